@@ -52,3 +52,18 @@ List<E> makeFixedListUnmodifiable<E>(List<E> fixedLengthList) {
 @patch
 Object extractTypeArguments<T>(T instance, Function extract) =>
     dart.extractTypeArguments<T>(instance, extract);
+
+@patch
+bool equalsIgnoreAsciiCase(String a, String b) {
+  if (a.length != b.length) return false;
+  for (int i = 0; i < a.length; i++) {
+    int aChar = a.codeUnitAt(i);
+    int bChar = b.codeUnitAt(i);
+    if (aChar == bChar) continue;
+    // Only ASCII letters differ in bit 0x20 between their cases.
+    if ((aChar ^ bChar) != 0x20) return false;
+    int lowerChar = aChar | 0x20;
+    if (lowerChar < 0x61 || lowerChar > 0x7a) return false;
+  }
+  return true;
+}
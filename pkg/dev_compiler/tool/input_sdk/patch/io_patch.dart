@@ -572,6 +572,26 @@ class _StdIOUtils {
   static _getStdioHandleType(int fd) {
     throw UnsupportedError("StdIOUtils._getStdioHandleType");
   }
+
+  @patch
+  static void _writeBuffered(int fd, List<int> data) {
+    throw UnsupportedError("StdIOUtils._writeBuffered");
+  }
+
+  @patch
+  static void _flushBuffered(int fd) {
+    throw UnsupportedError("StdIOUtils._flushBuffered");
+  }
+
+  @patch
+  static int _getBufferSize(int fd) {
+    throw UnsupportedError("Stdout.bufferSize");
+  }
+
+  @patch
+  static void _setBufferSize(int fd, int size) {
+    throw UnsupportedError("Stdout.bufferSize");
+  }
 }
 
 @patch
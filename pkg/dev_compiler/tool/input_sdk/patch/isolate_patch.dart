@@ -6,6 +6,7 @@
 
 import 'dart:_js_helper' show patch, NoReifyGeneric;
 import 'dart:async';
+import 'dart:typed_data' show TypedData;
 
 @patch
 class Isolate {
@@ -116,6 +117,22 @@ class Capability {
   factory Capability() => _unsupported();
 }
 
+@patch
+class TransferableTypedData {
+  @patch
+  factory TransferableTypedData.fromList(List<TypedData> list) =>
+      _unsupported();
+}
+
+@patch
+class RingBufferChannel {
+  @patch
+  factory RingBufferChannel(int capacity) => _unsupported();
+
+  @patch
+  factory RingBufferChannel.attach(int id) => _unsupported();
+}
+
 @NoReifyGeneric()
 T _unsupported<T>() {
   throw UnsupportedError('dart:isolate is not supported on dart4web');
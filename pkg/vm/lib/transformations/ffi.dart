@@ -29,7 +29,8 @@ enum NativeType {
   kIntptr,
   kFloat,
   kDouble,
-  kVoid
+  kVoid,
+  kByValue
 }
 
 const NativeType kNativeTypeIntStart = NativeType.kInt8;
@@ -50,7 +51,8 @@ const List<String> nativeTypeClassNames = [
   'IntPtr',
   'Float',
   'Double',
-  'Void'
+  'Void',
+  'ByValue'
 ];
 
 const int UNKNOWN = 0;
@@ -72,6 +74,7 @@ const List<int> nativeTypeSizes = [
   4, // Float
   8, // Double
   UNKNOWN, // Void
+  UNKNOWN, // ByValue
 ];
 
 /// [FfiTransformer] contains logic which is shared between
@@ -94,6 +97,7 @@ class FfiTransformer extends Transformer {
   final Procedure loadMethod;
   final Procedure storeMethod;
   final Procedure offsetByMethod;
+  final Procedure elementAtMethod;
   final Procedure asFunctionMethod;
   final Procedure lookupFunctionMethod;
   final Procedure fromFunctionMethod;
@@ -102,6 +106,12 @@ class FfiTransformer extends Transformer {
   /// Classes corresponding to [NativeType], indexed by [NativeType].
   final List<Class> nativeTypesClasses;
 
+  /// Element accessors in the VM's dart:ffi patch which the VM compiles to
+  /// raw memory accesses, indexed by [NativeType]. Null for the types which do
+  /// not have one.
+  final List<Procedure> loadMethods;
+  final List<Procedure> storeMethods;
+
   FfiTransformer(
       this.index, CoreTypes coreTypes, this.hierarchy, this.diagnosticReporter)
       : env = new TypeEnvironment(coreTypes, hierarchy),
@@ -116,6 +126,7 @@ class FfiTransformer extends Transformer {
         loadMethod = index.getMember('dart:ffi', 'Pointer', 'load'),
         storeMethod = index.getMember('dart:ffi', 'Pointer', 'store'),
         offsetByMethod = index.getMember('dart:ffi', 'Pointer', 'offsetBy'),
+        elementAtMethod = index.getMember('dart:ffi', 'Pointer', 'elementAt'),
         asFunctionMethod = index.getMember('dart:ffi', 'Pointer', 'asFunction'),
         lookupFunctionMethod =
             index.getMember('dart:ffi', 'DynamicLibrary', 'lookupFunction'),
@@ -124,7 +135,9 @@ class FfiTransformer extends Transformer {
         structField = index.getTopLevelMember('dart:ffi', 'struct'),
         nativeTypesClasses = nativeTypeClassNames
             .map((name) => index.getClass('dart:ffi', name))
-            .toList() {}
+            .toList(),
+        loadMethods = _elementAccessors(index, '_load'),
+        storeMethods = _elementAccessors(index, '_store') {}
 
   /// Computes the Dart type corresponding to a ffi.[NativeType], returns null
   /// if it is not a valid NativeType.
@@ -143,6 +156,7 @@ class FfiTransformer extends Transformer {
   /// [Void]                               -> [void]
   /// [Pointer]<T>                         -> [Pointer]<T>
   /// T extends [Pointer]                  -> T
+  /// [ByValue]<T>                         -> T
   /// [NativeFunction]<T1 Function(T2, T3) -> S1 Function(S2, S3)
   ///    where DartRepresentationOf(Tn) -> Sn
   DartType convertNativeTypeToDartType(DartType nativeType) {
@@ -168,6 +182,13 @@ class FfiTransformer extends Transformer {
     if (nativeType_ == NativeType.kVoid) {
       return VoidType();
     }
+    if (nativeType_ == NativeType.kByValue) {
+      DartType struct = (nativeType as InterfaceType).typeArguments[0];
+      if (struct is InterfaceType && struct.classNode != pointerClass) {
+        return struct;
+      }
+      return null;
+    }
     if (nativeType_ == NativeType.kNativeFunction) {
       DartType fun = (nativeType as InterfaceType).typeArguments[0];
       if (fun is FunctionType) {
@@ -196,6 +217,13 @@ class FfiTransformer extends Transformer {
   }
 }
 
+List<Procedure> _elementAccessors(LibraryIndex index, String prefix) {
+  return nativeTypeClassNames
+      .map((name) => index.tryGetMember(
+          'dart:ffi', LibraryIndex.topLevel, '$prefix$name') as Procedure)
+      .toList();
+}
+
 /// Contains replaced members, of which all the call sites need to be replaced.
 ///
 /// [ReplacedMembers] is populated by _FfiDefinitionTransformer and consumed by
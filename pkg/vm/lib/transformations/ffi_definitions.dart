@@ -213,6 +213,7 @@ class _FfiDefinitionTransformer extends FfiTransformer {
 
     List<int> offsets = _calculateOffsets(types);
     int size = _calculateSize(offsets, types);
+    _annotateFieldTypes(node, types);
 
     for (int i = 0; i < fields.length; i++) {
       List<Procedure> methods =
@@ -229,6 +230,26 @@ class _FfiDefinitionTransformer extends FfiTransformer {
     return size;
   }
 
+  /// Records the native types of the fields for the VM, which lays out structs
+  /// passed by value according to the native ABI.
+  ///
+  /// Sample output:
+  /// @pragma("vm:ffi:struct-fields", [ffi.Double, ffi.Double, ffi.Pointer])
+  void _annotateFieldTypes(Class node, List<NativeType> types) {
+    List<Expression> fieldTypes = types
+        .map((t) => TypeLiteral(InterfaceType(nativeTypesClasses[t.index])))
+        .toList();
+    node.addAnnotation(ConstructorInvocation(
+        pragmaConstructor,
+        Arguments([
+          StringLiteral("vm:ffi:struct-fields"),
+          ListLiteral(fieldTypes,
+              typeArgument: InterfaceType(env.coreTypes.typeClass),
+              isConst: true)
+        ]),
+        isConst: true));
+  }
+
   /// Sample output:
   /// ffi.Pointer<ffi.Double> get _xPtr => cast();
   /// double get x => _xPtr.load();
@@ -385,8 +406,8 @@ class _FfiDefinitionTransformer extends FfiTransformer {
   NativeType _getFieldType(Class c) {
     NativeType fieldType = getType(c);
 
-    if (fieldType == NativeType.kVoid) {
-      // Fields cannot have Void types.
+    if (fieldType == NativeType.kVoid || fieldType == NativeType.kByValue) {
+      // Fields cannot have Void types, and structs cannot be nested.
       return null;
     }
     return fieldType;
@@ -165,6 +165,8 @@ class _FfiUseSiteTransformer extends FfiTransformer {
         _ensureNativeTypeValid(nativeType, node);
         _ensureNativeTypeSized(nativeType, node, target.name);
         _ensureNativeTypeToDartType(nativeType, dartType, node);
+
+        return _replaceWithElementAccessor(node, nativeType, loadMethods);
       } else if (target == storeMethod) {
         // TODO(dacoharkes): should load and store permitted to be generic?
         // https://github.com/dart-lang/sdk/issues/35902
@@ -176,12 +178,43 @@ class _FfiUseSiteTransformer extends FfiTransformer {
         _ensureNativeTypeValid(nativeType, node);
         _ensureNativeTypeSized(nativeType, node, target.name);
         _ensureNativeTypeToDartType(nativeType, dartType, node);
+
+        return _replaceWithElementAccessor(node, nativeType, storeMethods);
       }
     } catch (_FfiStaticTypeError) {}
 
     return node;
   }
 
+  /// Replaces a [Pointer.load] or [Pointer.store] of a primitive native type
+  /// by a call to its element accessor in [accessors], which the VM compiles
+  /// to a raw memory access. Returns [node] unchanged for other types.
+  ///
+  /// A receiver of the form `pointer.elementAt(index)` is folded into the
+  /// call, so that walking a native array does not allocate pointers.
+  Expression _replaceWithElementAccessor(MethodInvocation node,
+      DartType nativeType, List<Procedure> accessors) {
+    final NativeType nativeType_ =
+        getType((nativeType as InterfaceType).classNode);
+    final Procedure accessor =
+        nativeType_ == null ? null : accessors[nativeType_.index];
+    if (accessor == null) {
+      return node;
+    }
+    final Expression receiver = node.receiver;
+    Expression pointer = receiver;
+    Expression index = IntLiteral(0);
+    if (receiver is MethodInvocation &&
+        receiver.interfaceTarget == elementAtMethod) {
+      pointer = receiver.receiver;
+      index = receiver.arguments.positional[0];
+    }
+    final List<Expression> arguments = <Expression>[pointer, index]
+      ..addAll(node.arguments.positional);
+    return StaticInvocation(accessor, Arguments(arguments))
+      ..fileOffset = node.fileOffset;
+  }
+
   DartType _pointerTypeGetTypeArg(DartType pointerType) {
     if (pointerType is InterfaceType) {
       InterfaceType superType =
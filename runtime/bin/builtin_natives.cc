@@ -17,6 +17,7 @@
 #include "bin/file.h"
 #include "bin/io_natives.h"
 #include "bin/platform.h"
+#include "bin/stdio.h"
 
 namespace dart {
 namespace bin {
@@ -91,6 +92,9 @@ void FUNCTION_NAME(Builtin_PrintString)(Dart_NativeArguments args) {
     Dart_PropagateError(result);
   }
 
+  // Output written through dart:io before this goes out first.
+  StdoutBuffer::Flush(1);
+
   // Uses fwrite to support printing NUL bytes.
   intptr_t res = fwrite(chars, 1, length, stdout);
   ASSERT(res == length);
@@ -5,8 +5,11 @@
 #include "platform/globals.h"
 #if defined(HOST_OS_LINUX)
 
-#include <errno.h>  // NOLINT
-#include <fcntl.h>  // NOLINT
+#include <errno.h>        // NOLINT
+#include <fcntl.h>        // NOLINT
+#include <pthread.h>      // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/fdutils.h"
@@ -15,7 +18,7 @@
 namespace dart {
 namespace bin {
 
-bool Crypto::GetRandomBytes(intptr_t count, uint8_t* buffer) {
+static bool ReadFromDevURandom(intptr_t count, uint8_t* buffer) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   intptr_t fd =
       TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(open("/dev/urandom", O_RDONLY));
@@ -38,6 +41,76 @@ bool Crypto::GetRandomBytes(intptr_t count, uint8_t* buffer) {
   return true;
 }
 
+// Reads straight from the kernel, using getrandom when the kernel has it so
+// that no file descriptor is needed.
+static bool ReadFromKernel(intptr_t count, uint8_t* buffer) {
+#if defined(SYS_getrandom)
+  ThreadSignalBlocker signal_blocker(SIGPROF);
+  intptr_t bytes_read = 0;
+  while (bytes_read < count) {
+    const intptr_t res = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+        syscall(SYS_getrandom, buffer + bytes_read, count - bytes_read, 0));
+    if (res < 0) {
+      if ((errno == ENOSYS) && (bytes_read == 0)) {
+        // Kernels before 3.17.
+        return ReadFromDevURandom(count, buffer);
+      }
+      return false;
+    }
+    bytes_read += res;
+  }
+  return true;
+#else
+  return ReadFromDevURandom(count, buffer);
+#endif  // defined(SYS_getrandom)
+}
+
+// Small requests, such as those made by Random.secure().nextInt(), are served
+// from a per-thread buffer of kernel randomness, so that most of them do not
+// need a system call at all. Bytes are handed out once only and cleared as
+// they are consumed. A forked child must not hand out the bytes its parent
+// will also hand out, so forking discards the buffers of all threads.
+static const intptr_t kPoolSize = 256;
+
+struct RandomPool {
+  uint8_t bytes[kPoolSize];
+  intptr_t available;
+  intptr_t generation;
+};
+
+static thread_local RandomPool random_pool = {{0}, 0, 0};
+static intptr_t pool_generation = 0;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static void DiscardPoolsAfterFork() {
+  pool_generation++;
+}
+
+static void InitPools() {
+  pthread_atfork(NULL, NULL, DiscardPoolsAfterFork);
+}
+
+bool Crypto::GetRandomBytes(intptr_t count, uint8_t* buffer) {
+  if (count > kPoolSize / 4) {
+    return ReadFromKernel(count, buffer);
+  }
+  pthread_once(&pool_once, InitPools);
+  RandomPool* pool = &random_pool;
+  if ((pool->generation != pool_generation) || (pool->available < count)) {
+    if (!ReadFromKernel(kPoolSize, pool->bytes)) {
+      pool->available = 0;
+      return false;
+    }
+    pool->available = kPoolSize;
+    pool->generation = pool_generation;
+  }
+  uint8_t* bytes = &pool->bytes[kPoolSize - pool->available];
+  memmove(buffer, bytes, count);
+  memset(bytes, 0, count);
+  pool->available -= count;
+  return true;
+}
+
 }  // namespace bin
 }  // namespace dart
 
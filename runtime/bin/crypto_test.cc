@@ -17,5 +17,25 @@ TEST_CASE(GetRandomBytes) {
   EXPECT(res);
 }
 
+TEST_CASE(GetRandomBytesNeverRepeats) {
+  // Small requests may be served from a buffer, which must not hand out the
+  // same bytes twice.
+  const intptr_t kNumRandomBytes = 8;
+  const intptr_t kNumRequests = 100;
+  uint8_t bufs[kNumRequests][kNumRandomBytes];
+  for (intptr_t i = 0; i < kNumRequests; i++) {
+    EXPECT(Crypto::GetRandomBytes(kNumRandomBytes, bufs[i]));
+  }
+  for (intptr_t i = 0; i < kNumRequests; i++) {
+    for (intptr_t j = i + 1; j < kNumRequests; j++) {
+      EXPECT(memcmp(bufs[i], bufs[j], kNumRandomBytes) != 0);
+    }
+  }
+
+  const intptr_t kLargeNumRandomBytes = 4096;
+  uint8_t large_buf[kLargeNumRandomBytes];
+  EXPECT(Crypto::GetRandomBytes(kLargeNumRandomBytes, large_buf));
+}
+
 }  // namespace bin
 }  // namespace dart
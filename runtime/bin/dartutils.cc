@@ -54,6 +54,9 @@ const char* const DartUtils::kVMServiceLibURL = "dart:vmservice";
 dart::SimpleHashMap* DartUtils::environment_ = NULL;
 
 MagicNumberData appjit_magic_number = {8, {0xdc, 0xdc, 0xf6, 0xf6, 0, 0, 0, 0}};
+MagicNumberData appjit_compressed_magic_number = {
+    8,
+    {0xdc, 0xdc, 0xf6, 0xf6, 0x1f, 0x8b, 0, 0}};
 MagicNumberData kernel_magic_number = {4, {0x90, 0xab, 0xcd, 0xef}};
 MagicNumberData kernel_list_magic_number = {
     7,
@@ -420,7 +423,8 @@ DartUtils::MagicNumber DartUtils::SniffForMagicNumber(const char* filename) {
 
 DartUtils::MagicNumber DartUtils::SniffForMagicNumber(const uint8_t* buffer,
                                                       intptr_t buffer_length) {
-  if (CheckMagicNumber(buffer, buffer_length, appjit_magic_number)) {
+  if (CheckMagicNumber(buffer, buffer_length, appjit_magic_number) ||
+      CheckMagicNumber(buffer, buffer_length, appjit_compressed_magic_number)) {
     return kAppJITMagicNumber;
   }
 
@@ -584,6 +584,7 @@ struct MagicNumberData {
 };
 
 extern MagicNumberData appjit_magic_number;
+extern MagicNumberData appjit_compressed_magic_number;
 extern MagicNumberData kernel_magic_number;
 extern MagicNumberData kernel_list_magic_number;
 extern MagicNumberData gzip_magic_number;
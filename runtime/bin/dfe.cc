@@ -13,8 +13,10 @@
 #include "bin/file.h"
 #include "bin/main_options.h"
 #include "bin/platform.h"
+#include "bin/process.h"
 #include "bin/utils.h"
 #include "include/dart_tools_api.h"
+#include "platform/text_buffer.h"
 #include "platform/utils.h"
 
 extern "C" {
@@ -66,8 +68,10 @@ DFE::DFE()
     : use_dfe_(false),
       use_incremental_compiler_(false),
       frontend_filename_(NULL),
-      application_kernel_buffer_(NULL),
-      application_kernel_buffer_size_(0) {
+      application_kernel_buffer_(),
+      application_kernel_buffer_size_(0),
+      kernel_cache_directory_(NULL),
+      kernel_cache_salt_(NULL) {
   // The run_vm_tests binary has the DART_PRECOMPILER set in order to allow unit
   // tests to exercise JIT and AOT pipeline.
   //
@@ -93,9 +97,20 @@ DFE::~DFE() {
   }
   frontend_filename_ = NULL;
 
-  free(application_kernel_buffer_);
-  application_kernel_buffer_ = NULL;
+  application_kernel_buffer_.reset();
   application_kernel_buffer_size_ = 0;
+
+  free(kernel_cache_directory_);
+  kernel_cache_directory_ = NULL;
+  free(kernel_cache_salt_);
+  kernel_cache_salt_ = NULL;
+}
+
+void DFE::set_kernel_cache(const char* directory, const char* salt) {
+  free(kernel_cache_directory_);
+  kernel_cache_directory_ = strdup(directory);
+  free(kernel_cache_salt_);
+  kernel_cache_salt_ = strdup(salt);
 }
 
 void DFE::Init() {
@@ -306,6 +321,34 @@ void DFE::ReadScript(const char* script_uri,
                      Dart_Timeline_Event_Duration, 0, NULL, NULL);
 }
 
+std::shared_ptr<uint8_t> DFE::MapScript(const char* script_uri,
+                                        intptr_t* kernel_buffer_size) const {
+  File* file =
+      reinterpret_cast<File*>(DartUtils::OpenFileUri(script_uri, false));
+  if (file == NULL) {
+    return nullptr;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if (length <= 0) {
+    return nullptr;
+  }
+  MappedMemory* mapping = file->Map(File::kReadOnly, 0, length);
+  if (mapping == NULL) {
+    return nullptr;
+  }
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(mapping->address());
+  if ((DartUtils::SniffForMagicNumber(buffer, length) !=
+       DartUtils::kKernelMagicNumber) ||
+      !Dart_IsKernel(buffer, length)) {
+    delete mapping;
+    return nullptr;
+  }
+  *kernel_buffer_size = length;
+  return std::shared_ptr<uint8_t>(buffer,
+                                  [mapping](uint8_t*) { delete mapping; });
+}
+
 // Attempts to treat [buffer] as a in-memory kernel byte representation.
 // If successful, returns [true] and places [buffer] into [kernel_ir], byte size
 // into [kernel_ir_size].
@@ -478,5 +521,236 @@ bool DFE::TryReadKernelFile(const char* script_uri,
   return TryReadSimpleKernelBuffer(buffer, kernel_ir, kernel_ir_size);
 }
 
+// A kernel cache entry consists of the kernel file and a manifest, which
+// starts with the SDK version and the size of the kernel file, followed by
+// the content hash and path of every source the kernel was compiled from:
+// ```
+// #@kernel-cache
+// 2.3.0-dev.0.1 (Tue Apr 2 12:30:06 2019 +0200) on "linux_x64"
+// 3654712
+// 7d2a51f0c3e8904b /projects/mytool/bin/main.dart
+// ...
+// ```
+// Both are named after a hash of the script URI, the package config and the
+// salt. The manifest is replaced after the kernel file, so a valid manifest
+// never refers to a partially written kernel file.
+static const char kKernelCacheMagic[] = "#@kernel-cache";
+static const char kKernelCacheKernelExtension[] = ".dill";
+static const char kKernelCacheDepsExtension[] = ".deps";
+
+static const uint64_t kKernelCacheHashSeed = 14695981039346656037ULL;
+
+// 64-bit FNV-1a.
+static uint64_t KernelCacheHash(uint64_t hash,
+                                const uint8_t* bytes,
+                                intptr_t length) {
+  for (intptr_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static uint64_t KernelCacheHash(uint64_t hash, const char* str) {
+  // Include the terminator to separate consecutive strings.
+  return KernelCacheHash(hash, reinterpret_cast<const uint8_t*>(str),
+                         strlen(str) + 1);
+}
+
+static bool HashSourceFile(const char* path, uint64_t* hash) {
+  File* file = File::Open(NULL, path, File::kRead);
+  if (file == NULL) {
+    return false;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if (length < 0) {
+    return false;
+  }
+  *hash = kKernelCacheHashSeed;
+  if (length == 0) {
+    return true;
+  }
+  MappedMemory* mapping = file->Map(File::kReadOnly, 0, length);
+  if (mapping == NULL) {
+    return false;
+  }
+  *hash = KernelCacheHash(
+      *hash, reinterpret_cast<const uint8_t*>(mapping->address()), length);
+  delete mapping;
+  return true;
+}
+
+// Appends a line to 'manifest' for each of the space separated 'dependencies'
+// as reported by the kernel service, which escapes spaces and backslashes in
+// the paths with a backslash.
+static bool AddKernelCacheDependencies(const char* dependencies,
+                                       intptr_t length,
+                                       TextBuffer* manifest) {
+  TextBuffer path(256);
+  for (intptr_t i = 0; i <= length; i++) {
+    if ((i == length) || (dependencies[i] == ' ')) {
+      if (path.length() > 0) {
+        uint64_t hash;
+        if (!HashSourceFile(path.buf(), &hash)) {
+          return false;
+        }
+        manifest->Printf("%016" Px64 " %s\n", hash, path.buf());
+        path.Clear();
+      }
+    } else if (dependencies[i] == '\n') {
+      return false;  // Would break the manifest format.
+    } else {
+      if ((dependencies[i] == '\\') && (i + 1 < length)) {
+        i++;
+      }
+      path.AddChar(dependencies[i]);
+    }
+  }
+  return true;
+}
+
+// Checks the manifest read from the cache against the current SDK and
+// sources, and returns the size of the cached kernel file if it still
+// applies. Returns -1 otherwise.
+static intptr_t ValidateKernelCacheManifest(char* manifest, intptr_t size) {
+  char* const end = manifest + size;
+  char* line = manifest;
+  intptr_t line_number = 0;
+  intptr_t kernel_size = -1;
+  while (line < end) {
+    char* newline = reinterpret_cast<char*>(memchr(line, '\n', end - line));
+    if (newline == NULL) {
+      return -1;
+    }
+    *newline = '\0';
+    if (line_number == 0) {
+      if (strcmp(line, kKernelCacheMagic) != 0) {
+        return -1;
+      }
+    } else if (line_number == 1) {
+      if (strcmp(line, Dart_VersionString()) != 0) {
+        return -1;
+      }
+    } else if (line_number == 2) {
+      char* rest = NULL;
+      kernel_size = strtoll(line, &rest, 10);
+      if ((rest == line) || (*rest != '\0') || (kernel_size <= 0)) {
+        return -1;
+      }
+    } else {
+      char* path = NULL;
+      const uint64_t expected_hash = strtoull(line, &path, 16);
+      if ((path == line) || (*path != ' ')) {
+        return -1;
+      }
+      uint64_t hash;
+      if (!HashSourceFile(path + 1, &hash) || (hash != expected_hash)) {
+        return -1;
+      }
+    }
+    line = newline + 1;
+    line_number++;
+  }
+  return kernel_size;
+}
+
+// Writes 'path' through a temporary file, so that concurrent readers see
+// either the old or the new contents.
+static bool WriteKernelCacheFile(const char* path,
+                                 const void* buffer,
+                                 intptr_t size) {
+  char* temp_path =
+      Utils::SCreate("%s.%" Pd ".tmp", path, Process::CurrentProcessId());
+  bool success = false;
+  File* file = File::Open(NULL, temp_path, File::kWriteTruncate);
+  if (file != NULL) {
+    success = file->WriteFully(buffer, size);
+    file->Release();
+    success = success && File::Rename(NULL, temp_path, path);
+    if (!success) {
+      File::Delete(NULL, temp_path);
+    }
+  }
+  free(temp_path);
+  return success;
+}
+
+char* DFE::KernelCachePath(const char* script_uri,
+                           const char* package_config,
+                           const char* extension) const {
+  ASSERT(UseKernelCache());
+  uint64_t key = KernelCacheHash(kKernelCacheHashSeed, script_uri);
+  key = KernelCacheHash(key, package_config != NULL ? package_config : "");
+  key = KernelCacheHash(key, kernel_cache_salt_);
+  return Utils::SCreate("%s%s%016" Px64 "%s", kernel_cache_directory_,
+                        File::PathSeparator(), key, extension);
+}
+
+std::shared_ptr<uint8_t> DFE::ReadCachedScript(
+    const char* script_uri,
+    const char* package_config,
+    intptr_t* kernel_buffer_size) const {
+  int64_t start = Dart_TimelineGetMicros();
+  char* manifest_path =
+      KernelCachePath(script_uri, package_config, kKernelCacheDepsExtension);
+  uint8_t* manifest = NULL;
+  intptr_t manifest_size = 0;
+  const bool found = TryReadFile(manifest_path, &manifest, &manifest_size);
+  free(manifest_path);
+  if (!found) {
+    return nullptr;
+  }
+  const intptr_t kernel_size = ValidateKernelCacheManifest(
+      reinterpret_cast<char*>(manifest), manifest_size);
+  free(manifest);
+  if (kernel_size < 0) {
+    return nullptr;
+  }
+  char* kernel_path =
+      KernelCachePath(script_uri, package_config, kKernelCacheKernelExtension);
+  std::shared_ptr<uint8_t> kernel = MapScript(kernel_path, kernel_buffer_size);
+  free(kernel_path);
+  if (kernel && (*kernel_buffer_size != kernel_size)) {
+    // Replaced by another process after we read the manifest.
+    kernel.reset();
+  }
+  int64_t end = Dart_TimelineGetMicros();
+  Dart_TimelineEvent("DFE::ReadCachedScript", start, end,
+                     Dart_Timeline_Event_Duration, 0, NULL, NULL);
+  return kernel;
+}
+
+void DFE::WriteCachedScript(const char* script_uri,
+                            const char* package_config,
+                            const uint8_t* kernel_buffer,
+                            intptr_t kernel_buffer_size) const {
+  Dart_KernelCompilationResult result = Dart_KernelListDependencies();
+  if (result.status != Dart_KernelCompilationStatus_Ok) {
+    free(result.error);
+    return;
+  }
+  TextBuffer manifest(1024);
+  manifest.Printf("%s\n%s\n%" Pd "\n", kKernelCacheMagic, Dart_VersionString(),
+                  kernel_buffer_size);
+  const bool valid =
+      AddKernelCacheDependencies(reinterpret_cast<char*>(result.kernel),
+                                 result.kernel_size, &manifest);
+  free(result.kernel);
+  if (!valid) {
+    return;
+  }
+  Directory::Create(NULL, kernel_cache_directory_);
+  char* kernel_path =
+      KernelCachePath(script_uri, package_config, kKernelCacheKernelExtension);
+  char* manifest_path =
+      KernelCachePath(script_uri, package_config, kKernelCacheDepsExtension);
+  if (WriteKernelCacheFile(kernel_path, kernel_buffer, kernel_buffer_size)) {
+    WriteKernelCacheFile(manifest_path, manifest.buf(), manifest.length());
+  }
+  free(kernel_path);
+  free(manifest_path);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -5,6 +5,8 @@
 #ifndef RUNTIME_BIN_DFE_H_
 #define RUNTIME_BIN_DFE_H_
 
+#include <memory>
+
 #include "include/dart_api.h"
 #include "include/dart_native_api.h"
 #include "platform/assert.h"
@@ -40,6 +42,12 @@ class DFE {
   }
   bool use_incremental_compiler() const { return use_incremental_compiler_; }
 
+  // Enables caching the kernel compiled for the main script in 'directory'.
+  // Compilations with a different 'salt', e.g. different VM flags, do not
+  // share cache entries.
+  void set_kernel_cache(const char* directory, const char* salt);
+  bool UseKernelCache() const { return kernel_cache_directory_ != NULL; }
+
   // Returns the platform binary file name if the path to
   // kernel binaries was set using SetKernelBinaries.
   const char* GetPlatformBinaryFilename();
@@ -47,11 +55,16 @@ class DFE {
   // Set the kernel program for the main application if it was specified
   // as a dill file.
   void set_application_kernel_buffer(uint8_t* buffer, intptr_t size) {
-    application_kernel_buffer_ = buffer;
+    application_kernel_buffer_ = std::shared_ptr<uint8_t>(buffer, free);
+    application_kernel_buffer_size_ = size;
+  }
+  void set_application_kernel_buffer(std::shared_ptr<uint8_t> buffer,
+                                     intptr_t size) {
+    application_kernel_buffer_ = std::move(buffer);
     application_kernel_buffer_size_ = size;
   }
   void application_kernel_buffer(const uint8_t** buffer, intptr_t* size) const {
-    *buffer = application_kernel_buffer_;
+    *buffer = application_kernel_buffer_.get();
     *size = application_kernel_buffer_size_;
   }
 
@@ -72,6 +85,21 @@ class DFE {
                             int* exit_code,
                             const char* package_config);
 
+  // Maps the kernel cached for 'script_uri' by WriteCachedScript, provided
+  // the SDK version and the contents of all the sources it was compiled from
+  // are still the same. Returns an empty pointer otherwise.
+  std::shared_ptr<uint8_t> ReadCachedScript(const char* script_uri,
+                                            const char* package_config,
+                                            intptr_t* kernel_buffer_size) const;
+
+  // Stores the kernel just compiled for 'script_uri' in the kernel cache,
+  // along with the content hashes of the sources the kernel service reports
+  // as its dependencies. Failing to write the cache is not an error.
+  void WriteCachedScript(const char* script_uri,
+                         const char* package_config,
+                         const uint8_t* kernel_buffer,
+                         intptr_t kernel_buffer_size) const;
+
   // Reads the script kernel file if specified 'script_uri' is a kernel file.
   // Returns an in memory kernel representation of the specified script is a
   // valid kernel file, false otherwise.
@@ -79,6 +107,15 @@ class DFE {
                   uint8_t** kernel_buffer,
                   intptr_t* kernel_buffer_size) const;
 
+  // Like ReadScript, but maps the kernel file read-only instead of copying
+  // it into the C heap: its pages are loaded when the VM reads them and are
+  // shared with other processes through the page cache. The mapping is
+  // released with the last reference to the returned buffer. Returns an
+  // empty pointer if 'script_uri' is not a kernel file which can be mapped,
+  // kernel list files for example have to be read with ReadScript.
+  std::shared_ptr<uint8_t> MapScript(const char* script_uri,
+                                     intptr_t* kernel_buffer_size) const;
+
   bool KernelServiceDillAvailable() const;
 
   // Tries to read [script_uri] as a Kernel IR file.
@@ -111,11 +148,20 @@ class DFE {
   intptr_t platform_strong_dill_size_;
 
   // Kernel binary specified on the cmd line.
-  uint8_t* application_kernel_buffer_;
+  std::shared_ptr<uint8_t> application_kernel_buffer_;
   intptr_t application_kernel_buffer_size_;
 
+  char* kernel_cache_directory_;
+  char* kernel_cache_salt_;
+
   bool InitKernelServiceAndPlatformDills(int target_abi_version);
 
+  // Returns the path of the kernel cache file with 'extension' for
+  // 'script_uri'. The caller must free() the result.
+  char* KernelCachePath(const char* script_uri,
+                        const char* package_config,
+                        const char* extension) const;
+
   DISALLOW_COPY_AND_ASSIGN(DFE);
 };
 
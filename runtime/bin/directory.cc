@@ -15,6 +15,7 @@
 #include "include/dart_api.h"
 #include "platform/assert.h"
 #include "platform/syslog.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -398,13 +399,13 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
+  // The names, then a type and a name offset for each entry.
+  const int kMaxEntries = 512;
+  const int kArraySize = 1 + 2 * kMaxEntries;
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
-  // In case the listing ended before it hit the buffer length, we need to
-  // override the array length.
-  response->AsApiCObject()->value.as_array.length = dir_listing->index();
+  dir_listing->FinishArray();
   return response;
 }
 
@@ -450,20 +451,42 @@ bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
                                                           const char* arg) {
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
   if (arg != NULL) {
-    size_t len = strlen(arg);
-    Dart_CObject* io_buffer = CObject::NewIOBuffer(len);
-    uint8_t* data = io_buffer->value.as_external_typed_data.data;
-    strncpy(reinterpret_cast<char*>(data), arg, len);
-
-    CObjectExternalUint8Array* external_array =
-        new CObjectExternalUint8Array(io_buffer);
-    array_->SetAt(index_++, external_array);
+    const intptr_t len = strlen(arg);
+    if (names_length_ + len > names_capacity_) {
+      names_capacity_ = Utils::Maximum(2 * names_capacity_,
+                                       names_length_ + len + PATH_MAX);
+      names_ = reinterpret_cast<char*>(realloc(names_, names_capacity_));
+      if (names_ == NULL) {
+        OUT_OF_MEMORY();
+      }
+    }
+    memmove(names_ + names_length_, arg, len);
+    names_length_ += len;
+    array_->SetAt(index_++,
+                  new CObjectInt32(CObject::NewInt32(names_length_)));
   } else {
     array_->SetAt(index_++, CObject::Null());
   }
   return index_ < length_;
 }
 
+void AsyncDirectoryListing::FinishArray() {
+  if (names_length_ == 0) {
+    array_->SetAt(kNamesIndex, CObject::Null());
+  } else {
+    Dart_CObject* io_buffer = CObject::NewIOBuffer(names_length_);
+    if (io_buffer == NULL) {
+      OUT_OF_MEMORY();
+    }
+    memmove(io_buffer->value.as_external_typed_data.data, names_,
+            names_length_);
+    array_->SetAt(kNamesIndex, new CObjectExternalUint8Array(io_buffer));
+  }
+  // In case the listing ended before it hit the array length, we need to
+  // override the array length.
+  array_->AsApiCObject()->value.as_array.length = index_;
+}
+
 bool AsyncDirectoryListing::HandleDirectory(const char* dir_name) {
   return AddFileSystemEntityToResponse(kListDirectory, dir_name);
 }
@@ -164,6 +164,11 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
     kListDone = 4
   };
 
+  // A response to a list request holds the names of all its entries back to
+  // back in one buffer, which comes first. It is followed by the type of
+  // each entry and the offset in the buffer at which its name ends.
+  static const intptr_t kNamesIndex = 0;
+
   AsyncDirectoryListing(Namespace* namespc,
                         const char* dir_name,
                         bool recursive,
@@ -172,7 +177,10 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
         DirectoryListing(namespc, dir_name, recursive, follow_links),
         array_(NULL),
         index_(0),
-        length_(0) {}
+        length_(0),
+        names_(NULL),
+        names_length_(0),
+        names_capacity_(0) {}
 
   virtual bool HandleDirectory(const char* dir_name);
   virtual bool HandleFile(const char* file_name);
@@ -181,20 +189,27 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
   virtual void HandleDone();
 
   void SetArray(CObjectArray* array, intptr_t length) {
-    ASSERT(length % 2 == 0);
+    ASSERT(length % 2 == 1);
     array_ = array;
-    index_ = 0;
+    index_ = kNamesIndex + 1;
     length_ = length;
+    names_length_ = 0;
   }
 
-  intptr_t index() const { return index_; }
+  // Stores the names gathered since SetArray in the array, and trims it to
+  // the entries actually listed.
+  void FinishArray();
 
  private:
-  virtual ~AsyncDirectoryListing() {}
+  virtual ~AsyncDirectoryListing() { free(names_); }
   bool AddFileSystemEntityToResponse(Response response, const char* arg);
   CObjectArray* array_;
   intptr_t index_;
   intptr_t length_;
+  // Reused from one request to the next.
+  char* names_;
+  intptr_t names_length_;
+  intptr_t names_capacity_;
 
   friend class ReferenceCounted<AsyncDirectoryListing>;
   DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncDirectoryListing);
@@ -13,8 +13,9 @@
 #include <stdlib.h>     // NOLINT
 #include <string.h>     // NOLINT
 #include <sys/param.h>  // NOLINT
-#include <sys/stat.h>   // NOLINT
-#include <unistd.h>     // NOLINT
+#include <sys/stat.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/dartutils.h"
@@ -80,6 +81,69 @@ struct LinkList {
   LinkList* next;
 };
 
+// Reads the entries of a directory with getdents64, which fills a buffer
+// with many entries per system call. The buffer is larger than the one
+// readdir uses, so that huge directories take fewer calls, and it is not
+// allocated at all for the many tiny ones, which fit in the first read.
+class DirectoryEntryReader {
+ public:
+  static const intptr_t kInitialBufferSize = 4 * KB;
+  static const intptr_t kMaxBufferSize = 64 * KB;
+
+  explicit DirectoryEntryReader(int fd)
+      : fd_(fd),
+        buffer_(initial_buffer_),
+        buffer_size_(kInitialBufferSize),
+        offset_(0),
+        length_(0) {}
+
+  ~DirectoryEntryReader() {
+    if (buffer_ != initial_buffer_) {
+      free(buffer_);
+    }
+    VOID_NO_RETRY_EXPECTED(close(fd_));
+  }
+
+  // Returns the next entry, or NULL at the end of the directory or with
+  // errno set on error. The glibc dirent64 has the layout of the kernel's
+  // linux_dirent64.
+  dirent64* Next() {
+    if (offset_ == length_) {
+      if ((length_ > 0) && (buffer_size_ < kMaxBufferSize)) {
+        // Having to read again means this is a big directory.
+        uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(kMaxBufferSize));
+        if (buffer != NULL) {
+          if (buffer_ != initial_buffer_) {
+            free(buffer_);
+          }
+          buffer_ = buffer;
+          buffer_size_ = kMaxBufferSize;
+        }
+      }
+      const intptr_t result = TEMP_FAILURE_RETRY(
+          syscall(SYS_getdents64, fd_, buffer_, buffer_size_));
+      if (result <= 0) {
+        return NULL;
+      }
+      offset_ = 0;
+      length_ = result;
+    }
+    dirent64* entry = reinterpret_cast<dirent64*>(buffer_ + offset_);
+    offset_ += entry->d_reclen;
+    return entry;
+  }
+
+ private:
+  const int fd_;
+  uint8_t* buffer_;
+  intptr_t buffer_size_;
+  intptr_t offset_;
+  intptr_t length_;
+  uint8_t initial_buffer_[kInitialBufferSize];
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryEntryReader);
+};
+
 ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (done_) {
     return kListDone;
@@ -98,13 +162,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   }
 
   if (lister_ == 0) {
-    do {
-      lister_ = reinterpret_cast<intptr_t>(fdopendir(fd_));
-    } while ((lister_ == 0) && (errno == EINTR));
-    if (lister_ == 0) {
-      done_ = true;
-      return kListError;
-    }
+    lister_ = reinterpret_cast<intptr_t>(new DirectoryEntryReader(fd_));
     if (parent_ != NULL) {
       if (!listing->path_buffer().Add(File::PathSeparator())) {
         return kListError;
@@ -119,7 +177,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   // Iterate the directory and post the directories and files to the
   // ports.
   errno = 0;
-  dirent* entry = readdir(reinterpret_cast<DIR*>(lister_));
+  dirent64* entry = reinterpret_cast<DirectoryEntryReader*>(lister_)->Next();
   if (entry != NULL) {
     if (!listing->path_buffer().Add(entry->d_name)) {
       done_ = true;
@@ -225,7 +283,7 @@ DirectoryListingEntry::~DirectoryListingEntry() {
   ResetLink();
   if (lister_ != 0) {
     // This also closes fd_.
-    VOID_NO_RETRY_EXPECTED(closedir(reinterpret_cast<DIR*>(lister_)));
+    delete reinterpret_cast<DirectoryEntryReader*>(lister_);
   }
 }
 
@@ -7,6 +7,7 @@
 #include "bin/eventhandler.h"
 #include "bin/platform.h"
 #include "bin/process.h"
+#include "bin/stdio.h"
 #include "include/dart_api.h"
 #include "platform/assert.h"
 #include "platform/globals.h"
@@ -16,6 +17,9 @@ namespace dart {
 namespace bin {
 
 void ErrorExit(int exit_code, const char* format, ...) {
+  // Output the program wrote before the error goes out first.
+  StdoutBuffer::FlushAll();
+
   va_list arguments;
   va_start(arguments, format);
   Syslog::VPrintErr(format, arguments);
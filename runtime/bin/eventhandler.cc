@@ -15,46 +15,101 @@
 namespace dart {
 namespace bin {
 
+TimeoutQueue::~TimeoutQueue() {
+  for (intptr_t i = 0; i < heap_length_; i++) {
+    delete heap_[i];
+  }
+  free(heap_);
+}
+
 void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
-  // Find port if present.
-  Timeout* last = NULL;
-  Timeout* current = timeouts_;
-  while (current != NULL) {
-    if (current->port() == port) {
-      // Found.
-      if (timeout < 0) {
-        // Remove from list and delete existing.
-        if (last != NULL) {
-          last->set_next(current->next());
-        } else {
-          timeouts_ = current->next();
-        }
-        delete current;
-      } else {
-        // Update timeout.
-        current->set_timeout(timeout);
-      }
-      break;
+  const uint32_t hash = PortHash(port);
+  SimpleHashMap::Entry* entry = timeouts_.Lookup(&port, hash, false);
+  if (entry != NULL) {
+    Timeout* current = reinterpret_cast<Timeout*>(entry->value);
+    if (timeout < 0) {
+      timeouts_.Remove(&port, hash);
+      RemoveAt(current->index());
+      delete current;
+    } else if (timeout < current->timeout()) {
+      current->set_timeout(timeout);
+      SiftUp(current->index());
+    } else {
+      current->set_timeout(timeout);
+      SiftDown(current->index());
     }
-    last = current;
-    current = current->next();
+  } else if (timeout >= 0) {
+    Timeout* current = new Timeout(port, timeout);
+    entry = timeouts_.Lookup(current->port_address(), hash, true);
+    entry->value = current;
+    Add(current);
   }
-  if (current == NULL && timeout >= 0) {
-    // Not found, create a new.
-    timeouts_ = new Timeout(port, timeout, timeouts_);
+}
+
+void TimeoutQueue::Add(Timeout* timeout) {
+  if (heap_length_ == heap_capacity_) {
+    heap_capacity_ =
+        (heap_capacity_ == 0) ? kInitialCapacity : 2 * heap_capacity_;
+    heap_ = reinterpret_cast<Timeout**>(
+        realloc(heap_, heap_capacity_ * sizeof(*heap_)));
+    if (heap_ == NULL) {
+      OUT_OF_MEMORY();
+    }
+  }
+  Place(timeout, heap_length_++);
+  SiftUp(timeout->index());
+}
+
+void TimeoutQueue::RemoveAt(intptr_t index) {
+  ASSERT((index >= 0) && (index < heap_length_));
+  const int64_t removed = heap_[index]->timeout();
+  Timeout* last = heap_[--heap_length_];
+  if (index == heap_length_) {
+    return;
+  }
+  Place(last, index);
+  if (last->timeout() < removed) {
+    SiftUp(index);
+  } else {
+    SiftDown(index);
   }
-  // Clear and find next timeout.
-  next_timeout_ = NULL;
-  current = timeouts_;
-  while (current != NULL) {
-    if ((next_timeout_ == NULL) ||
-        (current->timeout() < next_timeout_->timeout())) {
-      next_timeout_ = current;
+}
+
+void TimeoutQueue::SiftUp(intptr_t index) {
+  Timeout* timeout = heap_[index];
+  while (index > 0) {
+    const intptr_t parent = (index - 1) / 2;
+    if (heap_[parent]->timeout() <= timeout->timeout()) {
+      break;
+    }
+    Place(heap_[parent], index);
+    index = parent;
+  }
+  Place(timeout, index);
+}
+
+void TimeoutQueue::SiftDown(intptr_t index) {
+  Timeout* timeout = heap_[index];
+  while (true) {
+    intptr_t child = 2 * index + 1;
+    if (child >= heap_length_) {
+      break;
+    }
+    if ((child + 1 < heap_length_) &&
+        (heap_[child + 1]->timeout() < heap_[child]->timeout())) {
+      child++;
     }
-    current = current->next();
+    if (timeout->timeout() <= heap_[child]->timeout()) {
+      break;
+    }
+    Place(heap_[child], index);
+    index = child;
   }
+  Place(timeout, index);
 }
 
+intptr_t EventHandler::thread_count_ = 1;
+
 static EventHandler* event_handler = NULL;
 static Monitor* shutdown_monitor = NULL;
 
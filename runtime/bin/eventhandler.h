@@ -10,6 +10,7 @@
 #include "bin/isolate_data.h"
 
 #include "platform/hashmap.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -56,14 +57,18 @@ enum MessageFlags {
 #define TOKEN_COUNT(data) (data & ((1 << kCloseCommand) - 1))
 // clang-format on
 
+// The pending timeouts, one per port, kept in a binary min-heap so that the
+// next timeout is found in constant time. A hash map from ports to heap
+// entries makes updating or removing a port's timeout logarithmic too.
 class TimeoutQueue {
  private:
   class Timeout {
    public:
-    Timeout(Dart_Port port, int64_t timeout, Timeout* next)
-        : port_(port), timeout_(timeout), next_(next) {}
+    Timeout(Dart_Port port, int64_t timeout)
+        : port_(port), timeout_(timeout), index_(-1) {}
 
     Dart_Port port() const { return port_; }
+    Dart_Port* port_address() { return &port_; }
 
     int64_t timeout() const { return timeout_; }
     void set_timeout(int64_t timeout) {
@@ -71,42 +76,68 @@ class TimeoutQueue {
       timeout_ = timeout;
     }
 
-    Timeout* next() const { return next_; }
-    void set_next(Timeout* next) { next_ = next; }
+    // The position of this timeout in the heap.
+    intptr_t index() const { return index_; }
+    void set_index(intptr_t index) { index_ = index; }
 
    private:
     Dart_Port port_;
     int64_t timeout_;
-    Timeout* next_;
+    intptr_t index_;
   };
 
  public:
-  TimeoutQueue() : next_timeout_(NULL), timeouts_(NULL) {}
+  TimeoutQueue()
+      : timeouts_(&SamePort, kInitialCapacity),
+        heap_(NULL),
+        heap_length_(0),
+        heap_capacity_(0) {}
 
-  ~TimeoutQueue() {
-    while (HasTimeout())
-      RemoveCurrent();
-  }
+  ~TimeoutQueue();
 
-  bool HasTimeout() const { return next_timeout_ != NULL; }
+  bool HasTimeout() const { return heap_length_ > 0; }
 
   int64_t CurrentTimeout() const {
-    ASSERT(next_timeout_ != NULL);
-    return next_timeout_->timeout();
+    ASSERT(HasTimeout());
+    return heap_[0]->timeout();
   }
 
   Dart_Port CurrentPort() const {
-    ASSERT(next_timeout_ != NULL);
-    return next_timeout_->port();
+    ASSERT(HasTimeout());
+    return heap_[0]->port();
   }
 
   void RemoveCurrent() { UpdateTimeout(CurrentPort(), -1); }
 
+  // Sets the timeout for |port|, or removes it if |timeout| is negative.
   void UpdateTimeout(Dart_Port port, int64_t timeout);
 
  private:
-  Timeout* next_timeout_;
-  Timeout* timeouts_;
+  static const intptr_t kInitialCapacity = 16;
+
+  static bool SamePort(void* key1, void* key2) {
+    return *reinterpret_cast<Dart_Port*>(key1) ==
+           *reinterpret_cast<Dart_Port*>(key2);
+  }
+
+  static uint32_t PortHash(Dart_Port port) {
+    return Utils::WordHash(static_cast<intptr_t>(port ^ (port >> 32)));
+  }
+
+  void Add(Timeout* timeout);
+  void RemoveAt(intptr_t index);
+  void Place(Timeout* timeout, intptr_t index) {
+    heap_[index] = timeout;
+    timeout->set_index(index);
+  }
+  void SiftUp(intptr_t index);
+  void SiftDown(intptr_t index);
+
+  // Maps ports to their Timeout, keyed by the Timeout's own port field.
+  SimpleHashMap timeouts_;
+  Timeout** heap_;
+  intptr_t heap_length_;
+  intptr_t heap_capacity_;
 
   DISALLOW_COPY_AND_ASSIGN(TimeoutQueue);
 };
@@ -643,10 +674,17 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // The number of threads the event handler polls descriptors on. Only the
+  // Linux implementation uses more than one. Set before Start().
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t count) { thread_count_ = count; }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -69,7 +69,13 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
 }
 
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      handler_(NULL),
+      first_(this),
+      implementations_(NULL),
+      implementation_count_(1),
+      running_mutex_(NULL),
+      running_count_(0) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
   if (result != 0) {
@@ -126,6 +132,13 @@ static void DeleteDescriptorInfo(void* info) {
 }
 
 EventHandlerImplementation::~EventHandlerImplementation() {
+  if (implementations_ != NULL) {
+    for (intptr_t i = 1; i < implementation_count_; i++) {
+      delete implementations_[i];
+    }
+    delete[] implementations_;
+    delete running_mutex_;
+  }
   socket_map_.Clear(DeleteDescriptorInfo);
   close(epoll_fd_);
   close(timer_fd_);
@@ -384,8 +397,8 @@ void EventHandlerImplementation::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   static const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  EventHandlerImplementation* handler_impl =
+      reinterpret_cast<EventHandlerImplementation*>(args);
   ASSERT(handler_impl != NULL);
 
   while (!handler_impl->shutdown_) {
@@ -400,27 +413,74 @@ void EventHandlerImplementation::Poll(uword args) {
       handler_impl->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
-  handler->NotifyShutdownDone();
+  // The EventHandler deletes all implementations once told that the last
+  // one is done.
+  EventHandlerImplementation* first = handler_impl->first_;
+  EventHandler* handler = handler_impl->handler_;
+  bool is_last;
+  {
+    MutexLocker ml(first->running_mutex_);
+    is_last = (--first->running_count_ == 0);
+  }
+  if (is_last) {
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler->NotifyShutdownDone();
+  }
 }
 
-void EventHandlerImplementation::Start(EventHandler* handler) {
+void EventHandlerImplementation::StartThread() {
   int result =
       Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                    reinterpret_cast<uword>(handler));
+                    reinterpret_cast<uword>(this));
   if (result != 0) {
     FATAL1("Failed to start event handler thread %d", result);
   }
 }
 
+void EventHandlerImplementation::Start(EventHandler* handler) {
+  ASSERT(first_ == this);
+  ASSERT(implementations_ == NULL);
+  implementation_count_ =
+      dart::Utils::Maximum<intptr_t>(1, EventHandler::thread_count());
+  implementations_ = new EventHandlerImplementation*[implementation_count_];
+  implementations_[0] = this;
+  for (intptr_t i = 1; i < implementation_count_; i++) {
+    implementations_[i] = new EventHandlerImplementation();
+    implementations_[i]->first_ = this;
+  }
+  running_mutex_ = new Mutex();
+  running_count_ = implementation_count_;
+  for (intptr_t i = 0; i < implementation_count_; i++) {
+    implementations_[i]->handler_ = handler;
+    implementations_[i]->StartThread();
+  }
+}
+
 void EventHandlerImplementation::Shutdown() {
-  SendData(kShutdownId, 0, 0);
+  for (intptr_t i = 0; i < implementation_count_; i++) {
+    implementations_[i]->WakeupHandler(kShutdownId, 0, 0);
+  }
+}
+
+EventHandlerImplementation* EventHandlerImplementation::ImplementationFor(
+    intptr_t id) {
+  if ((implementation_count_ == 1) || (id == kTimerId)) {
+    return this;
+  }
+  ASSERT(id != kShutdownId);
+  // Commands for a socket whose descriptor is closed already are dropped by
+  // whichever implementation gets them.
+  const intptr_t fd = reinterpret_cast<Socket*>(id)->fd();
+  if (fd < 0) {
+    return this;
+  }
+  return implementations_[fd % implementation_count_];
 }
 
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
-  WakeupHandler(id, dart_port, data);
+  ImplementationFor(id)->WakeupHandler(id, dart_port, data);
 }
 
 void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
@@ -14,6 +14,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "bin/thread.h"
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
@@ -58,6 +59,11 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
+// With EventHandler::thread_count() above one, the implementation owned by
+// the EventHandler starts further ones, each polling its own epoll set on a
+// thread of its own. A descriptor and the commands for it always go to the
+// implementation picked by its file descriptor, so the state for it is only
+// ever touched by one thread. Timers are all handled by the first one.
 class EventHandlerImplementation {
  public:
   EventHandlerImplementation();
@@ -75,6 +81,8 @@ class EventHandlerImplementation {
  private:
   void HandleEvents(struct epoll_event* events, int size);
   static void Poll(uword args);
+  void StartThread();
+  EventHandlerImplementation* ImplementationFor(intptr_t id);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
   void UpdateTimerFd();
@@ -90,6 +98,15 @@ class EventHandlerImplementation {
   int epoll_fd_;
   int timer_fd_;
 
+  EventHandler* handler_;
+  // The first implementation, which owns the others.
+  EventHandlerImplementation* first_;
+  // Only used by the first implementation.
+  EventHandlerImplementation** implementations_;
+  intptr_t implementation_count_;
+  Mutex* running_mutex_;
+  intptr_t running_count_;  // Protected by running_mutex_.
+
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
 
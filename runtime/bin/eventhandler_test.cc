@@ -79,5 +79,44 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+VM_UNIT_TEST_CASE(TimeoutQueue) {
+  TimeoutQueue queue;
+  EXPECT(!queue.HasTimeout());
+
+  // Test: The earliest timeout is current, whatever the insertion order.
+  const int kCount = 100;
+  for (int i = 0; i < kCount; i++) {
+    queue.UpdateTimeout(i + 1, ((i * 37) % kCount) + 1000);
+  }
+  EXPECT(queue.HasTimeout());
+  EXPECT_EQ(1000, queue.CurrentTimeout());
+  EXPECT_EQ(1, queue.CurrentPort());
+
+  // Test: Moving timeouts earlier and later reorders them.
+  queue.UpdateTimeout(50, 10);
+  EXPECT_EQ(10, queue.CurrentTimeout());
+  EXPECT_EQ(50, queue.CurrentPort());
+  queue.UpdateTimeout(50, 5000);
+  EXPECT_EQ(1000, queue.CurrentTimeout());
+  EXPECT_EQ(1, queue.CurrentPort());
+
+  // Test: Removing a timeout that is not current keeps the order.
+  queue.UpdateTimeout(2, -1);
+  queue.UpdateTimeout(4242, -1);
+
+  // Test: Timeouts come out in order until the queue is empty.
+  int64_t last = 0;
+  int count = 0;
+  while (queue.HasTimeout()) {
+    EXPECT(queue.CurrentTimeout() >= last);
+    EXPECT(queue.CurrentPort() != 2);
+    last = queue.CurrentTimeout();
+    queue.RemoveCurrent();
+    count++;
+  }
+  EXPECT_EQ(kCount - 1, count);
+  EXPECT_EQ(5000, last);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -298,6 +298,18 @@ DART_EXPORT intptr_t ApplyTo42And74(IntptrBinOp binop) {
   return retval;
 }
 
+typedef double (*DoubleSignMixOp)(int8_t a, double b, float c, int64_t d);
+
+// Applies a function with mixed integer and floating point arguments to
+// -1, 1.5, 2.25 and 2^40.
+// Used for testing callbacks from C into Dart.
+DART_EXPORT double ApplyToMixedArguments(DoubleSignMixOp op) {
+  std::cout << "ApplyToMixedArguments()\n";
+  double retval = op(-1, 1.5, 2.25f, static_cast<int64_t>(1) << 40);
+  std::cout << "returning " << retval << "\n";
+  return retval;
+}
+
 // Returns next element in the array, unless a null pointer is passed.
 // When a null pointer is passed, a null pointer is returned.
 // Used for testing null pointers.
@@ -402,6 +414,68 @@ DART_EXPORT int64_t SumVeryLargeStruct(VeryLargeStruct* vls) {
   return retval;
 }
 
+struct Mixed8 {
+  int32_t a;
+  float b;
+};
+
+struct Mixed12 {
+  float x;
+  int32_t tag;
+  float y;
+};
+
+struct Point2 {
+  double x;
+  double y;
+};
+
+struct Point3 {
+  double x;
+  double y;
+  double z;
+};
+
+// Multiplies both fields of a struct passed and returned by value.
+// Used for testing structs which fit in a single integer register.
+DART_EXPORT Mixed8 ScaleMixed8(Mixed8 m, int32_t factor) {
+  std::cout << "ScaleMixed8({" << m.a << ", " << m.b << "}, " << factor
+            << ")\n";
+  m.a *= factor;
+  m.b *= factor;
+  return m;
+}
+
+// Swaps the floats of a struct passed and returned by value and increments its
+// tag.
+// Used for testing structs which are split between integer and floating point
+// registers.
+DART_EXPORT Mixed12 SwapMixed12(Mixed12 m) {
+  std::cout << "SwapMixed12({" << m.x << ", " << m.tag << ", " << m.y
+            << "})\n";
+  Mixed12 result = {m.y, m.tag + 1, m.x};
+  return result;
+}
+
+// Adds up five points passed by value.
+// Used for testing structs passed on the stack once the registers run out.
+DART_EXPORT Point2
+SumPoint2s(Point2 a, Point2 b, Point2 c, Point2 d, Point2 e) {
+  Point2 result = {a.x + b.x + c.x + d.x + e.x, a.y + b.y + c.y + d.y + e.y};
+  std::cout << "SumPoint2s returning {" << result.x << ", " << result.y
+            << "}\n";
+  return result;
+}
+
+// Scales a point passed and returned by value.
+// Used for testing structs which are too large for registers on some ABIs.
+DART_EXPORT Point3 ScalePoint3(Point3 p, double factor) {
+  std::cout << "ScalePoint3({" << p.x << ", " << p.y << ", " << p.z << "}, "
+            << factor << ")\n";
+  Point3 result = {p.x * factor, p.y * factor, p.z * factor};
+  return result;
+}
+
 // Sums numbers of various sizes.
 // Used for testing truncation and sign extension of non 64 bit parameters.
 DART_EXPORT int64_t SumSmallNumbers(int8_t a,
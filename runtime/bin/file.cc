@@ -9,11 +9,13 @@
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/io_thread_pool.h"
 #include "bin/namespace.h"
 #include "bin/typed_data_utils.h"
 #include "bin/utils.h"
 #include "include/bin/dart_io_api.h"
 #include "include/dart_api.h"
+#include "include/dart_native_api.h"
 #include "include/dart_tools_api.h"
 #include "platform/globals.h"
 
@@ -45,6 +47,23 @@ static File* GetFile(Dart_NativeArguments args) {
   return file;
 }
 
+// Like GetFile, but usable from natives that run without an API scope.
+static File* GetFileNoScope(Dart_NativeArguments args) {
+  File* file;
+  Dart_Handle result =
+      Dart_GetNativeReceiver(args, reinterpret_cast<intptr_t*>(&file));
+  ASSERT(!Dart_IsError(result));
+  return file;
+}
+
+// Sets an OSError as the return value of a native that runs without an API
+// scope.
+static void SetOSErrorReturnValueNoScope(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  Dart_ExitScope();
+}
+
 static void SetFile(Dart_Handle dart_this, intptr_t file_pointer) {
   DEBUG_ASSERT(IsFile(dart_this));
   Dart_Handle result = Dart_SetNativeInstanceField(
@@ -223,6 +242,93 @@ void FUNCTION_NAME(File_Read)(Dart_NativeArguments args) {
   }
 }
 
+// A read started by File_ReadAsync. The I/O thread owns it, and the reference
+// to the file it holds, once it has been queued.
+struct AsyncReadRequest {
+  File* file;
+  intptr_t length;
+  Dart_Port reply_port;
+  int64_t id;
+};
+
+// Reads on an IOThreadPool thread and replies with [id, data] or with
+// [id, errorCode, errorMessage]. The data is handed over as external typed
+// data so the bytes are not copied into the message.
+static void AsyncReadTask(void* data) {
+  AsyncReadRequest* request = reinterpret_cast<AsyncReadRequest*>(data);
+  RefCntReleaseScope<File> rs(request->file);
+  const intptr_t length = request->length;
+  uint8_t* buffer = IOBuffer::Allocate(length);
+  int64_t bytes_read = -1;
+  if (buffer != NULL) {
+    bytes_read = request->file->Read(reinterpret_cast<void*>(buffer), length);
+  }
+
+  Dart_CObject id;
+  id.type = Dart_CObject_kInt64;
+  id.value.as_int64 = request->id;
+  Dart_CObject values[2];
+  Dart_CObject* elements[3] = {&id, &values[0], &values[1]};
+  Dart_CObject message;
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.values = elements;
+  if (bytes_read >= 0) {
+    values[0].type = Dart_CObject_kExternalTypedData;
+    values[0].value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    values[0].value.as_external_typed_data.length = bytes_read;
+    values[0].value.as_external_typed_data.data = buffer;
+    values[0].value.as_external_typed_data.peer = buffer;
+    values[0].value.as_external_typed_data.callback = IOBuffer::Finalizer;
+    message.value.as_array.length = 2;
+    // The message owns the buffer from here on, even if it is not delivered.
+    Dart_PostCObject(request->reply_port, &message);
+  } else {
+    OSError os_error;
+    if (buffer != NULL) {
+      IOBuffer::Free(buffer);
+    }
+    values[0].type = Dart_CObject_kInt32;
+    values[0].value.as_int32 = os_error.code();
+    values[1].type = Dart_CObject_kString;
+    values[1].value.as_string = const_cast<char*>(os_error.message());
+    message.value.as_array.length = 3;
+    Dart_PostCObject(request->reply_port, &message);
+  }
+  delete request;
+}
+
+void FUNCTION_NAME(File_ReadAsync)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  if (file == NULL) {
+    OSError os_error(-1, "File closed", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  Dart_Handle length_object = Dart_GetNativeArgument(args, 1);
+  int64_t length = 0;
+  if (!DartUtils::GetInt64Value(length_object, &length) || (length < 0) ||
+      (length > kIntptrMax)) {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  Dart_Port reply_port = ILLEGAL_PORT;
+  ThrowIfError(
+      Dart_SendPortGetId(Dart_GetNativeArgument(args, 2), &reply_port));
+  AsyncReadRequest* request = new AsyncReadRequest();
+  file->Retain();
+  request->file = file;
+  request->length = static_cast<intptr_t>(length);
+  request->reply_port = reply_port;
+  request->id = DartUtils::GetNativeIntegerArgument(args, 3);
+  if (!IOThreadPool::Run(AsyncReadTask, request)) {
+    file->Release();
+    delete request;
+    OSError os_error(-1, "Cannot start I/O thread", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
 void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
   File* file = GetFile(args);
   ASSERT(file != NULL);
@@ -294,13 +400,13 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
 }
 
 void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
-  File* file = GetFile(args);
+  File* file = GetFileNoScope(args);
   ASSERT(file != NULL);
   intptr_t return_value = file->Position();
   if (return_value >= 0) {
     Dart_SetIntegerReturnValue(args, return_value);
   } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    SetOSErrorReturnValueNoScope(args);
   }
 }
 
@@ -337,13 +443,13 @@ void FUNCTION_NAME(File_Truncate)(Dart_NativeArguments args) {
 }
 
 void FUNCTION_NAME(File_Length)(Dart_NativeArguments args) {
-  File* file = GetFile(args);
+  File* file = GetFileNoScope(args);
   ASSERT(file != NULL);
   int64_t return_value = file->Length();
   if (return_value >= 0) {
     Dart_SetIntegerReturnValue(args, return_value);
   } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    SetOSErrorReturnValueNoScope(args);
   }
 }
 
@@ -496,6 +602,57 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void MappedMemoryFinalizer(void* isolate_data,
+                                  Dart_WeakPersistentHandle handle,
+                                  void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  ASSERT(file != NULL);
+  int64_t type;
+  int64_t start;
+  int64_t length;
+  int64_t advice;
+  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &type) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &start) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &length) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 4), &advice)) {
+    // Touching a mapping past the end of the file faults, so the range has
+    // to be in the file.
+    const int64_t file_length = file->Length();
+    if (file_length < 0) {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+      return;
+    }
+    if (((type == File::kReadOnly) || (type == File::kReadWrite)) &&
+        (start >= 0) && (length > 0) && (length <= kIntptrMax) &&
+        (start <= file_length - length) && (advice >= 0) &&
+        (advice <= MappedMemory::kAdviceMax)) {
+      MappedMemory* mapping =
+          file->Map(static_cast<File::MapType>(type), start, length);
+      if (mapping == NULL) {
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+        return;
+      }
+      mapping->Advise(static_cast<MappedMemory::Advice>(advice));
+      Dart_Handle result = Dart_NewExternalTypedData(
+          Dart_TypedData_kUint8, mapping->start(), length);
+      if (Dart_IsError(result)) {
+        delete mapping;
+        Dart_PropagateError(result);
+      }
+      Dart_NewWeakPersistentHandle(result, mapping, length,
+                                   MappedMemoryFinalizer);
+      Dart_SetReturnValue(args, result);
+      return;
+    }
+  }
+  OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle path_handle = Dart_GetNativeArgument(args, 1);
@@ -1479,6 +1636,40 @@ CObject* File::StatRequest(const CObjectArray& request) {
   return wrapper;
 }
 
+// Answers with the stat data of all paths packed into a single byte array,
+// File::kStatSize int64 values per path, so that checking many files costs
+// one message instead of one per file. Paths that cannot be stat'ed have a
+// type of kDoesNotExist.
+CObject* File::StatBatchRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  Namespace* namespc = CObjectToNamespacePointer(request[0]);
+  RefCntReleaseScope<Namespace> rs(namespc);
+  if ((request.Length() != 2) || !request[1]->IsArray()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectArray paths(request[1]);
+  for (intptr_t i = 0; i < paths.Length(); i++) {
+    if (!paths[i]->IsString()) {
+      return CObject::IllegalArgumentError();
+    }
+  }
+  const intptr_t record_size = File::kStatSize * sizeof(int64_t);
+  CObjectUint8Array* result = new CObjectUint8Array(
+      CObject::NewUint8Array(paths.Length() * record_size));
+  for (intptr_t i = 0; i < paths.Length(); i++) {
+    int64_t data[File::kStatSize];
+    CObjectString path(paths[i]);
+    File::Stat(namespc, path.CString(), data);
+    memmove(result->Buffer() + i * record_size, data, record_size);
+  }
+  CObjectArray* wrapper = new CObjectArray(CObject::NewArray(2));
+  wrapper->SetAt(0, new CObjectInt32(CObject::NewInt32(CObject::kSuccess)));
+  wrapper->SetAt(1, result);
+  return wrapper;
+}
+
 CObject* File::LockRequest(const CObjectArray& request) {
   if ((request.Length() < 1) || !request[0]->IsIntptr()) {
     return CObject::IllegalArgumentError();
@@ -24,17 +24,36 @@ class FileHandle;
 
 class MappedMemory {
  public:
-  MappedMemory(void* address, intptr_t size) : address_(address), size_(size) {}
+  // These match the constants in FileMapAccess in file.dart.
+  enum Advice {
+    kAdviceNormal = 0,
+    kAdviceSequential = 1,
+    kAdviceRandom = 2,
+    kAdviceMax = kAdviceRandom
+  };
+
+  MappedMemory(void* address, intptr_t size, intptr_t offset = 0)
+      : address_(address), size_(size), offset_(offset) {}
   ~MappedMemory() { Unmap(); }
 
   void* address() const { return address_; }
   intptr_t size() const { return size_; }
 
+  // The start of the requested range. The mapping itself starts earlier if
+  // the requested position was not page aligned.
+  uint8_t* start() const {
+    return reinterpret_cast<uint8_t*>(address_) + offset_;
+  }
+
+  // Tells the OS how the memory is going to be accessed, where supported.
+  void Advise(Advice advice);
+
  private:
   void Unmap();
 
   void* address_;
   intptr_t size_;
+  intptr_t offset_;
 
   DISALLOW_COPY_AND_ASSIGN(MappedMemory);
 };
@@ -97,9 +116,12 @@ class File : public ReferenceCounted<File> {
 
   intptr_t GetFD();
 
+  // kReadOnly and kReadWrite match the constants in FileMapMode in
+  // file.dart. Writes to a kReadWrite mapping go to the file.
   enum MapType {
     kReadOnly = 0,
     kReadExecute = 1,
+    kReadWrite = 2,
   };
   MappedMemory* Map(MapType type, int64_t position, int64_t length);
 
@@ -262,6 +284,7 @@ class File : public ReferenceCounted<File> {
   static CObject* TypeRequest(const CObjectArray& request);
   static CObject* IdenticalRequest(const CObjectArray& request);
   static CObject* StatRequest(const CObjectArray& request);
+  static CObject* StatBatchRequest(const CObjectArray& request);
   static CObject* LockRequest(const CObjectArray& request);
 
  private:
@@ -79,6 +79,7 @@ MappedMemory* File::Map(MapType type, int64_t position, int64_t length) {
   ASSERT(handle_->fd() >= 0);
   ASSERT(length > 0);
   int prot = PROT_NONE;
+  int flags = MAP_PRIVATE;
   switch (type) {
     case kReadOnly:
       prot = PROT_READ;
@@ -86,14 +87,21 @@ MappedMemory* File::Map(MapType type, int64_t position, int64_t length) {
     case kReadExecute:
       prot = PROT_READ | PROT_EXEC;
       break;
+    case kReadWrite:
+      prot = PROT_READ | PROT_WRITE;
+      flags = MAP_SHARED;
+      break;
     default:
       return NULL;
   }
-  void* addr = mmap(NULL, length, prot, MAP_PRIVATE, handle_->fd(), position);
+  // The offset given to mmap has to be page aligned.
+  const int64_t offset = position % sysconf(_SC_PAGESIZE);
+  void* addr = mmap(NULL, length + offset, prot, flags, handle_->fd(),
+                    position - offset);
   if (addr == MAP_FAILED) {
     return NULL;
   }
-  return new MappedMemory(addr, length);
+  return new MappedMemory(addr, length + offset, offset);
 }
 
 void MappedMemory::Unmap() {
@@ -103,6 +111,22 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  int posix_advice = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceSequential:
+      posix_advice = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      posix_advice = MADV_RANDOM;
+      break;
+    default:
+      break;
+  }
+  // This is only a hint, so failures are ignored.
+  VOID_NO_RETRY_EXPECTED(madvise(address_, size_, posix_advice));
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
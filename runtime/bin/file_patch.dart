@@ -74,6 +74,8 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   int close() native "File_Close";
   readByte() native "File_ReadByte";
   read(int bytes) native "File_Read";
+  Future readAsync(int bytes) => _AsyncFileReads._start(this, bytes);
+  _readAsync(int bytes, SendPort replyPort, int id) native "File_ReadAsync";
   readInto(List<int> buffer, int start, int end) native "File_ReadInto";
   writeByte(int value) native "File_WriteByte";
   writeFrom(List<int> buffer, int start, int end) native "File_WriteFrom";
@@ -83,6 +85,59 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   length() native "File_Length";
   flush() native "File_Flush";
   lock(int lock, int start, int end) native "File_Lock";
+  map(int mode, int start, int length, int access) native "File_Map";
+}
+
+// Completes the reads started by _RandomAccessFileOpsImpl.readAsync. They run
+// on the embedder's I/O threads and reply to a single port per isolate, so
+// unlike the IOService no request message has to be sent. The port is
+// closed while no read is pending to not keep the isolate alive.
+class _AsyncFileReads {
+  static RawReceivePort _receivePort;
+  static HashMap<int, Completer> _pending = new HashMap<int, Completer>();
+  static int _id = 0;
+
+  static Future _start(_RandomAccessFileOpsImpl ops, int bytes) {
+    if (_receivePort == null) {
+      _receivePort = new RawReceivePort(_handleReply);
+    }
+    int id;
+    do {
+      id = _getNextId();
+    } while (_pending.containsKey(id));
+    var result = ops._readAsync(bytes, _receivePort.sendPort, id);
+    if (result is OSError) {
+      _maybeClose();
+      return new Future.value(result);
+    }
+    final Completer completer = new Completer();
+    _pending[id] = completer;
+    return completer.future;
+  }
+
+  // The reply is either [id, data] or [id, errorCode, errorMessage].
+  static void _handleReply(List reply) {
+    final Completer completer = _pending.remove(reply[0]);
+    if (reply.length == 2) {
+      completer.complete(reply[1]);
+    } else {
+      completer.complete(new OSError(reply[2], reply[1]));
+    }
+    _maybeClose();
+  }
+
+  static void _maybeClose() {
+    if (_pending.isEmpty) {
+      _id = 0;
+      _receivePort.close();
+      _receivePort = null;
+    }
+  }
+
+  static int _getNextId() {
+    if (_id == 0x7FFFFFFF) _id = 0;
+    return _id++;
+  }
 }
 
 class _WatcherPath {
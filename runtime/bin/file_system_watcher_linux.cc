@@ -7,71 +7,426 @@
 
 #include "bin/file_system_watcher.h"
 
+#include <dirent.h>       // NOLINT
 #include <errno.h>        // NOLINT
+#include <fcntl.h>        // NOLINT
 #include <sys/inotify.h>  // NOLINT
+#include <sys/stat.h>     // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
+#include "bin/lockers.h"
 #include "bin/socket.h"
+#include "bin/thread.h"
+#include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
 namespace dart {
 namespace bin {
 
-bool FileSystemWatcher::IsSupported() {
-  return true;
+// The directories below the root of a recursive watch each need their own
+// inotify watch, and inotify hands out one watch descriptor per directory,
+// so a descriptor can serve several watched paths: as the root of one and
+// somewhere below the root of another.
+struct WatchTarget {
+  // The path id the events are reported under.
+  intptr_t root;
+  // The path of the directory relative to the root, or NULL for the root.
+  char* prefix;
+  WatchTarget* next;
+};
+
+struct WatchRoot {
+  intptr_t path_id;
+  char* path;
+  // The inotify events requested for the directories below the root.
+  uint32_t mask;
+  bool recursive;
+  WatchRoot* next;
+};
+
+struct PendingEvent {
+  int mask;
+  uint32_t cookie;
+  const char* name;
+  bool owns_name;
+  bool moved_to;
+  intptr_t path_id;
+};
+
+// The watches made on one inotify instance, which is shared by all watchers
+// of an isolate.
+class InotifyWatches {
+ public:
+  static InotifyWatches* Get(intptr_t fd);
+  static void Delete(intptr_t fd);
+
+  intptr_t Watch(const char* path, uint32_t mask, bool recursive);
+  void Unwatch(intptr_t path_id);
+  Dart_Handle ReadEvents();
+
+ private:
+  // Big enough for many events at once, so that a burst of changes takes
+  // a few reads rather than one read per event.
+  static const intptr_t kBufferSize = 64 * KB;
+
+  // Content and attribute changes repeating one of the last this many
+  // events reported for the same path are dropped, since a burst of writes
+  // to a file otherwise turns into a burst of identical events.
+  static const intptr_t kCoalesceWindow = 16;
+
+  explicit InotifyWatches(intptr_t fd);
+  ~InotifyWatches();
+
+  WatchTarget* TargetsOf(int wd);
+  WatchRoot* RootOf(intptr_t path_id);
+  bool AddTarget(int wd, intptr_t root, const char* prefix);
+  void RemoveTargets(intptr_t root, const char* prefix);
+  void AddSubtree(WatchRoot* root, const char* relative, bool report);
+  void AddEvent(intptr_t path_id,
+                int mask,
+                uint32_t cookie,
+                const char* name,
+                bool owns_name,
+                bool moved_to);
+
+  static Mutex* mutex_;
+  static InotifyWatches* list_;
+
+  const intptr_t fd_;
+  InotifyWatches* next_;
+  WatchRoot* roots_;
+  SimpleHashMap targets_;  // Watch descriptor to WatchTarget list.
+  PendingEvent* events_;
+  intptr_t events_length_;
+  intptr_t events_capacity_;
+  uint8_t buffer_[kBufferSize];
+
+  DISALLOW_COPY_AND_ASSIGN(InotifyWatches);
+};
+
+Mutex* InotifyWatches::mutex_ = new Mutex();
+InotifyWatches* InotifyWatches::list_ = NULL;
+
+static void* WatchDescriptorKey(int wd) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(wd));
 }
 
-intptr_t FileSystemWatcher::Init() {
-  int id = NO_RETRY_EXPECTED(inotify_init1(IN_CLOEXEC));
-  if (id < 0) {
-    return -1;
+static char* JoinPath(const char* dir, const char* name) {
+  if (dir == NULL) {
+    return strdup(name);
   }
-  // Some systems dosn't support setting this as non-blocking. Since watching
-  // internals are kept away from the user, we know it's possible to continue,
-  // even if setting non-blocking fails.
-  FDUtils::SetNonBlocking(id);
-  return id;
+  const intptr_t length = strlen(dir) + 1 + strlen(name);
+  char* result = reinterpret_cast<char*>(malloc(length + 1));
+  if (result == NULL) {
+    OUT_OF_MEMORY();
+  }
+  snprintf(result, length + 1, "%s/%s", dir, name);
+  return result;
 }
 
-void FileSystemWatcher::Close(intptr_t id) {
-  USE(id);
+static bool IsSubpath(const char* path, const char* prefix) {
+  const intptr_t length = strlen(prefix);
+  return (strncmp(path, prefix, length) == 0) &&
+         ((path[length] == '\0') || (path[length] == '/'));
 }
 
-intptr_t FileSystemWatcher::WatchPath(intptr_t id,
-                                      Namespace* namespc,
-                                      const char* path,
-                                      int events,
-                                      bool recursive) {
-  int list_events = IN_DELETE_SELF | IN_MOVE_SELF;
-  if ((events & kCreate) != 0) {
-    list_events |= IN_CREATE;
+InotifyWatches::InotifyWatches(intptr_t fd)
+    : fd_(fd),
+      next_(NULL),
+      roots_(NULL),
+      targets_(&SimpleHashMap::SamePointerValue, 16),
+      events_(NULL),
+      events_length_(0),
+      events_capacity_(0) {}
+
+InotifyWatches::~InotifyWatches() {
+  for (SimpleHashMap::Entry* entry = targets_.Start(); entry != NULL;
+       entry = targets_.Next(entry)) {
+    WatchTarget* target = reinterpret_cast<WatchTarget*>(entry->value);
+    while (target != NULL) {
+      WatchTarget* next = target->next;
+      free(target->prefix);
+      delete target;
+      target = next;
+    }
   }
-  if ((events & kModifyContent) != 0) {
-    list_events |= IN_CLOSE_WRITE | IN_ATTRIB;
+  while (roots_ != NULL) {
+    WatchRoot* next = roots_->next;
+    free(roots_->path);
+    delete roots_;
+    roots_ = next;
   }
-  if ((events & kDelete) != 0) {
-    list_events |= IN_DELETE;
+  free(events_);
+}
+
+InotifyWatches* InotifyWatches::Get(intptr_t fd) {
+  MutexLocker ml(mutex_);
+  for (InotifyWatches* watches = list_; watches != NULL;
+       watches = watches->next_) {
+    if (watches->fd_ == fd) {
+      return watches;
+    }
   }
-  if ((events & kMove) != 0) {
-    list_events |= IN_MOVE;
+  InotifyWatches* watches = new InotifyWatches(fd);
+  watches->next_ = list_;
+  list_ = watches;
+  return watches;
+}
+
+void InotifyWatches::Delete(intptr_t fd) {
+  InotifyWatches* watches = NULL;
+  {
+    MutexLocker ml(mutex_);
+    for (InotifyWatches** link = &list_; *link != NULL;
+         link = &(*link)->next_) {
+      if ((*link)->fd_ == fd) {
+        watches = *link;
+        *link = watches->next_;
+        break;
+      }
+    }
   }
-  const char* resolved_path = File::GetCanonicalPath(namespc, path);
-  path = resolved_path != NULL ? resolved_path : path;
-  int path_id = NO_RETRY_EXPECTED(inotify_add_watch(id, path, list_events));
-  if (path_id < 0) {
+  delete watches;
+}
+
+WatchTarget* InotifyWatches::TargetsOf(int wd) {
+  SimpleHashMap::Entry* entry =
+      targets_.Lookup(WatchDescriptorKey(wd), static_cast<uint32_t>(wd), false);
+  return (entry == NULL) ? NULL : reinterpret_cast<WatchTarget*>(entry->value);
+}
+
+WatchRoot* InotifyWatches::RootOf(intptr_t path_id) {
+  for (WatchRoot* root = roots_; root != NULL; root = root->next) {
+    if (root->path_id == path_id) {
+      return root;
+    }
+  }
+  return NULL;
+}
+
+// Returns false if |root| already has a target on |wd|, which happens when
+// a walk comes back to a directory it has seen under another name.
+bool InotifyWatches::AddTarget(int wd, intptr_t root, const char* prefix) {
+  SimpleHashMap::Entry* entry =
+      targets_.Lookup(WatchDescriptorKey(wd), static_cast<uint32_t>(wd), true);
+  WatchTarget* head = reinterpret_cast<WatchTarget*>(entry->value);
+  for (WatchTarget* target = head; target != NULL; target = target->next) {
+    if (target->root == root) {
+      return false;
+    }
+  }
+  WatchTarget* target = new WatchTarget();
+  target->root = root;
+  target->prefix = (prefix == NULL) ? NULL : strdup(prefix);
+  target->next = head;
+  entry->value = target;
+  return true;
+}
+
+// Removes the targets of |root| at or below |prefix|, or all of them if
+// |prefix| is NULL, and the inotify watches left without a target. The
+// emptied entries stay until the kernel confirms with IN_IGNORED.
+void InotifyWatches::RemoveTargets(intptr_t root, const char* prefix) {
+  for (SimpleHashMap::Entry* entry = targets_.Start(); entry != NULL;
+       entry = targets_.Next(entry)) {
+    WatchTarget* head = reinterpret_cast<WatchTarget*>(entry->value);
+    if (head == NULL) {
+      continue;
+    }
+    WatchTarget** link = reinterpret_cast<WatchTarget**>(&entry->value);
+    while (*link != NULL) {
+      WatchTarget* target = *link;
+      if ((target->root == root) &&
+          ((prefix == NULL) ||
+           ((target->prefix != NULL) && IsSubpath(target->prefix, prefix)))) {
+        *link = target->next;
+        free(target->prefix);
+        delete target;
+      } else {
+        link = &target->next;
+      }
+    }
+    if (entry->value == NULL) {
+      const int wd = static_cast<int>(reinterpret_cast<intptr_t>(entry->key));
+      VOID_NO_RETRY_EXPECTED(inotify_rm_watch(fd_, wd));
+    }
+  }
+}
+
+// Watches the directory |relative| below |root|, or the root itself if
+// |relative| is NULL, and every directory below it. The walk happens here
+// rather than in Dart so that a big tree takes one call. When |report| is
+// set the entries found are reported as created, as they can be created
+// before the watch on their directory is in place.
+void InotifyWatches::AddSubtree(WatchRoot* root,
+                                const char* relative,
+                                bool report) {
+  intptr_t length = 0;
+  intptr_t capacity = 16;
+  char** pending = reinterpret_cast<char**>(malloc(capacity * sizeof(char*)));
+  if (pending == NULL) {
+    OUT_OF_MEMORY();
+  }
+  pending[length++] = (relative == NULL) ? NULL : strdup(relative);
+  char path[PATH_MAX];
+  while (length > 0) {
+    char* dir = pending[--length];
+    const int written =
+        (dir == NULL) ? snprintf(path, PATH_MAX, "%s", root->path)
+                      : snprintf(path, PATH_MAX, "%s/%s", root->path, dir);
+    if ((written < 0) || (written >= PATH_MAX)) {
+      free(dir);
+      continue;
+    }
+    if (dir != NULL) {
+      int wd = NO_RETRY_EXPECTED(inotify_add_watch(
+          fd_, path, root->mask | IN_ONLYDIR | IN_DONT_FOLLOW | IN_MASK_ADD));
+      if ((wd < 0) || !AddTarget(wd, root->path_id, dir)) {
+        free(dir);
+        continue;
+      }
+    }
+    DIR* dir_pointer;
+    do {
+      dir_pointer = opendir(path);
+    } while ((dir_pointer == NULL) && (errno == EINTR));
+    if (dir_pointer == NULL) {
+      free(dir);
+      continue;
+    }
+    dirent* entry;
+    while ((entry = readdir(dir_pointer)) != NULL) {
+      if ((strcmp(entry->d_name, ".") == 0) ||
+          (strcmp(entry->d_name, "..") == 0)) {
+        continue;
+      }
+      bool is_dir = entry->d_type == DT_DIR;
+      if (entry->d_type == DT_UNKNOWN) {
+        struct stat64 entry_info;
+        is_dir = (TEMP_FAILURE_RETRY(fstatat64(dirfd(dir_pointer),
+                                               entry->d_name, &entry_info,
+                                               AT_SYMLINK_NOFOLLOW)) == 0) &&
+                 S_ISDIR(entry_info.st_mode);
+      }
+      if (!report && !is_dir) {
+        continue;
+      }
+      char* child = JoinPath(dir, entry->d_name);
+      if (report) {
+        AddEvent(root->path_id,
+                 FileSystemWatcher::kCreate |
+                     (is_dir ? FileSystemWatcher::kIsDir : 0),
+                 0, is_dir ? strdup(child) : child, true, false);
+      }
+      if (!is_dir) {
+        continue;
+      }
+      if (length == capacity) {
+        capacity *= 2;
+        pending = reinterpret_cast<char**>(
+            realloc(pending, capacity * sizeof(char*)));
+        if (pending == NULL) {
+          OUT_OF_MEMORY();
+        }
+      }
+      pending[length++] = child;
+    }
+    VOID_NO_RETRY_EXPECTED(closedir(dir_pointer));
+    free(dir);
+  }
+  free(pending);
+}
+
+intptr_t InotifyWatches::Watch(const char* path,
+                               uint32_t mask,
+                               bool recursive) {
+  if (recursive) {
+    // New and moved directories have to be picked up.
+    mask |= IN_CREATE | IN_MOVE;
+  }
+  // Adding to the mask keeps the events needed for a directory that is also
+  // below the root of a recursive watch. Events nobody asked for are
+  // filtered out in Dart.
+  int wd = NO_RETRY_EXPECTED(inotify_add_watch(fd_, path, mask | IN_MASK_ADD));
+  if (wd < 0) {
     return -1;
   }
-  return path_id;
+  AddTarget(wd, wd, NULL);
+  WatchRoot* root = RootOf(wd);
+  if (root == NULL) {
+    root = new WatchRoot();
+    root->path_id = wd;
+    root->path = strdup(path);
+    root->mask = 0;
+    root->recursive = false;
+    root->next = roots_;
+    roots_ = root;
+  }
+  root->mask |= mask & ~(IN_DELETE_SELF | IN_MOVE_SELF);
+  if (recursive && !root->recursive) {
+    root->recursive = true;
+    AddSubtree(root, NULL, false);
+  }
+  return wd;
 }
 
-void FileSystemWatcher::UnwatchPath(intptr_t id, intptr_t path_id) {
-  VOID_NO_RETRY_EXPECTED(inotify_rm_watch(id, path_id));
+void InotifyWatches::Unwatch(intptr_t path_id) {
+  RemoveTargets(path_id, NULL);
+  for (WatchRoot** link = &roots_; *link != NULL; link = &(*link)->next) {
+    WatchRoot* root = *link;
+    if (root->path_id == path_id) {
+      *link = root->next;
+      free(root->path);
+      delete root;
+      break;
+    }
+  }
 }
 
-intptr_t FileSystemWatcher::GetSocketId(intptr_t id, intptr_t path_id) {
-  USE(path_id);
-  return id;
+void InotifyWatches::AddEvent(intptr_t path_id,
+                              int mask,
+                              uint32_t cookie,
+                              const char* name,
+                              bool owns_name,
+                              bool moved_to) {
+  const int kChangeMask = FileSystemWatcher::kModifyContent |
+                          FileSystemWatcher::kModefyAttribute |
+                          FileSystemWatcher::kIsDir;
+  if ((mask & ~kChangeMask) == 0) {
+    const intptr_t limit = (events_length_ > kCoalesceWindow)
+                               ? events_length_ - kCoalesceWindow
+                               : 0;
+    for (intptr_t i = events_length_ - 1; i >= limit; i--) {
+      PendingEvent* event = &events_[i];
+      if ((event->path_id == path_id) &&
+          ((event->name == name) || ((event->name != NULL) && (name != NULL) &&
+                                     (strcmp(event->name, name) == 0)))) {
+        if (event->mask == mask) {
+          if (owns_name) {
+            free(const_cast<char*>(name));
+          }
+          return;
+        }
+        break;
+      }
+    }
+  }
+  if (events_length_ == events_capacity_) {
+    events_capacity_ = (events_capacity_ == 0) ? 64 : 2 * events_capacity_;
+    events_ = reinterpret_cast<PendingEvent*>(
+        realloc(events_, events_capacity_ * sizeof(PendingEvent)));
+    if (events_ == NULL) {
+      OUT_OF_MEMORY();
+    }
+  }
+  PendingEvent* event = &events_[events_length_++];
+  event->mask = mask;
+  event->cookie = cookie;
+  event->name = name;
+  event->owns_name = owns_name;
+  event->moved_to = moved_to;
+  event->path_id = path_id;
 }
 
 static int InotifyEventToMask(struct inotify_event* e) {
@@ -100,47 +455,157 @@ static int InotifyEventToMask(struct inotify_event* e) {
   return mask;
 }
 
-Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
-  USE(path_id);
+Dart_Handle InotifyWatches::ReadEvents() {
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
-  uint8_t buffer[kBufferSize];
   intptr_t bytes =
-      SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
+      SocketBase::Read(fd_, buffer_, kBufferSize, SocketBase::kAsync);
   if (bytes < 0) {
     return DartUtils::NewDartOSError();
   }
-  const intptr_t kMaxCount = bytes / kEventSize;
-  Dart_Handle events = Dart_NewList(kMaxCount);
   intptr_t offset = 0;
-  intptr_t i = 0;
   while (offset < bytes) {
     struct inotify_event* e =
-        reinterpret_cast<struct inotify_event*>(buffer + offset);
-    if ((e->mask & IN_IGNORED) == 0) {
+        reinterpret_cast<struct inotify_event*>(buffer_ + offset);
+    offset += kEventSize + e->len;
+    if ((e->mask & IN_IGNORED) != 0) {
+      // The watch is gone, along with the directory it was on.
+      SimpleHashMap::Entry* entry = targets_.Lookup(
+          WatchDescriptorKey(e->wd), static_cast<uint32_t>(e->wd), false);
+      if (entry != NULL) {
+        WatchTarget* target = reinterpret_cast<WatchTarget*>(entry->value);
+        while (target != NULL) {
+          WatchTarget* next = target->next;
+          free(target->prefix);
+          delete target;
+          target = next;
+        }
+        targets_.Remove(WatchDescriptorKey(e->wd),
+                        static_cast<uint32_t>(e->wd));
+      }
+      continue;
+    }
+    const int mask = InotifyEventToMask(e);
+    const char* name = (e->len > 0) ? e->name : NULL;
+    for (WatchTarget* target = TargetsOf(e->wd); target != NULL;
+         target = target->next) {
+      const char* path = name;
+      bool owns_path = false;
+      if (target->prefix != NULL) {
+        // A directory below the root going away is reported by its parent.
+        if ((mask & FileSystemWatcher::kDeleteSelf) != 0) {
+          continue;
+        }
+        path = (name == NULL) ? strdup(target->prefix)
+                              : JoinPath(target->prefix, name);
+        owns_path = true;
+      }
+      AddEvent(target->root, mask, e->cookie, path, owns_path,
+               (e->mask & IN_MOVED_TO) != 0);
+      if ((name == NULL) || ((e->mask & IN_ISDIR) == 0)) {
+        continue;
+      }
+      WatchRoot* root = RootOf(target->root);
+      if ((root == NULL) || !root->recursive) {
+        continue;
+      }
+      char* relative = JoinPath(target->prefix, name);
+      if ((e->mask & IN_MOVED_FROM) != 0) {
+        // Moves within the tree come back with IN_MOVED_TO.
+        RemoveTargets(root->path_id, relative);
+      } else if ((e->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+        AddSubtree(root, relative, (e->mask & IN_CREATE) != 0);
+      }
+      free(relative);
+    }
+  }
+  ASSERT(offset == bytes);
+
+  Dart_Handle events = Dart_NewList(events_length_);
+  Dart_Handle result = events;
+  for (intptr_t i = 0; i < events_length_; i++) {
+    PendingEvent* pending = &events_[i];
+    if (!Dart_IsError(result)) {
       Dart_Handle event = Dart_NewList(5);
-      int mask = InotifyEventToMask(e);
-      Dart_ListSetAt(event, 0, Dart_NewInteger(mask));
-      Dart_ListSetAt(event, 1, Dart_NewInteger(e->cookie));
-      if (e->len > 0) {
+      Dart_ListSetAt(event, 0, Dart_NewInteger(pending->mask));
+      Dart_ListSetAt(event, 1, Dart_NewInteger(pending->cookie));
+      if (pending->name != NULL) {
         Dart_Handle name = Dart_NewStringFromUTF8(
-            reinterpret_cast<uint8_t*>(e->name), strlen(e->name));
+            reinterpret_cast<const uint8_t*>(pending->name),
+            strlen(pending->name));
         if (Dart_IsError(name)) {
-          return name;
+          result = name;
         }
         Dart_ListSetAt(event, 2, name);
       } else {
         Dart_ListSetAt(event, 2, Dart_Null());
       }
-      Dart_ListSetAt(event, 3, Dart_NewBoolean(e->mask & IN_MOVED_TO));
-      Dart_ListSetAt(event, 4, Dart_NewInteger(e->wd));
+      Dart_ListSetAt(event, 3, Dart_NewBoolean(pending->moved_to));
+      Dart_ListSetAt(event, 4, Dart_NewInteger(pending->path_id));
       Dart_ListSetAt(events, i, event);
-      i++;
     }
-    offset += kEventSize + e->len;
+    if (pending->owns_name) {
+      free(const_cast<char*>(pending->name));
+    }
   }
-  ASSERT(offset == bytes);
-  return events;
+  events_length_ = 0;
+  return result;
+}
+
+bool FileSystemWatcher::IsSupported() {
+  return true;
+}
+
+intptr_t FileSystemWatcher::Init() {
+  int id = NO_RETRY_EXPECTED(inotify_init1(IN_CLOEXEC));
+  if (id < 0) {
+    return -1;
+  }
+  // Some systems dosn't support setting this as non-blocking. Since watching
+  // internals are kept away from the user, we know it's possible to continue,
+  // even if setting non-blocking fails.
+  FDUtils::SetNonBlocking(id);
+  return id;
+}
+
+void FileSystemWatcher::Close(intptr_t id) {
+  InotifyWatches::Delete(id);
+}
+
+intptr_t FileSystemWatcher::WatchPath(intptr_t id,
+                                      Namespace* namespc,
+                                      const char* path,
+                                      int events,
+                                      bool recursive) {
+  int list_events = IN_DELETE_SELF | IN_MOVE_SELF;
+  if ((events & kCreate) != 0) {
+    list_events |= IN_CREATE;
+  }
+  if ((events & kModifyContent) != 0) {
+    list_events |= IN_CLOSE_WRITE | IN_ATTRIB;
+  }
+  if ((events & kDelete) != 0) {
+    list_events |= IN_DELETE;
+  }
+  if ((events & kMove) != 0) {
+    list_events |= IN_MOVE;
+  }
+  const char* resolved_path = File::GetCanonicalPath(namespc, path);
+  path = resolved_path != NULL ? resolved_path : path;
+  return InotifyWatches::Get(id)->Watch(path, list_events, recursive);
+}
+
+void FileSystemWatcher::UnwatchPath(intptr_t id, intptr_t path_id) {
+  InotifyWatches::Get(id)->Unwatch(path_id);
+}
+
+intptr_t FileSystemWatcher::GetSocketId(intptr_t id, intptr_t path_id) {
+  USE(path_id);
+  return id;
+}
+
+Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
+  USE(path_id);
+  return InotifyWatches::Get(id)->ReadEvents();
 }
 
 }  // namespace bin
@@ -86,6 +86,9 @@ MappedMemory* File::Map(File::MapType type, int64_t position, int64_t length) {
       prot_final = PAGE_EXECUTE_READ;
       break;
     default:
+      // The file is read into memory rather than mapped, so writes to the
+      // memory could not go to the file.
+      SetLastError(ERROR_NOT_SUPPORTED);
       return NULL;
   }
 
@@ -119,6 +122,11 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  // The file has been read into memory already.
+  USE(advice);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return read(handle_->fd(), buffer, num_bytes);
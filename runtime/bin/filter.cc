@@ -6,6 +6,8 @@
 
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
+#include "bin/thread.h"
 
 #include "include/dart_api.h"
 
@@ -17,6 +19,11 @@ const int kZLibFlagAcceptAnyHeader = 32;
 
 static const int kFilterPointerNativeField = 0;
 
+static const intptr_t kFilterPoolSize = 8;
+static Mutex* filter_pool_mutex = new Mutex();
+static Filter* filter_pool[kFilterPoolSize];
+static intptr_t filter_pool_length = 0;
+
 static Dart_Handle GetFilter(Dart_Handle filter_obj, Filter** filter) {
   ASSERT(filter != NULL);
   Filter* result;
@@ -91,17 +98,25 @@ void FUNCTION_NAME(Filter_CreateZLibInflate)(Dart_NativeArguments args) {
     }
   }
 
-  ZLibInflateFilter* filter = new ZLibInflateFilter(
-      static_cast<int32_t>(window_bits), dictionary, dictionary_length, raw);
+  const int64_t pool_key =
+      (dictionary == NULL)
+          ? ZLibInflateFilter::PoolKey(static_cast<int32_t>(window_bits), raw)
+          : Filter::kNotPooled;
+  Filter* filter = Filter::TakeFromPool(pool_key);
   if (filter == NULL) {
-    delete[] dictionary;
-    Dart_PropagateError(
-        Dart_NewApiError("Could not allocate ZLibInflateFilter"));
-  }
-  if (!filter->Init()) {
-    delete filter;
-    Dart_ThrowException(
-        DartUtils::NewInternalError("Failed to create ZLibInflateFilter"));
+    filter = new ZLibInflateFilter(static_cast<int32_t>(window_bits),
+                                   dictionary, dictionary_length, raw);
+    if (filter == NULL) {
+      delete[] dictionary;
+      Dart_PropagateError(
+          Dart_NewApiError("Could not allocate ZLibInflateFilter"));
+    }
+    if (!filter->Init()) {
+      delete filter;
+      Dart_ThrowException(
+          DartUtils::NewInternalError("Failed to create ZLibInflateFilter"));
+    }
+    filter->set_pool_key(pool_key);
   }
   err = Filter::SetFilterAndCreateFinalizer(
       filter_obj, filter, sizeof(*filter) + dictionary_length);
@@ -145,19 +160,31 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     }
   }
 
-  ZLibDeflateFilter* filter = new ZLibDeflateFilter(
-      gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
-      static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
-      dictionary, dictionary_length, raw);
+  const int64_t pool_key =
+      (dictionary == NULL)
+          ? ZLibDeflateFilter::PoolKey(
+                gzip, static_cast<int32_t>(level),
+                static_cast<int32_t>(window_bits),
+                static_cast<int32_t>(mem_level),
+                static_cast<int32_t>(strategy), raw)
+          : Filter::kNotPooled;
+  Filter* filter = Filter::TakeFromPool(pool_key);
   if (filter == NULL) {
-    delete[] dictionary;
-    Dart_PropagateError(
-        Dart_NewApiError("Could not allocate ZLibDeflateFilter"));
-  }
-  if (!filter->Init()) {
-    delete filter;
-    Dart_ThrowException(
-        DartUtils::NewInternalError("Failed to create ZLibDeflateFilter"));
+    filter = new ZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
+        dictionary, dictionary_length, raw);
+    if (filter == NULL) {
+      delete[] dictionary;
+      Dart_PropagateError(
+          Dart_NewApiError("Could not allocate ZLibDeflateFilter"));
+    }
+    if (!filter->Init()) {
+      delete filter;
+      Dart_ThrowException(
+          DartUtils::NewInternalError("Failed to create ZLibDeflateFilter"));
+    }
+    filter->set_pool_key(pool_key);
   }
   Dart_Handle result = Filter::SetFilterAndCreateFinalizer(
       filter_obj, filter, sizeof(*filter) + dictionary_length);
@@ -183,9 +210,19 @@ void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
     Dart_PropagateError(err);
   }
 
+  // External typed data does not move, and the Dart side keeps it alive
+  // until the filter is done with it, so it is read in place.
+  bool owned = true;
+  const Dart_TypedData_Type external_type =
+      Dart_GetTypeOfExternalTypedData(data_obj);
   Dart_Handle result = Dart_TypedDataAcquireData(
       data_obj, &type, reinterpret_cast<void**>(&buffer), &length);
-  if (!Dart_IsError(result)) {
+  if (!Dart_IsError(result) && ((external_type == Dart_TypedData_kUint8) ||
+                                (external_type == Dart_TypedData_kInt8))) {
+    Dart_TypedDataReleaseData(data_obj);
+    buffer += start;
+    owned = false;
+  } else if (!Dart_IsError(result)) {
     ASSERT(type == Dart_TypedData_kUint8 || type == Dart_TypedData_kInt8);
     if (type != Dart_TypedData_kUint8 && type != Dart_TypedData_kInt8) {
       Dart_TypedDataReleaseData(data_obj);
@@ -216,9 +253,11 @@ void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
       Dart_PropagateError(err);
     }
   }
-  // Process will take ownership of buffer, if successful.
-  if (!filter->Process(buffer, chunk_length)) {
-    delete[] buffer;
+  // Process will take ownership of an owned buffer, if successful.
+  if (!filter->Process(buffer, chunk_length, owned)) {
+    if (owned) {
+      delete[] buffer;
+    }
     Dart_ThrowException(DartUtils::NewInternalError(
         "Call to Process while still processing data"));
   }
@@ -259,6 +298,39 @@ static void DeleteFilter(void* isolate_data,
                          Dart_WeakPersistentHandle handle,
                          void* filter_pointer) {
   Filter* filter = reinterpret_cast<Filter*>(filter_pointer);
+  Filter::Dispose(filter);
+}
+
+Filter* Filter::TakeFromPool(int64_t pool_key) {
+  if (pool_key == kNotPooled) {
+    return NULL;
+  }
+  Filter* filter = NULL;
+  {
+    MutexLocker ml(filter_pool_mutex);
+    for (intptr_t i = filter_pool_length - 1; i >= 0; i--) {
+      if (filter_pool[i]->pool_key() == pool_key) {
+        filter = filter_pool[i];
+        filter_pool[i] = filter_pool[--filter_pool_length];
+        break;
+      }
+    }
+  }
+  if ((filter != NULL) && !filter->Reset()) {
+    delete filter;
+    return NULL;
+  }
+  return filter;
+}
+
+void Filter::Dispose(Filter* filter) {
+  if ((filter->pool_key() != kNotPooled) && filter->initialized()) {
+    MutexLocker ml(filter_pool_mutex);
+    if (filter_pool_length < kFilterPoolSize) {
+      filter_pool[filter_pool_length++] = filter;
+      return;
+    }
+  }
   delete filter;
 }
 
@@ -283,9 +355,37 @@ Dart_Handle Filter::GetFilterNativeField(Dart_Handle filter,
       reinterpret_cast<intptr_t*>(filter_pointer));
 }
 
+// Pool keys pack the settings into bit fields, which zlib's valid ranges
+// fit in. Filters with settings outside of those are simply not pooled.
+static const int kPoolKeyFieldBits = 5;
+static const int64_t kInflatePoolKeyBit = static_cast<int64_t>(1) << 40;
+
+static bool AddToPoolKey(int64_t* key, int32_t value) {
+  if ((value < 0) || (value >= (1 << kPoolKeyFieldBits))) {
+    return false;
+  }
+  *key = (*key << kPoolKeyFieldBits) | value;
+  return true;
+}
+
+int64_t ZLibDeflateFilter::PoolKey(bool gzip,
+                                   int32_t level,
+                                   int32_t window_bits,
+                                   int32_t mem_level,
+                                   int32_t strategy,
+                                   bool raw) {
+  int64_t key = 0;
+  if (!AddToPoolKey(&key, (gzip ? 2 : 0) | (raw ? 1 : 0)) ||
+      !AddToPoolKey(&key, level + 1) || !AddToPoolKey(&key, window_bits) ||
+      !AddToPoolKey(&key, mem_level) || !AddToPoolKey(&key, strategy)) {
+    return kNotPooled;
+  }
+  return key;
+}
+
 ZLibDeflateFilter::~ZLibDeflateFilter() {
   delete[] dictionary_;
-  delete[] current_buffer_;
+  FreeCurrentBuffer();
   if (initialized()) {
     deflateEnd(&stream_);
   }
@@ -329,15 +429,31 @@ bool ZLibDeflateFilter::Init() {
   return true;
 }
 
-bool ZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
+bool ZLibDeflateFilter::Process(uint8_t* data, intptr_t length, bool owned) {
   if (current_buffer_ != NULL) {
     return false;
   }
   stream_.avail_in = length;
   stream_.next_in = current_buffer_ = data;
+  owns_current_buffer_ = owned;
   return true;
 }
 
+bool ZLibDeflateFilter::Reset() {
+  FreeCurrentBuffer();
+  stream_.next_in = Z_NULL;
+  stream_.avail_in = 0;
+  return deflateReset(&stream_) == Z_OK;
+}
+
+void ZLibDeflateFilter::FreeCurrentBuffer() {
+  if (owns_current_buffer_) {
+    delete[] current_buffer_;
+  }
+  current_buffer_ = NULL;
+  owns_current_buffer_ = false;
+}
+
 intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush,
@@ -362,15 +478,22 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
       error = true;
   }
 
-  delete[] current_buffer_;
-  current_buffer_ = NULL;
+  FreeCurrentBuffer();
   // Either 0 Byte processed or error
   return error ? -1 : 0;
 }
 
+int64_t ZLibInflateFilter::PoolKey(int32_t window_bits, bool raw) {
+  int64_t key = 0;
+  if (!AddToPoolKey(&key, raw ? 1 : 0) || !AddToPoolKey(&key, window_bits)) {
+    return kNotPooled;
+  }
+  return key | kInflatePoolKeyBit;
+}
+
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
-  delete[] current_buffer_;
+  FreeCurrentBuffer();
   if (initialized()) {
     inflateEnd(&stream_);
   }
@@ -393,15 +516,31 @@ bool ZLibInflateFilter::Init() {
   return true;
 }
 
-bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
+bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length, bool owned) {
   if (current_buffer_ != NULL) {
     return false;
   }
   stream_.avail_in = length;
   stream_.next_in = current_buffer_ = data;
+  owns_current_buffer_ = owned;
   return true;
 }
 
+bool ZLibInflateFilter::Reset() {
+  FreeCurrentBuffer();
+  stream_.next_in = Z_NULL;
+  stream_.avail_in = 0;
+  return inflateReset(&stream_) == Z_OK;
+}
+
+void ZLibInflateFilter::FreeCurrentBuffer() {
+  if (owns_current_buffer_) {
+    delete[] current_buffer_;
+  }
+  current_buffer_ = NULL;
+  owns_current_buffer_ = false;
+}
+
 intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush,
@@ -445,8 +584,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
       error = true;
   }
 
-  delete[] current_buffer_;
-  current_buffer_ = NULL;
+  FreeCurrentBuffer();
   // Either 0 Byte processed or error
   return error ? -1 : 0;
 }
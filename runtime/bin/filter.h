@@ -20,16 +20,34 @@ class Filter {
   virtual bool Init() = 0;
 
   /**
-   * On a successful call to Process, Process will take ownership of data. On
-   * successive calls to either Processed or ~Filter, data will be freed with
-   * a delete[] call.
+   * On a successful call to Process, Process will take ownership of data if
+   * |owned| is true. On successive calls to either Processed or ~Filter,
+   * owned data will be freed with a delete[] call. Data which is not owned
+   * must stay valid until Processed has returned 0 or an error.
    */
-  virtual bool Process(uint8_t* data, intptr_t length) = 0;
+  virtual bool Process(uint8_t* data, intptr_t length, bool owned) = 0;
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
                              bool end) = 0;
 
+  // Prepares the filter for a new stream with the same settings. Returns
+  // false if that fails.
+  virtual bool Reset() = 0;
+
+  // Filters created without a dictionary are kept in a pool when their Dart
+  // object is collected, and handed out again for the next stream with the
+  // same settings. That saves setting up zlib's window and tables, which
+  // for deflate take up several hundred KB, for every stream. |pool_key|
+  // identifies the settings of a filter, or is kNotPooled.
+  static const int64_t kNotPooled = -1;
+
+  // Returns a reset filter with the given key from the pool, or NULL.
+  static Filter* TakeFromPool(int64_t pool_key);
+
+  // Puts |filter| back in the pool if it can be reused, or deletes it.
+  static void Dispose(Filter* filter);
+
   static Dart_Handle SetFilterAndCreateFinalizer(Dart_Handle filter,
                                                  Filter* filter_pointer,
                                                  intptr_t filter_size);
@@ -38,16 +56,19 @@ class Filter {
 
   bool initialized() const { return initialized_; }
   void set_initialized(bool value) { initialized_ = value; }
+  int64_t pool_key() const { return pool_key_; }
+  void set_pool_key(int64_t value) { pool_key_ = value; }
   uint8_t* processed_buffer() { return processed_buffer_; }
   intptr_t processed_buffer_size() const { return kFilterBufferSize; }
 
  protected:
-  Filter() : initialized_(false) {}
+  Filter() : initialized_(false), pool_key_(kNotPooled) {}
 
  private:
   static const intptr_t kFilterBufferSize = 64 * KB;
   uint8_t processed_buffer_[kFilterBufferSize];
   bool initialized_;
+  int64_t pool_key_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
 };
@@ -70,15 +91,24 @@ class ZLibDeflateFilter : public Filter {
         dictionary_(dictionary),
         dictionary_length_(dictionary_length),
         raw_(raw),
-        current_buffer_(NULL) {}
+        current_buffer_(NULL),
+        owns_current_buffer_(false) {}
   virtual ~ZLibDeflateFilter();
 
+  static int64_t PoolKey(bool gzip,
+                         int32_t level,
+                         int32_t window_bits,
+                         int32_t mem_level,
+                         int32_t strategy,
+                         bool raw);
+
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual bool Process(uint8_t* data, intptr_t length, bool owned);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
                              bool end);
+  virtual bool Reset();
 
  private:
   const bool gzip_;
@@ -90,8 +120,11 @@ class ZLibDeflateFilter : public Filter {
   const intptr_t dictionary_length_;
   const bool raw_;
   uint8_t* current_buffer_;
+  bool owns_current_buffer_;
   z_stream stream_;
 
+  void FreeCurrentBuffer();
+
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
 };
 
@@ -105,15 +138,19 @@ class ZLibInflateFilter : public Filter {
         dictionary_(dictionary),
         dictionary_length_(dictionary_length),
         raw_(raw),
-        current_buffer_(NULL) {}
+        current_buffer_(NULL),
+        owns_current_buffer_(false) {}
   virtual ~ZLibInflateFilter();
 
+  static int64_t PoolKey(int32_t window_bits, bool raw);
+
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual bool Process(uint8_t* data, intptr_t length, bool owned);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
                              bool end);
+  virtual bool Reset();
 
  private:
   const int32_t window_bits_;
@@ -121,8 +158,11 @@ class ZLibInflateFilter : public Filter {
   const intptr_t dictionary_length_;
   const bool raw_;
   uint8_t* current_buffer_;
+  bool owns_current_buffer_;
   z_stream stream_;
 
+  void FreeCurrentBuffer();
+
   DISALLOW_COPY_AND_ASSIGN(ZLibInflateFilter);
 };
 
@@ -5,10 +5,24 @@
 // part of "common_patch.dart";
 
 class _FilterImpl extends NativeFieldWrapperClass1 implements RawZLibFilter {
-  void process(List<int> data, int start, int end) native "Filter_Process";
+  // External typed data is read in place by the native filter, so the data
+  // passed to process is kept alive until all of it has been processed.
+  List<int> _input;
 
-  List<int> processed({bool flush: true, bool end: false})
-      native "Filter_Processed";
+  void process(List<int> data, int start, int end) {
+    _process(data, start, end);
+    _input = data;
+  }
+
+  List<int> processed({bool flush: true, bool end: false}) {
+    List<int> result = _processed(flush, end);
+    if (result == null) _input = null;
+    return result;
+  }
+
+  void _process(List<int> data, int start, int end) native "Filter_Process";
+
+  List<int> _processed(bool flush, bool end) native "Filter_Processed";
 }
 
 class _ZLibInflateFilter extends _FilterImpl {
@@ -83,6 +83,7 @@ enum SnapshotKind {
   kAppJIT,
   kAppAOTBlobs,
   kAppAOTAssembly,
+  kAppAOTElf,
   kVMAOTAssembly,
 };
 static SnapshotKind snapshot_kind = kCore;
@@ -96,6 +97,7 @@ static const char* kSnapshotKindNames[] = {
     "app-jit",
     "app-aot-blobs",
     "app-aot-assembly",
+    "app-aot-elf",
     "vm-aot-assembly",
     NULL,
     // clang-format on
@@ -117,6 +119,7 @@ static const char* kSnapshotKindNames[] = {
   V(reused_instructions, reused_instructions_filename)                         \
   V(blobs_container_filename, blobs_container_filename)                        \
   V(assembly, assembly_filename)                                               \
+  V(elf, elf_filename)                                                         \
   V(load_compilation_trace, load_compilation_trace_filename)                   \
   V(load_type_feedback, load_type_feedback_filename)                           \
   V(save_obfuscation_map, obfuscation_map_filename)
@@ -125,6 +128,7 @@ static const char* kSnapshotKindNames[] = {
   V(read_all_bytecode, read_all_bytecode)                                      \
   V(compile_all, compile_all)                                                  \
   V(obfuscate, obfuscate)                                                      \
+  V(compress_data_sections, compress_data_sections)                            \
   V(verbose, verbose)                                                          \
   V(version, version)                                                          \
   V(help, help)
@@ -147,7 +151,7 @@ DEFINE_CB_OPTION(ProcessEnvironmentOption);
 static bool IsSnapshottingForPrecompilation() {
   return (snapshot_kind == kAppAOTBlobs) ||
          (snapshot_kind == kAppAOTAssembly) ||
-         (snapshot_kind == kVMAOTAssembly);
+         (snapshot_kind == kAppAOTElf) || (snapshot_kind == kVMAOTAssembly);
 }
 
 // clang-format off
@@ -176,6 +180,7 @@ static void PrintUsage() {
 "--isolate_snapshot_instructions=<output-file>                               \n"
 "[--obfuscate]                                                               \n"
 "[--save-obfuscation-map=<map-filename>]                                     \n"
+"[--load_type_feedback=<feedback-file>]                                      \n"
 "<dart-kernel-file>                                                          \n"
 "                                                                            \n"
 "To create an AOT application snapshot as assembly suitable for compilation  \n"
@@ -184,6 +189,16 @@ static void PrintUsage() {
 "--assembly=<output-file>                                                    \n"
 "[--obfuscate]                                                               \n"
 "[--save-obfuscation-map=<map-filename>]                                     \n"
+"[--load_type_feedback=<feedback-file>]                                      \n"
+"<dart-kernel-file>                                                          \n"
+"                                                                            \n"
+"To create an AOT application snapshot as an ELF shared library suitable for \n"
+"loading with dlopen, without an assembler or linker:                        \n"
+"--snapshot_kind=app-aot-elf                                                 \n"
+"--elf=<output-file>                                                         \n"
+"[--obfuscate]                                                               \n"
+"[--save-obfuscation-map=<map-filename>]                                     \n"
+"[--load_type_feedback=<feedback-file>]                                      \n"
 "<dart-kernel-file>                                                          \n"
 "                                                                            \n"
 "AOT snapshots can be obfuscated: that is all identifiers will be renamed    \n"
@@ -192,6 +207,18 @@ static void PrintUsage() {
 "using --save-obfuscation-map=<filename> option. See dartbug.com/30524       \n"
 "for implementation details and limitations of the obfuscation pass.         \n"
 "                                                                            \n"
+"AOT snapshots can use type feedback saved from a JIT training run with     \n"
+"--save_type_feedback=<filename>: hot polymorphic call sites are then       \n"
+"devirtualized and inlined for the receiver classes observed in the run.    \n"
+"                                                                            \n"
+"The startup code of an AOT snapshot can be placed together at the start of \n"
+"the instructions image with --instructions_order=<filename>, using the     \n"
+"order recorded by a JIT run with --write_startup_order_to=<filename>.      \n"
+"                                                                            \n"
+"An AOT snapshot written with --blobs_container_filename can have its data  \n"
+"sections compressed with --compress_data_sections. They are decompressed   \n"
+"in parallel when the snapshot is loaded.                                   \n"
+"                                                                            \n"
 "\n");
   if (verbose) {
     Syslog::PrintErr(
@@ -324,6 +351,15 @@ static int ParseArguments(int argc,
       }
       break;
     }
+    case kAppAOTElf: {
+      if (elf_filename == NULL) {
+        Syslog::PrintErr(
+            "Building an AOT snapshot as ELF requires specifying "
+            "an output file for --elf.\n\n");
+        return -1;
+      }
+      break;
+    }
     case kVMAOTAssembly: {
       if (assembly_filename == NULL) {
         Syslog::PrintErr(
@@ -428,8 +464,11 @@ static void MaybeLoadCode() {
     CHECK_RESULT(result);
   }
 
+  // When precompiling, the feedback guides the precompiler's inlining and
+  // devirtualization instead of compiling functions right away.
   if ((load_type_feedback_filename != NULL) &&
-      ((snapshot_kind == kCoreJIT) || (snapshot_kind == kAppJIT))) {
+      ((snapshot_kind == kCoreJIT) || (snapshot_kind == kAppJIT) ||
+       IsSnapshottingForPrecompilation())) {
     uint8_t* buffer = NULL;
     intptr_t size = 0;
     ReadFile(load_type_feedback_filename, &buffer, &size);
@@ -620,6 +659,11 @@ static void CreateAndWritePrecompiledSnapshot() {
     RefCntReleaseScope<File> rs(file);
     result = Dart_CreateAppAOTSnapshotAsAssembly(StreamingWriteCallback, file);
     CHECK_RESULT(result);
+  } else if (snapshot_kind == kAppAOTElf) {
+    File* file = OpenFile(elf_filename);
+    RefCntReleaseScope<File> rs(file);
+    result = Dart_CreateAppAOTSnapshotAsElf(StreamingWriteCallback, file);
+    CHECK_RESULT(result);
   } else {
     ASSERT(snapshot_kind == kAppAOTBlobs);
 
@@ -674,7 +718,7 @@ static void CreateAndWritePrecompiledSnapshot() {
           vm_snapshot_data_size, vm_snapshot_instructions_buffer,
           vm_snapshot_instructions_size, isolate_snapshot_data_buffer,
           isolate_snapshot_data_size, isolate_snapshot_instructions_buffer,
-          isolate_snapshot_instructions_size);
+          isolate_snapshot_instructions_size, compress_data_sections);
     } else {
       WriteFile(vm_snapshot_data_filename, vm_snapshot_data_buffer,
                 vm_snapshot_data_size);
@@ -779,6 +823,7 @@ static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs) {
       break;
     case kAppAOTBlobs:
     case kAppAOTAssembly:
+    case kAppAOTElf:
       CreateAndWritePrecompiledSnapshot();
       break;
     case kVMAOTAssembly: {
@@ -11,6 +11,38 @@
 namespace dart {
 namespace bin {
 
+void Compress(const uint8_t* input,
+              intptr_t input_len,
+              uint8_t** output,
+              intptr_t* output_length) {
+  ASSERT(input != NULL);
+  ASSERT(input_len >= 0);
+  ASSERT(input_len <= kMaxUint32);
+  ASSERT(output != NULL);
+  ASSERT(output_length != NULL);
+
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  int ret = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  ASSERT(ret == Z_OK);
+
+  const intptr_t output_capacity = deflateBound(&strm, input_len);
+  *output = reinterpret_cast<uint8_t*>(malloc(output_capacity));
+  strm.avail_in = input_len;
+  strm.next_in = const_cast<uint8_t*>(input);
+  strm.avail_out = output_capacity;
+  strm.next_out = *output;
+  // The output buffer is large enough to finish in one call.
+  ret = deflate(&strm, Z_FINISH);
+  ASSERT(ret == Z_STREAM_END);
+  *output_length = output_capacity - strm.avail_out;
+
+  deflateEnd(&strm);
+}
+
 void Decompress(const uint8_t* input,
                 intptr_t input_len,
                 uint8_t** output,
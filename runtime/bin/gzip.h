@@ -10,6 +10,13 @@
 namespace dart {
 namespace bin {
 
+// Compresses |input| into a gzip stream. This function allocates the output
+// buffer in the C heap and the caller is responsible for freeing it.
+void Compress(const uint8_t* input,
+              intptr_t input_len,
+              uint8_t** output,
+              intptr_t* output_length);
+
 // |input| is assumed to be a gzipped stream.
 // This function allocates the output buffer in the C heap and the caller
 // is responsible for freeing it.
@@ -0,0 +1,163 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/host_lookup_cache.h"
+
+#include "bin/lockers.h"
+#include "bin/thread.h"
+#include "bin/utils.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+Monitor* HostLookupCache::monitor_ = new Monitor();
+SimpleHashMap* HostLookupCache::entries_ =
+    new SimpleHashMap(&HostLookupCache::SameEntry, 16);
+HostLookupCache::Entry* HostLookupCache::head_ = NULL;
+HostLookupCache::Entry* HostLookupCache::tail_ = NULL;
+
+bool HostLookupCache::SameEntry(void* key1, void* key2) {
+  Entry* entry1 = reinterpret_cast<Entry*>(key1);
+  Entry* entry2 = reinterpret_cast<Entry*>(key2);
+  return (entry1->type == entry2->type) &&
+         (strcmp(entry1->host, entry2->host) == 0);
+}
+
+uint32_t HostLookupCache::EntryHash(int type, const char* host) {
+  uint32_t hash = Utils::StringHash(host, strlen(host));
+  return hash ^ Utils::WordHash(type);
+}
+
+AddressList<SocketAddress>* HostLookupCache::Copy(
+    const AddressList<SocketAddress>* addresses) {
+  AddressList<SocketAddress>* copy =
+      new AddressList<SocketAddress>(addresses->count());
+  for (intptr_t i = 0; i < addresses->count(); i++) {
+    RawAddr raw = addresses->GetAt(i)->addr();
+    copy->SetAt(i, new SocketAddress(&raw.addr));
+  }
+  return copy;
+}
+
+HostLookupCache::Entry* HostLookupCache::Find(int type,
+                                              const char* host,
+                                              uint32_t hash) {
+  Entry key;
+  key.type = type;
+  key.host = const_cast<char*>(host);
+  SimpleHashMap::Entry* map_entry = entries_->Lookup(&key, hash, false);
+  return (map_entry == NULL) ? NULL : reinterpret_cast<Entry*>(map_entry->key);
+}
+
+void HostLookupCache::Unlink(Entry* entry) {
+  if (entry->prev == NULL) {
+    head_ = entry->next;
+  } else {
+    entry->prev->next = entry->next;
+  }
+  if (entry->next == NULL) {
+    tail_ = entry->prev;
+  } else {
+    entry->next->prev = entry->prev;
+  }
+}
+
+void HostLookupCache::PushFront(Entry* entry) {
+  entry->prev = NULL;
+  entry->next = head_;
+  if (head_ == NULL) {
+    tail_ = entry;
+  } else {
+    head_->prev = entry;
+  }
+  head_ = entry;
+}
+
+void HostLookupCache::Delete(Entry* entry, uint32_t hash) {
+  Unlink(entry);
+  entries_->Remove(entry, hash);
+  delete entry->addresses;
+  free(entry->host);
+  delete entry;
+}
+
+AddressList<SocketAddress>* HostLookupCache::Lookup(const char* host,
+                                                    int type,
+                                                    OSError** os_error) {
+  const uint32_t hash = EntryHash(type, host);
+  {
+    MonitorLocker ml(monitor_);
+    while (true) {
+      Entry* entry = Find(type, host, hash);
+      if (entry == NULL) {
+        entry = new Entry();
+        entry->type = type;
+        entry->host = strdup(host);
+        entry->addresses = NULL;
+        entry->expires = 0;
+        entry->resolving = true;
+        SimpleHashMap::Entry* map_entry = entries_->Lookup(entry, hash, true);
+        ASSERT(map_entry->key == entry);
+        PushFront(entry);
+        // Entries being resolved have waiters, so they are not dropped.
+        for (Entry* last = tail_;
+             (entries_->size() > kMaxEntries) && (last != NULL);) {
+          Entry* prev = last->prev;
+          if (!last->resolving) {
+            Delete(last, EntryHash(last->type, last->host));
+          }
+          last = prev;
+        }
+        break;
+      }
+      if (entry->resolving) {
+        ml.Wait();
+        continue;
+      }
+      Unlink(entry);
+      PushFront(entry);
+      if (entry->expires > TimerUtils::GetCurrentMonotonicMillis()) {
+        return Copy(entry->addresses);
+      }
+      entry->resolving = true;
+      break;
+    }
+  }
+
+  AddressList<SocketAddress>* addresses =
+      SocketBase::LookupAddress(host, type, os_error);
+
+  MonitorLocker ml(monitor_);
+  Entry* entry = Find(type, host, hash);
+  ASSERT((entry != NULL) && entry->resolving);
+  if (addresses == NULL) {
+    // Waiters find no entry and resolve the name themselves.
+    Delete(entry, hash);
+  } else {
+    delete entry->addresses;
+    entry->addresses = Copy(addresses);
+    entry->expires =
+        TimerUtils::GetCurrentMonotonicMillis() + kTimeToLiveMillis;
+    entry->resolving = false;
+  }
+  ml.NotifyAll();
+  return addresses;
+}
+
+AddressList<SocketAddress>* HostLookupCache::LookupCached(const char* host,
+                                                          int type) {
+  MonitorLocker ml(monitor_);
+  Entry* entry = Find(type, host, EntryHash(type, host));
+  if ((entry == NULL) || entry->resolving ||
+      (entry->expires <= TimerUtils::GetCurrentMonotonicMillis())) {
+    return NULL;
+  }
+  Unlink(entry);
+  PushFront(entry);
+  return Copy(entry->addresses);
+}
+
+}  // namespace bin
+}  // namespace dart
@@ -0,0 +1,76 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_HOST_LOOKUP_CACHE_H_
+#define RUNTIME_BIN_HOST_LOOKUP_CACHE_H_
+
+#include "bin/socket_base.h"
+#include "platform/globals.h"
+#include "platform/hashmap.h"
+
+namespace dart {
+namespace bin {
+
+// Forward declaration.
+class Monitor;
+
+// A process-wide cache of host name lookups, shared by all isolates.
+//
+// getaddrinfo does not tell how long its answers may be kept, so successful
+// lookups are kept for kTimeToLiveMillis, which is short enough to follow
+// DNS changes in practice. Failed lookups are not cached. A lookup that
+// misses while the same name is already being resolved waits for that
+// answer instead of calling getaddrinfo again. The least recently used
+// entry is dropped once the cache holds kMaxEntries.
+class HostLookupCache {
+ public:
+  static const intptr_t kMaxEntries = 256;
+  static const int64_t kTimeToLiveMillis = 30 * 1000;
+
+  // Returns the addresses of |host| for the given address type, resolving
+  // it unless the cache has a fresh answer. Blocks, so it is only called
+  // on IO service threads and for synchronous sockets.
+  static AddressList<SocketAddress>* Lookup(const char* host,
+                                            int type,
+                                            OSError** os_error);
+
+  // Returns the cached addresses of |host|, or NULL without blocking if
+  // there is no fresh answer yet.
+  static AddressList<SocketAddress>* LookupCached(const char* host, int type);
+
+ private:
+  struct Entry {
+    int type;
+    char* host;
+    AddressList<SocketAddress>* addresses;
+    int64_t expires;
+    bool resolving;
+    Entry* prev;  // Towards the most recently used entry.
+    Entry* next;
+  };
+
+  static bool SameEntry(void* key1, void* key2);
+  static uint32_t EntryHash(int type, const char* host);
+  static AddressList<SocketAddress>* Copy(
+      const AddressList<SocketAddress>* addresses);
+
+  // These require the lock.
+  static Entry* Find(int type, const char* host, uint32_t hash);
+  static void Unlink(Entry* entry);
+  static void PushFront(Entry* entry);
+  static void Delete(Entry* entry, uint32_t hash);
+
+  static Monitor* monitor_;
+  static SimpleHashMap* entries_;
+  static Entry* head_;
+  static Entry* tail_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(HostLookupCache);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_HOST_LOOKUP_CACHE_H_
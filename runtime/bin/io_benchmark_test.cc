@@ -0,0 +1,352 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Benchmarks for the native code behind dart:io. They drive the same entry
+// points the natives use, without the Dart side, so that the scores only
+// move with the native hot paths.
+
+#include "bin/dartutils.h"
+#include "bin/directory.h"
+#include "bin/file.h"
+#include "bin/filter.h"
+#include "bin/socket.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "platform/utils.h"
+#include "vm/benchmark_test.h"
+#include "vm/growable_array.h"
+#include "vm/os.h"
+
+using dart::bin::Directory;
+using dart::bin::File;
+using dart::bin::Filter;
+using dart::bin::ZLibDeflateFilter;
+using dart::bin::ZLibInflateFilter;
+
+namespace dart {
+
+static int CompareLatencies(const int64_t* a, const int64_t* b) {
+  return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+}
+
+// Returns the 99th percentile of the given latencies, which are sorted.
+static int64_t P99(MallocGrowableArray<int64_t>* latencies) {
+  ASSERT(latencies->length() > 0);
+  latencies->Sort(CompareLatencies);
+  return latencies->At((latencies->length() * 99) / 100);
+}
+
+// Writes a temporary file of the given size and returns its path.
+static const char* CreateBenchmarkFile(intptr_t size) {
+  const char* system_temp = Directory::SystemTemp(NULL);
+  EXPECT_NOTNULL(system_temp);
+  const intptr_t len = strlen(system_temp) + 32;
+  char* path = bin::DartUtils::ScopedCString(len);
+  Utils::SNPrint(path, len, "%s/dart_io_benchmark", system_temp);
+  File* file = File::Open(NULL, path, File::kWriteTruncate);
+  EXPECT(file != NULL);
+  const intptr_t kChunkSize = 64 * KB;
+  uint8_t* chunk = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  for (intptr_t i = 0; i < kChunkSize; i++) {
+    chunk[i] = static_cast<uint8_t>(i * 31);
+  }
+  for (intptr_t written = 0; written < size; written += kChunkSize) {
+    EXPECT(file->WriteFully(chunk, kChunkSize));
+  }
+  free(chunk);
+  file->Release();
+  return path;
+}
+
+//
+// Measure reading a 16MB file sequentially in 64KB chunks, as
+// File.readAsBytes does. The score is inversely proportional to bytes/s.
+//
+BENCHMARK(IOFileSequentialRead) {
+  const intptr_t kFileSize = 16 * MB;
+  const intptr_t kChunkSize = 64 * KB;
+  const intptr_t kNumIterations = 10;
+  const char* path = CreateBenchmarkFile(kFileSize);
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    File* file = File::Open(NULL, path, File::kRead);
+    EXPECT(file != NULL);
+    for (intptr_t read = 0; read < kFileSize; read += kChunkSize) {
+      EXPECT(file->ReadFully(buffer, kChunkSize));
+    }
+    file->Release();
+  }
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  free(buffer);
+  File::Delete(NULL, path);
+}
+
+// Reads 4KB blocks at pseudo-random positions of a 16MB file, as
+// RandomAccessFile.setPosition followed by readInto does, and records the
+// latency of each read.
+static void RandomRead(MallocGrowableArray<int64_t>* latencies,
+                       int64_t* total) {
+  const intptr_t kFileSize = 16 * MB;
+  const intptr_t kBlockSize = 4 * KB;
+  const intptr_t kNumReads = 10000;
+  const char* path = CreateBenchmarkFile(kFileSize);
+  uint8_t buffer[kBlockSize];
+  File* file = File::Open(NULL, path, File::kRead);
+  EXPECT(file != NULL);
+  uint32_t seed = 42;
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < kNumReads; i++) {
+    seed = seed * 1103515245 + 12345;
+    const int64_t block = (seed >> 8) % (kFileSize / kBlockSize);
+    const int64_t before = OS::GetCurrentMonotonicMicros();
+    EXPECT(file->SetPosition(block * kBlockSize));
+    EXPECT(file->ReadFully(buffer, kBlockSize));
+    latencies->Add(OS::GetCurrentMonotonicMicros() - before);
+  }
+  *total = OS::GetCurrentMonotonicMicros() - start;
+  file->Release();
+  File::Delete(NULL, path);
+}
+
+BENCHMARK(IOFileRandomRead) {
+  MallocGrowableArray<int64_t> latencies;
+  int64_t total = 0;
+  RandomRead(&latencies, &total);
+  benchmark->set_score(total);
+}
+
+BENCHMARK(IOFileRandomReadP99) {
+  MallocGrowableArray<int64_t> latencies;
+  int64_t total = 0;
+  RandomRead(&latencies, &total);
+  benchmark->set_score(P99(&latencies));
+}
+
+// Runs the data through the filter the way Filter_Process and
+// Filter_Processed are called by the ZLibEncoder and ZLibDecoder sinks, and
+// returns the output.
+static MallocGrowableArray<uint8_t>* RunFilter(Filter* filter,
+                                               uint8_t* data,
+                                               intptr_t length) {
+  const intptr_t kChunkSize = 64 * KB;
+  MallocGrowableArray<uint8_t>* output = new MallocGrowableArray<uint8_t>();
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  for (intptr_t offset = 0; offset < length; offset += kChunkSize) {
+    const intptr_t size = Utils::Minimum(kChunkSize, length - offset);
+    EXPECT(filter->Process(data + offset, size, false));
+    const bool end = (offset + size) == length;
+    intptr_t processed;
+    while ((processed = filter->Processed(buffer, kChunkSize, end, end)) > 0) {
+      for (intptr_t i = 0; i < processed; i++) {
+        output->Add(buffer[i]);
+      }
+    }
+    EXPECT(processed == 0);
+  }
+  free(buffer);
+  return output;
+}
+
+static uint8_t* CreateCompressibleData(intptr_t length) {
+  uint8_t* data = reinterpret_cast<uint8_t*>(malloc(length));
+  uint32_t seed = 42;
+  for (intptr_t i = 0; i < length; i++) {
+    // Mostly text-like, with some noise.
+    seed = seed * 1103515245 + 12345;
+    data[i] = ((seed >> 16) % 8 == 0) ? (seed >> 24) : 'a' + (i % 26);
+  }
+  return data;
+}
+
+//
+// Measure compressing 8MB with the default ZLibCodec settings. The score is
+// inversely proportional to bytes/s.
+//
+BENCHMARK(IOZLibDeflate) {
+  const intptr_t kDataSize = 8 * MB;
+  uint8_t* data = CreateCompressibleData(kDataSize);
+  ZLibDeflateFilter filter(false, 6, 15, 8, 0, NULL, 0, false);
+  EXPECT(filter.Init());
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  MallocGrowableArray<uint8_t>* compressed =
+      RunFilter(&filter, data, kDataSize);
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  delete compressed;
+  free(data);
+}
+
+//
+// Measure decompressing the output of IOZLibDeflate. The score is inversely
+// proportional to bytes/s.
+//
+BENCHMARK(IOZLibInflate) {
+  const intptr_t kDataSize = 8 * MB;
+  uint8_t* data = CreateCompressibleData(kDataSize);
+  ZLibDeflateFilter deflate(false, 6, 15, 8, 0, NULL, 0, false);
+  EXPECT(deflate.Init());
+  MallocGrowableArray<uint8_t>* compressed =
+      RunFilter(&deflate, data, kDataSize);
+  ZLibInflateFilter inflate(15, NULL, 0, false);
+  EXPECT(inflate.Init());
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  MallocGrowableArray<uint8_t>* decompressed =
+      RunFilter(&inflate, compressed->data(), compressed->length());
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  EXPECT_EQ(kDataSize, decompressed->length());
+  delete decompressed;
+  delete compressed;
+  free(data);
+}
+
+// Socket handles are not file descriptors on Windows.
+#if !defined(HOST_OS_WINDOWS)
+
+using dart::bin::RawAddr;
+using dart::bin::ServerSocket;
+using dart::bin::Socket;
+using dart::bin::SocketAddress;
+using dart::bin::SocketBase;
+
+// A connected pair of non-blocking loopback sockets, set up the way
+// ServerSocket.bind and Socket.connect do.
+class LoopbackSockets {
+ public:
+  LoopbackSockets() : listener_(-1), client_(-1), server_(-1) {
+    EXPECT(SocketBase::Initialize());
+    RawAddr addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.in.sin_family = AF_INET;
+    EXPECT(SocketBase::ParseAddress(SocketAddress::TYPE_IPV4, "127.0.0.1",
+                                    &addr));
+    SocketAddress::SetAddrPort(&addr, 0);
+    listener_ = ServerSocket::CreateBindListen(addr, 1);
+    EXPECT(listener_ >= 0);
+    SocketAddress::SetAddrPort(&addr, SocketBase::GetPort(listener_));
+    client_ = Socket::CreateConnect(addr);
+    EXPECT(client_ >= 0);
+    do {
+      server_ = ServerSocket::Accept(listener_);
+    } while (server_ == ServerSocket::kTemporaryFailure);
+    EXPECT(server_ >= 0);
+    SocketBase::SetNoDelay(client_, true);
+    SocketBase::SetNoDelay(server_, true);
+  }
+
+  ~LoopbackSockets() {
+    SocketBase::Close(server_);
+    SocketBase::Close(client_);
+    SocketBase::Close(listener_);
+  }
+
+  intptr_t client() const { return client_; }
+  intptr_t server() const { return server_; }
+
+  // Transfers exactly |length| bytes, retrying while the non-blocking socket
+  // is not ready, as the event handler would after a wakeup. The other end
+  // must be able to take |length| bytes without being read from.
+  static void WriteAll(intptr_t fd, const uint8_t* buffer, intptr_t length) {
+    while (length > 0) {
+      const intptr_t written =
+          SocketBase::Write(fd, buffer, length, SocketBase::kAsync);
+      EXPECT(written >= 0);
+      buffer += written;
+      length -= written;
+    }
+  }
+  static void ReadAll(intptr_t fd, uint8_t* buffer, intptr_t length) {
+    while (length > 0) {
+      const intptr_t read =
+          SocketBase::Read(fd, buffer, length, SocketBase::kAsync);
+      EXPECT(read >= 0);
+      buffer += read;
+      length -= read;
+    }
+  }
+
+ private:
+  intptr_t listener_;
+  intptr_t client_;
+  intptr_t server_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopbackSockets);
+};
+
+// Sends small messages to be echoed back over loopback TCP and records the
+// latency of each round trip.
+static void SocketEcho(MallocGrowableArray<int64_t>* latencies,
+                       int64_t* total) {
+  const intptr_t kMessageSize = 64;
+  const intptr_t kNumMessages = 10000;
+  LoopbackSockets sockets;
+  uint8_t message[kMessageSize];
+  uint8_t echo[kMessageSize];
+  memset(message, 'x', kMessageSize);
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < kNumMessages; i++) {
+    const int64_t before = OS::GetCurrentMonotonicMicros();
+    LoopbackSockets::WriteAll(sockets.client(), message, kMessageSize);
+    LoopbackSockets::ReadAll(sockets.server(), echo, kMessageSize);
+    LoopbackSockets::WriteAll(sockets.server(), echo, kMessageSize);
+    LoopbackSockets::ReadAll(sockets.client(), echo, kMessageSize);
+    latencies->Add(OS::GetCurrentMonotonicMicros() - before);
+  }
+  *total = OS::GetCurrentMonotonicMicros() - start;
+}
+
+//
+// Measure 10000 round trips of 64 byte messages. The score is inversely
+// proportional to ops/s.
+//
+BENCHMARK(IOSocketEcho) {
+  MallocGrowableArray<int64_t> latencies;
+  int64_t total = 0;
+  SocketEcho(&latencies, &total);
+  benchmark->set_score(total);
+}
+
+BENCHMARK(IOSocketEchoP99) {
+  MallocGrowableArray<int64_t> latencies;
+  int64_t total = 0;
+  SocketEcho(&latencies, &total);
+  benchmark->set_score(P99(&latencies));
+}
+
+//
+// Measure sending 64MB over loopback TCP in writes of up to 64KB,
+// alternating with reads of whatever has arrived on the other end. The score
+// is inversely proportional to bytes/s.
+//
+BENCHMARK(IOSocketBulkTransfer) {
+  const intptr_t kTotalSize = 64 * MB;
+  const intptr_t kChunkSize = 64 * KB;
+  LoopbackSockets sockets;
+  uint8_t* out = reinterpret_cast<uint8_t*>(calloc(kChunkSize, 1));
+  uint8_t* in = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  intptr_t sent = 0;
+  intptr_t received = 0;
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  while (received < kTotalSize) {
+    if (sent < kTotalSize) {
+      const intptr_t written =
+          SocketBase::Write(sockets.client(), out,
+                            Utils::Minimum(kChunkSize, kTotalSize - sent),
+                            SocketBase::kAsync);
+      EXPECT(written >= 0);
+      sent += written;
+    }
+    const intptr_t read =
+        SocketBase::Read(sockets.server(), in, kChunkSize, SocketBase::kAsync);
+    EXPECT(read >= 0);
+    received += read;
+  }
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  EXPECT_EQ(kTotalSize, received);
+  free(in);
+  free(out);
+}
+
+#endif  // !defined(HOST_OS_WINDOWS)
+
+}  // namespace dart
@@ -49,14 +49,14 @@ namespace bin {
   V(File_GetType, 3)                                                           \
   V(File_LastAccessed, 2)                                                      \
   V(File_LastModified, 2)                                                      \
-  V(File_Length, 1)                                                            \
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_Map, 5)                                                               \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
-  V(File_Position, 1)                                                          \
   V(File_Read, 2)                                                              \
+  V(File_ReadAsync, 4)                                                         \
   V(File_ReadByte, 1)                                                          \
   V(File_ReadInto, 4)                                                          \
   V(File_Rename, 3)                                                            \
@@ -113,6 +113,7 @@ namespace bin {
   V(RawSocketOption_GetOptionValue, 1)                                         \
   V(SecureSocket_Connect, 7)                                                   \
   V(SecureSocket_Destroy, 1)                                                   \
+  V(SecureSocket_EnableKernelTLS, 2)                                           \
   V(SecureSocket_FilterPointer, 1)                                             \
   V(SecureSocket_GetSelectedProtocol, 1)                                       \
   V(SecureSocket_Handshake, 1)                                                 \
@@ -129,13 +130,11 @@ namespace bin {
   V(SecurityContext_TrustBuiltinRoots, 1)                                      \
   V(SecurityContext_UseCertificateChainBytes, 3)                               \
   V(ServerSocket_Accept, 2)                                                    \
-  V(ServerSocket_CreateBindListen, 6)                                          \
+  V(ServerSocket_CreateBindListen, 7)                                          \
   V(SocketBase_IsBindError, 2)                                                 \
-  V(Socket_Available, 1)                                                       \
   V(Socket_CreateBindConnect, 4)                                               \
   V(Socket_CreateBindDatagram, 6)                                              \
   V(Socket_CreateConnect, 3)                                                   \
-  V(Socket_GetPort, 1)                                                         \
   V(Socket_GetRemotePeer, 1)                                                   \
   V(Socket_GetError, 1)                                                        \
   V(Socket_GetOption, 3)                                                       \
@@ -145,13 +144,19 @@ namespace bin {
   V(Socket_GetType, 1)                                                         \
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
+  V(Socket_LookupCached, 2)                                                    \
   V(Socket_Read, 2)                                                            \
+  V(Socket_ReadInto, 4)                                                        \
   V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_RecvFromMany, 2)                                                    \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendTo, 6)                                                          \
+  V(Socket_SendToMany, 6)                                                      \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteVector, 4)                                                     \
   V(Stdin_ReadByte, 1)                                                         \
   V(Stdin_GetEchoMode, 1)                                                      \
   V(Stdin_SetEchoMode, 2)                                                      \
@@ -160,6 +165,10 @@ namespace bin {
   V(Stdin_AnsiSupported, 1)                                                    \
   V(Stdout_GetTerminalSize, 1)                                                 \
   V(Stdout_AnsiSupported, 1)                                                   \
+  V(Stdout_FlushBuffered, 1)                                                   \
+  V(Stdout_GetBufferSize, 1)                                                   \
+  V(Stdout_SetBufferSize, 2)                                                   \
+  V(Stdout_WriteBuffered, 4)                                                   \
   V(StringToSystemEncoding, 1)                                                 \
   V(SynchronousSocket_Available, 1)                                            \
   V(SynchronousSocket_CloseSync, 1)                                            \
@@ -181,26 +190,32 @@ namespace bin {
   V(X509_StartValidity, 1)                                                     \
   V(X509_EndValidity, 1)
 
+// Lists the natives that create no local handles on their common path. The
+// VM calls them without setting up an API scope; they enter one themselves
+// before allocating anything, e.g. an OSError.
+#define IO_NATIVE_NO_SCOPE_LIST(V)                                             \
+  V(File_Length, 1)                                                            \
+  V(File_Position, 1)                                                          \
+  V(Socket_Available, 1)                                                       \
+  V(Socket_GetPort, 1)                                                         \
+  V(Socket_ReadAhead, 1)
+
 IO_NATIVE_LIST(DECLARE_FUNCTION);
+IO_NATIVE_NO_SCOPE_LIST(DECLARE_FUNCTION);
 
 static struct NativeEntries {
   const char* name_;
   Dart_NativeFunction function_;
   int argument_count_;
-} IOEntries[] = {IO_NATIVE_LIST(REGISTER_FUNCTION)};
+} IOEntries[] = {IO_NATIVE_LIST(REGISTER_FUNCTION)},
+  IONoScopeEntries[] = {IO_NATIVE_NO_SCOPE_LIST(REGISTER_FUNCTION)};
 
-Dart_NativeFunction IONativeLookup(Dart_Handle name,
-                                   int argument_count,
-                                   bool* auto_setup_scope) {
-  const char* function_name = NULL;
-  Dart_Handle result = Dart_StringToCString(name, &function_name);
-  ASSERT(!Dart_IsError(result));
-  ASSERT(function_name != NULL);
-  ASSERT(auto_setup_scope != NULL);
-  *auto_setup_scope = true;
-  int num_entries = sizeof(IOEntries) / sizeof(struct NativeEntries);
+static Dart_NativeFunction LookupEntry(struct NativeEntries* entries,
+                                       int num_entries,
+                                       const char* function_name,
+                                       int argument_count) {
   for (int i = 0; i < num_entries; i++) {
-    struct NativeEntries* entry = &(IOEntries[i]);
+    struct NativeEntries* entry = &(entries[i]);
     if ((strcmp(function_name, entry->name_) == 0) &&
         (entry->argument_count_ == argument_count)) {
       return reinterpret_cast<Dart_NativeFunction>(entry->function_);
@@ -209,10 +224,11 @@ Dart_NativeFunction IONativeLookup(Dart_Handle name,
   return NULL;
 }
 
-const uint8_t* IONativeSymbol(Dart_NativeFunction nf) {
-  int num_entries = sizeof(IOEntries) / sizeof(struct NativeEntries);
+static const uint8_t* LookupSymbol(struct NativeEntries* entries,
+                                   int num_entries,
+                                   Dart_NativeFunction nf) {
   for (int i = 0; i < num_entries; i++) {
-    struct NativeEntries* entry = &(IOEntries[i]);
+    struct NativeEntries* entry = &(entries[i]);
     if (reinterpret_cast<Dart_NativeFunction>(entry->function_) == nf) {
       return reinterpret_cast<const uint8_t*>(entry->name_);
     }
@@ -220,5 +236,37 @@ const uint8_t* IONativeSymbol(Dart_NativeFunction nf) {
   return NULL;
 }
 
+Dart_NativeFunction IONativeLookup(Dart_Handle name,
+                                   int argument_count,
+                                   bool* auto_setup_scope) {
+  const char* function_name = NULL;
+  Dart_Handle result = Dart_StringToCString(name, &function_name);
+  ASSERT(!Dart_IsError(result));
+  ASSERT(function_name != NULL);
+  ASSERT(auto_setup_scope != NULL);
+  *auto_setup_scope = true;
+  Dart_NativeFunction function =
+      LookupEntry(IOEntries, sizeof(IOEntries) / sizeof(struct NativeEntries),
+                  function_name, argument_count);
+  if (function != NULL) {
+    return function;
+  }
+  *auto_setup_scope = false;
+  return LookupEntry(IONoScopeEntries,
+                     sizeof(IONoScopeEntries) / sizeof(struct NativeEntries),
+                     function_name, argument_count);
+}
+
+const uint8_t* IONativeSymbol(Dart_NativeFunction nf) {
+  const uint8_t* symbol = LookupSymbol(
+      IOEntries, sizeof(IOEntries) / sizeof(struct NativeEntries), nf);
+  if (symbol != NULL) {
+    return symbol;
+  }
+  return LookupSymbol(IONoScopeEntries,
+                      sizeof(IONoScopeEntries) / sizeof(struct NativeEntries),
+                      nf);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -0,0 +1,72 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_thread_pool.h"
+
+#include "bin/lockers.h"
+#include "bin/thread.h"
+
+namespace dart {
+namespace bin {
+
+Monitor* IOThreadPool::monitor_ = new Monitor();
+IOThreadPool::Entry* IOThreadPool::head_ = NULL;
+IOThreadPool::Entry* IOThreadPool::tail_ = NULL;
+intptr_t IOThreadPool::queued_ = 0;
+intptr_t IOThreadPool::thread_count_ = 0;
+intptr_t IOThreadPool::idle_count_ = 0;
+
+bool IOThreadPool::Run(Task task, void* data) {
+  MonitorLocker ml(monitor_);
+  // Only start another thread if the idle ones are all spoken for already.
+  if ((queued_ >= idle_count_) && (thread_count_ < kMaxThreads)) {
+    if (Thread::Start("dart:io I/O thread", ThreadMain, 0) == 0) {
+      thread_count_++;
+    } else if (thread_count_ == 0) {
+      return false;
+    }
+  }
+  Entry* entry = new Entry();
+  entry->task = task;
+  entry->data = data;
+  entry->next = NULL;
+  if (tail_ == NULL) {
+    head_ = entry;
+  } else {
+    tail_->next = entry;
+  }
+  tail_ = entry;
+  queued_++;
+  ml.Notify();
+  return true;
+}
+
+void IOThreadPool::ThreadMain(uword parameter) {
+  monitor_->Enter();
+  while (true) {
+    while (head_ == NULL) {
+      idle_count_++;
+      Monitor::WaitResult result = monitor_->Wait(kIdleTimeoutMillis);
+      idle_count_--;
+      if ((result == Monitor::kTimedOut) && (head_ == NULL)) {
+        thread_count_--;
+        monitor_->Exit();
+        return;
+      }
+    }
+    Entry* entry = head_;
+    head_ = entry->next;
+    if (head_ == NULL) {
+      tail_ = NULL;
+    }
+    queued_--;
+    monitor_->Exit();
+    entry->task(entry->data);
+    delete entry;
+    monitor_->Enter();
+  }
+}
+
+}  // namespace bin
+}  // namespace dart
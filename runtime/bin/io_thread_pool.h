@@ -0,0 +1,55 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_THREAD_POOL_H_
+#define RUNTIME_BIN_IO_THREAD_POOL_H_
+
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+// Forward declarations.
+class Monitor;
+
+// A small pool of threads for blocking I/O which natives hand work to
+// directly, instead of sending a request message to an IOService port.
+// Threads are started on demand and exit again once they have been idle for
+// kIdleTimeoutMillis.
+class IOThreadPool {
+ public:
+  typedef void (*Task)(void* data);
+
+  static const intptr_t kMaxThreads = 8;
+  static const int64_t kIdleTimeoutMillis = 5000;
+
+  // Queues |task| to be called with |data| on one of the pool's threads.
+  // Returns false if there is no thread to run it, in which case the caller
+  // still owns |data|.
+  static bool Run(Task task, void* data);
+
+ private:
+  struct Entry {
+    Task task;
+    void* data;
+    Entry* next;
+  };
+
+  static void ThreadMain(uword parameter);
+
+  static Monitor* monitor_;
+  static Entry* head_;
+  static Entry* tail_;
+  static intptr_t queued_;
+  static intptr_t thread_count_;
+  static intptr_t idle_count_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOThreadPool);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_IO_THREAD_POOL_H_
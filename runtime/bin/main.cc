@@ -30,6 +30,8 @@
 #include "bin/platform.h"
 #include "bin/process.h"
 #include "bin/snapshot_utils.h"
+#include "bin/socket.h"
+#include "bin/stdio.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
 #include "bin/vmservice_impl.h"
@@ -39,6 +41,11 @@
 #include "platform/syslog.h"
 #include "platform/text_buffer.h"
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID) || defined(HOST_OS_MACOS)
+#include <errno.h>
+#include <poll.h>
+#endif
+
 extern "C" {
 extern const uint8_t kDartVmSnapshotData[];
 extern const uint8_t kDartVmSnapshotInstructions[];
@@ -229,9 +236,12 @@ static Dart_Isolate IsolateSetupHelper(Dart_Isolate isolate,
 
   if (Dart_IsVMFlagSet("support_service") || !Dart_IsPrecompiledRuntime()) {
     // Set up the load port provided by the service isolate so that we can
-    // load scripts.
+    // load scripts. A lazily started service isolate provides none until
+    // its first client connects.
     result = DartUtils::SetupServiceLoadPort();
-    CHECK_RESULT(result);
+    if (!Dart_IsVMFlagSet("lazy_service_isolate")) {
+      CHECK_RESULT(result);
+    }
   }
 
   // Setup package root if specified.
@@ -264,20 +274,37 @@ static Dart_Isolate IsolateSetupHelper(Dart_Isolate isolate,
       Dart_ShutdownIsolate();
       return NULL;
     }
-    uint8_t* application_kernel_buffer = NULL;
-    intptr_t application_kernel_buffer_size = 0;
-    dfe.CompileAndReadScript(script_uri, &application_kernel_buffer,
-                             &application_kernel_buffer_size, error, exit_code,
-                             resolved_packages_config);
-    if (application_kernel_buffer == NULL) {
-      Dart_ExitScope();
-      Dart_ShutdownIsolate();
-      return NULL;
+    const bool use_kernel_cache = is_main_isolate && dfe.UseKernelCache();
+    std::shared_ptr<uint8_t> cached_kernel_buffer;
+    if (use_kernel_cache) {
+      cached_kernel_buffer = dfe.ReadCachedScript(
+          script_uri, resolved_packages_config, &kernel_buffer_size);
+    }
+    if (cached_kernel_buffer) {
+      kernel_buffer = cached_kernel_buffer.get();
+      isolate_data->SetKernelBufferAlreadyOwned(std::move(cached_kernel_buffer),
+                                                kernel_buffer_size);
+    } else {
+      uint8_t* application_kernel_buffer = NULL;
+      intptr_t application_kernel_buffer_size = 0;
+      dfe.CompileAndReadScript(script_uri, &application_kernel_buffer,
+                               &application_kernel_buffer_size, error,
+                               exit_code, resolved_packages_config);
+      if (application_kernel_buffer == NULL) {
+        Dart_ExitScope();
+        Dart_ShutdownIsolate();
+        return NULL;
+      }
+      if (use_kernel_cache) {
+        dfe.WriteCachedScript(script_uri, resolved_packages_config,
+                              application_kernel_buffer,
+                              application_kernel_buffer_size);
+      }
+      isolate_data->SetKernelBufferNewlyOwned(application_kernel_buffer,
+                                              application_kernel_buffer_size);
+      kernel_buffer = application_kernel_buffer;
+      kernel_buffer_size = application_kernel_buffer_size;
     }
-    isolate_data->SetKernelBufferNewlyOwned(application_kernel_buffer,
-                                            application_kernel_buffer_size);
-    kernel_buffer = application_kernel_buffer;
-    kernel_buffer_size = application_kernel_buffer_size;
   }
   if (kernel_buffer != NULL) {
     Dart_Handle uri = Dart_NewStringFromCString(script_uri);
@@ -541,6 +568,7 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
   ASSERT(script_uri != NULL);
   uint8_t* kernel_buffer = NULL;
   std::shared_ptr<uint8_t> parent_kernel_buffer;
+  std::shared_ptr<uint8_t> mapped_kernel_buffer;
   intptr_t kernel_buffer_size = 0;
   AppSnapshot* app_snapshot = NULL;
 
@@ -557,7 +585,18 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
   const uint8_t* isolate_snapshot_data = core_isolate_snapshot_data;
   const uint8_t* isolate_snapshot_instructions =
       core_isolate_snapshot_instructions;
-  if ((app_isolate_snapshot_data != NULL) &&
+  const uint8_t* isolate_shared_data = app_isolate_shared_data;
+  const uint8_t* isolate_shared_instructions = app_isolate_shared_instructions;
+  if (flags->group_snapshot_data != NULL) {
+    // Isolate.spawn with --share_program_on_spawn: the VM wrote a snapshot
+    // of the parent's program, which already contains everything the parent
+    // loaded.
+    isolate_run_app_snapshot = true;
+    isolate_snapshot_data = flags->group_snapshot_data;
+    isolate_snapshot_instructions = flags->group_snapshot_instructions;
+    isolate_shared_data = NULL;
+    isolate_shared_instructions = NULL;
+  } else if ((app_isolate_snapshot_data != NULL) &&
       (is_main_isolate || ((app_script_uri != NULL) &&
                            (strcmp(script_uri, app_script_uri) == 0)))) {
     isolate_run_app_snapshot = true;
@@ -575,7 +614,8 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
     }
   }
 
-  if (flags->copy_parent_code && callback_data) {
+  if (flags->copy_parent_code && (flags->group_snapshot_data == NULL) &&
+      callback_data) {
     IsolateData* parent_isolate_data =
         reinterpret_cast<IsolateData*>(callback_data);
     parent_kernel_buffer = parent_isolate_data->kernel_buffer();
@@ -584,7 +624,13 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
   }
 
   if (kernel_buffer == NULL && !isolate_run_app_snapshot) {
-    dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    if (Options::mmap_kernel()) {
+      mapped_kernel_buffer = dfe.MapScript(script_uri, &kernel_buffer_size);
+      kernel_buffer = mapped_kernel_buffer.get();
+    }
+    if (kernel_buffer == NULL) {
+      dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    }
   }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
@@ -594,6 +640,9 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
     if (parent_kernel_buffer) {
       isolate_data->SetKernelBufferAlreadyOwned(std::move(parent_kernel_buffer),
                                                 kernel_buffer_size);
+    } else if (mapped_kernel_buffer) {
+      isolate_data->SetKernelBufferAlreadyOwned(std::move(mapped_kernel_buffer),
+                                                kernel_buffer_size);
     } else {
       isolate_data->SetKernelBufferNewlyOwned(kernel_buffer,
                                               kernel_buffer_size);
@@ -633,8 +682,8 @@ static Dart_Isolate CreateIsolateAndSetupHelper(bool is_main_isolate,
   } else {
     isolate = Dart_CreateIsolate(
         script_uri, name, isolate_snapshot_data, isolate_snapshot_instructions,
-        app_isolate_shared_data, app_isolate_shared_instructions, flags,
-        isolate_data, error);
+        isolate_shared_data, isolate_shared_instructions, flags, isolate_data,
+        error);
   }
 #else
   isolate = Dart_CreateIsolate(
@@ -694,6 +743,8 @@ static Dart_Isolate CreateIsolateAndSetup(const char* script_uri,
 }
 
 static void OnIsolateShutdown(void* callback_data) {
+  // The isolate's last turn may have left output in the stdout buffer.
+  StdoutBuffer::FlushAll();
   Dart_EnterScope();
 
   Dart_Handle sticky_error = Dart_GetStickyError();
@@ -812,6 +863,7 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
       &exit_code);
 
   if (isolate == NULL) {
+    StdoutBuffer::FlushAll();
     Syslog::PrintErr("%s\n", error);
     free(error);
     error = NULL;
@@ -938,6 +990,11 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
 
   Dart_ExitScope();
 
+  if (Options::fast_exit()) {
+    // Nothing runs after the main isolate but the VM shutdown.
+    Dart_PrepareForExit();
+  }
+
   // Shutdown the isolate.
   Dart_ShutdownIsolate();
 
@@ -968,6 +1025,69 @@ Dart_Handle GetVMServiceAssetsArchiveCallback() {
 static Dart_GetVMServiceAssetsArchive GetVMServiceAssetsArchiveCallback = NULL;
 #endif  // !defined(NO_OBSERVATORY)
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID) || defined(HOST_OS_MACOS)
+#define SUPPORTS_LAZY_VM_SERVICE
+
+static void WaitForFirstServiceClient(uword fd) {
+  struct pollfd pollfd;
+  pollfd.fd = static_cast<int>(fd);
+  pollfd.events = POLLIN;
+  int result;
+  do {
+    pollfd.revents = 0;
+    result = poll(&pollfd, 1, -1);
+  } while ((result < 0) && (errno == EINTR));
+  Dart_StartServiceIsolate();
+}
+#endif
+
+// Listens on the VM service port and starts the service isolate once the
+// first client connects. The HTTP server of the service then accepts that
+// connection from the same socket. Returns false if the service isolate has
+// to be started right away instead.
+static bool StartServiceIsolateOnFirstClient() {
+#if defined(SUPPORTS_LAZY_VM_SERVICE)
+  const char* server_ip = Options::vm_service_server_ip();
+  OSError* os_error = NULL;
+  AddressList<SocketAddress>* addresses =
+      SocketBase::LookupAddress(server_ip, SocketAddress::TYPE_ANY, &os_error);
+  if (addresses == NULL) {
+    Syslog::PrintErr("vm-service: Failed to look up %s: %s\n", server_ip,
+                     os_error->message());
+    delete os_error;
+    return false;
+  }
+  // Prefer IPv4 addresses, as the HTTP server of the service does.
+  RawAddr addr;
+  for (intptr_t i = 0; i < addresses->count(); i++) {
+    addr = addresses->GetAt(i)->addr();
+    if (addresses->GetAt(i)->GetType() == SocketAddress::TYPE_IPV4) {
+      break;
+    }
+  }
+  const bool found = addresses->count() > 0;
+  delete addresses;
+  if (!found) {
+    Syslog::PrintErr("vm-service: Failed to look up %s\n", server_ip);
+    return false;
+  }
+  SocketAddress::SetAddrPort(&addr, Options::vm_service_server_port());
+  Socket* socket = ListeningSocketRegistry::Instance()->CreateSharedBindListen(
+      addr, /*backlog=*/0, /*v6_only=*/false);
+  if (socket == NULL) {
+    OSError error;
+    Syslog::PrintErr("vm-service: Failed to listen on %s:%d: %s\n", server_ip,
+                     Options::vm_service_server_port(), error.message());
+    return false;
+  }
+  VmService::SetServerSocketShared(true);
+  return Thread::Start("dart:vm-service-lazy-start", WaitForFirstServiceClient,
+                       static_cast<uword>(socket->fd())) == 0;
+#else
+  return false;
+#endif  // defined(SUPPORTS_LAZY_VM_SERVICE)
+}
+
 void main(int argc, char** argv) {
   char* script_name;
   const int EXTRA_VM_ARGUMENTS = 10;
@@ -1097,6 +1217,11 @@ void main(int argc, char** argv) {
     Platform::Exit(kErrorExitCode);
   }
 
+  // Binding the port only makes sense if it is known in advance.
+  if (Options::vm_service_lazy() && (Options::vm_service_server_port() > 0)) {
+    vm_options.AddArgument("--lazy_service_isolate");
+  }
+
   error = Dart_SetVMFlags(vm_options.count(), vm_options.arguments());
   if (error != NULL) {
     Syslog::PrintErr("Setting VM flags failed: %s\n", error);
@@ -1110,14 +1235,37 @@ void main(int argc, char** argv) {
   dfe.Init(Options::target_abi_version());
   uint8_t* application_kernel_buffer = NULL;
   intptr_t application_kernel_buffer_size = 0;
-  dfe.ReadScript(script_name, &application_kernel_buffer,
-                 &application_kernel_buffer_size);
+  std::shared_ptr<uint8_t> mapped_kernel_buffer;
+  if (Options::mmap_kernel()) {
+    mapped_kernel_buffer =
+        dfe.MapScript(script_name, &application_kernel_buffer_size);
+  }
+  if (mapped_kernel_buffer) {
+    dfe.set_application_kernel_buffer(std::move(mapped_kernel_buffer),
+                                      application_kernel_buffer_size);
+    Options::dfe()->set_use_dfe();
+  } else {
+    dfe.ReadScript(script_name, &application_kernel_buffer,
+                   &application_kernel_buffer_size);
+  }
   if (application_kernel_buffer != NULL) {
     // Since we loaded the script anyway, save it.
     dfe.set_application_kernel_buffer(application_kernel_buffer,
                                       application_kernel_buffer_size);
     Options::dfe()->set_use_dfe();
   }
+  // Cached kernel would not tell the kernel service about the sources, which
+  // the incremental compiler used for reloading and depfiles need.
+  if ((Options::kernel_cache_directory() != NULL) &&
+      !dfe.use_incremental_compiler() && (Options::depfile() == NULL) &&
+      (Options::gen_snapshot_kind() == kNone)) {
+    // VM flags like --enable-experiment change the kernel compiled.
+    TextBuffer salt(256);
+    for (int i = 0; i < vm_options.count(); i++) {
+      salt.Printf("%s\n", vm_options.GetArgument(i));
+    }
+    dfe.set_kernel_cache(Options::kernel_cache_directory(), salt.buf());
+  }
 #endif
 
   // Initialize the Dart VM.
@@ -1150,6 +1298,11 @@ void main(int argc, char** argv) {
     Platform::Exit(kErrorExitCode);
   }
 
+  if (Dart_IsVMFlagSet("lazy_service_isolate") &&
+      !StartServiceIsolateOnFirstClient()) {
+    Dart_StartServiceIsolate();
+  }
+
   Dart_SetServiceStreamCallbacks(&ServiceStreamListenCallback,
                                  &ServiceStreamCancelCallback);
   Dart_SetFileModifiedCallback(&FileModifiedCallback);
@@ -1187,6 +1340,7 @@ void main(int argc, char** argv) {
   // Free environment if any.
   Options::DestroyEnvironment();
 
+  StdoutBuffer::FlushAll();
   Platform::Exit(Process::GlobalExitCode());
 }
 
@@ -9,8 +9,10 @@
 #include <string.h>
 
 #include "bin/abi_version.h"
+#include "bin/eventhandler.h"
 #include "bin/options.h"
 #include "bin/platform.h"
+#include "bin/process.h"
 #include "platform/syslog.h"
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/security_context.h"
@@ -191,6 +193,16 @@ void Options::PrintUsage() {
 "--trace-loading\n"
 "  enables tracing of library and script loading\n"
 "\n"
+"--mmap-kernel\n"
+"  Maps the kernel file of the script instead of reading it into memory,\n"
+"  so that only the parts which are used get loaded.\n"
+"\n"
+"--kernel-cache=<path>\n"
+"  The path to a directory in which to cache the kernel compiled for the\n"
+"  script. Later runs map the cached kernel instead of compiling the script\n"
+"  again, as long as the SDK and the sources of the script are unchanged.\n"
+"  Not used together with the VM service, --depfile or --snapshot-kind.\n"
+"\n"
 "--enable-vm-service[=<port>[/<bind-address>]]\n"
 "  Enables the VM service and listens on specified port for connections\n"
 "  (default port number is 8181, default bind address is localhost).\n"
@@ -201,6 +213,17 @@ void Options::PrintUsage() {
 "  so it is not recommended to disable them unless behind a firewall on a\n"
 "  secure device.\n"
 "\n"
+"--lazy-vm-service\n"
+"  Only listens on the VM service port at startup, and starts the VM service\n"
+"  when the first client connects to it. Until then, resolving package URIs\n"
+"  at runtime with Isolate.resolvePackageUri is unsupported. Not supported\n"
+"  on Windows and Fuchsia, where the VM service starts right away.\n"
+"\n"
+"--fast-exit\n"
+"  Exits without running the finalizers of native resources or freeing the\n"
+"  memory of the Dart heaps once the program is done. The timeline and\n"
+"  profiles are still written.\n"
+"\n"
 "--root-certs-file=<path>\n"
 "  The path to a file containing the trusted root certificates to use for\n"
 "  secure socket connections.\n"
@@ -359,6 +382,59 @@ bool Options::ProcessAbiVersionOption(const char* arg,
   return true;
 }
 
+bool Options::ProcessEventHandlerThreadsOption(const char* arg,
+                                               CommandLineOptions* vm_options) {
+  const char* value =
+      OptionProcessor::ProcessOption(arg, "--event_handler_threads=");
+  if (value == NULL) {
+    return false;
+  }
+  int count = 0;
+  for (int i = 0; value[i]; ++i) {
+    if (value[i] >= '0' && value[i] <= '9') {
+      count = (count * 10) + value[i] - '0';
+    } else {
+      Syslog::PrintErr("--event_handler_threads must be an int\n");
+      return false;
+    }
+  }
+  static const int kMaxEventHandlerThreads = 64;
+  if ((count < 1) || (count > kMaxEventHandlerThreads)) {
+    Syslog::PrintErr("--event_handler_threads must be between 1 and %d\n",
+                     kMaxEventHandlerThreads);
+    return false;
+  }
+  EventHandler::set_thread_count(count);
+  return true;
+}
+
+bool Options::ProcessOutputPipeSizeOption(const char* arg,
+                                          CommandLineOptions* vm_options) {
+  const char* value =
+      OptionProcessor::ProcessOption(arg, "--process_output_pipe_size=");
+  if (value == NULL) {
+    return false;
+  }
+  static const intptr_t kMaxOutputPipeSize = 256 * MB;
+  intptr_t size = 0;
+  for (int i = 0; value[i]; ++i) {
+    if ((value[i] < '0') || (value[i] > '9')) {
+      Syslog::PrintErr("--process_output_pipe_size must be an int\n");
+      return false;
+    }
+    if (size <= kMaxOutputPipeSize) {
+      size = (size * 10) + value[i] - '0';
+    }
+  }
+  if (size > kMaxOutputPipeSize) {
+    Syslog::PrintErr("--process_output_pipe_size must be at most %" Pd "\n",
+                     kMaxOutputPipeSize);
+    return false;
+  }
+  Process::set_output_pipe_size(size);
+  return true;
+}
+
 int Options::ParseArguments(int argc,
                             char** argv,
                             bool vm_run_app_snapshot,
@@ -415,6 +491,7 @@ int Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  Socket::set_socket_read_ahead(Options::socket_read_ahead());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -30,6 +30,7 @@ namespace bin {
   V(load_type_feedback, load_type_feedback_filename)                           \
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
+  V(kernel_cache, kernel_cache_directory)                                      \
   V(namespace, namespc)
 
 // As STRING_OPTIONS_LIST but for boolean valued options. The default value is
@@ -39,13 +40,17 @@ namespace bin {
   V(compile_all, compile_all)                                                  \
   V(disable_service_origin_check, vm_service_dev_mode)                         \
   V(disable_service_auth_codes, vm_service_auth_disabled)                      \
+  V(lazy_vm_service, vm_service_lazy)                                          \
+  V(fast_exit, fast_exit)                                                      \
   V(deterministic, deterministic)                                              \
   V(trace_loading, trace_loading)                                              \
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
+  V(socket_read_ahead, socket_read_ahead)                                      \
   V(disable_exit, exit_disabled)                                               \
   V(preview_dart_2, nop_option)                                                \
-  V(suppress_core_dump, suppress_core_dump)
+  V(suppress_core_dump, suppress_core_dump)                                    \
+  V(mmap_kernel, mmap_kernel)
 
 // Boolean flags that have a short form.
 #define SHORT_BOOL_OPTIONS_LIST(V)                                             \
@@ -64,7 +69,9 @@ namespace bin {
   V(ProcessEnvironmentOption)                                                  \
   V(ProcessEnableVmServiceOption)                                              \
   V(ProcessObserveOption)                                                      \
-  V(ProcessAbiVersionOption)
+  V(ProcessAbiVersionOption)                                                   \
+  V(ProcessEventHandlerThreadsOption)                                          \
+  V(ProcessOutputPipeSizeOption)
 
 // This enum must match the strings in kSnapshotKindNames in main_options.cc.
 enum SnapshotKind {
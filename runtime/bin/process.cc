@@ -9,6 +9,7 @@
 #include "bin/namespace.h"
 #include "bin/platform.h"
 #include "bin/socket.h"
+#include "bin/stdio.h"
 #include "bin/utils.h"
 #include "platform/syslog.h"
 
@@ -229,6 +230,8 @@ void FUNCTION_NAME(Process_Exit)(Dart_NativeArguments args) {
   int64_t status = 0;
   // Ignore result if passing invalid argument and just exit 0.
   DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 0), &status);
+  // Output still waiting in the stdio buffers would be lost otherwise.
+  StdoutBuffer::FlushAll();
   Process::RunExitHook(status);
   Dart_ExitIsolate();
   Platform::Exit(static_cast<int>(status));
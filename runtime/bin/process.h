@@ -157,8 +157,15 @@ class Process {
   static bool ModeIsAttached(ProcessStartMode mode);
   static bool ModeHasStdio(ProcessStartMode mode);
 
+  // The size in bytes to make the kernel buffers of the pipes that started
+  // processes write their stdout and stderr to, where the OS supports it.
+  // Zero keeps the default size.
+  static void set_output_pipe_size(intptr_t size) { output_pipe_size_ = size; }
+  static intptr_t output_pipe_size() { return output_pipe_size_; }
+
  private:
   static int global_exit_code_;
+  static intptr_t output_pipe_size_;
   static Mutex* global_exit_code_mutex_;
   static ExitHook exit_hook_;
 
@@ -37,6 +37,7 @@ namespace bin {
 int Process::global_exit_code_ = 0;
 Mutex* Process::global_exit_code_mutex_ = new Mutex();
 Process::ExitHook Process::exit_hook_ = NULL;
+intptr_t Process::output_pipe_size_ = 0;
 
 // ProcessInfo is used to map a process id to the file descriptor for
 // the pipe used to communicate the exit code of the process to Dart.
@@ -404,6 +405,7 @@ class ProcessStarter {
     if (result < 0) {
       return CleanupAndReturnError();
     }
+    SetOutputPipeSize(read_in_[0]);
 
     // For detached processes the pipe to connect stderr and stdin are not used.
     if (Process::ModeHasStdio(mode_)) {
@@ -411,6 +413,7 @@ class ProcessStarter {
       if (result < 0) {
         return CleanupAndReturnError();
       }
+      SetOutputPipeSize(read_err_[0]);
 
       result = TEMP_FAILURE_RETRY(pipe2(write_out_, O_CLOEXEC));
       if (result < 0) {
@@ -421,6 +424,17 @@ class ProcessStarter {
     return 0;
   }
 
+  // A larger buffer lets a child that writes a lot of output run further
+  // ahead of the reads, which then return more of it at once.
+  void SetOutputPipeSize(int fd) {
+    const intptr_t size = Process::output_pipe_size();
+    if (size > 0) {
+      // Sizes above /proc/sys/fs/pipe-max-size fail for unprivileged
+      // processes, which keeps the default size.
+      NO_RETRY_EXPECTED(fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size)));
+    }
+  }
+
   void NewProcess() {
     // Wait for parent process before setting up the child process.
     char msg;
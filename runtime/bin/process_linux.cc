@@ -10,10 +10,14 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <sched.h>         // NOLINT
+#include <signal.h>        // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
+#include <sys/mman.h>      // NOLINT
 #include <sys/resource.h>  // NOLINT
+#include <sys/syscall.h>   // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
 
@@ -37,6 +41,7 @@ namespace bin {
 int Process::global_exit_code_ = 0;
 Mutex* Process::global_exit_code_mutex_ = new Mutex();
 Process::ExitHook Process::exit_hook_ = NULL;
+intptr_t Process::output_pipe_size_ = 0;
 
 // ProcessInfo is used to map a process id to the file descriptor for
 // the pipe used to communicate the exit code of the process to Dart.
@@ -70,11 +75,19 @@ class ProcessInfoList {
  public:
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // For callers which hold mutex() from before the process is created, so
+  // that the exit code handler cannot miss its exit.
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
   }
 
+  static Mutex* mutex() { return mutex_; }
+
   static intptr_t LookupProcessExitFd(pid_t pid) {
     MutexLocker locker(mutex_);
     ProcessInfo* current = active_processes_;
@@ -243,6 +256,11 @@ int ExitCodeHandler::process_count_ = 0;
 bool ExitCodeHandler::terminate_done_ = false;
 Monitor* ExitCodeHandler::monitor_ = new Monitor();
 
+// What execvp falls back to for files without a recognized format, and for
+// an environment without PATH.
+static const char* kShellPath = "/bin/sh";
+static const char* kDefaultSearchPath = "/bin:/usr/bin";
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -268,7 +286,9 @@ class ProcessStarter {
         err_(err),
         id_(id),
         exit_event_(exit_event),
-        os_error_message_(os_error_message) {
+        os_error_message_(os_error_message),
+        shell_arguments_(NULL),
+        clone_stacks_(NULL) {
     read_in_[0] = -1;
     read_in_[1] = -1;
     read_err_[0] = -1;
@@ -304,37 +324,45 @@ class ProcessStarter {
       return err;
     }
 
-    // Fork to create the new process.
-    pid_t pid = TEMP_FAILURE_RETRY(fork());
-    if (pid < 0) {
-      // Failed to fork.
-      return CleanupAndReturnError();
-    } else if (pid == 0) {
-      // This runs in the new process.
-      NewProcess();
-    }
-
-    // This runs in the original process.
-
-    // If the child process is not started in detached mode, be sure to
-    // listen for exit-codes, now that we have a non detached child process
-    // and also Register this child process.
-    if (Process::ModeIsAttached(mode_)) {
-      ExitCodeHandler::ProcessStarted();
-      err = RegisterProcess(pid);
+    pid_t pid;
+    if (Namespace::IsDefault(namespc_)) {
+      err = StartWithClone(&pid);
       if (err != 0) {
         return err;
       }
-    }
+    } else {
+      // Fork to create the new process.
+      pid = TEMP_FAILURE_RETRY(fork());
+      if (pid < 0) {
+        // Failed to fork.
+        return CleanupAndReturnError();
+      } else if (pid == 0) {
+        // This runs in the new process.
+        NewProcess();
+      }
 
-    // Notify child process to start. This is done to delay the call to exec
-    // until the process is registered above, and we are ready to receive the
-    // exit code.
-    char msg = '1';
-    int bytes_written =
-        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
-    if (bytes_written != sizeof(msg)) {
-      return CleanupAndReturnError();
+      // This runs in the original process.
+
+      // If the child process is not started in detached mode, be sure to
+      // listen for exit-codes, now that we have a non detached child process
+      // and also Register this child process.
+      if (Process::ModeIsAttached(mode_)) {
+        ExitCodeHandler::ProcessStarted();
+        err = RegisterProcess(pid);
+        if (err != 0) {
+          return err;
+        }
+      }
+
+      // Notify child process to start. This is done to delay the call to
+      // exec until the process is registered above, and we are ready to
+      // receive the exit code.
+      char msg = '1';
+      int bytes_written =
+          FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
+      if (bytes_written != sizeof(msg)) {
+        return CleanupAndReturnError();
+      }
     }
 
     // Read the result of executing the child process.
@@ -404,6 +432,7 @@ class ProcessStarter {
     if (result < 0) {
       return CleanupAndReturnError();
     }
+    SetOutputPipeSize(read_in_[0]);
 
     // For detached processes the pipe to connect stderr and stdin are not used.
     if (Process::ModeHasStdio(mode_)) {
@@ -411,6 +440,7 @@ class ProcessStarter {
       if (result < 0) {
         return CleanupAndReturnError();
       }
+      SetOutputPipeSize(read_err_[0]);
 
       result = TEMP_FAILURE_RETRY(pipe2(write_out_, O_CLOEXEC));
       if (result < 0) {
@@ -421,6 +451,17 @@ class ProcessStarter {
     return 0;
   }
 
+  // A larger buffer lets a child that writes a lot of output run further
+  // ahead of the reads, which then return more of it at once.
+  void SetOutputPipeSize(int fd) {
+    const intptr_t size = Process::output_pipe_size();
+    if (size > 0) {
+      // Sizes above /proc/sys/fs/pipe-max-size fail for unprivileged
+      // processes, which keeps the default size.
+      NO_RETRY_EXPECTED(fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size)));
+    }
+  }
+
   void NewProcess() {
     // Wait for parent process before setting up the child process.
     char msg;
@@ -572,6 +613,257 @@ class ProcessStarter {
     }
   }
 
+  // Starts the process with clone(CLONE_VM | CLONE_VFORK) instead of fork(),
+  // so that the page tables of a large heap are neither copied nor counted
+  // against overcommit. The child runs in our memory, with this thread
+  // suspended, until it calls exec or _exit. It must therefore not allocate,
+  // take locks, let signal handlers run or change any state we rely on, such
+  // as environ or the members of this object. Errors are still reported
+  // through exec_control_.
+  //
+  // Only used with the default namespace, in which working directories and
+  // paths resolve without allocating.
+  int StartWithClone(pid_t* pid) {
+    const bool attached = Process::ModeIsAttached(mode_);
+    int event_fds[2] = {-1, -1};
+    if (attached && (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0)) {
+      return CleanupAndReturnError();
+    }
+    void* stacks = mmap(NULL, kCloneStacks * kCloneStackSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stacks == MAP_FAILED) {
+      ClosePipe(event_fds);
+      return CleanupAndReturnError();
+    }
+    clone_stacks_ = reinterpret_cast<uint8_t*>(stacks);
+    shell_arguments_ = PrepareShellArguments();
+
+    sigset_t all_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_BLOCK, &all_signals, &signal_mask_);
+    int clone_errno = 0;
+    {
+      // The exit code handler looks processes up with this lock held, so it
+      // waits for the registration below even if the child has exited.
+      MutexLocker locker(ProcessInfoList::mutex());
+      *pid = Clone(attached ? ExecProcessInCloneEntry
+                            : StartDetachedProcessInCloneEntry,
+                   0);
+      clone_errno = errno;
+      if ((*pid > 0) && attached) {
+        ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+        event_fds[1] = -1;
+        ExitCodeHandler::ProcessStarted();
+      }
+    }
+    pthread_sigmask(SIG_SETMASK, &signal_mask_, NULL);
+    munmap(stacks, kCloneStacks * kCloneStackSize);
+    clone_stacks_ = NULL;
+
+    if (*pid < 0) {
+      ClosePipe(event_fds);
+      errno = clone_errno;
+      return CleanupAndReturnError();
+    }
+    if (attached) {
+      *exit_event_ = event_fds[0];
+      FDUtils::SetNonBlocking(event_fds[0]);
+    } else {
+      // The intermediate process has exited by now. Reap it unless the exit
+      // code handler got to it first.
+      VOID_TEMP_FAILURE_RETRY(waitpid(*pid, NULL, 0));
+    }
+    return 0;
+  }
+
+  // The arguments for running a file without a recognized format with the
+  // shell, as execvp does. The file name goes at index one.
+  char** PrepareShellArguments() {
+    intptr_t count = 0;
+    while (program_arguments_[count] != NULL) {
+      count++;
+    }
+    char** arguments = reinterpret_cast<char**>(
+        Dart_ScopeAllocate((count + 2) * sizeof(*arguments)));
+    arguments[0] = const_cast<char*>(kShellPath);
+    arguments[1] = NULL;
+    for (intptr_t i = 1; i <= count; i++) {
+      arguments[i + 1] = program_arguments_[i];
+    }
+    return arguments;
+  }
+
+  pid_t Clone(int (*entry)(void*), intptr_t stack_index) {
+    // Stacks grow down on all the architectures we run on.
+    uint8_t* stack = clone_stacks_ + (stack_index + 1) * kCloneStackSize;
+    return clone(entry, stack, CLONE_VM | CLONE_VFORK | SIGCHLD, this);
+  }
+
+  static int ExecProcessInCloneEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->ExecProcessInClone();
+    return 0;
+  }
+
+  static int StartDetachedProcessInCloneEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->StartDetachedProcessInClone();
+    return 0;
+  }
+
+  static int ExecDetachedProcessInCloneEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->ExecDetachedProcessInClone();
+    return 0;
+  }
+
+  // The handlers installed by the VM would run on our memory, so the child
+  // goes back to the default for every signal which is not ignored.
+  void ResetSignalHandlersInClone() {
+    for (int sig = 1; sig < NSIG; sig++) {
+      struct sigaction action;
+      if ((sigaction(sig, NULL, &action) == 0) &&
+          (action.sa_handler != SIG_DFL) && (action.sa_handler != SIG_IGN)) {
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = SIG_DFL;
+        sigaction(sig, &action, NULL);
+      }
+    }
+  }
+
+  void ExecProcessInClone() {
+    ResetSignalHandlersInClone();
+    sigprocmask(SIG_SETMASK, &signal_mask_, NULL);
+    if (mode_ == kNormal) {
+      if (TEMP_FAILURE_RETRY(dup2(write_out_[0], STDIN_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_in_[1], STDOUT_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_err_[1], STDERR_FILENO)) == -1) {
+        ReportChildError();
+      }
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+
+    if ((working_directory_ != NULL) &&
+        (NO_RETRY_EXPECTED(chdir(working_directory_)) != 0)) {
+      ReportChildError();
+    }
+
+    char realpath[PATH_MAX];
+    if (!FindPathInNamespace(realpath, PATH_MAX)) {
+      ReportChildError();
+    }
+    ExecInClone(realpath);
+    ReportChildError();
+  }
+
+  // Runs in the intermediate process, which only starts a new session for
+  // the detached process. Its own exit lets the parent continue.
+  void StartDetachedProcessInClone() {
+    ResetSignalHandlersInClone();
+    if (TEMP_FAILURE_RETRY(setsid()) == -1) {
+      ReportChildError();
+    }
+    // The final process is not the session leader.
+    if (Clone(ExecDetachedProcessInCloneEntry, 1) < 0) {
+      ReportChildError();
+    }
+    _exit(0);
+  }
+
+  void ExecDetachedProcessInClone() {
+    sigprocmask(SIG_SETMASK, &signal_mask_, NULL);
+    if (mode_ == kDetached) {
+      SetupDetached();
+    } else {
+      SetupDetachedWithStdio();
+    }
+    if ((working_directory_ != NULL) &&
+        (NO_RETRY_EXPECTED(chdir(working_directory_)) != 0)) {
+      ReportChildError();
+    }
+    // Older C libraries cache the pid and do not update it for children
+    // sharing the parent's memory.
+    ReportPid(syscall(SYS_getpid));
+    char realpath[PATH_MAX];
+    if (!FindPathInNamespace(realpath, PATH_MAX)) {
+      ReportChildError();
+    }
+    ExecInClone(realpath);
+    ReportChildError();
+  }
+
+  // Does what execvp does once environ is the environment of the new
+  // process, without assigning environ, which the child shares with us.
+  // Returns with errno set if the file could not be run.
+  void ExecInClone(const char* file) {
+    char** environment =
+        (program_environment_ != NULL) ? program_environment_ : environ;
+    if (strchr(file, '/') != NULL) {
+      ExecFileInClone(file, environment);
+      return;
+    }
+    const char* search_path = kDefaultSearchPath;
+    for (char** entry = environment; *entry != NULL; entry++) {
+      if (strncmp(*entry, "PATH=", 5) == 0) {
+        search_path = *entry + 5;
+        break;
+      }
+    }
+    const intptr_t file_length = strlen(file);
+    bool denied = false;
+    char candidate[PATH_MAX];
+    const char* directory = search_path;
+    while (true) {
+      const char* end = strchrnul(directory, ':');
+      const intptr_t directory_length = end - directory;
+      if (directory_length + file_length + 2 <= PATH_MAX) {
+        // An empty entry stands for the current directory.
+        memmove(candidate, directory, directory_length);
+        intptr_t length = directory_length;
+        if (length > 0) {
+          candidate[length++] = '/';
+        }
+        memmove(candidate + length, file, file_length + 1);
+        ExecFileInClone(candidate, environment);
+        switch (errno) {
+          case EACCES:
+            denied = true;
+            break;
+          case ENOENT:
+          case ENOTDIR:
+          case ESTALE:
+          case ENODEV:
+          case ETIMEDOUT:
+            break;
+          default:
+            return;
+        }
+      }
+      if (*end == '\0') {
+        break;
+      }
+      directory = end + 1;
+    }
+    if (denied) {
+      errno = EACCES;
+    }
+  }
+
+  void ExecFileInClone(const char* file, char** environment) {
+    VOID_TEMP_FAILURE_RETRY(execve(file, program_arguments_, environment));
+    if (errno == ENOEXEC) {
+      shell_arguments_[1] = const_cast<char*>(file);
+      VOID_TEMP_FAILURE_RETRY(
+          execve(kShellPath, shell_arguments_, environment));
+      errno = ENOEXEC;
+    }
+  }
+
   int RegisterProcess(pid_t pid) {
     int result;
     int event_fds[2];
@@ -769,6 +1061,11 @@ class ProcessStarter {
   int write_out_[2];     // Pipe for stdin to child process.
   int exec_control_[2];  // Pipe to get the result from exec.
 
+  static const intptr_t kCloneStackSize = 64 * KB;
+  // The detached process is started from an intermediate process, which
+  // needs a stack of its own.
+  static const intptr_t kCloneStacks = 2;
+
   char** program_arguments_;
   char** program_environment_;
 
@@ -783,6 +1080,10 @@ class ProcessStarter {
   intptr_t* exit_event_;
   char** os_error_message_;
 
+  char** shell_arguments_;
+  uint8_t* clone_stacks_;
+  sigset_t signal_mask_;  // The mask to restore in the child.
+
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(ProcessStarter);
 };
@@ -10,9 +10,17 @@
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
+#if defined(HOST_OS_LINUX)
+#include <netinet/in.h>   // NOLINT
+#include <netinet/tcp.h>  // NOLINT
+#include <sys/socket.h>   // NOLINT
+#endif
+
 #include "bin/lockers.h"
 #include "bin/secure_socket_utils.h"
 #include "bin/security_context.h"
+#include "bin/socket.h"
+#include "bin/ssl_session_cache.h"
 #include "platform/syslog.h"
 #include "platform/text_buffer.h"
 
@@ -129,6 +137,13 @@ void FUNCTION_NAME(SecureSocket_Destroy)(Dart_NativeArguments args) {
   filter->Destroy();
 }
 
+void FUNCTION_NAME(SecureSocket_EnableKernelTLS)(Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 1));
+  Dart_SetBooleanReturnValue(args, filter->EnableKernelTLS(socket->fd()));
+}
+
 void FUNCTION_NAME(SecureSocket_Handshake)(Dart_NativeArguments args) {
   GetFilter(args)->Handshake();
 }
@@ -436,6 +451,18 @@ void SSLFilter::InitializeLibrary() {
   }
 }
 
+int SSLFilter::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  SSLFilter* filter =
+      static_cast<SSLFilter*>(SSL_get_ex_data(ssl, filter_ssl_index));
+  if ((filter == NULL) || filter->is_server_ ||
+      filter->accepted_bad_certificate_ || (filter->hostname_ == NULL)) {
+    return 0;
+  }
+  SSLSessionCache::Insert(filter->session_group_, filter->hostname_, session);
+  // The cache holds on to the reference it was given.
+  return 1;
+}
+
 void SSLFilter::Connect(const char* hostname,
                         SSLCertContext* context,
                         bool is_server,
@@ -462,6 +489,7 @@ void SSLFilter::Connect(const char* hostname,
   SSL_set_mode(ssl_, SSL_MODE_AUTO_RETRY);  // TODO(whesse): Is this right?
   SSL_set_ex_data(ssl_, filter_ssl_index, this);
   context->RegisterCallbacks(ssl_);
+  session_group_ = context->session_group();
 
   if (is_server_) {
     int certificate_mode =
@@ -487,6 +515,14 @@ void SSLFilter::Connect(const char* hostname,
                                          hostname_, strlen(hostname_));
     SecureSocketUtils::CheckStatusSSL(
         status, "TlsException", "Set hostname for certificate checking", ssl_);
+
+    // Offer a cached session. If the server does not take it, the handshake
+    // just goes on as a full one.
+    SSL_SESSION* session = SSLSessionCache::Lookup(session_group_, hostname_);
+    if (session != NULL) {
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
   }
   // Make the connection:
   if (is_server_) {
@@ -570,6 +606,121 @@ void SSLFilter::GetSelectedProtocol(Dart_NativeArguments args) {
   }
 }
 
+#if defined(HOST_OS_LINUX)
+// The kernel TLS interface from <linux/tls.h>, which not all of the sysroots
+// we build against have. It is part of the stable kernel ABI.
+#if !defined(TCP_ULP)
+#define TCP_ULP 31
+#endif
+#if !defined(SOL_TLS)
+#define SOL_TLS 282
+#endif
+static const int kKernelTLSTx = 1;
+static const int kKernelTLSRx = 2;
+static const uint16_t kKernelTLS12Version = 0x0303;
+static const uint16_t kKernelTLSCipherAesGcm128 = 51;
+
+static const intptr_t kAesGcm128KeyLength = 16;
+static const intptr_t kAesGcm128SaltLength = 4;
+static const intptr_t kTLSSequenceLength = 8;
+
+struct KernelTLSAesGcm128Info {
+  uint16_t version;
+  uint16_t cipher_type;
+  uint8_t iv[kTLSSequenceLength];
+  uint8_t key[kAesGcm128KeyLength];
+  uint8_t salt[kAesGcm128SaltLength];
+  uint8_t rec_seq[kTLSSequenceLength];
+};
+
+static void FillKernelTLSInfo(KernelTLSAesGcm128Info* info,
+                              const uint8_t* key,
+                              const uint8_t* salt,
+                              uint64_t sequence) {
+  memset(info, 0, sizeof(*info));
+  info->version = kKernelTLS12Version;
+  info->cipher_type = kKernelTLSCipherAesGcm128;
+  memmove(info->key, key, kAesGcm128KeyLength);
+  memmove(info->salt, salt, kAesGcm128SaltLength);
+  // BoringSSL uses the record sequence number as the explicit nonce, and
+  // the kernel continues from there.
+  for (intptr_t i = kTLSSequenceLength - 1; i >= 0; i--) {
+    info->rec_seq[i] = static_cast<uint8_t>(sequence & 0xff);
+    info->iv[i] = info->rec_seq[i];
+    sequence >>= 8;
+  }
+}
+
+static bool IsAesGcm128Cipher(const SSL_CIPHER* cipher) {
+  if (cipher == NULL) {
+    return false;
+  }
+  switch (SSL_CIPHER_get_id(cipher)) {
+    case TLS1_CK_RSA_WITH_AES_128_GCM_SHA256:
+    case TLS1_CK_ECDHE_RSA_WITH_AES_128_GCM_SHA256:
+    case TLS1_CK_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256:
+      return true;
+    default:
+      return false;
+  }
+}
+#endif  // defined(HOST_OS_LINUX)
+
+bool SSLFilter::EnableKernelTLS(intptr_t fd) {
+#if defined(HOST_OS_LINUX)
+  if ((ssl_ == NULL) || in_handshake_ ||
+      (SSL_version(ssl_) != TLS1_2_VERSION) ||
+      !IsAesGcm128Cipher(SSL_get_current_cipher(ssl_))) {
+    return false;
+  }
+  // Records that BoringSSL or the BIO pair have already taken in, or still
+  // have to send, would be lost to the kernel.
+  if (SSL_has_pending(ssl_) || (BIO_ctrl_pending(SSL_get_rbio(ssl_)) != 0) ||
+      (BIO_ctrl_pending(socket_side_) != 0)) {
+    return false;
+  }
+  // For AES-GCM the key block is the client and server write keys followed
+  // by their implicit nonces. There are no MAC keys.
+  uint8_t key_block[2 * (kAesGcm128KeyLength + kAesGcm128SaltLength)];
+  if ((SSL_get_key_block_len(ssl_) != sizeof(key_block)) ||
+      !SSL_generate_key_block(ssl_, key_block, sizeof(key_block))) {
+    return false;
+  }
+  const uint8_t* client_key = key_block;
+  const uint8_t* server_key = client_key + kAesGcm128KeyLength;
+  const uint8_t* client_salt = server_key + kAesGcm128KeyLength;
+  const uint8_t* server_salt = client_salt + kAesGcm128SaltLength;
+  KernelTLSAesGcm128Info tx;
+  KernelTLSAesGcm128Info rx;
+  FillKernelTLSInfo(&tx, is_server_ ? server_key : client_key,
+                    is_server_ ? server_salt : client_salt,
+                    SSL_get_write_sequence(ssl_));
+  FillKernelTLSInfo(&rx, is_server_ ? client_key : server_key,
+                    is_server_ ? client_salt : server_salt,
+                    SSL_get_read_sequence(ssl_));
+  memset(key_block, 0, sizeof(key_block));
+
+  // Receiving is set up first, since it needs a newer kernel. An attached
+  // upper layer protocol without keys leaves the socket working as before.
+  bool enabled =
+      (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0) &&
+      (setsockopt(fd, SOL_TLS, kKernelTLSRx, &rx, sizeof(rx)) == 0);
+  const bool tx_failed =
+      enabled && (setsockopt(fd, SOL_TLS, kKernelTLSTx, &tx, sizeof(tx)) != 0);
+  memset(&tx, 0, sizeof(tx));
+  memset(&rx, 0, sizeof(rx));
+  if (tx_failed) {
+    // The kernel decrypts records already, so the connection cannot go
+    // back to BoringSSL.
+    SecureSocketUtils::ThrowIOException(-1, "TlsException",
+                                        "Failed to set up kernel TLS", NULL);
+  }
+  return enabled;
+#else
+  return false;
+#endif  // defined(HOST_OS_LINUX)
+}
+
 void SSLFilter::Renegotiate(bool use_session_cache,
                             bool request_client_certificate,
                             bool require_client_certificate) {
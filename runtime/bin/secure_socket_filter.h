@@ -45,13 +45,18 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
         handshake_complete_(NULL),
         bad_certificate_callback_(NULL),
         in_handshake_(false),
-        hostname_(NULL) {}
+        hostname_(NULL),
+        session_group_(0),
+        accepted_bad_certificate_(false) {}
 
   ~SSLFilter();
 
   char* hostname() const { return hostname_; }
   bool is_server() const { return is_server_; }
   bool is_client() const { return !is_server_; }
+  // Sessions of connections whose certificate was only accepted by the bad
+  // certificate callback are not cached.
+  void set_accepted_bad_certificate() { accepted_bad_certificate_ = true; }
 
   Dart_Handle Init(Dart_Handle dart_this);
   void Connect(const char* hostname,
@@ -63,6 +68,10 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   void Destroy();
   void FreeResources();
   void Handshake();
+  // Hands record encryption and decryption for the connection on |fd| over
+  // to the kernel and returns true, if the platform, protocol version and
+  // cipher allow it and no records are buffered.
+  bool EnableKernelTLS(intptr_t fd);
   void GetSelectedProtocol(Dart_NativeArguments args);
   void Renegotiate(bool use_session_cache,
                    bool request_client_certificate,
@@ -81,6 +90,8 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
                          bool in_handshake);
   Dart_Handle PeerCertificate();
   static void InitializeLibrary();
+  // Offers new client sessions to the SSLSessionCache.
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
   Dart_Handle callback_error;
 
   static CObject* ProcessFilterRequest(const CObjectArray& request);
@@ -107,6 +118,8 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   bool in_handshake_;
   bool is_server_;
   char* hostname_;
+  intptr_t session_group_;
+  bool accepted_bad_certificate_;
 
   static bool IsBufferEncrypted(int i) {
     return static_cast<BufferIndex>(i) >= kFirstEncrypted;
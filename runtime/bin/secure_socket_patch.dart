@@ -40,6 +40,13 @@ class _SecureSocket extends _Socket implements SecureSocket {
         requireClientCertificate: requireClientCertificate);
   }
 
+  bool enableKernelTls() {
+    if (_raw == null) {
+      throw new StateError("enableKernelTls called on destroyed SecureSocket");
+    }
+    return _raw.enableKernelTls();
+  }
+
   X509Certificate get peerCertificate {
     if (_raw == null) {
       throw new StateError("peerCertificate called on destroyed SecureSocket");
@@ -100,6 +107,16 @@ class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   void handshake() native "SecureSocket_Handshake";
 
+  bool enableKernelTls(RawSocket socket) {
+    // Only a socket with a file descriptor of its own can be handed over.
+    if (socket is! _RawSocket) return false;
+    _RawSocket rawSocket = socket;
+    return _enableKernelTls(rawSocket._socket);
+  }
+
+  bool _enableKernelTls(_NativeSocket socket)
+      native "SecureSocket_EnableKernelTLS";
+
   void rehandshake() => throw new UnimplementedError();
 
   int processBuffer(int bufferIndex) => throw new UnimplementedError();
@@ -18,6 +18,8 @@
 #include "bin/file.h"
 #include "bin/secure_socket_filter.h"
 #include "bin/secure_socket_utils.h"
+#include "bin/ssl_session_cache.h"
+#include "platform/atomic.h"
 #include "platform/syslog.h"
 
 // Return the error from the containing function if handle is an error handle.
@@ -34,6 +36,8 @@ namespace bin {
 
 const char* SSLCertContext::root_certs_file_ = NULL;
 const char* SSLCertContext::root_certs_cache_ = NULL;
+intptr_t SSLCertContext::next_session_group_ =
+    SSLCertContext::kBuiltinRootsSessionGroup + 1;
 
 int SSLCertContext::CertificateCallback(int preverify_ok,
                                         X509_STORE_CTX* store_ctx) {
@@ -76,7 +80,24 @@ int SSLCertContext::CertificateCallback(int preverify_ok,
     filter->callback_error = result;
     return 0;
   }
-  return DartUtils::GetBooleanValue(result);
+  if (!DartUtils::GetBooleanValue(result)) {
+    return 0;
+  }
+  filter->set_accepted_bad_certificate();
+  return 1;
+}
+
+intptr_t SSLCertContext::NewSessionGroup() {
+  return AtomicOperations::FetchAndIncrement(&next_session_group_);
+}
+
+void SSLCertContext::SetSessionGroup(intptr_t group) {
+  session_group_ = group;
+  // Servers only resume sessions with a matching id context, which keeps
+  // them from honoring tickets issued under a configuration of another group.
+  SSL_CTX_set_session_id_context(context_,
+                                 reinterpret_cast<const uint8_t*>(&group),
+                                 sizeof(group));
 }
 
 SSLCertContext* SSLCertContext::GetSecurityContext(Dart_NativeArguments args) {
@@ -800,6 +821,7 @@ void FUNCTION_NAME(SecurityContext_UsePrivateKeyBytes)(
   SSLCertContext* context = SSLCertContext::GetSecurityContext(args);
   const char* password = SSLCertContext::GetPasswordArgument(args, 2);
 
+  context->MarkCustomized();
   int status;
   {
     ScopedMemBIO bio(ThrowIfError(Dart_GetNativeArgument(args, 1)));
@@ -824,7 +846,13 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, SSLCertContext::CertificateCallback);
   SSL_CTX_set_min_proto_version(ctx, TLS1_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  // Client sessions go to the process-wide cache from the callback; the
+  // internal cache is only consulted by servers.
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_sess_set_new_cb(ctx, SSLFilter::NewSessionCallback);
+  SSLTicketKeys::Register(ctx);
   SSLCertContext* context = new SSLCertContext(ctx);
+  context->SetSessionGroup(SSLCertContext::NewSessionGroup());
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
     delete context;
@@ -840,6 +868,7 @@ void FUNCTION_NAME(SecurityContext_SetTrustedCertificatesBytes)(
 
   ASSERT(context != NULL);
   ASSERT(password != NULL);
+  context->MarkCustomized();
   context->SetTrustedCertificatesBytes(cert_bytes, password);
 }
 
@@ -853,6 +882,7 @@ void FUNCTION_NAME(SecurityContext_SetClientAuthoritiesBytes)(
   ASSERT(context != NULL);
   ASSERT(password != NULL);
 
+  context->MarkCustomized();
   context->SetClientAuthoritiesBytes(client_authorities_bytes, password);
 }
 
@@ -865,6 +895,7 @@ void FUNCTION_NAME(SecurityContext_UseCertificateChainBytes)(
   ASSERT(context != NULL);
   ASSERT(password != NULL);
 
+  context->MarkCustomized();
   int status = context->UseCertificateChainBytes(cert_chain_bytes, password);
 
   SecureSocketUtils::CheckStatus(status, "TlsException",
@@ -878,6 +909,9 @@ void FUNCTION_NAME(SecurityContext_TrustBuiltinRoots)(
   ASSERT(context != NULL);
 
   context->TrustBuiltinRoots();
+  context->SetSessionGroup(context->customized()
+                               ? SSLCertContext::NewSessionGroup()
+                               : SSLCertContext::kBuiltinRootsSessionGroup);
 }
 
 void FUNCTION_NAME(X509_Der)(Dart_NativeArguments args) {
@@ -24,11 +24,17 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   static const int kSecurityContextNativeFieldIndex = 0;
   static const int kX509NativeFieldIndex = 0;
 
+  // Contexts which have only been told to trust the built-in roots all share
+  // this session group, see SSLSessionCache.
+  static const intptr_t kBuiltinRootsSessionGroup = 1;
+
   explicit SSLCertContext(SSL_CTX* context)
       : ReferenceCounted(),
         context_(context),
         alpn_protocol_string_(NULL),
-        trust_builtin_(false) {}
+        trust_builtin_(false),
+        session_group_(0),
+        customized_(false) {}
 
   ~SSLCertContext() {
     SSL_CTX_free(context_);
@@ -84,6 +90,19 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   void RegisterCallbacks(SSL* ssl);
 
+  // Sessions verified with this context may only be resumed by contexts in
+  // the same group. A context gets a group of its own as soon as it is
+  // configured with certificates or keys.
+  intptr_t session_group() const { return session_group_; }
+  void SetSessionGroup(intptr_t group);
+  void MarkCustomized() {
+    customized_ = true;
+    SetSessionGroup(NewSessionGroup());
+  }
+  bool customized() const { return customized_; }
+
+  static intptr_t NewSessionGroup();
+
  private:
   void AddCompiledInCerts();
   void LoadRootCertFile(const char* file);
@@ -91,11 +110,14 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   static const char* root_certs_file_;
   static const char* root_certs_cache_;
+  static intptr_t next_session_group_;
 
   SSL_CTX* context_;
   uint8_t* alpn_protocol_string_;
 
   bool trust_builtin_;
+  intptr_t session_group_;
+  bool customized_;
 
   DISALLOW_COPY_AND_ASSIGN(SSLCertContext);
 };
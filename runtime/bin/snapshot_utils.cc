@@ -9,8 +9,12 @@
 #include "bin/error_exit.h"
 #include "bin/extensions.h"
 #include "bin/file.h"
+#include "bin/gzip.h"
+#include "bin/lockers.h"
 #include "bin/platform.h"
+#include "bin/thread.h"
 #include "include/dart_api.h"
+#include "platform/atomic.h"
 #include "platform/utils.h"
 
 #define LOG_SECTION_BOUNDARIES false
@@ -26,22 +30,40 @@ extern const char* kIsolateSnapshotInstructionsSymbolName;
 static const int64_t kAppSnapshotHeaderSize = 5 * kInt64Size;
 static const int64_t kAppSnapshotPageSize = 4 * KB;
 
+// The data sections of a snapshot written with compressed data sections are
+// split into frames which are gzip compressed independently, so that they
+// can be decompressed in parallel:
+//
+//   int64 uncompressed size of the section
+//   int64 number of frames
+//   int64 compressed size of each frame
+//   the compressed frames
+//
+// The instructions sections are not compressed, they are mapped executable.
+static const int64_t kCompressedFrameSize = 1 * MB;
+
 class MappedAppSnapshot : public AppSnapshot {
  public:
   MappedAppSnapshot(MappedMemory* vm_snapshot_data,
                     MappedMemory* vm_snapshot_instructions,
                     MappedMemory* isolate_snapshot_data,
-                    MappedMemory* isolate_snapshot_instructions)
+                    MappedMemory* isolate_snapshot_instructions,
+                    uint8_t* decompressed_vm_data = NULL,
+                    uint8_t* decompressed_isolate_data = NULL)
       : vm_data_mapping_(vm_snapshot_data),
         vm_instructions_mapping_(vm_snapshot_instructions),
         isolate_data_mapping_(isolate_snapshot_data),
-        isolate_instructions_mapping_(isolate_snapshot_instructions) {}
+        isolate_instructions_mapping_(isolate_snapshot_instructions),
+        decompressed_vm_data_(decompressed_vm_data),
+        decompressed_isolate_data_(decompressed_isolate_data) {}
 
   ~MappedAppSnapshot() {
     delete vm_data_mapping_;
     delete vm_instructions_mapping_;
     delete isolate_data_mapping_;
     delete isolate_instructions_mapping_;
+    free(decompressed_vm_data_);
+    free(decompressed_isolate_data_);
   }
 
   void SetBuffers(const uint8_t** vm_data_buffer,
@@ -64,6 +86,12 @@ class MappedAppSnapshot : public AppSnapshot {
       *isolate_instructions_buffer = reinterpret_cast<const uint8_t*>(
           isolate_instructions_mapping_->address());
     }
+    if (decompressed_vm_data_ != NULL) {
+      *vm_data_buffer = decompressed_vm_data_;
+    }
+    if (decompressed_isolate_data_ != NULL) {
+      *isolate_data_buffer = decompressed_isolate_data_;
+    }
   }
 
  private:
@@ -71,8 +99,121 @@ class MappedAppSnapshot : public AppSnapshot {
   MappedMemory* vm_instructions_mapping_;
   MappedMemory* isolate_data_mapping_;
   MappedMemory* isolate_instructions_mapping_;
+  uint8_t* decompressed_vm_data_;
+  uint8_t* decompressed_isolate_data_;
 };
 
+class DataSectionDecompressor {
+ public:
+  DataSectionDecompressor(const char* script_name,
+                          const uint8_t* section,
+                          int64_t section_size)
+      : script_name_(script_name),
+        next_frame_(0),
+        pending_threads_(0) {
+    const int64_t* header = reinterpret_cast<const int64_t*>(section);
+    if (section_size < 2 * kInt64Size) {
+      FATAL1("Corrupt compressed snapshot: %s\n", script_name_);
+    }
+    size_ = header[0];
+    num_frames_ = header[1];
+    if ((size_ < 0) || (num_frames_ < 0) ||
+        (num_frames_ !=
+         (size_ + kCompressedFrameSize - 1) / kCompressedFrameSize) ||
+        (section_size < (2 + num_frames_) * kInt64Size)) {
+      FATAL1("Corrupt compressed snapshot: %s\n", script_name_);
+    }
+    frame_sizes_ = &header[2];
+    frame_starts_ = new const uint8_t*[num_frames_];
+    const uint8_t* frame = section + (2 + num_frames_) * kInt64Size;
+    for (intptr_t i = 0; i < num_frames_; i++) {
+      frame_starts_[i] = frame;
+      frame += frame_sizes_[i];
+    }
+    if (frame > section + section_size) {
+      FATAL1("Corrupt compressed snapshot: %s\n", script_name_);
+    }
+    output_ = reinterpret_cast<uint8_t*>(malloc(size_));
+  }
+
+  ~DataSectionDecompressor() { delete[] frame_starts_; }
+
+  // Returns the decompressed section, which is allocated in the C heap and
+  // owned by the caller.
+  uint8_t* Decompress() {
+    const intptr_t num_threads =
+        Utils::Minimum<intptr_t>(Platform::NumberOfProcessors(), num_frames_);
+    for (intptr_t i = 1; i < num_threads; i++) {
+      {
+        MonitorLocker ml(&monitor_);
+        pending_threads_++;
+      }
+      if (Thread::Start("dart:snapshot-decompressor", &DecompressThread,
+                        reinterpret_cast<uword>(this)) != 0) {
+        MonitorLocker ml(&monitor_);
+        pending_threads_--;
+      }
+    }
+    DecompressFrames();
+    MonitorLocker ml(&monitor_);
+    while (pending_threads_ > 0) {
+      ml.Wait(Monitor::kNoTimeout);
+    }
+    return output_;
+  }
+
+ private:
+  static void DecompressThread(uword parameter) {
+    DataSectionDecompressor* decompressor =
+        reinterpret_cast<DataSectionDecompressor*>(parameter);
+    decompressor->DecompressFrames();
+    MonitorLocker ml(&decompressor->monitor_);
+    decompressor->pending_threads_--;
+    ml.Notify();
+  }
+
+  void DecompressFrames() {
+    for (;;) {
+      const intptr_t i = AtomicOperations::FetchAndIncrement(&next_frame_);
+      if (i >= num_frames_) break;
+      const int64_t start = i * kCompressedFrameSize;
+      const int64_t expected_size =
+          Utils::Minimum(kCompressedFrameSize, size_ - start);
+      uint8_t* frame = NULL;
+      intptr_t frame_size = 0;
+      bin::Decompress(frame_starts_[i], frame_sizes_[i], &frame, &frame_size);
+      if (frame_size != expected_size) {
+        FATAL1("Corrupt compressed snapshot: %s\n", script_name_);
+      }
+      memmove(output_ + start, frame, frame_size);
+      free(frame);
+    }
+  }
+
+  const char* script_name_;
+  int64_t size_;
+  int64_t num_frames_;
+  const int64_t* frame_sizes_;
+  const uint8_t** frame_starts_;
+  uint8_t* output_;
+  intptr_t next_frame_;
+  Monitor monitor_;
+  intptr_t pending_threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(DataSectionDecompressor);
+};
+
+// Decompresses the data section in [mapping] and releases the mapping.
+static uint8_t* DecompressDataSection(const char* script_name,
+                                      MappedMemory* mapping) {
+  DataSectionDecompressor decompressor(
+      script_name, reinterpret_cast<const uint8_t*>(mapping->address()),
+      mapping->size());
+  uint8_t* result = decompressor.Decompress();
+  delete mapping;
+  return result;
+}
+
 static AppSnapshot* TryReadAppSnapshotBlobs(const char* script_name) {
   File* file = File::Open(NULL, script_name, File::kRead);
   if (file == NULL) {
@@ -88,8 +229,12 @@ static AppSnapshot* TryReadAppSnapshotBlobs(const char* script_name) {
     return NULL;
   }
   ASSERT(sizeof(header[0]) == appjit_magic_number.length);
-  if (memcmp(&header[0], appjit_magic_number.bytes,
-             appjit_magic_number.length) != 0) {
+  ASSERT(sizeof(header[0]) == appjit_compressed_magic_number.length);
+  const bool compressed =
+      memcmp(&header[0], appjit_compressed_magic_number.bytes,
+             appjit_compressed_magic_number.length) == 0;
+  if (!compressed && (memcmp(&header[0], appjit_magic_number.bytes,
+                             appjit_magic_number.length) != 0)) {
     return NULL;
   }
 
@@ -150,6 +295,19 @@ static AppSnapshot* TryReadAppSnapshotBlobs(const char* script_name) {
     }
   }
 
+  if (compressed) {
+    uint8_t* vm_data = NULL;
+    if (vm_data_mapping != NULL) {
+      vm_data = DecompressDataSection(script_name, vm_data_mapping);
+    }
+    uint8_t* isolate_data = NULL;
+    if (isolate_data_mapping != NULL) {
+      isolate_data = DecompressDataSection(script_name, isolate_data_mapping);
+    }
+    return new MappedAppSnapshot(NULL, vm_instr_mapping, NULL,
+                                 isolate_instr_mapping, vm_data, isolate_data);
+  }
+
   return new MappedAppSnapshot(vm_data_mapping, vm_instr_mapping,
                                isolate_data_mapping, isolate_instr_mapping);
 }
@@ -270,6 +428,41 @@ static bool WriteInt64(File* file, int64_t size) {
   return file->WriteFully(&size, sizeof(size));
 }
 
+// Returns the compressed form of a data section, allocated in the C heap.
+static uint8_t* CompressDataSection(const uint8_t* buffer,
+                                    intptr_t size,
+                                    intptr_t* compressed_size) {
+  const intptr_t num_frames =
+      (size + kCompressedFrameSize - 1) / kCompressedFrameSize;
+  uint8_t** frames = new uint8_t*[num_frames];
+  intptr_t* frame_sizes = new intptr_t[num_frames];
+  intptr_t result_size = (2 + num_frames) * kInt64Size;
+  for (intptr_t i = 0; i < num_frames; i++) {
+    const intptr_t start = i * kCompressedFrameSize;
+    Compress(buffer + start,
+             Utils::Minimum<intptr_t>(kCompressedFrameSize, size - start),
+             &frames[i], &frame_sizes[i]);
+    result_size += frame_sizes[i];
+  }
+
+  uint8_t* result = reinterpret_cast<uint8_t*>(malloc(result_size));
+  int64_t* header = reinterpret_cast<int64_t*>(result);
+  header[0] = size;
+  header[1] = num_frames;
+  intptr_t cursor = (2 + num_frames) * kInt64Size;
+  for (intptr_t i = 0; i < num_frames; i++) {
+    header[2 + i] = frame_sizes[i];
+    memmove(result + cursor, frames[i], frame_sizes[i]);
+    cursor += frame_sizes[i];
+    free(frames[i]);
+  }
+  ASSERT(cursor == result_size);
+  delete[] frames;
+  delete[] frame_sizes;
+  *compressed_size = result_size;
+  return result;
+}
+
 void Snapshot::WriteAppSnapshot(const char* filename,
                                 uint8_t* vm_data_buffer,
                                 intptr_t vm_data_size,
@@ -278,13 +471,31 @@ void Snapshot::WriteAppSnapshot(const char* filename,
                                 uint8_t* isolate_data_buffer,
                                 intptr_t isolate_data_size,
                                 uint8_t* isolate_instructions_buffer,
-                                intptr_t isolate_instructions_size) {
+                                intptr_t isolate_instructions_size,
+                                bool compress_data_sections) {
   File* file = File::Open(NULL, filename, File::kWriteTruncate);
   if (file == NULL) {
     ErrorExit(kErrorExitCode, "Unable to write snapshot file '%s'\n", filename);
   }
 
-  file->WriteFully(appjit_magic_number.bytes, appjit_magic_number.length);
+  uint8_t* compressed_vm_data = NULL;
+  uint8_t* compressed_isolate_data = NULL;
+  if (compress_data_sections) {
+    if (vm_data_size != 0) {
+      compressed_vm_data =
+          CompressDataSection(vm_data_buffer, vm_data_size, &vm_data_size);
+      vm_data_buffer = compressed_vm_data;
+    }
+    if (isolate_data_size != 0) {
+      compressed_isolate_data = CompressDataSection(
+          isolate_data_buffer, isolate_data_size, &isolate_data_size);
+      isolate_data_buffer = compressed_isolate_data;
+    }
+    file->WriteFully(appjit_compressed_magic_number.bytes,
+                     appjit_compressed_magic_number.length);
+  } else {
+    file->WriteFully(appjit_magic_number.bytes, appjit_magic_number.length);
+  }
   WriteInt64(file, vm_data_size);
   WriteInt64(file, vm_instructions_size);
   WriteInt64(file, isolate_data_size);
@@ -332,6 +543,8 @@ void Snapshot::WriteAppSnapshot(const char* filename,
 
   file->Flush();
   file->Release();
+  free(compressed_vm_data);
+  free(compressed_isolate_data);
 }
 
 void Snapshot::GenerateKernel(const char* snapshot_filename,
@@ -370,7 +583,7 @@ void Snapshot::GenerateAppJIT(const char* snapshot_filename) {
   }
 
   WriteAppSnapshot(snapshot_filename, NULL, 0, NULL, 0, isolate_buffer,
-                   isolate_size, NULL, 0);
+                   isolate_size, NULL, 0, /*compress_data_sections=*/false);
 #else
   uint8_t* isolate_data_buffer = NULL;
   intptr_t isolate_data_size = 0;
@@ -384,7 +597,8 @@ void Snapshot::GenerateAppJIT(const char* snapshot_filename) {
   }
   WriteAppSnapshot(snapshot_filename, NULL, 0, NULL, 0, isolate_data_buffer,
                    isolate_data_size, isolate_instructions_buffer,
-                   isolate_instructions_size);
+                   isolate_instructions_size,
+                   /*compress_data_sections=*/false);
 #endif
 }
 
@@ -410,7 +624,8 @@ void Snapshot::GenerateAppAOTAsBlobs(const char* snapshot_filename,
   WriteAppSnapshot(snapshot_filename, vm_data_buffer, vm_data_size,
                    vm_instructions_buffer, vm_instructions_size,
                    isolate_data_buffer, isolate_data_size,
-                   isolate_instructions_buffer, isolate_instructions_size);
+                   isolate_instructions_buffer, isolate_instructions_size,
+                   /*compress_data_sections=*/false);
 }
 
 static void StreamingWriteCallback(void* callback_data,
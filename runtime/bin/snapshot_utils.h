@@ -46,7 +46,8 @@ class Snapshot {
                                uint8_t* isolate_data_buffer,
                                intptr_t isolate_data_size,
                                uint8_t* isolate_instructions_buffer,
-                               intptr_t isolate_instructions_size);
+                               intptr_t isolate_instructions_size,
+                               bool compress_data_sections);
 
  private:
   DISALLOW_ALLOCATION();
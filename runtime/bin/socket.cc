@@ -6,6 +6,8 @@
 
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/file.h"
+#include "bin/host_lookup_cache.h"
 #include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/lockers.h"
@@ -27,6 +29,7 @@ ListeningSocketRegistry* globalTcpListeningSocketRegistry = NULL;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
+bool Socket::socket_read_ahead_ = false;
 
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == NULL);
@@ -93,7 +96,8 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
                                                       RawAddr addr,
                                                       intptr_t backlog,
                                                       bool v6_only,
-                                                      bool shared) {
+                                                      bool shared,
+                                                      bool reuse_port) {
   MutexLocker ml(mutex_);
 
   OSSocket* first_os_socket = NULL;
@@ -108,7 +112,15 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
       OSSocket* os_socket_same_addr = FindOSSocketWithAddress(os_socket, addr);
 
       if (os_socket_same_addr != NULL) {
-        if (!os_socket_same_addr->shared || !shared) {
+        if (os_socket_same_addr->reuse_port != reuse_port) {
+          OSError os_error(-1,
+                           "The reusePort flag to bind() needs to be the same "
+                           "if binding multiple times on the same (address, "
+                           "port) combination.",
+                           OSError::kUnknown);
+          return DartUtils::NewDartOSError(&os_error);
+        }
+        if (!reuse_port && (!os_socket_same_addr->shared || !shared)) {
           OSError os_error(-1,
                            "The shared flag to bind() needs to be `true` if "
                            "binding multiple times on the same (address, port) "
@@ -124,7 +136,8 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
                            OSError::kUnknown);
           return DartUtils::NewDartOSError(&os_error);
         }
-
+      }
+      if ((os_socket_same_addr != NULL) && !reuse_port) {
         // This socket creation is the exact same as the one which originally
         // created the socket. We therefore increment the refcount and reuse
         // the file descriptor.
@@ -142,8 +155,11 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
     }
   }
 
-  // There is no socket listening on that (address, port), so we create new one.
-  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
+  // There is no socket listening on that (address, port), or every bind gets
+  // a socket of its own with SO_REUSEPORT, so we create a new one. The kernel
+  // then balances the incoming connections across those sockets.
+  intptr_t fd =
+      ServerSocket::CreateBindListen(addr, backlog, v6_only, reuse_port);
   if (fd == -5) {
     OSError os_error(-1, "Invalid host", OSError::kUnknown);
     return DartUtils::NewDartOSError(&os_error);
@@ -179,7 +195,7 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
 
   Socket* socketfd = new Socket(fd);
   OSSocket* os_socket =
-      new OSSocket(addr, allocated_port, v6_only, shared, socketfd);
+      new OSSocket(addr, allocated_port, v6_only, shared, reuse_port, socketfd);
   os_socket->ref_count = 1;
   os_socket->next = first_os_socket;
 
@@ -193,6 +209,30 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
   return Dart_True();
 }
 
+Socket* ListeningSocketRegistry::CreateSharedBindListen(RawAddr addr,
+                                                        intptr_t backlog,
+                                                        bool v6_only) {
+  MutexLocker ml(mutex_);
+
+  const intptr_t port = SocketAddress::GetAddrPort(addr);
+  ASSERT(port > 0);
+  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
+  if ((fd < 0) || !ServerSocket::StartAccept(fd)) {
+    return NULL;
+  }
+
+  Socket* socketfd = new Socket(fd);
+  OSSocket* os_socket = new OSSocket(addr, port, v6_only, /*shared=*/true,
+                                     /*reuse_port=*/false, socketfd);
+  // The reference of the caller, which is never dropped.
+  os_socket->ref_count = 1;
+  os_socket->next = LookupByPort(port);
+
+  InsertByPort(port, os_socket);
+  InsertByFd(socketfd, os_socket);
+  return socketfd;
+}
+
 bool ListeningSocketRegistry::CloseOneSafe(OSSocket* os_socket,
                                            bool update_hash_maps) {
   ASSERT(!mutex_->TryLock());
@@ -311,11 +351,10 @@ void FUNCTION_NAME(Socket_CreateBindDatagram)(Dart_NativeArguments args) {
 }
 
 void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
-  Socket* socket =
-      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Socket* socket = Socket::GetReceiverSocketIdNativeField(args);
   intptr_t available = SocketBase::Available(socket->fd());
   if (available >= 0) {
-    Dart_SetIntegerReturnValue(args, available);
+    Dart_SetIntegerReturnValue(args, socket->read_ahead_length() + available);
   } else {
     // Available failed. Mark socket as having data, to trigger a future read
     // event where the actual error can be reported.
@@ -323,6 +362,102 @@ void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
   }
 }
 
+intptr_t Socket::ReadAhead(bool* more) {
+  const intptr_t buffered = read_ahead_length();
+  if (buffered > 0) {
+    // Another read event came before the buffered bytes were taken, so
+    // there is more in the socket.
+    *more = true;
+    return buffered;
+  }
+  *more = false;
+  if (fd_ == kClosedFd) {
+    return -1;
+  }
+  const intptr_t size = read_ahead_size_;
+  if (read_ahead_buffer_ == NULL) {
+    read_ahead_buffer_ = IOBuffer::Allocate(size);
+    if (read_ahead_buffer_ == NULL) {
+      return SocketBase::Available(fd_);
+    }
+  }
+  const intptr_t bytes_read =
+      SocketBase::Read(fd_, read_ahead_buffer_, size, SocketBase::kAsync);
+  if (bytes_read <= 0) {
+    // Nothing to read, the end of the stream or an error which the next
+    // Read reports.
+    IOBuffer::Free(read_ahead_buffer_);
+    read_ahead_buffer_ = NULL;
+    return bytes_read;
+  }
+  read_ahead_start_ = 0;
+  read_ahead_end_ = bytes_read;
+  if (bytes_read == size) {
+    // A full read may have left data behind, so read more next time.
+    read_ahead_size_ = Utils::Minimum(2 * size, kMaxReadAheadSize);
+    *more = true;
+  } else if (bytes_read < size / 4) {
+    // A short read drained the socket.
+    read_ahead_size_ = Utils::Maximum(size / 2, kMinReadAheadSize);
+  }
+  return bytes_read;
+}
+
+intptr_t Socket::TakeReadAhead(uint8_t* buffer, intptr_t length) {
+  const intptr_t count = Utils::Minimum(length, read_ahead_length());
+  if (count == 0) {
+    return 0;
+  }
+  memmove(buffer, read_ahead_buffer_ + read_ahead_start_, count);
+  read_ahead_start_ += count;
+  if (read_ahead_start_ == read_ahead_end_) {
+    // Do not keep a buffer per idle connection.
+    IOBuffer::Free(read_ahead_buffer_);
+    read_ahead_buffer_ = NULL;
+    read_ahead_start_ = 0;
+    read_ahead_end_ = 0;
+  }
+  return count;
+}
+
+Dart_Handle Socket::TakeReadAheadBuffer(intptr_t length) {
+  if ((read_ahead_start_ != 0) || (length != read_ahead_end_) ||
+      (length == 0)) {
+    return Dart_Null();
+  }
+  // Shrinking an allocation does not move it with common allocators.
+  uint8_t* data =
+      reinterpret_cast<uint8_t*>(realloc(read_ahead_buffer_, length));
+  if (data == NULL) {
+    data = read_ahead_buffer_;
+  }
+  read_ahead_buffer_ = NULL;
+  read_ahead_start_ = 0;
+  read_ahead_end_ = 0;
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, data, length, data, length, IOBuffer::Finalizer);
+  if (Dart_IsError(result)) {
+    IOBuffer::Free(data);
+  }
+  return result;
+}
+
+// Returns twice the number of bytes that can be read without blocking, plus
+// one if the socket may have more data than that.
+void FUNCTION_NAME(Socket_ReadAhead)(Dart_NativeArguments args) {
+  Socket* socket = Socket::GetReceiverSocketIdNativeField(args);
+  bool more = false;
+  intptr_t available = Socket::socket_read_ahead()
+                           ? socket->ReadAhead(&more)
+                           : SocketBase::Available(socket->fd());
+  if (available < 0) {
+    // As in Socket_Available, trigger a read where the error is reported.
+    available = 1;
+    more = false;
+  }
+  Dart_SetIntegerReturnValue(args, 2 * available + (more ? 1 : 0));
+}
+
 void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -332,6 +467,16 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
+    if (socket->read_ahead_length() == length) {
+      Dart_Handle result = socket->TakeReadAheadBuffer(length);
+      if (Dart_IsError(result)) {
+        Dart_PropagateError(result);
+      }
+      if (!Dart_IsNull(result)) {
+        Dart_SetReturnValue(args, result);
+        return;
+      }
+    }
     uint8_t* buffer = NULL;
     Dart_Handle result = IOBuffer::Allocate(length, &buffer);
     if (Dart_IsNull(result)) {
@@ -342,8 +487,17 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
       Dart_PropagateError(result);
     }
     ASSERT(buffer != NULL);
-    intptr_t bytes_read =
-        SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+    intptr_t bytes_read = socket->TakeReadAhead(buffer, length);
+    if (bytes_read < length) {
+      const intptr_t more =
+          SocketBase::Read(socket->fd(), buffer + bytes_read,
+                           length - bytes_read, SocketBase::kAsync);
+      if (more >= 0) {
+        bytes_read += more;
+      } else if (bytes_read == 0) {
+        bytes_read = -1;
+      }
+    }
     if (bytes_read == length) {
       Dart_SetReturnValue(args, result);
     } else if (bytes_read > 0) {
@@ -373,48 +527,60 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
-  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
-  // handle 64k datagrams.
-  const int kReceiveBufferLen = 65536;
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-
-  // Ensure that a receive buffer for the UDP socket exists.
-  ASSERT(socket != NULL);
-  uint8_t* recv_buffer = socket->udp_receive_buffer();
-  if (recv_buffer == NULL) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
-    socket->set_udp_receive_buffer(recv_buffer);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t start = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
   }
-
-  // Read data into the buffer.
-  RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
-  if (bytes_read == 0) {
-    Dart_SetReturnValue(args, Dart_Null());
-    return;
+  Dart_TypedData_Type type;
+  uint8_t* buffer = NULL;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
   }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    return;
+  ASSERT(type == Dart_TypedData_kUint8);
+  ASSERT((start + length) <= len);
+  buffer += start;
+  intptr_t bytes_read = socket->TakeReadAhead(buffer, length);
+  if (bytes_read < length) {
+    const intptr_t more =
+        SocketBase::Read(socket->fd(), buffer + bytes_read,
+                         length - bytes_read, SocketBase::kAsync);
+    if (more >= 0) {
+      bytes_read += more;
+    } else if (bytes_read == 0) {
+      // Extract OSError before we release data, as it may override the error.
+      OSError os_error;
+      Dart_TypedDataReleaseData(buffer_obj);
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+      return;
+    }
   }
+  Dart_TypedDataReleaseData(buffer_obj);
+  Dart_SetIntegerReturnValue(args, bytes_read);
+}
 
-  // Datagram data read. Copy into buffer of the exact size,
-  ASSERT(bytes_read > 0);
+// Creates a Datagram object from a datagram received from |addr|.
+static Dart_Handle NewDatagram(Dart_Handle io_lib,
+                               const uint8_t* buffer,
+                               intptr_t length,
+                               RawAddr addr) {
   uint8_t* data_buffer = NULL;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
+  Dart_Handle data = IOBuffer::Allocate(length, &data_buffer);
   if (Dart_IsNull(data)) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    return;
+    return DartUtils::NewDartOSError();
   }
   if (Dart_IsError(data)) {
     Dart_PropagateError(data);
   }
   ASSERT(data_buffer != NULL);
-  memmove(data_buffer, recv_buffer, bytes_read);
+  memmove(data_buffer, buffer, length);
 
   // Get the port and clear it in the sockaddr structure.
   int port = SocketAddress::GetAddrPort(addr);
@@ -441,13 +607,103 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   if (Dart_IsError(dart_args[3])) {
     Dart_PropagateError(dart_args[3]);
   }
+  return Dart_Invoke(io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs,
+                     dart_args);
+}
+
+static Dart_Handle LookupIOLibrary() {
   // TODO(sgjesse): Cache the _makeDatagram function somewhere.
   Dart_Handle io_lib = Dart_LookupLibrary(DartUtils::NewString("dart:io"));
   if (Dart_IsError(io_lib)) {
     Dart_PropagateError(io_lib);
   }
-  Dart_Handle result = Dart_Invoke(
-      io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs, dart_args);
+  return io_lib;
+}
+
+// TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
+// handle 64k datagrams.
+static const int kReceiveBufferLen = 65536;
+
+void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+
+  // Ensure that a receive buffer for the UDP socket exists.
+  ASSERT(socket != NULL);
+  uint8_t* recv_buffer = socket->udp_receive_buffer();
+  if (recv_buffer == NULL) {
+    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
+    socket->set_udp_receive_buffer(recv_buffer);
+  }
+
+  // Read data into the buffer.
+  RawAddr addr;
+  const intptr_t bytes_read = SocketBase::RecvFrom(
+      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
+  if (bytes_read == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  if (bytes_read < 0) {
+    ASSERT(bytes_read == -1);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+
+  // Datagram data read. Copy into buffer of the exact size,
+  ASSERT(bytes_read > 0);
+  Dart_SetReturnValue(
+      args, NewDatagram(LookupIOLibrary(), recv_buffer, bytes_read, addr));
+}
+
+void FUNCTION_NAME(Socket_RecvFromMany)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  intptr_t max_count = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), 1, SocketBase::kMaxDatagramBatch);
+
+  // The batch buffer is only allocated for sockets which use it, as it has
+  // room for kMaxDatagramBatch datagrams of the maximum size.
+  ASSERT(socket != NULL);
+  uint8_t* recv_buffer = socket->udp_receive_many_buffer();
+  if (recv_buffer == NULL) {
+    recv_buffer = reinterpret_cast<uint8_t*>(
+        malloc(kReceiveBufferLen * SocketBase::kMaxDatagramBatch));
+    if (recv_buffer == NULL) {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+      return;
+    }
+    socket->set_udp_receive_many_buffer(recv_buffer);
+  }
+
+  intptr_t lengths[SocketBase::kMaxDatagramBatch];
+  RawAddr addrs[SocketBase::kMaxDatagramBatch];
+  const intptr_t count =
+      SocketBase::RecvFromMany(socket->fd(), recv_buffer, kReceiveBufferLen,
+                               max_count, lengths, addrs, SocketBase::kAsync);
+  if (count == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  if (count < 0) {
+    ASSERT(count == -1);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+
+  Dart_Handle io_lib = LookupIOLibrary();
+  Dart_Handle result = Dart_NewList(count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle datagram = NewDatagram(
+        io_lib, recv_buffer + i * kReceiveBufferLen, lengths[i], addrs[i]);
+    if (Dart_IsError(datagram)) {
+      Dart_PropagateError(datagram);
+    }
+    Dart_ListSetAt(result, i, datagram);
+  }
   Dart_SetReturnValue(args, result);
 }
 
@@ -494,6 +750,123 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_WriteVector)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle starts_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 3);
+  intptr_t count;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((count > 0) && (count <= SocketBase::kMaxWriteVectorBuffers));
+  Dart_Handle handles[SocketBase::kMaxWriteVectorBuffers];
+  const void* buffers[SocketBase::kMaxWriteVectorBuffers];
+  intptr_t lengths[SocketBase::kMaxWriteVectorBuffers];
+  intptr_t starts[SocketBase::kMaxWriteVectorBuffers];
+  intptr_t length = 0;
+  // Look up everything before acquiring any of the buffers.
+  for (intptr_t i = 0; i < count; i++) {
+    handles[i] = Dart_ListGetAt(buffers_obj, i);
+    starts[i] = DartUtils::GetIntptrValue(Dart_ListGetAt(starts_obj, i));
+    lengths[i] =
+        DartUtils::GetIntptrValue(Dart_ListGetAt(ends_obj, i)) - starts[i];
+    length += lengths[i];
+  }
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (length > 1) {
+      short_write = true;
+    }
+    intptr_t remaining = (length + 1) / 2;
+    intptr_t i = 0;
+    while (lengths[i] < remaining) {
+      remaining -= lengths[i++];
+    }
+    lengths[i] = remaining;
+    count = i + 1;
+  }
+  intptr_t acquired = 0;
+  while (acquired < count) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = NULL;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(handles[acquired], &type,
+                                       reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      if (acquired == 0) {
+        Dart_PropagateError(result);
+      }
+      // The same buffer can occur more than once, which the API does not
+      // allow to acquire with --verify_acquired_data. Just write the ones
+      // acquired so far.
+      break;
+    }
+    ASSERT((starts[acquired] + lengths[acquired]) <= len);
+    buffers[acquired] = buffer + starts[acquired];
+    acquired++;
+  }
+  intptr_t bytes_written = SocketBase::WriteVector(
+      socket->fd(), buffers, lengths, acquired, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    for (intptr_t i = 0; i < acquired; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    for (intptr_t i = 0; i < acquired; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  int64_t offset = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxInt64);
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  // The pointer comes from File_GetPointer, which retained the file.
+  File* file = reinterpret_cast<File*>(
+      DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1)));
+  ASSERT(file != NULL);
+  RefCntReleaseScope<File> rs(file);
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (length > 1) {
+      short_write = true;
+    }
+    length = (length + 1) / 2;
+  }
+  if (file->IsClosed()) {
+    OSError os_error(-1, "File closed", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  intptr_t bytes_sent = SocketBase::SendFile(socket->fd(), file, offset,
+                                             length, SocketBase::kAsync);
+  if (bytes_sent < 0) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  } else if (short_write) {
+    // If the write was forced 'short', indicate by returning the negative
+    // number of bytes. A forced short write may not trigger a write event.
+    Dart_SetIntegerReturnValue(args, -bytes_sent);
+  } else {
+    Dart_SetIntegerReturnValue(args, bytes_sent);
+  }
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -530,15 +903,83 @@ void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
+void FUNCTION_NAME(Socket_SendToMany)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-  OSError os_error;
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle starts_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 3);
+  Dart_Handle addresses_obj = Dart_GetNativeArgument(args, 4);
+  Dart_Handle ports_obj = Dart_GetNativeArgument(args, 5);
+  intptr_t count;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((count > 0) && (count <= SocketBase::kMaxDatagramBatch));
+  Dart_Handle handles[SocketBase::kMaxDatagramBatch];
+  const void* buffers[SocketBase::kMaxDatagramBatch];
+  intptr_t starts[SocketBase::kMaxDatagramBatch];
+  intptr_t lengths[SocketBase::kMaxDatagramBatch];
+  RawAddr addrs[SocketBase::kMaxDatagramBatch];
+  // Look up everything before acquiring any of the buffers.
+  for (intptr_t i = 0; i < count; i++) {
+    handles[i] = Dart_ListGetAt(buffers_obj, i);
+    starts[i] = DartUtils::GetIntptrValue(Dart_ListGetAt(starts_obj, i));
+    lengths[i] =
+        DartUtils::GetIntptrValue(Dart_ListGetAt(ends_obj, i)) - starts[i];
+    SocketAddress::GetSockAddr(Dart_ListGetAt(addresses_obj, i), &addrs[i]);
+    int64_t port = DartUtils::GetInt64ValueCheckRange(
+        Dart_ListGetAt(ports_obj, i), 0, 65535);
+    SocketAddress::SetAddrPort(&addrs[i], port);
+  }
+  intptr_t acquired = 0;
+  while (acquired < count) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = NULL;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(handles[acquired], &type,
+                                       reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      if (acquired == 0) {
+        Dart_PropagateError(result);
+      }
+      // The same buffer can occur more than once, which the API does not
+      // allow to acquire with --verify_acquired_data. Just send the ones
+      // acquired so far.
+      break;
+    }
+    ASSERT((starts[acquired] + lengths[acquired]) <= len);
+    buffers[acquired] = buffer + starts[acquired];
+    acquired++;
+  }
+  intptr_t sent = SocketBase::SendToMany(socket->fd(), buffers, lengths, addrs,
+                                         acquired, SocketBase::kAsync);
+  if (sent >= 0) {
+    for (intptr_t i = 0; i < acquired; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    Dart_SetIntegerReturnValue(args, sent);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    for (intptr_t i = 0; i < acquired; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
+void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
+  Socket* socket = Socket::GetReceiverSocketIdNativeField(args);
   intptr_t port = SocketBase::GetPort(socket->fd());
   if (port > 0) {
     Dart_SetIntegerReturnValue(args, port);
   } else {
+    // This native runs without an API scope.
+    Dart_EnterScope();
     Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    Dart_ExitScope();
   }
 }
 
@@ -627,10 +1068,11 @@ void FUNCTION_NAME(ServerSocket_CreateBindListen)(Dart_NativeArguments args) {
       Dart_GetNativeArgument(args, 3), 0, 65535);
   bool v6_only = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 4));
   bool shared = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 5));
+  bool reuse_port = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 6));
 
   Dart_Handle socket_object = Dart_GetNativeArgument(args, 0);
   Dart_Handle result = ListeningSocketRegistry::Instance()->CreateBindListen(
-      socket_object, addr, backlog, v6_only, shared);
+      socket_object, addr, backlog, v6_only, shared, reuse_port);
   Dart_SetReturnValue(args, result);
 }
 
@@ -657,7 +1099,7 @@ CObject* Socket::LookupRequest(const CObjectArray& request) {
     CObject* result = NULL;
     OSError* os_error = NULL;
     AddressList<SocketAddress>* addresses =
-        SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+        HostLookupCache::Lookup(host.CString(), type.Value(), &os_error);
     if (addresses != NULL) {
       CObjectArray* array =
           new CObjectArray(CObject::NewArray(addresses->count() + 1));
@@ -1007,6 +1449,52 @@ void FUNCTION_NAME(Socket_LeaveMulticast)(Dart_NativeArguments args) {
   }
 }
 
+// Answers a lookup from the host lookup cache without involving the IO
+// service, in the same format as Socket::LookupRequest, or returns null if
+// the name has to be resolved.
+void FUNCTION_NAME(Socket_LookupCached)(Dart_NativeArguments args) {
+  const char* host =
+      DartUtils::GetStringValue(Dart_GetNativeArgument(args, 0));
+  int64_t type = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), SocketAddress::TYPE_ANY,
+      SocketAddress::TYPE_IPV6);
+  AddressList<SocketAddress>* addresses =
+      HostLookupCache::LookupCached(host, type);
+  if (addresses == NULL) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  Dart_Handle response = Dart_NewList(addresses->count() + 1);
+  Dart_Handle result = response;
+  if (!Dart_IsError(response)) {
+    Dart_ListSetAt(response, 0, Dart_NewInteger(0));
+  }
+  for (intptr_t i = 0; (i < addresses->count()) && !Dart_IsError(result);
+       i++) {
+    SocketAddress* addr = addresses->GetAt(i);
+    Dart_Handle entry = Dart_NewList(3);
+    Dart_Handle data = SocketAddress::ToTypedData(addr->addr());
+    Dart_Handle as_string = Dart_NewStringFromCString(addr->as_string());
+    if (Dart_IsError(entry)) {
+      result = entry;
+    } else if (Dart_IsError(data)) {
+      result = data;
+    } else if (Dart_IsError(as_string)) {
+      result = as_string;
+    } else {
+      Dart_ListSetAt(entry, 0, Dart_NewInteger(addr->GetType()));
+      Dart_ListSetAt(entry, 1, as_string);
+      Dart_ListSetAt(entry, 2, data);
+      Dart_ListSetAt(response, i + 1, entry);
+    }
+  }
+  delete addresses;
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  Dart_SetReturnValue(args, response);
+}
+
 static void NormalSocketFinalizer(void* isolate_data,
                                   Dart_WeakPersistentHandle handle,
                                   void* data) {
@@ -1109,5 +1597,12 @@ Socket* Socket::GetSocketIdNativeField(Dart_Handle socket_obj) {
   return socket;
 }
 
+Socket* Socket::GetReceiverSocketIdNativeField(Dart_NativeArguments args) {
+  intptr_t id;
+  Dart_Handle err = Dart_GetNativeReceiver(args, &id);
+  ASSERT(!Dart_IsError(err));
+  return reinterpret_cast<Socket*>(id);
+}
+
 }  // namespace bin
 }  // namespace dart
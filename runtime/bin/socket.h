@@ -7,6 +7,7 @@
 
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
+#include "bin/io_buffer.h"
 #include "bin/reference_counting.h"
 #include "bin/socket_base.h"
 #include "bin/thread.h"
@@ -58,6 +59,10 @@ class Socket : public ReferenceCounted<Socket> {
 
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
   void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
+  uint8_t* udp_receive_many_buffer() const { return udp_receive_many_buffer_; }
+  void set_udp_receive_many_buffer(uint8_t* buffer) {
+    udp_receive_many_buffer_ = buffer;
+  }
 
   static bool Initialize();
 
@@ -88,6 +93,9 @@ class Socket : public ReferenceCounted<Socket> {
                                        Socket* socket,
                                        SocketFinalizer finalizer);
   static Socket* GetSocketIdNativeField(Dart_Handle socket);
+  // Returns the socket of the receiver of a native that runs without an API
+  // scope.
+  static Socket* GetReceiverSocketIdNativeField(Dart_NativeArguments args);
 
   static bool short_socket_read() { return short_socket_read_; }
   static void set_short_socket_read(bool short_socket_read) {
@@ -97,6 +105,38 @@ class Socket : public ReferenceCounted<Socket> {
   static void set_short_socket_write(bool short_socket_write) {
     short_socket_write_ = short_socket_write;
   }
+  static bool socket_read_ahead() { return socket_read_ahead_; }
+  static void set_socket_read_ahead(bool socket_read_ahead) {
+    socket_read_ahead_ = socket_read_ahead;
+  }
+
+  // With --socket_read_ahead, a read event on a stream socket reads the
+  // data right away instead of asking how much there is, and the following
+  // Read takes it from here. Small messages then cost one system call
+  // instead of two, and a Read taking all of the data gets the buffer
+  // itself.
+  //
+  // The size of the read adapts to the traffic of the socket: it doubles
+  // after a read filled the buffer and halves after a read used less than a
+  // quarter of it. A full read means more data may be waiting, which is
+  // reported instead of asking the socket how much there is.
+  static const intptr_t kMinReadAheadSize = 1 * KB;
+  static const intptr_t kInitialReadAheadSize = 16 * KB;
+  static const intptr_t kMaxReadAheadSize = 1 * MB;
+
+  // Reads ahead if nothing is buffered yet and returns the number of bytes
+  // that can be read without blocking, or -1 on error. Sets |more| if the
+  // socket may have more data than that.
+  intptr_t ReadAhead(bool* more);
+  intptr_t read_ahead_length() const {
+    return read_ahead_end_ - read_ahead_start_;
+  }
+  // Copies up to |length| buffered bytes to |buffer| and returns their
+  // number.
+  intptr_t TakeReadAhead(uint8_t* buffer, intptr_t length);
+  // Returns the buffered bytes as an IO buffer, or Dart_Null if they do not
+  // start the buffer or anything but all of them is asked for.
+  Dart_Handle TakeReadAheadBuffer(intptr_t length);
 
   static bool IsSignalSocketFlag(intptr_t flag) {
     return ((flag & (0x1 << kInternalSignalSocket)) != 0);
@@ -107,17 +147,27 @@ class Socket : public ReferenceCounted<Socket> {
     ASSERT(fd_ == kClosedFd);
     free(udp_receive_buffer_);
     udp_receive_buffer_ = NULL;
+    free(udp_receive_many_buffer_);
+    udp_receive_many_buffer_ = NULL;
+    IOBuffer::Free(read_ahead_buffer_);
+    read_ahead_buffer_ = NULL;
   }
 
   static const int kClosedFd = -1;
 
   static bool short_socket_read_;
   static bool short_socket_write_;
+  static bool socket_read_ahead_;
 
   intptr_t fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
+  uint8_t* udp_receive_many_buffer_;
+  uint8_t* read_ahead_buffer_;
+  intptr_t read_ahead_start_;
+  intptr_t read_ahead_end_;
+  intptr_t read_ahead_size_;
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -130,7 +180,9 @@ class ServerSocket {
   static intptr_t Accept(intptr_t fd);
 
   // Creates a socket which is bound and listens. The port to listen on is
-  // specified in the port component of the passed RawAddr structure.
+  // specified in the port component of the passed RawAddr structure. With
+  // |reuse_port| the socket is created with SO_REUSEPORT, which fails where
+  // it is not supported.
   //
   // Returns a positive integer if the call is successful. In case of failure
   // it returns:
@@ -139,7 +191,8 @@ class ServerSocket {
   //   -5: invalid bindAddress
   static intptr_t CreateBindListen(const RawAddr& addr,
                                    intptr_t backlog,
-                                   bool v6_only = false);
+                                   bool v6_only = false,
+                                   bool reuse_port = false);
 
   // Start accepting on a newly created listening socket. If it was unable to
   // start accepting incoming sockets, the fd is invalidated.
@@ -175,7 +228,16 @@ class ListeningSocketRegistry {
                                RawAddr addr,
                                intptr_t backlog,
                                bool v6_only,
-                               bool shared);
+                               bool shared,
+                               bool reuse_port);
+
+  // Creates a shared listening socket that no Dart socket object owns, for the
+  // embedder to watch. A later shared bind from Dart to the same address and
+  // port picks it up, along with the connections pending on it. Returns NULL
+  // on failure, with the error available as an OSError.
+  Socket* CreateSharedBindListen(RawAddr addr,
+                                 intptr_t backlog,
+                                 bool v6_only);
 
   // This should be called from the event handler for every kCloseEvent it gets
   // on listening sockets.
@@ -195,6 +257,7 @@ class ListeningSocketRegistry {
     int port;
     bool v6_only;
     bool shared;
+    bool reuse_port;
     int ref_count;
     Socket* socketfd;
 
@@ -206,11 +269,13 @@ class ListeningSocketRegistry {
              int port,
              bool v6_only,
              bool shared,
+             bool reuse_port,
              Socket* socketfd)
         : address(address),
           port(port),
           v6_only(v6_only),
           shared(shared),
+          reuse_port(reuse_port),
           ref_count(0),
           socketfd(socketfd),
           next(NULL) {}
@@ -31,6 +31,9 @@
 namespace dart {
 namespace bin {
 
+// Forward declarations.
+class File;
+
 union RawAddr {
   struct sockaddr_in in;
   struct sockaddr_in6 in6;
@@ -152,6 +155,24 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes the |count| buffers in order, with a single system call where the
+  // platform has one, and returns the total number of bytes written like
+  // Write. |count| must not exceed kMaxWriteVectorBuffers.
+  static const intptr_t kMaxWriteVectorBuffers = 16;
+  static intptr_t WriteVector(intptr_t fd,
+                              const void* const* buffers,
+                              const intptr_t* lengths,
+                              intptr_t count,
+                              SocketOpKind sync);
+  // Sends up to |length| bytes of |file|, starting at |offset|, without
+  // copying them to user space where the platform allows it. Returns the
+  // number of bytes sent like Write. The position of |file| is unspecified
+  // afterwards.
+  static intptr_t SendFile(intptr_t fd,
+                           File* file,
+                           int64_t offset,
+                           intptr_t length,
+                           SocketOpKind sync);
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
@@ -165,6 +186,28 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Batched versions of RecvFrom and SendTo, which use a single system call
+  // where the platform has one. They handle up to kMaxDatagramBatch
+  // datagrams and return how many were received or sent, 0 if none could be
+  // or -1 on error.
+  //
+  // RecvFromMany receives datagram i into the |slot_size| bytes at
+  // |buffer| + i * |slot_size| and stores its length and sender in
+  // |lengths|[i] and |addrs|[i].
+  static const intptr_t kMaxDatagramBatch = 16;
+  static intptr_t RecvFromMany(intptr_t fd,
+                               uint8_t* buffer,
+                               intptr_t slot_size,
+                               intptr_t count,
+                               intptr_t* lengths,
+                               RawAddr* addrs,
+                               SocketOpKind sync);
+  static intptr_t SendToMany(intptr_t fd,
+                             const void* const* buffers,
+                             const intptr_t* lengths,
+                             const RawAddr* addrs,
+                             intptr_t count,
+                             SocketOpKind sync);
   // Returns true if the given error-number is because the system was not able
   // to bind the socket to a specific IP.
   static bool IsBindError(intptr_t error_number);
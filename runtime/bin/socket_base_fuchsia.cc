@@ -27,6 +27,7 @@
 #include "bin/file.h"
 #include "bin/socket_base_fuchsia.h"
 #include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 // #define SOCKET_LOG_INFO 1
 // #define SOCKET_LOG_ERROR 1
@@ -147,6 +148,62 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  // There is no gathering write here, so write the buffers one by one until
+  // one of them is written partially.
+  intptr_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    const intptr_t written = Write(fd, buffers[i], lengths[i], sync);
+    if (written < 0) {
+      return (total > 0) ? total : written;
+    }
+    total += written;
+    if (written < lengths[i]) {
+      break;
+    }
+  }
+  return total;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t length,
+                              SocketOpKind sync) {
+  // There is no way to send a file without copying it here, so read it in
+  // chunks. Bytes that do not fit in the socket are read again next time.
+  const intptr_t kBufferSize = 64 * KB;
+  if (!file->SetPosition(offset)) {
+    return -1;
+  }
+  const intptr_t buffer_size = Utils::Minimum(length, kBufferSize);
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(buffer_size));
+  intptr_t total = 0;
+  while (total < length) {
+    const intptr_t bytes_read =
+        file->Read(buffer, Utils::Minimum(length - total, buffer_size));
+    if (bytes_read <= 0) {
+      total = ((bytes_read < 0) && (total == 0)) ? -1 : total;
+      break;
+    }
+    const intptr_t written = Write(fd, buffer, bytes_read, sync);
+    if (written < 0) {
+      total = (total > 0) ? total : -1;
+      break;
+    }
+    total += written;
+    if (written < bytes_read) {
+      break;
+    }
+  }
+  free(buffer);
+  return total;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -156,6 +213,54 @@ intptr_t SocketBase::SendTo(intptr_t fd,
   return -1;
 }
 
+intptr_t SocketBase::RecvFromMany(intptr_t fd,
+                                  uint8_t* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  RawAddr* addrs,
+                                  SocketOpKind sync) {
+  // There is no batched receive here, so receive the datagrams one by one
+  // until none is pending.
+  intptr_t received = 0;
+  while (received < count) {
+    const intptr_t bytes_read =
+        RecvFrom(fd, buffer + received * slot_size, slot_size,
+                 &addrs[received], sync);
+    if (bytes_read < 0) {
+      return (received > 0) ? received : -1;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    lengths[received++] = bytes_read;
+  }
+  return received;
+}
+
+intptr_t SocketBase::SendToMany(intptr_t fd,
+                                const void* const* buffers,
+                                const intptr_t* lengths,
+                                const RawAddr* addrs,
+                                intptr_t count,
+                                SocketOpKind sync) {
+  // There is no batched send here, so send the datagrams one by one until
+  // one of them cannot be sent.
+  intptr_t sent = 0;
+  while (sent < count) {
+    const intptr_t written =
+        SendTo(fd, buffers[sent], lengths[sent], addrs[sent], sync);
+    if (written < 0) {
+      return (sent > 0) ? sent : -1;
+    }
+    if ((written == 0) && (lengths[sent] > 0)) {
+      break;
+    }
+    sent++;
+  }
+  return sent;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   IOHandle* handle = reinterpret_cast<IOHandle*>(fd);
   ASSERT(handle->fd() >= 0);
@@ -7,15 +7,17 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <ifaddrs.h>      // NOLINT
-#include <net/if.h>       // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <ifaddrs.h>       // NOLINT
+#include <net/if.h>        // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <sys/uio.h>       // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -105,6 +107,46 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxWriteVectorBuffers);
+  struct iovec iov[kMaxWriteVectorBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t length,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  off64_t file_offset = offset;
+  ssize_t sent_bytes = TEMP_FAILURE_RETRY(
+      sendfile64(fd, file->GetFD(), &file_offset, length));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (sent_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    sent_bytes = 0;
+  }
+  return sent_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -123,6 +165,69 @@ intptr_t SocketBase::SendTo(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::RecvFromMany(intptr_t fd,
+                                  uint8_t* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  RawAddr* addrs,
+                                  SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxDatagramBatch);
+  struct mmsghdr messages[kMaxDatagramBatch];
+  struct iovec iov[kMaxDatagramBatch];
+  memset(messages, 0, sizeof(messages));
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = buffer + i * slot_size;
+    iov[i].iov_len = slot_size;
+    messages[i].msg_hdr.msg_name = &addrs[i].ss;
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i].ss);
+    messages[i].msg_hdr.msg_iov = &iov[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  int received =
+      TEMP_FAILURE_RETRY(recvmmsg(fd, messages, count, MSG_DONTWAIT, NULL));
+  if ((sync == kAsync) && (received == -1) && (errno == EWOULDBLOCK)) {
+    // If the read would block we need to retry and therefore return 0
+    // as the number of datagrams received.
+    received = 0;
+  }
+  for (int i = 0; i < received; i++) {
+    lengths[i] = messages[i].msg_len;
+  }
+  return received;
+}
+
+intptr_t SocketBase::SendToMany(intptr_t fd,
+                                const void* const* buffers,
+                                const intptr_t* lengths,
+                                const RawAddr* addrs,
+                                intptr_t count,
+                                SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxDatagramBatch);
+  struct mmsghdr messages[kMaxDatagramBatch];
+  struct iovec iov[kMaxDatagramBatch];
+  memset(messages, 0, sizeof(messages));
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+    messages[i].msg_hdr.msg_name =
+        const_cast<struct sockaddr*>(&addrs[i].addr);
+    messages[i].msg_hdr.msg_namelen = SocketAddress::GetAddrLength(addrs[i]);
+    messages[i].msg_hdr.msg_iov = &iov[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  int sent = TEMP_FAILURE_RETRY(sendmmsg(fd, messages, count, 0));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (sent == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of datagrams sent.
+    sent = 0;
+  }
+  return sent;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   RawAddr raw;
@@ -14,7 +14,9 @@
 #include <stdio.h>        // NOLINT
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
+#include <sys/socket.h>   // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -104,6 +106,57 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxWriteVectorBuffers);
+  struct iovec iov[kMaxWriteVectorBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t length,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  // On return, sent holds the number of bytes sent, also when sendfile fails
+  // because the socket would block after a partial write.
+  off_t sent = length;
+  int result;
+  do {
+    sent = length;
+    result = sendfile(file->GetFD(), fd, offset, &sent, NULL, 0);
+  } while ((result == -1) && (errno == EINTR) && (sent == 0));
+  if (result == 0) {
+    return sent;
+  }
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if (sent > 0) {
+    return sent;
+  }
+  if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    return 0;
+  }
+  return -1;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -122,6 +175,54 @@ intptr_t SocketBase::SendTo(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::RecvFromMany(intptr_t fd,
+                                  uint8_t* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  RawAddr* addrs,
+                                  SocketOpKind sync) {
+  // There is no batched receive here, so receive the datagrams one by one
+  // until none is pending.
+  intptr_t received = 0;
+  while (received < count) {
+    const intptr_t bytes_read =
+        RecvFrom(fd, buffer + received * slot_size, slot_size,
+                 &addrs[received], sync);
+    if (bytes_read < 0) {
+      return (received > 0) ? received : -1;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    lengths[received++] = bytes_read;
+  }
+  return received;
+}
+
+intptr_t SocketBase::SendToMany(intptr_t fd,
+                                const void* const* buffers,
+                                const intptr_t* lengths,
+                                const RawAddr* addrs,
+                                intptr_t count,
+                                SocketOpKind sync) {
+  // There is no batched send here, so send the datagrams one by one until
+  // one of them cannot be sent.
+  intptr_t sent = 0;
+  while (sent < count) {
+    const intptr_t written =
+        SendTo(fd, buffers[sent], lengths[sent], addrs[sent], sync);
+    if (written < 0) {
+      return (sent > 0) ? sent : -1;
+    }
+    if ((written == 0) && (lengths[sent] > 0)) {
+      break;
+    }
+    sent++;
+  }
+  return sent;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   RawAddr raw;
@@ -48,7 +48,12 @@ Socket::Socket(intptr_t fd)
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
       port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {}
+      udp_receive_buffer_(NULL),
+      udp_receive_many_buffer_(NULL),
+      read_ahead_buffer_(NULL),
+      read_ahead_start_(0),
+      read_ahead_end_(0),
+      read_ahead_size_(kInitialReadAheadSize) {}
 
 void Socket::SetClosedFd() {
   ASSERT(fd_ != kClosedFd);
@@ -121,7 +126,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   LOG_INFO("ServerSocket::CreateBindListen: calling socket(SOCK_STREAM)\n");
   intptr_t fd = NO_RETRY_EXPECTED(socket(addr.ss.ss_family, SOCK_STREAM, 0));
   if (fd < 0) {
@@ -148,6 +154,21 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
         setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &optval, sizeof(optval)));
   }
 
+  if (reuse_port) {
+#if defined(SO_REUSEPORT)
+    optval = 1;
+    if (NO_RETRY_EXPECTED(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval,
+                                     sizeof(optval))) != 0) {
+      FDUtils::SaveErrorAndClose(fd);
+      return -1;
+    }
+#else
+    errno = ENOPROTOOPT;
+    FDUtils::SaveErrorAndClose(fd);
+    return -1;
+#endif
+  }
+
   LOG_INFO("ServerSocket::CreateBindListen: calling bind(%ld)\n", fd);
   if (NO_RETRY_EXPECTED(
           bind(fd, &addr.addr, SocketAddress::GetAddrLength(addr))) < 0) {
@@ -164,7 +185,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
       (SocketBase::GetPort(reinterpret_cast<intptr_t>(io_handle)) == 65535)) {
     // Don't close the socket until we have created a new socket, ensuring
     // that we do not get the bad port number again.
-    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only, reuse_port);
     FDUtils::SaveErrorAndClose(fd);
     io_handle->Release();
     return new_fd;
@@ -22,7 +22,12 @@ Socket::Socket(intptr_t fd)
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
       port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {}
+      udp_receive_buffer_(NULL),
+      udp_receive_many_buffer_(NULL),
+      read_ahead_buffer_(NULL),
+      read_ahead_start_(0),
+      read_ahead_end_(0),
+      read_ahead_size_(kInitialReadAheadSize) {}
 
 void Socket::SetClosedFd() {
   fd_ = kClosedFd;
@@ -135,7 +140,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   intptr_t fd;
 
   fd = NO_RETRY_EXPECTED(
@@ -154,6 +160,21 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
         setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &optval, sizeof(optval)));
   }
 
+  if (reuse_port) {
+#if defined(SO_REUSEPORT)
+    optval = 1;
+    if (NO_RETRY_EXPECTED(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval,
+                                     sizeof(optval))) != 0) {
+      FDUtils::SaveErrorAndClose(fd);
+      return -1;
+    }
+#else
+    errno = ENOPROTOOPT;
+    FDUtils::SaveErrorAndClose(fd);
+    return -1;
+#endif
+  }
+
   if (NO_RETRY_EXPECTED(
           bind(fd, &addr.addr, SocketAddress::GetAddrLength(addr))) < 0) {
     FDUtils::SaveErrorAndClose(fd);
@@ -165,7 +186,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
       (SocketBase::GetPort(fd) == 65535)) {
     // Don't close the socket until we have created a new socket, ensuring
     // that we do not get the bad port number again.
-    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only, reuse_port);
     FDUtils::SaveErrorAndClose(fd);
     return new_fd;
   }
@@ -8,8 +8,12 @@
 class RawServerSocket {
   @patch
   static Future<RawServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false}) {
-    return _RawServerSocket.bind(address, port, backlog, v6Only, shared);
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false}) {
+    return _RawServerSocket.bind(
+        address, port, backlog, v6Only, shared, reusePort);
   }
 }
 
@@ -334,6 +338,12 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   static const int normalTokenBatchSize = 8;
   static const int listeningTokenBatchSize = 2;
 
+  // Must match SocketBase::kMaxWriteVectorBuffers.
+  static const int _maxWriteVectorBuffers = 16;
+
+  // Must match SocketBase::kMaxDatagramBatch.
+  static const int _maxDatagramBatch = 16;
+
   static const Duration _retryDuration = const Duration(milliseconds: 250);
   static const Duration _retryDurationLoopback =
       const Duration(milliseconds: 25);
@@ -362,6 +372,10 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   int available = 0;
 
+  // Whether the socket may hold more data than [available], because the last
+  // read ahead filled its buffer, see --socket_read_ahead.
+  bool readAheadMore = false;
+
   int tokens = 0;
 
   bool sendReadEvents = false;
@@ -380,19 +394,30 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   static Future<List<InternetAddress>> lookup(String host,
       {InternetAddressType type: InternetAddressType.any}) {
+    List<InternetAddress> addresses(response) {
+      return response.skip(1).map<InternetAddress>((result) {
+        return new _InternetAddress(result[1], host, result[2]);
+      }).toList();
+    }
+
+    // Recently resolved names are answered without a trip to the IO service.
+    var cached = _lookupCached(host, type._value);
+    if (cached != null) {
+      return new Future.value(addresses(cached));
+    }
     return _IOService._dispatch(_IOService.socketLookup, [host, type._value])
         .then((response) {
       if (isErrorResponse(response)) {
         throw createError(response, "Failed host lookup: '$host'");
       } else {
-        return response.skip(1).map<InternetAddress>((result) {
-          var type = new InternetAddressType._from(result[0]);
-          return new _InternetAddress(result[1], host, result[2]);
-        }).toList();
+        return addresses(response);
       }
     });
   }
 
+  static List _lookupCached(String host, int type)
+      native "Socket_LookupCached";
+
   static Future<InternetAddress> reverseLookup(InternetAddress addr) {
     return _IOService._dispatch(_IOService.socketReverseLookup,
         [(addr as _InternetAddress)._in_addr]).then((response) {
@@ -577,8 +602,8 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
-  static Future<_NativeSocket> bind(
-      host, int port, int backlog, bool v6Only, bool shared) async {
+  static Future<_NativeSocket> bind(host, int port, int backlog, bool v6Only,
+      bool shared, bool reusePort) async {
     _throwOnBadPort(port);
 
     final address = await _resolveHost(host);
@@ -586,7 +611,7 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     var socket = new _NativeSocket.listen();
     socket.localAddress = address;
     var result = socket.nativeCreateBindListen(
-        address._in_addr, port, backlog, v6Only, shared);
+        address._in_addr, port, backlog, v6Only, shared, reusePort);
     if (result is OSError) {
       throw new SocketException("Failed to create server socket",
           osError: result, address: address, port: port);
@@ -667,6 +692,10 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
     if (result != null) {
       available -= result.length;
+      if (available == 0 && readAheadMore) {
+        // Read the rest right away instead of waiting for the next read event.
+        readAhead();
+      }
       // TODO(ricow): Remove when we track internal and pipe uses.
       assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
       if (resourceInfo != null) {
@@ -681,6 +710,25 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int readInto(Uint8List buffer, int start, int end) {
+    if (isClosing || isClosed) return 0;
+    int len = min(available, end - start);
+    if (len == 0) return 0;
+    var result = nativeReadInto(buffer, start, len);
+    if (result is OSError) {
+      reportError(result, "Read failed");
+      return 0;
+    }
+    available -= result;
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.totalRead += result;
+      resourceInfo.didRead();
+    }
+    return result;
+  }
+
   Datagram receive() {
     if (isClosing || isClosed) return null;
     var result = nativeRecvFrom();
@@ -708,6 +756,33 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  List<Datagram> receiveMany(int maxCount) {
+    RangeError.checkValueInInterval(maxCount, 1, 1 << 30, "maxCount");
+    if (isClosing || isClosed) return const <Datagram>[];
+    var result = nativeRecvFromMany(min(maxCount, _maxDatagramBatch));
+    if (result is OSError) {
+      reportError(result, "Receive failed");
+      return const <Datagram>[];
+    }
+    if (result != null) {
+      // As in receive, available only covers the next datagram.
+      available = nativeAvailable();
+      // TODO(ricow): Remove when we track internal and pipe uses.
+      assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+      if (resourceInfo != null) {
+        for (Datagram datagram in result) {
+          resourceInfo.totalRead += datagram.data.length;
+        }
+      }
+    }
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.didRead();
+    }
+    return result == null ? const <Datagram>[] : result.cast<Datagram>();
+  }
+
   int write(List<int> buffer, int offset, int bytes) {
     if (buffer is! List) throw new ArgumentError();
     if (offset == null) offset = 0;
@@ -731,6 +806,49 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
         _ensureFastAndSerializableByteData(buffer, offset, offset + bytes);
     var result =
         nativeWrite(bufferAndStart.buffer, bufferAndStart.start, bytes);
+    return _handleWriteResult(result, bytes);
+  }
+
+  int sendFile(RandomAccessFile file, int position, int length) {
+    ArgumentError.checkNotNull(file, "file");
+    RangeError.checkNotNegative(position, "position");
+    RangeError.checkNotNegative(length, "length");
+    if (isClosing || isClosed) return 0;
+    if (length == 0) return 0;
+    _RandomAccessFile randomAccessFile = file;
+    randomAccessFile._checkAvailable();
+    var result =
+        nativeSendFile(randomAccessFile._pointer(), position, length);
+    return _handleWriteResult(result, length);
+  }
+
+  // Writes the buffers in [buffers] in order, starting at [offset] in the
+  // first one, and returns the number of bytes written. Only the first
+  // [_maxWriteVectorBuffers] non-empty buffers are written in one go.
+  int writeVector(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    var lists = <List<int>>[];
+    var starts = <int>[];
+    var ends = <int>[];
+    int bytes = 0;
+    for (int i = 0;
+        i < buffers.length && lists.length < _maxWriteVectorBuffers;
+        i++) {
+      var buffer = buffers[i];
+      int start = (i == 0) ? offset : 0;
+      if (start == buffer.length) continue;
+      _BufferAndStart bufferAndStart =
+          _ensureFastAndSerializableByteData(buffer, start, buffer.length);
+      lists.add(bufferAndStart.buffer);
+      starts.add(bufferAndStart.start);
+      ends.add(bufferAndStart.start + buffer.length - start);
+      bytes += buffer.length - start;
+    }
+    if (bytes == 0) return 0;
+    return _handleWriteResult(nativeWriteVector(lists, starts, ends), bytes);
+  }
+
+  int _handleWriteResult(result, int bytes) {
     if (result is OSError) {
       OSError osError = result;
       scheduleMicrotask(() => reportError(osError, "Write failed"));
@@ -773,6 +891,42 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int sendMany(List<Datagram> datagrams) {
+    if (isClosing || isClosed) return 0;
+    int count = min(datagrams.length, _maxDatagramBatch);
+    if (count == 0) return 0;
+    var buffers = new List<List<int>>(count);
+    var starts = new List<int>(count);
+    var ends = new List<int>(count);
+    var addresses = new List<List<int>>(count);
+    var ports = new List<int>(count);
+    for (int i = 0; i < count; i++) {
+      var datagram = datagrams[i];
+      _throwOnBadPort(datagram.port);
+      _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+          datagram.data, 0, datagram.data.length);
+      buffers[i] = bufferAndStart.buffer;
+      starts[i] = bufferAndStart.start;
+      ends[i] = bufferAndStart.start + datagram.data.length;
+      addresses[i] = (datagram.address as _InternetAddress)._in_addr;
+      ports[i] = datagram.port;
+    }
+    var result = nativeSendToMany(buffers, starts, ends, addresses, ports);
+    if (result is OSError) {
+      OSError osError = result;
+      scheduleMicrotask(() => reportError(osError, "Send failed"));
+      result = 0;
+    }
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      for (int i = 0; i < result; i++) {
+        resourceInfo.addWrite(datagrams[i].data.length);
+      }
+    }
+    return result;
+  }
+
   _NativeSocket accept() {
     // Don't issue accept if we're closing.
     if (isClosing || isClosed) return null;
@@ -895,7 +1049,13 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
           if (isListening) {
             available++;
           } else {
-            available = nativeAvailable();
+            // A TCP socket may take the data right away, see
+            // --socket_read_ahead.
+            if (isTcp) {
+              readAhead();
+            } else {
+              available = nativeAvailable();
+            }
             issueReadEvent();
             continue;
           }
@@ -1161,10 +1321,27 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   void nativeSetSocketId(int id, int typeFlags) native "Socket_SetSocketId";
   nativeAvailable() native "Socket_Available";
+  void readAhead() {
+    // The native call packs the flag into the lowest bit.
+    int result = nativeReadAhead();
+    available = result >> 1;
+    readAheadMore = (result & 1) != 0;
+  }
+
+  nativeReadAhead() native "Socket_ReadAhead";
   nativeRead(int len) native "Socket_Read";
+  nativeReadInto(Uint8List buffer, int start, int len)
+      native "Socket_ReadInto";
   nativeRecvFrom() native "Socket_RecvFrom";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeWriteVector(List<List<int>> buffers, List<int> starts, List<int> ends)
+      native "Socket_WriteVector";
+  nativeSendFile(int filePointer, int position, int length)
+      native "Socket_SendFile";
+  nativeRecvFromMany(int maxCount) native "Socket_RecvFromMany";
+  nativeSendToMany(List<List<int>> buffers, List<int> starts, List<int> ends,
+      List<List<int>> addresses, List<int> ports) native "Socket_SendToMany";
   nativeSendTo(List<int> buffer, int offset, int bytes, List<int> address,
       int port) native "Socket_SendTo";
   nativeCreateConnect(List<int> addr, int port) native "Socket_CreateConnect";
@@ -1172,7 +1349,7 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
       native "Socket_CreateBindConnect";
   bool isBindError(int errorNumber) native "SocketBase_IsBindError";
   nativeCreateBindListen(List<int> addr, int port, int backlog, bool v6Only,
-      bool shared) native "ServerSocket_CreateBindListen";
+      bool shared, bool reusePort) native "ServerSocket_CreateBindListen";
   nativeCreateBindDatagram(List<int> addr, int port, bool reuseAddress,
       bool reusePort, int ttl) native "Socket_CreateBindDatagram";
   nativeAccept(_NativeSocket socket) native "ServerSocket_Accept";
@@ -1199,11 +1376,15 @@ class _RawServerSocket extends Stream<RawSocket> implements RawServerSocket {
   ReceivePort _referencePort;
   bool _v6Only;
 
-  static Future<_RawServerSocket> bind(
-      address, int port, int backlog, bool v6Only, bool shared) {
+  static Future<_RawServerSocket> bind(address, int port, int backlog,
+      bool v6Only, bool shared, bool reusePort) {
     _throwOnBadPort(port);
     if (backlog < 0) throw new ArgumentError("Invalid backlog $backlog");
-    return _NativeSocket.bind(address, port, backlog, v6Only, shared)
+    if (shared && reusePort) {
+      throw new ArgumentError("shared and reusePort cannot both be true");
+    }
+    return _NativeSocket.bind(
+            address, port, backlog, v6Only, shared, reusePort)
         .then((socket) => new _RawServerSocket(socket, v6Only));
   }
 
@@ -1382,6 +1563,21 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
     }
   }
 
+  int sendFile(RandomAccessFile file, int position, int length) =>
+      _socket.sendFile(file, position, length);
+
+  int readInto(Uint8List buffer, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (_isMacOSTerminalInput) {
+      // Keep the Ctrl-D detection of read.
+      var data = read(end - start);
+      if (data == null) return 0;
+      buffer.setRange(start, start + data.length, data);
+      return data.length;
+    }
+    return _socket.readInto(buffer, start, end);
+  }
+
   int write(List<int> buffer, [int offset, int count]) =>
       _socket.write(buffer, offset, count);
 
@@ -1453,17 +1649,22 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
 class ServerSocket {
   @patch
   static Future<ServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false}) {
-    return _ServerSocket.bind(address, port, backlog, v6Only, shared);
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false}) {
+    return _ServerSocket.bind(
+        address, port, backlog, v6Only, shared, reusePort);
   }
 }
 
 class _ServerSocket extends Stream<Socket> implements ServerSocket {
   final _socket;
 
-  static Future<_ServerSocket> bind(
-      address, int port, int backlog, bool v6Only, bool shared) {
-    return _RawServerSocket.bind(address, port, backlog, v6Only, shared)
+  static Future<_ServerSocket> bind(address, int port, int backlog,
+      bool v6Only, bool shared, bool reusePort) {
+    return _RawServerSocket.bind(
+            address, port, backlog, v6Only, shared, reusePort)
         .then((socket) => new _ServerSocket(socket));
   }
 
@@ -1513,12 +1714,40 @@ class Socket {
   }
 }
 
+// The stream passed to addStream by Socket.sendFile. Sockets that can pass
+// the file to the operating system recognize it and never listen to it.
+class _SendFileStream extends Stream<List<int>> {
+  final File file;
+  final int start;
+  final int end;
+
+  _SendFileStream(this.file, this.start, this.end);
+
+  StreamSubscription<List<int>> listen(void onData(List<int> event),
+      {Function onError, void onDone(), bool cancelOnError}) {
+    return file.openRead(start, end).listen(onData,
+        onError: onError, onDone: onDone, cancelOnError: cancelOnError);
+  }
+}
+
 class _SocketStreamConsumer extends StreamConsumer<List<int>> {
+  // Data added while waiting for the socket to become writable is queued,
+  // and written with a single vectored write once it is, until this much is
+  // pending.
+  static const int _maxPendingBytes = 64 * 1024;
+
   StreamSubscription subscription;
   final _Socket socket;
-  int offset;
-  List<int> buffer;
+  // The data not written yet, starting at [offset] in the first buffer.
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int pendingBytes = 0;
   bool paused = false;
+  bool doneWhenWritten = false;
+  // The file being sent by sendFile, and the range of it not sent yet.
+  RandomAccessFile file;
+  int filePosition;
+  int fileEnd;
   Completer streamCompleter;
 
   _SocketStreamConsumer(this.socket);
@@ -1526,12 +1755,38 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   Future<Socket> addStream(Stream<List<int>> stream) {
     socket._ensureRawSocketSubscription();
     streamCompleter = new Completer<Socket>();
-    if (socket._raw != null) {
+    if (socket._sendsFilesDirectly && stream is _SendFileStream) {
+      _SendFileStream sendFileStream = stream;
+      sendFileStream.file.open().then((opened) {
+        if (streamCompleter == null) {
+          // The socket was destroyed in the meantime.
+          opened.closeSync();
+          return;
+        }
+        file = opened;
+        fileEnd = file.lengthSync();
+        if (sendFileStream.end != null && sendFileStream.end < fileEnd) {
+          fileEnd = sendFileStream.end;
+        }
+        filePosition = min(sendFileStream.start, fileEnd);
+        writeFile();
+      }, onError: (error, stackTrace) {
+        socket.destroy();
+        done(error, stackTrace);
+      });
+    } else if (socket._raw != null) {
       subscription = stream.listen((data) {
         assert(!paused);
-        assert(buffer == null);
-        buffer = data;
-        offset = 0;
+        buffers.add(data);
+        pendingBytes += data.length;
+        if (buffers.length > 1) {
+          // Waiting for a write event.
+          if (pendingBytes >= _maxPendingBytes) {
+            paused = true;
+            subscription.pause();
+          }
+          return;
+        }
         try {
           write();
         } catch (e) {
@@ -1543,7 +1798,11 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
         socket.destroy();
         done(error, stackTrace);
       }, onDone: () {
-        done();
+        if (buffers.isEmpty) {
+          done();
+        } else {
+          doneWhenWritten = true;
+        }
       }, cancelOnError: true);
     }
     return streamCompleter.future;
@@ -1555,26 +1814,69 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void write() {
+    if (file != null) {
+      writeFile();
+      return;
+    }
     if (subscription == null) return;
-    assert(buffer != null);
+    assert(buffers.isNotEmpty);
     // Write as much as possible.
-    offset += socket._write(buffer, offset, buffer.length - offset);
-    if (offset < buffer.length) {
-      if (!paused) {
+    int written = socket._writeVector(buffers, offset);
+    pendingBytes -= written;
+    written += offset;
+    int count = 0;
+    while (count < buffers.length && written >= buffers[count].length) {
+      written -= buffers[count].length;
+      count++;
+    }
+    buffers.removeRange(0, count);
+    offset = written;
+    if (buffers.isNotEmpty) {
+      if (!paused && pendingBytes >= _maxPendingBytes) {
         paused = true;
         subscription.pause();
+      } else if (paused && pendingBytes < _maxPendingBytes) {
+        paused = false;
+        subscription.resume();
       }
       socket._enableWriteEvent();
     } else {
-      buffer = null;
       if (paused) {
         paused = false;
         subscription.resume();
       }
+      if (doneWhenWritten) {
+        doneWhenWritten = false;
+        done();
+      }
     }
   }
 
+  void writeFile() {
+    try {
+      filePosition +=
+          socket._sendFile(file, filePosition, fileEnd - filePosition);
+    } catch (e, stackTrace) {
+      socket.destroy();
+      stop();
+      done(e, stackTrace);
+      return;
+    }
+    if (filePosition < fileEnd) {
+      socket._enableWriteEvent();
+    } else {
+      done();
+    }
+  }
+
+  void closeFile() {
+    if (file == null) return;
+    file.closeSync();
+    file = null;
+  }
+
   void done([error, stackTrace]) {
+    closeFile();
     if (streamCompleter != null) {
       if (error != null) {
         streamCompleter.completeError(error, stackTrace);
@@ -1586,6 +1888,7 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
+    closeFile();
     if (subscription == null) return;
     subscription.cancel();
     subscription = null;
@@ -1667,6 +1970,15 @@ class _Socket extends Stream<List<int>> implements Socket {
 
   Future flush() => _sink.flush();
 
+  Future sendFile(File file, [int start = 0, int end]) {
+    ArgumentError.checkNotNull(file, "file");
+    RangeError.checkNotNegative(start, "start");
+    if (end != null && end < start) {
+      throw new RangeError.range(end, start, null, "end");
+    }
+    return _sink.addStream(new _SendFileStream(file, start, end));
+  }
+
   Future close() => _sink.close();
 
   Future get done => _sink.done;
@@ -1722,7 +2034,7 @@ class _Socket extends Stream<List<int>> implements Socket {
     _detachReady = new Completer();
     _sink.close();
     return _detachReady.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -1800,8 +2112,32 @@ class _Socket extends Stream<List<int>> implements Socket {
     _consumer.done(error, stackTrace);
   }
 
-  int _write(List<int> data, int offset, int length) =>
-      _raw.write(data, offset, length);
+  // Whether the raw socket passes files to the operating system rather than
+  // reading them into memory.
+  bool get _sendsFilesDirectly {
+    var raw = _raw;
+    return raw is _RawSocket || (raw is _RawSecureSocket && raw._kernelTls);
+  }
+
+  int _sendFile(RandomAccessFile file, int position, int length) =>
+      _raw.sendFile(file, position, length);
+
+  int _writeVector(List<List<int>> buffers, int offset) {
+    var raw = _raw;
+    if (raw is _RawSocket) {
+      return raw._socket.writeVector(buffers, offset);
+    }
+    // Secure sockets encrypt the data into buffers of their own first, so
+    // write the buffers one by one.
+    int written = 0;
+    for (var buffer in buffers) {
+      int count = raw.write(buffer, offset, buffer.length - offset);
+      written += count;
+      if (offset + count < buffer.length) break;
+      offset = 0;
+    }
+    return written;
+  }
 
   void _enableWriteEvent() {
     _raw.writeEventsEnabled = true;
@@ -1893,10 +2229,15 @@ class _RawDatagramSocket extends Stream<RawSocketEvent>
   int send(List<int> buffer, InternetAddress address, int port) =>
       _socket.send(buffer, 0, buffer.length, address, port);
 
+  int sendMany(List<Datagram> datagrams) => _socket.sendMany(datagrams);
+
   Datagram receive() {
     return _socket.receive();
   }
 
+  List<Datagram> receiveMany([int maxCount = 16]) =>
+      _socket.receiveMany(maxCount);
+
   void joinMulticast(InternetAddress group, [NetworkInterface interface]) {
     _socket.joinMulticast(group, interface);
   }
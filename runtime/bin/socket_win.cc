@@ -24,7 +24,12 @@ Socket::Socket(intptr_t fd)
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
       port_(ILLEGAL_PORT),
-      udp_receive_buffer_(NULL) {
+      udp_receive_buffer_(NULL),
+      udp_receive_many_buffer_(NULL),
+      read_ahead_buffer_(NULL),
+      read_ahead_start_(0),
+      read_ahead_end_(0),
+      read_ahead_size_(kInitialReadAheadSize) {
   ASSERT(fd_ != kClosedFd);
   Handle* handle = reinterpret_cast<Handle*>(fd_);
   ASSERT(handle != NULL);
@@ -208,7 +213,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   SOCKET s = socket(addr.ss.ss_family, SOCK_STREAM, IPPROTO_TCP);
   if (s == INVALID_SOCKET) {
     return -1;
@@ -231,6 +237,13 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                reinterpret_cast<const char*>(&optval), sizeof(optval));
   }
 
+  if (reuse_port) {
+    // There is no equivalent of SO_REUSEPORT on Windows.
+    closesocket(s);
+    SetLastError(WSAEOPNOTSUPP);
+    return -1;
+  }
+
   status = bind(s, &addr.addr, SocketAddress::GetAddrLength(addr));
   if (status == SOCKET_ERROR) {
     DWORD rc = WSAGetLastError();
@@ -247,7 +260,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
        65535)) {
     // Don't close fd until we have created new. By doing that we ensure another
     // port.
-    intptr_t new_s = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_s = CreateBindListen(addr, backlog, v6_only, reuse_port);
     DWORD rc = WSAGetLastError();
     closesocket(s);
     listen_socket->Release();
@@ -0,0 +1,218 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_IO_SECURE_SOCKET_DISABLED)
+
+#include "bin/ssl_session_cache.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <time.h>
+
+#include "bin/lockers.h"
+#include "bin/utils.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+Mutex* SSLSessionCache::mutex_ = new Mutex();
+SimpleHashMap* SSLSessionCache::entries_ =
+    new SimpleHashMap(&SSLSessionCache::SameEntry, 16);
+SSLSessionCache::Entry* SSLSessionCache::head_ = NULL;
+SSLSessionCache::Entry* SSLSessionCache::tail_ = NULL;
+
+bool SSLSessionCache::SameEntry(void* key1, void* key2) {
+  Entry* entry1 = reinterpret_cast<Entry*>(key1);
+  Entry* entry2 = reinterpret_cast<Entry*>(key2);
+  return (entry1->group == entry2->group) &&
+         (strcmp(entry1->hostname, entry2->hostname) == 0);
+}
+
+uint32_t SSLSessionCache::EntryHash(intptr_t group, const char* hostname) {
+  uint32_t hash = Utils::StringHash(hostname, strlen(hostname));
+  return hash ^ Utils::WordHash(group);
+}
+
+SSLSessionCache::Entry* SSLSessionCache::Find(intptr_t group,
+                                              const char* hostname,
+                                              uint32_t hash) {
+  Entry key;
+  key.group = group;
+  key.hostname = const_cast<char*>(hostname);
+  SimpleHashMap::Entry* map_entry = entries_->Lookup(&key, hash, false);
+  return (map_entry == NULL) ? NULL : reinterpret_cast<Entry*>(map_entry->key);
+}
+
+void SSLSessionCache::Unlink(Entry* entry) {
+  if (entry->prev == NULL) {
+    head_ = entry->next;
+  } else {
+    entry->prev->next = entry->next;
+  }
+  if (entry->next == NULL) {
+    tail_ = entry->prev;
+  } else {
+    entry->next->prev = entry->prev;
+  }
+}
+
+void SSLSessionCache::PushFront(Entry* entry) {
+  entry->prev = NULL;
+  entry->next = head_;
+  if (head_ == NULL) {
+    tail_ = entry;
+  } else {
+    head_->prev = entry;
+  }
+  head_ = entry;
+}
+
+void SSLSessionCache::Delete(Entry* entry, uint32_t hash) {
+  Unlink(entry);
+  entries_->Remove(entry, hash);
+  SSL_SESSION_free(entry->session);
+  free(entry->hostname);
+  delete entry;
+}
+
+SSL_SESSION* SSLSessionCache::Lookup(intptr_t group, const char* hostname) {
+  MutexLocker ml(mutex_);
+  const uint32_t hash = EntryHash(group, hostname);
+  Entry* entry = Find(group, hostname, hash);
+  if (entry == NULL) {
+    return NULL;
+  }
+  SSL_SESSION* session = entry->session;
+  const uint64_t expires =
+      SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session);
+  if (expires <= static_cast<uint64_t>(time(NULL))) {
+    Delete(entry, hash);
+    return NULL;
+  }
+  if (SSL_SESSION_should_be_single_use(session)) {
+    // Hand the cache's reference over to the caller. A TLS 1.3 server sends
+    // fresh tickets after every handshake, which will take its place.
+    SSL_SESSION_up_ref(session);
+    Delete(entry, hash);
+    return session;
+  }
+  Unlink(entry);
+  PushFront(entry);
+  SSL_SESSION_up_ref(session);
+  return session;
+}
+
+void SSLSessionCache::Insert(intptr_t group,
+                             const char* hostname,
+                             SSL_SESSION* session) {
+  MutexLocker ml(mutex_);
+  const uint32_t hash = EntryHash(group, hostname);
+  Entry* entry = Find(group, hostname, hash);
+  if (entry != NULL) {
+    SSL_SESSION_free(entry->session);
+    entry->session = session;
+    Unlink(entry);
+    PushFront(entry);
+    return;
+  }
+  entry = new Entry();
+  entry->group = group;
+  entry->hostname = strdup(hostname);
+  entry->session = session;
+  SimpleHashMap::Entry* map_entry = entries_->Lookup(entry, hash, true);
+  ASSERT(map_entry->key == entry);
+  PushFront(entry);
+  if (entries_->size() > kMaxEntries) {
+    Delete(tail_, EntryHash(tail_->group, tail_->hostname));
+  }
+}
+
+void SSLSessionCache::Remove(intptr_t group, const char* hostname) {
+  MutexLocker ml(mutex_);
+  const uint32_t hash = EntryHash(group, hostname);
+  Entry* entry = Find(group, hostname, hash);
+  if (entry != NULL) {
+    Delete(entry, hash);
+  }
+}
+
+Mutex* SSLTicketKeys::mutex_ = new Mutex();
+SSLTicketKeys::Key SSLTicketKeys::current_;
+SSLTicketKeys::Key SSLTicketKeys::previous_;
+
+void SSLTicketKeys::Register(SSL_CTX* ctx) {
+  SSL_CTX_set_tlsext_ticket_key_cb(ctx, Callback);
+}
+
+bool SSLTicketKeys::Rotate(int64_t now) {
+  Key key;
+  if ((RAND_bytes(key.name, kNameLength) != 1) ||
+      (RAND_bytes(key.aes_key, kSecretLength) != 1) ||
+      (RAND_bytes(key.hmac_key, kSecretLength) != 1)) {
+    return false;
+  }
+  key.created = now;
+  previous_ = current_;
+  current_ = key;
+  return true;
+}
+
+int SSLTicketKeys::Callback(SSL* ssl,
+                            uint8_t* key_name,
+                            uint8_t* iv,
+                            EVP_CIPHER_CTX* cipher_ctx,
+                            HMAC_CTX* hmac_ctx,
+                            int encrypt) {
+  const int64_t now = TimerUtils::GetCurrentMonotonicMillis() / 1000;
+  MutexLocker ml(mutex_);
+  // A zero creation time marks a key which has not been made yet.
+  if ((current_.created == 0) ||
+      (now - current_.created >= kRotationSeconds)) {
+    if (!Rotate(now == 0 ? 1 : now)) {
+      return -1;
+    }
+  }
+  const Key* key;
+  int result = 1;
+  if (encrypt) {
+    key = &current_;
+    if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1) {
+      return -1;
+    }
+    memmove(key_name, key->name, kNameLength);
+    if (!EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), NULL, key->aes_key,
+                            iv)) {
+      return -1;
+    }
+  } else {
+    if (memcmp(key_name, current_.name, kNameLength) == 0) {
+      key = &current_;
+    } else if ((previous_.created != 0) &&
+               (now - previous_.created < 2 * kRotationSeconds) &&
+               (memcmp(key_name, previous_.name, kNameLength) == 0)) {
+      // Still accepted, but the client gets a ticket under the current key.
+      key = &previous_;
+      result = 2;
+    } else {
+      // Unknown or expired, so fall back to a full handshake.
+      return 0;
+    }
+    if (!EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), NULL, key->aes_key,
+                            iv)) {
+      return -1;
+    }
+  }
+  if (!HMAC_Init_ex(hmac_ctx, key->hmac_key, kSecretLength, EVP_sha256(),
+                    NULL)) {
+    return -1;
+  }
+  return result;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
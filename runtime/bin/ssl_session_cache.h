@@ -0,0 +1,110 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_SSL_SESSION_CACHE_H_
+#define RUNTIME_BIN_SSL_SESSION_CACHE_H_
+
+#include <openssl/ssl.h>
+
+#include "platform/globals.h"
+#include "platform/hashmap.h"
+
+namespace dart {
+namespace bin {
+
+// Forward declaration.
+class Mutex;
+
+// A process-wide cache of client sessions, shared by all isolates, so that
+// repeated connections to the same host can skip the full handshake.
+//
+// Sessions are filed under the host name they were made for and the session
+// group of the security context that verified the server. A session is only
+// handed out again for a context in the same group, since resuming it skips
+// certificate verification. The least recently used session is dropped once
+// the cache holds kMaxEntries of them.
+class SSLSessionCache {
+ public:
+  static const intptr_t kMaxEntries = 256;
+
+  // Returns a new reference to a resumable session, or NULL. Sessions which
+  // must be used only once are removed from the cache.
+  static SSL_SESSION* Lookup(intptr_t group, const char* hostname);
+
+  // Takes over the caller's reference to |session|.
+  static void Insert(intptr_t group,
+                     const char* hostname,
+                     SSL_SESSION* session);
+
+  static void Remove(intptr_t group, const char* hostname);
+
+ private:
+  struct Entry {
+    intptr_t group;
+    char* hostname;
+    SSL_SESSION* session;
+    Entry* prev;  // Towards the most recently used entry.
+    Entry* next;
+  };
+
+  static bool SameEntry(void* key1, void* key2);
+  static uint32_t EntryHash(intptr_t group, const char* hostname);
+
+  // These require the lock.
+  static Entry* Find(intptr_t group, const char* hostname, uint32_t hash);
+  static void Unlink(Entry* entry);
+  static void PushFront(Entry* entry);
+  static void Delete(Entry* entry, uint32_t hash);
+
+  static Mutex* mutex_;
+  static SimpleHashMap* entries_;
+  static Entry* head_;
+  static Entry* tail_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SSLSessionCache);
+};
+
+// Session ticket keys shared by all server contexts in the process. A fresh
+// key is made every kRotationSeconds; tickets issued with the previous key
+// are still accepted, and renewed, for one more period.
+class SSLTicketKeys {
+ public:
+  static const intptr_t kRotationSeconds = 60 * 60;
+
+  static void Register(SSL_CTX* ctx);
+
+ private:
+  static const intptr_t kNameLength = 16;
+  static const intptr_t kSecretLength = 16;
+
+  struct Key {
+    uint8_t name[kNameLength];
+    uint8_t aes_key[kSecretLength];
+    uint8_t hmac_key[kSecretLength];
+    int64_t created;
+  };
+
+  static int Callback(SSL* ssl,
+                      uint8_t* key_name,
+                      uint8_t* iv,
+                      EVP_CIPHER_CTX* cipher_ctx,
+                      HMAC_CTX* hmac_ctx,
+                      int encrypt);
+
+  // Requires the lock.
+  static bool Rotate(int64_t now);
+
+  static Mutex* mutex_;
+  static Key current_;
+  static Key previous_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SSLTicketKeys);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_SSL_SESSION_CACHE_H_
@@ -6,6 +6,9 @@
 
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
+#include "bin/file.h"
+#include "bin/lockers.h"
+#include "bin/thread.h"
 #include "bin/utils.h"
 
 #include "include/dart_api.h"
@@ -160,5 +163,143 @@ void FUNCTION_NAME(Stdout_AnsiSupported)(Dart_NativeArguments args) {
   }
 }
 
+Mutex* StdoutBuffer::mutex_ = new Mutex();
+StdoutBuffer::Buffer StdoutBuffer::buffer_;
+
+StdoutBuffer::Buffer* StdoutBuffer::For(intptr_t fd) {
+  if (!IsBuffered(fd)) {
+    return NULL;
+  }
+  Buffer* buffer = &buffer_;
+  if (buffer->file == NULL) {
+    int size[2];
+    buffer->file = File::OpenStdio(fd);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->size = kDefaultSize;
+    buffer->is_terminal = Stdout::GetTerminalSize(fd, size);
+  }
+  return buffer;
+}
+
+bool StdoutBuffer::FlushLocked(Buffer* buffer) {
+  if (buffer->length == 0) {
+    return true;
+  }
+  const intptr_t length = buffer->length;
+  buffer->length = 0;
+  return buffer->file->WriteFully(buffer->data, length);
+}
+
+bool StdoutBuffer::Write(intptr_t fd, const uint8_t* data, intptr_t length) {
+  MutexLocker ml(mutex_);
+  Buffer* buffer = For(fd);
+  ASSERT(buffer != NULL);
+  if (buffer->length + length > buffer->size) {
+    if (!FlushLocked(buffer)) {
+      return false;
+    }
+    if (length >= buffer->size) {
+      return buffer->file->WriteFully(data, length);
+    }
+  }
+  if (buffer->data == NULL) {
+    buffer->data = reinterpret_cast<uint8_t*>(malloc(buffer->size));
+    if (buffer->data == NULL) {
+      OUT_OF_MEMORY();
+    }
+  }
+  memmove(buffer->data + buffer->length, data, length);
+  buffer->length += length;
+  if (buffer->is_terminal && (memchr(data, '\n', length) != NULL)) {
+    return FlushLocked(buffer);
+  }
+  return true;
+}
+
+bool StdoutBuffer::Flush(intptr_t fd) {
+  MutexLocker ml(mutex_);
+  Buffer* buffer = For(fd);
+  return (buffer == NULL) || FlushLocked(buffer);
+}
+
+void StdoutBuffer::FlushAll() {
+  MutexLocker ml(mutex_);
+  if (buffer_.file != NULL) {
+    FlushLocked(&buffer_);
+  }
+}
+
+intptr_t StdoutBuffer::GetSize(intptr_t fd) {
+  MutexLocker ml(mutex_);
+  Buffer* buffer = For(fd);
+  return (buffer == NULL) ? 0 : buffer->size;
+}
+
+void StdoutBuffer::SetSize(intptr_t fd, intptr_t size) {
+  ASSERT((size >= 0) && (size <= kMaxSize));
+  MutexLocker ml(mutex_);
+  Buffer* buffer = For(fd);
+  if ((buffer == NULL) || (buffer->size == size)) {
+    return;
+  }
+  // Pending output goes out first, so the buffer can be replaced.
+  FlushLocked(buffer);
+  free(buffer->data);
+  buffer->data = NULL;
+  buffer->size = size;
+}
+
+void FUNCTION_NAME(Stdout_WriteBuffered)(Dart_NativeArguments args) {
+  intptr_t fd = DartUtils::GetNativeIntptrArgument(args, 0);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  // The range is checked in Dart.
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  Dart_TypedData_Type type;
+  intptr_t buffer_len = 0;
+  void* buffer = NULL;
+  Dart_Handle result =
+      Dart_TypedDataAcquireData(buffer_obj, &type, &buffer, &buffer_len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(type == Dart_TypedData_kUint8 || type == Dart_TypedData_kInt8);
+  ASSERT(end <= buffer_len);
+  ASSERT(StdoutBuffer::IsBuffered(fd));
+  bool success = StdoutBuffer::Write(
+      fd, reinterpret_cast<uint8_t*>(buffer) + start, end - start);
+  result = Dart_TypedDataReleaseData(buffer_obj);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  if (success) {
+    Dart_SetReturnValue(args, Dart_Null());
+  } else {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+}
+
+void FUNCTION_NAME(Stdout_FlushBuffered)(Dart_NativeArguments args) {
+  intptr_t fd = DartUtils::GetNativeIntptrArgument(args, 0);
+  if (StdoutBuffer::Flush(fd)) {
+    Dart_SetReturnValue(args, Dart_Null());
+  } else {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+}
+
+void FUNCTION_NAME(Stdout_GetBufferSize)(Dart_NativeArguments args) {
+  intptr_t fd = DartUtils::GetNativeIntptrArgument(args, 0);
+  Dart_SetIntegerReturnValue(args, StdoutBuffer::GetSize(fd));
+}
+
+void FUNCTION_NAME(Stdout_SetBufferSize)(Dart_NativeArguments args) {
+  intptr_t fd = DartUtils::GetNativeIntptrArgument(args, 0);
+  int64_t size = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 1), 0, StdoutBuffer::kMaxSize);
+  StdoutBuffer::SetSize(fd, size);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -40,6 +40,54 @@ class Stdout {
   DISALLOW_IMPLICIT_CONSTRUCTORS(Stdout);
 };
 
+// Forward declarations.
+class File;
+class Mutex;
+
+// Output written to stdout through dart:io is collected here, in one buffer
+// shared by all isolates, so that many small writes take few system calls.
+// The buffer is written out when it is full, when a write contains a line
+// break and stdout is a terminal, when Dart flushes it, before print writes
+// to stdout, when an isolate shuts down, and on exit. Stderr is not buffered
+// so that diagnostics survive a crash.
+class StdoutBuffer {
+ public:
+  static const intptr_t kDefaultSize = 16 * KB;
+  static const intptr_t kMaxSize = 1 * MB;
+
+  // Other descriptors are written to directly by the Dart side.
+  static bool IsBuffered(intptr_t fd) { return fd == 1; }
+
+  // These return false, with the OS error available, if writing failed.
+  static bool Write(intptr_t fd, const uint8_t* data, intptr_t length);
+  static bool Flush(intptr_t fd);
+
+  static void FlushAll();
+
+  static intptr_t GetSize(intptr_t fd);
+  // A size of 0 turns buffering off.
+  static void SetSize(intptr_t fd, intptr_t size);
+
+ private:
+  struct Buffer {
+    File* file;
+    uint8_t* data;
+    intptr_t length;
+    intptr_t size;
+    bool is_terminal;
+  };
+
+  // These require the lock.
+  static Buffer* For(intptr_t fd);
+  static bool FlushLocked(Buffer* buffer);
+
+  static Mutex* mutex_;
+  static Buffer buffer_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(StdoutBuffer);
+};
+
 }  // namespace bin
 }  // namespace dart
 
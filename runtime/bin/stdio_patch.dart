@@ -51,6 +51,34 @@ class _StdIOUtils {
 
   @patch
   static _getStdioHandleType(int fd) native "File_GetStdioHandleType";
+
+  @patch
+  static void _writeBuffered(int fd, List<int> data) {
+    _BufferAndStart bufferAndStart =
+        _ensureFastAndSerializableByteData(data, 0, data.length);
+    var result = _nativeWriteBuffered(fd, bufferAndStart.buffer,
+        bufferAndStart.start, bufferAndStart.start + data.length);
+    if (result is OSError) {
+      throw new StdoutException("Error writing to standard output", result);
+    }
+  }
+
+  @patch
+  static void _flushBuffered(int fd) {
+    var result = _nativeFlushBuffered(fd);
+    if (result is OSError) {
+      throw new StdoutException("Error writing to standard output", result);
+    }
+  }
+
+  @patch
+  static int _getBufferSize(int fd) native "Stdout_GetBufferSize";
+  @patch
+  static void _setBufferSize(int fd, int size) native "Stdout_SetBufferSize";
+
+  static _nativeWriteBuffered(int fd, List<int> buffer, int start, int end)
+      native "Stdout_WriteBuffered";
+  static _nativeFlushBuffered(int fd) native "Stdout_FlushBuffered";
 }
 
 @patch
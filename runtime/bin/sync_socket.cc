@@ -5,6 +5,7 @@
 #include "bin/sync_socket.h"
 
 #include "bin/dartutils.h"
+#include "bin/host_lookup_cache.h"
 #include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/lockers.h"
@@ -60,7 +61,7 @@ void FUNCTION_NAME(SynchronousSocket_LookupRequest)(Dart_NativeArguments args) {
 
   OSError* os_error = NULL;
   AddressList<SocketAddress>* addresses =
-      SocketBase::LookupAddress(host, type, &os_error);
+      HostLookupCache::Lookup(host, type, &os_error);
   if (addresses == NULL) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError(os_error));
     return;
@@ -360,7 +360,8 @@ class Server {
           address = addresses[i];
           if (address.type == InternetAddressType.IP_V4) break;
         }
-        _server = await HttpServer.bind(address, _port);
+        _server =
+            await HttpServer.bind(address, _port, shared: _sharedServerSocket);
         return true;
       } catch (e, st) {
         pollError = e;
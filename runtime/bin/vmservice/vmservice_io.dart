@@ -29,6 +29,10 @@ bool _authCodesDisabled;
 // Should the HTTP server run in devmode?
 @pragma("vm:entry-point")
 bool _originCheckDisabled;
+// Should the HTTP server bind shared, to pick up the socket the embedder
+// listened on until the service isolate started?
+@pragma("vm:entry-point")
+bool _sharedServerSocket = false;
 @pragma("vm:entry-point")
 bool _isWindows = false;
 @pragma("vm:entry-point")
@@ -99,6 +99,7 @@ const uint8_t* VmServiceIONativeSymbol(Dart_NativeFunction nf) {
 }
 
 const char* VmService::error_msg_ = NULL;
+bool VmService::server_socket_shared_ = false;
 char VmService::server_uri_[kServerUriStringBufferSize];
 
 void VmService::SetNativeResolver() {
@@ -175,6 +176,9 @@ bool VmService::Setup(const char* server_ip,
   result = Dart_SetField(library, DartUtils::NewString("_authCodesDisabled"),
                          Dart_NewBoolean(auth_codes_disabled));
   SHUTDOWN_ON_ERROR(result);
+  result = Dart_SetField(library, DartUtils::NewString("_sharedServerSocket"),
+                         Dart_NewBoolean(server_socket_shared_));
+  SHUTDOWN_ON_ERROR(result);
 
 // Are we running on Windows?
 #if defined(HOST_OS_WINDOWS)
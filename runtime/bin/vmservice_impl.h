@@ -23,6 +23,12 @@ class VmService {
 
   static void SetNativeResolver();
 
+  // Makes the HTTP server bind its socket shared, to pick up the one the
+  // embedder listens on until the service isolate starts.
+  static void SetServerSocketShared(bool shared) {
+    server_socket_shared_ = shared;
+  }
+
   // Error message if startup failed.
   static const char* GetErrorMessage();
 
@@ -36,6 +42,7 @@ class VmService {
   static void SetServerAddress(const char* server_uri_);
 
   static const char* error_msg_;
+  static bool server_socket_shared_;
   static char server_uri_[kServerUriStringBufferSize];
 
   DISALLOW_ALLOCATION();
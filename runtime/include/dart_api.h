@@ -529,7 +529,7 @@ typedef struct {
  * for each part.
  */
 
-#define DART_FLAGS_CURRENT_VERSION (0x0000000b)
+#define DART_FLAGS_CURRENT_VERSION (0x0000000e)
 
 typedef struct {
   int32_t version;
@@ -541,6 +541,24 @@ typedef struct {
   bool load_vmservice_library;
   bool unsafe_trust_strong_mode_types;
   bool copy_parent_code;
+  /* When set, a snapshot of the parent isolate's program and JIT code which
+   * the embedder can create the isolate from with Dart_CreateIsolate (without
+   * shared data or instructions) instead of loading the program again. It
+   * stays valid for as long as the created isolate exists. */
+  const uint8_t* group_snapshot_data;
+  const uint8_t* group_snapshot_instructions;
+  /* When non-zero, the isolate's messages are only handled on the CPUs whose
+   * bits are set (bit i stands for CPU i). This is only supported on Linux
+   * and Android and is ignored elsewhere. Isolates spawned by the isolate
+   * inherit the mask unless the embedder changes it in its create
+   * callback. */
+  uint64_t cpu_affinity_mask;
+  /* When set, the isolate is a batch isolate: the threads handling its
+   * messages only run when no thread of a normal isolate (or any other
+   * thread) is waiting for a CPU. Latency-critical isolates then go first
+   * when the machine is saturated. This is only supported on Linux and
+   * Android and is ignored elsewhere. Spawned isolates inherit it. */
+  bool batch_scheduling;
 } Dart_IsolateFlags;
 
 /**
@@ -774,6 +792,18 @@ DART_EXPORT DART_WARN_UNUSED_RESULT char* Dart_Initialize(
  */
 DART_EXPORT DART_WARN_UNUSED_RESULT char* Dart_Cleanup();
 
+/**
+ * Tells the VM that the process will exit right after it is shut down.
+ *
+ * From then on, shutting down an isolate neither runs the finalizers of its
+ * weak persistent handles nor frees its heap, and Dart_Cleanup leaves the
+ * memory of the VM itself to the operating system. Output that outlives the
+ * process, such as the timeline and profiles, is still flushed.
+ *
+ * After this call the embedder may only shut isolates and the VM down.
+ */
+DART_EXPORT void Dart_PrepareForExit();
+
 /**
  * Sets command line flags. Should be called before Dart_Initialize.
  *
@@ -2334,6 +2364,62 @@ Dart_InvokeClosure(Dart_Handle closure,
                    int number_of_arguments,
                    Dart_Handle* arguments);
 
+/**
+ * Resolves a static or top-level function once, so that it can be invoked
+ * repeatedly with Dart_InvokePrepared without looking it up by name or
+ * allocating an arguments descriptor on each call.
+ *
+ * The returned handle is opaque and may only be passed to
+ * Dart_InvokePrepared. Embedders invoking it across scopes should keep
+ * it in a persistent handle. If the isolate is reloaded, the function is
+ * resolved again by name on its next invocation.
+ *
+ * This function ignores visibility (leading underscores in names).
+ *
+ * \param target A type or library.
+ * \param name The name of the function to invoke.
+ * \param number_of_arguments The number of arguments of each invocation.
+ *
+ * \return A handle to the prepared invocation, or an error handle if the
+ *   function does not exist or does not accept number_of_arguments
+ *   positional arguments.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_PrepareInvoke(Dart_Handle target,
+                   Dart_Handle name,
+                   int number_of_arguments);
+
+/**
+ * Resolves a static field or getter, or a top-level variable or getter,
+ * once, so that its value can be read repeatedly with Dart_InvokePrepared
+ * (with no arguments). See Dart_PrepareInvoke.
+ *
+ * \param container A type or library.
+ * \param name A field name.
+ *
+ * \return A handle to the prepared invocation, or an error handle if the
+ *   field does not exist.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_PrepareGetField(Dart_Handle container, Dart_Handle name);
+
+/**
+ * Invokes a function or reads a field resolved by Dart_PrepareInvoke or
+ * Dart_PrepareGetField.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param prepared A handle returned by Dart_PrepareInvoke or
+ *   Dart_PrepareGetField.
+ * \param arguments An array of as many arguments as the invocation was
+ *   prepared for. Ignored for field reads.
+ *
+ * \return If the function is called or the field is read successfully,
+ *   then the result is returned. Otherwise an error handle is returned.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_InvokePrepared(Dart_Handle prepared, Dart_Handle* arguments);
+
 /**
  * Invokes a Generative Constructor on an object that was previously
  * allocated using Dart_Allocate/Dart_AllocateWithNativeFields.
@@ -3162,6 +3248,17 @@ DART_EXPORT bool Dart_IsServiceIsolate(Dart_Isolate isolate);
  */
 DART_EXPORT Dart_Port Dart_ServiceWaitForLoadPort();
 
+/**
+ * Starts the service isolate if the VM was initialized with
+ * --lazy_service_isolate and has not started it yet. The isolates already
+ * running are registered with the service isolate once it is up.
+ *
+ * Does not wait for the service isolate to start.
+ *
+ * \return Returns true if this call started the service isolate.
+ */
+DART_EXPORT bool Dart_StartServiceIsolate();
+
 /**
  * Writes the CPU profile to the timeline as a series of 'instant' events.
  *
@@ -3222,6 +3319,10 @@ Dart_SaveTypeFeedback(uint8_t** buffer, intptr_t* buffer_length);
  * Compile functions using data from Dart_SaveTypeFeedback. The data must from a
  * VM with the same version and compiler flags.
  *
+ * When precompiling, no functions are compiled and the compiler flags need not
+ * match: the receiver classes observed at each call site are kept and guide
+ * the inlining and devirtualization of Dart_Precompile.
+ *
  * \return Returns an error handle if a compilation error was encountered or a
  *   version mismatch is detected.
  */
@@ -3284,6 +3385,17 @@ DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
 Dart_CreateVMAOTSnapshotAsAssembly(Dart_StreamingWriteCallback callback,
                                    void* callback_data);
 
+/**
+ *  Same as Dart_CreateAppAOTSnapshotAsAssembly, except the callback is
+ *  provided with an ELF shared library exporting the same symbols, which the
+ *  embedder can load with dlopen without assembling and linking it first.
+ *
+ *  Only supported for targets which use ELF.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_CreateAppAOTSnapshotAsElf(Dart_StreamingWriteCallback callback,
+                               void* callback_data);
+
 /**
  *  Same as Dart_CreateAppAOTSnapshotAsAssembly, except all the pieces are
  *  provided directly as bytes that the embedder can load with mmap. The
@@ -3340,6 +3452,33 @@ Dart_CreateAppJITSnapshotAsBlobs(uint8_t** isolate_snapshot_data_buffer,
                                  intptr_t* isolate_snapshot_instructions_size,
                                  const uint8_t* reused_instructions);
 
+/**
+ * Like Dart_CreateAppJITSnapshotAsBlobs, but for an isolate which keeps
+ * running afterwards, e.g. a warmed-up production instance refreshing the
+ * snapshot used to start other instances of the same program.
+ *
+ * Unlike Dart_CreateAppJITSnapshotAsBlobs this does not compact the symbol
+ * table, deduplicate or drop code, so the isolate's heap is left as it is and
+ * the pause is limited to writing the reachable objects. The background
+ * compilers are stopped while the snapshot is written and start again when
+ * the isolate next needs them. Functions whose optimized code was
+ * deoptimized or disabled are written with their unoptimized code, so the
+ * snapshot only contains optimized code whose assumptions held in this
+ * isolate.
+ *
+ * Has the same requirements as Dart_CreateAppJITSnapshotAsBlobs. The buffers
+ * are scope allocated and are only valid until the next call to
+ * Dart_ExitScope.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT Dart_Handle
+Dart_CreateAppJITSnapshotOfRunningIsolateAsBlobs(
+    uint8_t** isolate_snapshot_data_buffer,
+    intptr_t* isolate_snapshot_data_size,
+    uint8_t** isolate_snapshot_instructions_buffer,
+    intptr_t* isolate_snapshot_instructions_size);
+
 /**
  * Like Dart_CreateAppJITSnapshotAsBlobs, but also creates a new VM snapshot.
  */
@@ -111,6 +111,37 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
  */
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message);
 
+/**
+ * Posts a message on some port. The message will contain a typed data
+ * object backed by 'data', which is handed over to the receiver without
+ * copying it or serializing a Dart_CObject graph.
+ *
+ * The ownership of 'data' is passed to the VM, including when the message
+ * cannot be posted. If 'callback' is NULL, 'data' must have been allocated
+ * with malloc and is released with free. Otherwise 'callback' is invoked
+ * with 'peer' once the receiver no longer uses the data.
+ *
+ * Native ports receive a copy of the data as a Dart_CObject_kTypedData.
+ *
+ * \param port_id The destination port.
+ * \param type The type of the typed data. Dart_TypedData_kByteData and
+ *   Dart_TypedData_kFloat32x4 are not supported.
+ * \param data The elements of the typed data.
+ * \param length The length of the data in bytes, a multiple of the
+ *   element size of 'type'.
+ * \param peer The argument passed to 'callback'.
+ * \param callback The finalizer releasing 'data', or NULL.
+ *
+ * \return True if the message was posted.
+ */
+DART_EXPORT bool Dart_PostExternalTypedData(
+    Dart_Port port_id,
+    Dart_TypedData_Type type,
+    uint8_t* data,
+    intptr_t length,
+    void* peer,
+    Dart_WeakPersistentHandleFinalizer callback);
+
 /**
  * A native message handler.
  *
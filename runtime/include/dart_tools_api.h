@@ -388,6 +388,36 @@ DART_EXPORT void Dart_TimelineEvent(const char* label,
  */
 DART_EXPORT void Dart_SetThreadName(const char* name);
 
+/*
+ * ==================
+ * Continuous Profile
+ * ==================
+ */
+
+/**
+ * Callback which receives the CPU profiles of an isolate collected with
+ * --continuous_profile. It is invoked on the thread of the isolate, with the
+ * isolate current, every --continuous_profile_period seconds and when the
+ * isolate shuts down.
+ *
+ * \param isolate_port The main port of the profiled isolate.
+ * \param profile An uncompressed protocol buffer in the pprof format
+ *   (profile.proto). It is only valid during the callback.
+ * \param profile_length The length of the profile in bytes.
+ */
+typedef void (*Dart_ContinuousProfileCallback)(Dart_Port isolate_port,
+                                               const uint8_t* profile,
+                                               intptr_t profile_length);
+
+/**
+ * Sets the callback which receives the profiles of --continuous_profile.
+ * Profiles are also written to files if --continuous_profile_file is given.
+ *
+ * NOTE: Profiles are not available in PRODUCT builds of Dart.
+ */
+DART_EXPORT void Dart_SetContinuousProfileCallback(
+    Dart_ContinuousProfileCallback callback);
+
 /*
  * =======
  * Metrics
@@ -432,4 +462,17 @@ Dart_IsolateRunnableLatencyMetric(Dart_Isolate isolate);  // Microsecond
 DART_EXPORT int64_t
 Dart_IsolateRunnableHeapSizeMetric(Dart_Isolate isolate);  // Byte
 
+/**
+ * Returns the metrics of the VM and of all isolates in the OpenMetrics text
+ * exposition format, for example to serve to a metrics scraper.
+ *
+ * Metric names are prefixed with "dart_" and isolate metrics are labeled
+ * with the name and main port of their isolate. May be called from any
+ * thread, also without a current isolate.
+ *
+ * \return A string that must be freed by the caller with free(), or NULL on
+ *   PRODUCT builds.
+ */
+DART_EXPORT char* Dart_GetOpenMetrics();
+
 #endif  // RUNTIME_INCLUDE_DART_TOOLS_API_H_
@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "platform/assert.h"
+#include "platform/sort.h"
 #include "vm/bootstrap_natives.h"
 #include "vm/exceptions.h"
 #include "vm/native_entry.h"
@@ -48,6 +49,73 @@ DEFINE_NATIVE_ENTRY(List_getLength, 0, 1) {
   return Smi::New(array.Length());
 }
 
+// Lists at least this long with Smi elements are radix sorted.
+static const intptr_t kRadixSortThreshold = 256;
+
+// _List or _GrowableList list, int length.
+// Sorts the first 'length' elements of 'list' the way Comparable.compare
+// orders them if they are all Smis or all one-byte strings. Returns whether
+// it did; other lists are left alone for the Dart sort.
+DEFINE_NATIVE_ENTRY(List_sort, 0, 2) {
+  const Instance& list =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, length_smi, arguments->NativeArgAt(1));
+  Array& array = Array::Handle(zone);
+  if (list.IsGrowableObjectArray()) {
+    array = GrowableObjectArray::Cast(list).data();
+  } else {
+    array ^= list.raw();
+  }
+  const intptr_t length = length_smi.Value();
+  ASSERT((length >= 0) && (length <= array.Length()));
+
+  // The elements are sorted in a copy and stored back with the write barrier,
+  // which a concurrent marker relies on when they move between slots.
+  RawObject** elements = zone->Alloc<RawObject*>(length);
+  Object& element = Object::Handle(zone);
+  NoSafepointScope no_safepoint;
+  bool all_smis = true;
+  bool all_strings = true;
+  for (intptr_t i = 0; i < length; i++) {
+    RawObject* raw = array.At(i);
+    const intptr_t cid = raw->GetClassIdMayBeSmi();
+    all_smis = all_smis && (cid == kSmiCid);
+    all_strings = all_strings && (cid == kOneByteStringCid);
+    if (!all_smis && !all_strings) {
+      return Bool::False().raw();
+    }
+    elements[i] = raw;
+  }
+
+  if (all_smis) {
+    // Tagged Smis order like their values.
+    auto key = [](RawObject* smi) {
+      return reinterpret_cast<uword>(smi) ^ (static_cast<uword>(1)
+                                             << (kBitsPerWord - 1));
+    };
+    if (length >= kRadixSortThreshold) {
+      RawObject** scratch = zone->Alloc<RawObject*>(length);
+      Sort::RadixSort(elements, scratch, length, key);
+    } else {
+      Sort::IntroSort(elements, length, [&key](RawObject* a, RawObject* b) {
+        return key(a) < key(b);
+      });
+    }
+  } else {
+    Sort::IntroSort(elements, length, [](RawObject* a, RawObject* b) {
+      return OneByteString::CompareTo(reinterpret_cast<RawOneByteString*>(a),
+                                      reinterpret_cast<RawOneByteString*>(b)) <
+             0;
+    });
+  }
+
+  for (intptr_t i = 0; i < length; i++) {
+    element = elements[i];
+    array.SetAt(i, element);
+  }
+  return Bool::True().raw();
+}
+
 // ObjectArray src, int start, int count, bool needTypeArgument.
 DEFINE_NATIVE_ENTRY(List_slice, 0, 4) {
   const Array& src = Array::CheckedHandle(zone, arguments->NativeArgAt(0));
@@ -69,6 +137,40 @@ DEFINE_NATIVE_ENTRY(List_slice, 0, 4) {
   return src.Slice(istart, icount, needs_type_arg.value());
 }
 
+// _List dst, ObjectArray or GrowableObjectArray src, int src_start,
+// int dst_start, int count.
+DEFINE_NATIVE_ENTRY(List_copyFromObjectArray, 0, 5) {
+  const Array& dst = Array::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Instance& src =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, src_start, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, dst_start, arguments->NativeArgAt(3));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, count, arguments->NativeArgAt(4));
+  const Array& source = Array::Handle(
+      zone, src.IsGrowableObjectArray()
+                ? GrowableObjectArray::Cast(src).data()
+                : Array::Cast(src).raw());
+  const intptr_t source_length = src.IsGrowableObjectArray()
+                                     ? GrowableObjectArray::Cast(src).Length()
+                                     : source.Length();
+  const intptr_t icount = count.Value();
+  if ((icount < 0) || (icount > source_length) || (icount > dst.Length())) {
+    Exceptions::ThrowRangeError("count", count, 0,
+                                Utils::Minimum(source_length, dst.Length()));
+  }
+  const intptr_t isrc_start = src_start.Value();
+  if ((isrc_start < 0) || (isrc_start > source_length - icount)) {
+    Exceptions::ThrowRangeError("srcStart", src_start, 0,
+                                source_length - icount);
+  }
+  const intptr_t idst_start = dst_start.Value();
+  if ((idst_start < 0) || (idst_start > dst.Length() - icount)) {
+    Exceptions::ThrowRangeError("start", dst_start, 0, dst.Length() - icount);
+  }
+  dst.CopyFrom(idst_start, source, isrc_start, icount);
+  return Object::null();
+}
+
 // Private factory, expects correct arguments.
 DEFINE_NATIVE_ENTRY(ImmutableList_from, 0, 4) {
   // Ignore first argument of a thsi factory (type argument).
@@ -4,6 +4,14 @@
 
 // part of "core_patch.dart";
 
+// Lists shorter than this are sorted in Dart, where the loop is cheaper than
+// calling into the runtime.
+const int _nativeSortThreshold = 16;
+
+// Fewer elements than this are copied between lists in Dart, for the same
+// reason.
+const int _nativeCopyThreshold = 64;
+
 @pragma("vm:entry-point")
 class _List<E> extends FixedLengthListBase<E> {
   @pragma("vm:exact-result-type", _List)
@@ -35,6 +43,26 @@ class _List<E> extends FixedLengthListBase<E> {
   List _sliceInternal(int start, int count, bool needsTypeArgument)
       native "List_slice";
 
+  // Copies [count] elements of [src], which is a different _List,
+  // _ImmutableList or _GrowableList, starting at [srcStart] into this list
+  // starting at [start]. The elements must already have the right type.
+  void _copyFromObjectArray(List src, int srcStart, int start, int count) {
+    if (count < _nativeCopyThreshold) {
+      // This is a work-around for dartbug.com/30090. See the comment in
+      // _GrowableList._grow.
+      if (count > 0) {
+        for (int i = 0; i < count; i++) {
+          this[start + i] = src[srcStart + i];
+        }
+      }
+    } else {
+      _copyFromObjectArrayNative(src, srcStart, start, count);
+    }
+  }
+
+  void _copyFromObjectArrayNative(List src, int srcStart, int start, int count)
+      native "List_copyFromObjectArray";
+
   // List interface.
   void setRange(int start, int end, Iterable<E> iterable, [int skipCount = 0]) {
     if (start < 0 || start > this.length) {
@@ -98,6 +126,19 @@ class _List<E> extends FixedLengthListBase<E> {
     return result;
   }
 
+  void sort([int compare(E a, E b)]) {
+    if (compare == null &&
+        this.length >= _nativeSortThreshold &&
+        _sortNative(this.length)) {
+      return;
+    }
+    super.sort(compare);
+  }
+
+  // Sorts the first 'length' elements if they are all Smis or all one-byte
+  // strings, and returns whether it did.
+  bool _sortNative(int length) native "List_sort";
+
   // Iterable interface.
 
   void forEach(f(E element)) {
@@ -26,6 +26,20 @@ class List<E> {
   factory List.from(Iterable elements, {bool growable: true}) {
     if (elements is EfficientLengthIterable<E>) {
       int length = elements.length;
+      final cid = ClassID.getID(elements);
+      if ((length > 0) &&
+          ((cid == ClassID.cidArray) ||
+              (cid == ClassID.cidGrowableObjectArray) ||
+              (cid == ClassID.cidImmutableArray))) {
+        // Copy the elements of the VM's own lists in bulk.
+        if (!growable) {
+          return new _List<E>(length)
+            .._copyFromObjectArray(elements, 0, 0, length);
+        }
+        var data = new _List(length)
+          .._copyFromObjectArray(elements, 0, 0, length);
+        return new _GrowableList<E>.withData(data).._setLength(length);
+      }
       var list = growable ? new _GrowableList<E>(length) : new _List<E>(length);
       if (length > 0) {
         // Avoid creating iterator unless necessary.
@@ -90,10 +90,18 @@ Function _asyncErrorWrapperHelper(continuation) {
 ///
 /// If [object] is not a future, then it is wrapped into one.
 ///
-/// Returns the result of registering with `.then`.
+/// Returns the result of registering with `.then`, or null if the
+/// continuation was scheduled directly.
 Future _awaitHelper(
     var object, Function thenCallback, Function errorCallback, var awaiter) {
   if (object is! Future) {
+    if (identical(Zone.current, _rootZone)) {
+      // Fast path: the root zone runs the continuation like a completed
+      // `_Future` would, so schedule it directly instead of allocating the
+      // future, its listener and the future returned by `.then`.
+      _scheduleAsyncCallback(() => thenCallback(object));
+      return null;
+    }
     object = new _Future().._setValue(object);
   } else if (object is! _Future) {
     return object.then(thenCallback, onError: errorCallback);
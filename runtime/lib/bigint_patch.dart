@@ -1194,6 +1194,10 @@ class _BigIntImpl implements BigInt {
     if (used == 0 || otherUsed == 0) {
       return zero;
     }
+    if (used >= _karatsubaThreshold && otherUsed >= _karatsubaThreshold) {
+      var product = _mulAbs(this, other);
+      return (_isNegative != other._isNegative) ? -product : product;
+    }
     var resultUsed = used + otherUsed;
     var digits = _digits;
     var otherDigits = other._digits;
@@ -1214,6 +1218,12 @@ class _BigIntImpl implements BigInt {
     var resultUsed = xUsed + otherUsed;
     var i = resultUsed + (resultUsed & 1);
     assert(resultDigits.length >= i);
+    if (xUsed >= _karatsubaThreshold && otherUsed >= _karatsubaThreshold) {
+      var product = _mulAbs(new _BigIntImpl._(false, xUsed, xDigits),
+          new _BigIntImpl._(false, otherUsed, otherDigits));
+      _copyProduct(product, resultDigits, i);
+      return resultUsed;
+    }
     while (--i >= 0) {
       resultDigits[i] = 0;
     }
@@ -1230,6 +1240,11 @@ class _BigIntImpl implements BigInt {
       Uint32List xDigits, int xUsed, Uint32List resultDigits) {
     var resultUsed = 2 * xUsed;
     assert(resultDigits.length >= resultUsed);
+    if (xUsed >= _karatsubaThreshold) {
+      var product = _sqrAbs(new _BigIntImpl._(false, xUsed, xDigits));
+      _copyProduct(product, resultDigits, resultUsed);
+      return resultUsed;
+    }
     // Since resultUsed is even, no need for a leading zero for
     // 64-bit processing.
     var i = resultUsed;
@@ -1247,6 +1262,123 @@ class _BigIntImpl implements BigInt {
     return resultUsed;
   }
 
+  // Operands with at least this many digits are multiplied with Karatsuba's
+  // algorithm. Below it, the _mulAdd and _sqrAdd intrinsics are faster.
+  static const int _karatsubaThreshold = 48;
+
+  // resultDigits[0..length-1] = product, zero extended.
+  static void _copyProduct(
+      _BigIntImpl product, Uint32List resultDigits, int length) {
+    var productDigits = product._digits;
+    var productUsed = product._used;
+    for (var i = 0; i < productUsed; i++) {
+      resultDigits[i] = productDigits[i];
+    }
+    for (var i = productUsed; i < length; i++) {
+      resultDigits[i] = 0;
+    }
+  }
+
+  // digits[offset..] += addend, where the sum is known to fit in digits.
+  static void _addDigitsAt(Uint32List digits, int offset, _BigIntImpl addend) {
+    var addendDigits = addend._digits;
+    var addendUsed = addend._used;
+    var carry = 0;
+    var i = offset;
+    for (var j = 0; j < addendUsed; j++, i++) {
+      carry += digits[i] + addendDigits[j];
+      digits[i] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+    while (carry != 0) {
+      carry += digits[i];
+      digits[i++] = carry & _digitMask;
+      carry >>= _digitBits;
+    }
+  }
+
+  /// Returns the non-negative value of the digits in the range [from] to
+  /// [to-1].
+  _BigIntImpl _sliceDigits(int from, int to) {
+    if (to > _used) to = _used;
+    if (from >= to) return zero;
+    var length = to - from;
+    return new _BigIntImpl._(
+        false, length, _cloneDigits(_digits, from, to, length));
+  }
+
+  // Index at which Karatsuba's algorithm splits an operand of [used] digits.
+  // It is kept even, so that the low halves start on a digit pair as the
+  // 64-bit intrinsics require.
+  static int _karatsubaSplit(int used) => ((used + 2) >> 2) << 1;
+
+  /// Returns `|x| * |y|`.
+  static _BigIntImpl _mulAbs(_BigIntImpl x, _BigIntImpl y) {
+    if (identical(x._digits, y._digits) && x._used == y._used) {
+      return _sqrAbs(x);
+    }
+    if (x._used < y._used) {
+      var t = x;
+      x = y;
+      y = t;
+    }
+    var xUsed = x._used;
+    var yUsed = y._used;
+    var resultUsed = xUsed + yUsed;
+    var resultDigits = _newDigits(resultUsed);
+    if (yUsed < _karatsubaThreshold) {
+      var xDigits = x._digits;
+      var yDigits = y._digits;
+      var i = 0;
+      while (i < yUsed) {
+        i += _mulAdd(yDigits, i, xDigits, 0, resultDigits, i, xUsed);
+      }
+      return new _BigIntImpl._(false, resultUsed, resultDigits);
+    }
+    var k = _karatsubaSplit(xUsed);
+    if (yUsed <= k) {
+      // Too unbalanced to split both operands. Multiply y by slices of x of
+      // about its own size instead.
+      var step = yUsed + (yUsed & 1);
+      for (var i = 0; i < xUsed; i += step) {
+        _addDigitsAt(resultDigits, i, _mulAbs(x._sliceDigits(i, i + step), y));
+      }
+      return new _BigIntImpl._(false, resultUsed, resultDigits);
+    }
+    var x0 = x._sliceDigits(0, k);
+    var x1 = x._sliceDigits(k, xUsed);
+    var y0 = y._sliceDigits(0, k);
+    var y1 = y._sliceDigits(k, yUsed);
+    var z0 = _mulAbs(x0, y0);
+    var z2 = _mulAbs(x1, y1);
+    var z1 = _mulAbs(x0 + x1, y0 + y1) - z0 - z2;
+    _addDigitsAt(resultDigits, 0, z0);
+    _addDigitsAt(resultDigits, 2 * k, z2);
+    _addDigitsAt(resultDigits, k, z1);
+    return new _BigIntImpl._(false, resultUsed, resultDigits);
+  }
+
+  /// Returns `x * x`.
+  static _BigIntImpl _sqrAbs(_BigIntImpl x) {
+    var xUsed = x._used;
+    var resultUsed = 2 * xUsed;
+    var resultDigits = _newDigits(resultUsed);
+    if (xUsed < _karatsubaThreshold) {
+      _sqrDigits(x._digits, xUsed, resultDigits);
+      return new _BigIntImpl._(false, resultUsed, resultDigits);
+    }
+    var k = _karatsubaSplit(xUsed);
+    var x0 = x._sliceDigits(0, k);
+    var x1 = x._sliceDigits(k, xUsed);
+    var z0 = _sqrAbs(x0);
+    var z2 = _sqrAbs(x1);
+    var z1 = _sqrAbs(x0 + x1) - z0 - z2;
+    _addDigitsAt(resultDigits, 0, z0);
+    _addDigitsAt(resultDigits, 2 * k, z2);
+    _addDigitsAt(resultDigits, k, z1);
+    return new _BigIntImpl._(false, resultUsed, resultDigits);
+  }
+
   // Indices of the arguments of _estimateQuotientDigit.
   // For 64-bit processing by intrinsics on 64-bit platforms, the top digit pair
   // of the divisor is provided in the args array, and a 64-bit estimated
@@ -1292,6 +1424,10 @@ class _BigIntImpl implements BigInt {
     if (_used < other._used) {
       return zero;
     }
+    if (_useRecursiveDivision(other)) {
+      var quo = _divRemRecursive(this, other)[0];
+      return (_isNegative != other._isNegative) ? -quo : quo;
+    }
     _divRem(other);
     // Return quotient, i.e.
     // _lastQuoRem_digits[_lastRem_used.._lastQuoRem_used-1] with proper sign.
@@ -1312,6 +1448,10 @@ class _BigIntImpl implements BigInt {
     if (_used < other._used) {
       return this;
     }
+    if (_useRecursiveDivision(other)) {
+      var rem = _divRemRecursive(this, other)[1];
+      return _isNegative ? -rem : rem;
+    }
     _divRem(other);
     // Return remainder, i.e.
     // denormalized _lastQuoRem_digits[0.._lastRem_used-1] with proper sign.
@@ -1327,6 +1467,109 @@ class _BigIntImpl implements BigInt {
     return rem;
   }
 
+  // Divisions where both the divisor and the quotient have at least this many
+  // digits use the recursive algorithm, whose cost is dominated by Karatsuba
+  // multiplication instead of growing with their product.
+  static const int _recursiveDivisionThreshold = 64;
+  static const int _recursiveDivisionBits =
+      _recursiveDivisionThreshold * _digitBits;
+
+  bool _useRecursiveDivision(_BigIntImpl other) =>
+      other._used >= _recursiveDivisionThreshold &&
+      _used - other._used >= _recursiveDivisionThreshold;
+
+  /// Returns `[|this| ~/ |other|, |this|.remainder(|other|)]` using
+  /// schoolbook division.
+  List<_BigIntImpl> _divRemSchoolbook(_BigIntImpl other) {
+    if (_used < other._used) {
+      return [zero, _isNegative ? -this : this];
+    }
+    _divRem(other);
+    var lastQuo_used = _lastQuoRemUsed - _lastRemUsed;
+    var quo = new _BigIntImpl._(
+        false,
+        lastQuo_used,
+        _cloneDigits(
+            _lastQuoRemDigits, _lastRemUsed, _lastQuoRemUsed, lastQuo_used));
+    var rem = new _BigIntImpl._(false, _lastRemUsed,
+        _cloneDigits(_lastQuoRemDigits, 0, _lastRemUsed, _lastRemUsed));
+    if (_lastRem_nsh > 0) {
+      rem = rem >> _lastRem_nsh;
+    }
+    return [quo, rem];
+  }
+
+  /// Returns `[|a| ~/ |b|, |a|.remainder(|b|)]`.
+  ///
+  /// Uses the recursive division of Burnikel and Ziegler, "Fast Recursive
+  /// Division" (1998). The dividend is split into chunks of as many digits
+  /// as the divisor, which are then divided by it from the most significant
+  /// one, each step dividing a value of twice the size of the divisor.
+  static List<_BigIntImpl> _divRemRecursive(_BigIntImpl a, _BigIntImpl b) {
+    // Normalize the divisor so that its top digit has its top bit set.
+    var shift = (_digitBits - b.bitLength % _digitBits) % _digitBits;
+    a = a.abs() << shift;
+    b = b.abs() << shift;
+    var n = b._used;
+    var nBits = n * _digitBits;
+    var aUsed = a._used;
+    var quoDigits = _newDigits(aUsed);
+    var rem = zero;
+    for (var i = (aUsed - 1) ~/ n * n; i >= 0; i -= n) {
+      var qr = _div2n1n((rem << nBits) + a._sliceDigits(i, i + n), b, nBits);
+      _addDigitsAt(quoDigits, i, qr[0]);
+      rem = qr[1];
+    }
+    return [new _BigIntImpl._(false, aUsed, quoDigits), rem >> shift];
+  }
+
+  // Returns `[a ~/ b, a.remainder(b)]`, where [b] has [n] bits and
+  // `a < b << n`.
+  static List<_BigIntImpl> _div2n1n(_BigIntImpl a, _BigIntImpl b, int n) {
+    if (n <= _recursiveDivisionBits ||
+        a.bitLength - n <= _recursiveDivisionBits) {
+      return a._divRemSchoolbook(b);
+    }
+    var pad = n & 1;
+    if (pad != 0) {
+      a <<= 1;
+      b <<= 1;
+      n++;
+    }
+    var halfN = n >> 1;
+    var mask = (one << halfN) - one;
+    var b1 = b >> halfN;
+    var b2 = b & mask;
+    var qr1 = _div3n2n(a >> n, (a >> halfN) & mask, b, b1, b2, halfN);
+    var qr2 = _div3n2n(qr1[1], a & mask, b, b1, b2, halfN);
+    var rem = qr2[1];
+    if (pad != 0) {
+      rem >>= 1;
+    }
+    return [(qr1[0] << halfN) | qr2[0], rem];
+  }
+
+  // Returns `[a ~/ b, a.remainder(b)]` for `a = a12 << n | a3`, where
+  // `b = b1 << n | b2` has 2n bits and `a12 < b << n`.
+  static List<_BigIntImpl> _div3n2n(_BigIntImpl a12, _BigIntImpl a3,
+      _BigIntImpl b, _BigIntImpl b1, _BigIntImpl b2, int n) {
+    _BigIntImpl quo, rem;
+    if ((a12 >> n) == b1) {
+      quo = (one << n) - one;
+      rem = a12 - (b1 << n) + b1;
+    } else {
+      var qr = _div2n1n(a12, b1, n);
+      quo = qr[0];
+      rem = qr[1];
+    }
+    rem = ((rem << n) | a3) - quo * b2;
+    while (rem._isNegative) {
+      quo -= one;
+      rem += b;
+    }
+    return [quo, rem];
+  }
+
   /// Computes this ~/ other and this.remainder(other).
   ///
   /// Stores the result in [_lastQuoRemDigits], [_lastQuoRemUsed] and
@@ -2409,6 +2652,9 @@ class _BigIntImpl implements BigInt {
       if (_isNegative) return (-_digits[0]).toString();
       return _digits[0].toString();
     }
+    if (_used >= _recursiveToStringThreshold) {
+      return _toStringRecursive();
+    }
 
     // Generate in chunks of 9 digits.
     // The chunks are in reversed order.
@@ -2440,6 +2686,51 @@ class _BigIntImpl implements BigInt {
     return decimalDigitChunks.reversed.join();
   }
 
+  // Values with at least this many digits are converted to decimal by
+  // splitting them in halves, which benefits from the recursive division.
+  static const int _recursiveToStringThreshold = 128;
+
+  String _toStringRecursive() {
+    var value = abs();
+    // powers[k] is 10^(9 * 2^k).
+    var powers = <_BigIntImpl>[_oneBillion];
+    while (true) {
+      var next = powers.last * powers.last;
+      if (next > value) break;
+      powers.add(next);
+    }
+    var buffer = new StringBuffer();
+    if (_isNegative) buffer.write("-");
+    _writeDecimal(value, powers, powers.length - 1, 0, buffer);
+    return buffer.toString();
+  }
+
+  // Writes the decimal digits of [value], which is less than
+  // `powers[level] * powers[level]`, to [buffer], left padded with zeros to
+  // [width] digits.
+  static void _writeDecimal(_BigIntImpl value, List<_BigIntImpl> powers,
+      int level, int width, StringBuffer buffer) {
+    if (level < 0 || value._used < _recursiveToStringThreshold) {
+      var digits = value.toString();
+      if (digits.length < width) buffer.write("0" * (width - digits.length));
+      buffer.write(digits);
+      return;
+    }
+    var divisor = powers[level];
+    if (width == 0 && value < divisor) {
+      // No leading zeros are written, so skip to the level that fits.
+      _writeDecimal(value, powers, level - 1, 0, buffer);
+      return;
+    }
+    var qr = value._useRecursiveDivision(divisor)
+        ? _divRemRecursive(value, divisor)
+        : value._divRemSchoolbook(divisor);
+    var lowWidth = 9 << level;
+    _writeDecimal(
+        qr[0], powers, level - 1, width == 0 ? 0 : width - lowWidth, buffer);
+    _writeDecimal(qr[1], powers, level - 1, lowWidth, buffer);
+  }
+
   int _toRadixCodeUnit(int digit) {
     const int _0 = 48;
     const int _a = 97;
@@ -21,6 +21,8 @@ class ClassID {
   @pragma("vm:entry-point")
   static final int cidOneByteString = 0;
   @pragma("vm:entry-point")
+  static final int cidSmi = 0;
+  @pragma("vm:entry-point")
   static final int cidTwoByteString = 0;
   @pragma("vm:entry-point")
   static final int cidUint8ArrayView = 0;
@@ -151,6 +151,33 @@ class _InternalLinkedHashMap<K, V> extends _HashVMBase
     _usedData = 0;
     _deletedKeys = 0;
   }
+
+  // Most keys are one byte strings or Smis. Checking for their class ids
+  // first gives each its own call site, so they are hashed and compared
+  // without the polymorphic dispatch of _OperatorEqualsAndHashCode. Equal
+  // Smis are identical and a Smi is its own hash code.
+  int _hashCode(e) {
+    final int cid = internal.ClassID.getID(e);
+    if (cid == internal.ClassID.cidSmi) {
+      return internal.unsafeCast<int>(e);
+    }
+    if (cid == internal.ClassID.cidOneByteString) {
+      return internal.unsafeCast<String>(e).hashCode;
+    }
+    return e.hashCode;
+  }
+
+  bool _equals(e1, e2) {
+    final int cid = internal.ClassID.getID(e1);
+    if (cid == internal.ClassID.cidSmi) {
+      return identical(e1, e2) ||
+          (internal.ClassID.getID(e2) != internal.ClassID.cidSmi && e1 == e2);
+    }
+    if (cid == internal.ClassID.cidOneByteString) {
+      return identical(e1, e2) || internal.unsafeCast<String>(e1) == e2;
+    }
+    return e1 == e2;
+  }
 }
 
 abstract class _LinkedHashMapMixin<K, V> implements _HashBase {
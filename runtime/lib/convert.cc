@@ -0,0 +1,706 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/bootstrap_natives.h"
+
+#include "platform/unicode.h"
+#include "vm/base64.h"
+#include "vm/dart_entry.h"
+#include "vm/double_conversion.h"
+#include "vm/exceptions.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/symbols.h"
+
+namespace dart {
+
+// Returns the address of the bytes of 'list' if it is one of the VM's own
+// Uint8List implementations, or NULL otherwise. Typed data can move, so the
+// address is only valid until the next safepoint.
+static const uint8_t* Uint8ListDataAddr(const Instance& list) {
+  intptr_t offset = 0;
+  Instance& data = Instance::Handle(list.raw());
+  if (data.GetClassId() == kTypedDataUint8ArrayViewCid) {
+    const TypedDataView& view = TypedDataView::Cast(list);
+    offset = Smi::Value(view.offset_in_bytes());
+    data = view.typed_data();
+  } else if ((data.GetClassId() != kTypedDataUint8ArrayCid) &&
+             (data.GetClassId() != kExternalTypedDataUint8ArrayCid)) {
+    return NULL;
+  }
+  void* bytes;
+  if (data.IsTypedData()) {
+    bytes = TypedData::Cast(data).DataAddr(0);
+  } else {
+    ASSERT(data.IsExternalTypedData());
+    bytes = ExternalTypedData::Cast(data).DataAddr(0);
+  }
+  return reinterpret_cast<const uint8_t*>(bytes) + offset;
+}
+
+DEFINE_NATIVE_ENTRY(Utf8Decoder_scanOneByteCharacters, 0, 3) {
+  const Instance& list =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  // The caller has checked the range already.
+  const intptr_t start = start_obj.Value();
+  const intptr_t end = end_obj.Value();
+  NoSafepointScope no_safepoint;
+  const uint8_t* data = Uint8ListDataAddr(list);
+  if (data == NULL) {
+    return Object::null();
+  }
+  return Smi::New(Utf8::AsciiPrefixLength(data + start, end - start));
+}
+
+// Decodes well formed UTF-8. Anything else is left to the decoder in Dart,
+// which knows how to report or replace malformed input.
+DEFINE_NATIVE_ENTRY(Utf8Decoder_convert, 0, 3) {
+  const Instance& list =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  // The caller has checked the range already.
+  intptr_t start = start_obj.Value();
+  const intptr_t end = end_obj.Value();
+
+  // The bytes are copied out of the list because allocating the result can
+  // move it.
+  uint8_t* utf8;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = Uint8ListDataAddr(list);
+    if (data == NULL) {
+      return Object::null();
+    }
+    // A leading byte order mark is dropped, like the Dart decoder does.
+    if (((end - start) >= 3) && (data[start] == 0xEF) &&
+        (data[start + 1] == 0xBB) && (data[start + 2] == 0xBF)) {
+      start += 3;
+    }
+    if (!Utf8::IsValid(data + start, end - start)) {
+      return Object::null();
+    }
+    utf8 = zone->Alloc<uint8_t>(end - start);
+    memmove(utf8, data + start, end - start);
+  }
+  return String::FromUTF8(utf8, end - start, Heap::kNew);
+}
+
+// Converts between bytes and the characters of one-byte strings without
+// copying them, which needs access to the string's data.
+class Base64Converter : public AllStatic {
+ public:
+  static RawObject* Encode(Zone* zone,
+                           const Instance& list,
+                           intptr_t length,
+                           bool url_safe) {
+    if (length > (OneByteString::kMaxElements / 4) * 3) {
+      return Object::null();
+    }
+    {
+      NoSafepointScope no_safepoint;
+      if (Uint8ListDataAddr(list) == NULL) {
+        return Object::null();
+      }
+    }
+    const String& result = String::Handle(
+        zone, OneByteString::New(Base64EncodedLength(length), Heap::kNew));
+    NoSafepointScope no_safepoint;
+    EncodeBase64(Uint8ListDataAddr(list), length, url_safe,
+                 OneByteString::DataStart(result));
+    return result.raw();
+  }
+
+  static RawObject* Decode(Zone* zone,
+                           const String& input,
+                           intptr_t start,
+                           intptr_t end) {
+    if (!input.IsOneByteString()) {
+      return Object::null();
+    }
+    const intptr_t length = end - start;
+    intptr_t decoded_length;
+    {
+      NoSafepointScope no_safepoint;
+      decoded_length =
+          Base64DecodedLength(OneByteString::CharAddr(input, start), length);
+    }
+    if (decoded_length < 0) {
+      return Object::null();
+    }
+    const TypedData& result = TypedData::Handle(
+        zone, TypedData::New(kTypedDataUint8ArrayCid, decoded_length));
+    NoSafepointScope no_safepoint;
+    if (!DecodeBase64Strict(OneByteString::CharAddr(input, start), length,
+                            reinterpret_cast<uint8_t*>(result.DataAddr(0)))) {
+      return Object::null();
+    }
+    return result.raw();
+  }
+};
+
+DEFINE_NATIVE_ENTRY(Base64Encoder_encode, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, url_safe, arguments->NativeArgAt(0));
+  const Instance& list =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, length_obj, arguments->NativeArgAt(2));
+  return Base64Converter::Encode(zone, list, length_obj.Value(),
+                                 url_safe.value());
+}
+
+// Decodes canonical padded base64. Anything else is left to the decoder in
+// Dart, which reports errors and accepts percent-encoded padding.
+DEFINE_NATIVE_ENTRY(Base64Decoder_decode, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, input, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  // The caller has checked the range already.
+  return Base64Converter::Decode(zone, input, start_obj.Value(),
+                                 end_obj.Value());
+}
+
+static const uword kLowBits = ~static_cast<uword>(0) / 0xFF;
+static const uword kHighBits = kLowBits * 0x80;
+
+static inline bool HasZeroByte(uword word) {
+  return ((word - kLowBits) & ~word & kHighBits) != 0;
+}
+
+// Returns true if 'word' holds a quote, a backslash or a control character,
+// which end the plain part of a JSON string.
+static inline bool HasStringSpecial(uword word) {
+  return HasZeroByte(word ^ (kLowBits * '"')) ||
+         HasZeroByte(word ^ (kLowBits * '\\')) ||
+         (((word - (kLowBits * 0x20)) & ~word & kHighBits) != 0);
+}
+
+static inline bool IsDigit(uint8_t c) {
+  return (c >= '0') && (c <= '9');
+}
+
+// Parses a complete JSON document held as UTF-8 bytes that do not move,
+// building the same objects as the Dart parser's _BuildJsonListener. Maps
+// are built without an index, which the caller has to regenerate.
+//
+// The parser gives up on anything unusual, such as syntax errors, deep
+// nesting or malformed UTF-8, and leaves that input to the Dart parser,
+// which reports errors precisely.
+class JsonParser : public ValueObject {
+ public:
+  JsonParser(Thread* thread, const uint8_t* json, intptr_t length)
+      : thread_(thread),
+        zone_(thread->zone()),
+        json_(json),
+        length_(length),
+        position_(0),
+        buffer_(NULL),
+        buffer_capacity_(0),
+        maps_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+        map_type_arguments_(TypeArguments::Handle(
+            zone_,
+            thread->isolate()->object_store()
+                ->type_argument_string_dynamic())) {
+    memset(keys_, 0, sizeof(keys_));
+  }
+
+  // Returns false if the Dart parser has to parse the input instead.
+  bool Parse(Object* result) {
+    SkipWhitespace();
+    if (!ParseValue(result, 0)) {
+      return false;
+    }
+    SkipWhitespace();
+    return position_ == length_;
+  }
+
+  const GrowableObjectArray& maps() const { return maps_; }
+
+ private:
+  // The Dart parser does not recurse, so deeper input is left to it.
+  static const intptr_t kMaxDepth = 512;
+
+  // Keep in sync with _HashBase._INITIAL_INDEX_SIZE in compact_hash.dart.
+  static const intptr_t kInitialMapDataSize = 16;
+
+  // Short keys are shared between the objects of a document, which also
+  // shares their hash codes.
+  static const intptr_t kKeyCacheSize = 64;
+  static const intptr_t kMaxCachedKeyLength = 32;
+
+  struct CachedKey {
+    const uint8_t* bytes;
+    intptr_t length;
+    Object* key;
+  };
+
+  void SkipWhitespace() {
+    while (position_ < length_) {
+      const uint8_t c = json_[position_];
+      if ((c != ' ') && (c != '\n') && (c != '\r') && (c != '\t')) {
+        return;
+      }
+      position_++;
+    }
+  }
+
+  bool Match(const char* literal) {
+    const intptr_t length = strlen(literal);
+    if ((length_ - position_ < length) ||
+        (memcmp(&json_[position_], literal, length) != 0)) {
+      return false;
+    }
+    position_ += length;
+    return true;
+  }
+
+  bool ParseValue(Object* value, intptr_t depth);
+  bool ParseArray(Object* value, intptr_t depth);
+  bool ParseObject(Object* value, intptr_t depth);
+  bool ParseString(Object* value, bool is_key);
+  bool ParseEscapedString(intptr_t start, Object* value);
+  bool ParseNumber(Object* value);
+  void LookupKey(const uint8_t* bytes, intptr_t length, Object* key);
+
+  Thread* thread_;
+  Zone* zone_;
+  const uint8_t* json_;
+  const intptr_t length_;
+  intptr_t position_;
+
+  // Holds the UTF-16 code units of strings with escapes.
+  uint16_t* buffer_;
+  intptr_t buffer_capacity_;
+
+  const GrowableObjectArray& maps_;
+  const TypeArguments& map_type_arguments_;
+  CachedKey keys_[kKeyCacheSize];
+
+  DISALLOW_COPY_AND_ASSIGN(JsonParser);
+};
+
+bool JsonParser::ParseValue(Object* value, intptr_t depth) {
+  if (position_ == length_) {
+    return false;
+  }
+  switch (json_[position_]) {
+    case '{':
+      return ParseObject(value, depth);
+    case '[':
+      return ParseArray(value, depth);
+    case '"':
+      return ParseString(value, false);
+    case 't':
+      *value = Bool::True().raw();
+      return Match("true");
+    case 'f':
+      *value = Bool::False().raw();
+      return Match("false");
+    case 'n':
+      *value = Object::null();
+      return Match("null");
+    default:
+      return ParseNumber(value);
+  }
+}
+
+bool JsonParser::ParseArray(Object* value, intptr_t depth) {
+  ASSERT(json_[position_] == '[');
+  if (depth == kMaxDepth) {
+    return false;
+  }
+  position_++;
+  HandleScope scope(thread_);
+  const GrowableObjectArray& list =
+      GrowableObjectArray::Handle(zone_, GrowableObjectArray::New());
+  Object& element = Object::Handle(zone_);
+  SkipWhitespace();
+  if ((position_ < length_) && (json_[position_] == ']')) {
+    position_++;
+    *value = list.raw();
+    return true;
+  }
+  while (true) {
+    if (!ParseValue(&element, depth + 1)) {
+      return false;
+    }
+    list.Add(element);
+    SkipWhitespace();
+    if (position_ == length_) {
+      return false;
+    }
+    const uint8_t c = json_[position_++];
+    if (c == ']') {
+      break;
+    }
+    if (c != ',') {
+      return false;
+    }
+    SkipWhitespace();
+  }
+  *value = list.raw();
+  return true;
+}
+
+bool JsonParser::ParseObject(Object* value, intptr_t depth) {
+  ASSERT(json_[position_] == '{');
+  if (depth == kMaxDepth) {
+    return false;
+  }
+  position_++;
+  HandleScope scope(thread_);
+  const GrowableObjectArray& entries =
+      GrowableObjectArray::Handle(zone_, GrowableObjectArray::New());
+  Object& element = Object::Handle(zone_);
+  SkipWhitespace();
+  if ((position_ < length_) && (json_[position_] == '}')) {
+    position_++;
+  } else {
+    while (true) {
+      if ((position_ == length_) || (json_[position_] != '"') ||
+          !ParseString(&element, true)) {
+        return false;
+      }
+      entries.Add(element);
+      SkipWhitespace();
+      if ((position_ == length_) || (json_[position_] != ':')) {
+        return false;
+      }
+      position_++;
+      SkipWhitespace();
+      if (!ParseValue(&element, depth + 1)) {
+        return false;
+      }
+      entries.Add(element);
+      SkipWhitespace();
+      if (position_ == length_) {
+        return false;
+      }
+      const uint8_t c = json_[position_++];
+      if (c == '}') {
+        break;
+      }
+      if (c != ',') {
+        return false;
+      }
+      SkipWhitespace();
+    }
+  }
+
+  // Lay the map out like a deserialized one. Duplicate keys are resolved
+  // when the index is regenerated, keeping the first position and the last
+  // value like the Dart parser does.
+  const intptr_t used_data = entries.Length();
+  const intptr_t data_size =
+      Utils::Maximum(Utils::RoundUpToPowerOfTwo(used_data),
+                     static_cast<uintptr_t>(kInitialMapDataSize));
+  const Array& data = Array::Handle(zone_, Array::New(data_size));
+  for (intptr_t i = 0; i < used_data; i++) {
+    element = entries.At(i);
+    data.SetAt(i, element);
+  }
+  const TypedData& no_index = TypedData::Handle(zone_);
+  const LinkedHashMap& map = LinkedHashMap::Handle(
+      zone_, LinkedHashMap::New(data, no_index, 0, used_data, 0));
+  map.SetTypeArguments(map_type_arguments_);
+  maps_.Add(map);
+  *value = map.raw();
+  return true;
+}
+
+void JsonParser::LookupKey(const uint8_t* bytes,
+                           intptr_t length,
+                           Object* key) {
+  uint32_t hash = length;
+  for (intptr_t i = 0; i < length; i++) {
+    hash = 31 * hash + bytes[i];
+  }
+  CachedKey* entry = &keys_[hash & (kKeyCacheSize - 1)];
+  if ((entry->key != NULL) && (entry->length == length) &&
+      (memcmp(entry->bytes, bytes, length) == 0)) {
+    *key = entry->key->raw();
+    return;
+  }
+  *key = String::FromLatin1(bytes, length);
+  if (entry->key == NULL) {
+    entry->key = &Object::ZoneHandle(zone_, Object::null());
+  }
+  *entry->key = key->raw();
+  entry->bytes = bytes;
+  entry->length = length;
+}
+
+bool JsonParser::ParseString(Object* value, bool is_key) {
+  ASSERT(json_[position_] == '"');
+  const intptr_t start = ++position_;
+  const intptr_t kWordSize = sizeof(uword);
+  uword high_bits = 0;
+  while (true) {
+    // Skip a word at a time while there is nothing to look at.
+    while ((position_ + kWordSize) <= length_) {
+      const uword word =
+          ReadUnaligned(reinterpret_cast<const uword*>(&json_[position_]));
+      if (HasStringSpecial(word)) {
+        break;
+      }
+      high_bits |= word;
+      position_ += kWordSize;
+    }
+    if (position_ == length_) {
+      return false;
+    }
+    const uint8_t c = json_[position_];
+    if (c == '"') {
+      break;
+    }
+    if (c == '\\') {
+      return ParseEscapedString(start, value);
+    }
+    if (c < 0x20) {
+      return false;
+    }
+    high_bits |= c;
+    position_++;
+  }
+  const uint8_t* bytes = &json_[start];
+  const intptr_t length = position_ - start;
+  position_++;
+  if ((high_bits & kHighBits) == 0) {
+    if (is_key && (length <= kMaxCachedKeyLength)) {
+      LookupKey(bytes, length, value);
+    } else {
+      *value = String::FromLatin1(bytes, length);
+    }
+    return true;
+  }
+  if (!Utf8::IsValid(bytes, length)) {
+    return false;
+  }
+  *value = String::FromUTF8(bytes, length);
+  return true;
+}
+
+bool JsonParser::ParseEscapedString(intptr_t start, Object* value) {
+  intptr_t i = start;
+  intptr_t length = 0;
+  while (true) {
+    if (i == length_) {
+      return false;
+    }
+    if ((length + 2) > buffer_capacity_) {
+      const intptr_t capacity = Utils::Maximum(2 * buffer_capacity_,
+                                               static_cast<intptr_t>(64));
+      buffer_ = zone_->Realloc<uint16_t>(buffer_, buffer_capacity_, capacity);
+      buffer_capacity_ = capacity;
+    }
+    const uint8_t c = json_[i];
+    if (c == '"') {
+      break;
+    }
+    if (c < 0x20) {
+      return false;
+    }
+    if (c < 0x80) {
+      i++;
+      if (c != '\\') {
+        buffer_[length++] = c;
+        continue;
+      }
+      if (i == length_) {
+        return false;
+      }
+      switch (json_[i++]) {
+        case '"':
+          buffer_[length++] = '"';
+          break;
+        case '\\':
+          buffer_[length++] = '\\';
+          break;
+        case '/':
+          buffer_[length++] = '/';
+          break;
+        case 'b':
+          buffer_[length++] = '\b';
+          break;
+        case 'f':
+          buffer_[length++] = '\f';
+          break;
+        case 'n':
+          buffer_[length++] = '\n';
+          break;
+        case 'r':
+          buffer_[length++] = '\r';
+          break;
+        case 't':
+          buffer_[length++] = '\t';
+          break;
+        case 'u': {
+          if ((length_ - i) < 4) {
+            return false;
+          }
+          uint16_t unit = 0;
+          for (intptr_t j = 0; j < 4; j++) {
+            const uint8_t digit = json_[i++];
+            if (IsDigit(digit)) {
+              unit = (unit << 4) | (digit - '0');
+            } else if (((digit | 0x20) >= 'a') && ((digit | 0x20) <= 'f')) {
+              unit = (unit << 4) | ((digit | 0x20) - 'a' + 10);
+            } else {
+              return false;
+            }
+          }
+          buffer_[length++] = unit;
+          break;
+        }
+        default:
+          return false;
+      }
+      continue;
+    }
+    int32_t ch;
+    i += Utf8::Decode(&json_[i], length_ - i, &ch);
+    if (ch == -1) {
+      return false;
+    }
+    if (Utf::IsSupplementary(ch)) {
+      Utf16::Encode(ch, &buffer_[length]);
+      length += 2;
+    } else {
+      buffer_[length++] = ch;
+    }
+  }
+  position_ = i + 1;
+  *value = String::FromUTF16(buffer_, length);
+  return true;
+}
+
+bool JsonParser::ParseNumber(Object* value) {
+  // Format: '-'?('0'|[1-9][0-9]*)('.'[0-9]+)?([eE][+-]?[0-9]+)?
+  const intptr_t start = position_;
+  const bool negative = (json_[position_] == '-');
+  if (negative) {
+    position_++;
+  }
+  const intptr_t digits_start = position_;
+  if ((position_ == length_) || !IsDigit(json_[position_])) {
+    return false;
+  }
+  if (json_[position_] == '0') {
+    position_++;
+    if ((position_ < length_) && IsDigit(json_[position_])) {
+      return false;
+    }
+  } else {
+    while ((position_ < length_) && IsDigit(json_[position_])) {
+      position_++;
+    }
+  }
+  const intptr_t digits = position_ - digits_start;
+  bool is_double = false;
+  if ((position_ < length_) && (json_[position_] == '.')) {
+    is_double = true;
+    position_++;
+    if ((position_ == length_) || !IsDigit(json_[position_])) {
+      return false;
+    }
+    while ((position_ < length_) && IsDigit(json_[position_])) {
+      position_++;
+    }
+  }
+  if ((position_ < length_) && ((json_[position_] | 0x20) == 'e')) {
+    is_double = true;
+    position_++;
+    if ((position_ < length_) &&
+        ((json_[position_] == '+') || (json_[position_] == '-'))) {
+      position_++;
+    }
+    if ((position_ == length_) || !IsDigit(json_[position_])) {
+      return false;
+    }
+    intptr_t exponent = 0;
+    while ((position_ < length_) && IsDigit(json_[position_])) {
+      exponent = 10 * exponent + (json_[position_] - '0');
+      // The Dart parser rounds these to zero or infinity without looking at
+      // the mantissa.
+      if (exponent > 400) {
+        return false;
+      }
+      position_++;
+    }
+  }
+  if (!is_double && (digits <= 19)) {
+    uint64_t magnitude = 0;
+    for (intptr_t i = digits_start; i < position_; i++) {
+      magnitude = 10 * magnitude + (json_[i] - '0');
+    }
+    const uint64_t limit =
+        static_cast<uint64_t>(kMaxInt64) + (negative ? 1 : 0);
+    if (magnitude <= limit) {
+      *value = Integer::New(negative ? static_cast<int64_t>(0 - magnitude)
+                                     : static_cast<int64_t>(magnitude));
+      return true;
+    }
+  }
+  // Integers which do not fit in 64 bits become doubles.
+  double result;
+  if (!CStringToDouble(reinterpret_cast<const char*>(&json_[start]),
+                       position_ - start, &result)) {
+    return false;
+  }
+  *value = Double::New(result);
+  return true;
+}
+
+DEFINE_NATIVE_ENTRY(JsonDecoder_parse, 0, 2) {
+  const Instance& source =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Instance& not_parsed =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(1));
+
+  // The document is parsed from a copy, because allocating the result can
+  // move the source.
+  uint8_t* json;
+  intptr_t length;
+  if (source.IsString()) {
+    const String& string = String::Cast(source);
+    length = Utf8::Length(string);
+    json = zone->Alloc<uint8_t>(length);
+    Utf8::Encode(string, reinterpret_cast<char*>(json), length);
+  } else {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = Uint8ListDataAddr(source);
+    if (data == NULL) {
+      return not_parsed.raw();
+    }
+    length = TypedDataBase::Cast(source).Length();
+    json = zone->Alloc<uint8_t>(length);
+    memmove(json, data, length);
+  }
+
+  JsonParser parser(thread, json, length);
+  Object& result = Object::Handle(zone);
+  if (!parser.Parse(&result)) {
+    return not_parsed.raw();
+  }
+  if (parser.maps().Length() > 0) {
+    const Library& collection_lib =
+        Library::Handle(zone, Library::CollectionLibrary());
+    const Function& rehash = Function::Handle(
+        zone,
+        collection_lib.LookupFunctionAllowPrivate(Symbols::_rehashObjects()));
+    ASSERT(!rehash.IsNull());
+    const Array& args = Array::Handle(zone, Array::New(1));
+    args.SetAt(0, parser.maps());
+    const Object& error =
+        Object::Handle(zone, DartEntry::InvokeFunction(rehash, args));
+    if (error.IsError()) {
+      Exceptions::PropagateError(Error::Cast(error));
+    }
+  }
+  return result.raw();
+}
+
+}  // namespace dart
@@ -19,6 +19,8 @@ import "dart:typed_data" show Uint8List, Uint16List;
 _parseJson(String source, reviver(key, value)) {
   _BuildJsonListener listener;
   if (reviver == null) {
+    var result = _parseJsonNative(source, _jsonNotParsed);
+    if (!identical(result, _jsonNotParsed)) return result;
     listener = new _BuildJsonListener();
   } else {
     listener = new _ReviverJsonListener(reviver);
@@ -31,6 +33,52 @@ _parseJson(String source, reviver(key, value)) {
   return listener.result;
 }
 
+const _jsonNotParsed = const Object();
+
+// Parses a complete document given as a String or a Uint8List, building the
+// same objects as [_BuildJsonListener]. Returns [notParsed] for input that
+// has to go through [_ChunkedJsonParser], including all invalid input.
+_parseJsonNative(Object source, Object notParsed) native "JsonDecoder_parse";
+
+@patch
+class Base64Encoder {
+  @patch
+  static String _convertIntercepted(bool urlSafe, List<int> input) {
+    if (input is Uint8List && input.length >= _nativeThreshold) {
+      // Returns null if the result would be too long for a string.
+      return _encodeNative(urlSafe, input, input.length);
+    }
+    return null; // This call was not intercepted.
+  }
+
+  // Below this many bytes the native call costs more than it saves.
+  static const int _nativeThreshold = 32;
+
+  static String _encodeNative(bool urlSafe, Uint8List input, int length)
+      native "Base64Encoder_encode";
+}
+
+@patch
+class Base64Decoder {
+  @patch
+  static Uint8List _convertIntercepted(String input, int start, int end) {
+    if (ClassID.getID(input) == ClassID.cidOneByteString &&
+        end - start >= _nativeThreshold) {
+      // Returns null if the input is not padded base64 without any
+      // percent-encoding, so that the decoder in Dart reports the error or
+      // handles the unusual input.
+      return _decodeNative(input, start, end);
+    }
+    return null; // This call was not intercepted.
+  }
+
+  // Below this many characters the native call costs more than it saves.
+  static const int _nativeThreshold = 32;
+
+  static Uint8List _decodeNative(String input, int start, int end)
+      native "Base64Decoder_decode";
+}
+
 @patch
 class Utf8Decoder {
   @patch
@@ -48,8 +96,21 @@ class Utf8Decoder {
   @patch
   static String _convertIntercepted(
       bool allowMalformed, List<int> codeUnits, int start, int end) {
+    if (codeUnits is Uint8List) {
+      end = RangeError.checkValidRange(start, end, codeUnits.length);
+      if (end - start >= _nativeThreshold) {
+        // Returns null if the input is not well formed.
+        return _convertNative(codeUnits, start, end);
+      }
+    }
     return null; // This call was not intercepted.
   }
+
+  // Below this many bytes the native call costs more than it saves.
+  static const int _nativeThreshold = 64;
+
+  static String _convertNative(Uint8List codeUnits, int start, int end)
+      native "Utf8Decoder_convert";
 }
 
 class _JsonUtf8Decoder extends Converter<List<int>, Object> {
@@ -59,6 +120,10 @@ class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   _JsonUtf8Decoder(this._reviver, this._allowMalformed);
 
   Object convert(List<int> input) {
+    if (_reviver == null && input is Uint8List) {
+      var result = _parseJsonNative(input, _jsonNotParsed);
+      if (!identical(result, _jsonNotParsed)) return result;
+    }
     var parser = _JsonUtf8DecoderSink._createParser(_reviver, _allowMalformed);
     parser.chunk = input;
     parser.chunkEnd = input.length;
@@ -1674,13 +1739,26 @@ class _Utf8StringBuffer {
     while (position < end) {
       int char = utf8[position];
       if (char <= MAX_ASCII) {
-        if (index == capacity) {
+        // Copy runs of ASCII characters in bulk.
+        int count = _scanOneByteCharacters(utf8, position, end);
+        if (count <= 1) {
+          if (index == capacity) {
+            length = index;
+            _grow();
+            capacity = buffer.length;
+          }
+          buffer[index++] = char;
+          position++;
+          continue;
+        }
+        while (index + count > capacity) {
           length = index;
           _grow();
           capacity = buffer.length;
         }
-        buffer[index++] = char;
-        position++;
+        buffer.setRange(index, index + count, utf8, position);
+        index += count;
+        position += count;
         continue;
       }
       length = index;
@@ -1859,6 +1937,10 @@ int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   // Special case for _Uint8ArrayView.
   if (units is Uint8List) {
     if (from >= 0 && to >= 0 && to <= units.length) {
+      if (to - from >= Utf8Decoder._nativeThreshold) {
+        final int count = _scanOneByteCharactersNative(units, from, to);
+        if (count != null) return count;
+      }
       for (int i = from; i < to; i++) {
         final unit = units[i];
         if ((unit & _ONE_BYTE_LIMIT) != unit) return i - from;
@@ -1874,3 +1956,7 @@ int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   }
   return to - from;
 }
+
+// Returns null if [units] is not one of the VM's own byte lists.
+int _scanOneByteCharactersNative(Uint8List units, int from, int to)
+    native "Utf8Decoder_scanOneByteCharacters";
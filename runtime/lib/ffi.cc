@@ -7,7 +7,9 @@
 #include "vm/bootstrap_natives.h"
 #include "vm/class_finalizer.h"
 #include "vm/compiler/assembler/assembler.h"
+#include "vm/dart_entry.h"
 #include "vm/exceptions.h"
+#include "vm/heap/safepoint.h"
 #include "vm/log.h"
 #include "vm/native_arguments.h"
 #include "vm/native_entry.h"
@@ -30,6 +32,12 @@ static void ThrowTypeArgumentError(const AbstractType& type_arg,
   Exceptions::ThrowArgumentError(error);
 }
 
+static void ThrowUnsupportedError(const char* message) {
+  const Array& args = Array::Handle(Array::New(1));
+  args.SetAt(0, String::Handle(String::New(message)));
+  Exceptions::ThrowByType(Exceptions::kUnsupported, args);
+}
+
 static bool IsPointerType(const AbstractType& type) {
   // Do a fast check for predefined types.
   classid_t type_cid = type.type_class_id();
@@ -82,7 +90,8 @@ static bool IsNativeFunction(const AbstractType& type_arg) {
 static void CheckSized(const AbstractType& type_arg) {
   classid_t type_cid = type_arg.type_class_id();
   if (RawObject::IsFfiTypeVoidClassId(type_cid) ||
-      RawObject::IsFfiTypeNativeFunctionClassId(type_cid)) {
+      RawObject::IsFfiTypeNativeFunctionClassId(type_cid) ||
+      type_cid == kFfiByValueCid) {
     const String& error = String::Handle(String::NewFormatted(
         "%s does not have a predefined size (@unsized). "
         "Unsized NativeTypes do not support [sizeOf] because their size "
@@ -111,6 +120,7 @@ static void CheckSized(const AbstractType& type_arg) {
 // [Float]                              -> [double]
 // [Pointer]<T>                         -> [Pointer]<T>
 // T extends [Pointer]                  -> T
+// [ByValue]<T>                         -> T
 // [NativeFunction]<T1 Function(T2, T3) -> S1 Function(S2, S3)
 //    where DartRepresentationOf(Tn) -> Sn
 static bool DartAndCTypeCorrespond(const AbstractType& native_type,
@@ -127,6 +137,12 @@ static bool DartAndCTypeCorrespond(const AbstractType& native_type,
   if (RawObject::IsFfiPointerClassId(native_type_cid)) {
     return native_type.Equals(dart_type) || dart_type.IsNullType();
   }
+  if (native_type_cid == kFfiByValueCid) {
+    TypeArguments& by_value_type_args =
+        TypeArguments::Handle(native_type.arguments());
+    return AbstractType::Handle(by_value_type_args.TypeAt(0))
+        .Equals(dart_type);
+  }
   if (RawObject::IsFfiTypeNativeFunctionClassId(native_type_cid)) {
     if (!dart_type.IsFunctionType()) {
       return false;
@@ -383,13 +399,10 @@ DEFINE_NATIVE_ENTRY(Ffi_load, 1, 1) {
 }
 
 static void StoreValue(Zone* zone,
-                       const Pointer& pointer,
-                       classid_t type_cid,
+                       uint8_t* address,
+                       const AbstractType& pointer_type_arg,
                        const Instance& new_value) {
-  uint8_t* address = reinterpret_cast<uint8_t*>(
-      Integer::Handle(pointer.GetCMemoryAddress()).AsInt64Value());
-  AbstractType& pointer_type_arg =
-      AbstractType::Handle(pointer.type_argument());
+  classid_t type_cid = pointer_type_arg.type_class_id();
   switch (type_cid) {
     case kFfiInt8Cid:
       *reinterpret_cast<int8_t*>(address) = AsInteger(new_value).AsInt64Value();
@@ -458,8 +471,47 @@ DEFINE_NATIVE_ENTRY(Ffi_store, 0, 2) {
   CheckSized(pointer_type_arg);
   ASSERT(DartAndCTypeCorrespond(pointer_type_arg, arg_type));
 
-  classid_t type_cid = pointer_type_arg.type_class_id();
-  StoreValue(zone, pointer, type_cid, new_value);
+  uint8_t* address = reinterpret_cast<uint8_t*>(
+      Integer::Handle(pointer.GetCMemoryAddress()).AsInt64Value());
+  StoreValue(zone, address, pointer_type_arg, new_value);
+  return Object::null();
+}
+
+// The following natives back the per-type element accessors in ffi_patch.dart,
+// which the optimizing compiler builds as raw loads and stores instead (see
+// FlowGraphBuilder::BuildFfiLoad). They are only called on DBC.
+
+static uint8_t* ElementAddress(Zone* zone,
+                               const Pointer& pointer,
+                               const AbstractType& pointer_type_arg,
+                               const Integer& index) {
+  const intptr_t address =
+      Integer::Handle(zone, pointer.GetCMemoryAddress()).AsInt64Value() +
+      index.AsInt64Value() *
+          compiler::ffi::ElementSizeInBytes(pointer_type_arg.type_class_id());
+  return reinterpret_cast<uint8_t*>(address);
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_loadElement, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, index, arguments->NativeArgAt(1));
+  const AbstractType& pointer_type_arg =
+      AbstractType::Handle(zone, pointer.type_argument());
+  ASSERT(!IsPointerType(pointer_type_arg));
+  return LoadValue(
+      zone, ElementAddress(zone, pointer, pointer_type_arg, index),
+      pointer_type_arg);
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_storeElement, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, index, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, new_value, arguments->NativeArgAt(2));
+  const AbstractType& pointer_type_arg =
+      AbstractType::Handle(zone, pointer.type_argument());
+  ASSERT(!IsPointerType(pointer_type_arg));
+  StoreValue(zone, ElementAddress(zone, pointer, pointer_type_arg, index),
+             pointer_type_arg, new_value);
   return Object::null();
 }
 
@@ -475,7 +527,8 @@ DEFINE_NATIVE_ENTRY(Ffi_sizeOf, 1, 0) {
 // TODO(dacoharkes): Cache the trampolines.
 // We can possibly address simultaniously with 'precaching' in AOT.
 static RawFunction* TrampolineFunction(const Function& dart_signature,
-                                       const Function& c_signature) {
+                                       const Function& c_signature,
+                                       bool is_leaf) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
   String& name =
@@ -509,12 +562,14 @@ static RawFunction* TrampolineFunction(const Function& dart_signature,
   }
   function.set_parameter_names(parameter_names);
   function.SetFfiCSignature(c_signature);
+  function.SetFfiIsLeaf(is_leaf);
 
   return function.raw();
 }
 
-DEFINE_NATIVE_ENTRY(Ffi_asFunction, 1, 1) {
+DEFINE_NATIVE_ENTRY(Ffi_asFunction, 1, 2) {
   GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(0));
+  GET_NATIVE_ARGUMENT(Bool, is_leaf, arguments->NativeArgAt(1));
   AbstractType& pointer_type_arg =
       AbstractType::Handle(pointer.type_argument());
   ASSERT(IsNativeFunction(pointer_type_arg));
@@ -528,8 +583,17 @@ DEFINE_NATIVE_ENTRY(Ffi_asFunction, 1, 1) {
       AbstractType::Handle(nativefunction_type_args.TypeAt(0));
   Function& c_signature =
       Function::Handle(Type::Cast(nativefunction_type_arg).signature());
-  Function& function =
-      Function::Handle(TrampolineFunction(dart_signature, c_signature));
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_DBC)
+  // The trampoline passes and returns structs by value the way the native ABI
+  // does, which it may not allow for some of them.
+  const char* error = nullptr;
+  if (compiler::ffi::NativeCallLayout::New(zone, c_signature, &error) ==
+      nullptr) {
+    ThrowUnsupportedError(error);
+  }
+#endif
+  Function& function = Function::Handle(TrampolineFunction(
+      dart_signature, c_signature, !is_leaf.IsNull() && is_leaf.value()));
 
   // Set the c function pointer in the context of the closure rather than in
   // the function so that we can reuse the function for each c function with
@@ -544,52 +608,249 @@ DEFINE_NATIVE_ENTRY(Ffi_asFunction, 1, 1) {
   return raw_closure;
 }
 
-// Generates assembly to trampoline from C++ back into Dart.
-static void* GenerateFfiInverseTrampoline(const Function& signature,
-                                          void* dart_entry_point) {
-#if defined(DART_PRECOMPILED_RUNTIME) || defined(DART_PRECOMPILER)
-  UNREACHABLE();
-#elif !defined(TARGET_ARCH_X64)
-  // https://github.com/dart-lang/sdk/issues/35774
-  UNREACHABLE();
-#elif !defined(TARGET_OS_LINUX) && !defined(TARGET_OS_MACOS) &&                \
-    !defined(TARGET_OS_WINDOWS)
-  // https://github.com/dart-lang/sdk/issues/35760 Arm32 && Android
-  // https://github.com/dart-lang/sdk/issues/35772 Arm64
-  // https://github.com/dart-lang/sdk/issues/35773 DBC
-  UNREACHABLE();
-#else
-
-  // TODO(dacoharkes): Implement this.
-  // https://github.com/dart-lang/sdk/issues/35761
-  // Look at StubCode::GenerateInvokeDartCodeStub.
-  UNREACHABLE();
+// Native callbacks are implemented by a trampoline per callback, which spills
+// the native arguments into a buffer of word-sized slots on its stack and
+// calls FfiCallbackDispatch. That boxes the arguments, invokes the Dart
+// function and unboxes its result into the first slot, from where the
+// trampoline returns it. Callbacks may only be invoked while the isolate's
+// thread is in a call into C, so the Dart function runs on top of the Dart
+// frames that made that call, just like in Dart_Invoke from a native
+// extension.
+#if defined(TARGET_ARCH_X64) && !defined(DART_PRECOMPILED_RUNTIME) &&         \
+    !defined(DART_PRECOMPILER)
+#define SUPPORTS_FFI_CALLBACKS 1
 #endif
+
+// The layout of the entries of ObjectStore::ffi_callbacks(). Callbacks are
+// cached per target function, native signature and exceptional return value,
+// and live as long as their isolate since C code may hold on to the pointers.
+enum FfiCallbackEntry {
+  kCallbackTarget,
+  kCallbackSignature,
+  kCallbackExceptionalReturn,
+  kCallbackPointer,
+  kCallbackCode,
+  kCallbackEntrySize,
+};
+
+// Whether a Dart value can be passed to C as the native type 'type'.
+static bool IsValidNativeValue(const AbstractType& type,
+                               const Instance& value) {
+  switch (type.type_class_id()) {
+    case kFfiInt8Cid:
+    case kFfiInt16Cid:
+    case kFfiInt32Cid:
+    case kFfiInt64Cid:
+    case kFfiUint8Cid:
+    case kFfiUint16Cid:
+    case kFfiUint32Cid:
+    case kFfiUint64Cid:
+    case kFfiIntPtrCid:
+      return value.IsInteger();
+    case kFfiFloatCid:
+    case kFfiDoubleCid:
+      return value.IsDouble();
+    case kFfiVoidCid:
+      return true;
+    case kFfiByValueCid:
+      return false;
+    default:
+      ASSERT(IsPointerType(type));
+      return value.IsNull() || value.IsPointer();
+  }
 }
 
-// TODO(dacoharkes): Implement this feature.
-// https://github.com/dart-lang/sdk/issues/35761
-// For now, it always returns Pointer with address 0.
-DEFINE_NATIVE_ENTRY(Ffi_fromFunction, 1, 1) {
-  GET_NATIVE_TYPE_ARGUMENT(type_arg, arguments->NativeTypeArgAt(0));
-  GET_NON_NULL_NATIVE_ARGUMENT(Closure, closure, arguments->NativeArgAt(0));
+#if defined(SUPPORTS_FFI_CALLBACKS)
 
-  Function& c_signature = Function::Handle(((Type&)type_arg).signature());
+// Called by the callback trampolines with the arguments of the native call in
+// 'values', one per slot. Stores the result in the first slot.
+static void FfiCallbackDispatch(Isolate* isolate,
+                                intptr_t callback_id,
+                                uint64_t* values) {
+  Thread* thread = Thread::Current();
+  if ((thread == nullptr) || (thread->isolate() != isolate) ||
+      (thread->execution_state() != Thread::kThreadInNative)) {
+    FATAL(
+        "An FFI callback was invoked outside of a call into C made by the "
+        "isolate which created it.");
+  }
+  TransitionNativeToVM transition(thread);
+  StackZone stack_zone(thread);
+  HANDLESCOPE(thread);
+  Zone* zone = thread->zone();
+
+  const GrowableObjectArray& callbacks = GrowableObjectArray::Handle(
+      zone, isolate->object_store()->ffi_callbacks());
+  const Array& entry =
+      Array::Handle(zone, Array::RawCast(callbacks.At(callback_id)));
+  const Function& target =
+      Function::CheckedHandle(zone, entry.At(kCallbackTarget));
+  const Function& c_signature =
+      Function::CheckedHandle(zone, entry.At(kCallbackSignature));
+
+  // The first parameter of the signature is the closure.
+  const intptr_t num_arguments = c_signature.num_fixed_parameters() - 1;
+  const Array& arguments = Array::Handle(zone, Array::New(num_arguments));
+  AbstractType& type = AbstractType::Handle(zone);
+  Instance& value = Instance::Handle(zone);
+  for (intptr_t i = 0; i < num_arguments; i++) {
+    type = c_signature.ParameterTypeAt(i + 1);
+    value = LoadValue(zone, reinterpret_cast<uint8_t*>(&values[i]), type);
+    arguments.SetAt(i, value);
+  }
+
+  // Exceptions cannot be propagated through the C frames, so they and
+  // results which cannot be passed to C are replaced by the exceptional
+  // return value.
+  const Object& result =
+      Object::Handle(zone, DartEntry::InvokeFunction(target, arguments));
+  type = c_signature.result_type();
+  if (type.type_class_id() == kFfiVoidCid) {
+    return;
+  }
+  if (result.IsInstance() &&
+      IsValidNativeValue(type, Instance::Cast(result))) {
+    value ^= result.raw();
+  } else {
+    value ^= entry.At(kCallbackExceptionalReturn);
+  }
+  values[0] = 0;
+  if (!value.IsNull() || IsPointerType(type)) {
+    StoreValue(zone, reinterpret_cast<uint8_t*>(&values[0]), type, value);
+  }
+}
+
+#define __ assembler->
+
+// Generates the trampoline C calls for the callback with the given id.
+static void GenerateFfiCallbackTrampoline(compiler::Assembler* assembler,
+                                          const Function& c_signature,
+                                          Isolate* isolate,
+                                          intptr_t callback_id) {
+  const ZoneGrowableArray<Representation>& arg_reps =
+      *compiler::ffi::ArgumentRepresentations(c_signature);
+  const ZoneGrowableArray<Location>& arg_locs =
+      *compiler::ffi::ArgumentLocations(arg_reps);
+  const intptr_t num_slots = Utils::Maximum<intptr_t>(arg_reps.length(), 1);
+
+  __ EnterFrame(0);
+  __ ReserveAlignedFrameSpace(num_slots * kWordSize);
+
+  // Stack arguments are above the return address, the saved frame pointer
+  // and the shadow space.
+  const intptr_t stack_arguments_offset =
+      2 * kWordSize + CallingConventions::kShadowSpaceBytes;
+  for (intptr_t i = 0; i < arg_reps.length(); i++) {
+    const compiler::Address slot(RSP, i * kWordSize);
+    const Location location = arg_locs[i];
+    if (location.IsRegister()) {
+      __ movq(slot, location.reg());
+    } else if (location.IsFpuRegister()) {
+      if (arg_reps[i] == kUnboxedFloat) {
+        __ movss(slot, location.fpu_reg());
+      } else {
+        __ movsd(slot, location.fpu_reg());
+      }
+    } else {
+      ASSERT(location.IsStackSlot());
+      __ movq(RAX, compiler::Address(RBP, stack_arguments_offset +
+                                              location.stack_index() *
+                                                  kWordSize));
+      __ movq(slot, RAX);
+    }
+  }
+
+  __ movq(CallingConventions::kArg1Reg,
+          compiler::Immediate(reinterpret_cast<int64_t>(isolate)));
+  __ movq(CallingConventions::kArg2Reg, compiler::Immediate(callback_id));
+  __ movq(CallingConventions::kArg3Reg, RSP);
+  __ movq(RAX, compiler::Immediate(
+                   reinterpret_cast<int64_t>(&FfiCallbackDispatch)));
+  __ CallCFunction(RAX);
+  if (CallingConventions::kShadowSpaceBytes != 0) {
+    __ addq(RSP, compiler::Immediate(CallingConventions::kShadowSpaceBytes));
+  }
+
+  // Small integers are returned extended to a full register, which C
+  // compilers rely on in practice.
+  const compiler::Address result(RSP, 0);
+  switch (AbstractType::Handle(c_signature.result_type()).type_class_id()) {
+    case kFfiVoidCid:
+      break;
+    case kFfiInt8Cid:
+      __ movsxb(RAX, result);
+      break;
+    case kFfiUint8Cid:
+      __ movzxb(RAX, result);
+      break;
+    case kFfiInt16Cid:
+      __ movsxw(RAX, result);
+      break;
+    case kFfiUint16Cid:
+      __ movzxw(RAX, result);
+      break;
+    case kFfiInt32Cid:
+      __ movsxd(RAX, result);
+      break;
+    case kFfiUint32Cid:
+      __ movl(RAX, result);
+      break;
+    case kFfiFloatCid:
+      __ movss(XMM0, result);
+      break;
+    case kFfiDoubleCid:
+      __ movsd(XMM0, result);
+      break;
+    default:  // 64-bit integers and pointers.
+      __ movq(RAX, result);
+      break;
+  }
+  __ LeaveFrame();
+  __ ret();
+}
 
-  Function& func = Function::Handle(closure.function());
-  Code& code = Code::Handle(func.EnsureHasCode());
-  void* entryPoint = reinterpret_cast<void*>(code.EntryPoint());
+#undef __
 
-  THR_Print("Ffi_fromFunction: %s\n", type_arg.ToCString());
-  THR_Print("Ffi_fromFunction: %s\n", c_signature.ToCString());
-  THR_Print("Ffi_fromFunction: %s\n", closure.ToCString());
-  THR_Print("Ffi_fromFunction: %s\n", func.ToCString());
-  THR_Print("Ffi_fromFunction: %s\n", code.ToCString());
-  THR_Print("Ffi_fromFunction: %p\n", entryPoint);
-  THR_Print("Ffi_fromFunction: %" Pd "\n", code.Size());
+#endif  // defined(SUPPORTS_FFI_CALLBACKS)
 
-  intptr_t address = reinterpret_cast<intptr_t>(
-      GenerateFfiInverseTrampoline(c_signature, entryPoint));
+DEFINE_NATIVE_ENTRY(Ffi_fromFunction, 1, 2) {
+  GET_NATIVE_TYPE_ARGUMENT(type_arg, arguments->NativeTypeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Closure, closure, arguments->NativeArgAt(0));
+  GET_NATIVE_ARGUMENT(Instance, exceptional_return, arguments->NativeArgAt(1));
+
+#if !defined(SUPPORTS_FFI_CALLBACKS)
+  ThrowUnsupportedError("FFI callbacks are not supported on this platform.");
+  return Object::null();
+#else
+  const Function& c_signature =
+      Function::Handle(zone, Type::Cast(type_arg).signature());
+  AbstractType& type = AbstractType::Handle(zone, c_signature.result_type());
+  bool has_struct = compiler::ffi::NativeTypeIsStruct(type);
+  for (intptr_t i = 0; i < c_signature.num_fixed_parameters(); i++) {
+    type = c_signature.ParameterTypeAt(i);
+    has_struct = has_struct || compiler::ffi::NativeTypeIsStruct(type);
+  }
+  if (has_struct) {
+    ThrowUnsupportedError(
+        "FFI callbacks cannot pass or return structs by value.");
+  }
+  // The kernel transformation ensures that the closure is a tear-off of a
+  // static function, which can be invoked without the closure.
+  const Function& closure_function =
+      Function::Handle(zone, closure.function());
+  ASSERT(closure_function.IsImplicitStaticClosureFunction());
+  const Function& target =
+      Function::Handle(zone, closure_function.parent_function());
+
+  const AbstractType& result_type =
+      AbstractType::Handle(zone, c_signature.result_type());
+  if (!IsValidNativeValue(result_type, exceptional_return)) {
+    const String& error = String::Handle(String::NewFormatted(
+        "Exceptional return value %s does not match return type %s",
+        exceptional_return.ToCString(),
+        String::Handle(zone, result_type.UserVisibleName()).ToCString()));
+    Exceptions::ThrowArgumentError(error);
+  }
 
   TypeArguments& type_args = TypeArguments::Handle(zone);
   type_args = TypeArguments::New(1);
@@ -597,21 +858,60 @@ DEFINE_NATIVE_ENTRY(Ffi_fromFunction, 1, 1) {
   type_args ^= type_args.Canonicalize();
 
   Class& native_function_class = Class::Handle(
-      Isolate::Current()->class_table()->At(kFfiNativeFunctionCid));
-  native_function_class.EnsureIsFinalized(Thread::Current());
+      zone, isolate->class_table()->At(kFfiNativeFunctionCid));
+  native_function_class.EnsureIsFinalized(thread);
 
   Type& native_function_type = Type::Handle(
+      zone,
       Type::New(native_function_class, type_args, TokenPosition::kNoSource));
   native_function_type ^=
-      ClassFinalizer::FinalizeType(Class::Handle(), native_function_type);
+      ClassFinalizer::FinalizeType(Class::Handle(zone), native_function_type);
   native_function_type ^= native_function_type.Canonicalize();
 
-  address = 0;  // https://github.com/dart-lang/sdk/issues/35761
-
-  Pointer& result = Pointer::Handle(Pointer::New(
-      native_function_type, Integer::Handle(zone, Integer::New(address))));
+  ObjectStore* object_store = isolate->object_store();
+  if (object_store->ffi_callbacks() == GrowableObjectArray::null()) {
+    object_store->set_ffi_callbacks(
+        GrowableObjectArray::Handle(zone, GrowableObjectArray::New()));
+  }
+  const GrowableObjectArray& callbacks =
+      GrowableObjectArray::Handle(zone, object_store->ffi_callbacks());
+  Array& entry = Array::Handle(zone);
+  Pointer& cached_pointer = Pointer::Handle(zone);
+  Instance& cached_return = Instance::Handle(zone);
+  for (intptr_t i = 0; i < callbacks.Length(); i++) {
+    entry ^= callbacks.At(i);
+    cached_pointer ^= entry.At(kCallbackPointer);
+    cached_return ^= entry.At(kCallbackExceptionalReturn);
+    if ((entry.At(kCallbackTarget) == target.raw()) &&
+        (cached_pointer.type_argument() == native_function_type.raw()) &&
+        ((cached_return.raw() == exceptional_return.raw()) ||
+         cached_return.CanonicalizeEquals(exceptional_return))) {
+      return cached_pointer.raw();
+    }
+  }
 
+  const intptr_t callback_id = callbacks.Length();
+  compiler::Assembler assembler(/*object_pool_builder=*/nullptr);
+  GenerateFfiCallbackTrampoline(&assembler, c_signature, isolate, callback_id);
+  const Code& code = Code::Handle(
+      zone, Code::FinalizeCodeAndNotify("FfiCallbackTrampoline", nullptr,
+                                        &assembler,
+                                        Code::PoolAttachment::kNotAttachPool));
+
+  const Pointer& result = Pointer::Handle(
+      zone,
+      Pointer::New(native_function_type,
+                   Integer::Handle(zone, Integer::New(code.EntryPoint()))));
+
+  entry = Array::New(kCallbackEntrySize, Heap::kOld);
+  entry.SetAt(kCallbackTarget, target);
+  entry.SetAt(kCallbackSignature, c_signature);
+  entry.SetAt(kCallbackExceptionalReturn, exceptional_return);
+  entry.SetAt(kCallbackPointer, result);
+  entry.SetAt(kCallbackCode, code);
+  callbacks.Add(entry, Heap::kOld);
   return result.raw();
+#endif  // !defined(SUPPORTS_FFI_CALLBACKS)
 }
 
 }  // namespace dart
@@ -15,7 +15,8 @@ int sizeOf<T extends NativeType>() native "Ffi_sizeOf";
 
 @patch
 Pointer<NativeFunction<T>> fromFunction<T extends Function>(
-    @DartRepresentationOf("T") Function f) native "Ffi_fromFunction";
+    @DartRepresentationOf("T") Function f,
+    [Object exceptionalReturn]) native "Ffi_fromFunction";
 
 @patch
 @pragma("vm:entry-point")
@@ -48,8 +49,75 @@ class Pointer<T extends NativeType> {
   U cast<U extends Pointer>() native "Ffi_cast";
 
   @patch
-  R asFunction<R extends Function>() native "Ffi_asFunction";
+  R asFunction<R extends Function>({bool isLeaf: false})
+      native "Ffi_asFunction";
 
   @patch
   void free() native "Ffi_free";
 }
+
+// Allocates the memory that a struct returned by value from a C function is
+// copied into. Called by the FFI trampolines, which wrap the address in an
+// instance of the struct class.
+int _allocateStructResult(int size) => allocate<Uint8>(count: size).address;
+
+// Loads and stores of the element at [index] of a pointer to a primitive
+// native type. The FFI kernel transformation rewrites [Pointer.load] and
+// [Pointer.store] calls into these when the native type is known statically,
+// and the optimizing compiler builds them as raw memory accesses.
+
+int _loadInt8(Pointer<Int8> pointer, int index) native "Ffi_loadElement";
+
+int _loadInt16(Pointer<Int16> pointer, int index) native "Ffi_loadElement";
+
+int _loadInt32(Pointer<Int32> pointer, int index) native "Ffi_loadElement";
+
+int _loadInt64(Pointer<Int64> pointer, int index) native "Ffi_loadElement";
+
+int _loadUint8(Pointer<Uint8> pointer, int index) native "Ffi_loadElement";
+
+int _loadUint16(Pointer<Uint16> pointer, int index) native "Ffi_loadElement";
+
+int _loadUint32(Pointer<Uint32> pointer, int index) native "Ffi_loadElement";
+
+int _loadUint64(Pointer<Uint64> pointer, int index) native "Ffi_loadElement";
+
+int _loadIntPtr(Pointer<IntPtr> pointer, int index) native "Ffi_loadElement";
+
+double _loadFloat(Pointer<Float> pointer, int index) native "Ffi_loadElement";
+
+double _loadDouble(Pointer<Double> pointer, int index)
+    native "Ffi_loadElement";
+
+void _storeInt8(Pointer<Int8> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeInt16(Pointer<Int16> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeInt32(Pointer<Int32> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeInt64(Pointer<Int64> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeUint8(Pointer<Uint8> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeUint16(Pointer<Uint16> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeUint32(Pointer<Uint32> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeUint64(Pointer<Uint64> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeIntPtr(Pointer<IntPtr> pointer, int index, int value)
+    native "Ffi_storeElement";
+
+void _storeFloat(Pointer<Float> pointer, int index, double value)
+    native "Ffi_storeElement";
+
+void _storeDouble(Pointer<Double> pointer, int index, double value)
+    native "Ffi_storeElement";
@@ -62,6 +62,12 @@ DEFINE_NATIVE_ENTRY(GrowableList_getCapacity, 0, 1) {
   return Smi::New(array.Capacity());
 }
 
+DEFINE_NATIVE_ENTRY(GrowableList_getData, 0, 1) {
+  const GrowableObjectArray& array =
+      GrowableObjectArray::CheckedHandle(zone, arguments->NativeArgAt(0));
+  return array.data();
+}
+
 DEFINE_NATIVE_ENTRY(GrowableList_setLength, 0, 2) {
   const GrowableObjectArray& array =
       GrowableObjectArray::CheckedHandle(zone, arguments->NativeArgAt(0));
@@ -90,6 +90,17 @@ class _GrowableList<T> extends ListBase<T> {
     return result;
   }
 
+  void sort([int compare(T a, T b)]) {
+    if (compare == null &&
+        this.length >= _nativeSortThreshold &&
+        _sortNative(this.length)) {
+      return;
+    }
+    super.sort(compare);
+  }
+
+  bool _sortNative(int length) native "List_sort";
+
   factory _GrowableList(int length) {
     var data = _allocateData(length);
     var result = new _GrowableList<T>.withData(data);
@@ -110,6 +121,10 @@ class _GrowableList<T> extends ListBase<T> {
   @pragma("vm:exact-result-type", "dart:core#_Smi")
   int get _capacity native "GrowableList_getCapacity";
 
+  // The backing store, which is only guaranteed to be a _List if the
+  // capacity is not zero.
+  _List get _data native "GrowableList_getData";
+
   @pragma("vm:exact-result-type", "dart:core#_Smi")
   int get length native "GrowableList_getLength";
 
@@ -181,10 +196,9 @@ class _GrowableList<T> extends ListBase<T> {
         if (identical(iterable, this)) {
           throw new ConcurrentModificationError(this);
         }
-        this._setLength(newLen);
-        final ListBase<T> iterableAsList = iterable;
-        for (int i = 0; i < iterLen; i++) {
-          this[len++] = iterableAsList[i];
+        if (iterLen > 0) {
+          this._setLength(newLen);
+          _data._copyFromObjectArray(iterable, 0, len, iterLen);
         }
         return;
       }
@@ -247,14 +261,12 @@ class _GrowableList<T> extends ListBase<T> {
     var newData = _allocateData(new_capacity);
     // This is a work-around for dartbug.com/30090: array-bound-check
     // generalization causes excessive deoptimizations because it
-    // hoists CheckArrayBound(i, ...) out of the loop below and turns it
+    // hoists CheckArrayBound(i, ...) out of the copying loop and turns it
     // into CheckArrayBound(length - 1, ...). Which deoptimizes
     // if length == 0. However the loop itself does not execute
     // if length == 0.
     if (length > 0) {
-      for (int i = 0; i < length; i++) {
-        newData[i] = this[i];
-      }
+      newData._copyFromObjectArray(this, 0, 0, length);
     }
     _setData(newData);
   }
@@ -263,9 +275,7 @@ class _GrowableList<T> extends ListBase<T> {
     var newData = _allocateData(new_capacity);
     // This is a work-around for dartbug.com/30090. See the comment in _grow.
     if (new_length > 0) {
-      for (int i = 0; i < new_length; i++) {
-        newData[i] = this[i];
-      }
+      newData._copyFromObjectArray(this, 0, 0, new_length);
     }
     _setData(newData);
   }
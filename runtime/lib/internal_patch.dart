@@ -28,6 +28,10 @@ List<T> makeFixedListUnmodifiable<T>(List<T> fixedLengthList)
 Object extractTypeArguments<T>(T instance, Function extract)
     native "Internal_extractTypeArguments";
 
+@patch
+bool equalsIgnoreAsciiCase(String a, String b)
+    native "String_equalsIgnoreAsciiCase";
+
 class VMLibraryHooks {
   // Example: "dart:isolate _Timer._factory"
   static var timerFactory;
@@ -118,6 +122,12 @@ Int32List _growRegExpStack(Int32List stack) {
   return newStack;
 }
 
+// Called by IRRegExpMacroAssembler::SkipUntilLiteral. Returns the index of
+// the first occurrence of [literal] in [subject] at or after [start], or the
+// length of [subject] if there is none.
+int _findRegExpLiteral(String subject, String literal, int start)
+    native "RegExp_findLiteral";
+
 // This function can be used to skip implicit or explicit checked down casts in
 // the parts of the core library implementation where we know by construction the
 // type of a value.
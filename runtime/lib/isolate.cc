@@ -19,12 +19,26 @@
 #include "vm/object_store.h"
 #include "vm/port.h"
 #include "vm/resolver.h"
+#include "vm/ring_buffer_channel.h"
 #include "vm/service.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            share_program_on_spawn,
+            false,
+            "Create the isolates started with Isolate.spawn from a snapshot of "
+            "the spawning isolate's program and JIT code, shared by all "
+            "isolates spawned from that program.");
+DEFINE_FLAG(int,
+            share_program_refresh_threshold,
+            0,
+            "With --share_program_on_spawn, write a new snapshot for the next "
+            "Isolate.spawn once the spawning isolate has optimized this many "
+            "more functions. 0 keeps the first snapshot.");
+
 DEFINE_NATIVE_ENTRY(CapabilityImpl_factory, 0, 1) {
   ASSERT(
       TypeArguments::CheckedHandle(zone, arguments->NativeArgAt(0)).IsNull());
@@ -47,6 +61,203 @@ DEFINE_NATIVE_ENTRY(CapabilityImpl_get_hashcode, 0, 1) {
   return Smi::New(hash);
 }
 
+// Returns the address of the first byte of |instance|, which must be a
+// TypedData, ExternalTypedData or a view over either of them. The result is
+// only valid until the next safepoint.
+static uint8_t* TypedDataBytes(const Instance& instance) {
+  const intptr_t cid = instance.GetClassId();
+  if (RawObject::IsTypedDataClassId(cid)) {
+    return reinterpret_cast<uint8_t*>(TypedData::Cast(instance).DataAddr(0));
+  }
+  if (RawObject::IsExternalTypedDataClassId(cid)) {
+    return reinterpret_cast<uint8_t*>(
+        ExternalTypedData::Cast(instance).DataAddr(0));
+  }
+  ASSERT(RawObject::IsTypedDataViewClassId(cid));
+  const TypedDataView& view = TypedDataView::Cast(instance);
+  const Instance& backing = Instance::Handle(TypedDataView::Data(view));
+  const intptr_t offset = Smi::Value(TypedDataView::OffsetInBytes(view));
+  return TypedDataBytes(backing) + offset;
+}
+
+static bool IsTypedDataInstance(const Object& obj) {
+  const intptr_t cid = obj.GetClassId();
+  return RawObject::IsTypedDataClassId(cid) ||
+         RawObject::IsExternalTypedDataClassId(cid) ||
+         RawObject::IsTypedDataViewClassId(cid);
+}
+
+DEFINE_NATIVE_ENTRY(TransferableTypedData_factory, 0, 2) {
+  ASSERT(
+      TypeArguments::CheckedHandle(zone, arguments->NativeArgAt(0)).IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, list, arguments->NativeArgAt(1));
+
+  Array& array = Array::Handle(zone);
+  intptr_t array_length = 0;
+  if (list.IsGrowableObjectArray()) {
+    const GrowableObjectArray& growable = GrowableObjectArray::Cast(list);
+    array = growable.data();
+    array_length = growable.Length();
+  } else if (list.IsArray()) {
+    array ^= list.raw();
+    array_length = array.Length();
+  } else {
+    Exceptions::ThrowArgumentError(list);
+  }
+
+  Instance& element = Instance::Handle(zone);
+  intptr_t total_bytes = 0;
+  const intptr_t max_bytes = TypedData::MaxElements(kTypedDataUint8ArrayCid);
+  for (intptr_t i = 0; i < array_length; i++) {
+    element ^= array.At(i);
+    if (!IsTypedDataInstance(element)) {
+      Exceptions::ThrowArgumentError(element);
+    }
+    total_bytes += TypedDataBase::Cast(element).LengthInBytes();
+    if (total_bytes > max_bytes) {
+      const Instance& exception =
+          Instance::Handle(zone, isolate->object_store()->out_of_memory());
+      Exceptions::Throw(thread, exception);
+    }
+  }
+
+  uint8_t* data = reinterpret_cast<uint8_t*>(malloc(total_bytes));
+  if (data == NULL) {
+    const Instance& exception =
+        Instance::Handle(zone, isolate->object_store()->out_of_memory());
+    Exceptions::Throw(thread, exception);
+  }
+  {
+    NoSafepointScope no_safepoint;
+    intptr_t offset = 0;
+    for (intptr_t i = 0; i < array_length; i++) {
+      element ^= array.At(i);
+      const intptr_t length_in_bytes =
+          TypedDataBase::Cast(element).LengthInBytes();
+      memmove(data + offset, TypedDataBytes(element), length_in_bytes);
+      offset += length_in_bytes;
+    }
+  }
+  return TransferableTypedData::New(data, total_bytes);
+}
+
+static void ExternalTypedDataFinalizer(void* isolate_callback_data,
+                                       Dart_WeakPersistentHandle handle,
+                                       void* peer) {
+  free(peer);
+}
+
+DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TransferableTypedData, t,
+                               arguments->NativeArgAt(0));
+  TransferableTypedDataPeer* peer = t.peer();
+  uint8_t* data = peer->data();
+  if (data == NULL) {
+    const auto& error = String::Handle(
+        zone, String::New("Attempt to materialize object that was "
+                          "transferred already."));
+    Exceptions::ThrowArgumentError(error);
+    UNREACHABLE();
+  }
+  const intptr_t length = peer->length();
+  peer->ClearData(isolate);
+
+  const ExternalTypedData& typed_data = ExternalTypedData::Handle(
+      zone, ExternalTypedData::New(kExternalTypedDataUint8ArrayCid, data,
+                                   length, Heap::kNew));
+  typed_data.AddFinalizer(data, &ExternalTypedDataFinalizer, length);
+  return typed_data.raw();
+}
+
+static void RingBufferChannelFinalizer(void* isolate_callback_data,
+                                       Dart_WeakPersistentHandle handle,
+                                       void* peer) {
+  reinterpret_cast<RingBufferChannel*>(peer)->Release();
+}
+
+// Wraps the ring of |channel| in an external Uint8List which owns one
+// reference to the channel.
+static RawExternalTypedData* NewRingBufferChannelData(
+    Zone* zone,
+    RingBufferChannel* channel) {
+  const ExternalTypedData& data = ExternalTypedData::Handle(
+      zone, ExternalTypedData::New(kExternalTypedDataUint8ArrayCid,
+                                   channel->data(), channel->capacity()));
+  data.AddFinalizer(channel, &RingBufferChannelFinalizer,
+                    channel->capacity());
+  return data.raw();
+}
+
+static RingBufferChannel* RingBufferChannelFromData(
+    const ExternalTypedData& data) {
+  return RingBufferChannel::FromData(
+      reinterpret_cast<uint8_t*>(data.DataAddr(0)));
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_create, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, capacity, arguments->NativeArgAt(0));
+  const int64_t value = capacity.AsInt64Value();
+  if ((value <= 0) || (value > RingBufferChannel::kMaxCapacity)) {
+    Exceptions::ThrowRangeError("capacity", capacity, 1,
+                                RingBufferChannel::kMaxCapacity);
+  }
+  RingBufferChannel* channel = RingBufferChannel::New(value);
+  if (channel == NULL) {
+    const Instance& exception =
+        Instance::Handle(zone, isolate->object_store()->out_of_memory());
+    Exceptions::Throw(thread, exception);
+  }
+  return NewRingBufferChannelData(zone, channel);
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_attach, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, id, arguments->NativeArgAt(0));
+  RingBufferChannel* channel = RingBufferChannel::Attach(id.AsInt64Value());
+  if (channel == NULL) {
+    Exceptions::ThrowArgumentError(id);
+  }
+  return NewRingBufferChannelData(zone, channel);
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_getId, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(ExternalTypedData, data,
+                               arguments->NativeArgAt(0));
+  return Integer::New(RingBufferChannelFromData(data)->id());
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_write, 0, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(ExternalTypedData, data,
+                               arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, bytes, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end, arguments->NativeArgAt(3));
+  ASSERT(IsTypedDataInstance(bytes));
+  NoSafepointScope no_safepoint;
+  return Smi::New(RingBufferChannelFromData(data)->Write(
+      TypedDataBytes(bytes) + start.Value(), end.Value() - start.Value()));
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_read, 0, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(ExternalTypedData, data,
+                               arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, target, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end, arguments->NativeArgAt(3));
+  ASSERT(IsTypedDataInstance(target));
+  NoSafepointScope no_safepoint;
+  return Smi::New(RingBufferChannelFromData(data)->Read(
+      TypedDataBytes(target) + start.Value(), end.Value() - start.Value()));
+}
+
+DEFINE_NATIVE_ENTRY(RingBufferChannel_notifyWhenReadable, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(ExternalTypedData, data,
+                               arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(SendPort, port, arguments->NativeArgAt(1));
+  return Bool::Get(RingBufferChannelFromData(data)->NotifyWhenReadable(
+                       port.Id()))
+      .raw();
+}
+
 DEFINE_NATIVE_ENTRY(RawReceivePortImpl_factory, 0, 1) {
   ASSERT(
       TypeArguments::CheckedHandle(zone, arguments->NativeArgAt(0)).IsNull());
@@ -151,6 +362,9 @@ class SpawnIsolateTask : public ThreadPool::Task {
       // to the origin_id of the parent isolate.
       isolate->set_origin_id(state_->origin_id());
     }
+    if (state_->group_source() != NULL) {
+      isolate->set_group_source(state_->group_source());
+    }
     MutexLocker ml(isolate->mutex());
     state_->set_isolate(reinterpret_cast<Isolate*>(isolate));
     isolate->set_spawn_state(state_);
@@ -239,6 +453,27 @@ DEFINE_NATIVE_ENTRY(Isolate_spawnFunction, 0, 11) {
 
       // Since this is a call to Isolate.spawn, copy the parent isolate's code.
       state->isolate_flags()->copy_parent_code = true;
+      if (FLAG_share_program_on_spawn) {
+        // Children spawned on demand long after the first one should not
+        // have to optimize again what this isolate optimized meanwhile.
+        // Children already created keep the old snapshot alive.
+        const bool is_stale =
+            (isolate->group_source() != NULL) &&
+            (FLAG_share_program_refresh_threshold > 0) &&
+            (isolate->optimized_code_installs_since_group_source() >=
+             FLAG_share_program_refresh_threshold);
+        if ((isolate->group_source() == NULL) || is_stale) {
+          IsolateGroupSource* source =
+              IsolateGroupSource::CreateFromCurrentIsolate(thread);
+          if (source != NULL) {
+            isolate->set_group_source(source);
+            source->Release();
+          }
+        }
+        if (isolate->group_source() != NULL) {
+          state->set_group_source(isolate->group_source());
+        }
+      }
 
       ThreadPool::Task* spawn_task = new SpawnIsolateTask(state);
 
@@ -14,6 +14,8 @@ import "dart:async"
 
 import "dart:collection" show HashMap;
 
+import "dart:typed_data" show ByteBuffer, TypedData, Uint8List;
+
 /// These are the additional parts of this patch library:
 // part "timer_impl.dart";
 
@@ -671,3 +673,74 @@ class Isolate {
 
   static String _getCurrentRootUriStr() native "Isolate_getCurrentRootUriStr";
 }
+
+@patch
+class TransferableTypedData {
+  @patch
+  factory TransferableTypedData.fromList(List<TypedData> list) =>
+      new _TransferableTypedDataImpl(list);
+}
+
+@pragma("vm:entry-point")
+class _TransferableTypedDataImpl implements TransferableTypedData {
+  factory _TransferableTypedDataImpl(List<TypedData> list)
+      native "TransferableTypedData_factory";
+
+  ByteBuffer materialize() {
+    return _materializeIntoUint8List().buffer;
+  }
+
+  Uint8List _materializeIntoUint8List()
+      native "TransferableTypedData_materialize";
+}
+
+@patch
+class RingBufferChannel {
+  @patch
+  factory RingBufferChannel(int capacity) =>
+      new _RingBufferChannelImpl(_RingBufferChannelImpl._create(capacity));
+
+  @patch
+  factory RingBufferChannel.attach(int id) =>
+      new _RingBufferChannelImpl(_RingBufferChannelImpl._attach(id));
+}
+
+class _RingBufferChannelImpl implements RingBufferChannel {
+  // An external Uint8List over the shared ring. It also keeps the VM's
+  // reference to the channel alive.
+  final Uint8List _data;
+
+  _RingBufferChannelImpl(this._data);
+
+  int get id => _getId(_data);
+
+  int get capacity => _data.length;
+
+  int write(Uint8List bytes, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, bytes.length);
+    return _write(_data, bytes, start, end);
+  }
+
+  int read(Uint8List target, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, target.length);
+    return _read(_data, target, start, end);
+  }
+
+  bool notifyWhenReadable(SendPort port) =>
+      _notifyWhenReadable(_data, port);
+
+  static Uint8List _create(int capacity) native "RingBufferChannel_create";
+
+  static Uint8List _attach(int id) native "RingBufferChannel_attach";
+
+  static int _getId(Uint8List data) native "RingBufferChannel_getId";
+
+  static int _write(Uint8List data, Uint8List bytes, int start, int end)
+      native "RingBufferChannel_write";
+
+  static int _read(Uint8List data, Uint8List target, int start, int end)
+      native "RingBufferChannel_read";
+
+  static bool _notifyWhenReadable(Uint8List data, SendPort port)
+      native "RingBufferChannel_notifyWhenReadable";
+}
@@ -85,7 +85,8 @@ DEFINE_NATIVE_ENTRY(RegExp_getGroupNameMap, 0, 1) {
   return Object::null();
 }
 
-static RawObject* ExecuteMatch(Zone* zone,
+static RawObject* ExecuteMatch(Thread* thread,
+                               Zone* zone,
                                NativeArguments* arguments,
                                bool sticky) {
   const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
@@ -94,7 +95,8 @@ static RawObject* ExecuteMatch(Zone* zone,
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
+  // The intrinsic only calls the native until the regexp has been compiled.
+  if (!FLAG_interpret_irregexp && RegExpEngine::TierUp(thread, regexp)) {
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
                                            /*sticky=*/sticky, zone);
   }
@@ -105,12 +107,27 @@ static RawObject* ExecuteMatch(Zone* zone,
 
 DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatch, 0, 3) {
   // This function is intrinsified. See Intrinsifier::RegExp_ExecuteMatch.
-  return ExecuteMatch(zone, arguments, /*sticky=*/false);
+  return ExecuteMatch(thread, zone, arguments, /*sticky=*/false);
 }
 
 DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchSticky, 0, 3) {
   // This function is intrinsified. See Intrinsifier::RegExp_ExecuteMatchSticky.
-  return ExecuteMatch(zone, arguments, /*sticky=*/true);
+  return ExecuteMatch(thread, zone, arguments, /*sticky=*/true);
+}
+
+DEFINE_NATIVE_ENTRY(RegExp_findLiteral, 0, 3) {
+  // Called by IRRegExpMacroAssembler::SkipUntilLiteral.
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(String, literal, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(2));
+  const intptr_t length = literal.Length();
+  uint16_t* chars = zone->Alloc<uint16_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    chars[i] = literal.CharAt(i);
+  }
+  const intptr_t index =
+      RegExpEngine::FindLiteral(subject, start.Value(), chars, length);
+  return Smi::New((index < 0) ? subject.Length() : index);
 }
 
 }  // namespace dart
@@ -99,6 +99,19 @@ static RawStackTrace* CurrentStackTrace(
 
 RawStackTrace* GetStackTraceForException() {
   Thread* thread = Thread::Current();
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // Most stack traces of exceptions are never looked at. Unless the trace
+  // needs the function of its frames to find the causal async frames, only
+  // collect the return addresses and look up their code when needed.
+  if (!FLAG_causal_async_stacks ||
+      (thread->async_stack_trace() == StackTrace::null())) {
+    const StackTrace& stack_trace = StackTrace::Handle(
+        thread->zone(), StackTraceUtils::CollectLazyStackTrace(thread, 0));
+    if (!stack_trace.IsNull()) {
+      return stack_trace.raw();
+    }
+  }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
   return CurrentStackTrace(thread, false, 0);
 }
 
@@ -521,6 +521,15 @@ DEFINE_NATIVE_ENTRY(String_concat, 0, 2) {
   const String& receiver =
       String::CheckedHandle(zone, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
+  // Strings are immutable, so concatenating an empty string needs no copy.
+  // Loops which start from "" and interpolations with empty parts hit this
+  // often.
+  if (b.Length() == 0) {
+    return receiver.raw();
+  }
+  if (receiver.Length() == 0) {
+    return b.raw();
+  }
   return String::Concat(receiver, b);
 }
 
@@ -538,6 +547,12 @@ DEFINE_NATIVE_ENTRY(String_toUpperCase, 0, 1) {
   return String::ToUpperCase(receiver);
 }
 
+DEFINE_NATIVE_ENTRY(String_equalsIgnoreAsciiCase, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, a, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
+  return Bool::Get(String::EqualsIgnoreAsciiCase(a, b)).raw();
+}
+
 DEFINE_NATIVE_ENTRY(String_concatRange, 0, 3) {
   GET_NON_NULL_NATIVE_ARGUMENT(Instance, argument, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(1));
@@ -118,13 +118,24 @@ class StringBuffer {
     _partsCodeUnits = _bufferPosition = _bufferCodeUnitMagnitude = 0;
   }
 
-  /** Returns the contents of buffer as a string. */
+  /**
+   * Returns the contents of buffer as a string.
+   *
+   * The parts are only flattened here, and the result replaces them, so
+   * calling toString repeatedly while writing more does not copy the
+   * earlier contents again each time.
+   */
   @patch
   String toString() {
     _consumeBuffer();
-    return (_partsCodeUnits == 0)
-        ? ""
-        : _StringBase._concatRange(_parts, 0, _parts.length);
+    if (_partsCodeUnits == 0) return "";
+    if (_parts.length == 1) return _parts[0];
+    String result = _StringBase._concatRange(_parts, 0, _parts.length);
+    _parts.length = 0;
+    _parts.add(result);
+    _partsCompactionIndex = 1;
+    _partsCodeUnitsSinceCompaction = 0;
+    return result;
   }
 
   /** Ensures that the buffer has enough capacity to add n code units. */
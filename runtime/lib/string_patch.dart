@@ -1017,12 +1017,7 @@ class _OneByteString extends _StringBase {
         if (patternCu0 > 0xFF) {
           return -1;
         }
-        for (int i = start; i < len; i++) {
-          if (this.codeUnitAt(i) == patternCu0) {
-            return i;
-          }
-        }
-        return -1;
+        return _indexOfCodeUnit(patternCu0, start);
       }
     }
     return super.indexOf(pattern, start);
@@ -1040,17 +1035,25 @@ class _OneByteString extends _StringBase {
         if (patternCu0 > 0xFF) {
           return false;
         }
-        for (int i = start; i < len; i++) {
-          if (this.codeUnitAt(i) == patternCu0) {
-            return true;
-          }
-        }
-        return false;
+        return _indexOfCodeUnit(patternCu0, start) >= 0;
       }
     }
     return super.contains(pattern, start);
   }
 
+  // Returns the index of the first occurrence of [codeUnit] at or after
+  // [start], or -1 if there is none. Intrinsified.
+  @pragma("vm:exact-result-type", "dart:core#_Smi")
+  int _indexOfCodeUnit(int codeUnit, int start) {
+    final len = this.length;
+    for (int i = start; i < len; i++) {
+      if (this.codeUnitAt(i) == codeUnit) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
   String operator *(int times) {
     if (times <= 0) return "";
     if (times == 1) return this;
@@ -1128,100 +1131,6 @@ class _OneByteString extends _StringBase {
     return result;
   }
 
-  // Lower-case conversion table for Latin-1 as string.
-  // Upper-case ranges: 0x41-0x5a ('A' - 'Z'), 0xc0-0xd6, 0xd8-0xde.
-  // Conversion to lower case performed by adding 0x20.
-  static const _LC_TABLE =
-      "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
-      "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f"
-      "\x20\x21\x22\x23\x24\x25\x26\x27\x28\x29\x2a\x2b\x2c\x2d\x2e\x2f"
-      "\x30\x31\x32\x33\x34\x35\x36\x37\x38\x39\x3a\x3b\x3c\x3d\x3e\x3f"
-      "\x40\x61\x62\x63\x64\x65\x66\x67\x68\x69\x6a\x6b\x6c\x6d\x6e\x6f"
-      "\x70\x71\x72\x73\x74\x75\x76\x77\x78\x79\x7a\x5b\x5c\x5d\x5e\x5f"
-      "\x60\x61\x62\x63\x64\x65\x66\x67\x68\x69\x6a\x6b\x6c\x6d\x6e\x6f"
-      "\x70\x71\x72\x73\x74\x75\x76\x77\x78\x79\x7a\x7b\x7c\x7d\x7e\x7f"
-      "\x80\x81\x82\x83\x84\x85\x86\x87\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
-      "\x90\x91\x92\x93\x94\x95\x96\x97\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f"
-      "\xa0\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8\xa9\xaa\xab\xac\xad\xae\xaf"
-      "\xb0\xb1\xb2\xb3\xb4\xb5\xb6\xb7\xb8\xb9\xba\xbb\xbc\xbd\xbe\xbf"
-      "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef"
-      "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xd7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xdf"
-      "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef"
-      "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff";
-
-  // Upper-case conversion table for Latin-1 as string.
-  // Lower-case ranges: 0x61-0x7a ('a' - 'z'), 0xe0-0xff.
-  // The characters 0xb5 (µ) and 0xff (ÿ) have upper case variants
-  // that are not Latin-1. These are both marked as 0x00 in the table.
-  // The German "sharp s" \xdf (ß) should be converted into two characters (SS),
-  // and is also marked with 0x00.
-  // Conversion to lower case performed by subtracting 0x20.
-  static const _UC_TABLE =
-      "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
-      "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f"
-      "\x20\x21\x22\x23\x24\x25\x26\x27\x28\x29\x2a\x2b\x2c\x2d\x2e\x2f"
-      "\x30\x31\x32\x33\x34\x35\x36\x37\x38\x39\x3a\x3b\x3c\x3d\x3e\x3f"
-      "\x40\x41\x42\x43\x44\x45\x46\x47\x48\x49\x4a\x4b\x4c\x4d\x4e\x4f"
-      "\x50\x51\x52\x53\x54\x55\x56\x57\x58\x59\x5a\x5b\x5c\x5d\x5e\x5f"
-      "\x60\x41\x42\x43\x44\x45\x46\x47\x48\x49\x4a\x4b\x4c\x4d\x4e\x4f"
-      "\x50\x51\x52\x53\x54\x55\x56\x57\x58\x59\x5a\x7b\x7c\x7d\x7e\x7f"
-      "\x80\x81\x82\x83\x84\x85\x86\x87\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
-      "\x90\x91\x92\x93\x94\x95\x96\x97\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f"
-      "\xa0\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8\xa9\xaa\xab\xac\xad\xae\xaf"
-      "\xb0\xb1\xb2\xb3\xb4\x00\xb6\xb7\xb8\xb9\xba\xbb\xbc\xbd\xbe\xbf"
-      "\xc0\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8\xc9\xca\xcb\xcc\xcd\xce\xcf"
-      "\xd0\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8\xd9\xda\xdb\xdc\xdd\xde\x00"
-      "\xc0\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8\xc9\xca\xcb\xcc\xcd\xce\xcf"
-      "\xd0\xd1\xd2\xd3\xd4\xd5\xd6\xf7\xd8\xd9\xda\xdb\xdc\xdd\xde\x00";
-
-  String toLowerCase() {
-    for (int i = 0; i < this.length; i++) {
-      final c = this.codeUnitAt(i);
-      if (c == _LC_TABLE.codeUnitAt(c)) continue;
-      // Upper-case character found.
-      final result = _allocate(this.length);
-      for (int j = 0; j < i; j++) {
-        result._setAt(j, this.codeUnitAt(j));
-      }
-      for (int j = i; j < this.length; j++) {
-        result._setAt(j, _LC_TABLE.codeUnitAt(this.codeUnitAt(j)));
-      }
-      return result;
-    }
-    return this;
-  }
-
-  String toUpperCase() {
-    for (int i = 0; i < this.length; i++) {
-      final c = this.codeUnitAt(i);
-      // Continue loop if character is unchanged by upper-case conversion.
-      if (c == _UC_TABLE.codeUnitAt(c)) continue;
-
-      // Check rest of string for characters that do not convert to
-      // single-characters in the Latin-1 range.
-      for (int j = i; j < this.length; j++) {
-        final c = this.codeUnitAt(j);
-        if ((_UC_TABLE.codeUnitAt(c) == 0x00) && (c != 0x00)) {
-          // We use the 0x00 value for characters other than the null character,
-          // that don't convert to a single Latin-1 character when upper-cased.
-          // In that case, call the generic super-class method.
-          return super.toUpperCase();
-        }
-      }
-      // Some lower-case characters found, but all upper-case to single Latin-1
-      // characters.
-      final result = _allocate(this.length);
-      for (int j = 0; j < i; j++) {
-        result._setAt(j, this.codeUnitAt(j));
-      }
-      for (int j = i; j < this.length; j++) {
-        result._setAt(j, _UC_TABLE.codeUnitAt(this.codeUnitAt(j)));
-      }
-      return result;
-    }
-    return this;
-  }
-
   // Allocates a string of given length, expecting its content to be
   // set using _setAt.
   @pragma("vm:exact-result-type", _OneByteString)
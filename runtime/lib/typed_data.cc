@@ -6,6 +6,7 @@
 
 #include "include/dart_api.h"
 
+#include "platform/sort.h"
 #include "vm/exceptions.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
@@ -176,6 +177,413 @@ DEFINE_NATIVE_ENTRY(TypedData_setRange, 0, 7) {
   return Bool::False().raw();
 }
 
+// Returns the address of 'length_in_bytes' bytes at 'offset_in_bytes' of a
+// TypedData or ExternalTypedData array. The caller must not allocate while
+// it holds on to the address.
+static uint8_t* TypedDataAddr(const Instance& instance,
+                              intptr_t offset_in_bytes,
+                              intptr_t length_in_bytes) {
+  if (instance.IsTypedData()) {
+    const TypedData& array = TypedData::Cast(instance);
+    ASSERT(Utils::RangeCheck(offset_in_bytes, length_in_bytes,
+                             array.LengthInBytes()));
+    return reinterpret_cast<uint8_t*>(array.DataAddr(offset_in_bytes));
+  }
+  const ExternalTypedData& array = ExternalTypedData::Cast(instance);
+  ASSERT(Utils::RangeCheck(offset_in_bytes, length_in_bytes,
+                           array.LengthInBytes()));
+  return reinterpret_cast<uint8_t*>(array.DataAddr(offset_in_bytes));
+}
+
+static uint8_t ClampToUint8(int64_t value) {
+  return value < 0 ? 0 : (value > 0xFF ? 0xFF : static_cast<uint8_t>(value));
+}
+
+// The loops below are simple enough for the C++ compiler to vectorize.
+template <typename T>
+static void FillElements(uint8_t* data, intptr_t length_in_bytes, T value) {
+  T* elements = reinterpret_cast<T*>(data);
+  const intptr_t length = length_in_bytes / sizeof(T);
+  for (intptr_t i = 0; i < length; i++) {
+    elements[i] = value;
+  }
+}
+
+DEFINE_NATIVE_ENTRY(TypedData_fillRange, 0, 5) {
+  const Instance& dst =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& dst_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& length = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const Instance& value =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(3));
+  const Smi& cid = Smi::CheckedHandle(zone, arguments->NativeArgAt(4));
+
+  const intptr_t length_in_bytes = length.Value();
+  NoSafepointScope no_safepoint;
+  uint8_t* data = TypedDataAddr(dst, dst_start.Value(), length_in_bytes);
+  switch (TypedDataBase::ElementType(cid.Value())) {
+    case kInt8ArrayElement:
+    case kUint8ArrayElement:
+      memset(data, static_cast<uint8_t>(Integer::Cast(value).AsInt64Value()),
+             length_in_bytes);
+      break;
+    case kUint8ClampedArrayElement:
+      memset(data, ClampToUint8(Integer::Cast(value).AsInt64Value()),
+             length_in_bytes);
+      break;
+    case kInt16ArrayElement:
+    case kUint16ArrayElement:
+      FillElements<uint16_t>(
+          data, length_in_bytes,
+          static_cast<uint16_t>(Integer::Cast(value).AsInt64Value()));
+      break;
+    case kInt32ArrayElement:
+    case kUint32ArrayElement:
+      FillElements<uint32_t>(
+          data, length_in_bytes,
+          static_cast<uint32_t>(Integer::Cast(value).AsInt64Value()));
+      break;
+    case kInt64ArrayElement:
+    case kUint64ArrayElement:
+      FillElements<int64_t>(data, length_in_bytes,
+                            Integer::Cast(value).AsInt64Value());
+      break;
+    case kFloat32ArrayElement:
+      FillElements<float>(data, length_in_bytes,
+                          static_cast<float>(Double::Cast(value).value()));
+      break;
+    case kFloat64ArrayElement:
+      FillElements<double>(data, length_in_bytes, Double::Cast(value).value());
+      break;
+    default:
+      UNREACHABLE();
+  }
+  return Object::null();
+}
+
+// Returns the index of the first (or last) element equal to 'value', or -1.
+template <typename T, typename V>
+static intptr_t FindElement(const uint8_t* data,
+                            intptr_t length_in_bytes,
+                            V value,
+                            bool from_end) {
+  const T* elements = reinterpret_cast<const T*>(data);
+  const intptr_t length = length_in_bytes / sizeof(T);
+  if (from_end) {
+    for (intptr_t i = length - 1; i >= 0; i--) {
+      if (elements[i] == value) return i;
+    }
+  } else {
+    for (intptr_t i = 0; i < length; i++) {
+      if (elements[i] == value) return i;
+    }
+  }
+  return -1;
+}
+
+// Like FindElement, but for integer elements, which 'value' might not fit.
+template <typename T>
+static intptr_t FindIntElement(const uint8_t* data,
+                               intptr_t length_in_bytes,
+                               int64_t value,
+                               bool from_end) {
+  const T element = static_cast<T>(value);
+  if (static_cast<int64_t>(element) != value) {
+    return -1;
+  }
+  if ((sizeof(T) == 1) && !from_end) {
+    const void* found = memchr(data, static_cast<uint8_t>(element),
+                               length_in_bytes);
+    return found == NULL ? -1 : static_cast<const uint8_t*>(found) - data;
+  }
+  return FindElement<T, T>(data, length_in_bytes, element, from_end);
+}
+
+DEFINE_NATIVE_ENTRY(TypedData_indexOf, 0, 6) {
+  const Instance& src =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& src_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& length = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const Instance& value =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(3));
+  const Smi& cid = Smi::CheckedHandle(zone, arguments->NativeArgAt(4));
+  const Bool& from_end = Bool::CheckedHandle(zone, arguments->NativeArgAt(5));
+
+  const intptr_t length_in_bytes = length.Value();
+  const bool backwards = from_end.value();
+  intptr_t index = -1;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data =
+        TypedDataAddr(src, src_start.Value(), length_in_bytes);
+    switch (TypedDataBase::ElementType(cid.Value())) {
+      case kInt8ArrayElement:
+        index = FindIntElement<int8_t>(data, length_in_bytes,
+                                       Integer::Cast(value).AsInt64Value(),
+                                       backwards);
+        break;
+      case kUint8ArrayElement:
+      case kUint8ClampedArrayElement:
+        index = FindIntElement<uint8_t>(data, length_in_bytes,
+                                        Integer::Cast(value).AsInt64Value(),
+                                        backwards);
+        break;
+      case kInt16ArrayElement:
+        index = FindIntElement<int16_t>(data, length_in_bytes,
+                                        Integer::Cast(value).AsInt64Value(),
+                                        backwards);
+        break;
+      case kUint16ArrayElement:
+        index = FindIntElement<uint16_t>(data, length_in_bytes,
+                                         Integer::Cast(value).AsInt64Value(),
+                                         backwards);
+        break;
+      case kInt32ArrayElement:
+        index = FindIntElement<int32_t>(data, length_in_bytes,
+                                        Integer::Cast(value).AsInt64Value(),
+                                        backwards);
+        break;
+      case kUint32ArrayElement:
+        index = FindIntElement<uint32_t>(data, length_in_bytes,
+                                         Integer::Cast(value).AsInt64Value(),
+                                         backwards);
+        break;
+      case kInt64ArrayElement:
+      case kUint64ArrayElement:
+        // Uint64List elements read back as signed 64-bit integers.
+        index = FindIntElement<int64_t>(data, length_in_bytes,
+                                        Integer::Cast(value).AsInt64Value(),
+                                        backwards);
+        break;
+      case kFloat32ArrayElement:
+        index = FindElement<float, double>(
+            data, length_in_bytes, Double::Cast(value).value(), backwards);
+        break;
+      case kFloat64ArrayElement:
+        index = FindElement<double, double>(
+            data, length_in_bytes, Double::Cast(value).value(), backwards);
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+  return Smi::New(index);
+}
+
+// Arrays at least this long are radix sorted; shorter ones are not worth the
+// scratch buffer and the counting pass.
+static const intptr_t kRadixSortThreshold = 256;
+
+// Sorts the elements by 'key', which maps them to unsigned integers of the
+// same width ordered the way Comparable.compare orders the elements.
+template <typename T, typename Key>
+static void SortElements(uint8_t* data, intptr_t length_in_bytes, Key key) {
+  T* elements = reinterpret_cast<T*>(data);
+  const intptr_t length = length_in_bytes / sizeof(T);
+  T* scratch = NULL;
+  if (length >= kRadixSortThreshold) {
+    scratch = reinterpret_cast<T*>(malloc(length_in_bytes));
+  }
+  if (scratch != NULL) {
+    Sort::RadixSort(elements, scratch, length, key);
+    free(scratch);
+  } else {
+    Sort::IntroSort(elements, length,
+                    [&key](T a, T b) { return key(a) < key(b); });
+  }
+}
+
+template <typename T>
+static void SortUnsignedElements(uint8_t* data, intptr_t length_in_bytes) {
+  SortElements<T>(data, length_in_bytes, [](T value) { return value; });
+}
+
+// Flipping the sign bit orders two's complement values as unsigned ones.
+template <typename T, typename U>
+static void SortSignedElements(uint8_t* data, intptr_t length_in_bytes) {
+  const U sign_bit = static_cast<U>(1) << (sizeof(U) * kBitsPerByte - 1);
+  SortElements<T>(data, length_in_bytes, [sign_bit](T value) {
+    return static_cast<U>(static_cast<U>(value) ^ sign_bit);
+  });
+}
+
+// Orders the bits of IEEE values by flipping all bits of negative values and
+// the sign bit of positive ones. Like double.compareTo, this puts -0.0 before
+// 0.0 and every NaN, whatever its sign, after infinity.
+template <typename T, typename U>
+static U FloatSortKey(T value) {
+  if (value != value) {
+    return ~static_cast<U>(0);
+  }
+  const U sign_bit = static_cast<U>(1) << (sizeof(U) * kBitsPerByte - 1);
+  const U bits = bit_cast<U, T>(value);
+  return ((bits & sign_bit) != 0) ? ~bits : (bits | sign_bit);
+}
+
+template <typename T, typename U>
+static void SortFloatElements(uint8_t* data, intptr_t length_in_bytes) {
+  SortElements<T>(data, length_in_bytes,
+                  [](T value) { return FloatSortKey<T, U>(value); });
+}
+
+// Sorts the elements of the byte range in place the way Comparable.compare
+// would order them when read back as elements of 'cid'.
+DEFINE_NATIVE_ENTRY(TypedData_sortRange, 0, 4) {
+  const Instance& dst =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& dst_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& length = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const Smi& cid = Smi::CheckedHandle(zone, arguments->NativeArgAt(3));
+
+  const intptr_t length_in_bytes = length.Value();
+  NoSafepointScope no_safepoint;
+  uint8_t* data = TypedDataAddr(dst, dst_start.Value(), length_in_bytes);
+  switch (TypedDataBase::ElementType(cid.Value())) {
+    case kInt8ArrayElement:
+      SortSignedElements<int8_t, uint8_t>(data, length_in_bytes);
+      break;
+    case kUint8ArrayElement:
+    case kUint8ClampedArrayElement:
+      SortUnsignedElements<uint8_t>(data, length_in_bytes);
+      break;
+    case kInt16ArrayElement:
+      SortSignedElements<int16_t, uint16_t>(data, length_in_bytes);
+      break;
+    case kUint16ArrayElement:
+      SortUnsignedElements<uint16_t>(data, length_in_bytes);
+      break;
+    case kInt32ArrayElement:
+      SortSignedElements<int32_t, uint32_t>(data, length_in_bytes);
+      break;
+    case kUint32ArrayElement:
+      SortUnsignedElements<uint32_t>(data, length_in_bytes);
+      break;
+    case kInt64ArrayElement:
+    case kUint64ArrayElement:
+      // Uint64List elements read back as signed 64-bit integers.
+      SortSignedElements<int64_t, uint64_t>(data, length_in_bytes);
+      break;
+    case kFloat32ArrayElement:
+      SortFloatElements<float, uint32_t>(data, length_in_bytes);
+      break;
+    case kFloat64ArrayElement:
+      SortFloatElements<double, uint64_t>(data, length_in_bytes);
+      break;
+    default:
+      UNREACHABLE();
+  }
+  return Object::null();
+}
+
+template <typename DstType, typename SrcType>
+static void ConvertElements(uint8_t* dst, const uint8_t* src, intptr_t count) {
+  DstType* dst_elements = reinterpret_cast<DstType*>(dst);
+  const SrcType* src_elements = reinterpret_cast<const SrcType*>(src);
+  for (intptr_t i = 0; i < count; i++) {
+    dst_elements[i] = static_cast<DstType>(src_elements[i]);
+  }
+}
+
+template <typename SrcType>
+static void ClampElements(uint8_t* dst, const uint8_t* src, intptr_t count) {
+  const SrcType* src_elements = reinterpret_cast<const SrcType*>(src);
+  for (intptr_t i = 0; i < count; i++) {
+    dst[i] = ClampToUint8(src_elements[i]);
+  }
+}
+
+// Integer elements are truncated by storing them as unsigned values of the
+// destination's width. Uint64List elements read back as signed values.
+#define INT_ELEMENT_TYPES(V)                                                   \
+  V(Int8Array, int8_t, uint8_t)                                                \
+  V(Uint8Array, uint8_t, uint8_t)                                              \
+  V(Int16Array, int16_t, uint16_t)                                             \
+  V(Uint16Array, uint16_t, uint16_t)                                           \
+  V(Int32Array, int32_t, uint32_t)                                             \
+  V(Uint32Array, uint32_t, uint32_t)                                           \
+  V(Int64Array, int64_t, uint64_t)                                             \
+  V(Uint64Array, int64_t, uint64_t)
+
+template <typename DstType>
+static void ConvertIntElements(uint8_t* dst,
+                               const uint8_t* src,
+                               TypedDataElementType src_type,
+                               intptr_t count) {
+  switch (src_type) {
+#define CONVERT_FROM(name, src_type, unused)                                   \
+  case k##name##Element:                                                       \
+    ConvertElements<DstType, src_type>(dst, src, count);                       \
+    break;
+    INT_ELEMENT_TYPES(CONVERT_FROM)
+#undef CONVERT_FROM
+    case kUint8ClampedArrayElement:
+      ConvertElements<DstType, uint8_t>(dst, src, count);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+// Copies between arrays of different element sizes, converting the elements
+// the way storing them one at a time from Dart would.
+DEFINE_NATIVE_ENTRY(TypedData_convertRange, 0, 7) {
+  const Instance& dst =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& dst_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& count_smi = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const Instance& src =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(3));
+  const Smi& src_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(4));
+  const Smi& to_cid = Smi::CheckedHandle(zone, arguments->NativeArgAt(5));
+  const Smi& from_cid = Smi::CheckedHandle(zone, arguments->NativeArgAt(6));
+
+  const intptr_t count = count_smi.Value();
+  const TypedDataElementType to_type =
+      TypedDataBase::ElementType(to_cid.Value());
+  const TypedDataElementType from_type =
+      TypedDataBase::ElementType(from_cid.Value());
+  NoSafepointScope no_safepoint;
+  uint8_t* dst_data =
+      TypedDataAddr(dst, dst_start.Value(),
+                    count * TypedDataBase::ElementSizeInBytes(to_cid.Value()));
+  const uint8_t* src_data = TypedDataAddr(
+      src, src_start.Value(),
+      count * TypedDataBase::ElementSizeInBytes(from_cid.Value()));
+  switch (to_type) {
+#define CONVERT_TO(name, unused, dst_type)                                     \
+  case k##name##Element:                                                       \
+    ConvertIntElements<dst_type>(dst_data, src_data, from_type, count);        \
+    break;
+    INT_ELEMENT_TYPES(CONVERT_TO)
+#undef CONVERT_TO
+    case kUint8ClampedArrayElement:
+      switch (from_type) {
+#define CLAMP_FROM(name, src_type, unused)                                     \
+  case k##name##Element:                                                       \
+    ClampElements<src_type>(dst_data, src_data, count);                        \
+    break;
+        INT_ELEMENT_TYPES(CLAMP_FROM)
+#undef CLAMP_FROM
+        default:
+          UNREACHABLE();
+      }
+      break;
+    case kFloat32ArrayElement:
+      ASSERT(from_type == kFloat64ArrayElement);
+      ConvertElements<float, double>(dst_data, src_data, count);
+      break;
+    case kFloat64ArrayElement:
+      ASSERT(from_type == kFloat32ArrayElement);
+      ConvertElements<double, float>(dst_data, src_data, count);
+      break;
+    default:
+      UNREACHABLE();
+  }
+  return Object::null();
+}
+
+#undef INT_ELEMENT_TYPES
+
 // We check the length parameter against a possible maximum length for the
 // array based on available physical addressable memory on the system.
 //
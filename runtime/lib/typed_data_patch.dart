@@ -109,8 +109,34 @@ abstract class _TypedListBase {
   // Element size of toCid and fromCid must match (test at caller).
   bool _setRange(int startInBytes, int lengthInBytes, _TypedListBase from,
       int startFromInBytes, int toCid, int fromCid) native "TypedData_setRange";
+
+  // Stores 'value' into every element of the byte range, converted to the
+  // element type of 'cid'.
+  void _fillRange(int startInBytes, int lengthInBytes, Object value, int cid)
+      native "TypedData_fillRange";
+
+  // Returns the index of the first (or, if 'fromEnd', the last) element of
+  // the byte range that is equal to 'value', or -1.
+  int _indexOf(int startInBytes, int lengthInBytes, Object value, int cid,
+      bool fromEnd) native "TypedData_indexOf";
+
+  // Sorts the elements of the byte range in the order Comparable.compare
+  // gives them as elements of 'cid'.
+  void _sortRange(int startInBytes, int lengthInBytes, int cid)
+      native "TypedData_sortRange";
+
+  // Like _setRange, but for elements of different sizes, converting them
+  // the way storing them one at a time would. 'from' must not share the
+  // buffer of this list.
+  void _convertRange(int startInBytes, int count, _TypedListBase from,
+      int startFromInBytes, int toCid, int fromCid)
+      native "TypedData_convertRange";
 }
 
+// Ranges with fewer elements than this are handled in Dart, where the loop
+// is cheaper than calling into the runtime.
+const int _bulkOperationThreshold = 16;
+
 abstract class _IntListMixin implements List<int> {
   int get elementSizeInBytes;
   int get offsetInBytes;
@@ -225,6 +251,16 @@ abstract class _IntListMixin implements List<int> {
           this[i] = tempBuffer[i - start];
         }
         return;
+      } else if (count >= _bulkOperationThreshold) {
+        this.buffer._data._convertRange(
+            start * elementSizeInBytes + this.offsetInBytes,
+            count,
+            fromAsTypedList.buffer._data,
+            skipCount * fromAsTypedList.elementSizeInBytes +
+                fromAsTypedList.offsetInBytes,
+            ClassID.getID(this),
+            ClassID.getID(from));
+        return;
       }
     }
 
@@ -382,6 +418,13 @@ abstract class _IntListMixin implements List<int> {
   }
 
   void sort([int compare(int a, int b)]) {
+    if (compare == null && this.length >= _bulkOperationThreshold) {
+      this.buffer._data._sortRange(
+          this.offsetInBytes,
+          this.length * elementSizeInBytes,
+          ClassID.getID(this));
+      return;
+    }
     Sort.sort(this, compare ?? Comparable.compare);
   }
 
@@ -391,6 +434,16 @@ abstract class _IntListMixin implements List<int> {
     } else if (start < 0) {
       start = 0;
     }
+    final count = this.length - start;
+    if (count >= _bulkOperationThreshold && element != null) {
+      final index = this.buffer._data._indexOf(
+          start * elementSizeInBytes + this.offsetInBytes,
+          count * elementSizeInBytes,
+          element,
+          ClassID.getID(this),
+          false);
+      return index < 0 ? -1 : start + index;
+    }
     for (int i = start; i < this.length; i++) {
       if (this[i] == element) return i;
     }
@@ -403,6 +456,14 @@ abstract class _IntListMixin implements List<int> {
     } else if (start < 0) {
       return -1;
     }
+    if (start >= _bulkOperationThreshold && element != null) {
+      return this.buffer._data._indexOf(
+          this.offsetInBytes,
+          (start + 1) * elementSizeInBytes,
+          element,
+          ClassID.getID(this),
+          true);
+    }
     for (int i = start; i >= 0; i--) {
       if (this[i] == element) return i;
     }
@@ -456,6 +517,15 @@ abstract class _IntListMixin implements List<int> {
 
   void fillRange(int start, int end, [int fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
+    final count = end - start;
+    if (count >= _bulkOperationThreshold && fillValue != null) {
+      this.buffer._data._fillRange(
+          start * elementSizeInBytes + this.offsetInBytes,
+          count * elementSizeInBytes,
+          fillValue,
+          ClassID.getID(this));
+      return;
+    }
     for (var i = start; i < end; ++i) {
       this[i] = fillValue;
     }
@@ -577,6 +647,16 @@ abstract class _DoubleListMixin implements List<double> {
           this[i] = tempBuffer[i - start];
         }
         return;
+      } else if (count >= _bulkOperationThreshold) {
+        this.buffer._data._convertRange(
+            start * elementSizeInBytes + this.offsetInBytes,
+            count,
+            fromAsTypedList.buffer._data,
+            skipCount * fromAsTypedList.elementSizeInBytes +
+                fromAsTypedList.offsetInBytes,
+            ClassID.getID(this),
+            ClassID.getID(from));
+        return;
       }
     }
 
@@ -736,6 +816,13 @@ abstract class _DoubleListMixin implements List<double> {
   }
 
   void sort([int compare(double a, double b)]) {
+    if (compare == null && this.length >= _bulkOperationThreshold) {
+      this.buffer._data._sortRange(
+          this.offsetInBytes,
+          this.length * elementSizeInBytes,
+          ClassID.getID(this));
+      return;
+    }
     Sort.sort(this, compare ?? Comparable.compare);
   }
 
@@ -745,6 +832,16 @@ abstract class _DoubleListMixin implements List<double> {
     } else if (start < 0) {
       start = 0;
     }
+    final count = this.length - start;
+    if (count >= _bulkOperationThreshold && element != null) {
+      final index = this.buffer._data._indexOf(
+          start * elementSizeInBytes + this.offsetInBytes,
+          count * elementSizeInBytes,
+          element,
+          ClassID.getID(this),
+          false);
+      return index < 0 ? -1 : start + index;
+    }
     for (int i = start; i < this.length; i++) {
       if (this[i] == element) return i;
     }
@@ -757,6 +854,14 @@ abstract class _DoubleListMixin implements List<double> {
     } else if (start < 0) {
       return -1;
     }
+    if (start >= _bulkOperationThreshold && element != null) {
+      return this.buffer._data._indexOf(
+          this.offsetInBytes,
+          (start + 1) * elementSizeInBytes,
+          element,
+          ClassID.getID(this),
+          true);
+    }
     for (int i = start; i >= 0; i--) {
       if (this[i] == element) return i;
     }
@@ -810,6 +915,15 @@ abstract class _DoubleListMixin implements List<double> {
 
   void fillRange(int start, int end, [double fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
+    final count = end - start;
+    if (count >= _bulkOperationThreshold && fillValue != null) {
+      this.buffer._data._fillRange(
+          start * elementSizeInBytes + this.offsetInBytes,
+          count * elementSizeInBytes,
+          fillValue,
+          ClassID.getID(this));
+      return;
+    }
     for (var i = start; i < end; ++i) {
       this[i] = fillValue;
     }
@@ -0,0 +1,54 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--no_background_compilation --optimization_counter_threshold=10 --coverage_counters
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+import 'test_helper.dart';
+import 'service_test_common.dart';
+import 'dart:developer';
+
+int helper(int i) => i + 1;
+
+int optimizedFunction(bool late) {
+  if (late) {
+    // Only reached by the optimized code.
+    return helper(2);
+  }
+  return helper(1);
+}
+
+void testFunction() {
+  for (var i = 0; i < 100; i++) {
+    optimizedFunction(false);
+  }
+  optimizedFunction(true);
+  debugger();
+}
+
+var tests = <IsolateTest>[
+  hasStoppedAtBreakpoint,
+  (Isolate isolate) async {
+    var root = isolate.rootLibrary;
+    await root.load();
+    var func = root.functions.singleWhere((f) => f.name == 'optimizedFunction');
+    await func.load();
+
+    var params = {
+      'reports': ['Coverage'],
+      'scriptId': func.location.script.id,
+      'tokenPos': func.location.tokenPos,
+      'endTokenPos': func.location.endTokenPos,
+      'forceCompile': true
+    };
+    var report = await isolate.invokeRpcNoUpgrade('getSourceReport', params);
+    expect(report['type'], equals('SourceReport'));
+    expect(report['ranges'].length, 1);
+    var coverage = report['ranges'][0]['coverage'];
+    expect(coverage['hits'], isNotEmpty);
+    expect(coverage['misses'], isEmpty);
+  },
+];
+
+main(args) => runIsolateTests(args, tests, testeeConcurrent: testFunction);
@@ -0,0 +1,100 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+fib(n) {
+  if (n < 0) return 0;
+  if (n == 0) return 1;
+  return fib(n - 1) + fib(n - 2);
+}
+
+testeeDo() {
+  print("Testee doing something.");
+  fib(30);
+  print("Testee did something.");
+}
+
+// Decodes the top level fields of a protocol buffer into a map from field
+// number to the list of its values: ints for varints, bytes for
+// length-delimited fields.
+Map<int, List> decodeFields(Uint8List bytes) {
+  var fields = <int, List>{};
+  var offset = 0;
+  int readVarint() {
+    var value = 0;
+    var shift = 0;
+    while (true) {
+      var byte = bytes[offset++];
+      value |= (byte & 0x7f) << shift;
+      if (byte < 0x80) return value;
+      shift += 7;
+    }
+  }
+
+  while (offset < bytes.length) {
+    var key = readVarint();
+    var field = key >> 3;
+    var value;
+    switch (key & 7) {
+      case 0:
+        value = readVarint();
+        break;
+      case 2:
+        var length = readVarint();
+        value = new Uint8List.view(
+            bytes.buffer, bytes.offsetInBytes + offset, length);
+        offset += length;
+        break;
+      default:
+        fail('Unexpected wire type ${key & 7}');
+    }
+    fields.putIfAbsent(field, () => []).add(value);
+  }
+  return fields;
+}
+
+Future<Map<int, List>> getSamples(
+    Isolate isolate, int sinceMicros, int knownCodes) async {
+  var params = {'sinceMicros': sinceMicros, 'knownCodes': knownCodes};
+  var result = await isolate.invokeRpcNoUpgrade('_getCpuSamplesBinary', params);
+  expect(result['type'], equals('_CpuSamplesBinary'));
+  return decodeFields(base64.decode(result['bytes']));
+}
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    var all = await getSamples(isolate, 0, 0);
+    var codes = all[3] ?? [];
+    var samples = all[4] ?? [];
+    expect(samples, isNotEmpty);
+    expect(codes, isNotEmpty);
+    expect(all[2], isNull); // The code table starts at 0.
+    for (Uint8List sample in samples) {
+      // Every frame is a varint index into the code table.
+      Uint8List frames = decodeFields(sample)[3].single;
+      expect(frames, isNotEmpty);
+      expect(frames.last, lessThan(0x80));
+    }
+    var names = codes.map((code) => utf8.decode(decodeFields(code)[1].single));
+    expect(names.any((name) => name.contains('fib')), isTrue);
+
+    // Code which was already sent is not sent again.
+    var newest = all[1].single;
+    var incremental = await getSamples(isolate, newest, codes.length);
+    expect(incremental[2].single, equals(codes.length));
+    for (Uint8List sample in incremental[4] ?? []) {
+      var delta = decodeFields(sample)[1];
+      expect(delta, isNotNull);
+    }
+  },
+];
+
+main(args) async => runIsolateTests(args, tests, testeeBefore: testeeDo);
@@ -0,0 +1,67 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+add(a, b) => a + b;
+
+testeeDo() {
+  for (int i = 0; i < 100; i++) {
+    add(i, 1);
+  }
+  // Deoptimizes the code specialized for integers.
+  add(1.5, 2.5);
+  for (int i = 0; i < 100; i++) {
+    add(i, 1);
+  }
+}
+
+bool isAddSite(Map site) =>
+    site['function'].contains('add') ||
+    (site['inlinedFunction'] ?? '').contains('add');
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    var result =
+        await isolate.invokeRpcNoUpgrade('_getDeoptimizationStatistics', {});
+    expect(result['type'], equals('_DeoptimizationStatistics'));
+    expect(result['deoptimizations'], greaterThan(0));
+
+    List sites = result['sites'];
+    expect(sites.any(isAddSite), isTrue);
+    for (Map site in sites) {
+      expect(site['deoptId'], new isInstanceOf<int>());
+      expect(site['reason'], new isInstanceOf<String>());
+      expect(site['count'], greaterThan(0));
+      expect(site['lazyCount'], lessThanOrEqualTo(site['count']));
+    }
+    for (int i = 1; i < sites.length; i++) {
+      expect(sites[i - 1]['count'], greaterThanOrEqualTo(sites[i]['count']));
+    }
+
+    List functions = result['reoptimizedFunctions'];
+    for (Map function in functions) {
+      expect(function['reoptimizations'], greaterThan(0));
+    }
+  },
+  (Isolate isolate) async {
+    var params = {'reset': 'true'};
+    await isolate.invokeRpcNoUpgrade('_getDeoptimizationStatistics', params);
+    var result =
+        await isolate.invokeRpcNoUpgrade('_getDeoptimizationStatistics', {});
+    expect(result['deoptimizations'], equals(0));
+    expect(result['sites'], isEmpty);
+    expect(result['reoptimizedFunctions'], isEmpty);
+  },
+];
+
+main(args) async => runIsolateTests(args, tests,
+    testeeBefore: testeeDo,
+    extraArgs: [
+      '--no-background-compilation',
+      '--optimization-counter-threshold=10'
+    ]);
@@ -0,0 +1,200 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_PLATFORM_SORT_H_
+#define RUNTIME_PLATFORM_SORT_H_
+
+#include <string.h>
+
+#include "platform/allocation.h"
+#include "platform/globals.h"
+#include "platform/utils.h"
+
+namespace dart {
+
+// In-place sorting of arrays of plain values, for callers that can order the
+// elements without calling back into Dart.
+class Sort : public AllStatic {
+ public:
+  // Sorts 'length' elements by the strict weak order 'less'. Not stable.
+  //
+  // Quicksort with median-of-three pivots that falls back to heapsort when
+  // partitioning goes badly and finishes short ranges with insertion sort, so
+  // it takes O(n log n) time on any input.
+  template <typename T, typename Less>
+  static void IntroSort(T* elements, intptr_t length, Less less) {
+    if (length < 2) return;
+    IntroSortRange(elements, elements + length,
+                   2 * Utils::HighestBit(length), less);
+  }
+
+  // Sorts 'length' elements by the unsigned integer 'key(element)' with a
+  // least significant digit first radix sort. Stable. 'scratch' must have
+  // room for 'length' elements.
+  //
+  // Takes one pass over the elements for every byte of the key that not all
+  // of them share, plus one to count the digits.
+  template <typename T, typename Key>
+  static void RadixSort(T* elements, T* scratch, intptr_t length, Key key) {
+    typedef decltype(key(elements[0])) K;
+    const intptr_t kDigits = sizeof(K);
+    const intptr_t kRadix = 256;
+    if (length < 2) return;
+    intptr_t counts[kDigits][kRadix];
+    memset(counts, 0, sizeof(counts));
+    for (intptr_t i = 0; i < length; i++) {
+      const K k = key(elements[i]);
+      for (intptr_t d = 0; d < kDigits; d++) {
+        counts[d][Digit(k, d)]++;
+      }
+    }
+
+    T* from = elements;
+    T* to = scratch;
+    for (intptr_t d = 0; d < kDigits; d++) {
+      intptr_t* count = counts[d];
+      if (count[Digit(key(from[0]), d)] == length) {
+        continue;  // Every element has the same digit here.
+      }
+      intptr_t offset = 0;
+      for (intptr_t digit = 0; digit < kRadix; digit++) {
+        const intptr_t n = count[digit];
+        count[digit] = offset;
+        offset += n;
+      }
+      for (intptr_t i = 0; i < length; i++) {
+        const T element = from[i];
+        to[count[Digit(key(element), d)]++] = element;
+      }
+      T* tmp = from;
+      from = to;
+      to = tmp;
+    }
+    if (from != elements) {
+      memmove(elements, from, length * sizeof(T));
+    }
+  }
+
+ private:
+  // Ranges this short are finished with insertion sort.
+  static const intptr_t kInsertionSortThreshold = 16;
+
+  template <typename K>
+  static intptr_t Digit(K key, intptr_t d) {
+    return static_cast<intptr_t>((key >> (d * kBitsPerByte)) & 0xFF);
+  }
+
+  template <typename T>
+  static void Swap(T* a, T* b) {
+    const T tmp = *a;
+    *a = *b;
+    *b = tmp;
+  }
+
+  template <typename T, typename Less>
+  static void IntroSortRange(T* first,
+                             T* last,
+                             intptr_t depth_limit,
+                             Less less) {
+    while (last - first > kInsertionSortThreshold) {
+      if (depth_limit == 0) {
+        HeapSort(first, last - first, less);
+        return;
+      }
+      depth_limit--;
+      T* cut = Partition(first, last, less);
+      // Recurse into the shorter side to bound the native stack depth.
+      if (cut - first < last - cut) {
+        IntroSortRange(first, cut, depth_limit, less);
+        first = cut;
+      } else {
+        IntroSortRange(cut, last, depth_limit, less);
+        last = cut;
+      }
+    }
+    InsertionSort(first, last, less);
+  }
+
+  // Moves the median of 'first[1]', the middle and the last element to
+  // 'first' and partitions the rest around it. The other two candidates stop
+  // the scans at both ends, so they need no bounds checks. Returns the start
+  // of the upper part.
+  template <typename T, typename Less>
+  static T* Partition(T* first, T* last, Less less) {
+    T* a = first + 1;
+    T* b = first + (last - first) / 2;
+    T* c = last - 1;
+    if (less(*a, *b)) {
+      if (less(*b, *c)) {
+        Swap(first, b);
+      } else if (less(*a, *c)) {
+        Swap(first, c);
+      } else {
+        Swap(first, a);
+      }
+    } else if (less(*a, *c)) {
+      Swap(first, a);
+    } else if (less(*b, *c)) {
+      Swap(first, c);
+    } else {
+      Swap(first, b);
+    }
+
+    const T pivot = *first;
+    T* lo = first + 1;
+    T* hi = last;
+    while (true) {
+      while (less(*lo, pivot)) lo++;
+      hi--;
+      while (less(pivot, *hi)) hi--;
+      if (!(lo < hi)) return lo;
+      Swap(lo, hi);
+      lo++;
+    }
+  }
+
+  template <typename T, typename Less>
+  static void InsertionSort(T* first, T* last, Less less) {
+    for (T* i = first + 1; i < last; i++) {
+      const T element = *i;
+      T* j = i;
+      while ((j > first) && less(element, *(j - 1))) {
+        *j = *(j - 1);
+        j--;
+      }
+      *j = element;
+    }
+  }
+
+  template <typename T, typename Less>
+  static void SiftDown(T* heap, intptr_t root, intptr_t length, Less less) {
+    const T element = heap[root];
+    while (true) {
+      intptr_t child = 2 * root + 1;
+      if (child >= length) break;
+      if ((child + 1 < length) && less(heap[child], heap[child + 1])) {
+        child++;
+      }
+      if (!less(element, heap[child])) break;
+      heap[root] = heap[child];
+      root = child;
+    }
+    heap[root] = element;
+  }
+
+  template <typename T, typename Less>
+  static void HeapSort(T* elements, intptr_t length, Less less) {
+    for (intptr_t i = length / 2 - 1; i >= 0; i--) {
+      SiftDown(elements, i, length, less);
+    }
+    for (intptr_t end = length - 1; end > 0; end--) {
+      Swap(elements, elements + end);
+      SiftDown(elements, 0, end, less);
+    }
+  }
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_PLATFORM_SORT_H_
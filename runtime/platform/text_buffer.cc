@@ -122,7 +122,7 @@ void TextBuffer::EscapeAndAddUTF16CodeUnit(uint16_t codeunit) {
 }
 
 void TextBuffer::AddString(const char* s) {
-  Printf("%s", s);
+  AddRaw(reinterpret_cast<const uint8_t*>(s), strlen(s));
 }
 
 void TextBuffer::AddEscapedString(const char* s) {
@@ -7,6 +7,7 @@
 #include "platform/allocation.h"
 #include "platform/globals.h"
 #include "platform/syslog.h"
+#include "platform/utils.h"
 
 namespace dart {
 
@@ -48,8 +49,16 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
                              Type* type) {
   intptr_t len = 0;
   Type char_type = kLatin1;
-  for (intptr_t i = 0; i < array_len; i++) {
+  intptr_t i = 0;
+  while (i < array_len) {
     uint8_t code_unit = utf8_array[i];
+    if (code_unit <= kMaxOneByteChar) {
+      intptr_t ascii = AsciiPrefixLength(&utf8_array[i], array_len - i);
+      len += ascii;
+      i += ascii;
+      continue;
+    }
+    i++;
     if (!IsTrailByte(code_unit)) {
       ++len;
       if (!IsLatin1SequenceStart(code_unit)) {          // > U+00FF
@@ -71,6 +80,10 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   intptr_t i = 0;
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
+    if (ch <= static_cast<uint32_t>(kMaxOneByteChar)) {
+      i += AsciiPrefixLength(&utf8_array[i], array_len - i);
+      continue;
+    }
     intptr_t j = 1;
     if (ch >= 0x80) {
       int8_t num_trail_bytes = kTrailBytes[ch];
@@ -95,6 +108,29 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   return true;
 }
 
+intptr_t Utf8::AsciiPrefixLength(const uint8_t* utf8_array,
+                                 intptr_t array_len) {
+  const uword kHighBits = static_cast<uword>(0x8080808080808080ULL);
+  const intptr_t kWordSize = sizeof(uword);
+  intptr_t i = 0;
+  while ((i < array_len) && !Utils::IsAligned(&utf8_array[i], kWordSize)) {
+    if (utf8_array[i] > kMaxOneByteChar) {
+      return i;
+    }
+    i++;
+  }
+  while ((i + kWordSize) <= array_len) {
+    if ((*reinterpret_cast<const uword*>(&utf8_array[i]) & kHighBits) != 0) {
+      break;
+    }
+    i += kWordSize;
+  }
+  while ((i < array_len) && (utf8_array[i] <= kMaxOneByteChar)) {
+    i++;
+  }
+  return i;
+}
+
 intptr_t Utf8::Length(int32_t ch) {
   if (ch <= kMaxOneByteChar) {
     return 1;
@@ -193,7 +229,15 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
   intptr_t i = 0;
   intptr_t j = 0;
   intptr_t num_bytes;
-  for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+  while ((i < array_len) && (j < len)) {
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      const intptr_t ascii = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      memmove(&dst[j], &utf8_array[i], ascii);
+      i += ascii;
+      j += ascii;
+      continue;
+    }
     int32_t ch;
     ASSERT(IsLatin1SequenceStart(utf8_array[i]));
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
@@ -202,6 +246,8 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
     }
     ASSERT(Utf::IsLatin1(ch));
     dst[j] = ch;
+    i += num_bytes;
+    j++;
   }
   if ((i < array_len) && (j == len)) {
     return false;  // Output overflow.
@@ -216,7 +262,17 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
   intptr_t i = 0;
   intptr_t j = 0;
   intptr_t num_bytes;
-  for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+  while ((i < array_len) && (j < len)) {
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      const intptr_t ascii = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      for (intptr_t k = 0; k < ascii; k++) {
+        dst[j + k] = utf8_array[i + k];
+      }
+      i += ascii;
+      j += ascii;
+      continue;
+    }
     int32_t ch;
     bool is_supplementary = IsSupplementarySequenceStart(utf8_array[i]);
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
@@ -230,6 +286,8 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
     } else {
       dst[j] = ch;
     }
+    i += num_bytes;
+    j++;
   }
   if ((i < array_len) && (j == len)) {
     return false;  // Output overflow.
@@ -52,6 +52,11 @@ class Utf8 : AllStatic {
   // Returns true if 'utf8_array' is a valid UTF-8 string.
   static bool IsValid(const uint8_t* utf8_array, intptr_t array_len);
 
+  // Returns the number of ASCII bytes at the start of 'utf8_array'. The
+  // bytes are checked a word at a time.
+  static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                    intptr_t array_len);
+
   static intptr_t Length(int32_t ch);
   static intptr_t Length(const String& str);
 
@@ -0,0 +1,60 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Awaiting a value which is not a future resumes in a later microtask, in
+// the order of the awaits and other scheduled microtasks, both in the root
+// zone and in custom zones.
+
+import 'dart:async';
+
+import 'package:expect/expect.dart';
+
+Future<void> awaitValues(List<String> log, String name) async {
+  log.add('$name start');
+  var value = await 1;
+  log.add('$name $value');
+  value = await null;
+  log.add('$name $value');
+}
+
+Future<void> run(List<String> log) {
+  final done = awaitValues(log, 'a');
+  scheduleMicrotask(() => log.add('microtask'));
+  awaitValues(log, 'b');
+  log.add('sync');
+  return done;
+}
+
+const expected = [
+  'a start',
+  'b start',
+  'sync',
+  'a 1',
+  'microtask',
+  'b 1',
+  'a null',
+  'b null',
+];
+
+main() async {
+  final rootLog = <String>[];
+  await run(rootLog);
+  await null;
+  Expect.listEquals(expected, rootLog);
+
+  final zoneLog = <String>[];
+  var runs = 0;
+  R countRunUnary<R, T>(
+      Zone self, ZoneDelegate parent, Zone zone, R f(T arg), T arg) {
+    runs++;
+    return parent.runUnary(zone, f, arg);
+  }
+
+  await runZoned(() => run(zoneLog),
+      zoneSpecification: new ZoneSpecification(runUnary: countRunUnary));
+  await null;
+  Expect.listEquals(expected, zoneLog);
+  // Continuations in custom zones still run through the zone.
+  Expect.isTrue(runs > 0);
+}
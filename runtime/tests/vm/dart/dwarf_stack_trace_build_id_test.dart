@@ -0,0 +1,26 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--dwarf-stack-traces
+
+// Stack traces of code loaded from an instructions image carry the image's
+// build id and image relative offsets for offline symbolization.
+
+import "package:expect/expect.dart";
+
+@pragma("vm:never-inline")
+String currentTrace() => StackTrace.current.toString();
+
+main() {
+  final trace = currentTrace();
+  final buildId = new RegExp(r"build_id: '([0-9a-f]{16})'").firstMatch(trace);
+  if (buildId == null) {
+    // Not running from a snapshot with an instructions image.
+    return;
+  }
+  Expect.notEquals("0000000000000000", buildId.group(1));
+  final offsets = new RegExp(r"_kDart(Isolate|Vm)SnapshotInstructions\+0x")
+      .allMatches(trace);
+  Expect.isTrue(offsets.isNotEmpty, trace);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Growing lists, addAll and List.from copy the elements of the VM's own
+// list implementations in bulk, above a small threshold.
+
+import 'package:expect/expect.dart';
+
+class Box {
+  final int value;
+  Box(this.value);
+}
+
+const constList = const <int>[1, 2, 3, 4, 5, 6, 7, 8, 9, 10];
+
+void expectBoxes(List<Box> list, int length) {
+  Expect.equals(length, list.length);
+  for (var i = 0; i < length; i++) {
+    Expect.equals(i, list[i].value);
+  }
+}
+
+void testAddAll() {
+  for (final length in [0, 1, 10, 63, 64, 65, 1000, 200000]) {
+    final fixed = new List<Box>(length);
+    for (var i = 0; i < length; i++) {
+      fixed[i] = new Box(i);
+    }
+    final growable = new List<Box>.of(fixed);
+    expectBoxes(growable, length);
+
+    final fromFixed = <Box>[]..addAll(fixed);
+    expectBoxes(fromFixed, length);
+    final fromGrowable = <Box>[]..addAll(growable);
+    expectBoxes(fromGrowable, length);
+
+    final appended = <Box>[new Box(-1)]..addAll(growable);
+    Expect.equals(length + 1, appended.length);
+    Expect.equals(-1, appended[0].value);
+    for (var i = 0; i < length; i++) {
+      Expect.identical(growable[i], appended[i + 1]);
+    }
+  }
+
+  final list = <int>[0]..addAll(constList);
+  Expect.listEquals([0]..addAll(constList.toList()), list);
+
+  final self = <int>[1, 2, 3];
+  Expect.throws(() => self.addAll(self),
+      (e) => e is ConcurrentModificationError);
+}
+
+void testGrow() {
+  final list = <Box>[];
+  for (var i = 0; i < 100000; i++) {
+    list.add(new Box(i));
+  }
+  expectBoxes(list, 100000);
+  list.length = 10;
+  expectBoxes(list, 10);
+}
+
+void testFrom() {
+  for (final length in [1, 63, 64, 65, 1000]) {
+    final source = new List<int>.generate(length, (i) => i);
+    final fixed = new List<int>.from(source, growable: false);
+    Expect.listEquals(source, fixed);
+    Expect.throws(() => fixed.add(0), (e) => e is UnsupportedError);
+
+    final growable = new List<num>.from(source);
+    Expect.listEquals(source, growable);
+    Expect.isTrue(growable is List<num>);
+    Expect.isFalse(growable is List<int>);
+    growable.add(1.5);
+    Expect.equals(length + 1, growable.length);
+
+    final copy = new List<num>.of(growable.sublist(0, length));
+    Expect.listEquals(source, copy);
+  }
+  Expect.listEquals(constList, new List<int>.from(constList));
+
+  final mixed = <Object>[1, 2, 3, "four"];
+  Expect.throws(() => new List<int>.from(mixed));
+}
+
+main() {
+  testAddAll();
+  testGrow();
+  testFrom();
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation --no-inline-alloc
+
+// Closures allocated inline by optimized code are fully initialized, also
+// when the allocation falls back to the stub after new space fills up.
+
+import 'package:expect/expect.dart';
+
+class Box {
+  final int value;
+  Box(this.value);
+
+  int get() => value;
+}
+
+Function makeAdder(int n) => (int x) => x + n;
+
+Function tearOff(Box box) => box.get;
+
+void main() {
+  final adders = <Function>[];
+  for (var i = 0; i < 100000; i++) {
+    final adder = makeAdder(i);
+    Expect.equals(i + 1, adder(1));
+    if (i % 1000 == 0) {
+      adders.add(adder);
+    }
+    final getter = tearOff(new Box(i));
+    Expect.equals(i, getter());
+    Expect.equals(getter.hashCode, getter.hashCode);
+  }
+  for (var i = 0; i < adders.length; i++) {
+    Expect.equals(i * 1000 + 2, adders[i](2));
+  }
+
+  final box = new Box(42);
+  Expect.equals(tearOff(box), tearOff(box));
+  Expect.equals(tearOff(box).hashCode, tearOff(box).hashCode);
+  Expect.notEquals(makeAdder(1), makeAdder(1));
+}
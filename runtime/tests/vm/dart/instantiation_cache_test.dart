@@ -0,0 +1,39 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+
+// Instantiating the same type arguments with many different instantiators
+// keeps working while the instantiations cache grows and in optimized code
+// probing it.
+
+import 'package:expect/expect.dart';
+
+class Pair<A, B> {}
+
+List<Map<T, Set<T>>> makeList<T>() => <Map<T, Set<T>>>[];
+
+class Holder<T> {
+  Pair<T, List<T>> makePair() => new Pair<T, List<T>>();
+}
+
+void check<T>(int depth) {
+  final list = makeList<T>();
+  Expect.isTrue(list is List<Map<T, Set<T>>>);
+  Expect.isFalse(list is List<Map<T, Set<List<T>>>>);
+  final pair = new Holder<T>().makePair();
+  Expect.isTrue(pair is Pair<T, List<T>>);
+  Expect.isFalse(pair is Pair<List<T>, T>);
+  if (depth > 0) {
+    check<List<T>>(depth - 1);
+    check<Set<T>>(depth - 1);
+  }
+}
+
+main() {
+  for (var i = 0; i < 20; i++) {
+    check<int>(5);
+    check<String>(5);
+  }
+}
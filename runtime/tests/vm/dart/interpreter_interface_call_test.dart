@@ -0,0 +1,86 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Exercises interface calls whose call sites go through monomorphic,
+// polymorphic and megamorphic inline cache states in the interpreter.
+
+import "package:expect/expect.dart";
+
+abstract class Shape {
+  int get sides;
+  int scaled(int factor) => sides * factor;
+  bool operator <(Shape other) => sides < other.sides;
+}
+
+class Triangle extends Shape {
+  int get sides => 3;
+}
+
+class Square extends Shape {
+  int get sides => 4;
+}
+
+class Pentagon extends Shape {
+  int get sides => 5;
+}
+
+class Hexagon extends Shape {
+  int get sides => 6;
+}
+
+class Heptagon extends Shape {
+  int get sides => 7;
+}
+
+class Octagon extends Shape {
+  int get sides => 8;
+  int scaled(int factor) => -factor;
+}
+
+int sumOfSides(List<Shape> shapes) {
+  int sum = 0;
+  for (Shape shape in shapes) {
+    sum += shape.sides;
+  }
+  return sum;
+}
+
+int sumOfScaled(List<Shape> shapes, int factor) {
+  int sum = 0;
+  for (Shape shape in shapes) {
+    sum += shape.scaled(factor);
+  }
+  return sum;
+}
+
+int countSmaller(List<Shape> shapes, Shape pivot) {
+  int count = 0;
+  for (Shape shape in shapes) {
+    if (shape < pivot) count++;
+  }
+  return count;
+}
+
+main() {
+  final monomorphic = <Shape>[new Square(), new Square()];
+  final polymorphic = <Shape>[new Triangle(), new Square(), new Pentagon()];
+  final megamorphic = <Shape>[
+    new Triangle(),
+    new Square(),
+    new Pentagon(),
+    new Hexagon(),
+    new Heptagon(),
+    new Octagon()
+  ];
+  for (int i = 0; i < 50; i++) {
+    Expect.equals(8, sumOfSides(monomorphic));
+    Expect.equals(12, sumOfSides(polymorphic));
+    Expect.equals(33, sumOfSides(megamorphic));
+    Expect.equals(16, sumOfScaled(monomorphic, 2));
+    Expect.equals(36, sumOfScaled(polymorphic, 3));
+    Expect.equals(25 * i - i, sumOfScaled(megamorphic, i));
+    Expect.equals(2, countSmaller(megamorphic, new Pentagon()));
+    Expect.equals(0, countSmaller(polymorphic, new Triangle()));
+  }
+}
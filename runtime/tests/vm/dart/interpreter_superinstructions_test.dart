@@ -0,0 +1,81 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Exercises sequences of bytecode instructions which the interpreter fuses
+// into superinstructions: pushes of locals, returns of locals and null, and
+// integer comparisons followed by conditional jumps.
+
+import "package:expect/expect.dart";
+
+class Box {
+  int value;
+  Box(this.value);
+
+  int get current => value;
+}
+
+int pick(int a, int b, bool first) {
+  if (first) {
+    return a;
+  }
+  return b;
+}
+
+void nothing() {}
+
+dynamic nullResult(int x) {
+  if (x > 0) {
+    return x;
+  }
+  return null;
+}
+
+int countBelow(int limit) {
+  int count = 0;
+  for (int i = 0; i < limit; i++) {
+    if (i <= 2 || i >= limit - 2) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int compare(int a, int b) {
+  if (a == b) return 0;
+  if (a > b) return 1;
+  return -1;
+}
+
+dynamic compareWithNull(dynamic a, dynamic b) => (a as int) < (b as int);
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    Expect.equals(1, pick(1, 2, true));
+    Expect.equals(2, pick(1, 2, false));
+    Expect.equals(7, new Box(7).current);
+    Expect.isNull(nullResult(-1));
+    Expect.equals(3, nullResult(3));
+    Expect.equals(5, countBelow(5));
+    Expect.equals(5, countBelow(10));
+    Expect.equals(0, countBelow(0));
+
+    Expect.equals(0, compare(3, 3));
+    Expect.equals(1, compare(4, 3));
+    Expect.equals(-1, compare(-4, 3));
+    const mint = 0x7fffffffffffffff;
+    Expect.equals(0, compare(mint, mint));
+    Expect.equals(-1, compare(mint - 1, mint));
+    Expect.equals(1, compare(mint, -mint));
+    Expect.equals(0, compare(mint - 5, mint ~/ 2 * 2 - 4));
+
+    int offset = i;
+    var closure = (int x) => x + offset;
+    Expect.equals(i + 1, closure(1));
+
+    Expect.throws(() => compareWithNull(null, 1));
+    Expect.throws(() => compareWithNull(1, null));
+    Expect.isTrue(compareWithNull(1, 2));
+  }
+  nothing();
+}
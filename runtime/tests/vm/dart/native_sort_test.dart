@@ -0,0 +1,110 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Sorting typed data and lists of Smis or one-byte strings without a
+// comparator orders them like sorting with Comparable.compare does.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+final random = new Random(42);
+
+List<T> fill<T extends num>(List<T> list, T next()) {
+  for (var i = 0; i < list.length; i++) {
+    list[i] = next();
+  }
+  return list;
+}
+
+void checkSort<T extends Comparable>(List<T> list) {
+  final expected = new List<T>.from(list)..sort(Comparable.compare);
+  list.sort();
+  for (var i = 0; i < list.length; i++) {
+    final a = expected[i];
+    final b = list[i];
+    // NaN is not equal to itself and 0.0 == -0.0.
+    Expect.isTrue(Comparable.compare(a, b) == 0, "$a vs $b at $i");
+  }
+}
+
+void testTypedData(int length) {
+  int signed(int bits) => random.nextInt(1 << bits) - (1 << (bits - 1));
+  int unsigned(int bits) => random.nextInt(1 << bits);
+
+  checkSort(fill(new Int8List(length), () => signed(8)));
+  checkSort(fill(new Uint8List(length), () => unsigned(8)));
+  checkSort(fill(new Uint8ClampedList(length), () => unsigned(8)));
+  checkSort(fill(new Int16List(length), () => signed(16)));
+  checkSort(fill(new Uint16List(length), () => unsigned(16)));
+  checkSort(fill(new Int32List(length), () => signed(32)));
+  checkSort(fill(new Uint32List(length), () => unsigned(32)));
+  checkSort(fill(
+      new Int64List(length), () => (signed(32) << 32) ^ unsigned(32)));
+  // Uint64List elements read back as signed integers.
+  checkSort(fill(
+      new Uint64List(length), () => (unsigned(32) << 32) ^ unsigned(32)));
+
+  const specials = const <double>[
+    double.nan,
+    -double.nan,
+    double.infinity,
+    double.negativeInfinity,
+    0.0,
+    -0.0,
+    double.minPositive,
+  ];
+  double nextDouble() => random.nextInt(8) == 0
+      ? specials[random.nextInt(specials.length)]
+      : (random.nextDouble() - 0.5) * 1e6;
+  checkSort(fill(new Float32List(length), nextDouble));
+  checkSort(fill(new Float64List(length), nextDouble));
+
+  // Views sort only their own elements.
+  final buffer = fill(new Int32List(length + 2), () => signed(32));
+  final first = buffer.first;
+  final last = buffer.last;
+  checkSort(new Int32List.view(buffer.buffer, 4, length));
+  Expect.equals(first, buffer.first);
+  Expect.equals(last, buffer.last);
+}
+
+void testLists(int length) {
+  final smis = new List<int>.generate(
+      length, (_) => random.nextInt(1 << 20) - (1 << 19));
+  checkSort(new List<int>.from(smis, growable: false));
+  checkSort(new List<int>.from(smis));
+
+  final strings = new List<String>.generate(length,
+      (_) => new String.fromCharCodes(new List<int>.generate(
+          random.nextInt(4), (_) => 0x61 + random.nextInt(3))));
+  checkSort(new List<String>.from(strings, growable: false));
+  checkSort(new List<String>.from(strings));
+
+  // Mixed lists are sorted in Dart.
+  final mixed = <num>[]..addAll(smis);
+  if (length > 0) mixed[0] = 0.5;
+  checkSort(mixed);
+  final twoByte = <String>[]..addAll(strings);
+  if (length > 0) twoByte[0] = '\u{1234}';
+  checkSort(twoByte);
+}
+
+void testErrors() {
+  final list = new List<Object>.generate(100, (i) => i);
+  list[50] = new Object();
+  Expect.throws(() => list.sort());
+  final withNull = new List<int>.generate(100, (i) => i);
+  withNull[50] = null;
+  Expect.throws(() => withNull.sort());
+}
+
+main() {
+  for (final length in const [0, 1, 15, 16, 100, 255, 256, 10000]) {
+    testTypedData(length);
+    testLists(length);
+  }
+  testErrors();
+}
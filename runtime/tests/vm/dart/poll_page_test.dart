@@ -0,0 +1,51 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--use-poll-page --optimization-counter-threshold=10 --no-background-compilation
+// VMOptions=--use-poll-page --optimization-counter-threshold=10 --no-background-compilation --no-use-osr
+
+// Optimized loops polling the poll page still see interrupts: an isolate
+// spinning in a loop answers immediate pings and can be killed.
+
+import 'dart:async';
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+int spinOnce(int n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    sum = (sum + i * 3) & 0xffff;
+  }
+  return sum;
+}
+
+void spin(SendPort started) {
+  // Get spinOnce optimized first when OSR is disabled.
+  for (var i = 0; i < 100; i++) {
+    spinOnce(10);
+  }
+  started.send(null);
+  var total = 0;
+  while (true) {
+    total ^= spinOnce(1 << 20);
+  }
+}
+
+Future<void> main() async {
+  final started = new ReceivePort();
+  final exited = new ReceivePort();
+  final isolate =
+      await Isolate.spawn(spin, started.sendPort, onExit: exited.sendPort);
+  await started.first;
+
+  for (var i = 0; i < 10; i++) {
+    final pong = new ReceivePort();
+    isolate.ping(pong.sendPort, response: i, priority: Isolate.immediate);
+    Expect.equals(i, await pong.first);
+  }
+
+  isolate.kill(priority: Isolate.immediate);
+  await exited.first;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation --no-polymorphic-with-deopt
+
+// A polymorphic instance call in optimized JIT code keeps dispatching
+// correctly while its switchable call site goes from the IC stub to the
+// megamorphic cache.
+
+import 'package:expect/expect.dart';
+
+abstract class Shape {
+  int get id;
+}
+
+class A extends Shape {
+  int get id => 1;
+}
+
+class B extends Shape {
+  int get id => 2;
+}
+
+class C extends Shape {
+  int get id => 3;
+}
+
+class D extends Shape {
+  int get id => 4;
+}
+
+class E extends Shape {
+  int get id => 5;
+}
+
+class F extends Shape {
+  int get id => 6;
+}
+
+class G extends Shape {
+  int get id => 7;
+}
+
+int sum(List<Shape> shapes) {
+  var result = 0;
+  for (final shape in shapes) {
+    result += shape.id;
+  }
+  return result;
+}
+
+main() {
+  final warm = <Shape>[new A(), new B()];
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(3, sum(warm));
+  }
+  final all = <Shape>[
+    new A(),
+    new B(),
+    new C(),
+    new D(),
+    new E(),
+    new F(),
+    new G(),
+  ];
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(28, sum(all));
+  }
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+
+// Views created and only read or written in optimized code keep working when
+// their allocation is removed, including when they have to be materialized
+// on deoptimization.
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+int sumWords(Uint8List bytes, int start, num extra) {
+  final view = new Uint32List.view(bytes.buffer, bytes.offsetInBytes + start);
+  var sum = view[0];
+  // Deoptimizes once 'extra' is a double, with the view still live.
+  sum += (extra + 1).toInt();
+  return sum + view[1];
+}
+
+void fillWords(Uint8List bytes, int start, int value) {
+  final view = new Uint32List.view(bytes.buffer, bytes.offsetInBytes + start);
+  for (var i = 0; i < view.length; i++) {
+    view[i] = value + i;
+  }
+}
+
+int readHeader(ByteData data, int offset) {
+  final view = new ByteData.view(data.buffer, data.offsetInBytes + offset, 6);
+  return view.getUint16(0, Endian.little) + view.getUint32(2, Endian.big);
+}
+
+main() {
+  final backing = new Uint8List(64);
+  final bytes = new Uint8List.view(backing.buffer, 8, 48);
+  for (var i = 0; i < 100; i++) {
+    fillWords(bytes, 16, i);
+    Expect.equals(i, new Uint32List.view(backing.buffer, 24)[0]);
+    Expect.equals(i + 1 + (i + 1), sumWords(bytes, 16, 0));
+  }
+  // Deoptimize with a live view and finish in unoptimized code.
+  Expect.equals(99 + 2 + 100, sumWords(bytes, 16, 1.5));
+
+  final data = new ByteData(32);
+  data.setUint16(10, 0x1234, Endian.little);
+  data.setUint32(12, 0x01020304, Endian.big);
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(0x1234 + 0x01020304, readHeader(data, 10));
+  }
+}
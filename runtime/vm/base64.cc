@@ -4,6 +4,7 @@
 
 #include "vm/base64.h"
 
+#include "platform/utils.h"
 #include "vm/os.h"
 
 namespace dart {
@@ -72,4 +73,133 @@ uint8_t* DecodeBase64(Zone* zone, const char* str, intptr_t* out_decoded_len) {
   return bytes;
 }
 
+static const char encode_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char encode_alphabet_url_safe[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+void EncodeBase64(const uint8_t* bytes,
+                  intptr_t length,
+                  bool url_safe,
+                  uint8_t* out) {
+  const char* alphabet = url_safe ? encode_alphabet_url_safe : encode_alphabet;
+  intptr_t i = 0;
+  // Encode six bytes at a time, using a single unaligned load of eight.
+  for (; i + 8 <= length; i += 6) {
+    uint64_t word;
+    memmove(&word, bytes + i, sizeof(word));
+    word = Utils::HostToBigEndian64(word);
+    out[0] = alphabet[(word >> 58) & 0x3F];
+    out[1] = alphabet[(word >> 52) & 0x3F];
+    out[2] = alphabet[(word >> 46) & 0x3F];
+    out[3] = alphabet[(word >> 40) & 0x3F];
+    out[4] = alphabet[(word >> 34) & 0x3F];
+    out[5] = alphabet[(word >> 28) & 0x3F];
+    out[6] = alphabet[(word >> 22) & 0x3F];
+    out[7] = alphabet[(word >> 16) & 0x3F];
+    out += 8;
+  }
+  for (; i + 3 <= length; i += 3) {
+    const uint32_t x = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+    out[0] = alphabet[x >> 18];
+    out[1] = alphabet[(x >> 12) & 0x3F];
+    out[2] = alphabet[(x >> 6) & 0x3F];
+    out[3] = alphabet[x & 0x3F];
+    out += 4;
+  }
+  if (i + 1 == length) {
+    const uint32_t x = bytes[i] << 16;
+    out[0] = alphabet[x >> 18];
+    out[1] = alphabet[(x >> 12) & 0x3F];
+    out[2] = PAD;
+    out[3] = PAD;
+  } else if (i + 2 == length) {
+    const uint32_t x = (bytes[i] << 16) | (bytes[i + 1] << 8);
+    out[0] = alphabet[x >> 18];
+    out[1] = alphabet[(x >> 12) & 0x3F];
+    out[2] = alphabet[(x >> 6) & 0x3F];
+    out[3] = PAD;
+  }
+}
+
+// Lookup table used by DecodeBase64Strict.
+// -1 : Not a character of either alphabet, including the padding character.
+// >=0 : Base 64 alphabet index of given byte.
+static const int8_t strict_decode_table[] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63,  //
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,  //
+    -1, 00, 01, 02, 03, 04, 05, 06, 07, 8,  9,  10, 11, 12, 13, 14,  //
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63,  //
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,  //
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
+static intptr_t PaddingLength(const uint8_t* chars, intptr_t length) {
+  if ((length == 0) || (chars[length - 1] != PAD)) return 0;
+  return (chars[length - 2] == PAD) ? 2 : 1;
+}
+
+intptr_t Base64DecodedLength(const uint8_t* chars, intptr_t length) {
+  if ((length % 4) != 0) {
+    return -1;
+  }
+  return (length / 4) * 3 - PaddingLength(chars, length);
+}
+
+bool DecodeBase64Strict(const uint8_t* chars, intptr_t length, uint8_t* out) {
+  if ((length % 4) != 0) {
+    return false;
+  }
+  const intptr_t pad_length = PaddingLength(chars, length);
+  const intptr_t unpadded_end = (pad_length == 0) ? length : length - 4;
+  // Invalid characters are negative in the table, so or-ing all the looked
+  // up values together gives a single check for the whole input.
+  int32_t check = 0;
+  intptr_t i = 0;
+  for (; i < unpadded_end; i += 4) {
+    const int32_t a = strict_decode_table[chars[i]];
+    const int32_t b = strict_decode_table[chars[i + 1]];
+    const int32_t c = strict_decode_table[chars[i + 2]];
+    const int32_t d = strict_decode_table[chars[i + 3]];
+    check |= a | b | c | d;
+    const uint32_t x = (static_cast<uint32_t>(a) << 18) |
+                       (static_cast<uint32_t>(b) << 12) |
+                       (static_cast<uint32_t>(c) << 6) |
+                       static_cast<uint32_t>(d);
+    out[0] = x >> 16;
+    out[1] = x >> 8;
+    out[2] = x;
+    out += 3;
+  }
+  if (pad_length != 0) {
+    const int32_t a = strict_decode_table[chars[i]];
+    const int32_t b = strict_decode_table[chars[i + 1]];
+    const int32_t c =
+        (pad_length == 1) ? strict_decode_table[chars[i + 2]] : 0;
+    check |= a | b | c;
+    if (check < 0) {
+      return false;
+    }
+    // The bits after the last decoded byte have to be zero.
+    const uint32_t x = (a << 18) | (b << 12) | (c << 6);
+    if ((x & ((pad_length == 1) ? 0xFF : 0xFFFF)) != 0) {
+      return false;
+    }
+    out[0] = x >> 16;
+    if (pad_length == 1) {
+      out[1] = x >> 8;
+    }
+  }
+  return check >= 0;
+}
+
 }  // namespace dart
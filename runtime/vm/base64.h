@@ -11,6 +11,30 @@ namespace dart {
 
 uint8_t* DecodeBase64(Zone* zone, const char* str, intptr_t* out_decoded_len);
 
+// Returns the length of the padded base64 encoding of 'length' bytes.
+inline intptr_t Base64EncodedLength(intptr_t length) {
+  return ((length + 2) / 3) * 4;
+}
+
+// Writes the padded base64 encoding of 'length' bytes to 'out', which must
+// have room for Base64EncodedLength(length) characters. The URL and filename
+// safe alphabet is used if 'url_safe' is true.
+void EncodeBase64(const uint8_t* bytes,
+                  intptr_t length,
+                  bool url_safe,
+                  uint8_t* out);
+
+// Returns the number of bytes encoded by 'length' characters of padded
+// base64, or -1 if 'length' is not a multiple of four.
+intptr_t Base64DecodedLength(const uint8_t* chars, intptr_t length);
+
+// Decodes 'length' characters of padded base64, in either alphabet, to
+// 'out', which must have room for Base64DecodedLength(chars, length) bytes.
+// Returns false if the characters are not a canonical encoding, for example
+// if they are not padded or have non-zero bits before the padding. 'out' is
+// then only partially written.
+bool DecodeBase64Strict(const uint8_t* chars, intptr_t length, uint8_t* out);
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_BASE64_H_
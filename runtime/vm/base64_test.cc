@@ -29,4 +29,61 @@ TEST_CASE(Base64DecodeEmpty) {
   intptr_t decoded_len;
   EXPECT(DecodeBase64(thread->zone(), "", &decoded_len) == nullptr);
 }
+
+static void ExpectEncodes(const char* bytes,
+                          const char* expected,
+                          const char* expected_url_safe) {
+  const intptr_t length = strlen(bytes);
+  const intptr_t encoded_length = Base64EncodedLength(length);
+  EXPECT_EQ(static_cast<intptr_t>(strlen(expected)), encoded_length);
+  uint8_t* out = reinterpret_cast<uint8_t*>(malloc(encoded_length));
+  EncodeBase64(reinterpret_cast<const uint8_t*>(bytes), length, false, out);
+  EXPECT(!memcmp(expected, out, encoded_length));
+  EncodeBase64(reinterpret_cast<const uint8_t*>(bytes), length, true, out);
+  EXPECT(!memcmp(expected_url_safe, out, encoded_length));
+  free(out);
+}
+
+TEST_CASE(Base64Encode) {
+  ExpectEncodes("", "", "");
+  ExpectEncodes("H", "SA==", "SA==");
+  ExpectEncodes("He", "SGU=", "SGU=");
+  ExpectEncodes("Hel", "SGVs", "SGVs");
+  ExpectEncodes("Hello, world!\n", "SGVsbG8sIHdvcmxkIQo=",
+                "SGVsbG8sIHdvcmxkIQo=");
+  ExpectEncodes("\xfb\xff\xbf\xfb\xff\xbf\xfb\xff\xbf", "+/+/+/+/+/+/",
+                "-_-_-_-_-_-_");
+}
+
+static bool DecodesTo(const char* chars, const char* expected) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(chars);
+  const intptr_t length = strlen(chars);
+  const intptr_t decoded_length = Base64DecodedLength(data, length);
+  if (decoded_length != static_cast<intptr_t>(strlen(expected))) {
+    return false;
+  }
+  uint8_t out[64];
+  return DecodeBase64Strict(data, length, out) &&
+         (memcmp(expected, out, decoded_length) == 0);
+}
+
+TEST_CASE(Base64DecodeStrict) {
+  EXPECT(DecodesTo("", ""));
+  EXPECT(DecodesTo("SA==", "H"));
+  EXPECT(DecodesTo("SGU=", "He"));
+  EXPECT(DecodesTo("SGVs", "Hel"));
+  EXPECT(DecodesTo("SGVsbG8sIHdvcmxkIQo=", "Hello, world!\n"));
+  EXPECT(DecodesTo("+/-_", "\xfb\xff\xbf"));
+
+  uint8_t out[64];
+  const char* malformed[] = {"SGV",      "SGVsb",   "SB==", "SGV=",
+                             "S===",     "====",    "SG s", "SG\x80s",
+                             "SA==SGVs", "SGVsbG8sIHdvcmxkIQo%3D"};
+  for (const char* chars : malformed) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(chars);
+    const intptr_t length = strlen(chars);
+    EXPECT((Base64DecodedLength(data, length) < 0) ||
+           !DecodeBase64Strict(data, length, out));
+  }
+}
 }  // namespace dart
@@ -13,8 +13,12 @@
 #include "platform/assert.h"
 #include "platform/globals.h"
 
+#include "include/dart_native_api.h"
+
 #include "vm/clustered_snapshot.h"
 #include "vm/dart_api_impl.h"
+#include "vm/lockers.h"
+#include "vm/os_thread.h"
 #include "vm/stack_frame.h"
 #include "vm/timer.h"
 
@@ -557,6 +561,51 @@ BENCHMARK_SIZE(CoreSnapshotSize) {
   free(isolate_snapshot_data_buffer);
 }
 
+// Measures creating an isolate from a full snapshot of the core libraries.
+// Run with --print_snapshot_load_stats for the time spent on each cluster.
+BENCHMARK(CoreSnapshotLoad) {
+  const char* kScriptChars =
+      "import 'dart:async';\n"
+      "import 'dart:core';\n"
+      "import 'dart:collection';\n"
+      "import 'dart:_internal';\n"
+      "import 'dart:math';\n"
+      "import 'dart:isolate';\n"
+      "import 'dart:mirrors';\n"
+      "import 'dart:typed_data';\n"
+      "\n";
+  const int kNumIterations = 100;
+
+  uint8_t* isolate_snapshot_data_buffer;
+  TestCase::LoadCoreTestScript(kScriptChars, NULL);
+  {
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+
+    Api::CheckAndFinalizePendingClasses(thread);
+
+    FullSnapshotWriter writer(Snapshot::kFull, NULL,
+                              &isolate_snapshot_data_buffer, &malloc_allocator,
+                              NULL, NULL /* image_writer */);
+    writer.WriteFullSnapshot();
+  }
+
+  Timer timer(true, "CoreSnapshotLoad");
+  Isolate* isolate = thread->isolate();
+  Dart_ExitIsolate();
+  for (int i = 0; i < kNumIterations; i++) {
+    timer.Start();
+    TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+    timer.Stop();
+    Dart_ShutdownIsolate();
+  }
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+  Dart_EnterIsolate(reinterpret_cast<Dart_Isolate>(isolate));
+
+  free(isolate_snapshot_data_buffer);
+}
+
 BENCHMARK_SIZE(StandaloneSnapshotSize) {
   const char* kScriptChars =
       "import 'dart:async';\n"
@@ -754,4 +803,432 @@ BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
 
+//
+// Measure isolate messaging end to end, through the port map and the
+// message handlers of both ends.
+//
+static const char* kMessagingScript =
+    "import 'dart:isolate';\n"
+    "import 'dart:typed_data';\n"
+    "RawReceivePort port;\n"
+    "int elapsed;\n"
+    "SendPort echo(SendPort reply, int count) {\n"
+    "  int received = 0;\n"
+    "  port = new RawReceivePort((message) {\n"
+    "    reply.send(message);\n"
+    "    if (++received == count) port.close();\n"
+    "  });\n"
+    "  return port.sendPort;\n"
+    "}\n"
+    "SendPort sink(int count) {\n"
+    "  int received = 0;\n"
+    "  port = new RawReceivePort((message) {\n"
+    "    if (++received == count) port.close();\n"
+    "  });\n"
+    "  return port.sendPort;\n"
+    "}\n"
+    "selfSend(bool typed, int count) {\n"
+    "  var message = typed\n"
+    "      ? new Uint8List(64 * 1024)\n"
+    "      : new List.generate(1024, (i) => [i, i, i, i, i, i, i, i]);\n"
+    "  int received = 0;\n"
+    "  var watch = new Stopwatch()..start();\n"
+    "  port = new RawReceivePort((_) {\n"
+    "    if (++received == count) {\n"
+    "      elapsed = watch.elapsedMicroseconds;\n"
+    "      port.close();\n"
+    "    } else {\n"
+    "      port.sendPort.send(message);\n"
+    "    }\n"
+    "  });\n"
+    "  port.sendPort.send(message);\n"
+    "}\n";
+
+static Dart_Port InvokeForPort(Dart_Handle lib,
+                               const char* name,
+                               intptr_t argc,
+                               Dart_Handle* args) {
+  Dart_Handle send_port = Dart_Invoke(lib, NewString(name), argc, args);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id = ILLEGAL_PORT;
+  EXPECT_VALID(Dart_SendPortGetId(send_port, &port_id));
+  return port_id;
+}
+
+static int CompareLatencies(const int64_t* a, const int64_t* b) {
+  return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+}
+
+static int64_t Percentile(MallocGrowableArray<int64_t>* latencies,
+                          intptr_t percent) {
+  ASSERT(latencies->length() > 0);
+  latencies->Sort(CompareLatencies);
+  return latencies->At((latencies->length() * percent) / 100);
+}
+
+// State of a ping-pong between the benchmark isolate and a native port. The
+// native port's handler records the round trip and sends the next ping.
+struct PingPong {
+  Monitor monitor;
+  Dart_Port echo_port;
+  intptr_t remaining;
+  int64_t sent_at;
+  MallocGrowableArray<int64_t> latencies;
+};
+static PingPong* ping_pong = NULL;
+
+static void PongHandler(Dart_Port dest_port_id, Dart_CObject* message) {
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  MonitorLocker ml(&ping_pong->monitor, false);
+  ping_pong->latencies.Add(now - ping_pong->sent_at);
+  if (--ping_pong->remaining > 0) {
+    ping_pong->sent_at = OS::GetCurrentMonotonicMicros();
+    Dart_PostInteger(ping_pong->echo_port, ping_pong->remaining);
+  } else {
+    ml.Notify();
+  }
+}
+
+// Returns the round trip latencies in microseconds of pings from a native
+// port to the benchmark isolate and back.
+static void RunPingPong(intptr_t count,
+                        MallocGrowableArray<int64_t>* latencies) {
+  Dart_Handle lib = TestCase::LoadTestScript(kMessagingScript, NULL);
+  EXPECT_VALID(lib);
+  PingPong state;
+  state.remaining = count;
+  ping_pong = &state;
+  Dart_Port pong_port = Dart_NewNativePort("Pong", PongHandler, false);
+  Dart_Handle args[2] = {Dart_NewSendPort(pong_port), Dart_NewInteger(count)};
+  state.echo_port = InvokeForPort(lib, "echo", 2, args);
+  {
+    MonitorLocker ml(&state.monitor, false);
+    state.sent_at = OS::GetCurrentMonotonicMicros();
+    Dart_PostInteger(state.echo_port, count);
+  }
+  EXPECT_VALID(Dart_RunLoop());
+  {
+    // The last pong may still be on its way.
+    MonitorLocker ml(&state.monitor, false);
+    while (state.remaining > 0) {
+      ml.Wait();
+    }
+  }
+  Dart_CloseNativePort(pong_port);
+  ping_pong = NULL;
+  for (intptr_t i = 0; i < state.latencies.length(); i++) {
+    latencies->Add(state.latencies[i]);
+  }
+}
+
+BENCHMARK(IsolatePingPong) {
+  const intptr_t kNumPings = 10000;
+  MallocGrowableArray<int64_t> latencies;
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  RunPingPong(kNumPings, &latencies);
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+}
+
+BENCHMARK(IsolatePingPongP50) {
+  const intptr_t kNumPings = 10000;
+  MallocGrowableArray<int64_t> latencies;
+  RunPingPong(kNumPings, &latencies);
+  benchmark->set_score(Percentile(&latencies, 50));
+}
+
+BENCHMARK(IsolatePingPongP99) {
+  const intptr_t kNumPings = 10000;
+  MallocGrowableArray<int64_t> latencies;
+  RunPingPong(kNumPings, &latencies);
+  benchmark->set_score(Percentile(&latencies, 99));
+}
+
+struct FanIn {
+  Monitor monitor;
+  Dart_Port sink_port;
+  intptr_t messages_per_thread;
+  intptr_t running;
+};
+
+static void FanInThread(uword parameter) {
+  FanIn* fan_in = reinterpret_cast<FanIn*>(parameter);
+  for (intptr_t i = 0; i < fan_in->messages_per_thread; i++) {
+    Dart_PostInteger(fan_in->sink_port, i);
+  }
+  MonitorLocker ml(&fan_in->monitor, false);
+  fan_in->running--;
+  ml.Notify();
+}
+
+//
+// Measure 8 native threads posting 12500 messages each to one isolate with
+// Dart_PostInteger. The score is inversely proportional to messages/s.
+//
+BENCHMARK(IsolateFanIn) {
+  const intptr_t kNumThreads = 8;
+  const intptr_t kMessagesPerThread = 12500;
+  Dart_Handle lib = TestCase::LoadTestScript(kMessagingScript, NULL);
+  EXPECT_VALID(lib);
+  FanIn fan_in;
+  Dart_Handle args[1] = {Dart_NewInteger(kNumThreads * kMessagesPerThread)};
+  fan_in.sink_port = InvokeForPort(lib, "sink", 1, args);
+  fan_in.messages_per_thread = kMessagesPerThread;
+  fan_in.running = kNumThreads;
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < kNumThreads; i++) {
+    EXPECT_EQ(0, OSThread::Start("FanIn", FanInThread,
+                                 reinterpret_cast<uword>(&fan_in)));
+  }
+  EXPECT_VALID(Dart_RunLoop());
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  MonitorLocker ml(&fan_in.monitor, false);
+  while (fan_in.running > 0) {
+    ml.Wait();
+  }
+}
+
+// Scores the time to post typed data messages of the given size to the
+// benchmark isolate with Dart_PostCObject and to handle all of them. The
+// number of messages keeps the total at 128MB, between 2 and 100000
+// messages, so the score is inversely proportional to bytes/s.
+static void MessageThroughputBenchmark(Benchmark* benchmark, intptr_t size) {
+  const intptr_t count =
+      Utils::Maximum<intptr_t>(2, Utils::Minimum<intptr_t>(
+                                      100000, (128 * MB) / size));
+  Dart_Handle lib = TestCase::LoadTestScript(kMessagingScript, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1] = {Dart_NewInteger(count)};
+  const Dart_Port sink_port = InvokeForPort(lib, "sink", 1, args);
+  uint8_t* data = reinterpret_cast<uint8_t*>(calloc(size, 1));
+  Dart_CObject message;
+  message.type = Dart_CObject_kTypedData;
+  message.value.as_typed_data.type = Dart_TypedData_kUint8;
+  message.value.as_typed_data.length = size;
+  message.value.as_typed_data.values = data;
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < count; i++) {
+    EXPECT(Dart_PostCObject(sink_port, &message));
+  }
+  EXPECT_VALID(Dart_RunLoop());
+  benchmark->set_score(OS::GetCurrentMonotonicMicros() - start);
+  free(data);
+}
+
+BENCHMARK(IsolateMessageThroughput8B) {
+  MessageThroughputBenchmark(benchmark, 8);
+}
+
+BENCHMARK(IsolateMessageThroughput1KB) {
+  MessageThroughputBenchmark(benchmark, KB);
+}
+
+BENCHMARK(IsolateMessageThroughput64KB) {
+  MessageThroughputBenchmark(benchmark, 64 * KB);
+}
+
+BENCHMARK(IsolateMessageThroughput1MB) {
+  MessageThroughputBenchmark(benchmark, MB);
+}
+
+BENCHMARK(IsolateMessageThroughput64MB) {
+  MessageThroughputBenchmark(benchmark, 64 * MB);
+}
+
+// Scores the time for the benchmark isolate to send 1000 messages of 64KB
+// to itself, either as typed data or as a graph of small lists.
+static void SelfSendBenchmark(Benchmark* benchmark, bool typed) {
+  Dart_Handle lib = TestCase::LoadTestScript(kMessagingScript, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[2] = {Dart_NewBoolean(typed), Dart_NewInteger(1000)};
+  EXPECT_VALID(Dart_Invoke(lib, NewString("selfSend"), 2, args));
+  EXPECT_VALID(Dart_RunLoop());
+  Dart_Handle elapsed = Dart_GetField(lib, NewString("elapsed"));
+  EXPECT_VALID(elapsed);
+  int64_t elapsed_time = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(elapsed, &elapsed_time));
+  benchmark->set_score(elapsed_time);
+}
+
+BENCHMARK(IsolateMessageTypedData) {
+  SelfSendBenchmark(benchmark, true);
+}
+
+BENCHMARK(IsolateMessageObjectGraph) {
+  SelfSendBenchmark(benchmark, false);
+}
+
+//
+// Measure the collectors on fixed heap shapes.
+//
+static const char* kGCScript =
+    "class Node {\n"
+    "  var left;\n"
+    "  var right;\n"
+    "  Node(this.left, this.right);\n"
+    "}\n"
+    "var retained;\n"
+    "allocate(int count, int keepEvery) {\n"
+    "  var kept = new List(count ~/ keepEvery + 1);\n"
+    "  for (int i = 0; i < count; i++) {\n"
+    "    var node = new Node(null, null);\n"
+    "    if (i % keepEvery == 0) kept[i ~/ keepEvery] = node;\n"
+    "  }\n"
+    "  retained = kept;\n"
+    "}\n"
+    "Node makeTree(int depth) {\n"
+    "  if (depth == 0) return new Node(null, null);\n"
+    "  return new Node(makeTree(depth - 1), makeTree(depth - 1));\n"
+    "}\n"
+    "buildTree(int depth) {\n"
+    "  retained = makeTree(depth);\n"
+    "}\n"
+    "fragment(int count) {\n"
+    "  var list = new List(count);\n"
+    "  for (int i = 0; i < count; i++) list[i] = new List(4);\n"
+    "  retained = list;\n"
+    "}\n"
+    "dropEveryOther() {\n"
+    "  for (int i = 0; i < retained.length; i += 2) retained[i] = null;\n"
+    "}\n"
+    "addExpandos(int count) {\n"
+    "  var expando = new Expando();\n"
+    "  var keys = new List(count);\n"
+    "  for (int i = 0; i < count; i++) {\n"
+    "    keys[i] = new Node(null, null);\n"
+    "    expando[keys[i]] = new Node(null, null);\n"
+    "  }\n"
+    "  retained = [expando, keys];\n"
+    "}\n";
+
+static void InvokeGCScript(Dart_Handle lib,
+                           const char* name,
+                           intptr_t argc,
+                           intptr_t arg0,
+                           intptr_t arg1) {
+  Dart_Handle args[2] = {Dart_NewInteger(arg0), Dart_NewInteger(arg1)};
+  Dart_Handle result = Dart_Invoke(lib, NewString(name), argc, args);
+  EXPECT_VALID(result);
+}
+
+// Returns the pause of a single collection of the given type in
+// microseconds.
+static int64_t TimeCollection(Thread* thread,
+                              Heap::GCType type,
+                              Heap::GCReason reason) {
+  TransitionNativeToVM transition(thread);
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  thread->isolate()->heap()->CollectGarbage(type, reason);
+  return OS::GetCurrentMonotonicMicros() - start;
+}
+
+static void CollectAll(Thread* thread) {
+  TransitionNativeToVM transition(thread);
+  thread->isolate()->heap()->CollectAllGarbage();
+}
+
+// Scores the average scavenge pause when every keep_every-th of a fixed
+// number of freshly allocated objects survives.
+static void ScavengePauseBenchmark(Benchmark* benchmark,
+                                   Thread* thread,
+                                   intptr_t keep_every) {
+  const intptr_t kNumObjects = 16 * KB;
+  const intptr_t kNumIterations = 100;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  int64_t elapsed_time = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    // Start each iteration with an empty new space.
+    TimeCollection(thread, Heap::kScavenge, Heap::kNewSpace);
+    InvokeGCScript(lib, "allocate", 2, kNumObjects, keep_every);
+    elapsed_time += TimeCollection(thread, Heap::kScavenge, Heap::kNewSpace);
+  }
+  benchmark->set_score(elapsed_time / kNumIterations);
+}
+
+BENCHMARK(GCScavengePause10) {
+  ScavengePauseBenchmark(benchmark, thread, 10);
+}
+
+BENCHMARK(GCScavengePause50) {
+  ScavengePauseBenchmark(benchmark, thread, 2);
+}
+
+BENCHMARK(GCScavengePause100) {
+  ScavengePauseBenchmark(benchmark, thread, 1);
+}
+
+// Scores the total time to scavenge a fixed amount of live objects, so that
+// the survived bytes per second are inversely proportional to the score.
+BENCHMARK(GCScavengeThroughput) {
+  const intptr_t kNumObjects = 16 * KB;
+  const intptr_t kNumIterations = 200;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  int64_t elapsed_time = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    InvokeGCScript(lib, "allocate", 2, kNumObjects, 1);
+    elapsed_time += TimeCollection(thread, Heap::kScavenge, Heap::kNewSpace);
+  }
+  benchmark->set_score(elapsed_time);
+}
+
+// Scores the average mark-sweep pause for a binary tree of 2^20 nodes in
+// old space.
+BENCHMARK(GCMarkLinkedGraph) {
+  const intptr_t kTreeDepth = 20;
+  const intptr_t kNumIterations = 10;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  InvokeGCScript(lib, "buildTree", 1, kTreeDepth, 0);
+  CollectAll(thread);  // Promote the tree.
+  int64_t elapsed_time = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    elapsed_time += TimeCollection(thread, Heap::kMarkSweep, Heap::kOldSpace);
+  }
+  benchmark->set_score(elapsed_time / kNumIterations);
+}
+
+BENCHMARK_MEMORY(GCMarkLinkedGraphRSS) {
+  const intptr_t kTreeDepth = 20;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  InvokeGCScript(lib, "buildTree", 1, kTreeDepth, 0);
+  CollectAll(thread);
+  benchmark->set_score(bin::Process::MaxRSS());
+}
+
+// Scores the average mark-compact pause for an old space in which every
+// other small object has died.
+BENCHMARK(GCCompactFragmented) {
+  const intptr_t kNumObjects = 512 * KB;
+  const intptr_t kNumIterations = 10;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  int64_t elapsed_time = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    InvokeGCScript(lib, "fragment", 1, kNumObjects, 0);
+    CollectAll(thread);  // Promote the objects.
+    InvokeGCScript(lib, "dropEveryOther", 0, 0, 0);
+    elapsed_time +=
+        TimeCollection(thread, Heap::kMarkCompact, Heap::kOldSpace);
+  }
+  benchmark->set_score(elapsed_time / kNumIterations);
+}
+
+// Scores the time to scavenge and then mark-sweep a heap holding many
+// Expando entries, which are weak properties for the collectors.
+BENCHMARK(GCWeakProperties) {
+  const intptr_t kNumEntries = 64 * KB;
+  const intptr_t kNumIterations = 10;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCScript, NULL);
+  EXPECT_VALID(lib);
+  int64_t elapsed_time = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    InvokeGCScript(lib, "addExpandos", 1, kNumEntries, 0);
+    elapsed_time += TimeCollection(thread, Heap::kScavenge, Heap::kNewSpace);
+    elapsed_time += TimeCollection(thread, Heap::kMarkSweep, Heap::kOldSpace);
+  }
+  benchmark->set_score(elapsed_time / kNumIterations);
+}
+
 }  // namespace dart
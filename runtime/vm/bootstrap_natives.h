@@ -48,6 +48,14 @@ namespace dart {
   V(CapabilityImpl_factory, 1)                                                 \
   V(CapabilityImpl_equals, 2)                                                  \
   V(CapabilityImpl_get_hashcode, 1)                                            \
+  V(TransferableTypedData_factory, 2)                                          \
+  V(TransferableTypedData_materialize, 1)                                      \
+  V(RingBufferChannel_create, 1)                                               \
+  V(RingBufferChannel_attach, 1)                                               \
+  V(RingBufferChannel_getId, 1)                                                \
+  V(RingBufferChannel_write, 4)                                                \
+  V(RingBufferChannel_read, 4)                                                 \
+  V(RingBufferChannel_notifyWhenReadable, 2)                                   \
   V(RawReceivePortImpl_factory, 1)                                             \
   V(RawReceivePortImpl_get_id, 1)                                              \
   V(RawReceivePortImpl_get_sendport, 1)                                        \
@@ -106,12 +114,15 @@ namespace dart {
   V(RegExp_getGroupNameMap, 1)                                                 \
   V(RegExp_ExecuteMatch, 3)                                                    \
   V(RegExp_ExecuteMatchSticky, 3)                                              \
+  V(RegExp_findLiteral, 3)                                                     \
   V(List_new, 2)                                                               \
   V(List_allocate, 2)                                                          \
   V(List_getIndexed, 2)                                                        \
   V(List_setIndexed, 3)                                                        \
   V(List_getLength, 1)                                                         \
   V(List_slice, 4)                                                             \
+  V(List_copyFromObjectArray, 5)                                               \
+  V(List_sort, 2)                                                              \
   V(ImmutableList_from, 4)                                                     \
   V(StringBase_createFromCodePoints, 3)                                        \
   V(StringBase_substringUnchecked, 3)                                          \
@@ -131,7 +142,13 @@ namespace dart {
   V(String_fromEnvironment, 3)                                                 \
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
+  V(String_equalsIgnoreAsciiCase, 2)                                           \
   V(String_concatRange, 3)                                                     \
+  V(JsonDecoder_parse, 2)                                                      \
+  V(Base64Encoder_encode, 3)                                                   \
+  V(Base64Decoder_decode, 3)                                                   \
+  V(Utf8Decoder_convert, 3)                                                    \
+  V(Utf8Decoder_scanOneByteCharacters, 3)                                      \
   V(Math_sqrt, 1)                                                              \
   V(Math_sin, 1)                                                               \
   V(Math_cos, 1)                                                               \
@@ -186,6 +203,10 @@ namespace dart {
   V(TypedData_Float64x2Array_new, 2)                                           \
   V(TypedData_length, 1)                                                       \
   V(TypedData_setRange, 7)                                                     \
+  V(TypedData_fillRange, 5)                                                    \
+  V(TypedData_indexOf, 6)                                                      \
+  V(TypedData_sortRange, 4)                                                    \
+  V(TypedData_convertRange, 7)                                                 \
   V(TypedData_GetInt8, 2)                                                      \
   V(TypedData_SetInt8, 3)                                                      \
   V(TypedData_GetUint8, 2)                                                     \
@@ -324,6 +345,7 @@ namespace dart {
   V(GrowableList_setIndexed, 3)                                                \
   V(GrowableList_getLength, 1)                                                 \
   V(GrowableList_getCapacity, 1)                                               \
+  V(GrowableList_getData, 1)                                                   \
   V(GrowableList_setLength, 2)                                                 \
   V(GrowableList_setData, 2)                                                   \
   V(Internal_unsafeCast, 1)                                                    \
@@ -375,14 +397,16 @@ namespace dart {
   V(Ffi_free, 1)                                                               \
   V(Ffi_load, 1)                                                               \
   V(Ffi_store, 2)                                                              \
+  V(Ffi_loadElement, 2)                                                        \
+  V(Ffi_storeElement, 3)                                                       \
   V(Ffi_address, 1)                                                            \
   V(Ffi_fromAddress, 1)                                                        \
   V(Ffi_elementAt, 2)                                                          \
   V(Ffi_offsetBy, 2)                                                           \
   V(Ffi_cast, 1)                                                               \
   V(Ffi_sizeOf, 0)                                                             \
-  V(Ffi_asFunction, 1)                                                         \
-  V(Ffi_fromFunction, 1)                                                       \
+  V(Ffi_asFunction, 2)                                                         \
+  V(Ffi_fromFunction, 2)                                                       \
   V(Ffi_dl_open, 1)                                                            \
   V(Ffi_dl_lookup, 2)                                                          \
   V(Ffi_dl_getHandle, 1)
@@ -1641,6 +1641,8 @@ class ClearTypeHashVisitor : public ObjectVisitor {
     } else if (obj->IsTypeArguments()) {
       type_args_ ^= obj;
       type_args_.SetHash(0);
+      // The instantiations cache is hashed by the hashes being cleared.
+      type_args_.set_instantiations(Object::zero_array());
     }
   }
 
@@ -71,6 +71,7 @@ namespace dart {
   V(Pointer)                                                                   \
   V(DynamicLibrary)                                                            \
   V(Capability)                                                                \
+  V(TransferableTypedData)                                                     \
   V(ReceivePort)                                                               \
   V(SendPort)                                                                  \
   V(StackTrace)                                                                \
@@ -125,6 +126,7 @@ namespace dart {
   V(Pointer)                                                                   \
   V(NativeFunction)                                                            \
   CLASS_LIST_FFI_TYPE_MARKER(V)                                                \
+  V(ByValue)                                                                   \
   V(NativeType)                                                                \
   V(DynamicLibrary)
 
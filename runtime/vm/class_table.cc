@@ -15,6 +15,19 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_class_table, false, "Print initial class table.");
+#ifndef PRODUCT
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            0,
+            "Allocate instances of a class directly in old space once at least "
+            "this percentage of them survived several consecutive scavenges "
+            "(0 disables pretenuring).");
+DEFINE_FLAG(int,
+            pretenure_scavenges,
+            3,
+            "Number of consecutive scavenges a class must meet "
+            "--pretenure_threshold before it is pretenured.");
+#endif  // !PRODUCT
 
 ClassTable::ClassTable()
     : top_(kNumPredefinedCids),
@@ -22,6 +35,7 @@ ClassTable::ClassTable()
       table_(NULL),
       old_tables_(new MallocGrowableArray<ClassAndSize*>()) {
   NOT_IN_PRODUCT(class_heap_stats_table_ = NULL);
+  NOT_IN_PRODUCT(has_pending_pretenuring_ = false);
   if (Dart::vm_isolate() == NULL) {
     capacity_ = initial_capacity_;
     table_ = reinterpret_cast<ClassAndSize*>(
@@ -56,6 +70,7 @@ ClassTable::ClassTable(ClassTable* original)
       table_(original->table_),
       old_tables_(NULL) {
   NOT_IN_PRODUCT(class_heap_stats_table_ = NULL);
+  NOT_IN_PRODUCT(has_pending_pretenuring_ = false);
 }
 
 ClassTable::~ClassTable() {
@@ -100,33 +115,7 @@ void ClassTable::Register(const Class& cls) {
     }
   } else {
     if (top_ == capacity_) {
-      // Grow the capacity of the class table.
-      // TODO(koda): Add ClassTable::Grow to share code.
-
-#ifndef PRODUCT
-      // Wait for any marking tasks to complete. Allocation stats in the
-      // marker rely on the class table size not changing.
-      Thread* thread = Thread::Current();
-      thread->heap()->WaitForMarkerTasks(thread);
-#endif
-
-      intptr_t new_capacity = capacity_ + capacity_increment_;
-      ClassAndSize* new_table = reinterpret_cast<ClassAndSize*>(
-          malloc(new_capacity * sizeof(ClassAndSize)));  // NOLINT
-      memmove(new_table, table_, capacity_ * sizeof(ClassAndSize));
-#ifndef PRODUCT
-      ClassHeapStats* new_stats_table = reinterpret_cast<ClassHeapStats*>(
-          realloc(class_heap_stats_table_,
-                  new_capacity * sizeof(ClassHeapStats)));  // NOLINT
-#endif
-      for (intptr_t i = capacity_; i < new_capacity; i++) {
-        new_table[i] = ClassAndSize(NULL, 0);
-        NOT_IN_PRODUCT(new_stats_table[i].Initialize());
-      }
-      capacity_ = new_capacity;
-      old_tables_->Add(table_);
-      table_ = new_table;  // TODO(koda): This should use atomics.
-      NOT_IN_PRODUCT(class_heap_stats_table_ = new_stats_table);
+      Grow(top_ + 1);
     }
     ASSERT(top_ < capacity_);
     if (!Class::is_valid_id(top_)) {
@@ -141,38 +130,11 @@ void ClassTable::Register(const Class& cls) {
 
 void ClassTable::AllocateIndex(intptr_t index) {
   if (index >= capacity_) {
-    // Grow the capacity of the class table.
-    // TODO(koda): Add ClassTable::Grow to share code.
-
-#ifndef PRODUCT
-    // Wait for any marking tasks to complete. Allocation stats in the
-    // marker rely on the class table size not changing.
-    Thread* thread = Thread::Current();
-    thread->heap()->WaitForMarkerTasks(thread);
-#endif
-
-    intptr_t new_capacity = index + capacity_increment_;
-    if (!Class::is_valid_id(index) || new_capacity < capacity_) {
+    if (!Class::is_valid_id(index)) {
       FATAL1("Fatal error in ClassTable::Register: invalid index %" Pd "\n",
              index);
     }
-    ClassAndSize* new_table = reinterpret_cast<ClassAndSize*>(
-        malloc(new_capacity * sizeof(ClassAndSize)));  // NOLINT
-    memmove(new_table, table_, capacity_ * sizeof(ClassAndSize));
-#ifndef PRODUCT
-    ClassHeapStats* new_stats_table = reinterpret_cast<ClassHeapStats*>(
-        realloc(class_heap_stats_table_,
-                new_capacity * sizeof(ClassHeapStats)));  // NOLINT
-#endif
-    for (intptr_t i = capacity_; i < new_capacity; i++) {
-      new_table[i] = ClassAndSize(NULL);
-      NOT_IN_PRODUCT(new_stats_table[i].Initialize());
-    }
-    capacity_ = new_capacity;
-    old_tables_->Add(table_);
-    table_ = new_table;  // TODO(koda): This should use atomics.
-    NOT_IN_PRODUCT(class_heap_stats_table_ = new_stats_table);
-    ASSERT(capacity_increment_ >= 1);
+    Grow(index + 1);
   }
 
   ASSERT(table_[index].class_ == NULL);
@@ -181,6 +143,46 @@ void ClassTable::AllocateIndex(intptr_t index) {
   }
 }
 
+void ClassTable::Reserve(intptr_t num_cids) {
+  ASSERT(Thread::Current()->IsMutatorThread());
+  if (num_cids > capacity_) {
+    Grow(num_cids);
+  }
+}
+
+void ClassTable::Grow(intptr_t min_capacity) {
+  ASSERT(min_capacity > capacity_);
+#ifndef PRODUCT
+  // Wait for any marking tasks to complete. Allocation stats in the
+  // marker rely on the class table size not changing.
+  Thread* thread = Thread::Current();
+  thread->heap()->WaitForMarkerTasks(thread);
+#endif
+
+  // Grow by at least half of the current capacity, so that loading many
+  // classes copies the table, and retains the old copy, only a few times.
+  ASSERT(capacity_increment_ >= 1);
+  const intptr_t new_capacity = Utils::Maximum(
+      min_capacity,
+      capacity_ + Utils::Maximum<intptr_t>(capacity_increment_, capacity_ / 2));
+  ClassAndSize* new_table = reinterpret_cast<ClassAndSize*>(
+      malloc(new_capacity * sizeof(ClassAndSize)));  // NOLINT
+  memmove(new_table, table_, capacity_ * sizeof(ClassAndSize));
+#ifndef PRODUCT
+  ClassHeapStats* new_stats_table = reinterpret_cast<ClassHeapStats*>(
+      realloc(class_heap_stats_table_,
+              new_capacity * sizeof(ClassHeapStats)));  // NOLINT
+#endif
+  for (intptr_t i = capacity_; i < new_capacity; i++) {
+    new_table[i] = ClassAndSize(NULL, 0);
+    NOT_IN_PRODUCT(new_stats_table[i].Initialize());
+  }
+  capacity_ = new_capacity;
+  old_tables_->Add(table_);
+  table_ = new_table;  // TODO(koda): This should use atomics.
+  NOT_IN_PRODUCT(class_heap_stats_table_ = new_stats_table);
+}
+
 void ClassTable::Unregister(intptr_t index) {
   table_[index] = ClassAndSize(NULL);
 }
@@ -366,6 +368,30 @@ void ClassHeapStats::UpdatePromotedAfterNewGC() {
   promoted_size = recent.old_size - old_pre_new_gc_size_;
 }
 
+bool ClassHeapStats::UpdatePretenuring() {
+  // Ignore classes with too few instances for the survival rate to be
+  // meaningful.
+  const intptr_t kMinSampleCount = 64;
+  if (pretenure() || (pre_gc.new_count < kMinSampleCount)) {
+    return false;
+  }
+  const intptr_t survival_percent = (promoted_count * 100) / pre_gc.new_count;
+  if (survival_percent < FLAG_pretenure_threshold) {
+    state_ = SurvivalStreakBits::update(0, state_);
+    return false;
+  }
+  const intptr_t streak = SurvivalStreakBits::decode(state_) + 1;
+  if (streak < FLAG_pretenure_scavenges) {
+    if (SurvivalStreakBits::is_valid(streak)) {
+      state_ = SurvivalStreakBits::update(streak, state_);
+    }
+    return false;
+  }
+  set_pretenure(true);
+  set_pretenure_stub_pending(true);
+  return true;
+}
+
 void ClassHeapStats::PrintToJSONObject(const Class& cls,
                                        JSONObject* obj) const {
   if (!FLAG_support_service) {
@@ -461,7 +487,31 @@ void ClassTable::ResetCountersNew() {
 void ClassTable::UpdatePromoted() {
   for (intptr_t i = 0; i < top_; i++) {
     class_heap_stats_table_[i].UpdatePromotedAfterNewGC();
+    if ((FLAG_pretenure_threshold > 0) &&
+        class_heap_stats_table_[i].UpdatePretenuring()) {
+      has_pending_pretenuring_ = true;
+    }
+  }
+}
+
+void ClassTable::ApplyPretenuring(Thread* thread) {
+  // Helper threads leave the stubs to the next mutator scavenge.
+  if (!has_pending_pretenuring_ || !thread->IsMutatorThread()) {
+    return;
+  }
+  has_pending_pretenuring_ = false;
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_DBC)
+  HANDLESCOPE(thread);
+  Class& cls = Class::Handle(thread->zone());
+  for (intptr_t i = 1; i < top_; i++) {
+    ClassHeapStats* stats = &class_heap_stats_table_[i];
+    if (stats->pretenure_stub_pending() && HasValidClassAt(i)) {
+      stats->set_pretenure_stub_pending(false);
+      cls = At(i);
+      cls.DisableAllocationStub();
+    }
   }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_DBC)
 }
 
 intptr_t ClassTable::TableOffsetFor(intptr_t cid) {
@@ -22,6 +22,7 @@ template <typename T>
 class MallocGrowableArray;
 class ObjectPointerVisitor;
 class RawClass;
+class Thread;
 
 class ClassAndSize {
  public:
@@ -156,12 +157,21 @@ class ClassHeapStats {
   }
   static intptr_t state_offset() { return OFFSET_OF(ClassHeapStats, state_); }
   static intptr_t TraceAllocationMask() { return (1 << kTraceAllocationBit); }
+  // Inline allocation fast paths bail out to the runtime when any of these
+  // bits are set: either for tracing or to allocate directly in old space.
+  static intptr_t AllocationSlowPathMask() {
+    return (1 << kTraceAllocationBit) | (1 << kPretenureBit);
+  }
 
   void Initialize();
   void ResetAtNewGC();
   void ResetAtOldGC();
   void ResetAccumulator();
   void UpdatePromotedAfterNewGC();
+  // Uses the survival rate of the last scavenge to decide whether new
+  // instances should be allocated directly in old space. Returns true if the
+  // class became pretenured.
+  bool UpdatePretenuring();
   void UpdateSize(intptr_t instance_size);
 #ifndef PRODUCT
   void PrintToJSONObject(const Class& cls, JSONObject* obj) const;
@@ -174,13 +184,39 @@ class ClassHeapStats {
     state_ = TraceAllocationBit::update(trace_allocation, state_);
   }
 
+  bool pretenure() const { return PretenureBit::decode(state_); }
+
+  void set_pretenure(bool pretenure) {
+    state_ = PretenureBit::update(pretenure, state_);
+  }
+
+  bool pretenure_stub_pending() const {
+    return PretenureStubPendingBit::decode(state_);
+  }
+
+  void set_pretenure_stub_pending(bool pending) {
+    state_ = PretenureStubPendingBit::update(pending, state_);
+  }
+
  private:
   enum StateBits {
     kTraceAllocationBit = 0,
+    kPretenureBit = 1,
+    kPretenureStubPendingBit = 2,
+    kSurvivalStreakPos = 3,
+    kSurvivalStreakSize = 8,
   };
 
   class TraceAllocationBit
       : public BitField<intptr_t, bool, kTraceAllocationBit, 1> {};
+  class PretenureBit : public BitField<intptr_t, bool, kPretenureBit, 1> {};
+  class PretenureStubPendingBit
+      : public BitField<intptr_t, bool, kPretenureStubPendingBit, 1> {};
+  // Number of consecutive scavenges in which most instances survived.
+  class SurvivalStreakBits : public BitField<intptr_t,
+                                             intptr_t,
+                                             kSurvivalStreakPos,
+                                             kSurvivalStreakSize> {};
 
   // Recent old at start of last new GC (used to compute promoted_*).
   intptr_t old_pre_new_gc_count_;
@@ -238,6 +274,10 @@ class ClassTable {
 
   void AllocateIndex(intptr_t index);
 
+  // Grows the table to hold at least 'num_cids' classes, e.g. before reading
+  // the classes of a snapshot, so that they are not added one step at a time.
+  void Reserve(intptr_t num_cids);
+
   void Unregister(intptr_t index);
 
   void Remap(intptr_t* old_to_new_cids);
@@ -311,6 +351,16 @@ class ClassTable {
     ClassHeapStats* stats = PreliminaryStatsAt(cid);
     return stats->trace_allocation();
   }
+
+  bool ShouldPretenure(intptr_t cid) {
+    ClassHeapStats* stats = PreliminaryStatsAt(cid);
+    return stats->pretenure();
+  }
+
+  // Disables the allocation stubs of classes that became pretenured during
+  // the last scavenge, so that their instances are allocated by the runtime.
+  // Must be called by the mutator outside of a GC.
+  void ApplyPretenuring(Thread* thread);
 #endif  // !PRODUCT
 
   void AddOldTable(ClassAndSize* old_table);
@@ -322,6 +372,8 @@ class ClassTable {
   friend class GCMarker;
   friend class MarkingWeakVisitor;
   friend class Scavenger;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class ScavengerWeakVisitor;
   friend class ClassHeapStatsTestHelper;
   friend class HeapTestsHelper;
@@ -330,6 +382,8 @@ class ClassTable {
 
   static bool ShouldUpdateSizeForClassId(intptr_t cid);
 
+  void Grow(intptr_t min_capacity);
+
   intptr_t top_;
   intptr_t capacity_;
 
@@ -339,6 +393,9 @@ class ClassTable {
 
 #ifndef PRODUCT
   ClassHeapStats* class_heap_stats_table_;
+  // Set when some class became pretenured and its allocation stub still needs
+  // to be disabled by ApplyPretenuring.
+  bool has_pending_pretenuring_;
 
   // May not have updated size for variable size classes.
   ClassHeapStats* PreliminaryStatsAt(intptr_t cid) {
@@ -5,18 +5,22 @@
 #include "vm/clustered_snapshot.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/bootstrap.h"
 #include "vm/compiler/backend/code_statistics.h"
 #include "vm/compiler/relocation.h"
 #include "vm/dart.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/interpreter.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/version.h"
 
@@ -24,6 +28,78 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            concurrent_snapshot_fill,
+            true,
+            "Initialize the objects of large snapshots on helper threads.");
+
+// Snapshots with less fill data than this are filled on the current thread.
+static const intptr_t kMinConcurrentFillSize = 512 * KB;
+
+DEFINE_FLAG(bool,
+            print_snapshot_load_stats,
+            false,
+            "Print the number of objects, size and load time of each cluster "
+            "of the snapshots read.");
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DEFINE_FLAG(bool,
+            read_only_number_constants,
+            false,
+            "Write the canonical ints and doubles of snapshots with code into "
+            "the read-only data image, where they are shared by all isolates "
+            "loading the snapshot instead of being copied into each heap.");
+
+// Canonical mints and doubles have no pointer fields and are never mutated,
+// so they can live in the data image like strings and PcDescriptors.
+static bool IsReadOnlyNumber(Serializer* s, RawObject* object) {
+  return FLAG_read_only_number_constants &&
+         Snapshot::IncludesCode(s->kind()) && object->IsCanonical() &&
+         !object->InVMIsolateHeap() &&
+         !s->isolate()->heap()->old_space()->IsObjectFromImagePages(object);
+}
+
+static void WriteReadOnlyNumbers(Serializer* s,
+                                 const GrowableArray<RawObject*>& objects) {
+  const intptr_t count = objects.length();
+  s->WriteUnsigned(count);
+  uint32_t running_offset = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    RawObject* object = objects[i];
+    s->AssignRef(object);
+    s->TraceStartWritingObject("(RO)number", object, nullptr);
+    uint32_t offset;
+    if (s->GetSharedDataOffset(object, &offset)) {
+      // Offsets into the shared image are tagged with the low bit, which is
+      // otherwise always clear.
+      s->WriteUnsigned((offset << 1) | 1);
+    } else {
+      offset = s->GetDataOffset(object);
+      s->TraceDataOffset(offset);
+      ASSERT(Utils::IsAligned(offset, kObjectAlignment));
+      ASSERT(offset > running_offset);
+      s->WriteUnsigned((offset - running_offset) << 1);
+      running_offset = offset;
+    }
+    s->TraceEndWritingObject();
+  }
+}
+#endif  // !DART_PRECOMPILED_RUNTIME
+
+static void ReadReadOnlyNumbers(Deserializer* d) {
+  const intptr_t count = d->ReadUnsigned();
+  uint32_t running_offset = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    const uint32_t encoded = d->ReadUnsigned();
+    if ((encoded & 1) != 0) {
+      d->AssignRef(d->GetSharedObjectAt(encoded >> 1));
+    } else {
+      running_offset += encoded >> 1;
+      d->AssignRef(d->GetObjectAt(running_offset));
+    }
+  }
+}
+
 #if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32) &&                 \
     !defined(TARGET_ARCH_DBC)
 
@@ -56,6 +132,114 @@ class RawCodeKeyValueTrait {
 
 typedef DirectChainedHashMap<RawCodeKeyValueTrait> RawCodeSet;
 
+DEFINE_FLAG(charp,
+            instructions_order,
+            nullptr,
+            "Place the code of the functions listed in the given file, one "
+            "qualified name per line (see --write_startup_order_to), at the "
+            "start of the instructions image in the listed order.");
+
+class FunctionRankTrait {
+ public:
+  struct Pair {
+    const char* name = nullptr;
+    // 1-based, 0 is reserved for the empty pair.
+    intptr_t rank = 0;
+  };
+  typedef const char* Key;
+  typedef intptr_t Value;
+
+  static Key KeyOf(const Pair& kv) { return kv.name; }
+  static Value ValueOf(const Pair& kv) { return kv.rank; }
+  static intptr_t Hashcode(Key key) { return String::Hash(key, strlen(key)); }
+  static bool IsKeyEqual(const Pair& kv, Key key) {
+    return strcmp(kv.name, key) == 0;
+  }
+};
+
+struct RankedCode {
+  RawCode* code;
+  intptr_t rank;
+};
+
+static int CompareRankedCode(const RankedCode* a, const RankedCode* b) {
+  return (a->rank < b->rank) ? -1 : ((a->rank > b->rank) ? 1 : 0);
+}
+
+// Moves the code of the functions listed in --instructions_order to the
+// front of [code_objects], so that the instructions which run at startup
+// share as few pages as possible. The order of all other code is kept.
+static void OrderCodeObjectsByStartupProfile(
+    GrowableArray<RawCode*>* code_objects) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    return;
+  }
+  void* file = file_open(FLAG_instructions_order, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("Failed to open file %s\n", FLAG_instructions_order);
+    return;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = 0;
+  file_read(&data, &length, file);
+  file_close(file);
+  if (data == nullptr) return;
+
+  Zone* zone = Thread::Current()->zone();
+  char* names = zone->Alloc<char>(length + 1);
+  memmove(names, data, length);
+  names[length] = '\0';
+  free(data);
+
+  DirectChainedHashMap<FunctionRankTrait> ranks;
+  intptr_t next_rank = 1;
+  for (char* line = names; *line != '\0';) {
+    char* end = strchr(line, '\n');
+    if (end != nullptr) *end = '\0';
+    if ((*line != '\0') && !ranks.HasKey(line)) {
+      FunctionRankTrait::Pair pair;
+      pair.name = line;
+      pair.rank = next_rank++;
+      ranks.Insert(pair);
+    }
+    if (end == nullptr) break;
+    line = end + 1;
+  }
+
+  GrowableArray<RankedCode> listed(zone, ranks.Length());
+  GrowableArray<RawCode*> unlisted(zone, code_objects->length());
+  Code& code = Code::Handle(zone);
+  Object& owner = Object::Handle(zone);
+  for (intptr_t i = 0; i < code_objects->length(); i++) {
+    code = (*code_objects)[i];
+    owner = code.owner();
+    intptr_t rank = 0;
+    if (owner.IsFunction()) {
+      rank = ranks.LookupValue(Function::Cast(owner).ToQualifiedCString());
+    }
+    if (rank == 0) {
+      unlisted.Add(code.raw());
+    } else {
+      RankedCode ranked = {code.raw(), rank};
+      listed.Add(ranked);
+    }
+  }
+  listed.Sort(CompareRankedCode);
+
+  intptr_t i = 0;
+  for (intptr_t j = 0; j < listed.length(); j++) {
+    (*code_objects)[i++] = listed[j].code;
+  }
+  for (intptr_t j = 0; j < unlisted.length(); j++) {
+    (*code_objects)[i++] = unlisted[j];
+  }
+  ASSERT(i == code_objects->length());
+}
+
 #endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32) &&          \
         // !defined(TARGET_ARCH_DBC)
 
@@ -199,6 +383,9 @@ class ClassDeserializationCluster : public DeserializationCluster {
   ClassDeserializationCluster() {}
   ~ClassDeserializationCluster() {}
 
+  // Registers the classes in the class table.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     predefined_start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -215,6 +402,8 @@ class ClassDeserializationCluster : public DeserializationCluster {
 
     start_index_ = d->next_index();
     count = d->ReadUnsigned();
+    // The new classes get ids after the ones already in the table.
+    table->Reserve(table->NumCids() + count);
     for (intptr_t i = 0; i < count; i++) {
       d->AssignRef(AllocateUninitialized(old_space, Class::InstanceSize()));
     }
@@ -465,7 +654,7 @@ class FunctionSerializationCluster : public SerializationCluster {
     } else if (kind == Snapshot::kFullJIT) {
       NOT_IN_PRECOMPILED(s->Push(func->ptr()->unoptimized_code_));
       NOT_IN_PRECOMPILED(s->Push(func->ptr()->bytecode_));
-      s->Push(func->ptr()->code_);
+      s->Push(CodeOf(s, func));
       s->Push(func->ptr()->ic_data_array_);
     }
   }
@@ -494,7 +683,7 @@ class FunctionSerializationCluster : public SerializationCluster {
       } else if (s->kind() == Snapshot::kFullJIT) {
         NOT_IN_PRECOMPILED(WriteField(func, unoptimized_code_));
         NOT_IN_PRECOMPILED(WriteField(func, bytecode_));
-        WriteField(func, code_);
+        WriteFieldValue(code_, CodeOf(s, func));
         WriteField(func, ic_data_array_);
       }
 
@@ -511,6 +700,24 @@ class FunctionSerializationCluster : public SerializationCluster {
   }
 
  private:
+  // The current code of [func] as written to a JIT snapshot. With
+  // stable_code_only, optimized code which did not survive in this process
+  // is replaced by the unoptimized code, or by the lazy compile stub if there
+  // is none.
+  static RawCode* CodeOf(Serializer* s, RawFunction* func) {
+    RawCode* code = func->ptr()->code_;
+    if (!s->stable_code_only() || !Code::IsOptimized(code)) return code;
+    if ((func->ptr()->deoptimization_counter_ == 0) &&
+        !Code::IsDisabled(code)) {
+      return code;
+    }
+    RawCode* unoptimized_code = func->ptr()->unoptimized_code_;
+    if (unoptimized_code == Code::null()) {
+      return StubCode::LazyCompile().raw();
+    }
+    return unoptimized_code;
+  }
+
   GrowableArray<RawFunction*> objects_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
@@ -1403,6 +1610,33 @@ class CodeDeserializationCluster : public DeserializationCluster {
   CodeDeserializationCluster() {}
   ~CodeDeserializationCluster() {}
 
+  // Computes the entry points like Instructions::EntryPoint and friends, but
+  // from the data in the snapshot. The instructions are not touched, so that
+  // the pages of the text image are only mapped in once code on them runs
+  // or is inspected.
+  static RawInstructions* ReadInstructionsAndSetEntryPoints(Deserializer* d,
+                                                            RawCode* code) {
+    bool has_single_entry_point;
+    uint32_t unchecked_offset;
+    RawInstructions* instr =
+        d->ReadInstructions(&has_single_entry_point, &unchecked_offset);
+    const uword payload = Instructions::PayloadStart(instr);
+    const uword monomorphic_offset =
+        has_single_entry_point ? 0 : Instructions::kMonomorphicEntryOffset;
+    const uword polymorphic_offset =
+        has_single_entry_point ? 0 : Instructions::kPolymorphicEntryOffset;
+    code->ptr()->entry_point_ = payload + monomorphic_offset;
+    code->ptr()->monomorphic_entry_point_ = payload + polymorphic_offset;
+    code->ptr()->unchecked_entry_point_ =
+        payload + unchecked_offset + monomorphic_offset;
+    code->ptr()->monomorphic_unchecked_entry_point_ =
+        payload + unchecked_offset + polymorphic_offset;
+    ASSERT(code->ptr()->entry_point_ == Instructions::EntryPoint(instr));
+    ASSERT(code->ptr()->unchecked_entry_point_ ==
+           Instructions::UncheckedEntryPoint(instr));
+    return instr;
+  }
+
   void ReadAlloc(Deserializer* d) {
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -1445,27 +1679,14 @@ class CodeDeserializationCluster : public DeserializationCluster {
       RawCode* code = reinterpret_cast<RawCode*>(d->Ref(id));
       Deserializer::InitializeHeader(code, kCodeCid, Code::InstanceSize(0));
 
-      RawInstructions* instr = d->ReadInstructions();
-
-      code->ptr()->entry_point_ = Instructions::EntryPoint(instr);
-      code->ptr()->monomorphic_entry_point_ =
-          Instructions::MonomorphicEntryPoint(instr);
-      code->ptr()->unchecked_entry_point_ =
-          Instructions::UncheckedEntryPoint(instr);
-      code->ptr()->monomorphic_unchecked_entry_point_ =
-          Instructions::MonomorphicUncheckedEntryPoint(instr);
+      RawInstructions* instr = ReadInstructionsAndSetEntryPoints(d, code);
       NOT_IN_PRECOMPILED(code->ptr()->active_instructions_ = instr);
       code->ptr()->instructions_ = instr;
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
       if (d->kind() == Snapshot::kFullJIT) {
-        RawInstructions* instr = d->ReadInstructions();
-        code->ptr()->active_instructions_ = instr;
-        code->ptr()->entry_point_ = Instructions::EntryPoint(instr);
-        code->ptr()->monomorphic_entry_point_ =
-            Instructions::MonomorphicEntryPoint(instr);
-        code->ptr()->unchecked_entry_point_ =
-            Instructions::UncheckedEntryPoint(instr);
+        code->ptr()->active_instructions_ =
+            ReadInstructionsAndSetEntryPoints(d, code);
       }
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -1587,8 +1808,10 @@ class BytecodeDeserializationCluster : public DeserializationCluster {
     for (intptr_t i = start_index_; i < stop_index_; i++) {
       bytecode ^= refs.At(i);
       binary = bytecode.GetBinary(zone);
-      bytecode.set_instructions(reinterpret_cast<uword>(
-          binary.DataAddr(bytecode.instructions_binary_offset())));
+      bytecode.set_instructions(Interpreter::FuseSuperinstructions(
+          reinterpret_cast<uword>(
+              binary.DataAddr(bytecode.instructions_binary_offset())),
+          bytecode.Size()));
     }
   }
 };
@@ -3091,6 +3314,9 @@ class MintSerializationCluster : public SerializationCluster {
     if (!object->IsHeapObject()) {
       RawSmi* smi = Smi::RawCast(object);
       smis_.Add(smi);
+    } else if (IsReadOnlyNumber(s, object)) {
+      Object::FinalizeReadOnlyObject(object);
+      read_only_mints_.Add(object);
     } else {
       RawMint* mint = Mint::RawCast(object);
       mints_.Add(mint);
@@ -3115,6 +3341,7 @@ class MintSerializationCluster : public SerializationCluster {
       s->Write<bool>(mint->IsCanonical());
       s->Write<int64_t>(mint->ptr()->value_);
     }
+    WriteReadOnlyNumbers(s, read_only_mints_);
   }
 
   void WriteFill(Serializer* s) {}
@@ -3122,6 +3349,7 @@ class MintSerializationCluster : public SerializationCluster {
  private:
   GrowableArray<RawSmi*> smis_;
   GrowableArray<RawMint*> mints_;
+  GrowableArray<RawObject*> read_only_mints_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -3149,6 +3377,7 @@ class MintDeserializationCluster : public DeserializationCluster {
         d->AssignRef(mint);
       }
     }
+    ReadReadOnlyNumbers(d);
     stop_index_ = d->next_index();
   }
 
@@ -3175,6 +3404,11 @@ class DoubleSerializationCluster : public SerializationCluster {
   ~DoubleSerializationCluster() {}
 
   void Trace(Serializer* s, RawObject* object) {
+    if (IsReadOnlyNumber(s, object)) {
+      Object::FinalizeReadOnlyObject(object);
+      read_only_objects_.Add(object);
+      return;
+    }
     RawDouble* dbl = Double::RawCast(object);
     objects_.Add(dbl);
   }
@@ -3187,6 +3421,7 @@ class DoubleSerializationCluster : public SerializationCluster {
       RawDouble* dbl = objects_[i];
       s->AssignRef(dbl);
     }
+    WriteReadOnlyNumbers(s, read_only_objects_);
   }
 
   void WriteFill(Serializer* s) {
@@ -3201,6 +3436,7 @@ class DoubleSerializationCluster : public SerializationCluster {
 
  private:
   GrowableArray<RawDouble*> objects_;
+  GrowableArray<RawObject*> read_only_objects_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -3217,6 +3453,8 @@ class DoubleDeserializationCluster : public DeserializationCluster {
       d->AssignRef(AllocateUninitialized(old_space, Double::InstanceSize()));
     }
     stop_index_ = d->next_index();
+    // Not part of [start_index_, stop_index_): these need no filling.
+    ReadReadOnlyNumbers(d);
   }
 
   void ReadFill(Deserializer* d) {
@@ -3662,6 +3900,7 @@ class RegExpDeserializationCluster : public DeserializationCluster {
                                      RegExp::InstanceSize());
       ReadFromTo(regexp);
       regexp->ptr()->num_registers_ = d->Read<int32_t>();
+      regexp->ptr()->execution_count_ = 0;
       regexp->ptr()->type_flags_ = d->Read<int8_t>();
     }
   }
@@ -3804,6 +4043,9 @@ class LinkedHashMapDeserializationCluster : public DeserializationCluster {
   LinkedHashMapDeserializationCluster() {}
   ~LinkedHashMapDeserializationCluster() {}
 
+  // Allocates the data arrays of the maps.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -4337,6 +4579,12 @@ void Serializer::WriteInstructions(RawInstructions* instr, RawCode* code) {
     UnexpectedObject(code, "Expected instructions to reuse");
   }
   Write<int32_t>(offset);
+  // The entry point data, so that the deserializer does not have to read the
+  // header of every Instructions object in the text image.
+  WriteUnsigned(
+      (static_cast<intptr_t>(instr->ptr()->unchecked_entrypoint_pc_offset_)
+       << 1) |
+      (Instructions::HasSingleEntryPoint(instr) ? 1 : 0));
 
   // If offset < 0, it's pointing to a shared instruction. We don't profile
   // references to shared text/data (since they don't consume any space). Of
@@ -4553,6 +4801,10 @@ void Serializer::Serialize() {
         static_cast<CodeSerializationCluster*>(clusters_by_cid_[kCodeCid])
             ->discovered_objects();
 
+    if (!vm_ && (FLAG_instructions_order != nullptr)) {
+      OrderCodeObjectsByStartupProfile(code_objects);
+    }
+
     GrowableArray<ImageWriterCommand> writer_commands;
     RelocateCodeObjects(vm_, code_objects, &writer_commands);
     image_writer_->PrepareForSerialization(&writer_commands);
@@ -4618,15 +4870,30 @@ void Serializer::Serialize() {
   // We should have assigned a ref to every object we pushed.
   ASSERT((next_ref_index_ - 1) == num_objects);
 
+  // Reserve the table of fill sizes, it is written once they are known.
+  const intptr_t fill_sizes_position = bytes_written();
+  for (intptr_t i = 0; i < num_clusters; i++) {
+    Write<int32_t>(0);
+  }
+  GrowableArray<intptr_t> fill_sizes(zone_, num_clusters);
   for (intptr_t cid = 1; cid < num_cids_; cid++) {
     SerializationCluster* cluster = clusters_by_cid_[cid];
     if (cluster != NULL) {
+      const intptr_t start = bytes_written();
       cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
       Write<int32_t>(kSectionMarker);
 #endif
+      fill_sizes.Add(bytes_written() - start);
     }
   }
+  ASSERT(fill_sizes.length() == num_clusters);
+  const intptr_t fill_end_position = bytes_written();
+  stream_.SetPosition(fill_sizes_position);
+  for (intptr_t i = 0; i < num_clusters; i++) {
+    Write<int32_t>(fill_sizes[i]);
+  }
+  stream_.SetPosition(fill_end_position);
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_print_snapshot_sizes_verbose) {
@@ -5069,9 +5336,19 @@ RawApiError* FullSnapshotReader::ConvertToApiError(char* message) {
   return ApiError::New(msg, Heap::kOld);
 }
 
-RawInstructions* Deserializer::ReadInstructions() {
+RawInstructions* Deserializer::ReadInstructions(
+    bool* has_single_entry_point,
+    uint32_t* unchecked_entrypoint_pc_offset) {
   int32_t offset = Read<int32_t>();
-  return image_reader_->GetInstructionsAt(offset);
+  const intptr_t entry_point_data = ReadUnsigned();
+  *has_single_entry_point = (entry_point_data & 1) != 0;
+  *unchecked_entrypoint_pc_offset =
+      static_cast<uint32_t>(entry_point_data >> 1);
+  RawInstructions* instr = image_reader_->GetInstructionsAt(offset);
+  ASSERT(Instructions::HasSingleEntryPoint(instr) == *has_single_entry_point);
+  ASSERT(instr->ptr()->unchecked_entrypoint_pc_offset_ ==
+         *unchecked_entrypoint_pc_offset);
+  return instr;
 }
 
 RawObject* Deserializer::GetObjectAt(uint32_t offset) const {
@@ -5090,6 +5367,15 @@ void Deserializer::Prepare() {
 
   clusters_ = new DeserializationCluster*[num_clusters_];
   refs_ = Array::New(num_objects_ + 1, Heap::kOld);
+
+  bool record_stats = FLAG_print_snapshot_load_stats;
+#if defined(SUPPORT_TIMELINE)
+  record_stats = record_stats || Timeline::GetIsolateStream()->enabled();
+#endif
+  if (record_stats) {
+    load_stats_ = zone_->Alloc<ClusterLoadStats>(num_clusters_);
+    memset(load_stats_, 0, num_clusters_ * sizeof(ClusterLoadStats));
+  }
 }
 
 void Deserializer::Deserialize() {
@@ -5100,8 +5386,21 @@ void Deserializer::Deserialize() {
   }
 
   for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (load_stats_ != nullptr) {
+      const intptr_t position = stream_.Position();
+      load_stats_[i].cid = ReadCid();
+      stream_.SetPosition(position);
+      load_stats_[i].num_objects = -next_ref_index_;
+      load_stats_[i].alloc_size = -position;
+      load_stats_[i].alloc_start = OS::GetCurrentMonotonicMicros();
+    }
     clusters_[i] = ReadCluster();
     clusters_[i]->ReadAlloc(this);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].alloc_end = OS::GetCurrentMonotonicMicros();
+      load_stats_[i].num_objects += next_ref_index_;
+      load_stats_[i].alloc_size += stream_.Position();
+    }
 #if defined(DEBUG)
     intptr_t serializers_next_ref_index_ = Read<int32_t>();
     ASSERT(serializers_next_ref_index_ == next_ref_index_);
@@ -5111,13 +5410,217 @@ void Deserializer::Deserialize() {
   // We should have completely filled the ref array.
   ASSERT((next_ref_index_ - 1) == num_objects_);
 
+  intptr_t* fill_offsets = zone_->Alloc<intptr_t>(num_clusters_ + 1);
+  intptr_t offset = stream_.Position() + num_clusters_ * sizeof(int32_t);
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    fill_offsets[i] = offset;
+    offset += Read<int32_t>();
+  }
+  fill_offsets[num_clusters_] = offset;
+  if (load_stats_ != nullptr) {
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      load_stats_[i].fill_size = fill_offsets[i + 1] - fill_offsets[i];
+    }
+  }
+
+  if (FLAG_concurrent_snapshot_fill &&
+      ((fill_offsets[num_clusters_] - fill_offsets[0]) >=
+       kMinConcurrentFillSize) &&
+      (OS::NumberOfAvailableProcessors() > 1)) {
+    FillClustersConcurrently(fill_offsets);
+    stream_.SetPosition(fill_offsets[num_clusters_]);
+    return;
+  }
+
   for (intptr_t i = 0; i < num_clusters_; i++) {
+    ASSERT(stream_.Position() == fill_offsets[i]);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_start = OS::GetCurrentMonotonicMicros();
+    }
+    clusters_[i]->ReadFill(this);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_end = OS::GetCurrentMonotonicMicros();
+    }
+#if defined(DEBUG)
+    int32_t section_marker = Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+  }
+}
+
+Deserializer::Deserializer(Deserializer* parent, intptr_t position)
+    : ThreadStackResource(nullptr),
+      heap_(parent->heap_),
+      zone_(nullptr),
+      kind_(parent->kind_),
+      stream_(parent->stream_.AddressOfCurrentPosition() -
+                  parent->stream_.Position(),
+              parent->stream_.Position() + parent->stream_.PendingBytes()),
+      image_reader_(parent->image_reader_),
+      num_base_objects_(parent->num_base_objects_),
+      num_objects_(parent->num_objects_),
+      num_clusters_(0),
+      refs_(parent->refs_),
+      next_ref_index_(parent->next_ref_index_),
+      clusters_(NULL) {
+  stream_.SetPosition(position);
+}
+
+class FillClustersTask : public ThreadPool::Task {
+ public:
+  FillClustersTask(Deserializer* deserializer,
+                   const intptr_t* fill_offsets,
+                   intptr_t* next_cluster,
+                   Monitor* monitor,
+                   intptr_t* pending_tasks)
+      : deserializer_(deserializer),
+        fill_offsets_(fill_offsets),
+        next_cluster_(next_cluster),
+        monitor_(monitor),
+        pending_tasks_(pending_tasks) {}
+
+  void Run() {
+    deserializer_->FillClusters(fill_offsets_, next_cluster_);
+    MonitorLocker ml(monitor_);
+    if (--(*pending_tasks_) == 0) {
+      ml.Notify();
+    }
+  }
+
+ private:
+  Deserializer* deserializer_;
+  const intptr_t* fill_offsets_;
+  intptr_t* next_cluster_;
+  Monitor* monitor_;
+  intptr_t* pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(FillClustersTask);
+};
+
+void Deserializer::FillClustersConcurrently(const intptr_t* fill_offsets) {
+  // Fill the clusters which have to be filled on this thread first, the
+  // helper readers take the snapshot bounds from [stream_].
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (clusters_[i]->CanFillConcurrently()) continue;
+    stream_.SetPosition(fill_offsets[i]);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_start = OS::GetCurrentMonotonicMicros();
+    }
     clusters_[i]->ReadFill(this);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_end = OS::GetCurrentMonotonicMicros();
+    }
 #if defined(DEBUG)
     int32_t section_marker = Read<int32_t>();
     ASSERT(section_marker == kSectionMarker);
 #endif
   }
+
+  intptr_t next_cluster = 0;
+  Monitor monitor;
+  intptr_t pending_tasks = Utils::Minimum<intptr_t>(
+      OS::NumberOfAvailableProcessors() - 1, num_clusters_);
+  const intptr_t num_tasks = pending_tasks;
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    if (!Dart::thread_pool()->Run(new FillClustersTask(
+            this, fill_offsets, &next_cluster, &monitor, &pending_tasks))) {
+      MonitorLocker ml(&monitor);
+      pending_tasks--;
+    }
+  }
+
+  FillClusters(fill_offsets, &next_cluster);
+  MonitorLocker ml(&monitor);
+  while (pending_tasks > 0) {
+    ml.Wait();
+  }
+}
+
+void Deserializer::FillClusters(const intptr_t* fill_offsets,
+                                intptr_t* next_cluster) {
+  for (;;) {
+    const intptr_t i = AtomicOperations::FetchAndIncrement(next_cluster);
+    if (i >= num_clusters_) break;
+    if (!clusters_[i]->CanFillConcurrently()) continue;
+    Deserializer reader(this, fill_offsets[i]);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_start = OS::GetCurrentMonotonicMicros();
+    }
+    clusters_[i]->ReadFill(&reader);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].fill_end = OS::GetCurrentMonotonicMicros();
+    }
+#if defined(DEBUG)
+    int32_t section_marker = reader.Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+  }
+}
+
+void Deserializer::PostLoadClusters(const Array& refs) {
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (load_stats_ != nullptr) {
+      load_stats_[i].post_load_start = OS::GetCurrentMonotonicMicros();
+    }
+    clusters_[i]->PostLoad(refs, kind_, zone_);
+    if (load_stats_ != nullptr) {
+      load_stats_[i].post_load_end = OS::GetCurrentMonotonicMicros();
+    }
+  }
+  if (load_stats_ != nullptr) {
+    ReportLoadStats();
+  }
+}
+
+void Deserializer::ReportLoadStats() {
+  ClassTable* class_table = thread()->isolate()->class_table();
+  Class& cls = Class::Handle(zone_);
+  String& cls_name = String::Handle(zone_);
+  if (FLAG_print_snapshot_load_stats) {
+    OS::PrintErr(
+        "             Cluster   Objs AllocSize  FillSize  Alloc(us)   "
+        "Fill(us) PostLoad(us)\n");
+  }
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    const ClusterLoadStats& stats = load_stats_[i];
+    const char* name = "<unknown>";
+    if (class_table->HasValidClassAt(stats.cid)) {
+      cls = class_table->At(stats.cid);
+      cls_name = cls.Name();
+      if (!cls_name.IsNull()) name = cls_name.ToCString();
+    }
+    if (FLAG_print_snapshot_load_stats) {
+      OS::PrintErr("%20s %6" Pd " %9" Pd " %9" Pd " %10" Pd64 " %10" Pd64
+                   " %12" Pd64 "\n",
+                   name, stats.num_objects, stats.alloc_size, stats.fill_size,
+                   stats.alloc_end - stats.alloc_start,
+                   stats.fill_end - stats.fill_start,
+                   stats.post_load_end - stats.post_load_start);
+    }
+#if defined(SUPPORT_TIMELINE)
+    TimelineStream* stream = Timeline::GetIsolateStream();
+    const struct {
+      const char* label;
+      int64_t start;
+      int64_t end;
+      intptr_t size;
+    } phases[] = {
+        {"ReadAlloc", stats.alloc_start, stats.alloc_end, stats.alloc_size},
+        {"ReadFill", stats.fill_start, stats.fill_end, stats.fill_size},
+        {"PostLoad", stats.post_load_start, stats.post_load_end, 0},
+    };
+    for (const auto& phase : phases) {
+      TimelineEvent* event = stream->StartEvent();
+      if (event == nullptr) break;
+      event->Duration(phase.label, phase.start, phase.end);
+      event->SetNumArguments(3);
+      event->CopyArgument(0, "cluster", name);
+      event->FormatArgument(1, "objects", "%" Pd, stats.num_objects);
+      event->FormatArgument(2, "bytes", "%" Pd, phase.size);
+      event->Complete();
+    }
+#endif  // defined(SUPPORT_TIMELINE)
+  }
 }
 
 class HeapLocker : public StackResource {
@@ -5232,9 +5735,7 @@ void Deserializer::ReadVMSnapshot() {
   isolate()->ValidateClassTable();
 #endif
 
-  for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i]->PostLoad(refs, kind_, zone_);
-  }
+  PostLoadClusters(refs);
 }
 
 void Deserializer::ReadIsolateSnapshot(ObjectStore* object_store) {
@@ -5278,9 +5779,7 @@ void Deserializer::ReadIsolateSnapshot(ObjectStore* object_store) {
   isolate->heap()->Verify();
 #endif
 
-  for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i]->PostLoad(refs, kind_, zone_);
-  }
+  PostLoadClusters(refs);
 
   // Setup native resolver for bootstrap impl.
   Bootstrap::SetupNativeResolver();
@@ -5372,6 +5871,7 @@ void FullSnapshotWriter::WriteIsolateSnapshot(intptr_t num_base_objects) {
   Serializer serializer(thread(), kind_, isolate_snapshot_data_buffer_, alloc_,
                         kInitialSize, isolate_image_writer_, /*vm=*/false,
                         profile_writer_);
+  serializer.set_stable_code_only(stable_code_only_);
   ObjectStore* object_store = isolate()->object_store();
   ASSERT(object_store != NULL);
 
@@ -5522,6 +6022,7 @@ RawApiError* FullSnapshotReader::ReadVMSnapshot() {
     ASSERT(instructions_image_ != NULL);
     thread_->isolate()->SetupImagePage(instructions_image_,
                                        /* is_executable */ true);
+    thread_->isolate()->set_instructions_image(instructions_image_);
   }
 
   deserializer.ReadVMSnapshot();
@@ -5553,6 +6054,7 @@ RawApiError* FullSnapshotReader::ReadIsolateSnapshot() {
     ASSERT(instructions_image_ != NULL);
     thread_->isolate()->SetupImagePage(instructions_image_,
                                        /* is_executable */ true);
+    thread_->isolate()->set_instructions_image(instructions_image_);
     if (shared_data_image_ != NULL) {
       thread_->isolate()->SetupImagePage(shared_data_image_,
                                          /* is_executable */ false);
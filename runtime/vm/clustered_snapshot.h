@@ -46,9 +46,11 @@ class ImageReader;
 // initialization/fill secton is read for each cluster, using the indices into
 // the reference array to fill pointers. At this point, every object has been
 // touched exactly once and in order, making this approach very cache friendly.
-// Finally, each cluster is given an opportunity to perform some fix-ups that
-// require the graph has been fully loaded, such as rehashing, though most
-// clusters do not require fixups.
+// The fill section starts with the size of each cluster's fill data, so that
+// clusters which only initialize their own objects can be filled concurrently
+// on the thread pool. Finally, each cluster is given an opportunity to perform
+// some fix-ups that require the graph has been fully loaded, such as
+// rehashing, though most clusters do not require fixups.
 
 class SerializationCluster : public ZoneAllocated {
  public:
@@ -92,6 +94,11 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill only initializes the cluster's objects from the stream
+  // and the ref array, without allocating or touching isolate state, so that
+  // it can run on a helper thread concurrently with other clusters.
+  virtual bool CanFillConcurrently() const { return true; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(const Array& refs, Snapshot::Kind kind, Zone* zone) {}
@@ -363,6 +370,11 @@ class Serializer : public ThreadStackResource {
   Snapshot::Kind kind() const { return kind_; }
   intptr_t next_ref_index() const { return next_ref_index_; }
 
+  // Whether only optimized code which was never deoptimized is written, see
+  // FullSnapshotWriter::set_stable_code_only.
+  bool stable_code_only() const { return stable_code_only_; }
+  void set_stable_code_only(bool value) { stable_code_only_ = value; }
+
   void DumpCombinedCodeStatistics();
 
  private:
@@ -382,6 +394,8 @@ class Serializer : public ThreadStackResource {
   // True if writing VM snapshot, false for Isolate snapshot.
   bool vm_;
 
+  bool stable_code_only_ = false;
+
   V8SnapshotProfileWriter* profile_writer_ = nullptr;
   struct ProfilingObject {
     RawObject* object_ = nullptr;
@@ -548,7 +562,10 @@ class Deserializer : public ThreadStackResource {
     return Read<int32_t>();
   }
 
-  RawInstructions* ReadInstructions();
+  // Also reads the entry point data written next to the instructions offset,
+  // which is the same as in the header of the returned instructions.
+  RawInstructions* ReadInstructions(bool* has_single_entry_point,
+                                    uint32_t* unchecked_entrypoint_pc_offset);
   RawObject* GetObjectAt(uint32_t offset) const;
   RawObject* GetSharedObjectAt(uint32_t offset) const;
 
@@ -559,6 +576,20 @@ class Deserializer : public ThreadStackResource {
 
   DeserializationCluster* ReadCluster();
 
+  // Fills the clusters whose fill data starts at [fill_offsets], using
+  // helper threads for the clusters which allow it.
+  void FillClustersConcurrently(const intptr_t* fill_offsets);
+
+  // Fills the concurrently fillable clusters, taking the index of the next
+  // one from [next_cluster]. Can be called from any thread.
+  void FillClusters(const intptr_t* fill_offsets, intptr_t* next_cluster);
+
+  // Runs the PostLoad step of every cluster.
+  void PostLoadClusters(const Array& refs);
+
+  // Prints the load statistics and reports them to the timeline.
+  void ReportLoadStats();
+
   intptr_t next_index() const { return next_ref_index_; }
   Heap* heap() const { return heap_; }
   Snapshot::Kind kind() const { return kind_; }
@@ -579,6 +610,10 @@ class Deserializer : public ThreadStackResource {
   intptr_t code_order_length() const { return code_order_length_; }
 
  private:
+  // A reader of the snapshot of [parent] starting at [position] which shares
+  // its ref array. It is not bound to a thread.
+  Deserializer(Deserializer* parent, intptr_t position);
+
   Heap* heap_;
   Zone* zone_;
   Snapshot::Kind kind_;
@@ -591,6 +626,23 @@ class Deserializer : public ThreadStackResource {
   RawArray* refs_;
   intptr_t next_ref_index_;
   DeserializationCluster** clusters_;
+
+  // What loading each cluster took, recorded with
+  // --print_snapshot_load_stats or while the isolate timeline stream is
+  // recording.
+  struct ClusterLoadStats {
+    intptr_t cid;
+    intptr_t num_objects;
+    intptr_t alloc_size;
+    intptr_t fill_size;
+    int64_t alloc_start;
+    int64_t alloc_end;
+    int64_t fill_start;
+    int64_t fill_end;
+    int64_t post_load_start;
+    int64_t post_load_end;
+  };
+  ClusterLoadStats* load_stats_ = nullptr;
 };
 
 #define ReadFromTo(obj, ...) d->ReadFromTo(obj, ##__VA_ARGS__);
@@ -623,6 +675,12 @@ class FullSnapshotWriter {
   intptr_t VmIsolateSnapshotSize() const { return vm_isolate_snapshot_size_; }
   intptr_t IsolateSnapshotSize() const { return isolate_snapshot_size_; }
 
+  // For snapshots with JIT code of a program which keeps running: functions
+  // whose optimized code was deoptimized or disabled are written with their
+  // unoptimized code instead, so the snapshot only carries optimized code
+  // whose speculations held in this process.
+  void set_stable_code_only(bool value) { stable_code_only_ = value; }
+
  private:
   // Writes a snapshot of the VM Isolate.
   intptr_t WriteVMSnapshot();
@@ -648,6 +706,7 @@ class FullSnapshotWriter {
   intptr_t mapped_text_size_;
 
   V8SnapshotProfileWriter* profile_writer_ = nullptr;
+  bool stable_code_only_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(FullSnapshotWriter);
 };
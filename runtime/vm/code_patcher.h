@@ -68,6 +68,13 @@ class CodePatcher : public AllStatic {
                                      const Code& code,
                                      const Code& new_target);
 
+  // Switchable calls load their data and target from the caller's object
+  // pool, so transitions only write pool entries and never stop the threads
+  // that may be running the caller. Generated code does not order its loads
+  // of the two entries, so a caller can pair the old target with the new
+  // data or the other way around. The IC and megamorphic stubs therefore
+  // each forward the other's data to the other stub (see
+  // ICCallThroughFunction and MegamorphicCall).
   static void PatchSwitchableCallAt(uword return_address,
                                     const Code& caller_code,
                                     const Object& data,
@@ -221,11 +221,13 @@ class SwitchableCallBase : public ValueObject {
   intptr_t data_index() const { return data_index_; }
   intptr_t target_index() const { return target_index_; }
 
-  RawObject* data() const { return object_pool_.ObjectAt(data_index()); }
+  RawObject* data() const {
+    return object_pool_.ObjectAtAcquire(data_index());
+  }
 
   void SetData(const Object& data) const {
     ASSERT(!Object::Handle(object_pool_.ObjectAt(data_index())).IsCode());
-    object_pool_.SetObjectAt(data_index(), data);
+    object_pool_.SetObjectAtRelease(data_index(), data);
     // No need to flush the instruction cache, since the code is not modified.
   }
 
@@ -310,12 +312,13 @@ class SwitchableCall : public SwitchableCallBase {
 
   void SetTarget(const Code& target) const {
     ASSERT(Object::Handle(object_pool_.ObjectAt(target_index())).IsCode());
-    object_pool_.SetObjectAt(target_index(), target);
+    object_pool_.SetObjectAtRelease(target_index(), target);
     // No need to flush the instruction cache, since the code is not modified.
   }
 
   RawCode* target() const {
-    return reinterpret_cast<RawCode*>(object_pool_.ObjectAt(target_index()));
+    return reinterpret_cast<RawCode*>(
+        object_pool_.ObjectAtAcquire(target_index()));
   }
 };
 
@@ -385,11 +388,12 @@ class BareSwitchableCall : public SwitchableCallBase {
   void SetTarget(const Code& target) const {
     ASSERT(object_pool_.TypeAt(target_index()) ==
            ObjectPool::EntryType::kImmediate);
-    object_pool_.SetRawValueAt(target_index(), target.MonomorphicEntryPoint());
+    object_pool_.SetRawValueAtRelease(target_index(),
+                                      target.MonomorphicEntryPoint());
   }
 
   RawCode* target() const {
-    const uword pc = object_pool_.RawValueAt(target_index());
+    const uword pc = object_pool_.RawValueAtAcquire(target_index());
     auto rct = Isolate::Current()->reverse_pc_lookup_cache();
     if (rct->Contains(pc)) {
       return rct->Lookup(pc);
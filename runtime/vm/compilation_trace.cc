@@ -6,6 +6,7 @@
 
 #include "vm/compiler/jit/compiler.h"
 #include "vm/globals.h"
+#include "vm/hash_table.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
@@ -18,6 +19,48 @@ namespace dart {
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 DEFINE_FLAG(bool, trace_compilation_trace, false, "Trace compilation trace.");
+DEFINE_FLAG(bool,
+            background_warmup,
+            false,
+            "Compile the functions of a loaded compilation trace or type "
+            "feedback on the background compilers where possible instead of "
+            "on the loading thread.");
+
+// Enters [function] into a background compiler queue if --background_warmup
+// is set and the function can be compiled there. The queues compile the
+// hottest functions first. Returns whether the function was queued.
+static bool QueueForBackgroundCompilation(Thread* thread,
+                                          const Function& function,
+                                          bool optimizing) {
+  if (!FLAG_background_warmup || !FLAG_background_compilation) {
+    return false;
+  }
+  Isolate* isolate = thread->isolate();
+  if (optimizing) {
+    if (isolate->optimizing_background_compiler() == nullptr) return false;
+  } else {
+    // Only bytecode can be compiled to unoptimized code in the background.
+    if (!FLAG_enable_interpreter || !function.HasBytecode() ||
+        (isolate->background_compiler() == nullptr)) {
+      return false;
+    }
+  }
+  if (BackgroundCompiler::IsDisabled(isolate, optimizing) ||
+      !function.is_background_optimizable()) {
+    return false;
+  }
+  BackgroundCompiler::Start(isolate);
+  if (optimizing) {
+    isolate->optimizing_background_compiler()->Compile(function);
+  } else {
+    isolate->background_compiler()->Compile(function);
+  }
+  if (FLAG_trace_compilation_trace) {
+    THR_Print("Compilation trace: queued %s%s\n",
+              optimizing ? "optimized " : "", function.ToQualifiedCString());
+  }
+  return true;
+}
 
 CompilationTraceSaver::CompilationTraceSaver(Zone* zone)
     : buf_(zone, 1 * MB),
@@ -365,6 +408,12 @@ RawObject* CompilationTraceLoader::CompileFunction(const Function& function) {
     return Object::null();
   }
 
+  // Call targets cannot be speculated before the code exists, the
+  // interpreter's feedback takes their place.
+  if (QueueForBackgroundCompilation(thread_, function, /*optimizing=*/false)) {
+    return Object::null();
+  }
+
   error_ = Compiler::CompileFunction(thread_, function);
   if (error_.IsError()) {
     return error_.raw();
@@ -538,12 +587,34 @@ void TypeFeedbackSaver::Visit(const Function& function) {
     call_sites_ = Object::empty_array().raw();  // Remove edge case.
   }
 
+  // Token positions identify the call sites when precompiling, where deopt
+  // ids differ.
+  GrowableArray<intptr_t> token_positions;
+  code_ = function.unoptimized_code();
+  if (!code_.IsNull()) {
+    PcDescriptors::Iterator iter(
+        PcDescriptors::Handle(code_.pc_descriptors()),
+        RawPcDescriptors::kIcCall | RawPcDescriptors::kUnoptStaticCall);
+    while (iter.MoveNext()) {
+      const intptr_t deopt_id = iter.DeoptId();
+      if (deopt_id < 0) continue;
+      while (token_positions.length() <= deopt_id) {
+        token_positions.Add(TokenPosition::kNoSource.value());
+      }
+      token_positions[deopt_id] = iter.TokenPos().value();
+    }
+  }
+
   // First element is edge counters.
   WriteInt(call_sites_.Length() - 1);
   for (intptr_t i = 1; i < call_sites_.Length(); i++) {
     call_site_ ^= call_sites_.At(i);
 
-    WriteInt(call_site_.deopt_id());
+    const intptr_t deopt_id = call_site_.deopt_id();
+    WriteInt(deopt_id);
+    WriteInt(((deopt_id >= 0) && (deopt_id < token_positions.length()))
+                 ? token_positions[deopt_id]
+                 : TokenPosition::kNoSource.value());
     WriteInt(call_site_.rebind_rule());
 
     str_ = call_site_.target_name();
@@ -606,6 +677,7 @@ TypeFeedbackLoader::TypeFeedbackLoader(Thread* thread)
       args_desc_(Array::Handle(zone_)),
       functions_to_compile_(
           GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+      aot_call_site_(Array::Handle(zone_)),
       error_(Error::Handle(zone_)) {}
 
 TypeFeedbackLoader::~TypeFeedbackLoader() {
@@ -642,6 +714,9 @@ RawObject* TypeFeedbackLoader::LoadFeedback(ReadStream* stream) {
 
     if (Compiler::CanOptimizeFunction(thread_, func_) &&
         (func_.usage_counter() >= FLAG_optimization_counter_threshold)) {
+      if (QueueForBackgroundCompilation(thread_, func_, /*optimizing=*/true)) {
+        continue;
+      }
       error_ = Compiler::CompileOptimizedFunction(thread_, func_);
       if (error_.IsError()) {
         return error_.raw();
@@ -694,6 +769,12 @@ RawObject* TypeFeedbackLoader::CheckHeader() {
       reinterpret_cast<const char*>(stream_->AddressOfCurrentPosition());
   ASSERT(features != NULL);
   intptr_t buffer_len = Utils::StrNLen(features, stream_->PendingBytes());
+  if (FLAG_precompiled_mode) {
+    // Deopt ids are not used when precompiling, so these flags do not matter.
+    free(expected_features);
+    stream_->Advance(buffer_len + 1);
+    return Error::null();
+  }
   if ((buffer_len != expected_len) ||
       strncmp(features, expected_features, expected_len)) {
     const String& msg = String::Handle(String::NewFormatted(
@@ -737,7 +818,7 @@ RawObject* TypeFeedbackLoader::LoadFields() {
     bool skip = cls_.IsNull();
 
     intptr_t num_fields = ReadInt();
-    if (!skip && (num_fields > 0)) {
+    if (!skip && (num_fields > 0) && !FLAG_precompiled_mode) {
       error_ = cls_.EnsureIsFinalized(thread_);
       if (error_.IsError()) {
         return error_.raw();
@@ -750,7 +831,8 @@ RawObject* TypeFeedbackLoader::LoadFields() {
       intptr_t guarded_cid = cid_map_[ReadInt()];
       intptr_t is_nullable = ReadInt();
 
-      if (skip) {
+      // The precompiler computes its own field guards.
+      if (skip || FLAG_precompiled_mode) {
         continue;
       }
 
@@ -830,7 +912,14 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
     }
   }
 
-  if (!skip) {
+  // When precompiling the feedback is kept for the precompiler instead of
+  // being merged into the ICData of unoptimized code.
+  const bool precompiling = FLAG_precompiled_mode;
+  const GrowableObjectArray& aot_call_sites = GrowableObjectArray::Handle(
+      zone_, precompiling ? GrowableObjectArray::New()
+                          : GrowableObjectArray::null());
+
+  if (!skip && !precompiling) {
     error_ = Compiler::CompileFunction(thread_, func_);
     if (error_.IsError()) {
       return error_.raw();
@@ -851,12 +940,30 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
   // First element is edge counters.
   for (intptr_t i = 1; i <= num_call_sites; i++) {
     intptr_t deopt_id = ReadInt();
+    intptr_t token_pos = ReadInt();
     intptr_t rebind_rule = ReadInt();
     target_name_ = ReadString();
     intptr_t num_checked_arguments = ReadInt();
     intptr_t num_entries = ReadInt();
 
-    if (!skip) {
+    aot_call_site_ = Array::null();
+    if (!skip && precompiling && (rebind_rule == ICData::kInstance) &&
+        (num_entries > 0) &&
+        (token_pos != TokenPosition::kNoSource.value())) {
+      aot_call_site_ = Array::New(
+          PrecompilerTypeFeedback::kFirstCheckIndex +
+              num_entries * (1 + num_checked_arguments),
+          Heap::kOld);
+      aot_call_site_.SetAt(PrecompilerTypeFeedback::kTokenPosIndex,
+                           Smi::Handle(zone_, Smi::New(token_pos)));
+      aot_call_site_.SetAt(PrecompilerTypeFeedback::kSelectorIndex,
+                           target_name_);
+      aot_call_site_.SetAt(PrecompilerTypeFeedback::kNumArgsTestedIndex,
+                           Smi::Handle(zone_, Smi::New(num_checked_arguments)));
+      aot_call_sites.Add(aot_call_site_);
+    }
+
+    if (!skip && !precompiling) {
       call_site_ ^= call_sites_.At(i);
       if ((call_site_.deopt_id() != deopt_id) ||
           (call_site_.rebind_rule() != rebind_rule) ||
@@ -884,7 +991,19 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
         }
       }
 
-      if (skip_entry) {
+      if (!aot_call_site_.IsNull()) {
+        // Checks of classes missing from the program keep their count at 0.
+        intptr_t index = PrecompilerTypeFeedback::kFirstCheckIndex +
+                         entry_index * (1 + num_checked_arguments);
+        const intptr_t count = skip_entry ? 0 : entry_usage;
+        aot_call_site_.SetAt(index++, Smi::Handle(zone_, Smi::New(count)));
+        for (intptr_t j = 0; j < num_checked_arguments; j++) {
+          aot_call_site_.SetAt(index++, Smi::Handle(zone_, Smi::New(cids[j])));
+        }
+        continue;
+      }
+
+      if (skip_entry || precompiling) {
         continue;
       }
 
@@ -911,7 +1030,9 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
     }
   }
 
-  if (!skip) {
+  if (!skip && precompiling) {
+    AddPrecompilerCallSites(aot_call_sites);
+  } else if (!skip) {
     func_.set_usage_counter(usage);
     func_.set_inlining_depth(inlining_depth);
 
@@ -923,6 +1044,113 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
   return Error::null();
 }
 
+class TypeFeedbackTableTraits {
+ public:
+  static const char* Name() { return "TypeFeedbackTableTraits"; }
+  static bool ReportStats() { return false; }
+
+  static bool IsMatch(const Object& a, const Object& b) {
+    return a.raw() == b.raw();
+  }
+
+  static uword Hash(const Object& key) {
+    const Function& function = Function::Cast(key);
+    return String::Handle(function.name()).Hash() ^
+           function.token_pos().value();
+  }
+};
+typedef UnorderedHashMap<TypeFeedbackTableTraits> TypeFeedbackTable;
+
+void TypeFeedbackLoader::AddPrecompilerCallSites(
+    const GrowableObjectArray& call_sites) {
+  if (call_sites.Length() == 0) {
+    return;
+  }
+  ObjectStore* object_store = thread_->isolate()->object_store();
+  if (object_store->type_feedback_table() == Array::null()) {
+    const intptr_t kInitialCapacity = 256;
+    object_store->set_type_feedback_table(Array::Handle(
+        zone_,
+        HashTables::New<TypeFeedbackTable>(kInitialCapacity, Heap::kOld)));
+  }
+  TypeFeedbackTable table(zone_, object_store->type_feedback_table());
+  table.UpdateOrInsert(func_, Array::Handle(zone_, Array::MakeFixedLength(
+                                                      call_sites)));
+  object_store->set_type_feedback_table(table.Release());
+}
+
+void PrecompilerTypeFeedback::AddChecks(const Function& function,
+                                        TokenPosition token_pos,
+                                        const ICData& ic_data) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  Isolate* isolate = thread->isolate();
+  if (isolate->object_store()->type_feedback_table() == Array::null()) {
+    return;
+  }
+  Array& call_sites = Array::Handle(zone);
+  {
+    TypeFeedbackTable table(zone,
+                            isolate->object_store()->type_feedback_table());
+    call_sites ^= table.GetOrNull(function);
+    table.Release();
+  }
+  if (call_sites.IsNull()) {
+    return;
+  }
+
+  const intptr_t num_args_tested = ic_data.NumArgsTested();
+  const String& selector = String::Handle(zone, ic_data.target_name());
+  String& site_selector = String::Handle(zone);
+  Array& call_site = Array::Handle(zone);
+  for (intptr_t i = 0; i < call_sites.Length(); i++) {
+    call_site ^= call_sites.At(i);
+    site_selector ^= call_site.At(kSelectorIndex);
+    if ((Smi::Value(Smi::RawCast(call_site.At(kTokenPosIndex))) !=
+         token_pos.value()) ||
+        (Smi::Value(Smi::RawCast(call_site.At(kNumArgsTestedIndex))) !=
+         num_args_tested) ||
+        !String::EqualsIgnoringPrivateKey(selector, site_selector)) {
+      continue;
+    }
+
+    const ArgumentsDescriptor args_desc(
+        Array::Handle(zone, ic_data.arguments_descriptor()));
+    ClassTable* class_table = isolate->class_table();
+    Class& cls = Class::Handle(zone);
+    Function& target = Function::Handle(zone);
+    GrowableArray<intptr_t> cids(num_args_tested);
+    intptr_t index = kFirstCheckIndex;
+    while (index < call_site.Length()) {
+      const intptr_t count = Smi::Value(Smi::RawCast(call_site.At(index++)));
+      cids.Clear();
+      for (intptr_t j = 0; j < num_args_tested; j++) {
+        cids.Add(Smi::Value(Smi::RawCast(call_site.At(index++))));
+      }
+      if ((count == 0) || !class_table->HasValidClassAt(cids[0]) ||
+          (ic_data.FindCheck(cids) != -1)) {
+        continue;
+      }
+      cls = class_table->At(cids[0]);
+      // Do not add artificial functions, which the precompiler only creates
+      // for selectors it has seen.
+      target = Resolver::ResolveDynamicForReceiverClass(
+          cls, selector, args_desc, /*allow_add=*/false);
+      if (target.IsNull() || target.IsMethodExtractor() ||
+          target.IsInvokeFieldDispatcher() ||
+          target.IsNoSuchMethodDispatcher()) {
+        continue;
+      }
+      if (num_args_tested == 1) {
+        ic_data.AddReceiverCheck(cids[0], target, count);
+      } else {
+        ic_data.AddCheck(cids, target, count);
+      }
+    }
+    return;
+  }
+}
+
 RawFunction* TypeFeedbackLoader::FindFunction(RawFunction::Kind kind,
                                               intptr_t token_pos) {
   if (cls_name_.Equals(Symbols::TopLevel())) {
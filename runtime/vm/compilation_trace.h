@@ -103,6 +103,7 @@ class TypeFeedbackLoader : public ValueObject {
   RawObject* LoadFields();
   RawObject* LoadFunction();
   RawFunction* FindFunction(RawFunction::Kind kind, intptr_t token_pos);
+  void AddPrecompilerCallSites(const GrowableObjectArray& call_sites);
 
   RawClass* ReadClassByName();
   RawString* ReadString();
@@ -128,9 +129,34 @@ class TypeFeedbackLoader : public ValueObject {
   Function& target_;
   Array& args_desc_;
   GrowableObjectArray& functions_to_compile_;
+  Array& aot_call_site_;
   Object& error_;
 };
 
+// Type feedback loaded in precompiled mode, where the loader does not compile
+// functions but keeps the receiver classes observed at each call site, keyed
+// by the token position of the call. The precompiler turns them into the
+// ICData of its calls, from which AotCallSpecializer and the inliner
+// devirtualize and inline polymorphic calls.
+class PrecompilerTypeFeedback : public AllStatic {
+ public:
+  // Layout of the array recorded for a call site: its token position,
+  // selector (without private mangling), number of checked arguments, and
+  // then for each observed check its count followed by the class ids.
+  enum {
+    kTokenPosIndex = 0,
+    kSelectorIndex,
+    kNumArgsTestedIndex,
+    kFirstCheckIndex,
+  };
+
+  // Adds the checks observed at the call at [token_pos] in [function] to the
+  // instance call [ic_data]. Does nothing if no feedback was loaded for it.
+  static void AddChecks(const Function& function,
+                        TokenPosition token_pos,
+                        const ICData& ic_data);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_COMPILATION_TRACE_H_
@@ -5,6 +5,7 @@
 #include "vm/compiler/aot/aot_call_specializer.h"
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -1036,6 +1037,10 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
         instr->ReplaceWith(call, current_iterator());
         return;
       }
+
+      if (TryReplaceWithDispatchTableCall(instr, receiver_class, class_ids)) {
+        return;
+      }
     }
 
     // Detect if o.m(...) is a call through a getter and expand it
@@ -1060,6 +1065,50 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
   }
 }
 
+bool AotCallSpecializer::TryReplaceWithDispatchTableCall(
+    InstanceCallInstr* instr,
+    const Class& receiver_class,
+    const GrowableArray<intptr_t>& class_ids) {
+  if ((precompiler_ == NULL) ||
+      (precompiler_->dispatch_table_generator() == NULL)) {
+    return false;
+  }
+  DispatchTableGenerator* generator = precompiler_->dispatch_table_generator();
+  const DispatchTableSelector* selector =
+      generator->LookupSelector(receiver_class, instr->function_name());
+  if (selector == NULL) {
+    return false;
+  }
+
+  // The call must reach the row's target for every possible receiver, which
+  // also rules out calls whose arguments don't match the targets.
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (intptr_t i = 0; i < class_ids.length(); i++) {
+    const Function* entry = selector->TargetFor(class_ids[i]);
+    if (entry == NULL) {
+      return false;
+    }
+    cls = isolate()->class_table()->At(class_ids[i]);
+    target = instr->ResolveForReceiverClass(cls);
+    if (target.raw() != entry->raw()) {
+      return false;
+    }
+  }
+
+  Definition* receiver = instr->ArgumentAt(instr->FirstArgIndex());
+  LoadClassIdInstr* load_cid =
+      new (Z) LoadClassIdInstr(new (Z) Value(receiver));
+  InsertBefore(instr, load_cid, NULL, FlowGraph::kValue);
+
+  const Array& table = Array::ZoneHandle(Z, generator->table().raw());
+  DispatchTableCallInstr* call = DispatchTableCallInstr::FromCall(
+      Z, instr, new (Z) Value(load_cid), table, selector->offset());
+  instr->ReplaceWith(call, current_iterator());
+  generator->MarkSelectorUsed(selector);
+  return true;
+}
+
 void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
   if (TryInlineFieldAccess(instr)) {
     return;
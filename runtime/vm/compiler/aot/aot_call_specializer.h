@@ -66,6 +66,14 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryExpandCallThroughGetter(const Class& receiver_class,
                                   InstanceCallInstr* call);
 
+  // Replace the call [instr] on a receiver whose possible classes are
+  // [class_ids] with a call through the global dispatch table if its row
+  // has the right target for each of them.
+  bool TryReplaceWithDispatchTableCall(
+      InstanceCallInstr* instr,
+      const Class& receiver_class,
+      const GrowableArray<intptr_t>& class_ids);
+
   Definition* TryOptimizeMod(TemplateDartCall<0>* instr,
                              Token::Kind op_kind,
                              Value* left_value,
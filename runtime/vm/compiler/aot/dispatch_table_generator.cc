@@ -0,0 +1,260 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
+    !defined(TARGET_ARCH_IA32)
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+
+#include "platform/atomic.h"
+#include "vm/class_table.h"
+#include "vm/compiler/cha.h"
+#include "vm/flags.h"
+#include "vm/resolver.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, max_exhaustive_polymorphic_checks);
+
+const Function* DispatchTableSelector::TargetFor(intptr_t cid) const {
+  intptr_t lo = 0;
+  intptr_t hi = cids_.length() - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (cids_[mid] == cid) {
+      return targets_[mid];
+    } else if (cids_[mid] < cid) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return NULL;
+}
+
+DispatchTableGenerator::DispatchTableGenerator(Zone* zone)
+    : zone_(zone), selectors_(zone, 64), table_(Array::ZoneHandle(zone)) {}
+
+bool DispatchTableGenerator::IsDispatchClass(const Class& cls) {
+  return cls.is_finalized() && !cls.is_implemented() &&
+         !cls.IsObjectClass() && !cls.IsDynamicClass() &&
+         !cls.IsTopLevel() && !cls.IsClosureClass() &&
+         !cls.IsTypedefClass() && !cls.InVMIsolateHeap();
+}
+
+bool DispatchTableGenerator::IsSelectorDeclaration(const Function& function) {
+  if (function.is_static()) return false;
+  switch (function.kind()) {
+    case RawFunction::kRegularFunction:
+    case RawFunction::kGetterFunction:
+    case RawFunction::kSetterFunction:
+    case RawFunction::kImplicitGetter:
+    case RawFunction::kImplicitSetter:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool DispatchTableGenerator::IsTableTarget(const Function& function) {
+  return !function.IsNull() && !function.is_abstract() &&
+         IsSelectorDeclaration(function);
+}
+
+bool DispatchTableGenerator::IsDeclaredBySuperclass(const Class& cls,
+                                                    const String& name) {
+  Class& super = Class::Handle(zone_, cls.SuperClass());
+  for (; !super.IsNull(); super = super.SuperClass()) {
+    if (IsDispatchClass(super) &&
+        (super.LookupDynamicFunctionAllowAbstract(name) != Function::null())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int CompareCids(const intptr_t* a, const intptr_t* b) {
+  return static_cast<int>(*a - *b);
+}
+
+void DispatchTableGenerator::AddSelector(ClassTable* class_table,
+                                         const Class& cls,
+                                         const String& name,
+                                         const GrowableArray<intptr_t>& cids) {
+  auto selector = new (zone_) DispatchTableSelector(
+      zone_, selectors_.length(), cls.id(),
+      String::ZoneHandle(zone_, name.raw()));
+  Class& receiver_class = Class::Handle(zone_);
+  Function& target = Function::Handle(zone_);
+  const Function* first_target = NULL;
+  bool polymorphic = false;
+  for (intptr_t i = 0; i < cids.length(); i++) {
+    receiver_class = class_table->At(cids[i]);
+    target = Resolver::ResolveDynamicAnyArgs(zone_, receiver_class, name,
+                                             /*allow_add=*/false);
+    // Every concrete subclass needs an entry, otherwise calls through the
+    // row would miss noSuchMethod or call-through-getter semantics.
+    if (!IsTableTarget(target)) return;
+    if (first_target == NULL) {
+      first_target = &Function::ZoneHandle(zone_, target.raw());
+    } else if (first_target->raw() != target.raw()) {
+      polymorphic = true;
+    }
+    selector->cids_.Add(cids[i]);
+  }
+  // Calls with a single target are devirtualized by CHA.
+  if (!polymorphic) return;
+
+  selector->cids_.Sort(CompareCids);
+  for (intptr_t i = 0; i < selector->cids_.length(); i++) {
+    receiver_class = class_table->At(selector->cids_[i]);
+    target = Resolver::ResolveDynamicAnyArgs(zone_, receiver_class, name,
+                                             /*allow_add=*/false);
+    selector->targets_.Add(&Function::ZoneHandle(zone_, target.raw()));
+  }
+  selectors_.Add(selector);
+}
+
+void DispatchTableGenerator::Initialize(ClassTable* class_table) {
+  Class& cls = Class::Handle(zone_);
+  Array& functions = Array::Handle(zone_);
+  Function& function = Function::Handle(zone_);
+  String& name = String::Handle(zone_);
+  GrowableArray<intptr_t> cids(zone_, 16);
+
+  const intptr_t num_cids = class_table->NumCids();
+  for (intptr_t cid = kInstanceCid; cid < num_cids; cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    if (!IsDispatchClass(cls)) continue;
+
+    functions = cls.functions();
+    for (intptr_t i = 0; i < functions.Length(); i++) {
+      function ^= functions.At(i);
+      if (!IsSelectorDeclaration(function)) continue;
+      name = function.name();
+      if (IsDeclaredBySuperclass(cls, name)) continue;
+
+      cids.Clear();
+      if (!CHA::ConcreteSubclasses(cls, &cids)) continue;
+      if (cids.length() <= FLAG_max_exhaustive_polymorphic_checks) continue;
+
+      AddSelector(class_table, cls, name, cids);
+    }
+  }
+
+  const intptr_t length = AssignOffsets();
+  table_ = Array::New(length, Heap::kOld);
+}
+
+static int CompareSelectorsBySize(DispatchTableSelector* const* a,
+                                  DispatchTableSelector* const* b) {
+  // Pack large rows first, ties are broken by id for determinism.
+  const intptr_t size_a = (*a)->NumEntries();
+  const intptr_t size_b = (*b)->NumEntries();
+  if (size_a != size_b) return (size_a > size_b) ? -1 : 1;
+  return ((*a)->id() < (*b)->id()) ? -1 : 1;
+}
+
+intptr_t DispatchTableGenerator::AssignOffsets() {
+  GrowableArray<DispatchTableSelector*> by_size(zone_, selectors_.length());
+  for (intptr_t i = 0; i < selectors_.length(); i++) {
+    by_size.Add(selectors_[i]);
+  }
+  by_size.Sort(CompareSelectorsBySize);
+
+  GrowableArray<bool> occupied(zone_, 1024);
+  intptr_t first_free = 0;
+  for (intptr_t i = 0; i < by_size.length(); i++) {
+    DispatchTableSelector* selector = by_size[i];
+    const intptr_t min_cid = selector->CidAt(0);
+    intptr_t offset = first_free - min_cid;
+    for (;; offset++) {
+      bool fits = true;
+      for (intptr_t j = 0; j < selector->NumEntries(); j++) {
+        const intptr_t index = selector->CidAt(j) + offset;
+        if ((index < occupied.length()) && occupied[index]) {
+          fits = false;
+          break;
+        }
+      }
+      if (fits) break;
+    }
+
+    selector->offset_ = offset;
+    for (intptr_t j = 0; j < selector->NumEntries(); j++) {
+      const intptr_t index = selector->CidAt(j) + offset;
+      while (occupied.length() <= index) {
+        occupied.Add(false);
+      }
+      occupied[index] = true;
+    }
+    while ((first_free < occupied.length()) && occupied[first_free]) {
+      first_free++;
+    }
+  }
+  return occupied.length();
+}
+
+const DispatchTableSelector* DispatchTableGenerator::LookupSelector(
+    const Class& receiver_class,
+    const String& name) const {
+  ASSERT(name.IsSymbol());
+  Zone* zone = Thread::Current()->zone();
+  Class& cls = Class::Handle(zone, receiver_class.raw());
+  for (; !cls.IsNull(); cls = cls.SuperClass()) {
+    const intptr_t cid = cls.id();
+    // Find the first row declared by [cid].
+    intptr_t lo = 0;
+    intptr_t hi = selectors_.length();
+    while (lo < hi) {
+      const intptr_t mid = lo + (hi - lo) / 2;
+      if (selectors_[mid]->declaring_cid() < cid) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    for (intptr_t i = lo; (i < selectors_.length()) &&
+                          (selectors_[i]->declaring_cid() == cid);
+         i++) {
+      if (selectors_[i]->name().raw() == name.raw()) {
+        return selectors_[i];
+      }
+    }
+  }
+  return NULL;
+}
+
+void DispatchTableGenerator::MarkSelectorUsed(
+    const DispatchTableSelector* selector) {
+  DispatchTableSelector* row = selectors_[selector->id()];
+  ASSERT(row == selector);
+  AtomicOperations::StoreRelease(&row->used_, static_cast<uword>(1));
+}
+
+bool DispatchTableGenerator::IsSelectorUsed(
+    const DispatchTableSelector* selector) const {
+  return AtomicOperations::LoadAcquire(&selectors_[selector->id()]->used_) !=
+         0;
+}
+
+void DispatchTableGenerator::BuildCodeArray() {
+  Code& code = Code::Handle(zone_);
+  for (intptr_t i = 0; i < selectors_.length(); i++) {
+    const DispatchTableSelector* selector = selectors_[i];
+    if (!IsSelectorUsed(selector)) continue;
+    for (intptr_t j = 0; j < selector->NumEntries(); j++) {
+      const Function& target = selector->TargetAt(j);
+      if (!target.HasCode()) continue;
+      code = target.CurrentCode();
+      table_.SetAt(selector->CidAt(j) + selector->offset(), code);
+    }
+  }
+}
+
+}  // namespace dart
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&           \
+        // !defined(TARGET_ARCH_IA32)
@@ -0,0 +1,143 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+#define RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class ClassTable;
+
+// A row of the dispatch table: the targets of one selector for all concrete
+// subclasses of the class which introduces it.
+class DispatchTableSelector : public ZoneAllocated {
+ public:
+  DispatchTableSelector(Zone* zone,
+                        intptr_t id,
+                        intptr_t declaring_cid,
+                        const String& name)
+      : id_(id),
+        declaring_cid_(declaring_cid),
+        name_(name),
+        cids_(zone, 8),
+        targets_(zone, 8),
+        offset_(kNoOffset),
+        used_(0) {}
+
+  static const intptr_t kNoOffset = kIntptrMin;
+
+  intptr_t id() const { return id_; }
+  intptr_t declaring_cid() const { return declaring_cid_; }
+  const String& name() const { return name_; }
+
+  // The table entry for a receiver of class [cid] is at [cid + offset()].
+  intptr_t offset() const { return offset_; }
+
+  intptr_t NumEntries() const { return cids_.length(); }
+  intptr_t CidAt(intptr_t i) const { return cids_[i]; }
+  const Function& TargetAt(intptr_t i) const { return *targets_[i]; }
+
+  // Returns the target for receivers of class [cid] or NULL if [cid] is not
+  // a concrete subclass of the declaring class.
+  const Function* TargetFor(intptr_t cid) const;
+
+ private:
+  friend class DispatchTableGenerator;
+
+  const intptr_t id_;
+  const intptr_t declaring_cid_;
+  const String& name_;
+  // Sorted by class id.
+  GrowableArray<intptr_t> cids_;
+  GrowableArray<const Function*> targets_;
+  intptr_t offset_;
+  // Set once code calling through this row has been generated.
+  uword used_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTableSelector);
+};
+
+// Builds the global dispatch table used by precompiled code for instance
+// calls which would otherwise go through the switchable call stubs.
+//
+// Before compilation starts the generator walks the finalized class
+// hierarchy and creates a row for every selector introduced by a class which
+// is not implemented by other classes, has more concrete subclasses than
+// --max-exhaustive-polymorphic-checks and at least two distinct targets. The
+// rows are packed into one table by first-fit row displacement, so that an
+// instance call becomes a load of table[cid + offset] followed by an
+// indirect call. After compilation the entries of rows which were used are
+// filled with the code of their targets.
+class DispatchTableGenerator : public ZoneAllocated {
+ public:
+  explicit DispatchTableGenerator(Zone* zone);
+
+  // Creates the rows and assigns their offsets. The class hierarchy has to be
+  // finalized and must not change afterwards.
+  void Initialize(ClassTable* class_table);
+
+  // Returns the row serving calls of [name] on receivers which are
+  // subclasses of [receiver_class], or NULL. Can be called from any
+  // compiler thread.
+  const DispatchTableSelector* LookupSelector(const Class& receiver_class,
+                                              const String& name) const;
+
+  // Records that code calling through [selector] has been generated. Can be
+  // called from any compiler thread.
+  void MarkSelectorUsed(const DispatchTableSelector* selector);
+
+  intptr_t NumSelectors() const { return selectors_.length(); }
+  const DispatchTableSelector* SelectorAt(intptr_t i) const {
+    return selectors_[i];
+  }
+  bool IsSelectorUsed(const DispatchTableSelector* selector) const;
+
+  // Fills the entries of the used rows with the code of their targets.
+  // Entries of targets which were never compiled (because no instance of
+  // their class can exist) are left null.
+  void BuildCodeArray();
+
+  // The table. Allocated by Initialize with its final length.
+  const Array& table() const { return table_; }
+
+ private:
+  // Whether selectors introduced by [cls] can get a row.
+  static bool IsDispatchClass(const Class& cls);
+
+  // Whether [function] declares a selector which can be dispatched through
+  // the table.
+  static bool IsSelectorDeclaration(const Function& function);
+
+  // Whether [function] can be the target of a table entry.
+  static bool IsTableTarget(const Function& function);
+
+  // Returns true if a superclass of [cls] which can introduce selectors
+  // already declares [name].
+  bool IsDeclaredBySuperclass(const Class& cls, const String& name);
+
+  // Creates the row for [name] introduced by [cls] if it is worth it.
+  void AddSelector(ClassTable* class_table,
+                   const Class& cls,
+                   const String& name,
+                   const GrowableArray<intptr_t>& cids);
+
+  // Assigns offsets to all rows by first-fit row displacement and returns
+  // the resulting table length.
+  intptr_t AssignOffsets();
+
+  Zone* zone_;
+  // Sorted by declaring class id.
+  GrowableArray<DispatchTableSelector*> selectors_;
+  Array& table_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTableGenerator);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
@@ -0,0 +1,109 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
+    !defined(TARGET_ARCH_IA32)
+
+static RawClass* GetClass(const Library& lib, const char* name) {
+  Thread* thread = Thread::Current();
+  const auto& cls = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(thread, name))));
+  EXPECT(!cls.IsNull());
+  return cls.raw();
+}
+
+ISOLATE_UNIT_TEST_CASE(DispatchTableGenerator_Rows) {
+  const char* kScript = R"(
+      abstract class A {
+        int foo();
+        int bar() => 0;
+        int baz() => 0;
+      }
+      class B0 extends A { int foo() => 0; }
+      class B1 extends A { int foo() => 1; }
+      class B2 extends A { int foo() => 2; }
+      class B3 extends A { int foo() => 3; }
+      class B4 extends A { int foo() => 4; }
+      class C extends B0 {
+        int foo() => 5;
+        int bar() => 5;
+      }
+      class D {
+        int foo() => 6;
+      }
+
+      main() {
+        final list = <A>[new B0(), new B1(), new B2(), new B3(), new B4(),
+                         new C()];
+        for (final a in list) {
+          a.foo();
+          a.bar();
+          a.baz();
+        }
+        new D();
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  const auto& class_a = Class::Handle(GetClass(lib, "A"));
+  const auto& class_b0 = Class::Handle(GetClass(lib, "B0"));
+  const auto& class_c = Class::Handle(GetClass(lib, "C"));
+  const auto& class_d = Class::Handle(GetClass(lib, "D"));
+  const auto& foo = String::Handle(Symbols::New(thread, "foo"));
+  const auto& bar = String::Handle(Symbols::New(thread, "bar"));
+  const auto& baz = String::Handle(Symbols::New(thread, "baz"));
+
+  DispatchTableGenerator generator(thread->zone());
+  generator.Initialize(thread->isolate()->class_table());
+
+  // foo and bar have several targets in the hierarchy of A. baz has a single
+  // one, so calls to it are devirtualized instead, as are calls to D.foo.
+  const auto foo_row = generator.LookupSelector(class_a, foo);
+  const auto bar_row = generator.LookupSelector(class_a, bar);
+  EXPECT(foo_row != NULL);
+  EXPECT(bar_row != NULL);
+  EXPECT(generator.LookupSelector(class_a, baz) == NULL);
+  EXPECT(generator.LookupSelector(class_d, foo) == NULL);
+  if ((foo_row == NULL) || (bar_row == NULL)) return;
+
+  // Subclasses find the row introduced by A.
+  EXPECT_EQ(foo_row, generator.LookupSelector(class_c, foo));
+  EXPECT_EQ(6, foo_row->NumEntries());
+  EXPECT_EQ(6, bar_row->NumEntries());
+  EXPECT(foo_row->TargetFor(class_d.id()) == NULL);
+  EXPECT_EQ(class_c.raw(), foo_row->TargetFor(class_c.id())->Owner());
+  EXPECT_EQ(class_a.raw(), bar_row->TargetFor(class_b0.id())->Owner());
+
+  // The rows are interleaved without sharing any entry.
+  const intptr_t table_length = generator.table().Length();
+  GrowableArray<bool> used(table_length);
+  for (intptr_t i = 0; i < table_length; i++) {
+    used.Add(false);
+  }
+  for (intptr_t i = 0; i < generator.NumSelectors(); i++) {
+    const DispatchTableSelector* row = generator.SelectorAt(i);
+    for (intptr_t j = 0; j < row->NumEntries(); j++) {
+      const intptr_t index = row->CidAt(j) + row->offset();
+      EXPECT(0 <= index && index < table_length);
+      if ((index < 0) || (index >= table_length)) continue;
+      EXPECT(!used[index]);
+      used[index] = true;
+    }
+  }
+}
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&           \
+        // !defined(TARGET_ARCH_IA32)
+
+}  // namespace dart
@@ -8,6 +8,7 @@
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
 #include "vm/compiler/backend/block_scheduler.h"
@@ -27,14 +28,19 @@
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/cpu.h"
+#include "vm/dart.h"
 #include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/flags.h"
 #include "vm/hash_table.h"
+#include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
+#include "vm/json_writer.h"
 #include "vm/kernel_loader.h"  // For kernel::ParseStaticFieldInitializer.
 #include "vm/log.h"
 #include "vm/longjump.h"
+#include "vm/lockers.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/os.h"
@@ -46,6 +52,7 @@
 #include "vm/runtime_entry.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/timer.h"
 #include "vm/type_table.h"
@@ -61,11 +68,27 @@ namespace dart {
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynamic targets");
 DEFINE_FLAG(bool, print_gop, false, "Print global object pool");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(charp,
+            print_loading_units_to,
+            nullptr,
+            "Print the loading units deferred imports split the program into, "
+            "with the libraries and the size of the code of each, to the "
+            "given file");
 DEFINE_FLAG(
     int,
     max_speculative_inlining_attempts,
     1,
     "Max number of attempts with speculative inlining (precompilation only)");
+DEFINE_FLAG(int,
+            precompiler_tasks,
+            1,
+            "The number of tasks compiling the functions of each precompiler "
+            "round in parallel. With 1 they are compiled on the main thread.");
+DEFINE_FLAG(bool,
+            use_table_dispatch,
+            false,
+            "Dispatch instance calls with many possible targets through a "
+            "global table indexed by receiver class id (x64 and arm64).");
 
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
@@ -85,21 +108,102 @@ DECLARE_FLAG(int, inlining_caller_size_threshold);
 DECLARE_FLAG(int, inlining_constant_arguments_max_size_threshold);
 DECLARE_FLAG(int, inlining_constant_arguments_min_size_threshold);
 DECLARE_FLAG(bool, print_instruction_stats);
+DECLARE_FLAG(bool, print_compiler_pass_statistics);
 
 Precompiler* Precompiler::singleton_ = nullptr;
 
 #if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
     !defined(TARGET_ARCH_IA32)
 
+// The functions of one precompiler round, compiled by precompiler tasks.
+// Each task claims the next function and optimizes it concurrently with the
+// others, but code is generated and installed one function at a time in
+// claim order. This keeps the global object pool and the instructions laid out
+// as in a serial compilation of the round.
+class PrecompilationRound {
+ public:
+  PrecompilationRound(Precompiler* precompiler,
+                      const GrowableObjectArray& functions)
+      : precompiler_(precompiler),
+        functions_(functions),
+        next_function_(0),
+        next_turn_(0),
+        running_tasks_(0) {}
+
+  Precompiler* precompiler() const { return precompiler_; }
+
+  // Returns the index of the next function to compile, or -1 if all are
+  // claimed.
+  intptr_t ClaimNextFunction(Function* function) {
+    MonitorLocker ml(&monitor_);
+    if (next_function_ == functions_.Length()) {
+      return -1;
+    }
+    *function ^= functions_.At(next_function_);
+    return next_function_++;
+  }
+
+  // Blocks until the function at [index] may generate its code.
+  void WaitForTurn(Thread* thread, intptr_t index) {
+    MonitorLocker ml(&monitor_);
+    while (next_turn_ != index) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+
+  // Lets the function after [index] generate its code.
+  void FinishTurn(Thread* thread, intptr_t index) {
+    MonitorLocker ml(&monitor_);
+    while (next_turn_ != index) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+    next_turn_++;
+    ml.NotifyAll();
+  }
+
+  void TaskStarted() {
+    MonitorLocker ml(&monitor_);
+    running_tasks_++;
+  }
+
+  void TaskDone() {
+    MonitorLocker ml(&monitor_);
+    ASSERT(running_tasks_ > 0);
+    running_tasks_--;
+    ml.NotifyAll();
+  }
+
+  void WaitForTasks(Thread* thread) {
+    MonitorLocker ml(&monitor_);
+    while (running_tasks_ > 0) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+
+ private:
+  Precompiler* precompiler_;
+  const GrowableObjectArray& functions_;
+  Monitor monitor_;
+  intptr_t next_function_;
+  intptr_t next_turn_;
+  intptr_t running_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrecompilationRound);
+};
+
 class PrecompileParsedFunctionHelper : public ValueObject {
  public:
   PrecompileParsedFunctionHelper(Precompiler* precompiler,
                                  ParsedFunction* parsed_function,
-                                 bool optimized)
+                                 bool optimized,
+                                 PrecompilationRound* round = NULL,
+                                 intptr_t round_index = -1)
       : precompiler_(precompiler),
         parsed_function_(parsed_function),
         optimized_(optimized),
-        thread_(Thread::Current()) {}
+        thread_(Thread::Current()),
+        round_(round),
+        round_index_(round_index) {}
 
   bool Compile(CompilationPipeline* pipeline);
 
@@ -118,6 +222,8 @@ class PrecompileParsedFunctionHelper : public ValueObject {
   ParsedFunction* parsed_function_;
   const bool optimized_;
   Thread* const thread_;
+  PrecompilationRound* const round_;  // NULL unless run by a precompiler task.
+  const intptr_t round_index_;
 
   DISALLOW_COPY_AND_ASSIGN(PrecompileParsedFunctionHelper);
 };
@@ -164,6 +270,7 @@ Precompiler::Precompiler(Thread* thread)
       types_to_retain_(),
       consts_to_retain_(),
       error_(Error::Handle()),
+      dispatch_table_generator_(NULL),
       get_runtime_type_is_unique_(false) {
   ASSERT(Precompiler::singleton_ == NULL);
   Precompiler::singleton_ = this;
@@ -180,6 +287,8 @@ void Precompiler::DoCompileAll() {
   {
     StackZone stack_zone(T);
     zone_ = stack_zone.GetZone();
+    // Precompiled code never runs in the process compiling it.
+    ICacheFlushBatch icache_flush_batch(T);
 
     if (FLAG_use_bare_instructions) {
       // Since we keep the object pool until the end of AOT compilation, it
@@ -207,6 +316,15 @@ void Precompiler::DoCompileAll() {
       // as well as other type checks.
       HierarchyInfo hierarchy_info(T);
 
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+      // Lay out the dispatch table while the class hierarchy is known to be
+      // complete, so that calls compiled from here on can use its offsets.
+      if (FLAG_use_table_dispatch) {
+        dispatch_table_generator_ = new (Z) DispatchTableGenerator(Z);
+        dispatch_table_generator_->Initialize(I->class_table());
+      }
+#endif
+
       // Precompile constructors to compute information such as
       // optimized instruction count (used in inlining heuristics).
       ClassFinalizer::ClearAllCode(
@@ -286,6 +404,10 @@ void Precompiler::DoCompileAll() {
       // [Type]-specialized stubs.
       AttachOptimizedTypeTestingStub();
 
+      if (dispatch_table_generator_ != NULL) {
+        dispatch_table_generator_->BuildCodeArray();
+      }
+
       if (FLAG_use_bare_instructions) {
         // Now we generate the actual object pool instance and attach it to the
         // object store. The AOT runtime will use it from there in the enter
@@ -331,6 +453,9 @@ void Precompiler::DoCompileAll() {
       I->object_store()->set_async_star_move_next_helper(null_function);
       I->object_store()->set_complete_on_async_return(null_function);
       I->object_store()->set_async_star_stream_controller(null_class);
+      if (FLAG_print_loading_units_to != nullptr) {
+        PrintLoadingUnits();
+      }
       DropMetadata();
       DropLibraryEntries();
     }
@@ -343,6 +468,7 @@ void Precompiler::DoCompileAll() {
 
     ProgramVisitor::Dedup();
 
+    dispatch_table_generator_ = NULL;
     zone_ = NULL;
   }
 
@@ -369,6 +495,10 @@ void Precompiler::DoCompileAll() {
     THR_Print(" %" Pd " classes,", dropped_class_count_);
     THR_Print(" %" Pd " libraries.\n", dropped_library_count_);
   }
+
+  if (FLAG_print_compiler_pass_statistics) {
+    CompilerPassStatistics::PrintAndClear();
+  }
 }
 
 void Precompiler::PrecompileConstructors() {
@@ -444,15 +574,33 @@ void Precompiler::Iterate() {
     changed_ = false;
 
     while (pending_functions_.Length() > 0) {
-      function ^= pending_functions_.RemoveLast();
-      ProcessFunction(function);
+      if (FLAG_precompiler_tasks > 1) {
+        ProcessPendingFunctionsInParallel();
+      } else {
+        function ^= pending_functions_.RemoveLast();
+        ProcessFunction(function);
+      }
     }
 
+    AddDispatchTableSelectors();
     CheckForNewDynamicFunctions();
     CollectCallbackFields();
   }
 }
 
+// Calls through the dispatch table don't leave an IC in the object pool, so
+// the selectors of the rows they use are sent here instead.
+void Precompiler::AddDispatchTableSelectors() {
+  if (dispatch_table_generator_ == NULL) return;
+  for (intptr_t i = 0; i < dispatch_table_generator_->NumSelectors(); i++) {
+    const DispatchTableSelector* selector =
+        dispatch_table_generator_->SelectorAt(i);
+    if (dispatch_table_generator_->IsSelectorUsed(selector)) {
+      AddSelector(selector->name());
+    }
+  }
+}
+
 void Precompiler::CollectCallbackFields() {
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
@@ -553,6 +701,111 @@ void Precompiler::ProcessFunction(const Function& function) {
   AddCalleesOf(function, gop_offset);
 }
 
+static RawError* PrecompileFunctionHelper(Precompiler* precompiler,
+                                          CompilationPipeline* pipeline,
+                                          const Function& function,
+                                          bool optimized,
+                                          PrecompilationRound* round,
+                                          intptr_t round_index);
+
+class PrecompilerTask : public ThreadPool::Task {
+ public:
+  PrecompilerTask(Isolate* isolate, PrecompilationRound* round)
+      : isolate_(isolate), round_(round) {}
+
+  virtual void Run() {
+    bool result = Thread::EnterIsolateAsHelper(isolate_, Thread::kCompilerTask);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      StackZone stack_zone(thread);
+      HANDLESCOPE(thread);
+      Function& function = Function::Handle(stack_zone.GetZone());
+      intptr_t index;
+      while ((index = round_->ClaimNextFunction(&function)) >= 0) {
+        // A function which fails is left without code and compiled again on
+        // the main thread, which reports its errors.
+        const bool optimized = function.IsOptimizable();
+        DartCompilationPipeline pipeline;
+        PrecompileFunctionHelper(round_->precompiler(), &pipeline, function,
+                                 optimized, round_, index);
+        round_->FinishTurn(thread, index);
+      }
+    }
+    Thread::ExitIsolateAsHelper();
+    round_->TaskDone();
+  }
+
+ private:
+  Isolate* isolate_;
+  PrecompilationRound* round_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrecompilerTask);
+};
+
+// Compiles the pending functions on --precompiler_tasks tasks, then adds
+// their callees, which form the next round, in the order a serial
+// compilation would.
+void Precompiler::ProcessPendingFunctionsInParallel() {
+  const GrowableObjectArray& functions =
+      GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  const GrowableObjectArray& compiled_functions =
+      GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  Function& function = Function::Handle(Z);
+  while (pending_functions_.Length() > 0) {
+    function ^= pending_functions_.RemoveLast();
+    if (function.HasCode()) {
+      compiled_functions.Add(function);
+    } else {
+      functions.Add(function);
+    }
+  }
+  intptr_t gop_offset =
+      FLAG_use_bare_instructions ? global_object_pool_builder()->CurrentLength()
+                                 : 0;
+
+  {
+    // The global object pool allocates its handles in [zone_], which
+    // is safe since this thread does not use it until the tasks are done.
+    PrecompilationRound round(this, functions);
+    for (intptr_t i = 0; i < FLAG_precompiler_tasks; i++) {
+      round.TaskStarted();
+      if (!Dart::thread_pool()->Run(new PrecompilerTask(I, &round))) {
+        round.TaskDone();
+        break;
+      }
+    }
+    round.WaitForTasks(T);
+  }
+
+  for (intptr_t i = 0; i < compiled_functions.Length(); i++) {
+    function ^= compiled_functions.At(i);
+    ProcessFunction(function);
+  }
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    if (!function.HasCode()) {
+      ProcessFunction(function);
+      continue;
+    }
+    function_count_++;
+    if (FLAG_trace_precompiler) {
+      THR_Print("Precompiled %" Pd " %s (%s, %s)\n", function_count_,
+                function.ToLibNamePrefixedQualifiedCString(),
+                function.token_pos().ToCString(),
+                Function::KindToCString(function.kind()));
+    }
+    // Used in the JIT to save type-feedback across compilations.
+    function.ClearICDataArray();
+    // The pool entries of the whole round are scanned with its first
+    // function.
+    AddCalleesOf(function, gop_offset);
+    if (FLAG_use_bare_instructions) {
+      gop_offset = global_object_pool_builder()->CurrentLength();
+    }
+  }
+}
+
 void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
   ASSERT(function.HasCode());
 
@@ -1717,6 +1970,205 @@ void Precompiler::DropMetadata() {
   }
 }
 
+// Appends the indices of the libraries 'lib' depends on, either through its
+// deferred imports or through all of its other imports and exports.
+static void AddLibraryDependencies(Zone* zone,
+                                   const Library& lib,
+                                   bool deferred,
+                                   GrowableArray<intptr_t>* dependencies) {
+  Library& target = Library::Handle(zone);
+  Namespace& ns = Namespace::Handle(zone);
+  if (!deferred) {
+    for (intptr_t i = 0; i < lib.num_imports(); i++) {
+      target = lib.ImportLibraryAt(i);
+      if (!target.IsNull()) dependencies->Add(target.index());
+    }
+    const Array& exports = Array::Handle(zone, lib.exports());
+    for (intptr_t i = 0; i < exports.Length(); i++) {
+      ns ^= exports.At(i);
+      if (ns.IsNull()) continue;
+      target = ns.library();
+      dependencies->Add(target.index());
+    }
+  }
+  LibraryPrefix& prefix = LibraryPrefix::Handle(zone);
+  LibraryPrefixIterator it(lib);
+  while (it.HasNext()) {
+    prefix = it.GetNext();
+    if (prefix.is_deferred_load() != deferred) continue;
+    for (intptr_t i = 0; i < prefix.num_imports(); i++) {
+      target = prefix.GetLibrary(i);
+      if (!target.IsNull()) dependencies->Add(target.index());
+    }
+  }
+}
+
+// Deferred imports are loaded eagerly, so all code ends up in one snapshot.
+// Reports how the program splits into loading units, which is what a
+// snapshot split by deferred import would load on demand, and the size of
+// the code in each unit.
+//
+// A deferred import starts a unit holding the libraries it reaches without
+// going through the root unit. Libraries reached by several units stay in
+// the root unit so that they are loaded once.
+void Precompiler::PrintLoadingUnits() {
+  const intptr_t kUnreached = -1;
+  const intptr_t kShared = -2;
+  const intptr_t num_libraries = libraries_.Length();
+  Library& lib = Library::Handle(Z);
+
+  // The root unit: everything reachable without a deferred import.
+  GrowableArray<intptr_t> unit_of(num_libraries);
+  for (intptr_t i = 0; i < num_libraries; i++) {
+    lib ^= libraries_.At(i);
+    ASSERT(lib.index() == i);
+    unit_of.Add(kUnreached);
+  }
+  GrowableArray<intptr_t> worklist;
+  lib = I->object_store()->root_library();
+  worklist.Add(lib.index());
+  unit_of[lib.index()] = 0;
+  while (!worklist.is_empty()) {
+    lib ^= libraries_.At(worklist.RemoveLast());
+    GrowableArray<intptr_t> dependencies;
+    AddLibraryDependencies(Z, lib, /*deferred=*/false, &dependencies);
+    for (intptr_t i = 0; i < dependencies.length(); i++) {
+      if (unit_of[dependencies[i]] == kUnreached) {
+        unit_of[dependencies[i]] = 0;
+        worklist.Add(dependencies[i]);
+      }
+    }
+  }
+
+  // Every deferred import of a library outside the root unit starts a unit,
+  // including the ones of libraries only reachable through other deferred
+  // imports.
+  GrowableArray<intptr_t> unit_roots;
+  for (intptr_t i = 0; i < num_libraries; i++) {
+    lib ^= libraries_.At(i);
+    GrowableArray<intptr_t> dependencies;
+    AddLibraryDependencies(Z, lib, /*deferred=*/true, &dependencies);
+    for (intptr_t j = 0; j < dependencies.length(); j++) {
+      if (unit_of[dependencies[j]] == 0) continue;
+      bool seen = false;
+      for (intptr_t k = 0; k < unit_roots.length(); k++) {
+        seen = seen || (unit_roots[k] == dependencies[j]);
+      }
+      if (!seen) unit_roots.Add(dependencies[j]);
+    }
+  }
+  GrowableArray<bool> visited(num_libraries);
+  for (intptr_t i = 0; i < num_libraries; i++) {
+    visited.Add(false);
+  }
+  for (intptr_t unit = 1; unit <= unit_roots.length(); unit++) {
+    for (intptr_t i = 0; i < num_libraries; i++) {
+      visited[i] = false;
+    }
+    worklist.Add(unit_roots[unit - 1]);
+    visited[unit_roots[unit - 1]] = true;
+    while (!worklist.is_empty()) {
+      const intptr_t index = worklist.RemoveLast();
+      if (unit_of[index] == kUnreached) {
+        unit_of[index] = unit;
+      } else if (unit_of[index] != unit) {
+        unit_of[index] = kShared;
+      }
+      lib ^= libraries_.At(index);
+      GrowableArray<intptr_t> dependencies;
+      AddLibraryDependencies(Z, lib, /*deferred=*/false, &dependencies);
+      for (intptr_t j = 0; j < dependencies.length(); j++) {
+        const intptr_t dependency = dependencies[j];
+        if (!visited[dependency] && unit_of[dependency] != 0) {
+          visited[dependency] = true;
+          worklist.Add(dependency);
+        }
+      }
+    }
+  }
+  for (intptr_t i = 0; i < num_libraries; i++) {
+    if (unit_of[i] < 0) unit_of[i] = 0;
+  }
+
+  // Attribute the size of the retained code to the units.
+  class CodeSizeVisitor : public FunctionVisitor {
+   public:
+    CodeSizeVisitor(Zone* zone, GrowableArray<intptr_t>* library_sizes)
+        : cls_(Class::Handle(zone)),
+          lib_(Library::Handle(zone)),
+          code_(Code::Handle(zone)),
+          library_sizes_(library_sizes) {}
+
+    void Visit(const Function& function) {
+      if (!function.HasCode()) return;
+      code_ = function.CurrentCode();
+      cls_ = function.origin();
+      lib_ = cls_.library();
+      if (lib_.IsNull()) return;
+      (*library_sizes_)[lib_.index()] += code_.Size();
+    }
+
+   private:
+    Class& cls_;
+    Library& lib_;
+    Code& code_;
+    GrowableArray<intptr_t>* library_sizes_;
+  };
+  GrowableArray<intptr_t> library_sizes(num_libraries);
+  for (intptr_t i = 0; i < num_libraries; i++) {
+    library_sizes.Add(0);
+  }
+  CodeSizeVisitor visitor(Z, &library_sizes);
+  ProgramVisitor::VisitFunctions(&visitor);
+
+  JSONWriter js;
+  js.OpenObject();
+  js.OpenArray("loading_units");
+  String& url = String::Handle(Z);
+  for (intptr_t unit = 0; unit <= unit_roots.length(); unit++) {
+    js.OpenObject();
+    js.PrintProperty64("id", unit);
+    if (unit > 0) {
+      lib ^= libraries_.At(unit_roots[unit - 1]);
+      url = lib.url();
+      js.PrintProperty("deferred_import", url.ToCString());
+    }
+    intptr_t size = 0;
+    js.OpenArray("libraries");
+    for (intptr_t i = 0; i < num_libraries; i++) {
+      if (unit_of[i] != unit) continue;
+      lib ^= libraries_.At(i);
+      url = lib.url();
+      js.PrintValue(url.ToCString());
+      size += library_sizes[i];
+    }
+    js.CloseArray();
+    js.PrintProperty64("instructions_size", size);
+    js.CloseObject();
+  }
+  js.CloseArray();
+  js.CloseObject();
+
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    return;
+  }
+  auto file = file_open(FLAG_print_loading_units_to, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("Failed to open file %s\n", FLAG_print_loading_units_to);
+    return;
+  }
+  char* output = nullptr;
+  intptr_t output_length = 0;
+  js.Steal(&output, &output_length);
+  file_write(output, output_length, file);
+  free(output);
+  file_close(file);
+}
+
 void Precompiler::DropLibraryEntries() {
   Library& lib = Library::Handle(Z);
   Array& dict = Array::Handle(Z);
@@ -2244,7 +2696,7 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
 
   if (optimized()) {
     // Installs code while at safepoint.
-    ASSERT(thread()->IsMutatorThread());
+    ASSERT(thread()->IsMutatorThread() || (round_ != NULL));
     function.InstallOptimizedCode(code);
   } else {  // not optimized.
     function.set_unoptimized_code(code);
@@ -2268,6 +2720,7 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   bool is_compiled = false;
   Zone* const zone = thread()->zone();
   HANDLESCOPE(thread());
+  const int64_t start_micros = OS::GetCurrentMonotonicMicros();
 
   // We may reattempt compilation if the function needs to be assembled using
   // far branches on ARM. In the else branch of the setjmp call, done is set to
@@ -2343,6 +2796,12 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 
       ASSERT(!FLAG_use_bare_instructions || precompiler_ != nullptr);
 
+      if (round_ != NULL) {
+        // Generates the code in the order of the round, so that the global
+        // object pool does not depend on the scheduling of the tasks.
+        round_->WaitForTurn(thread(), round_index_);
+      }
+
       ObjectPoolBuilder object_pool;
       ObjectPoolBuilder* active_object_pool_builder =
           FLAG_use_bare_instructions
@@ -2369,9 +2828,21 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
       }
       {
         TIMELINE_DURATION(thread(), CompilerVerbose, "FinalizeCompilation");
-        ASSERT(thread()->IsMutatorThread());
-        FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
-                            function_stats);
+        if (round_ == NULL) {
+          ASSERT(thread()->IsMutatorThread());
+          FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
+                              function_stats);
+        } else {
+          // Installs the code while the other precompiler tasks are stopped.
+          SafepointOperationScope safepoint_scope(thread());
+          FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
+                              function_stats);
+        }
+      }
+      if (FLAG_print_compiler_pass_statistics) {
+        CompilerPassStatistics::RecordFunction(
+            function, OS::GetCurrentMonotonicMicros() - start_micros,
+            pass_state);
       }
       // Exit the loop and the function with the correct result value.
       is_compiled = true;
@@ -2426,7 +2897,9 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 static RawError* PrecompileFunctionHelper(Precompiler* precompiler,
                                           CompilationPipeline* pipeline,
                                           const Function& function,
-                                          bool optimized) {
+                                          bool optimized,
+                                          PrecompilationRound* round,
+                                          intptr_t round_index) {
   // Check that we optimize, except if the function is not optimizable.
   ASSERT(FLAG_precompiled_mode);
   ASSERT(!function.IsOptimizable() || optimized);
@@ -2455,11 +2928,16 @@ static RawError* PrecompileFunctionHelper(Precompiler* precompiler,
     }
 
     PrecompileParsedFunctionHelper helper(precompiler, parsed_function,
-                                          optimized);
+                                          optimized, round, round_index);
     const bool success = helper.Compile(pipeline);
     if (!success) {
       // We got an error during compilation.
       const Error& error = Error::Handle(thread->StealStickyError());
+      if (error.IsNull()) {
+        // A precompiler task gave up, e.g. on a background compilation abort.
+        ASSERT(round != NULL);
+        return Error::null();
+      }
       ASSERT(error.IsLanguageError() &&
              LanguageError::Cast(error).kind() != Report::kBailout);
       return error.raw();
@@ -2490,8 +2968,11 @@ static RawError* PrecompileFunctionHelper(Precompiler* precompiler,
     // We got an error during compilation.
     const Error& error = Error::Handle(thread->StealStickyError());
     // Precompilation may encounter compile-time errors.
-    // Do not attempt to optimize functions that can cause errors.
-    function.set_is_optimizable(false);
+    // Do not attempt to optimize functions that can cause errors. A function
+    // failing on a precompiler task is compiled again on the main thread.
+    if (round == NULL) {
+      function.set_is_optimizable(false);
+    }
     return error.raw();
   }
   UNREACHABLE();
@@ -2508,7 +2989,8 @@ RawError* Precompiler::CompileFunction(Precompiler* precompiler,
   ASSERT(FLAG_precompiled_mode);
   const bool optimized = function.IsOptimizable();  // False for natives.
   DartCompilationPipeline pipeline;
-  return PrecompileFunctionHelper(precompiler, &pipeline, function, optimized);
+  return PrecompileFunctionHelper(precompiler, &pipeline, function, optimized,
+                                  /*round=*/NULL, /*round_index=*/-1);
 }
 
 Obfuscator::Obfuscator(Thread* thread, const String& private_key)
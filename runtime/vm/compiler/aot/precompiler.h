@@ -26,6 +26,7 @@ class String;
 class ParsedJSONObject;
 class ParsedJSONArray;
 class Precompiler;
+class DispatchTableGenerator;
 class FlowGraph;
 class PrecompilerEntryPointsPrinter;
 
@@ -233,6 +234,12 @@ class Precompiler : public ValueObject {
     return &global_object_pool_builder_;
   }
 
+  // The generator of the global dispatch table, or NULL if instance calls
+  // are not dispatched through it (see --use-table-dispatch).
+  DispatchTableGenerator* dispatch_table_generator() const {
+    return dispatch_table_generator_;
+  }
+
   static Precompiler* Instance() { return singleton_; }
 
  private:
@@ -262,7 +269,10 @@ class Precompiler : public ValueObject {
   void AddSelector(const String& selector);
   bool IsSent(const String& selector);
 
+  void AddDispatchTableSelectors();
+
   void ProcessFunction(const Function& function);
+  void ProcessPendingFunctionsInParallel();
   void CheckForNewDynamicFunctions();
   void CollectCallbackFields();
 
@@ -274,6 +284,7 @@ class Precompiler : public ValueObject {
   void TraceTypesFromRetainedClasses();
   void DropTypes();
   void DropTypeArguments();
+  void PrintLoadingUnits();
   void DropMetadata();
   void DropLibraryEntries();
   void DropClasses();
@@ -323,6 +334,7 @@ class Precompiler : public ValueObject {
   AbstractTypeSet types_to_retain_;
   InstanceSet consts_to_retain_;
   Error& error_;
+  DispatchTableGenerator* dispatch_table_generator_;
 
   bool get_runtime_type_is_unique_;
 };
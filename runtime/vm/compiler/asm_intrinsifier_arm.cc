@@ -1824,6 +1824,16 @@ void AsmIntrinsifier::Object_setHash(Assembler* assembler,
   UNREACHABLE();
 }
 
+void AsmIntrinsifier::StringBaseCompareTo(Assembler* assembler,
+                                          Label* normal_ir_body) {
+  // Only implemented on 64-bit architectures.
+}
+
+void AsmIntrinsifier::OneByteString_indexOfCodeUnit(Assembler* assembler,
+                                                    Label* normal_ir_body) {
+  // Only implemented on 64-bit architectures.
+}
+
 void AsmIntrinsifier::StringBaseCharAt(Assembler* assembler,
                                        Label* normal_ir_body) {
   Label try_two_byte_string;
@@ -2201,6 +2211,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2));
   __ ldr(R0, FieldAddress(R1, target::RegExp::function_offset(kOneByteStringCid,
                                                               sticky)));
+  // Until the regexp tiers up the field holds null or bytecode, which the
+  // native interprets.
+  __ CompareClassId(R0, kFunctionCid, R1);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R9.
@@ -2209,6 +2223,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ ldr(CODE_REG, FieldAddress(R0, target::Function::code_offset()));
   __ Branch(FieldAddress(R0, target::Function::entry_point_offset()));
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+0).
@@ -1822,6 +1822,28 @@ void GenerateSubstringMatchesSpecialization(Assembler* assembler,
   // i = 0
   __ LoadImmediate(R3, 0);
 
+  if ((receiver_cid == kOneByteStringCid) &&
+      (other_cid == kOneByteStringCid)) {
+    // Compare eight code units at a time while at least eight remain.
+    Label word_loop, tail;
+    __ Bind(&word_loop);
+    __ add(R6, R3, Operand(8));
+    __ cmp(R6, Operand(R9));
+    __ b(&tail, GT);
+    __ ldr(R10, Address(R0, 0));
+    __ ldr(R11, Address(R2, 0));
+    __ cmp(R10, Operand(R11));
+    __ b(return_false, NE);
+    __ mov(R3, R6);
+    __ add(R0, R0, Operand(8));
+    __ add(R2, R2, Operand(8));
+    __ b(&word_loop);
+
+    __ Bind(&tail);
+    __ cmp(R3, Operand(R9));
+    __ b(return_true, GE);
+  }
+
   // do
   Label loop;
   __ Bind(&loop);
@@ -1886,6 +1908,196 @@ void AsmIntrinsifier::StringBaseSubstringMatches(Assembler* assembler,
   __ Bind(normal_ir_body);
 }
 
+// Compares the code units of R0 and R2, which are both of class [cid],
+// eight bytes at a time. The index of the first differing code unit is
+// found from the lowest set bit of the xor of the first differing words,
+// since the strings are stored little endian.
+static void GenerateStringCompareToSpecialization(Assembler* assembler,
+                                                  intptr_t cid,
+                                                  Label* return_less,
+                                                  Label* return_greater,
+                                                  Label* return_equal) {
+  const intptr_t data_offset = (cid == kOneByteStringCid)
+                                   ? target::OneByteString::data_offset()
+                                   : target::TwoByteString::data_offset();
+  const intptr_t char_size = (cid == kOneByteStringCid) ? 1 : 2;
+  __ ldr(R6, FieldAddress(R0, target::String::length_offset()));
+  __ ldr(R7, FieldAddress(R2, target::String::length_offset()));
+
+  // R3: Number of bytes to compare, min(this.length, other.length) code
+  // units.
+  __ cmp(R6, Operand(R7));
+  __ csel(R3, R6, R7, LE);
+  if (char_size == 1) {
+    __ SmiUntag(R3);
+  } else {
+    ASSERT(kSmiTagShift == 1);  // A Smi length is the size in bytes.
+  }
+  __ AddImmediate(R0, data_offset - kHeapObjectTag);
+  __ AddImmediate(R2, data_offset - kHeapObjectTag);
+
+  // R8: Byte offset of the current word or code unit.
+  Label word_loop, found_difference, unit_loop, compare_unit;
+  __ mov(R8, ZR);
+  __ Bind(&word_loop);
+  __ add(R9, R8, Operand(8));
+  __ cmp(R9, Operand(R3));
+  __ b(&unit_loop, GT);
+  __ ldr(R10, Address(R0, R8));
+  __ ldr(R11, Address(R2, R8));
+  __ eor(R10, R10, Operand(R11));
+  __ cbnz(&found_difference, R10);
+  __ mov(R8, R9);
+  __ b(&word_loop);
+
+  __ Bind(&found_difference);
+  // Isolate the lowest differing bit and turn its index, 63 - clz, into the
+  // byte offset of the code unit containing it.
+  __ neg(R11, R10);
+  __ and_(R10, R10, Operand(R11));
+  __ clz(R10, R10);
+  __ eori(R10, R10, Immediate(63));
+  __ LsrImmediate(R10, R10, 3);
+  if (char_size == 2) {
+    __ andi(R10, R10, Immediate(~1));
+  }
+  __ add(R8, R8, Operand(R10));
+  __ b(&compare_unit);
+
+  __ Bind(&unit_loop);
+  __ cmp(R8, Operand(R3));
+  __ b(return_equal, GE);
+  __ Bind(&compare_unit);
+  const OperandSize size =
+      (char_size == 1) ? kUnsignedByte : kUnsignedHalfword;
+  __ ldr(R10, Address(R0, R8), size);
+  __ ldr(R11, Address(R2, R8), size);
+  __ cmp(R10, Operand(R11));
+  __ b(return_less, LT);
+  __ b(return_greater, GT);
+  __ add(R8, R8, Operand(char_size));
+  __ b(&unit_loop);
+}
+
+// int compareTo(String other)
+// This intrinsic handles a receiver and other which are both OneByteStrings
+// or both TwoByteStrings.
+void AsmIntrinsifier::StringBaseCompareTo(Assembler* assembler,
+                                          Label* normal_ir_body) {
+  Label return_less, return_greater, return_equal, try_two_byte;
+  __ ldr(R0, Address(SP, 1 * target::kWordSize));  // this
+  __ ldr(R2, Address(SP, 0 * target::kWordSize));  // other
+
+  __ BranchIfSmi(R2, normal_ir_body);
+
+  __ LoadClassId(R3, R0);
+  __ LoadClassId(R4, R2);
+  __ cmp(R3, Operand(R4));
+  __ b(normal_ir_body, NE);
+
+  __ CompareImmediate(R3, kOneByteStringCid);
+  __ b(&try_two_byte, NE);
+  GenerateStringCompareToSpecialization(assembler, kOneByteStringCid,
+                                        &return_less, &return_greater,
+                                        &return_equal);
+
+  __ Bind(&try_two_byte);
+  __ CompareImmediate(R3, kTwoByteStringCid);
+  __ b(normal_ir_body, NE);
+  GenerateStringCompareToSpecialization(assembler, kTwoByteStringCid,
+                                        &return_less, &return_greater,
+                                        &return_equal);
+
+  __ Bind(&return_equal);
+  // All compared code units are equal, the shorter string is smaller.
+  __ cmp(R6, Operand(R7));
+  __ b(&return_less, LT);
+  __ b(&return_greater, GT);
+  __ LoadImmediate(R0, target::ToRawSmi(0));
+  __ ret();
+
+  __ Bind(&return_less);
+  __ LoadImmediate(R0, target::ToRawSmi(-1));
+  __ ret();
+
+  __ Bind(&return_greater);
+  __ LoadImmediate(R0, target::ToRawSmi(1));
+  __ ret();
+
+  __ Bind(normal_ir_body);
+}
+
+// int _indexOfCodeUnit(int codeUnit, int start)
+// Scans a OneByteString eight code units at a time: after xor-ing a word
+// with the code unit replicated into every byte the matching bytes are
+// zero and are found with the usual (x - 0x01..01) & ~x & 0x80..80 test,
+// whose lowest set bit marks the first match.
+void AsmIntrinsifier::OneByteString_indexOfCodeUnit(Assembler* assembler,
+                                                    Label* normal_ir_body) {
+  Label word_loop, found_in_word, unit_loop, found, not_found;
+  __ ldr(R0, Address(SP, 2 * target::kWordSize));  // this
+  __ ldr(R1, Address(SP, 1 * target::kWordSize));  // codeUnit
+  __ ldr(R2, Address(SP, 0 * target::kWordSize));  // start
+
+  __ orr(R3, R1, Operand(R2));
+  __ BranchIfNotSmi(R3, normal_ir_body);  // 'codeUnit' or 'start' not Smi.
+  // Both have to be non-negative, codeUnit has to fit in a byte.
+  __ CompareImmediate(R1, target::ToRawSmi(0xFF));
+  __ b(normal_ir_body, HI);
+  __ tbnz(normal_ir_body, R2, kBitsPerInt64 - 1);
+
+  __ ldr(R3, FieldAddress(R0, target::String::length_offset()));
+  __ SmiUntag(R3);
+  __ SmiUntag(R1);
+  __ SmiUntag(R2);
+  __ AddImmediate(R0, target::OneByteString::data_offset() - kHeapObjectTag);
+
+  // R6: codeUnit in every byte, R7: 0x01..01, R8: 0x80..80.
+  __ LoadImmediate(R7, 0x0101010101010101LL);
+  __ mul(R6, R1, R7);
+  __ LoadImmediate(R8, 0x8080808080808080LL);
+
+  __ Bind(&word_loop);
+  __ add(R9, R2, Operand(8));
+  __ cmp(R9, Operand(R3));
+  __ b(&unit_loop, GT);
+  __ ldr(R10, Address(R0, R2));
+  __ eor(R10, R10, Operand(R6));
+  __ sub(R11, R10, Operand(R7));
+  __ bic(R11, R11, Operand(R10));
+  __ ands(R11, R11, Operand(R8));
+  __ b(&found_in_word, NE);
+  __ mov(R2, R9);
+  __ b(&word_loop);
+
+  __ Bind(&found_in_word);
+  __ neg(R10, R11);
+  __ and_(R11, R11, Operand(R10));
+  __ clz(R11, R11);
+  __ eori(R11, R11, Immediate(63));
+  __ add(R2, R2, Operand(R11, LSR, 3));
+  __ b(&found);
+
+  __ Bind(&unit_loop);
+  __ cmp(R2, Operand(R3));
+  __ b(&not_found, GE);
+  __ ldr(R10, Address(R0, R2), kUnsignedByte);
+  __ cmp(R10, Operand(R1));
+  __ b(&found, EQ);
+  __ add(R2, R2, Operand(1));
+  __ b(&unit_loop);
+
+  __ Bind(&found);
+  __ SmiTag(R0, R2);
+  __ ret();
+
+  __ Bind(&not_found);
+  __ LoadImmediate(R0, target::ToRawSmi(-1));
+  __ ret();
+
+  __ Bind(normal_ir_body);
+}
+
 void AsmIntrinsifier::StringBaseCharAt(Assembler* assembler,
                                        Label* normal_ir_body) {
   Label try_two_byte_string;
@@ -2263,6 +2475,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2));
   __ ldr(R0, FieldAddress(R1, target::RegExp::function_offset(kOneByteStringCid,
                                                               sticky)));
+  // Until the regexp tiers up the field holds null or bytecode, which the
+  // native interprets.
+  __ CompareClassId(R0, kFunctionCid);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R5.
@@ -2272,6 +2488,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ ldr(CODE_REG, FieldAddress(R0, target::Function::code_offset()));
   __ ldr(R1, FieldAddress(R0, target::Function::entry_point_offset()));
   __ br(R1);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+0).
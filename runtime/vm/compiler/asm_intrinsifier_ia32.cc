@@ -1826,6 +1826,16 @@ void AsmIntrinsifier::Object_setHash(Assembler* assembler,
   UNREACHABLE();
 }
 
+void AsmIntrinsifier::StringBaseCompareTo(Assembler* assembler,
+                                          Label* normal_ir_body) {
+  // Only implemented on 64-bit architectures.
+}
+
+void AsmIntrinsifier::OneByteString_indexOfCodeUnit(Assembler* assembler,
+                                                    Label* normal_ir_body) {
+  // Only implemented on 64-bit architectures.
+}
+
 void AsmIntrinsifier::StringBaseCharAt(Assembler* assembler,
                                        Label* normal_ir_body) {
   Label try_two_byte_string;
@@ -2200,6 +2210,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movl(EAX, FieldAddress(
                    EBX, EDI, TIMES_4,
                    target::RegExp::function_offset(kOneByteStringCid, sticky)));
+  // Until the regexp tiers up the field holds null or bytecode, which the
+  // native interprets.
+  __ CompareClassId(EAX, kFunctionCid, EDI);
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in EAX, the argument descriptor in EDX, and IC-Data in ECX.
@@ -2208,6 +2222,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ movl(EDI, FieldAddress(EAX, target::Function::entry_point_offset()));
   __ jmp(EDI);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+1), return-address (+0).
@@ -1769,6 +1769,28 @@ void GenerateSubstringMatchesSpecialization(Assembler* assembler,
   __ SmiUntag(R9);                      // other.length
   __ LoadImmediate(R11, Immediate(0));  // i = 0
 
+  if ((receiver_cid == kOneByteStringCid) &&
+      (other_cid == kOneByteStringCid)) {
+    // Compare eight code units at a time while at least eight remain.
+    Label word_loop, tail;
+    __ Bind(&word_loop);
+    __ leaq(R8, Address(R11, 8));
+    __ cmpq(R8, R9);
+    __ j(GREATER, &tail, Assembler::kNearJump);
+    __ leaq(R8, Address(R11, RBX, TIMES_1, 0));
+    __ movq(R12, FieldAddress(RAX, R8, TIMES_1,
+                              target::OneByteString::data_offset()));
+    __ cmpq(R12, FieldAddress(RCX, R11, TIMES_1,
+                              target::OneByteString::data_offset()));
+    __ j(NOT_EQUAL, return_false);
+    __ addq(R11, Immediate(8));
+    __ jmp(&word_loop, Assembler::kNearJump);
+
+    __ Bind(&tail);
+    __ cmpq(R11, R9);
+    __ j(GREATER_EQUAL, return_true);
+  }
+
   // do
   Label loop;
   __ Bind(&loop);
@@ -1847,6 +1869,210 @@ void AsmIntrinsifier::StringBaseSubstringMatches(Assembler* assembler,
   __ Bind(normal_ir_body);
 }
 
+// Compares the code units of RAX and RCX, which are both of class [cid],
+// eight bytes at a time. The index of the first differing code unit is
+// found from the lowest set bit of the xor of the first differing words,
+// since the strings are stored little endian.
+static void GenerateStringCompareToSpecialization(Assembler* assembler,
+                                                  intptr_t cid,
+                                                  Label* return_less,
+                                                  Label* return_greater,
+                                                  Label* return_equal) {
+  const intptr_t data_offset = (cid == kOneByteStringCid)
+                                   ? target::OneByteString::data_offset()
+                                   : target::TwoByteString::data_offset();
+  const intptr_t char_size = (cid == kOneByteStringCid) ? 1 : 2;
+  __ movq(R8, FieldAddress(RAX, target::String::length_offset()));
+  __ movq(R9, FieldAddress(RCX, target::String::length_offset()));
+
+  // RDX: Number of bytes to compare, min(this.length, other.length) code
+  // units.
+  Label length_done;
+  __ movq(RDX, R8);
+  __ cmpq(RDX, R9);
+  __ j(LESS_EQUAL, &length_done, Assembler::kNearJump);
+  __ movq(RDX, R9);
+  __ Bind(&length_done);
+  if (char_size == 1) {
+    __ SmiUntag(RDX);
+  } else {
+    ASSERT(kSmiTagShift == 1);  // A Smi length is the size in bytes.
+  }
+
+  // RDI: Byte offset of the current word or code unit.
+  Label word_loop, found_difference, unit_loop, compare_unit;
+  __ xorq(RDI, RDI);
+  __ Bind(&word_loop);
+  __ leaq(RSI, Address(RDI, 8));
+  __ cmpq(RSI, RDX);
+  __ j(GREATER, &unit_loop, Assembler::kNearJump);
+  __ movq(RSI, FieldAddress(RAX, RDI, TIMES_1, data_offset));
+  __ xorq(RSI, FieldAddress(RCX, RDI, TIMES_1, data_offset));
+  __ j(NOT_ZERO, &found_difference, Assembler::kNearJump);
+  __ addq(RDI, Immediate(8));
+  __ jmp(&word_loop, Assembler::kNearJump);
+
+  __ Bind(&found_difference);
+  // Isolate the lowest differing bit and turn its index into the byte offset
+  // of the code unit containing it.
+  __ movq(R11, RSI);
+  __ negq(R11);
+  __ andq(RSI, R11);
+  __ bsrq(RSI, RSI);
+  __ shrq(RSI, Immediate(3));
+  if (char_size == 2) {
+    __ andq(RSI, Immediate(~1));
+  }
+  __ addq(RDI, RSI);
+  __ jmp(&compare_unit, Assembler::kNearJump);
+
+  __ Bind(&unit_loop);
+  __ cmpq(RDI, RDX);
+  __ j(GREATER_EQUAL, return_equal);
+  __ Bind(&compare_unit);
+  if (char_size == 1) {
+    __ movzxb(RSI, FieldAddress(RAX, RDI, TIMES_1, data_offset));
+    __ movzxb(R11, FieldAddress(RCX, RDI, TIMES_1, data_offset));
+  } else {
+    __ movzxw(RSI, FieldAddress(RAX, RDI, TIMES_1, data_offset));
+    __ movzxw(R11, FieldAddress(RCX, RDI, TIMES_1, data_offset));
+  }
+  __ cmpq(RSI, R11);
+  __ j(LESS, return_less);
+  __ j(GREATER, return_greater);
+  __ addq(RDI, Immediate(char_size));
+  __ jmp(&unit_loop, Assembler::kNearJump);
+}
+
+// int compareTo(String other)
+// This intrinsic handles a receiver and other which are both OneByteStrings
+// or both TwoByteStrings.
+void AsmIntrinsifier::StringBaseCompareTo(Assembler* assembler,
+                                          Label* normal_ir_body) {
+  Label return_less, return_greater, return_equal, try_two_byte;
+  __ movq(RAX, Address(RSP, +2 * target::kWordSize));  // receiver
+  __ movq(RCX, Address(RSP, +1 * target::kWordSize));  // other
+
+  __ testq(RCX, Immediate(kSmiTagMask));
+  __ j(ZERO, normal_ir_body);  // 'other' is a Smi.
+
+  __ LoadClassId(RDI, RAX);
+  __ LoadClassId(RSI, RCX);
+  __ cmpq(RDI, RSI);
+  __ j(NOT_EQUAL, normal_ir_body);
+
+  __ cmpq(RDI, Immediate(kOneByteStringCid));
+  __ j(NOT_EQUAL, &try_two_byte);
+  GenerateStringCompareToSpecialization(assembler, kOneByteStringCid,
+                                        &return_less, &return_greater,
+                                        &return_equal);
+
+  __ Bind(&try_two_byte);
+  __ cmpq(RDI, Immediate(kTwoByteStringCid));
+  __ j(NOT_EQUAL, normal_ir_body);
+  GenerateStringCompareToSpecialization(assembler, kTwoByteStringCid,
+                                        &return_less, &return_greater,
+                                        &return_equal);
+
+  __ Bind(&return_equal);
+  // All compared code units are equal, the shorter string is smaller.
+  __ cmpq(R8, R9);
+  __ j(LESS, &return_less, Assembler::kNearJump);
+  __ j(GREATER, &return_greater, Assembler::kNearJump);
+  __ LoadImmediate(RAX, Immediate(target::ToRawSmi(0)));
+  __ ret();
+
+  __ Bind(&return_less);
+  __ LoadImmediate(RAX, Immediate(target::ToRawSmi(-1)));
+  __ ret();
+
+  __ Bind(&return_greater);
+  __ LoadImmediate(RAX, Immediate(target::ToRawSmi(1)));
+  __ ret();
+
+  __ Bind(normal_ir_body);
+}
+
+// int _indexOfCodeUnit(int codeUnit, int start)
+// Scans a OneByteString eight code units at a time: after xor-ing a word
+// with the code unit replicated into every byte the matching bytes are
+// zero and are found with the usual (x - 0x01..01) & ~x & 0x80..80 test,
+// whose lowest set bit marks the first match.
+void AsmIntrinsifier::OneByteString_indexOfCodeUnit(Assembler* assembler,
+                                                    Label* normal_ir_body) {
+  Label word_loop, found_in_word, unit_loop, found, not_found;
+  __ movq(RAX, Address(RSP, +3 * target::kWordSize));  // receiver
+  __ movq(RBX, Address(RSP, +2 * target::kWordSize));  // codeUnit
+  __ movq(RCX, Address(RSP, +1 * target::kWordSize));  // start
+
+  __ movq(RDX, RBX);
+  __ orq(RDX, RCX);
+  __ testq(RDX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, normal_ir_body);  // 'codeUnit' or 'start' is not Smi.
+  // Both have to be non-negative, codeUnit has to fit in a byte.
+  __ cmpq(RBX, Immediate(target::ToRawSmi(0xFF)));
+  __ j(ABOVE, normal_ir_body);
+  __ testq(RCX, RCX);
+  __ j(SIGN, normal_ir_body);
+
+  __ movq(RDX, FieldAddress(RAX, target::String::length_offset()));
+  __ SmiUntag(RDX);
+  __ SmiUntag(RBX);
+  __ SmiUntag(RCX);
+
+  // R8: codeUnit in every byte, R9: 0x01..01, R11: 0x80..80.
+  __ LoadImmediate(R9, Immediate(0x0101010101010101LL));
+  __ movq(R8, RBX);
+  __ imulq(R8, R9);
+  __ LoadImmediate(R11, Immediate(0x8080808080808080LL));
+
+  __ Bind(&word_loop);
+  __ leaq(RSI, Address(RCX, 8));
+  __ cmpq(RSI, RDX);
+  __ j(GREATER, &unit_loop, Assembler::kNearJump);
+  __ movq(RDI, FieldAddress(RAX, RCX, TIMES_1,
+                            target::OneByteString::data_offset()));
+  __ xorq(RDI, R8);
+  __ movq(RSI, RDI);
+  __ subq(RSI, R9);
+  __ notq(RDI);
+  __ andq(RSI, RDI);
+  __ andq(RSI, R11);
+  __ j(NOT_ZERO, &found_in_word, Assembler::kNearJump);
+  __ addq(RCX, Immediate(8));
+  __ jmp(&word_loop, Assembler::kNearJump);
+
+  __ Bind(&found_in_word);
+  __ movq(RDI, RSI);
+  __ negq(RDI);
+  __ andq(RSI, RDI);
+  __ bsrq(RSI, RSI);
+  __ shrq(RSI, Immediate(3));
+  __ addq(RCX, RSI);
+  __ jmp(&found, Assembler::kNearJump);
+
+  __ Bind(&unit_loop);
+  __ cmpq(RCX, RDX);
+  __ j(GREATER_EQUAL, &not_found, Assembler::kNearJump);
+  __ movzxb(RDI, FieldAddress(RAX, RCX, TIMES_1,
+                              target::OneByteString::data_offset()));
+  __ cmpq(RDI, RBX);
+  __ j(EQUAL, &found, Assembler::kNearJump);
+  __ incq(RCX);
+  __ jmp(&unit_loop, Assembler::kNearJump);
+
+  __ Bind(&found);
+  __ movq(RAX, RCX);
+  __ SmiTag(RAX);
+  __ ret();
+
+  __ Bind(&not_found);
+  __ LoadImmediate(RAX, Immediate(target::ToRawSmi(-1)));
+  __ ret();
+
+  __ Bind(normal_ir_body);
+}
+
 void AsmIntrinsifier::StringBaseCharAt(Assembler* assembler,
                                        Label* normal_ir_body) {
   Label try_two_byte_string;
@@ -2228,6 +2454,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movq(RAX, FieldAddress(
                    RBX, RDI, TIMES_8,
                    target::RegExp::function_offset(kOneByteStringCid, sticky)));
+  // Until the regexp tiers up the field holds null or bytecode, which the
+  // native interprets.
+  __ CompareClassId(RAX, kFunctionCid);
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in RAX, the argument descriptor in R10, and IC-Data in RCX.
@@ -2237,6 +2467,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movq(CODE_REG, FieldAddress(RAX, target::Function::code_offset()));
   __ movq(RDI, FieldAddress(RAX, target::Function::entry_point_offset()));
   __ jmp(RDI);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+1), return-address (+0).
@@ -1482,7 +1482,7 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
   ldr(temp_reg, Address(temp_reg, table_offset));
   AddImmediate(temp_reg, state_offset);
   ldr(temp_reg, Address(temp_reg, 0));
-  tsti(temp_reg, Immediate(ClassHeapStats::TraceAllocationMask()));
+  tsti(temp_reg, Immediate(ClassHeapStats::AllocationSlowPathMask()));
   b(trace, NE);
 }
 
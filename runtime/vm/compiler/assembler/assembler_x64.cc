@@ -221,6 +221,18 @@ void Assembler::TransitionNativeToGenerated() {
   movq(Address(THR, Thread::top_exit_frame_info_offset()), Immediate(0));
 }
 
+void Assembler::PollForInterrupts(Label* slow_path) {
+  movq(TMP, Address(THR, compiler::target::Thread::poll_page_offset()));
+  movq(TMP, Address(TMP, 0));
+  // nopl [RAX + disp32], where disp32 is the distance from the end of the
+  // nop to the slow path.
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x0F);
+  EmitUint8(0x1F);
+  EmitUint8(0x80);
+  EmitLabel(slow_path, 4);
+}
+
 void Assembler::EmitQ(int reg,
                       const Address& address,
                       int opcode,
@@ -387,6 +399,33 @@ void Assembler::EmitL(int dst, int src, int opcode, int prefix2, int prefix1) {
   EmitRegisterOperand(dst & 7, src);
 }
 
+void Assembler::EmitVex(int reg,
+                        int vvvv,
+                        int rm,
+                        int opcode,
+                        VexPrefix prefix,
+                        VexMap map,
+                        bool w) {
+  ASSERT(reg <= XMM15);
+  ASSERT(vvvv <= XMM15);
+  ASSERT(rm <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // R, X, B and vvvv are stored inverted.
+  const uint8_t r_bit = (reg > 7) ? 0 : 0x80;
+  const uint8_t b_bit = (rm > 7) ? 0 : 0x20;
+  const uint8_t vvvv_bits = (~vvvv & 0xF) << 3;
+  if ((b_bit != 0) && (map == kVex0F) && !w) {
+    EmitUint8(0xC5);
+    EmitUint8(r_bit | vvvv_bits | prefix);
+  } else {
+    EmitUint8(0xC4);
+    EmitUint8(r_bit | 0x40 | b_bit | map);
+    EmitUint8((w ? 0x80 : 0) | vvvv_bits | prefix);
+  }
+  EmitUint8(opcode);
+  EmitRegisterOperand(reg & 7, rm);
+}
+
 void Assembler::EmitW(Register dst,
                       Register src,
                       int opcode,
@@ -1780,7 +1819,7 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
       Isolate::class_table_offset() + ClassTable::TableOffsetFor(cid);
   movq(temp_reg, Address(temp_reg, table_offset));
   testb(Address(temp_reg, state_offset),
-        Immediate(target::ClassHeapStats::TraceAllocationMask()));
+        Immediate(target::ClassHeapStats::AllocationSlowPathMask()));
   // We are tracing for this class, jump to the trace label which will use
   // the allocation stub.
   j(NOT_ZERO, trace, near_jump);
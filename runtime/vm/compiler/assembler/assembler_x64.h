@@ -309,6 +309,11 @@ class Assembler : public AssemblerBase {
   void TransitionGeneratedToNative(Register destination_address);
   void TransitionNativeToGenerated();
 
+  // Loads from the thread's poll page, which faults while an interrupt is
+  // pending, and records slow_path for the fault handler. Clobbers TMP. See
+  // vm/poll_page.h.
+  void PollForInterrupts(Label* slow_path);
+
 // Register-register, register-address and address-register instructions.
 #define RR(width, name, ...)                                                   \
   void name(Register dst, Register src) { Emit##width(dst, src, __VA_ARGS__); }
@@ -421,6 +426,31 @@ class Assembler : public AssemblerBase {
   AX(L, name##ss, 0x50 + code, 0x0F, 0xF3)
   XMM_ALU_CODES(DECLARE_XMM)
 #undef DECLARE_XMM
+  // VEX encoded three operand forms: dst = src1 op src2. Only to be used if
+  // TargetCPUFeatures::avx_supported().
+#define DECLARE_VXMM(name, code)                                               \
+  void v##name##ps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code, kVexNoPrefix);                       \
+  }                                                                            \
+  void v##name##pd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code, kVex66);                             \
+  }                                                                            \
+  void v##name##ss(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code, kVexF3);                             \
+  }                                                                            \
+  void v##name##sd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code, kVexF2);                             \
+  }
+  XMM_ALU_CODES(DECLARE_VXMM)
+#undef DECLARE_VXMM
+  // dst = src1 * src2 + dst, rounded once. Only to be used if
+  // TargetCPUFeatures::fma_supported().
+  void vfmadd231sd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+    EmitVex(dst, src1, src2, 0xB9, kVex66, kVex0F38, /*w=*/true);
+  }
+  void vfmadd231pd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+    EmitVex(dst, src1, src2, 0xB8, kVex66, kVex0F38, /*w=*/true);
+  }
   XX(L, cvtps2pd, 0x5A, 0x0F)
   XX(L, cvtpd2ps, 0x5A, 0x0F, 0x66)
   XX(L, cvtsd2ss, 0x5A, 0x0F, 0xF2)
@@ -1012,6 +1042,19 @@ class Assembler : public AssemblerBase {
                               bool force_emit = false);
   inline void EmitOperandREX(int rm, const Operand& operand, uint8_t rex);
   inline void EmitRegisterOperand(int rm, int reg);
+
+  // The implied legacy prefix and opcode map of a VEX encoded instruction.
+  enum VexPrefix { kVexNoPrefix = 0, kVex66 = 1, kVexF3 = 2, kVexF2 = 3 };
+  enum VexMap { kVex0F = 1, kVex0F38 = 2, kVex0F3A = 3 };
+  // Emits a 128-bit VEX encoded instruction with ModRM.reg = reg,
+  // VEX.vvvv = vvvv and ModRM.rm = rm, using the short form when possible.
+  void EmitVex(int reg,
+               int vvvv,
+               int rm,
+               int opcode,
+               VexPrefix prefix,
+               VexMap map = kVex0F,
+               bool w = false);
   inline void EmitFixup(AssemblerFixup* fixup);
   inline void EmitOperandSizeOverride();
   inline void EmitRegRegRex(int reg, int base, uint8_t rex = REX_NONE);
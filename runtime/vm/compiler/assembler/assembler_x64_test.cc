@@ -6,6 +6,7 @@
 #if defined(TARGET_ARCH_X64)
 
 #include "vm/compiler/assembler/assembler.h"
+#include "vm/cpu.h"
 #include "vm/os.h"
 #include "vm/unit_test.h"
 #include "vm/virtual_memory.h"
@@ -4614,6 +4615,50 @@ ASSEMBLER_TEST_RUN(DoubleFPOperations, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(VexDoubleFPOperations, assembler) {
+  __ movq(RAX, Immediate(bit_cast<int64_t, double>(12.3)));
+  __ pushq(RAX);
+  __ movsd(XMM1, Address(RSP, 0));
+  __ movq(RAX, Immediate(bit_cast<int64_t, double>(3.4)));
+  __ movq(Address(RSP, 0), RAX);
+  __ movsd(XMM11, Address(RSP, 0));
+  __ vaddsd(XMM10, XMM1, XMM11);  // 15.7
+  __ vmulsd(XMM2, XMM10, XMM11);  // 53.38
+  __ vsubsd(XMM0, XMM2, XMM1);    // 41.08
+  __ vdivsd(XMM9, XMM0, XMM11);   // 12.082
+  __ vfmadd231sd(XMM9, XMM1, XMM11);  // 12.082 + 41.82
+  __ movaps(XMM0, XMM9);
+  __ popq(RAX);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(VexDoubleFPOperations, test) {
+  // Running the code needs the instructions, disassembling it does not.
+  const bool saved_use_avx = FLAG_use_avx;
+  FLAG_use_avx = true;
+  if (TargetCPUFeatures::fma_supported()) {
+    typedef double (*VexDoubleFPOperationsCode)();
+    double res = reinterpret_cast<VexDoubleFPOperationsCode>(test->entry())();
+    EXPECT_FLOAT_EQ(53.902, res, 0.001);
+  }
+  FLAG_use_avx = saved_use_avx;
+  EXPECT_DISASSEMBLY(
+      "movq rax,0x................\n"
+      "push rax\n"
+      "movsd xmm1,[rsp]\n"
+      "movq rax,0x................\n"
+      "movq [rsp],rax\n"
+      "movsd xmm11,[rsp]\n"
+      "vaddsd xmm10,xmm1,xmm11\n"
+      "vmulsd xmm2,xmm10,xmm11\n"
+      "vsubsd xmm0,xmm2,xmm1\n"
+      "vdivsd xmm9,xmm0,xmm11\n"
+      "vfmadd231sd xmm9,xmm1,xmm11\n"
+      "movaps xmm0,xmm9\n"
+      "pop rax\n"
+      "ret\n");
+}
+
 ASSEMBLER_TEST_GENERATE(Int32ToDoubleConversion, assembler) {
   // Fill upper bits with garbage.
   __ movq(R11, Immediate(0x1111111100000006));
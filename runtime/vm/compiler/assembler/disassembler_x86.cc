@@ -343,6 +343,9 @@ class DisassemblerX64 : public ValueObject {
   int PrintImmediateOp(uint8_t* data);
   const char* TwoByteMnemonic(uint8_t opcode);
   int TwoByteOpcodeInstruction(uint8_t* data);
+#if defined(TARGET_ARCH_X64)
+  int VexInstruction(uint8_t* data);
+#endif
   int Print660F38Instruction(uint8_t* data);
 
   int F6F7Instruction(uint8_t* data);
@@ -1232,6 +1235,52 @@ int DisassemblerX64::Print660F38Instruction(uint8_t* current) {
 // Handle all two-byte opcodes, which start with 0x0F.
 // These instructions may be affected by an 0x66, 0xF2, or 0xF3 prefix.
 // We do not use any three-byte opcodes, which start with 0x0F38 or 0x0F3A.
+#if defined(TARGET_ARCH_X64)
+// Handles the VEX encoded instructions emitted by the assembler: the three
+// operand forms of the XMM ALU operations and the fused multiply-adds.
+int DisassemblerX64::VexInstruction(uint8_t* data) {
+  uint8_t* current = data + 1;
+  // The R, X and B bits are stored inverted.
+  uint8_t rex = 0x40 | ((~current[0] >> 5) & 0x4);
+  int map = 1;
+  bool w = false;
+  uint8_t payload;
+  if (data[0] == 0xC4) {
+    rex |= (~current[0] >> 5) & 0x3;
+    map = current[0] & 0x1F;
+    payload = current[1];
+    w = (payload & 0x80) != 0;
+    current += 2;
+  } else {
+    payload = current[0];
+    current += 1;
+  }
+  setRex(rex);
+  const int vvvv = (~payload >> 3) & 0xF;
+  const int pp = payload & 0x3;
+  const uint8_t opcode = *current++;
+  const char* mnemonic = NULL;
+  if ((map == 1) && ((opcode & 0xF0) == 0x50)) {
+    const XmmMnemonic& names = xmm_instructions[opcode & 0xF];
+    const char* by_prefix[] = {names.ps_name, names.pd_name, names.ss_name,
+                               names.sd_name};
+    mnemonic = by_prefix[pp];
+  } else if ((map == 2) && (pp == 1) && w && (opcode == 0xB8)) {
+    mnemonic = "fmadd231pd";
+  } else if ((map == 2) && (pp == 1) && w && (opcode == 0xB9)) {
+    mnemonic = "fmadd231sd";
+  } else {
+    UnimplementedInstruction();
+  }
+  int mod, regop, rm;
+  get_modrm(*current, &mod, &regop, &rm);
+  Print("v%s %s,%s,", mnemonic, NameOfXMMRegister(regop),
+        NameOfXMMRegister(vvvv));
+  current += PrintRightXMMOperand(current);
+  return current - data;
+}
+#endif  // defined(TARGET_ARCH_X64)
+
 int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
   uint8_t opcode = *(data + 1);
   uint8_t* current = data + 2;
@@ -1638,6 +1687,14 @@ int DisassemblerX64::InstructionDecode(uword pc) {
         data += TwoByteOpcodeInstruction(data);
         break;
 
+#if defined(TARGET_ARCH_X64)
+      case 0xC4:
+        FALL_THROUGH;
+      case 0xC5:
+        data += VexInstruction(data);
+        break;
+#endif
+
       case 0x8F: {
         data++;
         int mod, regop, rm;
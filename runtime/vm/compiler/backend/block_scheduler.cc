@@ -158,6 +158,47 @@ static void Union(GrowableArray<Chain*>* chains,
   }
 }
 
+// Marks blocks ending in a throw/rethrow, as well as any block post-dominated
+// by such a throwing block, in [is_terminating] (indexed by preorder number).
+// Such blocks are cold: they run at most once per invocation.
+static void MarkTerminatingBlocks(FlowGraph* flow_graph,
+                                  GrowableArray<bool>* is_terminating) {
+  auto& reverse_postorder = flow_graph->reverse_postorder();
+  const intptr_t block_count = reverse_postorder.length();
+  is_terminating->FillWith(false, 0, block_count);
+
+  // Any block in the worklist is marked and any of its unconditional
+  // predecessors need to be marked as well.
+  GrowableArray<BlockEntryInstr*> worklist;
+
+  // Add all throwing blocks to the worklist.
+  for (intptr_t i = 0; i < block_count; ++i) {
+    auto block = reverse_postorder[i];
+    auto last = block->last_instruction();
+    if (last->IsThrow() || last->IsReThrow()) {
+      const intptr_t preorder_nr = block->preorder_number();
+      (*is_terminating)[preorder_nr] = true;
+      worklist.Add(block);
+    }
+  }
+
+  // Follow all indirect predecessors which unconditionally will end up in a
+  // throwing block.
+  while (worklist.length() > 0) {
+    auto block = worklist.RemoveLast();
+    for (intptr_t i = 0; i < block->PredecessorCount(); ++i) {
+      auto predecessor = block->PredecessorAt(i);
+      if (predecessor->last_instruction()->IsGoto()) {
+        const intptr_t preorder_nr = predecessor->preorder_number();
+        if (!(*is_terminating)[preorder_nr]) {
+          (*is_terminating)[preorder_nr] = true;
+          worklist.Add(predecessor);
+        }
+      }
+    }
+  }
+}
+
 void BlockScheduler::ReorderBlocks() const {
   if (FLAG_precompiled_mode) {
     ReorderBlocksAOT();
@@ -221,18 +262,27 @@ void BlockScheduler::ReorderBlocksJIT() const {
 
   // Build a new block order.  Emit each chain when its first block occurs
   // in the original reverse postorder ordering (which gives a topological
-  // sort of the blocks).
-  for (intptr_t i = block_count - 1; i >= 0; --i) {
-    if (chains[i]->first->block == flow_graph()->postorder()[i]) {
-      for (Link* link = chains[i]->first; link != NULL; link = link->next) {
-        flow_graph()->CodegenBlockOrder(true)->Add(link->block);
+  // sort of the blocks).  Chains starting with a terminating block are cold
+  // and are emitted after all other chains, so the hot path stays contiguous
+  // and throwing code does not dilute the instruction cache.
+  GrowableArray<bool> is_terminating(block_count);
+  MarkTerminatingBlocks(flow_graph(), &is_terminating);
+  auto& codegen_order = *flow_graph()->CodegenBlockOrder(true);
+  for (intptr_t pass = 0; pass < 2; ++pass) {
+    const bool emit_cold = (pass == 1);
+    for (intptr_t i = block_count - 1; i >= 0; --i) {
+      BlockEntryInstr* first = chains[i]->first->block;
+      if ((first == flow_graph()->postorder()[i]) &&
+          (is_terminating[first->preorder_number()] == emit_cold)) {
+        for (Link* link = chains[i]->first; link != NULL; link = link->next) {
+          codegen_order.Add(link->block);
+        }
       }
     }
   }
 }
 
-// Moves blocks ending in a throw/rethrow, as well as any block post-dominated
-// by such a throwing block, to the end.
+// Moves any terminating block (see MarkTerminatingBlocks) to the end.
 void BlockScheduler::ReorderBlocksAOT() const {
   if (!FLAG_reorder_basic_blocks) {
     return;
@@ -241,38 +291,7 @@ void BlockScheduler::ReorderBlocksAOT() const {
   auto& reverse_postorder = flow_graph()->reverse_postorder();
   const intptr_t block_count = reverse_postorder.length();
   GrowableArray<bool> is_terminating(block_count);
-  is_terminating.FillWith(false, 0, block_count);
-
-  // Any block in the worklist is marked and any of its unconditional
-  // predecessors need to be marked as well.
-  GrowableArray<BlockEntryInstr*> worklist;
-
-  // Add all throwing blocks to the worklist.
-  for (intptr_t i = 0; i < block_count; ++i) {
-    auto block = reverse_postorder[i];
-    auto last = block->last_instruction();
-    if (last->IsThrow() || last->IsReThrow()) {
-      const intptr_t preorder_nr = block->preorder_number();
-      is_terminating[preorder_nr] = true;
-      worklist.Add(block);
-    }
-  }
-
-  // Follow all indirect predecessors which unconditionally will end up in a
-  // throwing block.
-  while (worklist.length() > 0) {
-    auto block = worklist.RemoveLast();
-    for (intptr_t i = 0; i < block->PredecessorCount(); ++i) {
-      auto predecessor = block->PredecessorAt(i);
-      if (predecessor->last_instruction()->IsGoto()) {
-        const intptr_t preorder_nr = predecessor->preorder_number();
-        if (!is_terminating[preorder_nr]) {
-          is_terminating[preorder_nr] = true;
-          worklist.Add(predecessor);
-        }
-      }
-    }
-  }
+  MarkTerminatingBlocks(flow_graph(), &is_terminating);
 
   // Emit code in reverse postorder but move any throwing blocks to the very
   // end.
@@ -12,6 +12,8 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
   object_header_bytes_ = 0;
   return_const_count_ = 0;
   return_const_with_load_field_count_ = 0;
+  trampoline_count_ = 0;
+  trampoline_bytes_ = 0;
   intptr_t i = 0;
 
 #define DO(type, attrs)                                                        \
@@ -49,6 +51,11 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
 #undef INIT_SPECIAL_ENTRY
 }
 
+void CombinedCodeStatistics::AddTrampoline(intptr_t bytes) {
+  trampoline_count_++;
+  trampoline_bytes_ += bytes;
+}
+
 void CombinedCodeStatistics::DumpStatistics() {
   ASSERT(unaccounted_bytes_ >= 0);
 
@@ -63,7 +70,7 @@ void CombinedCodeStatistics::DumpStatistics() {
     instruction_bytes += entries_[i].bytes;
   }
   intptr_t total = object_header_bytes_ + instruction_bytes +
-                   unaccounted_bytes_ + alignment_bytes_;
+                   unaccounted_bytes_ + alignment_bytes_ + trampoline_bytes_;
   float ftotal = static_cast<float>(total) / 100.0;
 
   OS::PrintErr("--------------------\n");
@@ -98,12 +105,15 @@ void CombinedCodeStatistics::DumpStatistics() {
                object_header_bytes_ / ftotal, object_header_bytes_);
   OS::PrintErr("%5.2f %% % 8" Pd " bytes instructions\n",
                instruction_bytes / ftotal, instruction_bytes);
+  OS::PrintErr("%5.2f %% % 8" Pd " bytes trampolines\n",
+               trampoline_bytes_ / ftotal, trampoline_bytes_);
   OS::PrintErr("--------------------\n");
   OS::PrintErr("%5.2f %% % 8" Pd " bytes in total\n", total / ftotal, total);
   OS::PrintErr("--------------------\n");
   OS::PrintErr("% 8" Pd " return-constant functions\n", return_const_count_);
   OS::PrintErr("% 8" Pd " return-constant-with-load-field functions\n",
                return_const_with_load_field_count_);
+  OS::PrintErr("% 8" Pd " trampolines\n", trampoline_count_);
   OS::PrintErr("--------------------\n");
 }
 
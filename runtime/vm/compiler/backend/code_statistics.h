@@ -39,6 +39,10 @@ class CombinedCodeStatistics {
   void Begin(Instruction* instruction);
   void End(Instruction* instruction);
 
+  // Accounts for a trampoline the [CodeRelocator] inserted into the ".text"
+  // segment to extend the range of pc-relative calls.
+  void AddTrampoline(intptr_t bytes);
+
   void DumpStatistics();
 
   static EntryCounter SlowPathCounterFor(Instruction::Tag tag) {
@@ -63,6 +67,8 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t trampoline_count_;
+  intptr_t trampoline_bytes_;
 };
 
 class CodeStatistics {
@@ -422,6 +422,11 @@ void ConstantPropagator::VisitClosureCall(ClosureCallInstr* instr) {
   SetValue(instr, non_constant_);
 }
 
+void ConstantPropagator::VisitDispatchTableCall(
+    DispatchTableCallInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
 void ConstantPropagator::VisitInstanceCall(InstanceCallInstr* instr) {
   SetValue(instr, non_constant_);
 }
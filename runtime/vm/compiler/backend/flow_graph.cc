@@ -7,6 +7,7 @@
 #include "vm/compiler/backend/flow_graph.h"
 
 #include "vm/bit_vector.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/il_printer.h"
@@ -1857,6 +1858,30 @@ static void UnboxPhi(PhiInstr* phi) {
       break;
   }
 
+  // Phis merging boxed doubles are unboxed even if their static type is not
+  // precise (e.g. 'num'): boxes are only allocated at uses which need them.
+  if ((unboxed == kTagged) && CanUnboxDouble()) {
+    bool has_box = false;
+    bool should_unbox = true;
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      Definition* input = phi->InputAt(i)->definition();
+      if (input->IsBox() &&
+          (input->AsBox()->from_representation() == kUnboxedDouble)) {
+        has_box = true;
+      } else if ((input != phi) &&
+                 !(input->IsConstant() &&
+                   input->AsConstant()->value().IsDouble()) &&
+                 !(input->IsPhi() &&
+                   (input->representation() == kUnboxedDouble))) {
+        should_unbox = false;
+        break;
+      }
+    }
+    if (has_box && should_unbox) {
+      unboxed = kUnboxedDouble;
+    }
+  }
+
   // If all the inputs are unboxed, leave the Phi unboxed.
   if ((unboxed == kTagged) && phi->Type()->IsInt()) {
     bool should_unbox = true;
@@ -2281,6 +2306,10 @@ void FlowGraph::PopulateWithICData(const Function& function) {
               ICData::New(function, call->function_name(), arguments_descriptor,
                           call->deopt_id(), call->checked_argument_count(),
                           ICData::kInstance));
+          if (FLAG_precompiled_mode) {
+            PrecompilerTypeFeedback::AddChecks(function, call->token_pos(),
+                                               ic_data);
+          }
           call->set_ic_data(&ic_data);
         }
       } else if (instr->IsStaticCall()) {
@@ -179,6 +179,12 @@ bool FlowGraphCompiler::IsUnboxedField(const Field& field) {
 }
 
 bool FlowGraphCompiler::IsPotentialUnboxedField(const Field& field) {
+  if (FLAG_precompiled_mode) {
+    // In precompiled mode the guarded state is the field type inferred by TFA
+    // and does not change after compilation. A field without an inferred type
+    // still has kIllegalCid, which does not mean that no store was seen yet.
+    return IsUnboxedField(field);
+  }
   return field.is_unboxing_candidate() &&
          (FlowGraphCompiler::IsUnboxedField(field) ||
           (field.guarded_cid() == kIllegalCid));
@@ -1204,8 +1210,7 @@ bool FlowGraphCompiler::TryIntrinsifyHelper() {
 
         // Only intrinsify getter if the field cannot contain a mutable double.
         // Reading from a mutable double box requires allocating a fresh double.
-        if (field.is_instance() &&
-            (FLAG_precompiled_mode || !IsPotentialUnboxedField(field))) {
+        if (field.is_instance() && !IsPotentialUnboxedField(field)) {
           SpecialStatsBegin(CombinedCodeStatistics::kTagIntrinsics);
           GenerateGetterIntrinsic(field.Offset());
           SpecialStatsEnd(CombinedCodeStatistics::kTagIntrinsics);
@@ -1223,8 +1228,10 @@ bool FlowGraphCompiler::TryIntrinsifyHelper() {
           field = field.CloneFromOriginal();
 #endif
 
+          // Storing into a mutable double box requires unboxing the value.
           if (field.is_instance() &&
-              (FLAG_precompiled_mode || field.guarded_cid() == kDynamicCid)) {
+              (FLAG_precompiled_mode ? !IsPotentialUnboxedField(field)
+                                     : field.guarded_cid() == kDynamicCid)) {
             SpecialStatsBegin(CombinedCodeStatistics::kTagIntrinsics);
             GenerateSetterIntrinsic(field.Offset());
             SpecialStatsEnd(CombinedCodeStatistics::kTagIntrinsics);
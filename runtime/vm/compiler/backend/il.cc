@@ -4257,6 +4257,25 @@ intptr_t CallTargets::AggregateCallCount() const {
   return sum;
 }
 
+DispatchTableCallInstr* DispatchTableCallInstr::FromCall(
+    Zone* zone,
+    const InstanceCallInstr* call,
+    Value* class_id,
+    const Array& table,
+    intptr_t selector_offset) {
+  PushArgumentsArray* args =
+      new (zone) PushArgumentsArray(call->ArgumentCount());
+  for (intptr_t i = 0; i < call->ArgumentCount(); i++) {
+    args->Add(call->PushArgumentAt(i));
+  }
+  DispatchTableCallInstr* new_call = new (zone) DispatchTableCallInstr(
+      class_id, table, selector_offset, call->function_name(), args,
+      call->type_args_len(), call->argument_names(), call->token_pos(),
+      call->deopt_id());
+  new_call->result_type_ = call->result_type();
+  return new_call;
+}
+
 bool PolymorphicInstanceCallInstr::HasOnlyDispatcherOrImplicitAccessorTargets()
     const {
   const intptr_t len = targets_.length();
@@ -5281,6 +5300,13 @@ LocationSummary* FfiCallInstr::MakeLocationSummary(Zone* zone,
     const bool is_atomic = arg_representations_[i] == kUnboxedFloat ||
                            arg_representations_[i] == kUnboxedDouble;
 
+    if (!is_atomic && arg_locations_[i].IsFpuRegister()) {
+      // A piece of a struct passed by value in an FPU register is loaded as an
+      // integer and moved there just before the call.
+      summary->set_in(i, Location::RequiresRegister());
+      continue;
+    }
+
     // Since we have to move this input down to the stack, there's no point in
     // pinning it to any specific register.
     summary->set_in(i, UnallocateStackSlots(arg_locations_[i], is_atomic));
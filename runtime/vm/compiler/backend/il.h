@@ -358,6 +358,7 @@ struct InstrAttrs {
   M(AssertBoolean, _)                                                          \
   M(SpecialParameter, kNoGC)                                                   \
   M(ClosureCall, _)                                                            \
+  M(DispatchTableCall, _)                                                      \
   M(FfiCall, _)                                                                \
   M(InstanceCall, _)                                                           \
   M(PolymorphicInstanceCall, _)                                                \
@@ -3254,6 +3255,70 @@ class ClosureCallInstr : public TemplateDartCall<1> {
   DISALLOW_COPY_AND_ASSIGN(ClosureCallInstr);
 };
 
+// Calls the target of the dispatch table row at [selector_offset] for the
+// receiver whose class id is [class_id]: the code is loaded from
+// table[class_id + selector_offset]. Only created by the AOT call specializer
+// when the row has an entry for every possible class of the receiver, which
+// must not be null; see DispatchTableGenerator.
+class DispatchTableCallInstr : public TemplateDartCall<1> {
+ public:
+  DispatchTableCallInstr(Value* class_id,
+                         const Array& table,
+                         intptr_t selector_offset,
+                         const String& selector_name,
+                         PushArgumentsArray* arguments,
+                         intptr_t type_args_len,
+                         const Array& argument_names,
+                         TokenPosition token_pos,
+                         intptr_t deopt_id)
+      : TemplateDartCall(deopt_id,
+                         type_args_len,
+                         argument_names,
+                         arguments,
+                         token_pos),
+        table_(table),
+        selector_offset_(selector_offset),
+        selector_name_(selector_name),
+        result_type_(NULL) {
+    ASSERT(!arguments->is_empty());
+    ASSERT(table.IsZoneHandle());
+    ASSERT(selector_name.IsZoneHandle());
+    SetInputAt(0, class_id);
+  }
+
+  static DispatchTableCallInstr* FromCall(Zone* zone,
+                                          const InstanceCallInstr* call,
+                                          Value* class_id,
+                                          const Array& table,
+                                          intptr_t selector_offset);
+
+  DECLARE_INSTRUCTION(DispatchTableCall)
+  virtual CompileType ComputeType() const;
+
+  Value* class_id() const { return inputs_[0]; }
+  const Array& table() const { return table_; }
+  intptr_t selector_offset() const { return selector_offset_; }
+  const String& selector_name() const { return selector_name_; }
+
+  virtual intptr_t CallCount() const { return 1; }
+
+  virtual bool ComputeCanDeoptimize() const { return true; }
+
+  virtual bool HasUnknownSideEffects() const { return true; }
+
+  CompileType* result_type() const { return result_type_; }
+
+  PRINT_OPERANDS_TO_SUPPORT
+
+ private:
+  const Array& table_;
+  const intptr_t selector_offset_;
+  const String& selector_name_;
+  CompileType* result_type_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTableCallInstr);
+};
+
 class InstanceCallInstr : public TemplateDartCall<0> {
  public:
   InstanceCallInstr(
@@ -4161,13 +4226,17 @@ class FfiCallInstr : public Definition {
                intptr_t deopt_id,
                const Function& signature,
                const ZoneGrowableArray<Representation>& arg_reps,
-               const ZoneGrowableArray<Location>& arg_locs)
+               const ZoneGrowableArray<Location>& arg_locs,
+               const compiler::ffi::StructResult* struct_result,
+               bool is_leaf)
       : Definition(deopt_id),
         zone_(zone),
         signature_(signature),
         inputs_(arg_reps.length() + 1),
         arg_representations_(arg_reps),
-        arg_locations_(arg_locs) {
+        arg_locations_(arg_locs),
+        struct_result_(struct_result),
+        is_leaf_(is_leaf) {
     inputs_.FillWith(nullptr, 0, arg_reps.length() + 1);
     ASSERT(signature.IsZoneHandle());
   }
@@ -4180,6 +4249,18 @@ class FfiCallInstr : public Definition {
   // Input index of the function pointer to invoke.
   intptr_t TargetAddressIndex() const { return NativeArgCount(); }
 
+  // Leaf calls promise not to call back into Dart or block, so they are made
+  // without an exit frame and without leaving the generated code state, where
+  // the target architecture supports that.
+  bool is_leaf() const { return is_leaf_; }
+
+  // Non-null if the native function returns a struct by value. Its address is
+  // the last native argument. Unless the struct is returned in memory, the
+  // call stores the pieces it comes back in there.
+  const compiler::ffi::StructResult* struct_result() const {
+    return struct_result_;
+  }
+
   virtual intptr_t InputCount() const { return inputs_.length(); }
   virtual Value* InputAt(intptr_t i) const { return inputs_[i]; }
   virtual bool MayThrow() const { return false; }
@@ -4207,6 +4288,8 @@ class FfiCallInstr : public Definition {
   GrowableArray<Value*> inputs_;
   const ZoneGrowableArray<Representation>& arg_representations_;
   const ZoneGrowableArray<Location>& arg_locations_;
+  const compiler::ffi::StructResult* const struct_result_;
+  const bool is_leaf_;
 
   DISALLOW_COPY_AND_ASSIGN(FfiCallInstr);
 };
@@ -4762,6 +4845,10 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
            (emit_store_barrier_ == kEmitStoreBarrier);
   }
 
+  void set_emit_store_barrier(StoreBarrierType value) {
+    emit_store_barrier_ = value;
+  }
+
   virtual SpeculativeMode speculative_mode() const { return speculative_mode_; }
 
   virtual bool ComputeCanDeoptimize() const { return false; }
@@ -4785,7 +4872,7 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
     return Assembler::kValueCanBeSmi;
   }
 
-  const StoreBarrierType emit_store_barrier_;
+  StoreBarrierType emit_store_barrier_;
   const intptr_t index_scale_;
   const intptr_t class_id_;
   const AlignmentType alignment_;
@@ -4939,6 +5026,12 @@ class AllocateObjectInstr : public TemplateAllocation<0, NoThrow> {
     return Heap::IsAllocatableInNewSpace(cls.instance_size());
   }
 
+  // Closures are allocated inline in optimized code, which calls the
+  // allocation stub only when the bump allocation fails.
+  bool AllocatesInline(bool opt) const {
+    return opt && (ArgumentCount() == 0) && (cls().id() == kClosureCid);
+  }
+
   PRINT_OPERANDS_TO_SUPPORT
 
  private:
@@ -6849,6 +6942,7 @@ class CheckStackOverflowInstr : public TemplateInstruction<0, NoThrow> {
   bool in_loop() const { return loop_depth_ > 0; }
   intptr_t stack_depth() const { return stack_depth_; }
   intptr_t loop_depth() const { return loop_depth_; }
+  Kind kind() const { return kind_; }
 
   DECLARE_INSTRUCTION(CheckStackOverflow)
 
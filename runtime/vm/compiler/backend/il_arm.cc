@@ -2082,6 +2082,7 @@ void GuardFieldLengthInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 DEFINE_UNIMPLEMENTED_INSTRUCTION(GuardFieldTypeInstr)
 DEFINE_UNIMPLEMENTED_INSTRUCTION(CheckConditionInstr)
+DEFINE_UNIMPLEMENTED_INSTRUCTION(DispatchTableCallInstr)
 
 class BoxAllocationSlowPath : public TemplateSlowPathCode<Instruction> {
  public:
@@ -2843,24 +2844,47 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
   // generated code size.
   __ LoadObject(R3, type_arguments());
   __ ldr(R3, FieldAddress(R3, TypeArguments::instantiations_offset()));
-  __ AddImmediate(R3, Array::data_offset() - kHeapObjectTag);
-  // The instantiations cache is initialized with Object::zero_array() and is
-  // therefore guaranteed to contain kNoInstantiator. No length check needed.
+  // The instantiations cache is a hash table, see
+  // TypeArguments::FindInstantiation. The mask is its last slot.
+  COMPILE_ASSERT(StubCode::kInstantiationSizeInWords == 3);
+  COMPILE_ASSERT(TypeArguments::kInstantiationsHashMaskFromEnd == 1);
+  Label instantiator_hashed, hashed;
+  __ LoadImmediate(R2, 0);
+  __ CompareObject(instantiator_type_args_reg, Object::null_object());
+  __ b(&instantiator_hashed, EQ);
+  __ ldr(R2, FieldAddress(instantiator_type_args_reg,
+                          TypeArguments::hash_offset()));
+  __ Bind(&instantiator_hashed);
+  __ CompareObject(function_type_args_reg, Object::null_object());
+  __ b(&hashed, EQ);
+  __ ldr(IP,
+         FieldAddress(function_type_args_reg, TypeArguments::hash_offset()));
+  __ eor(R2, R2, Operand(IP));
+  __ Bind(&hashed);
+  // R2: probed entry as tagged index, R4: its address.
   Label loop, next, found, slow_case;
   __ Bind(&loop);
-  __ ldr(R2, Address(R3, 0 * kWordSize));  // Cached instantiator type args.
-  __ cmp(R2, Operand(instantiator_type_args_reg));
+  __ ldr(IP, FieldAddress(R3, Array::length_offset()));
+  __ add(IP, R3, Operand(IP, LSL, kWordSizeLog2 - kSmiTagShift));
+  __ ldr(IP, FieldAddress(IP, Array::data_offset() - kWordSize));
+  __ and_(R2, R2, Operand(IP));
+  __ add(R4, R2, Operand(R2, LSL, 1));
+  __ add(R4, R3, Operand(R4, LSL, kWordSizeLog2 - kSmiTagShift));
+  __ AddImmediate(R4, Array::data_offset() - kHeapObjectTag);
+  __ ldr(IP, Address(R4, 0 * kWordSize));  // Cached instantiator type args.
+  __ cmp(IP, Operand(instantiator_type_args_reg));
   __ b(&next, NE);
-  __ ldr(IP, Address(R3, 1 * kWordSize));  // Cached function type args.
+  __ ldr(IP, Address(R4, 1 * kWordSize));  // Cached function type args.
   __ cmp(IP, Operand(function_type_args_reg));
   __ b(&found, EQ);
   __ Bind(&next);
-  __ AddImmediate(R3, StubCode::kInstantiationSizeInWords * kWordSize);
-  __ CompareImmediate(R2, Smi::RawValue(StubCode::kNoInstantiator));
-  __ b(&loop, NE);
-  __ b(&slow_case);
+  __ ldr(IP, Address(R4, 0 * kWordSize));
+  __ CompareImmediate(IP, Smi::RawValue(StubCode::kNoInstantiator));
+  __ b(&slow_case, EQ);
+  __ AddImmediate(R2, Smi::RawValue(1));
+  __ b(&loop);
   __ Bind(&found);
-  __ ldr(result_reg, Address(R3, 2 * kWordSize));  // Cached instantiated args.
+  __ ldr(result_reg, Address(R4, 2 * kWordSize));  // Cached instantiated args.
   __ b(&type_arguments_instantiated);
 
   __ Bind(&slow_case);
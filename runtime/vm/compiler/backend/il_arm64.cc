@@ -274,6 +274,44 @@ void ClosureCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Drop(argument_count);
 }
 
+LocationSummary* DispatchTableCallInstr::MakeLocationSummary(Zone* zone,
+                                                             bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kCall);
+  summary->set_in(0, Location::RegisterLocation(R1));  // Smi class id.
+  summary->set_out(0, Location::RegisterLocation(R0));
+  return summary;
+}
+
+void DispatchTableCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // Load arguments descriptor in R4.
+  const intptr_t argument_count = ArgumentCount();  // Includes type args.
+  const Array& arguments_descriptor =
+      Array::ZoneHandle(Z, GetArgumentsDescriptor());
+  __ LoadObject(R4, arguments_descriptor);
+
+  // Code in CODE_REG, loaded from table[cid + selector_offset]. The class id
+  // is a Smi, so shifting it by 2 yields the word offset of its entry.
+  const Register cid_reg = locs()->in(0).reg();
+  ASSERT(cid_reg == R1);
+  __ LoadObject(CODE_REG, table());
+  __ add(CODE_REG, CODE_REG, Operand(cid_reg, LSL, 2));
+  __ LoadFieldFromOffset(CODE_REG, CODE_REG,
+                         Array::data_offset() + selector_offset() * kWordSize);
+  __ LoadFieldFromOffset(R2, CODE_REG, Code::entry_point_offset());
+
+  // R4: Arguments descriptor.
+  // R2: instructions.
+  // R5: Smi 0 (no IC data).
+  __ LoadImmediate(R5, 0);
+  __ blr(R2);
+  compiler->EmitCallsiteMetadata(token_pos(), deopt_id(),
+                                 RawPcDescriptors::kOther, locs());
+  __ Drop(argument_count);
+}
+
 LocationSummary* LoadLocalInstr::MakeLocationSummary(Zone* zone,
                                                      bool opt) const {
   return LocationSummary::Make(zone, 0, Location::RequiresRegister(),
@@ -872,28 +910,77 @@ void NativeCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Drop(ArgumentCount());  // Drop the arguments.
 }
 
+// Stores the pieces of a struct returned by value in registers into the
+// memory allocated for it, whose address the call got in 'address_slot'.
+static void StoreFfiStructResult(FlowGraphCompiler* compiler,
+                                 const compiler::ffi::StructResult& result,
+                                 Location address_slot) {
+  // The C stack pointer is where the Dart stack pointer was at the call.
+  __ mov(SPREG, CSP);
+  __ LoadFromOffset(TMP, SPREG, address_slot.ToStackSlotOffset());
+  for (intptr_t i = 0, n = result.NumPieces(); i < n; ++i) {
+    const Location piece = result.PieceLocation(i);
+    const intptr_t offset = result.PieceOffset(i);
+    switch (result.PieceSize(i)) {
+      case 8:
+        if (piece.IsFpuRegister()) {
+          __ StoreDToOffset(piece.fpu_reg(), TMP, offset);
+        } else {
+          __ StoreToOffset(piece.reg(), TMP, offset, kDoubleWord);
+        }
+        break;
+      case 4:
+        if (piece.IsFpuRegister()) {
+          __ fstrs(piece.fpu_reg(), Address(TMP, offset));
+        } else {
+          __ StoreToOffset(piece.reg(), TMP, offset, kWord);
+        }
+        break;
+      case 2:
+        __ StoreToOffset(piece.reg(), TMP, offset, kHalfword);
+        break;
+      case 1:
+        __ StoreToOffset(piece.reg(), TMP, offset, kByte);
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
 void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Register saved_fp = locs()->temp(0).reg();
   Register temp = locs()->temp(1).reg();
   Register branch = locs()->in(TargetAddressIndex()).reg();
 
-  // Save frame pointer because we're going to update it when we enter the exit
-  // frame.
-  __ mov(saved_fp, FPREG);
+  if (is_leaf_) {
+    // A leaf call stays in the current frame: it cannot reach a safepoint, so
+    // nothing walks the stack while it runs. The callee-saved temporary keeps
+    // the Dart stack pointer to return to, with the C stack pointer saved
+    // just below it.
+    __ mov(temp, SPREG);
+    __ PushRegister(CSP);
+  } else {
+    // Save frame pointer because we're going to update it when we enter the
+    // exit frame.
+    __ mov(saved_fp, FPREG);
 
-  // We need to create a dummy "exit frame". It will share the same pool pointer
-  // but have a null code object.
-  __ LoadObject(CODE_REG, Object::null_object());
-  __ set_constant_pool_allowed(false);
-  __ EnterDartFrame(0, PP);
+    // We need to create a dummy "exit frame". It will share the same pool
+    // pointer but have a null code object.
+    __ LoadObject(CODE_REG, Object::null_object());
+    __ set_constant_pool_allowed(false);
+    __ EnterDartFrame(0, PP);
 
-  // Save the stack limit address.
-  __ PushRegister(CSP);
+    // Save the stack limit address.
+    __ PushRegister(CSP);
+  }
 
   // Make space for arguments and align the frame.
   __ ReserveAlignedFrameSpace(compiler::ffi::NumStackSlots(arg_locations_) *
                               kWordSize);
 
+  // The frame pointer the incoming stack slots are relative to.
+  const Register origin_fp = is_leaf_ ? FPREG : saved_fp;
   for (intptr_t i = 0, n = NativeArgCount(); i < n; ++i) {
     Location origin = locs()->in(i);
     Location target = arg_locations_[i];
@@ -906,14 +993,45 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
       } else if (origin.IsStackSlot() || origin.IsDoubleStackSlot()) {
         // The base register cannot be SPREG because we've moved it.
         ASSERT(origin.base_reg() == FPREG);
-        __ LoadFromOffset(TMP, saved_fp, origin.ToStackSlotOffset());
+        __ LoadFromOffset(TMP, origin_fp, origin.ToStackSlotOffset());
         __ StoreToOffset(TMP, SPREG, target.ToStackSlotOffset());
       }
+    } else if (target.IsFpuRegister() && origin.IsRegister()) {
+      // A piece of a struct passed by value.
+      if (arg_representations_[i] == kUnboxedUint32) {
+        __ fmovsr(target.fpu_reg(), origin.reg());
+      } else {
+        __ fmovdr(target.fpu_reg(), origin.reg());
+      }
     } else {
       ASSERT(origin.Equals(target));
     }
   }
 
+  const bool store_struct_result =
+      struct_result_ != nullptr && !struct_result_->in_memory();
+
+  if (struct_result_ != nullptr && struct_result_->in_memory()) {
+    // The callee writes the struct to the address it gets in R8, which holds
+    // the target address. The saved frame pointer is not needed any more.
+    __ mov(saved_fp, branch);
+    branch = saved_fp;
+    __ LoadFromOffset(R8, SPREG,
+                      arg_locations_[NativeArgCount() - 1].ToStackSlotOffset());
+  }
+
+  if (is_leaf_) {
+    __ mov(CSP, SP);
+    __ blr(branch);
+    if (store_struct_result) {
+      StoreFfiStructResult(compiler, *struct_result_,
+                           arg_locations_[NativeArgCount() - 1]);
+    }
+    __ LoadFromOffset(CSP, temp, -kWordSize);
+    __ mov(SPREG, temp);
+    return;
+  }
+
   // We need to copy a dummy return address up into the dummy stack frame so the
   // stack walker will know which safepoint to use.
   __ adr(temp, Immediate(0));
@@ -930,6 +1048,10 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ TransitionGeneratedToNative(branch, temp);
 
   __ blr(branch);
+  if (store_struct_result) {
+    StoreFfiStructResult(compiler, *struct_result_,
+                         arg_locations_[NativeArgCount() - 1]);
+  }
 
   // Update information in the thread object and leave the safepoint.
   __ TransitionNativeToGenerated(temp);
@@ -2514,24 +2636,46 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
   // generated code size.
   __ LoadObject(R3, type_arguments());
   __ LoadFieldFromOffset(R3, R3, TypeArguments::instantiations_offset());
-  __ AddImmediate(R3, Array::data_offset() - kHeapObjectTag);
-  // The instantiations cache is initialized with Object::zero_array() and is
-  // therefore guaranteed to contain kNoInstantiator. No length check needed.
+  // The instantiations cache is a hash table, see
+  // TypeArguments::FindInstantiation. The mask is its last slot.
+  COMPILE_ASSERT(StubCode::kInstantiationSizeInWords == 3);
+  COMPILE_ASSERT(TypeArguments::kInstantiationsHashMaskFromEnd == 1);
+  __ LoadFieldFromOffset(R4, R3, Array::length_offset());
+  __ add(R4, R3, Operand(R4, LSL, kWordSizeLog2 - kSmiTagShift));
+  __ LoadFieldFromOffset(R4, R4, Array::data_offset() - kWordSize);
+  Label instantiator_hashed, hashed;
+  __ LoadImmediate(R2, 0);
+  __ CompareObject(instantiator_type_args_reg, Object::null_object());
+  __ b(&instantiator_hashed, EQ);
+  __ LoadFieldFromOffset(R2, instantiator_type_args_reg,
+                         TypeArguments::hash_offset());
+  __ Bind(&instantiator_hashed);
+  __ CompareObject(function_type_args_reg, Object::null_object());
+  __ b(&hashed, EQ);
+  __ LoadFieldFromOffset(TMP, function_type_args_reg,
+                         TypeArguments::hash_offset());
+  __ eor(R2, R2, Operand(TMP));
+  __ Bind(&hashed);
+  // R2: probed entry as tagged index, R5: its address.
   Label loop, next, found, slow_case;
   __ Bind(&loop);
-  __ LoadFromOffset(R2, R3, 0 * kWordSize);  // Cached instantiator type args.
-  __ CompareRegisters(R2, instantiator_type_args_reg);
+  __ and_(R2, R2, Operand(R4));
+  __ add(R5, R2, Operand(R2, LSL, 1));
+  __ add(R5, R3, Operand(R5, LSL, kWordSizeLog2 - kSmiTagShift));
+  __ AddImmediate(R5, Array::data_offset() - kHeapObjectTag);
+  __ LoadFromOffset(R6, R5, 0 * kWordSize);  // Cached instantiator type args.
+  __ CompareRegisters(R6, instantiator_type_args_reg);
   __ b(&next, NE);
-  __ LoadFromOffset(TMP, R3, 1 * kWordSize);  // Cached function type args.
+  __ LoadFromOffset(TMP, R5, 1 * kWordSize);  // Cached function type args.
   __ CompareRegisters(TMP, function_type_args_reg);
   __ b(&found, EQ);
   __ Bind(&next);
-  __ AddImmediate(R3, StubCode::kInstantiationSizeInWords * kWordSize);
-  __ CompareImmediate(R2, Smi::RawValue(StubCode::kNoInstantiator));
-  __ b(&loop, NE);
-  __ b(&slow_case);
+  __ CompareImmediate(R6, Smi::RawValue(StubCode::kNoInstantiator));
+  __ b(&slow_case, EQ);
+  __ AddImmediate(R2, Smi::RawValue(1));
+  __ b(&loop);
   __ Bind(&found);
-  __ LoadFromOffset(result_reg, R3, 2 * kWordSize);  // Cached instantiated ta.
+  __ LoadFromOffset(result_reg, R5, 2 * kWordSize);  // Cached instantiated ta.
   __ b(&type_arguments_instantiated);
 
   __ Bind(&slow_case);
@@ -6130,10 +6274,32 @@ void BooleanNegateInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 LocationSummary* AllocateObjectInstr::MakeLocationSummary(Zone* zone,
                                                           bool opt) const {
+  if (AllocatesInline(opt)) {
+    const intptr_t kNumInputs = 0;
+    const intptr_t kNumTemps = 1;
+    LocationSummary* locs = new (zone) LocationSummary(
+        zone, kNumInputs, kNumTemps, LocationSummary::kCallOnSlowPath);
+    locs->set_temp(0, Location::RequiresRegister());
+    locs->set_out(0, Location::RequiresRegister());
+    return locs;
+  }
   return MakeCallSummary(zone);
 }
 
 void AllocateObjectInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  if (AllocatesInline(compiler->is_optimizing())) {
+    const Register result = locs()->out(0).reg();
+    const Register temp = locs()->temp(0).reg();
+    BoxAllocationSlowPath::Allocate(compiler, this, cls(), result, temp);
+    // Like the allocation stub, null all fields before they are stored to.
+    __ LoadObject(temp, Object::null_object());
+    const intptr_t instance_size = cls().instance_size();
+    for (intptr_t offset = Instance::NextFieldOffset();
+         offset < instance_size; offset += kWordSize) {
+      __ StoreIntoObjectOffsetNoBarrier(result, offset, temp);
+    }
+    return;
+  }
   if (ArgumentCount() == 1) {
     TypeUsageInfo* type_usage_info = compiler->thread()->type_usage_info();
     if (type_usage_info != nullptr) {
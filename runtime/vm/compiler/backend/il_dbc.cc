@@ -64,6 +64,7 @@ DECLARE_FLAG(int, optimization_counter_threshold);
   M(UnaryInt64Op)                                                              \
   M(CheckedSmiOp)                                                              \
   M(CheckedSmiComparison)                                                      \
+  M(DispatchTableCall)                                                         \
   M(SimdOp)
 
 // Location summaries actually are not used by the unoptimizing DBC compiler
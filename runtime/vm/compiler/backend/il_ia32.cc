@@ -1546,6 +1546,7 @@ void StoreIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 DEFINE_UNIMPLEMENTED_INSTRUCTION(GuardFieldTypeInstr)
 DEFINE_UNIMPLEMENTED_INSTRUCTION(CheckConditionInstr)
+DEFINE_UNIMPLEMENTED_INSTRUCTION(DispatchTableCallInstr)
 
 LocationSummary* GuardFieldClassInstr::MakeLocationSummary(Zone* zone,
                                                            bool opt) const {
@@ -2434,24 +2435,43 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
   // generated code size.
   __ LoadObject(EDI, type_arguments());
   __ movl(EDI, FieldAddress(EDI, TypeArguments::instantiations_offset()));
-  __ leal(EDI, FieldAddress(EDI, Array::data_offset()));
-  // The instantiations cache is initialized with Object::zero_array() and is
-  // therefore guaranteed to contain kNoInstantiator. No length check needed.
+  // The instantiations cache is a hash table, see
+  // TypeArguments::FindInstantiation. The mask is its last slot.
+  COMPILE_ASSERT(StubCode::kInstantiationSizeInWords == 3);
+  COMPILE_ASSERT(TypeArguments::kInstantiationsHashMaskFromEnd == 1);
+  Label instantiator_hashed, hashed;
+  __ xorl(EDX, EDX);
+  __ CompareObject(instantiator_type_args_reg, Object::null_object());
+  __ j(EQUAL, &instantiator_hashed, Assembler::kNearJump);
+  __ movl(EDX, FieldAddress(instantiator_type_args_reg,
+                            TypeArguments::hash_offset()));
+  __ Bind(&instantiator_hashed);
+  __ CompareObject(function_type_args_reg, Object::null_object());
+  __ j(EQUAL, &hashed, Assembler::kNearJump);
+  __ xorl(EDX,
+          FieldAddress(function_type_args_reg, TypeArguments::hash_offset()));
+  __ Bind(&hashed);
+  // EDX: probed entry as tagged index, EBX: its address.
   Label loop, next, found, slow_case;
   __ Bind(&loop);
-  __ movl(EDX, Address(EDI, 0 * kWordSize));  // Cached instantiator type args.
-  __ cmpl(EDX, instantiator_type_args_reg);
+  __ movl(EBX, FieldAddress(EDI, Array::length_offset()));
+  __ andl(EDX, FieldAddress(EDI, EBX, TIMES_HALF_WORD_SIZE,
+                            Array::data_offset() - kWordSize));
+  __ leal(EBX, Address(EDX, EDX, TIMES_2, 0));
+  __ leal(EBX, FieldAddress(EDI, EBX, TIMES_HALF_WORD_SIZE,
+                            Array::data_offset()));
+  __ cmpl(instantiator_type_args_reg, Address(EBX, 0 * kWordSize));
   __ j(NOT_EQUAL, &next, Assembler::kNearJump);
-  __ movl(EBX, Address(EDI, 1 * kWordSize));  // Cached function type args.
-  __ cmpl(EBX, function_type_args_reg);
+  __ cmpl(function_type_args_reg, Address(EBX, 1 * kWordSize));
   __ j(EQUAL, &found, Assembler::kNearJump);
   __ Bind(&next);
-  __ addl(EDI, Immediate(StubCode::kInstantiationSizeInWords * kWordSize));
-  __ cmpl(EDX, Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
-  __ j(NOT_EQUAL, &loop, Assembler::kNearJump);
-  __ jmp(&slow_case, Assembler::kNearJump);
+  __ cmpl(Address(EBX, 0 * kWordSize),
+          Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
+  __ j(EQUAL, &slow_case, Assembler::kNearJump);
+  __ addl(EDX, Immediate(Smi::RawValue(1)));
+  __ jmp(&loop, Assembler::kNearJump);
   __ Bind(&found);
-  __ movl(result_reg, Address(EDI, 2 * kWordSize));  // Cached instantiated ta.
+  __ movl(result_reg, Address(EBX, 2 * kWordSize));  // Cached instantiated ta.
   __ jmp(&type_arguments_instantiated, Assembler::kNearJump);
 
   __ Bind(&slow_case);
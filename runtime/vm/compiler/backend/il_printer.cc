@@ -521,11 +521,28 @@ void ClosureCallInstr::PrintOperandsTo(BufferFormatter* f) const {
   }
 }
 
+void DispatchTableCallInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print(" %s<%" Pd ">, cid=", selector_name().ToCString(), type_args_len());
+  class_id()->PrintTo(f);
+  f->Print(", offset=%" Pd, selector_offset());
+  for (intptr_t i = 0; i < ArgumentCount(); ++i) {
+    f->Print(", ");
+    PushArgumentAt(i)->value()->PrintTo(f);
+  }
+}
+
 void FfiCallInstr::PrintOperandsTo(BufferFormatter* f) const {
   f->Print(" pointer=");
   InputAt(TargetAddressIndex())->PrintTo(f);
   f->Print(" signature=%s",
            Type::Handle(signature_.SignatureType()).ToCString());
+  if (is_leaf_) {
+    f->Print(" leaf");
+  }
+  if (struct_result_ != nullptr) {
+    f->Print(" struct_result=%" Pd "%s", struct_result_->size(),
+             struct_result_->in_memory() ? " in memory" : "");
+  }
   for (intptr_t i = 0, n = InputCount(); i < n - 1; ++i) {
     f->Print(", ");
     InputAt(i)->PrintTo(f);
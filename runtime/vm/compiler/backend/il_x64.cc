@@ -19,6 +19,7 @@
 #include "vm/instructions.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
+#include "vm/poll_page.h"
 #include "vm/stack_frame.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
@@ -879,29 +880,78 @@ void NativeCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Drop(ArgumentCount());  // Drop the arguments.
 }
 
+// Stores the pieces of a struct returned by value in registers into the
+// memory allocated for it, whose address the call got in 'address_slot'.
+static void StoreFfiStructResult(FlowGraphCompiler* compiler,
+                                 const compiler::ffi::StructResult& result,
+                                 Location address_slot) {
+  // The shadow space for the call is still reserved.
+  __ movq(TMP, Address(SPREG, CallingConventions::kShadowSpaceBytes +
+                                  address_slot.ToStackSlotOffset()));
+  for (intptr_t i = 0, n = result.NumPieces(); i < n; ++i) {
+    const Location piece = result.PieceLocation(i);
+    const Address dest(TMP, result.PieceOffset(i));
+    switch (result.PieceSize(i)) {
+      case 8:
+        if (piece.IsFpuRegister()) {
+          __ movsd(dest, piece.fpu_reg());
+        } else {
+          __ movq(dest, piece.reg());
+        }
+        break;
+      case 4:
+        if (piece.IsFpuRegister()) {
+          __ movss(dest, piece.fpu_reg());
+        } else {
+          __ movl(dest, piece.reg());
+        }
+        break;
+      case 2:
+        __ movw(dest, piece.reg());
+        break;
+      case 1:
+        __ movb(dest, piece.reg());
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
 void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Register saved_fp = locs()->temp(0).reg();
   Register target_address = locs()->in(TargetAddressIndex()).reg();
 
-  // Save frame pointer because we're going to update it when we enter the exit
-  // frame.
-  __ movq(saved_fp, FPREG);
-
-  // Make a space to put the return address.
-  __ pushq(Immediate(0));
-
-  // We need to create a dummy "exit frame". It will share the same pool pointer
-  // but have a null code object.
-  __ LoadObject(CODE_REG, Object::null_object());
-  __ set_constant_pool_allowed(false);
-  __ EnterDartFrame(compiler::ffi::NumStackSlots(arg_locations_) * kWordSize,
-                    PP);
-
-  // Align frame before entering C++ world.
-  if (OS::ActivationFrameAlignment() > 1) {
-    __ andq(SPREG, Immediate(~(OS::ActivationFrameAlignment() - 1)));
+  if (is_leaf_) {
+    // A leaf call stays in the current frame: it cannot reach a safepoint, so
+    // nothing walks the stack while it runs. The temporary is callee-saved and
+    // keeps the stack pointer to return to.
+    __ movq(saved_fp, SPREG);
+    __ ReserveAlignedFrameSpace(compiler::ffi::NumStackSlots(arg_locations_) *
+                                kWordSize);
+  } else {
+    // Save frame pointer because we're going to update it when we enter the
+    // exit frame.
+    __ movq(saved_fp, FPREG);
+
+    // Make a space to put the return address.
+    __ pushq(Immediate(0));
+
+    // We need to create a dummy "exit frame". It will share the same pool
+    // pointer but have a null code object.
+    __ LoadObject(CODE_REG, Object::null_object());
+    __ set_constant_pool_allowed(false);
+    __ EnterDartFrame(compiler::ffi::NumStackSlots(arg_locations_) * kWordSize,
+                      PP);
+
+    // Align frame before entering C++ world.
+    if (OS::ActivationFrameAlignment() > 1) {
+      __ andq(SPREG, Immediate(~(OS::ActivationFrameAlignment() - 1)));
+    }
   }
 
+  // The frame pointer the incoming stack slots are relative to.
+  const Register origin_fp = is_leaf_ ? FPREG : saved_fp;
   for (intptr_t i = 0, n = NativeArgCount(); i < n; ++i) {
     Location origin = locs()->in(i);
     Location target = arg_locations_[i];
@@ -915,14 +965,34 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
       } else if (origin.IsStackSlot() || origin.IsDoubleStackSlot()) {
         // The base register cannot be SPREG because we've moved it.
         ASSERT(origin.base_reg() == FPREG);
-        __ movq(TMP, Address(saved_fp, origin.ToStackSlotOffset()));
+        __ movq(TMP, Address(origin_fp, origin.ToStackSlotOffset()));
         __ movq(LocationToStackSlotAddress(target), TMP);
       }
+    } else if (target.IsFpuRegister() && origin.IsRegister()) {
+      // A piece of a struct passed by value.
+      if (arg_representations_[i] == kUnboxedUint32) {
+        __ movd(target.fpu_reg(), origin.reg());
+      } else {
+        __ movq(target.fpu_reg(), origin.reg());
+      }
     } else {
       ASSERT(origin.Equals(target));
     }
   }
 
+  const bool store_struct_result =
+      struct_result_ != nullptr && !struct_result_->in_memory();
+
+  if (is_leaf_) {
+    __ CallCFunction(target_address);
+    if (store_struct_result) {
+      StoreFfiStructResult(compiler, *struct_result_,
+                           arg_locations_[NativeArgCount() - 1]);
+    }
+    __ movq(SPREG, saved_fp);
+    return;
+  }
+
   // We need to copy a dummy return address up into the dummy stack frame so the
   // stack walker will know which safepoint to use. RIP points to the *next*
   // instruction, so 'AddressRIPRelative' loads the address of the following
@@ -936,6 +1006,10 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ TransitionGeneratedToNative(target_address);
 
   __ CallCFunction(target_address);
+  if (store_struct_result) {
+    StoreFfiStructResult(compiler, *struct_result_,
+                         arg_locations_[NativeArgCount() - 1]);
+  }
 
   // Update information in the thread object and leave the safepoint.
   __ TransitionNativeToGenerated();
@@ -2515,24 +2589,44 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
   // generated code size.
   __ LoadObject(RDI, type_arguments());
   __ movq(RDI, FieldAddress(RDI, TypeArguments::instantiations_offset()));
-  __ leaq(RDI, FieldAddress(RDI, Array::data_offset()));
-  // The instantiations cache is initialized with Object::zero_array() and is
-  // therefore guaranteed to contain kNoInstantiator. No length check needed.
+  // The instantiations cache is a hash table, see
+  // TypeArguments::FindInstantiation. The mask is its last slot.
+  COMPILE_ASSERT(StubCode::kInstantiationSizeInWords == 3);
+  COMPILE_ASSERT(TypeArguments::kInstantiationsHashMaskFromEnd == 1);
+  __ movq(R10, FieldAddress(RDI, Array::length_offset()));
+  __ movq(R10, FieldAddress(RDI, R10, TIMES_HALF_WORD_SIZE,
+                            Array::data_offset() - kWordSize));
+  Label instantiator_hashed, hashed;
+  __ xorq(RDX, RDX);
+  __ CompareObject(instantiator_type_args_reg, Object::null_object());
+  __ j(EQUAL, &instantiator_hashed, Assembler::kNearJump);
+  __ movq(RDX, FieldAddress(instantiator_type_args_reg,
+                            TypeArguments::hash_offset()));
+  __ Bind(&instantiator_hashed);
+  __ CompareObject(function_type_args_reg, Object::null_object());
+  __ j(EQUAL, &hashed, Assembler::kNearJump);
+  __ xorq(RDX,
+          FieldAddress(function_type_args_reg, TypeArguments::hash_offset()));
+  __ Bind(&hashed);
+  // RDX: probed entry as tagged index, R8: its address.
   Label loop, next, found, slow_case;
   __ Bind(&loop);
-  __ movq(RDX, Address(RDI, 0 * kWordSize));  // Cached instantiator type args.
-  __ cmpq(RDX, instantiator_type_args_reg);
+  __ andq(RDX, R10);
+  __ leaq(R8, Address(RDX, RDX, TIMES_2, 0));
+  __ leaq(R8, FieldAddress(RDI, R8, TIMES_HALF_WORD_SIZE,
+                           Array::data_offset()));
+  __ cmpq(instantiator_type_args_reg, Address(R8, 0 * kWordSize));
   __ j(NOT_EQUAL, &next, Assembler::kNearJump);
-  __ movq(R10, Address(RDI, 1 * kWordSize));  // Cached function type args.
-  __ cmpq(R10, function_type_args_reg);
+  __ cmpq(function_type_args_reg, Address(R8, 1 * kWordSize));
   __ j(EQUAL, &found, Assembler::kNearJump);
   __ Bind(&next);
-  __ addq(RDI, Immediate(StubCode::kInstantiationSizeInWords * kWordSize));
-  __ cmpq(RDX, Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
-  __ j(NOT_EQUAL, &loop, Assembler::kNearJump);
-  __ jmp(&slow_case, Assembler::kNearJump);
+  __ cmpq(Address(R8, 0 * kWordSize),
+          Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
+  __ j(EQUAL, &slow_case, Assembler::kNearJump);
+  __ addq(RDX, Immediate(Smi::RawValue(1)));
+  __ jmp(&loop, Assembler::kNearJump);
   __ Bind(&found);
-  __ movq(result_reg, Address(RDI, 2 * kWordSize));  // Cached instantiated ta.
+  __ movq(result_reg, Address(R8, 2 * kWordSize));  // Cached instantiated ta.
   __ jmp(&type_arguments_instantiated, Assembler::kNearJump);
 
   __ Bind(&slow_case);
@@ -2824,9 +2918,14 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   compiler->AddSlowPathCode(slow_path);
 
   Register temp = locs()->temp(0).reg();
-  // Generate stack overflow check.
-  __ cmpq(RSP, Address(THR, Thread::stack_limit_offset()));
-  __ j(BELOW_EQUAL, slow_path->entry_label());
+  if (compiler->is_optimizing() && in_loop() && PollPage::enabled()) {
+    // Loops cannot overflow the stack, so they only check for interrupts.
+    __ PollForInterrupts(slow_path->entry_label());
+  } else {
+    // Generate stack overflow check.
+    __ cmpq(RSP, Address(THR, Thread::stack_limit_offset()));
+    __ j(BELOW_EQUAL, slow_path->entry_label());
+  }
   if (compiler->CanOSRFunction() && in_loop()) {
     // In unoptimized code check the usage counter to trigger OSR at loop
     // stack checks.  Use progressively higher thresholds for more deeply
@@ -3987,7 +4086,11 @@ LocationSummary* BinaryDoubleOpInstr::MakeLocationSummary(Zone* zone,
       LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
   summary->set_in(0, Location::RequiresFpuRegister());
   summary->set_in(1, Location::RequiresFpuRegister());
-  summary->set_out(0, Location::SameAsFirstInput());
+  // The three operand AVX forms leave the inputs intact, which saves the
+  // register allocator from copying a left input that is still live.
+  summary->set_out(0, TargetCPUFeatures::avx_supported()
+                          ? Location::RequiresFpuRegister()
+                          : Location::SameAsFirstInput());
   return summary;
 }
 
@@ -3995,6 +4098,27 @@ void BinaryDoubleOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   XmmRegister left = locs()->in(0).fpu_reg();
   XmmRegister right = locs()->in(1).fpu_reg();
 
+  if (TargetCPUFeatures::avx_supported()) {
+    const XmmRegister result = locs()->out(0).fpu_reg();
+    switch (op_kind()) {
+      case Token::kADD:
+        __ vaddsd(result, left, right);
+        break;
+      case Token::kSUB:
+        __ vsubsd(result, left, right);
+        break;
+      case Token::kMUL:
+        __ vmulsd(result, left, right);
+        break;
+      case Token::kDIV:
+        __ vdivsd(result, left, right);
+        break;
+      default:
+        UNREACHABLE();
+    }
+    return;
+  }
+
   ASSERT(locs()->out(0).fpu_reg() == left);
 
   switch (op_kind()) {
@@ -6396,6 +6520,43 @@ void ClosureCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Drop(argument_count);
 }
 
+LocationSummary* DispatchTableCallInstr::MakeLocationSummary(Zone* zone,
+                                                             bool opt) const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kCall);
+  summary->set_in(0, Location::RegisterLocation(RCX));  // Smi class id.
+  summary->set_out(0, Location::RegisterLocation(RAX));
+  return summary;
+}
+
+void DispatchTableCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // Arguments descriptor is expected in R10.
+  const intptr_t argument_count = ArgumentCount();  // Includes type args.
+  const Array& arguments_descriptor =
+      Array::ZoneHandle(Z, GetArgumentsDescriptor());
+  __ LoadObject(R10, arguments_descriptor);
+
+  // Code in CODE_REG, loaded from table[cid + selector_offset]. The class id
+  // is a Smi, so scaling it by 4 yields the word offset of its entry.
+  const Register cid_reg = locs()->in(0).reg();
+  ASSERT(cid_reg == RCX);
+  __ LoadObject(CODE_REG, table());
+  __ movq(CODE_REG,
+          FieldAddress(CODE_REG, cid_reg, TIMES_4,
+                       Array::data_offset() + selector_offset() * kWordSize));
+  __ movq(RCX, FieldAddress(CODE_REG, Code::entry_point_offset()));
+
+  // R10: Arguments descriptor array.
+  // RBX: Smi 0 (no IC data).
+  __ xorq(RBX, RBX);
+  __ call(RCX);
+  compiler->EmitCallsiteMetadata(token_pos(), deopt_id(),
+                                 RawPcDescriptors::kOther, locs());
+  __ Drop(argument_count);
+}
+
 LocationSummary* BooleanNegateInstr::MakeLocationSummary(Zone* zone,
                                                          bool opt) const {
   return LocationSummary::Make(zone, 1, Location::RequiresRegister(),
@@ -6416,10 +6577,32 @@ void BooleanNegateInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 LocationSummary* AllocateObjectInstr::MakeLocationSummary(Zone* zone,
                                                           bool opt) const {
+  if (AllocatesInline(opt)) {
+    const intptr_t kNumInputs = 0;
+    const intptr_t kNumTemps = 1;
+    LocationSummary* locs = new (zone) LocationSummary(
+        zone, kNumInputs, kNumTemps, LocationSummary::kCallOnSlowPath);
+    locs->set_temp(0, Location::RequiresRegister());
+    locs->set_out(0, Location::RequiresRegister());
+    return locs;
+  }
   return MakeCallSummary(zone);
 }
 
 void AllocateObjectInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  if (AllocatesInline(compiler->is_optimizing())) {
+    const Register result = locs()->out(0).reg();
+    const Register temp = locs()->temp(0).reg();
+    BoxAllocationSlowPath::Allocate(compiler, this, cls(), result, temp);
+    // Like the allocation stub, null all fields before they are stored to.
+    __ LoadObject(temp, Object::null_object());
+    const intptr_t instance_size = cls().instance_size();
+    for (intptr_t offset = Instance::NextFieldOffset();
+         offset < instance_size; offset += kWordSize) {
+      __ StoreIntoObjectNoBarrier(result, FieldAddress(result, offset), temp);
+    }
+    return;
+  }
   if (ArgumentCount() == 1) {
     TypeUsageInfo* type_usage_info = compiler->thread()->type_usage_info();
     if (type_usage_info != nullptr) {
@@ -79,6 +79,11 @@ DEFINE_FLAG(int,
             60,
             "Inline function calls with sufficient constant arguments "
             "and up to the increased threshold on instructions");
+DEFINE_FLAG(int,
+            inlining_numeric_arguments_size_threshold,
+            120,
+            "In AOT, inline calls passing only ints and doubles to callees up "
+            "to the threshold on instructions, to avoid boxing the arguments");
 DEFINE_FLAG(int,
             inlining_hotness,
             10,
@@ -786,7 +791,8 @@ class CallSiteInliner : public ValueObject {
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
                                   intptr_t call_site_count,
-                                  intptr_t const_arg_count) {
+                                  intptr_t const_arg_count,
+                                  bool numeric_args) {
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
     }
@@ -794,6 +800,16 @@ class CallSiteInliner : public ValueObject {
       // Prevent methods becoming humongous and thus slow to compile.
       return InliningDecision::No("--inlining-caller-size-threshold");
     }
+    // AOT calls pass tagged values, so every int or double argument is boxed
+    // at the call and unboxed again in the callee.
+    const bool avoids_boxing = FLAG_precompiled_mode && numeric_args &&
+                               (instr_count != 0) &&
+                               (instr_count <=
+                                FLAG_inlining_numeric_arguments_size_threshold);
+    if (avoids_boxing) {
+      return InliningDecision::Yes(
+          "--inlining-numeric-arguments-size-threshold");
+    }
     if (const_arg_count > 0) {
       if (instr_count > FLAG_inlining_constant_arguments_max_size_threshold) {
         return InliningDecision(
@@ -961,9 +977,11 @@ class CallSiteInliner : public ValueObject {
 
     GrowableArray<Value*>* arguments = call_data->arguments;
     const intptr_t constant_arguments = CountConstants(*arguments);
+    const bool numeric_arguments = HasOnlyNumericArguments(*arguments);
     InliningDecision decision = ShouldWeInline(
         function, function.optimized_instruction_count(),
-        function.optimized_call_site_count(), constant_arguments);
+        function.optimized_call_site_count(), constant_arguments,
+        numeric_arguments);
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1210,13 +1228,15 @@ class CallSiteInliner : public ValueObject {
 
         // Use heuristics do decide if this call should be inlined.
         InliningDecision decision =
-            ShouldWeInline(function, size, call_site_count, constants_count);
+            ShouldWeInline(function, size, call_site_count, constants_count,
+                           numeric_arguments);
         if (!decision.value) {
           // If size is larger than all thresholds, don't consider it again.
           if ((size > FLAG_inlining_size_threshold) &&
               (call_site_count > FLAG_inlining_callee_call_sites_threshold) &&
               (size > FLAG_inlining_constant_arguments_min_size_threshold) &&
-              (size > FLAG_inlining_constant_arguments_max_size_threshold)) {
+              (size > FLAG_inlining_constant_arguments_max_size_threshold) &&
+              (size > FLAG_inlining_numeric_arguments_size_threshold)) {
             function.set_is_inlinable(false);
           }
           TRACE_INLINING(
@@ -1413,6 +1433,21 @@ class CallSiteInliner : public ValueObject {
     return count;
   }
 
+  // Whether the call passes only values known to be ints or doubles, like
+  // calls to small numeric helpers.
+  static bool HasOnlyNumericArguments(const GrowableArray<Value*>& arguments) {
+    if (arguments.is_empty()) {
+      return false;
+    }
+    for (intptr_t i = 0; i < arguments.length(); i++) {
+      CompileType* type = arguments[i]->Type();
+      if (!type->IsInt() && !type->IsDouble()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
     // TODO(zerny): Use a hash map for the cache.
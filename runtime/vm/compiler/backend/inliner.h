@@ -35,16 +35,16 @@ class SpeculativeInliningPolicy {
   }
 
   bool IsAllowedForInlining(intptr_t call_deopt_id) const {
-    // If we are not blacklisting, we always enable optimistic inlining.
-    if (!enable_blacklist_) {
-      return true;
-    }
-
     // If we have already blacklisted the deopt-id we don't allow inlining it.
     if (IsBlacklisted(call_deopt_id)) {
       return false;
     }
 
+    // If we are not blacklisting, we always enable optimistic inlining.
+    if (!enable_blacklist_) {
+      return true;
+    }
+
     // Allow it if we can bailout at least one more time.
     return remaining_ > 0;
   }
@@ -64,6 +64,15 @@ class SpeculativeInliningPolicy {
     return true;
   }
 
+  // Disables speculation at [id] without a limit on the number of such
+  // deopt-ids. Used by the JIT for call sites whose speculative checks have
+  // deoptimized an earlier version of the code.
+  void AddDeoptimizedDeoptId(intptr_t id) {
+    if (!IsBlacklisted(id)) {
+      inlining_blacklist_.Add(id);
+    }
+  }
+
   intptr_t length() const { return inlining_blacklist_.length(); }
 
  private:
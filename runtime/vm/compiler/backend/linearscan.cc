@@ -18,6 +18,11 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            loop_aware_spill_costs,
+            true,
+            "Weight eviction candidates by the loop depth of their uses.");
+
 #if defined(DEBUG)
 #define TRACE_ALLOC(statement)                                                 \
   do {                                                                         \
@@ -2192,6 +2197,19 @@ BitVector* ReachingDefs::Get(PhiInstr* phi) {
   return phi->reaching_defs();
 }
 
+Location FlowGraphAllocator::PrecedingSiblingLocation(LiveRange* range) {
+  if (range->vreg() < 0) return Location::NoLocation();
+  LiveRange* sibling = GetLiveRange(range->vreg());
+  while ((sibling != NULL) && (sibling->next_sibling() != range)) {
+    sibling = sibling->next_sibling();
+  }
+  if ((sibling == NULL) || (sibling->End() != range->Start())) {
+    return Location::NoLocation();
+  }
+  const Location loc = sibling->assigned_location();
+  return (loc.kind() == register_kind_) ? loc : Location::NoLocation();
+}
+
 bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
   intptr_t candidate = kNoRegister;
   intptr_t free_until = 0;
@@ -2199,6 +2217,17 @@ bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
   // If hint is available try hint first.
   // TODO(vegorov): ensure that phis are hinted on the back edge.
   Location hint = unallocated->finger()->FirstHint();
+  if (!hint.IsMachineRegister()) {
+    // Otherwise try to continue in the register of the preceding split
+    // sibling: this makes the move connecting the two siblings redundant.
+    hint = PrecedingSiblingLocation(unallocated);
+    if (hint.IsMachineRegister() &&
+        (blocked_registers_[hint.register_code()] ||
+         (FirstIntersectionWithAllocated(hint.register_code(), unallocated) !=
+          kMaxPosition))) {
+      hint = Location::NoLocation();
+    }
+  }
   if (hint.IsMachineRegister()) {
     if (!blocked_registers_[hint.register_code()]) {
       free_until =
@@ -2405,6 +2434,29 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
 
   ASSERT(candidate != kNoRegister);
 
+  if (FLAG_loop_aware_spill_costs) {
+    // Any register which stays free until the first register use is a valid
+    // choice. Among those prefer one whose eviction moves stack traffic out
+    // of loops instead of simply picking the one which is free for longest.
+    intptr_t best_cost = EvictionCost(candidate, unallocated);
+    for (intptr_t reg = 0; (reg < NumberOfRegisters()) && (best_cost > 0);
+         ++reg) {
+      if (blocked_registers_[reg] || (reg == candidate)) continue;
+      intptr_t reg_free_until = register_use_pos - 1;
+      intptr_t reg_blocked_at = kMaxPosition;
+      if (!UpdateFreeUntil(reg, unallocated, &reg_free_until,
+                           &reg_blocked_at)) {
+        continue;
+      }
+      const intptr_t cost = EvictionCost(reg, unallocated);
+      if (cost < best_cost) {
+        candidate = reg;
+        best_cost = cost;
+        blocked_at = reg_blocked_at;
+      }
+    }
+  }
+
   TRACE_ALLOC(THR_Print("assigning blocked register "));
   TRACE_ALLOC(MakeRegisterLocation(candidate).Print());
   TRACE_ALLOC(THR_Print(" to live range v%" Pd " until %" Pd "\n",
@@ -2474,6 +2526,44 @@ bool FlowGraphAllocator::UpdateFreeUntil(intptr_t reg,
   return true;
 }
 
+// Relative cost of a memory access performed in the given block.
+static intptr_t LoopDepthWeight(BlockEntryInstr* block) {
+  const intptr_t kMaxDepth = 6;
+  LoopInfo* loop_info = block->loop_info();
+  const intptr_t depth =
+      (loop_info != nullptr)
+          ? Utils::Minimum(loop_info->NestingDepth(), kMaxDepth)
+          : 0;
+  return static_cast<intptr_t>(1) << (3 * depth);
+}
+
+intptr_t FlowGraphAllocator::EvictionCost(intptr_t reg,
+                                          LiveRange* unallocated) {
+  const intptr_t start = unallocated->Start();
+  intptr_t cost = 0;
+  for (intptr_t i = 0; i < registers_[reg]->length(); i++) {
+    LiveRange* allocated = (*registers_[reg])[i];
+    if ((allocated == NULL) || (allocated->vreg() < 0)) continue;
+
+    UseInterval* first_pending_use_interval =
+        allocated->finger()->first_pending_use_interval();
+    intptr_t reload_pos = kMaxPosition;
+    if (first_pending_use_interval->Contains(start)) {
+      // An evicted active range is reloaded before its next register use.
+      UsePosition* use = allocated->finger()->FirstInterferingUse(start);
+      if (use != NULL) reload_pos = use->pos();
+    } else {
+      // An evicted inactive range is spilled where it starts to intersect.
+      reload_pos = FirstIntersection(first_pending_use_interval,
+                                     unallocated->first_use_interval());
+    }
+    if (reload_pos < allocated->End()) {
+      cost += LoopDepthWeight(BlockEntryAt(reload_pos));
+    }
+  }
+  return cost;
+}
+
 void FlowGraphAllocator::RemoveEvicted(intptr_t reg, intptr_t first_evicted) {
   intptr_t to = first_evicted;
   intptr_t from = first_evicted + 1;
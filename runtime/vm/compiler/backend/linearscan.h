@@ -213,6 +213,15 @@ class FlowGraphAllocator : public ValueObject {
                        intptr_t* cur_free_until,
                        intptr_t* cur_blocked_at);
 
+  // Estimate the cost of the memory accesses introduced by evicting the
+  // live ranges allocated to the given register in favor of the unallocated
+  // one. Accesses inside loops are weighted by the loop nesting depth.
+  intptr_t EvictionCost(intptr_t reg, LiveRange* unallocated);
+
+  // Returns the register assigned to the split sibling which immediately
+  // precedes the given live range, or an invalid location.
+  Location PrecedingSiblingLocation(LiveRange* range);
+
   // Split given live range in an optimal position between given positions.
   LiveRange* SplitBetween(LiveRange* range, intptr_t from, intptr_t to);
 
@@ -0,0 +1,555 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            true,
+            "Vectorize simple loops over Float32List and Float64List.");
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+// Upper bound on the number of instructions in a vectorized loop body.
+static const intptr_t kMaxBodyLength = 32;
+
+// Matches and transforms a single loop. See LoopVectorizer.
+class LoopVectorization : public ZoneAllocated {
+ public:
+  LoopVectorization(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        header_(nullptr),
+        body_(nullptr),
+        pre_header_(nullptr),
+        init_index_(-1),
+        index_(nullptr),
+        update_(nullptr),
+        comparison_(nullptr),
+        stack_check_(nullptr),
+        element_cid_(kIllegalCid),
+        scalar_(kMaxBodyLength),
+        vector_(kMaxBodyLength),
+        invariants_(),
+        splats_(),
+        vector_index_(nullptr) {}
+
+  // Returns true if the loop has the shape described in LoopVectorizer.
+  bool Match();
+
+  // Inserts the vector loop in front of the matched loop.
+  void Transform();
+
+ private:
+  bool MatchHeader();
+  bool MatchBody();
+  bool MatchOperand(Value* value, bool allow_operations);
+
+  bool IsInvariant(Definition* def) const {
+    return !loop_->Contains(def->GetBlock());
+  }
+  bool IsIndex(Value* value) const {
+    Definition* def = value->definition();
+    return def->OriginalDefinitionIgnoreBoxingAndConstraints() == index_;
+  }
+  bool IsFloat32() const { return element_cid_ == kTypedDataFloat32ArrayCid; }
+  intptr_t lanes() const { return IsFloat32() ? 4 : 2; }
+
+  intptr_t IndexOfScalar(Definition* def) const;
+  Definition* IndexConstant(int64_t value);
+  Definition* IndexAdd(Definition* index, int64_t value);
+  Definition* VectorOperand(Value* value);
+
+  FlowGraph* flow_graph_;
+  Zone* zone_;
+  LoopInfo* loop_;
+  JoinEntryInstr* header_;
+  TargetEntryInstr* body_;
+  BlockEntryInstr* pre_header_;
+  intptr_t init_index_;
+  PhiInstr* index_;
+  Definition* update_;
+  ComparisonInstr* comparison_;
+  CheckStackOverflowInstr* stack_check_;
+  intptr_t element_cid_;
+
+  // Loads, arithmetic and stores of the scalar body in order, and the
+  // corresponding instructions of the vector body.
+  GrowableArray<Instruction*> scalar_;
+  GrowableArray<Definition*> vector_;
+
+  // Loop invariant scalars and their splats.
+  GrowableArray<Definition*> invariants_;
+  GrowableArray<Definition*> splats_;
+
+  Definition* vector_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVectorization);
+};
+
+bool LoopVectorization::Match() {
+  return MatchHeader() && MatchBody();
+}
+
+bool LoopVectorization::MatchHeader() {
+  header_ = loop_->header()->AsJoinEntry();
+  if ((header_ == nullptr) || (loop_->inner() != nullptr) ||
+      (header_->PredecessorCount() != 2) ||
+      (loop_->back_edges().length() != 1) || header_->InsideTryBlock()) {
+    return false;
+  }
+
+  // Exactly two blocks: the header and the body, which is the back edge.
+  intptr_t num_blocks = 0;
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    num_blocks++;
+  }
+  if (num_blocks != 2) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < 2; i++) {
+    if (!loop_->Contains(header_->PredecessorAt(i))) {
+      init_index_ = i;
+      pre_header_ = header_->PredecessorAt(i);
+    }
+  }
+  if ((pre_header_ == nullptr) ||
+      (!pre_header_->IsTargetEntry() && !pre_header_->IsJoinEntry()) ||
+      !pre_header_->last_instruction()->IsGoto() ||
+      flow_graph_->prologue_info().Contains(pre_header_->block_id())) {
+    return false;
+  }
+
+  // The loop index is the only phi.
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    if (index_ != nullptr) {
+      return false;
+    }
+    index_ = it.Current();
+  }
+  if ((index_ == nullptr) || ((index_->representation() != kTagged) &&
+                              (index_->representation() != kUnboxedInt64))) {
+    return false;
+  }
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(loop_->LookupInduction(index_), &stride) ||
+      (stride != 1)) {
+    return false;
+  }
+
+  // The initial value has to be small enough for the index of the last lane
+  // not to overflow, even when the loop is not entered.
+  Definition* init = index_->InputAt(init_index_)->definition();
+  const int64_t init_max =
+      init->IsConstant() && init->AsConstant()->value().IsSmi()
+          ? Smi::Cast(init->AsConstant()->value()).Value()
+          : Range::ConstantMax(init->range()).ConstantValue();
+  if (init_max > (kSmiMax - lanes())) {
+    return false;
+  }
+
+  // The header only contains an optional stack overflow check and the
+  // branch on [index] < [limit] which enters the body.
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsCheckStackOverflow()) {
+      stack_check_ = current->AsCheckStackOverflow();
+    } else if (!current->IsBranch()) {
+      return false;
+    }
+  }
+  BranchInstr* branch = header_->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  comparison_ = branch->comparison();
+  RelationalOpInstr* relational = comparison_->AsRelationalOp();
+  if ((relational == nullptr) || (relational->kind() != Token::kLT) ||
+      ((relational->operation_cid() != kSmiCid) &&
+       (relational->operation_cid() != kMintCid)) ||
+      (relational->left()->definition() != index_) ||
+      !IsInvariant(relational->right()->definition())) {
+    return false;
+  }
+  body_ = branch->true_successor();
+  if (!loop_->Contains(body_) || loop_->Contains(branch->false_successor()) ||
+      !loop_->IsBackEdge(body_) || (body_->loop_info() != loop_)) {
+    return false;
+  }
+  return true;
+}
+
+bool LoopVectorization::MatchOperand(Value* value, bool allow_operations) {
+  Definition* def = value->definition();
+  const intptr_t index = IndexOfScalar(def);
+  if (index >= 0) {
+    return allow_operations || scalar_[index]->IsLoadIndexed();
+  }
+  if (!IsInvariant(def)) {
+    return false;
+  }
+  if (IsFloat32()) {
+    // Only constants which are exactly representable in single precision.
+    ConstantInstr* constant = def->AsConstant();
+    if ((constant == nullptr) || !constant->value().IsDouble()) {
+      return false;
+    }
+    const double value = Double::Cast(constant->value()).value();
+    return static_cast<double>(static_cast<float>(value)) == value;
+  }
+  return true;
+}
+
+bool LoopVectorization::MatchBody() {
+  // The update of the index is [index] + 1 and only feeds the phi.
+  update_ = index_->InputAt(1 - init_index_)->definition();
+  if ((update_->GetBlock() != body_) ||
+      (!update_->IsBinarySmiOp() && !update_->IsBinaryInt64Op()) ||
+      (update_->InputAt(0)->definition() != index_)) {
+    return false;
+  }
+
+  intptr_t num_stores = 0;
+  intptr_t body_length = 0;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (++body_length > kMaxBodyLength) {
+      return false;
+    }
+    if ((current == update_) || current->IsGoto()) {
+      continue;
+    }
+    if (current->IsCheckStackOverflow()) {
+      if (stack_check_ != nullptr) {
+        return false;
+      }
+      stack_check_ = current->AsCheckStackOverflow();
+      continue;
+    }
+    if (current->IsBoxInt64() && IsIndex(current->InputAt(0))) {
+      continue;
+    }
+
+    if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+      if (((load->class_id() != kTypedDataFloat32ArrayCid) &&
+           (load->class_id() != kTypedDataFloat64ArrayCid)) ||
+          ((element_cid_ != kIllegalCid) &&
+           (element_cid_ != load->class_id())) ||
+          load->IsExternal() || !IsInvariant(load->array()->definition()) ||
+          !IsIndex(load->index())) {
+        return false;
+      }
+      element_cid_ = load->class_id();
+    } else if (BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp()) {
+      if ((op->op_kind() != Token::kADD) && (op->op_kind() != Token::kSUB) &&
+          (op->op_kind() != Token::kMUL) && (op->op_kind() != Token::kDIV)) {
+        return false;
+      }
+      if (element_cid_ == kIllegalCid) {
+        return false;  // Needs a load first to know the element type.
+      }
+      if (!MatchOperand(op->left(), !IsFloat32()) ||
+          !MatchOperand(op->right(), !IsFloat32())) {
+        return false;
+      }
+    } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+      if ((store->class_id() != element_cid_) || store->IsExternal() ||
+          !IsInvariant(store->array()->definition()) ||
+          !IsIndex(store->index()) ||
+          (IndexOfScalar(store->value()->definition()) < 0)) {
+        return false;
+      }
+      num_stores++;
+    } else {
+      return false;
+    }
+    scalar_.Add(current);
+  }
+  if (num_stores == 0) {
+    return false;
+  }
+
+  // Values computed by the body are only used by the body, and are not
+  // needed to deoptimize at the stack overflow check.
+  for (intptr_t i = 0; i < scalar_.length(); i++) {
+    Definition* def = scalar_[i]->AsDefinition();
+    if ((def == nullptr) || !def->HasSSATemp()) {
+      continue;
+    }
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      Instruction* use = it.Current()->instruction();
+      if (use->GetBlock() != body_) {
+        return false;
+      }
+      // For Float32List the result of an operation must be rounded by a
+      // store before it is used again.
+      if (IsFloat32() && def->IsBinaryDoubleOp() && !use->IsStoreIndexed()) {
+        return false;
+      }
+    }
+  }
+  if ((stack_check_ != nullptr) && (stack_check_->env() != nullptr)) {
+    for (Environment::DeepIterator it(stack_check_->env()); !it.Done();
+         it.Advance()) {
+      Definition* def = it.CurrentValue()->definition();
+      if ((def != index_) && !IsInvariant(def)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+intptr_t LoopVectorization::IndexOfScalar(Definition* def) const {
+  for (intptr_t i = 0; i < scalar_.length(); i++) {
+    if (scalar_[i] == def) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+Definition* LoopVectorization::IndexConstant(int64_t value) {
+  if (index_->representation() == kTagged) {
+    return flow_graph_->GetConstant(Smi::ZoneHandle(zone_, Smi::New(value)));
+  }
+  UnboxedConstantInstr* constant = new (zone_) UnboxedConstantInstr(
+      Integer::ZoneHandle(zone_, Integer::New(value, Heap::kOld)),
+      kUnboxedInt64);
+  flow_graph_->InsertBefore(pre_header_->last_instruction(), constant, nullptr,
+                            FlowGraph::kValue);
+  return constant;
+}
+
+// The result never overflows: see the checks in MatchHeader.
+Definition* LoopVectorization::IndexAdd(Definition* index, int64_t value) {
+  Value* left = new (zone_) Value(index);
+  Value* right = new (zone_) Value(IndexConstant(value));
+  if (index_->representation() == kTagged) {
+    BinarySmiOpInstr* add = new (zone_)
+        BinarySmiOpInstr(Token::kADD, left, right, DeoptId::kNone);
+    add->set_can_overflow(false);
+    return add;
+  }
+  return new (zone_) BinaryInt64OpInstr(Token::kADD, left, right,
+                                        DeoptId::kNone,
+                                        Instruction::kNotSpeculative);
+}
+
+Definition* LoopVectorization::VectorOperand(Value* value) {
+  Definition* def = value->definition();
+  const intptr_t index = IndexOfScalar(def);
+  if (index >= 0) {
+    ASSERT(vector_[index] != nullptr);
+    return vector_[index];
+  }
+  ASSERT(IsInvariant(def));
+  for (intptr_t i = 0; i < invariants_.length(); i++) {
+    if (invariants_[i] == def) {
+      return splats_[i];
+    }
+  }
+  Definition* splat = SimdOpInstr::Create(
+      IsFloat32() ? MethodRecognizer::kFloat32x4Splat
+                  : MethodRecognizer::kFloat64x2Splat,
+      new (zone_) Value(def), DeoptId::kNone);
+  flow_graph_->InsertBefore(pre_header_->last_instruction(), splat, nullptr,
+                            FlowGraph::kValue);
+  invariants_.Add(def);
+  splats_.Add(splat);
+  return splat;
+}
+
+void LoopVectorization::Transform() {
+  const intptr_t vector_cid = IsFloat32() ? kTypedDataFloat32x4ArrayCid
+                                          : kTypedDataFloat64x2ArrayCid;
+  const intptr_t simd_cid = IsFloat32() ? kFloat32x4Cid : kFloat64x2Cid;
+  const intptr_t try_index = header_->try_index();
+
+  //   pre_header:  ...; goto vector_header
+  //   vector_header:
+  //     vector_index = phi(init, vector_index + lanes)
+  //     if (vector_index + lanes - 1 < limit) goto vector_body
+  //     else goto vector_exit
+  //   vector_body: vector loads, operations and stores; goto vector_header
+  //   vector_exit: goto header
+  //   header: index = phi(vector_index, index + 1) ...
+  //
+  // The vector exit takes over the block id of the pre-header since join
+  // predecessors are ordered by block id, so the phi inputs of the header
+  // stay in place.
+  JoinEntryInstr* vector_header = new (zone_) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  TargetEntryInstr* vector_body = new (zone_) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  TargetEntryInstr* vector_exit = new (zone_)
+      TargetEntryInstr(pre_header_->block_id(), try_index, DeoptId::kNone);
+  pre_header_->set_block_id(flow_graph_->allocate_block_id());
+
+  // Vector loop index.
+  PhiInstr* vector_index = new (zone_) PhiInstr(vector_header, 2);
+  flow_graph_->AllocateSSAIndexes(vector_index);
+  vector_index->set_representation(index_->representation());
+  vector_index->UpdateType(*index_->Type());
+  vector_index->mark_alive();
+  vector_header->InsertPhi(vector_index);
+
+  // Vector loop header.
+  Instruction* last = vector_header;
+  if (stack_check_ != nullptr) {
+    CheckStackOverflowInstr* check = new (zone_) CheckStackOverflowInstr(
+        stack_check_->token_pos(), stack_check_->stack_depth(),
+        stack_check_->loop_depth(), stack_check_->deopt_id(),
+        stack_check_->kind());
+    last = flow_graph_->AppendTo(last, check, stack_check_->env(),
+                                 FlowGraph::kEffect);
+    if (check->env() != nullptr) {
+      for (Environment::DeepIterator it(check->env()); !it.Done();
+           it.Advance()) {
+        if (it.CurrentValue()->definition() == index_) {
+          it.CurrentValue()->BindToEnvironment(vector_index);
+        }
+      }
+    }
+  }
+  Definition* last_lane = IndexAdd(vector_index, lanes() - 1);
+  last = flow_graph_->AppendTo(last, last_lane, nullptr, FlowGraph::kValue);
+  ComparisonInstr* comparison = comparison_->CopyWithNewOperands(
+      new (zone_) Value(last_lane),
+      new (zone_) Value(comparison_->right()->definition()));
+  BranchInstr* branch = new (zone_) BranchInstr(comparison, DeoptId::kNone);
+  flow_graph_->AppendTo(last, branch, nullptr, FlowGraph::kEffect);
+  vector_header->set_last_instruction(branch);
+  *branch->true_successor_address() = vector_body;
+  *branch->false_successor_address() = vector_exit;
+
+  // Vector loop body.
+  last = vector_body;
+  vector_index_ = vector_index;
+  if (index_->representation() != kTagged) {
+    vector_index_ = new (zone_) BoxInt64Instr(new (zone_) Value(vector_index));
+    last = flow_graph_->AppendTo(last, vector_index_, nullptr,
+                                 FlowGraph::kValue);
+  }
+  for (intptr_t i = 0; i < scalar_.length(); i++) {
+    Instruction* current = scalar_[i];
+    if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+      LoadIndexedInstr* vector_load = new (zone_) LoadIndexedInstr(
+          new (zone_) Value(load->array()->definition()),
+          new (zone_) Value(vector_index_), load->index_scale(), vector_cid,
+          load->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+          load->token_pos());
+      last = flow_graph_->AppendTo(last, vector_load, nullptr,
+                                   FlowGraph::kValue);
+      vector_.Add(vector_load);
+    } else if (BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp()) {
+      SimdOpInstr* vector_op = SimdOpInstr::Create(
+          SimdOpInstr::KindForOperator(simd_cid, op->op_kind()),
+          new (zone_) Value(VectorOperand(op->left())),
+          new (zone_) Value(VectorOperand(op->right())), DeoptId::kNone);
+      last = flow_graph_->AppendTo(last, vector_op, nullptr,
+                                   FlowGraph::kValue);
+      vector_.Add(vector_op);
+    } else {
+      StoreIndexedInstr* store = current->AsStoreIndexed();
+      ASSERT(store != nullptr);
+      StoreIndexedInstr* vector_store = new (zone_) StoreIndexedInstr(
+          new (zone_) Value(store->array()->definition()),
+          new (zone_) Value(vector_index_),
+          new (zone_) Value(VectorOperand(store->value())), kNoStoreBarrier,
+          store->index_scale(), vector_cid,
+          store->aligned() ? kAlignedAccess : kUnalignedAccess,
+          DeoptId::kNone, store->token_pos(), Instruction::kNotSpeculative);
+      last = flow_graph_->AppendTo(last, vector_store, nullptr,
+                                   FlowGraph::kEffect);
+      vector_.Add(nullptr);
+    }
+  }
+  Definition* next_index = IndexAdd(vector_index, lanes());
+  last = flow_graph_->AppendTo(last, next_index, nullptr, FlowGraph::kValue);
+  GotoInstr* back_edge = new (zone_) GotoInstr(vector_header, DeoptId::kNone);
+  flow_graph_->AppendTo(last, back_edge, nullptr, FlowGraph::kEffect);
+  vector_body->set_last_instruction(back_edge);
+
+  // Vector loop exit.
+  GotoInstr* exit = new (zone_) GotoInstr(header_, DeoptId::kNone);
+  vector_exit->LinkTo(exit);
+  vector_exit->set_last_instruction(exit);
+
+  // Enter the vector loop instead of the scalar loop.
+  pre_header_->last_instruction()->AsGoto()->set_successor(vector_header);
+
+  // Phi inputs are ordered like the (block id ordered) predecessors.
+  const intptr_t vector_init_index =
+      (pre_header_->block_id() < vector_body->block_id()) ? 0 : 1;
+  Value* init = new (zone_) Value(index_->InputAt(init_index_)->definition());
+  Value* update = new (zone_) Value(next_index);
+  vector_index->SetInputAt(vector_init_index, init);
+  vector_index->SetInputAt(1 - vector_init_index, update);
+  init->definition()->AddInputUse(init);
+  next_index->AddInputUse(update);
+
+  // The scalar loop starts where the vector loop stopped.
+  index_->InputAt(init_index_)->BindTo(vector_index);
+
+  if (FLAG_trace_optimization) {
+    THR_Print("Vectorized loop B%" Pd " into B%" Pd "\n", header_->block_id(),
+              vector_header->block_id());
+  }
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  if (!FLAG_loop_vectorization ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+  loop_hierarchy.ComputeInduction();
+
+  // Match all loops before changing the graph, which invalidates the loop
+  // hierarchy.
+  GrowableArray<LoopVectorization*> loops;
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    LoopVectorization* loop = new (flow_graph->zone())
+        LoopVectorization(flow_graph, loop_headers[i]->loop_info());
+    if (loop->Match()) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) {
+    return;
+  }
+  for (intptr_t i = 0; i < loops.length(); ++i) {
+    loops[i]->Transform();
+  }
+
+  // We have changed the block order and the dominator tree.
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
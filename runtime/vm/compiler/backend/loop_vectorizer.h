@@ -0,0 +1,39 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Vectorizes simple counted loops over Float32List and Float64List, e.g.
+//
+//   for (int i = 0; i < out.length; i++) {
+//     out[i] = a[i] * b[i];
+//   }
+//
+// A vector loop which processes Float32x4 (or Float64x2) lanes is inserted
+// in front of the original loop, which is kept as the scalar epilogue for
+// the remaining elements.
+//
+// Only innermost loops with a unit stride index, a body consisting of
+// element-wise loads, arithmetic and stores at the loop index and no
+// remaining bounds checks are vectorized. Arrays have to be internal typed
+// data, which never partially overlap, so lanes are independent. Float32
+// arithmetic is performed in double precision by the scalar code, which is
+// why only a single operation between loads is vectorized for Float32List:
+// rounding its result to single precision gives the same value as the
+// single precision operation.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
@@ -0,0 +1,91 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+// Returns the number of SIMD operations in [flow_graph].
+static intptr_t CountSimdOps(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsSimdOp()) count++;
+    }
+  }
+  return count;
+}
+
+static FlowGraph* CompileFunction(const Library& lib, const char* name) {
+  const auto& function = Function::Handle(GetFunction(lib, name));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  if (FLAG_support_il_printer) {
+    FlowGraphPrinter::PrintGraph("After LoopVectorization", flow_graph);
+  }
+  return flow_graph;
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float64List) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      foo(Float64List a) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = a[i] * a[i];
+        }
+      }
+
+      main() {
+        foo(new Float64List(5));
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+  FlowGraph* flow_graph = CompileFunction(lib, "foo");
+  EXPECT_EQ(1, CountSimdOps(flow_graph));
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float32ListKeepsRounding) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+  // The intermediate sum is computed in double precision by the scalar
+  // loop, so the vector loop would round differently.
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      foo(Float32List a, Float32List b) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = (a[i] + b[i]) * b[i];
+        }
+      }
+
+      main() {
+        foo(new Float32List(5), new Float32List(5));
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+  FlowGraph* flow_graph = CompileFunction(lib, "foo");
+  EXPECT_EQ(0, CountSimdOps(flow_graph));
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -7,6 +7,7 @@
 #include "vm/compiler/backend/loops.h"
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/il.h"
 
 namespace dart {
@@ -943,6 +944,124 @@ void LoopHierarchy::ComputeInduction() const {
   InductionVarAnalysis(preorder_).VisitHierarchy(top_);
 }
 
+// Helper method that determines if [mul] multiplies a basic induction
+// variable of [loop] whose update does not truncate, so that the induction
+// describes the actual runtime values.
+static bool MultipliesBasicInduction(LoopInfo* loop, BinaryInt64OpInstr* mul) {
+  for (intptr_t i = 0; i < mul->InputCount(); i++) {
+    Definition* def = mul->InputAt(i)->definition();
+    def = def->OriginalDefinitionIgnoreBoxingAndConstraints();
+    if (!loop->IsHeaderPhi(def)) {
+      continue;
+    }
+    PhiInstr* phi = def->AsPhi();
+    if ((phi->representation() != kTagged) &&
+        (phi->representation() != kUnboxedInt64)) {
+      return false;
+    }
+    if (!InductionVar::IsLinear(loop->LookupInduction(phi))) {
+      return false;
+    }
+    for (intptr_t j = 0; j < phi->InputCount(); j++) {
+      Definition* update = phi->InputAt(j)->definition();
+      update = update->OriginalDefinitionIgnoreBoxingAndConstraints();
+      if (loop->Contains(update->GetBlock()) && !update->IsBinarySmiOp() &&
+          !update->IsBinaryInt64Op()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+static UnboxedConstantInstr* InsertInt64Constant(FlowGraph* flow_graph,
+                                                 BlockEntryInstr* block,
+                                                 int64_t value) {
+  Zone* zone = flow_graph->zone();
+  UnboxedConstantInstr* constant = new (zone) UnboxedConstantInstr(
+      Integer::ZoneHandle(zone, Integer::New(value, Heap::kOld)),
+      kUnboxedInt64);
+  flow_graph->InsertBefore(block->last_instruction(), constant, nullptr,
+                           FlowGraph::kValue);
+  return constant;
+}
+
+void LoopStrengthReduction::Optimize(FlowGraph* flow_graph) {
+#if !defined(TARGET_ARCH_DBC) && defined(ARCH_IS_64_BIT)
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+  loop_hierarchy.ComputeInduction();
+
+  Zone* zone = flow_graph->zone();
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    JoinEntryInstr* header = loop_headers[i]->AsJoinEntry();
+    LoopInfo* loop = loop_headers[i]->loop_info();
+    // Only loops with a single entry and a single back edge.
+    if ((header == nullptr) || (header->PredecessorCount() != 2) ||
+        (loop->back_edges().length() != 1)) {
+      continue;
+    }
+    const intptr_t init_index = InitIndex(loop);
+    BlockEntryInstr* pre_header = header->PredecessorAt(init_index);
+    BlockEntryInstr* back_edge = header->PredecessorAt(1 - init_index);
+    ASSERT(loop->IsBackEdge(back_edge));
+
+    for (BitVector::Iterator loop_it(loop->blocks()); !loop_it.Done();
+         loop_it.Advance()) {
+      BlockEntryInstr* block = flow_graph->preorder()[loop_it.Current()];
+      if (block->loop_info() != loop) {
+        continue;  // inner loop
+      }
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        BinaryInt64OpInstr* mul = it.Current()->AsBinaryInt64Op();
+        if ((mul == nullptr) || (mul->op_kind() != Token::kMUL)) {
+          continue;
+        }
+        InductionVar* induc = loop->LookupInduction(mul);
+        int64_t initial = 0;
+        int64_t stride = 0;
+        if (!InductionVar::IsLinear(induc, &stride) ||
+            !InductionVar::IsConstant(induc->initial(), &initial) ||
+            !MultipliesBasicInduction(loop, mul)) {
+          continue;
+        }
+
+        // phi = initial; ...; phi = phi + stride (on the back edge).
+        PhiInstr* phi = new (zone) PhiInstr(header, 2);
+        flow_graph->AllocateSSAIndexes(phi);
+        phi->set_representation(kUnboxedInt64);
+        phi->UpdateType(CompileType::Int());
+        phi->mark_alive();
+        BinaryInt64OpInstr* update = new (zone) BinaryInt64OpInstr(
+            Token::kADD, new (zone) Value(phi),
+            new (zone) Value(InsertInt64Constant(flow_graph, pre_header,
+                                                 stride)),
+            DeoptId::kNone, Instruction::kNotSpeculative);
+        flow_graph->InsertBefore(back_edge->last_instruction(), update,
+                                 nullptr, FlowGraph::kValue);
+        Value* init_value = new (zone)
+            Value(InsertInt64Constant(flow_graph, pre_header, initial));
+        Value* update_value = new (zone) Value(update);
+        phi->SetInputAt(init_index, init_value);
+        phi->SetInputAt(1 - init_index, update_value);
+        init_value->definition()->AddInputUse(init_value);
+        update->AddInputUse(update_value);
+        header->InsertPhi(phi);
+
+        if (FLAG_trace_optimization) {
+          THR_Print("Strength reduced v%" Pd " into phi v%" Pd "\n",
+                    mul->ssa_temp_index(), phi->ssa_temp_index());
+        }
+        mul->ReplaceUsesWith(phi);
+        it.RemoveCurrentFromGraph();
+      }
+    }
+  }
+#endif  // !defined(TARGET_ARCH_DBC) && defined(ARCH_IS_64_BIT)
+}
+
 }  // namespace dart
 
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
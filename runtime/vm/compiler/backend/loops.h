@@ -299,6 +299,16 @@ class LoopHierarchy : public ZoneAllocated {
   DISALLOW_COPY_AND_ASSIGN(LoopHierarchy);
 };
 
+// Induction-driven strength reduction. Replaces an unboxed 64-bit
+// multiplication of a basic induction variable by a constant with a new
+// header phi that is advanced by the constant stride on the back edge.
+// Since 64-bit integer arithmetic wraps around, the new phi yields exactly
+// the value of the multiplication in every iteration.
+class LoopStrengthReduction : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_COMPILER_BACKEND_LOOPS_H_
@@ -518,4 +518,70 @@ ISOLATE_UNIT_TEST_CASE(SecondExitDown) {
   EXPECT_STREQ(expected, ComputeInduction(thread, script_chars));
 }
 
+//
+// Strength reduction tests.
+//
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
+    defined(ARCH_IS_64_BIT)
+
+// Counts the 64-bit multiplications in the given flow graph.
+static intptr_t CountInt64Multiplications(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      BinaryInt64OpInstr* op = it.Current()->AsBinaryInt64Op();
+      if ((op != nullptr) && (op->op_kind() == Token::kMUL)) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+ISOLATE_UNIT_TEST_CASE(StrengthReduceMultiplication) {
+  const char* script_chars =
+      R"(
+      int foo(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum += i * 12;
+        }
+        return sum;
+      }
+      main() {
+        foo(100);
+      }
+    )";
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+
+  TestPipeline before(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = before.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kCanonicalize,
+  });
+  EXPECT_EQ(1, CountInt64Multiplications(flow_graph));
+
+  TestPipeline after(function, CompilerPass::kAOT);
+  flow_graph = after.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kLoopStrengthReduction,
+  });
+  EXPECT_EQ(0, CountInt64Multiplications(flow_graph));
+}
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) && ...
+
 }  // namespace dart
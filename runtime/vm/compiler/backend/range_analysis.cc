@@ -16,6 +16,10 @@ DEFINE_FLAG(bool,
             array_bounds_check_elimination,
             true,
             "Eliminate redundant bounds checks.");
+DEFINE_FLAG(bool,
+            loop_versioning,
+            true,
+            "Duplicate loops to remove bounds checks in precompiled code.");
 DEFINE_FLAG(bool, trace_range_analysis, false, "Trace range analysis progress");
 DEFINE_FLAG(bool,
             trace_integer_ir_selection,
@@ -41,6 +45,8 @@ void RangeAnalysis::Analyze() {
   iis.Select();
 
   RemoveConstraints();
+
+  VersionLoops();
 }
 
 // Helper method to chase to a constrained definition.
@@ -1344,6 +1350,703 @@ void RangeAnalysis::EliminateRedundantBoundsChecks() {
   }
 }
 
+// Upper bound on the number of instructions in a loop that is versioned.
+static const intptr_t kMaxVersionedLoopSize = 100;
+
+static int CompareBlockIds(BlockEntryInstr* const* a,
+                           BlockEntryInstr* const* b) {
+  return (*a)->block_id() - (*b)->block_id();
+}
+
+// Versions innermost loops of the form
+//
+//   for (i = init; i < n; i += stride) { ... a[i] ... }
+//
+// with init >= 0 and stride > 0 where the bounds check of a[i] can't be
+// removed because n and a.length are unrelated loop invariant values.
+// The loop is duplicated and a single test of n <= a.length in the
+// pre-header selects the copy in which these checks are removed; the
+// original loop with all its checks is the fallback. Header phis which
+// are used after the loop are merged at the loop exit.
+//
+// This is the precompiled mode counterpart of BoundsCheckGeneralizer, which
+// can hoist the checks out of the loop by deoptimizing instead.
+class LoopVersioning : public ZoneAllocated {
+ public:
+  LoopVersioning(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        header_(nullptr),
+        pre_header_(nullptr),
+        exit_(nullptr),
+        comparison_(nullptr),
+        index_(nullptr),
+        length_(nullptr),
+        init_index_(-1),
+        fast_entry_(nullptr),
+        fast_exit_(nullptr),
+        blocks_(),
+        checks_(),
+        input_uses_(),
+        env_uses_(),
+        exit_phis_(),
+        merges_(),
+        block_clones_(flow_graph->preorder().length()),
+        clones_(flow_graph->current_ssa_temp_index()) {}
+
+  // Returns true if the loop has the shape described above.
+  bool Match();
+
+  // Duplicates the loop behind a test in the pre-header.
+  void Transform();
+
+  BlockEntryInstr* pre_header() const { return pre_header_; }
+  BlockEntryInstr* exit() const { return exit_; }
+
+ private:
+  // Blocks created while versioning other loops are not in this loop.
+  bool InLoop(BlockEntryInstr* block) const {
+    return (block->preorder_number() >= 0) && loop_->Contains(block);
+  }
+  bool IsInvariant(Definition* def) const { return !InLoop(def->GetBlock()); }
+  bool IsUsedAfterLoop(Definition* def) const;
+  bool IsRemovedCheck(Instruction* instr) const;
+
+  // Whether [instr] is one of the instructions CloneInstruction supports.
+  static bool CanClone(Instruction* instr);
+
+  Definition* CloneOf(Definition* def) const;
+  BlockEntryInstr* CloneOf(BlockEntryInstr* block) const;
+  TargetEntryInstr* CloneOfTarget(TargetEntryInstr* target) const;
+  Value* CloneValue(Value* value) const;
+  Instruction* CloneInstruction(Instruction* instr);
+  void CollectUsesAfterLoop();
+  void CloneBlocks();
+  PhiInstr* MergeOf(JoinEntryInstr* join, PhiInstr* phi, intptr_t slow_index);
+  void MergeExits();
+  void InsertGuard();
+
+  FlowGraph* flow_graph_;
+  Zone* zone_;
+  LoopInfo* loop_;
+  JoinEntryInstr* header_;
+  BlockEntryInstr* pre_header_;
+  TargetEntryInstr* exit_;
+  RelationalOpInstr* comparison_;
+  PhiInstr* index_;
+  Definition* length_;
+  intptr_t init_index_;
+  TargetEntryInstr* fast_entry_;
+  TargetEntryInstr* fast_exit_;
+
+  // Blocks of the loop in reverse postorder.
+  GrowableArray<BlockEntryInstr*> blocks_;
+
+  // Bounds checks which are removed from the copy of the loop.
+  GrowableArray<GenericCheckBoundInstr*> checks_;
+
+  // Uses of header phis after the loop, and the phis merging them with
+  // their copies at the exit.
+  GrowableArray<Value*> input_uses_;
+  GrowableArray<Value*> env_uses_;
+  GrowableArray<PhiInstr*> exit_phis_;
+  GrowableArray<PhiInstr*> merges_;
+
+  // Copies of blocks indexed by preorder number and of definitions indexed by
+  // SSA temp index.
+  GrowableArray<BlockEntryInstr*> block_clones_;
+  GrowableArray<Definition*> clones_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVersioning);
+};
+
+bool LoopVersioning::IsUsedAfterLoop(Definition* def) const {
+  for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+    if (!InLoop(it.Current()->instruction()->GetBlock())) {
+      return true;
+    }
+  }
+  for (Value::Iterator it(def->env_use_list()); !it.Done(); it.Advance()) {
+    if (!InLoop(it.Current()->instruction()->GetBlock())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LoopVersioning::IsRemovedCheck(Instruction* instr) const {
+  for (intptr_t i = 0; i < checks_.length(); i++) {
+    if (checks_[i] == instr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LoopVersioning::CanClone(Instruction* instr) {
+  if (BranchInstr* branch = instr->AsBranch()) {
+    ComparisonInstr* comparison = branch->comparison();
+    return comparison->IsRelationalOp() || comparison->IsEqualityCompare() ||
+           comparison->IsStrictCompare() || comparison->IsTestSmi();
+  }
+  return instr->IsGoto() || instr->IsCheckStackOverflow() ||
+         instr->IsBinaryIntegerOp() || instr->IsBox() ||
+         instr->IsBoxInteger() || instr->IsUnbox() ||
+         instr->IsUnboxInteger() || instr->IsIntConverter() ||
+         instr->IsUnboxedConstant() || instr->IsCheckNull() ||
+         instr->IsGenericCheckBound() || instr->IsLoadUntagged() ||
+         instr->IsLoadIndexed() || instr->IsStoreIndexed();
+}
+
+bool LoopVersioning::Match() {
+  header_ = loop_->header()->AsJoinEntry();
+  if ((header_ == nullptr) || (loop_->inner() != nullptr) ||
+      (header_->PredecessorCount() != 2) ||
+      (loop_->back_edges().length() != 1) || header_->InsideTryBlock()) {
+    return false;
+  }
+  for (intptr_t i = 0; i < 2; i++) {
+    if (!loop_->Contains(header_->PredecessorAt(i))) {
+      init_index_ = i;
+      pre_header_ = header_->PredecessorAt(i);
+    }
+  }
+  if ((pre_header_ == nullptr) ||
+      (!pre_header_->IsTargetEntry() && !pre_header_->IsJoinEntry()) ||
+      !pre_header_->last_instruction()->IsGoto() ||
+      flow_graph_->prologue_info().Contains(pre_header_->block_id())) {
+    return false;
+  }
+
+  // The header exits the loop when [index] < [limit] does not hold.
+  BranchInstr* branch = header_->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  comparison_ = branch->comparison()->AsRelationalOp();
+  if ((comparison_ == nullptr) || (comparison_->kind() != Token::kLT) ||
+      ((comparison_->operation_cid() != kSmiCid) &&
+       (comparison_->operation_cid() != kMintCid)) ||
+      !loop_->Contains(branch->true_successor()) ||
+      loop_->Contains(branch->false_successor()) ||
+      !IsInvariant(comparison_->right()->definition())) {
+    return false;
+  }
+  exit_ = branch->false_successor();
+  Definition* left = comparison_->left()
+                         ->definition()
+                         ->OriginalDefinitionIgnoreBoxingAndConstraints();
+  if (!loop_->IsHeaderPhi(left)) {
+    return false;
+  }
+  index_ = left->AsPhi();
+
+  // The index is at least its non-negative initial value and, while it is
+  // less than the limit, incrementing it can't overflow.
+  int64_t stride = 0;
+  Definition* init = index_->InputAt(init_index_)->definition();
+  if (!InductionVar::IsLinear(loop_->LookupInduction(index_), &stride) ||
+      (stride <= 0) || (stride > kMaxInt32) ||
+      !RangeUtils::IsPositive(init->range())) {
+    return false;
+  }
+
+  intptr_t size = 0;
+  for (BlockIterator it = flow_graph_->reverse_postorder_iterator();
+       !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+    if (!loop_->Contains(block)) {
+      continue;
+    }
+    if ((!block->IsTargetEntry() && !block->IsJoinEntry()) ||
+        block->InsideTryBlock()) {
+      return false;
+    }
+    // The only exit is the one out of the header.
+    Instruction* last = block->last_instruction();
+    for (intptr_t i = 0; i < last->SuccessorCount(); i++) {
+      BlockEntryInstr* successor = last->SuccessorAt(i);
+      if (!loop_->Contains(successor) && (successor != exit_)) {
+        return false;
+      }
+    }
+    // Only header phis are used after the loop, since nothing else in the
+    // loop dominates the exit.
+    if (JoinEntryInstr* join = block->AsJoinEntry()) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        if ((join != header_) && IsUsedAfterLoop(it.Current())) {
+          return false;
+        }
+      }
+    }
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if ((++size > kMaxVersionedLoopSize) || !CanClone(current)) {
+        return false;
+      }
+      Definition* def = current->AsDefinition();
+      if ((def != nullptr) && IsUsedAfterLoop(def)) {
+        return false;
+      }
+      GenericCheckBoundInstr* check = current->AsGenericCheckBound();
+      if ((check != nullptr) &&
+          (check->index()
+               ->definition()
+               ->OriginalDefinitionIgnoreBoxingAndConstraints() == index_) &&
+          IsInvariant(check->length()->definition()) &&
+          ((length_ == nullptr) ||
+           (length_ == check->length()->definition()))) {
+        length_ = check->length()->definition();
+        checks_.Add(check);
+      }
+    }
+    blocks_.Add(block);
+  }
+  if (checks_.is_empty()) {
+    return false;
+  }
+
+  // The guard compares the length like the loop compares the index.
+  if (comparison_->operation_cid() == kSmiCid) {
+    return (length_->representation() == kTagged) &&
+           (length_->Type()->ToCid() == kSmiCid);
+  }
+  return (length_->representation() == kTagged) ||
+         (length_->representation() == kUnboxedInt64);
+}
+
+Definition* LoopVersioning::CloneOf(Definition* def) const {
+  if (def->HasSSATemp() && (def->ssa_temp_index() < clones_.length()) &&
+      (clones_[def->ssa_temp_index()] != nullptr)) {
+    return clones_[def->ssa_temp_index()];
+  }
+  return def;
+}
+
+BlockEntryInstr* LoopVersioning::CloneOf(BlockEntryInstr* block) const {
+  ASSERT(loop_->Contains(block));
+  return block_clones_[block->preorder_number()];
+}
+
+TargetEntryInstr* LoopVersioning::CloneOfTarget(
+    TargetEntryInstr* target) const {
+  return (target == exit_) ? fast_exit_ : CloneOf(target)->AsTargetEntry();
+}
+
+Value* LoopVersioning::CloneValue(Value* value) const {
+  Value* copy = new (zone_) Value(CloneOf(value->definition()));
+  if (value->reaching_type() != nullptr) {
+    copy->SetReachingType(value->reaching_type());
+  }
+  return copy;
+}
+
+Instruction* LoopVersioning::CloneInstruction(Instruction* instr) {
+  const intptr_t deopt_id =
+      (instr->ComputeCanDeoptimize() || instr->CanBecomeDeoptimizationTarget())
+          ? instr->deopt_id()
+          : DeoptId::kNone;
+  if (GotoInstr* goto_instr = instr->AsGoto()) {
+    return new (zone_) GotoInstr(
+        CloneOf(goto_instr->successor())->AsJoinEntry(), deopt_id);
+  }
+  if (BranchInstr* branch = instr->AsBranch()) {
+    ComparisonInstr* comparison = branch->comparison();
+    BranchInstr* copy = new (zone_) BranchInstr(
+        comparison->CopyWithNewOperands(CloneValue(comparison->left()),
+                                        CloneValue(comparison->right())),
+        deopt_id);
+    *copy->true_successor_address() = CloneOfTarget(branch->true_successor());
+    *copy->false_successor_address() =
+        CloneOfTarget(branch->false_successor());
+    if (branch->constant_target() != nullptr) {
+      copy->set_constant_target(CloneOfTarget(branch->constant_target()));
+    }
+    return copy;
+  }
+  if (CheckStackOverflowInstr* check = instr->AsCheckStackOverflow()) {
+    return new (zone_) CheckStackOverflowInstr(
+        check->token_pos(), check->stack_depth(), check->loop_depth(),
+        deopt_id, check->kind());
+  }
+  if (BinaryIntegerOpInstr* op = instr->AsBinaryIntegerOp()) {
+    BinaryIntegerOpInstr* copy = nullptr;
+    if (op->IsBinaryInt64Op()) {
+      copy = new (zone_) BinaryInt64OpInstr(
+          op->op_kind(), CloneValue(op->left()), CloneValue(op->right()),
+          deopt_id, op->speculative_mode());
+      copy->set_can_overflow(op->can_overflow());
+      if (op->is_truncating()) {
+        copy->mark_truncating();
+      }
+    } else {
+      copy = BinaryIntegerOpInstr::Make(
+          op->representation(), op->op_kind(), CloneValue(op->left()),
+          CloneValue(op->right()), deopt_id, op->can_overflow(),
+          op->is_truncating(), op->range(), op->speculative_mode());
+    }
+    ASSERT(copy != nullptr);
+    return copy;
+  }
+  if (instr->IsBox() || instr->IsBoxInteger()) {
+    BoxInstr* box = static_cast<BoxInstr*>(instr);
+    return BoxInstr::Create(box->from_representation(),
+                            CloneValue(box->value()));
+  }
+  if (instr->IsUnbox() || instr->IsUnboxInteger()) {
+    UnboxInstr* unbox = static_cast<UnboxInstr*>(instr);
+    UnboxInstr* copy =
+        UnboxInstr::Create(unbox->representation(), CloneValue(unbox->value()),
+                           deopt_id, unbox->speculative_mode());
+    if (unbox->IsUnboxInteger() && unbox->AsUnboxInteger()->is_truncating()) {
+      copy->AsUnboxInteger()->mark_truncating();
+    }
+    return copy;
+  }
+  if (IntConverterInstr* converter = instr->AsIntConverter()) {
+    IntConverterInstr* copy = new (zone_)
+        IntConverterInstr(converter->from(), converter->to(),
+                          CloneValue(converter->value()), deopt_id);
+    if (converter->is_truncating()) {
+      copy->mark_truncating();
+    }
+    return copy;
+  }
+  if (UnboxedConstantInstr* constant = instr->AsUnboxedConstant()) {
+    return new (zone_)
+        UnboxedConstantInstr(constant->value(), constant->representation());
+  }
+  if (CheckNullInstr* check = instr->AsCheckNull()) {
+    return new (zone_) CheckNullInstr(CloneValue(check->value()),
+                                      check->function_name(), deopt_id,
+                                      check->token_pos());
+  }
+  if (GenericCheckBoundInstr* check = instr->AsGenericCheckBound()) {
+    return new (zone_) GenericCheckBoundInstr(
+        CloneValue(check->length()), CloneValue(check->index()), deopt_id);
+  }
+  if (LoadUntaggedInstr* load = instr->AsLoadUntagged()) {
+    return new (zone_)
+        LoadUntaggedInstr(CloneValue(load->object()), load->offset());
+  }
+  if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    return new (zone_) LoadIndexedInstr(
+        CloneValue(load->array()), CloneValue(load->index()),
+        load->index_scale(), load->class_id(),
+        load->aligned() ? kAlignedAccess : kUnalignedAccess, deopt_id,
+        load->token_pos());
+  }
+  StoreIndexedInstr* store = instr->AsStoreIndexed();
+  ASSERT(store != nullptr);
+  return new (zone_) StoreIndexedInstr(
+      CloneValue(store->array()), CloneValue(store->index()),
+      CloneValue(store->value()),
+      store->ShouldEmitStoreBarrier() ? kEmitStoreBarrier : kNoStoreBarrier,
+      store->index_scale(), store->class_id(),
+      store->aligned() ? kAlignedAccess : kUnalignedAccess, deopt_id,
+      store->token_pos(), store->speculative_mode());
+}
+
+void LoopVersioning::CloneBlocks() {
+  for (intptr_t i = 0; i < flow_graph_->preorder().length(); i++) {
+    block_clones_.Add(nullptr);
+  }
+  for (intptr_t i = 0; i < flow_graph_->current_ssa_temp_index(); i++) {
+    clones_.Add(nullptr);
+  }
+
+  // Join predecessors are ordered by block id, so the copies are numbered
+  // in the order of the original blocks to keep phi inputs in place.
+  GrowableArray<BlockEntryInstr*> sorted(blocks_.length());
+  for (intptr_t i = 0; i < blocks_.length(); i++) {
+    sorted.Add(blocks_[i]);
+  }
+  sorted.Sort(CompareBlockIds);
+  const intptr_t try_index = header_->try_index();
+
+  // The fast entry is numbered before the copy of the back edge.
+  fast_entry_ = new (zone_) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                             pre_header_->try_index(),
+                                             DeoptId::kNone);
+  for (intptr_t i = 0; i < sorted.length(); i++) {
+    BlockEntryInstr* block = sorted[i];
+    const intptr_t block_id = flow_graph_->allocate_block_id();
+    BlockEntryInstr* clone = nullptr;
+    if (block->IsJoinEntry()) {
+      clone = new (zone_)
+          JoinEntryInstr(block_id, try_index, block->deopt_id());
+    } else {
+      clone = new (zone_)
+          TargetEntryInstr(block_id, try_index, block->deopt_id());
+    }
+    block_clones_[block->preorder_number()] = clone;
+  }
+  fast_exit_ = new (zone_) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                            exit_->try_index(),
+                                            exit_->deopt_id());
+
+  // Phis first since their inputs may be defined later in the loop.
+  for (intptr_t i = 0; i < blocks_.length(); i++) {
+    JoinEntryInstr* join = blocks_[i]->AsJoinEntry();
+    if (join == nullptr) {
+      continue;
+    }
+    for (PhiIterator it(join); !it.Done(); it.Advance()) {
+      PhiInstr* phi = it.Current();
+      PhiInstr* copy = new (zone_)
+          PhiInstr(CloneOf(join)->AsJoinEntry(), phi->InputCount());
+      flow_graph_->AllocateSSAIndexes(copy);
+      copy->set_representation(phi->representation());
+      copy->UpdateType(*phi->Type());
+      if (phi->range() != nullptr) {
+        copy->set_range(*phi->range());
+      }
+      if (phi->is_alive()) {
+        copy->mark_alive();
+      }
+      CloneOf(join)->AsJoinEntry()->InsertPhi(copy);
+      clones_[phi->ssa_temp_index()] = copy;
+    }
+  }
+
+  for (intptr_t i = 0; i < blocks_.length(); i++) {
+    BlockEntryInstr* block = blocks_[i];
+    Instruction* last = CloneOf(block);
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      Definition* def = current->AsDefinition();
+      if (IsRemovedCheck(current)) {
+        if (def->HasSSATemp()) {
+          clones_[def->ssa_temp_index()] =
+              CloneOf(current->AsGenericCheckBound()->index()->definition());
+        }
+        continue;
+      }
+      Instruction* copy = CloneInstruction(current);
+      if ((def != nullptr) && def->HasSSATemp()) {
+        Definition* def_copy = copy->AsDefinition();
+        last = flow_graph_->AppendTo(last, copy, current->env(),
+                                     FlowGraph::kValue);
+        def_copy->UpdateType(*def->Type());
+        if (def->range() != nullptr) {
+          def_copy->set_range(*def->range());
+        }
+        clones_[def->ssa_temp_index()] = def_copy;
+      } else {
+        last = flow_graph_->AppendTo(last, copy, current->env(),
+                                     FlowGraph::kEffect);
+      }
+      if (copy->env() != nullptr) {
+        for (Environment::DeepIterator env_it(copy->env()); !env_it.Done();
+             env_it.Advance()) {
+          Value* value = env_it.CurrentValue();
+          Definition* clone = CloneOf(value->definition());
+          if (clone != value->definition()) {
+            value->BindToEnvironment(clone);
+          }
+        }
+      }
+    }
+    CloneOf(block)->set_last_instruction(last);
+  }
+
+  // Phi inputs. The copy of the header is entered from the fast entry in
+  // place of the pre-header.
+  BlockEntryInstr* back_edge = header_->PredecessorAt(1 - init_index_);
+  const intptr_t fast_init_index =
+      (fast_entry_->block_id() < CloneOf(back_edge)->block_id()) ? 0 : 1;
+  for (intptr_t i = 0; i < blocks_.length(); i++) {
+    JoinEntryInstr* join = blocks_[i]->AsJoinEntry();
+    if (join == nullptr) {
+      continue;
+    }
+    for (PhiIterator it(join); !it.Done(); it.Advance()) {
+      PhiInstr* phi = it.Current();
+      PhiInstr* copy = CloneOf(phi)->AsPhi();
+      for (intptr_t j = 0; j < phi->InputCount(); j++) {
+        intptr_t index = j;
+        if (join == header_) {
+          index = (j == init_index_) ? fast_init_index : 1 - fast_init_index;
+        }
+        Value* input = CloneValue(phi->InputAt(j));
+        copy->SetInputAt(index, input);
+        input->definition()->AddInputUse(input);
+      }
+    }
+  }
+}
+
+void LoopVersioning::CollectUsesAfterLoop() {
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    for (Value::Iterator use_it(phi->input_use_list()); !use_it.Done();
+         use_it.Advance()) {
+      if (!InLoop(use_it.Current()->instruction()->GetBlock())) {
+        input_uses_.Add(use_it.Current());
+      }
+    }
+    for (Value::Iterator use_it(phi->env_use_list()); !use_it.Done();
+         use_it.Advance()) {
+      if (!InLoop(use_it.Current()->instruction()->GetBlock())) {
+        env_uses_.Add(use_it.Current());
+      }
+    }
+  }
+}
+
+PhiInstr* LoopVersioning::MergeOf(JoinEntryInstr* join,
+                                  PhiInstr* phi,
+                                  intptr_t slow_index) {
+  for (intptr_t i = 0; i < exit_phis_.length(); i++) {
+    if (exit_phis_[i] == phi) {
+      return merges_[i];
+    }
+  }
+  PhiInstr* merge = new (zone_) PhiInstr(join, 2);
+  flow_graph_->AllocateSSAIndexes(merge);
+  merge->set_representation(phi->representation());
+  merge->UpdateType(*phi->Type());
+  if (phi->range() != nullptr) {
+    merge->set_range(*phi->range());
+  }
+  merge->mark_alive();
+  join->InsertPhi(merge);
+  Value* slow_input = new (zone_) Value(phi);
+  Value* fast_input = new (zone_) Value(CloneOf(phi));
+  merge->SetInputAt(slow_index, slow_input);
+  merge->SetInputAt(1 - slow_index, fast_input);
+  slow_input->definition()->AddInputUse(slow_input);
+  fast_input->definition()->AddInputUse(fast_input);
+  exit_phis_.Add(phi);
+  merges_.Add(merge);
+  return merge;
+}
+
+void LoopVersioning::MergeExits() {
+  // The exit becomes the common successor of both loops. It keeps its block
+  // id, so the order of predecessors of its successors is unchanged.
+  JoinEntryInstr* join = new (zone_) JoinEntryInstr(
+      exit_->block_id(), exit_->try_index(), exit_->deopt_id());
+  exit_->set_block_id(flow_graph_->allocate_block_id());
+  join->LinkTo(exit_->next());
+  join->set_last_instruction(exit_->last_instruction());
+  GotoInstr* slow_goto = new (zone_) GotoInstr(join, DeoptId::kNone);
+  exit_->LinkTo(slow_goto);
+  exit_->set_last_instruction(slow_goto);
+  GotoInstr* fast_goto = new (zone_) GotoInstr(join, DeoptId::kNone);
+  fast_exit_->LinkTo(fast_goto);
+  fast_exit_->set_last_instruction(fast_goto);
+
+  const intptr_t slow_index =
+      (exit_->block_id() < fast_exit_->block_id()) ? 0 : 1;
+  for (intptr_t i = 0; i < input_uses_.length(); i++) {
+    Value* use = input_uses_[i];
+    use->BindTo(MergeOf(join, use->definition()->AsPhi(), slow_index));
+  }
+  for (intptr_t i = 0; i < env_uses_.length(); i++) {
+    Value* use = env_uses_[i];
+    use->BindToEnvironment(
+        MergeOf(join, use->definition()->AsPhi(), slow_index));
+  }
+}
+
+void LoopVersioning::InsertGuard() {
+  // The slow entry takes over the block id of the pre-header so the phi
+  // inputs of the original header stay in place.
+  TargetEntryInstr* slow_entry = new (zone_) TargetEntryInstr(
+      pre_header_->block_id(), pre_header_->try_index(), DeoptId::kNone);
+  pre_header_->set_block_id(flow_graph_->allocate_block_id());
+  GotoInstr* slow_goto = new (zone_) GotoInstr(header_, DeoptId::kNone);
+  slow_entry->LinkTo(slow_goto);
+  slow_entry->set_last_instruction(slow_goto);
+
+  // Replace the goto at the end of the pre-header by
+  //   if (length < limit) goto slow_entry else goto fast_entry
+  Instruction* last = pre_header_->last_instruction()->previous();
+  Definition* length = length_;
+  if ((comparison_->operation_cid() == kMintCid) &&
+      (length->representation() != kUnboxedInt64)) {
+    length = UnboxInstr::Create(kUnboxedInt64, new (zone_) Value(length_),
+                                DeoptId::kNone, Instruction::kNotSpeculative);
+    if (length_->range() != nullptr) {
+      length->set_range(*length_->range());
+    }
+    last = flow_graph_->AppendTo(last, length, nullptr, FlowGraph::kValue);
+  }
+  BranchInstr* guard = new (zone_) BranchInstr(
+      comparison_->CopyWithNewOperands(
+          new (zone_) Value(length),
+          new (zone_) Value(comparison_->right()->definition())),
+      DeoptId::kNone);
+  flow_graph_->AppendTo(last, guard, nullptr, FlowGraph::kEffect);
+  pre_header_->set_last_instruction(guard);
+  *guard->true_successor_address() = slow_entry;
+  *guard->false_successor_address() = fast_entry_;
+
+  GotoInstr* fast_goto = new (zone_) GotoInstr(
+      CloneOf(header_)->AsJoinEntry(), DeoptId::kNone);
+  fast_entry_->LinkTo(fast_goto);
+  fast_entry_->set_last_instruction(fast_goto);
+}
+
+void LoopVersioning::Transform() {
+  CollectUsesAfterLoop();
+  CloneBlocks();
+  MergeExits();
+  InsertGuard();
+
+  if (FLAG_support_il_printer && FLAG_trace_range_analysis) {
+    THR_Print("Versioned loop B%" Pd " into B%" Pd " without %" Pd
+              " bounds checks\n",
+              header_->block_id(), CloneOf(header_)->block_id(),
+              checks_.length());
+  }
+}
+
+void RangeAnalysis::VersionLoops() {
+  if (!FLAG_array_bounds_check_elimination || !FLAG_loop_versioning ||
+      !FLAG_precompiled_mode) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+
+  // Match all loops before changing the graph. Loops next to each other
+  // are skipped if the exit of one is the pre-header of the other.
+  GrowableArray<LoopVersioning*> loops;
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    LoopVersioning* loop =
+        new (Z) LoopVersioning(flow_graph_, loop_headers[i]->loop_info());
+    if (!loop->Match()) {
+      continue;
+    }
+    bool overlaps = false;
+    for (intptr_t j = 0; j < loops.length(); ++j) {
+      if ((loop->pre_header() == loops[j]->exit()) ||
+          (loop->exit() == loops[j]->pre_header())) {
+        overlaps = true;
+      }
+    }
+    if (!overlaps) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) {
+    return;
+  }
+  for (intptr_t i = 0; i < loops.length(); ++i) {
+    loops[i]->Transform();
+  }
+
+  // We have changed the block order and the dominator tree.
+  flow_graph_->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph_->ComputeDominators(&dominance_frontier);
+}
+
 void RangeAnalysis::MarkUnreachableBlocks() {
   for (intptr_t i = 0; i < constraints_.length(); i++) {
     if (Range::IsUnknown(constraints_[i]->range())) {
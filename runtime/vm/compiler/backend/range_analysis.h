@@ -595,6 +595,10 @@ class RangeAnalysis : public ValueObject {
   // unconstrained definitions.
   void RemoveConstraints();
 
+  // Duplicate loops whose bounds checks remain only because the loop bound
+  // is not related to the array length, see LoopVersioning.
+  void VersionLoops();
+
   Range* ConstraintSmiRange(Token::Kind op, Definition* boundary);
 
   Zone* zone() const { return flow_graph_->zone(); }
@@ -18,6 +18,10 @@ namespace dart {
 
 DEFINE_FLAG(bool, dead_store_elimination, true, "Eliminate dead stores");
 DEFINE_FLAG(bool, load_cse, true, "Use redundant load elimination.");
+DEFINE_FLAG(bool,
+            partial_escape_analysis,
+            true,
+            "Sink allocations which only escape at a single point.");
 DEFINE_FLAG(bool,
             trace_load_optimization,
             false,
@@ -2636,13 +2640,22 @@ static bool IsSupportedAllocation(Instruction* instr) {
 
 enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
 
+static bool IsTypedDataViewAllocation(Definition* defn) {
+  AllocateObjectInstr* alloc = defn->AsAllocateObject();
+  return (alloc != NULL) &&
+         RawObject::IsTypedDataViewClassId(alloc->cls().id());
+}
+
 // Check if the use is safe for allocation sinking. Allocation sinking
 // candidates can only be used at store instructions:
 //
 //     - any store into the allocation candidate itself is unconditionally safe
 //       as it just changes the rematerialization state of this candidate;
 //     - store into another object is only safe if another object is allocation
-//       candidate.
+//       candidate;
+//     - the store of the inner pointer of a typed data view is safe as the
+//       pointer is recomputed from the backing store and offset of the view
+//       when it is materialized.
 //
 // We use a simple fix-point algorithm to discover the set of valid candidates
 // (see CollectCandidates method), that's why this IsSafeUse can operate in two
@@ -2672,6 +2685,13 @@ static bool IsSafeUse(Value* use, SafeUseCheck check_type) {
     return true;
   }
 
+  StoreUntaggedInstr* store_data = use->instruction()->AsStoreUntagged();
+  if (store_data != NULL) {
+    return (use == store_data->object()) &&
+           (store_data->offset() == TypedDataBase::data_field_offset()) &&
+           IsTypedDataViewAllocation(use->definition());
+  }
+
   return false;
 }
 
@@ -2705,6 +2725,30 @@ static Definition* StoreInto(Value* use) {
   return NULL;
 }
 
+// Removes [defn] if it is unused and then, transitively, the definitions it
+// used which become unused. Only follows the side effect free instructions
+// that compute the inner pointer of a typed data view.
+static void RemoveDeadInnerPointer(Definition* defn) {
+  GrowableArray<Definition*> worklist;
+  worklist.Add(defn);
+  while (!worklist.is_empty()) {
+    Definition* current = worklist.RemoveLast();
+    if ((current->previous() == NULL) || current->HasUses() ||
+        current->CanDeoptimize()) {
+      continue;
+    }
+    if (!current->IsLoadUntagged() && !current->IsIntConverter() &&
+        !current->IsUnboxInteger() && !current->IsBinaryInt64Op() &&
+        !current->IsBinaryInt32Op()) {
+      continue;
+    }
+    for (intptr_t i = 0; i < current->InputCount(); i++) {
+      worklist.Add(current->InputAt(i)->definition());
+    }
+    current->RemoveFromGraph();
+  }
+}
+
 // Remove the given allocation from the graph. It is not observable.
 // If deoptimization occurs the object will be materialized.
 void AllocationSinking::EliminateAllocation(Definition* alloc) {
@@ -2719,7 +2763,11 @@ void AllocationSinking::EliminateAllocation(Definition* alloc) {
   // fields. Remove these stores.
   for (Value* use = alloc->input_use_list(); use != NULL;
        use = alloc->input_use_list()) {
+    StoreUntaggedInstr* store_data = use->instruction()->AsStoreUntagged();
     use->instruction()->RemoveFromGraph();
+    if (store_data != NULL) {
+      RemoveDeadInnerPointer(store_data->value()->definition());
+    }
   }
 
 // There should be no environment uses. The pass replaced them with
@@ -2739,6 +2787,201 @@ void AllocationSinking::EliminateAllocation(Definition* alloc) {
   }
 }
 
+// Returns the instruction before which an object used by [instr] has to
+// exist: arguments of calls have to exist before the first argument is
+// pushed.
+static Instruction* EscapePointOf(Instruction* instr) {
+  PushArgumentInstr* push = instr->AsPushArgument();
+  if (push == NULL) {
+    return instr;
+  }
+  for (Instruction* next = push->next(); next != NULL; next = next->next()) {
+    for (intptr_t i = 0; i < next->ArgumentCount(); i++) {
+      if (next->PushArgumentAt(i) == push) {
+        return next->PushArgumentAt(0);
+      }
+    }
+  }
+  return NULL;
+}
+
+// Adds all blocks reachable from [block] (following successors if [forward]
+// is true, predecessors otherwise) to [reachable], not counting [block]
+// itself unless it is on a cycle.
+static void CollectReachableBlocks(BlockEntryInstr* block,
+                                   bool forward,
+                                   BitVector* reachable) {
+  GrowableArray<BlockEntryInstr*> worklist;
+  worklist.Add(block);
+  while (!worklist.is_empty()) {
+    BlockEntryInstr* current = worklist.RemoveLast();
+    const intptr_t count = forward
+                               ? current->last_instruction()->SuccessorCount()
+                               : current->PredecessorCount();
+    for (intptr_t i = 0; i < count; i++) {
+      BlockEntryInstr* next = forward
+                                  ? current->last_instruction()->SuccessorAt(i)
+                                  : current->PredecessorAt(i);
+      if (!reachable->Contains(next->preorder_number())) {
+        reachable->Add(next->preorder_number());
+        worklist.Add(next);
+      }
+    }
+  }
+}
+
+bool AllocationSinking::TryMaterializeAtEscape(AllocateObjectInstr* alloc) {
+  if ((alloc->ArgumentCount() != 0) || !alloc->closure_function().IsNull()) {
+    return false;
+  }
+  // A copy of a typed data view would also need its inner pointer.
+  if (IsTypedDataViewAllocation(alloc)) {
+    return false;
+  }
+
+  // All uses except stores into the allocation are escapes, and they all
+  // have to be in the same instruction.
+  Instruction* escape = NULL;
+  for (Value::Iterator it(alloc->input_use_list()); !it.Done(); it.Advance()) {
+    Value* use = it.Current();
+    StoreInstanceFieldInstr* store = use->instruction()->AsStoreInstanceField();
+    if ((store != NULL) && (use == store->instance()) &&
+        (store->value()->definition() != alloc)) {
+      continue;
+    }
+    if ((escape != NULL) && (escape != use->instruction())) {
+      return false;
+    }
+    escape = use->instruction();
+  }
+  if ((escape == NULL) || escape->IsPhi()) {
+    return false;
+  }
+  Instruction* point = EscapePointOf(escape);
+  if (point == NULL) {
+    return false;
+  }
+
+  // The copy is only valid if the escape point is executed at most once per
+  // execution of the allocation and everything which happens afterwards
+  // sees the copy.
+  BlockEntryInstr* block = point->GetBlock();
+  const intptr_t num_blocks = flow_graph_->preorder().length();
+  BitVector* after = new (Z) BitVector(Z, num_blocks);
+  BitVector* before = new (Z) BitVector(Z, num_blocks);
+  CollectReachableBlocks(block, /*forward=*/true, after);
+  CollectReachableBlocks(block, /*forward=*/false, before);
+  if (after->Contains(block->preorder_number())) {
+    return false;
+  }
+  GrowableArray<Instruction*> block_after;
+  for (Instruction* instr = point; instr != NULL; instr = instr->next()) {
+    block_after.Add(instr);
+  }
+
+  GrowableArray<Value*> input_uses_after;
+  GrowableArray<Value*> env_uses_after;
+  GrowableArray<StoreInstanceFieldInstr*> stores;
+  for (intptr_t pass = 0; pass < 2; pass++) {
+    const bool env = (pass == 1);
+    for (Value::Iterator it(env ? alloc->env_use_list()
+                                : alloc->input_use_list());
+         !it.Done(); it.Advance()) {
+      Value* use = it.Current();
+      Instruction* instr = use->instruction();
+      BlockEntryInstr* use_block = instr->GetBlock();
+      bool is_after = false;
+      if (use_block == block) {
+        for (intptr_t i = 0; i < block_after.length(); i++) {
+          if (block_after[i] == instr) {
+            is_after = true;
+            break;
+          }
+        }
+      } else if (after->Contains(use_block->preorder_number())) {
+        if (!block->Dominates(use_block)) {
+          return false;
+        }
+        is_after = true;
+      }
+      if (is_after) {
+        (env ? env_uses_after : input_uses_after).Add(use);
+        continue;
+      }
+      StoreInstanceFieldInstr* store = instr->AsStoreInstanceField();
+      if (env || (store == NULL) ||
+          ((use_block != block) &&
+           !before->Contains(use_block->preorder_number()))) {
+        continue;
+      }
+      // A store which may be executed before the escape determines the
+      // value of the field in the copy.
+      if (!point->IsDominatedBy(store)) {
+        return false;
+      }
+      bool found = false;
+      for (intptr_t i = 0; i < stores.length(); i++) {
+        if (&stores[i]->slot() == &store->slot()) {
+          if (store->IsDominatedBy(stores[i])) {
+            stores[i] = store;
+          }
+          found = true;
+        }
+      }
+      if (!found) {
+        stores.Add(store);
+      }
+    }
+  }
+
+  // Allocate and initialize the copy right before the object escapes, and
+  // let everything afterwards refer to it.
+  AllocateObjectInstr* copy = new (Z) AllocateObjectInstr(
+      alloc->token_pos(), alloc->cls(), new (Z) PushArgumentsArray(0));
+  flow_graph_->InsertBefore(point, copy, NULL, FlowGraph::kValue);
+  for (intptr_t i = 0; i < stores.length(); i++) {
+    StoreInstanceFieldInstr* store = new (Z) StoreInstanceFieldInstr(
+        stores[i]->slot(), new (Z) Value(copy),
+        stores[i]->value()->CopyWithType(Z), kEmitStoreBarrier,
+        alloc->token_pos(), StoreInstanceFieldInstr::Kind::kInitializing);
+    flow_graph_->InsertBefore(point, store, NULL, FlowGraph::kEffect);
+  }
+  for (intptr_t i = 0; i < input_uses_after.length(); i++) {
+    input_uses_after[i]->BindTo(copy);
+  }
+  for (intptr_t i = 0; i < env_uses_after.length(); i++) {
+    env_uses_after[i]->BindToEnvironment(copy);
+  }
+
+  if (FLAG_trace_optimization) {
+    THR_Print("materializing allocation v%" Pd " as v%" Pd " at %s\n",
+              alloc->ssa_temp_index(), copy->ssa_temp_index(),
+              escape->ToCString());
+  }
+  return true;
+}
+
+// Allocations which escape at a single point, typically a call on a cold
+// path, are copied at that point. The original allocation no longer escapes
+// and can be sunk by the rest of the pass.
+void AllocationSinking::MaterializeAtEscapes() {
+  GrowableArray<AllocateObjectInstr*> allocations;
+  for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      AllocateObjectInstr* alloc = it.Current()->AsAllocateObject();
+      if ((alloc != NULL) &&
+          !IsAllocationSinkingCandidate(alloc, kOptimisticCheck)) {
+        allocations.Add(alloc);
+      }
+    }
+  }
+  for (intptr_t i = 0; i < allocations.length(); i++) {
+    TryMaterializeAtEscape(allocations[i]);
+  }
+}
+
 // Find allocation instructions that can be potentially eliminated and
 // rematerialized at deoptimization exits if needed. See IsSafeUse
 // for the description of algorithm used below.
@@ -2897,7 +3140,8 @@ void AllocationSinking::DiscoverFailedCandidates() {
         } else {
           ASSERT(use->instruction()->IsMaterializeObject() ||
                  use->instruction()->IsPhi() ||
-                 use->instruction()->IsStoreInstanceField());
+                 use->instruction()->IsStoreInstanceField() ||
+                 use->instruction()->IsStoreUntagged());
         }
       }
     } else {
@@ -2931,6 +3175,9 @@ void AllocationSinking::DiscoverFailedCandidates() {
 }
 
 void AllocationSinking::Optimize() {
+  if (FLAG_partial_escape_analysis) {
+    MaterializeAtEscapes();
+  }
   CollectCandidates();
 
   // Insert MaterializeObject instructions that will describe the state of the
@@ -52,6 +52,11 @@ class AllocationSinking : public ZoneAllocated {
     GrowableArray<Definition*> worklist_;
   };
 
+  // Replaces allocations which escape at a single instruction with a copy
+  // made right before that instruction, see TryMaterializeAtEscape.
+  void MaterializeAtEscapes();
+  bool TryMaterializeAtEscape(AllocateObjectInstr* alloc);
+
   void CollectCandidates();
 
   void NormalizeMaterializations();
@@ -551,4 +551,54 @@ ISOLATE_UNIT_TEST_CASE(
                        /* make_host_escape= */ true, MakeAssertAssignable);
 }
 
+// Verifies that an allocation which only escapes on one path is only
+// allocated on that path.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscape) {
+  const char* kScript = R"(
+      class Point {
+        final double x;
+        final double y;
+        Point(this.x, this.y);
+      }
+
+      @pragma('vm:never-inline')
+      void report(Point p) {}
+
+      double foo(double a, bool b) {
+        final p = new Point(a, a + 1.0);
+        if (b) {
+          report(p);
+        }
+        return a;
+      }
+
+      main() {
+        foo(1.0, false);
+        foo(2.0, true);
+      }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  AllocateObjectInstr* alloc = nullptr;
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsAllocateObject()) {
+        alloc = it.Current()->AsAllocateObject();
+        count++;
+      }
+    }
+  }
+  EXPECT_EQ(1, count);
+  EXPECT(alloc != nullptr);
+  EXPECT(alloc->GetBlock() != flow_graph->graph_entry()->normal_entry());
+}
+
 }  // namespace dart
@@ -137,8 +137,10 @@ const Slot& Slot::Get(const Field& field,
   }
 
   bool used_guarded_state = false;
+  // A dynamic guarded cid is always nullable unless type flow analysis
+  // proved otherwise.
   if (field.guarded_cid() != kIllegalCid &&
-      field.guarded_cid() != kDynamicCid) {
+      (field.guarded_cid() != kDynamicCid || FLAG_precompiled_mode)) {
     // Use guarded state if it is more precise then what we already have.
     if (nullable_cid == kDynamicCid) {
       nullable_cid = field.guarded_cid();
@@ -151,13 +153,18 @@ const Slot& Slot::Get(const Field& field,
     }
   }
 
+  const AbstractType* static_type =
+      &AbstractType::ZoneHandle(zone, field.type());
+  if (FLAG_precompiled_mode && field.is_inferred_int()) {
+    static_type = &Type::ZoneHandle(zone, Type::IntType());
+  }
+
   const Slot& slot = SlotCache::Instance(thread).Canonicalize(
       Slot(Kind::kDartField,
            IsImmutableBit::encode(field.is_final() || field.is_const()) |
                IsNullableBit::encode(is_nullable) |
                IsGuardedBit::encode(used_guarded_state),
-           nullable_cid, field.Offset(), &field,
-           &AbstractType::ZoneHandle(zone, field.type())));
+           nullable_cid, field.Offset(), &field, static_type));
 
   // If properties of this slot were based on the guarded state make sure
   // to add the field to the list of guarded fields. Note that during background
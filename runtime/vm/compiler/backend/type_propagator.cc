@@ -1218,6 +1218,15 @@ CompileType InstanceCallInstr::ComputeType() const {
   return CompileType::Dynamic();
 }
 
+CompileType DispatchTableCallInstr::ComputeType() const {
+  CompileType* inferred_type = result_type();
+  if ((inferred_type != NULL) &&
+      (inferred_type->ToNullableCid() != kDynamicCid)) {
+    return *inferred_type;
+  }
+  return CompileType::Dynamic();
+}
+
 CompileType PolymorphicInstanceCallInstr::ComputeType() const {
   bool is_nullable = CompileType::kNullable;
   if (IsSureToCallSingleRecognizedTarget()) {
@@ -1334,6 +1343,14 @@ CompileType LoadStaticFieldInstr::ComputeType() const {
     cid = field.guarded_cid();
     is_nullable = field.is_nullable();
     abstract_type = nullptr;  // Cid is known, calculate abstract type lazily.
+  } else if (FLAG_precompiled_mode && (field.guarded_cid() == kDynamicCid)) {
+    // Type flow analysis may still know the nullability or that the field
+    // only holds integers.
+    is_nullable = is_nullable && field.is_nullable();
+    if (field.is_inferred_int() && (cid == kDynamicCid || cid == kIllegalCid)) {
+      cid = kIllegalCid;
+      abstract_type = &Type::ZoneHandle(Type::IntType());
+    }
   }
   return CompileType(is_nullable, cid, abstract_type);
 }
@@ -445,6 +445,43 @@ ISOLATE_UNIT_TEST_CASE(IRTest_TypedDataAOT_FunctionalIndexError) {
   }
 }
 
+// This test asserts that a loop whose bound is unrelated to the length of the
+// list it indexes is versioned: a copy without the bounds check is selected
+// by a single test of the bound against the length before the loop.
+ISOLATE_UNIT_TEST_CASE(IRTest_TypedDataAOT_LoopVersioning) {
+  const char* kScript =
+      R"(
+      import 'dart:typed_data';
+
+      int foo(Uint8List list, int n) {
+        final length = list.length;
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum += list[i];
+        }
+        return sum + length;
+      }
+      )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  intptr_t bounds_checks = 0;
+  intptr_t loads = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsGenericCheckBound()) bounds_checks++;
+      if (it.Current()->IsLoadIndexed()) loads++;
+    }
+  }
+  EXPECT_EQ(2, loads);
+  EXPECT_EQ(1, bounds_checks);
+}
+
 #endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC)
 
 }  // namespace dart
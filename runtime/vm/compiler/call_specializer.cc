@@ -1828,6 +1828,81 @@ Definition* TypedDataSpecializer::AppendLoadLength(TemplateDartCall<0>* call,
   return length;
 }
 
+// Returns the initializing store of [slot] into the allocation [alloc] if
+// there is exactly one and it dominates [instr].
+static StoreInstanceFieldInstr* FindInitializingStore(Definition* alloc,
+                                                      const Slot& slot,
+                                                      Instruction* instr) {
+  StoreInstanceFieldInstr* result = nullptr;
+  for (Value::Iterator it(alloc->input_use_list()); !it.Done(); it.Advance()) {
+    StoreInstanceFieldInstr* store =
+        it.Current()->instruction()->AsStoreInstanceField();
+    if ((store != nullptr) && (store->instance()->definition() == alloc) &&
+        (&store->slot() == &slot)) {
+      if (result != nullptr) return nullptr;
+      result = store;
+    }
+  }
+  if ((result == nullptr) || !instr->IsDominatedBy(result)) {
+    return nullptr;
+  }
+  return result;
+}
+
+// Loads the address of the first element of [array]. If [array] is a view
+// allocated in this graph, the address is computed from the backing store
+// and the offset the view was created with instead of loading it from the
+// view, which leaves the view free to be eliminated by allocation sinking.
+Definition* TypedDataSpecializer::AppendLoadData(TemplateDartCall<0>* call,
+                                                 Definition* array) {
+  StoreInstanceFieldInstr* typed_data = nullptr;
+  StoreInstanceFieldInstr* offset_in_bytes = nullptr;
+  AllocateObjectInstr* alloc = array->AsAllocateObject();
+  if ((alloc != nullptr) &&
+      RawObject::IsTypedDataViewClassId(alloc->cls().id())) {
+    typed_data =
+        FindInitializingStore(alloc, Slot::TypedDataView_data(), call);
+    offset_in_bytes = FindInitializingStore(
+        alloc, Slot::TypedDataView_offset_in_bytes(), call);
+  }
+  if ((typed_data == nullptr) || (offset_in_bytes == nullptr)) {
+    auto data = new (Z) LoadUntaggedInstr(new (Z) Value(array),
+                                          TypedDataBase::data_field_offset());
+    flow_graph_->InsertBefore(call, data, call->env(), FlowGraph::kValue);
+    return data;
+  }
+
+  auto backing_data = new (Z) LoadUntaggedInstr(
+      typed_data->value()->CopyWithType(Z),
+      TypedDataBase::data_field_offset());
+  flow_graph_->InsertBefore(call, backing_data, nullptr, FlowGraph::kValue);
+  auto base = new (Z) IntConverterInstr(kUntagged, kUnboxedIntPtr,
+                                        new (Z) Value(backing_data),
+                                        DeoptId::kNone);
+  base->mark_truncating();
+  flow_graph_->InsertBefore(call, base, nullptr, FlowGraph::kValue);
+  auto offset = new (Z) UnboxIntegerInstr(
+      kUnboxedIntPtr, UnboxIntegerInstr::kNoTruncation,
+      offset_in_bytes->value()->CopyWithType(Z), DeoptId::kNone,
+      Instruction::kNotSpeculative);
+  flow_graph_->InsertBefore(call, offset, nullptr, FlowGraph::kValue);
+#if defined(TARGET_ARCH_ARM64) || defined(TARGET_ARCH_X64)
+  auto address = new (Z) BinaryInt64OpInstr(
+      Token::kADD, new (Z) Value(base), new (Z) Value(offset), DeoptId::kNone,
+      Instruction::kNotSpeculative);
+#else
+  auto address = new (Z) BinaryInt32OpInstr(
+      Token::kADD, new (Z) Value(base), new (Z) Value(offset), DeoptId::kNone);
+#endif
+  address->mark_truncating();
+  flow_graph_->InsertBefore(call, address, nullptr, FlowGraph::kValue);
+  auto data = new (Z) IntConverterInstr(kUnboxedIntPtr, kUntagged,
+                                        new (Z) Value(address), DeoptId::kNone);
+  data->mark_truncating();
+  flow_graph_->InsertBefore(call, data, nullptr, FlowGraph::kValue);
+  return data;
+}
+
 Definition* TypedDataSpecializer::AppendLoadIndexed(TemplateDartCall<0>* call,
                                                     Definition* array,
                                                     Definition* index,
@@ -1835,9 +1910,7 @@ Definition* TypedDataSpecializer::AppendLoadIndexed(TemplateDartCall<0>* call,
   const intptr_t element_size = TypedDataBase::ElementSizeFor(cid);
   const intptr_t index_scale = element_size;
 
-  auto data = new (Z) LoadUntaggedInstr(new (Z) Value(array),
-                                        TypedDataBase::data_field_offset());
-  flow_graph_->InsertBefore(call, data, call->env(), FlowGraph::kValue);
+  Definition* data = AppendLoadData(call, array);
 
   Definition* load = new (Z)
       LoadIndexedInstr(new (Z) Value(data), new (Z) Value(index), index_scale,
@@ -1912,9 +1985,7 @@ void TypedDataSpecializer::AppendStoreIndexed(TemplateDartCall<0>* call,
       break;
   }
 
-  auto data = new (Z) LoadUntaggedInstr(new (Z) Value(array),
-                                        TypedDataBase::data_field_offset());
-  flow_graph_->InsertBefore(call, data, call->env(), FlowGraph::kValue);
+  Definition* data = AppendLoadData(call, array);
 
   auto store = new (Z) StoreIndexedInstr(
       new (Z) Value(data), new (Z) Value(index), new (Z) Value(value),
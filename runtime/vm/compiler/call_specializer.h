@@ -252,6 +252,7 @@ class TypedDataSpecializer : public FlowGraphVisitor {
                          Definition* array,
                          Definition** index);
   Definition* AppendLoadLength(TemplateDartCall<0>* call, Definition* array);
+  Definition* AppendLoadData(TemplateDartCall<0>* call, Definition* array);
   Definition* AppendLoadIndexed(TemplateDartCall<0>* call,
                                 Definition* array,
                                 Definition* index,
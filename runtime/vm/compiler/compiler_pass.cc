@@ -13,13 +13,18 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
+#include "vm/compiler/backend/loops.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/call_specializer.h"
+#include "vm/compiler/write_barrier_elimination.h"
 #if defined(DART_PRECOMPILER)
 #include "vm/compiler/aot/aot_call_specializer.h"
 #endif
+#include "vm/lockers.h"
+#include "vm/os.h"
 #include "vm/timeline.h"
 
 #define COMPILER_PASS_REPEAT(Name, Body)                                       \
@@ -53,6 +58,11 @@ DEFINE_OPTION_HANDLER(CompilerPass::ParseFilters,
                       "List of comma separated compilation passes flags. "
                       "Use -Name to disable a pass, Name to print IL after it. "
                       "Do --compiler-passes=help for more information.");
+DEFINE_FLAG(bool,
+            print_compiler_pass_statistics,
+            false,
+            "Print the time spent in each compiler pass, the flow graph size "
+            "after it and the functions which were slowest to compile.");
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
 
@@ -175,7 +185,34 @@ void CompilerPass::Run(CompilerPassState* state) const {
     PrintGraph(state, kTraceBefore, round);
     {
       TIMELINE_DURATION(thread, CompilerVerbose, name());
+      int64_t start_micros = 0;
+      if (FLAG_print_compiler_pass_statistics) {
+        if (state->initial_instruction_count < 0) {
+          state->initial_instruction_count =
+              state->flow_graph->InstructionCount();
+        }
+        start_micros = OS::GetCurrentMonotonicMicros();
+      }
       repeat = DoBody(state);
+      intptr_t instruction_count = -1;
+      if (FLAG_print_compiler_pass_statistics) {
+        const int64_t micros = OS::GetCurrentMonotonicMicros() - start_micros;
+        instruction_count = state->flow_graph->InstructionCount();
+        CompilerPassStatistics::RecordPass(this, micros, instruction_count);
+        if (id() == kInlining) {
+          state->inlined_instruction_count = instruction_count;
+        }
+        state->final_instruction_count = instruction_count;
+      }
+#if defined(SUPPORT_TIMELINE)
+      if (tds.enabled()) {
+        if (instruction_count < 0) {
+          instruction_count = state->flow_graph->InstructionCount();
+        }
+        tds.SetNumArguments(1);
+        tds.FormatArgument(0, "instructions", "%" Pd, instruction_count);
+      }
+#endif  // defined(SUPPORT_TIMELINE)
       thread->CheckForSafepoint();
 #if defined(DEBUG)
       FlowGraphChecker(state->flow_graph).Check();
@@ -204,6 +241,150 @@ void CompilerPass::PrintGraph(CompilerPassState* state,
   }
 }
 
+namespace {
+
+struct PassStatistics {
+  int64_t micros;
+  intptr_t runs;
+  int64_t instructions;
+};
+
+struct FunctionStatistics {
+  char* name;
+  int64_t micros;
+  intptr_t initial_instructions;
+  intptr_t inlined_instructions;
+  intptr_t final_instructions;
+};
+
+}  // namespace
+
+static Mutex* statistics_mutex = nullptr;
+static PassStatistics pass_statistics[CompilerPass::kNumPasses];
+static MallocGrowableArray<FunctionStatistics>* function_statistics = nullptr;
+
+// The number of functions listed in each of the tables.
+static const intptr_t kTopFunctions = 20;
+
+void CompilerPassStatistics::Init() {
+  statistics_mutex = new Mutex();
+}
+
+void CompilerPassStatistics::Cleanup() {
+  PrintAndClear();
+  delete function_statistics;
+  function_statistics = nullptr;
+  delete statistics_mutex;
+  statistics_mutex = nullptr;
+}
+
+void CompilerPassStatistics::RecordPass(const CompilerPass* pass,
+                                        int64_t micros,
+                                        intptr_t instruction_count) {
+  MutexLocker ml(statistics_mutex);
+  PassStatistics* entry = &pass_statistics[pass->id()];
+  entry->micros += micros;
+  entry->runs++;
+  entry->instructions += instruction_count;
+}
+
+void CompilerPassStatistics::RecordFunction(const Function& function,
+                                            int64_t micros,
+                                            const CompilerPassState& state) {
+  FunctionStatistics entry;
+  entry.name = strdup(function.ToFullyQualifiedCString());
+  entry.micros = micros;
+  entry.initial_instructions = state.initial_instruction_count;
+  entry.inlined_instructions = state.inlined_instruction_count;
+  entry.final_instructions = state.final_instruction_count;
+
+  MutexLocker ml(statistics_mutex);
+  if (function_statistics == nullptr) {
+    function_statistics = new MallocGrowableArray<FunctionStatistics>();
+  }
+  function_statistics->Add(entry);
+}
+
+static int CompareByCompileTime(const FunctionStatistics* a,
+                                const FunctionStatistics* b) {
+  return (a->micros < b->micros) ? 1 : ((a->micros > b->micros) ? -1 : 0);
+}
+
+// The growth of a function through inlining, in instructions.
+static intptr_t InliningGrowth(const FunctionStatistics* entry) {
+  if ((entry->initial_instructions < 0) || (entry->inlined_instructions < 0)) {
+    return 0;
+  }
+  return entry->inlined_instructions - entry->initial_instructions;
+}
+
+static int CompareByInliningGrowth(const FunctionStatistics* a,
+                                   const FunctionStatistics* b) {
+  const intptr_t growth_a = InliningGrowth(a);
+  const intptr_t growth_b = InliningGrowth(b);
+  return (growth_a < growth_b) ? 1 : ((growth_a > growth_b) ? -1 : 0);
+}
+
+void CompilerPassStatistics::PrintAndClear() {
+  MutexLocker ml(statistics_mutex);
+  if ((function_statistics == nullptr) || function_statistics->is_empty()) {
+    return;
+  }
+
+  int64_t total_micros = 0;
+  for (intptr_t i = 0; i < function_statistics->length(); i++) {
+    total_micros += (*function_statistics)[i].micros;
+  }
+  OS::PrintErr("=== Compiler pass statistics\n");
+  OS::PrintErr("Compiled %" Pd " functions in %" Pd64 " ms\n",
+               function_statistics->length(), total_micros / 1000);
+  OS::PrintErr("\n%-42s %10s %8s %12s\n", "Pass", "Time (ms)", "Runs",
+               "Avg. size");
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    const PassStatistics& entry = pass_statistics[i];
+    if (entry.runs == 0) continue;
+    OS::PrintErr("%-42s %10.2f %8" Pd " %12" Pd64 "\n",
+                 CompilerPass::Get(static_cast<CompilerPass::Id>(i))->name(),
+                 entry.micros / 1000.0, entry.runs,
+                 entry.instructions / entry.runs);
+  }
+
+  const intptr_t count =
+      Utils::Minimum(kTopFunctions, function_statistics->length());
+  function_statistics->Sort(CompareByCompileTime);
+  OS::PrintErr("\nSlowest functions to compile:\n");
+  OS::PrintErr("%10s %10s %10s %10s  %s\n", "Time (ms)", "Initial",
+               "Inlined", "Final", "Function");
+  for (intptr_t i = 0; i < count; i++) {
+    const FunctionStatistics& entry = (*function_statistics)[i];
+    OS::PrintErr("%10.2f %10" Pd " %10" Pd " %10" Pd "  %s\n",
+                 entry.micros / 1000.0, entry.initial_instructions,
+                 entry.inlined_instructions, entry.final_instructions,
+                 entry.name);
+  }
+
+  function_statistics->Sort(CompareByInliningGrowth);
+  OS::PrintErr("\nFunctions which grew the most through inlining:\n");
+  OS::PrintErr("%10s %10s %10s %10s  %s\n", "Growth", "Initial", "Inlined",
+               "Time (ms)", "Function");
+  for (intptr_t i = 0; i < count; i++) {
+    const FunctionStatistics& entry = (*function_statistics)[i];
+    if (InliningGrowth(&entry) <= 0) break;
+    OS::PrintErr("%10" Pd " %10" Pd " %10" Pd " %10.2f  %s\n",
+                 InliningGrowth(&entry), entry.initial_instructions,
+                 entry.inlined_instructions, entry.micros / 1000.0,
+                 entry.name);
+  }
+
+  for (intptr_t i = 0; i < function_statistics->length(); i++) {
+    free((*function_statistics)[i].name);
+  }
+  function_statistics->Clear();
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    pass_statistics[i] = PassStatistics();
+  }
+}
+
 #define INVOKE_PASS(Name)                                                      \
   CompilerPass::Get(CompilerPass::k##Name)->Run(pass_state);
 
@@ -269,6 +450,8 @@ void CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(RangeAnalysis);
   INVOKE_PASS(OptimizeBranches);
+  INVOKE_PASS(LoopVectorization);
+  INVOKE_PASS(LoopStrengthReduction);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(TryCatchOptimization);
   INVOKE_PASS(EliminateEnvironments);
@@ -389,6 +572,18 @@ COMPILER_PASS(OptimizeBranches, {
   ConstantPropagator::OptimizeBranches(flow_graph);
 });
 
+COMPILER_PASS(LoopStrengthReduction, {
+  // Runs after range analysis, which reasons about the original
+  // multiplications when eliminating bounds checks.
+  LoopStrengthReduction::Optimize(flow_graph);
+});
+
+COMPILER_PASS(LoopVectorization, {
+  // Runs after range analysis and branch optimization, which remove the
+  // bounds checks that would otherwise keep loops from being vectorized.
+  LoopVectorizer::Optimize(flow_graph);
+});
+
 COMPILER_PASS(OptimizeTypedDataAccesses,
               { TypedDataSpecializer::Optimize(flow_graph); });
 
@@ -441,37 +636,8 @@ COMPILER_PASS(ReorderBlocks, {
   }
 });
 
-static void WriteBarrierElimination(FlowGraph* flow_graph) {
-  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
-       !block_it.Done(); block_it.Advance()) {
-    BlockEntryInstr* block = block_it.Current();
-    Definition* last_allocated = nullptr;
-    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
-      Instruction* current = it.Current();
-      if (StoreInstanceFieldInstr* instr = current->AsStoreInstanceField()) {
-        if (!current->CanTriggerGC()) {
-          if (instr->instance()->definition() == last_allocated) {
-            instr->set_emit_store_barrier(kNoStoreBarrier);
-          }
-          continue;
-        }
-      }
-
-      AllocationInstr* alloc = current->AsAllocation();
-      if (alloc != nullptr && alloc->WillAllocateNewOrRemembered()) {
-        last_allocated = alloc;
-        continue;
-      }
-
-      if (current->CanTriggerGC()) {
-        last_allocated = nullptr;
-      }
-    }
-  }
-}
-
 COMPILER_PASS(WriteBarrierElimination,
-              { WriteBarrierElimination(flow_graph); });
+              { EliminateWriteBarriers(flow_graph); });
 
 COMPILER_PASS(FinalizeGraph, {
   // Compute and store graph informations (call & instruction counts)
@@ -9,6 +9,7 @@
 
 #include <initializer_list>
 
+#include "vm/allocation.h"
 #include "vm/growable_array.h"
 #include "vm/token_position.h"
 #include "vm/zone.h"
@@ -35,6 +36,8 @@ namespace dart {
   V(IfConvert)                                                                 \
   V(Inlining)                                                                  \
   V(LICM)                                                                      \
+  V(LoopStrengthReduction)                                                     \
+  V(LoopVectorization)                                                         \
   V(OptimisticallySpecializeSmiPhis)                                           \
   V(OptimizeBranches)                                                          \
   V(OptimizeTypedDataAccesses)                                                 \
@@ -72,7 +75,10 @@ struct CompilerPassState {
         speculative_policy(speculative_policy),
         reorder_blocks(false),
         block_scheduler(NULL),
-        sticky_flags(0) {
+        sticky_flags(0),
+        initial_instruction_count(-1),
+        inlined_instruction_count(-1),
+        final_instruction_count(-1) {
   }
 
   Thread* const thread;
@@ -97,6 +103,12 @@ struct CompilerPassState {
   BlockScheduler* block_scheduler;
 
   intptr_t sticky_flags;
+
+  // Size of the flow graph before the first pass, after inlining and after
+  // the last pass, collected for --print_compiler_pass_statistics.
+  intptr_t initial_instruction_count;
+  intptr_t inlined_instruction_count;
+  intptr_t final_instruction_count;
 };
 
 class CompilerPass {
@@ -111,7 +123,7 @@ class CompilerPass {
   static const intptr_t kNumPasses = 0 COMPILER_PASS_LIST(ADD_ONE);
 #undef ADD_ONE
 
-  CompilerPass(Id id, const char* name) : name_(name), flags_(0) {
+  CompilerPass(Id id, const char* name) : id_(id), name_(name), flags_(0) {
     ASSERT(passes_[id] == NULL);
     passes_[id] = this;
 
@@ -132,6 +144,7 @@ class CompilerPass {
 
   void Run(CompilerPassState* state) const;
 
+  Id id() const { return id_; }
   intptr_t flags() const { return flags_; }
   const char* name() const { return name_; }
 
@@ -173,10 +186,37 @@ class CompilerPass {
 
   static CompilerPass* passes_[];
 
+  const Id id_;
   const char* name_;
   intptr_t flags_;
 };
 
+// Compile time and IR size statistics of the optimizing compiler, collected
+// for all isolates with --print_compiler_pass_statistics: the wall time of
+// each pass and the flow graph size after it, and the functions which took
+// longest to compile or grew the most through inlining.
+//
+// The JIT prints the statistics when the VM shuts down, gen_snapshot when
+// precompilation is done.
+class CompilerPassStatistics : public AllStatic {
+ public:
+  static void Init();
+  // Prints the statistics which were not printed yet.
+  static void Cleanup();
+
+  static void RecordPass(const CompilerPass* pass,
+                         int64_t micros,
+                         intptr_t instruction_count);
+
+  // Called after [function] was compiled with optimizations in [micros].
+  static void RecordFunction(const Function& function,
+                             int64_t micros,
+                             const CompilerPassState& state);
+
+  // Prints the statistics collected so far, if any, and clears them.
+  static void PrintAndClear();
+};
+
 }  // namespace dart
 
 #endif
@@ -8,6 +8,7 @@
 
 #include "platform/globals.h"
 #include "vm/compiler/runtime_api.h"
+#include "vm/symbols.h"
 
 namespace dart {
 
@@ -49,6 +50,37 @@ size_t ElementSizeInBytes(intptr_t class_id) {
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
+classid_t ElementTypedDataCid(classid_t class_id) {
+  switch (class_id) {
+    case kFfiInt8Cid:
+      return kTypedDataInt8ArrayCid;
+    case kFfiInt16Cid:
+      return kTypedDataInt16ArrayCid;
+    case kFfiInt32Cid:
+      return kTypedDataInt32ArrayCid;
+    case kFfiInt64Cid:
+      return kTypedDataInt64ArrayCid;
+    case kFfiUint8Cid:
+      return kTypedDataUint8ArrayCid;
+    case kFfiUint16Cid:
+      return kTypedDataUint16ArrayCid;
+    case kFfiUint32Cid:
+      return kTypedDataUint32ArrayCid;
+    case kFfiUint64Cid:
+      return kTypedDataUint64ArrayCid;
+    case kFfiIntPtrCid:
+      return target::kWordSize == 4 ? kTypedDataInt32ArrayCid
+                                    : kTypedDataInt64ArrayCid;
+    case kFfiFloatCid:
+      return kTypedDataFloat32ArrayCid;
+    case kFfiDoubleCid:
+      return kTypedDataFloat64ArrayCid;
+    default:
+      UNREACHABLE();
+      return kIllegalCid;
+  }
+}
+
 Representation TypeRepresentation(const AbstractType& result_type) {
   switch (result_type.type_class_id()) {
     case kFfiFloatCid:
@@ -108,6 +140,7 @@ bool NativeTypeIsPointer(const AbstractType& result_type) {
     case kFfiInt64Cid:
     case kFfiUint64Cid:
     case kFfiIntPtrCid:
+    case kFfiByValueCid:
       return false;
     case kFfiPointerCid:
     default:
@@ -115,6 +148,156 @@ bool NativeTypeIsPointer(const AbstractType& result_type) {
   }
 }
 
+bool NativeTypeIsStruct(const AbstractType& type) {
+  return type.type_class_id() == kFfiByValueCid;
+}
+
+classid_t StructPieceTypedDataCid(intptr_t size) {
+  switch (size) {
+    case 1:
+      return kTypedDataUint8ArrayCid;
+    case 2:
+      return kTypedDataUint16ArrayCid;
+    case 4:
+      return kTypedDataUint32ArrayCid;
+    case 8:
+      return kTypedDataInt64ArrayCid;
+    default:
+      UNREACHABLE();
+      return kIllegalCid;
+  }
+}
+
+// The representation a piece of a struct is loaded with from its typed data
+// class.
+static Representation StructPieceRepresentation(intptr_t size) {
+  return size == 4 ? kUnboxedUint32 : kUnboxedInt64;
+}
+
+static bool IsStructPieceSize(intptr_t size) {
+  return size == 1 || size == 2 || size == 4 || size == 8;
+}
+
+// A field of a struct passed or returned by value.
+struct StructField {
+  classid_t cid;
+  intptr_t offset;
+  intptr_t size;
+};
+
+// A piece of a struct passed or returned by value, which travels in a single
+// register or stack slot.
+struct StructPiece {
+  intptr_t offset;
+  intptr_t size;
+  bool is_fpu;
+};
+
+// Lays out the struct 'T' of the type 'ffi.ByValue<T>' the way C does, from
+// the native types of its fields which the kernel FFI transformation records
+// on it. Returns the size of the struct, or 0 if its fields are unknown.
+static intptr_t LayOutStruct(const AbstractType& type,
+                             GrowableArray<StructField>* fields) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const TypeArguments& type_args =
+      TypeArguments::Handle(zone, type.arguments());
+  if (type_args.IsNull() || type_args.Length() != 1) return 0;
+  const AbstractType& struct_type =
+      AbstractType::Handle(zone, type_args.TypeAt(0));
+  if (!struct_type.HasTypeClass()) return 0;
+  const Class& struct_class = Class::Handle(zone, struct_type.type_class());
+  const Library& library = Library::Handle(zone, struct_class.library());
+  Object& options = Object::Handle(zone);
+  if (!library.FindPragma(thread, struct_class,
+                          Symbols::vm_ffi_struct_fields(), &options) ||
+      !options.IsArray()) {
+    return 0;
+  }
+
+  const Array& field_types = Array::Cast(options);
+  AbstractType& field_type = AbstractType::Handle(zone);
+  intptr_t offset = 0;
+  intptr_t alignment = 1;
+  for (intptr_t i = 0; i < field_types.Length(); i++) {
+    field_type ^= field_types.At(i);
+    StructField field;
+    field.cid = field_type.type_class_id();
+    field.size = ElementSizeInBytes(field.cid);
+    if (!RawObject::IsFfiTypeIntClassId(field.cid) &&
+        !RawObject::IsFfiTypeDoubleClassId(field.cid)) {
+      field.cid = kFfiPointerCid;
+    }
+    offset = Utils::RoundUp(offset, field.size);
+    field.offset = offset;
+    offset += field.size;
+    alignment = Utils::Maximum<intptr_t>(alignment, field.size);
+    fields->Add(field);
+  }
+  return Utils::RoundUp(offset, alignment);
+}
+
+// Splits a struct into word sized pieces. With 'classify', a piece goes into
+// an FPU register if all the fields in it are floating point, as in the
+// System V ABI.
+static bool SplitStructIntoWords(const GrowableArray<StructField>& fields,
+                                 intptr_t size,
+                                 bool classify,
+                                 GrowableArray<StructPiece>* pieces) {
+  for (intptr_t offset = 0; offset < size; offset += target::kWordSize) {
+    StructPiece piece;
+    piece.offset = offset;
+    piece.size = Utils::Minimum<intptr_t>(target::kWordSize, size - offset);
+    if (!IsStructPieceSize(piece.size)) return false;
+    piece.is_fpu = classify;
+    for (intptr_t i = 0; i < fields.length(); i++) {
+      if (fields[i].offset < offset + piece.size &&
+          fields[i].offset + fields[i].size > offset &&
+          !RawObject::IsFfiTypeDoubleClassId(fields[i].cid)) {
+        piece.is_fpu = false;
+      }
+    }
+    pieces->Add(piece);
+  }
+  return true;
+}
+
+#if defined(TARGET_ARCH_ARM64)
+// Whether a struct is a homogeneous floating-point aggregate of the AAPCS64:
+// one to four fields which are all floats or all doubles.
+static bool IsHomogeneousFloatAggregate(
+    const GrowableArray<StructField>& fields) {
+  if (fields.length() < 1 || fields.length() > 4) return false;
+  for (intptr_t i = 0; i < fields.length(); i++) {
+    if (!RawObject::IsFfiTypeDoubleClassId(fields[i].cid) ||
+        fields[i].cid != fields[0].cid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Splits a homogeneous floating-point aggregate into one piece per field.
+static void SplitStructIntoFields(const GrowableArray<StructField>& fields,
+                                  GrowableArray<StructPiece>* pieces) {
+  for (intptr_t i = 0; i < fields.length(); i++) {
+    StructPiece piece = {fields[i].offset, fields[i].size, true};
+    pieces->Add(piece);
+  }
+}
+#endif  // defined(TARGET_ARCH_ARM64)
+
+// The representation an argument of an FFI type is passed in.
+static Representation ArgumentRepresentation(const AbstractType& arg_type) {
+  Representation rep = TypeRepresentation(arg_type);
+  if (rep == kUnboxedFloat && CallingConventions::kAbiSoftFP) {
+    rep = kUnboxedInt32;
+  } else if (rep == kUnboxedDouble && CallingConventions::kAbiSoftFP) {
+    rep = kUnboxedInt64;
+  }
+  return rep;
+}
+
 // Converts a Ffi [signature] to a list of Representations.
 // Note that this ignores first argument (receiver) which is dynamic.
 ZoneGrowableArray<Representation>* ArgumentRepresentations(
@@ -124,13 +307,7 @@ ZoneGrowableArray<Representation>* ArgumentRepresentations(
   for (intptr_t i = 0; i < num_arguments; i++) {
     AbstractType& arg_type =
         AbstractType::Handle(signature.ParameterTypeAt(i + 1));
-    Representation rep = TypeRepresentation(arg_type);
-    if (rep == kUnboxedFloat && CallingConventions::kAbiSoftFP) {
-      rep = kUnboxedInt32;
-    } else if (rep == kUnboxedDouble && CallingConventions::kAbiSoftFP) {
-      rep = kUnboxedInt64;
-    }
-    result->Add(rep);
+    result->Add(ArgumentRepresentation(arg_type));
   }
   return result;
 }
@@ -171,7 +348,102 @@ class ArgumentFrameState : public ValueObject {
     }
   }
 
+  // Allocates the pieces a struct passed by value is split into, either all
+  // in registers or, if there are not enough of them left, all on the stack.
+  // Returns false if the native ABI would pass the struct by reference to a
+  // copy instead, which is not supported.
+  bool AllocateStruct(const GrowableArray<StructField>& fields,
+                      intptr_t size,
+                      GrowableArray<StructPiece>* pieces,
+                      ZoneGrowableArray<Location>* locations) {
+#if defined(TARGET_ARCH_X64) && !defined(_WIN64)
+    // Structs of up to 16 bytes go in registers by the classes of their
+    // eightbytes, larger ones in memory on the stack.
+    if (size <= 2 * target::kWordSize) {
+      if (!SplitStructIntoWords(fields, size, /*classify=*/true, pieces)) {
+        return false;
+      }
+      if (AllocateRegisterPieces(*pieces, locations)) return true;
+      pieces->Clear();
+    }
+    if (!SplitStructIntoWords(fields, size, /*classify=*/false, pieces)) {
+      return false;
+    }
+    AllocateStackPieces(*pieces, locations);
+    return true;
+#elif defined(TARGET_ARCH_X64)
+    // Structs of 1, 2, 4 or 8 bytes are passed like integers, all others by
+    // reference.
+    if (!IsStructPieceSize(size)) return false;
+    StructPiece piece = {0, size, false};
+    pieces->Add(piece);
+    locations->Add(AllocateArgument(kUnboxedInt64));
+    return true;
+#elif defined(TARGET_ARCH_ARM64)
+    // Homogeneous floating-point aggregates go in consecutive FPU registers and
+    // other structs of up to 16 bytes in consecutive CPU registers. Once one
+    // does not fit, no more registers of its kind are used, and it goes on the
+    // stack. Larger structs are passed by reference.
+    if (IsHomogeneousFloatAggregate(fields)) {
+      SplitStructIntoFields(fields, pieces);
+      if (AllocateRegisterPieces(*pieces, locations)) return true;
+      fpu_regs_used = CallingConventions::kNumFpuArgRegs;
+      pieces->Clear();
+    } else if (size <= 2 * target::kWordSize) {
+      if (!SplitStructIntoWords(fields, size, /*classify=*/false, pieces)) {
+        return false;
+      }
+      if (AllocateRegisterPieces(*pieces, locations)) return true;
+      cpu_regs_used = CallingConventions::kNumArgRegs;
+      pieces->Clear();
+    } else {
+      return false;
+    }
+    if (!SplitStructIntoWords(fields, size, /*classify=*/false, pieces)) {
+      return false;
+    }
+    AllocateStackPieces(*pieces, locations);
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Allocates the stack slot for the address a struct is returned into, after
+  // all the arguments.
+  Location AllocateResultAddressSlot() { return AllocateStackSlot(); }
+
  private:
+  // Allocates a register for each piece, unless there are too few left.
+  bool AllocateRegisterPieces(const GrowableArray<StructPiece>& pieces,
+                              ZoneGrowableArray<Location>* locations) {
+    intptr_t num_cpu = 0;
+    intptr_t num_fpu = 0;
+    for (intptr_t i = 0; i < pieces.length(); i++) {
+      if (pieces[i].is_fpu) {
+        num_fpu++;
+      } else {
+        num_cpu++;
+      }
+    }
+    if (cpu_regs_used + num_cpu > CallingConventions::kNumArgRegs ||
+        fpu_regs_used + num_fpu > CallingConventions::kNumFpuArgRegs) {
+      return false;
+    }
+    for (intptr_t i = 0; i < pieces.length(); i++) {
+      locations->Add(pieces[i].is_fpu ? AllocateFpuRegister()
+                                      : AllocateCpuRegister());
+    }
+    return true;
+  }
+
+  void AllocateStackPieces(const GrowableArray<StructPiece>& pieces,
+                           ZoneGrowableArray<Location>* locations) {
+    for (intptr_t i = 0; i < pieces.length(); i++) {
+      locations->Add(AllocateStackSlot());
+    }
+  }
+
   Location AllocateStackSlot() {
     return Location::StackSlot(stack_height_in_slots++, SPREG);
   }
@@ -295,6 +567,138 @@ Location ResultLocation(Representation result_rep) {
   }
 }
 
+// Decides how a struct is returned by value, or returns nullptr if the native
+// ABI does not allow it.
+static StructResult* ReturnStruct(const GrowableArray<StructField>& fields,
+                                  intptr_t size) {
+#if defined(TARGET_ARCH_X64) && !defined(_WIN64)
+  // Structs of up to 16 bytes come back in RAX and RDX or XMM0 and XMM1 by
+  // the classes of their eightbytes, larger ones in memory.
+  if (size > 2 * target::kWordSize) {
+    return new StructResult(size, /*in_memory=*/true);
+  }
+  GrowableArray<StructPiece> pieces;
+  if (!SplitStructIntoWords(fields, size, /*classify=*/true, &pieces)) {
+    return nullptr;
+  }
+  const Register cpu_regs[] = {RAX, RDX};
+  const FpuRegister fpu_regs[] = {XMM0, XMM1};
+  intptr_t cpu_regs_used = 0;
+  intptr_t fpu_regs_used = 0;
+  StructResult* result = new StructResult(size, /*in_memory=*/false);
+  for (intptr_t i = 0; i < pieces.length(); i++) {
+    result->AddPiece(
+        pieces[i].is_fpu
+            ? Location::FpuRegisterLocation(fpu_regs[fpu_regs_used++])
+            : Location::RegisterLocation(cpu_regs[cpu_regs_used++]),
+        pieces[i].offset, pieces[i].size);
+  }
+  return result;
+#elif defined(TARGET_ARCH_X64)
+  // Structs of 1, 2, 4 or 8 bytes come back in RAX, all others in memory.
+  if (!IsStructPieceSize(size)) {
+    return new StructResult(size, /*in_memory=*/true);
+  }
+  StructResult* result = new StructResult(size, /*in_memory=*/false);
+  result->AddPiece(Location::RegisterLocation(RAX), 0, size);
+  return result;
+#elif defined(TARGET_ARCH_ARM64)
+  // Homogeneous floating-point aggregates come back in V0 to V3, other
+  // structs of up to 16 bytes in R0 and R1, larger ones in memory.
+  GrowableArray<StructPiece> pieces;
+  if (IsHomogeneousFloatAggregate(fields)) {
+    SplitStructIntoFields(fields, &pieces);
+  } else if (size > 2 * target::kWordSize) {
+    return new StructResult(size, /*in_memory=*/true);
+  } else if (!SplitStructIntoWords(fields, size, /*classify=*/false,
+                                   &pieces)) {
+    return nullptr;
+  }
+  intptr_t cpu_regs_used = 0;
+  intptr_t fpu_regs_used = 0;
+  StructResult* result = new StructResult(size, /*in_memory=*/false);
+  for (intptr_t i = 0; i < pieces.length(); i++) {
+    result->AddPiece(
+        pieces[i].is_fpu
+            ? Location::FpuRegisterLocation(
+                  static_cast<FpuRegister>(V0 + fpu_regs_used++))
+            : Location::RegisterLocation(
+                  static_cast<Register>(R0 + cpu_regs_used++)),
+        pieces[i].offset, pieces[i].size);
+  }
+  return result;
+#else
+  return nullptr;
+#endif
+}
+
+NativeCallLayout* NativeCallLayout::New(Zone* zone,
+                                        const Function& signature,
+                                        const char** error) {
+  NativeCallLayout* layout = new (zone) NativeCallLayout();
+  ArgumentFrameState frame_state;
+  GrowableArray<StructField> fields;
+  GrowableArray<StructPiece> pieces;
+
+  AbstractType& type = AbstractType::Handle(zone, signature.result_type());
+  Location result_address;
+  if (NativeTypeIsStruct(type)) {
+    const intptr_t size = LayOutStruct(type, &fields);
+    layout->struct_result_ = size == 0 ? nullptr : ReturnStruct(fields, size);
+    if (layout->struct_result_ == nullptr) {
+      *error = "Structs cannot be returned by value on this platform.";
+      return nullptr;
+    }
+#if defined(TARGET_ARCH_X64)
+    // The callee gets the address to return the struct into in the register
+    // of the first argument.
+    if (layout->struct_result_->in_memory()) {
+      result_address = frame_state.AllocateArgument(kUnboxedFfiIntPtr);
+    }
+#endif
+  }
+
+  const intptr_t num_arguments = signature.num_fixed_parameters() - 1;
+  for (intptr_t i = 0; i < num_arguments; i++) {
+    layout->first_.Add(layout->locations_->length());
+    type = signature.ParameterTypeAt(i + 1);
+    if (!NativeTypeIsStruct(type)) {
+      const Representation rep = ArgumentRepresentation(type);
+      layout->representations_->Add(rep);
+      layout->locations_->Add(frame_state.AllocateArgument(rep));
+      layout->offsets_.Add(-1);
+      layout->sizes_.Add(0);
+      continue;
+    }
+    fields.Clear();
+    pieces.Clear();
+    const intptr_t size = LayOutStruct(type, &fields);
+    if (size == 0 || !frame_state.AllocateStruct(fields, size, &pieces,
+                                                 layout->locations_)) {
+      *error = "Structs of this size and layout cannot be passed by value on "
+               "this platform.";
+      return nullptr;
+    }
+    for (intptr_t j = 0; j < pieces.length(); j++) {
+      layout->representations_->Add(StructPieceRepresentation(pieces[j].size));
+      layout->offsets_.Add(pieces[j].offset);
+      layout->sizes_.Add(pieces[j].size);
+    }
+  }
+  layout->first_.Add(layout->locations_->length());
+
+  if (layout->struct_result_ != nullptr) {
+    if (result_address.IsInvalid()) {
+      result_address = frame_state.AllocateResultAddressSlot();
+    }
+    layout->representations_->Add(kUnboxedFfiIntPtr);
+    layout->locations_->Add(result_address);
+    layout->offsets_.Add(-1);
+    layout->sizes_.Add(0);
+  }
+  return layout;
+}
+
 // Accounts for alignment, where some stack slots are used as padding.
 intptr_t NumStackSlots(const ZoneGrowableArray<Location>& locations) {
   intptr_t num_arguments = locations.length();
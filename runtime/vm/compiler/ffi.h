@@ -25,6 +25,11 @@ constexpr intptr_t kMinimumArgumentWidth = 4;
 // Storage size for an FFI type (extends 'ffi.NativeType').
 size_t ElementSizeInBytes(intptr_t class_id);
 
+// The typed data class whose elements have the same layout as an FFI type
+// (extends 'ffi.NativeType'), used to access native memory with
+// LoadIndexed and StoreIndexed.
+classid_t ElementTypedDataCid(classid_t class_id);
+
 // Unboxed representation of an FFI type (extends 'ffi.NativeType').
 Representation TypeRepresentation(const AbstractType& result_type);
 
@@ -38,6 +43,100 @@ bool NativeTypeIsPointer(const AbstractType& result_type);
 // Whether a type is 'ffi.Void'.
 bool NativeTypeIsVoid(const AbstractType& result_type);
 
+// Whether a type is 'ffi.ByValue', a struct passed or returned by value.
+bool NativeTypeIsStruct(const AbstractType& type);
+
+// How a struct returned by value gets into the memory its caller allocates
+// for it. Either the callee writes it there itself, given the address of the
+// memory as a hidden argument, or it returns the struct in pieces in its
+// return registers, which the caller then stores.
+class StructResult : public ZoneAllocated {
+ public:
+  StructResult(intptr_t size, bool in_memory)
+      : size_(size), in_memory_(in_memory) {}
+
+  intptr_t size() const { return size_; }
+  bool in_memory() const { return in_memory_; }
+
+  // The return registers holding the pieces of a struct which is not
+  // returned in memory, and the bytes of the struct each one holds.
+  intptr_t NumPieces() const { return locations_.length(); }
+  Location PieceLocation(intptr_t i) const { return locations_[i]; }
+  intptr_t PieceOffset(intptr_t i) const { return offsets_[i]; }
+  intptr_t PieceSize(intptr_t i) const { return sizes_[i]; }
+
+  void AddPiece(Location location, intptr_t offset, intptr_t size) {
+    locations_.Add(location);
+    offsets_.Add(offset);
+    sizes_.Add(size);
+  }
+
+ private:
+  const intptr_t size_;
+  const bool in_memory_;
+  GrowableArray<Location> locations_;
+  GrowableArray<intptr_t> offsets_;
+  GrowableArray<intptr_t> sizes_;
+};
+
+// The native arguments a C signature function is called with, in the order of
+// its Dart arguments. Primitives and pointers take one native argument each.
+// A struct passed by value is split into pieces of at most a word, which each
+// take one native argument in a register or stack slot, as the native ABI
+// prescribes. The pieces are always integers: those which go into FPU
+// registers are moved there just before the call.
+//
+// A struct returned by value adds one last native argument, the address of the
+// memory it is returned into.
+class NativeCallLayout : public ZoneAllocated {
+ public:
+  // Returns nullptr and sets '*error' if the native ABI does not allow one of
+  // the structs in 'signature' to be passed or returned by value.
+  static NativeCallLayout* New(Zone* zone,
+                               const Function& signature,
+                               const char** error);
+
+  const ZoneGrowableArray<Representation>& representations() const {
+    return *representations_;
+  }
+  const ZoneGrowableArray<Location>& locations() const { return *locations_; }
+
+  // The native arguments the Dart argument 'index' (not counting the
+  // receiver) is passed in: 'NumNativeArguments(index)' of them, starting
+  // at 'FirstNativeArgument(index)'.
+  intptr_t FirstNativeArgument(intptr_t index) const { return first_[index]; }
+  intptr_t NumNativeArguments(intptr_t index) const {
+    return first_[index + 1] - first_[index];
+  }
+
+  // The bytes of its struct a piece of a struct passed by value holds.
+  intptr_t PieceOffset(intptr_t native_index) const {
+    return offsets_[native_index];
+  }
+  intptr_t PieceSize(intptr_t native_index) const {
+    return sizes_[native_index];
+  }
+
+  // Null unless the result is a struct returned by value.
+  const StructResult* struct_result() const { return struct_result_; }
+
+ private:
+  NativeCallLayout()
+      : representations_(new ZoneGrowableArray<Representation>()),
+        locations_(new ZoneGrowableArray<Location>()),
+        struct_result_(nullptr) {}
+
+  ZoneGrowableArray<Representation>* representations_;
+  ZoneGrowableArray<Location>* locations_;
+  GrowableArray<intptr_t> first_;
+  GrowableArray<intptr_t> offsets_;
+  GrowableArray<intptr_t> sizes_;
+  StructResult* struct_result_;
+};
+
+// The typed data class to load a piece of a struct of 'size' bytes with.
+classid_t StructPieceTypedDataCid(intptr_t size);
+
 // Unboxed representation of the result of a C signature function.
 Representation ResultRepresentation(const Function& signature);
 
@@ -338,6 +338,16 @@ Fragment BaseFlowGraphBuilder::LoadIndexed(intptr_t index_scale) {
   return Fragment(instr);
 }
 
+Fragment BaseFlowGraphBuilder::LoadIndexedTypedData(classid_t class_id) {
+  Value* index = Pop();
+  Value* array = Pop();
+  LoadIndexedInstr* instr = new (Z) LoadIndexedInstr(
+      array, index, Instance::ElementSizeFor(class_id), class_id,
+      kAlignedAccess, DeoptId::kNone, TokenPosition::kNoSource);
+  Push(instr);
+  return Fragment(instr);
+}
+
 Fragment BaseFlowGraphBuilder::LoadUntagged(intptr_t offset) {
   Value* object = Pop();
   auto load = new (Z) LoadUntaggedInstr(object, offset);
@@ -385,6 +395,21 @@ Fragment BaseFlowGraphBuilder::AddIntptrIntegers() {
   return Fragment(add);
 }
 
+Fragment BaseFlowGraphBuilder::MultiplyIntptrIntegers() {
+  Value* right = Pop();
+  Value* left = Pop();
+#if defined(TARGET_ARCH_ARM64) || defined(TARGET_ARCH_X64)
+  auto mul = new (Z) BinaryInt64OpInstr(
+      Token::kMUL, left, right, DeoptId::kNone, Instruction::kNotSpeculative);
+#else
+  auto mul =
+      new (Z) BinaryInt32OpInstr(Token::kMUL, left, right, DeoptId::kNone);
+#endif
+  mul->mark_truncating();
+  Push(mul);
+  return Fragment(mul);
+}
+
 Fragment BaseFlowGraphBuilder::UnboxSmiToIntptr() {
   Value* value = Pop();
   auto untagged = new (Z)
@@ -135,6 +135,7 @@ class BaseFlowGraphBuilder {
   Fragment LoadField(const Field& field);
   Fragment LoadNativeField(const Slot& native_field);
   Fragment LoadIndexed(intptr_t index_scale);
+  Fragment LoadIndexedTypedData(classid_t class_id);
 
   Fragment LoadUntagged(intptr_t offset);
   Fragment StoreUntagged(intptr_t offset);
@@ -143,6 +144,7 @@ class BaseFlowGraphBuilder {
   Fragment UnboxSmiToIntptr();
 
   Fragment AddIntptrIntegers();
+  Fragment MultiplyIntptrIntegers();
 
   void SetTempIndex(Definition* definition);
 
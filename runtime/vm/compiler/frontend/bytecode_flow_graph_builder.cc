@@ -791,22 +791,20 @@ void BytecodeFlowGraphBuilder::BuildInterfaceCallCommon(
   const String& name = String::ZoneHandle(Z, interface_target.name());
   ASSERT(name.IsSymbol());
 
-  const Array& arg_desc_array =
-      Array::Cast(ConstantAt(DecodeOperandD(), 1).value());
-  const ArgumentsDescriptor arg_desc(arg_desc_array);
+  // The inline cache of the call site is shared with the interpreter, so
+  // the call starts with the receiver classes seen while interpreting.
+  const ICData& icdata = ICData::Cast(ConstantAt(DecodeOperandD(), 1).value());
+  ASSERT(ic_data_array_->At(icdata.deopt_id())->Original() == icdata.raw());
+  ASSERT(icdata.target_name() == name.raw());
+
+  const ArgumentsDescriptor arg_desc(
+      Array::Handle(Z, icdata.arguments_descriptor()));
 
   const intptr_t argc = DecodeOperandA().value();
   Token::Kind token_kind = MethodTokenRecognizer::RecognizeTokenKind(name);
-
-  intptr_t checked_argument_count = 1;
-  if ((token_kind != Token::kILLEGAL) ||
+  if ((token_kind == Token::kILLEGAL) &&
       (name.raw() ==
-       Library::PrivateCoreLibName(Symbols::_simpleInstanceOf()).raw())) {
-    intptr_t argument_count = arg_desc.Count();
-    ASSERT(argument_count <= 2);
-    checked_argument_count = argument_count;
-  } else if (name.raw() ==
-             Library::PrivateCoreLibName(Symbols::_instanceOf()).raw()) {
+       Library::PrivateCoreLibName(Symbols::_instanceOf()).raw())) {
     token_kind = Token::kIS;
   }
 
@@ -814,8 +812,11 @@ void BytecodeFlowGraphBuilder::BuildInterfaceCallCommon(
 
   InstanceCallInstr* call = new (Z) InstanceCallInstr(
       position_, name, token_kind, arguments, arg_desc.TypeArgsLen(),
-      Array::ZoneHandle(Z, arg_desc.GetArgumentNames()), checked_argument_count,
-      *ic_data_array_, B->GetNextDeoptId(), interface_target);
+      Array::ZoneHandle(Z, arg_desc.GetArgumentNames()), icdata.NumArgsTested(),
+      *ic_data_array_, icdata.deopt_id(), interface_target);
+
+  ASSERT(call->ic_data() != nullptr);
+  ASSERT(call->ic_data()->Original() == icdata.raw());
 
   // TODO(alexmarkov): add type info - call->SetResultType()
 
@@ -918,6 +919,10 @@ void BytecodeFlowGraphBuilder::BuildNativeCall() {
       code_ += B->LoadNativeField(Slot::GrowableObjectArray_data());
       code_ += B->LoadNativeField(Slot::Array_length());
       break;
+    case MethodRecognizer::kGrowableArrayData:
+      ASSERT((function().NumParameters() == 1) && !function().IsGeneric());
+      code_ += B->LoadNativeField(Slot::GrowableObjectArray_data());
+      break;
     case MethodRecognizer::kListFactory: {
       ASSERT((function().NumParameters() == 2) && !function().IsGeneric() &&
              function().HasOptionalParameters());
@@ -12,6 +12,7 @@
 #include "vm/compiler/frontend/bytecode_scope_builder.h"
 #include "vm/constants_kbc.h"
 #include "vm/dart_entry.h"
+#include "vm/interpreter.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
 #include "vm/reusable_handles.h"
@@ -668,8 +669,27 @@ void BytecodeReaderHelper::ReadConstantPool(const Function& function,
         pool.SetObjectAt(i, elem);
         ++i;
         ASSERT(i < obj_count);
-        // The second entry is used for arguments descriptor.
-        obj = ReadObject();
+        // The second entry is used for the inline cache of the call site,
+        // which holds the arguments descriptor.
+        array ^= ReadObject();
+        name = Function::Cast(elem).name();
+        if (simpleInstanceOf == nullptr) {
+          simpleInstanceOf =
+              &Library::PrivateCoreLibName(Symbols::_simpleInstanceOf());
+        }
+        intptr_t checked_argument_count = 1;
+        if ((MethodTokenRecognizer::RecognizeTokenKind(name) !=
+             Token::kILLEGAL) ||
+            (name.raw() == simpleInstanceOf->raw())) {
+          intptr_t argument_count = ArgumentsDescriptor(array).Count();
+          ASSERT(argument_count <= 2);
+          checked_argument_count = argument_count;
+        }
+        obj =
+            ICData::New(function, name,
+                        array,  // Arguments descriptor.
+                        H.thread()->compiler_state().GetNextDeoptId(),
+                        checked_argument_count, ICData::RebindRule::kInstance);
       } break;
       default:
         UNREACHABLE();
@@ -690,9 +710,11 @@ RawBytecode* BytecodeReaderHelper::ReadBytecode(const ObjectPool& pool) {
   const uint8_t* data = helper_->reader_.BufferAt(offset);
   ASSERT(Utils::IsAligned(data, sizeof(KBCInstr)));
   helper_->reader_.set_offset(offset + size);
+  const uword instructions = Interpreter::FuseSuperinstructions(
+      reinterpret_cast<uword>(data), size);
 
   // Create and return bytecode object.
-  return Bytecode::New(reinterpret_cast<uword>(data), size, offset, pool);
+  return Bytecode::New(instructions, size, offset, pool);
 }
 
 void BytecodeReaderHelper::ReadExceptionsTable(const Bytecode& bytecode,
@@ -790,6 +812,7 @@ RawTypedData* BytecodeReaderHelper::NativeEntry(const Function& function,
     case MethodRecognizer::kByteDataViewLength:
     case MethodRecognizer::kClassIDgetID:
     case MethodRecognizer::kGrowableArrayCapacity:
+    case MethodRecognizer::kGrowableArrayData:
     case MethodRecognizer::kListFactory:
     case MethodRecognizer::kObjectArrayAllocate:
     case MethodRecognizer::kLinkedHashMap_getIndex:
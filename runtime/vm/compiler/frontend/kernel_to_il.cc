@@ -18,11 +18,19 @@
 #include "vm/object_store.h"
 #include "vm/report.h"
 #include "vm/resolver.h"
+#include "vm/source_report.h"
 #include "vm/stack_frame.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 namespace dart {
+
+DEFINE_FLAG(bool,
+            coverage_counters,
+            false,
+            "Record the call sites reached by JIT compiled code, including "
+            "optimized and inlined code, for source coverage reports.");
+
 namespace kernel {
 
 #define Z (zone_)
@@ -51,6 +59,7 @@ FlowGraphBuilder::FlowGraphBuilder(
       parsed_function_(parsed_function),
       optimizing_(optimizing),
       ic_data_array_(*ic_data_array),
+      coverage_counters_(NULL),
       next_function_id_(0),
       loop_depth_(0),
       try_depth_(0),
@@ -345,6 +354,7 @@ Fragment FlowGraphBuilder::InstanceCall(
     const CallSiteAttributesMetadata* call_site_attrs) {
   const intptr_t total_count = argument_count + (type_args_len > 0 ? 1 : 0);
   ArgumentArray arguments = GetArguments(total_count);
+  Fragment instructions = CoverageCounter(position);
   InstanceCallInstr* call = new (Z)
       InstanceCallInstr(position, name, kind, arguments, type_args_len,
                         argument_names, checked_argument_count, ic_data_array_,
@@ -365,7 +375,8 @@ Fragment FlowGraphBuilder::InstanceCall(
     call->set_receivers_static_type(&type);
   }
   Push(call);
-  return Fragment(call);
+  instructions += Fragment(call);
+  return instructions;
 }
 
 Fragment FlowGraphBuilder::ClosureCall(TokenPosition position,
@@ -388,11 +399,14 @@ Fragment FlowGraphBuilder::ClosureCall(TokenPosition position,
 Fragment FlowGraphBuilder::FfiCall(
     const Function& signature,
     const ZoneGrowableArray<Representation>& arg_reps,
-    const ZoneGrowableArray<Location>& arg_locs) {
+    const ZoneGrowableArray<Location>& arg_locs,
+    const compiler::ffi::StructResult* struct_result,
+    bool is_leaf) {
   Fragment body;
 
   FfiCallInstr* call =
-      new (Z) FfiCallInstr(Z, GetNextDeoptId(), signature, arg_reps, arg_locs);
+      new (Z) FfiCallInstr(Z, GetNextDeoptId(), signature, arg_reps, arg_locs,
+                           struct_result, is_leaf);
 
   for (intptr_t i = call->InputCount() - 1; i >= 0; --i) {
     call->SetInputAt(i, Pop());
@@ -575,6 +589,7 @@ Fragment FlowGraphBuilder::StaticCall(TokenPosition position,
                                       bool use_unchecked_entry) {
   const intptr_t total_count = argument_count + (type_args_count > 0 ? 1 : 0);
   ArgumentArray arguments = GetArguments(total_count);
+  Fragment instructions = CoverageCounter(position);
   StaticCallInstr* call = new (Z)
       StaticCallInstr(position, target, type_args_count, argument_names,
                       arguments, ic_data_array_, GetNextDeoptId(), rebind_rule);
@@ -583,7 +598,8 @@ Fragment FlowGraphBuilder::StaticCall(TokenPosition position,
     call->set_entry_kind(Code::EntryKind::kUnchecked);
   }
   Push(call);
-  return Fragment(call);
+  instructions += Fragment(call);
+  return instructions;
 }
 
 Fragment FlowGraphBuilder::StringInterpolate(TokenPosition position) {
@@ -799,6 +815,72 @@ Fragment FlowGraphBuilder::NativeFunctionBody(const Function& function,
       body += BuildTypedDataViewFactoryConstructor(
           function, kTypedDataFloat64x2ArrayViewCid);
       break;
+    case MethodRecognizer::kFfiLoadInt8:
+      body += BuildFfiLoad(function, kFfiInt8Cid);
+      break;
+    case MethodRecognizer::kFfiLoadInt16:
+      body += BuildFfiLoad(function, kFfiInt16Cid);
+      break;
+    case MethodRecognizer::kFfiLoadInt32:
+      body += BuildFfiLoad(function, kFfiInt32Cid);
+      break;
+    case MethodRecognizer::kFfiLoadInt64:
+      body += BuildFfiLoad(function, kFfiInt64Cid);
+      break;
+    case MethodRecognizer::kFfiLoadUint8:
+      body += BuildFfiLoad(function, kFfiUint8Cid);
+      break;
+    case MethodRecognizer::kFfiLoadUint16:
+      body += BuildFfiLoad(function, kFfiUint16Cid);
+      break;
+    case MethodRecognizer::kFfiLoadUint32:
+      body += BuildFfiLoad(function, kFfiUint32Cid);
+      break;
+    case MethodRecognizer::kFfiLoadUint64:
+      body += BuildFfiLoad(function, kFfiUint64Cid);
+      break;
+    case MethodRecognizer::kFfiLoadIntPtr:
+      body += BuildFfiLoad(function, kFfiIntPtrCid);
+      break;
+    case MethodRecognizer::kFfiLoadFloat:
+      body += BuildFfiLoad(function, kFfiFloatCid);
+      break;
+    case MethodRecognizer::kFfiLoadDouble:
+      body += BuildFfiLoad(function, kFfiDoubleCid);
+      break;
+    case MethodRecognizer::kFfiStoreInt8:
+      body += BuildFfiStore(function, kFfiInt8Cid);
+      break;
+    case MethodRecognizer::kFfiStoreInt16:
+      body += BuildFfiStore(function, kFfiInt16Cid);
+      break;
+    case MethodRecognizer::kFfiStoreInt32:
+      body += BuildFfiStore(function, kFfiInt32Cid);
+      break;
+    case MethodRecognizer::kFfiStoreInt64:
+      body += BuildFfiStore(function, kFfiInt64Cid);
+      break;
+    case MethodRecognizer::kFfiStoreUint8:
+      body += BuildFfiStore(function, kFfiUint8Cid);
+      break;
+    case MethodRecognizer::kFfiStoreUint16:
+      body += BuildFfiStore(function, kFfiUint16Cid);
+      break;
+    case MethodRecognizer::kFfiStoreUint32:
+      body += BuildFfiStore(function, kFfiUint32Cid);
+      break;
+    case MethodRecognizer::kFfiStoreUint64:
+      body += BuildFfiStore(function, kFfiUint64Cid);
+      break;
+    case MethodRecognizer::kFfiStoreIntPtr:
+      body += BuildFfiStore(function, kFfiIntPtrCid);
+      break;
+    case MethodRecognizer::kFfiStoreFloat:
+      body += BuildFfiStore(function, kFfiFloatCid);
+      break;
+    case MethodRecognizer::kFfiStoreDouble:
+      body += BuildFfiStore(function, kFfiDoubleCid);
+      break;
 #endif  // !defined(TARGET_ARCH_DBC)
     case MethodRecognizer::kObjectEquals:
       body += LoadLocal(parsed_function_->receiver_var());
@@ -839,6 +921,10 @@ Fragment FlowGraphBuilder::NativeFunctionBody(const Function& function,
       body += LoadLocal(parsed_function_->receiver_var());
       body += LoadNativeField(Slot::TypedDataView_data());
       break;
+    case MethodRecognizer::kFfiGetAddress:
+      body += LoadLocal(parsed_function_->receiver_var());
+      body += LoadNativeField(Slot::Pointer_c_memory_address());
+      break;
     case MethodRecognizer::kClassIDgetID:
       body += LoadLocal(first_parameter);
       body += LoadClassId();
@@ -848,6 +934,10 @@ Fragment FlowGraphBuilder::NativeFunctionBody(const Function& function,
       body += LoadNativeField(Slot::GrowableObjectArray_data());
       body += LoadNativeField(Slot::Array_length());
       break;
+    case MethodRecognizer::kGrowableArrayData:
+      body += LoadLocal(parsed_function_->receiver_var());
+      body += LoadNativeField(Slot::GrowableObjectArray_data());
+      break;
     case MethodRecognizer::kListFactory: {
       // factory List<E>([int length]) {
       //   return (:arg_desc.positional_count == 2) ? new _List<E>(length)
@@ -1041,6 +1131,97 @@ Fragment FlowGraphBuilder::BuildTypedDataViewFactoryConstructor(
   return body;
 }
 
+// The representation in which LoadIndexed produces and StoreIndexed consumes
+// the elements of a typed data class.
+static Representation ElementRepresentation(classid_t typed_data_cid) {
+  switch (typed_data_cid) {
+    case kTypedDataInt8ArrayCid:
+    case kTypedDataInt16ArrayCid:
+    case kTypedDataUint8ArrayCid:
+    case kTypedDataUint16ArrayCid:
+      return kUnboxedIntPtr;
+    case kTypedDataInt32ArrayCid:
+      return kUnboxedInt32;
+    case kTypedDataUint32ArrayCid:
+      return kUnboxedUint32;
+    case kTypedDataInt64ArrayCid:
+    case kTypedDataUint64ArrayCid:
+      return kUnboxedInt64;
+    case kTypedDataFloat32ArrayCid:
+    case kTypedDataFloat64ArrayCid:
+      return kUnboxedDouble;
+    default:
+      UNREACHABLE();
+      return kTagged;
+  }
+}
+
+Fragment FlowGraphBuilder::FfiElementAddress(LocalVariable* pointer,
+                                             LocalVariable* index,
+                                             intptr_t element_size) {
+  Fragment body;
+  body += LoadLocal(pointer);
+  body += LoadNativeField(Slot::Pointer_c_memory_address());
+  body += UnboxTruncate(kUnboxedIntPtr);
+  body += LoadLocal(index);
+  body += UnboxTruncate(kUnboxedIntPtr);
+  body += IntConstant(element_size);
+  body += UnboxTruncate(kUnboxedIntPtr);
+  body += MultiplyIntptrIntegers();
+  body += AddIntptrIntegers();
+  body += ConvertIntptrToUntagged();
+  return body;
+}
+
+Fragment FlowGraphBuilder::BuildFfiLoad(const Function& function,
+                                        classid_t ffi_type_cid) {
+  const classid_t typed_data_cid =
+      compiler::ffi::ElementTypedDataCid(ffi_type_cid);
+  LocalVariable* pointer = parsed_function_->RawParameterVariable(0);
+  LocalVariable* index = parsed_function_->RawParameterVariable(1);
+  const auto& name = String::ZoneHandle(Z, function.name());
+
+  Fragment body;
+  body += CheckNull(function.token_pos(), pointer, name,
+                    /*clear_the_temp=*/false);
+  body += CheckNull(function.token_pos(), index, name,
+                    /*clear_the_temp=*/false);
+  body += FfiElementAddress(pointer, index,
+                            compiler::ffi::ElementSizeInBytes(ffi_type_cid));
+  // The address already includes the offset of the element.
+  body += IntConstant(0);
+  body += LoadIndexedTypedData(typed_data_cid);
+  body += Box(ElementRepresentation(typed_data_cid));
+  return body;
+}
+
+Fragment FlowGraphBuilder::BuildFfiStore(const Function& function,
+                                         classid_t ffi_type_cid) {
+  const classid_t typed_data_cid =
+      compiler::ffi::ElementTypedDataCid(ffi_type_cid);
+  LocalVariable* pointer = parsed_function_->RawParameterVariable(0);
+  LocalVariable* index = parsed_function_->RawParameterVariable(1);
+  LocalVariable* value = parsed_function_->RawParameterVariable(2);
+  const auto& name = String::ZoneHandle(Z, function.name());
+
+  Fragment body;
+  body += CheckNull(function.token_pos(), pointer, name,
+                    /*clear_the_temp=*/false);
+  body += CheckNull(function.token_pos(), index, name,
+                    /*clear_the_temp=*/false);
+  body += CheckNull(function.token_pos(), value, name,
+                    /*clear_the_temp=*/false);
+  body += FfiElementAddress(pointer, index,
+                            compiler::ffi::ElementSizeInBytes(ffi_type_cid));
+  // The address already includes the offset of the element.
+  body += IntConstant(0);
+  body += LoadLocal(value);
+  body += UnboxTruncate(ElementRepresentation(typed_data_cid));
+  body += StoreIndexed(typed_data_cid);
+  body += NullConstant();
+  return body;
+}
+
 static const LocalScope* MakeImplicitClosureScope(Zone* Z, const Class& klass) {
   ASSERT(!klass.IsNull());
   // Note that if klass is _Closure, DeclarationType will be _Closure,
@@ -1150,6 +1331,36 @@ Fragment FlowGraphBuilder::DebugStepCheck(TokenPosition position) {
 #endif
 }
 
+Fragment FlowGraphBuilder::CoverageCounter(TokenPosition position) {
+#ifdef PRODUCT
+  return Fragment();
+#else
+  if (!FLAG_coverage_counters || !position.IsReal()) {
+    return Fragment();
+  }
+  const Function& function = parsed_function_->function();
+  if ((position < function.token_pos()) ||
+      (position > function.end_token_pos())) {
+    // Does not correspond to a source position of this function.
+    return Fragment();
+  }
+  if (coverage_counters_ == NULL) {
+    coverage_counters_ = &Array::ZoneHandle(
+        Z, CoverageCounters::GetOrCreate(thread_, function));
+  }
+  if (coverage_counters_->IsNull()) {
+    return Fragment();
+  }
+  // Emitted after the arguments are evaluated so, like the ICData of the
+  // call, the counter is only set when the call itself is reached.
+  Fragment instructions = Constant(*coverage_counters_);
+  instructions += IntConstant(position.Pos() - function.token_pos().Pos());
+  instructions += IntConstant(1);
+  instructions += StoreIndexed(kArrayCid);
+  return instructions;
+#endif
+}
+
 Fragment FlowGraphBuilder::EvaluateAssertion() {
   const Class& klass =
       Class::ZoneHandle(Z, Library::LookupCoreClass(Symbols::AssertionError()));
@@ -2495,6 +2706,23 @@ Fragment FlowGraphBuilder::FfiPointerFromAddress(const Type& result_type) {
   return rest;
 }
 
+Fragment FlowGraphBuilder::LoadFfiStructPiece(LocalVariable* pointer,
+                                              intptr_t offset,
+                                              intptr_t size) {
+  Fragment body;
+  body += LoadLocal(pointer);
+  body += LoadNativeField(Slot::Pointer_c_memory_address());
+  body += UnboxTruncate(kUnboxedIntPtr);
+  body += IntConstant(offset);
+  body += UnboxTruncate(kUnboxedIntPtr);
+  body += AddIntptrIntegers();
+  body += ConvertIntptrToUntagged();
+  // The address already includes the offset of the piece.
+  body += IntConstant(0);
+  body += LoadIndexedTypedData(compiler::ffi::StructPieceTypedDataCid(size));
+  return body;
+}
+
 Fragment FlowGraphBuilder::BitCast(Representation from, Representation to) {
   BitCastInstr* instr = new (Z) BitCastInstr(from, to, Pop());
   Push(instr);
@@ -2519,26 +2747,65 @@ FlowGraph* FlowGraphBuilder::BuildGraphOfFfiTrampoline(
   body += CheckStackOverflowInPrologue(function.token_pos());
 
   const Function& signature = Function::ZoneHandle(Z, function.FfiCSignature());
-  const auto& arg_reps = *compiler::ffi::ArgumentRepresentations(signature);
-  const auto& arg_locs = *compiler::ffi::ArgumentLocations(arg_reps);
+  // Asking for the function has checked already that the native ABI allows
+  // the signature.
+  const char* error = nullptr;
+  const auto* layout =
+      compiler::ffi::NativeCallLayout::New(Z, signature, &error);
+  ASSERT(layout != nullptr);
+  const auto& arg_reps = layout->representations();
+  const auto& arg_locs = layout->locations();
+  const auto* struct_result = layout->struct_result();
 
   BuildArgumentTypeChecks(TypeChecksToBuild::kCheckAllTypeParameterBounds,
                           &body, &body, &body);
 
-  // Unbox and push the arguments.
+  // Check for 'null'. Only ffi.Pointers are allowed to be null.
   AbstractType& ffi_type = AbstractType::Handle(Z);
   for (intptr_t pos = 1; pos < function.num_fixed_parameters(); pos++) {
-    body += LoadLocal(parsed_function_->ParameterVariable(pos));
     ffi_type = signature.ParameterTypeAt(pos);
-
-    // Check for 'null'. Only ffi.Pointers are allowed to be null.
     if (!compiler::ffi::NativeTypeIsPointer(ffi_type)) {
       body += LoadLocal(parsed_function_->ParameterVariable(pos));
       body <<=
           new (Z) CheckNullInstr(Pop(), String::ZoneHandle(Z, function.name()),
                                  GetNextDeoptId(), TokenPosition::kNoSource);
     }
+  }
+
+  // Allocate the memory a struct is returned into, which the caller of the
+  // trampoline owns from then on.
+  LocalVariable* result_address = nullptr;
+  if (struct_result != nullptr) {
+    const Library& ffi_library = Library::Handle(Z, Library::FfiLibrary());
+    const Function& allocate = Function::ZoneHandle(
+        Z, ffi_library.LookupFunctionAllowPrivate(
+               Symbols::AllocateStructResult()));
+    ASSERT(!allocate.IsNull());
+    body += IntConstant(struct_result->size());
+    body += PushArgument();
+    body += StaticCall(TokenPosition::kNoSource, allocate,
+                       /* argument_count = */ 1, ICData::kStatic);
+    result_address = MakeTemporary();
+  }
+
+  // Unbox and push the arguments.
+  for (intptr_t pos = 1; pos < function.num_fixed_parameters(); pos++) {
+    ffi_type = signature.ParameterTypeAt(pos);
+
+    if (compiler::ffi::NativeTypeIsStruct(ffi_type)) {
+      // Push the struct in the pieces it is passed in.
+      LocalVariable* pointer = parsed_function_->ParameterVariable(pos);
+      const intptr_t first = layout->FirstNativeArgument(pos - 1);
+      for (intptr_t i = first,
+                    n = first + layout->NumNativeArguments(pos - 1);
+           i < n; i++) {
+        body += LoadFfiStructPiece(pointer, layout->PieceOffset(i),
+                                   layout->PieceSize(i));
+      }
+      continue;
+    }
 
+    body += LoadLocal(parsed_function_->ParameterVariable(pos));
     if (compiler::ffi::NativeTypeIsPointer(ffi_type)) {
       body += LoadAddressFromFfiPointer();
       body += UnboxTruncate(kUnboxedFfiIntPtr);
@@ -2546,7 +2813,7 @@ FlowGraph* FlowGraphBuilder::BuildGraphOfFfiTrampoline(
       Representation from_rep = compiler::ffi::TypeRepresentation(ffi_type);
       body += UnboxTruncate(from_rep);
 
-      Representation to_rep = arg_reps[pos - 1];
+      Representation to_rep = arg_reps[layout->FirstNativeArgument(pos - 1)];
       if (from_rep != to_rep) {
         body += BitCast(from_rep, to_rep);
       } else {
@@ -2554,6 +2821,10 @@ FlowGraph* FlowGraphBuilder::BuildGraphOfFfiTrampoline(
       }
     }
   }
+  if (result_address != nullptr) {
+    body += LoadLocal(result_address);
+    body += UnboxTruncate(kUnboxedFfiIntPtr);
+  }
 
   // Push the function pointer, which is stored (boxed) in the first slot of the
   // context.
@@ -2564,10 +2835,20 @@ FlowGraph* FlowGraphBuilder::BuildGraphOfFfiTrampoline(
                     Z, Class::Handle(I->object_store()->ffi_pointer_class()))
                     ->context_variables()[0]));
   body += UnboxTruncate(kUnboxedFfiIntPtr);
-  body += FfiCall(signature, arg_reps, arg_locs);
+  body += FfiCall(signature, arg_reps, arg_locs, struct_result,
+                  function.FfiIsLeaf());
 
   ffi_type = signature.result_type();
-  if (compiler::ffi::NativeTypeIsPointer(ffi_type)) {
+  if (struct_result != nullptr) {
+    // The struct is in the memory allocated for it by now.
+    body += Drop();
+    body += LoadLocal(result_address);
+    const TypeArguments& type_args =
+        TypeArguments::Handle(Z, ffi_type.arguments());
+    body += FfiPointerFromAddress(
+        Type::Cast(AbstractType::ZoneHandle(Z, type_args.TypeAt(0))));
+    body += DropTempsPreserveTop(1);
+  } else if (compiler::ffi::NativeTypeIsPointer(ffi_type)) {
     body += Box(kUnboxedFfiIntPtr);
     body += FfiPointerFromAddress(Type::Cast(ffi_type));
   } else if (compiler::ffi::NativeTypeIsVoid(ffi_type)) {
@@ -108,6 +108,11 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
   Fragment BuildTypedDataViewFactoryConstructor(const Function& function,
                                                 classid_t cid);
 
+  // Bodies of the dart:ffi element accessors in ffi_patch.dart, which access
+  // the element of the native type with class id 'ffi_type_cid' directly.
+  Fragment BuildFfiLoad(const Function& function, classid_t ffi_type_cid);
+  Fragment BuildFfiStore(const Function& function, classid_t ffi_type_cid);
+
   Fragment EnterScope(intptr_t kernel_offset,
                       const LocalScope** scope = nullptr);
   Fragment ExitScope(intptr_t kernel_offset);
@@ -153,7 +158,9 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
                        bool use_unchecked_entry = false);
   Fragment FfiCall(const Function& signature,
                    const ZoneGrowableArray<Representation>& arg_reps,
-                   const ZoneGrowableArray<Location>& arg_locs);
+                   const ZoneGrowableArray<Location>& arg_locs,
+                   const compiler::ffi::StructResult* struct_result,
+                   bool is_leaf);
 
   Fragment RethrowException(TokenPosition position, int catch_try_index);
   Fragment LoadLocal(LocalVariable* variable);
@@ -209,6 +216,10 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
   bool NeedsDebugStepCheck(Value* value, TokenPosition position);
   Fragment DebugStepCheck(TokenPosition position);
 
+  // Marks the call at [position] as executed in the coverage counters of the
+  // function being built (see CoverageCounters).
+  Fragment CoverageCounter(TokenPosition position);
+
   // Truncates (instead of deoptimizing) if the origin does not fit into the
   // target representation.
   Fragment UnboxTruncate(Representation to);
@@ -233,6 +244,18 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
   // the pointer.
   Fragment FfiPointerFromAddress(const Type& result_type);
 
+  // Pushes the piece of 'size' bytes at 'offset' of the struct 'pointer',
+  // which must not be null, points to, unboxed.
+  Fragment LoadFfiStructPiece(LocalVariable* pointer,
+                              intptr_t offset,
+                              intptr_t size);
+
+  // Pushes the untagged address of the element at 'index' of 'pointer', which
+  // must not be null.
+  Fragment FfiElementAddress(LocalVariable* pointer,
+                             LocalVariable* index,
+                             intptr_t element_size);
+
   // Bit-wise cast between representations.
   // Pops the input and pushes the converted result.
   // Currently only works with equal sizes and floating point <-> integer.
@@ -343,6 +366,8 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
   ParsedFunction* parsed_function_;
   const bool optimizing_;
   ZoneGrowableArray<const ICData*>& ic_data_array_;
+  // Looked up on the first call site, see CoverageCounter.
+  const Array* coverage_counters_;
 
   intptr_t next_function_id_;
   intptr_t AllocateFunctionId() { return next_function_id_++; }
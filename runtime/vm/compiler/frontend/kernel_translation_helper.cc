@@ -2543,26 +2543,44 @@ const String& KernelReaderHelper::GetSourceFor(intptr_t index) {
   }
 }
 
-RawTypedData* KernelReaderHelper::GetLineStartsFor(intptr_t index) {
-  // Line starts are delta encoded. So get the max delta first so that we
-  // can store them as tighly as possible.
+intptr_t KernelReaderHelper::GetOffsetForLineStarts(intptr_t index) {
   AlternativeReadingScope alt(&reader_);
   SetOffset(GetOffsetForSourceInfo(index));
-  SkipBytes(ReadUInt());                         // skip uri.
-  SkipBytes(ReadUInt());                         // skip source.
-  const intptr_t line_start_count = ReadUInt();  // read number of line start
-  // entries.
-  MallocGrowableArray<int32_t> line_starts_array;
+  SkipBytes(ReadUInt());  // skip uri.
+  SkipBytes(ReadUInt());  // skip source.
+  return ReaderOffset();
+}
 
-  intptr_t max_delta = 0;
+int32_t KernelReaderHelper::ReadLineStartDeltas(
+    Reader* reader,
+    MallocGrowableArray<int32_t>* deltas) {
+  const intptr_t line_start_count = reader->ReadUInt();  // read number of line
+  // start entries.
+  int32_t max_delta = 0;
   for (intptr_t i = 0; i < line_start_count; ++i) {
-    int32_t delta = ReadUInt();
-    line_starts_array.Add(delta);
+    int32_t delta = reader->ReadUInt();
+    deltas->Add(delta);
     if (delta > max_delta) {
       max_delta = delta;
     }
   }
+  return max_delta;
+}
+
+RawTypedData* KernelReaderHelper::GetLineStartsFor(intptr_t index) {
+  // Line starts are delta encoded. So get the max delta first so that we
+  // can store them as tighly as possible.
+  AlternativeReadingScope alt(&reader_);
+  SetOffset(GetOffsetForLineStarts(index));
+  MallocGrowableArray<int32_t> line_starts_array;
+  const int32_t max_delta = ReadLineStartDeltas(&reader_, &line_starts_array);
+  return NewLineStarts(line_starts_array, max_delta);
+}
 
+RawTypedData* KernelReaderHelper::NewLineStarts(
+    const MallocGrowableArray<int32_t>& line_starts_array,
+    int32_t max_delta) {
+  const intptr_t line_start_count = line_starts_array.length();
   intptr_t cid;
   if (max_delta <= kMaxInt8) {
     cid = kTypedDataInt8ArrayCid;
@@ -1068,6 +1068,14 @@ class KernelReaderHelper {
   String& SourceTableUriFor(intptr_t index);
   const String& GetSourceFor(intptr_t index);
   RawTypedData* GetLineStartsFor(intptr_t index);
+  // Returns the offset of the delta encoded line starts of source [index].
+  intptr_t GetOffsetForLineStarts(intptr_t index);
+  // Reads the line start deltas at the current offset of [reader] and
+  // returns the largest one. Does not access the heap.
+  static int32_t ReadLineStartDeltas(Reader* reader,
+                                     MallocGrowableArray<int32_t>* deltas);
+  RawTypedData* NewLineStarts(const MallocGrowableArray<int32_t>& deltas,
+                              int32_t max_delta);
   String& SourceTableImportUriFor(intptr_t index, uint32_t binaryVersion);
 
   Zone* zone_;
@@ -1096,6 +1104,7 @@ class KernelReaderHelper {
   friend class KernelLoader;
   friend class LibraryDependencyHelper;
   friend class LibraryHelper;
+  friend class LineStartsDecoder;
   friend class MetadataHelper;
   friend class ProcedureAttributesMetadataHelper;
   friend class ProcedureHelper;
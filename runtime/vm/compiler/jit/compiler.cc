@@ -26,7 +26,9 @@
 #include "vm/compiler/frontend/bytecode_reader.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/deopt_statistics.h"
 #include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/compiler/jit/jit_profile_cache.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
@@ -88,11 +90,16 @@ DEFINE_FLAG(bool,
             verify_compiler,
             false,
             "Enable compiler verification assertions");
+DEFINE_FLAG(int,
+            background_compiler_tasks,
+            1,
+            "The number of tasks each background compiler of an isolate "
+            "uses to compile queued functions.");
 
 DECLARE_FLAG(bool, enable_interpreter);
 DECLARE_FLAG(bool, huge_method_cutoff_in_code_size);
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
-DECLARE_FLAG(bool, unbox_numeric_fields);
+DECLARE_FLAG(bool, print_compiler_pass_statistics);
 
 static void PrecompilationModeHandler(bool value) {
   if (value) {
@@ -116,11 +123,6 @@ static void PrecompilationModeHandler(bool value) {
     FLAG_use_field_guards = false;
     FLAG_use_cha_deopt = false;
 
-#if !defined(DART_PRECOMPILED_RUNTIME)
-    // Not present with DART_PRECOMPILED_RUNTIME
-    FLAG_unbox_numeric_fields = false;
-#endif
-
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
     // Set flags affecting runtime accordingly for gen_snapshot.
     // These flags are constants with PRODUCT and DART_PRECOMPILED_RUNTIME.
@@ -454,6 +456,8 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
       const bool is_osr = osr_id() != Compiler::kNoOSRDeoptId;
       if (!is_osr) {
         function.InstallOptimizedCode(code);
+        isolate()->IncrementOptimizedCodeInstalls();
+        NOT_IN_PRODUCT(DeoptStatistics::RecordOptimization(thread(), function));
       }
       ASSERT(code.owner() == function.raw());
     } else {
@@ -501,8 +505,18 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
       // Setting breakpoints at runtime could make a function non-optimizable.
       if (code_is_valid && Compiler::CanOptimizeFunction(thread(), function)) {
         const bool is_osr = osr_id() != Compiler::kNoOSRDeoptId;
-        ASSERT(!is_osr);  // OSR is not compiled in background.
-        function.InstallOptimizedCode(code);
+        if (is_osr) {
+          // The mutator enters the code at the next OSR check of the loop,
+          // which the raised usage counter makes happen right away.
+          isolate()->optimizing_background_compiler()->AddOsrCode(
+              function, osr_id(), code);
+          function.SetUsageCounter(BackgroundCompiler::kOsrReadyUsageCounter);
+        } else {
+          function.InstallOptimizedCode(code);
+          isolate()->IncrementOptimizedCodeInstalls();
+          NOT_IN_PRODUCT(
+              DeoptStatistics::RecordOptimization(thread(), function));
+        }
       } else {
         code = Code::null();
       }
@@ -587,6 +601,7 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   }
   Zone* const zone = thread()->zone();
   HANDLESCOPE(thread());
+  const int64_t start_micros = OS::GetCurrentMonotonicMicros();
 
   // We may reattempt compilation if the function needs to be assembled using
   // far branches on ARM. In the else branch of the setjmp call, done is set to
@@ -635,6 +650,15 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
             Compiler::AbortBackgroundCompilation(
                 DeoptId::kNone, "RestoreICDataMap: ICData array cleared.");
           }
+          // Do not speculate again at call sites whose class checks failed
+          // in earlier optimized code.
+          for (intptr_t i = 0; i < ic_data_array->length(); i++) {
+            const ICData* ic_data = (*ic_data_array)[i];
+            if ((ic_data != NULL) &&
+                ic_data->HasDeoptReason(ICData::kDeoptCheckClass)) {
+              speculative_policy.AddDeoptimizedDeoptId(i);
+            }
+          }
         }
 
         if (FLAG_print_ic_data_map) {
@@ -746,6 +770,11 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
                    FlowGraphPrinter::ShouldPrint(function)) {
           Disassembler::DisassembleCode(function, *result, true);
         }
+        if (FLAG_print_compiler_pass_statistics && optimized()) {
+          CompilerPassStatistics::RecordFunction(
+              function, OS::GetCurrentMonotonicMicros() - start_micros,
+              pass_state);
+        }
       }
       // Exit the loop and the function with the correct result value.
       done = true;
@@ -1014,7 +1043,13 @@ RawObject* Compiler::CompileFunction(Thread* thread, const Function& function) {
       CompilationPipeline::New(thread->zone(), function);
 
   const bool optimized = function.ForceOptimize();
-  return CompileFunctionHelper(pipeline, function, optimized, kNoOSRDeoptId);
+  const Object& result = Object::Handle(
+      thread->zone(),
+      CompileFunctionHelper(pipeline, function, optimized, kNoOSRDeoptId));
+  if (!optimized && result.IsCode()) {
+    JitProfileCache::FunctionCompiled(thread, function);
+  }
+  return result.raw();
 }
 
 RawError* Compiler::ParseFunction(Thread* thread, const Function& function) {
@@ -1290,15 +1325,25 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 // C-heap allocated background compilation queue element.
 class QueueElement {
  public:
-  explicit QueueElement(const Function& function)
-      : next_(NULL), function_(function.raw()) {}
+  explicit QueueElement(const Function& function,
+                        intptr_t osr_id = Compiler::kNoOSRDeoptId)
+      : next_(NULL),
+        function_(function.raw()),
+        osr_id_(osr_id),
+        code_(Code::null()) {}
 
   virtual ~QueueElement() {
     next_ = NULL;
     function_ = Function::null();
+    code_ = Code::null();
   }
 
   RawFunction* Function() const { return function_; }
+  intptr_t osr_id() const { return osr_id_; }
+  bool is_osr() const { return osr_id_ != Compiler::kNoOSRDeoptId; }
+
+  RawCode* code() const { return code_; }
+  void set_code(const Code& code) { code_ = code.raw(); }
 
   void set_next(QueueElement* elem) { next_ = elem; }
   QueueElement* next() const { return next_; }
@@ -1307,19 +1352,23 @@ class QueueElement {
   RawObject** function_ptr() {
     return reinterpret_cast<RawObject**>(&function_);
   }
+  RawObject** code_ptr() { return reinterpret_cast<RawObject**>(&code_); }
 
  private:
   QueueElement* next_;
   RawFunction* function_;
+  intptr_t osr_id_;
+  RawCode* code_;  // Finished OSR code, see BackgroundCompiler::AddOsrCode.
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, from which
+// workers may also take the function with the highest usage counter.
 class BackgroundCompilationQueue {
  public:
-  BackgroundCompilationQueue() : first_(NULL), last_(NULL) {}
+  BackgroundCompilationQueue() : first_(NULL), last_(NULL), length_(0) {}
   virtual ~BackgroundCompilationQueue() { Clear(); }
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
@@ -1327,15 +1376,19 @@ class BackgroundCompilationQueue {
     QueueElement* p = first_;
     while (p != NULL) {
       visitor->VisitPointer(p->function_ptr());
+      visitor->VisitPointer(p->code_ptr());
       p = p->next();
     }
   }
 
   bool IsEmpty() const { return first_ == NULL; }
 
+  intptr_t length() const { return length_; }
+
   void Add(QueueElement* value) {
     ASSERT(value != NULL);
     ASSERT(value->next() == NULL);
+    length_++;
     if (first_ == NULL) {
       first_ = value;
       ASSERT(last_ == NULL);
@@ -1365,9 +1418,47 @@ class BackgroundCompilationQueue {
     if (first_ == NULL) {
       last_ = NULL;
     }
+    length_--;
     return result;
   }
 
+  // Removes the element whose function has the highest usage counter, using
+  // 'function' as a scratch handle. Ties are broken in FIFO order.
+  QueueElement* RemoveHottest(Function* function) {
+    ASSERT(first_ != NULL);
+    QueueElement* hottest = NULL;
+    intptr_t hottest_count = -1;
+    for (QueueElement* p = first_; p != NULL; p = p->next()) {
+      *function = p->Function();
+      if (function->usage_counter() > hottest_count) {
+        hottest = p;
+        hottest_count = function->usage_counter();
+      }
+    }
+    Remove(hottest);
+    return hottest;
+  }
+
+  void Remove(QueueElement* value) {
+    QueueElement* prev = NULL;
+    QueueElement* p = first_;
+    while (p != value) {
+      ASSERT(p != NULL);
+      prev = p;
+      p = p->next();
+    }
+    if (prev == NULL) {
+      first_ = value->next();
+    } else {
+      prev->set_next(value->next());
+    }
+    if (last_ == value) {
+      last_ = prev;
+    }
+    value->set_next(NULL);
+    length_--;
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != NULL) {
@@ -1390,6 +1481,7 @@ class BackgroundCompilationQueue {
  private:
   QueueElement* first_;
   QueueElement* last_;
+  intptr_t length_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
@@ -1398,18 +1490,36 @@ BackgroundCompiler::BackgroundCompiler(Isolate* isolate)
     : isolate_(isolate),
       queue_monitor_(new Monitor()),
       function_queue_(new BackgroundCompilationQueue()),
+      compiling_queue_(new BackgroundCompilationQueue()),
+      osr_code_queue_(new BackgroundCompilationQueue()),
       done_monitor_(new Monitor()),
       running_(false),
       done_(true),
+      running_tasks_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete queue_monitor_;
   delete function_queue_;
+  delete compiling_queue_;
+  delete osr_code_queue_;
   delete done_monitor_;
 }
 
+QueueElement* BackgroundCompiler::TakeNextFunction(Function* function) {
+  ASSERT(queue_monitor_->IsOwnedByCurrentThread());
+  if (!running_ || function_queue_->IsEmpty()) {
+    return NULL;
+  }
+  // Hot functions first: they are where the time goes during warmup.
+  QueueElement* elem = function_queue_->RemoveHottest(function);
+  UpdateQueueMetric();
+  compiling_queue_->Add(elem);
+  *function = elem->Function();
+  return elem;
+}
+
 void BackgroundCompiler::Run() {
   while (running_) {
     // Maybe something is already in the queue, check first before waiting
@@ -1422,47 +1532,50 @@ void BackgroundCompiler::Run() {
       Zone* zone = stack_zone.GetZone();
       HANDLESCOPE(thread);
       Function& function = Function::Handle(zone);
+      QueueElement* qelem = NULL;
       {
         MonitorLocker ml(queue_monitor_);
-        function = function_queue()->PeekFunction();
+        qelem = TakeNextFunction(&function);
       }
-      while (running_ && !function.IsNull()) {
+      // A function stays in the compiling queue while it is compiled, so that
+      // it is not queued again meanwhile.
+      while (qelem != NULL) {
         // This is false if we are compiling bytecode -> unoptimized code.
         const bool optimizing = function.ShouldCompilerOptimize();
         ASSERT(FLAG_enable_interpreter || optimizing);
 
         if (optimizing) {
           Compiler::CompileOptimizedFunction(thread, function,
-                                             Compiler::kNoOSRDeoptId);
+                                             qelem->osr_id());
         } else {
           Compiler::CompileFunction(thread, function);
         }
 
-        QueueElement* qelem = NULL;
         {
           MonitorLocker ml(queue_monitor_);
-          if (function_queue()->IsEmpty()) {
-            // We are shutting down, queue was cleared.
-            function = Function::null();
-          } else {
-            qelem = function_queue()->Remove();
-            const Function& old = Function::Handle(qelem->Function());
+          compiling_queue_->Remove(qelem);
+          // If we are shutting down, the queue was cleared.
+          if (qelem->is_osr()) {
+            // On a bailout let the loop request OSR again later.
+            if (function.usage_counter() < 0) {
+              function.SetUsageCounter(0);
+            }
+          } else if (running_) {
             // If an optimizable method is not optimized, put it back on
             // the background queue (unless it was passed to foreground).
-            if ((optimizing && !old.HasOptimizedCode() &&
-                 old.IsOptimizable()) ||
+            if ((optimizing && !function.HasOptimizedCode() &&
+                 function.IsOptimizable()) ||
                 FLAG_stress_test_background_compilation) {
-              if (old.is_background_optimizable() &&
-                  Compiler::CanOptimizeFunction(thread, old)) {
-                QueueElement* repeat_qelem = new QueueElement(old);
+              if (function.is_background_optimizable() &&
+                  Compiler::CanOptimizeFunction(thread, function)) {
+                QueueElement* repeat_qelem = new QueueElement(function);
                 function_queue()->Add(repeat_qelem);
+                UpdateQueueMetric();
               }
             }
-            function = function_queue()->PeekFunction();
           }
-        }
-        if (qelem != NULL) {
           delete qelem;
+          qelem = TakeNextFunction(&function);
         }
       }
     }
@@ -1477,13 +1590,26 @@ void BackgroundCompiler::Run() {
   }  // while running
 
   {
-    // Notify that the thread is done.
+    // Notify that the last task is done.
     MonitorLocker ml_done(done_monitor_);
-    done_ = true;
-    ml_done.Notify();
+    ASSERT(running_tasks_ > 0);
+    if (--running_tasks_ == 0) {
+      done_ = true;
+      ml_done.Notify();
+    }
   }
 }
 
+void BackgroundCompiler::UpdateQueueMetric() {
+  ASSERT(queue_monitor_->IsOwnedByCurrentThread());
+#if !defined(PRODUCT)
+  Metric* metric = (this == isolate_->optimizing_background_compiler())
+                       ? isolate_->GetOptimizingCompilerQueueMetric()
+                       : isolate_->GetUnoptimizedCompilerQueueMetric();
+  metric->set_value(function_queue_->length());
+#endif  // !defined(PRODUCT)
+}
+
 void BackgroundCompiler::Compile(const Function& function) {
   ASSERT(Thread::Current()->IsMutatorThread());
   // TODO(srdjan): Checking different strategy for collecting garbage
@@ -1494,17 +1620,76 @@ void BackgroundCompiler::Compile(const Function& function) {
   {
     MonitorLocker ml(queue_monitor_);
     ASSERT(running_);
-    if (function_queue()->ContainsObj(function)) {
+    if (function_queue()->ContainsObj(function) ||
+        compiling_queue_->ContainsObj(function)) {
       return;
     }
     QueueElement* elem = new QueueElement(function);
     function_queue()->Add(elem);
+    UpdateQueueMetric();
     ml.Notify();
   }
 }
 
+void BackgroundCompiler::CompileOsr(const Function& function,
+                                    intptr_t osr_id) {
+  ASSERT(Thread::Current()->IsMutatorThread());
+  ASSERT(osr_id != Compiler::kNoOSRDeoptId);
+  MonitorLocker ml(queue_monitor_);
+  ASSERT(running_);
+  if (function_queue()->ContainsObj(function) ||
+      compiling_queue_->ContainsObj(function) ||
+      osr_code_queue_->ContainsObj(function)) {
+    return;
+  }
+  function_queue()->Add(new QueueElement(function, osr_id));
+  UpdateQueueMetric();
+  ml.Notify();
+}
+
+void BackgroundCompiler::AddOsrCode(const Function& function,
+                                    intptr_t osr_id,
+                                    const Code& code) {
+  MonitorLocker ml(queue_monitor_);
+  if (!running_) {
+    return;
+  }
+  QueueElement* elem = new QueueElement(function, osr_id);
+  elem->set_code(code);
+  osr_code_queue_->Add(elem);
+}
+
+RawCode* BackgroundCompiler::TakeOsrCode(const Function& function,
+                                         intptr_t osr_id) {
+  ASSERT(Thread::Current()->IsMutatorThread());
+  Code& code = Code::Handle();
+  MonitorLocker ml(queue_monitor_);
+  QueueElement* p = osr_code_queue_->Peek();
+  while (p != NULL) {
+    QueueElement* next = p->next();
+    if (p->function() == function.raw()) {
+      // Code for another loop of the function is stale: its loop has exited
+      // or it would have requested it.
+      if (p->osr_id() == osr_id) {
+        code = p->code();
+      }
+      osr_code_queue_->Remove(p);
+      delete p;
+    }
+    p = next;
+  }
+  // Dependent code of optimized code is disabled when its assumptions are
+  // invalidated, see WeakCodeReferences::DisableCode.
+  if (!code.IsNull() && code.IsDisabled()) {
+    return Code::null();
+  }
+  return code.raw();
+}
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  compiling_queue_->VisitObjectPointers(visitor);
+  osr_code_queue_->VisitObjectPointers(visitor);
 }
 
 class BackgroundCompilerTask : public ThreadPool::Task {
@@ -1530,9 +1715,16 @@ void BackgroundCompiler::Start() {
   if (running_ || !done_) return;
   running_ = true;
   done_ = false;
-  bool task_started =
-      Dart::thread_pool()->Run(new BackgroundCompilerTask(this));
-  if (!task_started) {
+  const intptr_t num_tasks = Utils::Maximum(1, FLAG_background_compiler_tasks);
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    // Counted before the task runs, so that Stop waits for every started one.
+    running_tasks_++;
+    if (!Dart::thread_pool()->Run(new BackgroundCompilerTask(this))) {
+      running_tasks_--;
+      break;
+    }
+  }
+  if (running_tasks_ == 0) {
     running_ = false;
     done_ = true;
   }
@@ -1547,7 +1739,9 @@ void BackgroundCompiler::Stop() {
     MonitorLocker ml(queue_monitor_);
     running_ = false;
     function_queue_->Clear();
-    ml.Notify();  // Stop waiting for the queue.
+    UpdateQueueMetric();
+    osr_code_queue_->Clear();
+    ml.NotifyAll();  // Stop waiting for the queue.
   }
 
   {
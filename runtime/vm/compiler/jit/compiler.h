@@ -146,10 +146,12 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
-// No OSR compilation in the background compiler.
+// Class to run optimizing compilation in background threads.
+// Current implementation: --background_compiler_tasks tasks per isolate, taking
+// the queued function with the highest usage counter first; they die with the
+// owning isolate. Code is installed by each task as in a single-task compiler.
+// OSR code is not installed: it is kept until the mutator polls for it at the
+// next OSR check of the loop that requested it, see HandleOSRRequest.
 class BackgroundCompiler {
  public:
   explicit BackgroundCompiler(Isolate* isolate);
@@ -209,6 +211,22 @@ class BackgroundCompiler {
   // enters the function in the compilation queue.
   void Compile(const Function& function);
 
+  // Enters an OSR compilation of 'function' at 'osr_id' in the queue. The
+  // result is retrieved with TakeOsrCode.
+  void CompileOsr(const Function& function, intptr_t osr_id);
+
+  // Called when the background compilation of OSR code is finalized.
+  void AddOsrCode(const Function& function, intptr_t osr_id, const Code& code);
+
+  // Removes the finished OSR code of 'function', if any, and returns it if it
+  // is for 'osr_id' and has not been disabled since. Returns Code::null()
+  // otherwise.
+  RawCode* TakeOsrCode(const Function& function, intptr_t osr_id);
+
+  // Usage counter of a function whose OSR code is ready, high enough to make
+  // the next OSR check of any of its loops request it.
+  static const int32_t kOsrReadyUsageCounter = kMaxInt32 / 2;
+
   void VisitPointers(ObjectPointerVisitor* visitor);
 
   BackgroundCompilationQueue* function_queue() const { return function_queue_; }
@@ -224,14 +242,26 @@ class BackgroundCompiler {
   bool IsDisabled();
   bool IsRunning() { return !done_; }
 
+  // Moves the next function to compile from the function queue to the
+  // compiling queue and returns it, or returns NULL if there is none or the
+  // compiler is stopping. Called with queue_monitor_ held.
+  QueueElement* TakeNextFunction(Function* function);
+
+  // Publishes the length of the function queue as an isolate metric. Called
+  // with queue_monitor_ held.
+  void UpdateQueueMetric();
+
   Isolate* isolate_;
 
-  Monitor* queue_monitor_;  // Controls access to the queue.
+  Monitor* queue_monitor_;  // Controls access to the queues.
   BackgroundCompilationQueue* function_queue_;
+  BackgroundCompilationQueue* compiling_queue_;  // Functions being compiled.
+  BackgroundCompilationQueue* osr_code_queue_;   // OSR code not yet entered.
 
-  Monitor* done_monitor_;   // Notify/wait that the thread is done.
+  Monitor* done_monitor_;   // Notify/wait that the tasks are done.
   bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  bool done_;               // True if all tasks are done.
+  intptr_t running_tasks_;  // Tasks started and not yet done.
 
   int16_t disabled_depth_;
 
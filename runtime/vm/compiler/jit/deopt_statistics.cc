@@ -0,0 +1,186 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/jit/deopt_statistics.h"
+
+#include "vm/growable_array.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/runtime_entry.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+intptr_t DeoptStatistics::FunctionKeyValueTrait::Hashcode(Key key) {
+  return String::Hash(key, strlen(key));
+}
+
+bool DeoptStatistics::FunctionKeyValueTrait::IsKeyEqual(Pair kv, Key key) {
+  return strcmp(kv->name, key) == 0;
+}
+
+bool DeoptStatistics::SiteKeyValueTrait::IsKeyEqual(Pair kv, Key key) {
+  return (kv->function == key->function) &&
+         (kv->site_function == key->site_function) &&
+         (kv->deopt_id == key->deopt_id) && (kv->reason == key->reason);
+}
+
+DeoptStatistics::~DeoptStatistics() {
+  Clear();
+}
+
+DeoptStatistics* DeoptStatistics::Get(Thread* thread) {
+  Isolate* isolate = thread->isolate();
+  if (isolate->deopt_statistics() == nullptr) {
+    isolate->set_deopt_statistics(new DeoptStatistics());
+  }
+  return isolate->deopt_statistics();
+}
+
+DeoptStatistics::FunctionEntry* DeoptStatistics::LookupFunction(
+    const Function& function) {
+  const char* name = function.ToFullyQualifiedCString();
+  FunctionEntry* entry = functions_.LookupValue(name);
+  if (entry == nullptr) {
+    entry = new FunctionEntry();
+    entry->name = strdup(name);
+    entry->hash = String::Hash(name, strlen(name));
+    entry->deoptimizations = 0;
+    entry->reoptimizations = 0;
+    functions_.Insert(entry);
+  }
+  return entry;
+}
+
+void DeoptStatistics::RecordDeoptimization(Thread* thread,
+                                           const Function& function,
+                                           const Function& site_function,
+                                           intptr_t deopt_id,
+                                           ICData::DeoptReasonId reason,
+                                           bool is_lazy) {
+  DeoptStatistics* statistics = Get(thread);
+  Site key;
+  key.function = statistics->LookupFunction(function);
+  key.site_function = site_function.raw() == function.raw()
+                          ? key.function
+                          : statistics->LookupFunction(site_function);
+  key.deopt_id = deopt_id;
+  key.reason = reason;
+  uint32_t hash = key.function->hash;
+  hash = CombineHashes(hash, key.site_function->hash);
+  hash = CombineHashes(hash, static_cast<uint32_t>(deopt_id));
+  hash = CombineHashes(hash, static_cast<uint32_t>(reason));
+  key.hash = FinalizeHash(hash, kBitsPerInt32 - 1);
+
+  Site* site = statistics->sites_.LookupValue(&key);
+  if (site == nullptr) {
+    site = new Site(key);
+    site->count = 0;
+    site->lazy_count = 0;
+    statistics->sites_.Insert(site);
+  }
+  site->count++;
+  if (is_lazy) {
+    site->lazy_count++;
+  }
+  key.function->deoptimizations++;
+  statistics->deoptimizations_++;
+}
+
+void DeoptStatistics::RecordOptimization(Thread* thread,
+                                         const Function& function) {
+  // Only functions which were deoptimized before are reoptimized. Checking
+  // the counter first keeps the common case free of name lookups.
+  if (function.deoptimization_counter() == 0) return;
+  Get(thread)->LookupFunction(function)->reoptimizations++;
+}
+
+// Sorts in descending order.
+static int CompareCounts(intptr_t a, intptr_t b) {
+  return (a < b) ? 1 : ((a > b) ? -1 : 0);
+}
+
+void DeoptStatistics::PrintJSON(Thread* thread, JSONStream* js, bool reset) {
+  DeoptStatistics* statistics = Get(thread);
+  Zone* zone = thread->zone();
+
+  JSONObject obj(js);
+  obj.AddProperty("type", "_DeoptimizationStatistics");
+  obj.AddProperty("deoptimizations", statistics->deoptimizations_);
+  {
+    GrowableArray<Site*> sites(zone, statistics->sites_.Length());
+    auto it = statistics->sites_.GetIterator();
+    for (Site** site = it.Next(); site != nullptr; site = it.Next()) {
+      sites.Add(*site);
+    }
+    sites.Sort([](Site* const* a, Site* const* b) {
+      return CompareCounts((*a)->count, (*b)->count);
+    });
+    JSONArray array(&obj, "sites");
+    for (intptr_t i = 0; i < sites.length(); i++) {
+      const Site* site = sites[i];
+      JSONObject entry(&array);
+      entry.AddProperty("function", site->function->name);
+      if (site->site_function != site->function) {
+        entry.AddProperty("inlinedFunction", site->site_function->name);
+      }
+      entry.AddProperty("deoptId", site->deopt_id);
+      entry.AddProperty("reason", DeoptReasonToCString(site->reason));
+      entry.AddProperty("count", site->count);
+      entry.AddProperty("lazyCount", site->lazy_count);
+    }
+  }
+  {
+    GrowableArray<FunctionEntry*> functions(zone, 16);
+    auto it = statistics->functions_.GetIterator();
+    for (FunctionEntry** function = it.Next(); function != nullptr;
+         function = it.Next()) {
+      if ((*function)->reoptimizations > 0) {
+        functions.Add(*function);
+      }
+    }
+    functions.Sort([](FunctionEntry* const* a, FunctionEntry* const* b) {
+      return CompareCounts((*a)->reoptimizations, (*b)->reoptimizations);
+    });
+    JSONArray array(&obj, "reoptimizedFunctions");
+    for (intptr_t i = 0; i < functions.length(); i++) {
+      const FunctionEntry* function = functions[i];
+      JSONObject entry(&array);
+      entry.AddProperty("function", function->name);
+      entry.AddProperty("deoptimizations", function->deoptimizations);
+      entry.AddProperty("reoptimizations", function->reoptimizations);
+    }
+  }
+
+  if (reset) {
+    statistics->Clear();
+  }
+}
+
+void DeoptStatistics::Clear() {
+  {
+    auto it = sites_.GetIterator();
+    for (Site** site = it.Next(); site != nullptr; site = it.Next()) {
+      delete *site;
+    }
+    sites_.Clear();
+  }
+  {
+    auto it = functions_.GetIterator();
+    for (FunctionEntry** function = it.Next(); function != nullptr;
+         function = it.Next()) {
+      free((*function)->name);
+      delete *function;
+    }
+    functions_.Clear();
+  }
+  deoptimizations_ = 0;
+}
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
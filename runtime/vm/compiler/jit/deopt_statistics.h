@@ -0,0 +1,111 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_JIT_DEOPT_STATISTICS_H_
+#define RUNTIME_VM_COMPILER_JIT_DEOPT_STATISTICS_H_
+
+#include "vm/allocation.h"
+#include "vm/hash_map.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class JSONStream;
+class Thread;
+
+#if !defined(PRODUCT)
+
+// Counts the deoptimizations of an isolate per optimized function, deopt
+// reason and deopt site, and how often deoptimized functions are optimized
+// again, for the _getDeoptimizationStatistics service RPC.
+//
+// A deopt site is the deopt-id in the innermost (possibly inlined) function
+// of the deoptimization environment. Functions are identified by their fully
+// qualified name, since functions can move during GC.
+//
+// Only accessed on the mutator thread or at a safepoint.
+class DeoptStatistics {
+ public:
+  ~DeoptStatistics();
+
+  // Called when [code] of [function] is deoptimized at [deopt_id] of
+  // [site_function], which is [function] itself unless the deopt site is in
+  // inlined code.
+  static void RecordDeoptimization(Thread* thread,
+                                   const Function& function,
+                                   const Function& site_function,
+                                   intptr_t deopt_id,
+                                   ICData::DeoptReasonId reason,
+                                   bool is_lazy);
+
+  // Called when optimized code is installed for [function].
+  static void RecordOptimization(Thread* thread, const Function& function);
+
+  // Prints the deopt sites sorted by count and the functions which were
+  // optimized again after being deoptimized. Clears the statistics
+  // afterwards if [reset] is true.
+  static void PrintJSON(Thread* thread, JSONStream* js, bool reset);
+
+ private:
+  struct FunctionEntry {
+    char* name;
+    uint32_t hash;
+    intptr_t deoptimizations;
+    intptr_t reoptimizations;
+  };
+
+  struct Site {
+    // Interned in [functions_], so they are compared by identity.
+    FunctionEntry* function;
+    FunctionEntry* site_function;
+    intptr_t deopt_id;
+    ICData::DeoptReasonId reason;
+    uint32_t hash;
+    intptr_t count;
+    intptr_t lazy_count;
+  };
+
+  class FunctionKeyValueTrait {
+   public:
+    typedef const char* Key;
+    typedef FunctionEntry* Value;
+    typedef FunctionEntry* Pair;
+
+    static Key KeyOf(Pair kv) { return kv->name; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static intptr_t Hashcode(Key key);
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  class SiteKeyValueTrait {
+   public:
+    typedef const Site* Key;
+    typedef Site* Value;
+    typedef Site* Pair;
+
+    static Key KeyOf(Pair kv) { return kv; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static intptr_t Hashcode(Key key) { return key->hash; }
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  DeoptStatistics() : deoptimizations_(0) {}
+
+  static DeoptStatistics* Get(Thread* thread);
+
+  FunctionEntry* LookupFunction(const Function& function);
+  void Clear();
+
+  MallocDirectChainedHashMap<FunctionKeyValueTrait> functions_;
+  MallocDirectChainedHashMap<SiteKeyValueTrait> sites_;
+  intptr_t deoptimizations_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptStatistics);
+};
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_JIT_DEOPT_STATISTICS_H_
@@ -27,6 +27,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            guarded_devirtualization_threshold,
+            90,
+            "Percentage of the calls at a polymorphic call site which must go "
+            "to one target for the site to be specialized for its receivers "
+            "under a deoptimizing class check. 0 disables.");
+
 // Quick access to the current isolate and zone.
 #define I (isolate())
 #define Z (zone())
@@ -64,6 +71,49 @@ void JitCallSpecializer::ReplaceWithStaticCall(InstanceCallInstr* instr,
   instr->ReplaceWith(call, current_iterator());
 }
 
+bool JitCallSpecializer::TryGuardedDevirtualization(
+    InstanceCallInstr* instr,
+    const CallTargets& targets) {
+  if ((FLAG_guarded_devirtualization_threshold <= 0) ||
+      !FLAG_polymorphic_with_deopt || (targets.length() < 2)) {
+    return false;
+  }
+  // A guard of this site has failed before, keep it polymorphic.
+  if (instr->ic_data()->HasDeoptReason(ICData::kDeoptCheckClass) ||
+      !speculative_policy_->IsAllowedForInlining(instr->deopt_id())) {
+    return false;
+  }
+
+  // Targets are sorted by frequency.
+  const TargetInfo& dominant = *targets.TargetAt(0);
+  const intptr_t total = targets.AggregateCallCount();
+  if ((total <= 0) || (dominant.count * 100 <
+                       FLAG_guarded_devirtualization_threshold * total)) {
+    return false;
+  }
+  const Function& target = *dominant.target;
+  if (MethodRecognizer::PolymorphicTarget(target) ||
+      (target.recognized_kind() == MethodRecognizer::kObjectRuntimeType)) {
+    return false;
+  }
+
+  if (FLAG_trace_optimization) {
+    THR_Print("Guarded devirtualization of %s to %s (%" Pd "/%" Pd ")\n",
+              instr->function_name().ToCString(), target.ToCString(),
+              dominant.count, total);
+  }
+  Cids* cids = new (Z) Cids(Z);
+  cids->Add(new (Z) CidRange(dominant.cid_start, dominant.cid_end));
+  Instruction* check = flow_graph()->CreateCheckClass(
+      instr->Receiver()->definition(), *cids, instr->deopt_id(),
+      instr->token_pos());
+  InsertBefore(instr, check, instr->env(), FlowGraph::kEffect);
+  // Call can still deoptimize, do not detach environment from instr.
+  StaticCallInstr* call = StaticCallInstr::FromCall(Z, instr, target);
+  instr->ReplaceWith(call, current_iterator());
+  return true;
+}
+
 // Tries to optimize instance call by replacing it with a faster instruction
 // (e.g, binary op, field load, ..).
 // TODO(dartbug.com/30635) Evaluate how much this can be shared with
@@ -148,6 +198,13 @@ void JitCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     }
   }
 
+  // If most calls go to one target, check for its receiver classes and call
+  // it directly, so that it can be inlined. A failing check deoptimizes and
+  // marks the call site, which is compiled as a polymorphic call afterwards.
+  if (!has_one_target && TryGuardedDevirtualization(instr, targets)) {
+    return;
+  }
+
   // If there is only one target we can make this into a deopting class check,
   // followed by a call instruction that does not check the class of the
   // receiver.  This enables a lot of optimizations because after the class
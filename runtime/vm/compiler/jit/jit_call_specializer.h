@@ -35,6 +35,12 @@ class JitCallSpecializer : public CallSpecializer {
       const GrowableArray<LocalVariable*>& context_variables,
       Value* context_value);
 
+  // Replaces a polymorphic [instr] whose calls mostly go to the first of
+  // [targets] by a class check for the receivers of that target and a static
+  // call of it. Returns false if the site does not qualify.
+  bool TryGuardedDevirtualization(InstanceCallInstr* instr,
+                                  const CallTargets& targets);
+
   void ReplaceWithStaticCall(InstanceCallInstr* instr,
                              const ICData& unary_checks,
                              const Function& target);
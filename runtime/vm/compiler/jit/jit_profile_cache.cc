@@ -0,0 +1,184 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/jit/jit_profile_cache.h"
+
+#include "platform/text_buffer.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+DEFINE_FLAG(charp,
+            jit_profile_cache,
+            nullptr,
+            "Remember the functions optimized by this program in the given "
+            "file and optimize them early in the next run.");
+
+DEFINE_FLAG(charp,
+            write_startup_order_to,
+            nullptr,
+            "Write the functions of this program in the order in which they "
+            "were first compiled to the given file, for use with "
+            "--instructions_order when generating an AOT snapshot.");
+
+DECLARE_FLAG(int, optimization_counter_threshold);
+
+intptr_t JitProfileCache::CStringKeyValueTrait::Hashcode(Key key) {
+  return String::Hash(key, strlen(key));
+}
+
+bool JitProfileCache::CStringKeyValueTrait::IsKeyEqual(Pair kv, Key key) {
+  return strcmp(kv, key) == 0;
+}
+
+JitProfileCache::~JitProfileCache() {
+  free(buffer_);
+}
+
+uint32_t JitProfileCache::ProgramHash(Thread* thread) {
+  Zone* zone = thread->zone();
+  const auto& root = Library::Handle(
+      zone, thread->isolate()->object_store()->root_library());
+  if (root.IsNull()) return 0;
+  const auto& kernel_data =
+      ExternalTypedData::Handle(zone, root.kernel_data());
+  if (kernel_data.IsNull()) return 0;
+
+  NoSafepointScope no_safepoint;
+  const uint8_t* data =
+      reinterpret_cast<const uint8_t*>(kernel_data.DataAddr(0));
+  const intptr_t length = kernel_data.LengthInBytes();
+  uint32_t hash = static_cast<uint32_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    hash = CombineHashes(hash, data[i]);
+  }
+  return FinalizeHash(hash, kBitsPerInt32 - 1);
+}
+
+JitProfileCache* JitProfileCache::Load(Thread* thread) {
+  auto cache = new JitProfileCache(nullptr);
+
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    return cache;
+  }
+  void* file = file_open(FLAG_jit_profile_cache, /*write=*/false);
+  if (file == nullptr) return cache;
+  uint8_t* data = nullptr;
+  intptr_t length = 0;
+  file_read(&data, &length, file);
+  file_close(file);
+  if (data == nullptr) return cache;
+
+  cache->buffer_ = reinterpret_cast<char*>(malloc(length + 1));
+  memmove(cache->buffer_, data, length);
+  cache->buffer_[length] = '\0';
+  free(data);
+
+  // The first line is the hash of the program which wrote the file, every
+  // other line the name of an optimized function.
+  char* line = cache->buffer_;
+  bool is_header = true;
+  while (*line != '\0') {
+    char* end = strchr(line, '\n');
+    if (end == nullptr) break;
+    *end = '\0';
+    if (is_header) {
+      char* hash_end = nullptr;
+      const uint32_t hash = strtoul(line, &hash_end, 16);
+      if ((hash_end == line) || (hash != ProgramHash(thread))) break;
+      is_header = false;
+    } else if (*line != '\0') {
+      cache->names_.Insert(line);
+    }
+    line = end + 1;
+  }
+  return cache;
+}
+
+void JitProfileCache::FunctionCompiled(Thread* thread,
+                                       const Function& function) {
+  if (((FLAG_jit_profile_cache == nullptr) &&
+       (FLAG_write_startup_order_to == nullptr)) ||
+      !thread->IsMutatorThread()) {
+    return;
+  }
+  Isolate* isolate = thread->isolate();
+  if (isolate->jit_profile_cache() == nullptr) {
+    isolate->set_jit_profile_cache((FLAG_jit_profile_cache != nullptr)
+                                       ? Load(thread)
+                                       : new JitProfileCache(nullptr));
+  }
+  JitProfileCache* cache = isolate->jit_profile_cache();
+  if (FLAG_write_startup_order_to != nullptr) {
+    cache->startup_order_.Printf("%s\n", function.ToQualifiedCString());
+  }
+  if (cache->names_.IsEmpty() || !function.IsOptimizable()) return;
+
+  if (cache->Contains(function.ToQualifiedCString()) &&
+      (function.usage_counter() < FLAG_optimization_counter_threshold)) {
+    function.SetUsageCounter(FLAG_optimization_counter_threshold);
+  }
+}
+
+void JitProfileCache::WriteFile(const char* path, TextBuffer* buffer) {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    return;
+  }
+  void* file = file_open(path, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("Failed to open file %s\n", path);
+    return;
+  }
+  file_write(buffer->buf(), buffer->length(), file);
+  file_close(file);
+}
+
+void JitProfileCache::Save(Thread* thread) {
+  JitProfileCache* cache = thread->isolate()->jit_profile_cache();
+  if ((FLAG_write_startup_order_to != nullptr) && (cache != nullptr)) {
+    WriteFile(FLAG_write_startup_order_to, &cache->startup_order_);
+  }
+  if (FLAG_jit_profile_cache == nullptr) return;
+
+  class OptimizedFunctionsVisitor : public FunctionVisitor {
+   public:
+    explicit OptimizedFunctionsVisitor(TextBuffer* buffer)
+        : buffer_(buffer) {}
+
+    void Visit(const Function& function) {
+      if (function.HasOptimizedCode()) {
+        buffer_->Printf("%s\n", function.ToQualifiedCString());
+      }
+    }
+
+   private:
+    TextBuffer* buffer_;
+  };
+
+  TextBuffer buffer(64 * KB);
+  buffer.Printf("%08x\n", ProgramHash(thread));
+  OptimizedFunctionsVisitor visitor(&buffer);
+  ProgramVisitor::VisitFunctions(&visitor);
+  WriteFile(FLAG_jit_profile_cache, &buffer);
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
@@ -0,0 +1,82 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_JIT_JIT_PROFILE_CACHE_H_
+#define RUNTIME_VM_COMPILER_JIT_JIT_PROFILE_CACHE_H_
+
+#include "platform/text_buffer.h"
+#include "vm/allocation.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class Function;
+class Thread;
+
+// An on-disk record of the functions which a previous run of the same program
+// optimized, enabled with --jit_profile_cache=<file>.
+//
+// The file starts with a hash of the root library's kernel binary: a file
+// written for a different program is ignored. When a function listed in the
+// file gets its unoptimized code, its usage counter is set to the
+// optimization threshold, so it is optimized on its next invocation instead
+// of after warming up again. The optimized code itself is still generated in
+// this process and thus validated against the current class hierarchy and
+// field guards like any other optimized code.
+//
+// With --write_startup_order_to=<file> the functions are also recorded in
+// the order in which they first got code, which gen_snapshot can use to lay
+// out the startup code of an AOT snapshot together.
+class JitProfileCache {
+ public:
+  ~JitProfileCache();
+
+  // Called after [function] got unoptimized code on the mutator thread.
+  static void FunctionCompiled(Thread* thread, const Function& function);
+
+  // Writes the functions of the current isolate which have optimized code
+  // to the cache file.
+  static void Save(Thread* thread);
+
+ private:
+  class CStringKeyValueTrait {
+   public:
+    typedef const char* Key;
+    typedef const char* Value;
+    typedef const char* Pair;
+
+    static Key KeyOf(Pair kv) { return kv; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static intptr_t Hashcode(Key key);
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  explicit JitProfileCache(char* buffer)
+      : buffer_(buffer), startup_order_(4 * KB) {}
+
+  // Reads the cache file of the current isolate. Returns nullptr if there is
+  // no usable file.
+  static JitProfileCache* Load(Thread* thread);
+
+  // A hash of the kernel binary of the root library.
+  static uint32_t ProgramHash(Thread* thread);
+
+  static void WriteFile(const char* path, TextBuffer* buffer);
+
+  bool Contains(const char* name) const {
+    return names_.LookupValue(name) != nullptr;
+  }
+
+  // The file contents, [names_] points into it.
+  char* buffer_;
+  MallocDirectChainedHashMap<CStringKeyValueTrait> names_;
+  // The functions in the order in which they first got code.
+  TextBuffer startup_order_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitProfileCache);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_JIT_JIT_PROFILE_CACHE_H_
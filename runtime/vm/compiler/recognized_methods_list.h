@@ -61,6 +61,29 @@ namespace dart {
   V(_Float32x4ArrayView, ., TypedData_Float32x4ArrayView_factory, 0x0)         \
   V(_Int32x4ArrayView, ., TypedData_Int32x4ArrayView_factory, 0x0)             \
   V(_Float64x2ArrayView, ., TypedData_Float64x2ArrayView_factory, 0x0)         \
+  V(::, _loadInt8, FfiLoadInt8, 0x0)                                           \
+  V(::, _loadInt16, FfiLoadInt16, 0x0)                                         \
+  V(::, _loadInt32, FfiLoadInt32, 0x0)                                         \
+  V(::, _loadInt64, FfiLoadInt64, 0x0)                                         \
+  V(::, _loadUint8, FfiLoadUint8, 0x0)                                         \
+  V(::, _loadUint16, FfiLoadUint16, 0x0)                                       \
+  V(::, _loadUint32, FfiLoadUint32, 0x0)                                       \
+  V(::, _loadUint64, FfiLoadUint64, 0x0)                                       \
+  V(::, _loadIntPtr, FfiLoadIntPtr, 0x0)                                       \
+  V(::, _loadFloat, FfiLoadFloat, 0x0)                                         \
+  V(::, _loadDouble, FfiLoadDouble, 0x0)                                       \
+  V(::, _storeInt8, FfiStoreInt8, 0x0)                                         \
+  V(::, _storeInt16, FfiStoreInt16, 0x0)                                       \
+  V(::, _storeInt32, FfiStoreInt32, 0x0)                                       \
+  V(::, _storeInt64, FfiStoreInt64, 0x0)                                       \
+  V(::, _storeUint8, FfiStoreUint8, 0x0)                                       \
+  V(::, _storeUint16, FfiStoreUint16, 0x0)                                     \
+  V(::, _storeUint32, FfiStoreUint32, 0x0)                                     \
+  V(::, _storeUint64, FfiStoreUint64, 0x0)                                     \
+  V(::, _storeIntPtr, FfiStoreIntPtr, 0x0)                                     \
+  V(::, _storeFloat, FfiStoreFloat, 0x0)                                       \
+  V(::, _storeDouble, FfiStoreDouble, 0x0)                                     \
+  V(Pointer, get:address, FfiGetAddress, 0x0)                                  \
   V(::, _toClampedUint8, ConvertIntToClampedUint8, 0x564b0435)                 \
   V(_StringBase, _interpolate, StringBaseInterpolate, 0x01ecb15a)              \
   V(_IntegerImplementation, toDouble, IntegerToDouble, 0x05da96ed)             \
@@ -174,6 +197,7 @@ namespace dart {
   V(_Double, _mulFromInteger, Double_mulFromInteger, 0x2017fcf6)               \
   V(_Double, .fromInteger, DoubleFromInteger, 0x6d234f4b)                      \
   V(_GrowableList, .withData, GrowableArray_Allocate, 0x28b2138e)              \
+  V(_GrowableList, get:_data, GrowableArrayData, 0x0)                          \
   V(_RegExp, _ExecuteMatch, RegExp_ExecuteMatch, 0x380184b1)                   \
   V(_RegExp, _ExecuteMatchSticky, RegExp_ExecuteMatchSticky, 0x79b8f955)       \
   V(Object, ==, ObjectEquals, 0x7b32a55a)                                      \
@@ -183,6 +207,7 @@ namespace dart {
   V(_StringBase, get:_identityHashCode, String_identityHash, 0x0472b1d8)       \
   V(_StringBase, get:isEmpty, StringBaseIsEmpty, 0x4a8b29c8)                   \
   V(_StringBase, _substringMatches, StringBaseSubstringMatches, 0x46de4f10)    \
+  V(_StringBase, compareTo, StringBaseCompareTo, 0x0)                          \
   V(_StringBase, [], StringBaseCharAt, 0x7cbb8603)                             \
   V(_OneByteString, get:hashCode, OneByteString_getHashCode, 0x78c3d446)       \
   V(_OneByteString, _substringUncheckedNative,                                 \
@@ -190,6 +215,7 @@ namespace dart {
   V(_OneByteString, _setAt, OneByteStringSetAt, 0x11ffddd1)                    \
   V(_OneByteString, _allocate, OneByteString_allocate,          0x74933376)    \
   V(_OneByteString, ==, OneByteString_equality, 0x4eda197e)                    \
+  V(_OneByteString, _indexOfCodeUnit, OneByteString_indexOfCodeUnit, 0x0)      \
   V(_TwoByteString, ==, TwoByteString_equality, 0x4eda197e)                    \
   V(_Type, get:hashCode, Type_getHashCode, 0x18d1523f)                         \
   V(::, _getHash, Object_getHash, 0x2827856d)                                  \
@@ -379,6 +405,7 @@ namespace dart {
   V(_ByteDataView, get:length, ByteDataViewLength, 0x0)          \
   V(_GrowableList, get:length, GrowableArrayLength, 0x18dd86b4)                \
   V(_GrowableList, get:_capacity, GrowableArrayCapacity, 0x2e04be60)           \
+  V(_GrowableList, get:_data, GrowableArrayData, 0x0)                          \
   V(_GrowableList, add, GrowableListAdd, 0x40b490b8)                           \
   V(_GrowableList, removeLast, GrowableListRemoveLast, 0x007855e5)             \
   V(_StringBase, get:length, StringBaseLength, 0x2a2d03d1)                     \
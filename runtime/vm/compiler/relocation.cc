@@ -21,6 +21,12 @@ DEFINE_FLAG(bool,
             false,
             "Generate always trampolines (for testing purposes).");
 
+DEFINE_FLAG(bool,
+            order_code_by_call_graph,
+            true,
+            "Place callees next to their callers in the .text segment to "
+            "avoid trampolines.");
+
 // The trampolines will have a 1-word object header in front of them.
 const intptr_t kOffsetInTrampoline = kWordSize;
 const intptr_t kTrampolineSize = OS::kMaxPreferredCodeAlignment;
@@ -48,9 +54,17 @@ void CodeRelocator::Relocate(bool is_vm_isolate) {
   //
   FindInstructionAndCallLimits();
 
+  GrowableArray<RawCode*> order(zone, code_objects_->length());
+  if (FLAG_order_code_by_call_graph) {
+    OrderCodeObjectsByCallGraph(&order);
+  } else {
+    order.AddArray(*code_objects_);
+  }
+  ASSERT(order.length() == code_objects_->length());
+
   // Emit all instructions and do relocations on the way.
-  for (intptr_t i = 0; i < code_objects_->length(); ++i) {
-    current_caller = (*code_objects_)[i];
+  for (intptr_t i = 0; i < order.length(); ++i) {
+    current_caller = order[i];
 
     const intptr_t code_text_offset = next_text_offset_;
     if (!AddInstructionsToText(current_caller.raw())) {
@@ -172,6 +186,73 @@ void CodeRelocator::FindInstructionAndCallLimits() {
   }
 }
 
+void CodeRelocator::OrderCodeObjectsByCallGraph(
+    GrowableArray<RawCode*>* order) {
+  Zone* zone = Thread::Current()->zone();
+  auto& caller = Code::Handle(zone);
+  auto& call_targets = Array::Handle(zone);
+  const intptr_t num_code_objects = code_objects_->length();
+
+  // The index of the first code object using an instructions object.
+  InstructionsPosition index_of_instructions;
+  GrowableArray<bool> placed(zone, num_code_objects);
+  for (intptr_t i = 0; i < num_code_objects; ++i) {
+    RawInstructions* instructions = Code::InstructionsOf((*code_objects_)[i]);
+    if (!index_of_instructions.HasKey(instructions)) {
+      index_of_instructions.Insert({instructions, i});
+    }
+    placed.Add(false);
+  }
+
+  // Lay out the call graph depth-first starting from the code objects in
+  // their original order, so that a caller is followed by its (first)
+  // callee and call chains end up close together. Forward calls to code
+  // emitted shortly after the caller never need a trampoline.
+  GrowableArray<intptr_t> worklist(zone, 64);
+  GrowableArray<intptr_t> callees(zone, 16);
+  for (intptr_t root = 0; root < num_code_objects; ++root) {
+    worklist.Add(root);
+    while (!worklist.is_empty()) {
+      const intptr_t index = worklist.RemoveLast();
+      if (placed[index]) continue;
+      placed[index] = true;
+      order->Add((*code_objects_)[index]);
+
+      caller = (*code_objects_)[index];
+      call_targets = caller.static_calls_target_table();
+      if (call_targets.IsNull()) continue;
+
+      callees.Clear();
+      StaticCallsTable calls(call_targets);
+      for (auto call : calls) {
+        kind_type_and_offset_ = call.Get<Code::kSCallTableKindAndOffset>();
+        auto kind = Code::KindField::decode(kind_type_and_offset_.Value());
+        if (kind == Code::kCallViaCode) {
+          continue;
+        }
+
+        target_ = call.Get<Code::kSCallTableFunctionTarget>();
+        if (target_.IsFunction()) {
+          destination_ = Function::Cast(target_).CurrentCode();
+        } else {
+          target_ = call.Get<Code::kSCallTableCodeTarget>();
+          destination_ = Code::Cast(target_).raw();
+        }
+
+        auto entry =
+            index_of_instructions.Lookup(destination_.instructions());
+        if ((entry != nullptr) && !placed[entry->value]) {
+          callees.Add(entry->value);
+        }
+      }
+      // Push in reverse so that the first callee is placed next.
+      for (intptr_t i = callees.length() - 1; i >= 0; --i) {
+        worklist.Add(callees[i]);
+      }
+    }
+  }
+}
+
 bool CodeRelocator::AddInstructionsToText(RawCode* code) {
   RawInstructions* instructions = Code::InstructionsOf(code);
 
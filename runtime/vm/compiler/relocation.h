@@ -154,6 +154,10 @@ class CodeRelocator : public StackResource {
 
   void FindInstructionAndCallLimits();
 
+  // Computes the order in which the code objects are emitted into the
+  // ".text" segment.
+  void OrderCodeObjectsByCallGraph(GrowableArray<RawCode*>* order);
+
   bool AddInstructionsToText(RawCode* code);
   void ScanCallTargets(const Code& code,
                        const Array& call_targets,
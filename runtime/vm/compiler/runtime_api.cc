@@ -305,7 +305,14 @@ intptr_t Class::InstanceSize(const dart::Class& klass) {
 }
 
 bool Class::TraceAllocation(const dart::Class& klass) {
-  return klass.TraceAllocation(dart::Isolate::Current());
+  dart::Isolate* isolate = dart::Isolate::Current();
+#if !defined(PRODUCT)
+  // Pretenured classes also need their instances allocated by the runtime.
+  if (isolate->class_table()->ShouldPretenure(klass.id())) {
+    return true;
+  }
+#endif  // !defined(PRODUCT)
+  return klass.TraceAllocation(isolate);
 }
 
 word Instance::first_field_offset() {
@@ -492,6 +499,7 @@ word Array::header_size() {
   V(Thread, marking_stack_block_offset)                                        \
   V(Thread, no_scope_native_wrapper_entry_point_offset)                        \
   V(Thread, object_null_offset)                                                \
+  V(Thread, poll_page_offset)                                                  \
   V(Thread, predefined_symbols_address_offset)                                 \
   V(Thread, resume_pc_offset)                                                  \
   V(Thread, store_buffer_block_offset)                                         \
@@ -571,6 +579,14 @@ word Thread::monomorphic_miss_entry_offset() {
   return dart::Thread::monomorphic_miss_entry_offset();
 }
 
+word Thread::megamorphic_call_checked_entry_offset() {
+  return dart::Thread::megamorphic_call_checked_entry_offset();
+}
+
+word Thread::ic_call_through_function_entry_offset() {
+  return dart::Thread::ic_call_through_function_entry_offset();
+}
+
 word Thread::write_barrier_mask_offset() {
   return dart::Thread::write_barrier_mask_offset();
 }
@@ -760,8 +776,8 @@ word Context::header_size() {
 }
 
 #if !defined(PRODUCT)
-word ClassHeapStats::TraceAllocationMask() {
-  return dart::ClassHeapStats::TraceAllocationMask();
+word ClassHeapStats::AllocationSlowPathMask() {
+  return dart::ClassHeapStats::AllocationSlowPathMask();
 }
 
 word ClassHeapStats::state_offset() {
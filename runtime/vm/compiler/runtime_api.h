@@ -569,6 +569,8 @@ class Thread : public AllStatic {
   static word null_error_shared_without_fpu_regs_entry_point_offset();
   static word write_barrier_mask_offset();
   static word monomorphic_miss_entry_offset();
+  static word megamorphic_call_checked_entry_offset();
+  static word ic_call_through_function_entry_offset();
   static word write_barrier_wrappers_thread_offset(intptr_t regno);
   static word array_write_barrier_entry_point_offset();
   static word write_barrier_entry_point_offset();
@@ -576,6 +578,7 @@ class Thread : public AllStatic {
   static uword vm_tag_compiled_id();
 
   static word safepoint_state_offset();
+  static word poll_page_offset();
   static uword safepoint_state_unacquired();
   static uword safepoint_state_acquired();
 
@@ -677,7 +680,7 @@ class ClassTable : public AllStatic {
 #if !defined(PRODUCT)
 class ClassHeapStats : public AllStatic {
  public:
-  static word TraceAllocationMask();
+  static word AllocationSlowPathMask();
   static word state_offset();
   static word allocated_since_gc_new_space_offset();
   static word allocated_size_since_gc_new_space_offset();
@@ -3032,11 +3032,21 @@ void StubCodeCompiler::GenerateOptimizedIdenticalWithNumberCheckStub(
 
 // Called from megamorphic calls.
 //  R0: receiver
-//  R9: MegamorphicCache (preserved)
+//  R9: MegamorphicCache, or ICData before a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code
 //  R4: arguments descriptor
 void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
+  if (!FLAG_precompiled_mode) {
+    // The call site may have switched from the IC stub to this stub after the
+    // target was loaded but before the data was, leaving the data an ICData
+    // (see CodePatcher::PatchSwitchableCallAt). Only the JIT switches.
+    __ CompareClassId(R9, kICDataCid, R8);
+    __ Branch(
+        Address(THR, target::Thread::ic_call_through_function_entry_offset()),
+        EQ);
+  }
+
   __ LoadTaggedClassIdMayBeSmi(R0, R0);
   // R0: receiver cid as Smi.
   __ ldr(R2, FieldAddress(R9, target::MegamorphicCache::buckets_offset()));
@@ -3095,12 +3105,19 @@ void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
 
 // Called from switchable IC calls.
 //  R0: receiver
-//  R9: ICData (preserved)
+//  R9: ICData, or MegamorphicCache after a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code object
 //  R4: arguments descriptor
 void StubCodeCompiler::GenerateICCallThroughFunctionStub(Assembler* assembler) {
   Label loop, found, miss;
+  // The call site may have switched to megamorphic after this stub was
+  // loaded but before the data was (see CodePatcher::PatchSwitchableCallAt).
+  __ CompareClassId(R9, kMegamorphicCacheCid, R8);
+  __ Branch(
+      Address(THR, target::Thread::megamorphic_call_checked_entry_offset()),
+      EQ);
+
   __ ldr(ARGS_DESC_REG,
          FieldAddress(R9, target::ICData::arguments_descriptor_offset()));
   __ ldr(R8, FieldAddress(R9, target::ICData::entries_offset()));
@@ -3098,11 +3098,25 @@ void StubCodeCompiler::GenerateOptimizedIdenticalWithNumberCheckStub(
 
 // Called from megamorphic calls.
 //  R0: receiver
-//  R5: MegamorphicCache (preserved)
+//  R5: MegamorphicCache, or ICData before a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code
 //  R4: arguments descriptor
 void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
+  if (!FLAG_precompiled_mode) {
+    // The call site may have switched from the IC stub to this stub after the
+    // target was loaded but before the data was, leaving the data an ICData
+    // (see CodePatcher::PatchSwitchableCallAt). Only the JIT switches.
+    Label is_megamorphic_cache;
+    __ CompareClassId(R5, kICDataCid);
+    __ b(&is_megamorphic_cache, NE);
+    __ ldr(R1,
+           Address(THR,
+                   target::Thread::ic_call_through_function_entry_offset()));
+    __ br(R1);
+    __ Bind(&is_megamorphic_cache);
+  }
+
   // Jump if receiver is a smi.
   Label smi_case;
   __ BranchIfSmi(R0, &smi_case);
@@ -3179,12 +3193,17 @@ void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
 
 // Called from switchable IC calls.
 //  R0: receiver
-//  R5: ICData (preserved)
+//  R5: ICData, or MegamorphicCache after a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code object
 //  R4: arguments descriptor
 void StubCodeCompiler::GenerateICCallThroughFunctionStub(Assembler* assembler) {
-  Label loop, found, miss;
+  Label loop, found, miss, megamorphic;
+  // The call site may have switched to megamorphic after this stub was
+  // loaded but before the data was (see CodePatcher::PatchSwitchableCallAt).
+  __ CompareClassId(R5, kMegamorphicCacheCid);
+  __ b(&megamorphic, EQ);
+
   __ ldr(ARGS_DESC_REG,
          FieldAddress(R5, target::ICData::arguments_descriptor_offset()));
   __ ldr(R8, FieldAddress(R5, target::ICData::entries_offset()));
@@ -3219,6 +3238,11 @@ void StubCodeCompiler::GenerateICCallThroughFunctionStub(Assembler* assembler) {
   __ ldr(CODE_REG, Address(R2, target::Isolate::ic_miss_code_offset()));
   __ ldr(R1, FieldAddress(CODE_REG, target::Code::entry_point_offset()));
   __ br(R1);
+
+  __ Bind(&megamorphic);
+  __ ldr(R1,
+         Address(THR, target::Thread::megamorphic_call_checked_entry_offset()));
+  __ br(R1);
 }
 
 void StubCodeCompiler::GenerateICCallThroughCodeStub(Assembler* assembler) {
@@ -3096,11 +3096,23 @@ void StubCodeCompiler::GenerateOptimizedIdenticalWithNumberCheckStub(
 
 // Called from megamorphic calls.
 //  RDX: receiver
-//  RBX: target::MegamorphicCache (preserved)
+//  RBX: target::MegamorphicCache, or ICData before a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code
 //  R10: arguments descriptor
 void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
+  if (!FLAG_precompiled_mode) {
+    // The call site may have switched from the IC stub to this stub after the
+    // target was loaded but before the data was, leaving the data an ICData
+    // (see CodePatcher::PatchSwitchableCallAt). Only the JIT switches.
+    Label is_megamorphic_cache;
+    __ CompareClassId(RBX, kICDataCid);
+    __ j(NOT_EQUAL, &is_megamorphic_cache, Assembler::kNearJump);
+    __ jmp(
+        Address(THR, target::Thread::ic_call_through_function_entry_offset()));
+    __ Bind(&is_megamorphic_cache);
+  }
+
   // Jump if receiver is a smi.
   Label smi_case;
   __ testq(RDX, Immediate(kSmiTagMask));
@@ -3177,12 +3189,17 @@ void StubCodeCompiler::GenerateMegamorphicCallStub(Assembler* assembler) {
 
 // Called from switchable IC calls.
 //  RDX: receiver
-//  RBX: ICData (preserved)
+//  RBX: ICData, or MegamorphicCache after a transition (preserved)
 // Passed to target:
 //  CODE_REG: target Code object
 //  R10: arguments descriptor
 void StubCodeCompiler::GenerateICCallThroughFunctionStub(Assembler* assembler) {
-  Label loop, found, miss;
+  Label loop, found, miss, megamorphic;
+  // The call site may have switched to megamorphic after this stub was
+  // loaded but before the data was (see CodePatcher::PatchSwitchableCallAt).
+  __ CompareClassId(RBX, kMegamorphicCacheCid);
+  __ j(EQUAL, &megamorphic);
+
   __ movq(R13, FieldAddress(RBX, target::ICData::entries_offset()));
   __ movq(R10,
           FieldAddress(RBX, target::ICData::arguments_descriptor_offset()));
@@ -3219,6 +3236,9 @@ void StubCodeCompiler::GenerateICCallThroughFunctionStub(Assembler* assembler) {
   __ movq(CODE_REG, Address(RAX, target::Isolate::ic_miss_code_offset()));
   __ movq(RCX, FieldAddress(CODE_REG, target::Code::entry_point_offset()));
   __ jmp(RCX);
+
+  __ Bind(&megamorphic);
+  __ jmp(Address(THR, target::Thread::megamorphic_call_checked_entry_offset()));
 }
 
 void StubCodeCompiler::GenerateICCallThroughCodeStub(Assembler* assembler) {
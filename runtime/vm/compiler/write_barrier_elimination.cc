@@ -0,0 +1,232 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/write_barrier_elimination.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+
+namespace dart {
+
+class WriteBarrierElimination : public ValueObject {
+ public:
+  WriteBarrierElimination(Zone* zone, FlowGraph* flow_graph)
+      : zone_(zone),
+        flow_graph_(flow_graph),
+        allocation_index_(zone, flow_graph->current_ssa_temp_index()),
+        allocations_(zone, 16),
+        in_(zone, flow_graph->postorder().length()),
+        out_(zone, flow_graph->postorder().length()),
+        volatile_(NULL) {}
+
+  void Run();
+
+ private:
+  // Assigns a dense index to every allocation whose result may be known to
+  // be new or remembered. Returns false if there are none.
+  bool CollectAllocations();
+
+  // Computes the set of allocations known to be new or remembered at the
+  // entry of every block.
+  void Analyze();
+
+  // Clears the store barrier of stores into allocations which are known to
+  // be new or remembered.
+  void Eliminate();
+
+  // Applies the effect of [instr] to [state]. If [eliminate] is true also
+  // removes the barrier from [instr] if it is a store into a known allocation.
+  void Transfer(Instruction* instr, BitVector* state, bool eliminate);
+
+  // Returns the dense index of the allocation [instance] refers to, or -1.
+  intptr_t IndexOf(Value* instance) const;
+
+  // Whether objects of the given kind are handled by
+  // Thread::RestoreWriteBarrierInvariant when the GC runs.
+  static bool IsDurableAllocation(Definition* alloc);
+
+  // Whether [instr] can only trigger a GC through a runtime call made
+  // directly from the current frame, without running any Dart code.
+  static bool PreservesDurableAllocations(Instruction* instr);
+
+  Zone* zone_;
+  FlowGraph* flow_graph_;
+  GrowableArray<intptr_t> allocation_index_;
+  GrowableArray<Definition*> allocations_;
+  GrowableArray<BitVector*> in_;
+  GrowableArray<BitVector*> out_;
+
+  // Allocations which are forgotten by every instruction which can trigger a
+  // GC.
+  BitVector* volatile_;
+
+  DISALLOW_COPY_AND_ASSIGN(WriteBarrierElimination);
+};
+
+bool WriteBarrierElimination::IsDurableAllocation(Definition* alloc) {
+  if (alloc->IsCreateArray() || alloc->IsAllocateContext() ||
+      alloc->IsAllocateUninitializedContext()) {
+    return true;
+  }
+  if (AllocateObjectInstr* alloc_object = alloc->AsAllocateObject()) {
+    return alloc_object->cls().id() >= kNumPredefinedCids;
+  }
+  return false;
+}
+
+bool WriteBarrierElimination::PreservesDurableAllocations(Instruction* instr) {
+  return instr->IsAllocation() || instr->IsCloneContext() ||
+         instr->IsCheckStackOverflow() || instr->IsBox() ||
+         instr->IsBoxInt64() || instr->IsBoxInt32() || instr->IsBoxUint32() ||
+         instr->IsStoreInstanceField();
+}
+
+bool WriteBarrierElimination::CollectAllocations() {
+  for (intptr_t i = 0; i < flow_graph_->current_ssa_temp_index(); i++) {
+    allocation_index_.Add(-1);
+  }
+  for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      AllocationInstr* alloc = it.Current()->AsAllocation();
+      if (alloc != NULL && alloc->HasSSATemp() &&
+          alloc->WillAllocateNewOrRemembered()) {
+        allocation_index_[alloc->ssa_temp_index()] = allocations_.length();
+        allocations_.Add(alloc);
+      }
+    }
+  }
+  if (allocations_.is_empty()) {
+    return false;
+  }
+  volatile_ = new (zone_) BitVector(zone_, allocations_.length());
+  for (intptr_t i = 0; i < allocations_.length(); i++) {
+    if (!IsDurableAllocation(allocations_[i])) {
+      volatile_->Add(i);
+    }
+  }
+  return true;
+}
+
+intptr_t WriteBarrierElimination::IndexOf(Value* instance) const {
+  Definition* defn = instance->definition()->OriginalDefinition();
+  if (!defn->HasSSATemp()) return -1;
+  const intptr_t ssa_index = defn->ssa_temp_index();
+  if (ssa_index >= allocation_index_.length()) return -1;
+  const intptr_t index = allocation_index_[ssa_index];
+  if (index < 0 || allocations_[index] != defn) return -1;
+  return index;
+}
+
+void WriteBarrierElimination::Transfer(Instruction* instr,
+                                       BitVector* state,
+                                       bool eliminate) {
+  if (eliminate) {
+    if (StoreInstanceFieldInstr* store = instr->AsStoreInstanceField()) {
+      // A store which boxes its value allocates the box before storing it.
+      if (!store->CanTriggerGC()) {
+        const intptr_t index = IndexOf(store->instance());
+        if (index >= 0 && state->Contains(index)) {
+          store->set_emit_store_barrier(kNoStoreBarrier);
+        }
+      }
+    } else if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+      const intptr_t index = IndexOf(store->array());
+      if (index >= 0 && state->Contains(index)) {
+        store->set_emit_store_barrier(kNoStoreBarrier);
+      }
+    }
+  }
+
+  if (instr->CanTriggerGC()) {
+    if (PreservesDurableAllocations(instr)) {
+      state->RemoveAll(volatile_);
+    } else {
+      state->Clear();
+    }
+  }
+
+  // The allocation's own (possible) GC happens before its result exists.
+  if (Definition* defn = instr->AsDefinition()) {
+    const intptr_t index = defn->HasSSATemp() && defn->IsAllocation()
+                               ? allocation_index_[defn->ssa_temp_index()]
+                               : -1;
+    if (index >= 0) {
+      state->Add(index);
+    }
+  }
+}
+
+void WriteBarrierElimination::Analyze() {
+  const GrowableArray<BlockEntryInstr*>& postorder = flow_graph_->postorder();
+  const intptr_t num_allocations = allocations_.length();
+  for (intptr_t i = 0; i < postorder.length(); i++) {
+    ASSERT(postorder[i]->postorder_number() == i);
+    in_.Add(new (zone_) BitVector(zone_, num_allocations));
+    BitVector* out = new (zone_) BitVector(zone_, num_allocations);
+    // Optimistically assume everything is known until proven otherwise.
+    out->SetAll();
+    out_.Add(out);
+  }
+
+  BitVector* state = new (zone_) BitVector(zone_, num_allocations);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      BlockEntryInstr* block = block_it.Current();
+      const intptr_t block_num = block->postorder_number();
+      BitVector* in = in_[block_num];
+      if (block->PredecessorCount() == 0) {
+        in->Clear();
+      } else {
+        in->SetAll();
+        for (intptr_t i = 0; i < block->PredecessorCount(); i++) {
+          in->Intersect(out_[block->PredecessorAt(i)->postorder_number()]);
+        }
+      }
+
+      state->CopyFrom(in);
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        Transfer(it.Current(), state, /*eliminate=*/false);
+      }
+      if (!state->Equals(*out_[block_num])) {
+        out_[block_num]->CopyFrom(state);
+        changed = true;
+      }
+    }
+  }
+}
+
+void WriteBarrierElimination::Eliminate() {
+  BitVector* state = new (zone_) BitVector(zone_, allocations_.length());
+  for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    state->CopyFrom(in_[block->postorder_number()]);
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Transfer(it.Current(), state, /*eliminate=*/true);
+    }
+  }
+}
+
+void WriteBarrierElimination::Run() {
+  if (!CollectAllocations()) return;
+  Analyze();
+  Eliminate();
+}
+
+void EliminateWriteBarriers(FlowGraph* flow_graph) {
+  WriteBarrierElimination elimination(Thread::Current()->zone(), flow_graph);
+  elimination.Run();
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -0,0 +1,32 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_WRITE_BARRIER_ELIMINATION_H_
+#define RUNTIME_VM_COMPILER_WRITE_BARRIER_ELIMINATION_H_
+
+namespace dart {
+
+class FlowGraph;
+
+// Removes the store barrier from StoreInstanceField and StoreIndexed
+// instructions whose target is known to be a recent allocation which is
+// either in new space or already in the remembered set (and on the deferred
+// marking stack during concurrent marking).
+//
+// The analysis is a forward "must" dataflow over the whole graph, so facts
+// established before a branch or a loop are kept when every path into a
+// block agrees on them.
+//
+// Allocations of arrays, contexts and instances of user classes stay known
+// across instructions which can only trigger a GC from a runtime call made
+// directly by the current frame (other allocations, boxing, stack overflow
+// checks), because the GC re-establishes the invariant for such objects
+// referenced from the mutator's frames; see
+// Thread::RestoreWriteBarrierInvariant. Every other instruction which can
+// trigger a GC (e.g. calls) forgets all allocations.
+void EliminateWriteBarriers(FlowGraph* flow_graph);
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_WRITE_BARRIER_ELIMINATION_H_
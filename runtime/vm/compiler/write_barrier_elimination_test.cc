@@ -0,0 +1,132 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/write_barrier_elimination.h"
+
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static void NoopNative(Dart_NativeArguments args) {}
+
+static Dart_NativeFunction NoopNativeLookup(Dart_Handle name,
+                                            int argument_count,
+                                            bool* auto_setup_scope) {
+  ASSERT(auto_setup_scope != nullptr);
+  *auto_setup_scope = false;
+  return reinterpret_cast<Dart_NativeFunction>(&NoopNative);
+}
+
+// Returns the number of stores in [flow_graph] which still emit a barrier.
+static intptr_t CountStoreBarriers(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* current = it.Current();
+      if (StoreInstanceFieldInstr* store = current->AsStoreInstanceField()) {
+        if (store->ShouldEmitStoreBarrier()) count++;
+      } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+        if (store->ShouldEmitStoreBarrier()) count++;
+      }
+    }
+  }
+  return count;
+}
+
+static FlowGraph* CompileFunction(const Library& lib, const char* name) {
+  const auto& function = Function::Handle(GetFunction(lib, name));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  if (FLAG_support_il_printer) {
+    FlowGraphPrinter::PrintGraph("After WriteBarrierElimination", flow_graph);
+  }
+  return flow_graph;
+}
+
+ISOLATE_UNIT_TEST_CASE(WriteBarrierElimination_AcrossBranches) {
+  const char* kScript = R"(
+      class C {
+        dynamic x;
+        dynamic y;
+      }
+
+      foo(bool b) {
+        final c = new C();
+        final d = new C();
+        if (b) {
+          c.x = d;
+        } else {
+          c.y = d;
+        }
+        return c;
+      }
+
+      main() {
+        foo(true);
+        foo(false);
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+  FlowGraph* flow_graph = CompileFunction(lib, "foo");
+  EXPECT_EQ(0, CountStoreBarriers(flow_graph));
+}
+
+ISOLATE_UNIT_TEST_CASE(WriteBarrierElimination_AcrossAllocations) {
+  const char* kScript = R"(
+      class C {
+        dynamic x;
+      }
+
+      foo(int n) {
+        final c = new C();
+        for (int i = 0; i < n; i++) {
+          c.x = new C();
+        }
+        return c;
+      }
+
+      main() {
+        foo(10);
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+  FlowGraph* flow_graph = CompileFunction(lib, "foo");
+  EXPECT_EQ(0, CountStoreBarriers(flow_graph));
+}
+
+ISOLATE_UNIT_TEST_CASE(WriteBarrierElimination_KilledByCall) {
+  const char* kScript = R"(
+      class C {
+        dynamic x;
+      }
+
+      dynamic blackhole() native 'BlackholeNative';
+
+      foo() {
+        final c = new C();
+        final d = blackhole();
+        c.x = d;
+        return c;
+      }
+
+      main() {
+        foo();
+      }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript, NoopNativeLookup));
+  Invoke(lib, "main");
+  FlowGraph* flow_graph = CompileFunction(lib, "foo");
+  EXPECT_EQ(1, CountStoreBarriers(flow_graph));
+}
+
+}  // namespace dart
@@ -6,6 +6,7 @@
 #include "platform/assert.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compilation_trace.h"
 #include "vm/dart_api_impl.h"
 #include "vm/heap/safepoint.h"
 #include "vm/kernel_isolate.h"
@@ -16,6 +17,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_tasks);
+
 ISOLATE_UNIT_TEST_CASE(CompileScript) {
   const char* kScriptChars =
       "class A {\n"
@@ -111,6 +114,184 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static f0() { return 0; }\n"
+      "  static f1() { return 1; }\n"
+      "  static f2() { return 2; }\n"
+      "  static f3() { return 3; }\n"
+      "  static f4() { return 4; }\n"
+      "  static f5() { return 5; }\n"
+      "}\n";
+  const intptr_t kNumFunctions = 6;
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, NULL);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const Array& functions = Array::Handle(Array::New(kNumFunctions));
+  Function& func = Function::Handle();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    func = cls.LookupStaticFunction(
+        String::Handle(String::NewFormatted("f%" Pd, i)));
+    EXPECT(!func.IsNull());
+    CompilerTest::TestCompileFunction(func);
+    EXPECT(!func.HasOptimizedCode());
+    // The hottest functions are taken from the queue first.
+    func.SetUsageCounter(i);
+    functions.SetAt(i, func);
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t saved_tasks = FLAG_background_compiler_tasks;
+  FLAG_background_compiler_tasks = 3;
+  Isolate* isolate = thread->isolate();
+  BackgroundCompiler::Start(isolate);
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    func ^= functions.At(i);
+    isolate->optimizing_background_compiler()->Compile(func);
+  }
+  Monitor* m = new Monitor();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    func ^= functions.At(i);
+    MonitorLocker ml(m);
+    while (!func.HasOptimizedCode()) {
+      ml.WaitWithSafepointCheck(thread, 1);
+    }
+  }
+  delete m;
+  BackgroundCompiler::Stop(isolate);
+  FLAG_background_compiler_tasks = saved_tasks;
+}
+
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileOsrOnHelperThread) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static loop(n) {\n"
+      "    var sum = 0;\n"
+      "    for (var i = 0; i < n; i++) sum += i;\n"
+      "    return sum;\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, NULL);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const Function& func = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("loop"))));
+  EXPECT(!func.IsNull());
+  CompilerTest::TestCompileFunction(func);
+  EXPECT(!func.HasOptimizedCode());
+  const Code& unoptimized_code = Code::Handle(func.unoptimized_code());
+  PcDescriptors::Iterator iter(
+      PcDescriptors::Handle(unoptimized_code.pc_descriptors()),
+      RawPcDescriptors::kOsrEntry);
+  EXPECT(iter.MoveNext());
+  const intptr_t osr_id = iter.DeoptId();
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  Isolate* isolate = thread->isolate();
+  BackgroundCompiler::Start(isolate);
+  BackgroundCompiler* compiler = isolate->optimizing_background_compiler();
+  func.SetUsageCounter(INT_MIN);
+  compiler->CompileOsr(func, osr_id);
+  Monitor* m = new Monitor();
+  {
+    MonitorLocker ml(m);
+    while (func.usage_counter() != BackgroundCompiler::kOsrReadyUsageCounter) {
+      ml.WaitWithSafepointCheck(thread, 1);
+    }
+  }
+  delete m;
+  // The OSR code is handed to the mutator instead of being installed.
+  EXPECT(!func.HasOptimizedCode());
+  const Code& osr_code = Code::Handle(compiler->TakeOsrCode(func, osr_id));
+  EXPECT(!osr_code.IsNull());
+  EXPECT(osr_code.is_optimized());
+  EXPECT(compiler->TakeOsrCode(func, osr_id) == Code::null());
+  BackgroundCompiler::Stop(isolate);
+}
+
+ISOLATE_UNIT_TEST_CASE(PrecompilerTypeFeedback) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static callFoo(x) { return x.foo(); }\n"
+      "}\n"
+      "class B { foo() => 1; }\n"
+      "class C { foo() => 2; }\n"
+      "main() {\n"
+      "  for (var i = 0; i < 10; i++) {\n"
+      "    A.callFoo(new B());\n"
+      "    A.callFoo(new C());\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle library;
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = 0;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, NULL);
+    Dart_Handle result = Dart_Invoke(library, NewString("main"), 0, NULL);
+    EXPECT_VALID(result);
+    // Save the feedback of the training run, then load it as gen_snapshot
+    // does before precompiling.
+    result = Dart_SaveTypeFeedback(&buffer, &buffer_length);
+    EXPECT_VALID(result);
+    const bool saved_precompiled_mode = FLAG_precompiled_mode;
+    FLAG_precompiled_mode = true;
+    result = Dart_LoadTypeFeedback(buffer, buffer_length);
+    FLAG_precompiled_mode = saved_precompiled_mode;
+    EXPECT_VALID(result);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const Function& func = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("callFoo"))));
+  EXPECT(!func.IsNull());
+  PcDescriptors::Iterator iter(
+      PcDescriptors::Handle(Code::Handle(func.unoptimized_code())
+                                .pc_descriptors()),
+      RawPcDescriptors::kIcCall);
+  EXPECT(iter.MoveNext());
+  const TokenPosition token_pos = iter.TokenPos();
+
+  const Array& args_desc = Array::Handle(ArgumentsDescriptor::New(0, 1));
+  const String& selector = String::Handle(Symbols::New(thread, "foo"));
+  ICData& ic_data = ICData::Handle(ICData::New(
+      func, selector, args_desc, DeoptId::kNone, 1, ICData::kInstance));
+  PrecompilerTypeFeedback::AddChecks(func, token_pos, ic_data);
+  // Both receiver classes seen in the training run.
+  EXPECT_EQ(2, ic_data.NumberOfChecks());
+
+  // Another call site of the function has no feedback.
+  ic_data = ICData::New(func, selector, args_desc, DeoptId::kNone, 1,
+                        ICData::kInstance);
+  PrecompilerTypeFeedback::AddChecks(func, TokenPosition(token_pos.Pos() + 1),
+                                     ic_data);
+  EXPECT_EQ(0, ic_data.NumberOfChecks());
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
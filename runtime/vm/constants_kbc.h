@@ -541,6 +541,34 @@ namespace dart {
   V(VMInternal_NoSuchMethodDispatcher,     0, ___, ___, ___)                   \
   V(VMInternal_ImplicitStaticClosure,      0, ___, ___, ___)                   \
   V(VMInternal_ImplicitInstanceClosure,    0, ___, ___, ___)                   \
+  V(VMInternal_PushPush,                   X, xeg, ___, ___)                   \
+  V(VMInternal_PushLoadFieldTOS,           X, xeg, ___, ___)                   \
+  V(VMInternal_PushReturnTOS,              X, xeg, ___, ___)                   \
+  V(VMInternal_PushNullReturnTOS,          0, ___, ___, ___)                   \
+  V(VMInternal_CompareIntEqJump,           0, ___, ___, ___)                   \
+  V(VMInternal_CompareIntGtJump,           0, ___, ___, ___)                   \
+  V(VMInternal_CompareIntLtJump,           0, ___, ___, ___)                   \
+  V(VMInternal_CompareIntGeJump,           0, ___, ___, ___)                   \
+  V(VMInternal_CompareIntLeJump,           0, ___, ___, ___)                   \
+
+  // Superinstructions are created by the VM when it loads bytecode of
+  // functions which are going to be interpreted. A superinstruction replaces
+  // the opcode of the first instruction of a frequent sequence and keeps its
+  // operands, and the instructions following it are left in place. Jumps into
+  // the middle of a sequence and all users of DecodeOpcode are not affected.
+  // The second column is the opcode which a superinstruction replaced; the
+  // compare superinstructions are followed by JumpIfTrue or JumpIfFalse.
+  // Superinstructions must come last in the list of internal bytecodes.
+#define KERNEL_SUPERINSTRUCTIONS_LIST(V)                                       \
+  V(VMInternal_PushPush,                   Push)                               \
+  V(VMInternal_PushLoadFieldTOS,           Push)                               \
+  V(VMInternal_PushReturnTOS,              Push)                               \
+  V(VMInternal_PushNullReturnTOS,          PushNull)                           \
+  V(VMInternal_CompareIntEqJump,           CompareIntEq)                       \
+  V(VMInternal_CompareIntGtJump,           CompareIntGt)                       \
+  V(VMInternal_CompareIntLtJump,           CompareIntLt)                       \
+  V(VMInternal_CompareIntGeJump,           CompareIntGe)                       \
+  V(VMInternal_CompareIntLeJump,           CompareIntLe)                       \
 
 #define KERNEL_BYTECODES_LIST(V)                                               \
   PUBLIC_KERNEL_BYTECODES_LIST(V)                                              \
@@ -567,6 +595,8 @@ class KernelBytecode {
 #undef DECLARE_BYTECODE
   };
 
+  static const Opcode kFirstSuperinstruction = kVMInternal_PushPush;
+
   static const char* NameOf(KBCInstr instr) {
     const char* names[] = {
 #define NAME(name, encoding, op1, op2, op3) #name,
@@ -645,8 +675,26 @@ class KernelBytecode {
     return static_cast<int32_t>(bc) >> kTShift;
   }
 
+  // Superinstructions are decoded as the instruction they replaced.
   DART_FORCE_INLINE static Opcode DecodeOpcode(KBCInstr bc) {
-    return static_cast<Opcode>(bc & 0xFF);
+    const Opcode op = static_cast<Opcode>(bc & 0xFF);
+    return LIKELY(op < kFirstSuperinstruction) ? op : ReplacedOpcode(op);
+  }
+
+  static Opcode ReplacedOpcode(Opcode superinstruction) {
+    switch (superinstruction) {
+#define REPLACED_OPCODE(name, replaced)                                        \
+  case k##name:                                                                \
+    return k##replaced;
+      KERNEL_SUPERINSTRUCTIONS_LIST(REPLACED_OPCODE)
+#undef REPLACED_OPCODE
+      default:
+        return superinstruction;
+    }
+  }
+
+  DART_FORCE_INLINE static bool IsSuperinstruction(KBCInstr instr) {
+    return static_cast<Opcode>(instr & 0xFF) >= kFirstSuperinstruction;
   }
 
   DART_FORCE_INLINE static bool IsTrap(KBCInstr instr) {
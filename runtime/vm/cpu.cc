@@ -0,0 +1,60 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/cpu.h"
+
+#include "platform/utils.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+ICacheFlushBatch::ICacheFlushBatch(Thread* thread)
+    : thread_(thread),
+      previous_(thread->icache_flush_batch()),
+      num_ranges_(0) {
+  thread->set_icache_flush_batch(this);
+}
+
+ICacheFlushBatch::~ICacheFlushBatch() {
+  ASSERT(thread_->icache_flush_batch() == this);
+  FlushAll();
+  thread_->set_icache_flush_batch(previous_);
+}
+
+void ICacheFlushBatch::FlushICache(uword start, uword size) {
+  Thread* thread = Thread::Current();
+  ICacheFlushBatch* batch =
+      (thread != NULL) ? thread->icache_flush_batch() : NULL;
+  if (batch == NULL) {
+    CPU::FlushICache(start, size);
+  } else if (size != 0) {
+    batch->Add(start, start + size);
+  }
+}
+
+void ICacheFlushBatch::Add(uword start, uword end) {
+  for (intptr_t i = 0; i < num_ranges_; i++) {
+    if ((start <= ends_[i] + kMaxCoalescedGap) &&
+        (starts_[i] <= end + kMaxCoalescedGap)) {
+      starts_[i] = Utils::Minimum(starts_[i], start);
+      ends_[i] = Utils::Maximum(ends_[i], end);
+      return;
+    }
+  }
+  if (num_ranges_ == kMaxRanges) {
+    FlushAll();
+  }
+  starts_[num_ranges_] = start;
+  ends_[num_ranges_] = end;
+  num_ranges_++;
+}
+
+void ICacheFlushBatch::FlushAll() {
+  for (intptr_t i = 0; i < num_ranges_; i++) {
+    CPU::FlushICache(starts_[i], ends_[i] - starts_[i]);
+  }
+  num_ranges_ = 0;
+}
+
+}  // namespace dart
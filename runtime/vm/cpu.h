@@ -13,6 +13,7 @@ namespace dart {
 // Forward Declarations.
 class Error;
 class Instance;
+class Thread;
 
 class CPU : public AllStatic {
  public:
@@ -20,6 +21,42 @@ class CPU : public AllStatic {
   static const char* Id();
 };
 
+// Defers the instruction cache flushes of code the current thread finalizes
+// while the batch is active, and performs them when the batch ends. Nearby
+// ranges are coalesced, so a batch of small code objects pays for the
+// barriers of a cache flush once instead of once per object.
+//
+// Code finalized during the batch must not run, on any thread, before the
+// batch ends. Patching code that may be running must flush immediately with
+// CPU::FlushICache.
+class ICacheFlushBatch : public ValueObject {
+ public:
+  explicit ICacheFlushBatch(Thread* thread);
+  ~ICacheFlushBatch();
+
+  // Flushes the range now, or adds it to the innermost batch of the current
+  // thread.
+  static void FlushICache(uword start, uword size);
+
+  intptr_t num_ranges() const { return num_ranges_; }
+
+ private:
+  // Ranges at most this far apart are flushed as one.
+  static const intptr_t kMaxCoalescedGap = 512;
+  static const intptr_t kMaxRanges = 16;
+
+  void Add(uword start, uword end);
+  void FlushAll();
+
+  Thread* const thread_;
+  ICacheFlushBatch* const previous_;
+  intptr_t num_ranges_;
+  uword starts_[kMaxRanges];
+  uword ends_[kMaxRanges];
+
+  DISALLOW_COPY_AND_ASSIGN(ICacheFlushBatch);
+};
+
 }  // namespace dart
 
 #if defined(TARGET_ARCH_IA32)
@@ -33,4 +33,37 @@ VM_UNIT_TEST_CASE(Id) {
 #endif
 }
 
+ISOLATE_UNIT_TEST_CASE(ICacheFlushBatchCoalesces) {
+  uint8_t* code = reinterpret_cast<uint8_t*>(malloc(64 * KB));
+  const uword start = reinterpret_cast<uword>(code);
+  {
+    ICacheFlushBatch batch(thread);
+    EXPECT_EQ(&batch, thread->icache_flush_batch());
+    // Adjacent and nearby ranges, in any order, share one flush.
+    ICacheFlushBatch::FlushICache(start + 256, 128);
+    ICacheFlushBatch::FlushICache(start, 256);
+    ICacheFlushBatch::FlushICache(start + 512, 64);
+    EXPECT_EQ(1, batch.num_ranges());
+    // Distant ranges do not.
+    ICacheFlushBatch::FlushICache(start + 32 * KB, 64);
+    EXPECT_EQ(2, batch.num_ranges());
+    ICacheFlushBatch::FlushICache(start + 16 * KB, 0);
+    EXPECT_EQ(2, batch.num_ranges());
+    {
+      ICacheFlushBatch inner(thread);
+      ICacheFlushBatch::FlushICache(start + 48 * KB, 64);
+      EXPECT_EQ(1, inner.num_ranges());
+      EXPECT_EQ(2, batch.num_ranges());
+    }
+    EXPECT_EQ(&batch, thread->icache_flush_batch());
+    // A full batch flushes what it has and starts over.
+    for (intptr_t i = 0; i < 20; i++) {
+      ICacheFlushBatch::FlushICache(start + i * 2 * KB, 64);
+    }
+    EXPECT_LE(batch.num_ranges(), 16);
+  }
+  EXPECT(thread->icache_flush_batch() == NULL);
+  free(code);
+}
+
 }  // namespace dart
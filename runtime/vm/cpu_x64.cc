@@ -18,6 +18,9 @@
 namespace dart {
 
 DEFINE_FLAG(bool, use_sse41, true, "Use SSE 4.1 if available");
+// Off by default: AOT snapshots compiled on an AVX machine would not run on
+// machines without it.
+DEFINE_FLAG(bool, use_avx, false, "Use AVX and FMA if available");
 
 void CPU::FlushICache(uword start, uword size) {
   // Nothing to be done here.
@@ -29,6 +32,9 @@ const char* CPU::Id() {
 
 bool HostCPUFeatures::sse2_supported_ = true;
 bool HostCPUFeatures::sse4_1_supported_ = false;
+bool HostCPUFeatures::avx_supported_ = false;
+bool HostCPUFeatures::avx2_supported_ = false;
+bool HostCPUFeatures::fma_supported_ = false;
 const char* HostCPUFeatures::hardware_ = NULL;
 #if defined(DEBUG)
 bool HostCPUFeatures::initialized_ = false;
@@ -39,6 +45,12 @@ void HostCPUFeatures::Init() {
   hardware_ = CpuInfo::GetCpuModel();
   sse4_1_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "sse4_1") ||
                       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4.1");
+  // macOS reports AVX as "AVX1.0" and does not list AVX2 among these.
+  avx_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "avx") ||
+                   CpuInfo::FieldContains(kCpuInfoFeatures, "AVX1.0");
+  avx2_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "avx2");
+  fma_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "fma") ||
+                   CpuInfo::FieldContains(kCpuInfoFeatures, "FMA");
 
 #if defined(DEBUG)
   initialized_ = true;
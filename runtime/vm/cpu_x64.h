@@ -11,6 +11,7 @@
 namespace dart {
 
 DECLARE_FLAG(bool, use_sse41);
+DECLARE_FLAG(bool, use_avx);
 
 class HostCPUFeatures : public AllStatic {
  public:
@@ -28,6 +29,18 @@ class HostCPUFeatures : public AllStatic {
     DEBUG_ASSERT(initialized_);
     return sse4_1_supported_ && FLAG_use_sse41;
   }
+  static bool avx_supported() {
+    DEBUG_ASSERT(initialized_);
+    return avx_supported_ && FLAG_use_avx;
+  }
+  static bool avx2_supported() {
+    DEBUG_ASSERT(initialized_);
+    return avx2_supported_ && avx_supported();
+  }
+  static bool fma_supported() {
+    DEBUG_ASSERT(initialized_);
+    return fma_supported_ && avx_supported();
+  }
 
  private:
   static const uint64_t kSSE2BitMask = static_cast<uint64_t>(1) << 26;
@@ -35,6 +48,9 @@ class HostCPUFeatures : public AllStatic {
   static const char* hardware_;
   static bool sse2_supported_;
   static bool sse4_1_supported_;
+  static bool avx_supported_;
+  static bool avx2_supported_;
+  static bool fma_supported_;
 #if defined(DEBUG)
   static bool initialized_;
 #endif
@@ -47,6 +63,9 @@ class TargetCPUFeatures : public AllStatic {
   static const char* hardware() { return HostCPUFeatures::hardware(); }
   static bool sse2_supported() { return HostCPUFeatures::sse2_supported(); }
   static bool sse4_1_supported() { return HostCPUFeatures::sse4_1_supported(); }
+  static bool avx_supported() { return HostCPUFeatures::avx_supported(); }
+  static bool avx2_supported() { return HostCPUFeatures::avx2_supported(); }
+  static bool fma_supported() { return HostCPUFeatures::fma_supported(); }
   static bool double_truncate_round_supported() { return false; }
 };
 
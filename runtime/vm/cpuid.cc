@@ -15,10 +15,15 @@
 #endif
 #endif
 
+#include "platform/utils.h"
+
 namespace dart {
 
 bool CpuId::sse2_ = false;
 bool CpuId::sse41_ = false;
+bool CpuId::avx_ = false;
+bool CpuId::avx2_ = false;
+bool CpuId::fma_ = false;
 const char* CpuId::id_string_ = NULL;
 const char* CpuId::brand_string_ = NULL;
 
@@ -34,10 +39,32 @@ void CpuId::GetCpuId(int32_t level, uint32_t info[4]) {
 #endif
 }
 
+void CpuId::GetCpuIdCount(int32_t level, int32_t count, uint32_t info[4]) {
+#if defined(HOST_OS_WINDOWS)
+  __cpuidex(reinterpret_cast<int*>(info), level, count);
+#else
+  __cpuid_count(level, count, info[0], info[1], info[2], info[3]);
+#endif
+}
+
+bool CpuId::OSSavesYmmState() {
+#if defined(HOST_OS_WINDOWS)
+  const uint64_t xcr0 = _xgetbv(0);
+#else
+  uint32_t eax;
+  uint32_t edx;
+  // Not using _xgetbv, which requires compiling with -mxsave.
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  const uint64_t xcr0 = (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+  return (xcr0 & 0x6) == 0x6;
+}
+
 void CpuId::Init() {
   uint32_t info[4] = {static_cast<uint32_t>(-1)};
 
   GetCpuId(0, info);
+  const uint32_t max_level = info[0];
   char* id_string = reinterpret_cast<char*>(malloc(3 * sizeof(int32_t)));
   // Yes, these are supposed to be out of order.
   *reinterpret_cast<uint32_t*>(id_string) = info[1];
@@ -48,6 +75,15 @@ void CpuId::Init() {
   GetCpuId(1, info);
   CpuId::sse41_ = (info[2] & (1 << 19)) != 0;
   CpuId::sse2_ = (info[3] & (1 << 26)) != 0;
+  // AVX needs both the instructions (bit 28) and XGETBV to tell whether the
+  // OS supports them (OSXSAVE, bit 27).
+  const bool os_avx = ((info[2] & (1 << 27)) != 0) && OSSavesYmmState();
+  CpuId::avx_ = os_avx && ((info[2] & (1 << 28)) != 0);
+  CpuId::fma_ = CpuId::avx_ && ((info[2] & (1 << 12)) != 0);
+  if (CpuId::avx_ && (max_level >= 7)) {
+    GetCpuIdCount(7, 0, info);
+    CpuId::avx2_ = (info[1] & (1 << 5)) != 0;
+  }
 
   char* brand_string =
       reinterpret_cast<char*>(malloc(3 * 4 * sizeof(uint32_t)));
@@ -89,15 +125,13 @@ const char* CpuId::field(CpuInfoIndices idx) {
     case kCpuInfoHardware:
       return brand_string();
     case kCpuInfoFeatures: {
-      if (sse2() && sse41()) {
-        return strdup("sse2 sse4.1");
-      } else if (sse2()) {
-        return strdup("sse2");
-      } else if (sse41()) {
-        return strdup("sse4.1");
-      } else {
-        return strdup("");
-      }
+      char features[64];
+      Utils::SNPrint(features, sizeof(features), "%s%s%s%s%s",
+                     sse2() ? " sse2" : "", sse41() ? " sse4.1" : "",
+                     avx_ ? " avx" : "", avx2_ ? " avx2" : "",
+                     fma_ ? " fma" : "");
+      // Skip the leading space.
+      return strdup((features[0] == '\0') ? features : features + 1);
     }
     default: {
       UNREACHABLE();
@@ -36,10 +36,17 @@ class CpuId : public AllStatic {
 
   static bool sse2_;
   static bool sse41_;
+  // Only set if the OS also saves the YMM registers on context switches.
+  static bool avx_;
+  static bool avx2_;
+  static bool fma_;
   static const char* id_string_;
   static const char* brand_string_;
 
   static void GetCpuId(int32_t level, uint32_t info[4]);
+  static void GetCpuIdCount(int32_t level, int32_t count, uint32_t info[4]);
+  // Whether XCR0 has the bits for saving XMM and YMM state.
+  static bool OSSavesYmmState();
 };
 
 }  // namespace dart
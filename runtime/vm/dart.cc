@@ -6,6 +6,7 @@
 
 #include "vm/clustered_snapshot.h"
 #include "vm/code_observers.h"
+#include "vm/compiler/compiler_pass.h"
 #include "vm/cpu.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -25,9 +26,11 @@
 #include "vm/object.h"
 #include "vm/object_id_ring.h"
 #include "vm/object_store.h"
+#include "vm/poll_page.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
 #include "vm/reverse_pc_lookup_cache.h"
+#include "vm/ring_buffer_channel.h"
 #include "vm/service_isolate.h"
 #include "vm/simulator.h"
 #include "vm/snapshot.h"
@@ -48,6 +51,7 @@ DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 DECLARE_FLAG(bool, strong);
 
 Isolate* Dart::vm_isolate_ = NULL;
+bool Dart::exiting_ = false;
 int64_t Dart::start_time_micros_ = 0;
 ThreadPool* Dart::thread_pool_ = NULL;
 DebugInfo* Dart::pprof_symbol_generator_ = NULL;
@@ -186,12 +190,14 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   start_time_micros_ = OS::GetCurrentMonotonicMicros();
   VirtualMemory::Init();
   OSThread::Init();
+  PollPage::Init();
 #if defined(SUPPORT_TIMELINE)
   Timeline::Init();
   TimelineDurationScope tds(Timeline::GetVMStream(), "Dart::Init");
 #endif
   Isolate::InitVM();
   PortMap::Init();
+  RingBufferChannel::Init();
   FreeListElement::Init();
   ForwardingCorpse::Init();
   Api::Init();
@@ -201,6 +207,9 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   NOT_IN_PRODUCT(Metric::Init());
   StoreBuffer::Init();
   MarkingStack::Init();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  CompilerPassStatistics::Init();
+#endif
 
 #if defined(USING_SIMULATOR)
   Simulator::Init();
@@ -530,6 +539,21 @@ char* Dart::Cleanup() {
   }
   OSThread::DisableOSThreadCreation();
 
+  if (exiting_) {
+    // The process exits next and releases the VM isolate and the remaining
+    // global state faster than tearing them down would.
+    if (FLAG_trace_shutdown) {
+      OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Skipping teardown for exit\n",
+                   UptimeMillis());
+    }
+    vm_isolate_ = NULL;
+    NOT_IN_PRODUCT(CodeObservers::Cleanup());
+#if defined(SUPPORT_TIMELINE)
+    Timeline::Cleanup();
+#endif
+    return NULL;
+  }
+
   // Set the VM isolate as current isolate.
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Cleaning up vm isolate\n",
@@ -542,11 +566,15 @@ char* Dart::Cleanup() {
   vm_isolate_ = NULL;
   ASSERT(Isolate::IsolateListLength() == 0);
   PortMap::Cleanup();
+  RingBufferChannel::Cleanup();
   ICData::Cleanup();
   ArgumentsDescriptor::Cleanup();
   TargetCPUFeatures::Cleanup();
   MarkingStack::Cleanup();
   StoreBuffer::Cleanup();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  CompilerPassStatistics::Cleanup();
+#endif
   Object::Cleanup();
   SemiSpace::Cleanup();
   StubCode::Cleanup();
@@ -778,6 +806,8 @@ const char* Dart::FeaturesString(Isolate* isolate,
       ADD_ISOLATE_FLAG(use_field_guards, use_field_guards,
                        FLAG_use_field_guards);
       ADD_ISOLATE_FLAG(use_osr, use_osr, FLAG_use_osr);
+      // Optimized code compiled to poll needs the poll page.
+      ADD_FLAG(use_poll_page, PollPage::enabled());
     }
     buffer.AddString(FLAG_causal_async_stacks ? " causal_async_stacks"
                                               : " no-causal_async_stacks");
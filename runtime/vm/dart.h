@@ -44,6 +44,11 @@ class Dart : public AllStatic {
   // (caller owns error message and has to free it).
   static char* Cleanup();
 
+  // The process exits once the VM is shut down, so isolate and VM teardown
+  // only flush what outlives the process and leave memory to the OS.
+  static void PrepareForExit() { exiting_ = true; }
+  static bool IsExiting() { return exiting_; }
+
   static Isolate* CreateIsolate(const char* name_prefix,
                                 const Dart_IsolateFlags& api_flags);
 
@@ -128,6 +133,7 @@ class Dart : public AllStatic {
   static bool HasApplicationIsolateLocked();
 
   static Isolate* vm_isolate_;
+  static bool exiting_;
   static int64_t start_time_micros_;
   static ThreadPool* thread_pool_;
   static DebugInfo* pprof_symbol_generator_;
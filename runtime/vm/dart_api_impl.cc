@@ -17,6 +17,7 @@
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
+#include "vm/elf.h"
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/kernel_loader.h"
 #endif
@@ -40,6 +41,7 @@
 #include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_pprof.h"
 #include "vm/profiler_service.h"
 #include "vm/program_visitor.h"
 #include "vm/resolver.h"
@@ -75,6 +77,11 @@ DEFINE_FLAG(bool,
             dump_tables,
             false,
             "Dump common hash tables before snapshotting.");
+DEFINE_FLAG(bool,
+            defer_weak_handle_finalizers,
+            false,
+            "Queue the callbacks of weak persistent handles whose referents "
+            "die and run them in a batch after the GC pause.");
 
 #define CHECK_ERROR_HANDLE(error)                                              \
   {                                                                            \
@@ -693,6 +700,33 @@ void FinalizablePersistentHandle::Finalize(
   state->weak_persistent_handles().FreeHandle(handle);
 }
 
+void FinalizablePersistentHandle::QueueFinalization(
+    Isolate* isolate,
+    FinalizablePersistentHandle* handle) {
+  if (!handle->raw()->IsHeapObject()) {
+    return;  // Free or already queued handle.
+  }
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  state->weak_persistent_handles().AddPendingFinalization(handle);
+  ASSERT(handle->IsFinalizationPending());
+}
+
+void FinalizablePersistentHandles::RunPendingFinalizations(Isolate* isolate) {
+  FinalizablePersistentHandle* handle = pending_list_;
+  pending_list_ = NULL;
+  while (handle != NULL) {
+    FinalizablePersistentHandle* next = handle->Next();
+    Dart_WeakPersistentHandleFinalizer callback = handle->callback();
+    if (callback != NULL) {
+      (*callback)(isolate->init_callback_data(), handle->apiHandle(),
+                  handle->peer());
+    }
+    FreeHandle(handle);
+    handle = next;
+  }
+}
+
 // --- Handles ---
 
 DART_EXPORT bool Dart_IsError(Dart_Handle handle) {
@@ -897,6 +931,9 @@ Dart_HandleFromWeakPersistent(Dart_WeakPersistentHandle object) {
   NoSafepointScope no_safepoint_scope;
   FinalizablePersistentHandle* weak_ref =
       FinalizablePersistentHandle::Cast(object);
+  if (weak_ref->IsFinalizationPending()) {
+    return Api::Null();  // The referent has been collected.
+  }
   return Api::NewHandle(thread, weak_ref->raw());
 }
 
@@ -990,6 +1027,11 @@ DART_EXPORT void Dart_DeleteWeakPersistentHandle(
   ASSERT(state != NULL);
   FinalizablePersistentHandle* weak_ref =
       FinalizablePersistentHandle::Cast(object);
+  if (weak_ref->IsFinalizationPending()) {
+    // The referent is dead and the handle is freed with the queued callbacks.
+    weak_ref->CancelFinalization();
+    return;
+  }
   weak_ref->EnsureFreeExternal(isolate);
   state->weak_persistent_handles().FreeHandle(weak_ref);
 }
@@ -1026,6 +1068,10 @@ DART_EXPORT char* Dart_Cleanup() {
   return Dart::Cleanup();
 }
 
+DART_EXPORT void Dart_PrepareForExit() {
+  Dart::PrepareForExit();
+}
+
 DART_EXPORT char* Dart_SetVMFlags(int argc, const char** argv) {
   return Flags::ProcessCommandLineFlags(argc, argv);
 }
@@ -1052,6 +1098,12 @@ VM_METRIC_LIST(VM_METRIC_API);
   }
 ISOLATE_METRIC_LIST(ISOLATE_METRIC_API);
 #undef ISOLATE_METRIC_API
+
+DART_EXPORT char* Dart_GetOpenMetrics() {
+  TextBuffer buffer(4 * KB);
+  Metric::PrintOpenMetrics(&buffer);
+  return buffer.Steal();
+}
 #else  // !defined(PRODUCT)
 #define VM_METRIC_API(type, variable, name, unit)                              \
   DART_EXPORT int64_t Dart_VM##variable##Metric() { return -1; }
@@ -1063,6 +1115,11 @@ VM_METRIC_LIST(VM_METRIC_API);
     return -1;                                                                 \
   }
 ISOLATE_METRIC_LIST(ISOLATE_METRIC_API);
+#undef ISOLATE_METRIC_API
+
+DART_EXPORT char* Dart_GetOpenMetrics() {
+  return NULL;
+}
 #endif  // !defined(PRODUCT)
 
 // --- Isolates ---
@@ -4282,6 +4339,257 @@ DART_EXPORT Dart_Handle Dart_InvokeClosure(Dart_Handle closure,
   return Api::NewHandle(T, DartEntry::InvokeClosure(args));
 }
 
+// Prepared invocations are arrays with the following slots.
+enum PreparedInvocationSlot {
+  // The Library or Class in which the target was resolved.
+  kPreparedContainer,
+  // The name of the target, with private names mangled.
+  kPreparedName,
+  // The number of arguments as a Smi, or -1 for field reads.
+  kPreparedArgumentCount,
+  // The Function to call, or the static Field to read.
+  kPreparedTarget,
+  // The arguments descriptor of calls to a Function target.
+  kPreparedArgumentsDescriptor,
+  // The reload generation of the isolate when the target was resolved.
+  kPreparedReloadGeneration,
+  kPreparedInvocationLength,
+};
+
+static intptr_t ReloadGeneration(Isolate* isolate) {
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  return isolate->reload_generation();
+#else
+  return 0;
+#endif
+}
+
+// Looks up the target of a prepared invocation and stores it in the
+// invocation. A negative number of arguments prepares a field read.
+static Dart_Handle ResolvePreparedInvocation(Thread* thread,
+                                             const Array& invocation) {
+  Zone* zone = thread->zone();
+  const Object& container =
+      Object::Handle(zone, invocation.At(kPreparedContainer));
+  const String& name =
+      String::Handle(zone, String::RawCast(invocation.At(kPreparedName)));
+  const intptr_t number_of_arguments =
+      Smi::Value(Smi::RawCast(invocation.At(kPreparedArgumentCount)));
+  const bool is_field_read = number_of_arguments < 0;
+
+  Object& target = Object::Handle(zone);
+  String& getter_name = String::Handle(zone);
+  if (is_field_read) {
+    getter_name = Field::GetterName(name);
+  }
+  if (container.IsLibrary()) {
+    const Library& lib = Library::Cast(container);
+    target = lib.LookupLocalOrReExportObject(name);
+    if (is_field_read && !target.IsField()) {
+      target = lib.LookupLocalOrReExportObject(getter_name);
+    }
+  } else {
+    const Class& cls = Class::Cast(container);
+    const Error& error = Error::Handle(zone, cls.EnsureIsFinalized(thread));
+    if (!error.IsNull()) {
+      return Api::NewHandle(thread, error.raw());
+    }
+    if (is_field_read) {
+      target = cls.LookupStaticField(name);
+      if (target.IsNull()) {
+        target = cls.LookupStaticFunction(getter_name);
+      }
+    } else {
+      target = cls.LookupStaticFunction(name);
+    }
+  }
+
+  if (target.IsField()) {
+    const Field& field = Field::Cast(target);
+    if (!field.is_static()) {
+      return Api::NewError("Field '%s' is not static.", name.ToCString());
+    }
+    if (FLAG_verify_entry_points) {
+      const Error& error = Error::Handle(
+          zone, field.VerifyEntryPoint(EntryPointPragma::kGetterOnly));
+      if (!error.IsNull()) {
+        return Api::NewHandle(thread, error.raw());
+      }
+    }
+    invocation.SetAt(kPreparedArgumentsDescriptor, Object::null_array());
+  } else if (target.IsFunction() && Function::Cast(target).is_static()) {
+    const Function& function = Function::Cast(target);
+    const Array& args_desc_array = Array::Handle(
+        zone, ArgumentsDescriptor::New(
+                  0, is_field_read ? 0 : number_of_arguments));
+    if (!function.AreValidArguments(ArgumentsDescriptor(args_desc_array),
+                                    NULL)) {
+      return Api::NewError("Function '%s' does not accept %" Pd
+                           " positional arguments.",
+                           name.ToCString(), number_of_arguments);
+    }
+    if (FLAG_verify_entry_points) {
+      const Error& error =
+          Error::Handle(zone, function.VerifyCallEntryPoint());
+      if (!error.IsNull()) {
+        return Api::NewHandle(thread, error.raw());
+      }
+    }
+    invocation.SetAt(kPreparedArgumentsDescriptor, args_desc_array);
+  } else if (is_field_read) {
+    return Api::NewError("Static field '%s' not found.", name.ToCString());
+  } else {
+    return Api::NewError("Static function '%s' not found.", name.ToCString());
+  }
+  invocation.SetAt(kPreparedTarget, target);
+  const intptr_t generation = ReloadGeneration(thread->isolate());
+  invocation.SetAt(kPreparedReloadGeneration,
+                   Smi::Handle(zone, Smi::New(generation)));
+  return Api::Success();
+}
+
+static Dart_Handle PrepareInvocation(Thread* thread,
+                                     const char* current_func,
+                                     Dart_Handle target,
+                                     Dart_Handle name,
+                                     intptr_t number_of_arguments) {
+  Zone* zone = thread->zone();
+  String& target_name =
+      String::Handle(zone, Api::UnwrapStringHandle(zone, name).raw());
+  if (target_name.IsNull()) {
+    RETURN_TYPE_ERROR(zone, name, String);
+  }
+  const Object& obj = Object::Handle(zone, Api::UnwrapHandle(target));
+  if (obj.IsError()) {
+    return target;
+  }
+  Object& container = Object::Handle(zone);
+  Library& lib = Library::Handle(zone);
+  if (obj.IsType()) {
+    if (!Type::Cast(obj).IsFinalized()) {
+      return Api::NewError(
+          "%s expects argument 'target' to be a fully resolved type.",
+          current_func);
+    }
+    container = Type::Cast(obj).type_class();
+    lib = Class::Cast(container).library();
+  } else if (obj.IsLibrary()) {
+    lib ^= obj.raw();
+    if (!lib.Loaded()) {
+      return Api::NewError("%s expects library argument 'target' to be loaded.",
+                           current_func);
+    }
+    container = lib.raw();
+  } else {
+    return Api::NewError(
+        "%s expects argument 'target' to be a type or library.", current_func);
+  }
+  if (Library::IsPrivate(target_name)) {
+    target_name = lib.PrivateName(target_name);
+  }
+
+  const Array& invocation =
+      Array::Handle(zone, Array::New(kPreparedInvocationLength, Heap::kOld));
+  invocation.SetAt(kPreparedContainer, container);
+  invocation.SetAt(kPreparedName, target_name);
+  invocation.SetAt(kPreparedArgumentCount,
+                   Smi::Handle(zone, Smi::New(number_of_arguments)));
+  const Dart_Handle result = ResolvePreparedInvocation(thread, invocation);
+  if (Api::IsError(result)) {
+    return result;
+  }
+  return Api::NewHandle(thread, invocation.raw());
+}
+
+DART_EXPORT Dart_Handle Dart_PrepareInvoke(Dart_Handle target,
+                                           Dart_Handle name,
+                                           int number_of_arguments) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  CHECK_CALLBACK_STATE(T);
+  if (number_of_arguments < 0) {
+    return Api::NewError(
+        "%s expects argument 'number_of_arguments' to be non-negative.",
+        CURRENT_FUNC);
+  }
+  return PrepareInvocation(T, CURRENT_FUNC, target, name, number_of_arguments);
+}
+
+DART_EXPORT Dart_Handle Dart_PrepareGetField(Dart_Handle container,
+                                             Dart_Handle name) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  CHECK_CALLBACK_STATE(T);
+  return PrepareInvocation(T, CURRENT_FUNC, container, name, -1);
+}
+
+DART_EXPORT Dart_Handle Dart_InvokePrepared(Dart_Handle prepared,
+                                            Dart_Handle* arguments) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  CHECK_CALLBACK_STATE(T);
+
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(prepared));
+  if (obj.IsError()) {
+    return prepared;
+  }
+  if (!obj.IsArray() ||
+      (Array::Cast(obj).Length() != kPreparedInvocationLength) ||
+      !Object::Handle(Z, Array::Cast(obj).At(kPreparedName)).IsString()) {
+    return Api::NewError(
+        "%s expects argument 'prepared' to be a prepared invocation.",
+        CURRENT_FUNC);
+  }
+  const Array& invocation = Array::Cast(obj);
+  if (Smi::Value(Smi::RawCast(invocation.At(kPreparedReloadGeneration))) !=
+      ReloadGeneration(T->isolate())) {
+    const Dart_Handle result = ResolvePreparedInvocation(T, invocation);
+    if (Api::IsError(result)) {
+      return result;
+    }
+  }
+
+  const Object& target = Object::Handle(Z, invocation.At(kPreparedTarget));
+  if (target.IsField()) {
+    const Field& field = Field::Cast(target);
+    if (!field.IsUninitialized()) {
+      return Api::NewHandle(T, field.StaticValue());
+    }
+    // Let the getter run the initializer on the first read.
+    const String& name =
+        String::Handle(Z, String::RawCast(invocation.At(kPreparedName)));
+    const Object& container =
+        Object::Handle(Z, invocation.At(kPreparedContainer));
+    const bool throw_nsm_if_absent = true;
+    const bool respect_reflectable = false;
+    const bool check_is_entrypoint = false;  // Checked when resolving.
+    if (container.IsLibrary()) {
+      return Api::NewHandle(
+          T, Library::Cast(container).InvokeGetter(name, throw_nsm_if_absent,
+                                                   respect_reflectable,
+                                                   check_is_entrypoint));
+    }
+    return Api::NewHandle(
+        T, Class::Cast(container).InvokeGetter(name, throw_nsm_if_absent,
+                                               respect_reflectable,
+                                               check_is_entrypoint));
+  }
+
+  const Function& function = Function::Cast(target);
+  const Array& args_desc_array = Array::Handle(
+      Z, Array::RawCast(invocation.At(kPreparedArgumentsDescriptor)));
+  const intptr_t number_of_arguments =
+      ArgumentsDescriptor(args_desc_array).Count();
+  Array& args = Array::Handle(Z);
+  const Dart_Handle result =
+      SetupArguments(T, number_of_arguments, arguments, 0, &args);
+  if (Api::IsError(result)) {
+    return result;
+  }
+  return Api::NewHandle(
+      T, DartEntry::InvokeFunction(function, args, args_desc_array));
+}
+
 DART_EXPORT Dart_Handle Dart_GetField(Dart_Handle container, Dart_Handle name) {
   DARTSCOPE(Thread::Current());
   API_TIMELINE_DURATION(T);
@@ -5606,6 +5914,10 @@ DART_EXPORT Dart_Port Dart_ServiceWaitForLoadPort() {
   return ServiceIsolate::WaitForLoadPort();
 }
 
+DART_EXPORT bool Dart_StartServiceIsolate() {
+  return ServiceIsolate::RunDeferred();
+}
+
 DART_EXPORT int64_t Dart_TimelineGetMicros() {
   return OS::GetCurrentMonotonicMicros();
 }
@@ -5853,6 +6165,13 @@ DART_EXPORT void Dart_SetThreadName(const char* name) {
   thread->SetName(name);
 }
 
+DART_EXPORT void Dart_SetContinuousProfileCallback(
+    Dart_ContinuousProfileCallback callback) {
+#if !defined(PRODUCT)
+  ContinuousProfile::SetCallback(callback);
+#endif
+}
+
 DART_EXPORT
 Dart_Handle Dart_SaveCompilationTrace(uint8_t** buffer,
                                       intptr_t* buffer_length) {
@@ -6048,6 +6367,70 @@ Dart_CreateVMAOTSnapshotAsAssembly(Dart_StreamingWriteCallback callback,
 #endif
 }
 
+DART_EXPORT Dart_Handle
+Dart_CreateAppAOTSnapshotAsElf(Dart_StreamingWriteCallback callback,
+                               void* callback_data) {
+#if defined(TARGET_ARCH_IA32)
+  return Api::NewError("AOT compilation is not supported on IA32.");
+#elif defined(TARGET_ARCH_DBC)
+  return Api::NewError("AOT compilation is not supported on DBC.");
+#elif !defined(TARGET_OS_LINUX) && !defined(TARGET_OS_ANDROID) &&             \
+    !defined(TARGET_OS_FUCHSIA)
+  return Api::NewError("ELF generation is only supported for ELF targets.");
+#elif !defined(DART_PRECOMPILER)
+  return Api::NewError(
+      "This VM was built without support for AOT compilation.");
+#else
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  Isolate* I = T->isolate();
+  if (I->compilation_allowed()) {
+    return Api::NewError(
+        "Isolate is not precompiled. "
+        "Did you forget to call Dart_Precompile?");
+  }
+  ASSERT(FLAG_load_deferred_eagerly);
+  CHECK_NULL(callback);
+
+  TIMELINE_DURATION(T, Isolate, "WriteAppAOTSnapshot");
+  // The image layout is that of the blobs, which the ELF writer then exports
+  // under the symbols of the assembly output.
+  uint8_t* vm_snapshot_instructions_buffer = NULL;
+  uint8_t* isolate_snapshot_instructions_buffer = NULL;
+  BlobImageWriter vm_image_writer(T, &vm_snapshot_instructions_buffer,
+                                  ApiReallocate, 2 * MB /* initial_size */,
+                                  /*shared_objects=*/nullptr,
+                                  /*shared_instructions=*/nullptr,
+                                  /*reused_objects=*/nullptr);
+  BlobImageWriter isolate_image_writer(T, &isolate_snapshot_instructions_buffer,
+                                       ApiReallocate, 2 * MB /* initial_size */,
+                                       /*shared_objects=*/nullptr,
+                                       /*shared_instructions=*/nullptr,
+                                       /*reused_objects=*/nullptr);
+  uint8_t* vm_snapshot_data_buffer = NULL;
+  uint8_t* isolate_snapshot_data_buffer = NULL;
+  FullSnapshotWriter writer(Snapshot::kFullAOT, &vm_snapshot_data_buffer,
+                            &isolate_snapshot_data_buffer, ApiReallocate,
+                            &vm_image_writer, &isolate_image_writer);
+  writer.WriteFullSnapshot();
+
+  StreamingWriteStream elf_stream(512 * KB, callback, callback_data);
+  Elf* elf = new (Z) Elf(Z, &elf_stream);
+  elf->AddText("_kDartVmSnapshotInstructions", vm_snapshot_instructions_buffer,
+               vm_image_writer.InstructionsBlobSize());
+  elf->AddText("_kDartIsolateSnapshotInstructions",
+               isolate_snapshot_instructions_buffer,
+               isolate_image_writer.InstructionsBlobSize());
+  elf->AddROData("_kDartVmSnapshotData", vm_snapshot_data_buffer,
+                 writer.VmIsolateSnapshotSize());
+  elf->AddROData("_kDartIsolateSnapshotData", isolate_snapshot_data_buffer,
+                 writer.IsolateSnapshotSize());
+  elf->Finalize();
+
+  return Api::Success();
+#endif
+}
+
 DART_EXPORT Dart_Handle
 Dart_CreateAppAOTSnapshotAsBlobs(uint8_t** vm_snapshot_data_buffer,
                                  intptr_t* vm_snapshot_data_size,
@@ -6293,6 +6676,57 @@ Dart_CreateAppJITSnapshotAsBlobs(uint8_t** isolate_snapshot_data_buffer,
 #endif
 }
 
+DART_EXPORT Dart_Handle Dart_CreateAppJITSnapshotOfRunningIsolateAsBlobs(
+    uint8_t** isolate_snapshot_data_buffer,
+    intptr_t* isolate_snapshot_data_size,
+    uint8_t** isolate_snapshot_instructions_buffer,
+    intptr_t* isolate_snapshot_instructions_size) {
+#if defined(TARGET_ARCH_IA32)
+  return Api::NewError("Snapshots with code are not supported on IA32.");
+#elif defined(DART_PRECOMPILED_RUNTIME)
+  return Api::NewError("JIT app snapshots cannot be taken from an AOT runtime");
+#else
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  Isolate* I = T->isolate();
+  if (!FLAG_load_deferred_eagerly) {
+    return Api::NewError(
+        "Creating full snapshots requires --load_deferred_eagerly");
+  }
+  CHECK_NULL(isolate_snapshot_data_buffer);
+  CHECK_NULL(isolate_snapshot_data_size);
+  CHECK_NULL(isolate_snapshot_instructions_buffer);
+  CHECK_NULL(isolate_snapshot_instructions_size);
+  Dart_Handle state = Api::CheckAndFinalizePendingClasses(T);
+  if (Api::IsError(state)) {
+    return state;
+  }
+
+  // Code installed by a background compiler while the snapshot is written
+  // could be written half way. The compilers are started again when the
+  // isolate next queues a function for them.
+  BackgroundCompiler::Stop(I);
+  {
+    TIMELINE_DURATION(T, Isolate, "WriteAppJITSnapshotOfRunningIsolate");
+    BlobImageWriter isolate_image_writer(
+        T, isolate_snapshot_instructions_buffer, ApiReallocate,
+        2 * MB /* initial_size */, /*shared_objects=*/nullptr,
+        /*shared_instructions=*/nullptr, /*reused_instructions=*/nullptr);
+    FullSnapshotWriter writer(Snapshot::kFullJIT, NULL,
+                              isolate_snapshot_data_buffer, ApiReallocate,
+                              NULL, &isolate_image_writer);
+    writer.set_stable_code_only(true);
+    writer.WriteFullSnapshot();
+
+    *isolate_snapshot_data_size = writer.IsolateSnapshotSize();
+    *isolate_snapshot_instructions_size =
+        isolate_image_writer.InstructionsBlobSize();
+  }
+
+  return Api::Success();
+#endif
+}
+
 DART_EXPORT Dart_Handle Dart_GetObfuscationMap(uint8_t** buffer,
                                                intptr_t* buffer_length) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -3119,6 +3119,35 @@ TEST_CASE(DartAPI_WeakPersistentHandleCallback) {
   }
 }
 
+TEST_CASE(DartAPI_WeakPersistentHandleDeferredCallback) {
+  const bool saved_flag = FLAG_defer_weak_handle_finalizers;
+  FLAG_defer_weak_handle_finalizers = true;
+  int peers[3] = {0, 0, 0};
+  {
+    Dart_EnterScope();
+    for (intptr_t i = 0; i < 3; i++) {
+      Dart_Handle obj = NewString("new string");
+      EXPECT_VALID(obj);
+      Dart_WeakPersistentHandle weak_ref = Dart_NewWeakPersistentHandle(
+          obj, &peers[i], 0, WeakPersistentHandlePeerFinalizer);
+      EXPECT_VALID(AsHandle(weak_ref));
+    }
+    Dart_ExitScope();
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    // The callbacks are queued during the scavenge and run when it ends.
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::WaitForGCTasks();
+    ApiState* state = thread->isolate()->api_state();
+    EXPECT(!state->weak_persistent_handles().HasPendingFinalizations());
+    for (intptr_t i = 0; i < 3; i++) {
+      EXPECT_EQ(42, peers[i]);
+    }
+  }
+  FLAG_defer_weak_handle_finalizers = saved_flag;
+}
+
 TEST_CASE(DartAPI_WeakPersistentHandleNoCallback) {
   Dart_WeakPersistentHandle weak_ref = NULL;
   int peer = 0;
@@ -5480,6 +5509,68 @@ static Dart_NativeFunction native_lookup(Dart_Handle name,
   return reinterpret_cast<Dart_NativeFunction>(&ExceptionNative);
 }
 
+TEST_CASE(DartAPI_InvokePrepared) {
+  const char* kScriptChars =
+      "class Counter {\n"
+      "  static int count = 0;\n"
+      "  static int add(int a, int b) => count += a + b;\n"
+      "  static int get twice => count * 2;\n"
+      "}\n"
+      "int _calls = 0;\n"
+      "final lazy = 42;\n"
+      "int next() => ++_calls;\n";
+  Dart_Handle result;
+  int64_t value = 0;
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle type = Dart_GetType(lib, NewString("Counter"), 0, NULL);
+  EXPECT_VALID(type);
+
+  Dart_Handle next = Dart_PrepareInvoke(lib, NewString("next"), 0);
+  EXPECT_VALID(next);
+  for (int i = 1; i <= 3; i++) {
+    result = Dart_InvokePrepared(next, NULL);
+    EXPECT_VALID(result);
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(i, value);
+  }
+
+  Dart_Handle add = Dart_PrepareInvoke(type, NewString("add"), 2);
+  EXPECT_VALID(add);
+  Dart_Handle args[2] = {Dart_NewInteger(3), Dart_NewInteger(4)};
+  result = Dart_InvokePrepared(add, args);
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  EXPECT_EQ(7, value);
+
+  // Static fields, getters and private top-level variables.
+  Dart_Handle count = Dart_PrepareGetField(type, NewString("count"));
+  EXPECT_VALID(count);
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_InvokePrepared(count, NULL), &value));
+  EXPECT_EQ(7, value);
+  Dart_Handle twice = Dart_PrepareGetField(type, NewString("twice"));
+  EXPECT_VALID(twice);
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_InvokePrepared(twice, NULL), &value));
+  EXPECT_EQ(14, value);
+  Dart_Handle calls = Dart_PrepareGetField(lib, NewString("_calls"));
+  EXPECT_VALID(calls);
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_InvokePrepared(calls, NULL), &value));
+  EXPECT_EQ(3, value);
+  Dart_Handle lazy = Dart_PrepareGetField(lib, NewString("lazy"));
+  EXPECT_VALID(lazy);
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_InvokePrepared(lazy, NULL), &value));
+  EXPECT_EQ(42, value);
+
+  // Errors are reported when preparing.
+  EXPECT_ERROR(Dart_PrepareInvoke(lib, NewString("missing"), 0),
+               "Static function 'missing' not found.");
+  EXPECT_ERROR(Dart_PrepareInvoke(type, NewString("add"), 1),
+               "Function 'add' does not accept 1 positional arguments.");
+  EXPECT_ERROR(Dart_PrepareGetField(type, NewString("missing")),
+               "Static field 'missing' not found.");
+  EXPECT_ERROR(Dart_InvokePrepared(Dart_NewInteger(1), NULL),
+               "Dart_InvokePrepared expects argument 'prepared' to be a "
+               "prepared invocation.");
+}
+
 TEST_CASE(DartAPI_ThrowException) {
   const char* kScriptChars = "int test() native \"ThrowException_native\";";
   Dart_Handle result;
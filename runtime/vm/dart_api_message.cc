@@ -4,6 +4,7 @@
 
 #include "vm/dart_api_message.h"
 #include "platform/unicode.h"
+#include "vm/flat_message.h"
 #include "vm/object.h"
 #include "vm/snapshot_ids.h"
 #include "vm/symbols.h"
@@ -20,7 +21,8 @@ ApiMessageReader::ApiMessageReader(Message* msg)
       backward_references_(kNumInitialReferences),
       vm_isolate_references_(kNumInitialReferences),
       vm_symbol_references_(NULL),
-      finalizable_data_(msg->finalizable_data()) {}
+      finalizable_data_(msg->finalizable_data()),
+      is_flat_(msg->IsFlat()) {}
 
 ApiMessageReader::~ApiMessageReader() {}
 
@@ -43,6 +45,9 @@ void ApiMessageReader::Init() {
 
 Dart_CObject* ApiMessageReader::ReadMessage() {
   Init();
+  if (is_flat_) {
+    return ReadFlatObject();
+  }
   if (PendingBytes() > 0) {
     // Read the object out of the message.
     return ReadObject();
@@ -491,53 +496,16 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
     }
     case kOneByteStringCid: {
       intptr_t len = ReadSmiValue();
-      uint8_t* latin1 =
-          reinterpret_cast<uint8_t*>(allocator(len * sizeof(uint8_t)));
-      intptr_t utf8_len = 0;
-      for (intptr_t i = 0; i < len; i++) {
-        latin1[i] = Read<uint8_t>();
-        utf8_len += Utf8::Length(latin1[i]);
-      }
-      Dart_CObject* object = AllocateDartCObjectString(utf8_len);
+      Dart_CObject* object = ReadLatin1String(len);
       AddBackRef(object_id, object, kIsDeserialized);
-      char* p = object->value.as_string;
-      for (intptr_t i = 0; i < len; i++) {
-        p += Utf8::Encode(latin1[i], p);
-      }
-      *p = '\0';
-      ASSERT(p == (object->value.as_string + utf8_len));
       return object;
     }
     case kTwoByteStringCid: {
       intptr_t len = ReadSmiValue();
-      uint16_t* utf16 =
-          reinterpret_cast<uint16_t*>(allocator(len * sizeof(uint16_t)));
-      intptr_t utf8_len = 0;
-      // Read all the UTF-16 code units.
-      for (intptr_t i = 0; i < len; i++) {
-        utf16[i] = Read<uint16_t>();
-      }
-      // Calculate the UTF-8 length and check if the string can be
-      // UTF-8 encoded.
-      bool valid = true;
-      intptr_t i = 0;
-      while (i < len && valid) {
-        int32_t ch = Utf16::Next(utf16, &i, len);
-        utf8_len += Utf8::Length(ch);
-        valid = !Utf16::IsSurrogate(ch);
+      Dart_CObject* object = ReadUTF16String(len);
+      if (object->type == Dart_CObject_kString) {
+        AddBackRef(object_id, object, kIsDeserialized);
       }
-      if (!valid) {
-        return AllocateDartCObjectUnsupported();
-      }
-      Dart_CObject* object = AllocateDartCObjectString(utf8_len);
-      AddBackRef(object_id, object, kIsDeserialized);
-      char* p = object->value.as_string;
-      i = 0;
-      while (i < len) {
-        p += Utf8::Encode(Utf16::Next(utf16, &i, len), p);
-      }
-      *p = '\0';
-      ASSERT(p == (object->value.as_string + utf8_len));
       return object;
     }
     case kSendPortCid: {
@@ -556,6 +524,17 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
       AddBackRef(object_id, object, kIsDeserialized);
       return object;
     }
+    case kTransferableTypedDataCid: {
+      // Native ports receive the transferred bytes as a Uint8List.
+      intptr_t len = Read<int32_t>();
+      Dart_CObject* object =
+          AllocateDartCObjectTypedData(Dart_TypedData_kUint8, len);
+      AddBackRef(object_id, object, kIsDeserialized);
+      FinalizableData finalizable_data = finalizable_data_->Take();
+      memmove(object->value.as_typed_data.values, finalizable_data.data, len);
+      finalizable_data.callback(NULL, NULL, finalizable_data.peer);
+      return object;
+    }
 
 #define READ_TYPED_DATA_HEADER(type)                                           \
   intptr_t len = ReadSmiValue();                                               \
@@ -678,6 +657,148 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
   }
 }
 
+Dart_CObject* ApiMessageReader::ReadLatin1String(intptr_t len) {
+  uint8_t* latin1 =
+      reinterpret_cast<uint8_t*>(allocator(len * sizeof(uint8_t)));
+  intptr_t utf8_len = 0;
+  for (intptr_t i = 0; i < len; i++) {
+    latin1[i] = Read<uint8_t>();
+    utf8_len += Utf8::Length(latin1[i]);
+  }
+  Dart_CObject* object = AllocateDartCObjectString(utf8_len);
+  char* p = object->value.as_string;
+  for (intptr_t i = 0; i < len; i++) {
+    p += Utf8::Encode(latin1[i], p);
+  }
+  *p = '\0';
+  ASSERT(p == (object->value.as_string + utf8_len));
+  return object;
+}
+
+Dart_CObject* ApiMessageReader::ReadUTF16String(intptr_t len) {
+  uint16_t* utf16 =
+      reinterpret_cast<uint16_t*>(allocator(len * sizeof(uint16_t)));
+  intptr_t utf8_len = 0;
+  // Read all the UTF-16 code units.
+  for (intptr_t i = 0; i < len; i++) {
+    utf16[i] = Read<uint16_t>();
+  }
+  // Calculate the UTF-8 length and check if the string can be
+  // UTF-8 encoded.
+  bool valid = true;
+  intptr_t i = 0;
+  while (i < len && valid) {
+    int32_t ch = Utf16::Next(utf16, &i, len);
+    utf8_len += Utf8::Length(ch);
+    valid = !Utf16::IsSurrogate(ch);
+  }
+  if (!valid) {
+    return AllocateDartCObjectUnsupported();
+  }
+  Dart_CObject* object = AllocateDartCObjectString(utf8_len);
+  char* p = object->value.as_string;
+  i = 0;
+  while (i < len) {
+    p += Utf8::Encode(Utf16::Next(utf16, &i, len), p);
+  }
+  *p = '\0';
+  ASSERT(p == (object->value.as_string + utf8_len));
+  return object;
+}
+
+static Dart_TypedData_Type FlatTypedDataType(intptr_t cid) {
+  switch (cid) {
+    case kTypedDataInt8ArrayCid:
+      return Dart_TypedData_kInt8;
+    case kTypedDataUint8ArrayCid:
+      return Dart_TypedData_kUint8;
+    case kTypedDataUint8ClampedArrayCid:
+      return Dart_TypedData_kUint8Clamped;
+    case kTypedDataInt16ArrayCid:
+      return Dart_TypedData_kInt16;
+    case kTypedDataUint16ArrayCid:
+      return Dart_TypedData_kUint16;
+    case kTypedDataInt32ArrayCid:
+      return Dart_TypedData_kInt32;
+    case kTypedDataUint32ArrayCid:
+      return Dart_TypedData_kUint32;
+    case kTypedDataInt64ArrayCid:
+      return Dart_TypedData_kInt64;
+    case kTypedDataUint64ArrayCid:
+      return Dart_TypedData_kUint64;
+    case kTypedDataFloat32ArrayCid:
+      return Dart_TypedData_kFloat32;
+    case kTypedDataFloat64ArrayCid:
+      return Dart_TypedData_kFloat64;
+    default:
+      UNREACHABLE();
+      return Dart_TypedData_kInvalid;
+  }
+}
+
+Dart_CObject* ApiMessageReader::ReadFlatObject() {
+  switch (Read<uint8_t>()) {
+    case kFlatNull:
+      return AllocateDartCObjectNull();
+    case kFlatTrue:
+      return AllocateDartCObjectBool(true);
+    case kFlatFalse:
+      return AllocateDartCObjectBool(false);
+    case kFlatInt: {
+      int64_t value64 = Read<int64_t>();
+      if ((kMinInt32 <= value64) && (value64 <= kMaxInt32)) {
+        return AllocateDartCObjectInt32(static_cast<int32_t>(value64));
+      }
+      return AllocateDartCObjectInt64(value64);
+    }
+    case kFlatDouble:
+      return AllocateDartCObjectDouble(ReadDouble());
+    case kFlatOneByteString:
+    case kFlatOneByteSymbol:
+      return ReadLatin1String(Read<int64_t>());
+    case kFlatTwoByteString:
+    case kFlatTwoByteSymbol:
+      return ReadUTF16String(Read<int64_t>());
+    case kFlatTypedData: {
+      const Dart_TypedData_Type type = FlatTypedDataType(ReadClassIDValue());
+      intptr_t len = Read<int64_t>();
+      Dart_CObject* object = AllocateDartCObjectTypedData(type, len);
+      if (len > 0) {
+        ReadBytes(object->value.as_typed_data.values,
+                  object->value.as_typed_data.length);
+      }
+      return object;
+    }
+    case kFlatExternalTypedData: {
+      // Native ports receive a copy, as for external typed data in regular
+      // messages.
+      const intptr_t cid = ReadClassIDValue();
+      intptr_t len = Read<int64_t>();
+      Dart_CObject* object =
+          AllocateDartCObjectTypedData(FlatTypedDataType(cid), len);
+      FinalizableData finalizable_data = finalizable_data_->Take();
+      memmove(object->value.as_typed_data.values, finalizable_data.data,
+              object->value.as_typed_data.length);
+      finalizable_data.callback(NULL, NULL, finalizable_data.peer);
+      return object;
+    }
+    case kFlatArray:
+    case kFlatGrowableArray: {
+      // Native ports see lists without their type arguments.
+      Read<uint8_t>();
+      intptr_t len = Read<int64_t>();
+      Dart_CObject* object = AllocateDartCObjectArray(len);
+      for (intptr_t i = 0; i < len; i++) {
+        object->value.as_array.values[i] = ReadFlatObject();
+      }
+      return object;
+    }
+    default:
+      UNREACHABLE();
+      return AllocateDartCObjectUnsupported();
+  }
+}
+
 Dart_CObject* ApiMessageReader::ReadIndexedObject(intptr_t object_id) {
   if (object_id == kDynamicType || object_id == kDoubleType ||
       object_id == kIntType || object_id == kBoolType ||
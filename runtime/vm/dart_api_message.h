@@ -114,6 +114,9 @@ class ApiMessageReader : public BaseReader {
   Dart_CObject* ReadPredefinedSymbol(intptr_t object_id);
   Dart_CObject* ReadObjectRef();
   Dart_CObject* ReadObject();
+  Dart_CObject* ReadFlatObject();
+  Dart_CObject* ReadLatin1String(intptr_t len);
+  Dart_CObject* ReadUTF16String(intptr_t len);
 
   // Add object to backward references.
   void AddBackRef(intptr_t id, Dart_CObject* obj, DeserializeState state);
@@ -148,6 +151,7 @@ class ApiMessageReader : public BaseReader {
   Dart_CObject dynamic_type_marker;
 
   MessageFinalizableData* finalizable_data_;
+  bool is_flat_;
 
   static _Dart_CObject* singleton_uint32_typed_data_;
 };
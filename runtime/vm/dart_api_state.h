@@ -25,6 +25,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, defer_weak_handle_finalizers);
+
 // Implementation of Zone support for very fast allocation of small chunks
 // of memory. The chunks cannot be deallocated individually, but instead
 // zones support deallocating all chunks in one fast operation when the
@@ -224,7 +226,23 @@ class FinalizablePersistentHandle {
   // Called when the referent becomes unreachable.
   void UpdateUnreachable(Isolate* isolate) {
     EnsureFreeExternal(isolate);
-    Finalize(isolate, this);
+    if (FLAG_defer_weak_handle_finalizers) {
+      QueueFinalization(isolate, this);
+    } else {
+      Finalize(isolate, this);
+    }
+  }
+
+  // Whether the referent died and the callback has been queued but has not
+  // run yet. Free handles have no callback.
+  bool IsFinalizationPending() const {
+    return !raw_->IsHeapObject() && (callback_ != NULL);
+  }
+
+  // Drops the queued callback of a handle deleted before it could run.
+  void CancelFinalization() {
+    ASSERT(IsFinalizationPending());
+    callback_ = NULL;
   }
 
   // Called when the referent has moved, potentially between generations.
@@ -269,6 +287,8 @@ class FinalizablePersistentHandle {
   ~FinalizablePersistentHandle() {}
 
   static void Finalize(Isolate* isolate, FinalizablePersistentHandle* handle);
+  static void QueueFinalization(Isolate* isolate,
+                                FinalizablePersistentHandle* handle);
 
   // Overload the raw_ field as a next pointer when adding freed
   // handles to the free list.
@@ -494,8 +514,12 @@ class FinalizablePersistentHandles
       : Handles<kFinalizablePersistentHandleSizeInWords,
                 kFinalizablePersistentHandlesPerChunk,
                 kOffsetOfRawPtrInFinalizablePersistentHandle>(),
-        free_list_(NULL) {}
-  ~FinalizablePersistentHandles() { free_list_ = NULL; }
+        free_list_(NULL),
+        pending_list_(NULL) {}
+  ~FinalizablePersistentHandles() {
+    ASSERT(pending_list_ == NULL);
+    free_list_ = NULL;
+  }
 
   // Accessors.
   FinalizablePersistentHandle* free_list() const { return free_list_; }
@@ -538,6 +562,21 @@ class FinalizablePersistentHandles
     set_free_list(handle);
   }
 
+  // Handles whose referents died in a GC with
+  // --defer_weak_handle_finalizers, chained through their raw_ fields like
+  // free handles. The GC only adds to the list inside its safepoint
+  // operation; the mutator takes the whole list when it runs the callbacks.
+  void AddPendingFinalization(FinalizablePersistentHandle* handle) {
+    handle->SetNext(pending_list_);
+    pending_list_ = handle;
+  }
+  bool HasPendingFinalizations() const { return pending_list_ != NULL; }
+
+  // Invokes the queued callbacks and frees their handles. Must be called
+  // outside of safepoint operations by the thread that has entered the
+  // isolate.
+  void RunPendingFinalizations(Isolate* isolate);
+
   // Validate if passed in handle is a Persistent Handle.
   bool IsValidHandle(Dart_WeakPersistentHandle object) const {
     return IsValidScopedHandle(reinterpret_cast<uword>(object));
@@ -559,6 +598,7 @@ class FinalizablePersistentHandles
 
  private:
   FinalizablePersistentHandle* free_list_;
+  FinalizablePersistentHandle* pending_list_;
   DISALLOW_COPY_AND_ASSIGN(FinalizablePersistentHandles);
 };
 
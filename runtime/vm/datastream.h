@@ -499,7 +499,21 @@ class StreamingWriteStream : public ValueObject {
     cursor_ += size;
   }
 
+  // Same encoding as WriteStream::WriteUnsigned.
+  void WriteUnsigned(intptr_t value) {
+    ASSERT((value >= 0) && (value <= kIntptrMax));
+    EnsureAvailable(kMaxUnsignedBytes);
+    while (value > kMaxUnsignedDataPerByte) {
+      *cursor_++ = static_cast<uint8_t>(value & kByteMask);
+      value = value >> kDataBitsPerByte;
+    }
+    *cursor_++ = static_cast<uint8_t>(value + kEndUnsignedByteMarker);
+  }
+
  private:
+  static const intptr_t kMaxUnsignedBytes =
+      (kBitsPerWord + kDataBitsPerByte - 1) / kDataBitsPerByte;
+
   void EnsureAvailable(intptr_t needed) {
     intptr_t available = limit_ - cursor_;
     if (available >= needed) return;
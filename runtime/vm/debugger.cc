@@ -24,6 +24,7 @@
 #include "vm/os.h"
 #include "vm/parser.h"
 #include "vm/port.h"
+#include "vm/program_visitor.h"
 #include "vm/runtime_entry.h"
 #include "vm/service.h"
 #include "vm/service_event.h"
@@ -1740,10 +1741,8 @@ RawFunction* Debugger::ResolveFunction(const Library& library,
   return function.raw();
 }
 
-// Deoptimize all functions in the isolate.
-// TODO(hausner): Actually we only need to deoptimize those functions
-// that inline the function that contains the newly created breakpoint.
-// We currently don't have this info so we deoptimize all functions.
+// Deoptimize all functions in the isolate. Needed for single stepping, which
+// may step into any function.
 void Debugger::DeoptimizeWorld() {
   BackgroundCompiler::Stop(isolate_);
   if (FLAG_trace_deoptimization) {
@@ -1796,6 +1795,76 @@ void Debugger::DeoptimizeWorld() {
   }
 }
 
+// Whether 'code' is optimized code of one of 'functions' or inlines one of
+// them.
+static bool OptimizedCodeContainsAny(const Code& code,
+                                     const GrowableObjectArray& functions) {
+  if (!code.is_optimized()) {
+    return false;
+  }
+  const Array& inlined = Array::Handle(code.inlined_id_to_function());
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    const RawObject* function = functions.At(i);
+    if (code.function() == function) {
+      return true;
+    }
+    for (intptr_t j = 0; !inlined.IsNull() && (j < inlined.Length()); j++) {
+      if (inlined.At(j) == function) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Deoptimize the optimized code of 'functions' and the optimized code into
+// which any of them was inlined, leaving all other optimized code running.
+// Functions with breakpoints are not optimized or inlined afterwards, see
+// Function::CanBeInlined.
+void Debugger::DeoptimizeFunctionsContaining(
+    const GrowableObjectArray& functions) {
+  // A compilation in progress may still inline one of the functions.
+  BackgroundCompiler::Stop(isolate_);
+  if (FLAG_trace_deoptimization) {
+    THR_Print("Deopt for breakpoint\n");
+  }
+
+  Code& code = Code::Handle();
+  DartFrameIterator iterator(Thread::Current(),
+                             StackFrameIterator::kNoCrossThreadIteration);
+  for (StackFrame* frame = iterator.NextFrame(); frame != NULL;
+       frame = iterator.NextFrame()) {
+    if (!frame->is_interpreted()) {
+      code = frame->LookupDartCode();
+      if (OptimizedCodeContainsAny(code, functions)) {
+        DeoptimizeAt(code, frame);
+      }
+    }
+  }
+
+  class DeoptimizeVisitor : public FunctionVisitor {
+   public:
+    explicit DeoptimizeVisitor(const GrowableObjectArray& functions)
+        : functions_(functions), code_(Code::Handle()) {}
+
+    void Visit(const Function& function) {
+      if (!function.HasOptimizedCode()) {
+        return;
+      }
+      code_ = function.CurrentCode();
+      if (OptimizedCodeContainsAny(code_, functions_)) {
+        function.SwitchToUnoptimizedCode();
+      }
+    }
+
+   private:
+    const GrowableObjectArray& functions_;
+    Code& code_;
+  };
+  DeoptimizeVisitor visitor(functions);
+  ProgramVisitor::VisitFunctions(&visitor);
+}
+
 ActivationFrame* Debugger::CollectDartFrame(Isolate* isolate,
                                             uword pc,
                                             StackFrame* frame,
@@ -2818,7 +2887,7 @@ BreakpointLocation* Debugger::SetBreakpoint(const Script& script,
     if (functions.Length() > 0) {
       // One or more function object containing this breakpoint location
       // have already been compiled. We can resolve the breakpoint now.
-      DeoptimizeWorld();
+      DeoptimizeFunctionsContaining(functions);
       func ^= functions.At(0);
       TokenPosition exact_token_pos = TokenPosition(-1);
       // if requested_column is larger than zero, [token_pos, last_token_pos]
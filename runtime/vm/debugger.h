@@ -639,6 +639,7 @@ class Debugger {
                                      intptr_t requested_column,
                                      intptr_t exact_token_pos);
   void DeoptimizeWorld();
+  void DeoptimizeFunctionsContaining(const GrowableObjectArray& functions);
   BreakpointLocation* SetBreakpoint(const Script& script,
                                     TokenPosition token_pos,
                                     TokenPosition last_token_pos,
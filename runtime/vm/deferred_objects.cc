@@ -315,6 +315,11 @@ void DeferredObject::Fill() {
         }
       }
     }
+
+    // The inner pointer of a view is not among the materialized fields.
+    if (RawObject::IsTypedDataViewClassId(cls.id())) {
+      TypedDataView::Cast(obj).raw()->RecomputeDataField();
+    }
   }
 }
 
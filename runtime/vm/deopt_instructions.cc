@@ -12,6 +12,7 @@
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/locations.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/compiler/jit/deopt_statistics.h"
 #include "vm/parser.h"
 #include "vm/stack_frame.h"
 #include "vm/thread.h"
@@ -26,6 +27,11 @@ DEFINE_FLAG(bool,
 DECLARE_FLAG(bool, trace_deoptimization);
 DECLARE_FLAG(bool, trace_deoptimization_verbose);
 
+static void FindDeoptSite(const GrowableArray<DeoptInstr*>& instructions,
+                          intptr_t first_frame_index,
+                          intptr_t* function_index,
+                          intptr_t* deopt_id);
+
 DeoptContext::DeoptContext(const StackFrame* frame,
                            const Code& code,
                            DestFrameOptions dest_options,
@@ -49,6 +55,8 @@ DeoptContext::DeoptContext(const StackFrame* frame,
       deopt_flags_(0),
       thread_(Thread::Current()),
       deopt_start_micros_(0),
+      deopt_site_function_index_(-1),
+      deopt_site_deopt_id_(DeoptId::kNone),
       deferred_slots_(NULL),
       deferred_objects_count_(0),
       deferred_objects_(NULL),
@@ -156,6 +164,18 @@ DeoptContext::~DeoptContext() {
   deferred_objects_ = NULL;
   deferred_objects_count_ = 0;
 
+#if !defined(PRODUCT)
+  if ((deopt_start_micros_ != 0) && (deopt_site_function_index_ >= 0)) {
+    const Code& code = Code::Handle(zone(), code_);
+    const Function& function = Function::Handle(zone(), code.function());
+    Function& site_function = Function::Handle(zone());
+    site_function ^= ObjectAt(deopt_site_function_index_);
+    DeoptStatistics::RecordDeoptimization(thread_, function, site_function,
+                                          deopt_site_deopt_id_, deopt_reason(),
+                                          is_lazy_deopt_);
+  }
+#endif  // !defined(PRODUCT)
+
 #if defined(SUPPORT_TIMELINE)
   if (deopt_start_micros_ != 0) {
     TimelineStream* compiler_stream = Timeline::GetCompilerStream();
@@ -173,10 +193,14 @@ DeoptContext::~DeoptContext() {
       if (timeline_event != NULL) {
         timeline_event->Duration("Deoptimize", deopt_start_micros_,
                                  OS::GetCurrentMonotonicMicros());
-        timeline_event->SetNumArguments(3);
+        timeline_event->SetNumArguments(5);
         timeline_event->CopyArgument(0, "function", function_name.ToCString());
         timeline_event->CopyArgument(1, "reason", reason);
         timeline_event->FormatArgument(2, "deoptimizationCount", "%d", counter);
+        timeline_event->FormatArgument(3, "deoptId", "%" Pd,
+                                       deopt_site_deopt_id_);
+        timeline_event->CopyArgument(4, "lazy",
+                                     is_lazy_deopt_ ? "true" : "false");
         timeline_event->Complete();
       }
     }
@@ -315,6 +339,8 @@ void DeoptContext::FillDestFrame() {
     SetDeferredObjectAt(from_index, obj);
     to_index += obj->ArgumentCount();
   }
+  FindDeoptSite(deopt_instructions, num_materializations,
+                &deopt_site_function_index_, &deopt_site_deopt_id_);
 
   // Populate stack frames.
   for (intptr_t to_index = frame_size - 1, from_index = len - 1; to_index >= 0;
@@ -486,6 +512,23 @@ class DeoptRetAddressInstr : public DeoptInstr {
   DISALLOW_COPY_AND_ASSIGN(DeoptRetAddressInstr);
 };
 
+// The first return address of the frame instructions is the one of the
+// innermost frame, its deopt-id is the one of the deoptimization point.
+static void FindDeoptSite(const GrowableArray<DeoptInstr*>& instructions,
+                          intptr_t first_frame_index,
+                          intptr_t* function_index,
+                          intptr_t* deopt_id) {
+  for (intptr_t i = first_frame_index; i < instructions.length(); i++) {
+    if (instructions[i]->kind() == DeoptInstr::kRetAddress) {
+      DeoptRetAddressInstr* ret_address =
+          static_cast<DeoptRetAddressInstr*>(instructions[i]);
+      *function_index = ret_address->object_table_index();
+      *deopt_id = ret_address->deopt_id();
+      return;
+    }
+  }
+}
+
 // Deoptimization instruction moving a constant stored at 'object_table_index'.
 class DeoptConstantInstr : public DeoptInstr {
  public:
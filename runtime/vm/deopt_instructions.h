@@ -276,6 +276,11 @@ class DeoptContext {
   intptr_t caller_fp_;
   Thread* thread_;
   int64_t deopt_start_micros_;
+  // The deopt site in the innermost frame of the deoptimization environment,
+  // set by FillDestFrame: the object table index of its function and its
+  // deopt-id.
+  intptr_t deopt_site_function_index_;
+  intptr_t deopt_site_deopt_id_;
 
   DeferredSlot* deferred_slots_;
 
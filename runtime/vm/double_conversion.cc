@@ -6,9 +6,11 @@
 
 #include "third_party/double-conversion/src/double-conversion.h"
 
+#include "vm/eisel_lemire.h"
 #include "vm/exceptions.h"
 #include "vm/globals.h"
 #include "vm/object.h"
+#include "vm/ryu.h"
 
 namespace dart {
 
@@ -16,9 +18,83 @@ static const char kDoubleToStringCommonExponentChar = 'e';
 static const char* kDoubleToStringCommonInfinitySymbol = "Infinity";
 static const char* kDoubleToStringCommonNaNSymbol = "NaN";
 
+static const int kDecimalLow = -6;
+static const int kDecimalHigh = 21;
+
+// Writes the shortest representation of a finite |d| in the same format
+// the DoubleToStringConverter in DoubleToCString produces, using Ryu to
+// generate the digits.
+static void ShortestToCString(double d, char* buffer) {
+  char* out = buffer;
+  if (signbit(d)) {
+    *out++ = '-';
+    d = -d;
+  }
+  if (d == 0.0) {
+    out[0] = '0';
+    out[1] = '.';
+    out[2] = '0';
+    out[3] = '\0';
+    return;
+  }
+
+  uint64_t significand;
+  int exponent;
+  Ryu::ShortestDecimal(d, &significand, &exponent);
+  char digits[20];
+  int length = 0;
+  do {
+    digits[length++] = '0' + static_cast<char>(significand % 10);
+    significand /= 10;
+  } while (significand != 0);
+  for (int i = 0, j = length - 1; i < j; i++, j--) {
+    const char digit = digits[i];
+    digits[i] = digits[j];
+    digits[j] = digit;
+  }
+
+  // The value is 0.digits * 10^decimal_point.
+  const int decimal_point = exponent + length;
+  const int exponent10 = decimal_point - 1;
+  if ((kDecimalLow <= exponent10) && (exponent10 < kDecimalHigh)) {
+    if (decimal_point <= 0) {
+      *out++ = '0';
+      *out++ = '.';
+      for (int i = decimal_point; i < 0; i++) {
+        *out++ = '0';
+      }
+      memmove(out, digits, length);
+      out += length;
+    } else if (decimal_point >= length) {
+      memmove(out, digits, length);
+      out += length;
+      for (int i = length; i < decimal_point; i++) {
+        *out++ = '0';
+      }
+      *out++ = '.';
+      *out++ = '0';
+    } else {
+      memmove(out, digits, decimal_point);
+      out += decimal_point;
+      *out++ = '.';
+      memmove(out, digits + decimal_point, length - decimal_point);
+      out += length - decimal_point;
+    }
+    *out = '\0';
+    return;
+  }
+
+  *out++ = digits[0];
+  if (length > 1) {
+    *out++ = '.';
+    memmove(out, digits + 1, length - 1);
+    out += length - 1;
+  }
+  *out++ = kDoubleToStringCommonExponentChar;
+  Utils::SNPrint(out, 6, "%+d", exponent10);
+}
+
 void DoubleToCString(double d, char* buffer, int buffer_size) {
-  static const int kDecimalLow = -6;
-  static const int kDecimalHigh = 21;
 
   // The output contains the sign, at most kDecimalHigh - 1 digits,
   // the decimal point followed by a 0 plus the \0.
@@ -31,6 +107,11 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   // sign, at most three exponent digits, plus the \0.
   ASSERT(buffer_size >= 1 + 17 + 1 + 1 + 1 + 3 + 1);
 
+  if (!isnan(d) && !isinf(d)) {
+    ShortestToCString(d, buffer);
+    return;
+  }
+
   static const int kConversionFlags =
       double_conversion::DoubleToStringConverter::EMIT_POSITIVE_EXPONENT_SIGN |
       double_conversion::DoubleToStringConverter::EMIT_TRAILING_DECIMAL_POINT |
@@ -156,11 +237,94 @@ RawString* DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+static inline bool IsDecimalDigit(char c) {
+  return (c >= '0') && (c <= '9');
+}
+
+// Parses the common form -?digits(.digits)?([eE][+-]?digits)? with at most
+// 19 significant digits, which Eisel-Lemire converts without any bignum
+// arithmetic. Returns false for everything else, including the rare inputs
+// Eisel-Lemire cannot decide, which are left to the converter.
+static bool SimpleStringToDouble(const char* str,
+                                 intptr_t length,
+                                 double* result) {
+  static const int kMaxSignificantDigits = 19;
+  // Exponents beyond this only matter for their sign, as any non-zero
+  // significand then over- or underflows.
+  static const int64_t kMaxExponent = 100000;
+
+  const char* current = str;
+  const char* end = str + length;
+  const bool negative = (*current == '-');
+  if (negative) {
+    current++;
+  }
+  if ((current == end) || !IsDecimalDigit(*current)) {
+    return false;
+  }
+
+  uint64_t significand = 0;
+  int significant_digits = 0;
+  int64_t exponent = 0;
+  while ((current != end) && IsDecimalDigit(*current)) {
+    if ((significand != 0) || (*current != '0')) {
+      if (++significant_digits > kMaxSignificantDigits) {
+        return false;
+      }
+      significand = significand * 10 + (*current - '0');
+    }
+    current++;
+  }
+  if ((current != end) && (*current == '.')) {
+    current++;
+    if ((current == end) || !IsDecimalDigit(*current)) {
+      return false;
+    }
+    while ((current != end) && IsDecimalDigit(*current)) {
+      if ((significand != 0) || (*current != '0')) {
+        if (++significant_digits > kMaxSignificantDigits) {
+          return false;
+        }
+        significand = significand * 10 + (*current - '0');
+      }
+      exponent--;
+      current++;
+    }
+  }
+  if ((current != end) && ((*current == 'e') || (*current == 'E'))) {
+    current++;
+    bool negative_exponent = false;
+    if ((current != end) && ((*current == '+') || (*current == '-'))) {
+      negative_exponent = (*current == '-');
+      current++;
+    }
+    if ((current == end) || !IsDecimalDigit(*current)) {
+      return false;
+    }
+    int64_t exponent_value = 0;
+    while ((current != end) && IsDecimalDigit(*current)) {
+      if (exponent_value < kMaxExponent) {
+        exponent_value = exponent_value * 10 + (*current - '0');
+      }
+      current++;
+    }
+    exponent += negative_exponent ? -exponent_value : exponent_value;
+  }
+  if (current != end) {
+    return false;
+  }
+  return EiselLemire::ToDouble(significand, exponent, negative, result);
+}
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
 
+  if (SimpleStringToDouble(str, length, result)) {
+    return true;
+  }
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kDoubleToStringCommonInfinitySymbol, kDoubleToStringCommonNaNSymbol);
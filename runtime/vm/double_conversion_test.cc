@@ -0,0 +1,68 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_conversion.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static void ExpectDoubleToCString(const char* expected, double value) {
+  char buffer[64];
+  DoubleToCString(value, buffer, sizeof(buffer));
+  EXPECT_STREQ(expected, buffer);
+}
+
+static void ExpectCStringToDouble(double expected, const char* str) {
+  double result = 0.0;
+  EXPECT(CStringToDouble(str, strlen(str), &result));
+  EXPECT_EQ(bit_cast<uint64_t>(expected), bit_cast<uint64_t>(result));
+}
+
+VM_UNIT_TEST_CASE(DoubleToCString) {
+  ExpectDoubleToCString("0.0", 0.0);
+  ExpectDoubleToCString("-0.0", -0.0);
+  ExpectDoubleToCString("1.0", 1.0);
+  ExpectDoubleToCString("0.1", 0.1);
+  ExpectDoubleToCString("-1.5", -1.5);
+  ExpectDoubleToCString("0.000001", 1e-6);
+  ExpectDoubleToCString("1e-7", 1e-7);
+  ExpectDoubleToCString("100000000000000000000.0", 1e20);
+  ExpectDoubleToCString("1e+21", 1e21);
+  ExpectDoubleToCString("123456789012345680000.0", 123456789012345678901.0);
+  ExpectDoubleToCString("1.7976931348623157e+308", 1.7976931348623157e308);
+  ExpectDoubleToCString("5e-324", 5e-324);
+  ExpectDoubleToCString("Infinity", bit_cast<double>(0x7FF0000000000000ULL));
+  ExpectDoubleToCString("NaN", bit_cast<double>(0x7FF8000000000000ULL));
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble) {
+  ExpectCStringToDouble(0.0, "0");
+  ExpectCStringToDouble(-0.0, "-0");
+  ExpectCStringToDouble(0.5, "00.5");
+  ExpectCStringToDouble(0.1, "0.1");
+  ExpectCStringToDouble(-1250.0, "-1.25e+3");
+  ExpectCStringToDouble(1e-5, "1E-5");
+  ExpectCStringToDouble(9007199254740992.0, "9007199254740993");
+  ExpectCStringToDouble(5e-324, "4.9406564584124654e-324");
+  ExpectCStringToDouble(0.0, "2.4703282292062327e-324");
+  ExpectCStringToDouble(1.7976931348623157e308, "1.7976931348623158e308");
+  ExpectCStringToDouble(bit_cast<double>(0x7FF0000000000000ULL), "1e400");
+  ExpectCStringToDouble(0.0, "1e-400");
+  // Inputs outside of the fast path go through the slower converter.
+  ExpectCStringToDouble(1.0, "+1");
+  ExpectCStringToDouble(0.5, ".5");
+  ExpectCStringToDouble(1.0, "1.");
+  ExpectCStringToDouble(1e20, "100000000000000000000.0000");
+  ExpectCStringToDouble(0.1, "0.1000000000000000055511151231257827021181583");
+  ExpectCStringToDouble(bit_cast<double>(0x7FF0000000000000ULL), "Infinity");
+
+  double result;
+  EXPECT(!CStringToDouble("", 0, &result));
+  EXPECT(!CStringToDouble("1e", 2, &result));
+  EXPECT(!CStringToDouble("-", 1, &result));
+  EXPECT(!CStringToDouble("12a", 3, &result));
+}
+
+}  // namespace dart
@@ -0,0 +1,31 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_EISEL_LEMIRE_H_
+#define RUNTIME_VM_EISEL_LEMIRE_H_
+
+#include "platform/allocation.h"
+#include "platform/globals.h"
+
+namespace dart {
+
+// Correctly rounded conversion of decimals with up to 19 significant digits
+// to doubles, using the algorithm of Eisel and Lemire ("Number Parsing at a
+// Gigabyte per Second", Software: Practice and Experience 51(8), 2021). It
+// multiplies the significand by a 128-bit approximation of the power of ten,
+// which almost always determines the rounding without any bignum work.
+class EiselLemire : public AllStatic {
+ public:
+  // Stores the double nearest to significand * 10^exponent, negated if
+  // |negative|, in |result|. Returns false in the rare cases where the
+  // approximation cannot decide the rounding, which need an exact algorithm.
+  static bool ToDouble(uint64_t significand,
+                       int64_t exponent,
+                       bool negative,
+                       double* result);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_EISEL_LEMIRE_H_
@@ -0,0 +1,433 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/elf.h"
+
+#include "platform/utils.h"
+#include "vm/os.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+static const intptr_t ELFCLASS32 = 1;
+static const intptr_t ELFCLASS64 = 2;
+static const intptr_t ELFDATA2LSB = 1;
+static const intptr_t EV_CURRENT = 1;
+static const intptr_t ELFOSABI_SYSV = 0;
+
+static const intptr_t ET_DYN = 3;
+
+static const intptr_t EM_386 = 3;
+static const intptr_t EM_ARM = 40;
+static const intptr_t EM_X86_64 = 62;
+static const intptr_t EM_AARCH64 = 183;
+
+static const intptr_t EF_ARM_ABI_VER5 = 0x05000000;
+
+static const intptr_t PT_LOAD = 1;
+static const intptr_t PT_DYNAMIC = 2;
+static const intptr_t PT_GNU_STACK = 0x6474e551;
+
+static const intptr_t PF_X = 1;
+static const intptr_t PF_W = 2;
+static const intptr_t PF_R = 4;
+
+static const intptr_t SHT_NULL = 0;
+static const intptr_t SHT_PROGBITS = 1;
+static const intptr_t SHT_STRTAB = 3;
+static const intptr_t SHT_HASH = 5;
+static const intptr_t SHT_DYNAMIC = 6;
+static const intptr_t SHT_DYNSYM = 11;
+
+static const intptr_t SHF_WRITE = 1;
+static const intptr_t SHF_ALLOC = 2;
+static const intptr_t SHF_EXECINSTR = 4;
+
+static const intptr_t STB_GLOBAL = 1;
+static const intptr_t STT_OBJECT = 1;
+static const intptr_t STT_FUNC = 2;
+
+static const intptr_t DT_NULL = 0;
+static const intptr_t DT_HASH = 4;
+static const intptr_t DT_STRTAB = 5;
+static const intptr_t DT_SYMTAB = 6;
+static const intptr_t DT_STRSZ = 10;
+static const intptr_t DT_SYMENT = 11;
+
+#if defined(ARCH_IS_32_BIT)
+static const intptr_t kElfClass = ELFCLASS32;
+static const intptr_t kElfHeaderSize = 52;
+static const intptr_t kProgramHeaderSize = 32;
+static const intptr_t kSectionHeaderSize = 40;
+static const intptr_t kSymbolSize = 16;
+#elif defined(ARCH_IS_64_BIT)
+static const intptr_t kElfClass = ELFCLASS64;
+static const intptr_t kElfHeaderSize = 64;
+static const intptr_t kProgramHeaderSize = 56;
+static const intptr_t kSectionHeaderSize = 64;
+static const intptr_t kSymbolSize = 24;
+#endif
+static const intptr_t kDynamicEntrySize = 2 * kWordSize;
+
+// The order of the sections in the file, which is also their layout in
+// memory.
+enum {
+  kNullSection = 0,
+  kDynstrSection,
+  kDynsymSection,
+  kHashSection,
+  kTextSection,
+  kRODataSection,
+  kDynamicSection,
+  kShstrtabSection,
+  kNumSections,
+};
+
+static const char* const kSectionNames[kNumSections] = {
+    "", ".dynstr", ".dynsym", ".hash", ".text", ".rodata", ".dynamic",
+    ".shstrtab",
+};
+
+static const intptr_t kNumDynamicEntries = 6;
+
+// Segments for the headers, .text, .rodata, .dynamic, and the stack.
+static const intptr_t kNumProgramHeaders = 6;
+
+// The hash function of the System V ABI, used by the dynamic linker to look
+// up symbols in .hash.
+static uint32_t ElfHash(const char* name) {
+  uint32_t h = 0;
+  for (const uint8_t* p = reinterpret_cast<const uint8_t*>(name); *p != 0;
+       p++) {
+    h = (h << 4) + *p;
+    const uint32_t g = h & 0xf0000000;
+    h ^= g >> 24;
+    h &= ~g;
+  }
+  return h;
+}
+
+Elf::Elf(Zone* zone, StreamingWriteStream* stream)
+    : zone_(zone),
+      stream_(stream),
+      text_(zone, 2),
+      rodata_(zone, 2),
+      text_size_(0),
+      rodata_size_(0) {}
+
+intptr_t Elf::AddBlob(GrowableArray<Blob>* blobs,
+                      intptr_t section_size,
+                      const char* name,
+                      const uint8_t* bytes,
+                      intptr_t size,
+                      intptr_t alignment) {
+  Blob blob;
+  blob.name = name;
+  blob.bytes = bytes;
+  blob.size = size;
+  blob.offset = Utils::RoundUp(section_size, alignment);
+  blob.name_offset = 0;
+  blobs->Add(blob);
+  return blob.offset + size;
+}
+
+void Elf::AddText(const char* name, const uint8_t* bytes, intptr_t size) {
+  text_size_ = AddBlob(&text_, text_size_, name, bytes, size, kPageSize);
+}
+
+void Elf::AddROData(const char* name, const uint8_t* bytes, intptr_t size) {
+  rodata_size_ = AddBlob(&rodata_, rodata_size_, name, bytes, size,
+                         OS::kMaxPreferredCodeAlignment);
+}
+
+void Elf::Finalize() {
+  // Symbol 0 is the undefined symbol, followed by the text and data symbols.
+  const intptr_t num_symbols = 1 + text_.length() + rodata_.length();
+
+  intptr_t dynstr_size = 1;
+  for (intptr_t i = 0; i < text_.length(); i++) {
+    text_[i].name_offset = dynstr_size;
+    dynstr_size += strlen(text_[i].name) + 1;
+  }
+  for (intptr_t i = 0; i < rodata_.length(); i++) {
+    rodata_[i].name_offset = dynstr_size;
+    dynstr_size += strlen(rodata_[i].name) + 1;
+  }
+
+  intptr_t shstrtab_size = 0;
+  intptr_t section_names[kNumSections];
+  for (intptr_t i = 0; i < kNumSections; i++) {
+    section_names[i] = shstrtab_size;
+    shstrtab_size += strlen(kSectionNames[i]) + 1;
+  }
+
+  // One bucket per symbol keeps the chains short.
+  const intptr_t num_buckets = num_symbols;
+  const intptr_t hash_size = (2 + num_buckets + num_symbols) * sizeof(uint32_t);
+
+  // Virtual addresses equal file offsets, which trivially satisfies the
+  // congruence that the dynamic linker requires for each segment.
+  intptr_t offsets[kNumSections];
+  intptr_t sizes[kNumSections];
+  offsets[kNullSection] = 0;
+  sizes[kNullSection] = 0;
+  intptr_t offset = kElfHeaderSize + kNumProgramHeaders * kProgramHeaderSize;
+  offsets[kDynstrSection] = offset;
+  sizes[kDynstrSection] = dynstr_size;
+  offset += dynstr_size;
+  offsets[kDynsymSection] = offset = Utils::RoundUp(offset, kWordSize);
+  sizes[kDynsymSection] = num_symbols * kSymbolSize;
+  offset += sizes[kDynsymSection];
+  offsets[kHashSection] = offset = Utils::RoundUp(offset, sizeof(uint32_t));
+  sizes[kHashSection] = hash_size;
+  offset += hash_size;
+  const intptr_t headers_size = offset;
+  // Each remaining loaded section gets its own segment, hence its own pages.
+  offsets[kTextSection] = offset = Utils::RoundUp(offset, kPageSize);
+  sizes[kTextSection] = text_size_;
+  offset += text_size_;
+  offsets[kRODataSection] = offset = Utils::RoundUp(offset, kPageSize);
+  sizes[kRODataSection] = rodata_size_;
+  offset += rodata_size_;
+  offsets[kDynamicSection] = offset = Utils::RoundUp(offset, kPageSize);
+  sizes[kDynamicSection] = kNumDynamicEntries * kDynamicEntrySize;
+  offset += sizes[kDynamicSection];
+  offsets[kShstrtabSection] = offset;
+  sizes[kShstrtabSection] = shstrtab_size;
+  offset += shstrtab_size;
+  const intptr_t section_headers_offset = Utils::RoundUp(offset, kWordSize);
+
+  ASSERT(stream_->position() == 0);
+  WriteHeader(kNumProgramHeaders, section_headers_offset, kNumSections,
+              kShstrtabSection);
+
+  WriteProgramHeader(PT_LOAD, PF_R, 0, headers_size, kPageSize);
+  WriteProgramHeader(PT_LOAD, PF_R | PF_X, offsets[kTextSection],
+                     sizes[kTextSection], kPageSize);
+  WriteProgramHeader(PT_LOAD, PF_R, offsets[kRODataSection],
+                     sizes[kRODataSection], kPageSize);
+  WriteProgramHeader(PT_LOAD, PF_R | PF_W, offsets[kDynamicSection],
+                     sizes[kDynamicSection], kPageSize);
+  WriteProgramHeader(PT_DYNAMIC, PF_R | PF_W, offsets[kDynamicSection],
+                     sizes[kDynamicSection], kWordSize);
+  // Without this the dynamic linker assumes the object needs an executable
+  // stack.
+  WriteProgramHeader(PT_GNU_STACK, PF_R | PF_W, 0, 0, 0);
+
+  ASSERT(stream_->position() == offsets[kDynstrSection]);
+  WriteString("");
+  for (intptr_t i = 0; i < text_.length(); i++) {
+    WriteString(text_[i].name);
+  }
+  for (intptr_t i = 0; i < rodata_.length(); i++) {
+    WriteString(rodata_[i].name);
+  }
+
+  PadTo(offsets[kDynsymSection]);
+  WriteSymbol(0, 0, kNullSection, 0, 0);
+  for (intptr_t i = 0; i < text_.length(); i++) {
+    WriteSymbol(text_[i].name_offset, (STB_GLOBAL << 4) | STT_FUNC,
+                kTextSection, offsets[kTextSection] + text_[i].offset,
+                text_[i].size);
+  }
+  for (intptr_t i = 0; i < rodata_.length(); i++) {
+    WriteSymbol(rodata_[i].name_offset, (STB_GLOBAL << 4) | STT_OBJECT,
+                kRODataSection, offsets[kRODataSection] + rodata_[i].offset,
+                rodata_[i].size);
+  }
+
+  PadTo(offsets[kHashSection]);
+  uint32_t* buckets = zone_->Alloc<uint32_t>(num_buckets);
+  uint32_t* chains = zone_->Alloc<uint32_t>(num_symbols);
+  memset(buckets, 0, num_buckets * sizeof(uint32_t));
+  memset(chains, 0, num_symbols * sizeof(uint32_t));
+  for (intptr_t i = 1; i < num_symbols; i++) {
+    const char* name = (i <= text_.length())
+                           ? text_[i - 1].name
+                           : rodata_[i - 1 - text_.length()].name;
+    const intptr_t bucket = ElfHash(name) % num_buckets;
+    chains[i] = buckets[bucket];
+    buckets[bucket] = i;
+  }
+  WriteWord(num_buckets);
+  WriteWord(num_symbols);
+  WriteBytes(buckets, num_buckets * sizeof(uint32_t));
+  WriteBytes(chains, num_symbols * sizeof(uint32_t));
+
+  WriteBlobs(text_, offsets[kTextSection]);
+  WriteBlobs(rodata_, offsets[kRODataSection]);
+
+  PadTo(offsets[kDynamicSection]);
+  WriteDynamicEntry(DT_HASH, offsets[kHashSection]);
+  WriteDynamicEntry(DT_STRTAB, offsets[kDynstrSection]);
+  WriteDynamicEntry(DT_STRSZ, sizes[kDynstrSection]);
+  WriteDynamicEntry(DT_SYMTAB, offsets[kDynsymSection]);
+  WriteDynamicEntry(DT_SYMENT, kSymbolSize);
+  WriteDynamicEntry(DT_NULL, 0);
+
+  ASSERT(stream_->position() == offsets[kShstrtabSection]);
+  for (intptr_t i = 0; i < kNumSections; i++) {
+    WriteString(kSectionNames[i]);
+  }
+
+  PadTo(section_headers_offset);
+  WriteSectionHeader(section_names[kNullSection], SHT_NULL, 0, 0, 0, 0, 0, 0,
+                     0);
+  WriteSectionHeader(section_names[kDynstrSection], SHT_STRTAB, SHF_ALLOC,
+                     offsets[kDynstrSection], sizes[kDynstrSection], 0, 0, 1,
+                     0);
+  // The info of a symbol table is the index of its first global symbol.
+  WriteSectionHeader(section_names[kDynsymSection], SHT_DYNSYM, SHF_ALLOC,
+                     offsets[kDynsymSection], sizes[kDynsymSection],
+                     kDynstrSection, 1, kWordSize, kSymbolSize);
+  WriteSectionHeader(section_names[kHashSection], SHT_HASH, SHF_ALLOC,
+                     offsets[kHashSection], sizes[kHashSection],
+                     kDynsymSection, 0, sizeof(uint32_t), sizeof(uint32_t));
+  WriteSectionHeader(section_names[kTextSection], SHT_PROGBITS,
+                     SHF_ALLOC | SHF_EXECINSTR, offsets[kTextSection],
+                     sizes[kTextSection], 0, 0, kPageSize, 0);
+  WriteSectionHeader(section_names[kRODataSection], SHT_PROGBITS, SHF_ALLOC,
+                     offsets[kRODataSection], sizes[kRODataSection], 0, 0,
+                     OS::kMaxPreferredCodeAlignment, 0);
+  WriteSectionHeader(section_names[kDynamicSection], SHT_DYNAMIC,
+                     SHF_ALLOC | SHF_WRITE, offsets[kDynamicSection],
+                     sizes[kDynamicSection], kDynstrSection, 0, kWordSize,
+                     kDynamicEntrySize);
+  WriteSectionHeader(section_names[kShstrtabSection], SHT_STRTAB, 0,
+                     offsets[kShstrtabSection], sizes[kShstrtabSection], 0, 0,
+                     1, 0);
+}
+
+void Elf::WriteHeader(intptr_t num_program_headers,
+                      intptr_t section_headers_offset,
+                      intptr_t num_sections,
+                      intptr_t shstrtab_index) {
+  const uint8_t ident[16] = {
+      0x7f, 'E', 'L', 'F', kElfClass, ELFDATA2LSB, EV_CURRENT, ELFOSABI_SYSV,
+  };
+  WriteBytes(ident, sizeof(ident));
+  WriteHalf(ET_DYN);
+#if defined(TARGET_ARCH_IA32)
+  WriteHalf(EM_386);
+#elif defined(TARGET_ARCH_X64)
+  WriteHalf(EM_X86_64);
+#elif defined(TARGET_ARCH_ARM)
+  WriteHalf(EM_ARM);
+#elif defined(TARGET_ARCH_ARM64)
+  WriteHalf(EM_AARCH64);
+#else
+  FATAL("Unknown ELF architecture");
+#endif
+  WriteWord(EV_CURRENT);
+  WriteAddr(0);  // No entry point.
+  WriteAddr(kElfHeaderSize);  // Program headers follow the ELF header.
+  WriteAddr(section_headers_offset);
+#if defined(TARGET_ARCH_ARM)
+  WriteWord(EF_ARM_ABI_VER5);
+#else
+  WriteWord(0);
+#endif
+  WriteHalf(kElfHeaderSize);
+  WriteHalf(kProgramHeaderSize);
+  WriteHalf(num_program_headers);
+  WriteHalf(kSectionHeaderSize);
+  WriteHalf(num_sections);
+  WriteHalf(shstrtab_index);
+}
+
+void Elf::WriteProgramHeader(intptr_t type,
+                             intptr_t flags,
+                             intptr_t offset,
+                             intptr_t size,
+                             intptr_t alignment) {
+  WriteWord(type);
+#if defined(ARCH_IS_64_BIT)
+  WriteWord(flags);
+#endif
+  WriteAddr(offset);
+  WriteAddr(offset);  // Virtual address.
+  WriteAddr(offset);  // Physical address.
+  WriteAddr(size);    // Size in the file.
+  WriteAddr(size);    // Size in memory.
+#if defined(ARCH_IS_32_BIT)
+  WriteWord(flags);
+#endif
+  WriteAddr(alignment);
+}
+
+void Elf::WriteSectionHeader(intptr_t name,
+                             intptr_t type,
+                             intptr_t flags,
+                             intptr_t offset,
+                             intptr_t size,
+                             intptr_t link,
+                             intptr_t info,
+                             intptr_t alignment,
+                             intptr_t entry_size) {
+  WriteWord(name);
+  WriteWord(type);
+  WriteAddr(flags);
+  WriteAddr((flags & SHF_ALLOC) != 0 ? offset : 0);  // Virtual address.
+  WriteAddr(offset);
+  WriteAddr(size);
+  WriteWord(link);
+  WriteWord(info);
+  WriteAddr(alignment);
+  WriteAddr(entry_size);
+}
+
+void Elf::WriteSymbol(intptr_t name,
+                      intptr_t info,
+                      intptr_t section,
+                      intptr_t offset,
+                      intptr_t size) {
+  const uint8_t info_byte = info;
+  const uint8_t other = 0;  // Default visibility.
+  WriteWord(name);
+#if defined(ARCH_IS_32_BIT)
+  WriteAddr(offset);
+  WriteAddr(size);
+  WriteBytes(&info_byte, 1);
+  WriteBytes(&other, 1);
+  WriteHalf(section);
+#else
+  WriteBytes(&info_byte, 1);
+  WriteBytes(&other, 1);
+  WriteHalf(section);
+  WriteAddr(offset);
+  WriteAddr(size);
+#endif
+}
+
+void Elf::WriteDynamicEntry(intptr_t tag, intptr_t value) {
+  WriteAddr(tag);
+  WriteAddr(value);
+}
+
+void Elf::WriteBlobs(const GrowableArray<Blob>& blobs,
+                     intptr_t section_offset) {
+  for (intptr_t i = 0; i < blobs.length(); i++) {
+    PadTo(section_offset + blobs[i].offset);
+    WriteBytes(blobs[i].bytes, blobs[i].size);
+  }
+}
+
+void Elf::WriteString(const char* string) {
+  WriteBytes(string, strlen(string) + 1);
+}
+
+void Elf::PadTo(intptr_t offset) {
+  ASSERT(stream_->position() <= offset);
+  static const uint8_t kZeros[64] = {0};
+  while (stream_->position() < offset) {
+    const intptr_t padding =
+        Utils::Minimum<intptr_t>(offset - stream_->position(), sizeof(kZeros));
+    WriteBytes(kZeros, padding);
+  }
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -0,0 +1,112 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_ELF_H_
+#define RUNTIME_VM_ELF_H_
+
+#include "vm/allocation.h"
+#include "vm/datastream.h"
+#include "vm/growable_array.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+// Writes an ELF shared object which exports blobs of instructions and data
+// as dynamic symbols, so that an AOT snapshot can be loaded with dlopen
+// without going through an assembler and a linker first.
+//
+// All added text is placed in a single executable .text section and all
+// added data in a single read-only .rodata section. The object has no
+// relocations: the snapshots only contain offsets relative to the start of
+// their own image.
+class Elf : public ZoneAllocated {
+ public:
+  Elf(Zone* zone, StreamingWriteStream* stream);
+
+#if defined(TARGET_ARCH_ARM64)
+  // Large enough for any page size an AArch64 kernel may be configured with.
+  static const intptr_t kPageSize = 64 * KB;
+#else
+  static const intptr_t kPageSize = 4 * KB;
+#endif
+
+  // Adds the bytes to the corresponding section and exports them under the
+  // given symbol name. The bytes are not copied and must stay alive until
+  // Finalize has been called. Instructions start at a page boundary as they
+  // do in the assembly output.
+  void AddText(const char* name, const uint8_t* bytes, intptr_t size);
+  void AddROData(const char* name, const uint8_t* bytes, intptr_t size);
+
+  // Writes the shared object to the stream.
+  void Finalize();
+
+ private:
+  struct Blob {
+    const char* name;
+    const uint8_t* bytes;
+    intptr_t size;
+    intptr_t offset;       // Within the section.
+    intptr_t name_offset;  // Within the dynamic string table.
+  };
+
+  static intptr_t AddBlob(GrowableArray<Blob>* blobs,
+                          intptr_t section_size,
+                          const char* name,
+                          const uint8_t* bytes,
+                          intptr_t size,
+                          intptr_t alignment);
+
+  void WriteHeader(intptr_t num_program_headers,
+                   intptr_t section_headers_offset,
+                   intptr_t num_sections,
+                   intptr_t shstrtab_index);
+  void WriteProgramHeader(intptr_t type,
+                          intptr_t flags,
+                          intptr_t offset,
+                          intptr_t size,
+                          intptr_t alignment);
+  void WriteSectionHeader(intptr_t name,
+                          intptr_t type,
+                          intptr_t flags,
+                          intptr_t offset,
+                          intptr_t size,
+                          intptr_t link,
+                          intptr_t info,
+                          intptr_t alignment,
+                          intptr_t entry_size);
+  void WriteSymbol(intptr_t name,
+                   intptr_t info,
+                   intptr_t section,
+                   intptr_t offset,
+                   intptr_t size);
+  void WriteDynamicEntry(intptr_t tag, intptr_t value);
+  void WriteBlobs(const GrowableArray<Blob>& blobs, intptr_t section_offset);
+  void WriteString(const char* string);
+  void PadTo(intptr_t offset);
+
+  void WriteHalf(uint16_t value) { WriteBytes(&value, sizeof(value)); }
+  void WriteWord(uint32_t value) { WriteBytes(&value, sizeof(value)); }
+  // Addresses, offsets and sizes have the width of a target word.
+  void WriteAddr(uword value) { WriteBytes(&value, sizeof(value)); }
+  void WriteBytes(const void* bytes, intptr_t size) {
+    stream_->WriteBytes(reinterpret_cast<const uint8_t*>(bytes), size);
+  }
+
+  Zone* const zone_;
+  StreamingWriteStream* const stream_;
+  GrowableArray<Blob> text_;
+  GrowableArray<Blob> rodata_;
+  intptr_t text_size_;
+  intptr_t rodata_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(Elf);
+};
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_ELF_H_
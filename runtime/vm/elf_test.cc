@@ -0,0 +1,125 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/elf.h"
+#include "platform/assert.h"
+#include "vm/os.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER) && defined(ARCH_IS_64_BIT)
+
+static void AppendToArray(void* callback_data,
+                          const uint8_t* buffer,
+                          intptr_t size) {
+  MallocGrowableArray<uint8_t>* bytes =
+      reinterpret_cast<MallocGrowableArray<uint8_t>*>(callback_data);
+  for (intptr_t i = 0; i < size; i++) {
+    bytes->Add(buffer[i]);
+  }
+}
+
+template <typename T>
+static T ReadAt(const MallocGrowableArray<uint8_t>& bytes, intptr_t offset) {
+  T value;
+  memmove(&value, &bytes[offset], sizeof(value));
+  return value;
+}
+
+// Finds a section by type through the section headers, as a tool would.
+static intptr_t FindSection(const MallocGrowableArray<uint8_t>& bytes,
+                            uint32_t type,
+                            intptr_t* size) {
+  const intptr_t section_headers = ReadAt<uint64_t>(bytes, 0x28);
+  const intptr_t num_sections = ReadAt<uint16_t>(bytes, 0x3c);
+  for (intptr_t i = 0; i < num_sections; i++) {
+    const intptr_t header = section_headers + i * 64;
+    if (ReadAt<uint32_t>(bytes, header + 4) == type) {
+      *size = ReadAt<uint64_t>(bytes, header + 32);
+      return ReadAt<uint64_t>(bytes, header + 24);
+    }
+  }
+  return -1;
+}
+
+// Returns the address of the named dynamic symbol, as dlsym would.
+static intptr_t LookupSymbol(const MallocGrowableArray<uint8_t>& bytes,
+                             const char* name,
+                             intptr_t* symbol_size) {
+  const uint32_t kDynsym = 11;
+  const uint32_t kDynstr = 3;
+  intptr_t dynsym_size = 0;
+  intptr_t dynstr_size = 0;
+  const intptr_t dynsym = FindSection(bytes, kDynsym, &dynsym_size);
+  const intptr_t dynstr = FindSection(bytes, kDynstr, &dynstr_size);
+  EXPECT(dynsym > 0);
+  EXPECT(dynstr > 0);
+  for (intptr_t symbol = dynsym; symbol < dynsym + dynsym_size;
+       symbol += 24) {
+    const intptr_t name_offset = ReadAt<uint32_t>(bytes, symbol);
+    const char* symbol_name =
+        reinterpret_cast<const char*>(&bytes[dynstr + name_offset]);
+    if (strcmp(symbol_name, name) == 0) {
+      *symbol_size = ReadAt<uint64_t>(bytes, symbol + 16);
+      return ReadAt<uint64_t>(bytes, symbol + 8);
+    }
+  }
+  return -1;
+}
+
+ISOLATE_UNIT_TEST_CASE(ElfExportsBlobs) {
+  uint8_t text[100];
+  uint8_t data[77];
+  uint8_t more_data[300];
+  for (intptr_t i = 0; i < 100; i++) {
+    text[i] = i;
+  }
+  for (intptr_t i = 0; i < 77; i++) {
+    data[i] = 2 * i;
+  }
+  for (intptr_t i = 0; i < 300; i++) {
+    more_data[i] = 255 - (i & 0xff);
+  }
+
+  MallocGrowableArray<uint8_t> bytes;
+  {
+    StreamingWriteStream stream(KB, AppendToArray, &bytes);
+    Elf* elf = new (thread->zone()) Elf(thread->zone(), &stream);
+    elf->AddText("_kTestInstructions", text, sizeof(text));
+    elf->AddROData("_kTestData", data, sizeof(data));
+    elf->AddROData("_kTestMoreData", more_data, sizeof(more_data));
+    elf->Finalize();
+  }
+
+  EXPECT_EQ(0x7f, bytes[0]);
+  EXPECT_EQ('E', bytes[1]);
+  EXPECT_EQ('L', bytes[2]);
+  EXPECT_EQ('F', bytes[3]);
+  EXPECT_EQ(3, ReadAt<uint16_t>(bytes, 0x10));  // A shared object.
+
+  // Virtual addresses equal file offsets, so a symbol's bytes can be found
+  // at its address in the file.
+  intptr_t size = 0;
+  intptr_t address = LookupSymbol(bytes, "_kTestInstructions", &size);
+  EXPECT(Utils::IsAligned(address, Elf::kPageSize));
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(text)), size);
+  EXPECT(memcmp(&bytes[address], text, sizeof(text)) == 0);
+
+  address = LookupSymbol(bytes, "_kTestData", &size);
+  EXPECT(Utils::IsAligned(address, OS::kMaxPreferredCodeAlignment));
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(data)), size);
+  EXPECT(memcmp(&bytes[address], data, sizeof(data)) == 0);
+
+  address = LookupSymbol(bytes, "_kTestMoreData", &size);
+  EXPECT(Utils::IsAligned(address, OS::kMaxPreferredCodeAlignment));
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(more_data)), size);
+  EXPECT(memcmp(&bytes[address], more_data, sizeof(more_data)) == 0);
+
+  EXPECT_EQ(-1, LookupSymbol(bytes, "_kMissing", &size));
+}
+
+#endif  // defined(DART_PRECOMPILER) && defined(ARCH_IS_64_BIT)
+
+}  // namespace dart
@@ -15,6 +15,10 @@ struct FinalizableData {
   void* data;
   void* peer;
   Dart_WeakPersistentHandleFinalizer callback;
+  // Called with [sender_peer] once the whole message has been written, see
+  // MessageFinalizableData::SerializationSucceeded.
+  Dart_WeakPersistentHandleFinalizer successful_write_callback;
+  void* sender_peer;
 };
 
 class MessageFinalizableData {
@@ -23,22 +27,46 @@ class MessageFinalizableData {
 
   ~MessageFinalizableData() {
     for (intptr_t i = position_; i < records_.length(); i++) {
+      // Data moved from the sender stays with it if the message could not be
+      // written.
+      if (records_[i].successful_write_callback != NULL) continue;
       records_[i].callback(NULL, NULL, records_[i].peer);
     }
   }
 
+  // [callback] frees [data] if the message is discarded before it is read.
+  // If [successful_write_callback] is given, [data] still belongs to the
+  // sender until the message has been written successfully; then the
+  // callback is invoked with [sender_peer] to give up the sender's
+  // ownership.
   void Put(intptr_t external_size,
            void* data,
            void* peer,
-           Dart_WeakPersistentHandleFinalizer callback) {
+           Dart_WeakPersistentHandleFinalizer callback,
+           Dart_WeakPersistentHandleFinalizer successful_write_callback = NULL,
+           void* sender_peer = NULL) {
     FinalizableData finalizable_data;
     finalizable_data.data = data;
     finalizable_data.peer = peer;
     finalizable_data.callback = callback;
+    finalizable_data.successful_write_callback = successful_write_callback;
+    finalizable_data.sender_peer = sender_peer;
     records_.Add(finalizable_data);
     external_size_ += external_size;
   }
 
+  // Called by the message writer after the whole message has been written.
+  void SerializationSucceeded() {
+    for (intptr_t i = 0; i < records_.length(); i++) {
+      if (records_[i].successful_write_callback != NULL) {
+        records_[i].successful_write_callback(NULL, NULL,
+                                              records_[i].sender_peer);
+        records_[i].successful_write_callback = NULL;
+        records_[i].sender_peer = NULL;
+      }
+    }
+  }
+
   FinalizableData Take() {
     ASSERT(position_ < records_.length());
     return records_[position_++];
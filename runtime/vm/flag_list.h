@@ -196,6 +196,8 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(use_field_guards, bool, !USING_DBC,                                        \
     "Use field guards and track field types")                                  \
   C(use_osr, false, true, bool, true, "Use OSR")                               \
+  P(use_poll_page, bool, false,                                                \
+    "Poll for interrupts in optimized loops with a load from a guard page.")   \
   P(use_strong_mode_types, bool, true, "Optimize based on strong mode types.") \
   R(verbose_gc, false, bool, false, "Enables verbose GC.")                     \
   R(verbose_gc_hdr, 40, int, 40, "Print verbose GC header interval.")          \
@@ -0,0 +1,383 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/flat_message.h"
+
+#include "vm/finalizable_data.h"
+#include "vm/longjump.h"
+#include "vm/message.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/symbols.h"
+
+namespace dart {
+
+static uint8_t* malloc_allocator(uint8_t* ptr,
+                                 intptr_t old_size,
+                                 intptr_t new_size) {
+  void* new_ptr = realloc(reinterpret_cast<void*>(ptr), new_size);
+  return reinterpret_cast<uint8_t*>(new_ptr);
+}
+
+static void malloc_deallocator(uint8_t* ptr) {
+  free(reinterpret_cast<void*>(ptr));
+}
+
+// The typed data classes a native port can receive.
+static bool IsFlatTypedDataClassId(intptr_t cid) {
+  switch (cid) {
+    case kTypedDataInt8ArrayCid:
+    case kTypedDataUint8ArrayCid:
+    case kTypedDataUint8ClampedArrayCid:
+    case kTypedDataInt16ArrayCid:
+    case kTypedDataUint16ArrayCid:
+    case kTypedDataInt32ArrayCid:
+    case kTypedDataUint32ArrayCid:
+    case kTypedDataInt64ArrayCid:
+    case kTypedDataUint64ArrayCid:
+    case kTypedDataFloat32ArrayCid:
+    case kTypedDataFloat64ArrayCid:
+      return true;
+    default:
+      return false;
+  }
+}
+
+FlatMessageWriter::FlatMessageWriter()
+    : BaseWriter(malloc_allocator, malloc_deallocator, kInitialSize),
+      zone_(Thread::Current()->zone()),
+      object_store_(Isolate::Current()->object_store()),
+      num_references_(0) {
+  memset(references_, 0, sizeof(references_));
+}
+
+Message* FlatMessageWriter::WriteMessage(const Object& obj,
+                                         Dart_Port dest_port,
+                                         Message::Priority priority) {
+  bool written;
+  {
+    NoSafepointScope no_safepoint;
+    written = WriteObject(obj, 0);
+  }
+  if (!written) {
+    FreeBuffer();
+    return NULL;
+  }
+  Message* message =
+      new Message(dest_port, buffer(), BytesWritten(), NULL, priority);
+  message->set_is_flat(true);
+  return message;
+}
+
+Message* FlatMessageWriter::WriteExternalTypedData(
+    intptr_t cid,
+    uint8_t* data,
+    intptr_t length,
+    void* peer,
+    Dart_WeakPersistentHandleFinalizer callback,
+    Dart_Port dest_port,
+    Message::Priority priority) {
+  ASSERT(IsFlatTypedDataClassId(cid));
+  ASSERT(callback != NULL);
+  // Only the header is written, so the smallest buffer will do.
+  uint8_t* buffer = NULL;
+  WriteStream stream(&buffer, malloc_allocator, 16);
+  WriteStream::Raw<sizeof(uint8_t), uint8_t>::Write(&stream,
+                                                    kFlatExternalTypedData);
+  WriteStream::Raw<sizeof(uint32_t), uint32_t>::Write(&stream, cid);
+  WriteStream::Raw<sizeof(int64_t), int64_t>::Write(&stream, length);
+  MessageFinalizableData* finalizable_data = new MessageFinalizableData();
+  finalizable_data->Put(length * TypedData::ElementSizeInBytes(cid), data,
+                        peer, callback);
+  Message* message = new Message(dest_port, stream.buffer(),
+                                 stream.bytes_written(), finalizable_data,
+                                 priority);
+  message->set_is_flat(true);
+  return message;
+}
+
+bool FlatMessageWriter::AddReference(const Object& obj) {
+  if (num_references_ == kMaxReferences) {
+    return false;
+  }
+  COMPILE_ASSERT((kReferenceTableSize & (kReferenceTableSize - 1)) == 0);
+  const intptr_t mask = kReferenceTableSize - 1;
+  RawObject* raw = obj.raw();
+  const uword hash = (RawObject::ToAddr(raw) >> kObjectAlignmentLog2) *
+                     static_cast<uword>(0x9e3779b1);
+  intptr_t index = static_cast<intptr_t>(hash) & mask;
+  while (references_[index] != NULL) {
+    if (references_[index] == raw) {
+      return false;
+    }
+    index = (index + 1) & mask;
+  }
+  references_[index] = raw;
+  num_references_++;
+  return true;
+}
+
+bool FlatMessageWriter::WriteTypeArguments(RawTypeArguments* type_arguments) {
+  if (type_arguments == TypeArguments::null()) {
+    Write<uint8_t>(kFlatNoTypeArguments);
+  } else if (type_arguments == object_store_->type_argument_int()) {
+    Write<uint8_t>(kFlatIntTypeArguments);
+  } else if (type_arguments == object_store_->type_argument_double()) {
+    Write<uint8_t>(kFlatDoubleTypeArguments);
+  } else if (type_arguments == object_store_->type_argument_string()) {
+    Write<uint8_t>(kFlatStringTypeArguments);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool FlatMessageWriter::WriteString(const String& str) {
+  if (!AddReference(str)) {
+    return false;
+  }
+  const bool is_symbol = str.IsSymbol();
+  const intptr_t len = str.Length();
+  if (str.IsOneByteString()) {
+    Write<uint8_t>(is_symbol ? kFlatOneByteSymbol : kFlatOneByteString);
+    Write<int64_t>(len);
+    WriteBytes(OneByteString::DataStart(str), len);
+  } else {
+    ASSERT(str.IsTwoByteString());
+    Write<uint8_t>(is_symbol ? kFlatTwoByteSymbol : kFlatTwoByteString);
+    Write<int64_t>(len);
+    WriteBytes(reinterpret_cast<const uint8_t*>(TwoByteString::DataStart(str)),
+               len * sizeof(uint16_t));
+  }
+  return true;
+}
+
+bool FlatMessageWriter::WriteObject(const Object& obj, intptr_t depth) {
+  if (obj.IsSmi()) {
+    Write<uint8_t>(kFlatInt);
+    Write<int64_t>(Smi::Cast(obj).Value());
+    return true;
+  }
+  if (obj.IsNull()) {
+    Write<uint8_t>(kFlatNull);
+    return true;
+  }
+  if (obj.IsBool()) {
+    Write<uint8_t>(Bool::Cast(obj).value() ? kFlatTrue : kFlatFalse);
+    return true;
+  }
+  if (depth == kMaxDepth) {
+    return false;
+  }
+  const intptr_t cid = obj.GetClassId();
+  switch (cid) {
+    case kMintCid:
+      Write<uint8_t>(kFlatInt);
+      Write<int64_t>(Mint::Cast(obj).value());
+      return true;
+    case kDoubleCid:
+      // Doubles are not shared in regular message snapshots either.
+      Write<uint8_t>(kFlatDouble);
+      WriteDouble(Double::Cast(obj).value());
+      return true;
+    case kOneByteStringCid:
+    case kTwoByteStringCid:
+      return WriteString(String::Cast(obj));
+    case kArrayCid: {
+      // Constant lists have to be canonicalized by the receiver.
+      if (obj.IsCanonical() || !AddReference(obj)) {
+        return false;
+      }
+      const Array& array = Array::Cast(obj);
+      Write<uint8_t>(kFlatArray);
+      if (!WriteTypeArguments(array.GetTypeArguments())) {
+        return false;
+      }
+      const intptr_t len = array.Length();
+      Write<int64_t>(len);
+      Object& element = Object::Handle(zone());
+      for (intptr_t i = 0; i < len; i++) {
+        element = array.At(i);
+        if (!WriteObject(element, depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case kGrowableObjectArrayCid: {
+      if (!AddReference(obj)) {
+        return false;
+      }
+      const GrowableObjectArray& array = GrowableObjectArray::Cast(obj);
+      Write<uint8_t>(kFlatGrowableArray);
+      if (!WriteTypeArguments(array.GetTypeArguments())) {
+        return false;
+      }
+      const intptr_t len = array.Length();
+      Write<int64_t>(len);
+      Object& element = Object::Handle(zone());
+      for (intptr_t i = 0; i < len; i++) {
+        element = array.At(i);
+        if (!WriteObject(element, depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      break;
+  }
+  if (IsFlatTypedDataClassId(cid)) {
+    if (!AddReference(obj)) {
+      return false;
+    }
+    const TypedData& typed_data = TypedData::Cast(obj);
+    Write<uint8_t>(kFlatTypedData);
+    WriteClassIDValue(cid);
+    Write<int64_t>(typed_data.Length());
+    WriteBytes(reinterpret_cast<const uint8_t*>(typed_data.DataAddr(0)),
+               typed_data.LengthInBytes());
+    return true;
+  }
+  return false;
+}
+
+FlatMessageReader::FlatMessageReader(Message* message, Thread* thread)
+    : BaseReader(message->snapshot(), message->snapshot_length()),
+      thread_(thread),
+      zone_(thread->zone()),
+      object_store_(thread->isolate()->object_store()),
+      finalizable_data_(message->finalizable_data()) {
+  ASSERT(message->IsFlat());
+}
+
+RawObject* FlatMessageReader::ReadObject() {
+  // Setup for long jump in case allocation fails while reading.
+  LongJumpScope jump;
+  if (setjmp(*jump.Set()) == 0) {
+    return ReadObjectImpl();
+  } else {
+    return thread_->StealStickyError();
+  }
+}
+
+RawTypeArguments* FlatMessageReader::ReadTypeArguments() {
+  switch (Read<uint8_t>()) {
+    case kFlatNoTypeArguments:
+      return TypeArguments::null();
+    case kFlatIntTypeArguments:
+      return object_store_->type_argument_int();
+    case kFlatDoubleTypeArguments:
+      return object_store_->type_argument_double();
+    case kFlatStringTypeArguments:
+      return object_store_->type_argument_string();
+    default:
+      UNREACHABLE();
+      return TypeArguments::null();
+  }
+}
+
+RawString* FlatMessageReader::ReadString(intptr_t tag) {
+  const intptr_t len = Read<int64_t>();
+  switch (tag) {
+    case kFlatOneByteString: {
+      const String& str =
+          String::Handle(zone_, OneByteString::New(len, Heap::kNew));
+      NoSafepointScope no_safepoint;
+      ReadBytes(OneByteString::DataStart(str), len);
+      return str.raw();
+    }
+    case kFlatTwoByteString: {
+      const String& str =
+          String::Handle(zone_, TwoByteString::New(len, Heap::kNew));
+      NoSafepointScope no_safepoint;
+      ReadBytes(reinterpret_cast<uint8_t*>(TwoByteString::DataStart(str)),
+                len * sizeof(uint16_t));
+      return str.raw();
+    }
+    case kFlatOneByteSymbol: {
+      uint8_t* latin1 = zone_->Alloc<uint8_t>(len);
+      ReadBytes(latin1, len);
+      return Symbols::FromLatin1(thread_, latin1, len);
+    }
+    case kFlatTwoByteSymbol: {
+      uint16_t* utf16 = zone_->Alloc<uint16_t>(len);
+      ReadBytes(reinterpret_cast<uint8_t*>(utf16), len * sizeof(uint16_t));
+      return Symbols::FromUTF16(thread_, utf16, len);
+    }
+    default:
+      UNREACHABLE();
+      return String::null();
+  }
+}
+
+RawObject* FlatMessageReader::ReadObjectImpl() {
+  const intptr_t tag = Read<uint8_t>();
+  switch (tag) {
+    case kFlatNull:
+      return Object::null();
+    case kFlatTrue:
+      return Bool::True().raw();
+    case kFlatFalse:
+      return Bool::False().raw();
+    case kFlatInt:
+      return Integer::New(Read<int64_t>());
+    case kFlatDouble:
+      return Double::New(ReadDouble());
+    case kFlatOneByteString:
+    case kFlatTwoByteString:
+    case kFlatOneByteSymbol:
+    case kFlatTwoByteSymbol:
+      return ReadString(tag);
+    case kFlatTypedData: {
+      const intptr_t cid = ReadClassIDValue();
+      const intptr_t len = Read<int64_t>();
+      const TypedData& result =
+          TypedData::Handle(zone_, TypedData::New(cid, len));
+      NoSafepointScope no_safepoint;
+      ReadBytes(reinterpret_cast<uint8_t*>(result.DataAddr(0)),
+                len * TypedData::ElementSizeInBytes(cid));
+      return result.raw();
+    }
+    case kFlatExternalTypedData: {
+      const intptr_t cid = ReadClassIDValue();
+      const intptr_t len = Read<int64_t>();
+      // The receiver now owns the buffer.
+      FinalizableData finalizable_data = finalizable_data_->Take();
+      const ExternalTypedData& result = ExternalTypedData::Handle(
+          zone_, ExternalTypedData::New(
+                     cid + kTypedDataCidRemainderExternal,
+                     reinterpret_cast<uint8_t*>(finalizable_data.data), len));
+      result.AddFinalizer(finalizable_data.peer, finalizable_data.callback,
+                          result.LengthInBytes());
+      return result.raw();
+    }
+    case kFlatArray:
+    case kFlatGrowableArray: {
+      const TypeArguments& type_arguments =
+          TypeArguments::Handle(zone_, ReadTypeArguments());
+      const intptr_t len = Read<int64_t>();
+      const Array& array = Array::Handle(zone_, Array::New(len));
+      Object& element = Object::Handle(zone_);
+      for (intptr_t i = 0; i < len; i++) {
+        element = ReadObjectImpl();
+        array.SetAt(i, element);
+      }
+      if (tag == kFlatArray) {
+        array.SetTypeArguments(type_arguments);
+        return array.raw();
+      }
+      const GrowableObjectArray& list =
+          GrowableObjectArray::Handle(zone_, GrowableObjectArray::New(array));
+      list.SetTypeArguments(type_arguments);
+      list.SetLength(len);
+      return list.raw();
+    }
+    default:
+      UNREACHABLE();
+      return Object::null();
+  }
+}
+
+}  // namespace dart
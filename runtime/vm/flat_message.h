@@ -0,0 +1,144 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_FLAT_MESSAGE_H_
+#define RUNTIME_VM_FLAT_MESSAGE_H_
+
+#include "platform/globals.h"
+#include "vm/allocation.h"
+#include "vm/snapshot.h"
+
+namespace dart {
+
+// Forward declarations.
+class Message;
+class MessageFinalizableData;
+class Object;
+class ObjectStore;
+class RawObject;
+class RawString;
+class RawTypeArguments;
+class String;
+class Thread;
+class Zone;
+
+// Messages made only of null, bools, integers, doubles, strings, typed data
+// and lists of those are encoded in a flat format which carries no object
+// ids. Such messages cannot contain cycles or shared objects, so neither the
+// writer nor the reader needs a forward or backward reference table.
+//
+// Each value is a tag byte followed by its payload:
+//   kFlatNull, kFlatTrue, kFlatFalse: no payload.
+//   kFlatInt: the value as a variable length int64.
+//   kFlatDouble: the 8 raw bytes of the value.
+//   kFlat{OneByte,TwoByte}{String,Symbol}: length and code units.
+//   kFlatTypedData: class id, length and the raw element bytes.
+//   kFlatExternalTypedData: class id and length. The elements stay in a
+//     native buffer recorded in the message's finalizable data.
+//   kFlat{Array,GrowableArray}: type arguments tag, length and elements.
+enum FlatMessageTag {
+  kFlatNull = 0,
+  kFlatTrue,
+  kFlatFalse,
+  kFlatInt,
+  kFlatDouble,
+  kFlatOneByteString,
+  kFlatTwoByteString,
+  kFlatOneByteSymbol,
+  kFlatTwoByteSymbol,
+  kFlatTypedData,
+  kFlatArray,
+  kFlatGrowableArray,
+  kFlatExternalTypedData,
+};
+
+// The type arguments a flat list can have.
+enum FlatTypeArgumentsTag {
+  kFlatNoTypeArguments = 0,
+  kFlatIntTypeArguments,
+  kFlatDoubleTypeArguments,
+  kFlatStringTypeArguments,
+};
+
+// Writes an object graph in the flat format, giving up as soon as the graph
+// contains anything the format cannot represent.
+class FlatMessageWriter : public BaseWriter {
+ public:
+  static const intptr_t kInitialSize = 256;
+
+  // Graphs deeper than this, or with more strings and lists than
+  // kMaxReferences, are left to the regular message snapshot.
+  static const intptr_t kMaxDepth = 32;
+  static const intptr_t kMaxReferences = 256;
+
+  FlatMessageWriter();
+  ~FlatMessageWriter() {}
+
+  // Returns a flat message for 'obj', or NULL if 'obj' has to be sent as a
+  // regular message snapshot.
+  Message* WriteMessage(const Object& obj,
+                        Dart_Port dest_port,
+                        Message::Priority priority);
+
+  // Returns a message whose only content is 'length' elements of the typed
+  // data class 'cid' in the native buffer 'data'. The receiver gets an
+  // external typed data object backed by the buffer, and 'callback' is
+  // invoked with 'peer' once the buffer is no longer used. Does not need a
+  // current isolate.
+  static Message* WriteExternalTypedData(
+      intptr_t cid,
+      uint8_t* data,
+      intptr_t length,
+      void* peer,
+      Dart_WeakPersistentHandleFinalizer callback,
+      Dart_Port dest_port,
+      Message::Priority priority);
+
+ private:
+  bool WriteObject(const Object& obj, intptr_t depth);
+  bool WriteString(const String& str);
+  bool WriteTypeArguments(RawTypeArguments* type_arguments);
+
+  // Records a heap object with identity, failing if it has been seen
+  // before. Sharing has to be preserved, which needs object ids.
+  bool AddReference(const Object& obj);
+
+  Zone* zone() const { return zone_; }
+
+  static const intptr_t kReferenceTableSize = 2 * kMaxReferences;
+
+  Zone* zone_;
+  ObjectStore* object_store_;
+  intptr_t num_references_;
+  RawObject* references_[kReferenceTableSize];
+
+  DISALLOW_COPY_AND_ASSIGN(FlatMessageWriter);
+};
+
+// Reads a message written by FlatMessageWriter into the current isolate.
+class FlatMessageReader : public BaseReader {
+ public:
+  FlatMessageReader(Message* message, Thread* thread);
+  ~FlatMessageReader() {}
+
+  // Returns the root object of the message or an error on allocation
+  // failure.
+  RawObject* ReadObject();
+
+ private:
+  RawObject* ReadObjectImpl();
+  RawTypeArguments* ReadTypeArguments();
+  RawString* ReadString(intptr_t tag);
+
+  Thread* thread_;
+  Zone* zone_;
+  ObjectStore* object_store_;
+  MessageFinalizableData* finalizable_data_;
+
+  DISALLOW_COPY_AND_ASSIGN(FlatMessageReader);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_FLAT_MESSAGE_H_
@@ -51,6 +51,13 @@ namespace dart {
 //  obj ^= cache.GetOrNull(name);
 //  ASSERT(cache.Release().raw() == get_foo_cache());
 //
+// Sets that are only ever inserted into (e.g., the canonical type and constant
+// tables) can also be read without the lock serializing their writers, using
+// HashSet::GetOrNullConcurrent. Keys are published with release stores, and
+// growth copies into a new RawArray that the writer publishes with a release
+// store, leaving the old array intact for readers still probing it. A reader
+// that misses must retry under the lock before inserting.
+//
 // TODO(koda): When exposing these to Dart code, document and assert that
 // KeyTraits methods must not run Dart code (since the C++ code doesn't check
 // for concurrent modification).
@@ -180,6 +187,34 @@ class HashTable : public ValueObject {
     return -1;
   }
 
+  // Like FindKey, but may race with insertions by another thread. Does not
+  // update the collision statistics, and must not be used on tables that
+  // have deleted entries.
+  template <typename Key>
+  intptr_t FindKeyConcurrent(const Key& key) const {
+    const intptr_t num_entries = NumEntries();
+    uword hash = KeyTraits::Hash(key);
+    ASSERT(Utils::IsPowerOfTwo(num_entries));
+    intptr_t probe = hash & (num_entries - 1);
+    int probe_distance = 1;
+    while (true) {
+      // Pairs with the release store in InternalSetKey, so the key object
+      // is fully initialized when matched.
+      *key_handle_ = data_->AtAcquire(KeyIndex(probe));
+      if (key_handle_->raw() == Object::sentinel().raw()) {
+        return -1;
+      }
+      ASSERT(key_handle_->raw() != Object::transition_sentinel().raw());
+      if (KeyTraits::IsMatch(key, *key_handle_)) {
+        return probe;
+      }
+      probe = (probe + probe_distance) & (num_entries - 1);
+      probe_distance++;
+    }
+    UNREACHABLE();
+    return -1;
+  }
+
   // Sets *entry to either:
   // - an occupied entry matching 'key', and returns true, or
   // - an unused/deleted entry where a matching key may be inserted,
@@ -370,7 +405,7 @@ class HashTable : public ValueObject {
   }
 
   void InternalSetKey(intptr_t entry, const Object& key) const {
-    data_->SetAt(KeyIndex(entry), key);
+    data_->SetAtRelease(KeyIndex(entry), key);
   }
 
   intptr_t GetSmiValueAt(intptr_t index) const {
@@ -684,6 +719,14 @@ class HashSet : public BaseIterTable {
     return (entry == -1) ? Object::null() : BaseIterTable::GetKey(entry);
   }
 
+  // Like GetOrNull, but may be called without the lock serializing the
+  // writers of an insert-only set. See the overview above.
+  template <typename Key>
+  RawObject* GetOrNullConcurrent(const Key& key) const {
+    intptr_t entry = BaseIterTable::FindKeyConcurrent(key);
+    return (entry == -1) ? Object::null() : BaseIterTable::KeyHandle().raw();
+  }
+
   template <typename Key>
   bool Remove(const Key& key) const {
     intptr_t entry = BaseIterTable::FindKey(key);
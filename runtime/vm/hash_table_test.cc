@@ -257,4 +257,40 @@ ISOLATE_UNIT_TEST_CASE(Maps) {
   }
 }
 
+// A reader holding on to the array of an insert-only set keeps finding the
+// keys inserted before the set grew into a new array.
+ISOLATE_UNIT_TEST_CASE(SetsConcurrentLookup) {
+  typedef UnorderedHashSet<TestTraits> Set;
+  Zone* zone = Thread::Current()->zone();
+  Set set(zone, HashTables::New<Set>(4));
+  EXPECT(set.GetOrNullConcurrent("a") == Object::null());
+  set.InsertNewOrGet("a");
+  set.InsertNewOrGet("bb");
+  const Array& snapshot = Array::Handle(zone, set.Release().raw());
+
+  Set writer(zone, snapshot.raw());
+  const char* const kKeys[] = {"ccc", "dddd", "eeeee", "ffffff", "ggggggg"};
+  for (size_t i = 0; i < ARRAY_SIZE(kKeys); ++i) {
+    writer.InsertNewOrGet(kKeys[i]);
+  }
+  const Array& grown = Array::Handle(zone, writer.Release().raw());
+  EXPECT(grown.raw() != snapshot.raw());
+
+  Set reader(zone, snapshot.raw());
+  String& str = String::Handle(zone);
+  str ^= reader.GetOrNullConcurrent("a");
+  EXPECT(str.Equals("a"));
+  str ^= reader.GetOrNullConcurrent("bb");
+  EXPECT(str.Equals("bb"));
+  reader.Release();
+
+  Set current(zone, grown.raw());
+  for (size_t i = 0; i < ARRAY_SIZE(kKeys); ++i) {
+    str ^= current.GetOrNullConcurrent(kKeys[i]);
+    EXPECT(str.Equals(kKeys[i]));
+  }
+  EXPECT(current.GetOrNullConcurrent("h") == Object::null());
+  current.Release();
+}
+
 }  // namespace dart
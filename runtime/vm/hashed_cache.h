@@ -0,0 +1,119 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HASHED_CACHE_H_
+#define RUNTIME_VM_HASHED_CACHE_H_
+
+#include "platform/assert.h"
+#include "platform/globals.h"
+
+namespace dart {
+
+// A direct mapped cache from integer keys to values, which grows while its
+// entries keep evicting each other.
+//
+// Starts with kInitialCapacity entries and doubles, up to kMaxCapacity
+// entries, whenever as many entries were evicted by the insertion of a
+// colliding key as the cache has entries. Both capacities must be powers of
+// two.
+//
+// Assumes Value is a default-constructible and copyable object.
+//
+// Duplicates are not allowed - check with Lookup before insertion.
+//
+template <class K, class V, intptr_t kInitialCapacity, intptr_t kMaxCapacity>
+class HashedCache {
+ public:
+  HashedCache()
+      : entries_(new Entry[kInitialCapacity]),
+        capacity_(kInitialCapacity),
+        evictions_(0),
+        hits_(0),
+        misses_(0) {}
+
+  ~HashedCache() { delete[] entries_; }
+
+  V* Lookup(K key) {
+    Entry* entry = &entries_[IndexOf(key)];
+    if (entry->occupied && (entry->key == key)) {
+      hits_++;
+      return &entry->value;
+    }
+    misses_++;
+    return NULL;
+  }
+
+  void Insert(K key, V value) {
+    Entry* entry = &entries_[IndexOf(key)];
+    if (entry->occupied) {
+      ASSERT(entry->key != key);
+      if ((++evictions_ >= capacity_) && (capacity_ < kMaxCapacity)) {
+        Grow();
+        entry = &entries_[IndexOf(key)];
+      }
+    }
+    entry->key = key;
+    entry->value = value;
+    entry->occupied = true;
+  }
+
+  // Removes all entries, keeping the capacity and the statistics.
+  void Clear() {
+    for (intptr_t i = 0; i < capacity_; i++) {
+      entries_[i] = Entry();
+    }
+    evictions_ = 0;
+  }
+
+  intptr_t capacity() const { return capacity_; }
+  int64_t hits() const { return hits_; }
+  int64_t misses() const { return misses_; }
+
+ private:
+  COMPILE_ASSERT((kInitialCapacity & (kInitialCapacity - 1)) == 0);
+  COMPILE_ASSERT((kMaxCapacity & (kMaxCapacity - 1)) == 0);
+  COMPILE_ASSERT(kInitialCapacity <= kMaxCapacity);
+
+  struct Entry {
+    Entry() : key(), value(), occupied(false) {}
+
+    K key;
+    V value;
+    bool occupied;
+  };
+
+  intptr_t IndexOf(K key) const {
+    // Fibonacci hashing spreads keys which only differ in their low bits,
+    // such as nearby return addresses.
+    const uint64_t hash =
+        static_cast<uint64_t>(key) * static_cast<uint64_t>(0x9e3779b97f4a7c15);
+    return static_cast<intptr_t>(hash >> 32) & (capacity_ - 1);
+  }
+
+  void Grow() {
+    Entry* old_entries = entries_;
+    const intptr_t old_capacity = capacity_;
+    capacity_ = old_capacity * 2;
+    entries_ = new Entry[capacity_];
+    for (intptr_t i = 0; i < old_capacity; i++) {
+      if (old_entries[i].occupied) {
+        entries_[IndexOf(old_entries[i].key)] = old_entries[i];
+      }
+    }
+    delete[] old_entries;
+    evictions_ = 0;
+  }
+
+  Entry* entries_;
+  intptr_t capacity_;
+  intptr_t evictions_;
+  int64_t hits_;
+  int64_t misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(HashedCache);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HASHED_CACHE_H_
@@ -0,0 +1,62 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/hashed_cache.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+UNIT_TEST_CASE(HashedCacheLookup) {
+  HashedCache<intptr_t, intptr_t, 16, 16> cache;
+  EXPECT(cache.Lookup(0) == NULL);
+  EXPECT(cache.Lookup(1) == NULL);
+  cache.Insert(1, 2);
+  EXPECT(*cache.Lookup(1) == 2);
+  EXPECT(cache.Lookup(0) == NULL);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(3, cache.misses());
+
+  cache.Clear();
+  EXPECT(cache.Lookup(1) == NULL);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(4, cache.misses());
+}
+
+UNIT_TEST_CASE(HashedCacheGrows) {
+  HashedCache<intptr_t, intptr_t, 4, 256> cache;
+  // Keep inserting more keys than the cache initially has entries, as
+  // many hot throw sites do.
+  for (intptr_t round = 0; round < 16; round++) {
+    for (intptr_t key = 1; key <= 64; key++) {
+      if (cache.Lookup(key * 8) == NULL) {
+        cache.Insert(key * 8, key);
+      }
+    }
+  }
+  EXPECT(cache.capacity() > 4);
+  EXPECT(cache.capacity() <= 256);
+  // All keys fit after growing, so most of the later lookups hit.
+  intptr_t found = 0;
+  for (intptr_t key = 1; key <= 64; key++) {
+    intptr_t* value = cache.Lookup(key * 8);
+    if (value != NULL) {
+      EXPECT_EQ(key, *value);
+      found++;
+    }
+  }
+  EXPECT(found > 32);
+}
+
+UNIT_TEST_CASE(HashedCacheMaxCapacity) {
+  HashedCache<intptr_t, intptr_t, 2, 8> cache;
+  for (intptr_t key = 0; key < 1000; key++) {
+    if (cache.Lookup(key) == NULL) {
+      cache.Insert(key, key);
+    }
+  }
+  EXPECT_EQ(8, cache.capacity());
+}
+
+}  // namespace dart
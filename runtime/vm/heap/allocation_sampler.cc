@@ -0,0 +1,136 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/allocation_sampler.h"
+
+#include "platform/utils.h"
+#include "vm/class_table.h"
+#include "vm/isolate.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/stack_frame.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(int,
+            allocation_sample_period,
+            0,
+            "Attribute on average every Nth allocated byte to its class and "
+            "allocating code (0 disables sampling).");
+DEFINE_FLAG(int,
+            print_allocation_samples,
+            0,
+            "Print this many of the top sampled allocation sites when an "
+            "isolate shuts down.");
+
+AllocationSampler::AllocationSampler() : mutex_(), random_(), samples_() {}
+
+AllocationSampler::~AllocationSampler() {
+  Reset();
+}
+
+intptr_t AllocationSampler::NextSampleDistance() {
+  ASSERT(IsEnabled());
+  const intptr_t period = FLAG_allocation_sample_period;
+  // Randomize the sample points to avoid aliasing with periodic allocation
+  // patterns, keeping the mean distance at the period.
+  MutexLocker ml(&mutex_);
+  const intptr_t jitter = random_.NextUInt32() % (period + 1);
+  return Utils::Maximum<intptr_t>(kObjectAlignment, period / 2 + jitter);
+}
+
+void AllocationSampler::RecordSample(Thread* thread,
+                                     intptr_t cid,
+                                     intptr_t size) {
+  Sample key = {cid, 0, 0, 0};
+  DartFrameIterator iterator(thread,
+                             StackFrameIterator::kNoCrossThreadIteration);
+  StackFrame* frame = iterator.NextFrame();
+  if (frame != NULL) {
+    key.pc = frame->pc();
+  }
+  const int64_t bytes =
+      Utils::Maximum<int64_t>(FLAG_allocation_sample_period, size);
+
+  MutexLocker ml(&mutex_);
+  Sample* sample = samples_.LookupValue(&key);
+  if (sample == NULL) {
+    sample = reinterpret_cast<Sample*>(malloc(sizeof(Sample)));
+    *sample = key;
+    samples_.Insert(sample);
+  }
+  sample->count++;
+  sample->bytes += bytes;
+}
+
+static int CompareSamples(const AllocationSampler::Sample* a,
+                          const AllocationSampler::Sample* b) {
+  if (a->bytes != b->bytes) {
+    return a->bytes > b->bytes ? -1 : 1;
+  }
+  return 0;
+}
+
+void AllocationSampler::GetSamples(GrowableArray<Sample>* samples) {
+  {
+    MutexLocker ml(&mutex_);
+    MallocDirectChainedHashMap<PointerKeyValueTrait<Sample> >::Iterator it =
+        samples_.GetIterator();
+    for (Sample** sample = it.Next(); sample != NULL; sample = it.Next()) {
+      samples->Add(**sample);
+    }
+  }
+  samples->Sort(CompareSamples);
+}
+
+void AllocationSampler::Print(intptr_t limit) {
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  GrowableArray<Sample> samples;
+  GetSamples(&samples);
+  if (samples.is_empty()) {
+    return;
+  }
+
+  ClassTable* class_table = isolate->class_table();
+  Class& cls = Class::Handle(zone.GetZone());
+  String& name = String::Handle(zone.GetZone());
+  Code& code = Code::Handle(zone.GetZone());
+  OS::PrintErr("Top allocation sites of %s (every %d bytes sampled):\n",
+               isolate->name(), FLAG_allocation_sample_period);
+  OS::PrintErr("%12s %8s  %-32s %s\n", "bytes", "samples", "class", "code");
+  for (intptr_t i = 0; (i < samples.length()) && (i < limit); i++) {
+    const Sample& sample = samples[i];
+    const char* class_name = "<unknown>";
+    if (class_table->IsValidIndex(sample.cid) &&
+        class_table->HasValidClassAt(sample.cid)) {
+      cls = class_table->At(sample.cid);
+      name = cls.ScrubbedName();
+      class_name = name.ToCString();
+    }
+    const char* code_name = "<runtime>";
+    if (sample.pc != 0) {
+      code = Code::LookupCode(sample.pc);
+      code_name = code.IsNull() ? "<collected>" : code.QualifiedName();
+    }
+    OS::PrintErr("%12" Pd64 " %8" Pd "  %-32s %s\n", sample.bytes,
+                 sample.count, class_name, code_name);
+  }
+}
+
+void AllocationSampler::Reset() {
+  MutexLocker ml(&mutex_);
+  MallocDirectChainedHashMap<PointerKeyValueTrait<Sample> >::Iterator it =
+      samples_.GetIterator();
+  for (Sample** sample = it.Next(); sample != NULL; sample = it.Next()) {
+    free(*sample);
+  }
+  samples_.Clear();
+}
+
+}  // namespace dart
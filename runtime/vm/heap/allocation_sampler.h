@@ -0,0 +1,83 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_ALLOCATION_SAMPLER_H_
+#define RUNTIME_VM_HEAP_ALLOCATION_SAMPLER_H_
+
+#include "vm/allocation.h"
+#include "vm/flags.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/os_thread.h"
+#include "vm/random.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, allocation_sample_period);
+
+class Thread;
+
+// Attributes a sample of the bytes allocated by an isolate to the class of
+// the allocated objects and to the Dart code allocating them.
+//
+// With --allocation_sample_period=N, on average every Nth byte is sampled.
+// The limit seen by the inline allocation fast paths (Thread::end) stops
+// short of the TLAB's end at the next sample point, so only the allocation
+// crossing it takes the slow path into the runtime, where it is recorded.
+// This keeps the cost independent of the allocation rate, unlike tracing
+// allocations of a class.
+class AllocationSampler {
+ public:
+  struct Sample {
+    intptr_t cid;
+    // Return address into the Dart code which allocated, or 0.
+    uword pc;
+    intptr_t count;
+    // Estimated number of bytes allocated, count times the period unless
+    // the sampled objects were larger.
+    int64_t bytes;
+
+    intptr_t Hashcode() const {
+      return static_cast<intptr_t>(pc ^ (static_cast<uword>(cid) * 31));
+    }
+    bool Equals(const Sample* other) const {
+      return (cid == other->cid) && (pc == other->pc);
+    }
+  };
+
+  AllocationSampler();
+  ~AllocationSampler();
+
+  static bool IsEnabled() { return FLAG_allocation_sample_period > 0; }
+
+  // Returns the number of bytes to allocate before taking the next sample,
+  // the period on average.
+  intptr_t NextSampleDistance();
+
+  // Records an allocation of 'size' bytes of class 'cid' by 'thread', which
+  // crossed a sample point.
+  void RecordSample(Thread* thread, intptr_t cid, intptr_t size);
+
+  // Appends the samples to 'samples', by decreasing estimated bytes.
+  void GetSamples(GrowableArray<Sample>* samples);
+
+  // Prints the 'limit' classes and allocation sites with the most estimated
+  // bytes.
+  void Print(intptr_t limit);
+
+  void Reset();
+
+ private:
+  Mutex mutex_;
+  Random random_;
+  // Malloced samples keyed by class and allocation site.
+  MallocDirectChainedHashMap<PointerKeyValueTrait<Sample> > samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSampler);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_ALLOCATION_SAMPLER_H_
@@ -7,16 +7,27 @@
 #include "platform/assert.h"
 #include "platform/utils.h"
 
+#include "vm/dart.h"
 #include "vm/dart_api_state.h"
+#include "vm/heap/pages.h"
 #include "vm/heap/safepoint.h"
+#include "vm/heap/weak_table.h"
 #include "vm/isolate_reload.h"
 #include "vm/object.h"
 #include "vm/raw_object.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            become_tasks,
+            2,
+            "The number of helper tasks forwarding old-space pointers during "
+            "become, in addition to the main thread.");
+
 ForwardingCorpse* ForwardingCorpse::AsForwarder(uword addr, intptr_t size) {
   ASSERT(size >= kObjectAlignment);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
@@ -59,6 +70,11 @@ static RawObject* GetForwardedObject(RawObject* object) {
   return forwarder->target();
 }
 
+static bool IsDummyObject(RawObject* object) {
+  if (!object->IsForwardingCorpse()) return false;
+  return GetForwardedObject(object) == object;
+}
+
 static void ForwardObjectTo(RawObject* before_obj, RawObject* after_obj) {
   const intptr_t size_before = before_obj->HeapSize();
 
@@ -146,6 +162,108 @@ class ForwardHeapPointersHandleVisitor : public HandleVisitor {
   DISALLOW_COPY_AND_ASSIGN(ForwardHeapPointersHandleVisitor);
 };
 
+// Forwards the pointers in the pages of 'pages', claiming one page at a time
+// through 'next_page'.
+static void ForwardPages(Thread* thread,
+                         const GrowableArray<HeapPage*>& pages,
+                         intptr_t* next_page) {
+  ForwardPointersVisitor pointer_visitor(thread);
+  ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
+  for (;;) {
+    const intptr_t index = AtomicOperations::FetchAndIncrement(next_page);
+    if (index >= pages.length()) {
+      break;
+    }
+    pages[index]->VisitObjects(&object_visitor);
+  }
+  pointer_visitor.VisitingObject(NULL);
+}
+
+class ForwardPagesTask : public ThreadPool::Task {
+ public:
+  ForwardPagesTask(Isolate* isolate,
+                   ThreadBarrier* barrier,
+                   const GrowableArray<HeapPage*>* pages,
+                   intptr_t* next_page)
+      : isolate_(isolate),
+        barrier_(barrier),
+        pages_(pages),
+        next_page_(next_page) {}
+
+  virtual void Run() {
+    bool result =
+        Thread::EnterIsolateAsHelper(isolate_, Thread::kBecomeTask, true);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardPages");
+      ForwardPages(thread, *pages_, next_page_);
+    }
+    // Publishes this task's store buffer block.
+    Thread::ExitIsolateAsHelper(true);
+
+    barrier_->Sync();
+    // This task is done. Notify the original thread.
+    barrier_->Exit();
+  }
+
+ private:
+  Isolate* isolate_;
+  ThreadBarrier* barrier_;
+  const GrowableArray<HeapPage*>* pages_;
+  intptr_t* next_page_;
+
+  DISALLOW_COPY_AND_ASSIGN(ForwardPagesTask);
+};
+
+// Moves the weak table entries of all forwarded objects to their targets in
+// one pass over the tables.
+static void ForwardWeakTables(Heap* heap) {
+  Zone* zone = Thread::Current()->zone();
+  GrowableArray<RawObject*> targets(zone, 16);
+  GrowableArray<intptr_t> values(zone, 16);
+  for (intptr_t sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    const Heap::WeakSelector selector = static_cast<Heap::WeakSelector>(sel);
+    for (intptr_t space = Heap::kNew; space <= Heap::kOld; space++) {
+      WeakTable* table =
+          heap->GetWeakTable(static_cast<Heap::Space>(space), selector);
+      for (intptr_t i = 0; i < WeakTable::kNumShards; i++) {
+        WeakTableShard* shard = table->shard(i);
+        for (intptr_t j = 0; j < shard->size(); j++) {
+          if (!shard->IsValidEntryAt(j)) continue;
+          RawObject* key = shard->ObjectAt(j);
+          if (!IsForwardingObject(key) || IsDummyObject(key)) continue;
+          targets.Add(GetForwardedObject(key));
+          values.Add(shard->ValueAt(j));
+          shard->InvalidateAt(j);
+        }
+      }
+    }
+    // Insert only after the scan, since the targets may share the tables.
+    for (intptr_t i = 0; i < targets.length(); i++) {
+      RawObject* target = targets[i];
+      heap->GetWeakTable(target->IsNewObject() ? Heap::kNew : Heap::kOld,
+                         selector)
+          ->SetValue(target, values[i]);
+    }
+    targets.Clear();
+    values.Clear();
+  }
+}
+
+// Whether a single scan of the weak tables is cheaper than looking up each
+// of 'num_forwarded' objects in every table.
+static bool ShouldForwardWeakTablesInBatch(Heap* heap,
+                                           intptr_t num_forwarded) {
+  intptr_t num_entries = 0;
+  for (intptr_t sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    const Heap::WeakSelector selector = static_cast<Heap::WeakSelector>(sel);
+    num_entries += heap->GetWeakTable(Heap::kNew, selector)->count();
+    num_entries += heap->GetWeakTable(Heap::kOld, selector)->count();
+  }
+  return num_forwarded * Heap::kNumWeakSelectors >= num_entries;
+}
+
 // On IA32, object pointers are embedded directly in the instruction stream,
 // which is normally write-protected, so we need to make it temporarily writable
 // to forward the pointers. On all other architectures, object pointers are
@@ -182,11 +300,6 @@ void Become::MakeDummyObject(const Instance& instance) {
   ForwardObjectTo(instance.raw(), instance.raw());
 }
 
-static bool IsDummyObject(RawObject* object) {
-  if (!object->IsForwardingCorpse()) return false;
-  return GetForwardedObject(object) == object;
-}
-
 void Become::CrashDump(RawObject* before_obj, RawObject* after_obj) {
   OS::PrintErr("DETECTED FATAL ISSUE IN BECOME MAPPINGS\n");
 
@@ -225,6 +338,8 @@ void Become::ElementsForwardIdentity(const Array& before, const Array& after) {
 
   // Setup forwarding pointers.
   ASSERT(before.Length() == after.Length());
+  const bool forward_weak_tables_in_batch =
+      ShouldForwardWeakTablesInBatch(heap, before.Length());
   for (intptr_t i = 0; i < before.Length(); i++) {
     RawObject* before_obj = before.At(i);
     RawObject* after_obj = after.At(i);
@@ -255,12 +370,18 @@ void Become::ElementsForwardIdentity(const Array& before, const Array& after) {
     }
 
     ForwardObjectTo(before_obj, after_obj);
-    heap->ForwardWeakEntries(before_obj, after_obj);
+    if (!forward_weak_tables_in_batch) {
+      heap->ForwardWeakEntries(before_obj, after_obj);
+    }
 #if defined(HASH_IN_OBJECT_HEADER)
     Object::SetCachedHash(after_obj, Object::GetCachedHash(before_obj));
 #endif
   }
 
+  if (forward_weak_tables_in_batch) {
+    ForwardWeakTables(heap);
+  }
+
   FollowForwardingPointers(thread);
 
 #if defined(DEBUG)
@@ -283,11 +404,29 @@ void Become::FollowForwardingPointers(Thread* thread) {
   ForwardPointersVisitor pointer_visitor(thread);
 
   {
-    // Heap pointers.
+    // Heap pointers. Old-space pages are shared with the helper tasks while
+    // this thread visits new space.
     WritableCodeLiteralsScope writable_code(heap);
+    GrowableArray<HeapPage*> pages(thread->zone(), 64);
+    heap->old_space()->CollectPages(&pages);
+    intptr_t next_page = 0;
+    const intptr_t num_tasks =
+        Utils::Minimum<intptr_t>(FLAG_become_tasks, pages.length() - 1);
+
+    ThreadBarrier barrier(Utils::Maximum<intptr_t>(num_tasks, 0) + 1,
+                          heap->barrier(), heap->barrier_done());
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      Dart::thread_pool()->Run(
+          new ForwardPagesTask(isolate, &barrier, &pages, &next_page));
+    }
+
     ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
-    heap->VisitObjects(&object_visitor);
+    heap->new_space()->VisitObjects(&object_visitor);
     pointer_visitor.VisitingObject(NULL);
+    ForwardPages(thread, pages, &next_page);
+
+    barrier.Sync();
+    barrier.Exit();
   }
 
   // C++ pointers.
@@ -8,6 +8,7 @@
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
 #include "vm/heap/pages.h"
+#include "vm/heap/weak_table.h"
 #include "vm/thread_barrier.h"
 #include "vm/timeline.h"
 
@@ -117,6 +118,10 @@ void HeapPage::FreeForwardingPage() {
   forwarding_page_ = NULL;
 }
 
+// The forwarding tasks with a case of their own in CompactorTask::Run. They
+// are followed by one task per weak table shard.
+static const intptr_t kNumFixedForwardingTasks = 6;
+
 class CompactorTask : public ThreadPool::Task {
  public:
   CompactorTask(Isolate* isolate,
@@ -166,9 +171,11 @@ class CompactorTask : public ThreadPool::Task {
 // Free space at the end of a page that is too small for the next block is
 // added to the freelist.
 void GCCompactor::Compact(HeapPage* pages,
+                          HeapPage* uncompacted_pages,
                           FreeList* freelist,
                           Mutex* pages_lock) {
   SetupImagePageBoundaries();
+  uncompacted_pages_ = uncompacted_pages;
 
   // Divide the heap.
   // TODO(30978): Try to divide based on live bytes or with work stealing.
@@ -228,6 +235,8 @@ void GCCompactor::Compact(HeapPage* pages,
     }
   }
 
+  PrepareWeakTables();
+
   {
     ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
                           heap_->barrier_done());
@@ -246,6 +255,11 @@ void GCCompactor::Compact(HeapPage* pages,
     barrier.Exit();
   }
 
+  for (intptr_t i = 0; i < weak_tables_.length(); i++) {
+    delete weak_tables_[i];
+  }
+  weak_tables_.Clear();
+
   // Update inner pointers in typed data views (needs to be done after all
   // threads are done with sliding since we need to access fields of the
   // view's backing store)
@@ -303,20 +317,70 @@ void GCCompactor::Compact(HeapPage* pages,
     for (intptr_t task_index = 0; task_index < num_tasks - 1; task_index++) {
       tails[task_index]->set_next(heads[task_index + 1]);
     }
-    tails[num_tasks - 1]->set_next(NULL);
+    HeapPage* tail = tails[num_tasks - 1];
+    tail->set_next(uncompacted_pages);
+    while (tail->next() != NULL) {
+      tail = tail->next();
+    }
     heap_->old_space()->pages_ = pages = heads[0];
-    heap_->old_space()->pages_tail_ = tails[num_tasks - 1];
+    heap_->old_space()->pages_tail_ = tail;
 
     delete[] heads;
     delete[] tails;
   }
 
   // Free forwarding information from the suriving pages.
-  for (HeapPage* page = pages; page != NULL; page = page->next()) {
+  for (HeapPage* page = pages; page != uncompacted_pages;
+       page = page->next()) {
     page->FreeForwardingPage();
   }
 }
 
+void GCCompactor::ForwardUncompactedPages() {
+  // Only visit marked objects: dead objects may refer to pages that have
+  // already been released.
+  for (HeapPage* page = uncompacted_pages_; page != NULL;
+       page = page->next()) {
+    uword current = page->object_start();
+    const uword end = page->object_end();
+    while (current < end) {
+      RawObject* obj = RawObject::FromAddr(current);
+      const intptr_t size = obj->HeapSize();
+      if (obj->IsMarked()) {
+        obj->VisitPointers(this);
+      }
+      current += size;
+    }
+  }
+}
+
+void GCCompactor::PrepareWeakTables() {
+  ASSERT(weak_tables_.is_empty());
+  // Only old-space objects move, so only the old-space tables need rehashing.
+  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    const Heap::WeakSelector selector = static_cast<Heap::WeakSelector>(sel);
+    WeakTable* table = heap_->GetWeakTable(Heap::kOld, selector);
+    heap_->SetWeakTable(Heap::kOld, selector, WeakTable::NewFrom(table));
+    weak_tables_.Add(table);
+  }
+}
+
+void GCCompactor::ForwardWeakTableShard(intptr_t index) {
+  const Heap::WeakSelector sel =
+      static_cast<Heap::WeakSelector>(index / WeakTable::kNumShards);
+  WeakTableShard* table =
+      weak_tables_[sel]->shard(index % WeakTable::kNumShards);
+  WeakTable* target = heap_->GetWeakTable(Heap::kOld, sel);
+  const intptr_t size = table->size();
+  for (intptr_t i = 0; i < size; i++) {
+    if (table->IsValidEntryAt(i)) {
+      RawObject* raw_obj = table->ObjectAt(i);
+      ForwardPointer(&raw_obj);
+      target->SetValueExclusive(raw_obj, table->ValueAt(i));
+    }
+  }
+}
+
 void CompactorTask::Run() {
   bool result =
       Thread::EnterIsolateAsHelper(isolate_, Thread::kCompactorTask, true);
@@ -387,13 +451,13 @@ void CompactorTask::Run() {
           break;
         }
         case 3: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakTables");
-          isolate_->heap()->ForwardWeakTables(compactor_);
+          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakHandles");
+          isolate_->VisitWeakPersistentHandles(compactor_);
           break;
         }
         case 4: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakHandles");
-          isolate_->VisitWeakPersistentHandles(compactor_);
+          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardUncompactedPages");
+          compactor_->ForwardUncompactedPages();
           break;
         }
 #ifndef PRODUCT
@@ -405,8 +469,17 @@ void CompactorTask::Run() {
           break;
         }
 #endif  // !PRODUCT
-        default:
-          more_forwarding_tasks = false;
+        default: {
+          // The remaining tasks are the shards of the weak tables.
+          const intptr_t shard = forwarding_task - kNumFixedForwardingTasks;
+          if ((shard < 0) || (shard >= compactor_->NumWeakTableShards())) {
+            more_forwarding_tasks = (shard < 0);
+            break;
+          }
+          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakTables");
+          compactor_->ForwardWeakTableShard(shard);
+          break;
+        }
       }
     }
 
@@ -422,6 +495,9 @@ void CompactorTask::PlanPage(HeapPage* page) {
   uword current = page->object_start();
   uword end = page->object_end();
 
+  // Card marked arrays are registered again wherever they end up.
+  page->ResetCardTable();
+
   auto forwarding_page = page->AllocateForwardingPage();
   while (current < end) {
     current = PlanBlock(current, forwarding_page);
@@ -518,6 +594,10 @@ uword CompactorTask::SlideBlock(uword first_object,
       }
       new_obj->ClearMarkBit();
       new_obj->VisitPointers(compactor_);
+      if (new_obj->IsCardRemembered()) {
+        // Which cards were dirty is lost with the move; remember them all.
+        HeapPage::Of(new_obj)->RegisterCardArray(new_obj, true);
+      }
 
       ASSERT(free_current_ == new_addr);
       free_current_ += size;
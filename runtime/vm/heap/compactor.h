@@ -28,10 +28,17 @@ class GCCompactor : public ValueObject,
   GCCompactor(Thread* thread, Heap* heap)
       : HandleVisitor(thread),
         ObjectPointerVisitor(thread->isolate()),
-        heap_(heap) {}
+        heap_(heap),
+        uncompacted_pages_(NULL) {}
   ~GCCompactor() {}
 
-  void Compact(HeapPage* pages, FreeList* freelist, Mutex* mutex);
+  // Slides the live objects of 'pages' together. The 'uncompacted_pages' stay
+  // in place, but pointers in their marked objects are forwarded. They are
+  // appended to the compacted pages and left marked for the sweeper.
+  void Compact(HeapPage* pages,
+               HeapPage* uncompacted_pages,
+               FreeList* freelist,
+               Mutex* mutex);
 
  private:
   friend class CompactorTask;
@@ -45,7 +52,19 @@ class GCCompactor : public ValueObject,
   void VisitPointers(RawObject** first, RawObject** last);
   void VisitHandle(uword addr);
 
+  void ForwardUncompactedPages();
+
+  // The old-space weak tables are replaced by fresh ones before the compactor
+  // tasks start. Each forwarding task takes shards of the original tables,
+  // forwards their keys and moves the entries over.
+  void PrepareWeakTables();
+  void ForwardWeakTableShard(intptr_t index);
+  intptr_t NumWeakTableShards() const {
+    return weak_tables_.length() * WeakTable::kNumShards;
+  }
+
   Heap* heap_;
+  HeapPage* uncompacted_pages_;
 
   struct ImagePageRange {
     uword base;
@@ -60,6 +79,8 @@ class GCCompactor : public ValueObject,
   // complete.
   Mutex typed_data_view_mutex_;
   MallocGrowableArray<RawTypedDataView*> typed_data_views_;
+
+  MallocGrowableArray<WeakTable*> weak_tables_;
 };
 
 }  // namespace dart
@@ -10,6 +10,7 @@
 #include "vm/object.h"
 #include "vm/os_thread.h"
 #include "vm/raw_object.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -108,8 +109,65 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
     }
   }
 
+  FreeListElement* element = TryDequeueLarge(size, is_protected, false);
+  if (element == NULL) {
+    return 0;  // Trigger allocation of new page.
+  }
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    intptr_t remainder_size = element->HeapSize() - size;
+    intptr_t region_size =
+        size + FreeListElement::HeaderSizeFor(remainder_size);
+    VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+  SplitElementAfterAndEnqueue(element, size, is_protected);
+  return reinterpret_cast<uword>(element);
+}
+
+FreeListElement* FreeList::TryDequeueLarge(intptr_t size,
+                                           bool is_protected,
+                                           bool largest) {
+  if (size < kMinLargeSize) {
+    // Every large element fits.
+    const intptr_t index = largest ? large_map_.Last() : large_map_.Next(0);
+    return (index == -1) ? NULL : DequeueLargeElement(index);
+  }
+  const intptr_t size_index = LargeIndexForSize(size);
+  if (largest) {
+    const intptr_t index = large_map_.Last();
+    if (index > size_index) {
+      return DequeueLargeElement(index);
+    }
+    return (index == size_index)
+               ? SearchLargeList(size_index, size, is_protected)
+               : NULL;
+  }
+  // The elements of the requested size class fit best, but may be too small.
+  if (large_map_.Test(size_index)) {
+    FreeListElement* element =
+        SearchLargeList(size_index, size, is_protected);
+    if (element != NULL) {
+      return element;
+    }
+  }
+  // Any element of a higher size class fits.
+  if ((size_index + 1) < kNumLargeLists) {
+    const intptr_t index = large_map_.Next(size_index + 1);
+    if (index != -1) {
+      return DequeueLargeElement(index);
+    }
+  }
+  return NULL;
+}
+
+FreeListElement* FreeList::SearchLargeList(intptr_t large_index,
+                                           intptr_t size,
+                                           bool is_protected) {
   FreeListElement* previous = NULL;
-  FreeListElement* current = free_lists_[kNumLists];
+  FreeListElement* current = large_lists_[large_index];
   // We are willing to search the freelist further for a big block.
   // For each successful free-list search we:
   //   * increase the search budget by #allocated-words
@@ -121,58 +179,37 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
   // reset the search budget.
   intptr_t tries_left = freelist_search_budget_ + (size >> kWordSizeLog2);
   while (current != NULL) {
+    FreeListElement* next = current->next();
     if (current->HeapSize() >= size) {
-      // Found an element large enough to hold the requested size. Dequeue,
-      // split and enqueue the remainder.
-      intptr_t remainder_size = current->HeapSize() - size;
-      intptr_t region_size =
-          size + FreeListElement::HeaderSizeFor(remainder_size);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
-                               VirtualMemory::kReadWrite);
-      }
-
       if (previous == NULL) {
-        free_lists_[kNumLists] = current->next();
+        DequeueLargeElement(large_index);
       } else {
-        // If the previous free list element's next field is protected, it
-        // needs to be unprotected before storing to it and reprotected
-        // after.
-        bool target_is_protected = false;
-        uword target_address = 0L;
+        // If the free list elements are protected, the previous element's
+        // next field needs to be unprotected before storing to it and
+        // reprotected after. The found element is made writable by the
+        // caller only after it has been unlinked.
+        const uword target_address = previous->next_address();
         if (is_protected) {
-          uword writable_start = reinterpret_cast<uword>(current);
-          uword writable_end = writable_start + region_size - 1;
-          target_address = previous->next_address();
-          target_is_protected =
-              !VirtualMemory::InSamePage(target_address, writable_start) &&
-              !VirtualMemory::InSamePage(target_address, writable_end);
-        }
-        if (target_is_protected) {
           VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
                                  kWordSize, VirtualMemory::kReadWrite);
         }
-        previous->set_next(current->next());
-        if (target_is_protected) {
+        previous->set_next(next);
+        if (is_protected) {
           VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
                                  kWordSize, VirtualMemory::kReadExecute);
         }
       }
-      SplitElementAfterAndEnqueue(current, size, is_protected);
       freelist_search_budget_ =
           Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return reinterpret_cast<uword>(current);
+      return current;
     } else if (tries_left-- < 0) {
       freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
+      return NULL;  // Trigger allocation of new page.
     }
     previous = current;
-    current = current->next();
+    current = next;
   }
-  return 0;
+  return NULL;
 }
 
 void FreeList::Free(uword addr, intptr_t size) {
@@ -193,18 +230,60 @@ void FreeList::FreeLocked(uword addr, intptr_t size) {
   // Postcondition: the (page containing the) header is left writable.
 }
 
+intptr_t FreeList::ReleaseUnusedMemoryLocked(intptr_t min_size) {
+  DEBUG_ASSERT(mutex_->IsOwnedByCurrentThread());
+  const intptr_t page_size = VirtualMemory::PageSize();
+  intptr_t released = 0;
+  const intptr_t first_index =
+      (min_size < kMinLargeSize) ? 0 : LargeIndexForSize(min_size);
+  for (intptr_t i = first_index; i < kNumLargeLists; i++) {
+    for (FreeListElement* element = large_lists_[i]; element != NULL;
+         element = element->next()) {
+      const intptr_t size = element->HeapSize();
+      if (size < min_size) {
+        continue;
+      }
+      // Keep the element header resident so the element stays in the list.
+      const uword start = reinterpret_cast<uword>(element);
+      const uword release_start = Utils::RoundUp(
+          start + FreeListElement::HeaderSizeFor(size), page_size);
+      const uword release_end = Utils::RoundDown(start + size, page_size);
+      if (release_end > release_start) {
+        VirtualMemory::DontNeed(reinterpret_cast<void*>(release_start),
+                                release_end - release_start);
+        released += release_end - release_start;
+      }
+    }
+  }
+  return released;
+}
+
 void FreeList::Reset() {
   MutexLocker ml(mutex_);
   free_map_.Reset();
   last_free_small_size_ = -1;
-  for (int i = 0; i < (kNumLists + 1); i++) {
+  for (int i = 0; i < kNumLists; i++) {
     free_lists_[i] = NULL;
   }
+  large_map_.Reset();
+  for (intptr_t i = 0; i < kNumLargeLists; i++) {
+    large_lists_[i] = NULL;
+  }
 }
 
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
+  if (index == kNumLists) {
+    const intptr_t large_index = LargeIndexForSize(element->HeapSize());
+    FreeListElement* next = large_lists_[large_index];
+    if (next == NULL) {
+      large_map_.Set(large_index, true);
+    }
+    element->set_next(next);
+    large_lists_[large_index] = element;
+    return;
+  }
   FreeListElement* next = free_lists_[index];
-  if (next == NULL && index != kNumLists) {
+  if (next == NULL) {
     free_map_.Set(index, true);
     last_free_small_size_ =
         Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
@@ -277,15 +356,17 @@ void FreeList::PrintLarge() const {
   intptr_t large_bytes = 0;
   MallocDirectChainedHashMap<NumbersKeyValueTrait<IntptrPair> > map;
   FreeListElement* node;
-  for (node = free_lists_[kNumLists]; node != NULL; node = node->next()) {
-    IntptrPair* pair = map.Lookup(node->HeapSize());
-    if (pair == NULL) {
-      large_sizes += 1;
-      map.Insert(IntptrPair(node->HeapSize(), 1));
-    } else {
-      pair->set_second(pair->second() + 1);
+  for (intptr_t i = 0; i < kNumLargeLists; i++) {
+    for (node = large_lists_[i]; node != NULL; node = node->next()) {
+      IntptrPair* pair = map.Lookup(node->HeapSize());
+      if (pair == NULL) {
+        large_sizes += 1;
+        map.Insert(IntptrPair(node->HeapSize(), 1));
+      } else {
+        pair->set_second(pair->second() + 1);
+      }
+      large_objects += 1;
     }
-    large_objects += 1;
   }
 
   MallocDirectChainedHashMap<NumbersKeyValueTrait<IntptrPair> >::Iterator it =
@@ -343,31 +424,9 @@ FreeListElement* FreeList::TryAllocateLarge(intptr_t minimum_size) {
 
 FreeListElement* FreeList::TryAllocateLargeLocked(intptr_t minimum_size) {
   DEBUG_ASSERT(mutex_->IsOwnedByCurrentThread());
-  FreeListElement* previous = NULL;
-  FreeListElement* current = free_lists_[kNumLists];
-  // TODO(koda): Find largest.
-  // We are willing to search the freelist further for a big block.
-  intptr_t tries_left =
-      freelist_search_budget_ + (minimum_size >> kWordSizeLog2);
-  while (current != NULL) {
-    FreeListElement* next = current->next();
-    if (current->HeapSize() >= minimum_size) {
-      if (previous == NULL) {
-        free_lists_[kNumLists] = next;
-      } else {
-        previous->set_next(next);
-      }
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return current;
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
-    }
-    previous = current;
-    current = next;
-  }
-  return NULL;
+  // Bump allocation consumes the whole element, so prefer the largest one.
+  return TryDequeueLarge(minimum_size, /*is_protected=*/false,
+                         /*largest=*/true);
 }
 
 }  // namespace dart
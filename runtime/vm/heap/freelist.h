@@ -90,7 +90,12 @@ class FreeList {
   uword TryAllocateLocked(intptr_t size, bool is_protected);
   void FreeLocked(uword addr, intptr_t size);
 
-  // Returns a large element, at least 'minimum_size', or NULL if none exists.
+  // Returns the OS pages spanned by the large free elements of at least
+  // min_size bytes to the OS. Returns the number of bytes released.
+  intptr_t ReleaseUnusedMemoryLocked(intptr_t min_size);
+
+  // Returns a large element, at least 'minimum_size', preferring the largest
+  // size class, or NULL if none is found.
   FreeListElement* TryAllocateLarge(intptr_t minimum_size);
   FreeListElement* TryAllocateLargeLocked(intptr_t minimum_size);
 
@@ -120,6 +125,18 @@ class FreeList {
   static const int kNumLists = 128;
   static const intptr_t kInitialFreeListSearchBudget = 1000;
 
+  // Elements too large for the exact size lists are kept in segregated lists,
+  // kLargeListsPerPowerOfTwo per power of two, indexed by a bitmap. Every
+  // element in a list above the one for a given size is large enough for it,
+  // so allocation searches at most the list of its own size class before
+  // taking the first element of the next populated one.
+  static const intptr_t kNumLargeLists = 64;
+  static const intptr_t kLargeListsPerPowerOfTwoLog2 = 2;
+  static const intptr_t kMinLargeSizeLog2 = 7 + kObjectAlignmentLog2;
+  static const intptr_t kMinLargeSize = static_cast<intptr_t>(1)
+                                        << kMinLargeSizeLog2;
+  COMPILE_ASSERT(kMinLargeSize == (kNumLists << kObjectAlignmentLog2));
+
   static intptr_t IndexForSize(intptr_t size) {
     ASSERT(size >= kObjectAlignment);
     ASSERT(Utils::IsAligned(size, kObjectAlignment));
@@ -131,13 +148,26 @@ class FreeList {
     return index;
   }
 
+  static intptr_t LargeIndexForSize(intptr_t size) {
+    ASSERT(size >= kMinLargeSize);
+    const intptr_t log2 = Utils::HighestBit(size);
+    const intptr_t sub_index =
+        (size >> (log2 - kLargeListsPerPowerOfTwoLog2)) &
+        ((1 << kLargeListsPerPowerOfTwoLog2) - 1);
+    const intptr_t index =
+        ((log2 - kMinLargeSizeLog2) << kLargeListsPerPowerOfTwoLog2) +
+        sub_index;
+    return Utils::Minimum(index, kNumLargeLists - 1);
+  }
+
   intptr_t LengthLocked(int index) const;
 
   void EnqueueElement(FreeListElement* element, intptr_t index);
   FreeListElement* DequeueElement(intptr_t index) {
+    ASSERT(index != kNumLists);
     FreeListElement* result = free_lists_[index];
     FreeListElement* next = result->next();
-    if (next == NULL && index != kNumLists) {
+    if (next == NULL) {
       intptr_t size = index << kObjectAlignmentLog2;
       if (size == last_free_small_size_) {
         // Note: This is -1 * kObjectAlignment if no other small sizes remain.
@@ -151,6 +181,27 @@ class FreeList {
     return result;
   }
 
+  FreeListElement* DequeueLargeElement(intptr_t large_index) {
+    FreeListElement* result = large_lists_[large_index];
+    FreeListElement* next = result->next();
+    if (next == NULL) {
+      large_map_.Set(large_index, false);
+    }
+    large_lists_[large_index] = next;
+    return result;
+  }
+
+  // Unlinks and returns a large element of at least [size] bytes, or NULL
+  // if there is none. When [largest] is true, prefers the highest populated
+  // size class over the best fitting one.
+  FreeListElement* TryDequeueLarge(intptr_t size,
+                                   bool is_protected,
+                                   bool largest);
+  // First-fit search of a single large list.
+  FreeListElement* SearchLargeList(intptr_t large_index,
+                                   intptr_t size,
+                                   bool is_protected);
+
   void SplitElementAfterAndEnqueue(FreeListElement* element,
                                    intptr_t size,
                                    bool is_protected);
@@ -163,7 +214,11 @@ class FreeList {
 
   BitSet<kNumLists> free_map_;
 
-  FreeListElement* free_lists_[kNumLists + 1];
+  FreeListElement* free_lists_[kNumLists];
+
+  BitSet<kNumLargeLists> large_map_;
+
+  FreeListElement* large_lists_[kNumLargeLists];
 
   intptr_t freelist_search_budget_;
 
@@ -182,4 +182,39 @@ TEST_CASE(FreeListProtectedVariableSizeObjects) {
   delete[] objects;
 }
 
+TEST_CASE(FreeListSegregatedLargeLists) {
+  FreeList* free_list = new FreeList();
+  const intptr_t kBlobSize = 1 * MB;
+  VirtualMemory* region =
+      VirtualMemory::Allocate(kBlobSize, /* is_executable */ false, NULL);
+  const uword blob = region->start();
+
+  // Free separate elements of various sizes above the small size classes.
+  const intptr_t kSizes[] = {2 * KB, 3 * KB, 5 * KB, 9 * KB, 64 * KB};
+  const intptr_t kNumSizes = ARRAY_SIZE(kSizes);
+  uword elements[kNumSizes];
+  uword cursor = blob;
+  for (intptr_t i = 0; i < kNumSizes; i++) {
+    elements[i] = cursor;
+    free_list->Free(cursor, kSizes[i]);
+    // Leave a gap so the elements cannot be mistaken for a single block.
+    cursor += kSizes[i] + KB;
+  }
+
+  // An element of the requested size class which fits is preferred.
+  EXPECT_EQ(elements[3], Allocate(free_list, 9 * KB, false));
+  // Otherwise the next populated size class is used.
+  EXPECT_EQ(elements[2], Allocate(free_list, 4 * KB, false));
+  EXPECT_EQ(elements[1], Allocate(free_list, 3 * KB, false));
+  // Bump allocation takes the largest element.
+  FreeListElement* largest = free_list->TryAllocateLarge(2 * KB);
+  EXPECT_EQ(elements[4], reinterpret_cast<uword>(largest));
+  EXPECT_EQ(64 * KB, largest->HeapSize());
+  EXPECT_EQ(elements[0], Allocate(free_list, 2 * KB, false));
+  EXPECT_EQ(0u, Allocate(free_list, 2 * KB, false));
+
+  delete region;
+  delete free_list;
+}
+
 }  // namespace dart
@@ -7,6 +7,7 @@
 #include "platform/assert.h"
 #include "platform/utils.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/heap/become.h"
 #include "vm/heap/pages.h"
@@ -32,6 +33,11 @@
 namespace dart {
 
 DEFINE_FLAG(bool, write_protect_vm_isolate, true, "Write protect vm_isolate.");
+DEFINE_FLAG(int,
+            tlab_grow_refills,
+            4,
+            "Double a thread's new-space TLAB size after this many refills "
+            "between two scavenges (0 keeps TLABs at their minimum size).");
 
 Heap::Heap(Isolate* isolate,
            intptr_t max_new_gen_semi_words,
@@ -64,7 +70,7 @@ Heap::~Heap() {
 
 void Heap::MakeTLABIterable(Thread* thread) {
   uword start = thread->top();
-  uword end = thread->end();
+  uword end = thread->tlab_end();
   ASSERT(end >= start);
   intptr_t size = end - start;
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
@@ -75,12 +81,62 @@ void Heap::MakeTLABIterable(Thread* thread) {
   }
 }
 
+intptr_t Heap::NextTLABSize(Thread* thread) {
+  const intptr_t max_size = GetTLABSize();
+  intptr_t size = thread->tlab_size();
+  if (size == 0) {
+    size = Utils::Minimum(kMinTLABSize, max_size);
+  }
+  const intptr_t refills = thread->tlab_refills() + 1;
+  if ((FLAG_tlab_grow_refills > 0) && (refills >= FLAG_tlab_grow_refills) &&
+      ((refills % FLAG_tlab_grow_refills) == 0)) {
+    size = Utils::Minimum(2 * size, max_size);
+  }
+  thread->set_tlab_refills(refills);
+  thread->set_tlab_size(size);
+  return size;
+}
+
+void Heap::AdjustTLABSize(Thread* thread) {
+  if ((thread->tlab_refills() == 0) && (thread->tlab_size() != 0)) {
+    const intptr_t min_size = Utils::Minimum(kMinTLABSize, GetTLABSize());
+    thread->set_tlab_size(Utils::Maximum(thread->tlab_size() / 2, min_size));
+  }
+  thread->set_tlab_refills(0);
+}
+
 void Heap::AbandonRemainingTLAB(Thread* thread) {
   MakeTLABIterable(thread);
+  if (AllocationSampler::IsEnabled()) {
+    thread->set_allocation_sample_remaining(
+        thread->allocation_sample_remaining() -
+        (thread->top() - thread->allocation_sample_top()));
+    thread->set_allocation_sample_top(0);
+  }
   thread->set_top(0);
   thread->set_end(0);
 }
 
+void Heap::AdvanceAllocationSample(Thread* thread, intptr_t size) {
+  ASSERT(AllocationSampler::IsEnabled());
+  const uword top = thread->top();
+  intptr_t remaining = thread->allocation_sample_remaining() - size -
+                       (top - thread->allocation_sample_top());
+  if (remaining < 0) {
+    thread->set_allocation_sample_pending(true);
+    remaining = Utils::RoundUp(allocation_sampler_.NextSampleDistance(),
+                               kObjectAlignment);
+  }
+  thread->set_allocation_sample_remaining(remaining);
+  thread->set_allocation_sample_top(top);
+  if (thread->HasActiveTLAB()) {
+    const uword tlab_end = thread->tlab_end();
+    thread->set_allocation_limit(
+        (remaining < static_cast<intptr_t>(tlab_end - top)) ? top + remaining
+                                                            : tlab_end);
+  }
+}
+
 uword Heap::AllocateNew(intptr_t size) {
   ASSERT(Thread::Current()->no_safepoint_scope_depth() == 0);
   Thread* thread = Thread::Current();
@@ -88,18 +144,35 @@ uword Heap::AllocateNew(intptr_t size) {
   if (addr != 0) {
     return addr;
   }
+  const bool sampling = AllocationSampler::IsEnabled();
+  if (sampling && (thread->end() < thread->tlab_end())) {
+    // This allocation crosses the next sample point.
+    thread->set_allocation_limit(thread->tlab_end());
+    addr = new_space_.TryAllocateInTLAB(thread, size);
+    if (addr != 0) {
+      AdvanceAllocationSample(thread, 0);
+      return addr;
+    }
+  }
 
-  intptr_t tlab_size = GetTLABSize();
-  if ((tlab_size > 0) && (size > tlab_size)) {
+  const intptr_t max_tlab_size = GetTLABSize();
+  if ((max_tlab_size > 0) && (size > max_tlab_size)) {
     return AllocateOld(size, HeapPage::kData);
   }
 
   AbandonRemainingTLAB(thread);
-  if (tlab_size > 0) {
+  intptr_t tlab_size = 0;
+  if (max_tlab_size > 0) {
+    tlab_size = Utils::Maximum(NextTLABSize(thread),
+                               Utils::RoundUp(size, kObjectAlignment));
     uword tlab_top = new_space_.TryAllocateNewTLAB(thread, tlab_size);
     if (tlab_top != 0) {
+      thread->set_allocation_sample_top(tlab_top);
       addr = new_space_.TryAllocateInTLAB(thread, size);
       if (addr != 0) {  // but "leftover" TLAB could end smaller than tlab_size
+        if (sampling) {
+          AdvanceAllocationSample(thread, 0);
+        }
         return addr;
       }
       // Abandon "leftover" TLAB as well so we can start from scratch.
@@ -116,10 +189,14 @@ uword Heap::AllocateNew(intptr_t size) {
 
   uword tlab_top = new_space_.TryAllocateNewTLAB(thread, tlab_size);
   if (tlab_top != 0) {
+    thread->set_allocation_sample_top(tlab_top);
     addr = new_space_.TryAllocateInTLAB(thread, size);
     // It is possible a GC doesn't clear enough space.
     // In that case, we must fall through and allocate into old space.
     if (addr != 0) {
+      if (sampling) {
+        AdvanceAllocationSample(thread, 0);
+      }
       return addr;
     }
   }
@@ -128,6 +205,12 @@ uword Heap::AllocateNew(intptr_t size) {
 
 uword Heap::AllocateOld(intptr_t size, HeapPage::PageType type) {
   ASSERT(Thread::Current()->no_safepoint_scope_depth() == 0);
+  if (type == HeapPage::kData) {
+    uword addr = old_space_.TryAllocateInTLAB(Thread::Current(), size);
+    if (addr != 0) {
+      return addr;
+    }
+  }
   uword addr = old_space_.TryAllocate(size, type);
   if (addr != 0) {
     return addr;
@@ -431,10 +514,26 @@ void Heap::NotifyIdle(int64_t deadline) {
     TIMELINE_FUNCTION_GC_DURATION(thread, "IdleGC");
     CollectOldSpaceGarbage(thread, kMarkSweep, kIdle);
   }
+  if (old_space_.ShouldReleaseFreeMemory() &&
+      (OS::GetCurrentMonotonicMicros() < deadline)) {
+    TIMELINE_FUNCTION_GC_DURATION(thread, "IdleReleaseFreeMemory");
+    ReleaseFreeMemory();
+  }
 }
 
 void Heap::NotifyLowMemory() {
   CollectAllGarbage(kLowMemory);
+  ReleaseFreeMemory();
+}
+
+void Heap::ReleaseFreeMemory() {
+  const intptr_t released = old_space_.ReleaseFreeMemory();
+#if !defined(PRODUCT)
+  Metric* metric = isolate()->GetHeapOldReleasedMetric();
+  metric->set_value(metric->value() + released);
+#else
+  USE(released);
+#endif  // !defined(PRODUCT)
 }
 
 void Heap::EvacuateNewSpace(Thread* thread, GCReason reason) {
@@ -449,6 +548,7 @@ void Heap::EvacuateNewSpace(Thread* thread, GCReason reason) {
     PrintStats();
     NOT_IN_PRODUCT(PrintStatsToTimeline(&tds, reason));
     EndNewSpaceGC();
+    RunPendingFinalizers(thread);
   }
 }
 
@@ -466,6 +566,8 @@ void Heap::CollectNewSpaceGarbage(Thread* thread, GCReason reason) {
       NOT_IN_PRODUCT(PrintStatsToTimeline(&tds, reason));
       EndNewSpaceGC();
     }
+    RunPendingFinalizers(thread);
+    NOT_IN_PRODUCT(isolate()->class_table()->ApplyPretenuring(thread));
     if (reason == kNewSpace) {
       if (old_space_.NeedsGarbageCollection()) {
         CollectOldSpaceGarbage(thread, kMarkSweep, kPromotion);
@@ -481,7 +583,9 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
                                   GCReason reason) {
   ASSERT(reason != kNewSpace);
   ASSERT(type != kScavenge);
-  if (FLAG_use_compactor) {
+  // Under memory pressure, compact so that whole pages can be released.
+  const bool under_memory_pressure = old_space_.UnderMemoryPressure();
+  if (FLAG_use_compactor || under_memory_pressure) {
     type = kMarkCompact;
   }
   if (BeginOldSpaceGC(thread)) {
@@ -497,6 +601,10 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     thread->isolate()->handler_info_cache()->Clear();
     thread->isolate()->catch_entry_moves_cache()->Clear();
     EndOldSpaceGC();
+    RunPendingFinalizers(thread);
+    if (under_memory_pressure || old_space_.UnderMemoryPressure()) {
+      ReleaseFreeMemory();
+    }
   }
 }
 
@@ -569,6 +677,20 @@ void Heap::CheckFinishConcurrentMarking(Thread* thread) {
   }
 }
 
+void Heap::RunPendingFinalizers(Thread* thread) {
+  ApiState* state = isolate()->api_state();
+  if ((state == NULL) ||
+      !state->weak_persistent_handles().HasPendingFinalizations()) {
+    return;
+  }
+  if (thread->IsMutatorThread()) {
+    TIMELINE_FUNCTION_GC_DURATION(thread, "RunPendingFinalizers");
+    state->weak_persistent_handles().RunPendingFinalizations(isolate());
+  } else {
+    isolate()->ScheduleInterrupts(Thread::kVMInterrupt);
+  }
+}
+
 void Heap::WaitForMarkerTasks(Thread* thread) {
   MonitorLocker ml(old_space_.tasks_lock());
   while ((old_space_.phase() == PageSpace::kMarking) ||
@@ -847,14 +969,6 @@ void Heap::ForwardWeakEntries(RawObject* before_object,
   }
 }
 
-void Heap::ForwardWeakTables(ObjectPointerVisitor* visitor) {
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    WeakSelector selector = static_cast<Heap::WeakSelector>(sel);
-    GetWeakTable(Heap::kNew, selector)->Forward(visitor);
-    GetWeakTable(Heap::kOld, selector)->Forward(visitor);
-  }
-}
-
 #ifndef PRODUCT
 void Heap::PrintToJSONObject(Space space, JSONObject* object) const {
   if (space == kNew) {
@@ -870,6 +984,18 @@ void Heap::PrintMemoryUsageJSON(JSONStream* stream) const {
   jsobj.AddProperty64("heapUsage", TotalUsedInWords() * kWordSize);
   jsobj.AddProperty64("heapCapacity", TotalCapacityInWords() * kWordSize);
   jsobj.AddProperty64("externalUsage", TotalExternalInWords() * kWordSize);
+  PrintPausesToJSONObject(&jsobj);
+}
+
+void Heap::PrintPausesToJSONObject(JSONObject* object) const {
+  static const char* kPauseNames[kNumPauseKinds] = {
+      "scavenge", "mark", "sweep", "compact", "safepoint",
+  };
+  JSONObject pauses(object, "_gcPauses");
+  for (intptr_t i = 0; i < kNumPauseKinds; i++) {
+    JSONObject pause(&pauses, kPauseNames[i]);
+    pause_histograms_[i].PrintToJSONObject(&pause);
+  }
 }
 #endif  // PRODUCT
 
@@ -895,6 +1021,7 @@ void Heap::RecordAfterGC(GCType type) {
   if (stats_.type_ == kScavenge) {
     new_space_.AddGCTime(delta);
     new_space_.IncrementCollections();
+    RecordPause(kScavengePause, delta);
   } else {
     old_space_.AddGCTime(delta);
     old_space_.IncrementCollections();
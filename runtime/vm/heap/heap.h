@@ -13,7 +13,9 @@
 #include "vm/allocation.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/allocation_sampler.h"
 #include "vm/heap/pages.h"
+#include "vm/heap/pause_histogram.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
 #include "vm/heap/weak_table.h"
@@ -64,6 +66,16 @@ class Heap {
     kDebugging,  // service request, --gc_at_instance_allocation, etc.
   };
 
+  // Pauses tracked in histograms, see RecordPause.
+  enum PauseKind {
+    kScavengePause,   // Whole scavenge.
+    kMarkPause,       // Marking (or its finalization) at the safepoint.
+    kSweepPause,      // Sweeping done at the safepoint.
+    kCompactPause,    // Compaction.
+    kSafepointPause,  // Time for all threads to reach a safepoint.
+    kNumPauseKinds,
+  };
+
   // Pattern for unused new space and swept old space.
   static const uint8_t kZapByte = 0xf3;
 
@@ -120,6 +132,9 @@ class Heap {
   void NotifyIdle(int64_t deadline);
   void NotifyLowMemory();
 
+  // Returns unused old-space memory to the OS.
+  void ReleaseFreeMemory();
+
   // Collect a single generation.
   void CollectGarbage(Space space);
   void CollectGarbage(GCType type, GCReason reason);
@@ -141,6 +156,11 @@ class Heap {
 
   void CheckStartConcurrentMarking(Thread* thread, GCReason reason);
   void CheckFinishConcurrentMarking(Thread* thread);
+
+  // Runs the weak persistent handle callbacks queued by collections with
+  // --defer_weak_handle_finalizers. Other threads leave them to the mutator,
+  // which runs them when it handles its next VM interrupt.
+  void RunPendingFinalizers(Thread* thread);
   void WaitForMarkerTasks(Thread* thread);
   void WaitForSweeperTasks(Thread* thread);
 
@@ -250,7 +270,6 @@ class Heap {
   }
 
   void ForwardWeakEntries(RawObject* before_object, RawObject* after_object);
-  void ForwardWeakTables(ObjectPointerVisitor* visitor);
 
   // Stats collection.
   void RecordTime(int id, int64_t micros) {
@@ -263,6 +282,15 @@ class Heap {
     stats_.data_[id] = value;
   }
 
+  void RecordPause(PauseKind kind, int64_t micros) {
+    ASSERT((kind >= 0) && (kind < kNumPauseKinds));
+    pause_histograms_[kind].Add(micros);
+  }
+  const PauseHistogram& pause_histogram(PauseKind kind) const {
+    ASSERT((kind >= 0) && (kind < kNumPauseKinds));
+    return pause_histograms_[kind];
+  }
+
   void UpdateGlobalMaxUsed();
 
   static bool IsAllocatableInNewSpace(intptr_t size) {
@@ -276,6 +304,9 @@ class Heap {
   // old space combined.
   void PrintMemoryUsageJSON(JSONStream* stream) const;
 
+  // Adds a "_gcPauses" property with a summary of each pause histogram.
+  void PrintPausesToJSONObject(JSONObject* object) const;
+
   // The heap map contains the sizes and class ids for the objects in each page.
   void PrintHeapMapToJSONStream(Isolate* isolate, JSONStream* stream) {
     old_space_.PrintHeapMapToJSONStream(isolate, stream);
@@ -291,7 +322,16 @@ class Heap {
     old_space_.SetupImagePage(pointer, size, is_executable);
   }
 
-  static const intptr_t kNewAllocatableSize = 256 * KB;
+  // Objects that would need a large page in old space are never allocated in
+  // new space. They get a mapping of their own right away, so the scavenger
+  // never copies them and promotion never has to move them.
+  static const intptr_t kNewAllocatableSize = 64 * KB;
+
+  // Arrays larger than this are allocated in old space and remember stores
+  // per card rather than as a whole object, so a scavenge only scans the
+  // parts of the array that were written to since the last one. Must span
+  // at least two cards.
+  static const intptr_t kCardMarkingArraySize = 16 * KB;
 
   intptr_t GetTLABSize() {
     // Inspired by V8 tlab size. More than threshold for old space allocation,
@@ -299,9 +339,26 @@ class Heap {
     const intptr_t size = 512 * KB;
     return Utils::RoundDown(size, kObjectAlignment);
   }
+
+  // TLABs start small and double each time a thread has refilled
+  // FLAG_tlab_grow_refills of them since the last scavenge, up to
+  // GetTLABSize(). A thread that took no TLAB between two scavenges gets its
+  // size halved again, so idle threads do not pin large chunks of new space.
+  static const intptr_t kMinTLABSize = 16 * KB;
+  intptr_t NextTLABSize(Thread* thread);
+  void AdjustTLABSize(Thread* thread);
+
   void MakeTLABIterable(Thread* thread);
   void AbandonRemainingTLAB(Thread* thread);
 
+  AllocationSampler* allocation_sampler() { return &allocation_sampler_; }
+
+  // Accounts the bytes 'thread' allocated in its TLAB since the last call and
+  // 'size' bytes allocated elsewhere against the distance to its next
+  // allocation sample, marks the sample pending if that point was passed and
+  // lowers the thread's allocation limit to the next one.
+  void AdvanceAllocationSample(Thread* thread, intptr_t size);
+
  private:
   class GCStats : public ValueObject {
    public:
@@ -387,6 +444,9 @@ class Heap {
 
   // GC stats collection.
   GCStats stats_;
+  PauseHistogram pause_histograms_[kNumPauseKinds];
+
+  AllocationSampler allocation_sampler_;
 
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
@@ -9,11 +9,21 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/weak_table.h"
 #include "vm/symbols.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+#ifndef PRODUCT
+DECLARE_FLAG(int, pretenure_scavenges);
+DECLARE_FLAG(int, pretenure_threshold);
+#endif
+DECLARE_FLAG(int, compaction_page_budget);
+DECLARE_FLAG(int, old_tlab_size);
+DECLARE_FLAG(int, scavenger_tasks);
+DECLARE_FLAG(int, tlab_grow_refills);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -356,6 +366,45 @@ ISOLATE_UNIT_TEST_CASE(BecomeForwardPeer) {
   EXPECT_EQ(peer, heap->GetPeer(after_obj.raw()));
 }
 
+ISOLATE_UNIT_TEST_CASE(BecomeForwardManyInParallel) {
+  Heap* heap = Isolate::Current()->heap();
+  const intptr_t kNumObjects = 4096;
+  const Array& before = Array::Handle(Array::New(kNumObjects, Heap::kOld));
+  const Array& after = Array::Handle(Array::New(kNumObjects, Heap::kOld));
+  // Referrers spread over many pages, in both spaces.
+  const Array& referrers = Array::Handle(Array::New(kNumObjects, Heap::kOld));
+  Array& before_obj = Array::Handle();
+  Array& after_obj = Array::Handle();
+  Array& referrer = Array::Handle();
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    before_obj = Array::New(1, Heap::kOld);
+    after_obj = Array::New(1, Heap::kOld);
+    referrer = Array::New(16, (i % 2) == 0 ? Heap::kOld : Heap::kNew);
+    referrer.SetAt(0, before_obj);
+    referrers.SetAt(i, referrer);
+    if ((i % 16) == 0) {
+      heap->SetPeer(before_obj.raw(), reinterpret_cast<void*>(i + 1));
+    }
+    before.SetAt(i, before_obj);
+    after.SetAt(i, after_obj);
+  }
+
+  Become::ElementsForwardIdentity(before, after);
+
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    referrer ^= referrers.At(i);
+    EXPECT(referrer.At(0) == after.At(i));
+    void* expected_peer = (i % 16) == 0 ? reinterpret_cast<void*>(i + 1)
+                                        : reinterpret_cast<void*>(0);
+    EXPECT_EQ(expected_peer, heap->GetPeer(after.At(i)));
+  }
+  heap->CollectAllGarbage();
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    referrer ^= referrers.At(i);
+    EXPECT(referrer.At(0) == after.At(i));
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(BecomeForwardRememberedObject) {
   Isolate* isolate = Isolate::Current();
   Heap* heap = isolate->heap();
@@ -709,6 +758,14 @@ class HeapTestHelper {
     thread->heap()->WaitForMarkerTasks(thread);
     thread->heap()->WaitForSweeperTasks(thread);
   }
+  static void StartConcurrentMarking(Thread* thread) {
+    Heap* heap = thread->heap();
+    if (heap->BeginOldSpaceGC(thread)) {
+      heap->old_space()->CollectGarbage(/*compact=*/false,
+                                        /*finalize=*/false);
+      heap->EndOldSpaceGC();
+    }
+  }
 };
 
 ISOLATE_UNIT_TEST_CASE(ExternalAllocationStats) {
@@ -738,6 +795,54 @@ ISOLATE_UNIT_TEST_CASE(ExternalAllocationStats) {
         heap->new_space()->ExternalInWords() * kWordSize);
   }
 }
+
+// Builds a chain of [length] new-space arrays, each holding an old-space
+// string which is only reachable through the chain.
+static RawArray* NewSpaceChain(intptr_t length, const Array& tail) {
+  Array& chain = Array::Handle(tail.raw());
+  Array& link = Array::Handle();
+  String& str = String::Handle();
+  for (intptr_t i = 0; i < length; i++) {
+    link = Array::New(2, Heap::kNew);
+    str = String::New("old", Heap::kOld);
+    link.SetAt(0, str);
+    link.SetAt(1, chain);
+    chain = link.raw();
+  }
+  return chain.raw();
+}
+
+static intptr_t CheckNewSpaceChain(const Array& chain) {
+  Array& link = Array::Handle(chain.raw());
+  Object& element = Object::Handle();
+  intptr_t length = 0;
+  while (!link.IsNull()) {
+    element = link.At(0);
+    EXPECT(element.IsString());
+    EXPECT(String::Cast(element).Equals("old"));
+    link ^= link.At(1);
+    length++;
+  }
+  return length;
+}
+
+ISOLATE_UNIT_TEST_CASE(ConcurrentMarkSplitsNewSpaceRoots) {
+  Heap* heap = thread->heap();
+  HeapTestHelper::MarkSweep(thread);
+
+  // Enough new-space objects for the root scan to be split.
+  const intptr_t kLength = 8 * KB;
+  Array& chain = Array::Handle(NewSpaceChain(kLength, Array::Handle()));
+  const intptr_t collections = heap->new_space()->collections();
+  HeapTestHelper::StartConcurrentMarking(thread);
+  // Objects allocated while marking end up in the last slice.
+  chain = NewSpaceChain(kLength, chain);
+  heap->WaitForMarkerTasks(thread);
+  heap->WaitForSweeperTasks(thread);
+  EXPECT_EQ(collections, heap->new_space()->collections());
+
+  EXPECT_EQ(2 * kLength, CheckNewSpaceChain(chain));
+}
 #endif  // !defined(PRODUCT)
 
 ISOLATE_UNIT_TEST_CASE(ArrayTruncationRaces) {
@@ -785,4 +890,422 @@ ISOLATE_UNIT_TEST_CASE(ArrayTruncationRaces) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(ParallelScavenge) {
+  intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 4;
+  Heap* heap = Isolate::Current()->heap();
+
+  // Build a new-space graph reachable both from a handle and from an old
+  // object (i.e., through the store buffer), with shared substructure so that
+  // tasks race to forward the same objects.
+  const intptr_t kLength = 1000;
+  const Array& shared = Array::Handle(Array::New(1, Heap::kNew));
+  shared.SetAt(0, String::Handle(String::New("shared", Heap::kNew)));
+  const Array& root = Array::Handle(Array::New(kLength, Heap::kNew));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(2, Heap::kNew);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    element.SetAt(1, shared);
+    root.SetAt(i, element);
+  }
+  const Array& old = Array::Handle(Array::New(1, Heap::kOld));
+  old.SetAt(0, root);
+
+  // The first scavenge copies the graph, the second one promotes it.
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(root.raw()->IsNewObject());
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(root.raw()->IsOldObject());
+  EXPECT(old.At(0) == root.raw());
+
+  Smi& value = Smi::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element ^= root.At(i);
+    value ^= element.At(0);
+    EXPECT_EQ(i, value.Value());
+    EXPECT(element.At(1) == shared.raw());
+  }
+  String& str = String::Handle();
+  str ^= shared.At(0);
+  EXPECT(str.Equals("shared"));
+
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
+#ifndef PRODUCT
+ISOLATE_UNIT_TEST_CASE(PretenureSurvivingClass) {
+  const int saved_threshold = FLAG_pretenure_threshold;
+  const int saved_scavenges = FLAG_pretenure_scavenges;
+  FLAG_pretenure_threshold = 50;
+  FLAG_pretenure_scavenges = 1;
+
+  Heap* heap = thread->isolate()->heap();
+  ClassTable* class_table = thread->isolate()->class_table();
+  const intptr_t kNumElements = 200;
+  const Array& holder = Array::Handle(Array::New(kNumElements, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kNumElements; i++) {
+    element = Array::New(1, Heap::kNew);
+    holder.SetAt(i, element);
+  }
+  EXPECT(!class_table->ShouldPretenure(kArrayCid));
+
+  // The first scavenge ages the elements, the second promotes all of them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(class_table->ShouldPretenure(kArrayCid));
+
+  // New-space requests for the class now land in old space.
+  element = Array::New(1, Heap::kNew);
+  EXPECT(element.IsOld());
+
+  FLAG_pretenure_threshold = saved_threshold;
+  FLAG_pretenure_scavenges = saved_scavenges;
+}
+#endif  // !PRODUCT
+
+ISOLATE_UNIT_TEST_CASE(ReleaseFreeOldSpaceMemory) {
+  Heap* heap = thread->isolate()->heap();
+  PageSpace* old_space = heap->old_space();
+  heap->CollectAllGarbage();
+  heap->WaitForSweeperTasks(thread);
+
+  // Keep the first object of a page alive so the page is not freed, but
+  // leaves a large free block behind it.
+  const Array& retained = Array::Handle(Array::New(1, Heap::kOld));
+  const intptr_t kGarbageArrays = 32;
+  for (intptr_t i = 0; i < kGarbageArrays; i++) {
+    Array::New(1024, Heap::kOld);
+  }
+  heap->CollectAllGarbage();
+  heap->WaitForSweeperTasks(thread);
+
+  EXPECT(old_space->ReleaseFreeMemory() > 0);
+  EXPECT(retained.IsOld());
+  // Released memory can be allocated again.
+  const Array& reused = Array::Handle(Array::New(1024, Heap::kOld));
+  for (intptr_t i = 0; i < 1024; i++) {
+    EXPECT(reused.At(i) == Object::null());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(OldSpaceTLAB) {
+  const int saved_old_tlab_size = FLAG_old_tlab_size;
+  FLAG_old_tlab_size = 16;
+  Heap* heap = thread->isolate()->heap();
+
+  const Array& first = Array::Handle(Array::New(4, Heap::kOld));
+  const Array& second = Array::Handle(Array::New(4, Heap::kOld));
+  EXPECT(thread->HasActiveOldTLAB());
+  // Consecutive small allocations are bump allocated from the same buffer.
+  EXPECT_EQ(RawObject::ToAddr(first.raw()) + first.raw()->HeapSize(),
+            RawObject::ToAddr(second.raw()));
+
+  // Collections drop the buffers and keep the heap walkable.
+  heap->CollectAllGarbage();
+  EXPECT(!thread->HasActiveOldTLAB());
+  EXPECT(first.Length() == 4);
+  EXPECT(second.Length() == 4);
+
+  const Array& third = Array::Handle(Array::New(4, Heap::kOld));
+  EXPECT(third.IsOld());
+  heap->old_space()->ReleaseTLAB(thread);
+  EXPECT(!thread->HasActiveOldTLAB());
+  heap->Verify();
+
+  FLAG_old_tlab_size = saved_old_tlab_size;
+}
+
+ISOLATE_UNIT_TEST_CASE(AdaptiveTLABSize) {
+  const int saved_grow_refills = FLAG_tlab_grow_refills;
+  FLAG_tlab_grow_refills = 2;
+  Heap* heap = thread->isolate()->heap();
+  const intptr_t saved_size = thread->tlab_size();
+  const intptr_t saved_refills = thread->tlab_refills();
+  thread->set_tlab_size(0);
+  const intptr_t min_size = Heap::kMinTLABSize;
+  thread->set_tlab_refills(0);
+
+  // A thread that keeps refilling gets larger TLABs, up to the maximum.
+  EXPECT_EQ(min_size, heap->NextTLABSize(thread));
+  EXPECT_EQ(2 * min_size, heap->NextTLABSize(thread));
+  EXPECT_EQ(2 * min_size, heap->NextTLABSize(thread));
+  EXPECT_EQ(4 * min_size, heap->NextTLABSize(thread));
+  for (intptr_t i = 0; i < 100; i++) {
+    EXPECT(heap->NextTLABSize(thread) <= heap->GetTLABSize());
+  }
+  EXPECT_EQ(heap->GetTLABSize(), thread->tlab_size());
+
+  // A scavenge only resets the refill count of a busy thread...
+  heap->AdjustTLABSize(thread);
+  EXPECT_EQ(0, thread->tlab_refills());
+  EXPECT_EQ(heap->GetTLABSize(), thread->tlab_size());
+  // ... but shrinks the TLAB of a thread that allocated nothing since.
+  heap->AdjustTLABSize(thread);
+  EXPECT_EQ(heap->GetTLABSize() / 2, thread->tlab_size());
+  for (intptr_t i = 0; i < 100; i++) {
+    heap->AdjustTLABSize(thread);
+  }
+  EXPECT_EQ(min_size, thread->tlab_size());
+
+  thread->set_tlab_size(saved_size);
+  thread->set_tlab_refills(saved_refills);
+  FLAG_tlab_grow_refills = saved_grow_refills;
+}
+
+ISOLATE_UNIT_TEST_CASE(PartialCompaction) {
+  const int saved_budget = FLAG_compaction_page_budget;
+  FLAG_compaction_page_budget = 2;
+  Heap* heap = thread->isolate()->heap();
+
+  // Interleave survivors with garbage so several pages end up fragmented.
+  const intptr_t kNumSurvivors = 256;
+  const Array& survivors = Array::Handle(Array::New(kNumSurvivors, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kNumSurvivors; i++) {
+    element = Array::New(64, Heap::kOld);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    survivors.SetAt(i, element);
+    Array::New(448, Heap::kOld);
+  }
+
+  heap->CollectGarbage(Heap::kMarkCompact, Heap::kFull);
+  heap->Verify();
+  for (intptr_t i = 0; i < kNumSurvivors; i++) {
+    element ^= survivors.At(i);
+    EXPECT_EQ(64, element.Length());
+    EXPECT(element.At(0) == Smi::New(i));
+  }
+
+  FLAG_compaction_page_budget = saved_budget;
+}
+
+ISOLATE_UNIT_TEST_CASE(LargeObjectsBypassNewSpace) {
+  // Too large for a regular old-space page: allocated in its own large page
+  // even when new space is requested.
+  const intptr_t kLength = (100 * KB) / kWordSize;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kNew));
+  EXPECT(array.IsOld());
+  const TypedData& data = TypedData::Handle(
+      TypedData::New(kTypedDataUint8ArrayCid, 100 * KB, Heap::kNew));
+  EXPECT(data.IsOld());
+
+  // Survives collections without moving.
+  const uword array_address = RawObject::ToAddr(array.raw());
+  thread->isolate()->heap()->CollectAllGarbage();
+  EXPECT_EQ(array_address, RawObject::ToAddr(array.raw()));
+}
+
+ISOLATE_UNIT_TEST_CASE(ConcurrentSweepLargePages) {
+  const bool saved_concurrent_sweep = FLAG_concurrent_sweep;
+  FLAG_concurrent_sweep = true;
+  Heap* heap = thread->isolate()->heap();
+  heap->CollectAllGarbage();
+  heap->WaitForSweeperTasks(thread);
+
+  const intptr_t kLength = (1 * MB) / kWordSize;
+  const Array& retained = Array::Handle(Array::New(kLength, Heap::kOld));
+  retained.SetAt(0, retained);
+  {
+    HANDLESCOPE(thread);
+    for (intptr_t i = 0; i < 8; i++) {
+      Array::Handle(Array::New(kLength, Heap::kOld));
+    }
+  }
+  const intptr_t capacity_before = heap->CapacityInWords(Heap::kOld);
+  heap->CollectAllGarbage();
+  heap->WaitForSweeperTasks(thread);
+
+  // The unreachable large pages were released by the sweeper.
+  EXPECT(heap->CapacityInWords(Heap::kOld) + 8 * kLength <= capacity_before);
+  EXPECT(retained.At(0) == retained.raw());
+  EXPECT(!retained.raw()->IsMarked());
+  heap->Verify();
+
+  FLAG_concurrent_sweep = saved_concurrent_sweep;
+}
+
+VM_UNIT_TEST_CASE(WeakTableShards) {
+  WeakTable table;
+  const intptr_t kNumKeys = 10000;
+  for (intptr_t i = 1; i <= kNumKeys; i++) {
+    RawObject* key = reinterpret_cast<RawObject*>(i * kObjectAlignment + 1);
+    table.SetValue(key, i);
+  }
+  EXPECT_EQ(kNumKeys, table.count());
+  // The entries are spread over all the shards.
+  for (intptr_t i = 0; i < WeakTable::kNumShards; i++) {
+    EXPECT(table.shard(i)->count() > 0);
+  }
+  for (intptr_t i = 1; i <= kNumKeys; i++) {
+    RawObject* key = reinterpret_cast<RawObject*>(i * kObjectAlignment + 1);
+    EXPECT_EQ(i, table.GetValue(key));
+    if ((i % 2) == 0) {
+      EXPECT_EQ(i, table.RemoveValue(key));
+    }
+  }
+  EXPECT_EQ(kNumKeys / 2, table.count());
+
+  WeakTable* copy = WeakTable::NewFrom(&table);
+  EXPECT_EQ(0, copy->count());
+  EXPECT(copy->size() >= kNumKeys / 2);
+  delete copy;
+}
+
+ISOLATE_UNIT_TEST_CASE(WeakTableEntriesSurviveParallelGC) {
+  const intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 2;
+  Heap* heap = thread->isolate()->heap();
+
+  const intptr_t kLength = 1000;
+  const Array& root = Array::Handle(Array::New(kLength, Heap::kNew));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(1, Heap::kNew);
+    heap->SetPeer(element.raw(), reinterpret_cast<void*>(i + 1));
+    root.SetAt(i, element);
+  }
+  for (intptr_t i = 0; i < kLength; i += 2) {
+    root.SetAt(i, Object::null_object());
+  }
+
+  // The first scavenge copies the survivors, the second one promotes them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT(root.raw()->IsOldObject());
+  EXPECT_EQ(kLength / 2, heap->PeerCount());
+
+  for (intptr_t i = 1; i < kLength; i += 4) {
+    root.SetAt(i, Object::null_object());
+  }
+  heap->CollectGarbage(Heap::kMarkCompact, Heap::kDebugging);
+  heap->WaitForSweeperTasks(thread);
+  EXPECT_EQ(kLength / 4, heap->PeerCount());
+  for (intptr_t i = 3; i < kLength; i += 4) {
+    element ^= root.At(i);
+    EXPECT_EQ(reinterpret_cast<void*>(i + 1), heap->GetPeer(element.raw()));
+  }
+
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
+ISOLATE_UNIT_TEST_CASE(CardMarkingOnRegularPages) {
+  Heap* heap = thread->isolate()->heap();
+
+  // Card marked, but small enough to share a regular page.
+  const intptr_t kLength = 2 * Array::kMaxNewSpaceElements;
+  EXPECT(Heap::IsAllocatableInNewSpace(Array::InstanceSize(kLength)));
+  const Array& first = Array::Handle(Array::New(kLength, Heap::kNew));
+  const Array& second = Array::Handle(Array::New(kLength, Heap::kNew));
+  EXPECT(first.IsOld());
+  EXPECT(first.raw()->IsCardRemembered());
+  EXPECT(second.IsOld());
+  EXPECT(second.raw()->IsCardRemembered());
+
+  String& str = String::Handle();
+  str = String::New("first", Heap::kNew);
+  first.SetAt(kLength - 1, str);
+  str = String::New("second", Heap::kNew);
+  second.SetAt(0, str);
+  str = String::null();
+
+  // The first scavenge copies the strings, the second one promotes them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  str ^= first.At(kLength - 1);
+  EXPECT(str.IsOld());
+  EXPECT(str.Equals("first"));
+  str ^= second.At(0);
+  EXPECT(str.IsOld());
+  EXPECT(str.Equals("second"));
+
+  // Compaction may move the arrays; their cards have to follow them.
+  str = String::New("moved", Heap::kNew);
+  first.SetAt(kLength / 2, str);
+  str = String::null();
+  heap->CollectGarbage(Heap::kMarkCompact, Heap::kDebugging);
+  heap->WaitForSweeperTasks(thread);
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  str ^= first.At(kLength / 2);
+  EXPECT(str.Equals("moved"));
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSamplerAttributesClasses) {
+  const intptr_t saved_period = FLAG_allocation_sample_period;
+  FLAG_allocation_sample_period = 4 * KB;
+  Heap* heap = thread->heap();
+  AllocationSampler* sampler = heap->allocation_sampler();
+  // Start counting from a fresh TLAB.
+  heap->AbandonRemainingTLAB(thread);
+  thread->set_allocation_sample_remaining(0);
+  sampler->Reset();
+
+  const intptr_t kNumObjects = 10000;
+  intptr_t allocated = 0;
+  {
+    HANDLESCOPE(thread);
+    Array& array = Array::Handle();
+    String& string = String::Handle();
+    for (intptr_t i = 0; i < kNumObjects; i++) {
+      array = Array::New(6);
+      string = OneByteString::New("abcdefghijklmnopqrstuvwxyz");
+      allocated += array.raw()->HeapSize() + string.raw()->HeapSize();
+    }
+  }
+
+  GrowableArray<AllocationSampler::Sample> samples;
+  sampler->GetSamples(&samples);
+  int64_t array_bytes = 0;
+  int64_t string_bytes = 0;
+  int64_t total_bytes = 0;
+  for (intptr_t i = 0; i < samples.length(); i++) {
+    if (samples[i].cid == kArrayCid) array_bytes += samples[i].bytes;
+    if (samples[i].cid == kOneByteStringCid) string_bytes += samples[i].bytes;
+    total_bytes += samples[i].bytes;
+  }
+  EXPECT(array_bytes > 0);
+  EXPECT(string_bytes > 0);
+  // The estimate is statistical; it should be well within a factor of two.
+  EXPECT(total_bytes > allocated / 2);
+  EXPECT(total_bytes < allocated * 2);
+
+  FLAG_allocation_sample_period = saved_period;
+  heap->AbandonRemainingTLAB(thread);
+  sampler->Reset();
+}
+
+VM_UNIT_TEST_CASE(MarkingWorkListSharesWithIdle) {
+  MarkingStack stack;
+  BlockWorkList<MarkingStack> busy(&stack);
+  for (intptr_t i = 1; i <= 10; i++) {
+    busy.Push(Smi::New(i));
+  }
+  // Nothing is shared while no consumer waits for work.
+  busy.ShareWork();
+  EXPECT(stack.IsEmptyRelaxed());
+
+  stack.EnterIdle();
+  busy.ShareWork();
+  stack.ExitIdle();
+  EXPECT(!stack.IsEmptyRelaxed());
+
+  // The idle consumer takes the shared half, the rest stays local.
+  BlockWorkList<MarkingStack> idle(&stack);
+  intptr_t taken = 0;
+  while (idle.Pop() != NULL) {
+    taken++;
+  }
+  EXPECT_EQ(5, taken);
+  EXPECT(stack.IsEmptyRelaxed());
+  intptr_t kept = 0;
+  while (busy.Pop() != NULL) {
+    kept++;
+  }
+  EXPECT_EQ(5, kept);
+  busy.Finalize();
+  idle.Finalize();
+}
+
 }  // namespace dart
@@ -8,6 +8,7 @@
 #include "vm/dart_api_state.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/pointer_block.h"
+#include "vm/heap/weak_table.h"
 #include "vm/isolate.h"
 #include "vm/log.h"
 #include "vm/object_id_ring.h"
@@ -21,64 +22,7 @@
 
 namespace dart {
 
-class MarkerWorkList : public ValueObject {
- public:
-  explicit MarkerWorkList(MarkingStack* marking_stack)
-      : marking_stack_(marking_stack) {
-    work_ = marking_stack_->PopEmptyBlock();
-  }
-
-  ~MarkerWorkList() {
-    ASSERT(work_ == NULL);
-    ASSERT(marking_stack_ == NULL);
-  }
-
-  // Returns NULL if no more work was found.
-  RawObject* Pop() {
-    ASSERT(work_ != NULL);
-    if (work_->IsEmpty()) {
-      // TODO(koda): Track over/underflow events and use in heuristics to
-      // distribute work and prevent degenerate flip-flopping.
-      MarkingStack::Block* new_work = marking_stack_->PopNonEmptyBlock();
-      if (new_work == NULL) {
-        return NULL;
-      }
-      marking_stack_->PushBlock(work_);
-      work_ = new_work;
-      // Generated code appends to marking stacks; tell MemorySanitizer.
-      MSAN_UNPOISON(work_, sizeof(*work_));
-    }
-    return work_->Pop();
-  }
-
-  void Push(RawObject* raw_obj) {
-    if (work_->IsFull()) {
-      // TODO(koda): Track over/underflow events and use in heuristics to
-      // distribute work and prevent degenerate flip-flopping.
-      marking_stack_->PushBlock(work_);
-      work_ = marking_stack_->PopEmptyBlock();
-    }
-    work_->Push(raw_obj);
-  }
-
-  void Finalize() {
-    ASSERT(work_->IsEmpty());
-    marking_stack_->PushBlock(work_);
-    work_ = NULL;
-    // Fail fast on attempts to mark after finalizing.
-    marking_stack_ = NULL;
-  }
-
-  void AbandonWork() {
-    marking_stack_->PushBlock(work_);
-    work_ = NULL;
-    marking_stack_ = NULL;
-  }
-
- private:
-  MarkingStack::Block* work_;
-  MarkingStack* marking_stack_;
-};
+typedef BlockWorkList<MarkingStack> MarkerWorkList;
 
 template <bool sync>
 class MarkingVisitorBase : public ObjectPointerVisitor {
@@ -179,6 +123,11 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         marked_bytes_ += size;
         NOT_IN_PRODUCT(UpdateLiveOld(class_id, size));
 
+        if (sync) {
+          // Feed markers which ran out of work, e.g. while this one is
+          // in a large object graph.
+          work_list_.ShareWork();
+        }
         raw_obj = work_list_.Pop();
       } while (raw_obj != NULL);
 
@@ -444,13 +393,56 @@ void GCMarker::Epilogue() {
 
 enum RootSlices {
   kIsolate = 0,
-  kNewSpace = 1,
-  kNumRootSlices = 2,
+  kNewSpace = 1,  // First of num_new_space_slices_ slices.
 };
 
+// Aim for a few new-space slices per marker task, but avoid tiny ones.
+static const intptr_t kNewSpaceSlicesPerTask = 4;
+static const intptr_t kMinNewSpaceSliceSize = 64 * KB;
+
 void GCMarker::ResetRootSlices() {
-  root_slices_not_started_ = kNumRootSlices;
-  root_slices_not_finished_ = kNumRootSlices;
+  Scavenger* new_space = heap_->new_space();
+  new_space->MakeNewSpaceIterable();
+  if ((new_space_boundaries_collections_ == new_space->collections()) &&
+      (new_space_boundaries_.length() >= 2)) {
+    // No scavenge happened since the boundaries were recorded by the last
+    // root marking (normally during StartConcurrentMark), so the new-space
+    // root scan can be split among the marker tasks. Objects allocated since
+    // then are part of the last slice.
+    num_new_space_slices_ = new_space_boundaries_.length() - 1;
+    new_space_end_ = new_space->top();
+  } else {
+    new_space_boundaries_.Clear();
+    new_space_boundaries_collections_ = -1;
+    num_new_space_slices_ = 1;
+    new_space_end_ = 0;
+  }
+  root_slices_not_started_ = kNewSpace + num_new_space_slices_;
+  root_slices_not_finished_ = kNewSpace + num_new_space_slices_;
+}
+
+void GCMarker::IterateNewSpaceSlice(ObjectPointerVisitor* visitor,
+                                    intptr_t slice) {
+  Scavenger* new_space = heap_->new_space();
+  if (new_space_end_ == 0) {
+    // Single slice: visit everything and record boundaries for splitting the
+    // next root scan, which is normally the one finalizing this marking.
+    ASSERT(slice == 0);
+    const intptr_t tasks = Utils::Maximum<intptr_t>(1, FLAG_marker_tasks);
+    const intptr_t interval = Utils::Maximum<intptr_t>(
+        kMinNewSpaceSliceSize,
+        (new_space->UsedInWords() << kWordSizeLog2) /
+            (tasks * kNewSpaceSlicesPerTask));
+    new_space->VisitObjectPointersRecordingBoundaries(visitor, interval,
+                                                      &new_space_boundaries_);
+    new_space_boundaries_collections_ = new_space->collections();
+    return;
+  }
+  const uword start = new_space_boundaries_[slice];
+  const uword end = (slice == num_new_space_slices_ - 1)
+                        ? new_space_end_
+                        : new_space_boundaries_[slice + 1];
+  new_space->VisitObjectPointers(visitor, start, end);
 }
 
 void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
@@ -461,21 +453,14 @@ void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
       return;  // No more tasks.
     }
 
-    switch (task) {
-      case kIsolate: {
-        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRoots");
-        isolate_->VisitObjectPointers(visitor,
-                                      ValidationPolicy::kDontValidateFrames);
-        break;
-      }
-      case kNewSpace: {
-        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessNewSpace");
-        heap_->new_space()->VisitObjectPointers(visitor);
-        break;
-      }
-      default:
-        FATAL1("%" Pd, task);
-        UNREACHABLE();
+    if (task == kIsolate) {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRoots");
+      isolate_->VisitObjectPointers(visitor,
+                                    ValidationPolicy::kDontValidateFrames);
+    } else {
+      ASSERT(task < kNewSpace + num_new_space_slices_);
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessNewSpace");
+      IterateNewSpaceSlice(visitor, task - kNewSpace);
     }
 
     intptr_t remaining =
@@ -494,10 +479,18 @@ void GCMarker::IterateWeakRoots(HandleVisitor* visitor) {
   isolate_->VisitWeakPersistentHandles(visitor);
 }
 
-void GCMarker::ProcessWeakTables(PageSpace* page_space) {
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
+void GCMarker::ProcessWeakTables() {
+  const intptr_t num_shards = Heap::kNumWeakSelectors * WeakTable::kNumShards;
+  while (true) {
+    const intptr_t index =
+        AtomicOperations::FetchAndIncrement(&weak_table_shards_started_);
+    if (index >= num_shards) {
+      break;
+    }
+    WeakTable* weak_table = heap_->GetWeakTable(
+        Heap::kOld,
+        static_cast<Heap::WeakSelector>(index / WeakTable::kNumShards));
+    WeakTableShard* table = weak_table->shard(index % WeakTable::kNumShards);
     intptr_t size = table->size();
     for (intptr_t i = 0; i < size; i++) {
       if (table->IsValidEntryAt(i)) {
@@ -577,12 +570,15 @@ class ParallelMarkTask : public ThreadPool::Task {
           // then there will never be more work (NB: 1 is *before* decrement).
           if (AtomicOperations::FetchAndDecrement(num_busy_) == 1) break;
 
-          // Wait for some work to appear.
+          // Wait for some work to appear, asking busy markers to share theirs.
+          // Polls without the stack's lock to not slow down the busy markers.
           // TODO(iposva): Replace busy-waiting with a solution using Monitor,
           // and redraw the boundaries between stack/visitor/task as needed.
-          while (marking_stack_->IsEmpty() &&
+          marking_stack_->EnterIdle();
+          while (marking_stack_->IsEmptyRelaxed() &&
                  AtomicOperations::LoadRelaxed(num_busy_) > 0) {
           }
+          marking_stack_->ExitIdle();
 
           // If no tasks are busy, there will never be more work.
           if (AtomicOperations::LoadRelaxed(num_busy_) == 0) break;
@@ -626,6 +622,9 @@ class ParallelMarkTask : public ThreadPool::Task {
       // Phase 2: Weak processing and follow-up marking on main thread.
       barrier_->Sync();
 
+      // Phase 2b: The weak tables are processed by all markers.
+      marker_->ProcessWeakTables();
+
       // Phase 3: Finalize results from all markers (detach code, etc.).
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
@@ -759,6 +758,10 @@ GCMarker::GCMarker(Isolate* isolate, Heap* heap)
       heap_(heap),
       marking_stack_(),
       visitors_(),
+      num_new_space_slices_(0),
+      new_space_end_(0),
+      new_space_boundaries_collections_(-1),
+      weak_table_shards_started_(0),
       marked_bytes_(0),
       marked_micros_(0) {
   visitors_ = new SyncMarkingVisitor*[FLAG_marker_tasks];
@@ -782,6 +785,13 @@ GCMarker::~GCMarker() {
 
 void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   isolate_->EnableIncrementalBarrier(&marking_stack_, &deferred_marking_stack_);
+  // Objects which optimized code stores into without a barrier are old and
+  // unmarked from now on; have them rescanned when marking finishes.
+  Thread* mutator_thread = isolate_->mutator_thread();
+  if (mutator_thread != NULL) {
+    mutator_thread->RestoreWriteBarrierInvariant(
+        Thread::kAddToDeferredMarkingStack);
+  }
 
   const intptr_t num_tasks = FLAG_marker_tasks;
 
@@ -894,11 +904,12 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
         IterateWeakRoots(&mark_weak);
       }
       barrier.Sync();
+      ProcessWeakTables();
 
       // Phase 3: Finalize results from all markers (detach code, etc.).
       barrier.Exit();
     }
-    ProcessWeakTables(page_space);
+    ProcessWeakTables();
     ProcessObjectIdTable();
   }
   Epilogue();
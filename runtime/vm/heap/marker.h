@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_HEAP_MARKER_H_
 #define RUNTIME_VM_HEAP_MARKER_H_
 
+#include "platform/growable_array.h"
 #include "vm/allocation.h"
 #include "vm/heap/pointer_block.h"
 #include "vm/os_thread.h"  // Mutex.
@@ -49,10 +50,13 @@ class GCMarker {
   void Epilogue();
   void ResetRootSlices();
   void IterateRoots(ObjectPointerVisitor* visitor);
+  void IterateNewSpaceSlice(ObjectPointerVisitor* visitor, intptr_t slice);
   void IterateWeakRoots(HandleVisitor* visitor);
   template <class MarkingVisitorType>
   void IterateWeakReferences(MarkingVisitorType* visitor);
-  void ProcessWeakTables(PageSpace* page_space);
+  // Claims and processes shards of the old-space weak tables until none are
+  // left. Called by all the marker tasks once marking is complete.
+  void ProcessWeakTables();
   void ProcessObjectIdTable();
 
   // Called by anyone: finalize and accumulate stats from 'visitor'.
@@ -69,6 +73,17 @@ class GCMarker {
   intptr_t root_slices_not_started_;
   intptr_t root_slices_not_finished_;
 
+  // New space is scanned as roots both when marking starts and when it is
+  // finalized. The first scan records object boundaries in to-space so that,
+  // if no scavenge happens in between, the second one can be split into
+  // slices which are processed in parallel.
+  intptr_t num_new_space_slices_;
+  uword new_space_end_;  // End of the last slice, or 0 for a single slice.
+  MallocGrowableArray<uword> new_space_boundaries_;
+  intptr_t new_space_boundaries_collections_;
+
+  intptr_t weak_table_shards_started_;
+
   Mutex stats_mutex_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
@@ -0,0 +1,63 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/memory_limit.h"
+
+#include <stdio.h>   // NOLINT
+#include <stdlib.h>  // NOLINT
+
+#include "platform/assert.h"
+
+namespace dart {
+
+bool MemoryLimit::ParseValue(const char* text, int64_t* value) {
+  char* end = NULL;
+  const long long parsed = strtoll(text, &end, 10);  // NOLINT
+  if (end == text || parsed <= 0) {
+    // Includes "max", which cgroup v2 uses for an unlimited group.
+    return false;
+  }
+  // cgroup v1 reports an unlimited group as the largest page-aligned value.
+  if (parsed >= (kMaxInt64 / 2)) {
+    return false;
+  }
+  *value = static_cast<int64_t>(parsed);
+  return true;
+}
+
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+
+static bool ReadValue(const char* path, int64_t* value) {
+  // Files under /sys do not report a valid size, so read a bounded prefix.
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) {
+    return false;
+  }
+  char buffer[64];
+  const size_t n = fread(buffer, 1, sizeof(buffer) - 1, fp);
+  fclose(fp);
+  buffer[n] = '\0';
+  return MemoryLimit::ParseValue(buffer, value);
+}
+
+bool MemoryLimit::GetLimitAndUsage(int64_t* limit, int64_t* usage) {
+  // Inside a container the process' own group is mounted at the root.
+  if (ReadValue("/sys/fs/cgroup/memory.max", limit)) {
+    return ReadValue("/sys/fs/cgroup/memory.current", usage);
+  }
+  if (ReadValue("/sys/fs/cgroup/memory/memory.limit_in_bytes", limit)) {
+    return ReadValue("/sys/fs/cgroup/memory/memory.usage_in_bytes", usage);
+  }
+  return false;
+}
+
+#else
+
+bool MemoryLimit::GetLimitAndUsage(int64_t* limit, int64_t* usage) {
+  return false;
+}
+
+#endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+
+}  // namespace dart
@@ -0,0 +1,30 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_MEMORY_LIMIT_H_
+#define RUNTIME_VM_HEAP_MEMORY_LIMIT_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Reads the memory limit imposed on the process by its control group, e.g.
+// when running inside a container. Both the unified (v2) and the legacy (v1)
+// memory controller hierarchies are supported.
+class MemoryLimit : public AllStatic {
+ public:
+  // Returns false if no limit applies or it cannot be read (including on
+  // platforms without cgroups). Otherwise returns the limit and the current
+  // usage of the control group in bytes.
+  static bool GetLimitAndUsage(int64_t* limit, int64_t* usage);
+
+  // Parses the contents of a cgroup memory file. Returns false for "max"
+  // and for values too large to be a real limit.
+  static bool ParseValue(const char* text, int64_t* value);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_MEMORY_LIMIT_H_
@@ -9,6 +9,7 @@
 #include "vm/heap/become.h"
 #include "vm/heap/compactor.h"
 #include "vm/heap/marker.h"
+#include "vm/heap/memory_limit.h"
 #include "vm/heap/safepoint.h"
 #include "vm/heap/sweeper.h"
 #include "vm/lockers.h"
@@ -16,6 +17,7 @@
 #include "vm/object.h"
 #include "vm/object_set.h"
 #include "vm/os_thread.h"
+#include "vm/thread_registry.h"
 #include "vm/virtual_memory.h"
 
 namespace dart {
@@ -40,7 +42,34 @@ DEFINE_FLAG(bool,
             print_free_list_after_gc,
             false,
             "Print free list statistics after a GC");
+DEFINE_FLAG(int,
+            memory_pressure_threshold,
+            0,
+            "Percentage of the process' cgroup memory limit above which old "
+            "gen growth is restricted, collections compact and free memory "
+            "is released (0 disables).");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(int,
+            compaction_page_budget,
+            0,
+            "Limit each compaction to this many of the most fragmented pages "
+            "and sweep the rest (0 compacts all pages).");
+DEFINE_FLAG(int,
+            compaction_fragmentation_threshold,
+            25,
+            "Pages with at least this percentage of free space are candidates "
+            "for --compaction_page_budget.");
+DEFINE_FLAG(int,
+            old_tlab_size,
+            0,
+            "Size in KB of the thread-local old-space allocation buffers "
+            "(0 disables).");
+DEFINE_FLAG(int,
+            idle_release_delay,
+            1000,
+            "Milliseconds after an old-space collection before idle "
+            "notifications return free old-space memory to the OS "
+            "(negative disables).");
 
 HeapPage* HeapPage::Allocate(intptr_t size_in_words,
                              PageType type,
@@ -51,8 +80,11 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   bool executable = type == kExecutable;
 #endif
 
-  VirtualMemory* memory = VirtualMemory::AllocateAligned(
-      size_in_words << kWordSizeLog2, kPageSize, executable, name);
+  const intptr_t size_in_bytes = size_in_words << kWordSizeLog2;
+  VirtualMemory* memory =
+      executable ? VirtualMemory::AllocateAligned(size_in_bytes, kPageSize,
+                                                  executable, name)
+                 : VirtualMemory::AllocateHeap(size_in_bytes, kPageSize, name);
   if (memory == NULL) {
     return NULL;
   }
@@ -64,6 +96,7 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   result->used_in_bytes_ = 0;
   result->forwarding_page_ = NULL;
   result->card_table_ = NULL;
+  result->card_owners_ = NULL;
   result->type_ = type;
 
   LSAN_REGISTER_ROOT_REGION(result, sizeof(*result));
@@ -74,10 +107,7 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
 void HeapPage::Deallocate() {
   ASSERT(forwarding_page_ == NULL);
 
-  if (card_table_ != NULL) {
-    free(card_table_);
-    card_table_ = NULL;
-  }
+  ResetCardTable();
 
   bool image_page = is_image_page();
 
@@ -97,7 +127,8 @@ void HeapPage::Deallocate() {
 }
 
 void HeapPage::VisitObjects(ObjectVisitor* visitor) const {
-  ASSERT(Thread::Current()->IsAtSafepoint());
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kBecomeTask));
   NoSafepointScope no_safepoint;
   uword obj_addr = object_start();
   uword end_addr = object_end();
@@ -123,63 +154,165 @@ void HeapPage::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
 }
 
 void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
-  ASSERT(Thread::Current()->IsAtSafepoint());
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kScavengerTask));
   NoSafepointScope no_safepoint;
 
   if (card_table_ == NULL) {
     return;
   }
+  ASSERT(card_owners_ != NULL);
 
-  bool table_is_empty = false;
-
-  RawArray* obj = static_cast<RawArray*>(RawObject::FromAddr(object_start()));
-  ASSERT(obj->IsArray());
-  ASSERT(obj->IsCardRemembered());
-  RawObject** obj_from = obj->from();
-  RawObject** obj_to = obj->to(Smi::Value(obj->ptr()->length_));
+  bool table_is_empty = true;
 
   const intptr_t size = card_table_size();
   for (intptr_t i = 0; i < size; i++) {
-    if (card_table_[i] != 0) {
-      RawObject** card_from =
-          reinterpret_cast<RawObject**>(this) + (i << kSlotsPerCardLog2);
-      RawObject** card_to = reinterpret_cast<RawObject**>(card_from) +
-                            (1 << kSlotsPerCardLog2) - 1;
-      // Minus 1 because to is inclusive.
-
+    if (card_table_[i] == 0) {
+      continue;
+    }
+    RawObject** card_start =
+        reinterpret_cast<RawObject**>(this) + (i << kSlotsPerCardLog2);
+    // Minus 1 because to is inclusive.
+    RawObject** card_end = card_start + (1 << kSlotsPerCardLog2) - 1;
+
+    bool has_new_target = false;
+    for (intptr_t j = 0; j < kOwnersPerCard; j++) {
+      RawArray* obj = CardOwnerAt(i * kOwnersPerCard + j);
+      if (obj == Array::null()) {
+        continue;
+      }
+      RawObject** card_from = card_start;
+      RawObject** card_to = card_end;
+      RawObject** obj_from = obj->from();
+      RawObject** obj_to = obj->to(Smi::Value(obj->ptr()->length_));
       if (card_from < obj_from) {
-        // First card overlaps with header.
+        // Card overlaps with the header or with the preceding object.
         card_from = obj_from;
       }
       if (card_to > obj_to) {
-        // Last card(s) may extend past the object. Array truncation can make
-        // this happen for more than one card.
+        // Card may extend past the object. Array truncation can make this
+        // happen for more than one card.
         card_to = obj_to;
       }
 
       visitor->VisitPointers(card_from, card_to);
 
-      bool has_new_target = false;
       for (RawObject** slot = card_from; slot <= card_to; slot++) {
         if ((*slot)->IsNewObjectMayBeSmi()) {
           has_new_target = true;
           break;
         }
       }
+    }
+
+    if (has_new_target) {
+      // Card remains remembered.
+      table_is_empty = false;
+    } else {
+      card_table_[i] = 0;
+    }
+  }
+
+  if (table_is_empty) {
+    // Keep the owners, the arrays are still card marked.
+    free(card_table_);
+    card_table_ = NULL;
+  }
+}
+
+RawArray* HeapPage::CardOwnerAt(intptr_t index) const {
+  ASSERT((index >= 0) && (index < card_owners_size()));
+  const uint16_t entry = card_owners_[index];
+  if (entry == 0) {
+    return Array::null();
+  }
+  const uword addr = reinterpret_cast<uword>(this) +
+                     ((entry - 1) << kObjectAlignmentLog2);
+  RawObject* obj = RawObject::FromAddr(addr);
+  // Become may have replaced the array since it was registered.
+  if (!obj->IsArray() || !obj->IsCardRemembered()) {
+    return Array::null();
+  }
+  return static_cast<RawArray*>(obj);
+}
+
+uint16_t HeapPage::CardOwnerEntry(RawObject* array) const {
+  const uword offset =
+      RawObject::ToAddr(array) - reinterpret_cast<uword>(this);
+  ASSERT(Utils::IsAligned(offset, kObjectAlignment));
+  ASSERT((offset >> kObjectAlignmentLog2) < kMaxUint16);
+  return static_cast<uint16_t>((offset >> kObjectAlignmentLog2) + 1);
+}
+
+void HeapPage::RegisterCardArray(RawObject* array, bool remember) {
+  ASSERT(array->IsArray());
+  ASSERT(array->IsCardRemembered());
+  ASSERT(Contains(RawObject::ToAddr(array)));
+  if (card_owners_ == NULL) {
+    card_owners_ = reinterpret_cast<uint16_t*>(
+        calloc(card_owners_size(), sizeof(uint16_t)));
+  }
+  const uword page_start = reinterpret_cast<uword>(this);
+  const uword start = RawObject::ToAddr(array) - page_start;
+  const uword end = start + array->HeapSize();
+  const intptr_t first_card = start >> kBytesPerCardLog2;
+  const intptr_t last_card = (end - 1) >> kBytesPerCardLog2;
+  ASSERT(last_card > first_card);
+  ASSERT(last_card < card_table_size());
+  const uint16_t entry = CardOwnerEntry(array);
+  if ((start & ((1 << kBytesPerCardLog2) - 1)) == 0) {
+    card_owners_[first_card * kOwnersPerCard] = entry;
+  } else {
+    card_owners_[first_card * kOwnersPerCard + 1] = entry;
+  }
+  for (intptr_t i = first_card + 1; i <= last_card; i++) {
+    card_owners_[i * kOwnersPerCard] = entry;
+  }
+  if (remember) {
+    for (intptr_t i = first_card; i <= last_card; i++) {
+      RememberCard(reinterpret_cast<RawObject* const*>(
+          page_start + (i << kBytesPerCardLog2)));
+    }
+  }
+}
 
-      if (has_new_target) {
-        // Card remains remembered.
-        table_is_empty = false;
+void HeapPage::ForgetUnmarkedCardArrays() {
+  if (card_owners_ == NULL) {
+    return;
+  }
+  bool owners_are_empty = true;
+  const intptr_t size = card_table_size();
+  for (intptr_t i = 0; i < size; i++) {
+    bool card_has_owner = false;
+    for (intptr_t j = 0; j < kOwnersPerCard; j++) {
+      const intptr_t index = i * kOwnersPerCard + j;
+      RawArray* obj = CardOwnerAt(index);
+      if ((obj == Array::null()) || !obj->IsMarked()) {
+        card_owners_[index] = 0;
       } else {
-        card_table_[i] = 0;
+        card_has_owner = true;
       }
     }
+    if (card_has_owner) {
+      owners_are_empty = false;
+    } else if (card_table_ != NULL) {
+      card_table_[i] = 0;
+    }
+  }
+  if (owners_are_empty) {
+    ResetCardTable();
   }
+}
 
-  if (table_is_empty) {
+void HeapPage::ResetCardTable() {
+  if (card_table_ != NULL) {
     free(card_table_);
     card_table_ = NULL;
   }
+  if (card_owners_ != NULL) {
+    free(card_owners_);
+    card_owners_ = NULL;
+  }
 }
 
 RawObject* HeapPage::FindObject(FindObjectVisitor* visitor) const {
@@ -203,9 +336,13 @@ RawObject* HeapPage::FindObject(FindObjectVisitor* visitor) const {
 void HeapPage::WriteProtect(bool read_only) {
   ASSERT(!is_image_page());
 
+  if ((type_ == kExecutable) && (memory_->AliasOffset() != 0)) {
+    return;  // The views of dual mapped code keep their protections.
+  }
+
   VirtualMemory::Protection prot;
   if (read_only) {
-    if ((type_ == kExecutable) && (memory_->AliasOffset() == 0)) {
+    if (type_ == kExecutable) {
       prot = VirtualMemory::kReadExecute;
     } else {
       prot = VirtualMemory::kReadOnly;
@@ -231,6 +368,7 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       exec_pages_(NULL),
       exec_pages_tail_(NULL),
       large_pages_(NULL),
+      large_pages_tail_(NULL),
       image_pages_(NULL),
       bump_top_(0),
       bump_end_(0),
@@ -250,7 +388,9 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
                              FLAG_old_gen_growth_time_ratio),
       marker_(NULL),
       gc_time_micros_(0),
+      last_gc_end_micros_(0),
       collections_(0),
+      released_free_memory_(false),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
       enable_concurrent_mark_(FLAG_concurrent_mark) {
   // We aren't holding the lock but no one can reference us yet.
@@ -317,11 +457,11 @@ HeapPage* PageSpace::AllocatePage(HeapPage::PageType type, bool link) {
       if (exec_pages_ == NULL) {
         exec_pages_ = page;
       } else {
-        if (FLAG_write_protect_code) {
+        if (CodeProtectedInPlace()) {
           exec_pages_tail_->WriteProtect(false);
         }
         exec_pages_tail_->set_next(page);
-        if (FLAG_write_protect_code) {
+        if (CodeProtectedInPlace()) {
           exec_pages_tail_->WriteProtect(true);
         }
       }
@@ -352,8 +492,26 @@ HeapPage* PageSpace::AllocateLargePage(intptr_t size, HeapPage::PageType type) {
     IncreaseCapacityInWords(-page_size_in_words);
     return NULL;
   }
-  page->set_next(large_pages_);
-  large_pages_ = page;
+  {
+    // Append, so a concurrent sweeper never has to look for the predecessor
+    // of a page it frees.
+    MutexLocker ml(pages_lock_);
+    if (large_pages_ == NULL) {
+      large_pages_ = page;
+    } else {
+      const bool is_exec_tail =
+          CodeProtectedInPlace() &&
+          (large_pages_tail_->type() == HeapPage::kExecutable);
+      if (is_exec_tail) {
+        large_pages_tail_->WriteProtect(false);
+      }
+      large_pages_tail_->set_next(page);
+      if (is_exec_tail) {
+        large_pages_tail_->WriteProtect(true);
+      }
+    }
+    large_pages_tail_ = page;
+  }
   // Only one object in this page (at least until String::MakeExternal or
   // Array::MakeFixedLength is called).
   page->set_object_end(page->object_start() + size);
@@ -408,12 +566,18 @@ void PageSpace::FreePage(HeapPage* page, HeapPage* previous_page) {
 }
 
 void PageSpace::FreeLargePage(HeapPage* page, HeapPage* previous_page) {
-  IncreaseCapacityInWords(-(page->memory_->size() >> kWordSizeLog2));
-  // Remove the page from the list.
-  if (previous_page != NULL) {
-    previous_page->set_next(page->next());
-  } else {
-    large_pages_ = page->next();
+  {
+    MutexLocker ml(pages_lock_);
+    IncreaseCapacityInWordsLocked(-(page->memory_->size() >> kWordSizeLog2));
+    // Remove the page from the list.
+    if (previous_page != NULL) {
+      previous_page->set_next(page->next());
+    } else {
+      large_pages_ = page->next();
+    }
+    if (page == large_pages_tail_) {
+      large_pages_tail_ = previous_page;
+    }
   }
   page->Deallocate();
 }
@@ -652,6 +816,7 @@ void PageSpace::MakeIterable() const {
   if (bump_top_ < bump_end_) {
     FreeListElement::AsElement(bump_top_, bump_end_ - bump_top_);
   }
+  MakeTLABsIterable();
 }
 
 void PageSpace::AbandonBumpAllocation() {
@@ -662,6 +827,98 @@ void PageSpace::AbandonBumpAllocation() {
   }
 }
 
+uword PageSpace::TryAllocateInTLAB(Thread* thread, intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  const intptr_t tlab_size = FLAG_old_tlab_size * KB;
+  // Large objects would waste most of a chunk.
+  if ((tlab_size == 0) || (size > (tlab_size >> 2))) {
+    return 0;
+  }
+  uword top = thread->old_top();
+  if ((thread->old_end() - top) < static_cast<uword>(size)) {
+    ReleaseTLAB(thread);
+    uword chunk = freelist_[HeapPage::kData].TryAllocate(tlab_size, false);
+    if (chunk == 0) {
+      chunk = TryAllocateInFreshPage(tlab_size, HeapPage::kData,
+                                     kControlGrowth, false /* is_locked */);
+      if (chunk == 0) {
+        return 0;
+      }
+      // usage_ is updated by the call above.
+    } else {
+      AtomicOperations::IncrementBy(&(usage_.used_in_words),
+                                    (tlab_size >> kWordSizeLog2));
+    }
+    top = chunk;
+    thread->set_old_end(chunk + tlab_size);
+  }
+  thread->set_old_top(top + size);
+  ASSERT((top & kObjectAlignmentMask) == kOldObjectAlignmentOffset);
+  return top;
+}
+
+static void MakeTLABIterable(Thread* thread) {
+  if (thread->old_top() < thread->old_end()) {
+    FreeListElement::AsElement(thread->old_top(),
+                               thread->old_end() - thread->old_top());
+  }
+}
+
+void PageSpace::MakeTLABsIterable() const {
+  if (FLAG_old_tlab_size == 0) {
+    return;
+  }
+  Isolate* isolate = heap_->isolate();
+  MonitorLocker ml(isolate->threads_lock(), false);
+  for (Thread* current = isolate->thread_registry()->active_list();
+       current != NULL; current = current->next()) {
+    MakeTLABIterable(current);
+  }
+  Thread* mutator_thread = isolate->mutator_thread();
+  if (mutator_thread != NULL) {
+    MakeTLABIterable(mutator_thread);
+  }
+}
+
+void PageSpace::AbandonTLAB(Thread* thread) {
+  const intptr_t remaining = thread->old_end() - thread->old_top();
+  if (remaining > 0) {
+    // The unmarked remainder is freed by the sweeper or the compactor.
+    FreeListElement::AsElement(thread->old_top(), remaining);
+    usage_.used_in_words -= (remaining >> kWordSizeLog2);
+  }
+  thread->set_old_top(0);
+  thread->set_old_end(0);
+}
+
+void PageSpace::AbandonTLABs() {
+  if (FLAG_old_tlab_size == 0) {
+    return;
+  }
+  ASSERT(Thread::Current()->IsAtSafepoint());
+  Isolate* isolate = heap_->isolate();
+  MonitorLocker ml(isolate->threads_lock(), false);
+  for (Thread* current = isolate->thread_registry()->active_list();
+       current != NULL; current = current->next()) {
+    AbandonTLAB(current);
+  }
+  Thread* mutator_thread = isolate->mutator_thread();
+  if (mutator_thread != NULL) {
+    AbandonTLAB(mutator_thread);
+  }
+}
+
+void PageSpace::ReleaseTLAB(Thread* thread) {
+  const intptr_t remaining = thread->old_end() - thread->old_top();
+  if (remaining > 0) {
+    freelist_[HeapPage::kData].Free(thread->old_top(), remaining);
+    AtomicOperations::IncrementBy(&(usage_.used_in_words),
+                                  -(remaining >> kWordSizeLog2));
+  }
+  thread->set_old_top(0);
+  thread->set_old_end(0);
+}
+
 void PageSpace::AbandonMarkingForShutdown() {
   delete marker_;
   marker_ = NULL;
@@ -750,6 +1007,12 @@ void PageSpace::VisitObjects(ObjectVisitor* visitor) const {
   }
 }
 
+void PageSpace::CollectPages(GrowableArray<HeapPage*>* pages) const {
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    pages->Add(it.page());
+  }
+}
+
 void PageSpace::VisitObjectsNoImagePages(ObjectVisitor* visitor) const {
   for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
     if (!it.page()->is_image_page()) {
@@ -773,8 +1036,30 @@ void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
 }
 
 void PageSpace::VisitRememberedCards(ObjectPointerVisitor* visitor) const {
+  // The concurrent sweeper may unlink pages while we visit, so collect the
+  // pages with remembered cards first. Pages holding a card marked array
+  // that survived the last marking are never freed by the sweeper.
+  MallocGrowableArray<HeapPage*> pages;
+  {
+    MutexLocker ml(pages_lock_);
+    for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+      if (page->has_card_table()) pages.Add(page);
+    }
+    for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+      if (page->has_card_table()) pages.Add(page);
+    }
+  }
+  for (intptr_t i = 0; i < pages.length(); i++) {
+    pages[i]->VisitRememberedCards(visitor);
+  }
+}
+
+void PageSpace::ForgetUnmarkedCardArrays() {
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    page->ForgetUnmarkedCardArrays();
+  }
   for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
-    page->VisitRememberedCards(visitor);
+    page->ForgetUnmarkedCardArrays();
   }
 }
 
@@ -908,7 +1193,7 @@ void PageSpace::PrintHeapMapToJSONStream(Isolate* isolate,
 #endif  // PRODUCT
 
 void PageSpace::WriteProtectCode(bool read_only) {
-  if (FLAG_write_protect_code) {
+  if (CodeProtectedInPlace()) {
     MutexLocker ml(pages_lock_);
     NoSafepointScope no_safepoint;
     // No need to go through all of the data pages first.
@@ -1054,6 +1339,7 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   const int64_t start = OS::GetCurrentMonotonicMicros();
 
   // Perform various cleanup that relies on no tasks interfering.
+  AbandonTLABs();
   isolate->class_table()->FreeOldTables();
 
   NoSafepointScope no_safepoints;
@@ -1099,6 +1385,9 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   delete marker_;
   marker_ = NULL;
 
+  // Must happen while the mark bits are still valid.
+  ForgetUnmarkedCardArrays();
+
   int64_t mid1 = OS::GetCurrentMonotonicMicros();
 
   // Abandon the remainder of the bump allocation block.
@@ -1125,9 +1414,12 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
     MutexLocker mld(freelist_[HeapPage::kData].mutex());
     MutexLocker mle(freelist_[HeapPage::kExecutable].mutex());
 
-    // Large and executable pages are always swept immediately.
+    // Large and executable pages are swept immediately unless the concurrent
+    // sweeper can take them along with the data pages.
+    const bool sweep_concurrently =
+        !compact && FLAG_concurrent_sweep && CanSweepCodeConcurrently();
     HeapPage* prev_page = NULL;
-    HeapPage* page = large_pages_;
+    HeapPage* page = sweep_concurrently ? NULL : large_pages_;
     while (page != NULL) {
       HeapPage* next_page = page->next();
       const intptr_t words_to_end = sweeper.SweepLargePage(page);
@@ -1142,7 +1434,7 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
     }
 
     prev_page = NULL;
-    page = exec_pages_;
+    page = sweep_concurrently ? NULL : exec_pages_;
     FreeList* freelist = &freelist_[HeapPage::kExecutable];
     while (page != NULL) {
       HeapPage* next_page = page->next();
@@ -1163,6 +1455,9 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
     Compact(thread);
     set_phase(kDone);
   } else if (FLAG_concurrent_sweep) {
+    // The sweeper toggles the protection of the code pages it sweeps, so
+    // they have to be read-only again before it starts.
+    WriteProtectCode(true);
     ConcurrentSweep(isolate);
   } else {
     BlockingSweep();
@@ -1170,7 +1465,7 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   }
 
   // Make code pages read-only.
-  if (finalize) WriteProtectCode(true);
+  if (compact || !FLAG_concurrent_sweep) WriteProtectCode(true);
 
   int64_t end = OS::GetCurrentMonotonicMicros();
 
@@ -1178,6 +1473,14 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   page_space_controller_.EvaluateGarbageCollection(
       usage_before, GetCurrentUsage(), start, end);
 
+  heap_->RecordPause(Heap::kMarkPause, mid1 - start);
+  if (compact) {
+    heap_->RecordPause(Heap::kSweepPause, mid3 - mid2);
+    heap_->RecordPause(Heap::kCompactPause, end - mid3);
+  } else {
+    heap_->RecordPause(Heap::kSweepPause, end - mid2);
+  }
+
   heap_->RecordTime(kConcurrentSweep, pre_safe_point - pre_wait_for_sweepers);
   heap_->RecordTime(kSafePoint, start - pre_safe_point);
   heap_->RecordTime(kMarkObjects, mid1 - start);
@@ -1196,18 +1499,57 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   if (heap_ != NULL) {
     heap_->UpdateGlobalMaxUsed();
   }
+  last_gc_end_micros_ = end;
+  released_free_memory_ = false;
+}
+
+bool PageSpace::ShouldReleaseFreeMemory() const {
+  if ((FLAG_idle_release_delay < 0) || released_free_memory_ ||
+      (collections_ == 0)) {
+    return false;
+  }
+  const int64_t idle_micros =
+      OS::GetCurrentMonotonicMicros() - last_gc_end_micros_;
+  return idle_micros >= (FLAG_idle_release_delay * kMicrosecondsPerMillisecond);
+}
+
+intptr_t PageSpace::ReleaseFreeMemory() {
+  // Sweeper tasks are still rebuilding the freelists.
+  {
+    MonitorLocker ml(tasks_lock());
+    if (tasks() > 0) {
+      return 0;
+    }
+  }
+  // Smaller blocks are likely to be reused soon and span few OS pages.
+  const intptr_t kMinReleaseSize = 64 * KB;
+  intptr_t released = 0;
+  {
+    FreeList* freelist = &freelist_[HeapPage::kData];
+    MutexLocker ml(freelist->mutex());
+    released = freelist->ReleaseUnusedMemoryLocked(kMinReleaseSize);
+  }
+  released_free_memory_ = true;
+  return released;
 }
 
 void PageSpace::BlockingSweep() {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "Sweep");
 
+  SweepPages(pages_, NULL);
+
+  if (FLAG_verify_after_gc) {
+    OS::PrintErr("Verifying after sweeping...");
+    heap_->VerifyGC(kForbidMarked);
+    OS::PrintErr(" done.\n");
+  }
+}
+
+void PageSpace::SweepPages(HeapPage* page, HeapPage* prev_page) {
   MutexLocker mld(freelist_[HeapPage::kData].mutex());
   MutexLocker mle(freelist_[HeapPage::kExecutable].mutex());
 
-  // Sweep all regular sized pages now.
   GCSweeper sweeper;
-  HeapPage* prev_page = NULL;
-  HeapPage* page = pages_;
   while (page != NULL) {
     HeapPage* next_page = page->next();
     bool page_in_use = sweeper.SweepPage(page, &freelist_[page->type()], true);
@@ -1219,26 +1561,136 @@ void PageSpace::BlockingSweep() {
     // Advance to the next page.
     page = next_page;
   }
-
-  if (FLAG_verify_after_gc) {
-    OS::PrintErr("Verifying after sweeping...");
-    heap_->VerifyGC(kForbidMarked);
-    OS::PrintErr(" done.\n");
-  }
 }
 
 void PageSpace::ConcurrentSweep(Isolate* isolate) {
-  // Start the concurrent sweeper task now.
-  GCSweeper::SweepConcurrent(isolate, pages_, pages_tail_,
-                             &freelist_[HeapPage::kData]);
+  // Start the concurrent sweeper task now. Large and executable pages have
+  // already been swept in the pause if they cannot be swept concurrently.
+  HeapPage* large_pages = NULL;
+  HeapPage* large_pages_tail = NULL;
+  HeapPage* exec_pages = NULL;
+  HeapPage* exec_pages_tail = NULL;
+  if (CanSweepCodeConcurrently()) {
+    large_pages = large_pages_;
+    large_pages_tail = large_pages_tail_;
+    exec_pages = exec_pages_;
+    exec_pages_tail = exec_pages_tail_;
+  }
+  GCSweeper::SweepConcurrent(isolate, pages_, pages_tail_, large_pages,
+                             large_pages_tail, exec_pages, exec_pages_tail,
+                             &freelist_[HeapPage::kData],
+                             &freelist_[HeapPage::kExecutable]);
+}
+
+bool PageSpace::CanSweepCodeConcurrently() {
+#if defined(TARGET_ARCH_IA32) || defined(TARGET_ARCH_DBC)
+  // Code patching unprotects and reprotects live instructions in place.
+  return false;
+#else
+  return !CodeProtectedInPlace();
+#endif
+}
+
+HeapPage* PageSpace::SelectPagesForCompaction() {
+  struct Candidate {
+    HeapPage* page;
+    intptr_t live_in_bytes;
+  };
+  MallocGrowableArray<Candidate> candidates;
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    intptr_t live_in_bytes = 0;
+    uword current = page->object_start();
+    const uword end = page->object_end();
+    while (current < end) {
+      RawObject* obj = RawObject::FromAddr(current);
+      const intptr_t size = obj->HeapSize();
+      if (obj->IsMarked()) {
+        live_in_bytes += size;
+      }
+      current += size;
+    }
+    const intptr_t capacity_in_bytes = end - page->object_start();
+    const intptr_t free_percent =
+        ((capacity_in_bytes - live_in_bytes) * 100) / capacity_in_bytes;
+    if (free_percent >= FLAG_compaction_fragmentation_threshold) {
+      Candidate candidate = {page, live_in_bytes};
+      candidates.Add(candidate);
+    }
+  }
+  if (candidates.length() < 2) {
+    return NULL;
+  }
+
+  // Emptiest pages first: they are the cheapest to evacuate.
+  struct CandidateComparator {
+    static int Compare(const Candidate* a, const Candidate* b) {
+      if (a->live_in_bytes != b->live_in_bytes) {
+        return (a->live_in_bytes < b->live_in_bytes) ? -1 : 1;
+      }
+      return 0;
+    }
+  };
+  candidates.Sort(CandidateComparator::Compare);
+  const intptr_t num_selected =
+      Utils::Minimum(candidates.length(),
+                     static_cast<intptr_t>(FLAG_compaction_page_budget));
+
+  // Unlink the selected pages from pages_, then chain them into their own
+  // list.
+  for (intptr_t i = 0; i < num_selected; i++) {
+    HeapPage* page = candidates[i].page;
+    HeapPage* prev = NULL;
+    HeapPage* current = pages_;
+    while (current != page) {
+      prev = current;
+      current = current->next();
+    }
+    if (prev == NULL) {
+      pages_ = page->next();
+    } else {
+      prev->set_next(page->next());
+    }
+    if (pages_tail_ == page) {
+      pages_tail_ = prev;
+    }
+  }
+  for (intptr_t i = 0; i < num_selected; i++) {
+    HeapPage* next = (i + 1 < num_selected) ? candidates[i + 1].page : NULL;
+    candidates[i].page->set_next(next);
+  }
+  return candidates[0].page;
 }
 
 void PageSpace::Compact(Thread* thread) {
+  HeapPage* compacted_pages = pages_;
+  HeapPage* uncompacted_pages = NULL;
+  if (FLAG_compaction_page_budget > 0) {
+    {
+      MutexLocker ml(pages_lock_);
+      compacted_pages = SelectPagesForCompaction();
+      uncompacted_pages = pages_;
+    }
+    if (compacted_pages == NULL) {
+      // Nothing is fragmented enough to be worth moving.
+      BlockingSweep();
+      return;
+    }
+  }
+
   thread->isolate()->set_compaction_in_progress(true);
   GCCompactor compactor(thread, heap_);
-  compactor.Compact(pages_, &freelist_[HeapPage::kData], pages_lock_);
+  compactor.Compact(compacted_pages, uncompacted_pages,
+                    &freelist_[HeapPage::kData], pages_lock_);
   thread->isolate()->set_compaction_in_progress(false);
 
+  if (uncompacted_pages != NULL) {
+    HeapPage* prev_page = pages_;
+    while (prev_page->next() != uncompacted_pages) {
+      prev_page = prev_page->next();
+    }
+    SweepPages(uncompacted_pages, prev_page);
+  }
+
   if (FLAG_verify_after_gc) {
     OS::PrintErr("Verifying after compacting...");
     heap_->VerifyGC(kForbidMarked);
@@ -1292,6 +1744,12 @@ uword PageSpace::TryAllocateDataBumpLocked(intptr_t size) {
   return result;
 }
 
+void PageSpace::UnallocatePromoLocked(uword addr, intptr_t size) {
+  freelist_[HeapPage::kData].FreeLocked(addr, size);
+  // No need for atomic operation: we're at a safepoint.
+  usage_.used_in_words -= (size >> kWordSizeLog2);
+}
+
 uword PageSpace::TryAllocatePromoLocked(intptr_t size) {
   FreeList* freelist = &freelist_[HeapPage::kData];
   uword result = freelist->TryAllocateSmallLocked(size);
@@ -1323,6 +1781,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->used_in_bytes_ = page->object_end_ - page->object_start();
   page->forwarding_page_ = NULL;
   page->card_table_ = NULL;
+  page->card_owners_ = NULL;
   if (is_executable) {
     ASSERT(Utils::IsAligned(pointer, OS::PreferredCodeAlignment()));
     page->type_ = HeapPage::kExecutable;
@@ -1357,7 +1816,8 @@ PageSpaceController::PageSpaceController(Heap* heap,
       desired_utilization_((100.0 - heap_growth_ratio) / 100.0),
       heap_growth_max_(heap_growth_max),
       garbage_collection_time_ratio_(garbage_collection_time_ratio),
-      idle_gc_threshold_in_words_(0) {
+      idle_gc_threshold_in_words_(0),
+      under_memory_pressure_(false) {
   intptr_t grow_heap = heap_growth_max / 2;
   gc_threshold_in_words_ =
       last_usage_.capacity_in_words + (kPageSizeInWords * grow_heap);
@@ -1485,6 +1945,28 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
       (before.CombinedCapacityInWords() - after.CombinedCapacityInWords()) /
       kPageSizeInWords;
   grow_heap = Utils::Maximum(grow_heap, freed_pages / 2);
+
+  // Near the container's memory limit, being killed by the OOM killer is
+  // worse than collecting more often.
+  under_memory_pressure_ = false;
+  int64_t memory_limit;
+  int64_t memory_usage;
+  if ((FLAG_memory_pressure_threshold > 0) &&
+      MemoryLimit::GetLimitAndUsage(&memory_limit, &memory_usage)) {
+    const intptr_t limited_grow_heap =
+        LimitGrowthForMemoryPressure(grow_heap, memory_limit, memory_usage,
+                                     FLAG_memory_pressure_threshold);
+    under_memory_pressure_ = limited_grow_heap != kUnlimitedGrowth;
+    if (under_memory_pressure_) {
+      grow_heap = Utils::Minimum(grow_heap, limited_grow_heap);
+    }
+    if (FLAG_log_growth && under_memory_pressure_) {
+      THR_Print("%s: memory pressure: usage=%" Pd64 "kB, limit=%" Pd64
+                "kB, growth=%" Pd " pages\n",
+                heap_->isolate()->name(), memory_usage / KB,
+                memory_limit / KB, grow_heap);
+    }
+  }
   heap_->RecordData(PageSpace::kAllowedGrowth, grow_heap);
   last_usage_ = after;
 
@@ -1503,6 +1985,26 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   }
 }
 
+const intptr_t PageSpaceController::kUnlimitedGrowth;
+
+intptr_t PageSpaceController::LimitGrowthForMemoryPressure(
+    intptr_t grow_heap,
+    int64_t memory_limit,
+    int64_t memory_usage,
+    int threshold_percent) {
+  ASSERT(memory_limit > 0);
+  if (memory_usage < (memory_limit / 100) * threshold_percent) {
+    return kUnlimitedGrowth;
+  }
+  // Grow into at most half of the remaining headroom, leaving the rest for
+  // new space, code and native allocations.
+  const int64_t headroom = Utils::Maximum<int64_t>(
+      0, memory_limit - memory_usage);
+  const int64_t max_grow_pages = headroom / 2 / kPageSize;
+  return static_cast<intptr_t>(
+      Utils::Minimum<int64_t>(grow_heap, max_grow_pages));
+}
+
 void PageSpaceController::EvaluateAfterLoading(SpaceUsage after) {
   // Number of pages we can allocate and still be within the desired growth
   // ratio.
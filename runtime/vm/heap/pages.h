@@ -6,6 +6,7 @@
 #define RUNTIME_VM_HEAP_PAGES_H_
 
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/heap/freelist.h"
 #include "vm/heap/spaces.h"
 #include "vm/lockers.h"
@@ -15,6 +16,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, dual_map_code);
 DECLARE_FLAG(bool, write_protect_code);
 
 // Forward declarations.
@@ -143,7 +145,34 @@ class HeapPage {
   }
   void VisitRememberedCards(ObjectPointerVisitor* visitor);
 
+  // Records [array] as the owner of the cards it spans. A regular page can
+  // hold several card marked arrays, so VisitRememberedCards uses these
+  // owners to find the array behind a dirty card without parsing the page.
+  // If [remember] is true, every card of the array is remembered as well.
+  void RegisterCardArray(RawObject* array, bool remember);
+
+  // Forgets the card marked arrays on this page that the last marking did
+  // not reach, so their memory can be swept and reused.
+  void ForgetUnmarkedCardArrays();
+
+  // Drops all card owners and remembered cards.
+  void ResetCardTable();
+
+  bool has_card_table() const { return card_table_ != NULL; }
+
  private:
+  // Each card has two owner entries: the card marked array covering the
+  // start of the card and the card marked array starting inside the card.
+  // Arrays are at least two cards long, so there are never more. An entry
+  // holds the array's offset in the page in allocation units plus one; zero
+  // means no owner.
+  static const intptr_t kOwnersPerCard = 2;
+  intptr_t card_owners_size() const {
+    return card_table_size() * kOwnersPerCard;
+  }
+  RawArray* CardOwnerAt(intptr_t index) const;
+  uint16_t CardOwnerEntry(RawObject* array) const;
+
   void set_object_end(uword value) {
     ASSERT((value & kObjectAlignmentMask) == kOldObjectAlignmentOffset);
     object_end_ = value;
@@ -163,7 +192,8 @@ class HeapPage {
   uword object_end_;
   uword used_in_bytes_;
   ForwardingPage* forwarding_page_;
-  uint8_t* card_table_;  // Remembered set, not marking.
+  uint8_t* card_table_;     // Remembered set, not marking.
+  uint16_t* card_owners_;  // See kOwnersPerCard.
   PageType type_;
 
   friend class PageSpace;
@@ -225,6 +255,19 @@ class PageSpaceController {
                                  int64_t end);
   void EvaluateAfterLoading(SpaceUsage after);
 
+  // Whether the last evaluated GC found the process above
+  // --memory_pressure_threshold of its cgroup memory limit.
+  bool under_memory_pressure() const { return under_memory_pressure_; }
+
+  // Returns the number of pages old gen may grow by when [memory_usage] of
+  // [memory_limit] bytes are in use, which is at most [grow_heap], or
+  // kUnlimitedGrowth if usage is below [threshold_percent] of the limit.
+  static const intptr_t kUnlimitedGrowth = -1;
+  static intptr_t LimitGrowthForMemoryPressure(intptr_t grow_heap,
+                                               int64_t memory_limit,
+                                               int64_t memory_usage,
+                                               int threshold_percent);
+
   void set_last_usage(SpaceUsage current) { last_usage_ = current; }
 
   void Enable() { is_enabled_ = true; }
@@ -263,6 +306,8 @@ class PageSpaceController {
   // Start considering idle GC when capacity exceeds this amount.
   intptr_t idle_gc_threshold_in_words_;
 
+  bool under_memory_pressure_;
+
   PageSpaceGarbageCollectionHistory history_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
@@ -280,7 +325,7 @@ class PageSpace {
                     HeapPage::PageType type = HeapPage::kData,
                     GrowthPolicy growth_policy = kControlGrowth) {
     bool is_protected =
-        (type == HeapPage::kExecutable) && FLAG_write_protect_code;
+        (type == HeapPage::kExecutable) && CodeProtectedInPlace();
     bool is_locked = false;
     return TryAllocateInternal(size, type, growth_policy, is_protected,
                                is_locked);
@@ -327,6 +372,10 @@ class PageSpace {
 
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectsNoImagePages(ObjectVisitor* visitor) const;
+  // Appends every page, made iterable, to 'pages' so that they can be divided
+  // among helper tasks. The caller must keep the page lists from changing,
+  // e.g. with a HeapIterationScope.
+  void CollectPages(GrowableArray<HeapPage*>* pages) const;
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
@@ -355,14 +404,32 @@ class PageSpace {
 
   bool GrowthControlState() { return page_space_controller_.is_enabled(); }
 
+  bool UnderMemoryPressure() const {
+    return page_space_controller_.under_memory_pressure();
+  }
+
   // Note: Code pages are made executable/non-executable when 'read_only' is
   // true/false, respectively.
   void WriteProtect(bool read_only);
   void WriteProtectCode(bool read_only);
 
+  // Whether code pages are write protected in place, so that every write to
+  // them changes protections. Dual mapped code pages instead keep a view that
+  // stays writable and an alias that stays executable.
+  static bool CodeProtectedInPlace() {
+    return FLAG_write_protect_code && !FLAG_dual_map_code;
+  }
+
   bool ShouldPerformIdleMarkSweep(int64_t deadline);
   bool ShouldPerformIdleMarkCompact(int64_t deadline);
 
+  // True once the data freelist built by the last collection has been idle
+  // for --idle_release_delay milliseconds and was not yet released.
+  bool ShouldReleaseFreeMemory() const;
+  // Returns the memory of large free blocks in data pages to the OS. Returns
+  // the number of bytes released, or 0 while sweeper tasks are running.
+  intptr_t ReleaseFreeMemory();
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
   int64_t gc_time_micros() const { return gc_time_micros_; }
@@ -413,10 +480,25 @@ class PageSpace {
   Phase phase() const { return phase_; }
   void set_phase(Phase val) { phase_ = val; }
 
+  // Thread-local allocation buffers for data pages. Each buffer is carved out
+  // of the freelist in chunks of --old_tlab_size, so small allocations only
+  // take the freelist lock when the buffer needs to be refilled. Returns 0 if
+  // buffers are disabled, the object is too large or no chunk is available.
+  uword TryAllocateInTLAB(Thread* thread, intptr_t size);
+  // Formats the unused part of all buffers so the heap can be walked.
+  void MakeTLABsIterable() const;
+  // Drops all buffers at a safepoint; the unused memory is reclaimed by the
+  // next sweep.
+  void AbandonTLABs();
+  // Returns the unused part of a thread's buffer to the freelist.
+  void ReleaseTLAB(Thread* thread);
+
   // Attempt to allocate from bump block rather than normal freelist.
   uword TryAllocateDataBumpLocked(intptr_t size);
   // Prefer small freelist blocks, then chip away at the bump block.
   uword TryAllocatePromoLocked(intptr_t size);
+  // Return the unused tail of a block obtained from TryAllocatePromoLocked.
+  void UnallocatePromoLocked(uword addr, intptr_t size);
 
   void SetupImagePage(void* pointer, uword size, bool is_executable);
 
@@ -456,6 +538,8 @@ class PageSpace {
                             GrowthPolicy growth_policy,
                             bool is_protected,
                             bool is_locked);
+  void AbandonTLAB(Thread* thread);
+
   uword TryAllocateInFreshPage(intptr_t size,
                                HeapPage::PageType type,
                                GrowthPolicy growth_policy,
@@ -467,6 +551,9 @@ class PageSpace {
   HeapPage* AllocateLargePage(intptr_t size, HeapPage::PageType type);
   void TruncateLargePage(HeapPage* page, intptr_t new_object_size_in_bytes);
   void FreeLargePage(HeapPage* page, HeapPage* previous_page);
+  // Drops the card tables of card marked arrays the last marking did not
+  // reach.
+  void ForgetUnmarkedCardArrays();
   void FreePages(HeapPage* pages);
 
   void CollectGarbageAtSafepoint(bool compact,
@@ -474,8 +561,20 @@ class PageSpace {
                                  int64_t pre_wait_for_sweepers,
                                  int64_t pre_safe_point);
   void BlockingSweep();
+  // Sweeps the regular pages starting at 'page', whose predecessor in pages_
+  // is 'prev_page' (or NULL).
+  void SweepPages(HeapPage* page, HeapPage* prev_page);
   void ConcurrentSweep(Isolate* isolate);
+  // Whether large and executable pages can be swept by the concurrent sweeper
+  // instead of in the pause. Toggling the protection of a code page must not
+  // take away execute permission from code the mutator is running, so this
+  // requires code to be dual mapped or not write protected at all.
+  static bool CanSweepCodeConcurrently();
   void Compact(Thread* thread);
+  // Unlinks up to --compaction_page_budget of the most fragmented data pages
+  // from pages_ and returns them, leaving the other pages in pages_. Returns
+  // NULL, leaving pages_ untouched, if fewer than two pages qualify.
+  HeapPage* SelectPagesForCompaction();
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
@@ -501,6 +600,7 @@ class PageSpace {
   HeapPage* exec_pages_;
   HeapPage* exec_pages_tail_;
   HeapPage* large_pages_;
+  HeapPage* large_pages_tail_;
   HeapPage* image_pages_;
 
   // A block of memory in a data page, managed by bump allocation. The remainder
@@ -529,7 +629,10 @@ class PageSpace {
   GCMarker* marker_;
 
   int64_t gc_time_micros_;
+  int64_t last_gc_end_micros_;
   intptr_t collections_;
+  // Whether ReleaseFreeMemory already ran since the last collection.
+  bool released_free_memory_;
   intptr_t mark_words_per_micro_;
 
   bool enable_concurrent_mark_;
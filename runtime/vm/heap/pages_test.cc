@@ -4,6 +4,7 @@
 
 #include "vm/heap/pages.h"
 #include "platform/assert.h"
+#include "vm/heap/memory_limit.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -31,4 +32,27 @@ TEST_CASE(Pages) {
   delete space;
 }
 
+TEST_CASE(PageSpaceMemoryPressure) {
+  const intptr_t kGrowHeap = 100;
+  const int64_t kLimit = 1000 * static_cast<int64_t>(kPageSize);
+  // Below the threshold growth is not restricted.
+  EXPECT_EQ(PageSpaceController::kUnlimitedGrowth,
+            PageSpaceController::LimitGrowthForMemoryPressure(
+                kGrowHeap, kLimit, kLimit / 2, 80));
+  // Above it old gen may only grow into half of the remaining headroom.
+  EXPECT_EQ(50, PageSpaceController::LimitGrowthForMemoryPressure(
+                    kGrowHeap, kLimit, kLimit - 100 * kPageSize, 80));
+  EXPECT_EQ(kGrowHeap, PageSpaceController::LimitGrowthForMemoryPressure(
+                           kGrowHeap, kLimit, kLimit - 400 * kPageSize, 50));
+  // At or beyond the limit it may not grow at all.
+  EXPECT_EQ(0, PageSpaceController::LimitGrowthForMemoryPressure(
+                   kGrowHeap, kLimit, kLimit + kPageSize, 80));
+
+  int64_t value = 0;
+  EXPECT(MemoryLimit::ParseValue("536870912\n", &value));
+  EXPECT_EQ(536870912, value);
+  EXPECT(!MemoryLimit::ParseValue("max\n", &value));
+  EXPECT(!MemoryLimit::ParseValue("9223372036854771712\n", &value));
+}
+
 }  // namespace dart
@@ -0,0 +1,93 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/pause_histogram.h"
+
+#include "platform/utils.h"
+#include "vm/json_stream.h"
+
+namespace dart {
+
+void PauseHistogram::Reset() {
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i] = 0;
+  }
+  count_ = 0;
+  total_ = 0;
+  max_ = 0;
+}
+
+intptr_t PauseHistogram::BucketFor(int64_t value) {
+  ASSERT(value >= 0);
+  if (value < kSubBuckets) {
+    return value;
+  }
+  const int64_t kMaxValue = (static_cast<int64_t>(1) << kMaxValueBits) - 1;
+  if (value > kMaxValue) {
+    value = kMaxValue;
+  }
+  const intptr_t shift = Utils::HighestBit(value) - kSubBucketBits;
+  const intptr_t sub_bucket = (value >> shift) & (kSubBuckets - 1);
+  return (shift + 1) * kSubBuckets + sub_bucket;
+}
+
+int64_t PauseHistogram::BucketUpperBound(intptr_t bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  const intptr_t shift = (bucket / kSubBuckets) - 1;
+  const intptr_t sub_bucket = bucket % kSubBuckets;
+  return ((static_cast<int64_t>(kSubBuckets + sub_bucket + 1)) << shift) - 1;
+}
+
+void PauseHistogram::Add(int64_t micros) {
+  if (micros < 0) {
+    micros = 0;
+  }
+  const intptr_t bucket = BucketFor(micros);
+  ASSERT(bucket < kNumBuckets);
+  buckets_[bucket]++;
+  count_++;
+  total_ += micros;
+  if (micros > max_) {
+    max_ = micros;
+  }
+}
+
+int64_t PauseHistogram::Percentile(double percent) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  ASSERT((percent >= 0.0) && (percent <= 100.0));
+  // Rank of the value at the percentile, rounded up.
+  int64_t rank = static_cast<int64_t>((percent * count_) / 100.0);
+  if ((rank * 100.0) < (percent * count_)) {
+    rank++;
+  }
+  if (rank < 1) {
+    rank = 1;
+  }
+  int64_t seen = 0;
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return Utils::Minimum(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+#ifndef PRODUCT
+void PauseHistogram::PrintToJSONObject(JSONObject* object) const {
+  object->AddProperty64("count", count_);
+  object->AddProperty64("totalMicros", total_);
+  object->AddProperty64("maxMicros", max_);
+  object->AddProperty64("p50Micros", Percentile(50.0));
+  object->AddProperty64("p90Micros", Percentile(90.0));
+  object->AddProperty64("p99Micros", Percentile(99.0));
+  object->AddProperty64("p999Micros", Percentile(99.9));
+}
+#endif  // !PRODUCT
+
+}  // namespace dart
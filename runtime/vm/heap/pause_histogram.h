@@ -0,0 +1,61 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_PAUSE_HISTOGRAM_H_
+#define RUNTIME_VM_HEAP_PAUSE_HISTOGRAM_H_
+
+#include "platform/assert.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class JSONObject;
+
+// A histogram of pause durations in microseconds with logarithmic buckets:
+// every power of two is split into kSubBuckets linear buckets, so any
+// recorded value is reported with a relative error below 1 / kSubBuckets
+// (HDR histogram style). Updates are not synchronized; they are expected to
+// come from a single thread at a time, e.g. the thread owning a safepoint.
+class PauseHistogram {
+ public:
+  PauseHistogram() { Reset(); }
+
+  void Reset();
+  void Add(int64_t micros);
+
+  int64_t count() const { return count_; }
+  int64_t total() const { return total_; }
+  int64_t max() const { return max_; }
+
+  // Returns an upper bound for the value below which the given percentage of
+  // the recorded values fall, e.g. Percentile(99.9) for p999. Returns 0 if
+  // nothing was recorded.
+  int64_t Percentile(double percent) const;
+
+#ifndef PRODUCT
+  void PrintToJSONObject(JSONObject* object) const;
+#endif  // !PRODUCT
+
+ private:
+  static const intptr_t kSubBucketBits = 3;
+  static const intptr_t kSubBuckets = 1 << kSubBucketBits;
+  // Values are clamped to 2^40 microseconds (about 12 days).
+  static const intptr_t kMaxValueBits = 40;
+  static const intptr_t kNumBuckets =
+      (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+  static intptr_t BucketFor(int64_t value);
+  static int64_t BucketUpperBound(intptr_t bucket);
+
+  int64_t buckets_[kNumBuckets];
+  int64_t count_;
+  int64_t total_;
+  int64_t max_;
+
+  DISALLOW_COPY_AND_ASSIGN(PauseHistogram);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_PAUSE_HISTOGRAM_H_
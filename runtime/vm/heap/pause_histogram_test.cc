@@ -0,0 +1,56 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/heap/pause_histogram.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+TEST_CASE(PauseHistogram_Empty) {
+  PauseHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.Percentile(50.0));
+  EXPECT_EQ(0, histogram.Percentile(99.9));
+}
+
+TEST_CASE(PauseHistogram_SmallValuesAreExact) {
+  PauseHistogram histogram;
+  for (intptr_t i = 1; i <= 7; i++) {
+    histogram.Add(i);
+  }
+  EXPECT_EQ(7, histogram.count());
+  EXPECT_EQ(28, histogram.total());
+  EXPECT_EQ(7, histogram.max());
+  EXPECT_EQ(4, histogram.Percentile(50.0));
+  EXPECT_EQ(7, histogram.Percentile(100.0));
+}
+
+TEST_CASE(PauseHistogram_Percentiles) {
+  PauseHistogram histogram;
+  // 990 short pauses and 10 long ones.
+  for (intptr_t i = 0; i < 990; i++) {
+    histogram.Add(100);
+  }
+  for (intptr_t i = 0; i < 10; i++) {
+    histogram.Add(50000);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(50000, histogram.max());
+
+  // Reported values are upper bounds within 1/8 of the recorded value.
+  const int64_t p50 = histogram.Percentile(50.0);
+  EXPECT(p50 >= 100);
+  EXPECT(p50 < 100 + 100 / 8);
+  const int64_t p99 = histogram.Percentile(99.0);
+  EXPECT(p99 >= 100);
+  EXPECT(p99 < 100 + 100 / 8);
+  EXPECT_EQ(50000, histogram.Percentile(99.9));
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.max());
+}
+
+}  // namespace dart
@@ -41,7 +41,8 @@ void BlockStack<BlockSize>::Cleanup() {
 }
 
 template <int BlockSize>
-BlockStack<BlockSize>::BlockStack() : mutex_(new Mutex()) {}
+BlockStack<BlockSize>::BlockStack()
+    : mutex_(new Mutex()), num_non_empty_(0), num_idle_(0) {}
 
 template <int BlockSize>
 BlockStack<BlockSize>::~BlockStack() {
@@ -67,6 +68,7 @@ void BlockStack<BlockSize>::Reset() {
     }
     TrimGlobalEmpty();
   }
+  UpdateNonEmpty();
 }
 
 template <int BlockSize>
@@ -75,7 +77,9 @@ typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::Blocks() {
   while (!partial_.IsEmpty()) {
     full_.Push(partial_.Pop());
   }
-  return full_.PopAll();
+  Block* result = full_.PopAll();
+  UpdateNonEmpty();
+  return result;
 }
 
 template <int BlockSize>
@@ -84,6 +88,7 @@ void BlockStack<BlockSize>::PushBlockImpl(Block* block) {
   if (block->IsFull()) {
     MutexLocker ml(mutex_);
     full_.Push(block);
+    UpdateNonEmpty();
   } else if (block->IsEmpty()) {
     MutexLocker ml(global_mutex_);
     global_empty_->Push(block);
@@ -91,6 +96,7 @@ void BlockStack<BlockSize>::PushBlockImpl(Block* block) {
   } else {
     MutexLocker ml(mutex_);
     partial_.Push(block);
+    UpdateNonEmpty();
   }
 }
 
@@ -120,7 +126,9 @@ BlockStack<BlockSize>::PopNonFullBlock() {
   {
     MutexLocker ml(mutex_);
     if (!partial_.IsEmpty()) {
-      return partial_.Pop();
+      Block* result = partial_.Pop();
+      UpdateNonEmpty();
+      return result;
     }
   }
   return PopEmptyBlock();
@@ -141,13 +149,16 @@ template <int BlockSize>
 typename BlockStack<BlockSize>::Block*
 BlockStack<BlockSize>::PopNonEmptyBlock() {
   MutexLocker ml(mutex_);
+  Block* result;
   if (!full_.IsEmpty()) {
-    return full_.Pop();
+    result = full_.Pop();
   } else if (!partial_.IsEmpty()) {
-    return partial_.Pop();
+    result = partial_.Pop();
   } else {
     return NULL;
   }
+  UpdateNonEmpty();
+  return result;
 }
 
 template <int BlockSize>
@@ -5,7 +5,10 @@
 #ifndef RUNTIME_VM_HEAP_POINTER_BLOCK_H_
 #define RUNTIME_VM_HEAP_POINTER_BLOCK_H_
 
+#include "platform/allocation.h"
 #include "platform/assert.h"
+#include "platform/atomic.h"
+#include "platform/memory_sanitizer.h"
 #include "vm/globals.h"
 
 namespace dart {
@@ -105,6 +108,20 @@ class BlockStack {
 
   bool IsEmpty();
 
+  // Like IsEmpty, but without taking the lock, so that consumers waiting for
+  // work can poll it without slowing down producers. The answer may be stale.
+  bool IsEmptyRelaxed() const {
+    return AtomicOperations::LoadRelaxed(&num_non_empty_) == 0;
+  }
+
+  // Consumers waiting for work. While there are any, consumers with work
+  // share part of it through the stack (see BlockWorkList::ShareWork).
+  void EnterIdle() { AtomicOperations::FetchAndIncrement(&num_idle_); }
+  void ExitIdle() { AtomicOperations::FetchAndDecrement(&num_idle_); }
+  bool HasIdle() const {
+    return AtomicOperations::LoadRelaxed(&num_idle_) > 0;
+  }
+
  protected:
   class List {
    public:
@@ -129,9 +146,18 @@ class BlockStack {
   // If needed, trims the global cache of empty blocks.
   static void TrimGlobalEmpty();
 
+  // Publishes the number of non-empty blocks for IsEmptyRelaxed. Must be
+  // called with mutex_ held after changing full_ or partial_.
+  void UpdateNonEmpty() {
+    AtomicOperations::StoreRelease(&num_non_empty_,
+                                   full_.length() + partial_.length());
+  }
+
   List full_;
   List partial_;
   Mutex* mutex_;
+  intptr_t num_non_empty_;
+  uintptr_t num_idle_;
 
   // Note: This is shared on the basis of block size.
   static const intptr_t kMaxGlobalEmpty = 100;
@@ -175,6 +201,119 @@ class MarkingStack : public BlockStack<kMarkingStackBlockSize> {
 
 typedef MarkingStack::Block MarkingStackBlock;
 
+// Work list shared by the parallel scavenger tasks. Each entry is an object
+// that has been copied or promoted, but whose slots have not been scavenged.
+class ScavengerStack : public BlockStack<kMarkingStackBlockSize> {
+ public:
+  // Adds and transfers ownership of the block to the buffer.
+  void PushBlock(Block* block) {
+    BlockStack<Block::kSize>::PushBlockImpl(block);
+  }
+};
+
+// A thread-local view of a shared stack of blocks (e.g., MarkingStack).
+// Pushes and pops hit the local block, and only full or empty blocks are
+// exchanged with the shared stack.
+template <typename Stack>
+class BlockWorkList : public ValueObject {
+ public:
+  typedef typename Stack::Block Block;
+
+  explicit BlockWorkList(Stack* stack) : spare_(NULL), stack_(stack) {
+    work_ = stack_->PopEmptyBlock();
+  }
+
+  ~BlockWorkList() {
+    ASSERT(work_ == NULL);
+    ASSERT(spare_ == NULL);
+    ASSERT(stack_ == NULL);
+  }
+
+  // Returns NULL if no more work was found.
+  RawObject* Pop() {
+    ASSERT(work_ != NULL);
+    if (work_->IsEmpty()) {
+      // TODO(koda): Track over/underflow events and use in heuristics to
+      // distribute work and prevent degenerate flip-flopping.
+      Block* new_work = stack_->PopNonEmptyBlock();
+      if (new_work == NULL) {
+        return NULL;
+      }
+      // Keep one empty block locally rather than round-tripping it through
+      // the global pool of empty blocks, which is shared by all stacks.
+      if (spare_ == NULL) {
+        spare_ = work_;
+      } else {
+        stack_->PushBlock(work_);
+      }
+      work_ = new_work;
+      // Generated code appends to marking stacks; tell MemorySanitizer.
+      MSAN_UNPOISON(work_, sizeof(*work_));
+    }
+    return work_->Pop();
+  }
+
+  void Push(RawObject* raw_obj) {
+    if (work_->IsFull()) {
+      // TODO(koda): Track over/underflow events and use in heuristics to
+      // distribute work and prevent degenerate flip-flopping.
+      stack_->PushBlock(work_);
+      work_ = PopEmptyBlock();
+    }
+    work_->Push(raw_obj);
+  }
+
+  // If other consumers of the stack are waiting for work, moves half of the
+  // local work to the stack for them to take. Cheap when nobody is waiting.
+  void ShareWork() {
+    if (!stack_->HasIdle() || (work_->Count() < 2)) {
+      return;
+    }
+    Block* shared = PopEmptyBlock();
+    for (intptr_t i = work_->Count() / 2; i > 0; i--) {
+      shared->Push(work_->Pop());
+    }
+    stack_->PushBlock(shared);
+  }
+
+  void Finalize() {
+    ASSERT(work_->IsEmpty());
+    stack_->PushBlock(work_);
+    work_ = NULL;
+    ReleaseSpare();
+    // Fail fast on attempts to mark after finalizing.
+    stack_ = NULL;
+  }
+
+  void AbandonWork() {
+    stack_->PushBlock(work_);
+    work_ = NULL;
+    ReleaseSpare();
+    stack_ = NULL;
+  }
+
+ private:
+  Block* PopEmptyBlock() {
+    if (spare_ != NULL) {
+      Block* result = spare_;
+      spare_ = NULL;
+      return result;
+    }
+    return stack_->PopEmptyBlock();
+  }
+
+  void ReleaseSpare() {
+    if (spare_ != NULL) {
+      stack_->PushBlock(spare_);
+      spare_ = NULL;
+    }
+  }
+
+  Block* work_;
+  Block* spare_;
+  Stack* stack_;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_HEAP_POINTER_BLOCK_H_
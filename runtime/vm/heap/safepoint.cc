@@ -4,12 +4,23 @@
 
 #include "vm/heap/safepoint.h"
 
+#include "vm/heap/heap.h"
+#include "vm/os.h"
+#include "vm/profiler.h"
+#include "vm/tags.h"
 #include "vm/thread.h"
 #include "vm/thread_registry.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
 DEFINE_FLAG(bool, trace_safepoint, false, "Trace Safepoint logic.");
+DEFINE_FLAG(int,
+            safepoint_report_threshold,
+            0,
+            "Report the threads which take longer than this many milliseconds "
+            "to reach a safepoint, and their stacks once they do (0 disables "
+            "reporting).");
 
 SafepointOperationScope::SafepointOperationScope(Thread* T)
     : ThreadStackResource(T) {
@@ -41,6 +52,7 @@ SafepointHandler::SafepointHandler(Isolate* isolate)
     : isolate_(isolate),
       safepoint_lock_(new Monitor()),
       number_threads_not_at_safepoint_(0),
+      safepoint_start_micros_(0),
       safepoint_operation_count_(0),
       owner_(NULL) {}
 
@@ -56,6 +68,7 @@ void SafepointHandler::SafepointThreads(Thread* T) {
   ASSERT(T->no_safepoint_scope_depth() == 0);
   ASSERT(T->execution_state() == Thread::kThreadInVM);
 
+  int64_t start = 0;
   {
     // First grab the threads list lock for this isolate
     // and check if a safepoint is already in progress. This
@@ -78,6 +91,11 @@ void SafepointHandler::SafepointThreads(Thread* T) {
 
     // Set safepoint in progress state by this thread.
     SetSafepointInProgress(T);
+    start = OS::GetCurrentMonotonicMicros();
+    {
+      MonitorLocker sl(safepoint_lock_);
+      safepoint_start_micros_ = start;
+    }
 
     // Go over the active thread list and ensure that all threads active
     // in the isolate reach a safepoint.
@@ -106,21 +124,141 @@ void SafepointHandler::SafepointThreads(Thread* T) {
   }
   // Now wait for all threads that are not already at a safepoint to check-in.
   {
-    MonitorLocker sl(safepoint_lock_);
+    TIMELINE_FUNCTION_GC_DURATION(T, "WaitForSafepoint");
+    const int64_t report_micros =
+        FLAG_safepoint_report_threshold * kMicrosecondsPerMillisecond;
+    const int64_t wait_millis =
+        (report_micros > 0)
+            ? Utils::Minimum<int64_t>(1000, FLAG_safepoint_report_threshold)
+            : 1000;
+    bool reported = false;
     intptr_t num_attempts = 0;
-    while (number_threads_not_at_safepoint_ > 0) {
-      Monitor::WaitResult retval = sl.Wait(1000);
-      if (retval == Monitor::kTimedOut) {
-        num_attempts += 1;
-        if (FLAG_trace_safepoint && num_attempts > 10) {
-          // We have been waiting too long, start logging this as we might
-          // have an issue where a thread is not checking in for a safepoint.
-          OS::PrintErr("Attempt:%" Pd " waiting for %d threads to check in\n",
-                       num_attempts, number_threads_not_at_safepoint_);
+    while (true) {
+      {
+        MonitorLocker sl(safepoint_lock_);
+        if (number_threads_not_at_safepoint_ == 0) {
+          break;
+        }
+        Monitor::WaitResult retval = sl.Wait(wait_millis);
+        if (number_threads_not_at_safepoint_ == 0) {
+          break;
+        }
+        if (retval == Monitor::kTimedOut) {
+          num_attempts += 1;
+          if (FLAG_trace_safepoint &&
+              (OS::GetCurrentMonotonicMicros() - start >
+               10 * kMicrosecondsPerSecond)) {
+            // We have been waiting too long, start logging this as we might
+            // have an issue where a thread is not checking in for a
+            // safepoint.
+            OS::PrintErr("Attempt:%" Pd " waiting for %d threads to check in\n",
+                         num_attempts, number_threads_not_at_safepoint_);
+          }
         }
       }
+      // Report the stragglers outside of the safepoint lock: it is acquired
+      // after the threads lock everywhere else.
+      const int64_t waited_micros = OS::GetCurrentMonotonicMicros() - start;
+      if (!reported && (report_micros > 0) &&
+          (waited_micros >= report_micros)) {
+        ReportSlowThreads(T, waited_micros);
+        reported = true;
+      }
     }
   }
+  // Only the owner of the safepoint gets here, so the histogram is not
+  // updated concurrently.
+  Heap* heap = isolate()->heap();
+  if (heap != NULL) {
+    heap->RecordPause(Heap::kSafepointPause,
+                      OS::GetCurrentMonotonicMicros() - start);
+  }
+}
+
+static const char* ExecutionStateName(Thread::ExecutionState state) {
+  switch (state) {
+    case Thread::kThreadInVM:
+      return "vm";
+    case Thread::kThreadInGenerated:
+      return "generated";
+    case Thread::kThreadInNative:
+      return "native";
+    case Thread::kThreadInBlockedState:
+      return "blocked";
+  }
+  return "unknown";
+}
+
+static const char* ThreadName(Thread* thread) {
+  OSThread* os_thread = thread->os_thread();
+  if ((os_thread == NULL) || (os_thread->name() == NULL)) {
+    return "<unnamed>";
+  }
+  return os_thread->name();
+}
+
+void SafepointHandler::ReportSlowThreads(Thread* T, int64_t waited_micros) {
+  MonitorLocker ml(threads_lock());
+  Thread* current = isolate()->thread_registry()->active_list();
+  while (current != NULL) {
+    // The state of a thread which is still running is read racily; it is
+    // only used for the report.
+    if ((current != T) && !current->BypassSafepoints() &&
+        current->IsSafepointRequested() && !current->IsAtSafepoint()) {
+      const char* name = ThreadName(current);
+      const char* state = ExecutionStateName(current->execution_state());
+      const char* tag = VMTag::TagName(current->vm_tag());
+      OS::PrintErr("Thread %s has not reached the safepoint requested by %s "
+                   "after %" Pd64 "ms (state: %s, vm tag: %s)\n",
+                   name, ThreadName(T),
+                   waited_micros / kMicrosecondsPerMillisecond, state, tag);
+#if defined(SUPPORT_TIMELINE)
+      TimelineEvent* event = Timeline::GetGCStream()->StartEvent();
+      if (event != NULL) {
+        event->Instant("SlowSafepointThread");
+        event->SetNumArguments(4);
+        event->CopyArgument(0, "thread", name);
+        event->CopyArgument(1, "state", state);
+        event->CopyArgument(2, "vmTag", tag);
+        event->FormatArgument(3, "waitedMicros", "%" Pd64, waited_micros);
+        event->Complete();
+      }
+#endif  // defined(SUPPORT_TIMELINE)
+    }
+    current = current->next();
+  }
+}
+
+void SafepointHandler::CheckInLate(Thread* T) {
+  if (FLAG_safepoint_report_threshold <= 0) {
+    return;
+  }
+  int64_t late_micros;
+  {
+    MonitorLocker sl(safepoint_lock_);
+    late_micros = OS::GetCurrentMonotonicMicros() - safepoint_start_micros_;
+  }
+  if (late_micros <
+      FLAG_safepoint_report_threshold * kMicrosecondsPerMillisecond) {
+    return;
+  }
+  const char* name = ThreadName(T);
+  const char* tag = VMTag::TagName(T->vm_tag());
+  OS::PrintErr("Thread %s reached the safepoint after %" Pd64
+               "ms (vm tag: %s), stack:\n",
+               name, late_micros / kMicrosecondsPerMillisecond, tag);
+  Profiler::DumpStackTrace(/*for_crash=*/false);
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetGCStream()->StartEvent();
+  if (event != NULL) {
+    event->Instant("SlowSafepointCheckIn");
+    event->SetNumArguments(3);
+    event->CopyArgument(0, "thread", name);
+    event->CopyArgument(1, "vmTag", tag);
+    event->FormatArgument(2, "lateMicros", "%" Pd64, late_micros);
+    event->Complete();
+  }
+#endif  // defined(SUPPORT_TIMELINE)
 }
 
 void SafepointHandler::ResumeThreads(Thread* T) {
@@ -159,6 +297,9 @@ void SafepointHandler::ResumeThreads(Thread* T) {
 
 void SafepointHandler::EnterSafepointUsingLock(Thread* T) {
   MonitorLocker tl(T->thread_lock());
+  if (T->IsSafepointRequested()) {
+    CheckInLate(T);
+  }
   T->SetAtSafepoint(true);
   if (T->IsSafepointRequested()) {
     MonitorLocker sl(safepoint_lock_);
@@ -183,6 +324,7 @@ void SafepointHandler::BlockForSafepoint(Thread* T) {
   ASSERT(!T->BypassSafepoints());
   MonitorLocker tl(T->thread_lock());
   if (T->IsSafepointRequested()) {
+    CheckInLate(T);
     T->SetAtSafepoint(true);
     {
       MonitorLocker sl(safepoint_lock_);
@@ -39,6 +39,15 @@ class SafepointHandler {
   void SafepointThreads(Thread* T);
   void ResumeThreads(Thread* T);
 
+  // Reports the threads which have not reached the safepoint requested by
+  // [T] within --safepoint_report_threshold milliseconds.
+  void ReportSlowThreads(Thread* T, int64_t waited_micros);
+
+  // Called by [T] right before it checks into the requested safepoint, while
+  // the heap is still stable. Reports its own stack if it took longer than
+  // --safepoint_report_threshold milliseconds.
+  void CheckInLate(Thread* T);
+
   Isolate* isolate() const { return isolate_; }
   Monitor* threads_lock() const { return isolate_->threads_lock(); }
   bool SafepointInProgress() const {
@@ -81,6 +90,10 @@ class SafepointHandler {
   Monitor* safepoint_lock_;
   int32_t number_threads_not_at_safepoint_;
 
+  // Time at which the current safepoint operation was requested, used to
+  // measure time-to-safepoint of the threads which check in.
+  int64_t safepoint_start_micros_;
+
   // Count that indicates if a safepoint operation is currently in progress
   // and also tracks the number of recursive safepoint operations on the
   // same thread.
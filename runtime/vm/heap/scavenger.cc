@@ -7,6 +7,7 @@
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flag_list.h"
+#include "vm/heap/become.h"
 #include "vm/heap/pointer_block.h"
 #include "vm/heap/safepoint.h"
 #include "vm/heap/verifier.h"
@@ -17,6 +18,8 @@
 #include "vm/object_id_ring.h"
 #include "vm/object_set.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
@@ -33,6 +36,11 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(int,
+            scavenger_tasks,
+            0,
+            "The number of tasks to spawn during scavenging (0 means "
+            "perform all scavenging on main thread).");
 
 // Scavenger uses RawObject::kMarkBit to distinguish forwarded and non-forwarded
 // objects. The kMarkBit does not intersect with the target address because of
@@ -85,19 +93,38 @@ static inline void objcpy(void* dst, const void* src, size_t size) {
   } while (size > 0);
 }
 
-class ScavengerVisitor : public ObjectPointerVisitor {
+template <bool parallel>
+class ScavengerVisitorBase : public ObjectPointerVisitor {
  public:
-  explicit ScavengerVisitor(Isolate* isolate,
-                            Scavenger* scavenger,
-                            SemiSpace* from)
+  ScavengerVisitorBase(Isolate* isolate,
+                       Scavenger* scavenger,
+                       SemiSpace* from,
+                       BlockWorkList<ScavengerStack>* work_list)
       : ObjectPointerVisitor(isolate),
         thread_(Thread::Current()),
         scavenger_(scavenger),
         from_(from),
         heap_(scavenger->heap_),
         page_space_(scavenger->heap_->old_space()),
+#ifndef PRODUCT
+        class_table_(isolate->class_table()),
+#endif  // !PRODUCT
+        work_list_(work_list),
+        delayed_weak_properties_(NULL),
+        copy_top_(0),
+        copy_end_(0),
+        promo_top_(0),
+        promo_end_(0),
         bytes_promoted_(0),
-        visiting_old_object_(NULL) {}
+        visiting_old_object_(NULL) {
+    ASSERT(parallel == (work_list != NULL));
+  }
+
+  ~ScavengerVisitorBase() {
+    ASSERT(!parallel || (delayed_weak_properties_ == NULL));
+    ASSERT(copy_top_ == copy_end_);
+    ASSERT(promo_top_ == promo_end_);
+  }
 
   virtual void VisitTypedDataViewPointers(RawTypedDataView* view,
                                           RawObject** first,
@@ -161,7 +188,97 @@ class ScavengerVisitor : public ObjectPointerVisitor {
 
   intptr_t bytes_promoted() const { return bytes_promoted_; }
 
+  // Parallel scavenge only: scavenge the slots of copied and promoted objects
+  // until this task's work list and the shared work stack are empty.
+  void ProcessWorkList() {
+    ASSERT(parallel);
+    RawObject* raw_obj;
+    while ((raw_obj = work_list_->Pop()) != NULL) {
+      if (raw_obj->IsNewObject()) {
+        intptr_t class_id = raw_obj->GetClassId();
+        intptr_t size;
+        if (class_id != kWeakPropertyCid) {
+          size = raw_obj->VisitPointersNonvirtual(this);
+        } else {
+          RawWeakProperty* raw_weak =
+              reinterpret_cast<RawWeakProperty*>(raw_obj);
+          size = ProcessWeakProperty(raw_weak);
+        }
+        NOT_IN_PRODUCT(class_table_->UpdateLiveNew(class_id, size));
+      } else {
+        ASSERT(!raw_obj->IsRemembered());
+        VisitingOldObject(raw_obj);
+        intptr_t size = raw_obj->VisitPointersNonvirtual(this);
+#if defined(PRODUCT)
+        USE(size);
+#else
+        class_table_->UpdateAllocatedOld(raw_obj->GetClassId(), size);
+#endif
+        if (raw_obj->IsMarked()) {
+          // Complete our promise from ScavengePointer (see
+          // Scavenger::ProcessToSpace).
+          thread_->MarkingStackAddObject(raw_obj);
+        }
+        VisitingOldObject(NULL);
+      }
+    }
+  }
+
+  // Parallel scavenge only: revisit the weak properties whose keys had not
+  // been reached when they were scanned. Returns true if any of them became
+  // reachable, potentially adding more work.
+  bool ProcessPendingWeakProperties() {
+    ASSERT(parallel);
+    bool more_to_scavenge = false;
+    RawWeakProperty* cur_weak = delayed_weak_properties_;
+    delayed_weak_properties_ = NULL;
+    while (cur_weak != NULL) {
+      uword next_weak = cur_weak->ptr()->next_;
+      RawObject* raw_key = cur_weak->ptr()->key_;
+      ASSERT(raw_key->IsNewObject());
+      uword header = *reinterpret_cast<uword*>(RawObject::ToAddr(raw_key));
+      // Reset the next pointer in the weak property.
+      cur_weak->ptr()->next_ = 0;
+      if (IsForwarding(header)) {
+        cur_weak->VisitPointersNonvirtual(this);
+        more_to_scavenge = true;
+      } else {
+        EnqueueWeakProperty(cur_weak);
+      }
+      cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+    }
+    return more_to_scavenge;
+  }
+
+  // Parallel scavenge only: make the unused parts of this task's buffers
+  // iterable and hand the remaining weak properties back to the scavenger,
+  // which clears them once all tasks are done.
+  void Finalize() {
+    ASSERT(parallel);
+    RetireCopyBuffer();
+    if (promo_top_ < promo_end_) {
+      page_space_->AcquireDataLock();
+      RetirePromotionBufferLocked();
+      page_space_->ReleaseDataLock();
+    }
+    if (delayed_weak_properties_ != NULL) {
+      MutexLocker ml(&scavenger_->space_lock_);
+      while (delayed_weak_properties_ != NULL) {
+        RawWeakProperty* cur_weak = delayed_weak_properties_;
+        delayed_weak_properties_ =
+            reinterpret_cast<RawWeakProperty*>(cur_weak->ptr()->next_);
+        cur_weak->ptr()->next_ = 0;
+        scavenger_->EnqueueWeakProperty(cur_weak);
+      }
+    }
+  }
+
  private:
+  // Size of the to-space and old-space chunks each parallel task allocates
+  // into without synchronization. Larger objects are allocated directly.
+  static const intptr_t kCopyBufferSize = 16 * KB;
+  static const intptr_t kPromotionBufferSize = 16 * KB;
+
   void UpdateStoreBuffer(RawObject** p, RawObject* obj) {
     ASSERT(obj->IsHeapObject());
     if (FLAG_verify_gc_contains) {
@@ -197,12 +314,17 @@ class ScavengerVisitor : public ObjectPointerVisitor {
       // Get the new location of the object.
       new_addr = ForwardedAddr(header);
     } else {
-      intptr_t size = raw_obj->HeapSize();
+      // In parallel mode another task may forward the object at any moment,
+      // so the size must come from the header we examined.
+      intptr_t size = parallel
+                          ? raw_obj->HeapSize(static_cast<uint32_t>(header))
+                          : raw_obj->HeapSize();
+      bool promoted = false;
       // Check whether object should be promoted.
       if (scavenger_->survivor_end_ <= raw_addr) {
         // Not a survivor of a previous scavenge. Just copy the object into the
         // to space.
-        new_addr = scavenger_->AllocateGC(size);
+        new_addr = TryAllocateCopy(size);
       } else {
         // TODO(iposva): Experiment with less aggressive promotion. For example
         // a coin toss determines if an object is promoted or whether it should
@@ -210,18 +332,24 @@ class ScavengerVisitor : public ObjectPointerVisitor {
         //
         // This object is a survivor of a previous scavenge. Attempt to promote
         // the object.
-        new_addr = page_space_->TryAllocatePromoLocked(size);
+        new_addr = TryAllocatePromotion(size);
         if (new_addr != 0) {
-          // If promotion succeeded then we need to remember it so that it can
-          // be traversed later.
-          scavenger_->PushToPromotedStack(new_addr);
-          bytes_promoted_ += size;
+          promoted = true;
         } else {
           // Promotion did not succeed. Copy into the to space instead.
           scavenger_->failed_to_promote_ = true;
-          new_addr = scavenger_->AllocateGC(size);
+          new_addr = TryAllocateCopy(size);
         }
       }
+      if (parallel && (new_addr == 0)) {
+        // The to space can be exhausted by the unused tails of the tasks' copy
+        // buffers. Promote instead.
+        new_addr = TryAllocatePromotion(size);
+        if (new_addr == 0) {
+          OUT_OF_MEMORY();
+        }
+        promoted = true;
+      }
       // During a scavenge we always succeed to at least copy all of the
       // current objects to the to space.
       ASSERT(new_addr != 0);
@@ -230,9 +358,9 @@ class ScavengerVisitor : public ObjectPointerVisitor {
              reinterpret_cast<void*>(raw_addr), size);
 
       RawObject* new_obj = RawObject::FromAddr(new_addr);
-      if (new_obj->IsOldObject()) {
+      if (promoted) {
         // Promoted: update age/barrier tags.
-        uint32_t tags = new_obj->ptr()->tags_;
+        uint32_t tags = static_cast<uint32_t>(header);
         tags = RawObject::OldBit::update(true, tags);
         tags = RawObject::OldAndNotRememberedBit::update(true, tags);
         tags = RawObject::NewBit::update(false, tags);
@@ -251,7 +379,29 @@ class ScavengerVisitor : public ObjectPointerVisitor {
       }
 
       // Remember forwarding address.
-      ForwardTo(raw_addr, new_addr);
+      if (parallel) {
+        // Race with other tasks to install the forwarding pointer. The loser
+        // gives back its copy and uses the winner's.
+        uword old_header = AtomicOperations::CompareAndSwapWord(
+            reinterpret_cast<uword*>(raw_addr), header, new_addr | kForwarded);
+        if (old_header != header) {
+          UndoAllocation(new_addr, size, promoted);
+          new_addr = ForwardedAddr(old_header);
+        } else {
+          if (promoted) {
+            bytes_promoted_ += size;
+          }
+          work_list_->Push(new_obj);
+        }
+      } else {
+        ForwardTo(raw_addr, new_addr);
+        if (promoted) {
+          // If promotion succeeded then we need to remember it so that it can
+          // be traversed later.
+          scavenger_->PushToPromotedStack(new_addr);
+          bytes_promoted_ += size;
+        }
+      }
     }
     // Update the reference.
     RawObject* new_obj = RawObject::FromAddr(new_addr);
@@ -262,18 +412,144 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     }
   }
 
+  DART_FORCE_INLINE
+  uword TryAllocateCopy(intptr_t size) {
+    if (!parallel) {
+      return scavenger_->AllocateGC(size);
+    }
+    if (LIKELY((copy_end_ - copy_top_) >= static_cast<uword>(size))) {
+      uword result = copy_top_;
+      copy_top_ += size;
+      return result;
+    }
+    if (size > (kCopyBufferSize / 4)) {
+      intptr_t allocated = size;
+      return scavenger_->TryAllocateGCBuffer(size, &allocated);
+    }
+    RetireCopyBuffer();
+    intptr_t allocated = kCopyBufferSize;
+    uword buffer = scavenger_->TryAllocateGCBuffer(size, &allocated);
+    if (buffer == 0) {
+      return 0;
+    }
+    copy_top_ = buffer + size;
+    copy_end_ = buffer + allocated;
+    return buffer;
+  }
+
+  uword TryAllocatePromotion(intptr_t size) {
+    if (!parallel) {
+      return page_space_->TryAllocatePromoLocked(size);
+    }
+    if (LIKELY((promo_end_ - promo_top_) >= static_cast<uword>(size))) {
+      uword result = promo_top_;
+      promo_top_ += size;
+      return result;
+    }
+    uword result = 0;
+    page_space_->AcquireDataLock();
+    if (size > (kPromotionBufferSize / 4)) {
+      result = page_space_->TryAllocatePromoLocked(size);
+    } else {
+      RetirePromotionBufferLocked();
+      uword buffer = page_space_->TryAllocatePromoLocked(kPromotionBufferSize);
+      if (buffer != 0) {
+        result = buffer;
+        promo_top_ = buffer + size;
+        promo_end_ = buffer + kPromotionBufferSize;
+      } else {
+        // Old space may still have room for this object alone.
+        result = page_space_->TryAllocatePromoLocked(size);
+      }
+    }
+    page_space_->ReleaseDataLock();
+    return result;
+  }
+
+  // Gives back a copy made by this task after another task won the race to
+  // forward the same object.
+  void UndoAllocation(uword addr, intptr_t size, bool promoted) {
+    if (promoted) {
+      if ((addr + size) == promo_top_) {
+        promo_top_ = addr;
+      } else {
+        // Allocated directly in old space; leave it to the sweeper.
+        FreeListElement::AsElement(addr, size);
+      }
+    } else {
+      if ((addr + size) == copy_top_) {
+        copy_top_ = addr;
+      } else {
+        ForwardingCorpse::AsForwarder(addr, size);
+      }
+    }
+  }
+
+  void RetireCopyBuffer() {
+    intptr_t remaining = copy_end_ - copy_top_;
+    if (remaining >= kObjectAlignment) {
+      // ForwardingCorpse(forwarding to default null) will work as filler.
+      ForwardingCorpse::AsForwarder(copy_top_, remaining);
+    }
+    copy_top_ = copy_end_ = 0;
+  }
+
+  void RetirePromotionBufferLocked() {
+    intptr_t remaining = promo_end_ - promo_top_;
+    if (remaining > 0) {
+      page_space_->UnallocatePromoLocked(promo_top_, remaining);
+    }
+    promo_top_ = promo_end_ = 0;
+  }
+
+  void EnqueueWeakProperty(RawWeakProperty* raw_weak) {
+    ASSERT(raw_weak->IsHeapObject());
+    ASSERT(raw_weak->IsNewObject());
+    ASSERT(raw_weak->IsWeakProperty());
+    ASSERT(raw_weak->ptr()->next_ == 0);
+    raw_weak->ptr()->next_ = reinterpret_cast<uword>(delayed_weak_properties_);
+    delayed_weak_properties_ = raw_weak;
+  }
+
+  intptr_t ProcessWeakProperty(RawWeakProperty* raw_weak) {
+    // The fate of the weak property is determined by its key.
+    RawObject* raw_key = raw_weak->ptr()->key_;
+    if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
+      uword raw_addr = RawObject::ToAddr(raw_key);
+      uword header = *reinterpret_cast<uword*>(raw_addr);
+      if (!IsForwarding(header)) {
+        // Key is white.  Enqueue the weak property.
+        EnqueueWeakProperty(raw_weak);
+        return raw_weak->HeapSize();
+      }
+    }
+    // Key is gray or black.  Make the weak property black.
+    return raw_weak->VisitPointersNonvirtual(this);
+  }
+
   Thread* thread_;
   Scavenger* scavenger_;
   SemiSpace* from_;
   Heap* heap_;
   PageSpace* page_space_;
+#ifndef PRODUCT
+  ClassTable* class_table_;
+#endif  // !PRODUCT
+
+  // Parallel scavenge only.
+  BlockWorkList<ScavengerStack>* work_list_;
   RawWeakProperty* delayed_weak_properties_;
+  uword copy_top_;
+  uword copy_end_;
+  uword promo_top_;
+  uword promo_end_;
+
   intptr_t bytes_promoted_;
   RawObject* visiting_old_object_;
 
   friend class Scavenger;
 
-  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitor);
+  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitorBase);
 };
 
 class ScavengerWeakVisitor : public HandleVisitor {
@@ -312,6 +588,111 @@ class ScavengerWeakVisitor : public HandleVisitor {
   DISALLOW_COPY_AND_ASSIGN(ScavengerWeakVisitor);
 };
 
+class ParallelScavengerTask : public ThreadPool::Task {
+ public:
+  ParallelScavengerTask(Isolate* isolate,
+                        Scavenger* scavenger,
+                        SemiSpace* from,
+                        ScavengerStack* work_stack,
+                        ThreadBarrier* barrier,
+                        uintptr_t* num_busy,
+                        intptr_t* bytes_promoted)
+      : isolate_(isolate),
+        scavenger_(scavenger),
+        from_(from),
+        work_stack_(work_stack),
+        barrier_(barrier),
+        num_busy_(num_busy),
+        bytes_promoted_(bytes_promoted) {}
+
+  virtual void Run() {
+    bool result =
+        Thread::EnterIsolateAsHelper(isolate_, Thread::kScavengerTask, true);
+    ASSERT(result);
+    {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ParallelScavenge");
+      BlockWorkList<ScavengerStack> work_list(work_stack_);
+      ParallelScavengerVisitor visitor(isolate_, scavenger_, from_, &work_list);
+
+      scavenger_->IterateRootSlices(isolate_, &visitor);
+
+      bool more_to_scavenge = false;
+      do {
+        do {
+          visitor.ProcessWorkList();
+
+          // I can't find more work right now. If no other task is busy,
+          // then there will never be more work (NB: 1 is *before* decrement).
+          if (AtomicOperations::FetchAndDecrement(num_busy_) == 1) break;
+
+          // Wait for some work to appear.
+          while (work_stack_->IsEmpty() &&
+                 AtomicOperations::LoadRelaxed(num_busy_) > 0) {
+          }
+
+          // If no tasks are busy, there will never be more work.
+          if (AtomicOperations::LoadRelaxed(num_busy_) == 0) break;
+
+          // I saw some work; get busy and compete for it.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        } while (true);
+        // Wait for all scavengers to stop.
+        barrier_->Sync();
+#if defined(DEBUG)
+        ASSERT(AtomicOperations::LoadRelaxed(num_busy_) == 0);
+        // Caveat: must not allow any scavenger to continue past the barrier
+        // before we checked num_busy, otherwise one of them might rush
+        // ahead and increment it.
+        barrier_->Sync();
+#endif
+        // Check if we have any pending properties with forwarded keys.
+        // Those might have been forwarded by another scavenger.
+        more_to_scavenge = visitor.ProcessPendingWeakProperties();
+        if (more_to_scavenge) {
+          // We have more work to do. Notify others.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        }
+
+        // Wait for all other scavengers to finish processing their pending
+        // weak properties and decide if they need to continue.
+        // Caveat: we need two barriers here to make this decision in lock step
+        // between all scavengers and the main thread.
+        barrier_->Sync();
+        if (!more_to_scavenge &&
+            (AtomicOperations::LoadRelaxed(num_busy_) > 0)) {
+          // All scavengers continue as long as any single scavenger has some
+          // work to do.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+          more_to_scavenge = true;
+        }
+        barrier_->Sync();
+      } while (more_to_scavenge);
+
+      // Every survivor has been copied, so the weak tables can be rehashed.
+      scavenger_->ProcessWeakTableShards(true);
+
+      work_list.Finalize();
+      visitor.Finalize();
+      AtomicOperations::IncrementBy(bytes_promoted_, visitor.bytes_promoted());
+    }
+    Thread::ExitIsolateAsHelper(true);
+
+    // This task is done. Notify the original thread.
+    barrier_->Exit();
+  }
+
+ private:
+  Isolate* isolate_;
+  Scavenger* scavenger_;
+  SemiSpace* from_;
+  ScavengerStack* work_stack_;
+  ThreadBarrier* barrier_;
+  uintptr_t* num_busy_;
+  intptr_t* bytes_promoted_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavengerTask);
+};
+
 // Visitor used to verify that all old->new references have been added to the
 // StoreBuffers.
 class VerifyStoreBufferPointerVisitor : public ObjectPointerVisitor {
@@ -382,9 +763,8 @@ SemiSpace* SemiSpace::New(intptr_t size_in_words, const char* name) {
     return new SemiSpace(nullptr);
   } else {
     intptr_t size_in_bytes = size_in_words << kWordSizeLog2;
-    const bool kExecutable = false;
-    VirtualMemory* memory =
-        VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
+    VirtualMemory* memory = VirtualMemory::AllocateHeap(
+        size_in_bytes, VirtualMemory::PageSize(), name);
     if (memory == nullptr) {
       // TODO(koda): If cache_ is not empty, we could try to delete it.
       return nullptr;
@@ -439,7 +819,12 @@ Scavenger::Scavenger(Heap* heap,
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
       external_size_(0),
-      failed_to_promote_(false) {
+      failed_to_promote_(false),
+      root_slices_started_(0),
+      pending_blocks_(NULL),
+      pending_store_buffer_entries_(0),
+      weak_tables_(),
+      weak_table_shards_started_(0) {
   // Verify assumptions about the first word in objects which the scavenger is
   // going to use for forwarding pointers.
   ASSERT(Object::tags_offset() == 0);
@@ -613,7 +998,7 @@ bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
 }
 
 void Scavenger::IterateStoreBuffers(Isolate* isolate,
-                                    ScavengerVisitor* visitor) {
+                                    SerialScavengerVisitor* visitor) {
   // Iterating through the store buffers.
   // Grab the deduplication sets out of the isolate's consolidated store buffer.
   StoreBufferBlock* pending = isolate->store_buffer()->Blocks();
@@ -649,7 +1034,7 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
 }
 
 void Scavenger::IterateObjectIdTable(Isolate* isolate,
-                                     ScavengerVisitor* visitor) {
+                                     ObjectPointerVisitor* visitor) {
 #ifndef PRODUCT
   if (!FLAG_support_service) {
     return;
@@ -658,7 +1043,8 @@ void Scavenger::IterateObjectIdTable(Isolate* isolate,
 #endif  // !PRODUCT
 }
 
-void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
+void Scavenger::IterateRoots(Isolate* isolate,
+                             SerialScavengerVisitor* visitor) {
 #ifdef SUPPORT_TIMELINE
   Thread* thread = Thread::Current();
 #endif
@@ -681,6 +1067,146 @@ void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
   heap_->RecordTime(kDummyScavengeTime, 0);
 }
 
+enum ScavengerRootSlices {
+  kIsolateRoots = 0,
+  kObjectIdRing = 1,
+  kRememberedCards = 2,
+  kNumScavengerRootSlices = 3,
+};
+
+void Scavenger::IterateRootSlices(Isolate* isolate,
+                                  ParallelScavengerVisitor* visitor) {
+  for (;;) {
+    intptr_t slice =
+        AtomicOperations::FetchAndIncrement(&root_slices_started_);
+    if (slice >= kNumScavengerRootSlices) {
+      break;
+    }
+    switch (slice) {
+      case kIsolateRoots: {
+        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRoots");
+        isolate->VisitObjectPointers(visitor,
+                                     ValidationPolicy::kDontValidateFrames);
+        break;
+      }
+      case kObjectIdRing:
+        IterateObjectIdTable(isolate, visitor);
+        break;
+      case kRememberedCards:
+        heap_->old_space()->VisitRememberedCards(visitor);
+        break;
+      default:
+        FATAL1("%" Pd, slice);
+        UNREACHABLE();
+    }
+  }
+
+  // Claim the store buffer blocks one at a time.
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRememberedSet");
+  for (;;) {
+    StoreBufferBlock* pending;
+    {
+      MutexLocker ml(&pending_blocks_lock_);
+      pending = pending_blocks_;
+      if (pending == NULL) {
+        break;
+      }
+      pending_blocks_ = pending->next();
+    }
+    // Generated code appends to store buffers; tell MemorySanitizer.
+    MSAN_UNPOISON(pending, sizeof(*pending));
+    AtomicOperations::IncrementBy(&pending_store_buffer_entries_,
+                                  pending->Count());
+    while (!pending->IsEmpty()) {
+      RawObject* raw_object = pending->Pop();
+      ASSERT(!raw_object->IsForwardingCorpse());
+      ASSERT(raw_object->IsRemembered());
+      raw_object->ClearRememberedBit();
+      visitor->VisitingOldObject(raw_object);
+      raw_object->VisitPointersNonvirtual(visitor);
+    }
+    visitor->VisitingOldObject(NULL);
+    pending->Reset();
+    // Return the emptied block for recycling (no need to check threshold).
+    isolate->store_buffer()->PushBlock(pending, StoreBuffer::kIgnoreThreshold);
+  }
+}
+
+intptr_t Scavenger::ParallelScavenge(Isolate* isolate, SemiSpace* from) {
+  const intptr_t num_tasks = FLAG_scavenger_tasks;
+  ASSERT(num_tasks > 0);
+
+  // Grab the deduplication sets out of the isolate's consolidated store buffer
+  // before any task starts appending to it.
+  pending_blocks_ = isolate->store_buffer()->Blocks();
+  pending_store_buffer_entries_ = 0;
+  root_slices_started_ = 0;
+
+  ScavengerStack work_stack;
+  intptr_t bytes_promoted = 0;
+  {
+    ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
+                          heap_->barrier_done());
+    // Used to coordinate draining among tasks; all start out as 'busy'.
+    uintptr_t num_busy = num_tasks;
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      bool result = Dart::thread_pool()->Run(new ParallelScavengerTask(
+          isolate, this, from, &work_stack, &barrier, &num_busy,
+          &bytes_promoted));
+      ASSERT(result);
+    }
+    bool more_to_scavenge = false;
+    do {
+      // Wait for all scavengers to stop.
+      barrier.Sync();
+#if defined(DEBUG)
+      ASSERT(AtomicOperations::LoadRelaxed(&num_busy) == 0);
+      // Caveat: must not allow any scavenger to continue past the barrier
+      // before we checked num_busy, otherwise one of them might rush
+      // ahead and increment it.
+      barrier.Sync();
+#endif
+      // Wait for all scavengers to go through weak properties and verify
+      // that there are no more objects to scavenge.
+      barrier.Sync();
+      more_to_scavenge = AtomicOperations::LoadRelaxed(&num_busy) > 0;
+      barrier.Sync();
+    } while (more_to_scavenge);
+    barrier.Exit();
+  }
+  // The barrier's destructor waits for all tasks to exit.
+  ASSERT(pending_blocks_ == NULL);
+  ASSERT(work_stack.IsEmpty());
+  resolved_top_ = top_;
+
+  heap_->RecordData(kStoreBufferEntries, pending_store_buffer_entries_);
+  heap_->RecordData(kDataUnused1, 0);
+  heap_->RecordData(kDataUnused2, 0);
+  return bytes_promoted;
+}
+
+uword Scavenger::TryAllocateGCBuffer(intptr_t min_size, intptr_t* size) {
+  ASSERT(scavenging_);
+  ASSERT(Utils::IsAligned(min_size, kObjectAlignment));
+  ASSERT(Utils::IsAligned(*size, kObjectAlignment));
+  ASSERT(min_size <= *size);
+  for (;;) {
+    uword top = AtomicOperations::LoadRelaxed(&top_);
+    intptr_t remaining = end_ - top;
+    if (remaining < min_size) {
+      return 0;
+    }
+    intptr_t allocated = Utils::Minimum(*size, remaining);
+    if (AtomicOperations::CompareAndSwapWord(&top_, top, top + allocated) ==
+        top) {
+      ASSERT(to_->Contains(top));
+      ASSERT((top & kObjectAlignmentMask) == object_alignment_);
+      *size = allocated;
+      return top;
+    }
+  }
+}
+
 bool Scavenger::IsUnreachable(RawObject** p) {
   RawObject* raw_obj = *p;
   if (!raw_obj->IsHeapObject()) {
@@ -706,7 +1232,7 @@ void Scavenger::IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor) {
   isolate->VisitWeakPersistentHandles(visitor);
 }
 
-void Scavenger::ProcessToSpace(ScavengerVisitor* visitor) {
+void Scavenger::ProcessToSpace(SerialScavengerVisitor* visitor) {
   Thread* thread = Thread::Current();
   NOT_IN_PRODUCT(ClassTable* class_table = thread->isolate()->class_table());
 
@@ -830,7 +1356,7 @@ void Scavenger::EnqueueWeakProperty(RawWeakProperty* raw_weak) {
 }
 
 uword Scavenger::ProcessWeakProperty(RawWeakProperty* raw_weak,
-                                     ScavengerVisitor* visitor) {
+                                     SerialScavengerVisitor* visitor) {
   // The fate of the weak property is determined by its key.
   RawObject* raw_key = raw_weak->ptr()->key_;
   if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
@@ -846,13 +1372,29 @@ uword Scavenger::ProcessWeakProperty(RawWeakProperty* raw_weak,
   return raw_weak->VisitPointersNonvirtual(visitor);
 }
 
-void Scavenger::ProcessWeakReferences() {
-  // Rehash the weak tables now that we know which objects survive this cycle.
+void Scavenger::PrepareWeakTables() {
+  ASSERT(weak_tables_.is_empty());
   for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
-    heap_->SetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel),
-                        WeakTable::NewFrom(table));
+    const Heap::WeakSelector selector = static_cast<Heap::WeakSelector>(sel);
+    WeakTable* table = heap_->GetWeakTable(Heap::kNew, selector);
+    heap_->SetWeakTable(Heap::kNew, selector, WeakTable::NewFrom(table));
+    weak_tables_.Add(table);
+  }
+  weak_table_shards_started_ = 0;
+}
+
+void Scavenger::ProcessWeakTableShards(bool exclusive) {
+  const intptr_t num_shards = weak_tables_.length() * WeakTable::kNumShards;
+  while (true) {
+    const intptr_t index =
+        AtomicOperations::FetchAndIncrement(&weak_table_shards_started_);
+    if (index >= num_shards) {
+      break;
+    }
+    const Heap::WeakSelector sel =
+        static_cast<Heap::WeakSelector>(index / WeakTable::kNumShards);
+    WeakTableShard* table =
+        weak_tables_[sel]->shard(index % WeakTable::kNumShards);
     intptr_t size = table->size();
     for (intptr_t i = 0; i < size; i++) {
       if (table->IsValidEntryAt(i)) {
@@ -864,15 +1406,29 @@ void Scavenger::ProcessWeakReferences() {
           // The object has survived.  Preserve its record.
           uword new_addr = ForwardedAddr(header);
           raw_obj = RawObject::FromAddr(new_addr);
-          heap_->SetWeakEntry(raw_obj, static_cast<Heap::WeakSelector>(sel),
-                              table->ValueAt(i));
+          WeakTable* target = heap_->GetWeakTable(
+              raw_obj->IsNewObject() ? Heap::kNew : Heap::kOld, sel);
+          if (exclusive) {
+            target->SetValueExclusive(raw_obj, table->ValueAt(i));
+          } else {
+            target->SetValue(raw_obj, table->ValueAt(i));
+          }
         }
       }
     }
-    // Remove the old table as it has been replaced with the newly allocated
-    // table above.
-    delete table;
   }
+}
+
+void Scavenger::ProcessWeakReferences() {
+  // Rehash the weak tables now that we know which objects survive this cycle.
+  // Parallel scavenger tasks have already taken care of all the shards.
+  ProcessWeakTableShards(false);
+  // Remove the old tables as they have been replaced with the newly allocated
+  // tables in PrepareWeakTables.
+  for (intptr_t i = 0; i < weak_tables_.length(); i++) {
+    delete weak_tables_[i];
+  }
+  weak_tables_.Clear();
 
   // The queued weak properties at this point do not refer to reachable keys,
   // so we clear their key and value fields.
@@ -923,14 +1479,18 @@ void Scavenger::MakeNewSpaceIterable() const {
 void Scavenger::AbandonTLABs(Isolate* isolate) {
   ASSERT(Thread::Current()->IsAtSafepoint());
   MonitorLocker ml(isolate->threads_lock(), false);
+  Thread* mutator_thread = isolate->mutator_thread();
+  bool mutator_seen = false;
   Thread* current = isolate->thread_registry()->active_list();
   while (current != NULL) {
     heap_->AbandonRemainingTLAB(current);
+    heap_->AdjustTLABSize(current);
+    mutator_seen = mutator_seen || (current == mutator_thread);
     current = current->next();
   }
-  Thread* mutator_thread = isolate->mutator_thread();
-  if (mutator_thread != NULL) {
+  if ((mutator_thread != NULL) && !mutator_seen) {
     heap_->AbandonRemainingTLAB(mutator_thread);
+    heap_->AdjustTLABSize(mutator_thread);
   }
 }
 
@@ -946,6 +1506,45 @@ void Scavenger::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   }
 }
 
+void Scavenger::VisitObjectPointersRecordingBoundaries(
+    ObjectPointerVisitor* visitor,
+    intptr_t interval,
+    MallocGrowableArray<uword>* boundaries) const {
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kMarkerTask));
+  ASSERT(interval > 0);
+  uword cur = FirstObjectStart();
+  const uword end = top_;
+  boundaries->Add(cur);
+  uword next_boundary = cur + interval;
+  while (cur < end) {
+    if (cur >= next_boundary) {
+      boundaries->Add(cur);
+      next_boundary = cur + interval;
+    }
+    RawObject* raw_obj = RawObject::FromAddr(cur);
+    cur += raw_obj->VisitPointers(visitor);
+  }
+  if (boundaries->Last() != cur) {
+    boundaries->Add(cur);
+  }
+}
+
+void Scavenger::VisitObjectPointers(ObjectPointerVisitor* visitor,
+                                    uword start,
+                                    uword end) const {
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kMarkerTask));
+  ASSERT(to_->Contains(start) || (start == top_));
+  ASSERT(end <= top_);
+  uword cur = start;
+  while (cur < end) {
+    RawObject* raw_obj = RawObject::FromAddr(cur);
+    cur += raw_obj->VisitPointers(visitor);
+  }
+  ASSERT(cur == end);
+}
+
 void Scavenger::VisitObjects(ObjectVisitor* visitor) const {
   ASSERT(Thread::Current()->IsAtSafepoint() ||
          (Thread::Current()->task_kind() == Thread::kMarkerTask));
@@ -1046,18 +1645,35 @@ void Scavenger::Scavenge() {
   intptr_t promo_candidate_words =
       (survivor_end_ - FirstObjectStart()) / kWordSize;
   SemiSpace* from = Prologue(isolate);
+  PrepareWeakTables();
   // The API prologue/epilogue may create/destroy zones, so we must not
   // depend on zone allocations surviving beyond the epilogue callback.
   {
     StackZone zone(thread);
-    // Setup the visitor and run the scavenge.
-    ScavengerVisitor visitor(isolate, this, from);
-    page_space->AcquireDataLock();
-    IterateRoots(isolate, &visitor);
-    int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
-    {
-      TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessToSpace");
-      ProcessToSpace(&visitor);
+    const bool parallel = FLAG_scavenger_tasks > 0;
+    intptr_t bytes_promoted = 0;
+    int64_t iterate_roots;
+    if (parallel) {
+      // The tasks share the roots and the copying work, so there is no
+      // separate root phase to time. Each task takes the data lock only
+      // while refilling its promotion buffer.
+      iterate_roots = OS::GetCurrentMonotonicMicros();
+      heap_->RecordTime(kVisitIsolateRoots, 0);
+      heap_->RecordTime(kIterateStoreBuffers, 0);
+      heap_->RecordTime(kDummyScavengeTime, 0);
+      bytes_promoted = ParallelScavenge(isolate, from);
+      heap_->RecordData(kToKBAfterStoreBuffer, RoundWordsToKB(UsedInWords()));
+    } else {
+      // Setup the visitor and run the scavenge.
+      SerialScavengerVisitor visitor(isolate, this, from, NULL);
+      page_space->AcquireDataLock();
+      IterateRoots(isolate, &visitor);
+      iterate_roots = OS::GetCurrentMonotonicMicros();
+      {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessToSpace");
+        ProcessToSpace(&visitor);
+      }
+      bytes_promoted = visitor.bytes_promoted();
     }
     int64_t process_to_space = OS::GetCurrentMonotonicMicros();
     {
@@ -1066,18 +1682,28 @@ void Scavenger::Scavenge() {
       IterateWeakRoots(isolate, &weak_visitor);
     }
     ProcessWeakReferences();
-    page_space->ReleaseDataLock();
+    if (!parallel) {
+      page_space->ReleaseDataLock();
+    }
 
     // Scavenge finished. Run accounting.
     int64_t end = OS::GetCurrentMonotonicMicros();
     heap_->RecordTime(kProcessToSpace, process_to_space - iterate_roots);
     heap_->RecordTime(kIterateWeaks, end - process_to_space);
-    stats_history_.Add(ScavengeStats(
-        start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-        visitor.bytes_promoted() >> kWordSizeLog2));
+    stats_history_.Add(ScavengeStats(start, end, usage_before,
+                                     GetCurrentUsage(), promo_candidate_words,
+                                     bytes_promoted >> kWordSizeLog2));
   }
   Epilogue(isolate, from);
 
+  // Objects which optimized code stores into without a barrier may have been
+  // promoted.
+  Thread* mutator_thread = isolate->mutator_thread();
+  if (mutator_thread != NULL) {
+    mutator_thread->RestoreWriteBarrierInvariant(
+        Thread::kAddToRememberedSet);
+  }
+
   // TODO(koda): Make verification more compatible with concurrent sweep.
   if (FLAG_verify_after_gc && !FLAG_concurrent_sweep) {
     OS::PrintErr("Verifying after Scavenge...");
@@ -6,10 +6,12 @@
 #define RUNTIME_VM_HEAP_SCAVENGER_H_
 
 #include "platform/assert.h"
+#include "platform/growable_array.h"
 #include "platform/utils.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/pointer_block.h"
 #include "vm/heap/spaces.h"
 #include "vm/lockers.h"
 #include "vm/raw_object.h"
@@ -24,7 +26,11 @@ class Heap;
 class Isolate;
 class JSONObject;
 class ObjectSet;
-class ScavengerVisitor;
+class WeakTable;
+template <bool parallel>
+class ScavengerVisitorBase;
+typedef ScavengerVisitorBase<false> SerialScavengerVisitor;
+typedef ScavengerVisitorBase<true> ParallelScavengerVisitor;
 
 // Wrapper around VirtualMemory that adds caching and handles the empty case.
 class SemiSpace {
@@ -195,6 +201,25 @@ class Scavenger {
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Visits all object pointers like VisitObjectPointers, recording in
+  // [boundaries] the start of the first object, the start of an object about
+  // every [interval] bytes and the end of the last object. Objects in
+  // to-space do not move until the next scavenge and new objects are only
+  // allocated past the last one (or into the filler at the end of a TLAB), so
+  // the recorded addresses stay object boundaries until then.
+  // The caller must have made new space iterable.
+  void VisitObjectPointersRecordingBoundaries(
+      ObjectPointerVisitor* visitor,
+      intptr_t interval,
+      MallocGrowableArray<uword>* boundaries) const;
+
+  // Visits the pointers of the objects in [start, end), which must be object
+  // boundaries, e.g. recorded by VisitObjectPointersRecordingBoundaries since
+  // the last scavenge. The caller must have made new space iterable.
+  void VisitObjectPointers(ObjectPointerVisitor* visitor,
+                           uword start,
+                           uword end) const;
+
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
   void WriteProtect(bool read_only);
@@ -239,16 +264,24 @@ class Scavenger {
 
   uword FirstObjectStart() const { return to_->start() | object_alignment_; }
   SemiSpace* Prologue(Isolate* isolate);
-  void IterateStoreBuffers(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateObjectIdTable(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateRoots(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakProperties(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakReferences(Isolate* isolate, ScavengerVisitor* visitor);
+  void IterateStoreBuffers(Isolate* isolate, SerialScavengerVisitor* visitor);
+  void IterateObjectIdTable(Isolate* isolate, ObjectPointerVisitor* visitor);
+  void IterateRoots(Isolate* isolate, SerialScavengerVisitor* visitor);
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
-  void ProcessToSpace(ScavengerVisitor* visitor);
+  void ProcessToSpace(SerialScavengerVisitor* visitor);
   void EnqueueWeakProperty(RawWeakProperty* raw_weak);
   uword ProcessWeakProperty(RawWeakProperty* raw_weak,
-                            ScavengerVisitor* visitor);
+                            SerialScavengerVisitor* visitor);
+
+  // Runs the copying phase of the scavenge in FLAG_scavenger_tasks helper
+  // tasks. Returns the number of bytes promoted.
+  intptr_t ParallelScavenge(Isolate* isolate, SemiSpace* from);
+  // Called by each parallel task to claim and scavenge root slices and store
+  // buffer blocks until none are left.
+  void IterateRootSlices(Isolate* isolate, ParallelScavengerVisitor* visitor);
+  // Atomically carves a buffer of at most *size and at least min_size bytes
+  // out of the to space. On success, *size holds the actual size.
+  uword TryAllocateGCBuffer(intptr_t min_size, intptr_t* size);
   void Epilogue(Isolate* isolate, SemiSpace* from);
 
   bool IsUnreachable(RawObject** p);
@@ -280,6 +313,13 @@ class Scavenger {
 
   void ProcessWeakReferences();
 
+  // Swaps fresh tables in for the new-space weak tables. Their entries are
+  // moved over shard by shard once it is known which objects survive.
+  void PrepareWeakTables();
+  // Claims and processes shards until none are left. Several parallel
+  // scavenger tasks share the work when 'exclusive' is set.
+  void ProcessWeakTableShards(bool exclusive);
+
   intptr_t NewSizeInWords(intptr_t old_size_in_words) const;
 
   uword top_;
@@ -323,8 +363,22 @@ class Scavenger {
   // Protects new space during the allocation of new TLABs
   Mutex space_lock_;
 
-  friend class ScavengerVisitor;
+  // Work shared by the parallel scavenger tasks: the next root slice to claim
+  // and the store buffer blocks that have not yet been claimed.
+  intptr_t root_slices_started_;
+  Mutex pending_blocks_lock_;
+  StoreBufferBlock* pending_blocks_;
+  intptr_t pending_store_buffer_entries_;
+
+  // The new-space weak tables as of the start of the scavenge and the next of
+  // their shards to be processed.
+  MallocGrowableArray<WeakTable*> weak_tables_;
+  intptr_t weak_table_shards_started_;
+
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class ScavengerWeakVisitor;
+  friend class ParallelScavengerTask;
 
   DISALLOW_COPY_AND_ASSIGN(Scavenger);
 };
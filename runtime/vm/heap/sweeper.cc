@@ -110,17 +110,29 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
                         PageSpace* old_space,
                         HeapPage* first,
                         HeapPage* last,
-                        FreeList* freelist)
+                        HeapPage* large_first,
+                        HeapPage* large_last,
+                        HeapPage* exec_first,
+                        HeapPage* exec_last,
+                        FreeList* freelist,
+                        FreeList* exec_freelist)
       : task_isolate_(isolate),
         old_space_(old_space),
         first_(first),
         last_(last),
-        freelist_(freelist) {
+        large_first_(large_first),
+        large_last_(large_last),
+        exec_first_(exec_first),
+        exec_last_(exec_last),
+        freelist_(freelist),
+        exec_freelist_(exec_freelist) {
     ASSERT(task_isolate_ != NULL);
-    ASSERT(first_ != NULL);
     ASSERT(old_space_ != NULL);
-    ASSERT(last_ != NULL);
+    ASSERT((first_ == NULL) == (last_ == NULL));
+    ASSERT((large_first_ == NULL) == (large_last_ == NULL));
+    ASSERT((exec_first_ == NULL) == (exec_last_ == NULL));
     ASSERT(freelist_ != NULL);
+    ASSERT(exec_freelist_ != NULL);
     MonitorLocker ml(old_space_->tasks_lock());
     old_space_->set_tasks(old_space_->tasks() + 1);
     old_space_->set_phase(PageSpace::kSweeping);
@@ -134,6 +146,14 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
       Thread* thread = Thread::Current();
       TIMELINE_FUNCTION_GC_DURATION(thread, "ConcurrentSweep");
       GCSweeper sweeper;
+      // Large pages first: they are cheap to sweep and give back the most
+      // capacity per page.
+      if (large_first_ != NULL) {
+        SweepLargePages(&sweeper);
+      }
+      if (exec_first_ != NULL) {
+        SweepExecutablePages(&sweeper);
+      }
 
       HeapPage* page = first_;
       HeapPage* prev_page = NULL;
@@ -148,12 +168,7 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
         } else {
           old_space_->FreePage(page, prev_page);
         }
-        {
-          // Notify the mutator thread that we have added elements to the free
-          // list or that more capacity is available.
-          MonitorLocker ml(old_space_->tasks_lock());
-          ml.Notify();
-        }
+        NotifyProgress();
         if (page == last_) break;
         page = next_page;
       }
@@ -171,19 +186,117 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
   }
 
  private:
+  // Notify the mutator thread that we have added elements to the free list or
+  // that more capacity is available.
+  void NotifyProgress() {
+    MonitorLocker ml(old_space_->tasks_lock());
+    ml.Notify();
+  }
+
+  // Code pages are read-only (or read-execute) outside of the pause. A page
+  // being swept is made writable under the pages lock, which the mutator also
+  // holds when it links a new page behind the tail of a list. The last page
+  // kept stays writable until the next one is kept, because freeing the pages
+  // in between writes its next field.
+  static void SetCodePageWritable(HeapPage* page, bool writable) {
+    if (PageSpace::CodeProtectedInPlace() &&
+        (page->type() == HeapPage::kExecutable)) {
+      page->WriteProtect(!writable);
+    }
+  }
+
+  void SweepLargePages(GCSweeper* sweeper) {
+    HeapPage* page = large_first_;
+    HeapPage* prev_page = NULL;
+    while (page != NULL) {
+      intptr_t words_to_end;
+      HeapPage* next_page;
+      {
+        MutexLocker ml(old_space_->pages_lock_);
+        next_page = page->next();
+        SetCodePageWritable(page, true);
+        words_to_end = sweeper->SweepLargePage(page);
+      }
+      const bool is_last = (page == large_last_);
+      if (words_to_end == 0) {
+        old_space_->FreeLargePage(page, prev_page);
+      } else {
+        old_space_->TruncateLargePage(page, words_to_end << kWordSizeLog2);
+        if (prev_page != NULL) {
+          MutexLocker ml(old_space_->pages_lock_);
+          SetCodePageWritable(prev_page, false);
+        }
+        prev_page = page;
+      }
+      NotifyProgress();
+      if (is_last) break;
+      page = next_page;
+    }
+    if (prev_page != NULL) {
+      MutexLocker ml(old_space_->pages_lock_);
+      SetCodePageWritable(prev_page, false);
+    }
+  }
+
+  void SweepExecutablePages(GCSweeper* sweeper) {
+    // Hold the freelist lock throughout, so no code is allocated into the
+    // pages while their protection changes under the allocator.
+    MutexLocker mle(exec_freelist_->mutex());
+    HeapPage* page = exec_first_;
+    HeapPage* prev_page = NULL;
+    while (page != NULL) {
+      ASSERT(page->type() == HeapPage::kExecutable);
+      bool page_in_use;
+      HeapPage* next_page;
+      {
+        MutexLocker ml(old_space_->pages_lock_);
+        next_page = page->next();
+        SetCodePageWritable(page, true);
+        page_in_use = sweeper->SweepPage(page, exec_freelist_, true);
+      }
+      const bool is_last = (page == exec_last_);
+      if (page_in_use) {
+        if (prev_page != NULL) {
+          MutexLocker ml(old_space_->pages_lock_);
+          SetCodePageWritable(prev_page, false);
+        }
+        prev_page = page;
+      } else {
+        old_space_->FreePage(page, prev_page);
+      }
+      if (is_last) break;
+      page = next_page;
+    }
+    if (prev_page != NULL) {
+      MutexLocker ml(old_space_->pages_lock_);
+      SetCodePageWritable(prev_page, false);
+    }
+  }
+
   Isolate* task_isolate_;
   PageSpace* old_space_;
   HeapPage* first_;
   HeapPage* last_;
+  HeapPage* large_first_;
+  HeapPage* large_last_;
+  HeapPage* exec_first_;
+  HeapPage* exec_last_;
   FreeList* freelist_;
+  FreeList* exec_freelist_;
 };
 
 void GCSweeper::SweepConcurrent(Isolate* isolate,
                                 HeapPage* first,
                                 HeapPage* last,
-                                FreeList* freelist) {
+                                HeapPage* large_first,
+                                HeapPage* large_last,
+                                HeapPage* exec_first,
+                                HeapPage* exec_last,
+                                FreeList* freelist,
+                                FreeList* exec_freelist) {
   bool result = Dart::thread_pool()->Run(new ConcurrentSweeperTask(
-      isolate, isolate->heap()->old_space(), first, last, freelist));
+      isolate, isolate->heap()->old_space(), first, last, large_first,
+      large_last, exec_first, exec_last, freelist, exec_freelist));
   ASSERT(result);
 }
 
@@ -34,11 +34,18 @@ class GCSweeper {
   // last marked object.
   intptr_t SweepLargePage(HeapPage* page);
 
-  // Sweep the regular sized data pages between first and last inclusive.
+  // Sweep the regular sized data pages between first and last inclusive, the
+  // large pages between large_first and large_last and the executable pages
+  // between exec_first and exec_last. Empty lists are passed as NULL.
   static void SweepConcurrent(Isolate* isolate,
                               HeapPage* first,
                               HeapPage* last,
-                              FreeList* freelist);
+                              HeapPage* large_first,
+                              HeapPage* large_last,
+                              HeapPage* exec_first,
+                              HeapPage* exec_last,
+                              FreeList* freelist,
+                              FreeList* exec_freelist);
 };
 
 }  // namespace dart
@@ -5,11 +5,12 @@
 #include "vm/heap/weak_table.h"
 
 #include "platform/assert.h"
+#include "vm/lockers.h"
 #include "vm/raw_object.h"
 
 namespace dart {
 
-intptr_t WeakTable::SizeFor(intptr_t count, intptr_t size) {
+intptr_t WeakTableShard::SizeFor(intptr_t count, intptr_t size) {
   intptr_t result = size;
   if (count <= (size / 4)) {
     // Reduce the capacity.
@@ -29,7 +30,7 @@ intptr_t WeakTable::SizeFor(intptr_t count, intptr_t size) {
   return result;
 }
 
-void WeakTable::SetValue(RawObject* key, intptr_t val) {
+void WeakTableShard::SetValue(RawObject* key, intptr_t val) {
   intptr_t mask = size() - 1;
   intptr_t idx = Hash(key) & mask;
   intptr_t empty_idx = -1;
@@ -74,28 +75,31 @@ void WeakTable::SetValue(RawObject* key, intptr_t val) {
   }
 }
 
-void WeakTable::Reset() {
+void WeakTableShard::Reset() {
+  Reset(kMinSize);
+}
+
+void WeakTableShard::Reset(intptr_t size) {
+  ASSERT(Utils::IsPowerOfTwo(size));
+  if (size < kMinSize) {
+    size = kMinSize;
+  }
+  // Get a max size that avoids overflows.
+  const intptr_t kMaxSize =
+      (kIntptrOne << (kBitsPerWord - 2)) / (kEntrySize * kWordSize);
+  ASSERT(Utils::IsPowerOfTwo(kMaxSize));
+  if (size > kMaxSize) {
+    size = kMaxSize;
+  }
   intptr_t* old_data = data_;
   used_ = 0;
   count_ = 0;
-  size_ = kMinSize;
+  size_ = size;
   free(old_data);
   data_ = reinterpret_cast<intptr_t*>(calloc(size_, kEntrySize * kWordSize));
 }
 
-void WeakTable::Forward(ObjectPointerVisitor* visitor) {
-  if (used_ == 0) return;
-
-  for (intptr_t i = 0; i < size_; i++) {
-    if (IsValidEntryAt(i)) {
-      visitor->VisitPointer(ObjectPointerAt(i));
-    }
-  }
-
-  Rehash();
-}
-
-void WeakTable::Rehash() {
+void WeakTableShard::Rehash() {
   intptr_t old_size = size();
   intptr_t* old_data = data_;
 
@@ -132,4 +136,60 @@ void WeakTable::Rehash() {
   free(old_data);
 }
 
+WeakTable::WeakTable(intptr_t size) {
+  const intptr_t shard_size = Utils::RoundUpToPowerOfTwo(
+      Utils::Maximum<intptr_t>(size / kNumShards, 1));
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    shards_[i].Reset(shard_size);
+  }
+}
+
+WeakTable* WeakTable::NewFrom(WeakTable* original) {
+  // Entries usually land in a different shard once their objects move, so
+  // size every shard for an even share of the entries.
+  WeakTable* result = new WeakTable();
+  const intptr_t size = WeakTableShard::SizeFor(
+      original->count() / kNumShards, original->size() / kNumShards);
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    result->shards_[i].Reset(Utils::RoundUpToPowerOfTwo(size));
+  }
+  return result;
+}
+
+void WeakTable::SetValueExclusive(RawObject* key, intptr_t val) {
+  const intptr_t index = ShardIndex(key);
+  MutexLocker ml(&locks_[index]);
+  shards_[index].SetValue(key, val);
+}
+
+intptr_t WeakTable::size() const {
+  intptr_t result = 0;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    result += shards_[i].size();
+  }
+  return result;
+}
+
+intptr_t WeakTable::used() const {
+  intptr_t result = 0;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    result += shards_[i].used();
+  }
+  return result;
+}
+
+intptr_t WeakTable::count() const {
+  intptr_t result = 0;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    result += shards_[i].count();
+  }
+  return result;
+}
+
+void WeakTable::Reset() {
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    shards_[i].Reset();
+  }
+}
+
 }  // namespace dart
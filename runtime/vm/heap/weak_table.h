@@ -8,39 +8,20 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "vm/os_thread.h"
 #include "vm/raw_object.h"
 
 namespace dart {
 
-class WeakTable {
+// An open-addressed hash table from objects to values. A WeakTable spreads its
+// entries over several of these.
+class WeakTableShard {
  public:
-  WeakTable() : size_(kMinSize), used_(0), count_(0) {
+  WeakTableShard() : size_(kMinSize), used_(0), count_(0) {
     ASSERT(Utils::IsPowerOfTwo(size_));
     data_ = reinterpret_cast<intptr_t*>(calloc(size_, kEntrySize * kWordSize));
   }
-  explicit WeakTable(intptr_t size) : used_(0), count_(0) {
-    ASSERT(size >= 0);
-    ASSERT(Utils::IsPowerOfTwo(kMinSize));
-    if (size < kMinSize) {
-      size = kMinSize;
-    }
-    // Get a max size that avoids overflows.
-    const intptr_t kMaxSize =
-        (kIntptrOne << (kBitsPerWord - 2)) / (kEntrySize * kWordSize);
-    ASSERT(Utils::IsPowerOfTwo(kMaxSize));
-    if (size > kMaxSize) {
-      size = kMaxSize;
-    }
-    size_ = size;
-    ASSERT(Utils::IsPowerOfTwo(size_));
-    data_ = reinterpret_cast<intptr_t*>(calloc(size_, kEntrySize * kWordSize));
-  }
-
-  ~WeakTable() { free(data_); }
-
-  static WeakTable* NewFrom(WeakTable* original) {
-    return new WeakTable(SizeFor(original->count(), original->size()));
-  }
+  ~WeakTableShard() { free(data_); }
 
   intptr_t size() const { return size_; }
   intptr_t used() const { return used_; }
@@ -107,10 +88,17 @@ class WeakTable {
     return 0;
   }
 
-  void Forward(ObjectPointerVisitor* visitor);
-
   void Reset();
 
+  // Resets this shard to an empty table of at least 'size' entries.
+  void Reset(intptr_t size);
+
+  static intptr_t SizeFor(intptr_t count, intptr_t size);
+
+  static intptr_t Hash(RawObject* key) {
+    return reinterpret_cast<uintptr_t>(key) * 92821;
+  }
+
  private:
   enum {
     kObjectOffset = 0,
@@ -121,7 +109,6 @@ class WeakTable {
   static const intptr_t kDeletedEntry = 1;  // Equivalent to a tagged NULL.
   static const intptr_t kMinSize = 8;
 
-  static intptr_t SizeFor(intptr_t count, intptr_t size);
   static intptr_t LimitFor(intptr_t size) {
     // Maintain a maximum of 75% fill rate.
     return 3 * (size / 4);
@@ -170,10 +157,6 @@ class WeakTable {
 
   void Rehash();
 
-  static intptr_t Hash(RawObject* key) {
-    return reinterpret_cast<uintptr_t>(key) * 92821;
-  }
-
   // data_ contains size_ tuples of key/value.
   intptr_t* data_;
   // size_ keeps the number of entries in data_. used_ maintains the number of
@@ -183,6 +166,66 @@ class WeakTable {
   intptr_t used_;
   intptr_t count_;
 
+  DISALLOW_COPY_AND_ASSIGN(WeakTableShard);
+};
+
+// Maps objects to values for peers, identity hashes and object ids. The
+// entries are spread over kNumShards shards by the high bits of their hash.
+// A shard grows by rehashing only itself, so no single insertion rebuilds the
+// whole table, and GC workers process the shards of a table in parallel.
+class WeakTable {
+ public:
+  static const intptr_t kNumShardsLog2 = 4;
+  static const intptr_t kNumShards = 1 << kNumShardsLog2;
+
+  WeakTable() {}
+  // Sizes the shards for 'size' entries in total.
+  explicit WeakTable(intptr_t size);
+
+  // Returns an empty table sized for the entries of 'original'.
+  static WeakTable* NewFrom(WeakTable* original);
+
+  intptr_t size() const;
+  intptr_t used() const;
+  intptr_t count() const;
+
+  WeakTableShard* shard(intptr_t index) {
+    ASSERT((index >= 0) && (index < kNumShards));
+    return &shards_[index];
+  }
+
+  void SetValue(RawObject* key, intptr_t val) {
+    ShardFor(key)->SetValue(key, val);
+  }
+
+  // Same as SetValue, but may be called from several GC workers at once.
+  void SetValueExclusive(RawObject* key, intptr_t val);
+
+  intptr_t GetValue(RawObject* key) const {
+    return shards_[ShardIndex(key)].GetValue(key);
+  }
+
+  // Removes and returns the value associated with |key|. Returns 0 if there is
+  // no value associated with |key|.
+  intptr_t RemoveValue(RawObject* key) {
+    return ShardFor(key)->RemoveValue(key);
+  }
+
+  void Reset();
+
+ private:
+  static intptr_t ShardIndex(RawObject* key) {
+    // The shards use the low bits of the hash to place their entries.
+    return static_cast<uintptr_t>(WeakTableShard::Hash(key)) >>
+           (kBitsPerWord - kNumShardsLog2);
+  }
+  WeakTableShard* ShardFor(RawObject* key) {
+    return &shards_[ShardIndex(key)];
+  }
+
+  WeakTableShard shards_[kNumShards];
+  Mutex locks_[kNumShards];
+
   DISALLOW_COPY_AND_ASSIGN(WeakTable);
 };
 
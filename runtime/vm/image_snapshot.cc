@@ -31,6 +31,13 @@ DEFINE_FLAG(charp,
             print_instructions_sizes_to,
             NULL,
             "Print sizes of all instruction objects to the given file");
+
+DEFINE_FLAG(charp,
+            print_instructions_map_to,
+            NULL,
+            "Print the build id of the isolate instructions image and the "
+            "offsets of all instruction objects in it to the given file, for "
+            "symbolizing --dwarf_stack_traces offline");
 #endif
 
 DEFINE_FLAG(bool,
@@ -204,6 +211,11 @@ void ImageWriter::DumpInstructionStats() {
   CombinedCodeStatistics instruction_stats;
   for (intptr_t i = 0; i < instructions_.length(); i++) {
     auto& data = instructions_[i];
+    const bool is_trampoline = data.trampline_length > 0;
+    if (is_trampoline) {
+      instruction_stats.AddTrampoline(data.trampline_length);
+      continue;
+    }
     CodeStatistics* stats = data.insns_->stats();
     if (stats != nullptr) {
       stats->AppendTo(&instruction_stats);
@@ -226,8 +238,15 @@ void ImageWriter::DumpInstructionsSizes() {
   js.OpenArray();
   for (intptr_t i = 0; i < instructions_.length(); i++) {
     auto& data = instructions_[i];
-    owner = data.code_->owner();
+    const bool is_trampoline = data.trampline_length > 0;
     js.OpenObject();
+    if (is_trampoline) {
+      js.PrintProperty("n", "[Trampoline]");
+      js.PrintProperty("s", data.trampline_length);
+      js.CloseObject();
+      continue;
+    }
+    owner = data.code_->owner();
     if (owner.IsFunction()) {
       cls = Function::Cast(owner).Owner();
       name = cls.ScrubbedName();
@@ -264,6 +283,52 @@ void ImageWriter::DumpInstructionsSizes() {
   file_close(file);
 }
 
+void ImageWriter::DumpInstructionsMap() {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    return;
+  }
+
+  JSONWriter js;
+  js.OpenObject();
+  js.PrintfProperty("build_id", "%016" Px64, build_id_);
+  js.OpenArray("instructions");
+  for (intptr_t i = 0; i < instructions_.length(); i++) {
+    auto& data = instructions_[i];
+    const bool is_trampoline = data.trampline_length > 0;
+    js.OpenObject();
+    // Offsets are relative to the start of the image, like the ones in
+    // stack traces.
+    js.PrintProperty64("o", data.text_offset_);
+    if (is_trampoline) {
+      js.PrintProperty("n", "[Trampoline]");
+      js.PrintProperty64("s", data.trampline_length);
+    } else {
+      js.PrintProperty("n", data.code_->QualifiedName());
+      js.PrintProperty64("s", data.insns_->raw()->HeapSize());
+    }
+    js.CloseObject();
+  }
+  js.CloseArray();
+  js.CloseObject();
+
+  auto file = file_open(FLAG_print_instructions_map_to, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("Failed to open file %s\n", FLAG_print_instructions_map_to);
+    return;
+  }
+
+  char* output = nullptr;
+  intptr_t output_length = 0;
+  js.Steal(&output, &output_length);
+  file_write(output, output_length, file);
+  free(output);
+  file_close(file);
+}
+
 void ImageWriter::DumpStatistics() {
   if (FLAG_print_instruction_stats) {
     DumpInstructionStats();
@@ -272,9 +337,42 @@ void ImageWriter::DumpStatistics() {
   if (FLAG_print_instructions_sizes_to != nullptr) {
     DumpInstructionsSizes();
   }
+
+  if (FLAG_print_instructions_map_to != nullptr) {
+    DumpInstructionsMap();
+  }
 }
 #endif
 
+void ImageWriter::ComputeBuildId() {
+  // FNV-1a over the bytes of all instructions in the order they are written.
+  uint64_t hash = 0xcbf29ce484222325;
+  NoSafepointScope no_safepoint;
+  for (intptr_t i = 0; i < instructions_.length(); i++) {
+    const InstructionsData& data = instructions_[i];
+    const uint8_t* bytes;
+    intptr_t length;
+    if (data.trampoline_bytes != nullptr) {
+      bytes = data.trampoline_bytes;
+      length = data.trampline_length;
+    } else {
+      bytes = reinterpret_cast<const uint8_t*>(data.insns_->PayloadStart());
+      length = data.insns_->Size();
+    }
+    for (intptr_t j = 0; j < length; j++) {
+      hash = (hash ^ bytes[j]) * 0x100000001b3;
+    }
+  }
+  build_id_ = hash;
+}
+
+void ImageWriter::FillTextHeader(uword* header) const {
+  memset(header, 0, Image::kHeaderSize);
+  header[0] = next_text_offset_;
+  memmove(reinterpret_cast<uint8_t*>(header) + Image::kBuildIdOffset,
+          &build_id_, sizeof(build_id_));
+}
+
 void ImageWriter::Write(WriteStream* clustered_stream, bool vm) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -308,6 +406,7 @@ void ImageWriter::Write(WriteStream* clustered_stream, bool vm) {
 
   offset_space_ = vm ? V8SnapshotProfileWriter::kVmText
                      : V8SnapshotProfileWriter::kIsolateText;
+  ComputeBuildId();
   WriteText(clustered_stream, vm);
 }
 
@@ -420,11 +519,11 @@ void AssemblyImageWriter::WriteText(WriteStream* clustered_stream, bool vm) {
 
   // This head also provides the gap to make the instructions snapshot
   // look like a HeapPage.
-  intptr_t instructions_length = next_text_offset_;
-  WriteWordLiteralText(instructions_length);
-  intptr_t header_words = Image::kHeaderSize / sizeof(uword);
-  for (intptr_t i = 1; i < header_words; i++) {
-    WriteWordLiteralText(0);
+  const intptr_t header_words = Image::kHeaderSize / sizeof(uword);
+  uword header[header_words];
+  FillTextHeader(header);
+  for (intptr_t i = 0; i < header_words; i++) {
+    WriteWordLiteralText(header[i]);
   }
 
   FrameUnwindPrologue();
@@ -695,11 +794,11 @@ intptr_t BlobImageWriter::WriteByteSequence(uword start, uword end) {
 void BlobImageWriter::WriteText(WriteStream* clustered_stream, bool vm) {
   // This header provides the gap to make the instructions snapshot look like a
   // HeapPage.
-  intptr_t instructions_length = next_text_offset_;
-  instructions_blob_stream_.WriteWord(instructions_length);
-  intptr_t header_words = Image::kHeaderSize / sizeof(uword);
-  for (intptr_t i = 1; i < header_words; i++) {
-    instructions_blob_stream_.WriteWord(0);
+  const intptr_t header_words = Image::kHeaderSize / sizeof(uword);
+  uword header[header_words];
+  FillTextHeader(header);
+  for (intptr_t i = 0; i < header_words; i++) {
+    instructions_blob_stream_.WriteWord(header[i]);
   }
 
   intptr_t text_offset = 0;
@@ -46,7 +46,24 @@ class Image : ValueObject {
     return snapshot_size - kHeaderSize;
   }
 
+  bool Contains(uword address) const {
+    const uword start = reinterpret_cast<uword>(raw_memory_);
+    const uword size = *reinterpret_cast<const uword*>(raw_memory_);
+    return (address >= start) && (address - start < size);
+  }
+
+  // Identifies the instructions of an instructions image, so that offsets
+  // into it can be symbolized offline with the matching build's debugging
+  // information. Zero for data images.
+  uint64_t build_id() const {
+    const uint8_t* start = reinterpret_cast<const uint8_t*>(raw_memory_);
+    uint64_t id;
+    memmove(&id, start + kBuildIdOffset, sizeof(id));
+    return id;
+  }
+
   static const intptr_t kHeaderSize = OS::kMaxPreferredCodeAlignment;
+  static const intptr_t kBuildIdOffset = 8;
 
  private:
   const void* raw_memory_;  // The symbol kInstructionsSnapshot.
@@ -186,6 +203,14 @@ class ImageWriter : public ValueObject {
 
   void DumpInstructionStats();
   void DumpInstructionsSizes();
+  void DumpInstructionsMap();
+
+  // Hashes the instructions to be written, which must happen before
+  // WriteText releases the trampolines.
+  void ComputeBuildId();
+  // Fills the header of the instructions image: its length, followed by the
+  // build id and zeros.
+  void FillTextHeader(uword* header) const;
 
   struct InstructionsData {
     InstructionsData(RawInstructions* insns,
@@ -237,6 +262,7 @@ class ImageWriter : public ValueObject {
   ObjectOffsetMap shared_objects_;
   ObjectOffsetMap shared_instructions_;
   ObjectOffsetMap reuse_instructions_;
+  uint64_t build_id_ = 0;
 
   V8SnapshotProfileWriter::IdSpace offset_space_ =
       V8SnapshotProfileWriter::kSnapshot;
@@ -270,12 +270,12 @@ SwitchableCallPatternBase::SwitchableCallPatternBase(const Code& code)
       target_pool_index_(-1) {}
 
 RawObject* SwitchableCallPatternBase::data() const {
-  return object_pool_.ObjectAt(data_pool_index_);
+  return object_pool_.ObjectAtAcquire(data_pool_index_);
 }
 
 void SwitchableCallPatternBase::SetData(const Object& data) const {
   ASSERT(!Object::Handle(object_pool_.ObjectAt(data_pool_index_)).IsCode());
-  object_pool_.SetObjectAt(data_pool_index_, data);
+  object_pool_.SetObjectAtRelease(data_pool_index_, data);
 }
 
 SwitchableCallPattern::SwitchableCallPattern(uword pc, const Code& code)
@@ -294,11 +294,12 @@ SwitchableCallPattern::SwitchableCallPattern(uword pc, const Code& code)
 }
 
 RawCode* SwitchableCallPattern::target() const {
-  return reinterpret_cast<RawCode*>(object_pool_.ObjectAt(target_pool_index_));
+  return reinterpret_cast<RawCode*>(
+      object_pool_.ObjectAtAcquire(target_pool_index_));
 }
 void SwitchableCallPattern::SetTarget(const Code& target) const {
   ASSERT(Object::Handle(object_pool_.ObjectAt(target_pool_index_)).IsCode());
-  object_pool_.SetObjectAt(target_pool_index_, target);
+  object_pool_.SetObjectAtRelease(target_pool_index_, target);
 }
 
 BareSwitchableCallPattern::BareSwitchableCallPattern(uword pc, const Code& code)
@@ -318,7 +319,7 @@ BareSwitchableCallPattern::BareSwitchableCallPattern(uword pc, const Code& code)
 }
 
 RawCode* BareSwitchableCallPattern::target() const {
-  const uword pc = object_pool_.RawValueAt(target_pool_index_);
+  const uword pc = object_pool_.RawValueAtAcquire(target_pool_index_);
   auto rct = Isolate::Current()->reverse_pc_lookup_cache();
   if (rct->Contains(pc)) {
     return rct->Lookup(pc);
@@ -333,8 +334,8 @@ RawCode* BareSwitchableCallPattern::target() const {
 void BareSwitchableCallPattern::SetTarget(const Code& target) const {
   ASSERT(object_pool_.TypeAt(target_pool_index_) ==
          ObjectPool::EntryType::kImmediate);
-  object_pool_.SetRawValueAt(target_pool_index_,
-                             target.MonomorphicEntryPoint());
+  object_pool_.SetRawValueAtRelease(target_pool_index_,
+                                    target.MonomorphicEntryPoint());
 }
 
 ReturnPattern::ReturnPattern(uword pc) : pc_(pc) {}
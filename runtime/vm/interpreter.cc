@@ -21,6 +21,7 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/os_thread.h"
 #include "vm/stack_frame_kbc.h"
 #include "vm/symbols.h"
@@ -39,6 +40,21 @@ DEFINE_FLAG(uint64_t,
             interpreter_trace_file_max_bytes,
             100 * MB,
             "Maximum size in bytes of the interpreter trace file");
+DEFINE_FLAG(int,
+            interpreter_back_edge_weight,
+            1,
+            "Usage counter increment of a loop back edge in interpreted "
+            "code, relative to the increment of an invocation.");
+DEFINE_FLAG(bool,
+            interpreter_superinstructions,
+            true,
+            "Fuse frequent sequences of bytecode instructions of interpreted "
+            "functions into superinstructions.");
+DEFINE_FLAG(bool,
+            interpreter_opcode_pair_histogram,
+            false,
+            "Print the most frequently executed pairs of adjacent bytecode "
+            "instructions on interpreter exit (debug mode only).");
 
 // InterpreterSetjmpBuffer are linked together, and the last created one
 // is referenced by the Interpreter. When an exception is thrown, the exception
@@ -354,6 +370,12 @@ Interpreter::Interpreter()
       trace_buffer_idx_ = 0;
     }
   }
+  opcode_pair_counts_ = NULL;
+  last_counted_pc_ = NULL;
+  last_counted_opcode_ = 0;
+  if (FLAG_interpreter_opcode_pair_histogram) {
+    opcode_pair_counts_ = new uint64_t[kNumOpcodes * kNumOpcodes]();
+  }
 #endif
 }
 
@@ -373,6 +395,11 @@ Interpreter::~Interpreter() {
       trace_buffer_ = NULL;
     }
   }
+  if (opcode_pair_counts_ != NULL) {
+    PrintOpcodePairHistogram();
+    delete[] opcode_pair_counts_;
+    opcode_pair_counts_ = NULL;
+  }
 #endif
 }
 
@@ -443,8 +470,148 @@ DART_NOINLINE void Interpreter::WriteInstructionToTrace(uint32_t* pc) {
   }
 }
 
+DART_NOINLINE void Interpreter::CountOpcodePair(uint32_t* pc) {
+  // Only instructions following each other in the bytecode can be fused, so
+  // pairs formed by taken jumps, calls and returns are not counted.
+  // Superinstructions are counted as the instructions they stand for.
+  const intptr_t opcode = KernelBytecode::DecodeOpcode(*pc);
+  if ((last_counted_pc_ != NULL) && (pc == last_counted_pc_ + 1)) {
+    opcode_pair_counts_[last_counted_opcode_ * kNumOpcodes + opcode]++;
+  }
+  last_counted_pc_ = pc;
+  last_counted_opcode_ = opcode;
+}
+
+struct OpcodePairCount {
+  intptr_t pair;
+  uint64_t count;
+};
+
+static int CompareOpcodePairCounts(const OpcodePairCount* a,
+                                   const OpcodePairCount* b) {
+  // Sort in descending order of counts.
+  if (a->count != b->count) {
+    return (a->count > b->count) ? -1 : 1;
+  }
+  return (a->pair < b->pair) ? -1 : ((a->pair > b->pair) ? 1 : 0);
+}
+
+void Interpreter::PrintOpcodePairHistogram() const {
+  const intptr_t kMaxPrintedPairs = 40;
+  MallocGrowableArray<OpcodePairCount> pairs;
+  uint64_t total = 0;
+  for (intptr_t i = 0; i < kNumOpcodes * kNumOpcodes; i++) {
+    if (opcode_pair_counts_[i] != 0) {
+      OpcodePairCount pair = {i, opcode_pair_counts_[i]};
+      pairs.Add(pair);
+      total += opcode_pair_counts_[i];
+    }
+  }
+  if (total == 0) {
+    return;
+  }
+  pairs.Sort(CompareOpcodePairCounts);
+  OS::PrintErr("Adjacent bytecode instruction pairs: %" Pu64 " executed\n",
+               total);
+  for (intptr_t i = 0; i < Utils::Minimum(pairs.length(), kMaxPrintedPairs);
+       i++) {
+    const KBCInstr first = static_cast<KBCInstr>(pairs[i].pair / kNumOpcodes);
+    const KBCInstr second = static_cast<KBCInstr>(pairs[i].pair % kNumOpcodes);
+    OS::PrintErr("%12" Pu64 " %5.2f%% %s %s\n", pairs[i].count,
+                 100.0 * pairs[i].count / total, KernelBytecode::NameOf(first),
+                 KernelBytecode::NameOf(second));
+  }
+}
+
 #endif  // defined(DEBUG)
 
+// Returns the first of two adjacent instructions with its opcode replaced by
+// the superinstruction for the pair, or unchanged if there is none.
+static KBCInstr FuseInstructionPair(KBCInstr first, KBCInstr second) {
+  const KernelBytecode::Opcode next = KernelBytecode::DecodeOpcode(second);
+  const bool is_branch = (next == KernelBytecode::kJumpIfTrue) ||
+                         (next == KernelBytecode::kJumpIfFalse);
+  KernelBytecode::Opcode fused;
+  switch (KernelBytecode::DecodeOpcode(first)) {
+    case KernelBytecode::kPush:
+      if (next == KernelBytecode::kPush) {
+        fused = KernelBytecode::kVMInternal_PushPush;
+      } else if (next == KernelBytecode::kLoadFieldTOS) {
+        fused = KernelBytecode::kVMInternal_PushLoadFieldTOS;
+      } else if (next == KernelBytecode::kReturnTOS) {
+        fused = KernelBytecode::kVMInternal_PushReturnTOS;
+      } else {
+        return first;
+      }
+      break;
+    case KernelBytecode::kPushNull:
+      if (next != KernelBytecode::kReturnTOS) {
+        return first;
+      }
+      fused = KernelBytecode::kVMInternal_PushNullReturnTOS;
+      break;
+#define FUSE_COMPARE_AND_BRANCH(Name)                                          \
+  case KernelBytecode::kCompareInt##Name:                                      \
+    if (!is_branch) {                                                          \
+      return first;                                                            \
+    }                                                                          \
+    fused = KernelBytecode::kVMInternal_CompareInt##Name##Jump;                \
+    break;
+      FUSE_COMPARE_AND_BRANCH(Eq)
+      FUSE_COMPARE_AND_BRANCH(Gt)
+      FUSE_COMPARE_AND_BRANCH(Lt)
+      FUSE_COMPARE_AND_BRANCH(Ge)
+      FUSE_COMPARE_AND_BRANCH(Le)
+#undef FUSE_COMPARE_AND_BRANCH
+    default:
+      return first;
+  }
+  return (first & ~static_cast<KBCInstr>(0xFF)) | fused;
+}
+
+uword Interpreter::FuseSuperinstructions(uword instructions, intptr_t size) {
+  Thread* thread = Thread::Current();
+  if (!FLAG_enable_interpreter || !FLAG_interpreter_superinstructions ||
+      !thread->IsMutatorThread()) {
+    return instructions;
+  }
+  const KBCInstr* original = reinterpret_cast<const KBCInstr*>(instructions);
+  const intptr_t length = size / sizeof(KBCInstr);
+  intptr_t i = 0;
+  while ((i + 1 < length) && !KernelBytecode::IsSuperinstruction(
+                                 FuseInstructionPair(original[i],
+                                                     original[i + 1]))) {
+    i++;
+  }
+  if (i + 1 >= length) {
+    return instructions;
+  }
+
+  // The bytecode may live in a read-only kernel buffer, so a copy is fused.
+  // Fused pairs do not overlap: the instructions following superinstructions
+  // keep their opcodes, which the superinstruction handlers rely on.
+  KBCInstr* copy = reinterpret_cast<KBCInstr*>(malloc(size));
+  memmove(copy, original, size);
+  while (i + 1 < length) {
+    copy[i] = FuseInstructionPair(original[i], original[i + 1]);
+    i += KernelBytecode::IsSuperinstruction(copy[i]) ? 2 : 1;
+  }
+
+  // Free the copy together with the isolate, like a reloaded kernel blob.
+  const ExternalTypedData& data = ExternalTypedData::Handle(
+      thread->zone(),
+      ExternalTypedData::New(kExternalTypedDataUint8ArrayCid,
+                             reinterpret_cast<uint8_t*>(copy), size,
+                             Heap::kOld));
+  data.AddFinalizer(copy,
+                    [](void* isolate_callback_data,
+                       Dart_WeakPersistentHandle handle,
+                       void* peer) { free(peer); },
+                    size);
+  thread->isolate()->RetainKernelBlob(data);
+  return reinterpret_cast<uword>(copy);
+}
+
 // Calls into the Dart runtime are based on this interface.
 typedef void (*InterpreterRuntimeCall)(NativeArguments arguments);
 
@@ -722,12 +889,34 @@ void Interpreter::InlineCacheMiss(int checked_args,
 }
 
 DART_FORCE_INLINE bool Interpreter::InterfaceCall(Thread* thread,
-                                                  RawString* target_name,
+                                                  RawICData* icdata,
                                                   RawObject** call_base,
                                                   RawObject** top,
                                                   uint32_t** pc,
                                                   RawObject*** FP,
                                                   RawObject*** SP) {
+  ASSERT(icdata->GetClassId() == kICDataCid);
+
+  // While the call site is monomorphic or polymorphic, its inline cache is
+  // searched. Once it is megamorphic, the cache stops growing and the target
+  // is looked up in the lookup cache shared by all call sites.
+  const intptr_t checked_args =
+      ICData::NumArgsTestedBits::decode(icdata->ptr()->state_bits_);
+  const intptr_t max_cache_length =
+      (FLAG_max_polymorphic_checks + 1) * (checked_args + 2);
+  if (LIKELY(Smi::Value(icdata->ptr()->entries_->ptr()->length_) <=
+             max_cache_length)) {
+    if (checked_args == 1) {
+      return InstanceCall1(thread, icdata, call_base, top, pc, FP, SP,
+                           false /* optimized */);
+    }
+    ASSERT(checked_args == 2);
+    return InstanceCall2(thread, icdata, call_base, top, pc, FP, SP,
+                         false /* optimized */);
+  }
+
+  RawString* target_name = icdata->ptr()->target_name_;
+  argdesc_ = icdata->ptr()->args_descriptor_;
   const intptr_t type_args_len =
       InterpreterHelpers::ArgDescTypeArgsLen(argdesc_);
   const intptr_t receiver_idx = type_args_len > 0 ? 1 : 0;
@@ -867,6 +1056,9 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
   if (IsWritingTraceFile()) {                                                  \
     WriteInstructionToTrace(pc - 1);                                           \
   }                                                                            \
+  if (opcode_pair_counts_ != NULL) {                                           \
+    CountOpcodePair(pc - 1);                                                   \
+  }                                                                            \
   icount_++;
 #else
 #define TRACE_INSTRUCTION
@@ -898,6 +1090,33 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
 // Load target of a jump instruction into PC.
 #define LOAD_JUMP_TARGET() pc += ((static_cast<int32_t>(op) >> 8) - 1)
 
+// Fetch the instruction following a superinstruction and continue with its
+// handler, without going through the dispatch table.
+#define DISPATCH_NEXT(Name)                                                    \
+  do {                                                                         \
+    op = *pc++;                                                                \
+    ASSERT((op & 0xFF) == KernelBytecode::k##Name);                            \
+    rA = ((op >> 8) & 0xFF);                                                   \
+    TRACE_INSTRUCTION                                                          \
+    goto bc##Name;                                                             \
+  } while (0)
+
+// Finish a compare superinstruction whose operands were popped: perform the
+// JumpIfTrue or JumpIfFalse following it without materializing the bool.
+#define COMPARE_AND_JUMP(condition)                                            \
+  do {                                                                         \
+    const bool is_true = (condition);                                          \
+    SP -= 1;                                                                   \
+    op = *pc++;                                                                \
+    ASSERT(((op & 0xFF) == KernelBytecode::kJumpIfTrue) ||                     \
+           ((op & 0xFF) == KernelBytecode::kJumpIfFalse));                     \
+    TRACE_INSTRUCTION                                                          \
+    if (is_true == ((op & 0xFF) == KernelBytecode::kJumpIfTrue)) {             \
+      LOAD_JUMP_TARGET();                                                      \
+    }                                                                          \
+    DISPATCH();                                                                \
+  } while (0)
+
 // Define entry point that handles bytecode Name with the given operand format.
 #define BYTECODE(Name, Operands)                                               \
   BYTECODE_HEADER(Name, DECLARE_##Operands, DECODE_##Operands)
@@ -1648,7 +1867,9 @@ SwitchDispatch:
       }
     }
     RawFunction* function = FrameFunction(FP);
-    int32_t counter = ++(function->ptr()->usage_counter_);
+    // A non-zero loop depth marks a loop back edge rather than the entry.
+    int32_t counter = (function->ptr()->usage_counter_ +=
+                       (rA == 0) ? 1 : FLAG_interpreter_back_edge_weight);
     if (UNLIKELY(FLAG_compilation_counter_threshold >= 0 &&
                  counter >= FLAG_compilation_counter_threshold &&
                  !Function::HasCode(function))) {
@@ -1714,15 +1935,12 @@ SwitchDispatch:
         (null_value != function_type_args)) {
       // First lookup in the cache.
       RawArray* instantiations = type_arguments->ptr()->instantiations_;
-      for (intptr_t i = 0;
-           instantiations->ptr()->data()[i] != NULL;  // kNoInstantiator
-           i += 3) {  // kInstantiationSizeInWords
-        if ((instantiations->ptr()->data()[i] == instantiator_type_args) &&
-            (instantiations->ptr()->data()[i + 1] == function_type_args)) {
-          // Found in the cache.
-          SP[-1] = instantiations->ptr()->data()[i + 2];
-          goto InstantiateTypeArgumentsTOSDone;
-        }
+      const intptr_t i = TypeArguments::FindInstantiation(
+          instantiations, instantiator_type_args, function_type_args);
+      if (instantiations->ptr()->data()[i] != NULL) {  // kNoInstantiator
+        // Found in the cache.
+        SP[-1] = instantiations->ptr()->data()[i + 2];
+        goto InstantiateTypeArgumentsTOSDone;
       }
 
       // Cache lookup failed, call runtime.
@@ -1911,11 +2129,8 @@ SwitchDispatch:
       RawObject** call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      RawString* target_name =
-          static_cast<RawFunction*>(LOAD_CONSTANT(kidx))->ptr()->name_;
-      argdesc_ = static_cast<RawArray*>(LOAD_CONSTANT(kidx + 1));
-      if (!InterfaceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                         &SP)) {
+      RawICData* icdata = RAW_CAST(ICData, LOAD_CONSTANT(kidx + 1));
+      if (!InterfaceCall(thread, icdata, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -1943,11 +2158,8 @@ SwitchDispatch:
       RawObject** call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      RawString* target_name =
-          static_cast<RawFunction*>(LOAD_CONSTANT(kidx))->ptr()->name_;
-      argdesc_ = static_cast<RawArray*>(LOAD_CONSTANT(kidx + 1));
-      if (!InterfaceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                         &SP)) {
+      RawICData* icdata = RAW_CAST(ICData, LOAD_CONSTANT(kidx + 1));
+      if (!InterfaceCall(thread, icdata, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2042,6 +2254,11 @@ SwitchDispatch:
         SP[0] = reinterpret_cast<RawObject**>(
             instance->ptr())[Array::length_offset() / kWordSize];
       } break;
+      case MethodRecognizer::kGrowableArrayData: {
+        RawInstance* instance = reinterpret_cast<RawInstance*>(SP[0]);
+        SP[0] = reinterpret_cast<RawObject**>(
+            instance->ptr())[GrowableObjectArray::data_offset() / kWordSize];
+      } break;
       case MethodRecognizer::kListFactory: {
         // factory List<E>([int length]) {
         //   return (:arg_desc.positional_count == 2) ? new _List<E>(length)
@@ -3359,6 +3576,80 @@ SwitchDispatch:
     DISPATCH();
   }
 
+  // Superinstructions (see KERNEL_SUPERINSTRUCTIONS_LIST in constants_kbc.h).
+  {
+    BYTECODE(VMInternal_PushPush, X);
+    *++SP = FP[rD];
+    DISPATCH_NEXT(Push);
+  }
+
+  {
+    BYTECODE(VMInternal_PushLoadFieldTOS, X);
+    *++SP = FP[rD];
+    DISPATCH_NEXT(LoadFieldTOS);
+  }
+
+  {
+    BYTECODE(VMInternal_PushReturnTOS, X);
+    *++SP = FP[rD];
+    DISPATCH_NEXT(ReturnTOS);
+  }
+
+  {
+    BYTECODE(VMInternal_PushNullReturnTOS, 0);
+    *++SP = null_value;
+    DISPATCH_NEXT(ReturnTOS);
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntEqJump, 0);
+    SP -= 1;
+    bool equal;
+    if (SP[0] == SP[1]) {
+      equal = true;
+    } else if (!SP[0]->IsHeapObject() || !SP[1]->IsHeapObject() ||
+               (SP[0] == null_value) || (SP[1] == null_value)) {
+      equal = false;
+    } else {
+      int64_t a = Integer::GetInt64Value(RAW_CAST(Integer, SP[0]));
+      int64_t b = Integer::GetInt64Value(RAW_CAST(Integer, SP[1]));
+      equal = (a == b);
+    }
+    COMPARE_AND_JUMP(equal);
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntGtJump, 0);
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
+    UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
+    COMPARE_AND_JUMP(a > b);
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntLtJump, 0);
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
+    UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
+    COMPARE_AND_JUMP(a < b);
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntGeJump, 0);
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
+    UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
+    COMPARE_AND_JUMP(a >= b);
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntLeJump, 0);
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
+    UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
+    COMPARE_AND_JUMP(a <= b);
+  }
+
   {
   TailCallSP1:
     RawFunction* function = Function::RawCast(SP[1]);
@@ -122,6 +122,12 @@ class Interpreter {
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
   void MajorGC() { lookup_cache_.Clear(); }
 
+  // Returns the start of a copy of the given bytecode which uses
+  // superinstructions (see KERNEL_SUPERINSTRUCTIONS_LIST), or instructions
+  // itself if there is nothing to fuse. The copy is owned by the current
+  // isolate.
+  static uword FuseSuperinstructions(uword instructions, intptr_t size);
+
  private:
   uintptr_t* stack_;
   uword stack_base_;
@@ -179,7 +185,7 @@ class Interpreter {
                        RawObject** SP);
 
   bool InterfaceCall(Thread* thread,
-                     RawString* target_name,
+                     RawICData* icdata,
                      RawObject** call_base,
                      RawObject** call_top,
                      uint32_t** pc,
@@ -258,6 +264,11 @@ class Interpreter {
   void FlushTraceBuffer();
   void WriteInstructionToTrace(uint32_t* pc);
 
+  // Counts executed pairs of adjacent instructions, as candidates for
+  // superinstructions.
+  void CountOpcodePair(uint32_t* pc);
+  void PrintOpcodePairHistogram() const;
+
   void* trace_file_;
   uint64_t trace_file_bytes_written_;
 
@@ -266,6 +277,11 @@ class Interpreter {
       kTraceBufferSizeInBytes / sizeof(KBCInstr);
   KBCInstr* trace_buffer_;
   intptr_t trace_buffer_idx_;
+
+  static const intptr_t kNumOpcodes = 256;
+  uint64_t* opcode_pair_counts_;
+  uint32_t* last_counted_pc_;
+  intptr_t last_counted_opcode_;
 #endif  // defined(DEBUG)
 
   // Longjmp support for exceptions.
@@ -10,8 +10,11 @@
 #include "platform/atomic.h"
 #include "platform/text_buffer.h"
 #include "vm/class_finalizer.h"
+#include "vm/clustered_snapshot.h"
 #include "vm/code_observers.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/compiler/jit/deopt_statistics.h"
+#include "vm/compiler/jit/jit_profile_cache.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -35,6 +38,8 @@
 #include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_binary.h"
+#include "vm/profiler_pprof.h"
 #include "vm/reusable_handles.h"
 #include "vm/reverse_pc_lookup_cache.h"
 #include "vm/service.h"
@@ -49,11 +54,13 @@
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/timeline_analysis.h"
+#include "vm/virtual_memory.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
 DECLARE_FLAG(bool, print_metrics);
+DECLARE_FLAG(int, print_allocation_samples);
 DECLARE_FLAG(bool, timing);
 DECLARE_FLAG(bool, trace_service);
 DECLARE_FLAG(bool, warn_on_pause_with_no_debugger);
@@ -640,6 +647,9 @@ MessageHandler::MessageStatus IsolateMessageHandler::HandleMessage(
     }
   }
   delete message;
+#if !defined(PRODUCT)
+  ContinuousProfile::Tick(thread);
+#endif  // !defined(PRODUCT)
   return status;
 }
 
@@ -779,6 +789,10 @@ void Isolate::FlagsInitialize(Dart_IsolateFlags* api_flags) {
   api_flags->entry_points = NULL;
   api_flags->load_vmservice_library = false;
   api_flags->copy_parent_code = false;
+  api_flags->group_snapshot_data = NULL;
+  api_flags->group_snapshot_instructions = NULL;
+  api_flags->cpu_affinity_mask = 0;
+  api_flags->batch_scheduling = false;
 }
 
 void Isolate::FlagsCopyTo(Dart_IsolateFlags* api_flags) const {
@@ -790,6 +804,10 @@ void Isolate::FlagsCopyTo(Dart_IsolateFlags* api_flags) const {
   api_flags->entry_points = NULL;
   api_flags->load_vmservice_library = should_load_vmservice();
   api_flags->copy_parent_code = false;
+  api_flags->group_snapshot_data = NULL;
+  api_flags->group_snapshot_instructions = NULL;
+  api_flags->cpu_affinity_mask = cpu_affinity_mask_;
+  api_flags->batch_scheduling = batch_scheduling_;
 }
 
 void Isolate::FlagsCopyFrom(const Dart_IsolateFlags& api_flags) {
@@ -819,6 +837,8 @@ void Isolate::FlagsCopyFrom(const Dart_IsolateFlags& api_flags) {
 #undef SET_FROM_FLAG
 
   set_should_load_vmservice(api_flags.load_vmservice_library);
+  cpu_affinity_mask_ = api_flags.cpu_affinity_mask;
+  batch_scheduling_ = api_flags.batch_scheduling;
 
   // Copy entry points list.
   ASSERT(embedder_entry_points_ == NULL);
@@ -877,6 +897,7 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       store_buffer_(new StoreBuffer()),
       marking_stack_(NULL),
       heap_(NULL),
+      instructions_image_(NULL),
       isolate_flags_(0),
       background_compiler_(NULL),
       optimizing_background_compiler_(NULL),
@@ -898,6 +919,7 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       reload_every_n_stack_overflow_checks_(FLAG_reload_every),
       reload_context_(NULL),
       last_reload_timestamp_(OS::GetCurrentTimeMillis()),
+      reload_generation_(0),
       object_id_ring_(NULL),
 #endif  // !defined(PRODUCT)
       start_time_micros_(OS::GetCurrentMonotonicMicros()),
@@ -923,6 +945,8 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
           NOT_IN_PRODUCT("Isolate::constant_canonicalization_mutex_"))),
       megamorphic_lookup_mutex_(
           new Mutex(NOT_IN_PRODUCT("Isolate::megamorphic_lookup_mutex_"))),
+      coverage_counters_mutex_(
+          new Mutex(NOT_IN_PRODUCT("Isolate::coverage_counters_mutex_"))),
       kernel_data_lib_cache_mutex_(
           new Mutex(NOT_IN_PRODUCT("Isolate::kernel_data_lib_cache_mutex_"))),
       kernel_data_class_cache_mutex_(
@@ -945,6 +969,11 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       boxed_field_list_(GrowableObjectArray::null()),
       spawn_count_monitor_(new Monitor()),
       spawn_count_(0),
+      group_source_(NULL),
+      optimized_code_installs_(0),
+      group_source_code_installs_(0),
+      cpu_affinity_mask_(0),
+      batch_scheduling_(false),
       handler_info_cache_(),
       catch_entry_moves_cache_(),
       embedder_entry_points_(NULL),
@@ -988,6 +1017,20 @@ Isolate::~Isolate() {
   delete reverse_pc_lookup_cache_;
   reverse_pc_lookup_cache_ = nullptr;
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  delete jit_profile_cache_;
+  jit_profile_cache_ = nullptr;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if !defined(PRODUCT)
+  delete continuous_profile_;
+  continuous_profile_ = nullptr;
+  delete deopt_statistics_;
+  deopt_statistics_ = nullptr;
+  delete cpu_sample_code_table_;
+  cpu_sample_code_table_ = nullptr;
+#endif  // !defined(PRODUCT)
+
   if (FLAG_enable_interpreter) {
     delete background_compiler_;
     background_compiler_ = NULL;
@@ -999,6 +1042,10 @@ Isolate::~Isolate() {
 #if !defined(PRODUCT)
   delete debugger_;
   debugger_ = NULL;
+  // The threads of this isolate are gone, so nothing samples into it
+  // anymore.
+  delete sample_buffer_;
+  sample_buffer_ = nullptr;
   if (FLAG_support_service) {
     delete object_id_ring_;
   }
@@ -1009,7 +1056,11 @@ Isolate::~Isolate() {
 
   free(name_);
   delete store_buffer_;
-  delete heap_;
+  if (!Dart::IsExiting()) {
+    // Releasing a large heap page by page is slow, and the process exiting
+    // releases it at once.
+    delete heap_;
+  }
   ASSERT(marking_stack_ == NULL);
   delete object_store_;
   delete api_state_;
@@ -1026,6 +1077,8 @@ Isolate::~Isolate() {
   constant_canonicalization_mutex_ = NULL;
   delete megamorphic_lookup_mutex_;
   megamorphic_lookup_mutex_ = NULL;
+  delete coverage_counters_mutex_;
+  coverage_counters_mutex_ = NULL;
   delete kernel_constants_mutex_;
   kernel_constants_mutex_ = nullptr;
   delete kernel_data_lib_cache_mutex_;
@@ -1042,6 +1095,7 @@ Isolate::~Isolate() {
   field_list_mutex_ = NULL;
   ASSERT(spawn_count_ == 0);
   delete spawn_count_monitor_;
+  set_group_source(NULL);
   delete safepoint_handler_;
   delete thread_registry_;
 
@@ -1124,6 +1178,8 @@ Isolate* Isolate::InitIsolate(const char* name_prefix,
   // Setup the isolate message handler.
   MessageHandler* handler = new IsolateMessageHandler(result);
   ASSERT(handler != NULL);
+  handler->set_cpu_affinity_mask(result->cpu_affinity_mask());
+  handler->set_batch_scheduling(result->batch_scheduling());
   result->set_message_handler(handler);
 
   // Setup the Dart API state.
@@ -1144,6 +1200,9 @@ Isolate* Isolate::InitIsolate(const char* name_prefix,
   result->BuildName(name_prefix);
 #if !defined(PRODUCT)
   result->debugger_ = new Debugger(result);
+  if (!is_vm_isolate) {
+    result->sample_buffer_ = Profiler::NewIsolateSampleBuffer();
+  }
 #endif
   if (FLAG_trace_isolates) {
     if (name_prefix == NULL || strcmp(name_prefix, "vm-isolate") != 0) {
@@ -1297,6 +1356,8 @@ bool Isolate::ReloadSources(JSONStream* js,
                             bool dont_delete_reload_context) {
   ASSERT(!IsReloading());
   SetHasAttemptedReload(true);
+  // Children must not be created from the program before the reload.
+  set_group_source(NULL);
   reload_context_ = new IsolateReloadContext(this, js);
   reload_context_->Reload(force_reload, root_script_url, packages_url,
                           /* kernel_buffer= */ NULL,
@@ -1315,6 +1376,8 @@ bool Isolate::ReloadKernel(JSONStream* js,
                            bool dont_delete_reload_context) {
   ASSERT(!IsReloading());
   SetHasAttemptedReload(true);
+  // Children must not be created from the program before the reload.
+  set_group_source(NULL);
   reload_context_ = new IsolateReloadContext(this, js);
   reload_context_->Reload(force_reload,
                           /* root_script_url= */ NULL,
@@ -1724,6 +1787,7 @@ void Isolate::Run() {
 
 void Isolate::NotifyIdle(int64_t deadline) {
   heap()->NotifyIdle(deadline);
+  Thread::Current()->ReleaseZoneSegments();
 }
 
 void Isolate::AddClosureFunction(const Function& function) const {
@@ -1840,9 +1904,18 @@ void Isolate::LowLevelShutdown() {
   }
 #endif  // !PRODUCT
 
-  // Finalize any weak persistent handles with a non-null referent.
-  FinalizeWeakPersistentHandlesVisitor visitor;
-  api_state()->weak_persistent_handles().VisitHandles(&visitor);
+  // Finalize any weak persistent handles with a non-null referent, and any
+  // whose callbacks are still queued. Not when the process is about to exit,
+  // which releases what they hold anyway.
+  if (!Dart::IsExiting()) {
+    FinalizeWeakPersistentHandlesVisitor visitor;
+    api_state()->weak_persistent_handles().VisitHandles(&visitor);
+    api_state()->weak_persistent_handles().RunPendingFinalizations(this);
+  }
+
+  if (FLAG_print_allocation_samples > 0) {
+    heap()->allocation_sampler()->Print(FLAG_print_allocation_samples);
+  }
 
 #if !defined(PRODUCT)
   if (FLAG_dump_megamorphic_stats) {
@@ -1920,6 +1993,23 @@ void Isolate::Shutdown() {
     KernelIsolate::NotifyAboutIsolateShutdown(this);
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (is_runnable() && !Isolate::IsVMInternalIsolate(this) &&
+      (object_store() != nullptr)) {
+    // The background compilers are stopped, so the set of optimized
+    // functions is final.
+    StackZone zone(thread);
+    HandleScope handle_scope(thread);
+    JitProfileCache::Save(thread);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if !defined(PRODUCT)
+  if (is_runnable() && (object_store() != nullptr)) {
+    ContinuousProfile::Flush(thread);
+  }
+#endif  // !defined(PRODUCT)
+
   if (heap_ != NULL) {
     // Wait for any concurrent GC tasks to finish before shutting down.
     // TODO(rmacnak): Interrupt tasks for faster shutdown.
@@ -2187,6 +2277,7 @@ void Isolate::PrintJSON(JSONStream* stream, bool ref) {
     heap()->PrintToJSONObject(Heap::kNew, &jsheap);
     heap()->PrintToJSONObject(Heap::kOld, &jsheap);
   }
+  heap()->PrintPausesToJSONObject(&jsobj);
 
   jsobj.AddProperty("runnable", is_runnable());
   jsobj.AddProperty("livePorts", message_handler()->live_ports());
@@ -2920,6 +3011,8 @@ void Isolate::UnscheduleThread(Thread* thread,
     ASSERT(thread->api_top_scope_ == NULL);
     ASSERT(thread->zone() == NULL);
     ASSERT(thread->sticky_error() == Error::null());
+    // Helper threads are unscheduled once they run out of work.
+    thread->ReleaseZoneSegments();
   }
   if (!bypass_safepoint) {
     // Ensure that the thread reports itself as being at a safepoint.
@@ -2956,6 +3049,122 @@ void Isolate::UnscheduleThread(Thread* thread,
   thread_registry()->ReturnThreadLocked(is_mutator, thread);
 }
 
+void Isolate::set_group_source(IsolateGroupSource* source) {
+  if (source != NULL) {
+    source->Retain();
+  }
+  if (group_source_ != NULL) {
+    group_source_->Release();
+  }
+  group_source_ = source;
+  group_source_code_installs_ = optimized_code_installs_;
+}
+
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_IA32)
+static uint8_t* MallocReallocate(uint8_t* ptr,
+                                 intptr_t old_size,
+                                 intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
+}
+
+// Moves |size| bytes at |buffer| into fresh pages with the given protection,
+// so they stay valid and aligned for as long as isolates use the snapshot.
+static VirtualMemory* CopyToPages(uint8_t* buffer,
+                                  intptr_t size,
+                                  bool is_executable,
+                                  VirtualMemory::Protection protection) {
+  const intptr_t mapped_size = Utils::RoundUp(size, VirtualMemory::PageSize());
+  VirtualMemory* memory = VirtualMemory::Allocate(
+      mapped_size, is_executable, "dart-isolate-group-snapshot");
+  if (memory != NULL) {
+    memmove(memory->address(), buffer, size);
+    memory->Protect(protection);
+  }
+  free(buffer);
+  return memory;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_IA32)
+
+IsolateGroupSource* IsolateGroupSource::CreateFromCurrentIsolate(
+    Thread* thread) {
+#if defined(DART_PRECOMPILED_RUNTIME) || defined(TARGET_ARCH_IA32)
+  // AOT isolates already start from a shared snapshot, and IA32 has no
+  // snapshots with code.
+  return NULL;
+#else
+  if (!FLAG_load_deferred_eagerly || !ClassFinalizer::ProcessPendingClasses()) {
+    return NULL;
+  }
+  Isolate* isolate = thread->isolate();
+  // Code installed by a background compiler while the snapshot is written
+  // could be written half way. The compilers are started again when the
+  // isolate next queues a function for them.
+  BackgroundCompiler::Stop(isolate);
+
+  TIMELINE_DURATION(thread, Isolate, "WriteIsolateGroupSnapshot");
+  uint8_t* data_buffer = NULL;
+  uint8_t* instructions_buffer = NULL;
+  intptr_t data_size = 0;
+  intptr_t instructions_size = 0;
+  {
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    BlobImageWriter image_writer(
+        thread, &instructions_buffer, MallocReallocate, 2 * MB,
+        /*shared_objects=*/nullptr, /*shared_instructions=*/nullptr,
+        /*reused_instructions=*/nullptr);
+    FullSnapshotWriter writer(Snapshot::kFullJIT, NULL, &data_buffer,
+                              MallocReallocate, NULL, &image_writer);
+    writer.set_stable_code_only(true);
+    writer.WriteFullSnapshot();
+    data_size = writer.IsolateSnapshotSize();
+    instructions_size = image_writer.InstructionsBlobSize();
+  }
+
+  VirtualMemory* data = CopyToPages(data_buffer, data_size,
+                                    /*is_executable=*/false,
+                                    VirtualMemory::kReadOnly);
+  VirtualMemory* instructions = CopyToPages(
+      instructions_buffer, instructions_size,
+      /*is_executable=*/true, VirtualMemory::kReadExecute);
+  if ((data == NULL) || (instructions == NULL)) {
+    delete data;
+    delete instructions;
+    return NULL;
+  }
+  return new IsolateGroupSource(data, instructions);
+#endif  // defined(DART_PRECOMPILED_RUNTIME) || defined(TARGET_ARCH_IA32)
+}
+
+IsolateGroupSource::IsolateGroupSource(VirtualMemory* snapshot_data,
+                                       VirtualMemory* snapshot_instructions)
+    : snapshot_data_(snapshot_data),
+      snapshot_instructions_(snapshot_instructions),
+      ref_count_(1) {}
+
+IsolateGroupSource::~IsolateGroupSource() {
+  delete snapshot_data_;
+  delete snapshot_instructions_;
+}
+
+const uint8_t* IsolateGroupSource::snapshot_data() const {
+  return reinterpret_cast<const uint8_t*>(snapshot_data_->address());
+}
+
+const uint8_t* IsolateGroupSource::snapshot_instructions() const {
+  return reinterpret_cast<const uint8_t*>(snapshot_instructions_->address());
+}
+
+void IsolateGroupSource::Retain() {
+  AtomicOperations::FetchAndIncrement(&ref_count_);
+}
+
+void IsolateGroupSource::Release() {
+  if (AtomicOperations::FetchAndDecrement(&ref_count_) == 1) {
+    delete this;
+  }
+}
+
 static const char* NewConstChar(const char* chars) {
   size_t len = strlen(chars);
   char* mem = new char[len + 1];
@@ -2995,6 +3204,7 @@ IsolateSpawnState::IsolateSpawnState(Dart_Port parent_port,
       serialized_message_(message_buffer->StealMessage()),
       spawn_count_monitor_(spawn_count_monitor),
       spawn_count_(spawn_count),
+      group_source_(NULL),
       paused_(paused),
       errors_are_fatal_(errors_are_fatal) {
   const Class& cls = Class::Handle(func.Owner());
@@ -3046,6 +3256,7 @@ IsolateSpawnState::IsolateSpawnState(Dart_Port parent_port,
       serialized_message_(message_buffer->StealMessage()),
       spawn_count_monitor_(spawn_count_monitor),
       spawn_count_(spawn_count),
+      group_source_(NULL),
       isolate_flags_(),
       paused_(paused),
       errors_are_fatal_(errors_are_fatal) {
@@ -3066,6 +3277,17 @@ IsolateSpawnState::~IsolateSpawnState() {
   delete[] debug_name_;
   delete serialized_args_;
   delete serialized_message_;
+  if (group_source_ != NULL) {
+    group_source_->Release();
+  }
+}
+
+void IsolateSpawnState::set_group_source(IsolateGroupSource* source) {
+  ASSERT(group_source_ == NULL);
+  source->Retain();
+  group_source_ = source;
+  isolate_flags_.group_snapshot_data = source->snapshot_data();
+  isolate_flags_.group_snapshot_instructions = source->snapshot_instructions();
 }
 
 RawObject* IsolateSpawnState::ResolveFunction() {
@@ -15,9 +15,9 @@
 #include "vm/base_isolate.h"
 #include "vm/class_table.h"
 #include "vm/exceptions.h"
-#include "vm/fixed_cache.h"
 #include "vm/growable_array.h"
 #include "vm/handles.h"
+#include "vm/hashed_cache.h"
 #include "vm/heap/verifier.h"
 #include "vm/megamorphic_cache_table.h"
 #include "vm/metrics.h"
@@ -45,7 +45,11 @@ class ICData;
 #if !defined(DART_PRECOMPILED_RUNTIME)
 class Interpreter;
 #endif
+class ContinuousProfile;
+class CpuSampleCodeTable;
+class DeoptStatistics;
 class IsolateProfilerData;
+class JitProfileCache;
 class IsolateReloadContext;
 class IsolateSpawnState;
 class Log;
@@ -82,6 +86,7 @@ class StoreBuffer;
 class StubCode;
 class ThreadRegistry;
 class UserTag;
+class VirtualMemory;
 
 class PendingLazyDeopt {
  public:
@@ -110,6 +115,35 @@ class IsolateVisitor {
   DISALLOW_COPY_AND_ASSIGN(IsolateVisitor);
 };
 
+// A snapshot of the program and JIT code of an isolate. With
+// --share_program_on_spawn, the isolates spawned with Isolate.spawn are
+// created from it instead of loading and compiling the program again. They
+// all share the snapshot's memory and deserialize the program into their own
+// heap.
+class IsolateGroupSource {
+ public:
+  // Writes a snapshot of the current isolate's program. Returns NULL if it
+  // cannot be written. The result has a reference count of one.
+  static IsolateGroupSource* CreateFromCurrentIsolate(Thread* thread);
+
+  const uint8_t* snapshot_data() const;
+  const uint8_t* snapshot_instructions() const;
+
+  void Retain();
+  void Release();
+
+ private:
+  IsolateGroupSource(VirtualMemory* snapshot_data,
+                     VirtualMemory* snapshot_instructions);
+  ~IsolateGroupSource();
+
+  VirtualMemory* const snapshot_data_;
+  VirtualMemory* const snapshot_instructions_;
+  intptr_t ref_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(IsolateGroupSource);
+};
+
 // Disallow OOB message handling within this scope.
 class NoOOBMessageScope : public ThreadStackResource {
  public:
@@ -131,10 +165,11 @@ class NoReloadScope : public ThreadStackResource {
   DISALLOW_COPY_AND_ASSIGN(NoReloadScope);
 };
 
-// Fixed cache for exception handler lookup.
-typedef FixedCache<intptr_t, ExceptionHandlerInfo, 16> HandlerInfoCache;
-// Fixed cache for catch entry state lookup.
-typedef FixedCache<intptr_t, CatchEntryMovesRefPtr, 16> CatchEntryMovesCache;
+// Cache for exception handler lookup, keyed by the pc of a frame.
+typedef HashedCache<intptr_t, ExceptionHandlerInfo, 16, 1024> HandlerInfoCache;
+// Cache for catch entry state lookup, keyed by the pc of the handler frame.
+typedef HashedCache<intptr_t, CatchEntryMovesRefPtr, 16, 1024>
+    CatchEntryMovesCache;
 
 // List of Isolate flags with corresponding members of Dart_IsolateFlags and
 // corresponding global command line flags.
@@ -295,6 +330,12 @@ class Isolate : public BaseIsolate {
 
   void SetupImagePage(const uint8_t* snapshot_buffer, bool is_executable);
 
+  // The instructions image this isolate's code was loaded from, if any.
+  const uint8_t* instructions_image() const { return instructions_image_; }
+  void set_instructions_image(const uint8_t* image) {
+    instructions_image_ = image;
+  }
+
   void ScheduleInterrupts(uword interrupt_bits);
 
   // Marks all libraries as loaded.
@@ -346,6 +387,28 @@ class Isolate : public BaseIsolate {
   IsolateSpawnState* spawn_state() const { return spawn_state_; }
   void set_spawn_state(IsolateSpawnState* value) { spawn_state_ = value; }
 
+  // The snapshot this isolate's children are created from, if any. Isolates
+  // created from a snapshot pass it on to their own children.
+  IsolateGroupSource* group_source() const { return group_source_; }
+  void set_group_source(IsolateGroupSource* source);
+
+  // The number of optimized functions installed since the group source was
+  // set, which tells how much the JIT code in it lags behind.
+  intptr_t optimized_code_installs_since_group_source() const {
+    return optimized_code_installs_ - group_source_code_installs_;
+  }
+  // Optimized code is only installed at a safepoint, so no two threads
+  // update the count at the same time.
+  void IncrementOptimizedCodeInstalls() { optimized_code_installs_++; }
+
+  // The CPUs this isolate's messages are handled on, or zero for any CPU.
+  // Children spawned by this isolate inherit it.
+  uint64_t cpu_affinity_mask() const { return cpu_affinity_mask_; }
+
+  // Whether this isolate's messages are handled at batch priority.
+  // Children spawned by this isolate inherit it.
+  bool batch_scheduling() const { return batch_scheduling_; }
+
   Mutex* mutex() const { return mutex_; }
   Mutex* symbols_mutex() const { return symbols_mutex_; }
   Mutex* type_canonicalization_mutex() const {
@@ -355,6 +418,7 @@ class Isolate : public BaseIsolate {
     return constant_canonicalization_mutex_;
   }
   Mutex* megamorphic_lookup_mutex() const { return megamorphic_lookup_mutex_; }
+  Mutex* coverage_counters_mutex() const { return coverage_counters_mutex_; }
 
   Mutex* kernel_data_lib_cache_mutex() const {
     return kernel_data_lib_cache_mutex_;
@@ -373,6 +437,9 @@ class Isolate : public BaseIsolate {
     return debugger_;
   }
 
+  // NULL if the samples of this isolate go to the shared sample buffer.
+  SampleBuffer* sample_buffer() const { return sample_buffer_; }
+
   void set_single_step(bool value) { single_step_ = value; }
   bool single_step() const { return single_step_; }
   static intptr_t single_step_offset() {
@@ -549,6 +616,10 @@ class Isolate : public BaseIsolate {
     last_reload_timestamp_ = value;
   }
   int64_t last_reload_timestamp() const { return last_reload_timestamp_; }
+
+  // The number of reloads committed so far.
+  intptr_t reload_generation() const { return reload_generation_; }
+  void increment_reload_generation() { reload_generation_++; }
 #else
   bool IsReloading() const { return false; }
   bool HasAttemptedReload() const { return false; }
@@ -734,6 +805,40 @@ class Isolate : public BaseIsolate {
     reverse_pc_lookup_cache_ = table;
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // The functions optimized by a previous run, see --jit_profile_cache.
+  JitProfileCache* jit_profile_cache() const { return jit_profile_cache_; }
+  void set_jit_profile_cache(JitProfileCache* cache) {
+    ASSERT(jit_profile_cache_ == nullptr);
+    jit_profile_cache_ = cache;
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if !defined(PRODUCT)
+  // The samples aggregated by --continuous_profile.
+  ContinuousProfile* continuous_profile() const { return continuous_profile_; }
+  void set_continuous_profile(ContinuousProfile* profile) {
+    ASSERT(continuous_profile_ == nullptr);
+    continuous_profile_ = profile;
+  }
+
+  // Deoptimizations and reoptimizations of this isolate's functions.
+  DeoptStatistics* deopt_statistics() const { return deopt_statistics_; }
+  void set_deopt_statistics(DeoptStatistics* statistics) {
+    ASSERT(deopt_statistics_ == nullptr);
+    deopt_statistics_ = statistics;
+  }
+
+  // The code sent to clients of _getCpuSamplesBinary.
+  CpuSampleCodeTable* cpu_sample_code_table() const {
+    return cpu_sample_code_table_;
+  }
+  void set_cpu_sample_code_table(CpuSampleCodeTable* table) {
+    ASSERT(cpu_sample_code_table_ == nullptr);
+    cpu_sample_code_table_ = table;
+  }
+#endif  // !defined(PRODUCT)
+
   // This doesn't belong here, but to avoid triggering bugs in jemalloc we
   // allocate the irregexpinterpreter's stack once per isolate instead of once
   // per regexp execution.
@@ -896,6 +1001,7 @@ class Isolate : public BaseIsolate {
   MarkingStack* marking_stack_;
   MarkingStack* deferred_marking_stack_;
   Heap* heap_;
+  const uint8_t* instructions_image_;
 
 #define ISOLATE_FLAG_BITS(V)                                                   \
   V(ErrorsFatal)                                                               \
@@ -951,6 +1057,9 @@ class Isolate : public BaseIsolate {
 
   VMTagCounters vm_tag_counters_;
 
+  // The samples of this isolate's threads, see --isolate_sample_buffer_size.
+  SampleBuffer* sample_buffer_ = nullptr;
+
   // We use 6 list entries for each pending service extension calls.
   enum {
     kPendingHandlerIndex = 0,
@@ -986,6 +1095,7 @@ class Isolate : public BaseIsolate {
   intptr_t reload_every_n_stack_overflow_checks_;
   IsolateReloadContext* reload_context_;
   int64_t last_reload_timestamp_;
+  intptr_t reload_generation_;
   // Ring buffer of objects assigned an id.
   ObjectIdRing* object_id_ring_;
 #endif  // !defined(PRODUCT)
@@ -1011,6 +1121,7 @@ class Isolate : public BaseIsolate {
   Mutex* type_canonicalization_mutex_;      // Protects type canonicalization.
   Mutex* constant_canonicalization_mutex_;  // Protects const canonicalization.
   Mutex* megamorphic_lookup_mutex_;  // Protects megamorphic table lookup.
+  Mutex* coverage_counters_mutex_;   // Protects the coverage counters table.
   Mutex* kernel_data_lib_cache_mutex_;
   Mutex* kernel_data_class_cache_mutex_;
   Mutex* kernel_constants_mutex_;
@@ -1050,6 +1161,12 @@ class Isolate : public BaseIsolate {
   Monitor* spawn_count_monitor_;
   intptr_t spawn_count_;
 
+  IsolateGroupSource* group_source_;
+  intptr_t optimized_code_installs_;
+  intptr_t group_source_code_installs_;
+  uint64_t cpu_affinity_mask_;
+  bool batch_scheduling_;
+
   HandlerInfoCache handler_info_cache_;
   CatchEntryMovesCache catch_entry_moves_cache_;
 
@@ -1058,6 +1175,16 @@ class Isolate : public BaseIsolate {
 
   ReversePcLookupCache* reverse_pc_lookup_cache_;
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  JitProfileCache* jit_profile_cache_ = nullptr;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if !defined(PRODUCT)
+  ContinuousProfile* continuous_profile_ = nullptr;
+  DeoptStatistics* deopt_statistics_ = nullptr;
+  CpuSampleCodeTable* cpu_sample_code_table_ = nullptr;
+#endif  // !defined(PRODUCT)
+
   intptr_t* irregexp_backtrack_stack_;
 
   static Dart_IsolateCreateCallback create_callback_;
@@ -1087,6 +1214,7 @@ class Isolate : public BaseIsolate {
   friend class GCMarker;  // VisitObjectPointers
   friend class SafepointHandler;
   friend class ObjectGraph;  // VisitObjectPointers
+  friend class PageSpace;    // threads_lock
   friend class Scavenger;    // VisitObjectPointers
   friend class HeapIterationScope;  // VisitObjectPointers
   friend class ServiceIsolate;
@@ -1191,6 +1319,10 @@ class IsolateSpawnState {
   bool errors_are_fatal() const { return errors_are_fatal_; }
   Dart_IsolateFlags* isolate_flags() { return &isolate_flags_; }
 
+  // Asks the embedder to create the isolate from |source|.
+  IsolateGroupSource* group_source() const { return group_source_; }
+  void set_group_source(IsolateGroupSource* source);
+
   RawObject* ResolveFunction();
   RawInstance* BuildArgs(Thread* thread);
   RawInstance* BuildMessage(Thread* thread);
@@ -1219,6 +1351,7 @@ class IsolateSpawnState {
   Monitor* spawn_count_monitor_;
   intptr_t* spawn_count_;
 
+  IsolateGroupSource* group_source_;
   Dart_IsolateFlags isolate_flags_;
   bool paused_;
   bool errors_are_fatal_;
@@ -846,6 +846,7 @@ void IsolateReloadContext::FinalizeLoading() {
     Commit();
     PostCommit();
     isolate()->set_last_reload_timestamp(reload_timestamp_);
+    isolate()->increment_reload_generation();
   } else {
     ReportReasonsForCancelling();
     Rollback();
@@ -1899,14 +1900,14 @@ class InvalidationCollector : public ObjectVisitor {
   virtual ~InvalidationCollector() {}
 
   virtual void VisitObject(RawObject* obj) {
-    if (obj->IsPseudoObject()) {
-      return;  // Cannot be wrapped in handles.
-    }
-    const Object& handle = Object::Handle(zone_, obj);
-    if (handle.IsFunction()) {
-      functions_->Add(&Function::Cast(handle));
-    } else if (handle.IsKernelProgramInfo()) {
-      kernel_infos_->Add(&KernelProgramInfo::Cast(handle));
+    // Only allocate handles for the objects which are collected, as the
+    // heap of a large application holds millions of other objects. This also
+    // skips pseudo objects, which cannot be wrapped in handles.
+    if (obj->IsFunction()) {
+      functions_->Add(&Function::Handle(zone_, Function::RawCast(obj)));
+    } else if (obj->IsKernelProgramInfo()) {
+      kernel_infos_->Add(
+          &KernelProgramInfo::Handle(zone_, KernelProgramInfo::RawCast(obj)));
     }
   }
 
@@ -81,6 +81,20 @@ TEST_CASE(JSON_JSONStream_Primitives) {
   }
 }
 
+TEST_CASE(JSON_JSONStream_Integers) {
+  JSONStream js;
+  {
+    JSONArray jsarr(&js);
+    jsarr.AddValue(static_cast<intptr_t>(0));
+    jsarr.AddValue(static_cast<intptr_t>(-1));
+    jsarr.AddValue(static_cast<intptr_t>(1234567890));
+    jsarr.AddValue64(9007199254740991LL);
+    jsarr.AddValue64(-9007199254740991LL);
+  }
+  EXPECT_STREQ("[0,-1,1234567890,9007199254740991,-9007199254740991]",
+               js.ToCString());
+}
+
 TEST_CASE(JSON_JSONStream_Array) {
   JSONStream js;
   {
@@ -201,6 +215,21 @@ TEST_CASE(JSON_JSONStream_EscapedString) {
   EXPECT_STREQ("[\"Hel\\\"\\\"lo\\r\\n\\t\"]", js.ToCString());
 }
 
+TEST_CASE(JSON_JSONStream_LongEscapedString) {
+  // A long run of characters which are added as is, then escaped ones.
+  JSONStream js;
+  {
+    JSONArray jsarr(&js);
+    jsarr.AddValue(
+        "0123456789012345678901234567890123456789012345678901234567890123456789"
+        "/\"\u00e9");
+  }
+  EXPECT_STREQ(
+      "[\"012345678901234567890123456789012345678901234567890123456789"
+      "0123456789\\/\\\"\u00e9\"]",
+      js.ToCString());
+}
+
 TEST_CASE(JSON_JSONStream_DartString) {
   const char* kScriptChars =
       "var ascii = 'Hello, World!';\n"
@@ -96,24 +96,24 @@ void JSONWriter::CloseArray() {
 
 void JSONWriter::PrintValueNull() {
   PrintCommaIfNeeded();
-  buffer_.Printf("null");
+  buffer_.AddString("null");
 }
 
 void JSONWriter::PrintValueBool(bool b) {
   PrintCommaIfNeeded();
-  buffer_.Printf("%s", b ? "true" : "false");
+  buffer_.AddString(b ? "true" : "false");
 }
 
 void JSONWriter::PrintValue(intptr_t i) {
   EnsureIntegerIsRepresentableInJavaScript(static_cast<int64_t>(i));
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd "", i);
+  AddInt64(i);
 }
 
 void JSONWriter::PrintValue64(int64_t i) {
   EnsureIntegerIsRepresentableInJavaScript(i);
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd64 "", i);
+  AddInt64(i);
 }
 
 void JSONWriter::PrintValue(double d) {
@@ -174,7 +174,7 @@ bool JSONWriter::PrintValueStr(const String& s,
 
 void JSONWriter::PrintValueNoEscape(const char* s) {
   PrintCommaIfNeeded();
-  buffer_.Printf("%s", s);
+  buffer_.AddString(s);
 }
 
 void JSONWriter::PrintfValue(const char* format, ...) {
@@ -338,6 +338,30 @@ void JSONWriter::AddEscapedUTF8String(const char* s) {
   AddEscapedUTF8String(s, len);
 }
 
+// Whether an ASCII character can be added to a JSON string as is, see
+// TextBuffer::EscapeAndAddCodeUnit.
+static inline bool IsUnescapedAscii(uint32_t ch) {
+  return (ch >= 0x20) && (ch < 0x80) && (ch != '"') && (ch != '\\') &&
+         (ch != '/');
+}
+
+void JSONWriter::AddInt64(int64_t value) {
+  // Formatting with printf dominates printing large arrays of integers.
+  char digits[21];  // A sign and up to 20 digits.
+  intptr_t start = sizeof(digits);
+  uint64_t magnitude = (value < 0) ? (0 - static_cast<uint64_t>(value))
+                                   : static_cast<uint64_t>(value);
+  do {
+    digits[--start] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0) {
+    digits[--start] = '-';
+  }
+  buffer_.AddRaw(reinterpret_cast<const uint8_t*>(&digits[start]),
+                 sizeof(digits) - start);
+}
+
 void JSONWriter::AddEscapedUTF8String(const char* s, intptr_t len) {
   if (s == NULL) {
     return;
@@ -345,6 +369,16 @@ void JSONWriter::AddEscapedUTF8String(const char* s, intptr_t len) {
   const uint8_t* s8 = reinterpret_cast<const uint8_t*>(s);
   intptr_t i = 0;
   for (; i < len;) {
+    // Copy a run of characters which need no escaping at once.
+    intptr_t run_end = i;
+    while ((run_end < len) && IsUnescapedAscii(s8[run_end])) {
+      run_end++;
+    }
+    if (run_end > i) {
+      buffer_.AddRaw(&s8[i], run_end - i);
+      i = run_end;
+      continue;
+    }
     // Extract next UTF8 character.
     int32_t ch = 0;
     int32_t ch_len = Utf8::Decode(&s8[i], len - i, &ch);
@@ -368,8 +402,24 @@ bool JSONWriter::AddDartString(const String& s,
     count = length - offset;
   }
   intptr_t limit = offset + count;
+  // Characters which need no escaping are collected in 'run' and added at
+  // once.
+  uint8_t run[64];
+  intptr_t run_length = 0;
   for (intptr_t i = offset; i < limit; i++) {
     uint16_t code_unit = s.CharAt(i);
+    if (IsUnescapedAscii(code_unit)) {
+      run[run_length++] = code_unit;
+      if (run_length == sizeof(run)) {
+        buffer_.AddRaw(run, run_length);
+        run_length = 0;
+      }
+      continue;
+    }
+    if (run_length > 0) {
+      buffer_.AddRaw(run, run_length);
+      run_length = 0;
+    }
     if (Utf16::IsTrailSurrogate(code_unit)) {
       buffer_.EscapeAndAddUTF16CodeUnit(code_unit);
     } else if (Utf16::IsLeadSurrogate(code_unit)) {
@@ -389,6 +439,7 @@ bool JSONWriter::AddDartString(const String& s,
       buffer_.EscapeAndAddCodeUnit(code_unit);
     }
   }
+  buffer_.AddRaw(run, run_length);
   // Return value indicates whether the string is truncated.
   return (offset > 0) || (limit < length);
 }
@@ -82,6 +82,7 @@ class JSONWriter : ValueObject {
  private:
   bool NeedComma();
   bool AddDartString(const String& s, intptr_t offset, intptr_t count);
+  void AddInt64(int64_t value);
 
   // Debug only fatal assertion.
   static void EnsureIntegerIsRepresentableInJavaScript(int64_t i);
@@ -19,6 +19,7 @@
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
+#include "vm/thread_pool.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 namespace dart {
@@ -31,6 +32,106 @@ namespace kernel {
 
 static const char* const kVMServiceIOLibraryUri = "dart:vmservice_io";
 
+DEFINE_FLAG(bool,
+            concurrent_kernel_source_scan,
+            true,
+            "Decode the line starts of the sources of large kernel binaries "
+            "on helper threads.");
+
+// Components with fewer sources than this are scanned on the current thread.
+static const intptr_t kMinConcurrentSourceScanCount = 64;
+
+// Decodes the delta encoded line starts of all sources of a component on the
+// thread pool. Decoding only reads the kernel binary, the TypedData objects
+// are created from the results on the mutator thread.
+class LineStartsDecoder {
+ public:
+  LineStartsDecoder(KernelReaderHelper* helper, intptr_t source_count)
+      : data_(helper->reader_.BufferAt(0)),
+        size_(helper->reader_.size()),
+        source_count_(source_count),
+        offsets_(new intptr_t[source_count]),
+        max_deltas_(new int32_t[source_count]),
+        deltas_(new MallocGrowableArray<int32_t>[source_count]),
+        next_source_(0),
+        pending_tasks_(0) {
+    for (intptr_t i = 0; i < source_count; i++) {
+      offsets_[i] = helper->GetOffsetForLineStarts(i);
+    }
+  }
+
+  ~LineStartsDecoder() {
+    delete[] offsets_;
+    delete[] max_deltas_;
+    delete[] deltas_;
+  }
+
+  void Decode() {
+    pending_tasks_ = Utils::Minimum<intptr_t>(
+        OS::NumberOfAvailableProcessors() - 1, source_count_);
+    const intptr_t num_tasks = pending_tasks_;
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      if (!Dart::thread_pool()->Run(new DecodeTask(this))) {
+        MonitorLocker ml(&monitor_);
+        pending_tasks_--;
+      }
+    }
+
+    DecodeSources();
+    MonitorLocker ml(&monitor_);
+    while (pending_tasks_ > 0) {
+      ml.Wait();
+    }
+  }
+
+  const MallocGrowableArray<int32_t>& DeltasAt(intptr_t index) const {
+    return deltas_[index];
+  }
+  int32_t MaxDeltaAt(intptr_t index) const { return max_deltas_[index]; }
+
+ private:
+  class DecodeTask : public ThreadPool::Task {
+   public:
+    explicit DecodeTask(LineStartsDecoder* decoder) : decoder_(decoder) {}
+
+    void Run() {
+      decoder_->DecodeSources();
+      MonitorLocker ml(&decoder_->monitor_);
+      if (--decoder_->pending_tasks_ == 0) {
+        ml.Notify();
+      }
+    }
+
+   private:
+    LineStartsDecoder* decoder_;
+
+    DISALLOW_COPY_AND_ASSIGN(DecodeTask);
+  };
+
+  void DecodeSources() {
+    Reader reader(data_, size_);
+    for (;;) {
+      const intptr_t i = AtomicOperations::FetchAndIncrement(&next_source_);
+      if (i >= source_count_) break;
+      reader.set_offset(offsets_[i]);
+      max_deltas_[i] =
+          KernelReaderHelper::ReadLineStartDeltas(&reader, &deltas_[i]);
+    }
+  }
+
+  const uint8_t* data_;
+  const intptr_t size_;
+  const intptr_t source_count_;
+  intptr_t* offsets_;
+  int32_t* max_deltas_;
+  MallocGrowableArray<int32_t>* deltas_;
+  intptr_t next_source_;
+  Monitor monitor_;
+  intptr_t pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(LineStartsDecoder);
+};
+
 class SimpleExpressionConverter {
  public:
   SimpleExpressionConverter(TranslationHelper* translation_helper,
@@ -372,6 +473,10 @@ void KernelLoader::InitializeFields(UriToSourceTable* uri_to_source_table) {
     offsets.SetUint32(i << 2, end_offset);
   }
 
+  // Most strings of the program end up as symbols, so make room for them at
+  // once instead of rehashing the symbol table repeatedly while loading.
+  Symbols::ReserveCapacity(thread_, count - 1);
+
   // Create view of the string data.
   const ExternalTypedData& data = ExternalTypedData::Handle(
       Z,
@@ -419,11 +524,20 @@ void KernelLoader::InitializeFields(UriToSourceTable* uri_to_source_table) {
 
   H.InitFromKernelProgramInfo(kernel_program_info_);
 
+  LineStartsDecoder* line_starts = nullptr;
+  if (FLAG_concurrent_kernel_source_scan &&
+      (source_table_size >= kMinConcurrentSourceScanCount)) {
+    TIMELINE_DURATION(thread_, Isolate, "DecodeLineStarts");
+    line_starts = new LineStartsDecoder(&helper_, source_table_size);
+    line_starts->Decode();
+  }
+
   Script& script = Script::Handle(Z);
   for (intptr_t index = 0; index < source_table_size; ++index) {
-    script = LoadScriptAt(index, uri_to_source_table);
+    script = LoadScriptAt(index, uri_to_source_table, line_starts);
     scripts.SetAt(index, script);
   }
+  delete line_starts;
 
   if (FLAG_enable_interpreter || FLAG_use_bytecode_compiler) {
     bytecode_metadata_helper_.ReadBytecodeComponent();
@@ -948,6 +1062,7 @@ void KernelLoader::ReadInferredType(const Field& field,
   }
   field.set_guarded_cid(type.cid);
   field.set_is_nullable(type.IsNullable());
+  field.set_is_inferred_int(type.IsInt());
   field.set_guarded_list_length(Field::kNoFixedLength);
 }
 
@@ -1982,8 +2097,10 @@ const Object& KernelLoader::ClassForScriptAt(const Class& klass,
   return klass;
 }
 
-RawScript* KernelLoader::LoadScriptAt(intptr_t index,
-                                      UriToSourceTable* uri_to_source_table) {
+RawScript* KernelLoader::LoadScriptAt(
+    intptr_t index,
+    UriToSourceTable* uri_to_source_table,
+    const LineStartsDecoder* decoded_line_starts) {
   const String& uri_string = helper_.SourceTableUriFor(index);
   const String& import_uri_string =
       helper_.SourceTableImportUriFor(index, program_->binary_version());
@@ -2003,7 +2120,13 @@ RawScript* KernelLoader::LoadScriptAt(intptr_t index,
 
   if (sources.IsNull() || line_starts.IsNull()) {
     const String& script_source = helper_.GetSourceFor(index);
-    line_starts ^= helper_.GetLineStartsFor(index);
+    if (decoded_line_starts != nullptr) {
+      line_starts ^=
+          helper_.NewLineStarts(decoded_line_starts->DeltasAt(index),
+                                decoded_line_starts->MaxDeltaAt(index));
+    } else {
+      line_starts ^= helper_.GetLineStartsFor(index);
+    }
 
     if (script_source.raw() == Symbols::Empty().raw() &&
         line_starts.Length() == 0 && uri_string.Length() > 0) {
@@ -19,6 +19,7 @@ namespace dart {
 namespace kernel {
 
 class KernelLoader;
+class LineStartsDecoder;
 
 class BuildingTranslationHelper : public TranslationHelper {
  public:
@@ -326,9 +327,11 @@ class KernelLoader : public ValueObject {
   RawArray* MakeFieldsArray();
   RawArray* MakeFunctionsArray();
 
+  // [line_starts] may hold the already decoded line starts of the sources.
   RawScript* LoadScriptAt(
       intptr_t index,
-      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table);
+      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table,
+      const LineStartsDecoder* line_starts);
 
   // If klass's script is not the script at the uri index, return a PatchClass
   // for klass whose script corresponds to the uri index.
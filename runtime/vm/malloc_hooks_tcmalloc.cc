@@ -8,9 +8,13 @@
 
 #include "vm/malloc_hooks.h"
 
+#include <math.h>
+
 #include "gperftools/malloc_hook.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
+#include "vm/flags.h"
 #include "vm/hash_map.h"
 #include "vm/json_stream.h"
 #include "vm/os_thread.h"
@@ -18,6 +22,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            profiler_native_memory_sampling_interval,
+            0,
+            "Track about one native allocation every this many bytes, with "
+            "its sizes scaled up accordingly, instead of every allocation. "
+            "0 tracks every allocation.");
+
 class AddressMap;
 
 // MallocHooksState contains all of the state related to the configuration of
@@ -27,6 +38,30 @@ class MallocHooksState : public AllStatic {
   static void RecordAllocHook(const void* ptr, size_t size);
   static void RecordFreeHook(const void* ptr);
 
+  // Returns 0 if this allocation isn't sampled, or else the number of bytes
+  // it stands for. Doesn't need the lock.
+  static intptr_t SampledSize(size_t size);
+
+  // False if the allocation at [ptr] certainly wasn't sampled. Doesn't need
+  // the lock, so frees of allocations which weren't sampled stay cheap.
+  static bool MaybeSampled(const void* ptr) {
+    return AtomicOperations::LoadRelaxed(
+               &sampled_address_filter_[SampledAddressFilterIndex(ptr)]) != 0;
+  }
+
+  static void AddSampledAddress(const void* ptr) {
+    ASSERT(malloc_hook_mutex()->IsOwnedByCurrentThread());
+    sampled_address_filter_[SampledAddressFilterIndex(ptr)]++;
+  }
+
+  static void RemoveSampledAddress(const void* ptr) {
+    ASSERT(malloc_hook_mutex()->IsOwnedByCurrentThread());
+    ASSERT(MaybeSampled(ptr));
+    sampled_address_filter_[SampledAddressFilterIndex(ptr)]--;
+  }
+
+  static intptr_t sampling_interval() { return sampling_interval_; }
+
   static bool Active() {
     ASSERT(malloc_hook_mutex()->IsOwnedByCurrentThread());
     return active_;
@@ -84,6 +119,12 @@ class MallocHooksState : public AllStatic {
   static void TearDown();
 
  private:
+  static intptr_t SampledAddressFilterIndex(const void* ptr) {
+    const uword address = reinterpret_cast<uword>(ptr);
+    return ((address >> 4) ^ (address >> 16)) &
+           (kSampledAddressFilterSize - 1);
+  }
+
   static Mutex* malloc_hook_mutex_;
   static ThreadId malloc_hook_mutex_owner_;
 
@@ -95,6 +136,14 @@ class MallocHooksState : public AllStatic {
   static AddressMap* address_map_;
   // End protected variables.
 
+  // --profiler_native_memory_sampling_interval when the hooks were
+  // installed.
+  static intptr_t sampling_interval_;
+  // Number of live sampled allocations whose address hashes to each entry.
+  // Written with the lock held, read without it.
+  static const intptr_t kSampledAddressFilterSize = 4096;
+  static uint32_t sampled_address_filter_[kSampledAddressFilterSize];
+
   static intptr_t original_pid_;
   static const intptr_t kInvalidPid = -1;
 };
@@ -233,13 +282,18 @@ intptr_t MallocHooksState::allocation_count_ = 0;
 intptr_t MallocHooksState::heap_allocated_memory_in_bytes_ = 0;
 AddressMap* MallocHooksState::address_map_ = NULL;
 
+intptr_t MallocHooksState::sampling_interval_ = 0;
+uint32_t MallocHooksState::sampled_address_filter_[kSampledAddressFilterSize];
+
 void MallocHooksState::Init() {
   address_map_ = new AddressMap();
   active_ = true;
+  sampling_interval_ = FLAG_profiler_native_memory_sampling_interval;
 #if defined(DEBUG)
   stack_trace_collection_enabled_ = true;
 #else
-  stack_trace_collection_enabled_ = false;
+  // Sampled allocations are rare enough to always collect their stacks.
+  stack_trace_collection_enabled_ = (sampling_interval_ > 0);
 #endif  // defined(DEBUG)
   original_pid_ = OS::ProcessId();
 }
@@ -249,6 +303,7 @@ void MallocHooksState::ResetStats() {
   allocation_count_ = 0;
   heap_allocated_memory_in_bytes_ = 0;
   address_map_->Clear();
+  memset(sampled_address_filter_, 0, sizeof(sampled_address_filter_));
 }
 
 void MallocHooksState::TearDown() {
@@ -258,6 +313,57 @@ void MallocHooksState::TearDown() {
   ResetStats();
   delete address_map_;
   address_map_ = NULL;
+  sampling_interval_ = 0;
+}
+
+static uint32_t NextRandom(uint32_t* state) {
+  // xorshift32.
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+// Draws the number of bytes until the next sample from an exponential
+// distribution, which makes every allocated byte equally likely to be
+// sampled independently of the allocation sizes.
+static intptr_t NextSampleCountdown(uint32_t* random, intptr_t interval) {
+  // Uniform in (0, 1].
+  const double uniform = (NextRandom(random) + 1.0) / 4294967296.0;
+  return static_cast<intptr_t>(-log(uniform) * interval) + 1;
+}
+
+intptr_t MallocHooksState::SampledSize(size_t size) {
+  OSThread* thread = OSThread::TryCurrent();
+  if (thread == NULL) {
+    // No place for the countdown yet.
+    return 0;
+  }
+  const intptr_t interval = sampling_interval_;
+  uint32_t* random = &thread->native_allocation_sample_random_;
+  if (*random == 0) {
+    *random = static_cast<uint32_t>(OS::GetCurrentMonotonicMicros()) ^
+              static_cast<uint32_t>(reinterpret_cast<uword>(thread));
+    if (*random == 0) {
+      *random = 1;
+    }
+    thread->native_allocation_sample_countdown_ =
+        NextSampleCountdown(random, interval);
+  }
+  thread->native_allocation_sample_countdown_ -= size;
+  if (thread->native_allocation_sample_countdown_ > 0) {
+    return 0;
+  }
+  thread->native_allocation_sample_countdown_ =
+      NextSampleCountdown(random, interval);
+  // An allocation of [size] bytes is sampled with probability
+  // 1 - e^(-size / interval). Scaling it by the inverse keeps the totals
+  // unbiased.
+  const double probability =
+      1.0 - exp(-static_cast<double>(size) / static_cast<double>(interval));
+  return static_cast<intptr_t>(size / probability);
 }
 
 void MallocHooks::Init() {
@@ -398,6 +504,17 @@ void MallocHooksState::RecordAllocHook(const void* ptr, size_t size) {
     return;
   }
 
+  // With sampling the size of a sampled allocation is scaled up to the bytes
+  // it stands for, so that the totals and the profile estimate the
+  // unsampled ones.
+  const bool sampling = MallocHooksState::sampling_interval() > 0;
+  if (sampling) {
+    size = MallocHooksState::SampledSize(size);
+    if (size == 0) {
+      return;
+    }
+  }
+
   MallocLocker ml(MallocHooksState::malloc_hook_mutex(),
                   MallocHooksState::malloc_hook_mutex_owner());
   // Now that we hold the lock, check to make sure everything is still active.
@@ -405,6 +522,9 @@ void MallocHooksState::RecordAllocHook(const void* ptr, size_t size) {
     MallocHooksState::IncrementHeapAllocatedMemoryInBytes(size);
     MallocHooksState::address_map()->Insert(
         ptr, new AllocationInfo(reinterpret_cast<uword>(ptr), size));
+    if (sampling) {
+      MallocHooksState::AddSampledAddress(ptr);
+    }
   }
 }
 
@@ -413,6 +533,10 @@ void MallocHooksState::RecordFreeHook(const void* ptr) {
       !MallocHooksState::IsOriginalProcess()) {
     return;
   }
+  const bool sampling = MallocHooksState::sampling_interval() > 0;
+  if (sampling && !MallocHooksState::MaybeSampled(ptr)) {
+    return;
+  }
 
   MallocLocker ml(MallocHooksState::malloc_hook_mutex(),
                   MallocHooksState::malloc_hook_mutex_owner());
@@ -425,6 +549,9 @@ void MallocHooksState::RecordFreeHook(const void* ptr) {
       const bool result = MallocHooksState::address_map()->Remove(ptr);
       ASSERT(result);
       delete allocation_info;
+      if (sampling) {
+        MallocHooksState::RemoveSampledAddress(ptr);
+      }
     }
   }
 }
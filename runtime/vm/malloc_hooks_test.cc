@@ -16,6 +16,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, profiler_native_memory_sampling_interval);
+
 static void MallocHookTestBufferInitializer(volatile char* buffer,
                                             uintptr_t size) {
   // Run through the buffer and do something. If we don't do this and the memory
@@ -112,6 +114,52 @@ UNIT_TEST_CASE(FreeUnseenMemoryMallocHookTest) {
   EXPECT_EQ(0L, MallocHooks::heap_allocated_memory_in_bytes());
 }
 
+class SampledMallocHooksScope : public ValueObject {
+ public:
+  explicit SampledMallocHooksScope(intptr_t interval)
+      : saved_interval_(FLAG_profiler_native_memory_sampling_interval) {
+    FLAG_profiler_native_memory_sampling_interval = interval;
+  }
+
+  ~SampledMallocHooksScope() {
+    FLAG_profiler_native_memory_sampling_interval = saved_interval_;
+  }
+
+ private:
+  intptr_t saved_interval_;
+};
+
+VM_UNIT_TEST_CASE(SampledMallocHookTest) {
+  SampledMallocHooksScope sampled(1 * KB);
+  EnableMallocHooksScope scope;
+
+  // Small allocations are mostly left out.
+  const intptr_t small_count = 1000;
+  char* small_buffers[small_count];
+  for (intptr_t i = 0; i < small_count; i++) {
+    small_buffers[i] = new char[8];
+    MallocHookTestBufferInitializer(small_buffers[i], 8);
+  }
+  EXPECT_LT(MallocHooks::allocation_count(), small_count);
+  for (intptr_t i = 0; i < small_count; i++) {
+    delete[] small_buffers[i];
+  }
+  EXPECT_EQ(0L, MallocHooks::allocation_count());
+  EXPECT_EQ(0L, MallocHooks::heap_allocated_memory_in_bytes());
+
+  // Allocations much larger than the interval are always sampled at their
+  // own size.
+  const intptr_t buffer_size = 1 * MB;
+  char* buffer = new char[buffer_size];
+  MallocHookTestBufferInitializer(buffer, buffer_size);
+  EXPECT_EQ(1L, MallocHooks::allocation_count());
+  EXPECT_EQ(buffer_size, MallocHooks::heap_allocated_memory_in_bytes());
+
+  delete[] buffer;
+  EXPECT_EQ(0L, MallocHooks::allocation_count());
+  EXPECT_EQ(0L, MallocHooks::heap_allocated_memory_in_bytes());
+}
+
 VM_UNIT_TEST_CASE(StackTraceMallocHookSimpleTest) {
   EnableMallocHooksAndStacksScope scope;
 
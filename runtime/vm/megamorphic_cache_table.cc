@@ -5,6 +5,7 @@
 #include "vm/megamorphic_cache_table.h"
 
 #include <stdlib.h>
+#include "vm/flags.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/stub_code.h"
@@ -12,6 +13,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            dump_megamorphic_probes,
+            false,
+            "With --dump-megamorphic-stats, also print the probe lengths of "
+            "every megamorphic cache.");
+
 RawMegamorphicCache* MegamorphicCacheTable::Lookup(Isolate* isolate,
                                                    const String& name,
                                                    const Array& descriptor) {
@@ -131,35 +138,43 @@ void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
   for (intptr_t i = 0; i < max_size; i++) {
     probe_counts[i] = 0;
   }
+  String& name = String::Handle();
   for (intptr_t i = 0; i < table.Length(); i++) {
     cache ^= table.At(i);
     buckets = cache.buckets();
     intptr_t mask = cache.mask();
     intptr_t capacity = mask + 1;
+    intptr_t cache_entry_count = 0;
+    intptr_t cache_probe_count = 0;
+    intptr_t cache_max_probe_count = 0;
     for (intptr_t j = 0; j < capacity; j++) {
       intptr_t class_id =
           Smi::Value(Smi::RawCast(cache.GetClassId(buckets, j)));
       if (class_id != kIllegalCid) {
-        intptr_t probe_count = 0;
-        intptr_t probe_index =
-            (class_id * MegamorphicCache::kSpreadFactor) & mask;
-        intptr_t probe_cid;
-        while (true) {
-          probe_count++;
-          probe_cid =
-              Smi::Value(Smi::RawCast(cache.GetClassId(buckets, probe_index)));
-          if (probe_cid == class_id) {
-            break;
-          }
-          probe_index = (probe_index + 1) & mask;
-        }
+        intptr_t probe_count =
+            MegamorphicCache::ProbeCount(buckets, mask, class_id);
+        ASSERT(probe_count > 0);
         probe_counts[probe_count]++;
         if (probe_count > max_probe_count) {
           max_probe_count = probe_count;
         }
+        if (probe_count > cache_max_probe_count) {
+          cache_max_probe_count = probe_count;
+        }
+        cache_probe_count += probe_count;
+        cache_entry_count++;
         entry_count++;
       }
     }
+    if (FLAG_dump_megamorphic_probes && (cache_entry_count > 0)) {
+      name = cache.target_name();
+      OS::PrintErr("Megamorphic cache %s: %" Pd " entries, capacity %" Pd
+                   ", max probe %" Pd ", average probe %lf\n",
+                   name.ToCString(), cache_entry_count, capacity,
+                   cache_max_probe_count,
+                   static_cast<double>(cache_probe_count) /
+                       static_cast<double>(cache_entry_count));
+    }
   }
   intptr_t cumulative_entries = 0;
   for (intptr_t i = 0; i <= max_probe_count; i++) {
@@ -23,7 +23,8 @@ Message::Message(Dart_Port dest_port,
       snapshot_(snapshot),
       snapshot_length_(snapshot_length),
       finalizable_data_(finalizable_data),
-      priority_(priority) {
+      priority_(priority),
+      is_flat_(false) {
   ASSERT((priority == kNormalPriority) ||
          (delivery_failure_port == kIllegalPort));
   ASSERT(!IsRaw());
@@ -39,7 +40,8 @@ Message::Message(Dart_Port dest_port,
       snapshot_(reinterpret_cast<uint8_t*>(raw_obj)),
       snapshot_length_(0),
       finalizable_data_(NULL),
-      priority_(priority) {
+      priority_(priority),
+      is_flat_(false) {
   ASSERT(!raw_obj->IsHeapObject() || raw_obj->InVMIsolateHeap());
   ASSERT((priority == kNormalPriority) ||
          (delivery_failure_port == kIllegalPort));
@@ -150,6 +152,31 @@ Message* MessageQueue::Dequeue() {
   return NULL;
 }
 
+void MessageQueue::DequeueInto(MessageQueue* other, intptr_t count) {
+  for (intptr_t i = 0; (i < count) && (head_ != NULL); i++) {
+    Message* msg = head_;
+    head_ = msg->next_;
+    msg->next_ = NULL;
+    other->Enqueue(msg, false);
+  }
+  if (head_ == NULL) {
+    tail_ = NULL;
+  }
+}
+
+void MessageQueue::Prepend(MessageQueue* other) {
+  if (other->head_ == NULL) {
+    return;
+  }
+  other->tail_->next_ = head_;
+  if (head_ == NULL) {
+    tail_ = other->tail_;
+  }
+  head_ = other->head_;
+  other->head_ = NULL;
+  other->tail_ = NULL;
+}
+
 void MessageQueue::Clear() {
   Message* cur = head_;
   head_ = NULL;
@@ -165,6 +192,51 @@ void MessageQueue::Clear() {
   }
 }
 
+bool IncomingMessageList::Add(Message* msg) {
+  ASSERT(msg->next_ == NULL);
+  Message* head = AtomicOperations::LoadRelaxed(&head_);
+  while (true) {
+    msg->next_ = head;
+    Message* previous =
+        AtomicOperations::CompareAndSwapPointer(&head_, head, msg);
+    if (previous == head) {
+      return head == NULL;
+    }
+    head = previous;
+  }
+}
+
+void IncomingMessageList::MoveTo(MessageQueue* queue,
+                                 MessageQueue* oob_queue) {
+  Message* head = AtomicOperations::LoadRelaxed(&head_);
+  while (head != NULL) {
+    Message* previous = AtomicOperations::CompareAndSwapPointer(
+        &head_, head, static_cast<Message*>(NULL));
+    if (previous == head) {
+      break;
+    }
+    head = previous;
+  }
+  // The list holds the newest message first: reverse it.
+  Message* oldest = NULL;
+  while (head != NULL) {
+    Message* next = head->next_;
+    head->next_ = oldest;
+    oldest = head;
+    head = next;
+  }
+  while (oldest != NULL) {
+    Message* next = oldest->next_;
+    oldest->next_ = NULL;
+    if (oldest->IsOOB()) {
+      oob_queue->Enqueue(oldest, false);
+    } else {
+      queue->Enqueue(oldest, false);
+    }
+    oldest = next;
+  }
+}
+
 MessageQueue::Iterator::Iterator(const MessageQueue* queue) : next_(NULL) {
   Reset(queue);
 }
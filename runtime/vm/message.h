@@ -6,6 +6,7 @@
 #define RUNTIME_VM_MESSAGE_H_
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
@@ -88,6 +89,11 @@ class Message {
   bool IsOOB() const { return priority_ == Message::kOOBPriority; }
   bool IsRaw() const { return snapshot_length_ == 0; }
 
+  // Whether the snapshot was written by FlatMessageWriter rather than as a
+  // regular message snapshot.
+  bool IsFlat() const { return is_flat_; }
+  void set_is_flat(bool value) { is_flat_ = value; }
+
   bool RedirectToDeliveryFailurePort();
 
   intptr_t Id() const;
@@ -96,6 +102,7 @@ class Message {
 
  private:
   friend class MessageQueue;
+  friend class IncomingMessageList;
 
   Message* next_;
   Dart_Port dest_port_;
@@ -104,6 +111,7 @@ class Message {
   intptr_t snapshot_length_;
   MessageFinalizableData* finalizable_data_;
   Priority priority_;
+  bool is_flat_;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
@@ -120,6 +128,14 @@ class MessageQueue {
   // message is available.  This function will not block.
   Message* Dequeue();
 
+  // Moves up to |count| messages from the front of this queue to the end of
+  // |other|.
+  void DequeueInto(MessageQueue* other, intptr_t count);
+
+  // Moves all messages in |other| in front of the messages in this queue,
+  // keeping their order.
+  void Prepend(MessageQueue* other);
+
   bool IsEmpty() { return head_ == NULL; }
 
   // Clear all messages from the message queue.
@@ -157,6 +173,31 @@ class MessageQueue {
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
+// Messages posted to a message handler before it moves them into its queues.
+// Any number of threads can add messages without taking a lock; the handler
+// takes them all at once while holding its monitor.
+class IncomingMessageList {
+ public:
+  IncomingMessageList() : head_(NULL) {}
+  ~IncomingMessageList() { ASSERT(IsEmpty()); }
+
+  // Adds |msg| to the list. Returns true if the list was empty, in which
+  // case the caller must make sure the handler notices the new message.
+  bool Add(Message* msg);
+
+  // Moves all messages in the list to |queue| or |oob_queue| depending on
+  // their priority, in the order they were added.
+  void MoveTo(MessageQueue* queue, MessageQueue* oob_queue);
+
+  bool IsEmpty() { return AtomicOperations::LoadAcquire(&head_) == NULL; }
+
+ private:
+  // The most recently added message, linked through Message::next_.
+  Message* head_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncomingMessageList);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_MESSAGE_H_
@@ -9,26 +9,81 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/os.h"
+#include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/thread_interrupter.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+DEFINE_FLAG(int,
+            message_batch_size,
+            16,
+            "Maximum number of normal messages a message handler takes from "
+            "its queue at once.");
+DEFINE_FLAG(int,
+            message_batch_micros,
+            1000,
+            "Time after which a message handler stops delivering a batch of "
+            "messages and looks at its queues again.");
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
-  explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
+  explicit MessageHandlerTask(MessageHandler* handler)
+      : handler_(handler), post_micros_(-1) {
     ASSERT(handler != NULL);
+#if defined(SUPPORT_TIMELINE)
+    if (Timeline::GetIsolateStream()->enabled()) {
+      post_micros_ = OS::GetCurrentMonotonicMicros();
+    }
+#endif
   }
 
   virtual void Run() {
     ASSERT(handler_ != NULL);
+    // The handler may be deleted by TaskCallback, so read its settings first.
+    const uint64_t mask = handler_->cpu_affinity_mask();
+    const bool pinned =
+        (mask != 0) && OSThread::SetCurrentThreadAffinity(mask);
+    const bool batch = handler_->batch_scheduling() &&
+                       OSThread::SetCurrentThreadBatchScheduling(true);
+#if defined(SUPPORT_TIMELINE)
+    if (post_micros_ >= 0) {
+      ReportQueueDelay(batch);
+    }
+#endif
     handler_->TaskCallback();
+    // The worker goes back to the pool and may run other handlers next.
+    if (batch) {
+      OSThread::SetCurrentThreadBatchScheduling(false);
+    }
+    if (pinned) {
+      OSThread::SetCurrentThreadAffinity(0);
+    }
   }
 
  private:
+#if defined(SUPPORT_TIMELINE)
+  // Records how long the task waited between being posted and getting a
+  // worker thread, which grows when the CPUs are saturated.
+  void ReportQueueDelay(bool batch) {
+    TimelineEvent* event = Timeline::GetIsolateStream()->StartEvent();
+    if (event == NULL) {
+      return;
+    }
+    event->Duration("MessageHandlerQueueDelay", post_micros_,
+                    OS::GetCurrentMonotonicMicros());
+    event->SetNumArguments(2);
+    event->CopyArgument(0, "handler", handler_->name());
+    event->CopyArgument(1, "scheduling", batch ? "batch" : "normal");
+    event->Complete();
+  }
+#endif
+
   MessageHandler* handler_;
+  int64_t post_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageHandlerTask);
 };
@@ -53,6 +108,7 @@ const char* MessageHandler::MessageStatusString(MessageStatus status) {
 MessageHandler::MessageHandler()
     : queue_(new MessageQueue()),
       oob_queue_(new MessageQueue()),
+      incoming_(),
       oob_message_handling_allowed_(true),
       paused_for_messages_(false),
       live_ports_(0),
@@ -65,6 +121,8 @@ MessageHandler::MessageHandler()
       paused_timestamp_(-1),
 #endif
       delete_me_(false),
+      cpu_affinity_mask_(0),
+      batch_scheduling_(false),
       pool_(NULL),
       task_(NULL),
       idle_start_time_(0),
@@ -76,6 +134,7 @@ MessageHandler::MessageHandler()
 }
 
 MessageHandler::~MessageHandler() {
+  incoming_.MoveTo(queue_, oob_queue_);
   delete queue_;
   delete oob_queue_;
   queue_ = NULL;
@@ -122,56 +181,66 @@ void MessageHandler::Run(ThreadPool* pool,
 }
 
 void MessageHandler::PostMessage(Message* message, bool before_events) {
-  Message::Priority saved_priority;
-  bool task_running = true;
-  {
-    MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
-      }
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
     }
+  }
 
-    saved_priority = message->priority();
+  Message::Priority saved_priority = message->priority();
+  if (before_events) {
+    // Ordering against the pending messages needs the queues themselves.
+    MonitorLocker ml(&monitor_);
+    incoming_.MoveTo(queue_, oob_queue_);
     if (message->IsOOB()) {
       oob_queue_->Enqueue(message, before_events);
     } else {
       queue_->Enqueue(message, before_events);
     }
-    if (paused_for_messages_) {
-      ml.Notify();
-    }
-    message = NULL;  // Do not access message.  May have been deleted.
-
-    if ((pool_ != NULL) && (task_ == NULL)) {
-      ASSERT(!delete_me_);
-      task_ = new MessageHandlerTask(this);
-      task_running = pool_->Run(task_);
-    }
+    NotifyIncomingLocked(&ml);
+  } else if (incoming_.Add(message)) {
+    // The list was empty, so nobody is on their way to wake up the handler
+    // yet. Messages added while it is non-empty are picked up together with
+    // this one.
+    MonitorLocker ml(&monitor_);
+    NotifyIncomingLocked(&ml);
   }
-  ASSERT(task_running);
+  message = NULL;  // Do not access message.  May have been deleted.
 
   // Invoke any custom message notification.
   MessageNotify(saved_priority);
 }
 
+void MessageHandler::NotifyIncomingLocked(MonitorLocker* ml) {
+  if (paused_for_messages_) {
+    ml->Notify();
+  }
+  if ((pool_ != NULL) && (task_ == NULL)) {
+    ASSERT(!delete_me_);
+    task_ = new MessageHandlerTask(this);
+    bool task_running = pool_->Run(task_);
+    ASSERT(task_running);
+  }
+}
+
 Message* MessageHandler::DequeueMessage(Message::Priority min_priority) {
   // TODO(turnidge): Add assert that monitor_ is held here.
+  incoming_.MoveTo(queue_, oob_queue_);
   Message* message = oob_queue_->Dequeue();
   if ((message == NULL) && (min_priority < Message::kOOBPriority)) {
     message = queue_->Dequeue();
@@ -180,6 +249,7 @@ Message* MessageHandler::DequeueMessage(Message::Priority min_priority) {
 }
 
 void MessageHandler::ClearOOBQueue() {
+  incoming_.MoveTo(queue_, oob_queue_);
   oob_queue_->Clear();
 }
 
@@ -197,59 +267,91 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
       ((allow_normal_messages && !paused()) ? Message::kNormalPriority
                                             : Message::kOOBPriority);
   Message* message = DequeueMessage(min_priority);
+  // Normal messages after the first are taken from the queue in batches and
+  // handled without reacquiring the monitor. OOB messages which arrive in
+  // the meantime are still handled promptly by isolates, from the message
+  // interrupt.
+  MessageQueue batch;
   while (message != NULL) {
-    intptr_t message_len = message->Size();
-    if (FLAG_trace_isolates) {
-      OS::PrintErr(
-          "[<] Handling message:\n"
-          "\tlen:        %" Pd
-          "\n"
-          "\thandler:    %s\n"
-          "\tport:       %" Pd64 "\n",
-          message_len, name(), message->dest_port());
+    if ((message->priority() == Message::kNormalPriority) &&
+        allow_multiple_normal_messages) {
+      // There are no OOB messages pending, or DequeueMessage would have
+      // returned one.
+      ASSERT(oob_queue_->IsEmpty());
+      queue_->DequeueInto(&batch, FLAG_message_batch_size - 1);
     }
 
-    // Release the monitor_ temporarily while we handle the message.
+    // Release the monitor_ temporarily while we handle the messages.
     // The monitor was acquired in MessageHandler::TaskCallback().
     ml->Exit();
-    Message::Priority saved_priority = message->priority();
-    Dart_Port saved_dest_port = message->dest_port();
-    MessageStatus status = HandleMessage(message);
-    if (status > max_status) {
-      max_status = status;
+    const int64_t batch_deadline =
+        batch.IsEmpty()
+            ? 0
+            : OS::GetCurrentMonotonicMicros() + FLAG_message_batch_micros;
+    while (true) {
+      intptr_t message_len = message->Size();
+      if (FLAG_trace_isolates) {
+        OS::PrintErr(
+            "[<] Handling message:\n"
+            "\tlen:        %" Pd
+            "\n"
+            "\thandler:    %s\n"
+            "\tport:       %" Pd64 "\n",
+            message_len, name(), message->dest_port());
+      }
+
+      Message::Priority saved_priority = message->priority();
+      Dart_Port saved_dest_port = message->dest_port();
+      MessageStatus status = HandleMessage(message);
+      if (status > max_status) {
+        max_status = status;
+      }
+      message = NULL;  // May be deleted by now.
+      if (FLAG_trace_isolates) {
+        OS::PrintErr(
+            "[.] Message handled (%s):\n"
+            "\tlen:        %" Pd
+            "\n"
+            "\thandler:    %s\n"
+            "\tport:       %" Pd64 "\n",
+            MessageStatusString(status), message_len, name(), saved_dest_port);
+      }
+      // If we are shutting down, do not process any more messages.
+      if (status == kShutdown) {
+        break;
+      }
+
+      // Remember time since the last message. Don't consider OOB messages so
+      // using Observatory doesn't trigger additional idle tasks.
+      if ((FLAG_idle_timeout_micros != 0) &&
+          (saved_priority == Message::kNormalPriority)) {
+        idle_start_time_ = OS::GetCurrentMonotonicMicros();
+      }
+
+      // Some callers want to process only one normal message and then quit.
+      // At the same time it is OK to process multiple OOB messages.
+      if ((saved_priority == Message::kNormalPriority) &&
+          !allow_multiple_normal_messages) {
+        // We processed one normal message.  Allow no more.
+        allow_normal_messages = false;
+      }
+
+      // Carry on with the batch only while normal messages may still be
+      // handled. Handling a message may have paused the handler or failed.
+      if (batch.IsEmpty() || (max_status != kOK) || !allow_normal_messages ||
+          paused() || (OS::GetCurrentMonotonicMicros() > batch_deadline)) {
+        break;
+      }
+      message = batch.Dequeue();
     }
-    message = NULL;  // May be deleted by now.
     ml->Enter();
-    if (FLAG_trace_isolates) {
-      OS::PrintErr(
-          "[.] Message handled (%s):\n"
-          "\tlen:        %" Pd
-          "\n"
-          "\thandler:    %s\n"
-          "\tport:       %" Pd64 "\n",
-          MessageStatusString(status), message_len, name(), saved_dest_port);
-    }
-    // If we are shutting down, do not process any more messages.
-    if (status == kShutdown) {
+    // The rest of the batch was taken before anything now in the queue.
+    queue_->Prepend(&batch);
+    if (max_status == kShutdown) {
       ClearOOBQueue();
       break;
     }
 
-    // Remember time since the last message. Don't consider OOB messages so
-    // using Observatory doesn't trigger additional idle tasks.
-    if ((FLAG_idle_timeout_micros != 0) &&
-        (saved_priority == Message::kNormalPriority)) {
-      idle_start_time_ = OS::GetCurrentMonotonicMicros();
-    }
-
-    // Some callers want to process only one normal message and then quit. At
-    // the same time it is OK to process multiple OOB messages.
-    if ((saved_priority == Message::kNormalPriority) &&
-        !allow_multiple_normal_messages) {
-      // We processed one normal message.  Allow no more.
-      allow_normal_messages = false;
-    }
-
     // Reevaluate the minimum allowable priority.  The paused state
     // may have changed as part of handling the message.  We may also
     // have encountered an error during message processing.
@@ -285,10 +387,12 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
   CheckAccess();
 #endif
   paused_for_messages_ = true;
+  incoming_.MoveTo(queue_, oob_queue_);
   while (queue_->IsEmpty() && oob_queue_->IsEmpty()) {
     Monitor::WaitResult wr = ml.Wait(timeout_millis);
     ASSERT(task_ != NULL);
     ASSERT(!delete_me_);
+    incoming_.MoveTo(queue_, oob_queue_);
     if (wr == Monitor::kTimedOut) {
       break;
     }
@@ -344,11 +448,13 @@ bool MessageHandler::ShouldPauseOnExit(MessageStatus status) const {
 
 bool MessageHandler::HasOOBMessages() {
   MonitorLocker ml(&monitor_);
+  incoming_.MoveTo(queue_, oob_queue_);
   return !oob_queue_->IsEmpty();
 }
 
 bool MessageHandler::HasMessages() {
   MonitorLocker ml(&monitor_);
+  incoming_.MoveTo(queue_, oob_queue_);
   return !queue_->IsEmpty();
 }
 
@@ -554,6 +660,7 @@ void MessageHandler::CloseAllPorts() {
         "\thandler:    %s\n",
         name());
   }
+  incoming_.MoveTo(queue_, oob_queue_);
   queue_->Clear();
   oob_queue_->Clear();
 }
@@ -660,6 +767,7 @@ void MessageHandler::PausedOnExitLocked(MonitorLocker* ml, bool paused) {
 MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != NULL);
+  handler_->incoming_.MoveTo(handler_->queue_, handler_->oob_queue_);
   handler_->oob_message_handling_allowed_ = false;
 }
 
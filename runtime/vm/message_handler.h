@@ -82,6 +82,18 @@ class MessageHandler {
 
   bool paused() const { return paused_ > 0; }
 
+  // When non-zero, the thread pool worker handling this handler's messages
+  // is restricted to the CPUs in this mask while it does so (see
+  // OSThread::SetCurrentThreadAffinity).
+  uint64_t cpu_affinity_mask() const { return cpu_affinity_mask_; }
+  void set_cpu_affinity_mask(uint64_t mask) { cpu_affinity_mask_ = mask; }
+
+  // When set, the thread pool worker handling this handler's messages runs
+  // at batch priority while it does so (see
+  // OSThread::SetCurrentThreadBatchScheduling).
+  bool batch_scheduling() const { return batch_scheduling_; }
+  void set_batch_scheduling(bool value) { batch_scheduling_ = value; }
+
   void increment_paused() { paused_++; }
   void decrement_paused() {
     ASSERT(paused_ > 0);
@@ -231,6 +243,9 @@ class MessageHandler {
   // messages from the queue_.
   Message* DequeueMessage(Message::Priority min_priority);
 
+  // Wakes up a handler waiting for messages, or starts a task to handle them.
+  void NotifyIncomingLocked(MonitorLocker* ml);
+
   void ClearOOBQueue();
 
   // Handles any pending messages.
@@ -241,6 +256,9 @@ class MessageHandler {
   Monitor monitor_;  // Protects all fields in MessageHandler.
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
+  // Messages posted since the queues were last looked at. Unlike the queues,
+  // adding to it does not need the monitor.
+  IncomingMessageList incoming_;
   // This flag is not thread safe and can only reliably be accessed on a single
   // thread.
   bool oob_message_handling_allowed_;
@@ -255,6 +273,8 @@ class MessageHandler {
   int64_t paused_timestamp_;
 #endif
   bool delete_me_;
+  uint64_t cpu_affinity_mask_;
+  bool batch_scheduling_;
   ThreadPool* pool_;
   ThreadPool::Task* task_;
   int64_t idle_start_time_;
@@ -20,6 +20,12 @@ class MessageHandlerTestPeer {
   void increment_live_ports() { handler_->increment_live_ports(); }
   void decrement_live_ports() { handler_->decrement_live_ports(); }
 
+  // Moves posted messages from the incoming list to the queues.
+  void DrainIncoming() {
+    MonitorLocker ml(&handler_->monitor_);
+    handler_->incoming_.MoveTo(handler_->queue_, handler_->oob_queue_);
+  }
+
   MessageQueue* queue() const { return handler_->queue_; }
   MessageQueue* oob_queue() const { return handler_->oob_queue_; }
 
@@ -134,6 +140,7 @@ VM_UNIT_TEST_CASE(MessageHandler_PostMessage) {
   EXPECT_EQ(1, handler.notify_count());
 
   // The message has been added to the correct queue.
+  handler_peer.DrainIncoming();
   EXPECT(message == handler_peer.queue()->Dequeue());
   EXPECT(NULL == handler_peer.oob_queue()->Dequeue());
   delete message;
@@ -146,6 +153,7 @@ VM_UNIT_TEST_CASE(MessageHandler_PostMessage) {
   EXPECT_EQ(2, handler.notify_count());
 
   // The message has been added to the correct queue.
+  handler_peer.DrainIncoming();
   EXPECT(message == handler_peer.oob_queue()->Dequeue());
   EXPECT(NULL == handler_peer.queue()->Dequeue());
   delete message;
@@ -194,6 +202,7 @@ VM_UNIT_TEST_CASE(MessageHandler_ClosePort) {
   handler_peer.ClosePort(1);
 
   // Closing the port does not drop the messages from the queue.
+  handler_peer.DrainIncoming();
   EXPECT(message1 == handler_peer.queue()->Dequeue());
   EXPECT(message2 == handler_peer.queue()->Dequeue());
   delete message1;
@@ -211,6 +220,7 @@ VM_UNIT_TEST_CASE(MessageHandler_CloseAllPorts) {
   handler_peer.CloseAllPorts();
 
   // All messages are dropped from the queue.
+  handler_peer.DrainIncoming();
   EXPECT(NULL == handler_peer.queue()->Dequeue());
 }
 
@@ -145,4 +145,88 @@ TEST_CASE(MessageQueue_Clear) {
   // msg1 and msg2 already delete by FlushAll.
 }
 
+TEST_CASE(MessageQueue_DequeueIntoAndPrepend) {
+  MessageQueue queue;
+  MessageQueue batch;
+  Message* msgs[4];
+  for (intptr_t i = 0; i < 4; i++) {
+    const char* str = "msg";
+    msgs[i] = new Message(i + 1, AllocMsg(str), strlen(str) + 1, NULL,
+                          Message::kNormalPriority);
+    queue.Enqueue(msgs[i], false);
+  }
+
+  queue.DequeueInto(&batch, 3);
+  EXPECT_EQ(1, queue.Length());
+  EXPECT_EQ(3, batch.Length());
+  EXPECT(batch.Dequeue() == msgs[0]);
+
+  // The rest of the batch goes back in front, in order.
+  queue.Prepend(&batch);
+  EXPECT(batch.IsEmpty());
+  EXPECT_EQ(3, queue.Length());
+  EXPECT(queue.Dequeue() == msgs[1]);
+  EXPECT(queue.Dequeue() == msgs[2]);
+  EXPECT(queue.Dequeue() == msgs[3]);
+  EXPECT(queue.IsEmpty());
+
+  // Taking more messages than there are empties the queue.
+  const char* str5 = "msg5";
+  Message* msg5 = new Message(5, AllocMsg(str5), strlen(str5) + 1, NULL,
+                              Message::kNormalPriority);
+  queue.Enqueue(msg5, false);
+  queue.DequeueInto(&batch, 3);
+  EXPECT(queue.IsEmpty());
+  EXPECT(batch.Dequeue() == msg5);
+
+  for (intptr_t i = 0; i < 4; i++) {
+    delete msgs[i];
+  }
+  delete msg5;
+}
+
+TEST_CASE(IncomingMessageList_MoveTo) {
+  IncomingMessageList incoming;
+  MessageQueue queue;
+  MessageQueue oob_queue;
+  EXPECT(incoming.IsEmpty());
+
+  const char* str1 = "msg1";
+  const char* str2 = "msg2";
+  const char* str3 = "msg3";
+  Message* msg1 = new Message(1, AllocMsg(str1), strlen(str1) + 1, NULL,
+                              Message::kNormalPriority);
+  Message* msg2 = new Message(2, AllocMsg(str2), strlen(str2) + 1, NULL,
+                              Message::kOOBPriority);
+  Message* msg3 = new Message(3, AllocMsg(str3), strlen(str3) + 1, NULL,
+                              Message::kNormalPriority);
+
+  // Only adding to an empty list asks the caller to notify the handler.
+  EXPECT(incoming.Add(msg1));
+  EXPECT(!incoming.Add(msg2));
+  EXPECT(!incoming.Add(msg3));
+  EXPECT(!incoming.IsEmpty());
+
+  // Messages keep the order they were added in.
+  incoming.MoveTo(&queue, &oob_queue);
+  EXPECT(incoming.IsEmpty());
+  EXPECT_EQ(2, queue.Length());
+  EXPECT_EQ(1, oob_queue.Length());
+  EXPECT(queue.Dequeue() == msg1);
+  EXPECT(queue.Dequeue() == msg3);
+  EXPECT(oob_queue.Dequeue() == msg2);
+
+  // The list can be reused once it has been emptied.
+  Message* msg4 = new Message(4, AllocMsg(str1), strlen(str1) + 1, NULL,
+                              Message::kNormalPriority);
+  EXPECT(incoming.Add(msg4));
+  incoming.MoveTo(&queue, &oob_queue);
+  EXPECT(queue.Dequeue() == msg4);
+
+  delete msg1;
+  delete msg2;
+  delete msg3;
+  delete msg4;
+}
+
 }  // namespace dart
@@ -6,6 +6,8 @@
 
 #include "vm/metrics.h"
 
+#include "platform/text_buffer.h"
+#include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
@@ -108,6 +110,125 @@ void Metric::PrintJSON(JSONStream* stream) {
 }
 #endif  // !PRODUCT
 
+// OpenMetrics names may not contain dots, so "heap.old.used" in bytes is
+// exported as "dart_heap_old_used_bytes".
+static void PrintOpenMetricsName(TextBuffer* buffer,
+                                 const char* name,
+                                 Metric::Unit unit) {
+  buffer->AddString("dart_");
+  for (const char* c = name; *c != '\0'; c++) {
+    buffer->AddChar((*c == '.') ? '_' : *c);
+  }
+  switch (unit) {
+    case Metric::kCounter:
+      break;
+    case Metric::kByte:
+      buffer->AddString("_bytes");
+      break;
+    case Metric::kMicrosecond:
+      buffer->AddString("_microseconds");
+      break;
+  }
+}
+
+static void PrintOpenMetricsFamily(TextBuffer* buffer,
+                                   const char* name,
+                                   Metric::Unit unit) {
+  // Counters of this VM can go down, e.g. the isolate count.
+  buffer->AddString("# TYPE ");
+  PrintOpenMetricsName(buffer, name, unit);
+  buffer->AddString(" gauge\n");
+  if (unit != Metric::kCounter) {
+    buffer->AddString("# UNIT ");
+    PrintOpenMetricsName(buffer, name, unit);
+    buffer->AddString((unit == Metric::kByte) ? " bytes\n" : " microseconds\n");
+  }
+}
+
+static void PrintOpenMetricsLabelValue(TextBuffer* buffer, const char* value) {
+  for (const char* c = value; *c != '\0'; c++) {
+    if (*c == '\n') {
+      buffer->AddString("\\n");
+    } else {
+      if ((*c == '"') || (*c == '\\')) {
+        buffer->AddChar('\\');
+      }
+      buffer->AddChar(*c);
+    }
+  }
+}
+
+void Metric::PrintOpenMetrics(TextBuffer* buffer) {
+  for (Metric* current = vm_head(); current != NULL;
+       current = current->next()) {
+    PrintOpenMetricsFamily(buffer, current->name(), current->unit());
+    PrintOpenMetricsName(buffer, current->name(), current->unit());
+    buffer->Printf(" %" Pd64 "\n", current->Value());
+  }
+
+#define COUNT_ISOLATE_METRIC(type, variable, name, unit) +1
+  static const intptr_t kNumIsolateMetrics =
+      0 ISOLATE_METRIC_LIST(COUNT_ISOLATE_METRIC);
+#undef COUNT_ISOLATE_METRIC
+
+  struct IsolateSample {
+    char* labels;
+    int64_t values[kNumIsolateMetrics];
+  };
+
+  // Take the values of all isolates while holding the isolate list lock, so
+  // none of them can shut down meanwhile. The values of running isolates are
+  // read without synchronization and may be slightly stale.
+  class SampleCollector : public IsolateVisitor {
+   public:
+    explicit SampleCollector(MallocGrowableArray<IsolateSample>* samples)
+        : samples_(samples) {}
+
+    virtual void VisitIsolate(Isolate* isolate) {
+      if (IsVMInternalIsolate(isolate)) {
+        return;
+      }
+      TextBuffer labels(64);
+      labels.AddString("{isolate=\"");
+      PrintOpenMetricsLabelValue(&labels, isolate->name());
+      labels.Printf("\",port=\"%" Pd64 "\"}", isolate->main_port());
+      IsolateSample sample;
+      sample.labels = labels.Steal();
+      intptr_t index = 0;
+#define ADD_ISOLATE_METRIC_VALUE(type, variable, name, unit)                   \
+  sample.values[index++] =                                                     \
+      static_cast<Metric*>(isolate->Get##variable##Metric())->Value();
+      ISOLATE_METRIC_LIST(ADD_ISOLATE_METRIC_VALUE);
+#undef ADD_ISOLATE_METRIC_VALUE
+      samples_->Add(sample);
+    }
+
+   private:
+    MallocGrowableArray<IsolateSample>* samples_;
+  };
+
+  MallocGrowableArray<IsolateSample> samples;
+  SampleCollector collector(&samples);
+  Isolate::VisitIsolates(&collector);
+
+  intptr_t index = 0;
+#define PRINT_ISOLATE_METRIC(type, variable, name, unit)                       \
+  PrintOpenMetricsFamily(buffer, name, Metric::unit);                          \
+  for (intptr_t i = 0; i < samples.length(); i++) {                            \
+    PrintOpenMetricsName(buffer, name, Metric::unit);                          \
+    buffer->Printf("%s %" Pd64 "\n", samples[i].labels,                        \
+                   samples[i].values[index]);                                  \
+  }                                                                            \
+  index++;
+  ISOLATE_METRIC_LIST(PRINT_ISOLATE_METRIC);
+#undef PRINT_ISOLATE_METRIC
+
+  for (intptr_t i = 0; i < samples.length(); i++) {
+    free(samples[i].labels);
+  }
+  buffer->AddString("# EOF\n");
+}
+
 char* Metric::ValueToString(int64_t value, Unit unit) {
   Thread* thread = Thread::Current();
   ASSERT(thread != NULL);
@@ -255,42 +376,62 @@ void Metric::DeregisterWithVM() {
   UNREACHABLE();
 }
 
+// The heap metrics are also read from other threads by PrintOpenMetrics.
 int64_t MetricHeapOldUsed::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
 int64_t MetricHeapOldCapacity::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->CapacityInWords(Heap::kOld) * kWordSize;
 }
 
 int64_t MetricHeapOldExternal::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->ExternalInWords(Heap::kOld) * kWordSize;
 }
 
 int64_t MetricHeapNewUsed::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->UsedInWords(Heap::kNew) * kWordSize;
 }
 
 int64_t MetricHeapNewCapacity::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->CapacityInWords(Heap::kNew) * kWordSize;
 }
 
 int64_t MetricHeapNewExternal::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->ExternalInWords(Heap::kNew) * kWordSize;
 }
 
 int64_t MetricHeapUsed::Value() const {
-  ASSERT(isolate() == Isolate::Current());
   return isolate()->heap()->UsedInWords(Heap::kNew) * kWordSize +
          isolate()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+#define DEFINE_GC_PAUSE_METRICS(Kind)                                          \
+  int64_t MetricGC##Kind##PauseP99::Value() const {                            \
+    return isolate()                                                           \
+        ->heap()                                                               \
+        ->pause_histogram(Heap::k##Kind##Pause)                                \
+        .Percentile(99.0);                                                     \
+  }                                                                            \
+  int64_t MetricGC##Kind##PauseP999::Value() const {                           \
+    return isolate()                                                           \
+        ->heap()                                                               \
+        ->pause_histogram(Heap::k##Kind##Pause)                                \
+        .Percentile(99.9);                                                     \
+  }
+GC_PAUSE_METRIC_LIST(DEFINE_GC_PAUSE_METRICS)
+#undef DEFINE_GC_PAUSE_METRICS
+
+#define DEFINE_EXCEPTION_CACHE_METRICS(Name, cache)                            \
+  int64_t Metric##Name##Hits::Value() const {                                  \
+    return isolate()->cache()->hits();                                         \
+  }                                                                            \
+  int64_t Metric##Name##Misses::Value() const {                                \
+    return isolate()->cache()->misses();                                       \
+  }
+EXCEPTION_CACHE_METRIC_LIST(DEFINE_EXCEPTION_CACHE_METRICS)
+#undef DEFINE_EXCEPTION_CACHE_METRICS
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
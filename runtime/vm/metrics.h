@@ -11,6 +11,7 @@ namespace dart {
 
 class Isolate;
 class JSONStream;
+class TextBuffer;
 
 // Metrics for each isolate.
 #define ISOLATE_METRIC_LIST(V)                                                 \
@@ -19,6 +20,26 @@ class JSONStream;
   V(MetricHeapOldCapacity, HeapOldCapacity, "heap.old.capacity", kByte)        \
   V(MaxMetric, HeapOldCapacityMax, "heap.old.capacity.max", kByte)             \
   V(MetricHeapOldExternal, HeapOldExternal, "heap.old.external", kByte)        \
+  V(Metric, HeapOldReleased, "heap.old.released", kByte)                       \
+  V(MetricGCScavengePauseP99, GCScavengePauseP99, "gc.scavenge.pause.p99",     \
+    kMicrosecond)                                                              \
+  V(MetricGCScavengePauseP999, GCScavengePauseP999, "gc.scavenge.pause.p999",  \
+    kMicrosecond)                                                              \
+  V(MetricGCMarkPauseP99, GCMarkPauseP99, "gc.mark.pause.p99", kMicrosecond)   \
+  V(MetricGCMarkPauseP999, GCMarkPauseP999, "gc.mark.pause.p999",              \
+    kMicrosecond)                                                              \
+  V(MetricGCSweepPauseP99, GCSweepPauseP99, "gc.sweep.pause.p99",             \
+    kMicrosecond)                                                              \
+  V(MetricGCSweepPauseP999, GCSweepPauseP999, "gc.sweep.pause.p999",           \
+    kMicrosecond)                                                              \
+  V(MetricGCCompactPauseP99, GCCompactPauseP99, "gc.compact.pause.p99",        \
+    kMicrosecond)                                                              \
+  V(MetricGCCompactPauseP999, GCCompactPauseP999, "gc.compact.pause.p999",     \
+    kMicrosecond)                                                              \
+  V(MetricGCSafepointPauseP99, GCSafepointPauseP99, "gc.safepoint.pause.p99",  \
+    kMicrosecond)                                                              \
+  V(MetricGCSafepointPauseP999, GCSafepointPauseP999,                          \
+    "gc.safepoint.pause.p999", kMicrosecond)                                   \
   V(MetricHeapNewUsed, HeapNewUsed, "heap.new.used", kByte)                    \
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MetricHeapNewCapacity, HeapNewCapacity, "heap.new.capacity", kByte)        \
@@ -27,7 +48,17 @@ class JSONStream;
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
   V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(MetricHandlerInfoCacheHits, HandlerInfoCacheHits,                          \
+    "exceptions.handler_info_cache.hits", kCounter)                            \
+  V(MetricHandlerInfoCacheMisses, HandlerInfoCacheMisses,                      \
+    "exceptions.handler_info_cache.misses", kCounter)                          \
+  V(MetricCatchEntryMovesCacheHits, CatchEntryMovesCacheHits,                  \
+    "exceptions.catch_entry_moves_cache.hits", kCounter)                       \
+  V(MetricCatchEntryMovesCacheMisses, CatchEntryMovesCacheMisses,              \
+    "exceptions.catch_entry_moves_cache.misses", kCounter)                     \
+  V(Metric, UnoptimizedCompilerQueue, "compiler.unoptimized.queue", kCounter)  \
+  V(Metric, OptimizingCompilerQueue, "compiler.optimizing.queue", kCounter)
 
 #define VM_METRIC_LIST(V)                                                      \
   V(MetricIsolateCount, IsolateCount, "vm.isolate.count", kCounter)            \
@@ -63,6 +94,10 @@ class Metric {
 
 #ifndef PRODUCT
   void PrintJSON(JSONStream* stream);
+
+  // Prints the VM metrics and the metrics of all isolates in the OpenMetrics
+  // text format. May be called from any thread.
+  static void PrintOpenMetrics(TextBuffer* buffer);
 #endif  // !PRODUCT
 
   // Returns a zone allocated string.
@@ -180,6 +215,44 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+// Percentiles of the GC pause histograms kept by the heap.
+#define GC_PAUSE_METRIC_LIST(V)                                                \
+  V(Scavenge)                                                                  \
+  V(Mark)                                                                      \
+  V(Sweep)                                                                     \
+  V(Compact)                                                                   \
+  V(Safepoint)
+
+#define DECLARE_GC_PAUSE_METRICS(Kind)                                         \
+  class MetricGC##Kind##PauseP99 : public Metric {                             \
+   protected:                                                                  \
+    virtual int64_t Value() const;                                             \
+  };                                                                           \
+  class MetricGC##Kind##PauseP999 : public Metric {                            \
+   protected:                                                                  \
+    virtual int64_t Value() const;                                             \
+  };
+GC_PAUSE_METRIC_LIST(DECLARE_GC_PAUSE_METRICS)
+#undef DECLARE_GC_PAUSE_METRICS
+
+// Lookups in the caches used to find exception handlers, see
+// Isolate::handler_info_cache and Isolate::catch_entry_moves_cache.
+#define EXCEPTION_CACHE_METRIC_LIST(V)                                         \
+  V(HandlerInfoCache, handler_info_cache)                                      \
+  V(CatchEntryMovesCache, catch_entry_moves_cache)
+
+#define DECLARE_EXCEPTION_CACHE_METRICS(Name, cache)                           \
+  class Metric##Name##Hits : public Metric {                                   \
+   protected:                                                                  \
+    virtual int64_t Value() const;                                             \
+  };                                                                           \
+  class Metric##Name##Misses : public Metric {                                 \
+   protected:                                                                  \
+    virtual int64_t Value() const;                                             \
+  };
+EXCEPTION_CACHE_METRIC_LIST(DECLARE_EXCEPTION_CACHE_METRICS)
+#undef DECLARE_EXCEPTION_CACHE_METRICS
+
 #if !defined(PRODUCT)
 #define VM_METRIC_VARIABLE(type, variable, name, unit)                         \
   extern type vm_metric_##variable;
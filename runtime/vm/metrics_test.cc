@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "platform/assert.h"
+#include "platform/text_buffer.h"
 
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
@@ -73,6 +74,26 @@ VM_UNIT_TEST_CASE(Metric_OnDemand) {
   Dart_ShutdownIsolate();
 }
 
+VM_UNIT_TEST_CASE(Metric_OpenMetrics) {
+  TestCase::CreateTestIsolate();
+  {
+    TextBuffer buffer(KB);
+    Metric::PrintOpenMetrics(&buffer);
+    const char* text = buffer.buf();
+    EXPECT_SUBSTRING("# TYPE dart_vm_isolate_count gauge\n", text);
+    EXPECT_SUBSTRING("# TYPE dart_heap_old_used_bytes gauge\n"
+                     "# UNIT dart_heap_old_used_bytes bytes\n",
+                     text);
+    EXPECT_SUBSTRING("dart_heap_old_used_bytes{isolate=\"", text);
+    EXPECT_SUBSTRING("dart_gc_scavenge_pause_p99_microseconds{", text);
+    EXPECT_SUBSTRING("dart_compiler_optimizing_queue{", text);
+    const intptr_t length = strlen(text);
+    EXPECT(length > 6);
+    EXPECT_STREQ("# EOF\n", text + length - 6);
+  }
+  Dart_ShutdownIsolate();
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
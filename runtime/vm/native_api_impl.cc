@@ -8,6 +8,7 @@
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_api_state.h"
+#include "vm/flat_message.h"
 #include "vm/message.h"
 #include "vm/native_message_handler.h"
 #include "vm/port.h"
@@ -67,6 +68,71 @@ DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   return PostCObjectHelper(port_id, &cobj);
 }
 
+static void FreeExternalTypedData(void* isolate_callback_data,
+                                  Dart_WeakPersistentHandle handle,
+                                  void* data) {
+  free(data);
+}
+
+static intptr_t PostedTypedDataClassId(Dart_TypedData_Type type) {
+  switch (type) {
+    case Dart_TypedData_kInt8:
+      return kTypedDataInt8ArrayCid;
+    case Dart_TypedData_kUint8:
+      return kTypedDataUint8ArrayCid;
+    case Dart_TypedData_kUint8Clamped:
+      return kTypedDataUint8ClampedArrayCid;
+    case Dart_TypedData_kInt16:
+      return kTypedDataInt16ArrayCid;
+    case Dart_TypedData_kUint16:
+      return kTypedDataUint16ArrayCid;
+    case Dart_TypedData_kInt32:
+      return kTypedDataInt32ArrayCid;
+    case Dart_TypedData_kUint32:
+      return kTypedDataUint32ArrayCid;
+    case Dart_TypedData_kInt64:
+      return kTypedDataInt64ArrayCid;
+    case Dart_TypedData_kUint64:
+      return kTypedDataUint64ArrayCid;
+    case Dart_TypedData_kFloat32:
+      return kTypedDataFloat32ArrayCid;
+    case Dart_TypedData_kFloat64:
+      return kTypedDataFloat64ArrayCid;
+    default:
+      return kIllegalCid;
+  }
+}
+
+DART_EXPORT bool Dart_PostExternalTypedData(
+    Dart_Port port_id,
+    Dart_TypedData_Type type,
+    uint8_t* data,
+    intptr_t length,
+    void* peer,
+    Dart_WeakPersistentHandleFinalizer callback) {
+  if (callback == NULL) {
+    callback = FreeExternalTypedData;
+    peer = data;
+  }
+  const intptr_t cid = PostedTypedDataClassId(type);
+  if ((cid == kIllegalCid) || ((data == NULL) && (length != 0))) {
+    callback(NULL, NULL, peer);
+    return false;
+  }
+  const intptr_t element_size = TypedData::ElementSizeInBytes(cid);
+  const intptr_t elements = length / element_size;
+  if ((length < 0) || ((length % element_size) != 0) ||
+      (elements > ExternalTypedData::MaxElements(
+                      cid + kTypedDataCidRemainderExternal))) {
+    callback(NULL, NULL, peer);
+    return false;
+  }
+  // Deleting an undelivered message invokes the callback.
+  return PortMap::PostMessage(FlatMessageWriter::WriteExternalTypedData(
+      cid, data, elements, peer, callback, port_id,
+      Message::kNormalPriority));
+}
+
 DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          Dart_NativeMessageHandler handler,
                                          bool handle_concurrently) {
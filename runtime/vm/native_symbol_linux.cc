@@ -6,19 +6,348 @@
 #if defined(HOST_OS_LINUX)
 
 #include "platform/memory_sanitizer.h"
+#include "platform/sort.h"
+#include "vm/lockers.h"
 #include "vm/native_symbol.h"
 #include "vm/os.h"
+#include "vm/os_thread.h"
 
-#include <cxxabi.h>  // NOLINT
-#include <dlfcn.h>   // NOLINT
+#include <cxxabi.h>    // NOLINT
+#include <dlfcn.h>     // NOLINT
+#include <elf.h>       // NOLINT
+#include <fcntl.h>     // NOLINT
+#include <limits.h>    // NOLINT
+#include <link.h>      // NOLINT
+#include <sys/mman.h>  // NOLINT
+#include <sys/stat.h>  // NOLINT
+#include <unistd.h>    // NOLINT
 
 namespace dart {
 
-void NativeSymbolResolver::Init() {}
+// The function symbols of one loaded object, read from the symbol table of
+// its file the first time a pc in it is looked up. Entries are sorted by
+// offset from the load bias of the object, so a lookup is a binary search
+// instead of a dladdr call, which takes the loader lock, and each name is
+// demangled at most once.
+class NativeSymbols {
+ public:
+  NativeSymbols(const char* path,
+                uword base,
+                uword bias,
+                uword start,
+                uword end)
+      : next_(NULL),
+        path_(strdup(path)),
+        base_(base),
+        bias_(bias),
+        start_(start),
+        end_(end),
+        read_(false),
+        mapping_(NULL),
+        mapping_size_(0),
+        entries_(NULL),
+        num_entries_(0) {}
 
-void NativeSymbolResolver::Cleanup() {}
+  ~NativeSymbols() {
+    for (intptr_t i = 0; i < num_entries_; i++) {
+      free(entries_[i].demangled);
+    }
+    free(entries_);
+    if (mapping_ != NULL) {
+      munmap(mapping_, mapping_size_);
+    }
+    free(path_);
+  }
+
+  NativeSymbols* next() const { return next_; }
+  void set_next(NativeSymbols* symbols) { next_ = symbols; }
+
+  const char* path() const { return path_; }
+  uword base() const { return base_; }
+  bool Contains(uword pc) const { return (pc >= start_) && (pc < end_); }
+
+  bool Lookup(uword pc, uword* start, const char** name) {
+    if (!read_) {
+      read_ = true;
+      Read();
+    }
+    const uword offset = pc - bias_;
+    intptr_t lo = 0;
+    intptr_t hi = num_entries_ - 1;
+    while (lo <= hi) {
+      intptr_t mid = (hi - lo + 1) / 2 + lo;
+      ASSERT(mid >= lo);
+      ASSERT(mid <= hi);
+      Entry* entry = &entries_[mid];
+      if (offset < entry->offset) {
+        hi = mid - 1;
+      } else if (offset >= (entry->offset + entry->size)) {
+        lo = mid + 1;
+      } else {
+        *start = entry->offset + bias_;
+        *name = Demangle(entry);
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  struct Entry {
+    uword offset;
+    uword size;
+    const char* name;  // Points into the mapped file.
+    char* demangled;
+  };
+
+  static const char* Demangle(Entry* entry) {
+    if (entry->demangled == NULL) {
+      int status = 0;
+      size_t len = 0;
+      char* demangled = abi::__cxa_demangle(entry->name, NULL, &len, &status);
+      MSAN_UNPOISON(demangled, len);
+      if (status == 0) {
+        entry->demangled = demangled;
+      } else {
+        free(demangled);
+        entry->demangled = strdup(entry->name);
+      }
+    }
+    return entry->demangled;
+  }
+
+  // Maps the file of the object and collects its function symbols, from the
+  // full symbol table if it was not stripped and the dynamic one otherwise.
+  void Read() {
+    int fd = open(path_, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) ||
+        (static_cast<size_t>(st.st_size) < sizeof(ElfW(Ehdr)))) {
+      close(fd);
+      return;
+    }
+    mapping_size_ = st.st_size;
+    void* mapping = mmap(NULL, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      return;
+    }
+    mapping_ = mapping;
+
+    const uint8_t* file = reinterpret_cast<const uint8_t*>(mapping_);
+    const ElfW(Ehdr)* header = reinterpret_cast<const ElfW(Ehdr)*>(file);
+    if ((memcmp(header->e_ident, ELFMAG, SELFMAG) != 0) ||
+        (header->e_ident[EI_CLASS] != (kWordSize == 8 ? ELFCLASS64
+                                                      : ELFCLASS32)) ||
+        (header->e_shentsize != sizeof(ElfW(Shdr))) ||
+        (header->e_shoff > mapping_size_) ||
+        (header->e_shnum >
+         (mapping_size_ - header->e_shoff) / sizeof(ElfW(Shdr)))) {
+      return;
+    }
+    const ElfW(Shdr)* sections =
+        reinterpret_cast<const ElfW(Shdr)*>(file + header->e_shoff);
+    const ElfW(Shdr)* table = NULL;
+    for (intptr_t i = 0; i < header->e_shnum; i++) {
+      if (sections[i].sh_type == SHT_SYMTAB) {
+        table = &sections[i];
+        break;
+      }
+      if (sections[i].sh_type == SHT_DYNSYM) {
+        table = &sections[i];
+      }
+    }
+    if ((table == NULL) || (table->sh_link >= header->e_shnum) ||
+        !InFile(table) || !InFile(&sections[table->sh_link])) {
+      return;
+    }
+    const ElfW(Sym)* symbols =
+        reinterpret_cast<const ElfW(Sym)*>(file + table->sh_offset);
+    const intptr_t num_symbols = table->sh_size / sizeof(ElfW(Sym));
+    const ElfW(Shdr)& string_table = sections[table->sh_link];
+    const char* names =
+        reinterpret_cast<const char*>(file + string_table.sh_offset);
+    const uword names_size = string_table.sh_size;
+
+    entries_ = reinterpret_cast<Entry*>(malloc(num_symbols * sizeof(Entry)));
+    if (entries_ == NULL) {
+      return;
+    }
+    for (intptr_t i = 0; i < num_symbols; i++) {
+      const ElfW(Sym)& symbol = symbols[i];
+      if ((ELF32_ST_TYPE(symbol.st_info) != STT_FUNC) ||
+          (symbol.st_shndx == SHN_UNDEF) || (symbol.st_size == 0) ||
+          (symbol.st_name >= names_size) ||
+          (memchr(names + symbol.st_name, '\0',
+                  names_size - symbol.st_name) == NULL)) {
+        continue;
+      }
+      Entry* entry = &entries_[num_entries_++];
+      entry->offset = symbol.st_value;
+      entry->size = symbol.st_size;
+      entry->name = names + symbol.st_name;
+      entry->demangled = NULL;
+    }
+    Sort::IntroSort(entries_, num_entries_, [](const Entry& a, const Entry& b) {
+      return a.offset < b.offset;
+    });
+  }
+
+  bool InFile(const ElfW(Shdr)* section) const {
+    return (section->sh_type != SHT_NOBITS) &&
+           (section->sh_offset <= mapping_size_) &&
+           (section->sh_size <= mapping_size_ - section->sh_offset);
+  }
+
+  NativeSymbols* next_;
+  char* const path_;
+  const uword base_;  // Lowest mapped address, like dladdr's dli_fbase.
+  const uword bias_;
+  const uword start_;
+  const uword end_;
+  bool read_;
+  void* mapping_;
+  size_t mapping_size_;
+  Entry* entries_;
+  intptr_t num_entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeSymbols);
+};
+
+// Guards the cache below, which lives until the VM shuts down.
+static Mutex* lock_ = NULL;
+static NativeSymbols* symbols_ = NULL;
+// The loader's count of loads and unloads when the cache was filled.
+static uint64_t loaded_objects_generation_ = 0;
+
+static void DeleteSymbols() {
+  NativeSymbols* symbols = symbols_;
+  symbols_ = NULL;
+  while (symbols != NULL) {
+    NativeSymbols* next = symbols->next();
+    delete symbols;
+    symbols = next;
+  }
+}
+
+static uint64_t Generation(struct dl_phdr_info* info, size_t size) {
+  if (size < offsetof(struct dl_phdr_info, dlpi_subs) +
+                 sizeof(info->dlpi_subs)) {
+    return 0;
+  }
+  return info->dlpi_adds + info->dlpi_subs;
+}
+
+static int ReadGeneration(struct dl_phdr_info* info, size_t size, void* data) {
+  *reinterpret_cast<uint64_t*>(data) = Generation(info, size);
+  return 1;  // Stop after the first object.
+}
+
+static int AddObject(struct dl_phdr_info* info, size_t size, void* data) {
+  loaded_objects_generation_ = Generation(info, size);
+  uword base = kUwordMax;
+  uword start = kUwordMax;
+  uword end = 0;
+  for (intptr_t i = 0; i < info->dlpi_phnum; i++) {
+    const ElfW(Phdr)& segment = info->dlpi_phdr[i];
+    if (segment.p_type != PT_LOAD) {
+      continue;
+    }
+    const uword segment_start = info->dlpi_addr + segment.p_vaddr;
+    base = Utils::Minimum(base, segment_start);
+    if ((segment.p_flags & PF_X) == 0) {
+      continue;
+    }
+    start = Utils::Minimum(start, segment_start);
+    end = Utils::Maximum(end, segment_start + segment.p_memsz);
+  }
+  if (start >= end) {
+    return 0;
+  }
+  // The main program comes first, without a name.
+  bool* is_first = reinterpret_cast<bool*>(data);
+  const char* path = info->dlpi_name;
+  char exe_path[PATH_MAX];
+  if ((path == NULL) || (path[0] == '\0')) {
+    if (!*is_first) {
+      return 0;
+    }
+    ssize_t length = readlink("/proc/self/exe", exe_path, PATH_MAX - 1);
+    if (length <= 0) {
+      return 0;
+    }
+    exe_path[length] = '\0';
+    path = exe_path;
+  }
+  *is_first = false;
+  base = Utils::RoundDown(base, static_cast<uword>(getpagesize()));
+  NativeSymbols* symbols =
+      new NativeSymbols(path, base, info->dlpi_addr, start, end);
+  symbols->set_next(symbols_);
+  symbols_ = symbols;
+  return 0;
+}
+
+// Returns the cached object containing pc, refilling the cache if objects
+// were loaded or unloaded since it was filled. Requires lock_.
+static NativeSymbols* FindObject(uword pc) {
+  bool filled = false;
+  if (symbols_ == NULL) {
+    bool is_first = true;
+    dl_iterate_phdr(AddObject, &is_first);
+    filled = true;
+  }
+  for (NativeSymbols* symbols = symbols_; symbols != NULL;
+       symbols = symbols->next()) {
+    if (symbols->Contains(pc)) {
+      return symbols;
+    }
+  }
+  if (filled) {
+    return NULL;
+  }
+  uint64_t generation = 0;
+  dl_iterate_phdr(ReadGeneration, &generation);
+  if (generation == loaded_objects_generation_) {
+    return NULL;
+  }
+  DeleteSymbols();
+  return FindObject(pc);
+}
+
+void NativeSymbolResolver::Init() {
+  if (lock_ == NULL) {
+    lock_ = new Mutex();
+  }
+}
+
+void NativeSymbolResolver::Cleanup() {
+  if (lock_ == NULL) {
+    return;
+  }
+  MutexLocker lock(lock_);
+  DeleteSymbols();
+}
 
 char* NativeSymbolResolver::LookupSymbolName(uintptr_t pc, uintptr_t* start) {
+  if (lock_ != NULL) {
+    MutexLocker lock(lock_);
+    NativeSymbols* symbols = FindObject(pc);
+    const char* name = NULL;
+    uword symbol_start = 0;
+    if ((symbols != NULL) && symbols->Lookup(pc, &symbol_start, &name)) {
+      if (start != NULL) {
+        *start = symbol_start;
+      }
+      return strdup(name);
+    }
+  }
+
+  // Not in a symbol table the cache could read, e.g. a symbol only the
+  // loader knows about.
   Dl_info info;
   int r = dladdr(reinterpret_cast<void*>(pc), &info);
   if (r == 0) {
@@ -47,6 +376,16 @@ void NativeSymbolResolver::FreeSymbolName(char* name) {
 bool NativeSymbolResolver::LookupSharedObject(uword pc,
                                               uword* dso_base,
                                               char** dso_name) {
+  if (lock_ != NULL) {
+    MutexLocker lock(lock_);
+    NativeSymbols* symbols = FindObject(pc);
+    if (symbols != NULL) {
+      *dso_base = symbols->base();
+      *dso_name = strdup(symbols->path());
+      return true;
+    }
+  }
+
   Dl_info info;
   int r = dladdr(reinterpret_cast<void*>(pc), &info);
   if (r == 0) {
@@ -35,6 +35,7 @@
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
 #include "vm/heap/weak_code.h"
+#include "vm/image_snapshot.h"
 #include "vm/isolate_reload.h"
 #include "vm/kernel.h"
 #include "vm/kernel_binary.h"
@@ -46,6 +47,7 @@
 #include "vm/profiler.h"
 #include "vm/resolver.h"
 #include "vm/reusable_handles.h"
+#include "vm/reverse_pc_lookup_cache.h"
 #include "vm/runtime_entry.h"
 #include "vm/scopes.h"
 #include "vm/stack_frame.h"
@@ -1265,6 +1267,22 @@ void Object::FinalizeReadOnlyObject(RawObject* object) {
     ASSERT(size <= desc->HeapSize());
     memset(reinterpret_cast<void*>(RawObject::ToAddr(desc) + size), 0,
            desc->HeapSize() - size);
+  } else if ((cid == kMintCid) || (cid == kDoubleCid)) {
+#if defined(HASH_IN_OBJECT_HEADER)
+    // The header can't be written once the object is read-only, so assign
+    // the identity hash now, derived from the value for determinism.
+    if (GetCachedHash(object) == 0) {
+      const intptr_t value_offset =
+          (cid == kMintCid) ? Mint::value_offset() : Double::value_offset();
+      uint64_t bits;
+      memmove(&bits,
+              reinterpret_cast<void*>(RawObject::ToAddr(object) + value_offset),
+              sizeof(bits));
+      uint32_t hash = CombineHashes(static_cast<uint32_t>(bits),
+                                    static_cast<uint32_t>(bits >> 32));
+      SetCachedHash(object, FinalizeHash(hash, kBitsPerInt32 - 2));
+    }
+#endif  // defined(HASH_IN_OBJECT_HEADER)
   }
 }
 
@@ -1562,6 +1580,11 @@ RawError* Object::Init(Isolate* isolate,
     RegisterPrivateClass(cls, Symbols::_CapabilityImpl(), isolate_lib);
     pending_classes.Add(cls);
 
+    cls = Class::New<TransferableTypedData>();
+    RegisterPrivateClass(cls, Symbols::_TransferableTypedDataImpl(),
+                         isolate_lib);
+    pending_classes.Add(cls);
+
     cls = Class::New<ReceivePort>();
     RegisterPrivateClass(cls, Symbols::_RawReceivePortImpl(), isolate_lib);
     pending_classes.Add(cls);
@@ -1947,6 +1970,14 @@ RawError* Object::Init(Isolate* isolate,
     pending_classes.Add(cls);
     RegisterClass(cls, Symbols::FfiNativeFunction(), lib);
 
+    cls = Class::New<Instance>(kFfiByValueCid);
+    cls.set_type_arguments_field_offset(Pointer::type_arguments_offset());
+    cls.set_num_type_arguments(1);
+    cls.set_num_own_type_arguments(1);
+    cls.set_is_prefinalized();
+    pending_classes.Add(cls);
+    RegisterClass(cls, Symbols::FfiByValue(), lib);
+
     cls = Class::NewPointerClass(kFfiPointerCid);
     object_store->set_ffi_pointer_class(cls);
     pending_classes.Add(cls);
@@ -2051,6 +2082,8 @@ RawError* Object::Init(Isolate* isolate,
 
     cls = Class::New<Instance>(kFfiNativeFunctionCid);
 
+    cls = Class::New<Instance>(kFfiByValueCid);
+
     cls = Class::NewPointerClass(kFfiPointerCid);
     object_store->set_ffi_pointer_class(cls);
 
@@ -2092,6 +2125,7 @@ RawError* Object::Init(Isolate* isolate,
     object_store->set_null_class(cls);
 
     cls = Class::New<Capability>();
+    cls = Class::New<TransferableTypedData>();
     cls = Class::New<ReceivePort>();
     cls = Class::New<SendPort>();
     cls = Class::New<StackTrace>();
@@ -2189,6 +2223,13 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
   ASSERT(thread->execution_state() == Thread::kThreadInVM);
   ASSERT(thread->no_callback_scope_depth() == 0);
   Heap* heap = thread->heap();
+#ifndef PRODUCT
+  ClassTable* class_table = thread->isolate()->class_table();
+  // Classes whose instances consistently survive scavenges skip new space.
+  if ((space == Heap::kNew) && class_table->ShouldPretenure(cls_id)) {
+    space = Heap::kOld;
+  }
+#endif  // !PRODUCT
 
   uword address;
 
@@ -2208,7 +2249,6 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
     UNREACHABLE();
   }
 #ifndef PRODUCT
-  ClassTable* class_table = thread->isolate()->class_table();
   if (space == Heap::kNew) {
     class_table->UpdateAllocatedNew(cls_id, size);
   } else {
@@ -2218,6 +2258,17 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
     Profiler::SampleAllocation(thread, cls_id);
   }
 #endif  // !PRODUCT
+  if (UNLIKELY(AllocationSampler::IsEnabled())) {
+    // New-space allocations are accounted by the heap's slow path.
+    if (!thread->bump_allocate() &&
+        ((address & kNewObjectAlignmentOffset) == kOldObjectAlignmentOffset)) {
+      heap->AdvanceAllocationSample(thread, size);
+    }
+    if (thread->allocation_sample_pending()) {
+      thread->set_allocation_sample_pending(false);
+      heap->allocation_sampler()->RecordSample(thread, cls_id, size);
+    }
+  }
   NoSafepointScope no_safepoint;
   InitializeObject(address, cls_id, size);
   RawObject* raw_obj = reinterpret_cast<RawObject*>(address + kHeapObjectTag);
@@ -4226,12 +4277,15 @@ void Class::ClearDirectSubclasses() const {
 }
 
 RawArray* Class::constants() const {
-  return raw_ptr()->constants_;
+  // Pairs with the release store in set_constants, so that the table can be
+  // probed without the constant canonicalization lock.
+  return AtomicOperations::LoadAcquire(&raw_ptr()->constants_);
 }
 
 void Class::set_constants(const Array& value) const {
   ASSERT(!value.IsNull());
-  StorePointer(&raw_ptr()->constants_, value.raw());
+  StorePointer<RawArray*, MemoryOrder::kRelease>(&raw_ptr()->constants_,
+                                                 value.raw());
 }
 
 void Class::set_declaration_type(const Type& value) const {
@@ -4855,27 +4909,33 @@ typedef UnorderedHashSet<CanonicalNumberTraits<Double, CanonicalDoubleKey> >
 typedef UnorderedHashSet<CanonicalNumberTraits<Mint, CanonicalMintKey> >
     CanonicalMintSet;
 
-// Returns an instance of Double or Double::null().
+// Returns an instance of Double or Double::null(). Does not need the
+// constant canonicalization lock.
 RawDouble* Class::LookupCanonicalDouble(Zone* zone, double value) const {
   ASSERT(this->raw() == Isolate::Current()->object_store()->double_class());
-  if (this->constants() == Object::empty_array().raw()) return Double::null();
+  const Array& table = Array::Handle(zone, this->constants());
+  if (table.raw() == Object::empty_array().raw()) return Double::null();
 
   Double& canonical_value = Double::Handle(zone);
-  CanonicalDoubleSet constants(zone, this->constants());
-  canonical_value ^= constants.GetOrNull(CanonicalDoubleKey(value));
-  this->set_constants(constants.Release());
+  // Lookups must not store the table back, that could drop an insertion
+  // made concurrently under the lock.
+  CanonicalDoubleSet constants(zone, table.raw());
+  canonical_value ^= constants.GetOrNullConcurrent(CanonicalDoubleKey(value));
+  constants.Release();
   return canonical_value.raw();
 }
 
-// Returns an instance of Mint or Mint::null().
+// Returns an instance of Mint or Mint::null(). Does not need the constant
+// canonicalization lock.
 RawMint* Class::LookupCanonicalMint(Zone* zone, int64_t value) const {
   ASSERT(this->raw() == Isolate::Current()->object_store()->mint_class());
-  if (this->constants() == Object::empty_array().raw()) return Mint::null();
+  const Array& table = Array::Handle(zone, this->constants());
+  if (table.raw() == Object::empty_array().raw()) return Mint::null();
 
   Mint& canonical_value = Mint::Handle(zone);
-  CanonicalMintSet constants(zone, this->constants());
-  canonical_value ^= constants.GetOrNull(CanonicalMintKey(value));
-  this->set_constants(constants.Release());
+  CanonicalMintSet constants(zone, table.raw());
+  canonical_value ^= constants.GetOrNullConcurrent(CanonicalMintKey(value));
+  constants.Release();
   return canonical_value.raw();
 }
 
@@ -4926,15 +4986,18 @@ class CanonicalInstanceTraits {
 };
 typedef UnorderedHashSet<CanonicalInstanceTraits> CanonicalInstancesSet;
 
+// Does not need the constant canonicalization lock.
 RawInstance* Class::LookupCanonicalInstance(Zone* zone,
                                             const Instance& value) const {
   ASSERT(this->raw() == value.clazz());
   ASSERT(is_finalized() || is_prefinalized());
   Instance& canonical_value = Instance::Handle(zone);
-  if (this->constants() != Object::empty_array().raw()) {
-    CanonicalInstancesSet constants(zone, this->constants());
-    canonical_value ^= constants.GetOrNull(CanonicalInstanceKey(value));
-    this->set_constants(constants.Release());
+  const Array& table = Array::Handle(zone, this->constants());
+  if (table.raw() != Object::empty_array().raw()) {
+    CanonicalInstancesSet constants(zone, table.raw());
+    canonical_value ^=
+        constants.GetOrNullConcurrent(CanonicalInstanceKey(value));
+    constants.Release();
   }
   return canonical_value.raw();
 }
@@ -5182,13 +5245,43 @@ bool TypeArguments::HasInstantiations() const {
 intptr_t TypeArguments::NumInstantiations() const {
   const Array& prior_instantiations = Array::Handle(instantiations());
   ASSERT(prior_instantiations.Length() > 0);  // Always at least a sentinel.
-  intptr_t num = 0;
-  intptr_t i = 0;
-  while (prior_instantiations.At(i) != Smi::New(StubCode::kNoInstantiator)) {
-    i += StubCode::kInstantiationSizeInWords;
-    num++;
+  if (prior_instantiations.Length() == 1) {
+    return 0;
+  }
+  return Smi::Value(Smi::RawCast(prior_instantiations.At(
+      prior_instantiations.Length() - kInstantiationsNumEntriesFromEnd)));
+}
+
+intptr_t TypeArguments::FindInstantiation(
+    RawArray* instantiations,
+    RawObject* instantiator_type_arguments,
+    RawObject* function_type_arguments) {
+  // The bits of the hash field of a vector mixed into the probe start.
+  auto hash_bits = [](RawObject* type_arguments) -> uword {
+    if (type_arguments == Object::null()) {
+      return 0;
+    }
+    return reinterpret_cast<uword>(
+        static_cast<RawTypeArguments*>(type_arguments)->ptr()->hash_);
+  };
+  RawObject** data = instantiations->ptr()->data();
+  const intptr_t length = Smi::Value(instantiations->ptr()->length_);
+  // Like the index, the mask stays tagged: both are twice the untagged value.
+  const uword mask =
+      reinterpret_cast<uword>(data[length - kInstantiationsHashMaskFromEnd]);
+  uword probe = (hash_bits(instantiator_type_arguments) ^
+                 hash_bits(function_type_arguments)) &
+                mask;
+  while (true) {
+    const intptr_t index =
+        (probe >> kSmiTagShift) * StubCode::kInstantiationSizeInWords;
+    if (((data[index] == instantiator_type_arguments) &&
+         (data[index + 1] == function_type_arguments)) ||
+        (data[index] == Smi::New(StubCode::kNoInstantiator))) {
+      return index;
+    }
+    probe = (probe + Smi::RawValue(1)) & mask;
   }
-  return num;
 }
 
 RawArray* TypeArguments::instantiations() const {
@@ -5446,16 +5539,11 @@ RawTypeArguments* TypeArguments::InstantiateAndCanonicalizeFrom(
   // The instantiations cache is initialized with Object::zero_array() and is
   // therefore guaranteed to contain kNoInstantiator. No length check needed.
   ASSERT(prior_instantiations.Length() > 0);  // Always at least a sentinel.
-  intptr_t index = 0;
-  while (true) {
-    if ((prior_instantiations.At(index) == instantiator_type_arguments.raw()) &&
-        (prior_instantiations.At(index + 1) == function_type_arguments.raw())) {
-      return TypeArguments::RawCast(prior_instantiations.At(index + 2));
-    }
-    if (prior_instantiations.At(index) == Smi::New(StubCode::kNoInstantiator)) {
-      break;
-    }
-    index += StubCode::kInstantiationSizeInWords;
+  const intptr_t index = FindInstantiation(prior_instantiations.raw(),
+                                           instantiator_type_arguments.raw(),
+                                           function_type_arguments.raw());
+  if (prior_instantiations.At(index) != Smi::New(StubCode::kNoInstantiator)) {
+    return TypeArguments::RawCast(prior_instantiations.At(index + 2));
   }
   // Cache lookup failed. Instantiate the type arguments.
   TypeArguments& result = TypeArguments::Handle();
@@ -5467,27 +5555,77 @@ RawTypeArguments* TypeArguments::InstantiateAndCanonicalizeFrom(
   // indirectly, so the prior_instantiations array cannot have grown.
   ASSERT(prior_instantiations.raw() == instantiations());
   // Add instantiator and function type args and result to instantiations array.
-  intptr_t length = prior_instantiations.Length();
-  if ((index + StubCode::kInstantiationSizeInWords) >= length) {
-    // TODO(regis): Should we limit the number of cached instantiations?
-    // Grow the instantiations array by about 50%, but at least by 1.
-    // The initial array is Object::zero_array() of length 1.
-    intptr_t entries = (length - 1) / StubCode::kInstantiationSizeInWords;
-    intptr_t new_entries = entries + (entries >> 1) + 1;
-    length = new_entries * StubCode::kInstantiationSizeInWords + 1;
-    prior_instantiations =
-        Array::Grow(prior_instantiations, length, Heap::kOld);
-    set_instantiations(prior_instantiations);
-    ASSERT((index + StubCode::kInstantiationSizeInWords) < length);
-  }
-  prior_instantiations.SetAt(index + 0, instantiator_type_arguments);
-  prior_instantiations.SetAt(index + 1, function_type_arguments);
-  prior_instantiations.SetAt(index + 2, result);
-  prior_instantiations.SetAt(index + 3,
-                             Smi::Handle(Smi::New(StubCode::kNoInstantiator)));
+  AddInstantiation(instantiator_type_arguments, function_type_arguments,
+                   result);
   return result.raw();
 }
 
+void TypeArguments::AddInstantiation(
+    const TypeArguments& instantiator_type_arguments,
+    const TypeArguments& function_type_arguments,
+    const TypeArguments& instantiation) const {
+  // The probe start depends on the hashes, which must not change once cached.
+  if (!instantiator_type_arguments.IsNull()) {
+    instantiator_type_arguments.Hash();
+  }
+  if (!function_type_arguments.IsNull()) {
+    function_type_arguments.Hash();
+  }
+  Array& cache = Array::Handle(instantiations());
+  const intptr_t length = cache.Length();
+  intptr_t num_entries = 0;
+  intptr_t capacity = 0;
+  if (length > 1) {
+    num_entries = Smi::Value(
+        Smi::RawCast(cache.At(length - kInstantiationsNumEntriesFromEnd)));
+    capacity = (length - kInstantiationsNumEntriesFromEnd) /
+               StubCode::kInstantiationSizeInWords;
+  }
+  if (2 * (num_entries + 1) > capacity) {
+    // Rehash into a table twice as large, starting with 4 entries.
+    const intptr_t kInitialCapacity = 4;
+    const intptr_t new_capacity =
+        (capacity == 0) ? kInitialCapacity : 2 * capacity;
+    const Array& new_cache = Array::Handle(
+        Array::New(new_capacity * StubCode::kInstantiationSizeInWords +
+                       kInstantiationsNumEntriesFromEnd,
+                   Heap::kOld));
+    const Smi& free = Smi::Handle(Smi::New(StubCode::kNoInstantiator));
+    for (intptr_t i = 0; i < new_capacity; i++) {
+      new_cache.SetAt(i * StubCode::kInstantiationSizeInWords, free);
+    }
+    new_cache.SetAt(new_cache.Length() - kInstantiationsHashMaskFromEnd,
+                    Smi::Handle(Smi::New(new_capacity - 1)));
+    Object& instantiator = Object::Handle();
+    Object& function = Object::Handle();
+    Object& instantiated = Object::Handle();
+    for (intptr_t i = 0; i < capacity; i++) {
+      const intptr_t index = i * StubCode::kInstantiationSizeInWords;
+      instantiator = cache.At(index);
+      if (instantiator.raw() == free.raw()) continue;
+      function = cache.At(index + 1);
+      instantiated = cache.At(index + 2);
+      const intptr_t new_index = FindInstantiation(
+          new_cache.raw(), instantiator.raw(), function.raw());
+      new_cache.SetAt(new_index, instantiator);
+      new_cache.SetAt(new_index + 1, function);
+      new_cache.SetAt(new_index + 2, instantiated);
+    }
+    cache = new_cache.raw();
+    set_instantiations(cache);
+  }
+  const intptr_t index =
+      FindInstantiation(cache.raw(), instantiator_type_arguments.raw(),
+                        function_type_arguments.raw());
+  ASSERT(cache.At(index) == Smi::New(StubCode::kNoInstantiator));
+  // The instantiator goes in last: it marks the entry as used.
+  cache.SetAt(index + 1, function_type_arguments);
+  cache.SetAt(index + 2, instantiation);
+  cache.SetAt(index, instantiator_type_arguments);
+  cache.SetAt(cache.Length() - kInstantiationsNumEntriesFromEnd,
+              Smi::Handle(Smi::New(num_entries + 1)));
+}
+
 RawTypeArguments* TypeArguments::New(intptr_t len, Heap::Space space) {
   if (len < 0 || len > kMaxElements) {
     // This should be caught before we reach here.
@@ -5537,11 +5675,11 @@ RawTypeArguments* TypeArguments::Canonicalize(TrailPtr trail) const {
   ObjectStore* object_store = isolate->object_store();
   TypeArguments& result = TypeArguments::Handle(zone);
   {
-    SafepointMutexLocker ml(isolate->type_canonicalization_mutex());
+    // Most lookups hit, so probe without the lock first.
     CanonicalTypeArgumentsSet table(zone,
                                     object_store->canonical_type_arguments());
-    result ^= table.GetOrNull(CanonicalTypeArgumentsKey(*this));
-    object_store->set_canonical_type_arguments(table.Release());
+    result ^= table.GetOrNullConcurrent(CanonicalTypeArgumentsKey(*this));
+    table.Release();
   }
   if (result.IsNull()) {
     // Canonicalize each type argument.
@@ -6102,6 +6240,20 @@ RawFunction* Function::FfiCSignature() const {
   return FfiTrampolineData::Cast(obj).c_signature();
 }
 
+bool Function::FfiIsLeaf() const {
+  ASSERT(IsFfiTrampoline());
+  const Object& obj = Object::Handle(raw_ptr()->data_);
+  ASSERT(!obj.IsNull());
+  return FfiTrampolineData::Cast(obj).is_leaf();
+}
+
+void Function::SetFfiIsLeaf(bool is_leaf) const {
+  ASSERT(IsFfiTrampoline());
+  const Object& obj = Object::Handle(raw_ptr()->data_);
+  ASSERT(!obj.IsNull());
+  FfiTrampolineData::Cast(obj).set_is_leaf(is_leaf);
+}
+
 RawType* Function::SignatureType() const {
   Type& type = Type::Handle(ExistingSignatureType());
   if (type.IsNull()) {
@@ -8252,12 +8404,18 @@ void FfiTrampolineData::set_c_signature(const Function& value) const {
   StorePointer(&raw_ptr()->c_signature_, value.raw());
 }
 
+void FfiTrampolineData::set_is_leaf(bool value) const {
+  StoreNonPointer(&raw_ptr()->is_leaf_, value);
+}
+
 RawFfiTrampolineData* FfiTrampolineData::New() {
   ASSERT(Object::ffi_trampoline_data_class() != Class::null());
   RawObject* raw =
       Object::Allocate(FfiTrampolineData::kClassId,
                        FfiTrampolineData::InstanceSize(), Heap::kOld);
-  return reinterpret_cast<RawFfiTrampolineData*>(raw);
+  RawFfiTrampolineData* data = reinterpret_cast<RawFfiTrampolineData*>(raw);
+  data->ptr()->is_leaf_ = false;
+  return data;
 }
 
 const char* FfiTrampolineData::ToCString() const {
@@ -14745,22 +14903,18 @@ RawCode* Code::FinalizeCode(FlowGraphCompiler* compiler,
                                object->raw());
     }
 
-    // Write protect instructions and, if supported by OS, use dual mapping
-    // for execution.
+    // Write protect instructions or, if supported by OS, use dual mapping
+    // for execution. The executable alias of dual mapped code is never
+    // writable, so it needs no change of protections.
     if (FLAG_write_protect_code) {
       uword address = RawObject::ToAddr(instrs.raw());
       // Check if a dual mapping exists.
       instrs = Instructions::RawCast(HeapPage::ToExecutable(instrs.raw()));
-      uword exec_address = RawObject::ToAddr(instrs.raw());
-      if (exec_address != address) {
+      if (RawObject::ToAddr(instrs.raw()) == address) {
         VirtualMemory::Protect(reinterpret_cast<void*>(address),
                                instrs.raw()->HeapSize(),
-                               VirtualMemory::kReadOnly);
-        address = exec_address;
+                               VirtualMemory::kReadExecute);
       }
-      VirtualMemory::Protect(reinterpret_cast<void*>(address),
-                             instrs.raw()->HeapSize(),
-                             VirtualMemory::kReadExecute);
     }
 
     // Hook up Code and Instructions objects.
@@ -14780,7 +14934,7 @@ RawCode* Code::FinalizeCode(FlowGraphCompiler* compiler,
     }
 #endif
 
-    CPU::FlushICache(instrs.PayloadStart(), instrs.Size());
+    ICacheFlushBatch::FlushICache(instrs.PayloadStart(), instrs.Size());
   }
 
 #ifndef PRODUCT
@@ -15443,22 +15597,24 @@ const char* ContextScope::ToCString() const {
 }
 
 RawArray* MegamorphicCache::buckets() const {
-  return raw_ptr()->buckets_;
+  return AtomicOperations::LoadAcquire(&raw_ptr()->buckets_);
 }
 
 void MegamorphicCache::set_buckets(const Array& buckets) const {
-  StorePointer(&raw_ptr()->buckets_, buckets.raw());
+  StorePointer<RawArray*, MemoryOrder::kRelease>(&raw_ptr()->buckets_,
+                                                 buckets.raw());
 }
 
 // Class IDs in the table are smi-tagged, so we use a smi-tagged mask
 // and target class ID to avoid untagging (on each iteration of the
 // test loop) in generated code.
 intptr_t MegamorphicCache::mask() const {
-  return Smi::Value(raw_ptr()->mask_);
+  return Smi::Value(AtomicOperations::LoadAcquire(&raw_ptr()->mask_));
 }
 
 void MegamorphicCache::set_mask(intptr_t mask) const {
-  StoreSmi(&raw_ptr()->mask_, Smi::New(mask));
+  StorePointer<RawSmi*, MemoryOrder::kRelease>(&raw_ptr()->mask_,
+                                               Smi::New(mask));
 }
 
 intptr_t MegamorphicCache::filled_entry_count() const {
@@ -15522,6 +15678,7 @@ void MegamorphicCache::EnsureCapacity() const {
   if (static_cast<double>(filled_entry_count() + 1) > load_limit) {
     const Array& old_buckets = Array::Handle(buckets());
     intptr_t new_capacity = old_capacity * 2;
+    const intptr_t new_mask = new_capacity - 1;
     const Array& new_buckets =
         Array::Handle(Array::New(kEntryLength * new_capacity));
 
@@ -15530,38 +15687,91 @@ void MegamorphicCache::EnsureCapacity() const {
     for (intptr_t i = 0; i < new_capacity; ++i) {
       SetEntry(new_buckets, i, smi_illegal_cid(), target);
     }
-    set_buckets(new_buckets);
-    set_mask(new_capacity - 1);
-    set_filled_entry_count(0);
 
-    // Rehash the valid entries.
+    // Rehash the valid entries before the new buckets are published, so that
+    // concurrent readers never see a partially filled table.
     Smi& class_id = Smi::Handle();
+    intptr_t filled_entry_count = 0;
     for (intptr_t i = 0; i < old_capacity; ++i) {
       class_id ^= GetClassId(old_buckets, i);
       if (class_id.Value() != kIllegalCid) {
         target = GetTargetFunction(old_buckets, i);
-        Insert(class_id, target);
+        InsertEntry(new_buckets, new_mask, class_id, target);
+        filled_entry_count++;
       }
     }
+
+    // Readers load the mask before the buckets. Publishing the buckets first
+    // means a reader can pair the old mask with the new buckets, which only
+    // probes a prefix of them, but never the new mask with the old buckets.
+    set_buckets(new_buckets);
+    set_mask(new_mask);
+    set_filled_entry_count(filled_entry_count);
   }
 }
 
+void MegamorphicCache::InsertEntry(const Array& array,
+                                   intptr_t mask,
+                                   const Smi& class_id,
+                                   const Object& target) {
+  intptr_t index = (class_id.Value() * kSpreadFactor) & mask;
+  intptr_t i = index;
+  do {
+    if (Smi::Value(Smi::RawCast(GetClassId(array, i))) == kIllegalCid) {
+      SetEntry(array, i, class_id, target);
+      return;
+    }
+    i = (i + 1) & mask;
+  } while (i != index);
+  UNREACHABLE();
+}
+
 void MegamorphicCache::Insert(const Smi& class_id, const Object& target) const {
   ASSERT(static_cast<double>(filled_entry_count() + 1) <=
          (kLoadFactor * static_cast<double>(mask() + 1)));
   const Array& backing_array = Array::Handle(buckets());
-  intptr_t id_mask = mask();
+  InsertEntry(backing_array, mask(), class_id, target);
+  set_filled_entry_count(filled_entry_count() + 1);
+}
+
+RawObject* MegamorphicCache::Lookup(const Smi& class_id) const {
+  // See EnsureCapacity for why the mask has to be loaded first.
+  const intptr_t id_mask = mask();
+  const Array& backing_array = Array::Handle(buckets());
   intptr_t index = (class_id.Value() * kSpreadFactor) & id_mask;
   intptr_t i = index;
   do {
-    if (Smi::Value(Smi::RawCast(GetClassId(backing_array, i))) == kIllegalCid) {
-      SetEntry(backing_array, i, class_id, target);
-      set_filled_entry_count(filled_entry_count() + 1);
-      return;
+    const intptr_t probe_cid =
+        Smi::Value(Smi::RawCast(GetClassIdAcquire(backing_array, i)));
+    if (probe_cid == class_id.Value()) {
+      return GetTargetFunction(backing_array, i);
+    }
+    if (probe_cid == kIllegalCid) {
+      break;
     }
     i = (i + 1) & id_mask;
   } while (i != index);
-  UNREACHABLE();
+  return Object::null();
+}
+
+intptr_t MegamorphicCache::ProbeCount(const Array& buckets,
+                                      intptr_t mask,
+                                      intptr_t class_id) {
+  intptr_t index = (class_id * kSpreadFactor) & mask;
+  intptr_t i = index;
+  intptr_t probe_count = 0;
+  do {
+    probe_count++;
+    const intptr_t probe_cid = Smi::Value(Smi::RawCast(GetClassId(buckets, i)));
+    if (probe_cid == class_id) {
+      return probe_count;
+    }
+    if (probe_cid == kIllegalCid) {
+      break;
+    }
+    i = (i + 1) & mask;
+  } while (i != index);
+  return -1;
 }
 
 const char* MegamorphicCache::ToCString() const {
@@ -16276,8 +16486,13 @@ RawInstance* Instance::CheckAndCanonicalize(Thread* thread,
   Isolate* isolate = thread->isolate();
   Instance& result = Instance::Handle(zone);
   const Class& cls = Class::Handle(zone, this->clazz());
+  result ^= cls.LookupCanonicalInstance(zone, *this);
+  if (!result.IsNull()) {
+    return result.raw();
+  }
   {
     SafepointMutexLocker ml(isolate->constant_canonicalization_mutex());
+    // Retry lookup.
     result ^= cls.LookupCanonicalInstance(zone, *this);
     if (!result.IsNull()) {
       return result.raw();
@@ -16298,10 +16513,8 @@ RawInstance* Instance::CheckAndCanonicalize(Thread* thread,
 #if defined(DEBUG)
 bool Instance::CheckIsCanonical(Thread* thread) const {
   Zone* zone = thread->zone();
-  Isolate* isolate = thread->isolate();
   Instance& result = Instance::Handle(zone);
   const Class& cls = Class::Handle(zone, this->clazz());
-  SafepointMutexLocker ml(isolate->constant_canonicalization_mutex());
   result ^= cls.LookupCanonicalInstance(zone, *this);
   return (result.raw() == this->raw());
 }
@@ -17667,10 +17880,10 @@ RawAbstractType* Type::Canonicalize(TrailPtr trail) const {
   AbstractType& type = Type::Handle(zone);
   ObjectStore* object_store = isolate->object_store();
   {
-    SafepointMutexLocker ml(isolate->type_canonicalization_mutex());
+    // Most lookups hit, so probe without the lock first.
     CanonicalTypeSet table(zone, object_store->canonical_types());
-    type ^= table.GetOrNull(CanonicalTypeKey(*this));
-    ASSERT(object_store->canonical_types() == table.Release().raw());
+    type ^= table.GetOrNullConcurrent(CanonicalTypeKey(*this));
+    table.Release();
   }
   if (type.IsNull()) {
     // The type was not found in the table. It is not canonical yet.
@@ -17757,10 +17970,9 @@ bool Type::CheckIsCanonical(Thread* thread) const {
 
   ObjectStore* object_store = isolate->object_store();
   {
-    SafepointMutexLocker ml(isolate->type_canonicalization_mutex());
     CanonicalTypeSet table(zone, object_store->canonical_types());
-    type ^= table.GetOrNull(CanonicalTypeKey(*this));
-    object_store->set_canonical_types(table.Release());
+    type ^= table.GetOrNullConcurrent(CanonicalTypeKey(*this));
+    table.Release();
   }
   return (raw() == type.raw());
 }
@@ -19715,16 +19927,200 @@ RawString* String::Transform(int32_t (*mapping)(int32_t ch),
   return TwoByteString::Transform(mapping, str, space);
 }
 
+static const uint64_t kAsciiWordOnes = 0x0101010101010101ULL;
+static const uint64_t kAsciiWordHighBits = 0x80 * kAsciiWordOnes;
+
+// Loads the eight characters at |chars| as a word, whose bytes are ASCII
+// exactly if none of kAsciiWordHighBits are set.
+static inline uint64_t LoadAsciiWord(const uint8_t* chars) {
+  uint64_t word;
+  memmove(&word, chars, sizeof(word));
+  return word;
+}
+
+// Returns the high bit of each byte of the ASCII |word| which is in
+// [first, last]. Adding to the bytes cannot carry into the next byte, as
+// they are all below 0x80.
+static inline uint64_t AsciiBytesInRange(uint64_t word,
+                                         uint8_t first,
+                                         uint8_t last) {
+  const uint64_t at_least_first = word + (0x80 - first) * kAsciiWordOnes;
+  const uint64_t above_last = word + (0x7F - last) * kAsciiWordOnes;
+  return at_least_first & ~above_last & kAsciiWordHighBits;
+}
+
+static inline uint8_t AsciiToLower(uint8_t ch) {
+  return ((ch >= 'A') && (ch <= 'Z')) ? (ch | 0x20) : ch;
+}
+
+// Returns the index of the first of |chars| which |mapping| changes, or
+// |length| if it changes none. Words of ASCII characters are only checked
+// for characters in [first, last].
+static intptr_t FindFirstMapped(int32_t (*mapping)(int32_t ch),
+                                uint8_t first,
+                                uint8_t last,
+                                const uint8_t* chars,
+                                intptr_t length) {
+  intptr_t i = 0;
+  while (i < length) {
+    if (i + 8 <= length) {
+      const uint64_t word = LoadAsciiWord(chars + i);
+      if (((word & kAsciiWordHighBits) == 0) &&
+          (AsciiBytesInRange(word, first, last) == 0)) {
+        i += 8;
+        continue;
+      }
+    }
+    const intptr_t end = Utils::Minimum(i + 8, length);
+    for (; i < end; i++) {
+      if (mapping(chars[i]) != chars[i]) {
+        return i;
+      }
+    }
+  }
+  return length;
+}
+
+// Maps |length| of |src| into |dst|, eight ASCII characters at a time when
+// possible. Returns false if a character maps to one outside Latin-1.
+static bool MapOneByteChars(int32_t (*mapping)(int32_t ch),
+                            uint8_t first,
+                            uint8_t last,
+                            const uint8_t* src,
+                            uint8_t* dst,
+                            intptr_t length) {
+  intptr_t i = 0;
+  while (i < length) {
+    if (i + 8 <= length) {
+      uint64_t word = LoadAsciiWord(src + i);
+      if ((word & kAsciiWordHighBits) == 0) {
+        // Case only differs in bit 0x20, two below each byte's high bit.
+        word ^= AsciiBytesInRange(word, first, last) >> 2;
+        memmove(dst + i, &word, sizeof(word));
+        i += 8;
+        continue;
+      }
+    }
+    const intptr_t end = Utils::Minimum(i + 8, length);
+    for (; i < end; i++) {
+      const int32_t ch = mapping(src[i]);
+      if (!Utf::IsLatin1(ch)) {
+        return false;
+      }
+      dst[i] = ch;
+    }
+  }
+  return true;
+}
+
+RawString* String::TransformOneByte(int32_t (*mapping)(int32_t ch),
+                                    uint8_t first,
+                                    uint8_t last,
+                                    const String& str,
+                                    Heap::Space space) {
+  ASSERT(str.IsOneByteString() || str.IsExternalOneByteString());
+  const intptr_t length = str.Length();
+  if (length == 0) {
+    return str.raw();
+  }
+  intptr_t start;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* chars = str.IsOneByteString()
+                               ? OneByteString::CharAddr(str, 0)
+                               : ExternalOneByteString::CharAddr(str, 0);
+    start = FindFirstMapped(mapping, first, last, chars, length);
+  }
+  if (start == length) {
+    // Nothing changes, so there is no need for a copy.
+    return str.raw();
+  }
+  const String& result = String::Handle(OneByteString::New(length, space));
+  bool is_latin1;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* chars = str.IsOneByteString()
+                               ? OneByteString::CharAddr(str, 0)
+                               : ExternalOneByteString::CharAddr(str, 0);
+    uint8_t* result_chars = OneByteString::CharAddr(result, 0);
+    memmove(result_chars, chars, start);
+    is_latin1 = MapOneByteChars(mapping, first, last, chars + start,
+                                result_chars + start, length - start);
+  }
+  if (!is_latin1) {
+    // The upper case of 'µ' and 'ÿ' are outside Latin-1.
+    return TwoByteString::Transform(mapping, str, space);
+  }
+  return result.raw();
+}
+
 RawString* String::ToUpperCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.IsOneByteString() || str.IsExternalOneByteString()) {
+    return TransformOneByte(CaseMapping::ToUpper, 'a', 'z', str, space);
+  }
   return Transform(CaseMapping::ToUpper, str, space);
 }
 
 RawString* String::ToLowerCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.IsOneByteString() || str.IsExternalOneByteString()) {
+    return TransformOneByte(CaseMapping::ToLower, 'A', 'Z', str, space);
+  }
   return Transform(CaseMapping::ToLower, str, space);
 }
 
+bool String::EqualsIgnoreAsciiCase(const String& str1, const String& str2) {
+  const intptr_t length = str1.Length();
+  if (length != str2.Length()) {
+    return false;
+  }
+  if (str1.raw() == str2.raw() || length == 0) {
+    return true;
+  }
+  NoSafepointScope no_safepoint;
+  if ((str1.IsOneByteString() || str1.IsExternalOneByteString()) &&
+      (str2.IsOneByteString() || str2.IsExternalOneByteString())) {
+    const uint8_t* chars1 = str1.IsOneByteString()
+                                ? OneByteString::CharAddr(str1, 0)
+                                : ExternalOneByteString::CharAddr(str1, 0);
+    const uint8_t* chars2 = str2.IsOneByteString()
+                                ? OneByteString::CharAddr(str2, 0)
+                                : ExternalOneByteString::CharAddr(str2, 0);
+    intptr_t i = 0;
+    while (i < length) {
+      if (i + 8 <= length) {
+        uint64_t word1 = LoadAsciiWord(chars1 + i);
+        uint64_t word2 = LoadAsciiWord(chars2 + i);
+        if (((word1 | word2) & kAsciiWordHighBits) == 0) {
+          word1 |= AsciiBytesInRange(word1, 'A', 'Z') >> 2;
+          word2 |= AsciiBytesInRange(word2, 'A', 'Z') >> 2;
+          if (word1 != word2) {
+            return false;
+          }
+          i += 8;
+          continue;
+        }
+      }
+      const intptr_t end = Utils::Minimum(i + 8, length);
+      for (; i < end; i++) {
+        if (AsciiToLower(chars1[i]) != AsciiToLower(chars2[i])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  for (intptr_t i = 0; i < length; i++) {
+    const uint16_t ch1 = str1.CharAt(i);
+    const uint16_t ch2 = str2.CharAt(i);
+    if ((ch1 != ch2) &&
+        ((ch1 > 0x7F) || (ch2 > 0x7F) ||
+         (AsciiToLower(ch1) != AsciiToLower(ch2)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool String::ParseDouble(const String& str,
                          intptr_t start,
                          intptr_t end,
@@ -20421,11 +20817,13 @@ uint32_t Array::CanonicalizeHash() const {
 
 RawArray* Array::New(intptr_t len, Heap::Space space) {
   ASSERT(Isolate::Current()->object_store()->array_class() != Class::null());
-  RawArray* result = New(kClassId, len, space);
-  if (UseCardMarkingForAllocation(len)) {
-    ASSERT(result->IsOldObject());
-    result->SetCardRememberedBitUnsynchronized();
+  if (!UseCardMarkingForAllocation(len)) {
+    return New(kClassId, len, space);
   }
+  RawArray* result = New(kClassId, len, Heap::kOld);
+  ASSERT(result->IsOldObject());
+  result->SetCardRememberedBitUnsynchronized();
+  HeapPage::Of(result)->RegisterCardArray(result, false);
   return result;
 }
 
@@ -20472,6 +20870,20 @@ RawArray* Array::Slice(intptr_t start,
   return dest.raw();
 }
 
+void Array::CopyFrom(intptr_t start,
+                     const Array& source,
+                     intptr_t source_start,
+                     intptr_t count) const {
+  ASSERT(raw() != source.raw());
+  ASSERT((start >= 0) && (count >= 0) && (start + count <= Length()));
+  ASSERT((source_start >= 0) && (source_start + count <= source.Length()));
+  if (count == 0) {
+    return;
+  }
+  NoSafepointScope no_safepoint;
+  StoreArrayPointers(ObjectAddr(start), source.ObjectAddr(source_start), count);
+}
+
 void Array::MakeImmutable() const {
   if (IsImmutable()) return;
   ASSERT(!IsCanonical());
@@ -20509,10 +20921,8 @@ RawArray* Array::Grow(const Array& source,
   }
   ASSERT(new_length >= len);  // Cannot copy 'source' into new array.
   ASSERT(new_length != len);  // Unnecessary copying of array.
-  PassiveObject& obj = PassiveObject::Handle(zone);
-  for (int i = 0; i < len; i++) {
-    obj = source.At(i);
-    result.SetAt(i, obj);
+  if (len > 0) {
+    result.CopyFrom(0, source, 0, len);
   }
   return result.raw();
 }
@@ -21250,6 +21660,43 @@ const char* Capability::ToCString() const {
   return "Capability";
 }
 
+void TransferableTypedDataPeer::ClearData(Isolate* isolate) {
+  handle_->EnsureFreeExternal(isolate);
+  data_ = nullptr;
+  length_ = 0;
+}
+
+static void TransferableTypedDataFinalizer(void* isolate_callback_data,
+                                           Dart_WeakPersistentHandle handle,
+                                           void* peer) {
+  delete reinterpret_cast<TransferableTypedDataPeer*>(peer);
+}
+
+RawTransferableTypedData* TransferableTypedData::New(uint8_t* data,
+                                                     intptr_t length,
+                                                     Heap::Space space) {
+  TransferableTypedDataPeer* peer = new TransferableTypedDataPeer(data, length);
+  TransferableTypedData& result = TransferableTypedData::Handle();
+  {
+    RawObject* raw =
+        Object::Allocate(TransferableTypedData::kClassId,
+                         TransferableTypedData::InstanceSize(), space);
+    NoSafepointScope no_safepoint;
+    result ^= raw;
+    result.StoreNonPointer(&result.raw_ptr()->peer_, peer);
+  }
+  // The bytes are freed with the peer if the object is collected while it
+  // still owns them.
+  peer->set_handle(FinalizablePersistentHandle::New(
+      Isolate::Current(), result, peer, &TransferableTypedDataFinalizer,
+      length));
+  return result.raw();
+}
+
+const char* TransferableTypedData::ToCString() const {
+  return "TransferableTypedData";
+}
+
 RawReceivePort* ReceivePort::New(Dart_Port id,
                                  bool is_control_port,
                                  Heap::Space space) {
@@ -21418,28 +21865,41 @@ RawFunction* Closure::GetInstantiatedSignature(Zone* zone) const {
 }
 
 intptr_t StackTrace::Length() const {
-  const Array& code_array = Array::Handle(raw_ptr()->code_array_);
-  return code_array.Length();
+  // Also set for lazy stack traces.
+  const Array& pc_offset_array = Array::Handle(raw_ptr()->pc_offset_array_);
+  return pc_offset_array.Length();
 }
 
 RawObject* StackTrace::CodeAtFrame(intptr_t frame_index) const {
+  if (IsLazy()) {
+    Materialize();
+  }
   const Array& code_array = Array::Handle(raw_ptr()->code_array_);
   return code_array.At(frame_index);
 }
 
 void StackTrace::SetCodeAtFrame(intptr_t frame_index,
                                 const Object& code) const {
+  if (IsLazy()) {
+    Materialize();
+  }
   const Array& code_array = Array::Handle(raw_ptr()->code_array_);
   code_array.SetAt(frame_index, code);
 }
 
 RawSmi* StackTrace::PcOffsetAtFrame(intptr_t frame_index) const {
+  if (IsLazy()) {
+    Materialize();
+  }
   const Array& pc_offset_array = Array::Handle(raw_ptr()->pc_offset_array_);
   return reinterpret_cast<RawSmi*>(pc_offset_array.At(frame_index));
 }
 
 void StackTrace::SetPcOffsetAtFrame(intptr_t frame_index,
                                     const Smi& pc_offset) const {
+  if (IsLazy()) {
+    Materialize();
+  }
   const Array& pc_offset_array = Array::Handle(raw_ptr()->pc_offset_array_);
   pc_offset_array.SetAt(frame_index, pc_offset);
 }
@@ -21498,6 +21958,37 @@ RawStackTrace* StackTrace::New(const Array& code_array,
   return result.raw();
 }
 
+RawStackTrace* StackTrace::NewLazy(const Array& return_address_offsets,
+                                   Heap::Space space) {
+  ASSERT(!return_address_offsets.IsNull());
+  return New(Array::null_array(), return_address_offsets, space);
+}
+
+void StackTrace::Materialize() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  ASSERT(IsLazy());
+  Zone* zone = Thread::Current()->zone();
+  ReversePcLookupCache* cache = Isolate::Current()->reverse_pc_lookup_cache();
+  const Array& pc_offset_array =
+      Array::Handle(zone, raw_ptr()->pc_offset_array_);
+  const intptr_t length = pc_offset_array.Length();
+  const Array& code_array = Array::Handle(zone, Array::New(length));
+  Code& code = Code::Handle(zone);
+  Smi& offset = Smi::Handle(zone);
+  for (intptr_t i = 0; i < length; i++) {
+    offset ^= pc_offset_array.At(i);
+    const uword pc = cache->first_absolute_pc() + offset.Value();
+    code = cache->Lookup(pc);
+    code_array.SetAt(i, code);
+    offset = Smi::New(pc - code.PayloadStart());
+    pc_offset_array.SetAt(i, offset);
+  }
+  set_code_array(code_array);
+#else
+  UNREACHABLE();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 static void PrintStackTraceFrame(Zone* zone,
                                  ZoneTextBuffer* buffer,
                                  const Function& function,
@@ -21624,6 +22115,24 @@ const char* StackTrace::ToDartCString(const StackTrace& stack_trace_in) {
   return buffer.buffer();
 }
 
+#if defined(DART_PRECOMPILER) || defined(DART_PRECOMPILED_RUNTIME)
+// Appends the offset of the address into the instructions image, which
+// together with the image's build id identifies the instruction even when
+// the image was not loaded from a shared object.
+static void PrintInstructionsImageOffset(ZoneTextBuffer* buffer,
+                                         uword address) {
+  const uint8_t* isolate_image = Isolate::Current()->instructions_image();
+  const uint8_t* vm_image = Dart::vm_isolate()->instructions_image();
+  if ((isolate_image != NULL) && Image(isolate_image).Contains(address)) {
+    buffer->Printf("  _kDartIsolateSnapshotInstructions+0x%" Px,
+                   address - reinterpret_cast<uword>(isolate_image));
+  } else if ((vm_image != NULL) && Image(vm_image).Contains(address)) {
+    buffer->Printf("  _kDartVmSnapshotInstructions+0x%" Px,
+                   address - reinterpret_cast<uword>(vm_image));
+  }
+}
+#endif
+
 const char* StackTrace::ToDwarfCString(const StackTrace& stack_trace_in) {
 #if defined(DART_PRECOMPILER) || defined(DART_PRECOMPILED_RUNTIME)
   Zone* zone = Thread::Current()->zone();
@@ -21644,6 +22153,11 @@ const char* StackTrace::ToDwarfCString(const StackTrace& stack_trace_in) {
   OSThread* thread = OSThread::Current();
   buffer.Printf("pid: %" Pd ", tid: %" Pd ", name %s\n", OS::ProcessId(),
                 OSThread::ThreadIdToIntPtr(thread->id()), thread->name());
+  const uint8_t* isolate_image = Isolate::Current()->instructions_image();
+  if (isolate_image != NULL) {
+    buffer.Printf("build_id: '%016" Px64 "'\n",
+                  Image(isolate_image).build_id());
+  }
   intptr_t frame_index = 0;
   do {
     for (intptr_t i = 0; i < stack_trace.Length(); i++) {
@@ -21677,13 +22191,15 @@ const char* StackTrace::ToDwarfCString(const StackTrace& stack_trace_in) {
         if (NativeSymbolResolver::LookupSharedObject(call_addr, &dso_base,
                                                      &dso_name)) {
           uword dso_offset = call_addr - dso_base;
-          buffer.Printf("    #%02" Pd " pc %" Pp "  %s\n", frame_index,
+          buffer.Printf("    #%02" Pd " pc %" Pp "  %s", frame_index,
                         dso_offset, dso_name);
           NativeSymbolResolver::FreeSymbolName(dso_name);
         } else {
-          buffer.Printf("    #%02" Pd " pc %" Pp "  <unknown>\n", frame_index,
+          buffer.Printf("    #%02" Pd " pc %" Pp "  <unknown>", frame_index,
                         call_addr);
         }
+        PrintInstructionsImageOffset(&buffer, call_addr);
+        buffer.AddString("\n");
         frame_index++;
       }
     }
@@ -21753,6 +22269,7 @@ RawRegExp* RegExp::New(Heap::Space space) {
     result.set_type(kUninitialized);
     result.set_flags(0);
     result.set_num_registers(-1);
+    result.set_execution_count(0);
   }
   return result.raw();
 }
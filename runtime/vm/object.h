@@ -2005,6 +2005,12 @@ class Function : public Object {
   // Can only be used on FFI trampolines.
   RawFunction* FfiCSignature() const;
 
+  // Whether the C function called by an FFI trampoline promises to neither
+  // call back into Dart nor block, so that the call needs no transition.
+  // Can only be used on FFI trampolines.
+  bool FfiIsLeaf() const;
+  void SetFfiIsLeaf(bool is_leaf) const;
+
   // Return a new function with instantiated result and parameter types.
   RawFunction* InstantiateSignatureFrom(
       const TypeArguments& instantiator_type_arguments,
@@ -2537,7 +2543,7 @@ class Function : public Object {
     // On DBC we use native calls instead of IR for the view factories (see
     // kernel_to_il.cc)
 #if !defined(TARGET_ARCH_DBC)
-    if (IsTypedDataViewFactory()) {
+    if (IsTypedDataViewFactory() || IsFfiLoadOrStore()) {
       return true;
     }
 #endif
@@ -2736,6 +2742,14 @@ class Function : public Object {
     return false;
   }
 
+  // Whether this is one of the dart:ffi element accessors which are built as
+  // raw memory accesses (see kernel_to_il.cc).
+  bool IsFfiLoadOrStore() const {
+    const MethodRecognizer::Kind kind = recognized_kind();
+    return (MethodRecognizer::kFfiLoadInt8 <= kind) &&
+           (kind <= MethodRecognizer::kFfiStoreDouble);
+  }
+
   DART_WARN_UNUSED_RESULT
   RawError* VerifyCallEntryPoint() const;
 
@@ -3135,6 +3149,9 @@ class FfiTrampolineData : public Object {
   RawFunction* c_signature() const { return raw_ptr()->c_signature_; }
   void set_c_signature(const Function& value) const;
 
+  bool is_leaf() const { return raw_ptr()->is_leaf_; }
+  void set_is_leaf(bool value) const;
+
   static RawFfiTrampolineData* New();
 
   FINAL_HEAP_OBJECT_IMPLEMENTATION(FfiTrampolineData, Object);
@@ -3223,6 +3240,16 @@ class Field : public Object {
         GenericCovariantImplBit::update(value, raw_ptr()->kind_bits_));
   }
 
+  // Whether type flow analysis proved that only integers are stored into
+  // this field. Only set in precompiled mode, where the guarded cid alone
+  // cannot express a mix of Smis and Mints.
+  bool is_inferred_int() const {
+    return InferredIntBit::decode(raw_ptr()->kind_bits_);
+  }
+  void set_is_inferred_int(bool value) const {
+    set_kind_bits(InferredIntBit::update(value, raw_ptr()->kind_bits_));
+  }
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
   intptr_t binary_declaration_offset() const {
     return RawField::BinaryDeclarationOffset::decode(
@@ -3546,6 +3573,7 @@ class Field : public Object {
     kHasPragmaBit,
     kCovariantBit,
     kGenericCovariantImplBit,
+    kInferredIntBit,
   };
   class ConstBit : public BitField<uint16_t, bool, kConstBit, 1> {};
   class StaticBit : public BitField<uint16_t, bool, kStaticBit, 1> {};
@@ -3566,6 +3594,7 @@ class Field : public Object {
   class CovariantBit : public BitField<uint16_t, bool, kCovariantBit, 1> {};
   class GenericCovariantImplBit
       : public BitField<uint16_t, bool, kGenericCovariantImplBit, 1> {};
+  class InferredIntBit : public BitField<uint16_t, bool, kInferredIntBit, 1> {};
 
   // Update guarded cid and guarded length for this field. Returns true, if
   // deoptimization of dependent code is required.
@@ -4304,6 +4333,19 @@ class ObjectPool : public Object {
     StorePointer(&EntryAddr(index)->raw_obj_, obj.raw());
   }
 
+  // Access to entries with acquire release semantics, for entries that
+  // running code reads while they are updated (see switchable calls).
+  RawObject* ObjectAtAcquire(intptr_t index) const {
+    ASSERT((TypeAt(index) == EntryType::kTaggedObject) ||
+           (TypeAt(index) == EntryType::kNativeEntryData));
+    return AtomicOperations::LoadAcquire(&EntryAddr(index)->raw_obj_);
+  }
+  void SetObjectAtRelease(intptr_t index, const Object& obj) const {
+    ASSERT(TypeAt(index) == EntryType::kTaggedObject);
+    StorePointer<RawObject*, MemoryOrder::kRelease>(
+        &EntryAddr(index)->raw_obj_, obj.raw());
+  }
+
   uword RawValueAt(intptr_t index) const {
     ASSERT(TypeAt(index) != EntryType::kTaggedObject);
     return EntryAddr(index)->raw_value_;
@@ -4312,6 +4354,15 @@ class ObjectPool : public Object {
     ASSERT(TypeAt(index) != EntryType::kTaggedObject);
     StoreNonPointer(&EntryAddr(index)->raw_value_, raw_value);
   }
+  uword RawValueAtAcquire(intptr_t index) const {
+    ASSERT(TypeAt(index) != EntryType::kTaggedObject);
+    return AtomicOperations::LoadAcquire(&EntryAddr(index)->raw_value_);
+  }
+  void SetRawValueAtRelease(intptr_t index, uword raw_value) const {
+    ASSERT(TypeAt(index) != EntryType::kTaggedObject);
+    AtomicOperations::StoreRelease(
+        const_cast<uword*>(&EntryAddr(index)->raw_value_), raw_value);
+  }
 
   // Used during reloading (see object_reload.cc). Calls Reset on all ICDatas.
   void ResetICDatas(Zone* zone) const;
@@ -4913,6 +4964,10 @@ class Code : public Object {
     return code->ptr()->instructions_;
   }
 
+  static uword PayloadStartOf(const RawCode* code) {
+    return Instructions::PayloadStart(InstructionsOf(code));
+  }
+
   static uword EntryPoint(const RawCode* code) {
     return Instructions::EntryPoint(InstructionsOf(code));
   }
@@ -5344,6 +5399,12 @@ class Code : public Object {
     return Code::OptimizedBit::decode(code->ptr()->state_bits_);
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  static bool IsDisabled(RawCode* code) {
+    return code->ptr()->instructions_ != code->ptr()->active_instructions_;
+  }
+#endif
+
   static const intptr_t kEntrySize = sizeof(int32_t);  // NOLINT
 
   void set_compile_timestamp(int64_t timestamp) const {
@@ -5408,6 +5469,9 @@ class Bytecode : public Object {
   uword instructions() const { return raw_ptr()->instructions_; }
 
   uword PayloadStart() const { return instructions(); }
+  static uword PayloadStartOf(const RawBytecode* bytecode) {
+    return bytecode->ptr()->instructions_;
+  }
   intptr_t Size() const { return raw_ptr()->instructions_size_; }
 
   RawObjectPool* object_pool() const { return raw_ptr()->object_pool_; }
@@ -5689,6 +5753,16 @@ class MegamorphicCache : public Object {
 
   void Insert(const Smi& class_id, const Object& target) const;
 
+  // Returns the target cached for [class_id] or null. Can be called from
+  // background compiler threads while the mutator inserts into the cache.
+  RawObject* Lookup(const Smi& class_id) const;
+
+  // Returns the number of probes the lookup of [class_id] in [buckets] takes,
+  // or -1 if [class_id] is not in the table.
+  static intptr_t ProbeCount(const Array& buckets,
+                             intptr_t mask,
+                             intptr_t class_id);
+
   void SwitchToBareInstructions();
 
   static intptr_t InstanceSize() {
@@ -5716,7 +5790,15 @@ class MegamorphicCache : public Object {
                               const Smi& class_id,
                               const Object& target);
 
+  // Inserts into [array] without updating the entry count.
+  static void InsertEntry(const Array& array,
+                          intptr_t mask,
+                          const Smi& class_id,
+                          const Object& target);
+
   static inline RawObject* GetClassId(const Array& array, intptr_t index);
+  static inline RawObject* GetClassIdAcquire(const Array& array,
+                                             intptr_t index);
   static inline RawObject* GetTargetFunction(const Array& array,
                                              intptr_t index);
 
@@ -6299,6 +6381,30 @@ class TypeArguments : public Instance {
   static intptr_t instantiations_offset() {
     return OFFSET_OF(RawTypeArguments, instantiations_);
   }
+  static intptr_t hash_offset() { return OFFSET_OF(RawTypeArguments, hash_); }
+
+  // The instantiations cache is an open addressing hash table of entries of
+  // StubCode::kInstantiationSizeInWords slots: instantiator type arguments,
+  // function type arguments and their instantiation. A free entry starts with
+  // StubCode::kNoInstantiator. The table capacity is a power of two and the
+  // table is at most half full. The last two slots of the array hold the
+  // number of cached instantiations and the hash mask (capacity - 1) as Smis.
+  //
+  // The probe starts at the entry given by the bitwise xor of the raw hash
+  // fields of the two type argument vectors (0 for null) and the raw hash
+  // mask, and continues with the next entries, wrapping around, up to the
+  // matching or a free entry. Generated code probes the table the same way.
+  //
+  // Object::zero_array() of length 1 is the empty cache: its only slot reads
+  // both as a hash mask of 0 and as a free first entry.
+  static const intptr_t kInstantiationsNumEntriesFromEnd = 2;
+  static const intptr_t kInstantiationsHashMaskFromEnd = 1;
+
+  // Returns the index of the cache entry for the given pair of type argument
+  // vectors, or of the free entry where it would be inserted.
+  static intptr_t FindInstantiation(RawArray* instantiations,
+                                    RawObject* instantiator_type_arguments,
+                                    RawObject* function_type_arguments);
 
   static const intptr_t kBytesPerElement = kWordSize;
   static const intptr_t kMaxElements = kSmiMax / kBytesPerElement;
@@ -6347,6 +6453,9 @@ class TypeArguments : public Instance {
 
   RawArray* instantiations() const;
   void set_instantiations(const Array& value) const;
+  void AddInstantiation(const TypeArguments& instantiator_type_arguments,
+                        const TypeArguments& function_type_arguments,
+                        const TypeArguments& instantiation) const;
   RawAbstractType* const* TypeAddr(intptr_t index) const;
   void SetLength(intptr_t value) const;
   // Number of fields in the raw object=3 (instantiations_, length_ and hash_).
@@ -7400,6 +7509,10 @@ class String : public Instance {
   static RawString* ToLowerCase(const String& str,
                                 Heap::Space space = Heap::kNew);
 
+  // Returns whether the strings are equal after mapping the ASCII letters
+  // in both of them to lower case.
+  static bool EqualsIgnoreAsciiCase(const String& str1, const String& str2);
+
   static RawString* RemovePrivateKey(const String& name);
 
   static RawString* ScrubName(const String& name);
@@ -7437,6 +7550,14 @@ class String : public Instance {
   bool Equals(const uint8_t* characters, intptr_t len) const;
   static intptr_t Hash(const uint8_t* characters, intptr_t len);
 
+  // Maps a one-byte string with |mapping|, which changes the ASCII
+  // characters in [first, last] and no other ASCII characters.
+  static RawString* TransformOneByte(int32_t (*mapping)(int32_t ch),
+                                     uint8_t first,
+                                     uint8_t last,
+                                     const String& str,
+                                     Heap::Space space);
+
   void SetLength(intptr_t value) const {
     // This is only safe because we create a new Smi, which does not cause
     // heap allocation.
@@ -7493,6 +7614,19 @@ class OneByteString : public AllStatic {
   static intptr_t UnroundedSize(RawOneByteString* str) {
     return UnroundedSize(Smi::Value(str->ptr()->length_));
   }
+
+  // Compares the code units of two one-byte strings like String::CompareTo,
+  // but without handles.
+  static intptr_t CompareTo(RawOneByteString* a, RawOneByteString* b) {
+    const intptr_t a_len = Smi::Value(a->ptr()->length_);
+    const intptr_t b_len = Smi::Value(b->ptr()->length_);
+    const int result = memcmp(a->ptr()->data(), b->ptr()->data(),
+                              (a_len < b_len) ? a_len : b_len);
+    if (result != 0) {
+      return (result < 0) ? -1 : 1;
+    }
+    return (a_len < b_len) ? -1 : ((a_len > b_len) ? 1 : 0);
+  }
   static intptr_t UnroundedSize(intptr_t len) {
     return sizeof(RawOneByteString) + (len * kBytesPerElement);
   }
@@ -7602,10 +7736,14 @@ class OneByteString : public AllStatic {
                                     Snapshot::Kind kind,
                                     bool as_reference);
 
+  friend class Base64Converter;
   friend class Class;
   friend class String;
   friend class Symbols;
   friend class ExternalOneByteString;
+  friend class FlatMessageReader;
+  friend class FlatMessageWriter;
+  friend class RegExpEngine;
   friend class SnapshotReader;
   friend class StringHasher;
   friend class Utf8;
@@ -7728,6 +7866,9 @@ class TwoByteString : public AllStatic {
                                     bool as_reference);
 
   friend class Class;
+  friend class FlatMessageReader;
+  friend class FlatMessageWriter;
+  friend class RegExpEngine;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -7818,6 +7959,7 @@ class ExternalOneByteString : public AllStatic {
   }
 
   friend class Class;
+  friend class RegExpEngine;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -7905,6 +8047,7 @@ class ExternalTwoByteString : public AllStatic {
   }
 
   friend class Class;
+  friend class RegExpEngine;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -7953,7 +8096,7 @@ class Array : public Instance {
 
   // Returns `true` if we use card marking for arrays of length [array_length].
   static bool UseCardMarkingForAllocation(const intptr_t array_length) {
-    return Array::InstanceSize(array_length) > Heap::kNewAllocatableSize;
+    return Array::InstanceSize(array_length) > Heap::kCardMarkingArraySize;
   }
 
   intptr_t Length() const { return LengthOf(raw()); }
@@ -8019,7 +8162,7 @@ class Array : public Instance {
   static const intptr_t kBytesPerElement = kWordSize;
   static const intptr_t kMaxElements = kSmiMax / kBytesPerElement;
   static const intptr_t kMaxNewSpaceElements =
-      (Heap::kNewAllocatableSize - sizeof(RawArray)) / kBytesPerElement;
+      (Heap::kCardMarkingArraySize - sizeof(RawArray)) / kBytesPerElement;
 
   static intptr_t type_arguments_offset() {
     return OFFSET_OF(RawArray, type_arguments_);
@@ -8078,6 +8221,14 @@ class Array : public Instance {
                   intptr_t count,
                   bool with_type_argument) const;
 
+  // Copies 'count' elements of 'source' starting at 'source_start' into this
+  // array starting at 'start', in one pass of write barriers. The two arrays
+  // must be different.
+  void CopyFrom(intptr_t start,
+                const Array& source,
+                intptr_t source_start,
+                intptr_t count) const;
+
  protected:
   static RawArray* New(intptr_t class_id,
                        intptr_t len,
@@ -8105,7 +8256,7 @@ class Array : public Instance {
   // TODO(koda): Use this to fix Object::Clone's broken store buffer logic.
   void StoreArrayPointers(RawObject* const* to,
                           RawObject* const* from,
-                          intptr_t count) {
+                          intptr_t count) const {
     ASSERT(Contains(reinterpret_cast<uword>(to)));
     if (raw()->IsNewObject()) {
       memmove(const_cast<RawObject**>(to), from, count * kWordSize);
@@ -9035,6 +9186,52 @@ class Capability : public Instance {
   friend class Class;
 };
 
+// The malloc'ed bytes of a TransferableTypedData. The bytes are owned by the
+// object until they are moved to another isolate by sending the object, or
+// into an ExternalTypedData by materializing it, after which the peer is
+// empty. The peer is deleted when its object is collected.
+class TransferableTypedDataPeer {
+ public:
+  TransferableTypedDataPeer(uint8_t* data, intptr_t length)
+      : data_(data), length_(length), handle_(nullptr) {}
+  ~TransferableTypedDataPeer() { free(data_); }
+
+  uint8_t* data() const { return data_; }
+  intptr_t length() const { return length_; }
+  FinalizablePersistentHandle* handle() const { return handle_; }
+  void set_handle(FinalizablePersistentHandle* handle) { handle_ = handle; }
+
+  // Gives up the ownership of the bytes, which no longer count as external
+  // memory of this isolate.
+  void ClearData(Isolate* isolate);
+
+ private:
+  uint8_t* data_;
+  intptr_t length_;
+  FinalizablePersistentHandle* handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransferableTypedDataPeer);
+};
+
+class TransferableTypedData : public Instance {
+ public:
+  TransferableTypedDataPeer* peer() const { return raw_ptr()->peer_; }
+
+  static intptr_t InstanceSize() {
+    return RoundedAllocationSize(sizeof(RawTransferableTypedData));
+  }
+
+  // Takes the ownership of [data], which must have been allocated with
+  // malloc.
+  static RawTransferableTypedData* New(uint8_t* data,
+                                       intptr_t length,
+                                       Heap::Space space = Heap::kNew);
+
+ private:
+  FINAL_HEAP_OBJECT_IMPLEMENTATION(TransferableTypedData, Instance);
+  friend class Class;
+};
+
 class ReceivePort : public Instance {
  public:
   RawSendPort* send_port() const { return raw_ptr()->send_port_; }
@@ -9085,6 +9282,11 @@ class StackTrace : public Instance {
 
   intptr_t Length() const;
 
+  // Whether only the return addresses of the frames were collected, see
+  // StackTraceUtils::CollectLazyStackTrace. The Code objects of the frames
+  // are looked up on the first access of a frame.
+  bool IsLazy() const { return raw_ptr()->code_array_ == Array::null(); }
+
   RawStackTrace* async_link() const { return raw_ptr()->async_link_; }
   void set_async_link(const StackTrace& async_link) const;
   void set_expand_inlined(bool value) const;
@@ -9095,6 +9297,17 @@ class StackTrace : public Instance {
 
   RawArray* pc_offset_array() const { return raw_ptr()->pc_offset_array_; }
   RawSmi* PcOffsetAtFrame(intptr_t frame_index) const;
+
+  // Used by the profiler, which reads stack traces without handles.
+  static RawStackTrace* AsyncLinkOf(const RawStackTrace* stack_trace) {
+    return stack_trace->ptr()->async_link_;
+  }
+  static RawArray* CodeArrayOf(const RawStackTrace* stack_trace) {
+    return stack_trace->ptr()->code_array_;
+  }
+  static RawArray* PcOffsetArrayOf(const RawStackTrace* stack_trace) {
+    return stack_trace->ptr()->pc_offset_array_;
+  }
   void SetPcOffsetAtFrame(intptr_t frame_index, const Smi& pc_offset) const;
 
   static intptr_t InstanceSize() {
@@ -9109,7 +9322,15 @@ class StackTrace : public Instance {
                             const StackTrace& async_link,
                             Heap::Space space = Heap::kNew);
 
+  // Creates a lazy stack trace from the offsets of the return addresses of
+  // its frames from the start of the isolate's instructions.
+  static RawStackTrace* NewLazy(const Array& return_address_offsets,
+                                Heap::Space space = Heap::kNew);
+
  private:
+  // Looks up the Code objects of the frames of a lazy stack trace.
+  void Materialize() const;
+
   static const char* ToDartCString(const StackTrace& stack_trace_in);
   static const char* ToDwarfCString(const StackTrace& stack_trace_in);
 
@@ -9163,6 +9384,7 @@ class RegExp : public Instance {
   bool is_multi_line() const { return (flags() & kMultiLine); }
 
   intptr_t num_registers() const { return raw_ptr()->num_registers_; }
+  intptr_t execution_count() const { return raw_ptr()->execution_count_; }
 
   RawString* pattern() const { return raw_ptr()->pattern_; }
   RawSmi* num_bracket_expressions() const {
@@ -9218,6 +9440,14 @@ class RegExp : public Instance {
     return *FunctionAddr(cid, sticky);
   }
 
+  // Whether the matcher functions used in JIT mode have been created. Until
+  // then the one and two byte fields may hold bytecode, but the external
+  // string fields are never shared.
+  bool has_functions() const {
+    return function(kExternalOneByteStringCid, /*sticky=*/false) !=
+           Function::null();
+  }
+
   void set_pattern(const String& pattern) const;
   void set_function(intptr_t cid, bool sticky, const Function& value) const;
   void set_bytecode(bool is_one_byte,
@@ -9234,6 +9464,9 @@ class RegExp : public Instance {
   void set_num_registers(intptr_t value) const {
     StoreNonPointer(&raw_ptr()->num_registers_, value);
   }
+  void set_execution_count(intptr_t value) const {
+    StoreNonPointer(&raw_ptr()->execution_count_, value);
+  }
 
   const char* Flags() const;
 
@@ -9502,7 +9735,8 @@ void MegamorphicCache::SetEntry(const Array& array,
                                 const Smi& class_id,
                                 const Object& target) {
   ASSERT(target.IsFunction() || target.IsSmi());
-  array.SetAt((index * kEntryLength) + kClassIdIndex, class_id);
+  // The class id is released after the target, so that a reader which finds
+  // the class id also finds its target.
 #if defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_precompiled_mode && FLAG_use_bare_instructions) {
     if (target.IsFunction()) {
@@ -9510,17 +9744,24 @@ void MegamorphicCache::SetEntry(const Array& array,
       const auto& entry_point = Smi::Handle(
           Smi::FromAlignedAddress(Code::EntryPoint(function.CurrentCode())));
       array.SetAt((index * kEntryLength) + kTargetFunctionIndex, entry_point);
+      array.SetAtRelease((index * kEntryLength) + kClassIdIndex, class_id);
       return;
     }
   }
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
   array.SetAt((index * kEntryLength) + kTargetFunctionIndex, target);
+  array.SetAtRelease((index * kEntryLength) + kClassIdIndex, class_id);
 }
 
 RawObject* MegamorphicCache::GetClassId(const Array& array, intptr_t index) {
   return array.At((index * kEntryLength) + kClassIdIndex);
 }
 
+RawObject* MegamorphicCache::GetClassIdAcquire(const Array& array,
+                                               intptr_t index) {
+  return array.AtAcquire((index * kEntryLength) + kClassIdIndex);
+}
+
 RawObject* MegamorphicCache::GetTargetFunction(const Array& array,
                                                intptr_t index) {
   return array.At((index * kEntryLength) + kTargetFunctionIndex);
@@ -6,6 +6,7 @@
 
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
+#include "vm/datastream.h"
 #include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
@@ -490,7 +491,34 @@ intptr_t ObjectGraph::InboundReferences(Object* obj, const Array& references) {
   return visitor.length();
 }
 
-static void WritePtr(RawObject* raw, WriteStream* stream) {
+// The snapshot encoding, written either into a buffer or through a
+// streaming callback.
+class GraphWriter {
+ public:
+  virtual ~GraphWriter() {}
+  virtual void WriteUnsigned(intptr_t value) = 0;
+};
+
+class BufferedGraphWriter : public GraphWriter {
+ public:
+  explicit BufferedGraphWriter(WriteStream* stream) : stream_(stream) {}
+  virtual void WriteUnsigned(intptr_t value) { stream_->WriteUnsigned(value); }
+
+ private:
+  WriteStream* stream_;
+};
+
+class StreamingGraphWriter : public GraphWriter {
+ public:
+  explicit StreamingGraphWriter(StreamingWriteStream* stream)
+      : stream_(stream) {}
+  virtual void WriteUnsigned(intptr_t value) { stream_->WriteUnsigned(value); }
+
+ private:
+  StreamingWriteStream* stream_;
+};
+
+static void WritePtr(RawObject* raw, GraphWriter* stream) {
   ASSERT(raw->IsHeapObject());
   ASSERT(raw->IsOldObject());
   uword addr = RawObject::ToAddr(raw);
@@ -504,7 +532,7 @@ static void WritePtr(RawObject* raw, WriteStream* stream) {
 class WritePointerVisitor : public ObjectPointerVisitor {
  public:
   WritePointerVisitor(Isolate* isolate,
-                      WriteStream* stream,
+                      GraphWriter* stream,
                       bool only_instances)
       : ObjectPointerVisitor(isolate),
         stream_(stream),
@@ -530,7 +558,7 @@ class WritePointerVisitor : public ObjectPointerVisitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
+  GraphWriter* stream_;
   bool only_instances_;
   intptr_t count_;
 };
@@ -538,17 +566,35 @@ class WritePointerVisitor : public ObjectPointerVisitor {
 static void WriteHeader(RawObject* raw,
                         intptr_t size,
                         intptr_t cid,
-                        WriteStream* stream) {
+                        GraphWriter* stream) {
   WritePtr(raw, stream);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
   stream->WriteUnsigned(size);
   stream->WriteUnsigned(cid);
 }
 
+// Writes 'obj' if it belongs in a snapshot of 'roots'. Returns whether it
+// was written.
+static bool WriteNode(const Object& obj,
+                      ObjectGraph::SnapshotRoots roots,
+                      WritePointerVisitor* ptr_writer,
+                      GraphWriter* stream) {
+  if ((roots == ObjectGraph::kVM) || obj.IsField() || obj.IsInstance() ||
+      obj.IsContext()) {
+    // Each object is a header + a zero-terminated list of its neighbors.
+    RawObject* raw_obj = obj.raw();
+    WriteHeader(raw_obj, raw_obj->HeapSize(), obj.GetClassId(), stream);
+    raw_obj->VisitPointers(ptr_writer);
+    stream->WriteUnsigned(0);
+    return true;
+  }
+  return false;
+}
+
 class WriteGraphVisitor : public ObjectGraph::Visitor {
  public:
   WriteGraphVisitor(Isolate* isolate,
-                    WriteStream* stream,
+                    GraphWriter* stream,
                     ObjectGraph::SnapshotRoots roots)
       : stream_(stream),
         ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
@@ -561,12 +607,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
     REUSABLE_OBJECT_HANDLESCOPE(thread);
     Object& obj = thread->ObjectHandle();
     obj = raw_obj;
-    if ((roots_ == ObjectGraph::kVM) || obj.IsField() || obj.IsInstance() ||
-        obj.IsContext()) {
-      // Each object is a header + a zero-terminated list of its neighbors.
-      WriteHeader(raw_obj, raw_obj->HeapSize(), obj.GetClassId(), stream_);
-      raw_obj->VisitPointers(&ptr_writer_);
-      stream_->WriteUnsigned(0);
+    if (WriteNode(obj, roots_, &ptr_writer_, stream_)) {
       ++count_;
     }
     return kProceed;
@@ -575,7 +616,42 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
+  GraphWriter* stream_;
+  WritePointerVisitor ptr_writer_;
+  ObjectGraph::SnapshotRoots roots_;
+  intptr_t count_;
+};
+
+// Writes the objects of old space in address order rather than in traversal
+// order. Nothing is recorded per object, so memory use does not grow with the
+// heap.
+class WriteHeapObjectVisitor : public ObjectVisitor {
+ public:
+  WriteHeapObjectVisitor(Isolate* isolate,
+                         GraphWriter* stream,
+                         ObjectGraph::SnapshotRoots roots)
+      : stream_(stream),
+        ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
+        roots_(roots),
+        count_(0) {}
+
+  virtual void VisitObject(RawObject* raw_obj) {
+    if (raw_obj->IsFreeListElement() || raw_obj->IsForwardingCorpse()) {
+      return;
+    }
+    Thread* thread = Thread::Current();
+    REUSABLE_OBJECT_HANDLESCOPE(thread);
+    Object& obj = thread->ObjectHandle();
+    obj = raw_obj;
+    if (WriteNode(obj, roots_, &ptr_writer_, stream_)) {
+      ++count_;
+    }
+  }
+
+  intptr_t count() const { return count_; }
+
+ private:
+  GraphWriter* stream_;
   WritePointerVisitor ptr_writer_;
   ObjectGraph::SnapshotRoots roots_;
   intptr_t count_;
@@ -583,7 +659,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
 
 class WriteGraphExternalSizesVisitor : public HandleVisitor {
  public:
-  WriteGraphExternalSizesVisitor(Thread* thread, WriteStream* stream)
+  WriteGraphExternalSizesVisitor(Thread* thread, GraphWriter* stream)
       : HandleVisitor(thread), stream_(stream) {}
 
   void VisitHandle(uword addr) {
@@ -598,19 +674,10 @@ class WriteGraphExternalSizesVisitor : public HandleVisitor {
   }
 
  private:
-  WriteStream* stream_;
+  GraphWriter* stream_;
 };
 
-intptr_t ObjectGraph::Serialize(WriteStream* stream,
-                                SnapshotRoots roots,
-                                bool collect_garbage) {
-  if (collect_garbage) {
-    isolate()->heap()->CollectAllGarbage();
-  }
-  // Current encoding assumes objects do not move, so promote everything to old.
-  isolate()->heap()->new_space()->Evacuate();
-  HeapIterationScope iteration_scope(Thread::Current(), true);
-
+intptr_t ObjectGraph::WriteRoots(GraphWriter* stream, SnapshotRoots roots) {
   RawObject* kRootAddress = reinterpret_cast<RawObject*>(kHeapObjectTag);
   const intptr_t kRootCid = kIllegalCid;
   RawObject* kStackAddress =
@@ -628,41 +695,77 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
     isolate()->VisitObjectPointers(&ptr_writer,
                                    ValidationPolicy::kDontValidateFrames);
     stream->WriteUnsigned(0);
-  } else {
-    {
-      // Write root "object".
-      WriteHeader(kRootAddress, 0, kRootCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, false);
-      IterateUserFields(&ptr_writer);
-      WritePtr(kStackAddress, stream);
-      stream->WriteUnsigned(0);
-    }
+    return 1;  // root
+  }
 
-    {
-      // Write stack "object".
-      WriteHeader(kStackAddress, 0, kStackCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, true);
-      isolate()->VisitStackPointers(&ptr_writer,
-                                    ValidationPolicy::kDontValidateFrames);
-      stream->WriteUnsigned(0);
-    }
+  {
+    // Write root "object".
+    WriteHeader(kRootAddress, 0, kRootCid, stream);
+    WritePointerVisitor ptr_writer(isolate(), stream, false);
+    IterateUserFields(&ptr_writer);
+    WritePtr(kStackAddress, stream);
+    stream->WriteUnsigned(0);
   }
 
-  WriteGraphVisitor visitor(isolate(), stream, roots);
-  IterateObjects(&visitor);
-  stream->WriteUnsigned(0);
+  {
+    // Write stack "object".
+    WriteHeader(kStackAddress, 0, kStackCid, stream);
+    WritePointerVisitor ptr_writer(isolate(), stream, true);
+    isolate()->VisitStackPointers(&ptr_writer,
+                                  ValidationPolicy::kDontValidateFrames);
+    stream->WriteUnsigned(0);
+  }
+  return 2;  // root and stack
+}
 
+void ObjectGraph::WriteExternalSizes(GraphWriter* stream) {
   WriteGraphExternalSizesVisitor external_visitor(Thread::Current(), stream);
   isolate()->VisitWeakPersistentHandles(&external_visitor);
   stream->WriteUnsigned(0);
+}
 
-  intptr_t object_count = visitor.count();
-  if (roots == kVM) {
-    object_count += 1;  // root
-  } else {
-    object_count += 2;  // root and stack
+intptr_t ObjectGraph::Serialize(WriteStream* stream,
+                                SnapshotRoots roots,
+                                bool collect_garbage) {
+  if (collect_garbage) {
+    isolate()->heap()->CollectAllGarbage();
+  }
+  // Current encoding assumes objects do not move, so promote everything to old.
+  isolate()->heap()->new_space()->Evacuate();
+  HeapIterationScope iteration_scope(Thread::Current(), true);
+
+  BufferedGraphWriter writer(stream);
+  intptr_t object_count = WriteRoots(&writer, roots);
+
+  WriteGraphVisitor visitor(isolate(), &writer, roots);
+  IterateObjects(&visitor);
+  writer.WriteUnsigned(0);
+
+  WriteExternalSizes(&writer);
+
+  return object_count + visitor.count();
+}
+
+intptr_t ObjectGraph::StreamSerialize(StreamingWriteStream* stream,
+                                      SnapshotRoots roots,
+                                      bool collect_garbage) {
+  if (collect_garbage) {
+    isolate()->heap()->CollectAllGarbage();
   }
-  return object_count;
+  // Current encoding assumes objects do not move, so promote everything to old.
+  isolate()->heap()->new_space()->Evacuate();
+  HeapIterationScope iteration_scope(Thread::Current(), true);
+
+  StreamingGraphWriter writer(stream);
+  intptr_t object_count = WriteRoots(&writer, roots);
+
+  WriteHeapObjectVisitor visitor(isolate(), &writer, roots);
+  iteration_scope.IterateOldObjects(&visitor);
+  writer.WriteUnsigned(0);
+
+  WriteExternalSizes(&writer);
+
+  return object_count + visitor.count();
 }
 
 }  // namespace dart
@@ -11,9 +11,11 @@
 namespace dart {
 
 class Array;
+class GraphWriter;
 class Isolate;
 class Object;
 class RawObject;
+class StreamingWriteStream;
 class WriteStream;
 
 // Utility to traverse the object graph in an ordered fashion.
@@ -109,7 +111,21 @@ class ObjectGraph : public ThreadStackResource {
                      SnapshotRoots roots,
                      bool collect_garbage);
 
+  // Like 'Serialize', but walks the heap page by page and writes through
+  // 'stream' as it goes instead of traversing the graph. Memory use is
+  // bounded by the stream's buffer, independent of the heap size. Nodes are
+  // written in address order and include all objects in the heap, reachable
+  // or not, so 'collect_garbage' should usually be true.
+  intptr_t StreamSerialize(StreamingWriteStream* stream,
+                           SnapshotRoots roots,
+                           bool collect_garbage);
+
  private:
+  // Writes the stream header and the root pseudo-objects. Returns the number
+  // of nodes written.
+  intptr_t WriteRoots(GraphWriter* stream, SnapshotRoots roots);
+  void WriteExternalSizes(GraphWriter* stream);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectGraph);
 };
 
@@ -4,6 +4,7 @@
 
 #include "vm/object_graph.h"
 #include "platform/assert.h"
+#include "vm/datastream.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -138,4 +139,62 @@ ISOLATE_UNIT_TEST_CASE(ObjectGraph) {
   }
 }
 
+static uint8_t* malloc_allocator(uint8_t* ptr,
+                                 intptr_t old_size,
+                                 intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
+}
+
+struct StreamedSnapshot {
+  intptr_t chunks;
+  intptr_t bytes;
+  uint8_t first_byte;
+};
+
+static void CollectSnapshotChunk(void* callback_data,
+                                 const uint8_t* buffer,
+                                 intptr_t size) {
+  StreamedSnapshot* snapshot =
+      reinterpret_cast<StreamedSnapshot*>(callback_data);
+  if (size == 0) {
+    return;
+  }
+  if (snapshot->bytes == 0) {
+    snapshot->first_byte = buffer[0];
+  }
+  snapshot->chunks++;
+  snapshot->bytes += size;
+}
+
+ISOLATE_UNIT_TEST_CASE(StreamingHeapSnapshot) {
+  const Array& a = Array::Handle(Array::New(100, Heap::kOld));
+  for (intptr_t i = 0; i < a.Length(); i++) {
+    a.SetAt(i, Array::Handle(Array::New(1, Heap::kNew)));
+  }
+
+  uint8_t* buffer = NULL;
+  WriteStream buffered(&buffer, &malloc_allocator, 1 * KB);
+  intptr_t buffered_count;
+  {
+    ObjectGraph graph(thread);
+    buffered_count = graph.Serialize(&buffered, ObjectGraph::kVM, true);
+  }
+
+  StreamedSnapshot snapshot = {0, 0, 0};
+  intptr_t streamed_count;
+  {
+    // A small buffer forces the snapshot out in many chunks.
+    StreamingWriteStream streaming(4 * KB, &CollectSnapshotChunk, &snapshot);
+    ObjectGraph graph(thread);
+    streamed_count = graph.StreamSerialize(&streaming, ObjectGraph::kVM, true);
+  }
+
+  // The heap walk also sees objects that are not reachable anymore.
+  EXPECT_LE(buffered_count, streamed_count);
+  EXPECT_LT(1, snapshot.chunks);
+  EXPECT_LT(0, snapshot.bytes);
+  EXPECT_EQ(buffer[0], snapshot.first_byte);
+  free(buffer);
+}
+
 }  // namespace dart
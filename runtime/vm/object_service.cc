@@ -210,8 +210,13 @@ void TypeArguments::PrintJSONImpl(JSONStream* stream, bool ref) const {
     Array& prior_instantiations = Array::Handle(instantiations());
     ASSERT(prior_instantiations.Length() > 0);  // Always at least a sentinel.
     TypeArguments& type_args = TypeArguments::Handle();
-    intptr_t i = 0;
-    while (prior_instantiations.At(i) != Smi::New(StubCode::kNoInstantiator)) {
+    const intptr_t num_slots =
+        prior_instantiations.Length() - kInstantiationsNumEntriesFromEnd;
+    for (intptr_t i = 0; i < num_slots;
+         i += StubCode::kInstantiationSizeInWords) {
+      if (prior_instantiations.At(i) == Smi::New(StubCode::kNoInstantiator)) {
+        continue;
+      }
       JSONObject instantiation(&jsarr);
       type_args ^= prior_instantiations.At(i);
       instantiation.AddProperty("instantiatorTypeArguments", type_args, true);
@@ -219,7 +224,6 @@ void TypeArguments::PrintJSONImpl(JSONStream* stream, bool ref) const {
       instantiation.AddProperty("functionTypeArguments", type_args, true);
       type_args ^= prior_instantiations.At(i + 2);
       instantiation.AddProperty("instantiated", type_args, true);
-      i += StubCode::kInstantiationSizeInWords;
     }
   }
 }
@@ -1447,6 +1451,10 @@ void Capability::PrintJSONImpl(JSONStream* stream, bool ref) const {
   Instance::PrintJSONImpl(stream, ref);
 }
 
+void TransferableTypedData::PrintJSONImpl(JSONStream* stream, bool ref) const {
+  Instance::PrintJSONImpl(stream, ref);
+}
+
 void ReceivePort::PrintJSONImpl(JSONStream* stream, bool ref) const {
   Instance::PrintJSONImpl(stream, ref);
 }
@@ -1490,7 +1498,7 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !is_ignore_case());
   jsobj.AddProperty("isMultiLine", is_multi_line());
 
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp && has_functions()) {
     Function& func = Function::Handle();
     func = function(kOneByteStringCid, /*sticky=*/false);
     jsobj.AddProperty("_oneByteFunction", func);
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_OBJECT_STORE_H_
 #define RUNTIME_VM_OBJECT_STORE_H_
 
+#include "platform/atomic.h"
 #include "vm/object.h"
 
 namespace dart {
@@ -31,7 +32,10 @@ class ObjectPointerVisitor;
   M(TypedData, typed_data)                                                     \
   M(VMService, _vmservice)
 
-#define OBJECT_STORE_FIELD_LIST(R_, RW)                                        \
+// Fields declared with ARW_AR are read with acquire and written with release
+// semantics, so that threads that do not hold the lock serializing the
+// writers may read them.
+#define OBJECT_STORE_FIELD_LIST(R_, RW, ARW_AR)                                \
   RW(Class, object_class)                                                      \
   RW(Type, object_type)                                                        \
   RW(Class, null_class)                                                        \
@@ -83,8 +87,8 @@ class ObjectPointerVisitor;
   RW(Class, error_class)                                                       \
   RW(Class, weak_property_class)                                               \
   RW(Array, symbol_table)                                                      \
-  RW(Array, canonical_types)                                                   \
-  RW(Array, canonical_type_arguments)                                          \
+  ARW_AR(Array, canonical_types)                                               \
+  ARW_AR(Array, canonical_type_arguments)                                      \
   RW(Library, async_library)                                                   \
   RW(Library, builtin_library)                                                 \
   RW(Library, core_library)                                                    \
@@ -140,7 +144,10 @@ class ObjectPointerVisitor;
   R_(Function, megamorphic_miss_function)                                      \
   RW(Array, code_order_table)                                                  \
   RW(Array, obfuscation_map)                                                   \
+  RW(Array, type_feedback_table)                                               \
+  RW(Array, coverage_counters)                                                 \
   RW(GrowableObjectArray, changed_in_last_reload)                              \
+  RW(GrowableObjectArray, ffi_callbacks)                                       \
   RW(Class, ffi_pointer_class)                                                 \
   RW(Class, ffi_native_type_class)                                             \
 // Please remember the last entry must be referred in the 'to' function below.
@@ -164,9 +171,18 @@ class ObjectStore {
 #define DECLARE_GETTER_AND_SETTER(Type, name)                                  \
   DECLARE_GETTER(Type, name)                                                   \
   void set_##name(const Type& value) { name##_ = value.raw(); }
-  OBJECT_STORE_FIELD_LIST(DECLARE_GETTER, DECLARE_GETTER_AND_SETTER)
+#define DECLARE_ACQREL_GETTER_AND_SETTER(Type, name)                           \
+  Raw##Type* name() const { return AtomicOperations::LoadAcquire(&name##_); }  \
+  void set_##name(const Type& value) {                                         \
+    AtomicOperations::StoreRelease(&name##_, value.raw());                     \
+  }                                                                            \
+  static intptr_t name##_offset() { return OFFSET_OF(ObjectStore, name##_); }
+  OBJECT_STORE_FIELD_LIST(DECLARE_GETTER,
+                          DECLARE_GETTER_AND_SETTER,
+                          DECLARE_ACQREL_GETTER_AND_SETTER)
 #undef DECLARE_GETTER
 #undef DECLARE_GETTER_AND_SETTER
+#undef DECLARE_ACQREL_GETTER_AND_SETTER
 
   RawLibrary* bootstrap_library(BootstrapLibraryId index) {
     switch (index) {
@@ -232,6 +248,7 @@ class ObjectStore {
   RawObject** from() { return reinterpret_cast<RawObject**>(&object_class_); }
 #define DECLARE_OBJECT_STORE_FIELD(type, name) Raw##type* name##_;
   OBJECT_STORE_FIELD_LIST(DECLARE_OBJECT_STORE_FIELD,
+                          DECLARE_OBJECT_STORE_FIELD,
                           DECLARE_OBJECT_STORE_FIELD)
 #undef DECLARE_OBJECT_STORE_FIELD
   RawObject** to() {
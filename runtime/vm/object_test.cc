@@ -336,6 +336,60 @@ ISOLATE_UNIT_TEST_CASE(StringCompareTo) {
   EXPECT(monkey_face.CompareTo(abce) > 0);
 }
 
+ISOLATE_UNIT_TEST_CASE(StringChangeCase) {
+  const String& lower =
+      String::Handle(String::New("content-type: text/html; charset=utf-8"));
+  const String& mixed =
+      String::Handle(String::New("Content-Type: text/HTML; charset=UTF-8"));
+  const String& upper =
+      String::Handle(String::New("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8"));
+  EXPECT(lower.IsOneByteString());
+  // Strings which are already in the right case are not copied.
+  EXPECT(String::ToLowerCase(lower) == lower.raw());
+  EXPECT(String::ToUpperCase(upper) == upper.raw());
+  EXPECT(String::Handle(String::ToLowerCase(mixed)).Equals(lower));
+  EXPECT(String::Handle(String::ToUpperCase(mixed)).Equals(upper));
+
+  // Latin-1 letters, including 'ÿ' whose upper case is not Latin-1.
+  const String& latin1 =
+      String::Handle(String::New("Caf\xc3\xa9 \xc3\x84rger ABCDEFGH"));
+  EXPECT(latin1.IsOneByteString());
+  EXPECT_STREQ("caf\xc3\xa9 \xc3\xa4rger abcdefgh",
+               String::Handle(String::ToLowerCase(latin1)).ToCString());
+  EXPECT_STREQ("CAF\xc3\x89 \xc3\x84RGER ABCDEFGH",
+               String::Handle(String::ToUpperCase(latin1)).ToCString());
+  const String& y_diaeresis =
+      String::Handle(String::New("abcdefgh\xc3\xbf"));
+  const String& y_diaeresis_upper =
+      String::Handle(String::ToUpperCase(y_diaeresis));
+  EXPECT(y_diaeresis_upper.IsTwoByteString());
+  EXPECT_STREQ("ABCDEFGH\xc5\xb8", y_diaeresis_upper.ToCString());
+}
+
+ISOLATE_UNIT_TEST_CASE(StringEqualsIgnoreAsciiCase) {
+  const String& lower = String::Handle(String::New("transfer-encoding"));
+  const String& mixed = String::Handle(String::New("Transfer-Encoding"));
+  const String& other = String::Handle(String::New("Transfer-Encodinf"));
+  EXPECT(String::EqualsIgnoreAsciiCase(lower, mixed));
+  EXPECT(String::EqualsIgnoreAsciiCase(mixed, lower));
+  EXPECT(!String::EqualsIgnoreAsciiCase(lower, other));
+  EXPECT(!String::EqualsIgnoreAsciiCase(lower, Symbols::Empty()));
+  // '@' and '`' differ from each other in the same bit as letters do.
+  EXPECT(!String::EqualsIgnoreAsciiCase(String::Handle(String::New("@")),
+                                        String::Handle(String::New("`"))));
+  // Non-ASCII letters only compare equal to themselves.
+  const String& a_umlaut = String::Handle(String::New("\xc3\xa4" "bcdefghi"));
+  const String& a_umlaut_upper =
+      String::Handle(String::New("\xc3\x84" "BCDEFGHI"));
+  EXPECT(!String::EqualsIgnoreAsciiCase(a_umlaut, a_umlaut_upper));
+  EXPECT(String::EqualsIgnoreAsciiCase(
+      a_umlaut, String::Handle(String::New("\xc3\xa4" "BCDEFGHI"))));
+  const String& two_byte = String::Handle(String::New("\xe2\x82\xacUro"));
+  EXPECT(two_byte.IsTwoByteString());
+  EXPECT(String::EqualsIgnoreAsciiCase(
+      two_byte, String::Handle(String::New("\xe2\x82\xacuRO"))));
+}
+
 ISOLATE_UNIT_TEST_CASE(StringEncodeIRI) {
   const char* kInput =
       "file:///usr/local/johnmccutchan/workspace/dart-repo/dart/test.dart";
@@ -1755,6 +1809,24 @@ ISOLATE_UNIT_TEST_CASE(SymbolUnicode) {
   EXPECT_EQ(cat2.raw(), cat.raw());
 }
 
+ISOLATE_UNIT_TEST_CASE(SymbolReserveCapacity) {
+  const String& before = String::Handle(Symbols::New(thread, "Vorher"));
+  const intptr_t kNumSymbols = 1000;
+  Symbols::ReserveCapacity(thread, kNumSymbols);
+  ObjectStore* object_store = thread->isolate()->object_store();
+  const Array& table = Array::Handle(object_store->symbol_table());
+  char name[32];
+  for (intptr_t i = 0; i < kNumSymbols; i++) {
+    Utils::SNPrint(name, sizeof(name), "ReservedSymbol%" Pd, i);
+    EXPECT(String::Handle(Symbols::New(thread, name)).IsSymbol());
+  }
+  // The table was not grown while adding the reserved symbols.
+  EXPECT_EQ(table.raw(), object_store->symbol_table());
+  EXPECT_EQ(before.raw(), Symbols::New(thread, "Vorher"));
+  EXPECT_EQ(Symbols::New(thread, "ReservedSymbol7"),
+            Symbols::New(thread, "ReservedSymbol7"));
+}
+
 ISOLATE_UNIT_TEST_CASE(Bool) {
   EXPECT(Bool::True().value());
   EXPECT(!Bool::False().value());
@@ -2563,6 +2635,43 @@ ISOLATE_UNIT_TEST_CASE_WITH_EXPECTATION(CodeExecutability, "Crash") {
       stack_trace_collection_enabled);
 }
 
+// Dual mapped code is written through its writable view without changing
+// protections, and the executable view sees the writes.
+ISOLATE_UNIT_TEST_CASE(DualMappedCodeStaysWritable) {
+  if (!FLAG_write_protect_code || !FLAG_dual_map_code) {
+    return;
+  }
+  extern void GenerateIncrement(Assembler * assembler);
+  ObjectPoolBuilder object_pool_builder;
+  Assembler _assembler_(&object_pool_builder);
+  GenerateIncrement(&_assembler_);
+  const Function& function = Function::Handle(CreateFunction("Test_Code"));
+  Code& code = Code::Handle(Code::FinalizeCodeAndNotify(
+      function, nullptr, &_assembler_, Code::PoolAttachment::kAttachPool));
+  function.AttachCode(code);
+  Instructions& instructions = Instructions::Handle(code.instructions());
+  uint8_t* executable = reinterpret_cast<uint8_t*>(instructions.PayloadStart());
+  Instructions& writable = Instructions::Handle(
+      Instructions::RawCast(HeapPage::ToWritable(instructions.raw())));
+  EXPECT(writable.raw() != instructions.raw());
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(writable.PayloadStart());
+
+  const uint8_t original = bytes[0];
+  bytes[0] = original ^ 0xff;
+  EXPECT_EQ(original ^ 0xff, executable[0]);
+  bytes[0] = original;
+  EXPECT_EQ(original, executable[0]);
+
+  // Neither view changes protections when all code is made writable.
+  thread->isolate()->heap()->WriteProtectCode(false);
+  thread->isolate()->heap()->WriteProtectCode(true);
+  bytes[0] = original;
+
+  const Object& result =
+      Object::Handle(DartEntry::InvokeFunction(function, Array::empty_array()));
+  EXPECT_EQ(1, Smi::Cast(result).Value());
+}
+
 // Test for Embedded String object in the instructions.
 ISOLATE_UNIT_TEST_CASE(EmbedStringInCode) {
   extern void GenerateEmbedStringInCode(Assembler * assembler, const char* str);
@@ -2919,6 +3028,42 @@ ISOLATE_UNIT_TEST_CASE(ICData) {
   EXPECT_EQ(target1.raw(), scall_icdata.GetTargetAt(0));
 }
 
+ISOLATE_UNIT_TEST_CASE(MegamorphicCache) {
+  const String& target_name = String::Handle(Symbols::New(thread, "Thun"));
+  const intptr_t kTypeArgsLen = 0;
+  const intptr_t kNumArgs = 1;
+  const Array& args_descriptor = Array::Handle(
+      ArgumentsDescriptor::New(kTypeArgsLen, kNumArgs, Object::null_array()));
+  const MegamorphicCache& cache = MegamorphicCache::Handle(
+      MegamorphicCache::New(target_name, args_descriptor));
+  const Function& target = Function::Handle(GetDummyTarget("Thun"));
+
+  // Grow the cache several times.
+  const intptr_t kFirstCid = 100;
+  const intptr_t kNumCids = 40;
+  Smi& class_id = Smi::Handle();
+  for (intptr_t cid = kFirstCid; cid < kFirstCid + kNumCids; cid++) {
+    class_id = Smi::New(cid);
+    EXPECT(cache.Lookup(class_id) == Object::null());
+    cache.EnsureCapacity();
+    cache.Insert(class_id, target);
+  }
+  EXPECT_EQ(kNumCids, cache.filled_entry_count());
+  EXPECT(cache.mask() + 1 >= 2 * kNumCids);
+
+  // Consecutive class ids are all found by their first probe.
+  const Array& buckets = Array::Handle(cache.buckets());
+  for (intptr_t cid = kFirstCid; cid < kFirstCid + kNumCids; cid++) {
+    class_id = Smi::New(cid);
+    EXPECT_EQ(target.raw(), cache.Lookup(class_id));
+    EXPECT_EQ(1, MegamorphicCache::ProbeCount(buckets, cache.mask(), cid));
+  }
+  class_id = Smi::New(kFirstCid + kNumCids);
+  EXPECT(cache.Lookup(class_id) == Object::null());
+  EXPECT_EQ(-1, MegamorphicCache::ProbeCount(buckets, cache.mask(),
+                                             kFirstCid + kNumCids));
+}
+
 ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   String& class_name = String::Handle(Symbols::New(thread, "EmptyClass"));
   Script& script = Script::Handle();
@@ -4,6 +4,10 @@
 
 #include "vm/os_thread.h"
 
+#if defined(HOST_OS_LINUX)
+#include <unistd.h>  // NOLINT
+#endif
+
 #include "platform/atomic.h"
 #include "vm/lockers.h"
 #include "vm/log.h"
@@ -42,6 +46,14 @@ OSThread::OSThread()
       stack_limit_(0),
       stack_headroom_(0),
       thread_(NULL) {
+#if defined(HOST_OS_LINUX) && !defined(PRODUCT)
+  hardware_event_fd_ = -1;
+  hardware_event_count_ = 0;
+#endif
+#if !defined(PRODUCT)
+  native_allocation_sample_countdown_ = 0;
+  native_allocation_sample_random_ = 0;
+#endif
   // Try to get accurate stack bounds from pthreads, etc.
   if (!GetCurrentStackBounds(&stack_limit_, &stack_base_)) {
     // Fall back to a guess based on the stack pointer.
@@ -77,6 +89,12 @@ OSThread::~OSThread() {
     FATAL("Thread exited without calling Dart_ExitIsolate");
   }
   RemoveThreadFromList(this);
+#if defined(HOST_OS_LINUX) && !defined(PRODUCT)
+  // The thread interrupter only opens events for threads in the list.
+  if (hardware_event_fd_ >= 0) {
+    close(hardware_event_fd_);
+  }
+#endif
   delete log_;
   log_ = NULL;
 #if defined(SUPPORT_TIMELINE)
@@ -193,6 +193,15 @@ class OSThread : public BaseThread {
     return ThreadInlineImpl::GetThreadLocal(key);
   }
   static ThreadId GetCurrentThreadId();
+  // Restricts the calling thread to the CPUs whose bits are set in |mask|
+  // (bit i stands for CPU i). A mask of zero lets the thread run on any CPU
+  // the process may use again. Returns false if the platform does not
+  // support thread affinity or rejects the mask.
+  static bool SetCurrentThreadAffinity(uint64_t mask);
+  // Lets the OS run the calling thread only when no other thread is waiting
+  // for a CPU, or restores the default time-sharing policy. Returns false if
+  // the platform does not support it.
+  static bool SetCurrentThreadBatchScheduling(bool batch);
   static void SetThreadLocal(ThreadLocalKey key, uword value);
   static intptr_t GetMaxStackSize();
   static void Join(ThreadJoinId id);
@@ -272,6 +281,23 @@ class OSThread : public BaseThread {
   uword stack_headroom_;
   ThreadState* thread_;
 
+#if defined(HOST_OS_LINUX) && !defined(PRODUCT)
+  // The perf event which interrupts this thread with
+  // --profiler_hardware_event, -1 if none is open yet.
+  int hardware_event_fd_;
+  // The value of the perf event counter at the last sample.
+  uint64_t hardware_event_count_;
+#endif
+
+#if !defined(PRODUCT)
+  // Bytes this thread allocates before its next sampled native allocation,
+  // see --profiler_native_memory_sampling_interval.
+  intptr_t native_allocation_sample_countdown_;
+  // State of the random number generator drawing the countdowns, 0 until
+  // the first draw.
+  uint32_t native_allocation_sample_random_;
+#endif
+
   // thread_list_lock_ cannot have a static lifetime because the order in which
   // destructors run is undefined. At the moment this lock cannot be deleted
   // either since otherwise, if a thread only begins to run after we have
@@ -287,6 +313,8 @@ class OSThread : public BaseThread {
 
   friend class Isolate;  // to access set_thread(Thread*).
   friend class OSThreadIterator;
+  friend class MallocHooksState;
+  friend class ThreadInterrupterLinux;
   friend class ThreadInterrupterWin;
   friend class ThreadInterrupterFuchsia;
 };
@@ -173,6 +173,14 @@ ThreadId OSThread::GetCurrentThreadId() {
   return info.koid;
 }
 
+bool OSThread::SetCurrentThreadAffinity(uint64_t mask) {
+  return false;
+}
+
+bool OSThread::SetCurrentThreadBatchScheduling(bool batch) {
+  return false;
+}
+
 #ifdef SUPPORT_TIMELINE
 ThreadId OSThread::GetCurrentThreadTraceId() {
   return pthread_self();
@@ -9,9 +9,11 @@
 #include "vm/os_thread.h"
 
 #include <errno.h>         // NOLINT
+#include <sched.h>         // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/syscall.h>   // NOLINT
 #include <sys/time.h>      // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "platform/address_sanitizer.h"
 #include "platform/assert.h"
@@ -192,6 +194,33 @@ ThreadId OSThread::GetCurrentThreadId() {
   return pthread_self();
 }
 
+bool OSThread::SetCurrentThreadAffinity(uint64_t mask) {
+  cpu_set_t cpus;
+  if (mask == 0) {
+    // Threads start with the affinity of the process.
+    if (sched_getaffinity(getpid(), sizeof(cpus), &cpus) != 0) {
+      return false;
+    }
+  } else {
+    CPU_ZERO(&cpus);
+    for (intptr_t cpu = 0; cpu < 64; cpu++) {
+      if ((mask & (static_cast<uint64_t>(1) << cpu)) != 0) {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+  }
+  // A pid of zero stands for the calling thread.
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
+bool OSThread::SetCurrentThreadBatchScheduling(bool batch) {
+  // Unprivileged threads may switch between these two policies freely,
+  // unlike nice values which they cannot lower again.
+  struct sched_param param;
+  param.sched_priority = 0;
+  return sched_setscheduler(0, batch ? SCHED_IDLE : SCHED_OTHER, &param) == 0;
+}
+
 #ifdef SUPPORT_TIMELINE
 ThreadId OSThread::GetCurrentThreadTraceId() {
   return syscall(__NR_gettid);
@@ -168,6 +168,14 @@ ThreadId OSThread::GetCurrentThreadId() {
   return pthread_self();
 }
 
+bool OSThread::SetCurrentThreadAffinity(uint64_t mask) {
+  return false;
+}
+
+bool OSThread::SetCurrentThreadBatchScheduling(bool batch) {
+  return false;
+}
+
 #ifdef SUPPORT_TIMELINE
 ThreadId OSThread::GetCurrentThreadTraceId() {
   return ThreadIdFromIntPtr(pthread_mach_thread_np(pthread_self()));
@@ -114,6 +114,14 @@ ThreadId OSThread::GetCurrentThreadId() {
   return ::GetCurrentThreadId();
 }
 
+bool OSThread::SetCurrentThreadAffinity(uint64_t mask) {
+  return false;
+}
+
+bool OSThread::SetCurrentThreadBatchScheduling(bool batch) {
+  return false;
+}
+
 #ifdef SUPPORT_TIMELINE
 ThreadId OSThread::GetCurrentThreadTraceId() {
   return ::GetCurrentThreadId();
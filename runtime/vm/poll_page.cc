@@ -0,0 +1,108 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/poll_page.h"
+
+#include "vm/flags.h"
+#include "vm/signal_handler.h"
+#include "vm/thread.h"
+#include "vm/virtual_memory.h"
+
+#if defined(HOST_ARCH_X64) && defined(TARGET_ARCH_X64) &&                      \
+    (defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)) &&                    \
+    !defined(DART_PRECOMPILED_RUNTIME)
+#define SUPPORTS_POLL_PAGE
+#endif
+
+namespace dart {
+
+uword PollPage::disarmed_page_ = 0;
+uword PollPage::armed_page_ = 0;
+
+#if defined(SUPPORTS_POLL_PAGE)
+
+static struct sigaction previous_segv_action;
+
+// Returns the slow path of the poll faulting at pc, or 0 if pc is not a poll.
+static uword PollSlowPath(uword pc) {
+  const uint8_t* code = reinterpret_cast<const uint8_t*>(pc);
+  // movq TMP, [TMP]
+  if ((code[0] != 0x4D) || (code[1] != 0x8B) || (code[2] != 0x1B)) {
+    return 0;
+  }
+  // nopl [RAX + disp32]
+  code += PollPage::kPollLoadSize;
+  if ((code[0] != 0x0F) || (code[1] != 0x1F) || (code[2] != 0x80)) {
+    return 0;
+  }
+  int32_t offset;
+  memmove(&offset, code + 3, sizeof(offset));
+  return pc + PollPage::kPollLoadSize + PollPage::kPollNopSize + offset;
+}
+
+static void PollPageFaultHandler(int signal, siginfo_t* info, void* context) {
+  const uword address = reinterpret_cast<uword>(info->si_addr);
+  ucontext_t* ucontext = reinterpret_cast<ucontext_t*>(context);
+  mcontext_t& mcontext = ucontext->uc_mcontext;
+  if ((address - PollPage::armed_page()) <
+      static_cast<uword>(VirtualMemory::PageSize())) {
+    Thread* thread = Thread::Current();
+    if ((thread != NULL) &&
+        (thread->execution_state() == Thread::kThreadInGenerated)) {
+      const uword slow_path =
+          PollSlowPath(SignalHandler::GetProgramCounter(mcontext));
+      if (slow_path != 0) {
+        mcontext.gregs[REG_RIP] = slow_path;
+        return;
+      }
+    }
+  }
+
+  // Not a poll: leave the fault to whoever handled it before us.
+  if ((previous_segv_action.sa_flags & SA_SIGINFO) != 0) {
+    previous_segv_action.sa_sigaction(signal, info, context);
+    return;
+  }
+  // Reinstall the previous disposition and let the faulting instruction run
+  // again under it.
+  int r = sigaction(SIGSEGV, &previous_segv_action, NULL);
+  ASSERT(r == 0);
+}
+
+void PollPage::Init() {
+  if (!FLAG_use_poll_page || FLAG_precompiled_mode || enabled()) {
+    return;
+  }
+  const intptr_t page_size = VirtualMemory::PageSize();
+  // Never freed: threads of a shutting down VM may still poll.
+  VirtualMemory* pages =
+      VirtualMemory::Allocate(2 * page_size, false, "dart-poll-pages");
+  if (pages == NULL) {
+    OUT_OF_MEMORY();
+  }
+  VirtualMemory::Protect(pages->address(), page_size,
+                         VirtualMemory::kReadOnly);
+  VirtualMemory::Protect(reinterpret_cast<void*>(pages->start() + page_size),
+                         page_size, VirtualMemory::kNoAccess);
+  armed_page_ = pages->start() + page_size;
+
+  struct sigaction act;
+  memset(&act, 0, sizeof(act));
+  act.sa_sigaction = PollPageFaultHandler;
+  sigemptyset(&act.sa_mask);
+  act.sa_flags = SA_RESTART | SA_SIGINFO;
+  int r = sigaction(SIGSEGV, &act, &previous_segv_action);
+  ASSERT(r == 0);
+
+  // Published last: code is only compiled to poll once this is set.
+  disarmed_page_ = pages->start();
+}
+
+#else
+
+void PollPage::Init() {}
+
+#endif  // defined(SUPPORTS_POLL_PAGE)
+
+}  // namespace dart
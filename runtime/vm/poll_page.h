@@ -0,0 +1,55 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_POLL_PAGE_H_
+#define RUNTIME_VM_POLL_PAGE_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Lets optimized code check for interrupts at loop back-edges with a single
+// load instead of comparing the stack pointer against the stack limit.
+//
+// Every thread points to one of two process-wide pages: a readable disarmed
+// page or an inaccessible armed page. Scheduling an interrupt on a thread
+// swaps its pointer to the armed page, so its next poll faults. Swapping a
+// pointer instead of changing page protections keeps the pages shared and
+// costs no system call per interrupt.
+//
+// A poll is the load followed by a nop whose 32-bit displacement holds the
+// distance to the stack overflow slow path of the check:
+//
+//   movq TMP, [THR + poll_page_offset]
+//   movq TMP, [TMP]
+//   nopl [RAX + slow_path - next_pc]
+//
+// The fault handler resumes the thread at that slow path, which handles the
+// interrupt as it does for a stack limit check and jumps back after the nop.
+//
+// Only supported in JIT mode on X64 Linux and Android.
+class PollPage : public AllStatic {
+ public:
+  // Allocates the pages and installs the fault handler if --use_poll_page is
+  // given and the platform supports it. Does nothing when called again.
+  static void Init();
+
+  static bool enabled() { return disarmed_page_ != 0; }
+
+  static uword disarmed_page() { return disarmed_page_; }
+  static uword armed_page() { return armed_page_; }
+
+  // Encoding of a poll after the load of the poll page into TMP.
+  static const intptr_t kPollLoadSize = 3;
+  static const intptr_t kPollNopSize = 7;
+
+ private:
+  static uword disarmed_page_;
+  static uword armed_page_;
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_POLL_PAGE_H_
@@ -56,9 +56,22 @@ DEFINE_FLAG(bool,
             profile_vm_allocation,
             false,
             "Collect native stack traces when tracing Dart allocations.");
+DEFINE_FLAG(int,
+            isolate_sample_buffer_size,
+            0,
+            "Number of samples held for each isolate in a buffer of its own. "
+            "0 keeps the samples of all isolates in one shared buffer.");
+DEFINE_FLAG(bool,
+            profile_async_stacks,
+            false,
+            "Attribute samples taken in async functions to their logical "
+            "async call path. Requires --causal_async_stacks.");
 
 #ifndef PRODUCT
 
+DECLARE_FLAG(bool, continuous_profile);
+DECLARE_FLAG(int, continuous_profile_sample_period);
+
 bool Profiler::initialized_ = false;
 SampleBuffer* Profiler::sample_buffer_ = NULL;
 AllocationSampleBuffer* Profiler::allocation_sample_buffer_ = NULL;
@@ -68,6 +81,11 @@ void Profiler::Init() {
   // Place some sane restrictions on user controlled flags.
   SetSampleDepth(FLAG_max_profile_depth);
   Sample::Init();
+  if (FLAG_continuous_profile) {
+    // An always-on profile samples at a lower rate to keep the overhead low.
+    FLAG_profiler = true;
+    FLAG_profile_period = FLAG_continuous_profile_sample_period;
+  }
   if (!FLAG_profiler) {
     return;
   }
@@ -82,6 +100,22 @@ void Profiler::Init() {
   initialized_ = true;
 }
 
+SampleBuffer* Profiler::sample_buffer(Isolate* isolate) {
+  if ((isolate != NULL) && (isolate->sample_buffer() != NULL)) {
+    return isolate->sample_buffer();
+  }
+  return sample_buffer_;
+}
+
+SampleBuffer* Profiler::NewIsolateSampleBuffer() {
+  // Isolates created before the profiler was enabled at runtime keep using
+  // the shared buffer.
+  if (!initialized_ || (FLAG_isolate_sample_buffer_size <= 0)) {
+    return NULL;
+  }
+  return new SampleBuffer(FLAG_isolate_sample_buffer_size);
+}
+
 void Profiler::InitAllocationSampleBuffer() {
   ASSERT(Profiler::allocation_sample_buffer_ == NULL);
   if (FLAG_profiler_native_memory) {
@@ -545,6 +579,7 @@ class ProfilerDartStackWalker : public ProfilerStackWalker {
                             sample_buffer,
                             skip_count),
         thread_(thread),
+        head_sample_(sample),
         pc_(reinterpret_cast<uword*>(pc)),
         fp_(reinterpret_cast<uword*>(fp)) {}
 
@@ -657,9 +692,56 @@ class ProfilerDartStackWalker : public ProfilerStackWalker {
       // frame.
       RELEASE_ASSERT(IsInterpretedFrame(fp_) == in_interpreted_frame);
     }
+
+    if (FLAG_profile_async_stacks && thread_->IsMutatorThread()) {
+      AppendAsyncFrames();
+    }
   }
 
  private:
+  // Appends the causal async stack trace of the running async function,
+  // starting with its asynchronous gap marker. The synchronous frames which
+  // only lead back to the event loop are dropped when the sample is
+  // processed, see ProcessedSample::SpliceAsyncFrames.
+  void AppendAsyncFrames() {
+    RawStackTrace* stack_trace = thread_->async_stack_trace();
+    if (stack_trace == StackTrace::null()) {
+      return;
+    }
+    head_sample_->set_has_async_frames(true);
+    while (stack_trace != StackTrace::null()) {
+      RawArray* code_array = StackTrace::CodeArrayOf(stack_trace);
+      RawArray* pc_offset_array = StackTrace::PcOffsetArrayOf(stack_trace);
+      if ((code_array == Array::null()) || (pc_offset_array == Array::null())) {
+        return;
+      }
+      const intptr_t length = Utils::Minimum(Array::LengthOf(code_array),
+                                             Array::LengthOf(pc_offset_array));
+      RawObject** codes = Array::DataOf(code_array);
+      RawObject** pc_offsets = Array::DataOf(pc_offset_array);
+      for (intptr_t i = 0; i < length; i++) {
+        RawObject* code = codes[i];
+        RawObject* pc_offset = pc_offsets[i];
+        if (!pc_offset->IsSmi()) {
+          continue;
+        }
+        const intptr_t cid = code->GetClassIdMayBeSmi();
+        uword start;
+        if (cid == kCodeCid) {
+          start = Code::PayloadStartOf(static_cast<RawCode*>(code));
+        } else if (cid == kBytecodeCid) {
+          start = Bytecode::PayloadStartOf(static_cast<RawBytecode*>(code));
+        } else {
+          continue;
+        }
+        if (!Append(start + Smi::Value(static_cast<RawSmi*>(pc_offset)), 0)) {
+          return;  // Sample is full.
+        }
+      }
+      stack_trace = StackTrace::AsyncLinkOf(stack_trace);
+    }
+  }
+
   uword* CallerPC(bool interp) const {
     ASSERT(fp_ != NULL);
     uword* caller_pc_ptr =
@@ -703,6 +785,7 @@ class ProfilerDartStackWalker : public ProfilerStackWalker {
   }
 
   Thread* const thread_;
+  Sample* const head_sample_;
   uword* pc_;
   uword* fp_;
 };
@@ -1171,7 +1254,7 @@ void Profiler::SampleAllocation(Thread* thread, intptr_t cid) {
 
   const bool exited_dart_code = thread->HasExitedDartCode();
 
-  SampleBuffer* sample_buffer = Profiler::sample_buffer();
+  SampleBuffer* sample_buffer = Profiler::sample_buffer(isolate);
   if (sample_buffer == NULL) {
     // Profiler not initialized.
     return;
@@ -1277,7 +1360,7 @@ void Profiler::SampleThreadSingleFrame(Thread* thread, uintptr_t pc) {
   ASSERT(os_thread != NULL);
   Isolate* isolate = thread->isolate();
 
-  SampleBuffer* sample_buffer = Profiler::sample_buffer();
+  SampleBuffer* sample_buffer = Profiler::sample_buffer(isolate);
   if (sample_buffer == NULL) {
     // Profiler not initialized.
     return;
@@ -1386,7 +1469,7 @@ void Profiler::SampleThread(Thread* thread,
 
   // At this point we have a valid stack boundary for this isolate and
   // know that our initial stack and frame pointers are within the boundary.
-  SampleBuffer* sample_buffer = Profiler::sample_buffer();
+  SampleBuffer* sample_buffer = Profiler::sample_buffer(isolate);
   if (sample_buffer == NULL) {
     // Profiler not initialized.
     return;
@@ -1394,6 +1477,7 @@ void Profiler::SampleThread(Thread* thread,
 
   // Setup sample.
   Sample* sample = SetupSample(thread, sample_buffer, os_thread->trace_id());
+  sample->set_hardware_events(state.hardware_events);
   // Increment counter for vm tag.
   VMTagCounters* counters = isolate->vm_tag_counters();
   ASSERT(counters != NULL);
@@ -1591,6 +1675,7 @@ ProcessedSample* SampleBuffer::BuildProcessedSample(
   // Copy state bits from sample.
   processed_sample->set_native_allocation_size_bytes(
       sample->native_allocation_size_bytes());
+  processed_sample->set_hardware_events(sample->hardware_events());
   processed_sample->set_timestamp(sample->timestamp());
   processed_sample->set_tid(sample->tid());
   processed_sample->set_vm_tag(sample->vm_tag());
@@ -1620,6 +1705,10 @@ ProcessedSample* SampleBuffer::BuildProcessedSample(
                                   sample->GetStackBuffer());
   }
 
+  if (sample->has_async_frames()) {
+    processed_sample->SpliceAsyncFrames(clt);
+  }
+
   processed_sample->set_truncated(truncated);
   return processed_sample;
 }
@@ -1649,6 +1738,7 @@ ProcessedSample::ProcessedSample()
       user_tag_(0),
       allocation_cid_(-1),
       truncated_(false),
+      hardware_events_(0),
       timeline_code_trie_(nullptr),
       timeline_function_trie_(nullptr) {}
 
@@ -1667,6 +1757,62 @@ void ProcessedSample::FixupCaller(const CodeLookupTable& clt,
   CheckForMissingDartFrame(clt, cd, pc_marker, stack_buffer);
 }
 
+void ProcessedSample::SpliceAsyncFrames(const CodeLookupTable& clt) {
+  const uword gap_marker = StubCode::AsynchronousGapMarker().PayloadStart();
+  intptr_t gap_index = -1;
+  for (intptr_t i = 0; i < length(); i++) {
+    if (At(i) == gap_marker) {
+      gap_index = i;
+      break;
+    }
+  }
+  if (gap_index == -1) {
+    return;
+  }
+  // The frame after the gap marker belongs to the async function which is
+  // running. Its synchronous part ends with the closure that holds the body.
+  const Function& async_function = Function::Handle(
+      (gap_index + 1 < length()) ? FunctionAt(clt, gap_index + 1)
+                                 : Function::null());
+  intptr_t body_index = -1;
+  if (!async_function.IsNull()) {
+    for (intptr_t i = 0; i < gap_index; i++) {
+      const Function& function = Function::Handle(FunctionAt(clt, i));
+      if (!function.IsNull() &&
+          (function.parent_function() == async_function.raw())) {
+        body_index = i;
+        break;
+      }
+    }
+  }
+  if (body_index == -1) {
+    // The async stack trace doesn't match the synchronous frames, leave it
+    // out rather than misattribute the sample.
+    pcs_.TruncateTo(gap_index);
+    return;
+  }
+  // Replace the frames between the body and the gap marker with the async
+  // frames.
+  intptr_t cursor = body_index + 1;
+  for (intptr_t i = gap_index; i < length(); i++) {
+    pcs_[cursor++] = pcs_[i];
+  }
+  pcs_.TruncateTo(cursor);
+}
+
+RawFunction* ProcessedSample::FunctionAt(const CodeLookupTable& clt,
+                                              intptr_t index) const {
+  const CodeDescriptor* cd = clt.FindCode(At(index));
+  if (cd == NULL) {
+    return Function::null();
+  }
+  const Object& owner = Object::Handle(cd->code().owner());
+  if (!owner.IsFunction()) {
+    return Function::null();
+  }
+  return Function::Cast(owner).raw();
+}
+
 void ProcessedSample::CheckForMissingDartFrame(const CodeLookupTable& clt,
                                                const CodeDescriptor* cd,
                                                uword pc_marker,
@@ -64,7 +64,14 @@ class Profiler : public AllStatic {
   // profile period is changed via the service protocol.
   static void UpdateSamplePeriod();
 
+  // The buffer shared by all isolates which don't have their own one.
   static SampleBuffer* sample_buffer() { return sample_buffer_; }
+  // The buffer which holds the samples of [isolate]. NULL if the profiler is
+  // not initialized.
+  static SampleBuffer* sample_buffer(Isolate* isolate);
+  // Returns a buffer for the samples of a new isolate, or NULL if its samples
+  // go to the shared buffer.
+  static SampleBuffer* NewIsolateSampleBuffer();
   static AllocationSampleBuffer* allocation_sample_buffer() {
     return allocation_sample_buffer_;
   }
@@ -199,6 +206,7 @@ class Sample {
     state_ = 0;
     native_allocation_address_ = 0;
     native_allocation_size_bytes_ = 0;
+    hardware_events_ = 0;
     continuation_index_ = -1;
     next_free_ = NULL;
     uword* pcs = GetPCArray();
@@ -298,6 +306,14 @@ class Sample {
     return ClassAllocationSampleBit::decode(state_);
   }
 
+  // Whether the async stack trace of the running async function follows the
+  // synchronous frames, see --profile_async_stacks.
+  bool has_async_frames() const { return AsyncFramesBit::decode(state_); }
+
+  void set_has_async_frames(bool has_async_frames) {
+    state_ = AsyncFramesBit::update(has_async_frames, state_);
+  }
+
   void set_is_allocation_sample(bool allocation_sample) {
     state_ = ClassAllocationSampleBit::update(allocation_sample, state_);
   }
@@ -316,6 +332,11 @@ class Sample {
     native_allocation_size_bytes_ = size;
   }
 
+  // The hardware events counted on the thread since its previous sample,
+  // see --profiler_hardware_event. 0 for timer based samples.
+  uint64_t hardware_events() const { return hardware_events_; }
+  void set_hardware_events(uint64_t events) { hardware_events_ = events; }
+
   Sample* next_free() const { return next_free_; }
   void set_next_free(Sample* next_free) { next_free_ = next_free; }
 
@@ -364,6 +385,9 @@ class Sample {
 
   static intptr_t instance_size() { return instance_size_; }
 
+  // The number of pcs in a single sample.
+  static intptr_t pcs_length() { return pcs_length_; }
+
   uword* GetPCArray() const;
 
   static const int kStackBufferSizeInWords = 2;
@@ -382,7 +406,8 @@ class Sample {
     kClassAllocationSampleBit = 6,
     kContinuationSampleBit = 7,
     kThreadTaskBit = 8,  // 5 bits.
-    kNextFreeBit = 13,
+    kAsyncFramesBit = 13,
+    kNextFreeBit = 14,
   };
   class HeadSampleBit : public BitField<uword, bool, kHeadSampleBit, 1> {};
   class LeafFrameIsDart : public BitField<uword, bool, kLeafFrameIsDartBit, 1> {
@@ -399,6 +424,7 @@ class Sample {
       : public BitField<uword, bool, kContinuationSampleBit, 1> {};
   class ThreadTaskBit
       : public BitField<uword, Thread::TaskKind, kThreadTaskBit, 5> {};
+  class AsyncFramesBit : public BitField<uword, bool, kAsyncFramesBit, 1> {};
 
   int64_t timestamp_;
   ThreadId tid_;
@@ -412,6 +438,7 @@ class Sample {
   uword state_;
   uword native_allocation_address_;
   uintptr_t native_allocation_size_bytes_;
+  uint64_t hardware_events_;
   intptr_t continuation_index_;
   Sample* next_free_;
 
@@ -630,10 +657,13 @@ class SampleBuffer {
 
   ProcessedSampleBuffer* BuildProcessedSampleBuffer(SampleFilter* filter);
 
+  // Returns the next sample in the chain of samples starting at a head
+  // sample, or NULL at the end of the chain.
+  Sample* Next(Sample* sample);
+
  protected:
   ProcessedSample* BuildProcessedSample(Sample* sample,
                                         const CodeLookupTable& clt);
-  Sample* Next(Sample* sample);
 
   VirtualMemory* memory_;
   Sample* samples_;
@@ -716,6 +746,9 @@ class ProcessedSample : public ZoneAllocated {
     native_allocation_size_bytes_ = allocation_size;
   }
 
+  uint64_t hardware_events() const { return hardware_events_; }
+  void set_hardware_events(uint64_t events) { hardware_events_ = events; }
+
   // Was the stack trace truncated?
   bool truncated() const { return truncated_; }
   void set_truncated(bool truncated) { truncated_ = truncated; }
@@ -750,6 +783,9 @@ class ProcessedSample : public ZoneAllocated {
                                 uword pc_marker,
                                 uword* stack_buffer);
 
+  void SpliceAsyncFrames(const CodeLookupTable& clt);
+  RawFunction* FunctionAt(const CodeLookupTable& clt, intptr_t index) const;
+
   ZoneGrowableArray<uword> pcs_;
   int64_t timestamp_;
   ThreadId tid_;
@@ -760,6 +796,7 @@ class ProcessedSample : public ZoneAllocated {
   bool first_frame_executing_;
   uword native_allocation_address_;
   uintptr_t native_allocation_size_bytes_;
+  uint64_t hardware_events_;
   ProfileTrieNode* timeline_code_trie_;
   ProfileTrieNode* timeline_function_trie_;
 
@@ -0,0 +1,224 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler_binary.h"
+
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/native_symbol.h"
+#include "vm/object.h"
+#include "vm/os_thread.h"
+#include "vm/profiler.h"
+#include "vm/protobuf_writer.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+#ifndef PRODUCT
+
+DECLARE_FLAG(int, profile_period);
+
+intptr_t CpuSampleCodeTable::EntryKeyValueTrait::Hashcode(Key key) {
+  return String::Hash(key, strlen(key));
+}
+
+bool CpuSampleCodeTable::EntryKeyValueTrait::IsKeyEqual(Pair kv, Key key) {
+  return strcmp(kv->name, key) == 0;
+}
+
+CpuSampleCodeTable::~CpuSampleCodeTable() {
+  for (intptr_t i = 0; i < entries_.length(); i++) {
+    free(entries_[i]->name);
+    delete entries_[i];
+  }
+}
+
+CpuSampleCodeTable* CpuSampleCodeTable::Get(Thread* thread) {
+  Isolate* isolate = thread->isolate();
+  if (isolate->cpu_sample_code_table() == nullptr) {
+    isolate->set_cpu_sample_code_table(new CpuSampleCodeTable());
+  }
+  return isolate->cpu_sample_code_table();
+}
+
+intptr_t CpuSampleCodeTable::IndexOf(const char* name, Kind kind) {
+  Entry* entry = indices_.LookupValue(name);
+  if (entry == nullptr) {
+    entry = new Entry();
+    entry->name = strdup(name);
+    entry->kind = kind;
+    entry->index = entries_.length();
+    entries_.Add(entry);
+    indices_.Insert(entry);
+  }
+  return entry->index;
+}
+
+// Collects the mutator samples newer than a given timestamp and encodes
+// them, symbolizing every distinct pc once.
+class CpuSampleEncoder : public SampleVisitor {
+ public:
+  // Field numbers of the messages described in profiler_binary.h.
+  enum {
+    kNewestSampleMicros = 1,
+    kCodeTableStart = 2,
+    kCode = 3,
+    kSample = 4,
+    kSamplePeriodMicros = 5,
+    kCodeName = 1,
+    kCodeKind = 2,
+    kSampleTimestampDelta = 1,
+    kSampleTid = 2,
+    kSampleFrame = 3,
+  };
+
+  CpuSampleEncoder(Thread* thread,
+                   SampleBuffer* buffer,
+                   CpuSampleCodeTable* table,
+                   int64_t since_micros)
+      : SampleVisitor(thread->isolate()->main_port()),
+        zone_(thread->zone()),
+        buffer_(buffer),
+        table_(table),
+        code_lookup_table_(new (zone_) CodeLookupTable(thread)),
+        since_micros_(since_micros),
+        samples_(zone_, 256) {}
+
+  virtual void VisitSample(Sample* sample) {
+    if ((sample->timestamp() <= since_micros_) ||
+        sample->is_allocation_sample() ||
+        (sample->thread_task() != Thread::kMutatorTask)) {
+      return;
+    }
+    samples_.Add(sample);
+  }
+
+  void Encode(intptr_t known_codes, ProtobufWriter* result) {
+    const intptr_t code_table_start =
+        Utils::Minimum(known_codes, table_->length());
+    samples_.Sort(CompareTimestamps);
+
+    ProtobufWriter encoded_samples;
+    int64_t previous_micros = since_micros_;
+    for (intptr_t i = 0; i < samples_.length(); i++) {
+      Sample* sample = samples_[i];
+      intptr_t length = 0;
+      for (Sample* current = sample;
+           (current != nullptr) && (length < kMaxFrames);
+           current = buffer_->Next(current)) {
+        for (intptr_t j = 0;
+             (j < Sample::pcs_length()) && (length < kMaxFrames); j++) {
+          const uword pc = current->At(j);
+          if (pc == 0) break;
+          frames_[length++] = IndexOf(pc);
+        }
+      }
+      ProtobufWriter encoded;
+      encoded.WriteInt(kSampleTimestampDelta,
+                       sample->timestamp() - previous_micros);
+      encoded.WriteInt(kSampleTid, OSThread::ThreadIdToIntPtr(sample->tid()));
+      encoded.WritePacked(kSampleFrame, frames_, length);
+      encoded_samples.WriteMessage(kSample, &encoded);
+      previous_micros = sample->timestamp();
+    }
+
+    result->WriteInt(kNewestSampleMicros, previous_micros);
+    result->WriteInt(kCodeTableStart, code_table_start);
+    for (intptr_t i = code_table_start; i < table_->length(); i++) {
+      const CpuSampleCodeTable::Entry* entry = table_->At(i);
+      ProtobufWriter code;
+      code.WriteString(kCodeName, entry->name);
+      code.WriteInt(kCodeKind, entry->kind);
+      result->WriteMessage(kCode, &code);
+    }
+    result->buffer()->AddRaw(
+        reinterpret_cast<const uint8_t*>(encoded_samples.buffer()->buf()),
+        encoded_samples.buffer()->length());
+    result->WriteInt(kSamplePeriodMicros, FLAG_profile_period);
+  }
+
+ private:
+  // --max_profile_depth is at most 255.
+  static const intptr_t kMaxFrames = 256;
+
+  static int CompareTimestamps(Sample* const* a, Sample* const* b) {
+    const int64_t timestamp_a = (*a)->timestamp();
+    const int64_t timestamp_b = (*b)->timestamp();
+    return (timestamp_a < timestamp_b) ? -1
+                                       : ((timestamp_a > timestamp_b) ? 1 : 0);
+  }
+
+  intptr_t IndexOf(uword pc) {
+    // The map returns 0 for pcs which were not looked up yet.
+    const intptr_t cached = pc_indices_.Lookup(static_cast<intptr_t>(pc));
+    if (cached != 0) {
+      return cached - 1;
+    }
+    intptr_t index;
+    const CodeDescriptor* descriptor = code_lookup_table_->FindCode(pc);
+    if (descriptor != nullptr) {
+      const AbstractCode code = descriptor->code();
+      const bool is_dart = Object::Handle(zone_, code.owner()).IsFunction();
+      index = table_->IndexOf(code.QualifiedName(),
+                              is_dart ? CpuSampleCodeTable::kDartCode
+                                      : CpuSampleCodeTable::kStubCode);
+    } else {
+      uintptr_t start = 0;
+      char* native_name = NativeSymbolResolver::LookupSymbolName(pc, &start);
+      if (native_name != nullptr) {
+        index = table_->IndexOf(native_name, CpuSampleCodeTable::kNativeCode);
+        NativeSymbolResolver::FreeSymbolName(native_name);
+      } else {
+        index = table_->IndexOf("[Unknown]", CpuSampleCodeTable::kUnknownCode);
+      }
+    }
+    pc_indices_.Insert(static_cast<intptr_t>(pc), index + 1);
+    return index;
+  }
+
+  Zone* zone_;
+  SampleBuffer* buffer_;
+  CpuSampleCodeTable* table_;
+  const CodeLookupTable* code_lookup_table_;
+  const int64_t since_micros_;
+  GrowableArray<Sample*> samples_;
+  IntMap<intptr_t> pc_indices_;
+  int64_t frames_[kMaxFrames];
+
+  DISALLOW_COPY_AND_ASSIGN(CpuSampleEncoder);
+};
+
+void CpuSampleCodeTable::PrintJSON(Thread* thread,
+                                   JSONStream* js,
+                                   int64_t since_micros,
+                                   intptr_t known_codes) {
+  SampleBuffer* buffer = Profiler::sample_buffer(thread->isolate());
+  if (buffer == nullptr) {
+    js->PrintError(kFeatureDisabled, NULL);
+    return;
+  }
+  CpuSampleCodeTable* table = Get(thread);
+
+  ProtobufWriter result;
+  {
+    // Disable thread interrupts while processing the buffer.
+    DisableThreadInterruptsScope dtis(thread);
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    CpuSampleEncoder encoder(thread, buffer, table, since_micros);
+    buffer->VisitSamples(&encoder);
+    encoder.Encode(known_codes, &result);
+  }
+
+  JSONObject obj(js);
+  obj.AddProperty("type", "_CpuSamplesBinary");
+  obj.AddPropertyBase64(
+      "bytes", reinterpret_cast<const uint8_t*>(result.buffer()->buf()),
+      result.buffer()->length());
+}
+
+#endif  // !PRODUCT
+
+}  // namespace dart
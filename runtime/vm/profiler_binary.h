@@ -0,0 +1,111 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROFILER_BINARY_H_
+#define RUNTIME_VM_PROFILER_BINARY_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class JSONStream;
+class Thread;
+
+#ifndef PRODUCT
+
+// The code table of the _getCpuSamplesBinary service RPC, which returns the
+// CPU samples of the mutator of an isolate taken since a given timestamp,
+// so a profiling agent can poll for new samples without rebuilding the
+// whole profile as with _getCpuProfile.
+//
+// The samples are a base64-encoded protocol buffer:
+//
+//   message CpuSamples {
+//     // Pass as sinceMicros to get the samples taken after this response.
+//     int64 newest_sample_micros = 1;
+//     // The code table index of the first entry of [code].
+//     int64 code_table_start = 2;
+//     repeated Code code = 3;
+//     repeated Sample sample = 4;
+//     int64 sample_period_micros = 5;
+//   }
+//
+//   message Code {
+//     string name = 1;
+//     Kind kind = 2;  // See CpuSampleCodeTable::Kind.
+//   }
+//
+//   message Sample {
+//     // Since the previous sample, or since sinceMicros for the first one.
+//     int64 timestamp_delta_micros = 1;
+//     int64 tid = 2;
+//     // Code table indices, innermost frame first.
+//     repeated int64 frame = 3 [packed = true];
+//   }
+//
+// The samples are ordered by timestamp. Symbolized code is identified by
+// name, so entries stay valid when code is moved or collected, and the
+// table of an isolate only grows. A client passes the number of entries it
+// already has as knownCodes and is only sent the new ones.
+class CpuSampleCodeTable {
+ public:
+  enum Kind {
+    kDartCode = 0,
+    kStubCode = 1,
+    kNativeCode = 2,
+    kUnknownCode = 3,
+  };
+
+  ~CpuSampleCodeTable();
+
+  static void PrintJSON(Thread* thread,
+                        JSONStream* js,
+                        int64_t since_micros,
+                        intptr_t known_codes);
+
+ private:
+  struct Entry {
+    char* name;
+    Kind kind;
+    intptr_t index;
+  };
+
+  class EntryKeyValueTrait {
+   public:
+    typedef const char* Key;
+    typedef Entry* Value;
+    typedef Entry* Pair;
+
+    static Key KeyOf(Pair kv) { return kv->name; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static intptr_t Hashcode(Key key);
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  CpuSampleCodeTable() {}
+
+  static CpuSampleCodeTable* Get(Thread* thread);
+
+  // Returns the index of the entry for [name], adding it if needed.
+  intptr_t IndexOf(const char* name, Kind kind);
+
+  intptr_t length() const { return entries_.length(); }
+  const Entry* At(intptr_t index) const { return entries_[index]; }
+
+  friend class CpuSampleEncoder;
+
+  MallocDirectChainedHashMap<EntryKeyValueTrait> indices_;
+  MallocGrowableArray<Entry*> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CpuSampleCodeTable);
+};
+
+#endif  // !PRODUCT
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROFILER_BINARY_H_
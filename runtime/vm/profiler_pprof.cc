@@ -0,0 +1,450 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler_pprof.h"
+
+#include "platform/text_buffer.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/native_symbol.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/profiler.h"
+#include "vm/protobuf_writer.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+#ifndef PRODUCT
+
+DEFINE_FLAG(bool,
+            continuous_profile,
+            false,
+            "Continuously aggregate the CPU samples of every isolate and "
+            "export them periodically as pprof profiles.");
+DEFINE_FLAG(int,
+            continuous_profile_period,
+            60,
+            "Seconds between two exports of the continuous profile.");
+DEFINE_FLAG(int,
+            continuous_profile_sample_period,
+            10000,
+            "Time between profiler samples in microseconds when "
+            "--continuous_profile is enabled.");
+DEFINE_FLAG(charp,
+            continuous_profile_file,
+            nullptr,
+            "Write continuous profiles to <prefix>-<isolate port>-<n>.pb.");
+DECLARE_FLAG(int, profile_period);
+
+// Samples are moved out of the sample buffer at least this often, which is
+// well before the buffer wraps around at the continuous sampling rate.
+static const int64_t kAggregateIntervalMicros = kMicrosecondsPerSecond;
+
+Dart_ContinuousProfileCallback ContinuousProfile::callback_ = nullptr;
+
+bool ContinuousProfile::StackKeyValueTrait::IsKeyEqual(Pair kv, Key key) {
+  if ((kv->hash != key->hash) || (kv->length != key->length)) {
+    return false;
+  }
+  return memcmp(kv->pcs, key->pcs, kv->length * sizeof(uword)) == 0;
+}
+
+ContinuousProfile::ContinuousProfile(int64_t now)
+    : last_sample_micros_(now),
+      last_aggregate_micros_(now),
+      start_micros_(now),
+      sample_count_(0),
+      exports_(0) {}
+
+ContinuousProfile::~ContinuousProfile() {
+  Clear();
+}
+
+void ContinuousProfile::Clear() {
+  auto it = stacks_.GetIterator();
+  for (Stack** stack = it.Next(); stack != nullptr; stack = it.Next()) {
+    free((*stack)->pcs);
+    delete *stack;
+  }
+  stacks_.Clear();
+  sample_count_ = 0;
+}
+
+ContinuousProfile* ContinuousProfile::Get(Thread* thread) {
+  if (!FLAG_continuous_profile ||
+      (Profiler::sample_buffer(thread->isolate()) == nullptr) ||
+      !thread->IsMutatorThread()) {
+    return nullptr;
+  }
+  Isolate* isolate = thread->isolate();
+  if (Isolate::IsVMInternalIsolate(isolate)) {
+    return nullptr;
+  }
+  if (isolate->continuous_profile() == nullptr) {
+    isolate->set_continuous_profile(
+        new ContinuousProfile(OS::GetCurrentMonotonicMicros()));
+  }
+  return isolate->continuous_profile();
+}
+
+void ContinuousProfile::Tick(Thread* thread) {
+  ContinuousProfile* profile = Get(thread);
+  if (profile == nullptr) return;
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  if ((now - profile->last_aggregate_micros_) < kAggregateIntervalMicros) {
+    return;
+  }
+  profile->Aggregate(thread);
+  profile->last_aggregate_micros_ = now;
+  const int64_t period_micros =
+      static_cast<int64_t>(FLAG_continuous_profile_period) *
+      kMicrosecondsPerSecond;
+  if ((now - profile->start_micros_) >= period_micros) {
+    profile->Export(thread, now);
+  }
+}
+
+void ContinuousProfile::Flush(Thread* thread) {
+  ContinuousProfile* profile = Get(thread);
+  if (profile == nullptr) return;
+  profile->Aggregate(thread);
+  profile->Export(thread, OS::GetCurrentMonotonicMicros());
+}
+
+// Collects the mutator samples of an isolate which are newer than a given
+// timestamp. The samples of the mutator are written while it is interrupted,
+// so when the mutator itself visits them they are all complete.
+class ContinuousProfileVisitor : public SampleVisitor {
+ public:
+  ContinuousProfileVisitor(Dart_Port port,
+                           SampleBuffer* buffer,
+                           ContinuousProfile* profile,
+                           int64_t after_micros)
+      : SampleVisitor(port),
+        buffer_(buffer),
+        profile_(profile),
+        after_micros_(after_micros),
+        newest_micros_(after_micros) {}
+
+  virtual void VisitSample(Sample* sample) {
+    if ((sample->timestamp() <= after_micros_) ||
+        sample->is_allocation_sample() ||
+        (sample->thread_task() != Thread::kMutatorTask)) {
+      return;
+    }
+    intptr_t length = 0;
+    for (Sample* current = sample;
+         (current != nullptr) && (length < kMaxFrames);
+         current = buffer_->Next(current)) {
+      for (intptr_t i = 0;
+           (i < Sample::pcs_length()) && (length < kMaxFrames); i++) {
+        const uword pc = current->At(i);
+        if (pc == 0) break;
+        pcs_[length++] = pc;
+      }
+    }
+    profile_->AddStack(pcs_, length);
+    newest_micros_ = Utils::Maximum(newest_micros_, sample->timestamp());
+  }
+
+  int64_t newest_micros() const { return newest_micros_; }
+
+ private:
+  // --max_profile_depth is at most 255.
+  static const intptr_t kMaxFrames = 256;
+
+  SampleBuffer* buffer_;
+  ContinuousProfile* profile_;
+  const int64_t after_micros_;
+  int64_t newest_micros_;
+  uword pcs_[kMaxFrames];
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfileVisitor);
+};
+
+void ContinuousProfile::Aggregate(Thread* thread) {
+  SampleBuffer* buffer = Profiler::sample_buffer(thread->isolate());
+  ContinuousProfileVisitor visitor(thread->isolate()->main_port(), buffer,
+                                   this, last_sample_micros_);
+  buffer->VisitSamples(&visitor);
+  last_sample_micros_ = visitor.newest_micros();
+}
+
+void ContinuousProfile::AddStack(const uword* pcs, intptr_t length) {
+  if (length == 0) return;
+  uint32_t hash = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    hash = CombineHashes(hash, static_cast<uint32_t>(pcs[i]));
+  }
+  Stack key = {const_cast<uword*>(pcs), length,
+               FinalizeHash(hash, kBitsPerInt32 - 1), 0};
+  Stack** existing = stacks_.Lookup(&key);
+  if (existing != nullptr) {
+    (*existing)->count++;
+  } else {
+    Stack* stack = new Stack(key);
+    stack->pcs = reinterpret_cast<uword*>(malloc(length * sizeof(uword)));
+    memmove(stack->pcs, pcs, length * sizeof(uword));
+    stack->count = 1;
+    stacks_.Insert(stack);
+  }
+  sample_count_++;
+}
+
+// Builds a pprof profile (see profile.proto in github.com/google/pprof),
+// symbolizing every distinct pc once.
+class PprofBuilder : public ValueObject {
+ public:
+  // Field numbers of profile.proto.
+  enum {
+    kProfileSampleType = 1,
+    kProfileSample = 2,
+    kProfileLocation = 4,
+    kProfileFunction = 5,
+    kProfileStringTable = 6,
+    kProfileTimeNanos = 9,
+    kProfileDurationNanos = 10,
+    kProfilePeriodType = 11,
+    kProfilePeriod = 12,
+    kValueTypeType = 1,
+    kValueTypeUnit = 2,
+    kSampleLocationId = 1,
+    kSampleValue = 2,
+    kLocationId = 1,
+    kLocationAddress = 3,
+    kLocationLine = 4,
+    kLineFunctionId = 1,
+    kFunctionId = 1,
+    kFunctionName = 2,
+    kFunctionSystemName = 3,
+    kFunctionFilename = 4,
+  };
+
+  PprofBuilder(Thread* thread, const CodeLookupTable& code_table)
+      : zone_(thread->zone()),
+        code_table_(code_table),
+        owner_(Object::Handle(zone_)),
+        script_(Script::Handle(zone_)),
+        url_(String::Handle(zone_)),
+        string_count_(0),
+        location_count_(0),
+        function_count_(0) {
+    // The first entry of the string table must be the empty string.
+    Intern("");
+  }
+
+  void AddValueType(intptr_t field, const char* type, const char* unit) {
+    ProtobufWriter value_type;
+    value_type.WriteInt(kValueTypeType, Intern(type));
+    value_type.WriteInt(kValueTypeUnit, Intern(unit));
+    profile_.WriteMessage(field, &value_type);
+  }
+
+  void AddSample(const uword* pcs, intptr_t length, int64_t count) {
+    int64_t* location_ids = zone_->Alloc<int64_t>(length);
+    for (intptr_t i = 0; i < length; i++) {
+      location_ids[i] = LocationId(pcs[i]);
+    }
+    const int64_t values[] = {count, count * FLAG_profile_period * 1000};
+    ProtobufWriter sample;
+    sample.WritePacked(kSampleLocationId, location_ids, length);
+    sample.WritePacked(kSampleValue, values, ARRAY_SIZE(values));
+    profile_.WriteMessage(kProfileSample, &sample);
+  }
+
+  void AddInt(intptr_t field, int64_t value) {
+    profile_.WriteInt(field, value);
+  }
+
+  // Appends the tables and returns the encoded profile.
+  TextBuffer* Finish() {
+    profile_.buffer()->AddRaw(
+        reinterpret_cast<const uint8_t*>(locations_.buffer()->buf()),
+        locations_.buffer()->length());
+    profile_.buffer()->AddRaw(
+        reinterpret_cast<const uint8_t*>(functions_.buffer()->buf()),
+        functions_.buffer()->length());
+    profile_.buffer()->AddRaw(
+        reinterpret_cast<const uint8_t*>(strings_.buffer()->buf()),
+        strings_.buffer()->length());
+    return profile_.buffer();
+  }
+
+ private:
+  struct StringIndex {
+    const char* string;
+    intptr_t index;
+  };
+
+  class StringIndexTrait {
+   public:
+    typedef const char* Key;
+    typedef intptr_t Value;
+    typedef StringIndex Pair;
+
+    static Key KeyOf(Pair kv) { return kv.string; }
+    static Value ValueOf(Pair kv) { return kv.index; }
+    static intptr_t Hashcode(Key key) {
+      return String::Hash(key, strlen(key));
+    }
+    static bool IsKeyEqual(Pair kv, Key key) {
+      return strcmp(kv.string, key) == 0;
+    }
+  };
+
+  intptr_t Intern(const char* string) {
+    StringIndex* existing = string_indices_.Lookup(string);
+    if (existing != nullptr) {
+      return existing->index;
+    }
+    StringIndex entry = {string, string_count_++};
+    string_indices_.Insert(entry);
+    strings_.WriteString(kProfileStringTable, string);
+    return entry.index;
+  }
+
+  intptr_t LocationId(uword pc) {
+    const intptr_t existing = location_ids_.Lookup(static_cast<intptr_t>(pc));
+    if (existing != 0) {
+      return existing;
+    }
+    const char* name = nullptr;
+    const char* system_name = nullptr;
+    const char* filename = "";
+    const CodeDescriptor* descriptor = code_table_.FindCode(pc);
+    if (descriptor != nullptr) {
+      const AbstractCode code = descriptor->code();
+      name = code.QualifiedName();
+      system_name = code.Name();
+      owner_ = code.owner();
+      if (owner_.IsFunction()) {
+        script_ = Function::Cast(owner_).script();
+        if (!script_.IsNull()) {
+          url_ = script_.url();
+          filename = url_.ToCString();
+        }
+      }
+    } else {
+      uintptr_t start = 0;
+      char* native_name = NativeSymbolResolver::LookupSymbolName(pc, &start);
+      if (native_name != nullptr) {
+        name = zone_->MakeCopyOfString(native_name);
+        NativeSymbolResolver::FreeSymbolName(native_name);
+      } else {
+        name = "[Unknown]";
+      }
+      system_name = name;
+    }
+
+    const intptr_t name_index = Intern(name);
+    intptr_t function_id = function_ids_.Lookup(name_index);
+    if (function_id == 0) {
+      function_id = ++function_count_;
+      function_ids_.Insert(name_index, function_id);
+      ProtobufWriter function;
+      function.WriteInt(kFunctionId, function_id);
+      function.WriteInt(kFunctionName, name_index);
+      function.WriteInt(kFunctionSystemName, Intern(system_name));
+      function.WriteInt(kFunctionFilename, Intern(filename));
+      functions_.WriteMessage(kProfileFunction, &function);
+    }
+
+    const intptr_t location_id = ++location_count_;
+    location_ids_.Insert(static_cast<intptr_t>(pc), location_id);
+    ProtobufWriter line;
+    line.WriteInt(kLineFunctionId, function_id);
+    ProtobufWriter location;
+    location.WriteInt(kLocationId, location_id);
+    location.WriteInt(kLocationAddress, pc);
+    location.WriteMessage(kLocationLine, &line);
+    locations_.WriteMessage(kProfileLocation, &location);
+    return location_id;
+  }
+
+  Zone* zone_;
+  const CodeLookupTable& code_table_;
+  Object& owner_;
+  Script& script_;
+  String& url_;
+
+  ProtobufWriter profile_;
+  ProtobufWriter locations_;
+  ProtobufWriter functions_;
+  ProtobufWriter strings_;
+
+  DirectChainedHashMap<StringIndexTrait> string_indices_;
+  IntMap<intptr_t> location_ids_;
+  // Keyed by the string index of the function name.
+  IntMap<intptr_t> function_ids_;
+  intptr_t string_count_;
+  intptr_t location_count_;
+  intptr_t function_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(PprofBuilder);
+};
+
+void ContinuousProfile::Export(Thread* thread, int64_t now) {
+  if (sample_count_ == 0) {
+    start_micros_ = now;
+    return;
+  }
+  Isolate* isolate = thread->isolate();
+  StackZone stack_zone(thread);
+  HandleScope handle_scope(thread);
+  Zone* zone = thread->zone();
+
+  CodeLookupTable* code_table = new (zone) CodeLookupTable(thread);
+  PprofBuilder builder(thread, *code_table);
+  builder.AddValueType(PprofBuilder::kProfileSampleType, "samples", "count");
+  builder.AddValueType(PprofBuilder::kProfileSampleType, "cpu", "nanoseconds");
+  auto it = stacks_.GetIterator();
+  for (Stack** stack = it.Next(); stack != nullptr; stack = it.Next()) {
+    builder.AddSample((*stack)->pcs, (*stack)->length, (*stack)->count);
+  }
+  // time_nanos is wall clock time, the samples use the monotonic clock.
+  const int64_t duration_micros = now - start_micros_;
+  builder.AddInt(PprofBuilder::kProfileTimeNanos,
+                 (OS::GetCurrentTimeMicros() - duration_micros) *
+                     kNanosecondsPerMicrosecond);
+  builder.AddInt(PprofBuilder::kProfileDurationNanos,
+                 duration_micros * kNanosecondsPerMicrosecond);
+  builder.AddValueType(PprofBuilder::kProfilePeriodType, "cpu", "nanoseconds");
+  builder.AddInt(PprofBuilder::kProfilePeriod,
+                 FLAG_profile_period * kNanosecondsPerMicrosecond);
+  TextBuffer* encoded = builder.Finish();
+
+  if (callback_ != nullptr) {
+    callback_(isolate->main_port(),
+              reinterpret_cast<const uint8_t*>(encoded->buf()),
+              encoded->length());
+  }
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((FLAG_continuous_profile_file != nullptr) && (file_open != nullptr) &&
+      (file_write != nullptr) && (file_close != nullptr)) {
+    const char* path =
+        OS::SCreate(zone, "%s-%" Pd64 "-%" Pd ".pb",
+                    FLAG_continuous_profile_file,
+                    static_cast<int64_t>(isolate->main_port()), exports_);
+    void* file = file_open(path, /*write=*/true);
+    if (file != nullptr) {
+      file_write(encoded->buf(), encoded->length(), file);
+      file_close(file);
+    } else {
+      OS::PrintErr("Failed to open file %s\n", path);
+    }
+  }
+
+  exports_++;
+  start_micros_ = now;
+  Clear();
+}
+
+#endif  // !PRODUCT
+
+}  // namespace dart
@@ -0,0 +1,100 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROFILER_PPROF_H_
+#define RUNTIME_VM_PROFILER_PPROF_H_
+
+#include "include/dart_tools_api.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class Thread;
+
+#ifndef PRODUCT
+
+// Always-on CPU profile of an isolate, enabled with --continuous_profile.
+//
+// The samples of the mutator thread are periodically moved out of the shared
+// sample buffer into a table from call stack (a list of raw pcs) to sample
+// count, so the profile covers much more time than the ring buffer does and
+// takes memory proportional to the number of distinct stacks. Every
+// --continuous_profile_period seconds the table is symbolized, written out as
+// an uncompressed pprof protobuf to the embedder callback set with
+// Dart_SetContinuousProfileCallback or to --continuous_profile_file, and
+// cleared.
+//
+// Symbolization only happens on export. Each distinct pc of the exported
+// stacks is looked up once and every function name is added to the string
+// table once.
+class ContinuousProfile {
+ public:
+  ~ContinuousProfile();
+
+  // Called on the mutator thread between messages and when handling VM
+  // interrupts. Aggregates new samples and exports the profile when it is
+  // due. Cheap when neither is.
+  static void Tick(Thread* thread);
+
+  // Exports the remaining samples before the isolate shuts down.
+  static void Flush(Thread* thread);
+
+  static void SetCallback(Dart_ContinuousProfileCallback callback) {
+    callback_ = callback;
+  }
+
+ private:
+  struct Stack {
+    uword* pcs;
+    intptr_t length;
+    uint32_t hash;
+    int64_t count;
+  };
+
+  class StackKeyValueTrait {
+   public:
+    typedef const Stack* Key;
+    typedef Stack* Value;
+    typedef Stack* Pair;
+
+    static Key KeyOf(Pair kv) { return kv; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static intptr_t Hashcode(Key key) { return key->hash; }
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  explicit ContinuousProfile(int64_t now);
+
+  static ContinuousProfile* Get(Thread* thread);
+
+  // Moves the samples taken since the last call into [stacks_].
+  void Aggregate(Thread* thread);
+  void AddStack(const uword* pcs, intptr_t length);
+
+  void Export(Thread* thread, int64_t now);
+  void Clear();
+
+  static Dart_ContinuousProfileCallback callback_;
+
+  friend class ContinuousProfileVisitor;
+
+  MallocDirectChainedHashMap<StackKeyValueTrait> stacks_;
+  // Timestamp of the newest sample in [stacks_].
+  int64_t last_sample_micros_;
+  int64_t last_aggregate_micros_;
+  // Start of the time covered by the current profile.
+  int64_t start_micros_;
+  int64_t sample_count_;
+  intptr_t exports_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfile);
+};
+
+#endif  // !PRODUCT
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROFILER_PPROF_H_
@@ -1214,7 +1214,7 @@ class ProfileBuilder : public ValueObject {
         inclusive_tree_(false),
         samples_(NULL),
         info_kind_(kNone) {
-    ASSERT((sample_buffer_ == Profiler::sample_buffer()) ||
+    ASSERT((sample_buffer_ == Profiler::sample_buffer(thread->isolate())) ||
            (sample_buffer_ == Profiler::allocation_sample_buffer()));
     ASSERT(profile_ != NULL);
   }
@@ -2820,7 +2820,7 @@ void ProfilerService::PrintJSON(JSONStream* stream,
                                   time_origin_micros, time_extent_micros);
   bool code_trie = false;  // Doesn't matter for kAsProfile.
   PrintJSONImpl(thread, stream, tag_order, extra_tags, &filter,
-                Profiler::sample_buffer(), kAsProfile, code_trie);
+                Profiler::sample_buffer(isolate), kAsProfile, code_trie);
 }
 
 class ClassAllocationSampleFilter : public SampleFilter {
@@ -2859,7 +2859,7 @@ void ProfilerService::PrintAllocationJSON(JSONStream* stream,
                                      time_extent_micros);
   bool code_trie = false;  // Doesn't matter for kAsProfile.
   PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
-                Profiler::sample_buffer(), kAsProfile, code_trie);
+                Profiler::sample_buffer(isolate), kAsProfile, code_trie);
 }
 
 void ProfilerService::PrintNativeAllocationJSON(JSONStream* stream,
@@ -2886,7 +2886,7 @@ void ProfilerService::PrintTimelineJSON(JSONStream* stream,
   NoAllocationSampleFilter filter(isolate->main_port(), thread_task_mask,
                                   time_origin_micros, time_extent_micros);
   PrintJSONImpl(thread, stream, tag_order, kNoExtraTags, &filter,
-                Profiler::sample_buffer(), kAsTimeline, code_trie);
+                Profiler::sample_buffer(isolate), kAsTimeline, code_trie);
 }
 
 void ProfilerService::AddToTimeline(Profile::TagOrder tag_order,
@@ -2902,18 +2902,18 @@ void ProfilerService::AddToTimeline(Profile::TagOrder tag_order,
   NoAllocationSampleFilter filter(isolate->main_port(), thread_task_mask,
                                   time_origin_micros, time_extent_micros);
   PrintJSONImpl(thread, &stream, Profile::kNoTags, kNoExtraTags, &filter,
-                Profiler::sample_buffer(), kAsPlatformTimeline, code_trie);
+                Profiler::sample_buffer(isolate), kAsPlatformTimeline,
+                code_trie);
 }
 
 void ProfilerService::ClearSamples() {
-  SampleBuffer* sample_buffer = Profiler::sample_buffer();
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  SampleBuffer* sample_buffer = Profiler::sample_buffer(isolate);
   if (sample_buffer == NULL) {
     return;
   }
 
-  Thread* thread = Thread::Current();
-  Isolate* isolate = thread->isolate();
-
   // Disable thread interrupts while processing the buffer.
   DisableThreadInterruptsScope dtis(thread);
 
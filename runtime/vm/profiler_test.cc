@@ -8,6 +8,7 @@
 #include "vm/dart_api_state.h"
 #include "vm/globals.h"
 #include "vm/profiler.h"
+#include "vm/profiler_pprof.h"
 #include "vm/profiler_service.h"
 #include "vm/source_report.h"
 #include "vm/symbols.h"
@@ -2818,6 +2819,90 @@ ISOLATE_UNIT_TEST_CASE(Profiler_ProfileCodeTableTest) {
   EXPECT_EQ(table->FindCodeForPC(50), code1);
 }
 
+DECLARE_FLAG(int, isolate_sample_buffer_size);
+
+ISOLATE_UNIT_TEST_CASE(Profiler_IsolateSampleBuffer) {
+  EnableProfiler();
+  Isolate* isolate = thread->isolate();
+  if (isolate->sample_buffer() == NULL) {
+    EXPECT(Profiler::sample_buffer(isolate) == Profiler::sample_buffer());
+  } else {
+    EXPECT(Profiler::sample_buffer(isolate) == isolate->sample_buffer());
+  }
+
+  const intptr_t saved_size = FLAG_isolate_sample_buffer_size;
+  FLAG_isolate_sample_buffer_size = 0;
+  EXPECT(Profiler::NewIsolateSampleBuffer() == NULL);
+  FLAG_isolate_sample_buffer_size = 100;
+  SampleBuffer* sample_buffer = Profiler::NewIsolateSampleBuffer();
+  EXPECT(sample_buffer != NULL);
+  EXPECT_EQ(100, sample_buffer->capacity());
+  delete sample_buffer;
+  FLAG_isolate_sample_buffer_size = saved_size;
+}
+
+DECLARE_FLAG(bool, continuous_profile);
+
+static Dart_Port continuous_profile_port = ILLEGAL_PORT;
+static char* continuous_profile = nullptr;
+static intptr_t continuous_profile_length = 0;
+
+static void ContinuousProfileCallback(Dart_Port isolate_port,
+                                      const uint8_t* profile,
+                                      intptr_t profile_length) {
+  continuous_profile_port = isolate_port;
+  free(continuous_profile);
+  continuous_profile = reinterpret_cast<char*>(malloc(profile_length));
+  memmove(continuous_profile, profile, profile_length);
+  continuous_profile_length = profile_length;
+}
+
+static bool ContinuousProfileContains(const char* string) {
+  const intptr_t length = strlen(string);
+  for (intptr_t i = 0; i + length <= continuous_profile_length; i++) {
+    if (memcmp(&continuous_profile[i], string, length) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_ContinuousProfile) {
+  EnableProfiler();
+  const bool saved_continuous_profile = FLAG_continuous_profile;
+  FLAG_continuous_profile = true;
+  ContinuousProfile::SetCallback(ContinuousProfileCallback);
+  // Creates the profile, which only picks up samples taken after this.
+  ContinuousProfile::Tick(thread);
+
+  Isolate* isolate = thread->isolate();
+  SampleBuffer* sample_buffer = Profiler::sample_buffer(isolate);
+  const int64_t timestamp = OS::GetCurrentMonotonicMicros() + 1000;
+  for (intptr_t i = 0; i < 3; i++) {
+    Sample* sample = sample_buffer->ReserveSample();
+    sample->Init(isolate->main_port(), timestamp + i, 0);
+    sample->set_thread_task(Thread::kMutatorTask);
+    sample->SetAt(0, 0x10);
+    if (i < 2) {
+      sample->SetAt(1, 0x20);
+    }
+  }
+  ContinuousProfile::Flush(thread);
+
+  EXPECT_EQ(isolate->main_port(), continuous_profile_port);
+  EXPECT(continuous_profile_length > 0);
+  // The first field is the sample type.
+  EXPECT_EQ(0x0a, continuous_profile[0]);
+  EXPECT(ContinuousProfileContains("samples"));
+  EXPECT(ContinuousProfileContains("nanoseconds"));
+  EXPECT(ContinuousProfileContains("[Unknown]"));
+
+  free(continuous_profile);
+  continuous_profile = nullptr;
+  ContinuousProfile::SetCallback(nullptr);
+  FLAG_continuous_profile = saved_continuous_profile;
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
@@ -0,0 +1,84 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROTOBUF_WRITER_H_
+#define RUNTIME_VM_PROTOBUF_WRITER_H_
+
+#include "platform/allocation.h"
+#include "platform/text_buffer.h"
+
+namespace dart {
+
+// Encodes protocol buffers, just enough of them for the pprof profiles and
+// Perfetto traces written by the VM.
+class ProtobufWriter : public ValueObject {
+ public:
+  ProtobufWriter() : buffer_(256) {}
+
+  TextBuffer* buffer() { return &buffer_; }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.AddChar(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    buffer_.AddChar(static_cast<char>(value));
+  }
+
+  // Zero is the default value and is left out.
+  void WriteInt(intptr_t field, int64_t value) {
+    if (value == 0) return;
+    WriteVarint((field << 3) | kVarintWireType);
+    WriteVarint(static_cast<uint64_t>(value));
+  }
+
+  void WriteFixed64(intptr_t field, uint64_t value) {
+    WriteVarint((field << 3) | kFixed64WireType);
+    for (intptr_t i = 0; i < 8; i++) {
+      buffer_.AddChar(static_cast<char>(value & 0xff));
+      value >>= 8;
+    }
+  }
+
+  void WriteDouble(intptr_t field, double value) {
+    uint64_t bits;
+    memmove(&bits, &value, sizeof(bits));
+    WriteFixed64(field, bits);
+  }
+
+  void WriteBytes(intptr_t field, const void* data, intptr_t length) {
+    WriteVarint((field << 3) | kLengthDelimitedWireType);
+    WriteVarint(length);
+    buffer_.AddRaw(reinterpret_cast<const uint8_t*>(data), length);
+  }
+
+  void WriteString(intptr_t field, const char* value) {
+    WriteBytes(field, value, strlen(value));
+  }
+
+  void WriteMessage(intptr_t field, ProtobufWriter* message) {
+    WriteBytes(field, message->buffer()->buf(), message->buffer()->length());
+  }
+
+  void WritePacked(intptr_t field, const int64_t* values, intptr_t length) {
+    ProtobufWriter packed;
+    for (intptr_t i = 0; i < length; i++) {
+      packed.WriteVarint(static_cast<uint64_t>(values[i]));
+    }
+    WriteMessage(field, &packed);
+  }
+
+ private:
+  static const intptr_t kVarintWireType = 0;
+  static const intptr_t kFixed64WireType = 1;
+  static const intptr_t kLengthDelimitedWireType = 2;
+
+  TextBuffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtobufWriter);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROTOBUF_WRITER_H_
@@ -78,11 +78,11 @@ void RawObject::Validate(Isolate* isolate) const {
 // Can't look at the class object because it can be called during
 // compaction when the class objects are moving. Can use the class
 // id in the header and the sizes in the Class Table.
-intptr_t RawObject::HeapSizeFromClass() const {
+intptr_t RawObject::HeapSizeFromClass(uint32_t tags) const {
   // Only reasonable to be called on heap objects.
   ASSERT(IsHeapObject());
 
-  intptr_t class_id = GetClassId();
+  intptr_t class_id = ClassIdTag::decode(tags);
   intptr_t instance_size = 0;
   switch (class_id) {
     case kCodeCid: {
@@ -144,9 +144,9 @@ intptr_t RawObject::HeapSizeFromClass() const {
       CLASS_LIST_TYPED_DATA(SIZE_FROM_CLASS) {
         const RawTypedData* raw_obj =
             reinterpret_cast<const RawTypedData*>(this);
-        intptr_t cid = raw_obj->GetClassId();
         intptr_t array_len = Smi::Value(raw_obj->ptr()->length_);
-        intptr_t lengthInBytes = array_len * TypedData::ElementSizeInBytes(cid);
+        intptr_t lengthInBytes =
+            array_len * TypedData::ElementSizeInBytes(class_id);
         instance_size = TypedData::InstanceSize(lengthInBytes);
         break;
       }
@@ -215,8 +215,7 @@ intptr_t RawObject::HeapSizeFromClass() const {
       ClassTable* class_table = isolate->class_table();
       if (!class_table->IsValidIndex(class_id) ||
           !class_table->HasValidClassAt(class_id)) {
-        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id,
-               ptr()->tags_);
+        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id, tags);
       }
 #endif  // DEBUG
       instance_size = isolate->GetClassSizeForHeapWalkAt(class_id);
@@ -224,7 +223,6 @@ intptr_t RawObject::HeapSizeFromClass() const {
   }
   ASSERT(instance_size != 0);
 #if defined(DEBUG)
-  uint32_t tags = ptr()->tags_;
   intptr_t tags_size = SizeTag::decode(tags);
   if ((class_id == kArrayCid) && (instance_size > tags_size && tags_size > 0)) {
     // TODO(22501): Array::MakeFixedLength could be in the process of shrinking
@@ -477,6 +475,7 @@ NULL_VISITOR(Int32x4)
 NULL_VISITOR(Float64x2)
 NULL_VISITOR(Bool)
 NULL_VISITOR(Capability)
+NULL_VISITOR(TransferableTypedData)
 NULL_VISITOR(SendPort)
 REGULAR_VISITOR(Pointer)
 NULL_VISITOR(DynamicLibrary)
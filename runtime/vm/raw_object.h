@@ -384,6 +384,20 @@ class RawObject {
     return result;
   }
 
+  // Like HeapSize, but decodes the size from tags loaded earlier by the caller.
+  // Used by the parallel scavenger, where another task may replace the header
+  // with a forwarding pointer at any time.
+  intptr_t HeapSize(uint32_t tags) const {
+    ASSERT(IsHeapObject());
+    intptr_t result = SizeTag::decode(tags);
+    if (result != 0) {
+      return result;
+    }
+    result = HeapSizeFromClass(tags);
+    ASSERT(result > SizeTag::kMaxSizeTag);
+    return result;
+  }
+
   bool Contains(uword addr) const {
     intptr_t this_size = HeapSize();
     uword this_addr = RawObject::ToAddr(this);
@@ -495,7 +509,8 @@ class RawObject {
   intptr_t VisitPointersPredefined(ObjectPointerVisitor* visitor,
                                    intptr_t class_id);
 
-  intptr_t HeapSizeFromClass() const;
+  intptr_t HeapSizeFromClass() const { return HeapSizeFromClass(ptr()->tags_); }
+  intptr_t HeapSizeFromClass(uint32_t tags) const;
 
   intptr_t GetClassId() const {
     uint32_t tags = ptr()->tags_;
@@ -689,7 +704,8 @@ class RawObject {
   friend class RawTypedData;
   friend class RawTypedDataView;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class SizeExcludingClassVisitor;  // GetClassId
   friend class InstanceAccumulator;        // GetClassId
   friend class RetainingPathVisitor;       // GetClassId
@@ -1014,6 +1030,7 @@ class RawFfiTrampolineData : public RawObject {
   RawType* signature_type_;
   RawFunction* c_signature_;
   VISIT_TO(RawObject*, c_signature_);
+  bool is_leaf_;
 };
 
 class RawField : public RawObject {
@@ -2178,7 +2195,8 @@ class RawTypedDataView : public RawTypedDataBase {
   friend class ObjectPoolSerializationCluster;
   friend class RawObjectPool;
   friend class GCCompactor;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class SnapshotReader;
 };
 
@@ -2231,6 +2249,7 @@ class RawArray : public RawInstance {
   friend class Object;
   friend class ICData;            // For high performance access.
   friend class SubtypeTestCache;  // For high performance access.
+  friend class TypeArguments;     // For high performance access.
 
   friend class HeapPage;
 };
@@ -2361,6 +2380,14 @@ class RawCapability : public RawInstance {
   uint64_t id_;
 };
 
+class TransferableTypedDataPeer;
+
+class RawTransferableTypedData : public RawInstance {
+  RAW_HEAP_OBJECT_IMPLEMENTATION(TransferableTypedData);
+  VISIT_NOTHING();
+  TransferableTypedDataPeer* peer_;
+};
+
 class RawSendPort : public RawInstance {
   RAW_HEAP_OBJECT_IMPLEMENTATION(SendPort);
   VISIT_NOTHING();
@@ -2430,6 +2457,10 @@ class RawRegExp : public RawInstance {
 
   intptr_t num_registers_;
 
+  // The number of matches interpreted so far in JIT mode, where the matcher
+  // functions are only created once a regexp has been used often enough.
+  intptr_t execution_count_;
+
   // A bitfield with two fields:
   // type: Uninitialized, simple or complex.
   // flags: Represents global/local, case insensitive, multiline.
@@ -2453,7 +2484,8 @@ class RawWeakProperty : public RawInstance {
   template <bool>
   friend class MarkingVisitorBase;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
 };
 
 // MirrorReferences are used by mirrors to hold reflectees that are VM
@@ -2630,7 +2662,7 @@ inline bool RawObject::IsFfiTypeNativeFunctionClassId(intptr_t index) {
 }
 
 inline bool RawObject::IsFfiClassId(intptr_t index) {
-  return (index >= kFfiPointerCid && index <= kFfiVoidCid);
+  return (index >= kFfiPointerCid && index <= kFfiByValueCid);
 }
 
 inline bool RawObject::IsFfiDynamicLibraryClassId(intptr_t index) {
@@ -2079,6 +2079,63 @@ void RawCapability::WriteTo(SnapshotWriter* writer,
   writer->Write<uint64_t>(ptr()->id_);
 }
 
+RawTransferableTypedData* TransferableTypedData::ReadFrom(
+    SnapshotReader* reader,
+    intptr_t object_id,
+    intptr_t tags,
+    Snapshot::Kind kind,
+    bool as_reference) {
+  ASSERT(kind == Snapshot::kMessage);
+  const intptr_t length = reader->Read<int32_t>();
+
+  FinalizableData finalizable_data =
+      static_cast<MessageSnapshotReader*>(reader)->finalizable_data()->Take();
+  uint8_t* data = reinterpret_cast<uint8_t*>(finalizable_data.data);
+  TransferableTypedData& result = TransferableTypedData::ZoneHandle(
+      reader->zone(), TransferableTypedData::New(data, length));
+  reader->AddBackRef(object_id, &result, kIsDeserialized);
+  return result.raw();
+}
+
+// Invoked once the message carrying the bytes of a TransferableTypedData has
+// been written: the bytes now belong to the message.
+static void TransferableTypedDataSent(void* isolate_callback_data,
+                                      Dart_WeakPersistentHandle handle,
+                                      void* peer) {
+  reinterpret_cast<TransferableTypedDataPeer*>(peer)->ClearData(
+      Isolate::Current());
+}
+
+void RawTransferableTypedData::WriteTo(SnapshotWriter* writer,
+                                       intptr_t object_id,
+                                       Snapshot::Kind kind,
+                                       bool as_reference) {
+  ASSERT(kind == Snapshot::kMessage);
+  TransferableTypedDataPeer* peer = ptr()->peer_;
+  uint8_t* data = peer->data();
+  if (data == nullptr) {
+    writer->SetWriteException(Exceptions::kArgument,
+                              "Illegal argument in isolate message"
+                              " : (TransferableTypedData has been transferred"
+                              " already)");
+    UNREACHABLE();
+  }
+  const intptr_t length = peer->length();
+
+  // Write out the serialization header value for this object.
+  writer->WriteInlinedObjectHeader(object_id);
+
+  // Write out the class and tags information.
+  writer->WriteIndexedObject(kTransferableTypedDataCid);
+  writer->WriteTags(writer->GetObjectTags(this));
+
+  writer->Write<int32_t>(length);
+  // The bytes are not copied: they move to the receiver with the message.
+  static_cast<MessageWriter*>(writer)->finalizable_data()->Put(
+      length, data, /*peer=*/data, IsolateMessageTypedDataFinalizer,
+      TransferableTypedDataSent, /*sender_peer=*/peer);
+}
+
 RawReceivePort* ReceivePort::ReadFrom(SnapshotReader* reader,
                                       intptr_t object_id,
                                       intptr_t tags,
@@ -18,6 +18,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            regexp_tier_up_threshold,
+            10,
+            "In JIT mode, the number of matches of a regular expression to "
+            "interpret before compiling it, or 0 to compile it right away.");
+
 // Default to generating optimized regexp code.
 static const bool kRegexpOptimization = true;
 
@@ -328,6 +334,15 @@ class RegExpCompiler : public ValueObject {
 
   Zone* zone() const { return zone_; }
 
+  // Records the .*? loop that an unanchored |tree| is wrapped in. If every
+  // match of |tree| starts with a long enough literal, the loop skips ahead
+  // to occurrences of it instead of trying to match at every position.
+  void SetUnanchoredLoop(RegExpNode* loop, RegExpTree* tree);
+  RegExpNode* unanchored_loop() const { return unanchored_loop_; }
+  ZoneGrowableArray<uint16_t>* required_prefix() const {
+    return required_prefix_;
+  }
+
   static const intptr_t kNoRegister = -1;
 
  private:
@@ -342,6 +357,8 @@ class RegExpCompiler : public ValueObject {
   bool read_backward_;
   intptr_t current_expansion_factor_;
   FrequencyCollator frequency_collator_;
+  RegExpNode* unanchored_loop_;
+  ZoneGrowableArray<uint16_t>* required_prefix_;
   Zone* zone_;
 };
 
@@ -373,10 +390,82 @@ RegExpCompiler::RegExpCompiler(intptr_t capture_count,
       reg_exp_too_big_(false),
       read_backward_(false),
       current_expansion_factor_(1),
+      unanchored_loop_(NULL),
+      required_prefix_(NULL),
       zone_(Thread::Current()->zone()) {
   accept_ = new (Z) EndNode(EndNode::ACCEPT, Z);
 }
 
+static const intptr_t kMinRequiredPrefixLength = 2;
+static const intptr_t kMaxRequiredPrefixLength = 32;
+
+// Appends to |prefix| the characters every match of |tree| starts with.
+// Returns whether |tree| matches exactly those characters, in which case
+// whatever follows it continues the prefix.
+static bool AppendRequiredPrefix(RegExpTree* tree,
+                                 ZoneGrowableArray<uint16_t>* prefix) {
+  if (prefix->length() >= kMaxRequiredPrefixLength) {
+    return false;
+  }
+  if (tree->IsAtom()) {
+    ZoneGrowableArray<uint16_t>* data = tree->AsAtom()->data();
+    for (intptr_t i = 0; i < data->length(); i++) {
+      prefix->Add(data->At(i));
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      const TextElement& element = (*elements)[i];
+      if (element.text_type() != TextElement::ATOM ||
+          !AppendRequiredPrefix(element.atom(), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!AppendRequiredPrefix(nodes->At(i), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return AppendRequiredPrefix(tree->AsCapture()->body(), prefix);
+  }
+  if (tree->IsQuantifier()) {
+    // At least one iteration of the body has to match, but how many there
+    // are decides what comes after it.
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() > 0) {
+      AppendRequiredPrefix(quantifier->body(), prefix);
+    }
+    return false;
+  }
+  // Assertions and lookarounds match the empty string wherever they match.
+  return tree->IsEmpty() || tree->IsAssertion() || tree->IsLookaround();
+}
+
+void RegExpCompiler::SetUnanchoredLoop(RegExpNode* loop, RegExpTree* tree) {
+  unanchored_loop_ = loop;
+  if (ignore_case_) {
+    return;
+  }
+  ZoneGrowableArray<uint16_t>* prefix =
+      new (Z) ZoneGrowableArray<uint16_t>(kMaxRequiredPrefixLength);
+  AppendRequiredPrefix(tree, prefix);
+  if (prefix->length() >= kMinRequiredPrefixLength) {
+    if (prefix->length() > kMaxRequiredPrefixLength) {
+      prefix->TruncateTo(kMaxRequiredPrefixLength);
+    }
+    required_prefix_ = prefix;
+  }
+}
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 RegExpEngine::CompilationResult RegExpCompiler::Assemble(
     IRRegExpMacroAssembler* macro_assembler,
@@ -3184,7 +3273,17 @@ intptr_t ChoiceNode::EmitOptimizedUnanchoredSearch(RegExpCompiler* compiler,
   RegExpMacroAssembler* macro_assembler = compiler->macro_assembler();
   // At this point we know that we are at a non-greedy loop that will eat
   // any character one at a time.  Any non-anchored regexp has such a
-  // loop prepended to it in order to find where it starts.  We look for
+  // loop prepended to it in order to find where it starts.  If every match
+  // starts with the same literal, the loop can go straight to the next
+  // occurrence of it, which is a plain substring search.
+  if (this == compiler->unanchored_loop() &&
+      compiler->required_prefix() != NULL) {
+    macro_assembler->SkipUntilLiteral(*compiler->required_prefix());
+    return Utils::Minimum(
+        kMaxLookaheadForBoyerMoore,
+        EatsAtLeast(kMaxLookaheadForBoyerMoore, kRecursionBudget, false));
+  }
+  // Otherwise we look for
   // a pattern of the form ...abc... where we can look 6 characters ahead
   // and step forwards 3 if the character is not one of abc.  Abc need
   // not be atoms, they can be any reasonably limited character class or
@@ -4736,6 +4835,7 @@ RegExpEngine::CompilationResult RegExpEngine::CompileIR(
     RegExpNode* loop_node = RegExpQuantifier::ToNode(
         0, RegExpTree::kInfinity, false, new (zone) RegExpCharacterClass('*'),
         &compiler, captured_body, data->contains_anchor);
+    compiler.SetUnanchoredLoop(loop_node, data->tree);
 
     if (data->contains_anchor) {
       // Unroll loop once, to take care of the case that might start
@@ -4806,7 +4906,6 @@ RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     bool is_one_byte,
     bool is_sticky,
     Zone* zone) {
-  ASSERT(FLAG_interpret_irregexp);
   const String& pattern = String::Handle(zone, regexp.pattern());
 
   ASSERT(!regexp.IsNull());
@@ -4840,6 +4939,7 @@ RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     RegExpNode* loop_node = RegExpQuantifier::ToNode(
         0, RegExpTree::kInfinity, false, new (zone) RegExpCharacterClass('*'),
         &compiler, captured_body, data->contains_anchor);
+    compiler.SetUnanchoredLoop(loop_node, data->tree);
 
     if (data->contains_anchor) {
       // Unroll loop once, to take care of the case that might start
@@ -4950,6 +5050,100 @@ static void CreateSpecializedFunction(Thread* thread,
   // The function is compiled lazily during the first call.
 }
 
+static void CreateSpecializedFunctions(Thread* thread,
+                                       Zone* zone,
+                                       const RegExp& regexp) {
+  const Library& lib = Library::Handle(zone, Library::CoreLibrary());
+  const Class& owner = Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
+
+  for (intptr_t cid = kOneByteStringCid; cid <= kExternalTwoByteStringCid;
+       cid++) {
+    CreateSpecializedFunction(thread, zone, regexp, cid, /*sticky=*/false,
+                              owner);
+    CreateSpecializedFunction(thread, zone, regexp, cid, /*sticky=*/true,
+                              owner);
+  }
+}
+
+template <typename Char>
+static intptr_t FindLiteralIn(const Char* subject,
+                              intptr_t length,
+                              intptr_t start,
+                              const uint16_t* literal,
+                              intptr_t literal_length) {
+  const uint16_t first = literal[0];
+  const intptr_t last_start = length - literal_length;
+  for (intptr_t i = start; i <= last_start; i++) {
+    if (sizeof(Char) == 1) {
+      // memchr is vectorized by the C library, which makes it the fastest
+      // way here to get to the next candidate.
+      const void* found = memchr(subject + i, first, last_start - i + 1);
+      if (found == NULL) {
+        return -1;
+      }
+      i = reinterpret_cast<const Char*>(found) - subject;
+    } else if (subject[i] != first) {
+      continue;
+    }
+    intptr_t j = 1;
+    while (j < literal_length && subject[i + j] == literal[j]) {
+      j++;
+    }
+    if (j == literal_length) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+intptr_t RegExpEngine::FindLiteral(const String& subject,
+                                   intptr_t start,
+                                   const uint16_t* literal,
+                                   intptr_t literal_length) {
+  ASSERT(literal_length > 0);
+  NoSafepointScope no_safepoint;
+  const intptr_t length = subject.Length();
+  switch (subject.GetClassId()) {
+    case kOneByteStringCid:
+    case kExternalOneByteStringCid:
+      for (intptr_t i = 0; i < literal_length; i++) {
+        if (literal[i] > 0xFF) {
+          return -1;
+        }
+      }
+      return FindLiteralIn(subject.IsOneByteString()
+                               ? OneByteString::DataStart(subject)
+                               : ExternalOneByteString::DataStart(subject),
+                           length, start, literal, literal_length);
+    case kTwoByteStringCid:
+    case kExternalTwoByteStringCid:
+      return FindLiteralIn(subject.IsTwoByteString()
+                               ? TwoByteString::DataStart(subject)
+                               : ExternalTwoByteString::DataStart(subject),
+                           length, start, literal, literal_length);
+    default:
+      UNREACHABLE();
+      return -1;
+  }
+}
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+bool RegExpEngine::TierUp(Thread* thread, const RegExp& regexp) {
+  ASSERT(!FLAG_interpret_irregexp);
+  if (regexp.has_functions()) {
+    return true;
+  }
+  const intptr_t count = regexp.execution_count() + 1;
+  if (count < FLAG_regexp_tier_up_threshold) {
+    regexp.set_execution_count(count);
+    return false;
+  }
+  // This replaces the bytecode, which shares its fields with the functions.
+  CreateSpecializedFunctions(thread, thread->zone(), regexp);
+  return true;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 RawRegExp* RegExpEngine::CreateRegExp(Thread* thread,
                                       const String& pattern,
                                       bool multi_line,
@@ -4971,18 +5165,11 @@ RawRegExp* RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
-  if (!FLAG_interpret_irregexp) {
-    const Library& lib = Library::Handle(zone, Library::CoreLibrary());
-    const Class& owner =
-        Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
-
-    for (intptr_t cid = kOneByteStringCid; cid <= kExternalTwoByteStringCid;
-         cid++) {
-      CreateSpecializedFunction(thread, zone, regexp, cid, /*sticky=*/false,
-                                owner);
-      CreateSpecializedFunction(thread, zone, regexp, cid, /*sticky=*/true,
-                                owner);
-    }
+  // In JIT mode, regexps are interpreted until they have been matched
+  // FLAG_regexp_tier_up_threshold times, so that the many which are only
+  // used a few times never pay for compilation. See TierUp.
+  if (!FLAG_interpret_irregexp && (FLAG_regexp_tier_up_threshold <= 0)) {
+    CreateSpecializedFunctions(thread, zone, regexp);
   }
 
   return regexp.raw();
@@ -1401,6 +1401,20 @@ class RegExpEngine : public AllStatic {
                                  bool multi_line,
                                  bool ignore_case);
 
+  // Returns the index of the first occurrence of |literal| in |subject| at
+  // or after |start|, or -1 if there is none.
+  static intptr_t FindLiteral(const String& subject,
+                              intptr_t start,
+                              const uint16_t* literal,
+                              intptr_t literal_length);
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Counts a match of |regexp| in JIT mode and returns whether it should use
+  // the compiled matcher functions, creating them once the regexp has been
+  // interpreted often enough.
+  static bool TierUp(Thread* thread, const RegExp& regexp);
+#endif
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
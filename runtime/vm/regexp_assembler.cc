@@ -59,8 +59,9 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(
 BlockLabel::BlockLabel()
     : block_(NULL), is_bound_(false), is_linked_(false), pos_(-1) {
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
-    // Only needed by the compiled IR backend.
+  // Only needed by the compiled IR backend, which runs inside a compiler
+  // state. Bytecode is also generated in JIT mode before a regexp tiers up.
+  if (!FLAG_interpret_irregexp && Thread::Current()->HasCompilerState()) {
     block_ =
         new JoinEntryInstr(-1, -1, CompilerState::Current().GetNextDeoptId());
   }
@@ -208,6 +208,9 @@ class RegExpMacroAssembler : public ZoneAllocated {
   virtual void ReadStackPointerFromRegister(intptr_t reg) = 0;
   virtual void SetCurrentPositionFromEnd(intptr_t by) = 0;
   virtual void SetRegister(intptr_t register_index, intptr_t to) = 0;
+  // Advances the current position to the next occurrence of |literal| at
+  // or after it, or to the end of the subject if there is none.
+  virtual void SkipUntilLiteral(const ZoneGrowableArray<uint16_t>& literal) = 0;
   // Return whether the matching (with a global regexp) will be restarted.
   virtual bool Succeed() = 0;
   virtual void WriteCurrentPositionToRegister(intptr_t reg,
@@ -116,6 +116,18 @@ void BytecodeRegExpMacroAssembler::SetCurrentPositionFromEnd(intptr_t by) {
   Emit(BC_SET_CURRENT_POSITION_FROM_END, by);
 }
 
+void BytecodeRegExpMacroAssembler::SkipUntilLiteral(
+    const ZoneGrowableArray<uint16_t>& literal) {
+  ASSERT(Utils::IsUint(24, literal.length()));
+  Emit(BC_SKIP_UNTIL_LITERAL, literal.length());
+  for (intptr_t i = 0; i < literal.length(); i++) {
+    Emit16(literal[i]);
+  }
+  if ((literal.length() & 1) != 0) {
+    Emit16(0);
+  }
+}
+
 void BytecodeRegExpMacroAssembler::SetRegister(intptr_t register_index,
                                                intptr_t to) {
   ASSERT(register_index >= 0);
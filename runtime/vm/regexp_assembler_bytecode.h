@@ -45,6 +45,7 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
   virtual void AdvanceRegister(intptr_t reg, intptr_t by);  // r[reg] += by.
   virtual void SetCurrentPositionFromEnd(intptr_t by);
   virtual void SetRegister(intptr_t register_index, intptr_t to);
+  virtual void SkipUntilLiteral(const ZoneGrowableArray<uint16_t>& literal);
   virtual void WriteCurrentPositionToRegister(intptr_t reg, intptr_t cp_offset);
   virtual void ClearRegisters(intptr_t reg_from, intptr_t reg_to);
   virtual void ReadCurrentPositionFromRegister(intptr_t reg);
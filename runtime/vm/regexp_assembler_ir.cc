@@ -1575,6 +1575,31 @@ void IRRegExpMacroAssembler::SetCurrentPositionFromEnd(intptr_t by) {
   BindBlock(&after_position);
 }
 
+void IRRegExpMacroAssembler::SkipUntilLiteral(
+    const ZoneGrowableArray<uint16_t>& literal) {
+  TAG();
+  const Library& lib = Library::Handle(Z, Library::InternalLibrary());
+  const Function& find_function = Function::ZoneHandle(
+      Z, lib.LookupFunctionAllowPrivate(Symbols::FindRegExpLiteral()));
+  const String& literal_string = String::ZoneHandle(
+      Z, Symbols::FromUTF16(Thread::Current(), literal.data(),
+                            literal.length()));
+
+  ZoneGrowableArray<PushArgumentInstr*>* arguments =
+      new (Z) ZoneGrowableArray<PushArgumentInstr*>(3);
+  arguments->Add(PushLocal(string_param_));
+  arguments->Add(PushArgument(Bind(new (Z) ConstantInstr(literal_string))));
+  PushArgumentInstr* position_push = PushLocal(current_position_);
+  PushArgumentInstr* length_push = PushLocal(string_param_length_);
+  arguments->Add(PushArgument(Bind(Add(position_push, length_push))));
+  PushArgumentInstr* index_push = PushArgument(
+      Bind(StaticCall(find_function, arguments, ICData::kStatic)));
+
+  // The position is kept as an offset from the end of the subject.
+  length_push = PushLocal(string_param_length_);
+  StoreLocal(current_position_, Bind(Sub(index_push, length_push)));
+}
+
 void IRRegExpMacroAssembler::SetRegister(intptr_t reg, intptr_t to) {
   TAG();
   // Reserved for positions!
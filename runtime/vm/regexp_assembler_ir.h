@@ -113,6 +113,7 @@ class IRRegExpMacroAssembler : public RegExpMacroAssembler {
   virtual void ReadStackPointerFromRegister(intptr_t reg);
   virtual void SetCurrentPositionFromEnd(intptr_t by);
   virtual void SetRegister(intptr_t register_index, intptr_t to);
+  virtual void SkipUntilLiteral(const ZoneGrowableArray<uint16_t>& literal);
   virtual bool Succeed();
   virtual void WriteCurrentPositionToRegister(intptr_t reg, intptr_t cp_offset);
   virtual void ClearRegisters(intptr_t reg_from, intptr_t reg_to);
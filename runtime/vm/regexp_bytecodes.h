@@ -65,7 +65,8 @@ V(CHECK_AT_START,    45, 8)   /* bc8 pad24 addr32                           */ \
 V(CHECK_NOT_AT_START, 46, 8)  /* bc8 offset24 addr32                        */ \
 V(CHECK_GREEDY,      47, 8)   /* bc8 pad24 addr32                           */ \
 V(ADVANCE_CP_AND_GOTO, 48, 8) /* bc8 offset24 addr32                        */ \
-V(SET_CURRENT_POSITION_FROM_END, 49, 4) /* bc8 idx24                        */
+V(SET_CURRENT_POSITION_FROM_END, 49, 4) /* bc8 idx24                        */ \
+V(SKIP_UNTIL_LITERAL, 50, 4)  /* bc8 length24 uc16... padded to 32 bits     */
 
 // clang-format on
 
@@ -8,6 +8,7 @@
 
 #include "platform/unicode.h"
 #include "vm/object.h"
+#include "vm/regexp.h"
 #include "vm/regexp_assembler.h"
 #include "vm/regexp_bytecodes.h"
 #include "vm/unibrow-inl.h"
@@ -608,6 +609,15 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
         break;
       }
+      BYTECODE(SKIP_UNTIL_LITERAL) {
+        const intptr_t length = static_cast<uint32_t>(insn) >> BYTECODE_SHIFT;
+        const uint16_t* literal = reinterpret_cast<const uint16_t*>(pc + 4);
+        const intptr_t found =
+            RegExpEngine::FindLiteral(subject, current, literal, length);
+        current = (found < 0) ? subject_length : found;
+        pc += BC_SKIP_UNTIL_LITERAL_LENGTH + Utils::RoundUp(length * 2, 4);
+        break;
+      }
       default:
         UNREACHABLE();
         break;
@@ -44,8 +44,23 @@ void ReversePcLookupCache::BuildAndAttachToIsolate(Isolate* isolate) {
         ASSERT(pc_array[i - 1] <= pc_array[i]);
       }
 #endif  // defined(DEBUG)
-      auto cache =
-          new ReversePcLookupCache(isolate, pc_array, length, begin, end);
+
+      // One more page than covered by the instructions, so the lookup can
+      // always read the entry of the next page.
+      const intptr_t page_count =
+          ((end - begin) >> ReversePcLookupCache::kPageSizeLog2) + 2;
+      auto page_array = new uint32_t[page_count];
+      intptr_t index = 0;
+      for (intptr_t page = 0; page < page_count; page++) {
+        const uword page_start = page << ReversePcLookupCache::kPageSizeLog2;
+        while ((index < length - 1) && (pc_array[index] < page_start)) {
+          index++;
+        }
+        page_array[page] = index;
+      }
+
+      auto cache = new ReversePcLookupCache(isolate, pc_array, length,
+                                            page_array, begin, end);
       isolate->set_reverse_pc_lookup_cache(cache);
     }
   }
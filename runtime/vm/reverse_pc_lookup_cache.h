@@ -40,20 +40,37 @@ class Isolate;
 // The lookup will then do a binary search in pc_array. The index can then be
 // used in the `code_order_table` of the object store.
 //
+// To keep the binary search short for the deep stacks walked by the GC, the
+// profiler and exceptions, a second uint32 array has an entry for every 4KB
+// page of instructions, starting at the first instruction:
+//
+//   page_array[p] == min { i | pc_array[i] >= p * 4KB }
+//
+// (clamped to the last index) so the code for a pc in page p is found by
+// searching pc_array[page_array[p]..page_array[p+1]], which is usually only
+// one or two entries.
+//
 // WARNING: This class cannot do memory allocation or handle allocation!
 class ReversePcLookupCache {
  public:
+  static const intptr_t kPageSizeLog2 = 12;
+
   ReversePcLookupCache(Isolate* isolate,
                        uint32_t* pc_array,
                        intptr_t length,
+                       uint32_t* page_array,
                        uword first_absolute_pc,
                        uword last_absolute_pc)
       : isolate_(isolate),
         pc_array_(pc_array),
         length_(length),
+        page_array_(page_array),
         first_absolute_pc_(first_absolute_pc),
         last_absolute_pc_(last_absolute_pc) {}
-  ~ReversePcLookupCache() { delete[] pc_array_; }
+  ~ReversePcLookupCache() {
+    delete[] pc_array_;
+    delete[] page_array_;
+  }
 
   // Builds a [ReversePcLookupCache] and attaches it to the isolate (if
   // `code_order_table` is non-`null`).
@@ -65,16 +82,20 @@ class ReversePcLookupCache {
     return first_absolute_pc_ <= pc && pc <= last_absolute_pc_;
   }
 
+  // The start of the first instructions covered by this cache.
+  uword first_absolute_pc() const { return first_absolute_pc_; }
+
   // Looks up the [Code] object from a given [pc].
   inline RawCode* Lookup(uword pc) {
     NoSafepointScope no_safepoint_scope;
 
-    intptr_t left = 0;
-    intptr_t right = length_ - 1;
-
     ASSERT(first_absolute_pc_ <= pc && pc < last_absolute_pc_);
     uint32_t pc_offset = static_cast<uint32_t>(pc - first_absolute_pc_);
 
+    const intptr_t page = pc_offset >> kPageSizeLog2;
+    intptr_t left = page_array_[page];
+    intptr_t right = page_array_[page + 1];
+
     while (left < right) {
       intptr_t middle = left + (right - left) / 2;
 
@@ -101,6 +122,7 @@ class ReversePcLookupCache {
   Isolate* isolate_;
   uint32_t* pc_array_;
   intptr_t length_;
+  uint32_t* page_array_;
   uword first_absolute_pc_;
   uword last_absolute_pc_;
 };
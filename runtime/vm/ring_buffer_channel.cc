@@ -0,0 +1,153 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ring_buffer_channel.h"
+
+#include <new>
+
+#include "platform/atomic.h"
+#include "platform/utils.h"
+#include "vm/lockers.h"
+#include "vm/message.h"
+#include "vm/object.h"
+#include "vm/port.h"
+
+namespace dart {
+
+Mutex* RingBufferChannel::mutex_ = NULL;
+RingBufferChannel* RingBufferChannel::channels_ = NULL;
+int64_t RingBufferChannel::next_id_ = 1;
+
+void RingBufferChannel::Init() {
+  ASSERT(mutex_ == NULL);
+  mutex_ = new Mutex();
+}
+
+void RingBufferChannel::Cleanup() {
+  // The isolates holding channels have all been shut down by now, which
+  // finalized their references.
+  delete mutex_;
+  mutex_ = NULL;
+}
+
+RingBufferChannel::RingBufferChannel(intptr_t capacity)
+    : id_(next_id_++),
+      capacity_(capacity),
+      ref_count_(1),
+      next_(NULL),
+      head_(0),
+      tail_(0),
+      notify_(0),
+      notify_port_(ILLEGAL_PORT) {}
+
+RingBufferChannel* RingBufferChannel::New(intptr_t capacity) {
+  ASSERT((capacity > 0) && (capacity <= kMaxCapacity));
+  capacity = Utils::RoundUpToPowerOfTwo(capacity);
+  void* memory = malloc(sizeof(RingBufferChannel) + capacity);
+  if (memory == NULL) {
+    return NULL;
+  }
+  MutexLocker ml(mutex_);
+  RingBufferChannel* channel = new (memory) RingBufferChannel(capacity);
+  channel->next_ = channels_;
+  channels_ = channel;
+  return channel;
+}
+
+RingBufferChannel* RingBufferChannel::Attach(int64_t id) {
+  MutexLocker ml(mutex_);
+  for (RingBufferChannel* channel = channels_; channel != NULL;
+       channel = channel->next_) {
+    if (channel->id_ == id) {
+      channel->ref_count_++;
+      return channel;
+    }
+  }
+  return NULL;
+}
+
+void RingBufferChannel::Release() {
+  {
+    // References are only dropped when the Dart objects holding them are
+    // finalized, so taking the lock here is cheap enough and keeps Attach
+    // from reviving a channel that is being freed.
+    MutexLocker ml(mutex_);
+    ASSERT(ref_count_ > 0);
+    if (--ref_count_ > 0) {
+      return;
+    }
+    RingBufferChannel** link = &channels_;
+    while (*link != this) {
+      link = &(*link)->next_;
+    }
+    *link = next_;
+  }
+  this->~RingBufferChannel();
+  free(this);
+}
+
+intptr_t RingBufferChannel::Write(const uint8_t* bytes, intptr_t length) {
+  const uword head = AtomicOperations::LoadAcquire(&head_);
+  const uword tail = AtomicOperations::LoadRelaxed(&tail_);
+  const intptr_t count =
+      Utils::Minimum(length, capacity_ - static_cast<intptr_t>(tail - head));
+  if (count == 0) {
+    return 0;
+  }
+  const intptr_t start = static_cast<intptr_t>(tail) & (capacity_ - 1);
+  const intptr_t first = Utils::Minimum(count, capacity_ - start);
+  memmove(data() + start, bytes, first);
+  memmove(data(), bytes + first, count - first);
+  AtomicOperations::StoreRelease(&tail_, tail + count);
+
+  // The compare-and-swap orders the store of tail_ above before the read of
+  // notify_, matching the consumer which sets notify_ before it reads tail_.
+  if (AtomicOperations::CompareAndSwapUint32(&notify_, 1, 0) == 1) {
+    // The consumer is idle, so this is rare enough to take the lock.
+    Dart_Port port;
+    {
+      MutexLocker ml(mutex_);
+      port = notify_port_;
+    }
+    PortMap::PostMessage(
+        new Message(port, Object::null(), Message::kNormalPriority));
+  }
+  return count;
+}
+
+intptr_t RingBufferChannel::Read(uint8_t* bytes, intptr_t length) {
+  const uword tail = AtomicOperations::LoadAcquire(&tail_);
+  const uword head = AtomicOperations::LoadRelaxed(&head_);
+  const intptr_t count =
+      Utils::Minimum(length, static_cast<intptr_t>(tail - head));
+  if (count == 0) {
+    return 0;
+  }
+  const intptr_t start = static_cast<intptr_t>(head) & (capacity_ - 1);
+  const intptr_t first = Utils::Minimum(count, capacity_ - start);
+  memmove(bytes, data() + start, first);
+  memmove(bytes + first, data(), count - first);
+  AtomicOperations::StoreRelease(&head_, head + count);
+  return count;
+}
+
+bool RingBufferChannel::NotifyWhenReadable(Dart_Port port) {
+  {
+    MutexLocker ml(mutex_);
+    notify_port_ = port;
+  }
+  // The compare-and-swap is a full barrier, so notify_ is set before tail_
+  // is read below, even if an earlier request is still pending.
+  AtomicOperations::CompareAndSwapUint32(&notify_, 0, 1);
+  if (AtomicOperations::LoadAcquire(&tail_) ==
+      AtomicOperations::LoadRelaxed(&head_)) {
+    return true;
+  }
+  // Data arrived in the meantime. If the producer has not seen the request
+  // yet, withdraw it; otherwise its message is already on the way.
+  AtomicOperations::CompareAndSwapUint32(&notify_, 1, 0);
+  return false;
+}
+
+}  // namespace dart
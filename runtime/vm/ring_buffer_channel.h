@@ -0,0 +1,91 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_RING_BUFFER_CHANNEL_H_
+#define RUNTIME_VM_RING_BUFFER_CHANNEL_H_
+
+#include "include/dart_api.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/allocation.h"
+
+namespace dart {
+
+// Forward declarations.
+class Mutex;
+
+// A single-producer single-consumer ring of bytes in malloc'ed memory which
+// isolates can share. The producer and the consumer each only update their
+// own position, so reading and writing never take a lock. The consumer can
+// ask to have a message posted to one of its ports when it finds the ring
+// empty, which is the only time the port machinery gets involved.
+//
+// The ring lives in the same allocation as this header, just after it, so
+// the Dart side can hold it as an external Uint8List and get back to the
+// channel with FromData().
+class RingBufferChannel {
+ public:
+  static const intptr_t kMaxCapacity = 1 << 30;
+
+  // Creates a channel holding at least |capacity| bytes with a reference
+  // count of one, or returns NULL if the memory cannot be allocated.
+  // |capacity| must not exceed kMaxCapacity.
+  static RingBufferChannel* New(intptr_t capacity);
+
+  // Returns the live channel with the given id with one more reference,
+  // or NULL if it has been freed already.
+  static RingBufferChannel* Attach(int64_t id);
+
+  static RingBufferChannel* FromData(uint8_t* data) {
+    return reinterpret_cast<RingBufferChannel*>(data) - 1;
+  }
+
+  void Release();
+
+  int64_t id() const { return id_; }
+  intptr_t capacity() const { return capacity_; }
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  // Producer side. Copies as many bytes as fit and returns their number.
+  intptr_t Write(const uint8_t* bytes, intptr_t length);
+
+  // Consumer side. Copies up to |length| available bytes and returns their
+  // number.
+  intptr_t Read(uint8_t* bytes, intptr_t length);
+
+  // Consumer side. Arranges for a null message to be posted to |port| on
+  // the next write and returns true, unless there is data to read already.
+  bool NotifyWhenReadable(Dart_Port port);
+
+  static void Init();
+  static void Cleanup();
+
+ private:
+  explicit RingBufferChannel(intptr_t capacity);
+
+  static Mutex* mutex_;  // Protects the list of live channels.
+  static RingBufferChannel* channels_;
+  static int64_t next_id_;
+
+  const int64_t id_;
+  const intptr_t capacity_;  // A power of two.
+  intptr_t ref_count_;
+  RingBufferChannel* next_;
+
+  // Total bytes read and written. Only the consumer updates head_ and only
+  // the producer updates tail_.
+  uword head_;
+  uword tail_;
+
+  // Set by the consumer when it wants to be notified of the next write, and
+  // cleared by whichever side gets to it first.
+  uint32_t notify_;
+  Dart_Port notify_port_;
+
+  DISALLOW_COPY_AND_ASSIGN(RingBufferChannel);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_RING_BUFFER_CHANNEL_H_
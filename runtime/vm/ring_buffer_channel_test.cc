@@ -0,0 +1,54 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ring_buffer_channel.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(RingBufferChannel_WriteRead) {
+  RingBufferChannel* channel = RingBufferChannel::New(6);
+  EXPECT_EQ(8, channel->capacity());
+
+  const uint8_t input[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  uint8_t output[10] = {0};
+  EXPECT_EQ(0, channel->Read(output, 10));
+  EXPECT_EQ(8, channel->Write(input, 10));
+  EXPECT_EQ(0, channel->Write(input, 1));
+  EXPECT_EQ(5, channel->Read(output, 5));
+  EXPECT_EQ(5, output[4]);
+
+  // This write wraps around the end of the ring.
+  EXPECT_EQ(5, channel->Write(input + 5, 5));
+  EXPECT_EQ(8, channel->Read(output, 10));
+  EXPECT_EQ(6, output[0]);
+  EXPECT_EQ(8, output[2]);
+  EXPECT_EQ(6, output[3]);
+  EXPECT_EQ(10, output[7]);
+  EXPECT_EQ(0, channel->Read(output, 10));
+  channel->Release();
+}
+
+VM_UNIT_TEST_CASE(RingBufferChannel_Attach) {
+  RingBufferChannel* channel = RingBufferChannel::New(16);
+  const int64_t id = channel->id();
+  EXPECT_EQ(channel, RingBufferChannel::Attach(id));
+  EXPECT_EQ(channel, RingBufferChannel::FromData(channel->data()));
+  channel->Release();
+  channel->Release();
+  EXPECT(RingBufferChannel::Attach(id) == NULL);
+}
+
+VM_UNIT_TEST_CASE(RingBufferChannel_NotifyWhenReadable) {
+  RingBufferChannel* channel = RingBufferChannel::New(16);
+  // Nothing listens on the illegal port, so the notification is dropped.
+  EXPECT(channel->NotifyWhenReadable(ILLEGAL_PORT));
+  const uint8_t input[] = {1, 2};
+  EXPECT_EQ(2, channel->Write(input, 2));
+  EXPECT(!channel->NotifyWhenReadable(ILLEGAL_PORT));
+  channel->Release();
+}
+
+}  // namespace dart
@@ -27,6 +27,7 @@
 #include "vm/stack_frame.h"
 #include "vm/symbols.h"
 #include "vm/thread_registry.h"
+#include "vm/timeline.h"
 #include "vm/type_testing_stubs.h"
 
 namespace dart {
@@ -59,6 +60,11 @@ DECLARE_FLAG(bool, trace_optimizing_compiler);
 DECLARE_FLAG(int, max_polymorphic_checks);
 
 DEFINE_FLAG(bool, trace_osr, false, "Trace attempts at on-stack replacement.");
+DEFINE_FLAG(bool,
+            background_osr,
+            true,
+            "Compile OSR code in the background compiler, entering it once "
+            "it is ready instead of compiling it on the mutator.");
 
 DEFINE_FLAG(int, gc_every, 0, "Run major GC on every N stack overflow checks");
 DEFINE_FLAG(int,
@@ -2032,11 +2038,31 @@ static void HandleOSRRequest(Thread* thread) {
                  function.usage_counter());
   }
 
-  // Since the code is referenced from the frame and the ZoneHandle,
-  // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  ThrowIfError(result);
+  Object& result = Object::Handle();
+  if (FLAG_background_osr && FLAG_background_compilation &&
+      (isolate->optimizing_background_compiler() != NULL) &&
+      !BackgroundCompiler::IsDisabled(isolate, /*optimizing_compiler=*/true) &&
+      function.is_background_optimizable()) {
+    result = isolate->optimizing_background_compiler()->TakeOsrCode(function,
+                                                                    osr_id);
+    if (result.IsNull()) {
+      // Keep running the unoptimized code until the OSR code is ready; its
+      // readiness raises the usage counter again.
+      BackgroundCompiler::Start(isolate);
+      function.SetUsageCounter(INT_MIN);
+      isolate->optimizing_background_compiler()->CompileOsr(function, osr_id);
+      return;
+    }
+    if (FLAG_trace_osr) {
+      OS::PrintErr("Entering background OSR code for %s at id=%" Pd "\n",
+                   function.ToFullyQualifiedCString(), osr_id);
+    }
+  } else {
+    // Since the code is referenced from the frame and the ZoneHandle,
+    // it cannot have been removed from the function.
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    ThrowIfError(result);
+  }
 
   if (!result.IsNull()) {
     const Code& code = Code::Cast(result);
@@ -2116,6 +2142,30 @@ DEFINE_RUNTIME_ENTRY(TraceICCall, 2) {
                ic_data.NumberOfChecks(), function.ToFullyQualifiedCString());
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Records in the compiler timeline stream that [function] became hot enough
+// to move to the next tier.
+static void RecordTierUp(const Function& function, bool optimizing) {
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetCompilerStream()->StartEvent();
+  if (event == NULL) {
+    return;
+  }
+  const char* tier = "unoptimized";
+  if (optimizing) {
+    tier = function.HasOptimizedCode() ? "reoptimized" : "optimized";
+  }
+  event->Instant("TierUp");
+  event->SetNumArguments(3);
+  event->CopyArgument(0, "function", function.ToFullyQualifiedCString());
+  event->CopyArgument(1, "tier", tier);
+  event->FormatArgument(2, "usageCounter", "%" Pd,
+                        static_cast<intptr_t>(function.usage_counter()));
+  event->Complete();
+#endif  // defined(SUPPORT_TIMELINE)
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 // This is called from function that needs to be optimized.
 // The requesting function can be already optimized (reoptimization).
 // Returns the Code object where to continue execution.
@@ -2131,6 +2181,7 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
 
   if ((!optimizing_compilation) ||
       Compiler::CanOptimizeFunction(thread, function)) {
+    RecordTierUp(function, optimizing_compilation);
     if (FLAG_background_compilation) {
       if (FLAG_enable_inlining_annotations) {
         FATAL("Cannot enable inlining annotations and background compilation");
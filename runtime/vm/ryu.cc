@@ -0,0 +1,902 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ryu.h"
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+
+namespace dart {
+
+static const int kMantissaBits = 52;
+static const int kExponentBits = 11;
+static const int kExponentBias = 1023;
+static const int kPow5InvBitCount = 125;
+static const int kPow5BitCount = 125;
+
+// kPow5InvSplit[i] is floor(2^(pow5bits(i) - 1 + 125) / 5^i) + 1 and
+// kPow5Split[i] is 5^i scaled to 125 bits, both as {low, high} halves.
+static const uint64_t kPow5InvSplit[][2] = {
+    {DART_UINT64_C(0x0000000000000001), DART_UINT64_C(0x2000000000000000)},
+    {DART_UINT64_C(0x999999999999999a), DART_UINT64_C(0x1999999999999999)},
+    {DART_UINT64_C(0x47ae147ae147ae15), DART_UINT64_C(0x147ae147ae147ae1)},
+    {DART_UINT64_C(0x6c8b4395810624de), DART_UINT64_C(0x10624dd2f1a9fbe7)},
+    {DART_UINT64_C(0x7a786c226809d496), DART_UINT64_C(0x1a36e2eb1c432ca5)},
+    {DART_UINT64_C(0x61f9f01b866e43ab), DART_UINT64_C(0x14f8b588e368f084)},
+    {DART_UINT64_C(0xb4c7f34938583622), DART_UINT64_C(0x10c6f7a0b5ed8d36)},
+    {DART_UINT64_C(0x87a6520ec08d236a), DART_UINT64_C(0x1ad7f29abcaf4857)},
+    {DART_UINT64_C(0x9fb841a566d74f88), DART_UINT64_C(0x15798ee2308c39df)},
+    {DART_UINT64_C(0xe62d01511f12a607), DART_UINT64_C(0x112e0be826d694b2)},
+    {DART_UINT64_C(0xd6ae6881cb5109a4), DART_UINT64_C(0x1b7cdfd9d7bdbab7)},
+    {DART_UINT64_C(0xdef1ed34a2a73aea), DART_UINT64_C(0x15fd7fe17964955f)},
+    {DART_UINT64_C(0x7f27f0f6e885c8bb), DART_UINT64_C(0x119799812dea1119)},
+    {DART_UINT64_C(0x650cb4be40d60df8), DART_UINT64_C(0x1c25c268497681c2)},
+    {DART_UINT64_C(0xea70909833de7193), DART_UINT64_C(0x16849b86a12b9b01)},
+    {DART_UINT64_C(0x21f3a6e0297ec143), DART_UINT64_C(0x1203af9ee756159b)},
+    {DART_UINT64_C(0x6985d7cd0f313537), DART_UINT64_C(0x1cd2b297d889bc2b)},
+    {DART_UINT64_C(0x2137dfd73f5a90f9), DART_UINT64_C(0x170ef54646d49689)},
+    {DART_UINT64_C(0xe75fe645cc4873fa), DART_UINT64_C(0x12725dd1d243aba0)},
+    {DART_UINT64_C(0xa5663d3c7a0d865d), DART_UINT64_C(0x1d83c94fb6d2ac34)},
+    {DART_UINT64_C(0x511e976394d79eb1), DART_UINT64_C(0x179ca10c9242235d)},
+    {DART_UINT64_C(0xda7edf82dd794bc1), DART_UINT64_C(0x12e3b40a0e9b4f7d)},
+    {DART_UINT64_C(0x2a6498d1625bac68), DART_UINT64_C(0x1e392010175ee596)},
+    {DART_UINT64_C(0xeeb6e0a781e2f053), DART_UINT64_C(0x182db34012b25144)},
+    {DART_UINT64_C(0x58924d52ce4f26a9), DART_UINT64_C(0x1357c299a88ea76a)},
+    {DART_UINT64_C(0x27507bb7b07ea441), DART_UINT64_C(0x1ef2d0f5da7dd8aa)},
+    {DART_UINT64_C(0x52a6c95fc0655034), DART_UINT64_C(0x18c240c4aecb13bb)},
+    {DART_UINT64_C(0x0eebd44c99eaa690), DART_UINT64_C(0x13ce9a36f23c0fc9)},
+    {DART_UINT64_C(0xb17953adc3110a80), DART_UINT64_C(0x1fb0f6be50601941)},
+    {DART_UINT64_C(0xc12ddc8b02740867), DART_UINT64_C(0x195a5efea6b34767)},
+    {DART_UINT64_C(0x3424b06f3529a052), DART_UINT64_C(0x14484bfeebc29f86)},
+    {DART_UINT64_C(0x901d59f290ee19db), DART_UINT64_C(0x1039d66589687f9e)},
+    {DART_UINT64_C(0x4cfbc31db4b0295f), DART_UINT64_C(0x19f623d5a8a73297)},
+    {DART_UINT64_C(0x3d9635b15d59bab2), DART_UINT64_C(0x14c4e977ba1f5bac)},
+    {DART_UINT64_C(0x97ab5e277de16228), DART_UINT64_C(0x109d8792fb4c4956)},
+    {DART_UINT64_C(0xf2abc9d8c9689d0d), DART_UINT64_C(0x1a95a5b7f87a0ef0)},
+    {DART_UINT64_C(0x5bbca17a3aba173e), DART_UINT64_C(0x154484932d2e725a)},
+    {DART_UINT64_C(0xafca1ac82efb45cb), DART_UINT64_C(0x11039d428a8b8eae)},
+    {DART_UINT64_C(0xb2dcf7a6b1920945), DART_UINT64_C(0x1b38fb9daa78e44a)},
+    {DART_UINT64_C(0xf57d92ebc141a104), DART_UINT64_C(0x15c72fb1552d836e)},
+    {DART_UINT64_C(0xc46475896767b403), DART_UINT64_C(0x116c262777579c58)},
+    {DART_UINT64_C(0x6d6d88dbd8a5ecd2), DART_UINT64_C(0x1be03d0bf225c6f4)},
+    {DART_UINT64_C(0x8abe071646eb23db), DART_UINT64_C(0x164cfda3281e38c3)},
+    {DART_UINT64_C(0x6efe6c11d255b649), DART_UINT64_C(0x11d7314f534b609c)},
+    {DART_UINT64_C(0xb197134fb6ef8a0e), DART_UINT64_C(0x1c8b821885456760)},
+    {DART_UINT64_C(0x27ac0f72f8bfa1a5), DART_UINT64_C(0x16d601ad376ab91a)},
+    {DART_UINT64_C(0xb95672c260994e1e), DART_UINT64_C(0x1244ce242c5560e1)},
+    {DART_UINT64_C(0xf5571e03cdc21695), DART_UINT64_C(0x1d3ae36d13bbce35)},
+    {DART_UINT64_C(0x2aac18030b01abab), DART_UINT64_C(0x17624f8a762fd82b)},
+    {DART_UINT64_C(0xbbbce0026f348956), DART_UINT64_C(0x12b50c6ec4f31355)},
+    {DART_UINT64_C(0x92c7ccd0b1eda889), DART_UINT64_C(0x1dee7a4ad4b81eef)},
+    {DART_UINT64_C(0xdbd30a408e57ba07), DART_UINT64_C(0x17f1fb6f10934bf2)},
+    {DART_UINT64_C(0x7ca8d50071dfc806), DART_UINT64_C(0x1327fc58da0f6ff5)},
+    {DART_UINT64_C(0xfaa7bb33e9660cd6), DART_UINT64_C(0x1ea6608e29b24cbb)},
+    {DART_UINT64_C(0x9552fc298784d711), DART_UINT64_C(0x18851a0b548ea3c9)},
+    {DART_UINT64_C(0xaaa8c9bad2d0ac0e), DART_UINT64_C(0x139dae6f76d88307)},
+    {DART_UINT64_C(0xdddadc5e1e1aace3), DART_UINT64_C(0x1f62b0b257c0d1a5)},
+    {DART_UINT64_C(0x7e48b04b4b488a4f), DART_UINT64_C(0x191bc08eac9a4151)},
+    {DART_UINT64_C(0xcb6d59d5d5d3a1d9), DART_UINT64_C(0x141633a556e1cdda)},
+    {DART_UINT64_C(0x3c577b1177dc817b), DART_UINT64_C(0x1011c2eaabe7d7e2)},
+    {DART_UINT64_C(0xc6f25e825960cf2a), DART_UINT64_C(0x19b604aaaca62636)},
+    {DART_UINT64_C(0x6bf518684780a5bb), DART_UINT64_C(0x14919d5556eb51c5)},
+    {DART_UINT64_C(0x232a79ed06008496), DART_UINT64_C(0x10747ddddf22a7d1)},
+    {DART_UINT64_C(0xd1dd8fe1a3340756), DART_UINT64_C(0x1a53fc9631d10c81)},
+    {DART_UINT64_C(0xa7e4731ae8f66c45), DART_UINT64_C(0x150ffd44f4a73d34)},
+    {DART_UINT64_C(0x531d28e253f8569e), DART_UINT64_C(0x10d9976a5d52975d)},
+    {DART_UINT64_C(0xeb61db03b98d5762), DART_UINT64_C(0x1af5bf109550f22e)},
+    {DART_UINT64_C(0xbc4e48cfc7a445e8), DART_UINT64_C(0x159165a6ddda5b58)},
+    {DART_UINT64_C(0x6371d3d96c836b20), DART_UINT64_C(0x11411e1f17e1e2ad)},
+    {DART_UINT64_C(0x9f1c8628ad9f11cd), DART_UINT64_C(0x1b9b6364f3030448)},
+    {DART_UINT64_C(0xe5b06b53be18db0b), DART_UINT64_C(0x1615e91d8f359d06)},
+    {DART_UINT64_C(0xeaf3890fcb4715a2), DART_UINT64_C(0x11ab20e472914a6b)},
+    {DART_UINT64_C(0x44b8db4c7871bc37), DART_UINT64_C(0x1c45016d841baa46)},
+    {DART_UINT64_C(0x03c715d6c6c1635f), DART_UINT64_C(0x169d9abe03495505)},
+    {DART_UINT64_C(0x3638de456bcde919), DART_UINT64_C(0x1217aefe69077737)},
+    {DART_UINT64_C(0x56c163a2461641c1), DART_UINT64_C(0x1cf2b1970e725858)},
+    {DART_UINT64_C(0xdf011c81d1ab67ce), DART_UINT64_C(0x17288e1271f51379)},
+    {DART_UINT64_C(0x7f3416ce4155eca5), DART_UINT64_C(0x1286d80ec190dc61)},
+    {DART_UINT64_C(0x6520247d3556476e), DART_UINT64_C(0x1da48ce468e7c702)},
+    {DART_UINT64_C(0xea801d30f7783925), DART_UINT64_C(0x17b6d71d20b96c01)},
+    {DART_UINT64_C(0xbb99b0f3f92cfa84), DART_UINT64_C(0x12f8ac174d612334)},
+    {DART_UINT64_C(0x5f5c4e532847f739), DART_UINT64_C(0x1e5aacf215683854)},
+    {DART_UINT64_C(0x7f7d0b75b9d32c2e), DART_UINT64_C(0x18488a5b44536043)},
+    {DART_UINT64_C(0x9930d5f7c7dc2358), DART_UINT64_C(0x136d3b7c36a919cf)},
+    {DART_UINT64_C(0x8eb4898c72f9d226), DART_UINT64_C(0x1f152bf9f10e8fb2)},
+    {DART_UINT64_C(0x722a07a38f2e41b8), DART_UINT64_C(0x18ddbcc7f40ba628)},
+    {DART_UINT64_C(0xc1bb394fa5be9afa), DART_UINT64_C(0x13e497065cd61e86)},
+    {DART_UINT64_C(0x9c5ec2190930f7f6), DART_UINT64_C(0x1fd424d6faf030d7)},
+    {DART_UINT64_C(0x49e56814075a5ff8), DART_UINT64_C(0x197683df2f268d79)},
+    {DART_UINT64_C(0x6e51201005e1e660), DART_UINT64_C(0x145ecfe5bf520ac7)},
+    {DART_UINT64_C(0xf1da800cd181851a), DART_UINT64_C(0x104bd984990e6f05)},
+    {DART_UINT64_C(0x4fc400148268d4f5), DART_UINT64_C(0x1a12f5a0f4e3e4d6)},
+    {DART_UINT64_C(0xd96999aa01ed772b), DART_UINT64_C(0x14dbf7b3f71cb711)},
+    {DART_UINT64_C(0xadee1488018ac5bc), DART_UINT64_C(0x10aff95cc5b09274)},
+    {DART_UINT64_C(0x497ceda668de092c), DART_UINT64_C(0x1ab328946f80ea54)},
+    {DART_UINT64_C(0x3aca57b853e4d424), DART_UINT64_C(0x155c2076bf9a5510)},
+    {DART_UINT64_C(0x623b7960431d7683), DART_UINT64_C(0x1116805effaeaa73)},
+    {DART_UINT64_C(0x9d2bf566d1c8bd9e), DART_UINT64_C(0x1b5733cb32b110b8)},
+    {DART_UINT64_C(0x7dbcc452416d647f), DART_UINT64_C(0x15df5ca28ef40d60)},
+    {DART_UINT64_C(0xcafd69db678ab6cc), DART_UINT64_C(0x117f7d4ed8c33de6)},
+    {DART_UINT64_C(0xab2f0fc572778adf), DART_UINT64_C(0x1bff2ee48e052fd7)},
+    {DART_UINT64_C(0x88f273045b92d580), DART_UINT64_C(0x1665bf1d3e6a8cac)},
+    {DART_UINT64_C(0xd3f528d049424466), DART_UINT64_C(0x11eaff4a98553d56)},
+    {DART_UINT64_C(0xb988414d4203a0a3), DART_UINT64_C(0x1cab3210f3bb9557)},
+    {DART_UINT64_C(0x6139cdd76802e6e9), DART_UINT64_C(0x16ef5b40c2fc7779)},
+    {DART_UINT64_C(0xe761717920025254), DART_UINT64_C(0x125915cd68c9f92d)},
+    {DART_UINT64_C(0xa568b58e999d5086), DART_UINT64_C(0x1d5b561574765b7c)},
+    {DART_UINT64_C(0x5120913ee14aa6d2), DART_UINT64_C(0x177c44ddf6c515fd)},
+    {DART_UINT64_C(0xa74d40ff1aa21f0e), DART_UINT64_C(0x12c9d0b1923744ca)},
+    {DART_UINT64_C(0x0baece64f769cb4a), DART_UINT64_C(0x1e0fb44f50586e11)},
+    {DART_UINT64_C(0x3c8bd850c5ee3c3b), DART_UINT64_C(0x180c903f7379f1a7)},
+    {DART_UINT64_C(0xca0979da37f1c9c9), DART_UINT64_C(0x133d4032c2c7f485)},
+    {DART_UINT64_C(0xa9a8c2f6bfe942db), DART_UINT64_C(0x1ec866b79e0cba6f)},
+    {DART_UINT64_C(0x2153cf2bccba9be3), DART_UINT64_C(0x18a0522c7e709526)},
+    {DART_UINT64_C(0x1aa9728970954982), DART_UINT64_C(0x13b374f06526ddb8)},
+    {DART_UINT64_C(0xf775840f1a88759d), DART_UINT64_C(0x1f8587e7083e2f8c)},
+    {DART_UINT64_C(0x5f9136727ba05e17), DART_UINT64_C(0x19379fec0698260a)},
+    {DART_UINT64_C(0x1940f85b9619e4df), DART_UINT64_C(0x142c7ff0054684d5)},
+    {DART_UINT64_C(0xe100c6afab47ea4c), DART_UINT64_C(0x1023998cd1053710)},
+    {DART_UINT64_C(0xce67a44c453fdd47), DART_UINT64_C(0x19d28f47b4d524e7)},
+    {DART_UINT64_C(0xd852e9d69dccb106), DART_UINT64_C(0x14a8729fc3ddb71f)},
+    {DART_UINT64_C(0x79dbee454b0a2738), DART_UINT64_C(0x1086c219697e2c19)},
+    {DART_UINT64_C(0x295fe3a211a9d859), DART_UINT64_C(0x1a71368f0f30468f)},
+    {DART_UINT64_C(0xbab31c81a7bb137a), DART_UINT64_C(0x15275ed8d8f36ba5)},
+    {DART_UINT64_C(0x6228e39aec95a92f), DART_UINT64_C(0x10ec4be0ad8f8951)},
+    {DART_UINT64_C(0x9d0e38f7e0ef7517), DART_UINT64_C(0x1b13ac9aaf4c0ee8)},
+    {DART_UINT64_C(0xb0d82d931a592a79), DART_UINT64_C(0x15a956e225d67253)},
+    {DART_UINT64_C(0x8d79be0f4847552e), DART_UINT64_C(0x11544581b7dec1dc)},
+    {DART_UINT64_C(0x158f967eda0bbb7c), DART_UINT64_C(0x1bba08cf8c979c94)},
+    {DART_UINT64_C(0x77a611ff14d62f97), DART_UINT64_C(0x162e6d72d6dfb076)},
+    {DART_UINT64_C(0xf951a7ff43de8c79), DART_UINT64_C(0x11bebdf578b2f391)},
+    {DART_UINT64_C(0xc21c3ffed2fdad8e), DART_UINT64_C(0x1c6463225ab7ec1c)},
+    {DART_UINT64_C(0x01b0333242648ad8), DART_UINT64_C(0x16b6b5b5155ff017)},
+    {DART_UINT64_C(0x0159c28e9b83a246), DART_UINT64_C(0x122bc490dde659ac)},
+    {DART_UINT64_C(0xcef604175f3903a3), DART_UINT64_C(0x1d12d41afca3c2ac)},
+    {DART_UINT64_C(0x725e69ac4c2d9c83), DART_UINT64_C(0x17424348ca1c9bbd)},
+    {DART_UINT64_C(0xf5185489d68ae39c), DART_UINT64_C(0x129b69070816e2fd)},
+    {DART_UINT64_C(0xee8d540fbdab05c6), DART_UINT64_C(0x1dc574d80cf16b2f)},
+    {DART_UINT64_C(0xbed77672fe226b05), DART_UINT64_C(0x17d12a4670c1228c)},
+    {DART_UINT64_C(0xff12c528cb4ebc04), DART_UINT64_C(0x130dbb6b8d674ed6)},
+    {DART_UINT64_C(0xcb513b74787df9a0), DART_UINT64_C(0x1e7c5f127bd87e24)},
+    {DART_UINT64_C(0x090dc929f9fe614d), DART_UINT64_C(0x18637f41fcad31b7)},
+    {DART_UINT64_C(0xa0d7d42194cb810a), DART_UINT64_C(0x1382cc34ca2427c5)},
+    {DART_UINT64_C(0x67bfb9cf5478ce77), DART_UINT64_C(0x1f37ad21436d0c6f)},
+    {DART_UINT64_C(0x1fcc94a5dd2d71f9), DART_UINT64_C(0x18f9574dcf8a7059)},
+    {DART_UINT64_C(0x7fd6dd517dbdf4c7), DART_UINT64_C(0x13faac3e3fa1f37a)},
+    {DART_UINT64_C(0xffbe2ee8c92fee0b), DART_UINT64_C(0x1ff779fd329cb8c3)},
+    {DART_UINT64_C(0x6631bf20a0f324d6), DART_UINT64_C(0x1992c7fdc216fa36)},
+    {DART_UINT64_C(0xb827cc1a1a5c1d78), DART_UINT64_C(0x14756ccb01abfb5e)},
+    {DART_UINT64_C(0x935309ae7b7ce460), DART_UINT64_C(0x105df0a267bcc918)},
+    {DART_UINT64_C(0x1eeb42b0c594a099), DART_UINT64_C(0x1a2fe76a3f9474f4)},
+    {DART_UINT64_C(0xe58902270476e6e1), DART_UINT64_C(0x14f31f8832dd2a5c)},
+    {DART_UINT64_C(0xb7a0ce859d2bebe7), DART_UINT64_C(0x10c27fa028b0eeb0)},
+    {DART_UINT64_C(0x59014a6f61dfdfd8), DART_UINT64_C(0x1ad0cc33744e4ab4)},
+    {DART_UINT64_C(0xe0cdd525e7e64cad), DART_UINT64_C(0x1573d68f903ea229)},
+    {DART_UINT64_C(0x4d7177518651d6f1), DART_UINT64_C(0x11297872d9cbb4ee)},
+    {DART_UINT64_C(0x7be8bee8d6e957e8), DART_UINT64_C(0x1b758d848fac54b0)},
+    {DART_UINT64_C(0xfcba3253df211320), DART_UINT64_C(0x15f7a46a0c89dd59)},
+    {DART_UINT64_C(0x63c8284318e74280), DART_UINT64_C(0x1192e9ee706e4aae)},
+    {DART_UINT64_C(0x060d0d3827d86a66), DART_UINT64_C(0x1c1e43171a4a1117)},
+    {DART_UINT64_C(0x6b3da42cecad21eb), DART_UINT64_C(0x167e9c127b6e7412)},
+    {DART_UINT64_C(0x88fe1cf0bd574e56), DART_UINT64_C(0x11fee341fc585cdb)},
+    {DART_UINT64_C(0x419694b462254a23), DART_UINT64_C(0x1ccb0536608d615f)},
+    {DART_UINT64_C(0x67abaa29e81dd4e9), DART_UINT64_C(0x1708d0f84d3de77f)},
+    {DART_UINT64_C(0xb95621bb2017dd87), DART_UINT64_C(0x126d73f9d764b932)},
+    {DART_UINT64_C(0xc223692b668c95a5), DART_UINT64_C(0x1d7becc2f23ac1ea)},
+    {DART_UINT64_C(0xce82ba891ed6de1d), DART_UINT64_C(0x179657025b6234bb)},
+    {DART_UINT64_C(0xa53562074bdf1818), DART_UINT64_C(0x12deac01e2b4f6fc)},
+    {DART_UINT64_C(0x3b889cd87964f359), DART_UINT64_C(0x1e3113363787f194)},
+    {DART_UINT64_C(0xfc6d4a46c783f5e1), DART_UINT64_C(0x18274291c6065adc)},
+    {DART_UINT64_C(0x30576e9f06032b1a), DART_UINT64_C(0x13529ba7d19eaf17)},
+    {DART_UINT64_C(0x1a257dcb3cd1de90), DART_UINT64_C(0x1eea92a61c311825)},
+    {DART_UINT64_C(0x481dfe3c30a7e540), DART_UINT64_C(0x18bba884e35a79b7)},
+    {DART_UINT64_C(0xd34b31c9c0865100), DART_UINT64_C(0x13c9539d82aec7c5)},
+    {DART_UINT64_C(0x5211e942cda3b4cd), DART_UINT64_C(0x1fa885c8d117a609)},
+    {DART_UINT64_C(0x74db21023e1c90a4), DART_UINT64_C(0x19539e3a40dfb807)},
+    {DART_UINT64_C(0xf715b401cb4a0d50), DART_UINT64_C(0x1442e4fb67196005)},
+    {DART_UINT64_C(0xf8de299b09080aa7), DART_UINT64_C(0x103583fc527ab337)},
+    {DART_UINT64_C(0x8e304291a80cddd7), DART_UINT64_C(0x19ef3993b72ab859)},
+    {DART_UINT64_C(0x3e8d020e200a4b13), DART_UINT64_C(0x14bf6142f8eef9e1)},
+    {DART_UINT64_C(0x653d9b3e80083c0f), DART_UINT64_C(0x10991a9bfa58c7e7)},
+    {DART_UINT64_C(0x6ec8f864000d2ce4), DART_UINT64_C(0x1a8e90f9908e0ca5)},
+    {DART_UINT64_C(0x8bd3f9e999a423ea), DART_UINT64_C(0x153eda614071a3b7)},
+    {DART_UINT64_C(0x3ca994bae1501cbb), DART_UINT64_C(0x10ff151a99f482f9)},
+    {DART_UINT64_C(0xc775bac49bb3612b), DART_UINT64_C(0x1b31bb5dc320d18e)},
+    {DART_UINT64_C(0xd2c4956a16291a89), DART_UINT64_C(0x15c162b168e70e0b)},
+    {DART_UINT64_C(0xdbd0778811ba7ba1), DART_UINT64_C(0x11678227871f3e6f)},
+    {DART_UINT64_C(0x2c80bf401c5d929b), DART_UINT64_C(0x1bd8d03f3e9863e6)},
+    {DART_UINT64_C(0xbd33cc3349e47549), DART_UINT64_C(0x16470cff6546b651)},
+    {DART_UINT64_C(0xca8fd68f6e505dd4), DART_UINT64_C(0x11d270cc51055ea7)},
+    {DART_UINT64_C(0x4419574be3b3c953), DART_UINT64_C(0x1c83e7ad4e6efdd9)},
+    {DART_UINT64_C(0x0347790982f63aa9), DART_UINT64_C(0x16cfec8aa52597e1)},
+    {DART_UINT64_C(0xcf6c60d468c4fbba), DART_UINT64_C(0x123ff06eea847980)},
+    {DART_UINT64_C(0xe57a34870e07f92a), DART_UINT64_C(0x1d331a4b10d3f59a)},
+    {DART_UINT64_C(0x512e906c0b399422), DART_UINT64_C(0x175c1508da432ae2)},
+    {DART_UINT64_C(0xda8ba6bcd5c7a9b5), DART_UINT64_C(0x12b010d3e1cf5581)},
+    {DART_UINT64_C(0x90df712e22d90f87), DART_UINT64_C(0x1de6815302e5559c)},
+    {DART_UINT64_C(0xda4c5a8b4f140c6c), DART_UINT64_C(0x17eb9aa8cf1dde16)},
+    {DART_UINT64_C(0xaea37ba2a5a9a38a), DART_UINT64_C(0x1322e220a5b17e78)},
+    {DART_UINT64_C(0x7dd25f6aa2a905a9), DART_UINT64_C(0x1e9e369aa2b59727)},
+    {DART_UINT64_C(0x97db7f888220d154), DART_UINT64_C(0x187e92154ef7ac1f)},
+    {DART_UINT64_C(0x797c6606ce80a777), DART_UINT64_C(0x139874ddd8c6234c)},
+    {DART_UINT64_C(0x8f2d700ae4010bf1), DART_UINT64_C(0x1f5a549627a36bad)},
+    {DART_UINT64_C(0x0c2459a25000d65a), DART_UINT64_C(0x191510781fb5efbe)},
+    {DART_UINT64_C(0x701d1481d99a4515), DART_UINT64_C(0x1410d9f9b2f7f2fe)},
+    {DART_UINT64_C(0xc017439b147b6a77), DART_UINT64_C(0x100d7b2e28c65bfe)},
+    {DART_UINT64_C(0xccf205c4ed9243f2), DART_UINT64_C(0x19af2b7d0e0a2cca)},
+    {DART_UINT64_C(0x0a5b37d0be0e9cc2), DART_UINT64_C(0x148c22ca71a1bd6f)},
+    {DART_UINT64_C(0x0848f973cb3ee3ce), DART_UINT64_C(0x10701bd527b4978c)},
+    {DART_UINT64_C(0xda0e5bec78649fb0), DART_UINT64_C(0x1a4cf9550c5425ac)},
+    {DART_UINT64_C(0x7b3eaff060507fc0), DART_UINT64_C(0x150a6110d6a9b7bd)},
+    {DART_UINT64_C(0x95cbbff380406633), DART_UINT64_C(0x10d51a73deee2c97)},
+    {DART_UINT64_C(0xefac665266cd7052), DART_UINT64_C(0x1aee90b964b04758)},
+    {DART_UINT64_C(0x2623850eb8a459db), DART_UINT64_C(0x158ba6fab6f36c47)},
+    {DART_UINT64_C(0x1e82d0d893b6ae49), DART_UINT64_C(0x113c85955f29236c)},
+    {DART_UINT64_C(0xfd9e1af41f8ab075), DART_UINT64_C(0x1b9408eefea838ac)},
+    {DART_UINT64_C(0x97b1af29b2d559f7), DART_UINT64_C(0x16100725988693bd)},
+    {DART_UINT64_C(0xac8e25baf5777b2c), DART_UINT64_C(0x11a66c1e139edc97)},
+    {DART_UINT64_C(0x7a7d092b2258c513), DART_UINT64_C(0x1c3d79c9b8fe2dbf)},
+    {DART_UINT64_C(0x61fda0ef4ead6a76), DART_UINT64_C(0x169794a160cb57cc)},
+    {DART_UINT64_C(0xe7fe1a590bbdeec5), DART_UINT64_C(0x1212dd4de7091309)},
+    {DART_UINT64_C(0xa6635d5b45fcb13a), DART_UINT64_C(0x1ceafbafd80e84dc)},
+    {DART_UINT64_C(0x851c4aaf6b308dc8), DART_UINT64_C(0x172262f3133ed0b0)},
+    {DART_UINT64_C(0xd0e36ef2bc26d7d4), DART_UINT64_C(0x1281e8c275cbda26)},
+    {DART_UINT64_C(0xb49f17eac6a48c86), DART_UINT64_C(0x1d9ca79d894629d7)},
+    {DART_UINT64_C(0x2a18dfef0550706b), DART_UINT64_C(0x17b08617a104ee46)},
+    {DART_UINT64_C(0x54e0b3259dd9f389), DART_UINT64_C(0x12f39e794d9d8b6b)},
+    {DART_UINT64_C(0x87cdeb6f62f65274), DART_UINT64_C(0x1e5297287c2f4578)},
+    {DART_UINT64_C(0xd30b22bf825ea85d), DART_UINT64_C(0x18421286c9bf6ac6)},
+    {DART_UINT64_C(0x0f3c1bcc684bb9e4), DART_UINT64_C(0x13680ed23aff889f)},
+    {DART_UINT64_C(0x18602c7a4079296d), DART_UINT64_C(0x1f0ce4839198da98)},
+    {DART_UINT64_C(0x46b356c833942124), DART_UINT64_C(0x18d71d360e13e213)},
+    {DART_UINT64_C(0x388f78a029434db6), DART_UINT64_C(0x13df4a91a4dcb4dc)},
+    {DART_UINT64_C(0x5a7f2766a86baf8a), DART_UINT64_C(0x1fcbaa82a1612160)},
+    {DART_UINT64_C(0x153285ebb9efbfa2), DART_UINT64_C(0x196fbb9bb44db44d)},
+    {DART_UINT64_C(0xaa8ed189618c994e), DART_UINT64_C(0x145962e2f6a4903d)},
+    {DART_UINT64_C(0xeed8a7a11ad6e10c), DART_UINT64_C(0x1047824f2bb6d9ca)},
+    {DART_UINT64_C(0x7e27729b5e249b45), DART_UINT64_C(0x1a0c03b1df8af611)},
+    {DART_UINT64_C(0xfe85f549181d4904), DART_UINT64_C(0x14d6695b193bf80d)},
+    {DART_UINT64_C(0xcb9e5dd4134aa0d0), DART_UINT64_C(0x10ab877c142ff9a4)},
+    {DART_UINT64_C(0xdf63c9535211014d), DART_UINT64_C(0x1aac0bf9b9e65c3a)},
+    {DART_UINT64_C(0x191ca10f74da6771), DART_UINT64_C(0x15566ffafb1eb02f)},
+    {DART_UINT64_C(0xadb080d92a4852c1), DART_UINT64_C(0x1111f32f2f4bc025)},
+    {DART_UINT64_C(0x15e7348eaa0d5134), DART_UINT64_C(0x1b4feb7eb212cd09)},
+    {DART_UINT64_C(0xab1f5d3eee710dc4), DART_UINT64_C(0x15d98932280f0a6d)},
+    {DART_UINT64_C(0xbc1917658b8da49d), DART_UINT64_C(0x117ad428200c0857)},
+    {DART_UINT64_C(0x2cf4f23c127c3a94), DART_UINT64_C(0x1bf7b9d9cce00d59)},
+    {DART_UINT64_C(0xf0c3f4fcdb969543), DART_UINT64_C(0x165fc7e170b33de0)},
+    {DART_UINT64_C(0x5a365d9716121103), DART_UINT64_C(0x11e6398126f5cb1a)},
+    {DART_UINT64_C(0x9056fc24f01ce804), DART_UINT64_C(0x1ca38f350b22de90)},
+    {DART_UINT64_C(0xd9df301d8ce3ecd0), DART_UINT64_C(0x16e93f5da2824ba6)},
+    {DART_UINT64_C(0xe17f59b13d8323da), DART_UINT64_C(0x125432b14ecea2eb)},
+    {DART_UINT64_C(0x68cbc2b52f38395c), DART_UINT64_C(0x1d53844ee47dd179)},
+    {DART_UINT64_C(0x53d6355dbf602de3), DART_UINT64_C(0x177603725064a794)},
+    {DART_UINT64_C(0xa9782ab165e68b1c), DART_UINT64_C(0x12c4cf8ea6b6ec76)},
+    {DART_UINT64_C(0x0f26aab56fd744fa), DART_UINT64_C(0x1e07b27dd78b13f1)},
+    {DART_UINT64_C(0x3f52222abfdf6a62), DART_UINT64_C(0x18062864ac6f4327)},
+    {DART_UINT64_C(0x65db4e88997f884e), DART_UINT64_C(0x1338205089f29c1f)},
+    {DART_UINT64_C(0x6fc54a7428cc0d4a), DART_UINT64_C(0x1ec033b40fea9365)},
+    {DART_UINT64_C(0x596aa1f68709a43b), DART_UINT64_C(0x1899c2f673220f84)},
+    {DART_UINT64_C(0xadeee7f86c07b696), DART_UINT64_C(0x13ae3591f5b4d936)},
+    {DART_UINT64_C(0x497e3ff3e00c5756), DART_UINT64_C(0x1f7d228322baf524)},
+    {DART_UINT64_C(0xd464fff64cd6ac45), DART_UINT64_C(0x1930e868e89590e9)},
+    {DART_UINT64_C(0x4383fff83d7889d1), DART_UINT64_C(0x14272053ed4473ee)},
+    {DART_UINT64_C(0xcf9cccc69793a174), DART_UINT64_C(0x101f4d0ff1038ff1)},
+    {DART_UINT64_C(0x7f6147a425b90252), DART_UINT64_C(0x19cbae7fe805b31c)},
+    {DART_UINT64_C(0xcc4dd2e9b7c7350f), DART_UINT64_C(0x14a2f1ffecd15c16)},
+    {DART_UINT64_C(0x3d0b0f215fd290d9), DART_UINT64_C(0x10825b3323dab012)},
+    {DART_UINT64_C(0x61ab4b689950e7c1), DART_UINT64_C(0x1a6a2b85062ab350)},
+    {DART_UINT64_C(0x4e22a2ba1440b967), DART_UINT64_C(0x1521bc6a6b555c40)},
+    {DART_UINT64_C(0x0b4ee894dd009453), DART_UINT64_C(0x10e7c9eebc4449cd)},
+    {DART_UINT64_C(0x1217da87c800ed51), DART_UINT64_C(0x1b0c764ac6d3a948)},
+    {DART_UINT64_C(0xdb46486ca000bdda), DART_UINT64_C(0x15a391d56bdc876c)},
+    {DART_UINT64_C(0x490506bd4ccd64af), DART_UINT64_C(0x114fa7ddefe39f8a)},
+    {DART_UINT64_C(0xa8080ac87ae23ab1), DART_UINT64_C(0x1bb2a62fe638ff43)},
+    {DART_UINT64_C(0x5339a239fbe82ef4), DART_UINT64_C(0x162884f31e93ff69)},
+    {DART_UINT64_C(0x75c7b4fb2fecf25d), DART_UINT64_C(0x11ba03f5b20fff87)},
+    {DART_UINT64_C(0x22d92191e647ea2e), DART_UINT64_C(0x1c5cd322b67fff3f)},
+    {DART_UINT64_C(0xb57a8141850654f2), DART_UINT64_C(0x16b0a8e891ffff65)},
+    {DART_UINT64_C(0xc4620101373843f5), DART_UINT64_C(0x1226ed86db3332b7)},
+    {DART_UINT64_C(0x3a366801f1f39fee), DART_UINT64_C(0x1d0b15a491eb8459)},
+    {DART_UINT64_C(0xfb5eb99b27f6198b), DART_UINT64_C(0x173c115074bc69e0)},
+    {DART_UINT64_C(0x2f7efae2865e7ad6), DART_UINT64_C(0x129674405d6387e7)},
+    {DART_UINT64_C(0xe597f7d0d6fd9156), DART_UINT64_C(0x1dbd86cd6238d971)},
+    {DART_UINT64_C(0x8479930d78cadaab), DART_UINT64_C(0x17cad23de82d7ac1)},
+    {DART_UINT64_C(0xd06142712d6f1556), DART_UINT64_C(0x1308a831868ac89a)},
+    {DART_UINT64_C(0x4d686a4eaf182222), DART_UINT64_C(0x1e74404f3daada91)},
+    {DART_UINT64_C(0xa453883ef279b4e8), DART_UINT64_C(0x185d003f6488aeda)},
+    {DART_UINT64_C(0xe9dc6cff28615d87), DART_UINT64_C(0x137d99cc506d58ae)},
+    {DART_UINT64_C(0xa960ae650d6895a4), DART_UINT64_C(0x1f2f5c7a1a488de4)},
+    {DART_UINT64_C(0xbab3beb73ded4483), DART_UINT64_C(0x18f2b061aea07183)},
+    {DART_UINT64_C(0x2ef6322c318a9d36), DART_UINT64_C(0x13f559e7bee6c136)},
+    {DART_UINT64_C(0xe4bd1d13827761f0), DART_UINT64_C(0x1feef63f97d79b89)},
+    {DART_UINT64_C(0x83ca7da9352c4e5a), DART_UINT64_C(0x198bf832dfdfafa1)},
+    {DART_UINT64_C(0x9ca1fe20f756a515), DART_UINT64_C(0x146ff9c24cb2f2e7)},
+    {DART_UINT64_C(0x4a1b31b3f9121daa), DART_UINT64_C(0x1059949b708f28b9)},
+    {DART_UINT64_C(0x435eb5ecc1b695dd), DART_UINT64_C(0x1a28edc580e50df5)},
+    {DART_UINT64_C(0x35e55e57015ede4a), DART_UINT64_C(0x14ed8b04671da4c4)},
+    {DART_UINT64_C(0xc4b77eac0118b1d5), DART_UINT64_C(0x10be08d0527e1d69)},
+    {DART_UINT64_C(0xa12597799b5ab622), DART_UINT64_C(0x1ac9a7b3b7302f0f)},
+    {DART_UINT64_C(0x4db7ac6149155e81), DART_UINT64_C(0x156e1fc2f8f358d9)},
+    {DART_UINT64_C(0xd7c6238107444b9b), DART_UINT64_C(0x1124e63593f5e0ad)},
+    {DART_UINT64_C(0x593d059b3ed3ac2b), DART_UINT64_C(0x1b6e3d2286563449)},
+    {DART_UINT64_C(0xe0fd9e15cbdc89bc), DART_UINT64_C(0x15f1ca820511c36d)},
+    {DART_UINT64_C(0xb3fe18116fe3a163), DART_UINT64_C(0x118e3b9b37416924)},
+    {DART_UINT64_C(0x866359b57fd29bd1), DART_UINT64_C(0x1c16c5c525357507)},
+    {DART_UINT64_C(0xd1e91491330ee30e), DART_UINT64_C(0x16789e3750f790d2)},
+    {DART_UINT64_C(0x74ba76da8f3f1c0b), DART_UINT64_C(0x11fa182c40c60d75)},
+    {DART_UINT64_C(0xedf72490e531c678), DART_UINT64_C(0x1cc359e067a348bb)},
+    {DART_UINT64_C(0x8b2c1d40b75b052d), DART_UINT64_C(0x1702ae4d1fb5d3c9)},
+    {DART_UINT64_C(0x6f567dcd5f7c0424), DART_UINT64_C(0x12688b70e62b0fd4)},
+    {DART_UINT64_C(0x7ef0c94898c66d06), DART_UINT64_C(0x1d74124e3d11b2ed)},
+    {DART_UINT64_C(0x98c0a106e09ebd9f), DART_UINT64_C(0x17900ea4fda7c257)},
+    {DART_UINT64_C(0x470080d24d4bcae6), DART_UINT64_C(0x12d9a550caec9b79)},
+    {DART_UINT64_C(0xd800ce1d487944a2), DART_UINT64_C(0x1e29088144adc58e)},
+    {DART_UINT64_C(0x1333d8176d2dd082), DART_UINT64_C(0x1820d39a9d57d13f)},
+    {DART_UINT64_C(0xa8f646792424a6ce), DART_UINT64_C(0x134d76154aaca765)},
+    {DART_UINT64_C(0x74bd3d8ea03aa47d), DART_UINT64_C(0x1ee25688777aa56f)},
+    {DART_UINT64_C(0x5d64313ee6955064), DART_UINT64_C(0x18b51206c5fbb78c)},
+    {DART_UINT64_C(0x4ab68dcbebaaa6b7), DART_UINT64_C(0x13c40e6bd1962c70)},
+    {DART_UINT64_C(0x1124161312aaa457), DART_UINT64_C(0x1fa01712e8f0471a)},
+    {DART_UINT64_C(0xda8344dc0eeee9df), DART_UINT64_C(0x194cdf4253f36c14)},
+    {DART_UINT64_C(0xe2029d7cd8bf2180), DART_UINT64_C(0x143d7f6843292343)},
+    {DART_UINT64_C(0x4e687dfd7a328133), DART_UINT64_C(0x103132b9cf541c36)},
+    {DART_UINT64_C(0x4a40c9959050ceb8), DART_UINT64_C(0x19e851294bb9c6bd)},
+    {DART_UINT64_C(0x0833d477a6a70bc6), DART_UINT64_C(0x14b9da876fc7d231)},
+    {DART_UINT64_C(0xa02976c61eec096b), DART_UINT64_C(0x1094aed2bfd30e8d)},
+    {DART_UINT64_C(0x004257a364acdbdf), DART_UINT64_C(0x1a877e1dffb81749)},
+    {DART_UINT64_C(0xcd01dfb5ea23e319), DART_UINT64_C(0x153931b1996012a0)},
+    {DART_UINT64_C(0x70ce4c91881cb5ae), DART_UINT64_C(0x10fa8e27ade6754d)},
+    {DART_UINT64_C(0x1ae3adb5a69455e2), DART_UINT64_C(0x1b2a7d0c4970bbaf)},
+    {DART_UINT64_C(0x7be957c4854377e8), DART_UINT64_C(0x15bb973d078d62f2)},
+    {DART_UINT64_C(0xc987796a0435f987), DART_UINT64_C(0x1162df64060ab58e)},
+    {DART_UINT64_C(0x75a58f1006bcc271), DART_UINT64_C(0x1bd1656cd67788e4)},
+    {DART_UINT64_C(0xf7b7a5a66bca3527), DART_UINT64_C(0x16411df0ab92d3e9)},
+    {DART_UINT64_C(0x5fc61e1ebca1c41f), DART_UINT64_C(0x11cdb18d560f0fee)},
+    {DART_UINT64_C(0xffa363646102d365), DART_UINT64_C(0x1c7c4f4889b1b316)},
+    {DART_UINT64_C(0x32e91c504d9bdc51), DART_UINT64_C(0x16c9d906d48e28df)},
+    {DART_UINT64_C(0x8f20e37371497d0e), DART_UINT64_C(0x123b140576d820b2)},
+    {DART_UINT64_C(0x7e9b0585820f2e7c), DART_UINT64_C(0x1d2b533bf159cdea)},
+    {DART_UINT64_C(0xcbaf379e01a5beca), DART_UINT64_C(0x1755dc2ff447d7ee)},
+    {DART_UINT64_C(0x0958f94b348498a1), DART_UINT64_C(0x12ab168cc36cacbf)},
+};
+
+static const uint64_t kPow5Split[][2] = {
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1000000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1400000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1900000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1f40000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1388000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x186a000000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1e84800000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1312d00000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x17d7840000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1dcd650000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x12a05f2000000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x174876e800000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1d1a94a200000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x12309ce540000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x16bcc41e90000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1c6bf52634000000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x11c37937e0800000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x16345785d8a00000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1bc16d674ec80000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1158e460913d0000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x15af1d78b58c4000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1b1ae4d6e2ef5000)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x10f0cf064dd59200)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x152d02c7e14af680)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x1a784379d99db420)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x108b2a2c28029094)},
+    {DART_UINT64_C(0x0000000000000000), DART_UINT64_C(0x14adf4b7320334b9)},
+    {DART_UINT64_C(0x4000000000000000), DART_UINT64_C(0x19d971e4fe8401e7)},
+    {DART_UINT64_C(0x8800000000000000), DART_UINT64_C(0x1027e72f1f128130)},
+    {DART_UINT64_C(0xaa00000000000000), DART_UINT64_C(0x1431e0fae6d7217c)},
+    {DART_UINT64_C(0xd480000000000000), DART_UINT64_C(0x193e5939a08ce9db)},
+    {DART_UINT64_C(0xc9a0000000000000), DART_UINT64_C(0x1f8def8808b02452)},
+    {DART_UINT64_C(0xbe04000000000000), DART_UINT64_C(0x13b8b5b5056e16b3)},
+    {DART_UINT64_C(0xad85000000000000), DART_UINT64_C(0x18a6e32246c99c60)},
+    {DART_UINT64_C(0xd8e6400000000000), DART_UINT64_C(0x1ed09bead87c0378)},
+    {DART_UINT64_C(0x878fe80000000000), DART_UINT64_C(0x13426172c74d822b)},
+    {DART_UINT64_C(0x6973e20000000000), DART_UINT64_C(0x1812f9cf7920e2b6)},
+    {DART_UINT64_C(0x03d0da8000000000), DART_UINT64_C(0x1e17b84357691b64)},
+    {DART_UINT64_C(0x8262889000000000), DART_UINT64_C(0x12ced32a16a1b11e)},
+    {DART_UINT64_C(0x22fb2ab400000000), DART_UINT64_C(0x178287f49c4a1d66)},
+    {DART_UINT64_C(0xabb9f56100000000), DART_UINT64_C(0x1d6329f1c35ca4bf)},
+    {DART_UINT64_C(0xcb54395ca0000000), DART_UINT64_C(0x125dfa371a19e6f7)},
+    {DART_UINT64_C(0xbe2947b3c8000000), DART_UINT64_C(0x16f578c4e0a060b5)},
+    {DART_UINT64_C(0x2db399a0ba000000), DART_UINT64_C(0x1cb2d6f618c878e3)},
+    {DART_UINT64_C(0xfc90400474400000), DART_UINT64_C(0x11efc659cf7d4b8d)},
+    {DART_UINT64_C(0x7bb4500591500000), DART_UINT64_C(0x166bb7f0435c9e71)},
+    {DART_UINT64_C(0xdaa16406f5a40000), DART_UINT64_C(0x1c06a5ec5433c60d)},
+    {DART_UINT64_C(0xa8a4de8459868000), DART_UINT64_C(0x118427b3b4a05bc8)},
+    {DART_UINT64_C(0xd2ce16256fe82000), DART_UINT64_C(0x15e531a0a1c872ba)},
+    {DART_UINT64_C(0x87819baecbe22800), DART_UINT64_C(0x1b5e7e08ca3a8f69)},
+    {DART_UINT64_C(0xf4b1014d3f6d5900), DART_UINT64_C(0x111b0ec57e6499a1)},
+    {DART_UINT64_C(0x71dd41a08f48af40), DART_UINT64_C(0x1561d276ddfdc00a)},
+    {DART_UINT64_C(0x0e549208b31adb10), DART_UINT64_C(0x1aba4714957d300d)},
+    {DART_UINT64_C(0x28f4db456ff0c8ea), DART_UINT64_C(0x10b46c6cdd6e3e08)},
+    {DART_UINT64_C(0x33321216cbecfb24), DART_UINT64_C(0x14e1878814c9cd8a)},
+    {DART_UINT64_C(0xbffe969c7ee839ed), DART_UINT64_C(0x1a19e96a19fc40ec)},
+    {DART_UINT64_C(0xf7ff1e21cf512434), DART_UINT64_C(0x105031e2503da893)},
+    {DART_UINT64_C(0xf5fee5aa43256d41), DART_UINT64_C(0x14643e5ae44d12b8)},
+    {DART_UINT64_C(0x337e9f14d3eec892), DART_UINT64_C(0x197d4df19d605767)},
+    {DART_UINT64_C(0x005e46da08ea7ab6), DART_UINT64_C(0x1fdca16e04b86d41)},
+    {DART_UINT64_C(0xa03aec4845928cb2), DART_UINT64_C(0x13e9e4e4c2f34448)},
+    {DART_UINT64_C(0xc849a75a56f72fde), DART_UINT64_C(0x18e45e1df3b0155a)},
+    {DART_UINT64_C(0x7a5c1130ecb4fbd6), DART_UINT64_C(0x1f1d75a5709c1ab1)},
+    {DART_UINT64_C(0xec798abe93f11d65), DART_UINT64_C(0x13726987666190ae)},
+    {DART_UINT64_C(0xa797ed6e38ed64bf), DART_UINT64_C(0x184f03e93ff9f4da)},
+    {DART_UINT64_C(0x517de8c9c728bdef), DART_UINT64_C(0x1e62c4e38ff87211)},
+    {DART_UINT64_C(0xd2eeb17e1c7976b5), DART_UINT64_C(0x12fdbb0e39fb474a)},
+    {DART_UINT64_C(0x87aa5ddda397d462), DART_UINT64_C(0x17bd29d1c87a191d)},
+    {DART_UINT64_C(0xe994f5550c7dc97b), DART_UINT64_C(0x1dac74463a989f64)},
+    {DART_UINT64_C(0x11fd195527ce9ded), DART_UINT64_C(0x128bc8abe49f639f)},
+    {DART_UINT64_C(0xd67c5faa71c24568), DART_UINT64_C(0x172ebad6ddc73c86)},
+    {DART_UINT64_C(0x8c1b77950e32d6c2), DART_UINT64_C(0x1cfa698c95390ba8)},
+    {DART_UINT64_C(0x57912abd28dfc639), DART_UINT64_C(0x121c81f7dd43a749)},
+    {DART_UINT64_C(0xad75756c7317b7c8), DART_UINT64_C(0x16a3a275d494911b)},
+    {DART_UINT64_C(0x98d2d2c78fdda5ba), DART_UINT64_C(0x1c4c8b1349b9b562)},
+    {DART_UINT64_C(0x9f83c3bcb9ea8794), DART_UINT64_C(0x11afd6ec0e14115d)},
+    {DART_UINT64_C(0x0764b4abe8652979), DART_UINT64_C(0x161bcca7119915b5)},
+    {DART_UINT64_C(0x493de1d6e27e73d7), DART_UINT64_C(0x1ba2bfd0d5ff5b22)},
+    {DART_UINT64_C(0x6dc6ad264d8f0866), DART_UINT64_C(0x1145b7e285bf98f5)},
+    {DART_UINT64_C(0xc938586fe0f2ca80), DART_UINT64_C(0x159725db272f7f32)},
+    {DART_UINT64_C(0x7b866e8bd92f7d20), DART_UINT64_C(0x1afcef51f0fb5eff)},
+    {DART_UINT64_C(0xad34051767bdae34), DART_UINT64_C(0x10de1593369d1b5f)},
+    {DART_UINT64_C(0x9881065d41ad19c1), DART_UINT64_C(0x15159af804446237)},
+    {DART_UINT64_C(0x7ea147f492186032), DART_UINT64_C(0x1a5b01b605557ac5)},
+    {DART_UINT64_C(0x6f24ccf8db4f3c1f), DART_UINT64_C(0x1078e111c3556cbb)},
+    {DART_UINT64_C(0x4aee003712230b27), DART_UINT64_C(0x14971956342ac7ea)},
+    {DART_UINT64_C(0xdda98044d6abcdf0), DART_UINT64_C(0x19bcdfabc13579e4)},
+    {DART_UINT64_C(0x0a89f02b062b60b6), DART_UINT64_C(0x10160bcb58c16c2f)},
+    {DART_UINT64_C(0xcd2c6c35c7b638e4), DART_UINT64_C(0x141b8ebe2ef1c73a)},
+    {DART_UINT64_C(0x8077874339a3c71d), DART_UINT64_C(0x1922726dbaae3909)},
+    {DART_UINT64_C(0xe0956914080cb8e4), DART_UINT64_C(0x1f6b0f092959c74b)},
+    {DART_UINT64_C(0x6c5d61ac8507f38e), DART_UINT64_C(0x13a2e965b9d81c8f)},
+    {DART_UINT64_C(0x4774ba17a649f072), DART_UINT64_C(0x188ba3bf284e23b3)},
+    {DART_UINT64_C(0x1951e89d8fdc6c8f), DART_UINT64_C(0x1eae8caef261aca0)},
+    {DART_UINT64_C(0x0fd3316279e9c3d9), DART_UINT64_C(0x132d17ed577d0be4)},
+    {DART_UINT64_C(0x13c7fdbb186434cf), DART_UINT64_C(0x17f85de8ad5c4edd)},
+    {DART_UINT64_C(0x58b9fd29de7d4203), DART_UINT64_C(0x1df67562d8b36294)},
+    {DART_UINT64_C(0xb7743e3a2b0e4942), DART_UINT64_C(0x12ba095dc7701d9c)},
+    {DART_UINT64_C(0xe5514dc8b5d1db92), DART_UINT64_C(0x17688bb5394c2503)},
+    {DART_UINT64_C(0xdea5a13ae3465277), DART_UINT64_C(0x1d42aea2879f2e44)},
+    {DART_UINT64_C(0x0b2784c4ce0bf38a), DART_UINT64_C(0x1249ad2594c37ceb)},
+    {DART_UINT64_C(0xcdf165f6018ef06d), DART_UINT64_C(0x16dc186ef9f45c25)},
+    {DART_UINT64_C(0x416dbf7381f2ac88), DART_UINT64_C(0x1c931e8ab871732f)},
+    {DART_UINT64_C(0x88e497a83137abd5), DART_UINT64_C(0x11dbf316b346e7fd)},
+    {DART_UINT64_C(0xeb1dbd923d8596ca), DART_UINT64_C(0x1652efdc6018a1fc)},
+    {DART_UINT64_C(0x25e52cf6cce6fc7d), DART_UINT64_C(0x1be7abd3781eca7c)},
+    {DART_UINT64_C(0x97af3c1a40105dce), DART_UINT64_C(0x1170cb642b133e8d)},
+    {DART_UINT64_C(0xfd9b0b20d0147542), DART_UINT64_C(0x15ccfe3d35d80e30)},
+    {DART_UINT64_C(0x3d01cde904199292), DART_UINT64_C(0x1b403dcc834e11bd)},
+    {DART_UINT64_C(0x462120b1a28ffb9b), DART_UINT64_C(0x1108269fd210cb16)},
+    {DART_UINT64_C(0xd7a968de0b33fa82), DART_UINT64_C(0x154a3047c694fddb)},
+    {DART_UINT64_C(0xcd93c3158e00f923), DART_UINT64_C(0x1a9cbc59b83a3d52)},
+    {DART_UINT64_C(0xc07c59ed78c09bb6), DART_UINT64_C(0x10a1f5b813246653)},
+    {DART_UINT64_C(0xb09b7068d6f0c2a3), DART_UINT64_C(0x14ca732617ed7fe8)},
+    {DART_UINT64_C(0xdcc24c830cacf34c), DART_UINT64_C(0x19fd0fef9de8dfe2)},
+    {DART_UINT64_C(0xc9f96fd1e7ec180f), DART_UINT64_C(0x103e29f5c2b18bed)},
+    {DART_UINT64_C(0x3c77cbc661e71e13), DART_UINT64_C(0x144db473335deee9)},
+    {DART_UINT64_C(0x8b95beb7fa60e598), DART_UINT64_C(0x1961219000356aa3)},
+    {DART_UINT64_C(0x6e7b2e65f8f91efe), DART_UINT64_C(0x1fb969f40042c54c)},
+    {DART_UINT64_C(0xc50cfcffbb9bb35f), DART_UINT64_C(0x13d3e2388029bb4f)},
+    {DART_UINT64_C(0xb6503c3faa82a037), DART_UINT64_C(0x18c8dac6a0342a23)},
+    {DART_UINT64_C(0xa3e44b4f95234844), DART_UINT64_C(0x1efb1178484134ac)},
+    {DART_UINT64_C(0xe66eaf11bd360d2b), DART_UINT64_C(0x135ceaeb2d28c0eb)},
+    {DART_UINT64_C(0xe00a5ad62c839075), DART_UINT64_C(0x183425a5f872f126)},
+    {DART_UINT64_C(0x980cf18bb7a47493), DART_UINT64_C(0x1e412f0f768fad70)},
+    {DART_UINT64_C(0x5f0816f752c6c8dc), DART_UINT64_C(0x12e8bd69aa19cc66)},
+    {DART_UINT64_C(0xf6ca1cb527787b13), DART_UINT64_C(0x17a2ecc414a03f7f)},
+    {DART_UINT64_C(0xf47ca3e2715699d7), DART_UINT64_C(0x1d8ba7f519c84f5f)},
+    {DART_UINT64_C(0xf8cde66d86d62026), DART_UINT64_C(0x127748f9301d319b)},
+    {DART_UINT64_C(0xf7016008e88ba830), DART_UINT64_C(0x17151b377c247e02)},
+    {DART_UINT64_C(0xb4c1b80b22ae923c), DART_UINT64_C(0x1cda62055b2d9d83)},
+    {DART_UINT64_C(0x50f91306f5ad1b65), DART_UINT64_C(0x12087d4358fc8272)},
+    {DART_UINT64_C(0xe53757c8b318623f), DART_UINT64_C(0x168a9c942f3ba30e)},
+    {DART_UINT64_C(0x9e852dbadfde7acf), DART_UINT64_C(0x1c2d43b93b0a8bd2)},
+    {DART_UINT64_C(0xa3133c94cbeb0cc1), DART_UINT64_C(0x119c4a53c4e69763)},
+    {DART_UINT64_C(0x8bd80bb9fee5cff1), DART_UINT64_C(0x16035ce8b6203d3c)},
+    {DART_UINT64_C(0xaece0ea87e9f43ee), DART_UINT64_C(0x1b843422e3a84c8b)},
+    {DART_UINT64_C(0x4d40c9294f238a75), DART_UINT64_C(0x1132a095ce492fd7)},
+    {DART_UINT64_C(0x2090fb73a2ec6d12), DART_UINT64_C(0x157f48bb41db7bcd)},
+    {DART_UINT64_C(0x68b53a508ba78856), DART_UINT64_C(0x1adf1aea12525ac0)},
+    {DART_UINT64_C(0x417144725748b536), DART_UINT64_C(0x10cb70d24b7378b8)},
+    {DART_UINT64_C(0x51cd958eed1ae283), DART_UINT64_C(0x14fe4d06de5056e6)},
+    {DART_UINT64_C(0xe640faf2a8619b24), DART_UINT64_C(0x1a3de04895e46c9f)},
+    {DART_UINT64_C(0xefe89cd7a93d00f7), DART_UINT64_C(0x1066ac2d5daec3e3)},
+    {DART_UINT64_C(0xebe2c40d938c4134), DART_UINT64_C(0x14805738b51a74dc)},
+    {DART_UINT64_C(0x26db7510f86f5181), DART_UINT64_C(0x19a06d06e2611214)},
+    {DART_UINT64_C(0x9849292a9b4592f1), DART_UINT64_C(0x100444244d7cab4c)},
+    {DART_UINT64_C(0xbe5b73754216f7ad), DART_UINT64_C(0x1405552d60dbd61f)},
+    {DART_UINT64_C(0xadf25052929cb598), DART_UINT64_C(0x1906aa78b912cba7)},
+    {DART_UINT64_C(0x996ee4673743e2ff), DART_UINT64_C(0x1f485516e7577e91)},
+    {DART_UINT64_C(0xffe54ec0828a6ddf), DART_UINT64_C(0x138d352e5096af1a)},
+    {DART_UINT64_C(0xbfdea270a32d0957), DART_UINT64_C(0x18708279e4bc5ae1)},
+    {DART_UINT64_C(0x2fd64b0ccbf84bad), DART_UINT64_C(0x1e8ca3185deb719a)},
+    {DART_UINT64_C(0x5de5eee7ff7b2f4c), DART_UINT64_C(0x1317e5ef3ab32700)},
+    {DART_UINT64_C(0x755f6aa1ff59fb1f), DART_UINT64_C(0x17dddf6b095ff0c0)},
+    {DART_UINT64_C(0x92b7454a7f3079e7), DART_UINT64_C(0x1dd55745cbb7ecf0)},
+    {DART_UINT64_C(0x5bb28b4e8f7e4c30), DART_UINT64_C(0x12a5568b9f52f416)},
+    {DART_UINT64_C(0xf29f2e22335ddf3c), DART_UINT64_C(0x174eac2e8727b11b)},
+    {DART_UINT64_C(0xef46f9aac035570b), DART_UINT64_C(0x1d22573a28f19d62)},
+    {DART_UINT64_C(0xd58c5c0ab8215667), DART_UINT64_C(0x123576845997025d)},
+    {DART_UINT64_C(0x4aef730d6629ac01), DART_UINT64_C(0x16c2d4256ffcc2f5)},
+    {DART_UINT64_C(0x9dab4fd0bfb41701), DART_UINT64_C(0x1c73892ecbfbf3b2)},
+    {DART_UINT64_C(0xa28b11e277d08e60), DART_UINT64_C(0x11c835bd3f7d784f)},
+    {DART_UINT64_C(0x8b2dd65b15c4b1f9), DART_UINT64_C(0x163a432c8f5cd663)},
+    {DART_UINT64_C(0x6df94bf1db35de77), DART_UINT64_C(0x1bc8d3f7b3340bfc)},
+    {DART_UINT64_C(0xc4bbcf772901ab0a), DART_UINT64_C(0x115d847ad000877d)},
+    {DART_UINT64_C(0x35eac354f34215cd), DART_UINT64_C(0x15b4e5998400a95d)},
+    {DART_UINT64_C(0x8365742a30129b40), DART_UINT64_C(0x1b221effe500d3b4)},
+    {DART_UINT64_C(0xd21f689a5e0ba108), DART_UINT64_C(0x10f5535fef208450)},
+    {DART_UINT64_C(0x06a742c0f58e894a), DART_UINT64_C(0x1532a837eae8a565)},
+    {DART_UINT64_C(0x4851137132f22b9d), DART_UINT64_C(0x1a7f5245e5a2cebe)},
+    {DART_UINT64_C(0xed32ac26bfd75b42), DART_UINT64_C(0x108f936baf85c136)},
+    {DART_UINT64_C(0xa87f57306fcd3212), DART_UINT64_C(0x14b378469b673184)},
+    {DART_UINT64_C(0xd29f2cfc8bc07e97), DART_UINT64_C(0x19e056584240fde5)},
+    {DART_UINT64_C(0xa3a37c1dd7584f1e), DART_UINT64_C(0x102c35f729689eaf)},
+    {DART_UINT64_C(0x8c8c5b254d2e62e6), DART_UINT64_C(0x14374374f3c2c65b)},
+    {DART_UINT64_C(0x6faf71eea079fb9f), DART_UINT64_C(0x1945145230b377f2)},
+    {DART_UINT64_C(0x0b9b4e6a48987a87), DART_UINT64_C(0x1f965966bce055ef)},
+    {DART_UINT64_C(0x674111026d5f4c94), DART_UINT64_C(0x13bdf7e0360c35b5)},
+    {DART_UINT64_C(0xc111554308b71fba), DART_UINT64_C(0x18ad75d8438f4322)},
+    {DART_UINT64_C(0x7155aa93cae4e7a8), DART_UINT64_C(0x1ed8d34e547313eb)},
+    {DART_UINT64_C(0x26d58a9c5ecf10c9), DART_UINT64_C(0x13478410f4c7ec73)},
+    {DART_UINT64_C(0xf08aed437682d4fb), DART_UINT64_C(0x1819651531f9e78f)},
+    {DART_UINT64_C(0xecada89454238a3a), DART_UINT64_C(0x1e1fbe5a7e786173)},
+    {DART_UINT64_C(0x73ec895cb4963664), DART_UINT64_C(0x12d3d6f88f0b3ce8)},
+    {DART_UINT64_C(0x90e7abb3e1bbc3fd), DART_UINT64_C(0x1788ccb6b2ce0c22)},
+    {DART_UINT64_C(0x352196a0da2ab4fd), DART_UINT64_C(0x1d6affe45f818f2b)},
+    {DART_UINT64_C(0x0134fe24885ab11e), DART_UINT64_C(0x1262dfeebbb0f97b)},
+    {DART_UINT64_C(0xc1823dadaa715d65), DART_UINT64_C(0x16fb97ea6a9d37d9)},
+    {DART_UINT64_C(0x31e2cd19150db4bf), DART_UINT64_C(0x1cba7de5054485d0)},
+    {DART_UINT64_C(0x1f2dc02fad2890f7), DART_UINT64_C(0x11f48eaf234ad3a2)},
+    {DART_UINT64_C(0xa6f9303b9872b535), DART_UINT64_C(0x1671b25aec1d888a)},
+    {DART_UINT64_C(0x50b77c4a7e8f6282), DART_UINT64_C(0x1c0e1ef1a724eaad)},
+    {DART_UINT64_C(0x5272adae8f199d91), DART_UINT64_C(0x1188d357087712ac)},
+    {DART_UINT64_C(0x670f591a32e004f6), DART_UINT64_C(0x15eb082cca94d757)},
+    {DART_UINT64_C(0x40d32f60bf980633), DART_UINT64_C(0x1b65ca37fd3a0d2d)},
+    {DART_UINT64_C(0x4883fd9c77bf03e0), DART_UINT64_C(0x111f9e62fe44483c)},
+    {DART_UINT64_C(0x5aa4fd0395aec4d8), DART_UINT64_C(0x156785fbbdd55a4b)},
+    {DART_UINT64_C(0x314e3c447b1a760e), DART_UINT64_C(0x1ac1677aad4ab0de)},
+    {DART_UINT64_C(0xded0e5aaccf089c9), DART_UINT64_C(0x10b8e0acac4eae8a)},
+    {DART_UINT64_C(0x96851f15802cac3b), DART_UINT64_C(0x14e718d7d7625a2d)},
+    {DART_UINT64_C(0xfc2666dae037d74a), DART_UINT64_C(0x1a20df0dcd3af0b8)},
+    {DART_UINT64_C(0x9d980048cc22e68e), DART_UINT64_C(0x10548b68a044d673)},
+    {DART_UINT64_C(0x84fe005aff2ba032), DART_UINT64_C(0x1469ae42c8560c10)},
+    {DART_UINT64_C(0xa63d8071bef6883e), DART_UINT64_C(0x198419d37a6b8f14)},
+    {DART_UINT64_C(0xcfcce08e2eb42a4e), DART_UINT64_C(0x1fe52048590672d9)},
+    {DART_UINT64_C(0x21e00c58dd309a70), DART_UINT64_C(0x13ef342d37a407c8)},
+    {DART_UINT64_C(0x2a580f6f147cc10d), DART_UINT64_C(0x18eb0138858d09ba)},
+    {DART_UINT64_C(0xb4ee134ad99bf150), DART_UINT64_C(0x1f25c186a6f04c28)},
+    {DART_UINT64_C(0x7114cc0ec80176d2), DART_UINT64_C(0x137798f428562f99)},
+    {DART_UINT64_C(0xcd59ff127a01d486), DART_UINT64_C(0x18557f31326bbb7f)},
+    {DART_UINT64_C(0xc0b07ed7188249a8), DART_UINT64_C(0x1e6adefd7f06aa5f)},
+    {DART_UINT64_C(0xd86e4f466f516e09), DART_UINT64_C(0x1302cb5e6f642a7b)},
+    {DART_UINT64_C(0xce89e3180b25c98b), DART_UINT64_C(0x17c37e360b3d351a)},
+    {DART_UINT64_C(0x822c5bde0def3bee), DART_UINT64_C(0x1db45dc38e0c8261)},
+    {DART_UINT64_C(0xf15bb96ac8b58575), DART_UINT64_C(0x1290ba9a38c7d17c)},
+    {DART_UINT64_C(0x2db2a7c57ae2e6d2), DART_UINT64_C(0x1734e940c6f9c5dc)},
+    {DART_UINT64_C(0x391f51b6d99ba086), DART_UINT64_C(0x1d022390f8b83753)},
+    {DART_UINT64_C(0x03b3931248014454), DART_UINT64_C(0x1221563a9b732294)},
+    {DART_UINT64_C(0x04a077d6da019569), DART_UINT64_C(0x16a9abc9424feb39)},
+    {DART_UINT64_C(0x45c895cc9081fac3), DART_UINT64_C(0x1c5416bb92e3e607)},
+    {DART_UINT64_C(0x8b9d5d9fda513cba), DART_UINT64_C(0x11b48e353bce6fc4)},
+    {DART_UINT64_C(0xae84b507d0e58be8), DART_UINT64_C(0x1621b1c28ac20bb5)},
+    {DART_UINT64_C(0x1a25e249c51eeee3), DART_UINT64_C(0x1baa1e332d728ea3)},
+    {DART_UINT64_C(0xf057ad6e1b33554d), DART_UINT64_C(0x114a52dffc679925)},
+    {DART_UINT64_C(0x6c6d98c9a2002aa1), DART_UINT64_C(0x159ce797fb817f6f)},
+    {DART_UINT64_C(0x4788fefc0a803549), DART_UINT64_C(0x1b04217dfa61df4b)},
+    {DART_UINT64_C(0x0cb59f5d8690214e), DART_UINT64_C(0x10e294eebc7d2b8f)},
+    {DART_UINT64_C(0xcfe30734e83429a1), DART_UINT64_C(0x151b3a2a6b9c7672)},
+    {DART_UINT64_C(0x83dbc9022241340a), DART_UINT64_C(0x1a6208b50683940f)},
+    {DART_UINT64_C(0xb2695da15568c086), DART_UINT64_C(0x107d457124123c89)},
+    {DART_UINT64_C(0x1f03b509aac2f0a7), DART_UINT64_C(0x149c96cd6d16cbac)},
+    {DART_UINT64_C(0x26c4a24c1573acd1), DART_UINT64_C(0x19c3bc80c85c7e97)},
+    {DART_UINT64_C(0x783ae56f8d684c03), DART_UINT64_C(0x101a55d07d39cf1e)},
+    {DART_UINT64_C(0x16499ecb70c25f03), DART_UINT64_C(0x1420eb449c8842e6)},
+    {DART_UINT64_C(0x9bdc067e4cf2f6c4), DART_UINT64_C(0x19292615c3aa539f)},
+    {DART_UINT64_C(0x82d3081de02fb476), DART_UINT64_C(0x1f736f9b3494e887)},
+    {DART_UINT64_C(0xb1c3e512ac1dd0c9), DART_UINT64_C(0x13a825c100dd1154)},
+    {DART_UINT64_C(0xde34de57572544fc), DART_UINT64_C(0x18922f31411455a9)},
+    {DART_UINT64_C(0x55c215ed2cee963b), DART_UINT64_C(0x1eb6bafd91596b14)},
+    {DART_UINT64_C(0xb5994db43c151de5), DART_UINT64_C(0x133234de7ad7e2ec)},
+    {DART_UINT64_C(0xe2ffa1214b1a655e), DART_UINT64_C(0x17fec216198ddba7)},
+    {DART_UINT64_C(0xdbbf89699de0feb6), DART_UINT64_C(0x1dfe729b9ff15291)},
+    {DART_UINT64_C(0x2957b5e202ac9f31), DART_UINT64_C(0x12bf07a143f6d39b)},
+    {DART_UINT64_C(0xf3ada35a8357c6fe), DART_UINT64_C(0x176ec98994f48881)},
+    {DART_UINT64_C(0x70990c31242db8bd), DART_UINT64_C(0x1d4a7bebfa31aaa2)},
+    {DART_UINT64_C(0x865fa79eb69c9376), DART_UINT64_C(0x124e8d737c5f0aa5)},
+    {DART_UINT64_C(0xe7f791866443b854), DART_UINT64_C(0x16e230d05b76cd4e)},
+    {DART_UINT64_C(0xa1f575e7fd54a669), DART_UINT64_C(0x1c9abd04725480a2)},
+    {DART_UINT64_C(0xa53969b0fe54e801), DART_UINT64_C(0x11e0b622c774d065)},
+    {DART_UINT64_C(0x0e87c41d3dea2202), DART_UINT64_C(0x1658e3ab7952047f)},
+    {DART_UINT64_C(0xd229b5248d64aa82), DART_UINT64_C(0x1bef1c9657a6859e)},
+    {DART_UINT64_C(0x435a1136d85eea91), DART_UINT64_C(0x117571ddf6c81383)},
+    {DART_UINT64_C(0x143095848e76a536), DART_UINT64_C(0x15d2ce55747a1864)},
+    {DART_UINT64_C(0x193cbae5b2144e83), DART_UINT64_C(0x1b4781ead1989e7d)},
+    {DART_UINT64_C(0x2fc5f4cf8f4cb112), DART_UINT64_C(0x110cb132c2ff630e)},
+    {DART_UINT64_C(0xbbb77203731fdd56), DART_UINT64_C(0x154fdd7f73bf3bd1)},
+    {DART_UINT64_C(0x2aa54e844fe7d4ac), DART_UINT64_C(0x1aa3d4df50af0ac6)},
+    {DART_UINT64_C(0xdaa75112b1f0e4eb), DART_UINT64_C(0x10a6650b926d66bb)},
+    {DART_UINT64_C(0xd15125575e6d1e26), DART_UINT64_C(0x14cffe4e7708c06a)},
+    {DART_UINT64_C(0x85a56ead360865b0), DART_UINT64_C(0x1a03fde214caf085)},
+    {DART_UINT64_C(0x7387652c41c53f8e), DART_UINT64_C(0x10427ead4cfed653)},
+    {DART_UINT64_C(0x50693e7752368f71), DART_UINT64_C(0x14531e58a03e8be8)},
+    {DART_UINT64_C(0x64838e1526c4334e), DART_UINT64_C(0x1967e5eec84e2ee2)},
+    {DART_UINT64_C(0xfda4719a70754022), DART_UINT64_C(0x1fc1df6a7a61ba9a)},
+    {DART_UINT64_C(0xde86c70086494815), DART_UINT64_C(0x13d92ba28c7d14a0)},
+    {DART_UINT64_C(0x162878c0a7db9a1a), DART_UINT64_C(0x18cf768b2f9c59c9)},
+    {DART_UINT64_C(0x5bb296f0d1d280a1), DART_UINT64_C(0x1f03542dfb83703b)},
+    {DART_UINT64_C(0x194f9e5683239064), DART_UINT64_C(0x1362149cbd322625)},
+    {DART_UINT64_C(0x5fa385ec23ec747e), DART_UINT64_C(0x183a99c3ec7eafae)},
+    {DART_UINT64_C(0xf78c67672ce7919d), DART_UINT64_C(0x1e494034e79e5b99)},
+    {DART_UINT64_C(0x3ab7c0a07c10bb02), DART_UINT64_C(0x12edc82110c2f940)},
+    {DART_UINT64_C(0x4965b0c89b14e9c3), DART_UINT64_C(0x17a93a2954f3b790)},
+    {DART_UINT64_C(0x5bbf1cfac1da2433), DART_UINT64_C(0x1d9388b3aa30a574)},
+    {DART_UINT64_C(0xb957721cb92856a0), DART_UINT64_C(0x127c35704a5e6768)},
+    {DART_UINT64_C(0xe7ad4ea3e7726c48), DART_UINT64_C(0x171b42cc5cf60142)},
+    {DART_UINT64_C(0xa198a24ce14f075a), DART_UINT64_C(0x1ce2137f74338193)},
+    {DART_UINT64_C(0x44ff65700cd16498), DART_UINT64_C(0x120d4c2fa8a030fc)},
+    {DART_UINT64_C(0x563f3ecc1005bdbe), DART_UINT64_C(0x16909f3b92c83d3b)},
+    {DART_UINT64_C(0x2bcf0e7f14072d2e), DART_UINT64_C(0x1c34c70a777a4c8a)},
+    {DART_UINT64_C(0x5b61690f6c847c3d), DART_UINT64_C(0x11a0fc668aac6fd6)},
+    {DART_UINT64_C(0xf239c35347a59b4c), DART_UINT64_C(0x16093b802d578bcb)},
+    {DART_UINT64_C(0xeec83428198f021f), DART_UINT64_C(0x1b8b8a6038ad6ebe)},
+    {DART_UINT64_C(0x553d20990ff96153), DART_UINT64_C(0x1137367c236c6537)},
+    {DART_UINT64_C(0x2a8c68bf53f7b9a8), DART_UINT64_C(0x1585041b2c477e85)},
+    {DART_UINT64_C(0x752f82ef28f5a812), DART_UINT64_C(0x1ae64521f7595e26)},
+    {DART_UINT64_C(0x093db1d57999890b), DART_UINT64_C(0x10cfeb353a97dad8)},
+    {DART_UINT64_C(0x0b8d1e4ad7ffeb4e), DART_UINT64_C(0x1503e602893dd18e)},
+    {DART_UINT64_C(0x8e7065dd8dffe622), DART_UINT64_C(0x1a44df832b8d45f1)},
+    {DART_UINT64_C(0xf9063faa78bfefd5), DART_UINT64_C(0x106b0bb1fb384bb6)},
+    {DART_UINT64_C(0xb747cf9516efebca), DART_UINT64_C(0x1485ce9e7a065ea4)},
+    {DART_UINT64_C(0xe519c37a5cabe6bd), DART_UINT64_C(0x19a742461887f64d)},
+    {DART_UINT64_C(0xaf301a2c79eb7036), DART_UINT64_C(0x1008896bcf54f9f0)},
+    {DART_UINT64_C(0xdafc20b798664c43), DART_UINT64_C(0x140aabc6c32a386c)},
+    {DART_UINT64_C(0x11bb28e57e7fdf54), DART_UINT64_C(0x190d56b873f4c688)},
+    {DART_UINT64_C(0x1629f31ede1fd72a), DART_UINT64_C(0x1f50ac6690f1f82a)},
+    {DART_UINT64_C(0x4dda37f34ad3e67a), DART_UINT64_C(0x13926bc01a973b1a)},
+    {DART_UINT64_C(0xe150c5f01d88e019), DART_UINT64_C(0x187706b0213d09e0)},
+    {DART_UINT64_C(0x19a4f76c24eb181f), DART_UINT64_C(0x1e94c85c298c4c59)},
+    {DART_UINT64_C(0xb0071aa39712ef13), DART_UINT64_C(0x131cfd3999f7afb7)},
+    {DART_UINT64_C(0x9c08e14c7cd7aad8), DART_UINT64_C(0x17e43c8800759ba5)},
+    {DART_UINT64_C(0x030b199f9c0d958e), DART_UINT64_C(0x1ddd4baa0093028f)},
+    {DART_UINT64_C(0x61e6f003c1887d79), DART_UINT64_C(0x12aa4f4a405be199)},
+    {DART_UINT64_C(0xba60ac04b1ea9cd7), DART_UINT64_C(0x1754e31cd072d9ff)},
+    {DART_UINT64_C(0xa8f8d705de65440d), DART_UINT64_C(0x1d2a1be4048f907f)},
+    {DART_UINT64_C(0xc99b8663aaff4a88), DART_UINT64_C(0x123a516e82d9ba4f)},
+    {DART_UINT64_C(0xbc0267fc95bf1d2a), DART_UINT64_C(0x16c8e5ca239028e3)},
+    {DART_UINT64_C(0xab0301fbbb2ee474), DART_UINT64_C(0x1c7b1f3cac74331c)},
+    {DART_UINT64_C(0xeae1e13d54fd4ec9), DART_UINT64_C(0x11ccf385ebc89ff1)},
+    {DART_UINT64_C(0x659a598caa3ca27b), DART_UINT64_C(0x1640306766bac7ee)},
+    {DART_UINT64_C(0xff00efefd4cbcb1a), DART_UINT64_C(0x1bd03c81406979e9)},
+    {DART_UINT64_C(0x3f6095f5e4ff5ef0), DART_UINT64_C(0x116225d0c841ec32)},
+    {DART_UINT64_C(0xcf38bb735e3f36ac), DART_UINT64_C(0x15baaf44fa52673e)},
+    {DART_UINT64_C(0x8306ea5035cf0457), DART_UINT64_C(0x1b295b1638e7010e)},
+    {DART_UINT64_C(0x11e4527221a162b6), DART_UINT64_C(0x10f9d8ede39060a9)},
+    {DART_UINT64_C(0x565d670eaa09bb64), DART_UINT64_C(0x15384f295c7478d3)},
+    {DART_UINT64_C(0x2bf4c0d2548c2a3d), DART_UINT64_C(0x1a8662f3b3919708)},
+    {DART_UINT64_C(0x1b78f88374d79a66), DART_UINT64_C(0x1093fdd8503afe65)},
+    {DART_UINT64_C(0x625736a4520d8100), DART_UINT64_C(0x14b8fd4e6449bdfe)},
+    {DART_UINT64_C(0xfaed044d6690e140), DART_UINT64_C(0x19e73ca1fd5c2d7d)},
+    {DART_UINT64_C(0xbcd422b0601a8cc8), DART_UINT64_C(0x103085e53e599c6e)},
+    {DART_UINT64_C(0x6c092b5c78212ffa), DART_UINT64_C(0x143ca75e8df0038a)},
+    {DART_UINT64_C(0x070b763396297bf8), DART_UINT64_C(0x194bd136316c046d)},
+    {DART_UINT64_C(0x48ce53c07bb3daf6), DART_UINT64_C(0x1f9ec583bdc70588)},
+    {DART_UINT64_C(0x2d80f4584d5068da), DART_UINT64_C(0x13c33b72569c6375)},
+    {DART_UINT64_C(0x78e1316e60a48310), DART_UINT64_C(0x18b40a4eec437c52)},
+};
+
+// Returns floor(log10(2^e)) for 0 <= e <= 1650.
+static inline int Log10Pow2(int e) {
+  ASSERT((e >= 0) && (e <= 1650));
+  return static_cast<int>((static_cast<uint32_t>(e) * 78913) >> 18);
+}
+
+// Returns floor(log10(5^e)) for 0 <= e <= 2620.
+static inline int Log10Pow5(int e) {
+  ASSERT((e >= 0) && (e <= 2620));
+  return static_cast<int>((static_cast<uint32_t>(e) * 732923) >> 20);
+}
+
+// Returns the number of bits of 5^e, or 1 for e == 0, for 0 <= e <= 3528.
+static inline int Pow5Bits(int e) {
+  ASSERT((e >= 0) && (e <= 3528));
+  return static_cast<int>(((static_cast<uint32_t>(e) * 1217359) >> 19) + 1);
+}
+
+static inline int Pow5Factor(uint64_t value) {
+  int count = 0;
+  while ((value % 5) == 0) {
+    value /= 5;
+    count++;
+  }
+  return count;
+}
+
+static inline bool IsMultipleOfPowerOf5(uint64_t value, int p) {
+  return Pow5Factor(value) >= p;
+}
+
+static inline bool IsMultipleOfPowerOf2(uint64_t value, int p) {
+  ASSERT((p >= 0) && (p < 64));
+  return (value & ((static_cast<uint64_t>(1) << p) - 1)) == 0;
+}
+
+// Returns the high 64 bits of a * b and stores the low ones in |low|.
+static inline uint64_t MultiplyHigh(uint64_t a, uint64_t b, uint64_t* low) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *low = static_cast<uint64_t>(product);
+  return static_cast<uint64_t>(product >> 64);
+#else
+  const uint64_t a_lo = static_cast<uint32_t>(a);
+  const uint64_t a_hi = a >> 32;
+  const uint64_t b_lo = static_cast<uint32_t>(b);
+  const uint64_t b_hi = b >> 32;
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t hi_hi = a_hi * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + static_cast<uint32_t>(hi_lo) + lo_hi;
+  *low = (cross << 32) | static_cast<uint32_t>(lo_lo);
+  return (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+}
+
+// Returns (m * mul) >> j, where mul is a 125-bit {low, high} pair and
+// 64 < j < 128.
+static inline uint64_t MulShift(uint64_t m, const uint64_t* mul, int j) {
+  ASSERT((j > 64) && (j < 128));
+  uint64_t low0;
+  const uint64_t high0 = MultiplyHigh(m, mul[0], &low0);
+  uint64_t low1;
+  uint64_t high1 = MultiplyHigh(m, mul[1], &low1);
+  // Adds high0 to the 128-bit value high1:low1.
+  const uint64_t sum = low1 + high0;
+  if (sum < high0) {
+    high1++;
+  }
+  const int shift = j - 64;
+  return (high1 << (64 - shift)) | (sum >> shift);
+}
+
+void Ryu::ShortestDecimal(double value, uint64_t* digits, int* exponent) {
+  const uint64_t bits = bit_cast<uint64_t>(value);
+  const uint64_t ieee_mantissa =
+      bits & ((static_cast<uint64_t>(1) << kMantissaBits) - 1);
+  const int ieee_exponent =
+      static_cast<int>((bits >> kMantissaBits) & ((1 << kExponentBits) - 1));
+  ASSERT((bits >> 63) == 0);
+  ASSERT(ieee_exponent != ((1 << kExponentBits) - 1));
+  ASSERT((ieee_exponent != 0) || (ieee_mantissa != 0));
+
+  // Step 1: Decode the value as m2 * 2^e2, and make room for the half-way
+  // points to the neighbouring doubles.
+  int e2;
+  uint64_t m2;
+  if (ieee_exponent == 0) {
+    e2 = 1 - kExponentBias - kMantissaBits - 2;
+    m2 = ieee_mantissa;
+  } else {
+    e2 = ieee_exponent - kExponentBias - kMantissaBits - 2;
+    m2 = (static_cast<uint64_t>(1) << kMantissaBits) | ieee_mantissa;
+  }
+  const bool accept_bounds = (m2 & 1) == 0;
+
+  // Step 2: Determine the interval of valid decimal representations,
+  // [4 * m2 - 1 - mm_shift, 4 * m2 + 2]. The lower half-way point is closer
+  // when the significand is a power of two.
+  const uint64_t mv = 4 * m2;
+  const uint32_t mm_shift = ((ieee_mantissa != 0) || (ieee_exponent <= 1));
+
+  // Step 3: Convert the interval to a decimal power base.
+  uint64_t vr, vp, vm;
+  int e10;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+  if (e2 >= 0) {
+    const int q = Log10Pow2(e2) - (e2 > 3);
+    e10 = q;
+    const int k = kPow5InvBitCount + Pow5Bits(q) - 1;
+    const int i = -e2 + q + k;
+    vr = MulShift(mv, kPow5InvSplit[q], i);
+    vp = MulShift(mv + 2, kPow5InvSplit[q], i);
+    vm = MulShift(mv - 1 - mm_shift, kPow5InvSplit[q], i);
+    if (q <= 21) {
+      // Only one of mp, mv and mm can be a multiple of 5, if any.
+      if ((mv % 5) == 0) {
+        vr_is_trailing_zeros = IsMultipleOfPowerOf5(mv, q);
+      } else if (accept_bounds) {
+        vm_is_trailing_zeros = IsMultipleOfPowerOf5(mv - 1 - mm_shift, q);
+      } else {
+        vp -= IsMultipleOfPowerOf5(mv + 2, q);
+      }
+    }
+  } else {
+    const int q = Log10Pow5(-e2) - (-e2 > 1);
+    e10 = q + e2;
+    const int i = -e2 - q;
+    const int k = Pow5Bits(i) - kPow5BitCount;
+    const int j = q - k;
+    vr = MulShift(mv, kPow5Split[i], j);
+    vp = MulShift(mv + 2, kPow5Split[i], j);
+    vm = MulShift(mv - 1 - mm_shift, kPow5Split[i], j);
+    if (q <= 1) {
+      // mv has at least two trailing zero bits, and mm has one if mm_shift
+      // is one.
+      vr_is_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_is_trailing_zeros = mm_shift == 1;
+      } else {
+        // mp = mv + 2 always has at least one trailing zero bit.
+        --vp;
+      }
+    } else if (q < 63) {
+      // The full product has at least q trailing zeros if mv has, as
+      // -e2 >= q.
+      vr_is_trailing_zeros = IsMultipleOfPowerOf2(mv, q);
+    }
+  }
+
+  // Step 4: Find the shortest decimal representation in the interval.
+  int removed = 0;
+  uint64_t output;
+  if (vm_is_trailing_zeros || vr_is_trailing_zeros) {
+    // The general case, which is rare.
+    int last_removed_digit = 0;
+    while ((vp / 10) > (vm / 10)) {
+      vm_is_trailing_zeros &= (vm % 10) == 0;
+      vr_is_trailing_zeros &= last_removed_digit == 0;
+      last_removed_digit = static_cast<int>(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+    if (vm_is_trailing_zeros) {
+      while ((vm % 10) == 0) {
+        vr_is_trailing_zeros &= last_removed_digit == 0;
+        last_removed_digit = static_cast<int>(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        removed++;
+      }
+    }
+    if (vr_is_trailing_zeros && (last_removed_digit == 5) && ((vr % 2) == 0)) {
+      // Round to even if the exact value is .....50..0.
+      last_removed_digit = 4;
+    }
+    // Take vr + 1 if vr is outside the interval or has to be rounded up.
+    output = vr + (((vr == vm) && (!accept_bounds || !vm_is_trailing_zeros)) ||
+                   (last_removed_digit >= 5));
+  } else {
+    bool round_up = false;
+    if ((vp / 100) > (vm / 100)) {
+      // Remove two digits at a time while possible.
+      round_up = (vr % 100) >= 50;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
+    while ((vp / 10) > (vm / 10)) {
+      round_up = (vr % 10) >= 5;
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+    // Take vr + 1 if vr is outside the interval or has to be rounded up.
+    output = vr + ((vr == vm) || round_up);
+  }
+  *digits = output;
+  *exponent = e10 + removed;
+}
+
+}  // namespace dart
@@ -0,0 +1,26 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_RYU_H_
+#define RUNTIME_VM_RYU_H_
+
+#include "platform/allocation.h"
+#include "platform/globals.h"
+
+namespace dart {
+
+// Shortest round-trip decimal representations of doubles, computed with
+// Ulf Adams' Ryu algorithm ("Ryu: fast float-to-string conversion", PLDI
+// 2018). Unlike Grisu3 it never needs a bignum fallback.
+class Ryu : public AllStatic {
+ public:
+  // Sets |digits| and |exponent| so that digits * 10^exponent is the decimal
+  // with the fewest digits that reads back as |value|, and among those the
+  // one closest to |value|. |value| must be finite and greater than zero.
+  static void ShortestDecimal(double value, uint64_t* digits, int* exponent);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_RYU_H_
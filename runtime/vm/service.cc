@@ -11,6 +11,7 @@
 #include "platform/unicode.h"
 #include "vm/base64.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/compiler/jit/deopt_statistics.h"
 #include "vm/cpu.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
@@ -33,6 +34,7 @@
 #include "vm/parser.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_binary.h"
 #include "vm/profiler_service.h"
 #include "vm/reusable_handles.h"
 #include "vm/service_event.h"
@@ -3796,6 +3798,16 @@ static bool GetTagProfile(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_deoptimization_statistics_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER, new BoolParameter("reset", false), NULL,
+};
+
+static bool GetDeoptimizationStatistics(Thread* thread, JSONStream* js) {
+  const bool reset = BoolParameter::Parse(js->LookupParam("reset"), false);
+  DeoptStatistics::PrintJSON(thread, js, reset);
+  return true;
+}
+
 static const char* const tags_enum_names[] = {
     "None", "UserVM", "UserOnly", "VMUser", "VMOnly", NULL,
 };
@@ -3837,6 +3849,26 @@ static bool GetCpuProfile(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_cpu_samples_binary_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new Int64Parameter("sinceMicros", false),
+    new Int64Parameter("knownCodes", false),
+    NULL,
+};
+
+static bool GetCpuSamplesBinary(Thread* thread, JSONStream* js) {
+  const int64_t since_micros =
+      Int64Parameter::Parse(js->LookupParam("sinceMicros"), 0);
+  const int64_t known_codes =
+      Int64Parameter::Parse(js->LookupParam("knownCodes"), 0);
+  if (known_codes < 0) {
+    PrintInvalidParamError(js, "knownCodes");
+    return true;
+  }
+  CpuSampleCodeTable::PrintJSON(thread, js, since_micros, known_codes);
+  return true;
+}
+
 static const MethodParameter* get_cpu_profile_timeline_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     new EnumParameter("tags", true, tags_enum_names),
@@ -4014,7 +4046,8 @@ static ObjectGraph::SnapshotRoots snapshot_roots_values[] = {
 static const MethodParameter* request_heap_snapshot_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     new EnumParameter("roots", false /* not required */, snapshot_roots_names),
-    new BoolParameter("collectGarbage", false /* not required */), NULL,
+    new BoolParameter("collectGarbage", false /* not required */),
+    new BoolParameter("streaming", false /* not required */), NULL,
 };
 
 static bool RequestHeapSnapshot(Thread* thread, JSONStream* js) {
@@ -4025,14 +4058,57 @@ static bool RequestHeapSnapshot(Thread* thread, JSONStream* js) {
   }
   const bool collect_garbage =
       BoolParameter::Parse(js->LookupParam("collectGarbage"), true);
+  const bool streaming =
+      BoolParameter::Parse(js->LookupParam("streaming"), false);
   if (Service::graph_stream.enabled()) {
-    Service::SendGraphEvent(thread, roots, collect_garbage);
+    if (streaming) {
+      Service::SendStreamingGraphEvent(thread, roots, collect_garbage);
+    } else {
+      Service::SendGraphEvent(thread, roots, collect_garbage);
+    }
   }
   // TODO(koda): Provide some id that ties this request to async response(s).
   PrintSuccess(js);
   return true;
 }
 
+void Service::SendGraphChunk(Thread* thread,
+                             intptr_t chunk_index,
+                             intptr_t chunk_count,
+                             intptr_t node_count,
+                             const uint8_t* chunk_start,
+                             intptr_t chunk_size) {
+  JSONStream js;
+  {
+    JSONObject jsobj(&js);
+    jsobj.AddProperty("jsonrpc", "2.0");
+    jsobj.AddProperty("method", "streamNotify");
+    {
+      JSONObject params(&jsobj, "params");
+      params.AddProperty("streamId", graph_stream.id());
+      {
+        JSONObject event(&params, "event");
+        event.AddProperty("type", "Event");
+        event.AddProperty("kind", "_Graph");
+        event.AddProperty("isolate", thread->isolate());
+        event.AddPropertyTimeMillis("timestamp", OS::GetCurrentTimeMillis());
+
+        event.AddProperty("chunkIndex", chunk_index);
+        // Streamed snapshots only know these once the last chunk is sent.
+        if (chunk_count >= 0) {
+          event.AddProperty("chunkCount", chunk_count);
+        }
+        if (node_count >= 0) {
+          event.AddProperty("nodeCount", node_count);
+        }
+      }
+    }
+  }
+
+  SendEventWithData(graph_stream.id(), "_Graph", js.buffer()->buf(),
+                    js.buffer()->length(), chunk_start, chunk_size);
+}
+
 void Service::SendGraphEvent(Thread* thread,
                              ObjectGraph::SnapshotRoots roots,
                              bool collect_garbage) {
@@ -4047,36 +4123,46 @@ void Service::SendGraphEvent(Thread* thread,
   intptr_t num_chunks =
       (stream.bytes_written() + (kChunkSize - 1)) / kChunkSize;
   for (intptr_t i = 0; i < num_chunks; i++) {
-    JSONStream js;
-    {
-      JSONObject jsobj(&js);
-      jsobj.AddProperty("jsonrpc", "2.0");
-      jsobj.AddProperty("method", "streamNotify");
-      {
-        JSONObject params(&jsobj, "params");
-        params.AddProperty("streamId", graph_stream.id());
-        {
-          JSONObject event(&params, "event");
-          event.AddProperty("type", "Event");
-          event.AddProperty("kind", "_Graph");
-          event.AddProperty("isolate", thread->isolate());
-          event.AddPropertyTimeMillis("timestamp", OS::GetCurrentTimeMillis());
-
-          event.AddProperty("chunkIndex", i);
-          event.AddProperty("chunkCount", num_chunks);
-          event.AddProperty("nodeCount", node_count);
-        }
-      }
-    }
-
     uint8_t* chunk_start = buffer + (i * kChunkSize);
     intptr_t chunk_size = (i + 1 == num_chunks)
                               ? stream.bytes_written() - (i * kChunkSize)
                               : kChunkSize;
 
-    SendEventWithData(graph_stream.id(), "_Graph", js.buffer()->buf(),
-                      js.buffer()->length(), chunk_start, chunk_size);
+    SendGraphChunk(thread, i, num_chunks, node_count, chunk_start, chunk_size);
+  }
+}
+
+struct StreamingGraphState {
+  Thread* thread;
+  intptr_t chunk_count;
+};
+
+void Service::StreamGraphChunk(void* callback_data,
+                               const uint8_t* buffer,
+                               intptr_t size) {
+  if (size == 0) {
+    return;
+  }
+  StreamingGraphState* state =
+      reinterpret_cast<StreamingGraphState*>(callback_data);
+  SendGraphChunk(state->thread, state->chunk_count++, -1, -1, buffer, size);
+}
+
+void Service::SendStreamingGraphEvent(Thread* thread,
+                                      ObjectGraph::SnapshotRoots roots,
+                                      bool collect_garbage) {
+  StreamingGraphState state = {thread, 0};
+  intptr_t node_count;
+  {
+    // Chunks are sent whenever the buffer fills up, so only one of them is
+    // ever held in memory.
+    StreamingWriteStream stream(1 * MB, &StreamGraphChunk, &state);
+    ObjectGraph graph(thread);
+    node_count = graph.StreamSerialize(&stream, roots, collect_garbage);
   }
+  // An empty last chunk carries the totals.
+  SendGraphChunk(thread, state.chunk_count, state.chunk_count + 1, node_count,
+                 NULL, 0);
 }
 
 void Service::SendInspectEvent(Isolate* isolate, const Object& inspectee) {
@@ -4868,8 +4954,12 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_cpu_profile_params },
   { "_getCpuProfileTimeline", GetCpuProfileTimeline,
     get_cpu_profile_timeline_params },
+  { "_getCpuSamplesBinary", GetCpuSamplesBinary,
+    get_cpu_samples_binary_params },
   { "_writeCpuProfileTimeline", WriteCpuProfileTimeline,
     write_cpu_profile_timeline_params },
+  { "_getDeoptimizationStatistics", GetDeoptimizationStatistics,
+    get_deoptimization_statistics_params },
   { "getFlagList", GetFlagList,
     get_flag_list_params },
   { "_getHeapMap", GetHeapMap,
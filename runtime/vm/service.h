@@ -124,6 +124,11 @@ class Service : public AllStatic {
   static void SendGraphEvent(Thread* thread,
                              ObjectGraph::SnapshotRoots roots,
                              bool collect_garbage);
+  // Like SendGraphEvent, but sends the snapshot while it is being written
+  // instead of building it in memory first.
+  static void SendStreamingGraphEvent(Thread* thread,
+                                      ObjectGraph::SnapshotRoots roots,
+                                      bool collect_garbage);
   static void SendInspectEvent(Isolate* isolate, const Object& inspectee);
 
   static void SendEmbedderEvent(Isolate* isolate,
@@ -218,6 +223,16 @@ class Service : public AllStatic {
                         uint8_t* bytes,
                         intptr_t bytes_length);
 
+  static void SendGraphChunk(Thread* thread,
+                             intptr_t chunk_index,
+                             intptr_t chunk_count,
+                             intptr_t node_count,
+                             const uint8_t* chunk_start,
+                             intptr_t chunk_size);
+  static void StreamGraphChunk(void* callback_data,
+                               const uint8_t* buffer,
+                               intptr_t size);
+
   // Does not take ownership of 'data'.
   static void SendEventWithData(const char* stream_id,
                                 const char* event_type,
@@ -35,6 +35,11 @@ DEFINE_FLAG(bool,
             trace_service_verbose,
             false,
             "Provide extra service tracing information.");
+DEFINE_FLAG(bool,
+            lazy_service_isolate,
+            false,
+            "Do not start the service isolate with the VM but when the "
+            "embedder asks for it with Dart_StartServiceIsolate.");
 
 // These must be kept in sync with service/constants.dart
 #define VM_SERVICE_ISOLATE_EXIT_MESSAGE_ID 0
@@ -76,6 +81,7 @@ const char* ServiceIsolate::kName = DART_VM_SERVICE_ISOLATE_NAME;
 Dart_IsolateCreateCallback ServiceIsolate::create_callback_ = NULL;
 Monitor* ServiceIsolate::monitor_ = new Monitor();
 ServiceIsolate::State ServiceIsolate::state_ = ServiceIsolate::kStopped;
+bool ServiceIsolate::run_deferred_ = false;
 Isolate* ServiceIsolate::isolate_ = NULL;
 Dart_Port ServiceIsolate::port_ = ILLEGAL_PORT;
 Dart_Port ServiceIsolate::load_port_ = ILLEGAL_PORT;
@@ -320,8 +326,56 @@ void ServiceIsolate::InitializingFailed() {
   ml.NotifyAll();
 }
 
+// Registers the isolates started before the service isolate, as each one
+// would have done itself on startup.
+class RegisterRunningIsolatesVisitor : public IsolateVisitor {
+ public:
+  explicit RegisterRunningIsolatesVisitor(Dart_Port service_port)
+      : service_port_(service_port) {}
+
+  virtual void VisitIsolate(Isolate* isolate) {
+    if (IsVMInternalIsolate(isolate)) {
+      return;
+    }
+    // Keep in sync with MakeServiceControlMessage.
+    Dart_CObject code;
+    code.type = Dart_CObject_kInt32;
+    code.value.as_int32 = VM_SERVICE_ISOLATE_STARTUP_MESSAGE_ID;
+    Dart_CObject port_id;
+    port_id.type = Dart_CObject_kInt64;
+    port_id.value.as_int64 = isolate->main_port();
+    Dart_CObject send_port;
+    send_port.type = Dart_CObject_kSendPort;
+    send_port.value.as_send_port.id = isolate->main_port();
+    send_port.value.as_send_port.origin_id = ILLEGAL_PORT;
+    Dart_CObject name;
+    name.type = Dart_CObject_kString;
+    name.value.as_string = const_cast<char*>(isolate->name());
+    Dart_CObject* values[] = {&code, &port_id, &send_port, &name};
+
+    Dart_CObject message;
+    message.type = Dart_CObject_kArray;
+    message.value.as_array.length = ARRAY_SIZE(values);
+    message.value.as_array.values = values;
+    if (FLAG_trace_service) {
+      OS::PrintErr(DART_VM_SERVICE_ISOLATE_NAME ": Isolate %s %" Pd64
+                                                " registered.\n",
+                   isolate->name(), isolate->main_port());
+    }
+    ApiMessageWriter writer;
+    PortMap::PostMessage(writer.WriteCMessage(&message, service_port_,
+                                              Message::kNormalPriority));
+  }
+
+ private:
+  const Dart_Port service_port_;
+};
+
 class RunServiceTask : public ThreadPool::Task {
  public:
+  explicit RunServiceTask(bool register_running_isolates)
+      : register_running_isolates_(register_running_isolates) {}
+
   virtual void Run() {
     ASSERT(Isolate::Current() == NULL);
 #if defined(SUPPORT_TIMELINE)
@@ -365,6 +419,11 @@ class RunServiceTask : public ThreadPool::Task {
     // waiting for service isolate to come up will deadlock.
     ServiceIsolate::FinishedInitializing();
 
+    if (register_running_isolates_ && ServiceIsolate::IsRunning()) {
+      RegisterRunningIsolatesVisitor visitor(ServiceIsolate::Port());
+      Isolate::VisitIsolates(&visitor);
+    }
+
     if (got_unwind) {
       ShutdownIsolate(reinterpret_cast<uword>(isolate));
       return;
@@ -467,15 +526,40 @@ class RunServiceTask : public ThreadPool::Task {
     ServiceIsolate::SetLoadPort(rp.Id());
     return false;
   }
+
+  const bool register_running_isolates_;
 };
 
 void ServiceIsolate::Run() {
   {
     MonitorLocker ml(monitor_);
     ASSERT(state_ == kStopped);
+    if (FLAG_lazy_service_isolate) {
+      run_deferred_ = true;
+      return;
+    }
     state_ = kStarting;
     ml.NotifyAll();
   }
+  StartRunServiceTask(/*register_running_isolates=*/false);
+}
+
+bool ServiceIsolate::RunDeferred() {
+  {
+    MonitorLocker ml(monitor_);
+    if (!run_deferred_) {
+      return false;
+    }
+    run_deferred_ = false;
+    ASSERT(state_ == kStopped);
+    state_ = kStarting;
+    ml.NotifyAll();
+  }
+  StartRunServiceTask(/*register_running_isolates=*/true);
+  return true;
+}
+
+void ServiceIsolate::StartRunServiceTask(bool register_running_isolates) {
   // Grab the isolate create callback here to avoid race conditions with tests
   // that change this after Dart_Initialize returns.
   create_callback_ = Isolate::CreateCallback();
@@ -483,7 +567,8 @@ void ServiceIsolate::Run() {
     ServiceIsolate::InitializingFailed();
     return;
   }
-  bool task_started = Dart::thread_pool()->Run(new RunServiceTask());
+  bool task_started =
+      Dart::thread_pool()->Run(new RunServiceTask(register_running_isolates));
   ASSERT(task_started);
 }
 
@@ -510,6 +595,7 @@ void ServiceIsolate::KillServiceIsolate() {
 void ServiceIsolate::Shutdown() {
   {
     MonitorLocker ml(monitor_);
+    run_deferred_ = false;
     while (state_ == kStarting) {
       ml.Wait();
     }
@@ -37,6 +37,12 @@ class ServiceIsolate : public AllStatic {
                              Dart_Port reply_port);
 
   static void Run();
+
+  // Starts the service isolate if Dart::Init deferred it because of
+  // --lazy_service_isolate. The isolates already running are registered with
+  // it once it is up. Returns false if there is nothing left to start.
+  static bool RunDeferred();
+
   static bool SendIsolateStartupMessage();
   static bool SendIsolateShutdownMessage();
   static void SendServiceExitMessage();
@@ -56,6 +62,7 @@ class ServiceIsolate : public AllStatic {
 
  private:
   static void KillServiceIsolate();
+  static void StartRunServiceTask(bool register_running_isolates);
 
  protected:
   static void SetServicePort(Dart_Port port);
@@ -78,6 +85,7 @@ class ServiceIsolate : public AllStatic {
     kStopping,
   };
   static State state_;
+  static bool run_deferred_;
   static Isolate* isolate_;
   static Dart_Port port_;
   static Dart_Port load_port_;
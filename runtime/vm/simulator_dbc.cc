@@ -1536,15 +1536,12 @@ SwitchDispatch:
         (null_value != function_type_args)) {
       // First lookup in the cache.
       RawArray* instantiations = type_arguments->ptr()->instantiations_;
-      for (intptr_t i = 0;
-           instantiations->ptr()->data()[i] != NULL;  // kNoInstantiator
-           i += 3) {  // kInstantiationSizeInWords
-        if ((instantiations->ptr()->data()[i] == instantiator_type_args) &&
-            (instantiations->ptr()->data()[i + 1] == function_type_args)) {
-          // Found in the cache.
-          SP[-1] = instantiations->ptr()->data()[i + 2];
-          goto InstantiateTypeArgumentsTOSDone;
-        }
+      const intptr_t i = TypeArguments::FindInstantiation(
+          instantiations, instantiator_type_args, function_type_args);
+      if (instantiations->ptr()->data()[i] != NULL) {  // kNoInstantiator
+        // Found in the cache.
+        SP[-1] = instantiations->ptr()->data()[i + 2];
+        goto InstantiateTypeArgumentsTOSDone;
       }
 
       // Cache lookup failed, call runtime.
@@ -9,6 +9,8 @@
 #include "vm/class_finalizer.h"
 #include "vm/dart.h"
 #include "vm/exceptions.h"
+#include "vm/flags.h"
+#include "vm/flat_message.h"
 #include "vm/heap/heap.h"
 #include "vm/longjump.h"
 #include "vm/message.h"
@@ -28,6 +30,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            flat_messages,
+            true,
+            "Send messages made only of primitives, strings, typed data and "
+            "lists of those without object ids.");
+
 static const int kNumInitialReferences = 32;
 
 static bool IsSingletonClassId(intptr_t class_id) {
@@ -804,12 +812,21 @@ MessageSnapshotReader::MessageSnapshotReader(Message* message, Thread* thread)
                      Snapshot::kMessage,
                      new ZoneGrowableArray<BackRefNode>(kNumInitialReferences),
                      thread),
+      message_(message),
       finalizable_data_(message->finalizable_data()) {}
 
 MessageSnapshotReader::~MessageSnapshotReader() {
   ResetBackwardReferenceTable();
 }
 
+RawObject* MessageSnapshotReader::ReadObject() {
+  if (message_->IsFlat()) {
+    FlatMessageReader reader(message_, thread());
+    return reader.ReadObject();
+  }
+  return SnapshotReader::ReadObject();
+}
+
 SnapshotWriter::SnapshotWriter(Thread* thread,
                                Snapshot::Kind kind,
                                ReAlloc alloc,
@@ -1467,6 +1484,15 @@ Message* MessageWriter::WriteMessage(const Object& obj,
   ASSERT(kind() == Snapshot::kMessage);
   ASSERT(isolate() != NULL);
 
+  if (FLAG_flat_messages) {
+    FlatMessageWriter flat_writer;
+    Message* message = flat_writer.WriteMessage(obj, dest_port, priority);
+    if (message != NULL) {
+      FreeBuffer();
+      return message;
+    }
+  }
+
   // Setup for long jump in case there is an exception while writing
   // the message.
   volatile bool has_exception = false;
@@ -1486,6 +1512,7 @@ Message* MessageWriter::WriteMessage(const Object& obj,
 
   MessageFinalizableData* finalizable_data = finalizable_data_;
   finalizable_data_ = NULL;
+  finalizable_data->SerializationSucceeded();
   return new Message(dest_port, buffer(), BytesWritten(), finalizable_data,
                      priority);
 }
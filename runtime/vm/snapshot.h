@@ -459,7 +459,11 @@ class MessageSnapshotReader : public SnapshotReader {
 
   MessageFinalizableData* finalizable_data() const { return finalizable_data_; }
 
+  // Reads flat messages without going through the object id tables.
+  RawObject* ReadObject();
+
  private:
+  Message* message_;
   MessageFinalizableData* finalizable_data_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageSnapshotReader);
@@ -715,6 +719,7 @@ class SnapshotWriter : public BaseWriter {
   friend class RawScript;
   friend class RawStackTrace;
   friend class RawSubtypeTestCache;
+  friend class RawTransferableTypedData;
   friend class RawType;
   friend class RawTypedDataView;
   friend class RawTypeRef;
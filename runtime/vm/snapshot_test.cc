@@ -727,6 +727,84 @@ ISOLATE_UNIT_TEST_CASE(SerializeEmptyByteArray) {
   delete message;
 }
 
+ISOLATE_UNIT_TEST_CASE(SerializeFlatMessage) {
+  StackZone zone(thread);
+  const Array& inner = Array::Handle(Array::New(2));
+  inner.SetAt(0, Bool::True());
+  inner.SetAt(1, Object::null_object());
+  const TypedData& typed_data =
+      TypedData::Handle(TypedData::New(kTypedDataUint8ArrayCid, 3));
+  typed_data.SetUint8(2, 42);
+  const Array& array = Array::Handle(Array::New(5));
+  array.SetAt(0, Smi::Handle(Smi::New(7)));
+  array.SetAt(1, Double::Handle(Double::New(2.5)));
+  array.SetAt(2, String::Handle(String::New("flat")));
+  array.SetAt(3, typed_data);
+  array.SetAt(4, inner);
+
+  MessageWriter writer(true);
+  Message* message =
+      writer.WriteMessage(array, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(message->IsFlat());
+
+  // Read object back from the snapshot.
+  MessageSnapshotReader reader(message, thread);
+  Array& serialized_array = Array::Handle();
+  serialized_array ^= reader.ReadObject();
+  EXPECT_EQ(5, serialized_array.Length());
+  EXPECT(Equals(Smi::Handle(Smi::New(7)),
+                Object::Handle(serialized_array.At(0))));
+  EXPECT_EQ(2.5, Double::Cast(Object::Handle(serialized_array.At(1))).value());
+  EXPECT(String::Cast(Object::Handle(serialized_array.At(2))).Equals("flat"));
+  const TypedData& serialized_typed_data =
+      TypedData::Cast(Object::Handle(serialized_array.At(3)));
+  EXPECT_EQ(3, serialized_typed_data.Length());
+  EXPECT_EQ(42, serialized_typed_data.GetUint8(2));
+  const Array& serialized_inner =
+      Array::Cast(Object::Handle(serialized_array.At(4)));
+  EXPECT_EQ(Bool::True().raw(), serialized_inner.At(0));
+  EXPECT(serialized_inner.At(1) == Object::null());
+
+  // Read object back from the snapshot into a C structure.
+  ApiNativeScope scope;
+  ApiMessageReader api_reader(message);
+  Dart_CObject* root = api_reader.ReadMessage();
+  EXPECT_EQ(Dart_CObject_kArray, root->type);
+  EXPECT_EQ(5, root->value.as_array.length);
+  EXPECT_EQ(7, root->value.as_array.values[0]->value.as_int32);
+  EXPECT_EQ(2.5, root->value.as_array.values[1]->value.as_double);
+  EXPECT_STREQ("flat", root->value.as_array.values[2]->value.as_string);
+  EXPECT_EQ(Dart_TypedData_kUint8,
+            root->value.as_array.values[3]->value.as_typed_data.type);
+  EXPECT_EQ(42, root->value.as_array.values[3]->value.as_typed_data.values[2]);
+  EXPECT_EQ(Dart_CObject_kBool,
+            root->value.as_array.values[4]->value.as_array.values[0]->type);
+  CheckEncodeDecodeMessage(root);
+
+  delete message;
+}
+
+ISOLATE_UNIT_TEST_CASE(SerializeSharedObjectsNotFlat) {
+  StackZone zone(thread);
+  const Array& inner = Array::Handle(Array::New(1));
+  const Array& array = Array::Handle(Array::New(2));
+  array.SetAt(0, inner);
+  array.SetAt(1, inner);
+
+  MessageWriter writer(true);
+  Message* message =
+      writer.WriteMessage(array, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(!message->IsFlat());
+
+  // Sharing survives the round trip.
+  MessageSnapshotReader reader(message, thread);
+  Array& serialized_array = Array::Handle();
+  serialized_array ^= reader.ReadObject();
+  EXPECT_EQ(serialized_array.At(0), serialized_array.At(1));
+
+  delete message;
+}
+
 VM_UNIT_TEST_CASE(FullSnapshot) {
   const char* kScriptChars =
       "class Fields  {\n"
@@ -2030,6 +2108,72 @@ VM_UNIT_TEST_CASE(PostCObject) {
   Dart_ExitScope();
 }
 
+static intptr_t posted_external_typed_data_finalized = 0;
+
+static void PostedExternalTypedDataFinalizer(void* isolate_callback_data,
+                                             Dart_WeakPersistentHandle handle,
+                                             void* peer) {
+  posted_external_typed_data_finalized++;
+  free(peer);
+}
+
+VM_UNIT_TEST_CASE(PostExternalTypedData) {
+  TestIsolateScope __test_isolate__;
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "import 'dart:typed_data';\n"
+      "main() {\n"
+      "  var result = '';\n"
+      "  var port = new RawReceivePort();\n"
+      "  port.handler = (message) {\n"
+      "    result = '$result${message.runtimeType}${message.length}';\n"
+      "    result = '$result${message.first}${message.last}';\n"
+      "    if (message is Float64List) throw new Exception(result);\n"
+      "  };\n"
+      "  return port.sendPort;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_EnterScope();
+
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id;
+  Dart_Handle result = Dart_SendPortGetId(send_port, &port_id);
+  ASSERT(!Dart_IsError(result));
+
+  const intptr_t kLength = 100;
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(malloc(kLength));
+  for (intptr_t i = 0; i < kLength; i++) {
+    bytes[i] = i;
+  }
+  // Without a callback the data is released with free().
+  EXPECT(Dart_PostExternalTypedData(port_id, Dart_TypedData_kUint8, bytes,
+                                    kLength, NULL, NULL));
+
+  double* doubles = reinterpret_cast<double*>(malloc(3 * sizeof(double)));
+  doubles[0] = 1.5;
+  doubles[1] = 0.0;
+  doubles[2] = -2.5;
+  EXPECT(Dart_PostExternalTypedData(
+      port_id, Dart_TypedData_kFloat64, reinterpret_cast<uint8_t*>(doubles),
+      3 * sizeof(double), doubles, PostedExternalTypedDataFinalizer));
+
+  // Rejected data is released right away.
+  posted_external_typed_data_finalized = 0;
+  uint8_t* odd = reinterpret_cast<uint8_t*>(malloc(3));
+  EXPECT(!Dart_PostExternalTypedData(port_id, Dart_TypedData_kInt16, odd, 3,
+                                     odd, PostedExternalTypedDataFinalizer));
+  EXPECT_EQ(1, posted_external_typed_data_finalized);
+
+  result = Dart_RunLoop();
+  EXPECT(Dart_IsError(result));
+  EXPECT_SUBSTRING("Exception: _ExternalUint8Array100099"
+                   "_ExternalFloat64Array31.5-2.5\n",
+                   Dart_GetError(result));
+
+  Dart_ExitScope();
+}
+
 TEST_CASE(OmittedObjectEncodingLength) {
   StackZone zone(Thread::Current());
   MessageWriter writer(true);
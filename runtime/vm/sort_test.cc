@@ -0,0 +1,109 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/sort.h"
+#include "platform/assert.h"
+#include "vm/random.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static bool IntLess(int32_t a, int32_t b) {
+  return a < b;
+}
+
+static uint32_t IntKey(int32_t value) {
+  return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+static void ExpectSorted(const int32_t* elements, intptr_t length) {
+  for (intptr_t i = 1; i < length; i++) {
+    EXPECT_LE(elements[i - 1], elements[i]);
+  }
+}
+
+// Sorts 'elements' both ways and checks that the results agree.
+static void TestSort(int32_t* elements, intptr_t length) {
+  int32_t* copy = new int32_t[length];
+  int32_t* scratch = new int32_t[length];
+  int64_t sum = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    copy[i] = elements[i];
+    sum += elements[i];
+  }
+  Sort::IntroSort(elements, length, IntLess);
+  ExpectSorted(elements, length);
+  Sort::RadixSort(copy, scratch, length, IntKey);
+  for (intptr_t i = 0; i < length; i++) {
+    EXPECT_EQ(elements[i], copy[i]);
+    sum -= elements[i];
+  }
+  EXPECT_EQ(0, sum);
+  delete[] scratch;
+  delete[] copy;
+}
+
+VM_UNIT_TEST_CASE(Sort_Random) {
+  Random random(42);
+  const intptr_t kLengths[] = {0, 1, 2, 3, 16, 17, 100, 1000, 100000};
+  const uint32_t kRanges[] = {2, 1000, 0xFFFFFFFF};
+  for (size_t l = 0; l < ARRAY_SIZE(kLengths); l++) {
+    for (size_t r = 0; r < ARRAY_SIZE(kRanges); r++) {
+      const intptr_t length = kLengths[l];
+      int32_t* elements = new int32_t[length];
+      for (intptr_t i = 0; i < length; i++) {
+        elements[i] = static_cast<int32_t>(random.NextUInt32() % kRanges[r]) -
+                      static_cast<int32_t>(kRanges[r] / 2);
+      }
+      TestSort(elements, length);
+      delete[] elements;
+    }
+  }
+}
+
+VM_UNIT_TEST_CASE(Sort_Patterns) {
+  const intptr_t kLength = 10000;
+  int32_t* elements = new int32_t[kLength];
+  // Ascending, descending, organ pipe and constant inputs, which make naive
+  // quicksorts quadratic.
+  for (intptr_t i = 0; i < kLength; i++) {
+    elements[i] = i;
+  }
+  TestSort(elements, kLength);
+  for (intptr_t i = 0; i < kLength; i++) {
+    elements[i] = kLength - i;
+  }
+  TestSort(elements, kLength);
+  for (intptr_t i = 0; i < kLength; i++) {
+    elements[i] = (i < kLength / 2) ? i : kLength - i;
+  }
+  TestSort(elements, kLength);
+  for (intptr_t i = 0; i < kLength; i++) {
+    elements[i] = 7;
+  }
+  TestSort(elements, kLength);
+  delete[] elements;
+}
+
+VM_UNIT_TEST_CASE(Sort_RadixSortIsStable) {
+  // Sorting by the high half only must keep the low halves in order.
+  const intptr_t kLength = 1000;
+  uint32_t* elements = new uint32_t[kLength];
+  uint32_t* scratch = new uint32_t[kLength];
+  for (intptr_t i = 0; i < kLength; i++) {
+    elements[i] = (((kLength - i) % 10) << 16) | i;
+  }
+  Sort::RadixSort(elements, scratch, kLength,
+                  [](uint32_t value) { return value >> 16; });
+  for (intptr_t i = 1; i < kLength; i++) {
+    EXPECT_LE(elements[i - 1] >> 16, elements[i] >> 16);
+    if ((elements[i - 1] >> 16) == (elements[i] >> 16)) {
+      EXPECT_LT(elements[i - 1] & 0xFFFF, elements[i] & 0xFFFF);
+    }
+  }
+  delete[] scratch;
+  delete[] elements;
+}
+
+}  // namespace dart
@@ -6,8 +6,10 @@
 #include "vm/source_report.h"
 
 #include "vm/compiler/jit/compiler.h"
+#include "vm/hash_table.h"
 #include "vm/isolate.h"
 #include "vm/kernel_loader.h"
+#include "vm/lockers.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/profiler.h"
@@ -57,7 +59,8 @@ void SourceReport::Init(Thread* thread,
     // Build the profile.
     SampleFilter samplesForIsolate(thread_->isolate()->main_port(),
                                    Thread::kMutatorTask, -1, -1);
-    profile_.Build(thread, &samplesForIsolate, Profiler::sample_buffer(),
+    profile_.Build(thread, &samplesForIsolate,
+                   Profiler::sample_buffer(thread_->isolate()),
                    Profile::kNoTags);
   }
 }
@@ -227,6 +230,68 @@ void SourceReport::PrintCallSitesData(JSONObject* jsobj,
   }
 }
 
+class CoverageCountersTraits {
+ public:
+  static const char* Name() { return "CoverageCountersTraits"; }
+  static bool ReportStats() { return false; }
+
+  static bool IsMatch(const Object& a, const Object& b) {
+    return a.raw() == b.raw();
+  }
+
+  static uword Hash(const Object& key) {
+    const Function& function = Function::Cast(key);
+    return String::Handle(function.name()).Hash() ^
+           function.token_pos().value();
+  }
+};
+typedef UnorderedHashMap<CoverageCountersTraits> CoverageCountersTable;
+
+RawArray* CoverageCounters::GetOrCreate(Thread* thread,
+                                        const Function& function) {
+  const TokenPosition begin_pos = function.token_pos();
+  const TokenPosition end_pos = function.end_token_pos();
+  if (!begin_pos.IsReal() || !end_pos.IsReal() || (end_pos < begin_pos)) {
+    return Array::null();
+  }
+  Zone* zone = thread->zone();
+  Isolate* isolate = thread->isolate();
+  ObjectStore* object_store = isolate->object_store();
+  // Optimized code is also compiled by the background compiler.
+  SafepointMutexLocker ml(isolate->coverage_counters_mutex());
+  if (object_store->coverage_counters() == Array::null()) {
+    const intptr_t kInitialCapacity = 256;
+    object_store->set_coverage_counters(
+        Array::Handle(zone, HashTables::New<CoverageCountersTable>(
+                                kInitialCapacity, Heap::kOld)));
+  }
+  CoverageCountersTable table(zone, object_store->coverage_counters());
+  Array& counters = Array::Handle(zone);
+  counters ^= table.GetOrNull(function);
+  if (counters.IsNull()) {
+    const intptr_t length = (end_pos.Pos() - begin_pos.Pos()) + 1;
+    counters = Array::New(length, Heap::kOld);
+    table.UpdateOrInsert(function, counters);
+  }
+  object_store->set_coverage_counters(table.Release());
+  return counters.raw();
+}
+
+RawArray* CoverageCounters::Lookup(Thread* thread, const Function& function) {
+  Isolate* isolate = thread->isolate();
+  ObjectStore* object_store = isolate->object_store();
+  SafepointMutexLocker ml(isolate->coverage_counters_mutex());
+  if (object_store->coverage_counters() == Array::null()) {
+    return Array::null();
+  }
+  CoverageCountersTable table(thread->zone(),
+                              object_store->coverage_counters());
+  Array& counters = Array::Handle(thread->zone());
+  counters ^= table.GetOrNull(function);
+  table.Release();
+  return counters.raw();
+}
+
 void SourceReport::PrintCoverageData(JSONObject* jsobj,
                                      const Function& function,
                                      const Code& code) {
@@ -288,6 +353,17 @@ void SourceReport::PrintCoverageData(JSONObject* jsobj,
     }
   }
 
+  const Array& counters =
+      Array::Handle(zone(), CoverageCounters::Lookup(thread(), function));
+  if (!counters.IsNull()) {
+    ASSERT(counters.Length() == func_length);
+    for (intptr_t i = 0; i < func_length; i++) {
+      if (counters.At(i) != Object::null()) {
+        coverage[i] = kCoverageHit;
+      }
+    }
+  }
+
   JSONObject cov(jsobj, "coverage");
   {
     JSONArray hits(&cov, "hits");
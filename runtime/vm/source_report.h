@@ -124,6 +124,24 @@ class SourceReport {
   intptr_t next_script_index_;
 };
 
+// The call sites reached by code compiled with --coverage_counters.
+//
+// The compiler emits a store into an array of the function a call belongs
+// to, indexed by the offset of the call's token position from the start of
+// the function, just before the call. Unlike the ICData counts, which are
+// only updated by unoptimized code, the stores are kept in optimized code,
+// including in the code of inlined calls, so SourceReport also sees the
+// calls first reached after a function was optimized.
+class CoverageCounters : public AllStatic {
+ public:
+  // Returns the counters of [function], creating them if needed, or null
+  // if the function has no source.
+  static RawArray* GetOrCreate(Thread* thread, const Function& function);
+
+  // Returns the counters of [function], or null if none were created.
+  static RawArray* Lookup(Thread* thread, const Function& function);
+};
+
 }  // namespace dart
 
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
@@ -3,6 +3,8 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/stack_trace.h"
+#include "vm/object_store.h"
+#include "vm/reverse_pc_lookup_cache.h"
 #include "vm/stack_frame.h"
 
 namespace dart {
@@ -133,4 +135,46 @@ intptr_t StackTraceUtils::ExtractAsyncStackTraceInfo(
   return async_stack_trace_length;
 }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+RawStackTrace* StackTraceUtils::CollectLazyStackTrace(Thread* thread,
+                                                      int skip_frames) {
+  Zone* zone = thread->zone();
+  Isolate* isolate = thread->isolate();
+  if (isolate->object_store()->code_order_table() == Object::null()) {
+    return StackTrace::null();
+  }
+  ReversePcLookupCache* cache = isolate->reverse_pc_lookup_cache();
+  const uword first_pc = cache->first_absolute_pc();
+  // The number of frames is only known after the walk.
+  GrowableArray<intptr_t> offsets(zone, 64);
+  StackFrameIterator frames(ValidationPolicy::kDontValidateFrames, thread,
+                            StackFrameIterator::kNoCrossThreadIteration);
+  StackFrame* frame = frames.NextFrame();
+  ASSERT(frame != NULL);  // We expect to find a dart invocation frame.
+  for (; frame != NULL; frame = frames.NextFrame()) {
+    if (!frame->IsDartFrame()) {
+      continue;
+    }
+    if (skip_frames > 0) {
+      skip_frames--;
+      continue;
+    }
+    const uword pc = frame->pc();
+    if (!cache->Contains(pc) || !Smi::IsValid(pc - first_pc)) {
+      return StackTrace::null();
+    }
+    offsets.Add(pc - first_pc);
+  }
+
+  const Array& pc_offset_array =
+      Array::Handle(zone, Array::New(offsets.length()));
+  Smi& offset = Smi::Handle(zone);
+  for (intptr_t i = 0; i < offsets.length(); i++) {
+    offset = Smi::New(offsets[i]);
+    pc_offset_array.SetAt(i, offset);
+  }
+  return StackTrace::NewLazy(pc_offset_array);
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 }  // namespace dart
@@ -44,6 +44,17 @@ class StackTraceUtils : public AllStatic {
                                              StackTrace* async_stack_trace,
                                              Array* async_code_array,
                                              Array* async_pc_offset_array);
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+  /// Collects the return addresses of the Dart frames into a lazy stack
+  /// trace (see StackTrace::IsLazy), which avoids looking up the Code of
+  /// every frame of stack traces which are never looked at.
+  /// Skips over the first |skip_frames|.
+  /// Returns null if the Code of a frame is not found through the isolate's
+  /// ReversePcLookupCache, as outside of bare instructions mode.
+  static RawStackTrace* CollectLazyStackTrace(Thread* thread,
+                                              int skip_frames);
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
 };
 
 }  // namespace dart
@@ -10,6 +10,7 @@
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/cpu.h"
 #include "vm/flags.h"
 #include "vm/heap/safepoint.h"
 #include "vm/interpreter.h"
@@ -52,6 +53,8 @@ void StubCode::Init() {
 
 void StubCode::Init() {
   ObjectPoolBuilder object_pool_builder;
+  // None of the stubs runs before all of them are generated.
+  ICacheFlushBatch icache_flush_batch(Thread::Current());
 
   // Generate all the stubs.
   VM_STUB_CODE_LIST(STUB_CODE_GENERATE);
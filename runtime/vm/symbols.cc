@@ -303,6 +303,27 @@ void Symbols::SetupSymbolTable(Isolate* isolate) {
   isolate->object_store()->set_symbol_table(array);
 }
 
+void Symbols::ReserveCapacity(Thread* thread, intptr_t num_symbols) {
+  Isolate* isolate = thread->isolate();
+  ASSERT(isolate != Dart::vm_isolate());
+  Zone* zone = thread->zone();
+  SafepointMutexLocker ml(isolate->symbols_mutex());
+  SymbolTable table(zone, isolate->object_store()->symbol_table());
+  // Keep below the load factor at which insertion grows the table.
+  const double kMaxLoadFactor = 0.71;
+  const intptr_t num_occupied = table.NumOccupied() + num_symbols;
+  if ((1 + num_occupied + table.NumDeleted()) <
+      (kMaxLoadFactor * table.NumEntries())) {
+    table.Release();
+    return;
+  }
+  SymbolTable new_table(zone, HashTables::New<SymbolTable>(
+                                  num_occupied * 3 / 2, Heap::kOld));
+  HashTables::Copy(table, new_table);
+  isolate->object_store()->set_symbol_table(new_table.Release());
+  table.Release();
+}
+
 void Symbols::Compact() {
   Thread* thread = Thread::Current();
   ASSERT(thread->isolate() != Dart::vm_isolate());
@@ -22,6 +22,7 @@ class ObjectPointerVisitor;
   V(AddStream, "addStream")                                                    \
   V(AllocateInvocationMirror, "_allocateInvocationMirror")                     \
   V(AllocateInvocationMirrorForClosure, "_allocateInvocationMirrorForClosure") \
+  V(AllocateStructResult, "_allocateStructResult")                             \
   V(AnonymousClosure, "<anonymous closure>")                                   \
   V(AnonymousSignature, "<anonymous signature>")                               \
   V(ApiError, "ApiError")                                                      \
@@ -134,6 +135,7 @@ class ObjectPointerVisitor;
   V(ExternalTwoByteString, "_ExternalTwoByteString")                           \
   V(FactoryResult, "factory result")                                           \
   V(FallThroughError, "FallThroughError")                                      \
+  V(FfiByValue, "ByValue")                                                     \
   V(FfiDouble, "Double")                                                       \
   V(FfiDynamicLibrary, "DynamicLibrary")                                       \
   V(FfiFloat, "Float")                                                         \
@@ -153,6 +155,7 @@ class ObjectPointerVisitor;
   V(FfiVoid, "Void")                                                           \
   V(Field, "Field")                                                            \
   V(FinallyRetVal, ":finally_ret_val")                                         \
+  V(FindRegExpLiteral, "_findRegExpLiteral")                                   \
   V(Float32List, "Float32List")                                                \
   V(Float32x4, "Float32x4")                                                    \
   V(Float32x4List, "Float32x4List")                                            \
@@ -411,6 +414,7 @@ class ObjectPointerVisitor;
   V(_SyncIterable, "_SyncIterable")                                            \
   V(_SyncIterableConstructor, "_SyncIterable.")                                \
   V(_SyncIterator, "_SyncIterator")                                            \
+  V(_TransferableTypedDataImpl, "_TransferableTypedDataImpl")                  \
   V(_Type, "_Type")                                                            \
   V(_TypeParameter, "_TypeParameter")                                          \
   V(_TypeRef, "_TypeRef")                                                      \
@@ -482,6 +486,7 @@ class ObjectPointerVisitor;
   V(toString, "toString")                                                      \
   V(vm_entry_point, "vm:entry-point")                                          \
   V(vm_exact_result_type, "vm:exact-result-type")                              \
+  V(vm_ffi_struct_fields, "vm:ffi:struct-fields")                              \
   V(vm_non_nullable_result_type, "vm:non-nullable-result-type")                \
   V(vm_trace_entrypoints, "vm:testing.unsafe.trace-entrypoints-fn")            \
   V(word_character_map, ":word_character_map")
@@ -634,6 +639,10 @@ class Symbols : public AllStatic {
   // Treat the symbol table as weak and collect garbage.
   static void Compact();
 
+  // Grows the symbol table of the current isolate once, so that
+  // [num_symbols] more symbols can be added without rehashing it again.
+  static void ReserveCapacity(Thread* thread, intptr_t num_symbols);
+
   // Creates a Symbol given a C string that is assumed to contain
   // UTF-8 encoded characters and '\0' is considered a termination character.
   // TODO(7123) - Rename this to FromCString(....).
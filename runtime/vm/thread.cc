@@ -14,7 +14,9 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/os_thread.h"
+#include "vm/poll_page.h"
 #include "vm/profiler.h"
+#include "vm/profiler_pprof.h"
 #include "vm/runtime_entry.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
@@ -39,11 +41,13 @@ Thread::~Thread() {
 #endif
   // There should be no top api scopes at this point.
   ASSERT(api_top_scope() == NULL);
-  // Delete the resusable api scope if there is one.
-  if (api_reusable_scope_) {
-    delete api_reusable_scope_;
-    api_reusable_scope_ = NULL;
+  // Delete the reusable api scopes if there are any.
+  while (api_reusable_scope_ != NULL) {
+    ApiLocalScope* scope = api_reusable_scope_;
+    api_reusable_scope_ = scope->previous();
+    delete scope;
   }
+  api_reusable_scope_count_ = 0;
   delete thread_lock_;
   thread_lock_ = NULL;
 }
@@ -78,12 +82,15 @@ Thread::Thread(Isolate* isolate)
       resume_pc_(0),
       execution_state_(kThreadInNative),
       safepoint_state_(0),
+      poll_page_(PollPage::disarmed_page()),
       task_kind_(kUnknownTask),
       dart_stream_(NULL),
       thread_lock_(new Monitor()),
       api_reusable_scope_(NULL),
+      api_reusable_scope_count_(0),
       api_top_scope_(NULL),
       no_callback_scope_depth_(0),
+      icache_flush_batch_(NULL),
 #if defined(DEBUG)
       no_safepoint_scope_depth_(0),
 #endif
@@ -94,6 +101,14 @@ Thread::Thread(Isolate* isolate)
       deferred_interrupts_(0),
       stack_overflow_count_(0),
       bump_allocate_(false),
+      old_top_(0),
+      old_end_(0),
+      tlab_size_(0),
+      tlab_refills_(0),
+      tlab_end_(0),
+      allocation_sample_remaining_(0),
+      allocation_sample_top_(0),
+      allocation_sample_pending_(false),
       hierarchy_info_(NULL),
       type_usage_info_(NULL),
       pending_functions_(GrowableObjectArray::null()),
@@ -282,6 +297,12 @@ const char* Thread::TaskKindToCString(TaskKind kind) {
       return "kSweeperTask";
     case kMarkerTask:
       return "kMarkerTask";
+    case kCompactorTask:
+      return "kCompactorTask";
+    case kScavengerTask:
+      return "kScavengerTask";
+    case kBecomeTask:
+      return "kBecomeTask";
     default:
       UNREACHABLE();
       return "";
@@ -386,6 +407,7 @@ void Thread::ExitIsolateAsHelper(bool bypass_safepoint) {
   }
   thread->StoreBufferRelease();
   thread->heap()->AbandonRemainingTLAB(thread);
+  thread->heap()->old_space()->ReleaseTLAB(thread);
   Isolate* isolate = thread->isolate();
   ASSERT(isolate != NULL);
   const bool kIsNotMutatorThread = false;
@@ -412,6 +434,7 @@ void Thread::SetStackLimit(uword limit) {
     stack_limit_ = limit;
   }
   saved_stack_limit_ = limit;
+  UpdatePollPage();
 }
 
 void Thread::ClearStackLimit() {
@@ -441,6 +464,7 @@ void Thread::ScheduleInterruptsLocked(uword interrupt_bits) {
     stack_limit_ = kInterruptStackLimit & ~kInterruptsMask;
   }
   stack_limit_ |= interrupt_bits;
+  UpdatePollPage();
 }
 
 uword Thread::GetAndClearInterrupts() {
@@ -450,6 +474,7 @@ uword Thread::GetAndClearInterrupts() {
   }
   uword interrupt_bits = stack_limit_ & kInterruptsMask;
   stack_limit_ = saved_stack_limit_;
+  UpdatePollPage();
   return interrupt_bits;
 }
 
@@ -474,6 +499,7 @@ void Thread::DeferOOBMessageInterrupts() {
       // No other pending interrupts.  Restore normal stack limit.
       stack_limit_ = saved_stack_limit_;
     }
+    UpdatePollPage();
   }
   if (FLAG_trace_service && FLAG_trace_service_verbose) {
     OS::PrintErr("[+%" Pd64 "ms] Isolate %s deferring OOB interrupts\n",
@@ -496,6 +522,7 @@ void Thread::RestoreOOBMessageInterrupts() {
     }
     stack_limit_ |= deferred_interrupts_;
     deferred_interrupts_ = 0;
+    UpdatePollPage();
   }
   if (FLAG_trace_service && FLAG_trace_service_verbose) {
     OS::PrintErr("[+%" Pd64 "ms] Isolate %s restoring OOB interrupts\n",
@@ -503,6 +530,11 @@ void Thread::RestoreOOBMessageInterrupts() {
   }
 }
 
+void Thread::UpdatePollPage() {
+  poll_page_ = (stack_limit_ == saved_stack_limit_) ? PollPage::disarmed_page()
+                                                    : PollPage::armed_page();
+}
+
 RawError* Thread::HandleInterrupts() {
   uword interrupt_bits = GetAndClearInterrupts();
   if ((interrupt_bits & kVMInterrupt) != 0) {
@@ -513,6 +545,10 @@ RawError* Thread::HandleInterrupts() {
       heap()->CollectGarbage(Heap::kNew);
     }
     heap()->CheckFinishConcurrentMarking(this);
+    heap()->RunPendingFinalizers(this);
+#if !defined(PRODUCT)
+    ContinuousProfile::Tick(this);
+#endif  // !defined(PRODUCT)
   }
   if ((interrupt_bits & kMessageInterrupt) != 0) {
     MessageHandler::MessageStatus status =
@@ -713,6 +749,84 @@ void Thread::VisitObjectPointers(ObjectPointerVisitor* visitor,
   }
 }
 
+class RestoreWriteBarrierInvariantVisitor : public ObjectPointerVisitor {
+ public:
+  RestoreWriteBarrierInvariantVisitor(Isolate* isolate,
+                                      Thread* thread,
+                                      Thread::RestoreWriteBarrierInvariantOp op)
+      : ObjectPointerVisitor(isolate), thread_(thread), op_(op) {}
+
+  void VisitPointers(RawObject** first, RawObject** last) {
+    for (; first != last + 1; first++) {
+      RawObject* obj = *first;
+      // Stores into new-space objects or into objects which are card
+      // remembered never have their barrier eliminated.
+      if (obj->IsSmiOrNewObject()) continue;
+      if (obj->IsCardRemembered()) continue;
+      // Canonical and VM isolate objects are never the result of an
+      // allocation in optimized code.
+      if (obj->IsCanonical()) continue;
+      if (obj->InVMIsolateHeap()) continue;
+      const intptr_t cid = obj->GetClassIdMayBeSmi();
+      if ((cid != kArrayCid) && (cid != kContextCid) &&
+          (cid < kNumPredefinedCids)) {
+        continue;
+      }
+
+      switch (op_) {
+        case Thread::kAddToRememberedSet:
+          if (!obj->IsRemembered()) {
+            obj->SetRememberedBit();
+            thread_->StoreBufferAddObjectGC(obj);
+          }
+          if (thread_->is_marking()) {
+            thread_->DeferredMarkingStackAddObject(obj);
+          }
+          break;
+        case Thread::kAddToDeferredMarkingStack:
+          thread_->DeferredMarkingStackAddObject(obj);
+          break;
+      }
+    }
+  }
+
+ private:
+  Thread* const thread_;
+  const Thread::RestoreWriteBarrierInvariantOp op_;
+};
+
+void Thread::RestoreWriteBarrierInvariant(RestoreWriteBarrierInvariantOp op) {
+  ASSERT(IsMutatorThread());
+  // A mutator which is not scheduled cannot be suspended in a runtime call
+  // from optimized code.
+  if ((op == kAddToRememberedSet) ? (store_buffer_block_ == NULL)
+                                  : (deferred_marking_stack_block_ == NULL)) {
+    return;
+  }
+
+  const StackFrameIterator::CrossThreadPolicy cross_thread_policy =
+      StackFrameIterator::kAllowCrossThreadIteration;
+  StackFrameIterator frames_iterator(top_exit_frame_info(),
+                                     ValidationPolicy::kDontValidateFrames,
+                                     this, cross_thread_policy);
+  RestoreWriteBarrierInvariantVisitor visitor(isolate(), this, op);
+  bool scan_next_dart_frame = false;
+  for (StackFrame* frame = frames_iterator.NextFrame(); frame != NULL;
+       frame = frames_iterator.NextFrame()) {
+    if (frame->IsExitFrame()) {
+      scan_next_dart_frame = true;
+    } else if (frame->IsDartFrame(/*validate=*/false)) {
+      // Only a frame suspended in a runtime call (possibly made through a
+      // stub) relies on the invariant; a frame which called other Dart code
+      // forgot all of its allocations at the call.
+      if (scan_next_dart_frame && !frame->is_interpreted()) {
+        frame->VisitObjectPointers(&visitor);
+      }
+      scan_next_dart_frame = false;
+    }
+  }
+}
+
 bool Thread::CanLoadFromThread(const Object& object) {
   // In order to allow us to use assembler helper routines with non-[Code]
   // objects *before* stubs are initialized, we only loop ver the stubs if the
@@ -872,13 +986,14 @@ int Thread::ZoneSizeInBytes() const {
 
 void Thread::EnterApiScope() {
   ASSERT(MayAllocateHandles());
-  ApiLocalScope* new_scope = api_reusable_scope();
+  ApiLocalScope* new_scope = api_reusable_scope_;
   if (new_scope == NULL) {
     new_scope = new ApiLocalScope(api_top_scope(), top_exit_frame_info());
     ASSERT(new_scope != NULL);
   } else {
+    api_reusable_scope_ = new_scope->previous();
+    api_reusable_scope_count_--;
     new_scope->Reinit(this, api_top_scope(), top_exit_frame_info());
-    set_api_reusable_scope(NULL);
   }
   set_api_top_scope(new_scope);  // New scope is now the top scope.
 }
@@ -886,13 +1001,14 @@ void Thread::EnterApiScope() {
 void Thread::ExitApiScope() {
   ASSERT(MayAllocateHandles());
   ApiLocalScope* scope = api_top_scope();
-  ApiLocalScope* reusable_scope = api_reusable_scope();
   set_api_top_scope(scope->previous());  // Reset top scope to previous.
-  if (reusable_scope == NULL) {
+  if (api_reusable_scope_count_ < kMaxReusableApiScopes) {
+    ASSERT(api_reusable_scope_ != scope);
     scope->Reset(this);  // Reset the old scope which we just exited.
-    set_api_reusable_scope(scope);
+    scope->set_previous(api_reusable_scope_);
+    api_reusable_scope_ = scope;
+    api_reusable_scope_count_++;
   } else {
-    ASSERT(reusable_scope != scope);
     delete scope;
   }
 }
@@ -41,6 +41,7 @@ class GrowableObjectArray;
 class HandleScope;
 class Heap;
 class HierarchyInfo;
+class ICacheFlushBatch;
 class Instance;
 class Interpreter;
 class Isolate;
@@ -164,6 +165,8 @@ class Zone;
     StubCode::StackOverflowSharedWithFPURegs().EntryPoint(), 0)                \
   V(uword, megamorphic_call_checked_entry_,                                    \
     StubCode::MegamorphicCall().EntryPoint(), 0)                               \
+  V(uword, ic_call_through_function_entry_,                                    \
+    StubCode::ICCallThroughFunction().EntryPoint(), 0)                         \
   V(uword, monomorphic_miss_entry_, StubCode::MonomorphicMiss().EntryPoint(),  \
     0)                                                                         \
   V(uword, deoptimize_entry_, StubCode::Deoptimize().EntryPoint(), 0)
@@ -218,6 +221,8 @@ class Thread : public ThreadState {
     kMarkerTask = 0x4,
     kSweeperTask = 0x8,
     kCompactorTask = 0x10,
+    kScavengerTask = 0x20,
+    kBecomeTask = 0x40,
   };
   // Converts a TaskKind to its corresponding C-String name.
   static const char* TaskKindToCString(TaskKind kind);
@@ -313,6 +318,10 @@ class Thread : public ThreadState {
     return OFFSET_OF(Thread, safepoint_state_);
   }
 
+  // The page optimized loops load from to poll for interrupts. It is
+  // inaccessible while an interrupt is pending, see vm/poll_page.h.
+  static intptr_t poll_page_offset() { return OFFSET_OF(Thread, poll_page_); }
+
   TaskKind task_kind() const { return task_kind_; }
 
   // Retrieves and clears the stack overflow flags.  These are set by
@@ -339,12 +348,12 @@ class Thread : public ThreadState {
   // Monitor corresponding to this thread.
   Monitor* thread_lock() const { return thread_lock_; }
 
-  // The reusable api local scope for this thread.
+  // The most recently exited api local scope kept for reuse by this thread.
+  // Further reusable scopes are chained through their previous() links, so
+  // that nested scopes (a native calling into Dart calling another native)
+  // do not allocate either.
   ApiLocalScope* api_reusable_scope() const { return api_reusable_scope_; }
-  void set_api_reusable_scope(ApiLocalScope* value) {
-    ASSERT(value == NULL || api_reusable_scope_ == NULL);
-    api_reusable_scope_ = value;
-  }
+  static const intptr_t kMaxReusableApiScopes = 4;
 
   // The api local scope for this thread, this where all local handles
   // are allocated.
@@ -371,6 +380,8 @@ class Thread : public ThreadState {
   // Has |this| exited Dart code?
   bool HasExitedDartCode() const;
 
+  bool HasCompilerState() const { return compiler_state_ != nullptr; }
+
   CompilerState& compiler_state() {
     ASSERT(compiler_state_ != nullptr);
     return *compiler_state_;
@@ -405,6 +416,11 @@ class Thread : public ThreadState {
   void set_interpreter(Interpreter* value) { interpreter_ = value; }
 #endif
 
+  ICacheFlushBatch* icache_flush_batch() const { return icache_flush_batch_; }
+  void set_icache_flush_batch(ICacheFlushBatch* batch) {
+    icache_flush_batch_ = batch;
+  }
+
   int32_t no_callback_scope_depth() const { return no_callback_scope_depth_; }
 
   void IncrementNoCallbackScopeDepth() {
@@ -438,6 +454,21 @@ class Thread : public ThreadState {
     return OFFSET_OF(Thread, marking_stack_block_);
   }
 
+  enum RestoreWriteBarrierInvariantOp {
+    kAddToRememberedSet,
+    kAddToDeferredMarkingStack
+  };
+
+  // Optimized code may omit the write barrier for stores into an array,
+  // context or instance it allocated itself, even across a GC triggered by
+  // a runtime call made directly from that code (see
+  // compiler/write_barrier_elimination.h). Such objects can be promoted by a
+  // scavenge or become old and unmarked when concurrent marking starts, so
+  // the GC calls this afterwards to add the candidates referenced from the
+  // frames which are suspended in such a call to the remembered set or to
+  // the deferred marking stack.
+  void RestoreWriteBarrierInvariant(RestoreWriteBarrierInvariantOp op);
+
   uword top_exit_frame_info() const { return top_exit_frame_info_; }
   void set_top_exit_frame_info(uword top_exit_frame_info) {
     top_exit_frame_info_ = top_exit_frame_info;
@@ -455,10 +486,19 @@ class Thread : public ThreadState {
   }
   void set_end(uword value) {
     end_ = value;
+    tlab_end_ = value;
   }
 
   uword top() { return top_; }
+  // The limit of the inline allocation fast paths. It is below tlab_end()
+  // while the next allocation sample point falls inside the TLAB, see
+  // Heap::AdvanceAllocationSample.
   uword end() { return end_; }
+  uword tlab_end() const { return tlab_end_; }
+  void set_allocation_limit(uword value) {
+    ASSERT((value >= top_) && (value <= tlab_end_));
+    end_ = value;
+  }
 
   bool HasActiveTLAB() { return end_ > 0; }
 
@@ -468,6 +508,41 @@ class Thread : public ThreadState {
   bool bump_allocate() const { return bump_allocate_; }
   void set_bump_allocate(bool b) { bump_allocate_ = b; }
 
+  // Thread-local old-space allocation buffer, see PageSpace::TryAllocateInTLAB.
+  uword old_top() const { return old_top_; }
+  uword old_end() const { return old_end_; }
+  void set_old_top(uword value) { old_top_ = value; }
+  void set_old_end(uword value) { old_end_ = value; }
+  bool HasActiveOldTLAB() const { return old_end_ > 0; }
+
+  // Size of the next new-space TLAB handed to this thread and the number of
+  // TLABs it took since the last scavenge, see Heap::NextTLABSize.
+  intptr_t tlab_size() const { return tlab_size_; }
+  void set_tlab_size(intptr_t value) { tlab_size_ = value; }
+  intptr_t tlab_refills() const { return tlab_refills_; }
+  void set_tlab_refills(intptr_t value) { tlab_refills_ = value; }
+
+  // Bytes left to allocate before the next allocation sample, as of when
+  // top() was 'allocation_sample_top', see AllocationSampler.
+  intptr_t allocation_sample_remaining() const {
+    return allocation_sample_remaining_;
+  }
+  void set_allocation_sample_remaining(intptr_t value) {
+    allocation_sample_remaining_ = value;
+  }
+  uword allocation_sample_top() const { return allocation_sample_top_; }
+  void set_allocation_sample_top(uword value) {
+    allocation_sample_top_ = value;
+  }
+  // Whether the last allocation by the heap crossed a sample point and is yet
+  // to be attributed to its class.
+  bool allocation_sample_pending() const {
+    return allocation_sample_pending_;
+  }
+  void set_allocation_sample_pending(bool value) {
+    allocation_sample_pending_ = value;
+  }
+
   int32_t no_safepoint_scope_depth() const {
 #if defined(DEBUG)
     return no_safepoint_scope_depth_;
@@ -852,6 +927,7 @@ class Thread : public ThreadState {
   uword resume_pc_;
   uword execution_state_;
   uword safepoint_state_;
+  uword volatile poll_page_;
 
   // ---- End accessed from generated code. ----
 
@@ -864,8 +940,10 @@ class Thread : public ThreadState {
   TimelineStream* dart_stream_;
   Monitor* thread_lock_;
   ApiLocalScope* api_reusable_scope_;
+  intptr_t api_reusable_scope_count_;
   ApiLocalScope* api_top_scope_;
   int32_t no_callback_scope_depth_;
+  ICacheFlushBatch* icache_flush_batch_;
 #if defined(DEBUG)
   int32_t no_safepoint_scope_depth_;
 #endif
@@ -876,6 +954,14 @@ class Thread : public ThreadState {
   uint16_t deferred_interrupts_;
   int32_t stack_overflow_count_;
   bool bump_allocate_;
+  uword old_top_;
+  uword old_end_;
+  intptr_t tlab_size_;
+  intptr_t tlab_refills_;
+  uword tlab_end_;
+  intptr_t allocation_sample_remaining_;
+  uword allocation_sample_top_;
+  bool allocation_sample_pending_;
 
   // Compiler state:
   CompilerState* compiler_state_ = nullptr;
@@ -935,6 +1021,10 @@ class Thread : public ThreadState {
   void DeferOOBMessageInterrupts();
   void RestoreOOBMessageInterrupts();
 
+  // Arms the poll page while an interrupt is pending. Called with the
+  // thread lock held whenever stack_limit_ changes.
+  void UpdatePollPage();
+
 #define REUSABLE_FRIEND_DECLARATION(name)                                      \
   friend class Reusable##name##HandleScope;
   REUSABLE_HANDLE_LIST(REUSABLE_FRIEND_DECLARATION)
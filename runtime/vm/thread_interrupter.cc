@@ -38,6 +38,16 @@ namespace dart {
 //
 
 DEFINE_FLAG(bool, trace_thread_interrupter, false, "Trace thread interrupter");
+DEFINE_FLAG(charp,
+            profiler_hardware_event,
+            NULL,
+            "Sample threads on overflows of a hardware performance counter "
+            "instead of on a timer: cycles, instructions, llc-misses or "
+            "branch-misses. Only supported on Linux.");
+DEFINE_FLAG(int,
+            profiler_hardware_event_period,
+            1000000,
+            "Number of hardware events between two samples.");
 
 bool ThreadInterrupter::initialized_ = false;
 bool ThreadInterrupter::shutdown_ = false;
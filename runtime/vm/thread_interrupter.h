@@ -18,6 +18,9 @@ struct InterruptedThreadState {
   uintptr_t dsp;
   uintptr_t fp;
   uintptr_t lr;
+  // The hardware events counted on the thread since it was last sampled,
+  // see --profiler_hardware_event.
+  uint64_t hardware_events = 0;
 };
 
 class ThreadInterrupter : public AllStatic {
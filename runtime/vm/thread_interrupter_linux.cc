@@ -5,7 +5,13 @@
 #include "platform/globals.h"
 #if defined(HOST_OS_LINUX)
 
-#include <errno.h>  // NOLINT
+#include <errno.h>             // NOLINT
+#include <fcntl.h>             // NOLINT
+#include <linux/perf_event.h>  // NOLINT
+#include <string.h>            // NOLINT
+#include <sys/ioctl.h>         // NOLINT
+#include <sys/syscall.h>       // NOLINT
+#include <unistd.h>            // NOLINT
 
 #include "vm/flags.h"
 #include "vm/os.h"
@@ -18,6 +24,8 @@ namespace dart {
 #ifndef PRODUCT
 
 DECLARE_FLAG(bool, trace_thread_interrupter);
+DECLARE_FLAG(charp, profiler_hardware_event);
+DECLARE_FLAG(int, profiler_hardware_event_period);
 
 class ThreadInterrupterLinux : public AllStatic {
  public:
@@ -27,6 +35,20 @@ class ThreadInterrupterLinux : public AllStatic {
     if (signal != SIGPROF) {
       return;
     }
+    // A perf event signals its overflow with POLL_HUP and disables itself
+    // until it is refreshed, the timer uses pthread_kill.
+    const bool hardware_event = (info->si_code == POLL_HUP);
+    uint64_t hardware_event_count = 0;
+    if (hardware_event) {
+      const int saved_errno = errno;
+      if (read(info->si_fd, &hardware_event_count,
+               sizeof(hardware_event_count)) !=
+          sizeof(hardware_event_count)) {
+        hardware_event_count = 0;
+      }
+      ioctl(info->si_fd, PERF_EVENT_IOC_REFRESH, 1);
+      errno = saved_errno;
+    }
     Thread* thread = Thread::Current();
     if (thread == NULL) {
       return;
@@ -40,8 +62,102 @@ class ThreadInterrupterLinux : public AllStatic {
     its.csp = SignalHandler::GetCStackPointer(mcontext);
     its.dsp = SignalHandler::GetDartStackPointer(mcontext);
     its.lr = SignalHandler::GetLinkRegister(mcontext);
+    if (hardware_event) {
+      OSThread* os_thread = thread->os_thread();
+      if (hardware_event_count > os_thread->hardware_event_count_) {
+        its.hardware_events =
+            hardware_event_count - os_thread->hardware_event_count_;
+      }
+      os_thread->hardware_event_count_ = hardware_event_count;
+    }
     Profiler::SampleThread(thread, its);
   }
+
+  // Makes sure [thread] has a perf event which interrupts it every
+  // --profiler_hardware_event_period events. Returns false if it can't have
+  // one, the thread is then interrupted by the timer.
+  static bool StartHardwareEvent(OSThread* thread) {
+    if (thread->hardware_event_fd_ >= 0) {
+      return true;
+    }
+    if (thread->hardware_event_fd_ == kHardwareEventFailed) {
+      return false;
+    }
+    thread->hardware_event_fd_ = kHardwareEventFailed;
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    if (!SetHardwareEventConfig(FLAG_profiler_hardware_event, &attr)) {
+      if (FirstWarning()) {
+        OS::PrintErr("Unknown hardware event %s, using the timer instead.\n",
+                     FLAG_profiler_hardware_event);
+      }
+      return false;
+    }
+    attr.sample_period = FLAG_profiler_hardware_event_period;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    const pid_t tid = thread->trace_id();
+    const int fd = syscall(__NR_perf_event_open, &attr, tid, /*cpu=*/-1,
+                           /*group_fd=*/-1, PERF_FLAG_FD_CLOEXEC);
+    if (fd < 0) {
+      if (FirstWarning()) {
+        OS::PrintErr("perf_event_open failed (errno %d), using the timer.\n",
+                     errno);
+      }
+      return false;
+    }
+    // Deliver the overflow signal to the thread itself.
+    struct f_owner_ex owner;
+    owner.type = F_OWNER_TID;
+    owner.pid = tid;
+    if ((fcntl(fd, F_SETFL, O_ASYNC) == -1) ||
+        (fcntl(fd, F_SETSIG, SIGPROF) == -1) ||
+        (fcntl(fd, F_SETOWN_EX, &owner) == -1) ||
+        (ioctl(fd, PERF_EVENT_IOC_REFRESH, 1) == -1)) {
+      if (FirstWarning()) {
+        OS::PrintErr("Failed to set up a perf event (errno %d), using the "
+                     "timer.\n",
+                     errno);
+      }
+      close(fd);
+      return false;
+    }
+    thread->hardware_event_count_ = 0;
+    thread->hardware_event_fd_ = fd;
+    return true;
+  }
+
+ private:
+  static const int kHardwareEventFailed = -2;
+
+  static bool SetHardwareEventConfig(const char* name,
+                                     struct perf_event_attr* attr) {
+    if (strcmp(name, "cycles") == 0) {
+      attr->config = PERF_COUNT_HW_CPU_CYCLES;
+    } else if (strcmp(name, "instructions") == 0) {
+      attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+    } else if (strcmp(name, "llc-misses") == 0) {
+      attr->config = PERF_COUNT_HW_CACHE_MISSES;
+    } else if (strcmp(name, "branch-misses") == 0) {
+      attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Only called on the thread interrupter thread.
+  static bool FirstWarning() {
+    static bool warned = false;
+    const bool first = !warned;
+    warned = true;
+    return first;
+  }
 };
 
 bool ThreadInterrupter::IsDebuggerAttached() {
@@ -53,6 +169,11 @@ void ThreadInterrupter::InterruptThread(OSThread* thread) {
     OS::PrintErr("ThreadInterrupter interrupting %p\n",
                  reinterpret_cast<void*>(thread->id()));
   }
+  if ((FLAG_profiler_hardware_event != NULL) &&
+      ThreadInterrupterLinux::StartHardwareEvent(thread)) {
+    // The thread is interrupted by its perf event instead.
+    return;
+  }
   int result = pthread_kill(thread->id(), SIGPROF);
   ASSERT((result == 0) || (result == ESRCH));
 }
@@ -14,6 +14,24 @@ DEFINE_FLAG(int,
             worker_timeout_millis,
             5000,
             "Free workers when they have been idle for this amount of time.");
+DEFINE_FLAG(int,
+            worker_keep_alive_count,
+            -1,
+            "Number of idle workers which are kept past "
+            "--worker_timeout_millis, so that bursts of tasks reuse threads "
+            "instead of starting new ones. Negative means the number of "
+            "processors.");
+
+// The pool does not bound the number of workers: tasks such as message
+// handlers run for as long as their isolate does, and parallel GC tasks wait
+// for each other, so queueing a task behind busy workers could deadlock.
+// Thread churn is limited instead by keeping some idle workers around.
+static intptr_t KeepAliveCount() {
+  if (FLAG_worker_keep_alive_count < 0) {
+    return OS::NumberOfAvailableProcessors();
+  }
+  return FLAG_worker_keep_alive_count;
+}
 
 ThreadPool::ThreadPool()
     : shutting_down_(false),
@@ -245,6 +263,10 @@ bool ThreadPool::ReleaseIdleWorker(Worker* worker) {
   if (shutting_down_) {
     return false;
   }
+  if (count_idle_ <= static_cast<uint64_t>(KeepAliveCount())) {
+    // Keep this worker for the next task.
+    return false;
+  }
   // Remove from idle list.
   if (!RemoveWorkerFromIdleList(worker)) {
     return false;
@@ -400,8 +422,12 @@ bool ThreadPool::Worker::Loop() {
       if (IsDone()) {
         return false;
       }
-      if ((result == Monitor::kTimedOut) && pool_->ReleaseIdleWorker(this)) {
-        return true;
+      if (result == Monitor::kTimedOut) {
+        if (pool_->ReleaseIdleWorker(this)) {
+          return true;
+        }
+        // Kept alive by the pool: start a new idle period.
+        idle_start = OS::GetCurrentMonotonicMicros();
       }
     }
   }
@@ -10,6 +10,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, worker_timeout_millis);
+DECLARE_FLAG(int, worker_keep_alive_count);
 
 VM_UNIT_TEST_CASE(ThreadPool_Create) {
   ThreadPool thread_pool;
@@ -154,6 +155,8 @@ VM_UNIT_TEST_CASE(ThreadPool_WorkerTimeout) {
   // Adjust the worker timeout so that we timeout quickly.
   int saved_timeout = FLAG_worker_timeout_millis;
   FLAG_worker_timeout_millis = 1;
+  int saved_keep_alive_count = FLAG_worker_keep_alive_count;
+  FLAG_worker_keep_alive_count = 0;
 
   ThreadPool thread_pool;
   EXPECT_EQ(0U, thread_pool.workers_started());
@@ -184,6 +187,36 @@ VM_UNIT_TEST_CASE(ThreadPool_WorkerTimeout) {
   }
   EXPECT_EQ(1U, thread_pool.workers_stopped());
   FLAG_worker_timeout_millis = saved_timeout;
+  FLAG_worker_keep_alive_count = saved_keep_alive_count;
+}
+
+VM_UNIT_TEST_CASE(ThreadPool_WorkerKeepAlive) {
+  int saved_timeout = FLAG_worker_timeout_millis;
+  FLAG_worker_timeout_millis = 1;
+  int saved_keep_alive_count = FLAG_worker_keep_alive_count;
+  FLAG_worker_keep_alive_count = 1;
+
+  ThreadPool thread_pool;
+  Monitor sync;
+  bool done = true;
+  for (int i = 0; i < 2; i++) {
+    thread_pool.Run(new TestTask(&sync, &done));
+    {
+      MonitorLocker ml(&sync);
+      done = false;
+      ml.Notify();
+      while (!done) {
+        ml.Wait();
+      }
+    }
+    // Give the worker time to go idle and time out several times.
+    OS::Sleep(50);
+    // The idle worker is kept and reused for the second task.
+    EXPECT_EQ(1U, thread_pool.workers_started());
+    EXPECT_EQ(0U, thread_pool.workers_stopped());
+  }
+  FLAG_worker_timeout_millis = saved_timeout;
+  FLAG_worker_keep_alive_count = saved_keep_alive_count;
 }
 
 class SpawnTask : public ThreadPool::Task {
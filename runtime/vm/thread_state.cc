@@ -25,7 +25,22 @@ ThreadState::ThreadState(bool is_os_thread) : BaseThread(is_os_thread) {
   }
 }
 
-ThreadState::~ThreadState() {}
+ThreadState::~ThreadState() {
+  delete zone_segment_cache_;
+}
+
+ZoneSegmentCache* ThreadState::zone_segment_cache() {
+  if (zone_segment_cache_ == nullptr) {
+    zone_segment_cache_ = new ZoneSegmentCache();
+  }
+  return zone_segment_cache_;
+}
+
+void ThreadState::ReleaseZoneSegments() {
+  if (zone_segment_cache_ != nullptr) {
+    zone_segment_cache_->ReleaseAll();
+  }
+}
 
 bool ThreadState::ZoneIsOwnedByThread(Zone* zone) const {
   ASSERT(zone != nullptr);
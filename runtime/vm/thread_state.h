@@ -13,6 +13,7 @@ namespace dart {
 class HandleScope;
 class LongJumpScope;
 class Zone;
+class ZoneSegmentCache;
 
 // ThreadState is a container for auxiliary thread-local state: e.g. it
 // owns a stack of Zones for allocation and a stack of StackResources
@@ -65,6 +66,12 @@ class ThreadState : public BaseThread {
 
   void ResetHighWatermark() { zone_high_watermark_ = current_zone_capacity_; }
 
+  // The segments of deleted zones kept for reuse by this thread.
+  ZoneSegmentCache* zone_segment_cache();
+
+  // Frees the cached zone segments, e.g. when the thread goes idle.
+  void ReleaseZoneSegments();
+
   StackResource* top_resource() const { return top_resource_; }
   void set_top_resource(StackResource* value) { top_resource_ = value; }
   static intptr_t top_resource_offset() {
@@ -102,6 +109,7 @@ class ThreadState : public BaseThread {
   Zone* zone_ = nullptr;
   uintptr_t current_zone_capacity_ = 0;
   uintptr_t zone_high_watermark_ = 0;
+  ZoneSegmentCache* zone_segment_cache_ = nullptr;
   StackResource* top_resource_ = nullptr;
   LongJumpScope* long_jump_base_ = nullptr;
 
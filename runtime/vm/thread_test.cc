@@ -12,9 +12,14 @@
 #include "vm/thread_pool.h"
 #include "vm/unit_test.h"
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+#include <sched.h>  // NOLINT
+#endif
+
 namespace dart {
 
 DECLARE_FLAG(bool, enable_interpreter);
+DECLARE_FLAG(int, safepoint_report_threshold);
 
 VM_UNIT_TEST_CASE(Mutex) {
   // This unit test case needs a running isolate.
@@ -80,6 +85,28 @@ VM_UNIT_TEST_CASE(Monitor) {
   delete monitor;
 }
 
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+VM_UNIT_TEST_CASE(OSThread_SetCurrentThreadAffinity) {
+  // Pin to the CPU we are running on, which the process is surely allowed
+  // to use.
+  const int cpu = sched_getcpu();
+  if ((cpu < 0) || (cpu >= 64)) {
+    return;
+  }
+  EXPECT(OSThread::SetCurrentThreadAffinity(static_cast<uint64_t>(1) << cpu));
+  EXPECT_EQ(cpu, sched_getcpu());
+  EXPECT(OSThread::SetCurrentThreadAffinity(0));
+}
+
+VM_UNIT_TEST_CASE(OSThread_SetCurrentThreadBatchScheduling) {
+  EXPECT(OSThread::SetCurrentThreadBatchScheduling(true));
+  EXPECT_EQ(SCHED_IDLE, sched_getscheduler(0));
+  // Threads have to be able to go back without privileges.
+  EXPECT(OSThread::SetCurrentThreadBatchScheduling(false));
+  EXPECT_EQ(SCHED_OTHER, sched_getscheduler(0));
+}
+#endif
+
 class ObjectCounter : public ObjectPointerVisitor {
  public:
   explicit ObjectCounter(Isolate* isolate, const Object* obj)
@@ -862,6 +889,72 @@ ISOLATE_UNIT_TEST_CASE(RecursiveSafepointTest2) {
   } while (!all_exited);
 }
 
+class SlowSafepointTask : public ThreadPool::Task {
+ public:
+  SlowSafepointTask(Isolate* isolate,
+                    Monitor* monitor,
+                    bool* started,
+                    bool* exited)
+      : isolate_(isolate),
+        monitor_(monitor),
+        started_(started),
+        exited_(exited) {}
+
+  virtual void Run() {
+    Thread::EnterIsolateAsHelper(isolate_, Thread::kUnknownTask);
+    {
+      MonitorLocker ml(monitor_);
+      *started_ = true;
+      ml.Notify();
+    }
+    // Keep the safepoint requested by the main thread waiting.
+    OS::Sleep(100);
+    Thread::Current()->CheckForSafepoint();
+    Thread::ExitIsolateAsHelper();
+    {
+      MonitorLocker ml(monitor_);
+      *exited_ = true;
+      ml.Notify();
+    }
+  }
+
+ private:
+  Isolate* isolate_;
+  Monitor* monitor_;
+  bool* started_;
+  bool* exited_;
+};
+
+// Test that reporting a thread which is slow to reach a safepoint does not
+// interfere with the safepoint operation.
+ISOLATE_UNIT_TEST_CASE(SafepointSlowThreadReport) {
+  const int saved_threshold = FLAG_safepoint_report_threshold;
+  FLAG_safepoint_report_threshold = 10;
+  Isolate* isolate = thread->isolate();
+  Monitor monitor;
+  bool started = false;
+  bool exited = false;
+  Dart::thread_pool()->Run(
+      new SlowSafepointTask(isolate, &monitor, &started, &exited));
+  {
+    MonitorLocker ml(&monitor);
+    while (!started) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+  {
+    SafepointOperationScope safepoint_scope(thread);
+    EXPECT(thread->IsAtSafepoint());
+  }
+  {
+    MonitorLocker ml(&monitor);
+    while (!exited) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+  FLAG_safepoint_report_threshold = saved_threshold;
+}
+
 class AllocAndGCTask : public ThreadPool::Task {
  public:
   AllocAndGCTask(Isolate* isolate, Monitor* done_monitor, bool* done)
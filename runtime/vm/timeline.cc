@@ -12,11 +12,13 @@
 #include <cstdlib>
 
 #include "platform/atomic.h"
+#include "vm/dart.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/lockers.h"
 #include "vm/log.h"
 #include "vm/object.h"
+#include "vm/protobuf_writer.h"
 #include "vm/service_event.h"
 #include "vm/thread.h"
 
@@ -53,7 +55,13 @@ DEFINE_FLAG(charp,
             timeline_recorder,
             "ring",
             "Select the timeline recorder used. "
-            "Valid values: ring, endless, startup, and systrace.")
+            "Valid values: ring, endless, startup, systrace, and perfetto.")
+DEFINE_FLAG(charp,
+            timeline_perfetto_file,
+            NULL,
+            "File the perfetto timeline recorder streams to. Defaults to "
+            "dart-timeline-<pid>.pftrace in --timeline_dir or the current "
+            "directory.");
 
 // Implementation notes:
 //
@@ -107,6 +115,24 @@ static TimelineEventRecorder* CreateTimelineRecorder() {
 
   const char* flag = FLAG_timeline_recorder;
 
+  if ((flag != NULL) && (strcmp("perfetto", flag) == 0)) {
+    if (FLAG_trace_timeline) {
+      THR_Print("Using the Perfetto file timeline recorder.\n");
+    }
+    char* path;
+    if (FLAG_timeline_perfetto_file != NULL) {
+      path = strdup(FLAG_timeline_perfetto_file);
+    } else {
+      path = OS::SCreate(NULL, "%s/dart-timeline-%" Pd ".pftrace",
+                         FLAG_timeline_dir != NULL ? FLAG_timeline_dir : ".",
+                         static_cast<intptr_t>(OS::ProcessId()));
+    }
+    TimelineEventRecorder* recorder =
+        new TimelineEventPerfettoFileRecorder(path);
+    free(path);
+    return recorder;
+  }
+
   if (use_systrace_recorder || (flag != NULL)) {
     if (use_systrace_recorder || (strcmp("systrace", flag) == 0)) {
       if (FLAG_trace_timeline) {
@@ -215,7 +241,8 @@ void Timeline::Cleanup() {
   ASSERT(recorder_ != NULL);
 
 #ifndef PRODUCT
-  if (FLAG_timeline_dir != NULL) {
+  if ((FLAG_timeline_dir != NULL) &&
+      (strcmp(recorder_->name(), "PerfettoFile") != 0)) {
     recorder_->WriteTo(FLAG_timeline_dir);
   }
 #endif
@@ -993,6 +1020,7 @@ TimelineEvent* TimelineEventRecorder::ThreadBlockStartEvent() {
     // Thread has a block and it is full:
     // 1) Mark it as finished.
     thread_block->Finish();
+    BlockFinishedLocked(thread_block);
     // 2) Allocate a new block.
     thread_block = GetNewBlockLocked();
     thread->set_timeline_block(thread_block);
@@ -1123,6 +1151,7 @@ void TimelineEventRecorder::FinishBlock(TimelineEventBlock* block) {
   }
   MutexLocker ml(&lock_);
   block->Finish();
+  BlockFinishedLocked(block);
 }
 
 TimelineEventBlock* TimelineEventRecorder::GetNewBlock() {
@@ -1488,6 +1517,440 @@ void TimelineEventEndlessRecorder::Clear() {
   OSThread* thread = OSThread::Current();
   thread->set_timeline_block(NULL);
 }
+// Field numbers of the Perfetto trace protos, see
+// protos/perfetto/trace/ in https://github.com/google/perfetto.
+enum {
+  kTracePacket = 1,
+
+  kTracePacketTimestamp = 8,
+  kTracePacketTrustedSequenceId = 10,
+  kTracePacketTrackEvent = 11,
+  kTracePacketSequenceFlags = 13,
+  kTracePacketTimestampClockId = 58,
+  kTracePacketTrackDescriptor = 60,
+
+  kTrackDescriptorUuid = 1,
+  kTrackDescriptorName = 2,
+  kTrackDescriptorProcess = 3,
+  kTrackDescriptorThread = 4,
+  kTrackDescriptorParentUuid = 5,
+  kTrackDescriptorCounter = 8,
+
+  kProcessDescriptorPid = 1,
+  kProcessDescriptorName = 6,
+
+  kThreadDescriptorPid = 1,
+  kThreadDescriptorTid = 2,
+  kThreadDescriptorName = 5,
+
+  kTrackEventDebugAnnotation = 4,
+  kTrackEventType = 9,
+  kTrackEventTrackUuid = 11,
+  kTrackEventCategory = 22,
+  kTrackEventName = 23,
+  kTrackEventDoubleCounterValue = 44,
+  kTrackEventFlowId = 47,
+  kTrackEventTerminatingFlowId = 48,
+
+  kDebugAnnotationStringValue = 6,
+  kDebugAnnotationName = 10,
+};
+
+// Values of TrackEvent.Type.
+enum {
+  kTrackEventSliceBegin = 1,
+  kTrackEventSliceEnd = 2,
+  kTrackEventInstant = 3,
+  kTrackEventCounter = 4,
+};
+
+static const intptr_t kBuiltinClockMonotonic = 3;
+static const intptr_t kSequenceIncrementalStateCleared = 1;
+static const intptr_t kTrustedSequenceId = 1;
+
+// The low bits of a track uuid tell the kinds of tracks apart.
+static uint64_t ProcessTrackUuid() {
+  return static_cast<uint64_t>(OS::ProcessId()) << 2;
+}
+
+static uint64_t ThreadTrackUuid(ThreadId tid) {
+  return (static_cast<uint64_t>(OSThread::ThreadIdToIntPtr(tid)) << 2) | 1;
+}
+
+static uint64_t AsyncTrackUuid(int64_t async_id) {
+  return (static_cast<uint64_t>(async_id) << 2) | 2;
+}
+
+static uint64_t CounterTrackUuid(const char* name) {
+  return (static_cast<uint64_t>(Utils::StringHash(name, strlen(name))) << 2) |
+         3;
+}
+
+static void WritePacket(ProtobufWriter* trace,
+                        ProtobufWriter* packet,
+                        intptr_t field,
+                        ProtobufWriter* payload) {
+  packet->WriteInt(kTracePacketTrustedSequenceId, kTrustedSequenceId);
+  packet->WriteMessage(field, payload);
+  trace->WriteMessage(kTracePacket, packet);
+}
+
+static void WriteTrackDescriptor(ProtobufWriter* trace,
+                                 uint64_t uuid,
+                                 const char* name,
+                                 bool is_counter) {
+  ProtobufWriter track;
+  track.WriteInt(kTrackDescriptorUuid, uuid);
+  track.WriteInt(kTrackDescriptorParentUuid, ProcessTrackUuid());
+  track.WriteString(kTrackDescriptorName, name);
+  if (is_counter) {
+    ProtobufWriter counter;
+    track.WriteMessage(kTrackDescriptorCounter, &counter);
+  }
+  ProtobufWriter packet;
+  WritePacket(trace, &packet, kTracePacketTrackDescriptor, &track);
+}
+
+static void WriteThreadTrackDescriptor(ProtobufWriter* trace, ThreadId tid) {
+  ProtobufWriter thread;
+  thread.WriteInt(kThreadDescriptorPid, OS::ProcessId());
+  thread.WriteInt(kThreadDescriptorTid, OSThread::ThreadIdToIntPtr(tid));
+  {
+    OSThreadIterator it;
+    while (it.HasNext()) {
+      OSThread* os_thread = it.Next();
+      if ((os_thread->trace_id() == tid) && (os_thread->name() != NULL)) {
+        thread.WriteString(kThreadDescriptorName, os_thread->name());
+        break;
+      }
+    }
+  }
+  ProtobufWriter track;
+  track.WriteInt(kTrackDescriptorUuid, ThreadTrackUuid(tid));
+  track.WriteInt(kTrackDescriptorParentUuid, ProcessTrackUuid());
+  track.WriteMessage(kTrackDescriptorThread, &thread);
+  ProtobufWriter packet;
+  WritePacket(trace, &packet, kTracePacketTrackDescriptor, &track);
+}
+
+static void WriteProcessTrackDescriptor(ProtobufWriter* trace) {
+  ProtobufWriter process;
+  process.WriteInt(kProcessDescriptorPid, OS::ProcessId());
+  process.WriteString(kProcessDescriptorName, "dart");
+  ProtobufWriter track;
+  track.WriteInt(kTrackDescriptorUuid, ProcessTrackUuid());
+  track.WriteMessage(kTrackDescriptorProcess, &process);
+  ProtobufWriter packet;
+  packet.WriteInt(kTracePacketSequenceFlags, kSequenceIncrementalStateCleared);
+  WritePacket(trace, &packet, kTracePacketTrackDescriptor, &track);
+}
+
+static void WriteDebugAnnotation(ProtobufWriter* track_event,
+                                 const char* name,
+                                 const char* value) {
+  ProtobufWriter annotation;
+  annotation.WriteString(kDebugAnnotationName, name);
+  annotation.WriteString(kDebugAnnotationStringValue, value);
+  track_event->WriteMessage(kTrackEventDebugAnnotation, &annotation);
+}
+
+static void WriteTrackEvent(ProtobufWriter* trace,
+                            const TimelineEvent* event,
+                            int64_t micros,
+                            intptr_t type,
+                            uint64_t track_uuid,
+                            ProtobufWriter* track_event) {
+  track_event->WriteInt(kTrackEventType, type);
+  track_event->WriteInt(kTrackEventTrackUuid, track_uuid);
+  if ((type != kTrackEventSliceEnd) && (type != kTrackEventCounter)) {
+    track_event->WriteString(kTrackEventName, event->label());
+    TimelineStream* stream = event->stream();
+    if (stream != NULL) {
+      track_event->WriteString(kTrackEventCategory, stream->name());
+    }
+    for (intptr_t i = 0; i < event->arguments_length(); i++) {
+      const TimelineEventArgument& arg = event->arguments()[i];
+      WriteDebugAnnotation(track_event, arg.name, arg.value);
+    }
+  }
+  ProtobufWriter packet;
+  packet.WriteInt(kTracePacketTimestamp, micros * kNanosecondsPerMicrosecond);
+  packet.WriteInt(kTracePacketTimestampClockId, kBuiltinClockMonotonic);
+  WritePacket(trace, &packet, kTracePacketTrackEvent, track_event);
+}
+
+static void WriteTrackEvent(ProtobufWriter* trace,
+                            const TimelineEvent* event,
+                            int64_t micros,
+                            intptr_t type,
+                            uint64_t track_uuid) {
+  ProtobufWriter track_event;
+  WriteTrackEvent(trace, event, micros, type, track_uuid, &track_event);
+}
+
+static void WriteCounters(ProtobufWriter* trace, const TimelineEvent* event) {
+  for (intptr_t i = 0; i < event->arguments_length(); i++) {
+    const TimelineEventArgument& arg = event->arguments()[i];
+    char* name = OS::SCreate(NULL, "%s %s", event->label(), arg.name);
+    uint64_t uuid = CounterTrackUuid(name);
+    WriteTrackDescriptor(trace, uuid, name, true);
+    free(name);
+    ProtobufWriter track_event;
+    track_event.WriteDouble(kTrackEventDoubleCounterValue,
+                            strtod(arg.value, NULL));
+    WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventCounter,
+                    uuid, &track_event);
+  }
+}
+
+static void WriteFlow(ProtobufWriter* trace,
+                      const TimelineEvent* event,
+                      uint64_t track_uuid) {
+  const bool is_end = event->event_type() == TimelineEvent::kFlowEnd;
+  ProtobufWriter track_event;
+  track_event.WriteFixed64(
+      is_end ? kTrackEventTerminatingFlowId : kTrackEventFlowId,
+      event->AsyncId());
+  WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventInstant,
+                  track_uuid, &track_event);
+}
+
+static void WritePerfettoEvent(ProtobufWriter* trace,
+                               const TimelineEvent* event) {
+  const uint64_t thread_track = ThreadTrackUuid(event->thread());
+  switch (event->event_type()) {
+    case TimelineEvent::kBegin:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventSliceBegin,
+                      thread_track);
+      break;
+    case TimelineEvent::kEnd:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventSliceEnd,
+                      thread_track);
+      break;
+    case TimelineEvent::kDuration:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventSliceBegin,
+                      thread_track);
+      WriteTrackEvent(trace, event, event->TimeEnd(), kTrackEventSliceEnd,
+                      thread_track);
+      break;
+    case TimelineEvent::kInstant:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventInstant,
+                      thread_track);
+      break;
+    case TimelineEvent::kAsyncBegin: {
+      // Each async id gets its own track, named after its first event.
+      const uint64_t async_track = AsyncTrackUuid(event->AsyncId());
+      WriteTrackDescriptor(trace, async_track, event->label(), false);
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventSliceBegin,
+                      async_track);
+      break;
+    }
+    case TimelineEvent::kAsyncInstant:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventInstant,
+                      AsyncTrackUuid(event->AsyncId()));
+      break;
+    case TimelineEvent::kAsyncEnd:
+      WriteTrackEvent(trace, event, event->TimeOrigin(), kTrackEventSliceEnd,
+                      AsyncTrackUuid(event->AsyncId()));
+      break;
+    case TimelineEvent::kCounter:
+      WriteCounters(trace, event);
+      break;
+    case TimelineEvent::kFlowBegin:
+    case TimelineEvent::kFlowStep:
+    case TimelineEvent::kFlowEnd:
+      WriteFlow(trace, event, thread_track);
+      break;
+    default:
+      // Metadata and unfinished events have no Perfetto counterpart.
+      break;
+  }
+}
+
+TimelineEventPerfettoFileRecorder::TimelineEventPerfettoFileRecorder(
+    const char* path,
+    intptr_t num_blocks)
+    : path_(strdup(path)),
+      file_(NULL),
+      blocks_(NULL),
+      num_blocks_(num_blocks),
+      free_blocks_(num_blocks),
+      dropped_events_(0),
+      pending_blocks_(num_blocks),
+      shutdown_(false),
+      writer_id_(OSThread::kInvalidThreadJoinId) {
+  ASSERT(num_blocks_ > 0);
+  blocks_ = new TimelineEventBlock*[num_blocks_];
+  for (intptr_t i = 0; i < num_blocks_; i++) {
+    blocks_[i] = new TimelineEventBlock(i);
+    free_blocks_.Add(blocks_[i]);
+  }
+  MonitorLocker ml(&monitor_);
+  int result = OSThread::Start("Dart Timeline Writer", WriterMain,
+                               reinterpret_cast<uword>(this));
+  if (result != 0) {
+    FATAL1("Could not start timeline writer thread: error %d\n", result);
+  }
+  while (writer_id_ == OSThread::kInvalidThreadJoinId) {
+    ml.Wait();
+  }
+}
+
+TimelineEventPerfettoFileRecorder::~TimelineEventPerfettoFileRecorder() {
+  // Hand the blocks the threads are still filling to the writer, which writes
+  // out everything pending before it exits.
+  Timeline::ReclaimCachedBlocksFromThreads();
+  {
+    MonitorLocker ml(&monitor_);
+    shutdown_ = true;
+    ml.Notify();
+  }
+  OSThread::Join(writer_id_);
+  writer_id_ = OSThread::kInvalidThreadJoinId;
+  if (dropped_events_ > 0) {
+    OS::PrintErr(
+        "Warning: The Perfetto timeline recorder dropped %" Pd
+        " events because the writer fell behind.\n",
+        dropped_events_);
+  }
+  for (intptr_t i = 0; i < num_blocks_; i++) {
+    delete blocks_[i];
+  }
+  delete[] blocks_;
+  free(path_);
+}
+
+#ifndef PRODUCT
+void TimelineEventPerfettoFileRecorder::PrintJSON(
+    JSONStream* js,
+    TimelineEventFilter* filter) {
+  if (!FLAG_support_service) {
+    return;
+  }
+  JSONObject topLevel(js);
+  topLevel.AddProperty("type", "_Timeline");
+  {
+    JSONArray events(&topLevel, "traceEvents");
+    PrintJSONMeta(&events);
+  }
+}
+
+void TimelineEventPerfettoFileRecorder::PrintTraceEvent(
+    JSONStream* js,
+    TimelineEventFilter* filter) {
+  if (!FLAG_support_service) {
+    return;
+  }
+  JSONArray events(js);
+  PrintJSONMeta(&events);
+}
+#endif
+
+TimelineEvent* TimelineEventPerfettoFileRecorder::StartEvent() {
+  return ThreadBlockStartEvent();
+}
+
+void TimelineEventPerfettoFileRecorder::CompleteEvent(TimelineEvent* event) {
+  if (event == NULL) {
+    return;
+  }
+  ThreadBlockCompleteEvent(event);
+}
+
+TimelineEventBlock* TimelineEventPerfettoFileRecorder::GetNewBlockLocked() {
+  if (free_blocks_.is_empty()) {
+    // Called once for every event the calling thread can't record.
+    dropped_events_++;
+    return NULL;
+  }
+  TimelineEventBlock* block = free_blocks_.RemoveLast();
+  block->Open();
+  return block;
+}
+
+void TimelineEventPerfettoFileRecorder::BlockFinishedLocked(
+    TimelineEventBlock* block) {
+  MonitorLocker ml(&monitor_);
+  pending_blocks_.Add(block);
+  ml.Notify();
+}
+
+void TimelineEventPerfettoFileRecorder::WriterMain(uword parameter) {
+  TimelineEventPerfettoFileRecorder* recorder =
+      reinterpret_cast<TimelineEventPerfettoFileRecorder*>(parameter);
+  {
+    MonitorLocker ml(&recorder->monitor_);
+    OSThread* os_thread = OSThread::Current();
+    recorder->writer_id_ = OSThread::GetCurrentThreadJoinId(os_thread);
+    ml.Notify();
+  }
+  recorder->WriteBlocks();
+}
+
+void TimelineEventPerfettoFileRecorder::WriteBlocks() {
+  Dart_FileOpenCallback file_open = Dart::file_open_callback();
+  if ((file_open != NULL) && (Dart::file_write_callback() != NULL) &&
+      (Dart::file_close_callback() != NULL)) {
+    file_ = (*file_open)(path_, true);
+  }
+  if (file_ == NULL) {
+    OS::PrintErr("Failed to open timeline file: %s\n", path_);
+  } else {
+    ProtobufWriter trace;
+    WriteProcessTrackDescriptor(&trace);
+    WriteData(trace.buffer()->buf(), trace.buffer()->length());
+  }
+
+  MallocGrowableArray<TimelineEventBlock*> blocks;
+  while (true) {
+    {
+      MonitorLocker ml(&monitor_);
+      while (pending_blocks_.is_empty() && !shutdown_) {
+        ml.Wait();
+      }
+      if (pending_blocks_.is_empty()) {
+        break;
+      }
+      for (intptr_t i = 0; i < pending_blocks_.length(); i++) {
+        blocks.Add(pending_blocks_[i]);
+      }
+      pending_blocks_.Clear();
+    }
+    for (intptr_t i = 0; i < blocks.length(); i++) {
+      WriteBlock(blocks[i]);
+      blocks[i]->Reset();
+    }
+    {
+      MutexLocker ml(&lock_);
+      for (intptr_t i = 0; i < blocks.length(); i++) {
+        free_blocks_.Add(blocks[i]);
+      }
+    }
+    blocks.Clear();
+  }
+
+  if (file_ != NULL) {
+    (*Dart::file_close_callback())(file_);
+    file_ = NULL;
+  }
+}
+
+void TimelineEventPerfettoFileRecorder::WriteBlock(TimelineEventBlock* block) {
+  if ((file_ == NULL) || block->IsEmpty()) {
+    return;
+  }
+  ProtobufWriter trace;
+  WriteThreadTrackDescriptor(&trace, block->thread_id());
+  for (intptr_t i = 0; i < block->length(); i++) {
+    WritePerfettoEvent(&trace, block->At(i));
+  }
+  WriteData(trace.buffer()->buf(), trace.buffer()->length());
+}
+
+void TimelineEventPerfettoFileRecorder::WriteData(const void* data,
+                                                  intptr_t length) {
+  (*Dart::file_write_callback())(data, length, file_);
+}
 
 TimelineEventBlock::TimelineEventBlock(intptr_t block_index)
     : next_(NULL),
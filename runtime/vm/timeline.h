@@ -324,6 +324,8 @@ class TimelineEvent {
 
   const char* label() const { return label_; }
 
+  TimelineStream* stream() const { return stream_; }
+
   // Does this duration end before |micros| ?
   bool DurationFinishedBefore(int64_t micros) const {
     return TimeEnd() <= micros;
@@ -445,6 +447,7 @@ class TimelineEvent {
   friend class TimelineEventStartupRecorder;
   friend class TimelineEventPlatformRecorder;
   friend class TimelineEventFuchsiaRecorder;
+  friend class TimelineEventPerfettoFileRecorder;
   friend class TimelineStream;
   friend class TimelineTestHelper;
   DISALLOW_COPY_AND_ASSIGN(TimelineEvent);
@@ -627,6 +630,7 @@ class TimelineEventBlock {
   friend class TimelineEventRingRecorder;
   friend class TimelineEventStartupRecorder;
   friend class TimelineEventPlatformRecorder;
+  friend class TimelineEventPerfettoFileRecorder;
   friend class TimelineTestHelper;
   friend class JSONStream;
 
@@ -717,6 +721,9 @@ class TimelineEventRecorder {
   virtual TimelineEventBlock* GetNewBlockLocked() = 0;
   virtual void Clear() = 0;
 
+  // Called with |lock_| held after a thread is done filling |block|.
+  virtual void BlockFinishedLocked(TimelineEventBlock* block) {}
+
   // Utility method(s).
 #ifndef PRODUCT
   void PrintJSONMeta(JSONArray* array) const;
@@ -861,6 +868,64 @@ class TimelineEventEndlessRecorder : public TimelineEventRecorder {
   friend class TimelineTestHelper;
 };
 
+// A recorder that streams events to a file in the Perfetto trace format
+// (https://perfetto.dev), which Perfetto and chrome://tracing can load.
+//
+// Threads fill blocks taken from a fixed pool. Finished blocks are handed to a
+// background thread that encodes them as trace packets, appends them to the
+// file and returns them to the pool. When the pool is empty new events are
+// dropped, so memory use stays bounded no matter how long the VM runs.
+class TimelineEventPerfettoFileRecorder : public TimelineEventRecorder {
+ public:
+  static const intptr_t kDefaultNumBlocks = 256;
+
+  explicit TimelineEventPerfettoFileRecorder(
+      const char* path,
+      intptr_t num_blocks = kDefaultNumBlocks);
+  virtual ~TimelineEventPerfettoFileRecorder();
+
+  // The events have already left the VM, so only the metadata is printed.
+#ifndef PRODUCT
+  void PrintJSON(JSONStream* js, TimelineEventFilter* filter);
+  void PrintTraceEvent(JSONStream* js, TimelineEventFilter* filter);
+#endif
+
+  const char* name() const { return "PerfettoFile"; }
+
+  intptr_t dropped_events() const { return dropped_events_; }
+
+ protected:
+  TimelineEvent* StartEvent();
+  void CompleteEvent(TimelineEvent* event);
+  TimelineEventBlock* GetNewBlockLocked();
+  TimelineEventBlock* GetHeadBlockLocked() { return NULL; }
+  void Clear() {}
+  void BlockFinishedLocked(TimelineEventBlock* block);
+
+ private:
+  static void WriterMain(uword parameter);
+  void WriteBlocks();
+  void WriteBlock(TimelineEventBlock* block);
+  void WriteData(const void* data, intptr_t length);
+
+  char* path_;
+  void* file_;
+  TimelineEventBlock** blocks_;
+  intptr_t num_blocks_;
+  // Blocks no thread is using. Guarded by |lock_|.
+  MallocGrowableArray<TimelineEventBlock*> free_blocks_;
+  intptr_t dropped_events_;
+
+  // Guards |pending_blocks_| and |shutdown_|.
+  Monitor monitor_;
+  MallocGrowableArray<TimelineEventBlock*> pending_blocks_;
+  bool shutdown_;
+  ThreadJoinId writer_id_;
+
+  friend class TimelineTestHelper;
+  DISALLOW_COPY_AND_ASSIGN(TimelineEventPerfettoFileRecorder);
+};
+
 // An iterator for blocks.
 class TimelineEventBlockIterator {
  public:
@@ -179,14 +179,15 @@ RawCode* TypeTestingStubGenerator::BuildCodeForType(const Type& type) {
   HierarchyInfo* hi = Thread::Current()->hierarchy_info();
   ASSERT(hi != NULL);
 
+  const Class& type_class = Class::Handle(type.type_class());
+  ASSERT(!type_class.IsNull());
+
   if (!hi->CanUseSubtypeRangeCheckFor(type) &&
-      !hi->CanUseGenericSubtypeRangeCheckFor(type)) {
+      !hi->CanUseGenericSubtypeRangeCheckFor(type) &&
+      !CanUseInterfaceRangeCheckFor(hi, type, type_class)) {
     return Code::null();
   }
 
-  const Class& type_class = Class::Handle(type.type_class());
-  ASSERT(!type_class.IsNull());
-
   // To use the already-defined __ Macro !
   Assembler assembler(nullptr);
   BuildOptimizedTypeTestStub(&assembler, hi, type, type_class);
@@ -256,9 +257,7 @@ void TypeTestingStubGenerator::BuildOptimizedTypeTestStubFastCases(
 
     BuildOptimizedSubtypeRangeCheck(assembler, ranges, class_id_reg,
                                     instance_reg, smi_is_ok);
-  } else {
-    ASSERT(hi->CanUseGenericSubtypeRangeCheckFor(type));
-
+  } else if (hi->CanUseGenericSubtypeRangeCheckFor(type)) {
     const intptr_t num_type_parameters = type_class.NumTypeParameters();
     const intptr_t num_type_arguments = type_class.NumTypeArguments();
 
@@ -271,6 +270,10 @@ void TypeTestingStubGenerator::BuildOptimizedTypeTestStubFastCases(
 
     BuildOptimizedSubclassRangeCheckWithTypeArguments(assembler, hi, type_class,
                                                       tp, ta);
+  } else {
+    ASSERT(CanUseInterfaceRangeCheckFor(hi, type, type_class));
+    BuildOptimizedInterfaceRangeCheckWithTypeArguments(assembler, hi, type,
+                                                       type_class);
   }
 
   // Fast case for 'null'.
@@ -361,6 +364,289 @@ void TypeTestingStubGenerator::
   __ Bind(&check_failed);
 }
 
+// The concrete classes implementing a generic interface which hold the type
+// arguments of the interface at the same indices of their type argument
+// vector.
+struct InterfaceImplementorGroup : public ZoneAllocated {
+  enum {
+    // The type argument is statically known to be a subtype.
+    kNoCheck = -1,
+  };
+
+  InterfaceImplementorGroup(Zone* zone, intptr_t type_arguments_field_offset)
+      : type_arguments_field_offset(type_arguments_field_offset),
+        type_argument_indices(zone, 2),
+        cids(zone, 4) {}
+
+  bool HasTypeArgumentChecks() const {
+    return type_arguments_field_offset != Class::kNoTypeArguments;
+  }
+
+  // [Class::kNoTypeArguments] if no type argument has to be checked.
+  const intptr_t type_arguments_field_offset;
+  // For every type parameter of the interface the index of its value in the
+  // type argument vector of the instance, or [kNoCheck].
+  GrowableArray<intptr_t> type_argument_indices;
+  // Sorted class ids of the group.
+  GrowableArray<intptr_t> cids;
+};
+
+static bool HasTypeArgumentChecks(const GrowableArray<intptr_t>& indices) {
+  for (intptr_t i = 0; i < indices.length(); ++i) {
+    if (indices[i] != InterfaceImplementorGroup::kNoCheck) return true;
+  }
+  return false;
+}
+
+// Computes the type arguments of [interface] as a supertype of [cls] given the
+// type arguments [args] of [cls]. Returns false if [interface] is not a
+// (finalized) supertype of [cls].
+static bool FindInterfaceTypeArguments(Zone* zone,
+                                       const Class& cls,
+                                       const TypeArguments& args,
+                                       const Class& interface,
+                                       TypeArguments* result) {
+  Class& this_class = Class::Handle(zone, cls.raw());
+  Array& interfaces = Array::Handle(zone);
+  AbstractType& interface_type = AbstractType::Handle(zone);
+  Class& interface_class = Class::Handle(zone);
+  TypeArguments& interface_args = TypeArguments::Handle(zone);
+  while (!this_class.IsNull()) {
+    if (this_class.raw() == interface.raw()) {
+      // Subclasses do not truncate the type argument vector of their super
+      // classes, see [Class::IsSubtypeOf].
+      *result = args.raw();
+      return true;
+    }
+    interfaces = this_class.interfaces();
+    for (intptr_t i = 0; i < interfaces.Length(); i++) {
+      interface_type ^= interfaces.At(i);
+      if (!interface_type.IsFinalized()) return false;
+      interface_class = interface_type.type_class();
+      interface_args = interface_type.arguments();
+      if (!interface_args.IsNull() && !interface_args.IsInstantiated()) {
+        interface_args = interface_args.InstantiateFrom(
+            args, Object::null_type_arguments(), kNoneFree, NULL, Heap::kNew);
+      }
+      if (FindInterfaceTypeArguments(zone, interface_class, interface_args,
+                                     interface, result)) {
+        return true;
+      }
+    }
+    this_class = this_class.SuperClass();
+  }
+  return false;
+}
+
+// Computes where the instances of [cls] hold the type arguments of the
+// interface [type]. Returns false if instances of [cls] have to be checked by
+// the slow path.
+static bool ComputeTypeArgumentIndices(Zone* zone,
+                                       const Class& cls,
+                                       const Type& type,
+                                       const Class& type_class,
+                                       GrowableArray<intptr_t>* indices) {
+  const Type& declaration_type = Type::Handle(zone, cls.DeclarationType());
+  const TypeArguments& declaration_args =
+      TypeArguments::Handle(zone, declaration_type.arguments());
+  TypeArguments& interface_args = TypeArguments::Handle(zone);
+  if (!FindInterfaceTypeArguments(zone, cls, declaration_args, type_class,
+                                  &interface_args)) {
+    return false;
+  }
+
+  const TypeArguments& ta = TypeArguments::Handle(zone, type.arguments());
+  const intptr_t num_type_parameters = type_class.NumTypeParameters();
+  const intptr_t from_index =
+      type_class.NumTypeArguments() - num_type_parameters;
+  AbstractType& type_arg = AbstractType::Handle(zone);
+  AbstractType& interface_arg = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < num_type_parameters; ++i) {
+    type_arg = ta.TypeAt(from_index + i);
+    if (type_arg.raw() == Type::ObjectType() ||
+        type_arg.raw() == Type::DynamicType()) {
+      indices->Add(InterfaceImplementorGroup::kNoCheck);
+      continue;
+    }
+    // A null vector means all type arguments of the interface are dynamic.
+    if (interface_args.IsNull()) return false;
+    interface_arg = interface_args.TypeAt(from_index + i);
+    if (interface_arg.IsTypeParameter() &&
+        (TypeParameter::Cast(interface_arg).parameterized_class_id() ==
+         cls.id())) {
+      indices->Add(TypeParameter::Cast(interface_arg).index());
+    } else if (interface_arg.IsInstantiated() && type_arg.IsInstantiated() &&
+               interface_arg.IsSubtypeOf(type_arg, Heap::kNew)) {
+      indices->Add(InterfaceImplementorGroup::kNoCheck);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void CollectInterfaceImplementorGroups(
+    HierarchyInfo* hi,
+    const Type& type,
+    const Class& type_class,
+    GrowableArray<InterfaceImplementorGroup*>* groups) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  ClassTable* class_table = thread->isolate()->class_table();
+
+  const CidRangeVector& ranges =
+      hi->SubtypeRangesForClass(type_class,
+                                /*include_abstract=*/false,
+                                /*exclude_null=*/true);
+  Class& cls = Class::Handle(zone);
+  GrowableArray<intptr_t> indices(zone, type_class.NumTypeParameters());
+  for (intptr_t i = 0; i < ranges.length(); ++i) {
+    if (ranges[i].IsIllegalRange()) continue;
+    for (intptr_t cid = ranges[i].cid_start; cid <= ranges[i].cid_end; ++cid) {
+      if (!class_table->HasValidClassAt(cid)) continue;
+      cls = class_table->At(cid);
+      if (!cls.is_finalized() || cls.is_abstract()) continue;
+
+      indices.Clear();
+      if (!ComputeTypeArgumentIndices(zone, cls, type, type_class, &indices)) {
+        continue;
+      }
+
+      // The offset does not matter if nothing is loaded from the vector, so
+      // all such classes share a group.
+      const intptr_t offset = HasTypeArgumentChecks(indices)
+                                  ? cls.type_arguments_field_offset()
+                                  : Class::kNoTypeArguments;
+      InterfaceImplementorGroup* group = NULL;
+      for (intptr_t j = 0; j < groups->length(); ++j) {
+        InterfaceImplementorGroup* candidate = (*groups)[j];
+        if (candidate->type_arguments_field_offset != offset) continue;
+        bool same_indices = true;
+        for (intptr_t k = 0; k < indices.length(); ++k) {
+          if (candidate->type_argument_indices[k] != indices[k]) {
+            same_indices = false;
+            break;
+          }
+        }
+        if (same_indices) {
+          group = candidate;
+          break;
+        }
+      }
+      if (group == NULL) {
+        group = new (zone) InterfaceImplementorGroup(zone, offset);
+        group->type_argument_indices.AddArray(indices);
+        groups->Add(group);
+      }
+      group->cids.Add(cid);
+    }
+  }
+}
+
+bool TypeTestingStubGenerator::CanUseInterfaceRangeCheckFor(
+    HierarchyInfo* hi,
+    const Type& type,
+    const Class& type_class) {
+  if (type.IsFunctionType() || type.IsDartFunctionType()) {
+    return false;
+  }
+  // See [HierarchyInfo::CanUseGenericSubtypeRangeCheckFor] for FutureOr.
+  if (!type_class.is_implemented() || !type_class.IsGeneric() ||
+      type_class.IsFutureOrClass() ||
+      (type.arguments() == TypeArguments::null())) {
+    return false;
+  }
+
+  const TypeArguments& ta = TypeArguments::Handle(type.arguments());
+  const intptr_t num_type_parameters = type_class.NumTypeParameters();
+  const intptr_t from_index =
+      type_class.NumTypeArguments() - num_type_parameters;
+  AbstractType& type_arg = AbstractType::Handle();
+  for (intptr_t i = 0; i < num_type_parameters; ++i) {
+    type_arg = ta.TypeAt(from_index + i);
+    if (!type_arg.IsTypeParameter() &&
+        !hi->CanUseSubtypeRangeCheckFor(type_arg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TypeTestingStubGenerator::
+    BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+        Assembler* assembler,
+        HierarchyInfo* hi,
+        const Type& type,
+        const Class& type_class,
+        const Register class_id_reg,
+        const Register instance_reg,
+        const Register instance_type_args_reg) {
+  Zone* zone = Thread::Current()->zone();
+
+  // The implementations of the interface might store its type arguments at
+  // different offsets and indices. We group the implementations by where
+  // they store them and emit a cid-range check followed by the type argument
+  // checks for every group. Implementations which do not pass the type
+  // arguments of the interface through, e.g. `class A implements List<B<T>>`,
+  // are left to the slow path.
+  GrowableArray<InterfaceImplementorGroup*> groups(zone, 4);
+  CollectInterfaceImplementorGroups(hi, type, type_class, &groups);
+
+  const TypeArguments& ta = TypeArguments::Handle(zone, type.arguments());
+  const intptr_t num_type_parameters = type_class.NumTypeParameters();
+  const intptr_t from_index =
+      type_class.NumTypeArguments() - num_type_parameters;
+  AbstractType& type_arg = AbstractType::Handle(zone);
+
+  Label check_failed;
+  for (intptr_t i = 0; i < groups.length(); ++i) {
+    InterfaceImplementorGroup* group = groups[i];
+
+    CidRangeVector ranges;
+    for (intptr_t j = 0; j < group->cids.length(); ++j) {
+      const intptr_t cid = group->cids[j];
+      if (!ranges.is_empty() && (ranges.Last().cid_end + 1 == cid)) {
+        ranges.Last().cid_end = cid;
+      } else {
+        ranges.Add(CidRange(cid, cid));
+      }
+    }
+
+    // The range check biases the class id register, so it is reloaded for
+    // every group.
+    Label next_group;
+    BuildOptimizedSubclassRangeCheck(assembler, ranges, class_id_reg,
+                                     instance_reg, &next_group);
+
+    if (group->HasTypeArgumentChecks()) {
+      __ LoadField(instance_type_args_reg,
+                   FieldAddress(instance_reg,
+                                group->type_arguments_field_offset));
+
+      // See [BuildOptimizedSubclassRangeCheckWithTypeArguments] on why the
+      // null vector is accepted.
+      Label process_done;
+      __ CompareObject(instance_type_args_reg, Object::null_object());
+      __ BranchIf(NOT_EQUAL, &process_done);
+      __ Ret();
+      __ Bind(&process_done);
+
+      for (intptr_t j = 0; j < num_type_parameters; ++j) {
+        const intptr_t index = group->type_argument_indices[j];
+        if (index == InterfaceImplementorGroup::kNoCheck) continue;
+        type_arg = ta.TypeAt(from_index + j);
+        BuildOptimizedTypeArgumentValueCheck(assembler, hi, type_arg, index,
+                                             &check_failed);
+      }
+    }
+    __ Ret();
+    __ Bind(&next_group);
+  }
+
+  // If anything fails.
+  __ Bind(&check_failed);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedSubclassRangeCheck(
     Assembler* assembler,
     const CidRangeVector& ranges,
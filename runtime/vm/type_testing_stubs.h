@@ -89,6 +89,27 @@ class TypeTestingStubGenerator {
       const Register instance_reg,
       const Register instance_type_args_reg);
 
+  // Whether [BuildOptimizedInterfaceRangeCheckWithTypeArguments] can be used
+  // for [type], a generic type whose class is implemented by other classes.
+  static bool CanUseInterfaceRangeCheckFor(HierarchyInfo* hi,
+                                           const Type& type,
+                                           const Class& type_class);
+
+  static void BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+      Assembler* assembler,
+      HierarchyInfo* hi,
+      const Type& type,
+      const Class& type_class);
+
+  static void BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+      Assembler* assembler,
+      HierarchyInfo* hi,
+      const Type& type,
+      const Class& type_class,
+      const Register class_id_reg,
+      const Register instance_reg,
+      const Register instance_type_args_reg);
+
   static void BuildOptimizedSubclassRangeCheck(Assembler* assembler,
                                                const CidRangeVector& ranges,
                                                Register class_id_reg,
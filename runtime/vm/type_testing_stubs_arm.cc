@@ -42,6 +42,21 @@ void TypeTestingStubGenerator::
       kInstanceTypeArguments);
 }
 
+void TypeTestingStubGenerator::
+    BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+        Assembler* assembler,
+        HierarchyInfo* hi,
+        const Type& type,
+        const Class& type_class) {
+  const Register kInstanceReg = R0;
+  const Register kInstanceTypeArguments = NOTFP;
+  const Register kClassIdReg = R9;
+
+  BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+      assembler, hi, type, type_class, kClassIdReg, kInstanceReg,
+      kInstanceTypeArguments);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedTypeArgumentValueCheck(
     Assembler* assembler,
     HierarchyInfo* hi,
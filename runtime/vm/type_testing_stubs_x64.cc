@@ -42,6 +42,21 @@ void TypeTestingStubGenerator::
       kInstanceTypeArguments);
 }
 
+void TypeTestingStubGenerator::
+    BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+        Assembler* assembler,
+        HierarchyInfo* hi,
+        const Type& type,
+        const Class& type_class) {
+  const Register kInstanceReg = RAX;
+  const Register kInstanceTypeArguments = RSI;
+  const Register kClassIdReg = TMP;
+
+  BuildOptimizedInterfaceRangeCheckWithTypeArguments(
+      assembler, hi, type, type_class, kClassIdReg, kInstanceReg,
+      kInstanceTypeArguments);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedTypeArgumentValueCheck(
     Assembler* assembler,
     HierarchyInfo* hi,
@@ -27,6 +27,43 @@ ISOLATE_UNIT_TEST_CASE(Utf8Encode) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Utf8AsciiPrefixLength) {
+  uint8_t buffer[64];
+  memset(buffer, 'a', sizeof(buffer));
+  EXPECT_EQ(64, Utf8::AsciiPrefixLength(buffer, 64));
+  // Check every position of the first non-ASCII byte, from every start, so
+  // both the unaligned and the word at a time loops see it.
+  for (intptr_t start = 0; start < 16; start++) {
+    for (intptr_t i = start; i < 64; i++) {
+      buffer[i] = 0xC3;
+      EXPECT_EQ(i - start, Utf8::AsciiPrefixLength(&buffer[start], 64 - start));
+      buffer[i] = 'a';
+    }
+  }
+  EXPECT_EQ(0, Utf8::AsciiPrefixLength(buffer, 0));
+
+  // Decoding copies the ASCII runs in bulk.
+  const char* src = "abcdefghijklmnopqrstuvwxyz\xC3\xA6\xC3\xB8" "abcdefghij";
+  const intptr_t src_len = strlen(src);
+  const uint8_t* utf8 = reinterpret_cast<const uint8_t*>(src);
+  EXPECT(Utf8::IsValid(utf8, src_len));
+  Utf8::Type type;
+  const intptr_t len = Utf8::CodeUnitCount(utf8, src_len, &type);
+  EXPECT_EQ(38, len);
+  EXPECT_EQ(Utf8::kLatin1, type);
+  uint8_t latin1[38];
+  EXPECT(Utf8::DecodeToLatin1(utf8, src_len, latin1, len));
+  EXPECT_EQ('z', latin1[25]);
+  EXPECT_EQ(0xE6, latin1[26]);
+  EXPECT_EQ(0xF8, latin1[27]);
+  EXPECT_EQ('j', latin1[37]);
+  uint16_t utf16[38];
+  EXPECT(Utf8::DecodeToUTF16(utf8, src_len, utf16, len));
+  EXPECT_EQ(0xF8, utf16[27]);
+  EXPECT_EQ('a', utf16[28]);
+  EXPECT(!Utf8::DecodeToLatin1(utf8, src_len, latin1, len - 1));
+}
+
 ISOLATE_UNIT_TEST_CASE(Utf8InvalidByte) {
   {
     uint8_t array[] = {0x41, 0xF0, 0x92};
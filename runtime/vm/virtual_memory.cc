@@ -6,9 +6,21 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/virtual_memory_compressed.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            heap_huge_pages,
+            false,
+            "Align large heap regions to huge pages and request transparent "
+            "huge page backing for them.");
+DEFINE_FLAG(bool,
+            heap_numa_local,
+            false,
+            "Prefer the NUMA node of the allocating mutator for heap memory.");
+
 bool VirtualMemory::InSamePage(uword address0, uword address1) {
   return (Utils::RoundDown(address0, PageSize()) ==
           Utils::RoundDown(address1, PageSize()));
@@ -17,8 +29,9 @@ bool VirtualMemory::InSamePage(uword address0, uword address1) {
 void VirtualMemory::Truncate(intptr_t new_size) {
   ASSERT(Utils::IsAligned(new_size, PageSize()));
   ASSERT(new_size <= size());
-  if (reserved_.size() ==
-      region_.size()) {  // Don't create holes in reservation.
+  // Don't create holes in reservation. Parts of the compressed heap region
+  // are only given back as a whole.
+  if ((reserved_.size() == region_.size()) && !InCompressedHeap()) {
     FreeSubSegment(reinterpret_cast<void*>(start() + new_size),
                    size() - new_size);
     reserved_.set_size(new_size);
@@ -31,6 +44,39 @@ void VirtualMemory::Truncate(intptr_t new_size) {
   alias_.Subregion(alias_, 0, new_size);
 }
 
+bool VirtualMemory::InCompressedHeap() const {
+#if defined(DART_COMPRESSED_POINTERS)
+  return vm_owns_region() &&
+         VirtualMemoryCompressedHeap::Contains(reserved_.start());
+#else
+  return false;
+#endif  // defined(DART_COMPRESSED_POINTERS)
+}
+
+VirtualMemory* VirtualMemory::AllocateHeap(intptr_t size,
+                                           intptr_t alignment,
+                                           const char* name) {
+  if (FLAG_heap_huge_pages && (size >= kHugePageSize)) {
+    alignment = Utils::Maximum(alignment, kHugePageSize);
+  }
+#if defined(DART_COMPRESSED_POINTERS)
+  const MemoryRegion reserved =
+      VirtualMemoryCompressedHeap::Allocate(size, alignment);
+  if (reserved.pointer() == NULL) {
+    return NULL;
+  }
+  MemoryRegion region(reserved.pointer(), size);
+  VirtualMemory* memory = new VirtualMemory(region, reserved);
+#else
+  VirtualMemory* memory =
+      AllocateAligned(size, alignment, /*is_executable=*/false, name);
+#endif  // defined(DART_COMPRESSED_POINTERS)
+  if ((memory != NULL) && (FLAG_heap_huge_pages || FLAG_heap_numa_local)) {
+    AdviseHeapRegion(memory->address(), memory->size());
+  }
+  return memory;
+}
+
 VirtualMemory* VirtualMemory::ForImagePage(void* pointer, uword size) {
   // Memory for precompilated instructions was allocated by the embedder, so
   // create a VirtualMemory without allocating.
@@ -41,6 +41,11 @@ class VirtualMemory {
   static void Protect(void* address, intptr_t size, Protection mode);
   void Protect(Protection mode) { return Protect(address(), size(), mode); }
 
+  // Tells the OS the contents of the page-aligned range are no longer needed,
+  // allowing it to reclaim the backing memory. The range stays mapped and
+  // reads as zero (or unspecified on Windows) until written again.
+  static void DontNeed(void* address, intptr_t size);
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, NULL is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -53,6 +58,14 @@ class VirtualMemory {
                                         bool is_executable,
                                         const char* name);
 
+  // Reserves and commits non-executable memory for heap pages and semispaces.
+  // Depending on --heap_huge_pages and --heap_numa_local, large regions are
+  // aligned to and backed by transparent huge pages, and the region is bound
+  // to the NUMA node of the mutator that allocates it.
+  static VirtualMemory* AllocateHeap(intptr_t size,
+                                     intptr_t alignment,
+                                     const char* name);
+
   static intptr_t PageSize() {
     ASSERT(page_size_ != 0);
     ASSERT(Utils::IsPowerOfTwo(page_size_));
@@ -72,6 +85,16 @@ class VirtualMemory {
   static VirtualMemory* ForImagePage(void* pointer, uword size);
 
  private:
+  static const intptr_t kHugePageSize = 2 * MB;
+
+  // Whether this memory was carved from the compressed heap region, which
+  // owns the reservation.
+  bool InCompressedHeap() const;
+
+  // Applies the heap backing policy to a freshly reserved heap region. Does
+  // nothing on platforms without support for it.
+  static void AdviseHeapRegion(void* address, intptr_t size);
+
   // Free a sub segment. On operating systems that support it this
   // can give back the virtual memory to the system. Returns true on success.
   static void FreeSubSegment(void* address, intptr_t size);
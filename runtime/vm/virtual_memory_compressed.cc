@@ -0,0 +1,144 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/virtual_memory_compressed.h"
+
+#if defined(DART_COMPRESSED_POINTERS)
+
+#if !defined(HOST_OS_ANDROID) && !defined(HOST_OS_LINUX) &&                   \
+    !defined(HOST_OS_MACOS)
+#error DART_COMPRESSED_POINTERS is only supported on POSIX hosts.
+#endif
+
+#include <errno.h>
+#include <sys/mman.h>
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/lockers.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+#undef MAP_FAILED
+#define MAP_FAILED reinterpret_cast<void*>(-1)
+
+uword VirtualMemoryCompressedHeap::base_ = 0;
+Mutex* VirtualMemoryCompressedHeap::mutex_ = NULL;
+uword VirtualMemoryCompressedHeap::allocated_[kNumGranules / kBitsPerWord];
+intptr_t VirtualMemoryCompressedHeap::minimum_free_ = 0;
+
+static void MapInaccessible(uword start, intptr_t size) {
+  // Replacing the mapping also drops its backing memory.
+  void* address = mmap(reinterpret_cast<void*>(start), size, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                       -1, 0);
+  if (address == MAP_FAILED) {
+    int error = errno;
+    const int kBufferSize = 1024;
+    char error_buf[kBufferSize];
+    FATAL2("mmap error: %d (%s)", error,
+           Utils::StrError(error, error_buf, kBufferSize));
+  }
+}
+
+void VirtualMemoryCompressedHeap::Init() {
+  if (base_ != 0) {
+    return;  // Reserved by a previous initialization of the VM.
+  }
+  // Over-reserve to find a 4GB aligned region, then give back the rest.
+  const intptr_t reserved_size = 2 * kRegionSize;
+  void* address =
+      mmap(NULL, reserved_size, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (address == MAP_FAILED) {
+    FATAL("Failed to reserve the compressed heap region.");
+  }
+  const uword reserved_start = reinterpret_cast<uword>(address);
+  const uword aligned_start = Utils::RoundUp(reserved_start, kRegionSize);
+  if (aligned_start > reserved_start) {
+    munmap(address, aligned_start - reserved_start);
+  }
+  const uword aligned_end = aligned_start + kRegionSize;
+  const uword reserved_end = reserved_start + reserved_size;
+  if (reserved_end > aligned_end) {
+    munmap(reinterpret_cast<void*>(aligned_end), reserved_end - aligned_end);
+  }
+  base_ = aligned_start;
+  mutex_ = new Mutex();
+}
+
+bool VirtualMemoryCompressedHeap::IsAllocated(intptr_t granule) {
+  return (allocated_[granule / kBitsPerWord] &
+          (static_cast<uword>(1) << (granule % kBitsPerWord))) != 0;
+}
+
+void VirtualMemoryCompressedHeap::SetAllocated(intptr_t first,
+                                               intptr_t count,
+                                               bool allocated) {
+  for (intptr_t granule = first; granule < first + count; granule++) {
+    const uword bit = static_cast<uword>(1) << (granule % kBitsPerWord);
+    if (allocated) {
+      allocated_[granule / kBitsPerWord] |= bit;
+    } else {
+      allocated_[granule / kBitsPerWord] &= ~bit;
+    }
+  }
+}
+
+MemoryRegion VirtualMemoryCompressedHeap::Allocate(intptr_t size,
+                                                   intptr_t alignment) {
+  ASSERT(base_ != 0);
+  ASSERT(Utils::IsPowerOfTwo(alignment));
+  const intptr_t count = Utils::RoundUp(size, kGranuleSize) / kGranuleSize;
+  const intptr_t step =
+      Utils::Maximum<intptr_t>(alignment / kGranuleSize, 1);
+
+  MutexLocker ml(mutex_);
+  intptr_t first = Utils::RoundUp(minimum_free_, step);
+  while (first + count <= kNumGranules) {
+    // Find the last allocated granule of the candidate range, if any.
+    intptr_t conflict = -1;
+    for (intptr_t i = first + count - 1; i >= first; i--) {
+      if (IsAllocated(i)) {
+        conflict = i;
+        break;
+      }
+    }
+    if (conflict == -1) {
+      const uword start = base_ + first * kGranuleSize;
+      const intptr_t committed = count * kGranuleSize;
+      if (mprotect(reinterpret_cast<void*>(start), committed,
+                   PROT_READ | PROT_WRITE) != 0) {
+        return MemoryRegion();
+      }
+      SetAllocated(first, count, true);
+      if (first == minimum_free_) {
+        minimum_free_ = first + count;
+      }
+      return MemoryRegion(reinterpret_cast<void*>(start), committed);
+    }
+    first = Utils::RoundUp(conflict + 1, step);
+  }
+  return MemoryRegion();
+}
+
+void VirtualMemoryCompressedHeap::Free(void* address, intptr_t size) {
+  const uword start = reinterpret_cast<uword>(address);
+  ASSERT(Contains(start));
+  ASSERT(Utils::IsAligned(start - base_, kGranuleSize));
+  const intptr_t count = Utils::RoundUp(size, kGranuleSize) / kGranuleSize;
+  MapInaccessible(start, count * kGranuleSize);
+
+  MutexLocker ml(mutex_);
+  const intptr_t first = (start - base_) / kGranuleSize;
+  SetAllocated(first, count, false);
+  if (first < minimum_free_) {
+    minimum_free_ = first;
+  }
+}
+
+}  // namespace dart
+
+#endif  // defined(DART_COMPRESSED_POINTERS)
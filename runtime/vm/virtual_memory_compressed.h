@@ -0,0 +1,66 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_VIRTUAL_MEMORY_COMPRESSED_H_
+#define RUNTIME_VM_VIRTUAL_MEMORY_COMPRESSED_H_
+
+#include "vm/globals.h"
+
+#if defined(DART_COMPRESSED_POINTERS)
+
+#if !defined(ARCH_IS_64_BIT)
+#error DART_COMPRESSED_POINTERS is only supported on 64-bit targets.
+#endif
+
+#include "vm/memory_region.h"
+
+namespace dart {
+
+class Mutex;
+
+// A single 4GB aligned reservation from which all heap pages and semispaces
+// are carved, so that a heap address is determined by its low 32 bits and
+// the base of the region.
+//
+// Memory is handed out in granules of kGranuleSize bytes. Unused granules
+// are reserved but neither accessible nor backed by memory.
+class VirtualMemoryCompressedHeap : public AllStatic {
+ public:
+  static const intptr_t kRegionSize = 4 * GB;
+  static const intptr_t kGranuleSize = 256 * KB;
+
+  // Reserves the region. Must be called before any heap memory is allocated.
+  static void Init();
+
+  // Commits size bytes at the given alignment, returning an empty region
+  // when the region has no such free range left. The memory reads as zero.
+  static MemoryRegion Allocate(intptr_t size, intptr_t alignment);
+
+  // Decommits memory returned by Allocate.
+  static void Free(void* address, intptr_t size);
+
+  static uword base() { return base_; }
+  static bool Contains(uword address) {
+    return (base_ != 0) &&
+           ((address - base_) < static_cast<uword>(kRegionSize));
+  }
+
+ private:
+  static const intptr_t kNumGranules = kRegionSize / kGranuleSize;
+
+  static bool IsAllocated(intptr_t granule);
+  static void SetAllocated(intptr_t first, intptr_t count, bool allocated);
+
+  static uword base_;
+  static Mutex* mutex_;
+  static uword allocated_[kNumGranules / kBitsPerWord];
+  // The first granule which may be free.
+  static intptr_t minimum_free_;
+};
+
+}  // namespace dart
+
+#endif  // defined(DART_COMPRESSED_POINTERS)
+
+#endif  // RUNTIME_VM_VIRTUAL_MEMORY_COMPRESSED_H_
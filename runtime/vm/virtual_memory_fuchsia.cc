@@ -166,8 +166,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   VirtualMemory* result;
 
   if (dual_mapping) {
-    // ZX_VM_PERM_EXECUTE is added later via VirtualMemory::Protect.
-    const zx_vm_option_t alias_options = ZX_VM_PERM_READ;
+    // Code is written through the region and executed through the alias, so
+    // both keep their permissions for their whole lifetime.
+    const zx_vm_option_t alias_options = ZX_VM_PERM_READ | ZX_VM_PERM_EXECUTE;
     void* alias_ptr = MapAligned(vmar, vmo, alias_options, size, alignment,
                                  base_, padded_size);
     if (alias_ptr == NULL) {
@@ -185,6 +186,10 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   return result;
 }
 
+void VirtualMemory::AdviseHeapRegion(void* address, intptr_t size) {
+  // Not supported.
+}
+
 VirtualMemory::~VirtualMemory() {
   // Reserved region may be empty due to VirtualMemory::Truncate.
   if (vm_owns_region() && reserved_.size() != 0) {
@@ -208,6 +213,10 @@ void VirtualMemory::FreeSubSegment(void* address, intptr_t size) {
   LOG_INFO("zx_vmar_unmap(0x%p, 0x%lx) success\n", address, size);
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  // Not supported.
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
@@ -17,6 +17,7 @@
 #include "platform/assert.h"
 #include "platform/utils.h"
 #include "vm/isolate.h"
+#include "vm/virtual_memory_compressed.h"
 
 // #define VIRTUAL_MEMORY_LOGGING 1
 #if defined(VIRTUAL_MEMORY_LOGGING)
@@ -33,6 +34,8 @@ namespace dart {
 #define MAP_FAILED reinterpret_cast<void*>(-1)
 
 DECLARE_FLAG(bool, dual_map_code);
+DECLARE_FLAG(bool, heap_huge_pages);
+DECLARE_FLAG(bool, heap_numa_local);
 DECLARE_FLAG(bool, write_protect_code);
 
 uword VirtualMemory::page_size_ = 0;
@@ -40,27 +43,25 @@ uword VirtualMemory::page_size_ = 0;
 void VirtualMemory::Init() {
   page_size_ = getpagesize();
 
+#if defined(DART_COMPRESSED_POINTERS)
+  VirtualMemoryCompressedHeap::Init();
+#endif  // defined(DART_COMPRESSED_POINTERS)
+
 #if defined(DUAL_MAPPING_SUPPORTED)
   // Detect dual mapping exec permission limitation on some platforms,
   // such as on docker containers, and disable dual mapping in this case.
   // Also detect for missing support of memfd_create syscall.
-  if (FLAG_dual_map_code) {
+  if (FLAG_dual_map_code && FLAG_write_protect_code) {
     intptr_t size = page_size_;
     intptr_t alignment = 256 * 1024;  // e.g. heap page size.
     VirtualMemory* vm = AllocateAligned(size, alignment, true, NULL);
     if (vm == NULL) {
-      LOG_INFO("memfd_create not supported; disabling dual mapping of code.\n");
+      LOG_INFO("memfd_create or executable mapping not supported; "
+               "disabling dual mapping of code.\n");
       FLAG_dual_map_code = false;
       return;
     }
-    void* region = reinterpret_cast<void*>(vm->region_.start());
-    void* alias = reinterpret_cast<void*>(vm->alias_.start());
-    if (region == alias ||
-        mprotect(region, size, PROT_READ) != 0 ||  // Remove PROT_WRITE.
-        mprotect(alias, size, PROT_READ | PROT_EXEC) != 0) {  // Add PROT_EXEC.
-      LOG_INFO("mprotect fails; disabling dual mapping of code.\n");
-      FLAG_dual_map_code = false;
-    }
+    ASSERT(vm->AliasOffset() != 0);
     delete vm;
   }
 #endif  // defined(DUAL_MAPPING_SUPPORTED)
@@ -168,8 +169,10 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
       return NULL;
     }
     MemoryRegion region(region_ptr, size);
-    // PROT_EXEC is added later via VirtualMemory::Protect.
-    const int alias_prot = PROT_READ;
+    // The views keep their protections for their whole lifetime: code is
+    // written through the region and executed through the alias, so neither
+    // installing nor patching code needs an mprotect.
+    const int alias_prot = PROT_READ | PROT_EXEC;
     void* alias_ptr =
         MapAligned(fd, alias_prot, size, alignment, allocated_size);
     close(fd);
@@ -204,7 +207,49 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   return new VirtualMemory(region, region);
 }
 
+void VirtualMemory::AdviseHeapRegion(void* address, intptr_t size) {
+#if defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+#if defined(MADV_HUGEPAGE)
+  if (FLAG_heap_huge_pages && (size >= kHugePageSize)) {
+    // Only a hint: the kernel may run with transparent huge pages disabled.
+    if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+      LOG_INFO("madvise(%p, 0x%" Px ", MADV_HUGEPAGE) failed\n", address,
+               size);
+    }
+  }
+#endif  // defined(MADV_HUGEPAGE)
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+  // Only bind memory allocated by the thread owning the isolate; helper
+  // threads may run on any node.
+  Thread* thread = Thread::Current();
+  if (FLAG_heap_numa_local &&
+      ((thread == NULL) || thread->IsMutatorThread())) {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if ((syscall(SYS_getcpu, &cpu, &node, NULL) == 0) &&
+        (node < kBitsPerWord)) {
+      // MPOL_PREFERRED from <numaif.h>: allocate on the node when possible,
+      // fall back to other nodes under memory pressure.
+      const int kPolicyPreferred = 1;
+      unsigned long node_mask = 1UL << node;  // NOLINT
+      if (syscall(SYS_mbind, address, size, kPolicyPreferred, &node_mask,
+                  kBitsPerWord, 0) != 0) {
+        LOG_INFO("mbind(%p, 0x%" Px ", node %u) failed\n", address, size,
+                 node);
+      }
+    }
+  }
+#endif  // defined(SYS_getcpu) && defined(SYS_mbind)
+#endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+}
+
 VirtualMemory::~VirtualMemory() {
+#if defined(DART_COMPRESSED_POINTERS)
+  if (InCompressedHeap()) {
+    VirtualMemoryCompressedHeap::Free(reserved_.pointer(), reserved_.size());
+    return;
+  }
+#endif  // defined(DART_COMPRESSED_POINTERS)
   if (vm_owns_region()) {
     unmap(reserved_.start(), reserved_.end());
     const intptr_t alias_offset = AliasOffset();
@@ -220,6 +265,14 @@ void VirtualMemory::FreeSubSegment(void* address,
   unmap(start, start + size);
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  ASSERT(Utils::IsAligned(reinterpret_cast<uword>(address), PageSize()));
+  ASSERT(Utils::IsAligned(size, PageSize()));
+  if (madvise(address, size, MADV_DONTNEED) != 0) {
+    LOG_INFO("madvise(%p, 0x%" Px ", MADV_DONTNEED) failed\n", address, size);
+  }
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(TARGET_ARCH_DBC)
   RELEASE_ASSERT((mode != kReadExecute) && (mode != kReadWriteExecute));
@@ -6,9 +6,13 @@
 #include "platform/assert.h"
 #include "vm/heap/heap.h"
 #include "vm/unit_test.h"
+#include "vm/virtual_memory_compressed.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, heap_huge_pages);
+DECLARE_FLAG(bool, heap_numa_local);
+
 bool IsZero(char* begin, char* end) {
   for (char* current = begin; current < end; ++current) {
     if (*current != 0) {
@@ -64,6 +68,26 @@ VM_UNIT_TEST_CASE(AllocateAlignedVirtualMemory) {
   }
 }
 
+VM_UNIT_TEST_CASE(AllocateHugePageBackedHeapMemory) {
+  const bool saved_huge_pages = FLAG_heap_huge_pages;
+  const bool saved_numa_local = FLAG_heap_numa_local;
+  FLAG_heap_huge_pages = true;
+  FLAG_heap_numa_local = true;
+  const intptr_t kHugePageSize = 2 * MB;
+  VirtualMemory* vm = VirtualMemory::AllocateHeap(
+      2 * kHugePageSize, VirtualMemory::PageSize(), NULL);
+  EXPECT(vm != NULL);
+  EXPECT(Utils::IsAligned(vm->start(), kHugePageSize));
+  EXPECT_EQ(2 * kHugePageSize, vm->size());
+  char* buf = reinterpret_cast<char*>(vm->address());
+  EXPECT(IsZero(buf, buf + vm->size()));
+  buf[vm->size() - 1] = 'a';
+  EXPECT_EQ('a', buf[vm->size() - 1]);
+  delete vm;
+  FLAG_heap_huge_pages = saved_huge_pages;
+  FLAG_heap_numa_local = saved_numa_local;
+}
+
 VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   // Reservations should always be handed back to OS upon destruction.
   const intptr_t kVirtualMemoryBlockSize = 10 * MB;
@@ -88,4 +112,41 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+#if defined(DART_COMPRESSED_POINTERS)
+VM_UNIT_TEST_CASE(CompressedHeapVirtualMemory) {
+  const intptr_t kSize = 3 * kPageSize;
+  VirtualMemory* first = VirtualMemory::AllocateHeap(kSize, kPageSize, NULL);
+  EXPECT(first != NULL);
+  EXPECT(VirtualMemoryCompressedHeap::Contains(first->start()));
+  EXPECT(VirtualMemoryCompressedHeap::Contains(first->end() - 1));
+  EXPECT(Utils::IsAligned(first->start(), kPageSize));
+  char* buf = reinterpret_cast<char*>(first->address());
+  EXPECT(IsZero(buf, buf + first->size()));
+  buf[0] = 'a';
+  first->Truncate(kPageSize);
+
+  VirtualMemory* second = VirtualMemory::AllocateHeap(kSize, kPageSize, NULL);
+  EXPECT(second != NULL);
+  EXPECT(VirtualMemoryCompressedHeap::Contains(second->start()));
+  EXPECT(second->start() >= first->start() + kSize);
+
+  // Freed memory is reused first-fit and reads as zero again.
+  const uword first_start = first->start();
+  delete first;
+  VirtualMemory* third = VirtualMemory::AllocateHeap(kSize, kPageSize, NULL);
+  EXPECT(third != NULL);
+  EXPECT(third->start() <= first_start);
+  buf = reinterpret_cast<char*>(third->address());
+  EXPECT(IsZero(buf, buf + third->size()));
+  delete second;
+  delete third;
+
+  // Code is not allocated from the heap region.
+  VirtualMemory* code = VirtualMemory::Allocate(kPageSize, true, NULL);
+  EXPECT(code != NULL);
+  EXPECT(!VirtualMemoryCompressedHeap::Contains(code->start()));
+  delete code;
+}
+#endif  // defined(DART_COMPRESSED_POINTERS)
+
 }  // namespace dart
@@ -56,6 +56,10 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   return new VirtualMemory(region, reserved);
 }
 
+void VirtualMemory::AdviseHeapRegion(void* address, intptr_t size) {
+  // Not supported.
+}
+
 VirtualMemory::~VirtualMemory() {
   // Note that the size of the reserved region might be set to 0 by
   // Truncate(0, true) but that does not actually release the mapping
@@ -76,6 +80,12 @@ void VirtualMemory::FreeSubSegment(void* address,
   }
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  // MEM_RESET keeps the pages committed but lets the OS discard their
+  // contents instead of writing them to the page file.
+  VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
@@ -40,36 +40,53 @@ class Zone::Segment {
 
   static void Delete(Segment* segment) { free(segment); }
 
+  friend class ZoneSegmentCache;
   DISALLOW_IMPLICIT_CONSTRUCTORS(Segment);
 };
 
 Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
   ASSERT(size >= 0);
-  Segment* result = reinterpret_cast<Segment*>(malloc(size));
+  Segment* result = NULL;
+  ThreadState* current_thread = ThreadState::Current();
+  if (current_thread != NULL) {
+    result = current_thread->zone_segment_cache()->Take(size);
+  }
   if (result == NULL) {
-    OUT_OF_MEMORY();
+    result = reinterpret_cast<Segment*>(malloc(size));
+    if (result == NULL) {
+      OUT_OF_MEMORY();
+    }
+    result->size_ = size;
   }
   ASSERT(Utils::IsAligned(result->start(), Zone::kAlignment));
 #ifdef DEBUG
   // Zap the entire allocated segment (including the header).
-  memset(result, kZapUninitializedByte, size);
+  memset(result, kZapUninitializedByte, result->size_);
 #endif
   result->next_ = next;
-  result->size_ = size;
-  IncrementMemoryCapacity(size);
+  IncrementMemoryCapacity(result->size());
   return result;
 }
 
 void Zone::Segment::DeleteSegmentList(Segment* head) {
+  ThreadState* current_thread = ThreadState::Current();
+  ZoneSegmentCache* cache = (current_thread != NULL)
+                                ? current_thread->zone_segment_cache()
+                                : NULL;
   Segment* current = head;
   while (current != NULL) {
-    DecrementMemoryCapacity(current->size());
+    const intptr_t size = current->size();
+    DecrementMemoryCapacity(size);
     Segment* next = current->next();
 #ifdef DEBUG
-    // Zap the entire current segment (including the header).
-    memset(current, kZapDeletedByte, current->size());
+    // Zap the entire current segment (including the header), keeping its
+    // size for the cache.
+    memset(current, kZapDeletedByte, size);
+    current->size_ = size;
 #endif
-    Segment::Delete(current);
+    if ((cache == NULL) || !cache->Put(current)) {
+      Segment::Delete(current);
+    }
     current = next;
   }
 }
@@ -94,6 +111,72 @@ void Zone::Segment::DecrementMemoryCapacity(uintptr_t size) {
   }
 }
 
+Zone::Segment* ZoneSegmentCache::Take(intptr_t size) {
+  if (size == Zone::kSegmentSize) {
+    Zone::Segment* result = segments_;
+    if (result != NULL) {
+      segments_ = result->next_;
+      segment_count_--;
+    }
+    return result;
+  }
+  // Only reuse a large segment which wastes at most half of its size.
+  Zone::Segment** link = &large_segments_;
+  for (Zone::Segment* current = large_segments_; current != NULL;
+       current = current->next_) {
+    if ((current->size() >= size) && (current->size() / 2 <= size)) {
+      *link = current->next_;
+      large_segment_count_--;
+      return current;
+    }
+    link = &current->next_;
+  }
+  return NULL;
+}
+
+bool ZoneSegmentCache::Put(Zone::Segment* segment) {
+  if (segment->size() == Zone::kSegmentSize) {
+    if (segment_count_ >= kMaxSegments) {
+      return false;
+    }
+    segment->next_ = segments_;
+    segments_ = segment;
+    segment_count_++;
+    return true;
+  }
+  if ((large_segment_count_ >= kMaxLargeSegments) ||
+      (segment->size() > kMaxLargeSegmentSize)) {
+    return false;
+  }
+  segment->next_ = large_segments_;
+  large_segments_ = segment;
+  large_segment_count_++;
+  return true;
+}
+
+void ZoneSegmentCache::ReleaseAll() {
+  Zone::Segment* lists[] = {segments_, large_segments_};
+  for (Zone::Segment* current : lists) {
+    while (current != NULL) {
+      Zone::Segment* next = current->next_;
+      Zone::Segment::Delete(current);
+      current = next;
+    }
+  }
+  segments_ = NULL;
+  segment_count_ = 0;
+  large_segments_ = NULL;
+  large_segment_count_ = 0;
+}
+
+intptr_t ZoneSegmentCache::CapacityInBytes() const {
+  intptr_t size = segment_count_ * Zone::kSegmentSize;
+  for (Zone::Segment* s = large_segments_; s != NULL; s = s->next_) {
+    size += s->size();
+  }
+  return size;
+}
+
 // TODO(bkonyi): We need to account for the initial chunk size when a new zone
 // is created within a new thread or ApiNativeScope when calculating high
 // watermarks or memory consumption.
@@ -164,6 +164,7 @@ class Zone {
 
   friend class StackZone;
   friend class ApiZone;
+  friend class ZoneSegmentCache;
   template <typename T, typename B, typename Allocator>
   friend class BaseGrowableArray;
   template <typename T, typename B, typename Allocator>
@@ -199,6 +200,40 @@ class StackZone : public StackResource {
   DISALLOW_IMPLICIT_CONSTRUCTORS(StackZone);
 };
 
+// Keeps the segments of deleted zones for reuse by later zones of the same
+// thread, so the many short lived zones do not malloc and free them each
+// time. The number and size of the kept segments are bounded, and they are
+// freed when the thread goes idle.
+class ZoneSegmentCache {
+ public:
+  ZoneSegmentCache() {}
+  ~ZoneSegmentCache() { ReleaseAll(); }
+
+  // Frees all cached segments.
+  void ReleaseAll();
+
+  intptr_t CapacityInBytes() const;
+
+ private:
+  static const intptr_t kMaxSegments = 16;
+  static const intptr_t kMaxLargeSegments = 4;
+  static const intptr_t kMaxLargeSegmentSize = 1 * MB;
+
+  // Returns a cached segment of at least 'size' bytes, or NULL.
+  Zone::Segment* Take(intptr_t size);
+
+  // Returns whether the segment was cached; otherwise the caller frees it.
+  bool Put(Zone::Segment* segment);
+
+  Zone::Segment* segments_ = nullptr;
+  intptr_t segment_count_ = 0;
+  Zone::Segment* large_segments_ = nullptr;
+  intptr_t large_segment_count_ = 0;
+
+  friend class Zone;
+  DISALLOW_COPY_AND_ASSIGN(ZoneSegmentCache);
+};
+
 inline uword Zone::AllocUnsafe(intptr_t size) {
   ASSERT(size >= 0);
   // Round up the requested size to fit the alignment.
@@ -155,6 +155,32 @@ VM_UNIT_TEST_CASE(ZoneAllocated) {
   Dart_ShutdownIsolate();
 }
 
+TEST_CASE(ZoneSegmentReuse) {
+  ZoneSegmentCache* cache = thread->zone_segment_cache();
+  cache->ReleaseAll();
+  const uintptr_t capacity = thread->current_zone_capacity();
+  uword first_segment = 0;
+  {
+    StackZone stack_zone(thread);
+    // Expand the zone beyond its initial buffer.
+    first_segment = stack_zone.GetZone()->AllocUnsafe(2 * KB);
+  }
+  // The segment is kept, but no longer counted as zone capacity.
+  EXPECT_EQ(capacity, thread->current_zone_capacity());
+  EXPECT_EQ(64 * KB, cache->CapacityInBytes());
+  {
+    StackZone stack_zone(thread);
+    EXPECT_EQ(first_segment, stack_zone.GetZone()->AllocUnsafe(2 * KB));
+    EXPECT_EQ(0, cache->CapacityInBytes());
+    // Large segments are kept as well.
+    EXPECT(stack_zone.GetZone()->AllocUnsafe(512 * KB) != 0);
+  }
+  EXPECT(cache->CapacityInBytes() > 512 * KB);
+  thread->ReleaseZoneSegments();
+  EXPECT_EQ(0, cache->CapacityInBytes());
+  EXPECT_EQ(capacity, thread->current_zone_capacity());
+}
+
 TEST_CASE(PrintToString) {
   StackZone zone(Thread::Current());
   const char* result = zone.GetZone()->PrintToString("Hello %s!", "World");
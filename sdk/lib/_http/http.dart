@@ -16,7 +16,7 @@ import 'dart:collection'
         UnmodifiableMapView;
 import 'dart:convert';
 import 'dart:developer' hide log;
-import 'dart:_internal' show Since, HttpStatus;
+import 'dart:_internal' show Since, HttpStatus, equalsIgnoreAsciiCase;
 import 'dart:math';
 import 'dart:io';
 import 'dart:typed_data';
@@ -221,10 +221,18 @@ abstract class HttpServer implements Stream<HttpRequest> {
    * isolates are bound to the port, then the incoming connections will be
    * distributed among all the bound `HttpServer`s. Connections can be
    * distributed over multiple isolates this way.
+   *
+   * The optional argument [reusePort] gives each `HttpServer` bound to the
+   * same combination a listening socket of its own instead, letting the
+   * operating system distribute the connections. See
+   * [RawServerSocket.bind].
    */
   static Future<HttpServer> bind(address, int port,
-          {int backlog: 0, bool v6Only: false, bool shared: false}) =>
-      _HttpServer.bind(address, port, backlog, v6Only, shared);
+          {int backlog: 0,
+          bool v6Only: false,
+          bool shared: false,
+          bool reusePort: false}) =>
+      _HttpServer.bind(address, port, backlog, v6Only, shared, reusePort);
 
   /**
    * The [address] can either be a [String] or an
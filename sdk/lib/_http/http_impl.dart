@@ -2515,10 +2515,13 @@ class _HttpServer extends Stream<HttpRequest>
   Duration _idleTimeout;
   Timer _idleTimer;
 
-  static Future<HttpServer> bind(
-      address, int port, int backlog, bool v6Only, bool shared) {
+  static Future<HttpServer> bind(address, int port, int backlog, bool v6Only,
+      bool shared, bool reusePort) {
     return ServerSocket.bind(address, port,
-            backlog: backlog, v6Only: v6Only, shared: shared)
+            backlog: backlog,
+            v6Only: v6Only,
+            shared: shared,
+            reusePort: reusePort)
         .then<HttpServer>((socket) {
       return new _HttpServer._(socket, true);
     });
@@ -2896,6 +2899,10 @@ class _DetachedSocket extends Stream<List<int>> implements Socket {
     return _socket.addStream(stream);
   }
 
+  Future sendFile(File file, [int start = 0, int end]) {
+    return _socket.sendFile(file, start, end);
+  }
+
   void destroy() {
     _socket.destroy();
   }
@@ -2941,8 +2948,8 @@ class _AuthenticationScheme {
   const _AuthenticationScheme(this._scheme);
 
   factory _AuthenticationScheme.fromString(String scheme) {
-    if (scheme.toLowerCase() == "basic") return BASIC;
-    if (scheme.toLowerCase() == "digest") return DIGEST;
+    if (equalsIgnoreAsciiCase(scheme, "basic")) return BASIC;
+    if (equalsIgnoreAsciiCase(scheme, "digest")) return DIGEST;
     return UNKNOWN;
   }
 
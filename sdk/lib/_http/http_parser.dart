@@ -518,6 +518,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
               throw new HttpException("Invalid request URI");
             }
             _uri_or_reason_phrase.add(byte);
+            _addUntil(_uri_or_reason_phrase, _CharCode.SP);
           }
           break;
 
@@ -622,6 +623,16 @@ class _HttpParser extends Stream<_HttpIncoming> {
               throw new HttpException("Invalid header field name");
             }
             _headerField.add(_toLowerCaseByte(byte));
+            // Take the rest of the name in this buffer in one go.
+            while (_index < _buffer.length) {
+              int next = _buffer[_index];
+              if (next == _CharCode.COLON) break;
+              if (!_isTokenChar(next)) {
+                throw new HttpException("Invalid header field name");
+              }
+              _headerField.add(_toLowerCaseByte(next));
+              _index++;
+            }
           }
           break;
 
@@ -644,6 +655,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             _state = _State.HEADER_VALUE_FOLD_OR_END;
           } else {
             _headerValue.add(byte);
+            _addUntil(_headerValue, _CharCode.CR);
           }
           break;
 
@@ -925,6 +937,27 @@ class _HttpParser extends Stream<_HttpIncoming> {
     _index = null;
   }
 
+  // Adds the bytes from _index up to the next [stop], CR or LF byte, or up
+  // to the end of the buffer, to [target] and moves past them. The spans
+  // between delimiters are copied in bulk rather than a byte per turn of
+  // the state machine.
+  void _addUntil(List<int> target, int stop) {
+    int end = _index;
+    final int length = _buffer.length;
+    while (end < length) {
+      int byte = _buffer[end];
+      if (byte == stop || byte == _CharCode.CR || byte == _CharCode.LF) {
+        break;
+      }
+      end++;
+    }
+    if (end > _index) {
+      target.addAll(new Uint8List.view(
+          _buffer.buffer, _buffer.offsetInBytes + _index, end - _index));
+      _index = end;
+    }
+  }
+
   static bool _isTokenChar(int byte) {
     return byte > 31 && byte < 128 && !_Const.SEPARATOR_MAP[byte];
   }
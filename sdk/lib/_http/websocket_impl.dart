@@ -541,11 +541,11 @@ class _WebSocketTransformerImpl
     }
     bool isUpgrade = false;
     request.headers[HttpHeaders.connectionHeader].forEach((String value) {
-      if (value.toLowerCase() == "upgrade") isUpgrade = true;
+      if (equalsIgnoreAsciiCase(value, "upgrade")) isUpgrade = true;
     });
     if (!isUpgrade) return false;
     String upgrade = request.headers.value(HttpHeaders.upgradeHeader);
-    if (upgrade == null || upgrade.toLowerCase() != "websocket") {
+    if (upgrade == null || !equalsIgnoreAsciiCase(upgrade, "websocket")) {
       return false;
     }
     String version = request.headers.value("Sec-WebSocket-Version");
@@ -1052,9 +1052,10 @@ class _WebSocketImpl extends Stream with _ServiceObject implements WebSocket {
       if (response.statusCode != HttpStatus.switchingProtocols ||
           response.headers[HttpHeaders.connectionHeader] == null ||
           !response.headers[HttpHeaders.connectionHeader]
-              .any((value) => value.toLowerCase() == "upgrade") ||
-          response.headers.value(HttpHeaders.upgradeHeader).toLowerCase() !=
-              "websocket") {
+              .any((value) => equalsIgnoreAsciiCase(value, "upgrade")) ||
+          !equalsIgnoreAsciiCase(
+              response.headers.value(HttpHeaders.upgradeHeader),
+              "websocket")) {
         error("Connection to '$uri' was not upgraded to websocket");
       }
       String accept = response.headers.value("Sec-WebSocket-Accept");
@@ -10,6 +10,7 @@ import 'dart:_interceptors' show JSArray, JSExtendableArray;
 import 'dart:_internal' show MappedIterable, ListIterable;
 import 'dart:collection' show LinkedHashMap, MapBase;
 import 'dart:_native_typed_data' show NativeUint8List;
+import 'dart:typed_data' show Uint8List;
 
 /// Parses [json] and builds the corresponding parsed JSON value.
 ///
@@ -383,6 +384,22 @@ class _JsonDecoderSink extends _StringSinkConversionSink {
   }
 }
 
+@patch
+class Base64Encoder {
+  @patch
+  static String _convertIntercepted(bool urlSafe, List<int> input) {
+    return null; // This call was not intercepted.
+  }
+}
+
+@patch
+class Base64Decoder {
+  @patch
+  static Uint8List _convertIntercepted(String input, int start, int end) {
+    return null; // This call was not intercepted.
+  }
+}
+
 @patch
 class Utf8Decoder {
   @patch
@@ -440,7 +440,10 @@ class NetworkInterface {
 class RawServerSocket {
   @patch
   static Future<RawServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false}) {
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false}) {
     throw new UnsupportedError("RawServerSocket.bind");
   }
 }
@@ -449,7 +452,10 @@ class RawServerSocket {
 class ServerSocket {
   @patch
   static Future<ServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false}) {
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false}) {
     throw new UnsupportedError("ServerSocket.bind");
   }
 }
@@ -572,6 +578,26 @@ class _StdIOUtils {
   static _getStdioHandleType(int fd) {
     throw new UnsupportedError("StdIOUtils._getStdioHandleType");
   }
+
+  @patch
+  static void _writeBuffered(int fd, List<int> data) {
+    throw new UnsupportedError("StdIOUtils._writeBuffered");
+  }
+
+  @patch
+  static void _flushBuffered(int fd) {
+    throw new UnsupportedError("StdIOUtils._flushBuffered");
+  }
+
+  @patch
+  static int _getBufferSize(int fd) {
+    throw new UnsupportedError("Stdout.bufferSize");
+  }
+
+  @patch
+  static void _setBufferSize(int fd, int size) {
+    throw new UnsupportedError("Stdout.bufferSize");
+  }
 }
 
 @patch
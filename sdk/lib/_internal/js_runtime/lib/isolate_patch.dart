@@ -7,6 +7,7 @@
 import "dart:async";
 import 'dart:_foreign_helper' show JS;
 import 'dart:_js_helper' show patch;
+import 'dart:typed_data' show TypedData;
 
 @patch
 class Isolate {
@@ -146,6 +147,27 @@ class Capability {
   }
 }
 
+@patch
+class TransferableTypedData {
+  @patch
+  factory TransferableTypedData.fromList(List<TypedData> list) {
+    throw new UnsupportedError('TransferableTypedData.fromList');
+  }
+}
+
+@patch
+class RingBufferChannel {
+  @patch
+  factory RingBufferChannel(int capacity) {
+    throw new UnsupportedError('RingBufferChannel');
+  }
+
+  @patch
+  factory RingBufferChannel.attach(int id) {
+    throw new UnsupportedError('RingBufferChannel.attach');
+  }
+}
+
 /// Returns the base path added to Uri.base to resolve `package:` Uris.
 ///
 /// This is used by `Isolate.resolvePackageUri` to load resources. The default
@@ -230,6 +230,10 @@ class Base64Encoder extends Converter<List<int>, String> {
 
   String convert(List<int> input) {
     if (input.isEmpty) return "";
+    // Allow the implementation to intercept and specialize based on the type
+    // of input.
+    var result = _convertIntercepted(_urlSafe, input);
+    if (result != null) return result;
     var encoder = _Base64Encoder(_urlSafe);
     var buffer = encoder.encode(input, 0, input.length, true);
     return String.fromCharCodes(buffer);
@@ -241,6 +245,8 @@ class Base64Encoder extends Converter<List<int>, String> {
     }
     return _AsciiBase64EncoderSink(sink, _urlSafe);
   }
+
+  external static String _convertIntercepted(bool urlSafe, List<int> input);
 }
 
 /// Helper class for encoding bytes to base64.
@@ -481,6 +487,10 @@ class Base64Decoder extends Converter<String, List<int>> {
   Uint8List convert(String input, [int start = 0, int end]) {
     end = RangeError.checkValidRange(start, end, input.length);
     if (start == end) return Uint8List(0);
+    // Allow the implementation to intercept and specialize based on the type
+    // of input.
+    var result = _convertIntercepted(input, start, end);
+    if (result != null) return result;
     var decoder = _Base64Decoder();
     var buffer = decoder.decode(input, start, end);
     decoder.close(input, end);
@@ -490,6 +500,9 @@ class Base64Decoder extends Converter<String, List<int>> {
   StringConversionSink startChunkedConversion(Sink<List<int>> sink) {
     return _Base64DecoderSink(sink);
   }
+
+  external static Uint8List _convertIntercepted(
+      String input, int start, int end);
 }
 
 /// Helper class implementing base64 decoding with intermediate state.
@@ -33,6 +33,7 @@ class DartRepresentationOf {
   /// [Float]                              -> [double]
   /// [Pointer]<T>                         -> [Pointer]<T>
   /// T extends [Pointer]                  -> T
+  /// [ByValue]<T>                         -> T
   /// [NativeFunction]<T1 Function(T2, T3) -> S1 Function(S2, S3)
   ///    where DartRepresentationOf(Tn) -> Sn
   const DartRepresentationOf(String nativeType);
@@ -20,8 +20,11 @@ class DynamicLibrary {
   external Pointer<T> lookup<T extends NativeType>(String symbolName);
 
   /// Helper that combines lookup and cast to a Dart function.
-  F lookupFunction<T extends Function, F extends Function>(String symbolName) {
-    return lookup<NativeFunction<T>>(symbolName)?.asFunction<F>();
+  ///
+  /// See [Pointer.asFunction] for the meaning of [isLeaf].
+  F lookupFunction<T extends Function, F extends Function>(String symbolName,
+      {bool isLeaf: false}) {
+    return lookup<NativeFunction<T>>(symbolName)?.asFunction<F>(isLeaf: isLeaf);
   }
 
   /// Dynamic libraries are equal if they load the same library.
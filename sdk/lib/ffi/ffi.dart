@@ -29,12 +29,21 @@ external int sizeOf<T extends NativeType>();
 /// Convert Dart function to a C function pointer, automatically marshalling
 /// the arguments and return value
 ///
-/// Note: this is not implemented, always returns Pointer with address 0.
+/// [f] must be a top-level or static function. If it throws, or returns a
+/// value which does not fit the native return type, the C caller gets
+/// [exceptionalReturn] instead, which is required to be representable in the
+/// native return type.
 ///
-/// TODO(dacoharkes): Implement this feature.
-/// https://github.com/dart-lang/sdk/issues/35761
+/// The returned pointer may only be called by C code running on the thread of
+/// the isolate that created it, while the isolate is inside a native call.
+/// Asking again for the same function, signature and exceptional return
+/// gives the same pointer.
+///
+/// Note: this is only implemented on x64, elsewhere it throws an
+/// [UnsupportedError].
 external Pointer<NativeFunction<T>> fromFunction<T extends Function>(
-    @DartRepresentationOf("T") Function f);
+    @DartRepresentationOf("T") Function f,
+    [Object exceptionalReturn]);
 
 /*
 /// TODO(dacoharkes): Implement this feature.
@@ -84,7 +93,13 @@ class Pointer<T extends NativeType> extends NativeType {
   /// and return value.
   ///
   /// Can only be called on [Pointer]<[NativeFunction]>.
-  external R asFunction<@DartRepresentationOf("T") R extends Function>();
+  ///
+  /// Pass [isLeaf] as true only if the C function neither calls back into Dart
+  /// nor blocks. Such calls skip the transition out of Dart code, which makes
+  /// calls to small C functions considerably cheaper, but the isolate cannot
+  /// take part in garbage collection or be interrupted until the call returns.
+  external R asFunction<@DartRepresentationOf("T") R extends Function>(
+      {bool isLeaf: false});
 
   /// Free memory on the C heap pointed to by this pointer with free().
   ///
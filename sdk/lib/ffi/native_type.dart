@@ -131,3 +131,18 @@ class Void extends NativeType {
 /// marker in type signatures.
 @unsized
 class NativeFunction<T extends Function> extends NativeType {}
+
+/// Represents a struct passed or returned by value in C.
+///
+/// [T] must be a struct class, annotated with [struct]. A `ByValue<T>`
+/// argument in a [NativeFunction] signature is a `T` in Dart, which points to
+/// the struct that is copied into the call. A `ByValue<T>` result is copied
+/// into newly allocated memory, which the caller has to [Pointer.free].
+///
+/// Structs can only be passed and returned by value on 64-bit platforms, and
+/// not to or from callbacks created with [fromFunction].
+///
+/// [ByValue] is not constructible in the Dart code and serves purely as marker
+/// in type signatures.
+@unsized
+class ByValue<T extends Pointer> extends NativeType {}
@@ -165,6 +165,14 @@ int parseHexByte(String source, int index) {
 /// https://github.com/dart-lang/sdk/issues/31371
 external Object extractTypeArguments<T>(T instance, Function extract);
 
+/// Whether [a] and [b] are equal when ASCII letters are compared without
+/// regard to case.
+///
+/// Characters outside ASCII have to be equal. This is cheaper than comparing
+/// lower-cased copies, and is how protocol tokens such as HTTP header names
+/// are compared.
+external bool equalsIgnoreAsciiCase(String a, String b);
+
 /// Annotation class marking the version where SDK API was added.
 ///
 /// A `Since` annotation can be applied to a library declaration,
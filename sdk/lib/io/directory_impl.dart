@@ -291,6 +291,8 @@ class _AsyncDirectoryLister {
   static const int listError = 3;
   static const int listDone = 4;
 
+  static const int responseNames = 0;
+
   static const int responseType = 0;
   static const int responsePath = 1;
   static const int responseComplete = 1;
@@ -373,18 +375,29 @@ class _AsyncDirectoryLister {
       nextRunning = false;
       if (result is List) {
         next();
-        assert(result.length % 2 == 0);
-        for (int i = 0; i < result.length; i++) {
-          assert(i % 2 == 0);
+        if (result.isEmpty) return;
+        // The names of all entries come first, in one buffer, followed by the
+        // type of each entry and the offset at which its name ends.
+        assert(result.length % 2 == 1);
+        Uint8List names = result[responseNames];
+        int start = 0;
+        Uint8List name(int end) {
+          var rawPath = new Uint8List.view(
+              names.buffer, names.offsetInBytes + start, end - start);
+          start = end;
+          return rawPath;
+        }
+
+        for (int i = responseNames + 1; i < result.length; i++) {
           switch (result[i++]) {
             case listFile:
-              controller.add(new File.fromRawPath(result[i]));
+              controller.add(new File.fromRawPath(name(result[i])));
               break;
             case listDirectory:
-              controller.add(new Directory.fromRawPath(result[i]));
+              controller.add(new Directory.fromRawPath(name(result[i])));
               break;
             case listLink:
-              controller.add(new Link.fromRawPath(result[i]));
+              controller.add(new Link.fromRawPath(name(result[i])));
               break;
             case listError:
               error(result[i]);
@@ -97,6 +97,37 @@ class FileLock {
   const FileLock._internal(this._type);
 }
 
+/// The ways a file can be mapped into memory by [RandomAccessFile.mapSync].
+class FileMapMode {
+  /// The mapping can only be read.
+  static const read = const FileMapMode._internal(0);
+
+  /// The mapping can be read and written, and writes go to the file. They
+  /// are only certain to be on disk after [RandomAccessFile.flush].
+  static const write = const FileMapMode._internal(2);
+
+  final int _mode;
+
+  const FileMapMode._internal(this._mode);
+}
+
+/// How a memory mapped file is going to be accessed, which lets the
+/// operating system read ahead or not.
+class FileMapAccess {
+  /// No particular order.
+  static const normal = const FileMapAccess._internal(0);
+
+  /// From the start to the end.
+  static const sequential = const FileMapAccess._internal(1);
+
+  /// In random order.
+  static const random = const FileMapAccess._internal(2);
+
+  final int _access;
+
+  const FileMapAccess._internal(this._access);
+}
+
 /**
  * A reference to a file on the file system.
  *
@@ -943,6 +974,29 @@ abstract class RandomAccessFile {
    */
   void unlockSync([int start = 0, int end = -1]);
 
+  /**
+   * Synchronously maps [length] bytes of the file starting at [start] into
+   * memory.
+   *
+   * The bytes are returned as a list backed directly by the mapping, so
+   * they are only read from the file when the list is accessed, and are
+   * not copied into the Dart heap. The list is unmodifiable unless [mode]
+   * is [FileMapMode.write]. The mapping stays valid after the file is
+   * closed, and is released when the list is garbage collected. [access]
+   * is a hint for how the list is going to be read.
+   *
+   * The range has to be within the file. Accessing a mapping of a part of
+   * the file that is truncated away terminates the process.
+   *
+   * On Windows the range is read into memory rather than mapped, and
+   * [FileMapMode.write] is not supported.
+   *
+   * Throws a [FileSystemException] if the operation fails.
+   */
+  Uint8List mapSync(int start, int length,
+      {FileMapMode mode: FileMapMode.read,
+      FileMapAccess access: FileMapAccess.normal});
+
   /**
    * Returns a human-readable string for this RandomAccessFile instance.
    */
@@ -652,6 +652,8 @@ abstract class _RandomAccessFileOps {
   int close();
   readByte();
   read(int bytes);
+  // Completes with the bytes read or with an OSError.
+  Future readAsync(int bytes);
   readInto(List<int> buffer, int start, int end);
   writeByte(int value);
   writeFrom(List<int> buffer, int start, int end);
@@ -661,6 +663,7 @@ abstract class _RandomAccessFileOps {
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int mode, int start, int length, int access);
 }
 
 class _RandomAccessFile implements RandomAccessFile {
@@ -743,12 +746,15 @@ class _RandomAccessFile implements RandomAccessFile {
 
   Future<List<int>> read(int bytes) {
     ArgumentError.checkNotNull(bytes, 'bytes');
-    return _dispatch(_IOService.fileRead, [null, bytes]).then((response) {
-      if (_isErrorResponse(response)) {
-        throw _exceptionFromResponse(response, "read failed", path);
+    if (bytes < 0) {
+      return new Future.error(new ArgumentError("read failed: $path"));
+    }
+    return _dispatchRead(bytes).then((response) {
+      if (response is OSError) {
+        throw new FileSystemException("read failed", path, response);
       }
-      _resourceInfo.addRead(response[1].length);
-      List<int> result = response[1];
+      List<int> result = response;
+      _resourceInfo.addRead(result.length);
       return result;
     });
   }
@@ -775,12 +781,12 @@ class _RandomAccessFile implements RandomAccessFile {
       return new Future.value(0);
     }
     int length = end - start;
-    return _dispatch(_IOService.fileReadInto, [null, length]).then((response) {
-      if (_isErrorResponse(response)) {
-        throw _exceptionFromResponse(response, "readInto failed", path);
+    return _dispatchRead(length).then((response) {
+      if (response is OSError) {
+        throw new FileSystemException("readInto failed", path, response);
       }
-      int read = response[1];
-      List<int> data = response[2];
+      List<int> data = response;
+      int read = data.length;
       buffer.setRange(start, start + read, data);
       _resourceInfo.addRead(read);
       return read;
@@ -1040,6 +1046,29 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
+  Uint8List mapSync(int start, int length,
+      {FileMapMode mode: FileMapMode.read,
+      FileMapAccess access: FileMapAccess.normal}) {
+    _checkAvailable();
+    ArgumentError.checkNotNull(mode, "mode");
+    ArgumentError.checkNotNull(access, "access");
+    if ((start is! int) || (length is! int)) {
+      throw new ArgumentError();
+    }
+    RangeError.checkNotNegative(start, "start");
+    if (length <= 0) {
+      throw new RangeError.range(length, 1, null, "length");
+    }
+    var result = _ops.map(mode._mode, start, length, access._access);
+    if (result is OSError) {
+      throw new FileSystemException('map failed', path, result);
+    }
+    if (mode == FileMapMode.read) {
+      return new UnmodifiableUint8ListView(result);
+    }
+    return result;
+  }
+
   void unlockSync([int start = 0, int end = -1]) {
     _checkAvailable();
     if ((start is! int) || (end is! int)) {
@@ -1083,6 +1112,22 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
+  // Like _dispatch, but reads on the embedder's I/O threads instead of going
+  // through the IOService.
+  Future _dispatchRead(int bytes) {
+    if (closed) {
+      return new Future.error(new FileSystemException("File closed", path));
+    }
+    if (_asyncDispatched) {
+      var msg = "An async operation is currently pending";
+      return new Future.error(new FileSystemException(msg, path));
+    }
+    _asyncDispatched = true;
+    return _ops.readAsync(bytes).whenComplete(() {
+      _asyncDispatched = false;
+    });
+  }
+
   void _checkAvailable() {
     if (_asyncDispatched) {
       throw new FileSystemException(
@@ -182,6 +182,65 @@ class FileStat {
     });
   }
 
+  /**
+   * Asynchronously calls the operating system's stat() function on each of
+   * the [paths].
+   *
+   * Returns a Future which completes with a list holding a [FileStat] object
+   * for each path, in the same order as [paths]. The paths are handled in a
+   * single request, which is much cheaper than calling [stat] for each of
+   * them when there are many. Paths for which the call fails get a
+   * [FileStat] object with `.type` set to FileSystemEntityType.notFound and
+   * the other fields invalid.
+   */
+  static Future<List<FileStat>> statAll(List<String> paths) {
+    final IOOverrides overrides = IOOverrides.current;
+    if (overrides == null) {
+      return _statAll(paths);
+    }
+    return Future.wait(paths.map(overrides.stat));
+  }
+
+  static Future<List<FileStat>> _statAll(List<String> paths) {
+    // Trailing path is not supported on Windows.
+    if (Platform.isWindows) {
+      paths = paths
+          .map(FileSystemEntity._trimTrailingPathSeparators)
+          .toList(growable: false);
+    }
+    return _File._dispatchWithNamespace(
+        _IOService.fileStatBatch, [null, paths]).then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(response, "Stat failed", null);
+      }
+      // The records of all paths are packed into a single byte array.
+      Uint8List bytes = response[1];
+      Int64List data = bytes.buffer.asInt64List(
+          bytes.offsetInBytes, bytes.length ~/ Int64List.bytesPerElement);
+      const int recordSize = _size + 1;
+      final result = new List<FileStat>(paths.length);
+      for (int i = 0; i < paths.length; i++) {
+        final int record = i * recordSize;
+        final int type = data[record + _type];
+        if (type == FileSystemEntityType.notFound._type) {
+          result[i] = FileStat._notFound;
+          continue;
+        }
+        result[i] = new FileStat._internal(
+            new DateTime.fromMillisecondsSinceEpoch(
+                data[record + _changedTime]),
+            new DateTime.fromMillisecondsSinceEpoch(
+                data[record + _modifiedTime]),
+            new DateTime.fromMillisecondsSinceEpoch(
+                data[record + _accessedTime]),
+            FileSystemEntityType._lookup(type),
+            data[record + _mode],
+            data[record + _size]);
+      }
+      return result;
+    });
+  }
+
   String toString() => """
 FileStat: type $type
           changed $changed
@@ -474,7 +533,8 @@ abstract class FileSystemEntity {
    *   * `Windows`: Uses `ReadDirectoryChangesW`. The implementation only
    *     supports watching directories. Recursive watching is supported.
    *   * `Linux`: Uses `inotify`. The implementation supports watching both
-   *     files and directories. Recursive watching is not supported.
+   *     files and directories. Recursive watching is supported by watching
+   *     every directory below the watched one.
    *     Note: When watching files directly, delete events might not happen
    *     as expected.
    *   * `OS X`: Uses `FSEvents`. The implementation supports watching both
@@ -171,6 +171,19 @@ abstract class SecureSocket implements Socket {
    */
   String get selectedProtocol;
 
+  /**
+   * Hands the encryption and decryption of records over to the operating
+   * system, and returns whether it did.
+   *
+   * This is only supported on Linux, for TLS 1.2 connections with an
+   * AES-128-GCM cipher suite, and only while no data is buffered in either
+   * direction, so it is best called right after the handshake has completed.
+   * Afterwards plaintext goes straight between the socket and the kernel,
+   * and [sendFile] sends files without reading them into memory. The
+   * connection can no longer be renegotiated.
+   */
+  bool enableKernelTls();
+
   /**
    * Renegotiate an existing secure connection, renewing the session keys
    * and possibly changing the connection properties.
@@ -371,6 +384,19 @@ abstract class RawSecureSocket implements RawSocket {
    * protocol between client and server.
    */
   String get selectedProtocol;
+
+  /**
+   * Hands the encryption and decryption of records over to the operating
+   * system, and returns whether it did.
+   *
+   * This is only supported on Linux, for TLS 1.2 connections with an
+   * AES-128-GCM cipher suite, and only while no data is buffered in either
+   * direction, so it is best called right after the handshake has completed.
+   * Afterwards plaintext goes straight between the socket and the kernel,
+   * and [sendFile] sends files without reading them into memory. The
+   * connection can no longer be renegotiated.
+   */
+  bool enableKernelTls();
 }
 
 /**
@@ -459,6 +485,9 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   bool _connectPending = true;
   bool _filterPending = false;
   bool _filterActive = false;
+  // Records are encrypted and decrypted by the kernel, and reads and writes
+  // go straight to the network socket.
+  bool _kernelTls = false;
 
   _SecureFilter _secureFilter = new _SecureFilter();
   String _selectedProtocol;
@@ -602,6 +631,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   }
 
   int available() {
+    if (_kernelTls) return _socket.available();
     return _status != connectedStatus
         ? 0
         : _secureFilter.buffers[readPlaintextId].length;
@@ -664,7 +694,9 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   void set writeEventsEnabled(bool value) {
     _writeEventsEnabled = value;
-    if (value) {
+    if (_kernelTls) {
+      _socket.writeEventsEnabled = value;
+    } else if (value) {
       Timer.run(() => _sendWriteEvent());
     }
   }
@@ -673,7 +705,31 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   void set readEventsEnabled(bool value) {
     _readEventsEnabled = value;
-    _scheduleReadEvent();
+    if (_kernelTls) {
+      _socket.readEventsEnabled = value;
+    } else {
+      _scheduleReadEvent();
+    }
+  }
+
+  bool enableKernelTls() {
+    if (_kernelTls) return true;
+    if (_status != connectedStatus ||
+        _closedRead ||
+        _closedWrite ||
+        _filterActive ||
+        _bufferedData != null ||
+        !_secureFilter.buffers.every((buffer) => buffer.isEmpty)) {
+      return false;
+    }
+    if (!_secureFilter.enableKernelTls(_socket)) return false;
+    _kernelTls = true;
+    _filterPending = false;
+    _filterStatus.readEmpty = true;
+    _filterStatus.writeEmpty = true;
+    _socket.readEventsEnabled = _readEventsEnabled;
+    _socket.writeEventsEnabled = _writeEventsEnabled;
+    return true;
   }
 
   List<int> read([int length]) {
@@ -687,11 +743,34 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     if (_status != connectedStatus) {
       return null;
     }
+    if (_kernelTls) return _socket.read(length);
     var result = _secureFilter.buffers[readPlaintextId].read(length);
     _scheduleFilter();
     return result;
   }
 
+  int sendFile(RandomAccessFile file, int position, int length) {
+    // The data has to be encrypted, so it is read into memory anyway. Only
+    // read as much as there is room for.
+    if (_status != connectedStatus) return 0;
+    if (_kernelTls) return _socket.sendFile(file, position, length);
+    int bytes = min(length, _secureFilter.buffers[writePlaintextId].free);
+    if (bytes == 0) return 0;
+    file.setPositionSync(position);
+    return write(file.readSync(bytes));
+  }
+
+  int readInto(Uint8List buffer, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (_kernelTls && !_closedRead) return _socket.readInto(buffer, start, end);
+    // The plaintext is decrypted into buffers of the filter, so it has to be
+    // copied out anyway.
+    var data = read(end - start);
+    if (data == null) return 0;
+    buffer.setRange(start, start + data.length, data);
+    return data.length;
+  }
+
   // Write the data to the socket, and schedule the filter to encrypt it.
   int write(List<int> data, [int offset, int bytes]) {
     if (bytes != null && (bytes is! int || bytes < 0)) {
@@ -707,6 +786,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
       return 0;
     }
     if (_status != connectedStatus) return 0;
+    if (_kernelTls) return _socket.write(data, offset, bytes);
     offset ??= 0;
     bytes ??= data.length - offset;
 
@@ -745,6 +825,10 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   }
 
   void _eventDispatcher(RawSocketEvent event) {
+    if (_kernelTls) {
+      _kernelTlsEventDispatcher(event);
+      return;
+    }
     try {
       if (event == RawSocketEvent.read) {
         _readHandler();
@@ -758,6 +842,27 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     }
   }
 
+  void _kernelTlsEventDispatcher(RawSocketEvent event) {
+    if (event == RawSocketEvent.read) {
+      if (_readEventsEnabled && !_closedRead) {
+        _controller.add(RawSocketEvent.read);
+      }
+    } else if (event == RawSocketEvent.write) {
+      if (_writeEventsEnabled && !_closedWrite) {
+        _writeEventsEnabled = false;
+        _controller.add(RawSocketEvent.write);
+      }
+    } else if (event == RawSocketEvent.readClosed) {
+      if (_closedRead) return;
+      _socketClosedRead = true;
+      _closedRead = true;
+      _controller.add(RawSocketEvent.readClosed);
+      if (_socketClosedWrite) {
+        _close();
+      }
+    }
+  }
+
   void _readHandler() {
     _readSocket();
     _scheduleFilter();
@@ -886,7 +991,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   }
 
   void _tryFilter() {
-    if (_status == closedStatus) {
+    if (_status == closedStatus || _kernelTls) {
       return;
     }
     if (_filterPending && !_filterActive) {
@@ -966,7 +1071,16 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   void _readSocket() {
     if (_status == closedStatus) return;
     var buffer = _secureFilter.buffers[readEncryptedId];
-    if (buffer.writeFromSource(_readSocketOrBufferedData) > 0) {
+    int bytes;
+    if (_bufferedData != null) {
+      bytes = buffer.writeFromSource(_readSocketOrBufferedData);
+    } else if (!_socketClosedRead) {
+      // Read the encrypted data straight into the filter's buffer.
+      bytes = buffer.writeFromSocket(_socket);
+    } else {
+      bytes = 0;
+    }
+    if (bytes > 0) {
       _filterStatus.readEmpty = false;
     } else {
       _socket.readEventsEnabled = false;
@@ -1008,6 +1122,13 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   // If a write event should be sent, add it to the controller.
   _sendWriteEvent() {
+    if (_kernelTls) {
+      // The network socket sends the write events.
+      if (_writeEventsEnabled && !_closedWrite) {
+        _socket.writeEventsEnabled = true;
+      }
+      return;
+    }
     if (!_closedWrite &&
         _writeEventsEnabled &&
         _pauseCount == 0 &&
@@ -1210,6 +1331,20 @@ class _ExternalBuffer {
     return written;
   }
 
+  int writeFromSocket(RawSocket socket) {
+    int written = 0;
+    int toWrite = linearFree;
+    // Loop over zero, one, or two linear data ranges.
+    while (toWrite > 0) {
+      int bytes = socket.readInto(data as Uint8List, end, end + toWrite);
+      if (bytes == 0) break;
+      advanceEnd(bytes);
+      written += bytes;
+      toWrite = linearFree;
+    }
+    return written;
+  }
+
   bool readToSocket(RawSocket socket) {
     // Loop over zero, one, or two linear data ranges.
     while (true) {
@@ -1246,6 +1381,7 @@ abstract class _SecureFilter {
   int processBuffer(int bufferIndex);
   void registerBadCertificateCallback(Function callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
+  bool enableKernelTls(RawSocket socket);
 
   // This call may cause a reference counted pointer in the native
   // implementation to be retained. It should only be called when the resulting
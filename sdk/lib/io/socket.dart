@@ -261,9 +261,22 @@ abstract class RawServerSocket implements Stream<RawSocket> {
    * other isolates are bound to the port, then the incoming connections will be
    * distributed among all the bound `RawServerSocket`s. Connections can be
    * distributed over multiple isolates this way.
+   *
+   * The optional argument [reusePort] also allows binding more
+   * `RawServerSocket`s to the same combination of `address`, `port` and
+   * `v6Only`, but gives each of them an operating system socket of its own,
+   * created with the `SO_REUSEPORT` option. On Linux and Android the kernel
+   * then distributes the incoming connections among them, without the
+   * sockets sharing an accept queue. All the sockets bound to the
+   * combination need to pass the same [reusePort], and [shared] and
+   * [reusePort] cannot both be `true`. Binding fails on platforms without
+   * `SO_REUSEPORT`.
    */
   external static Future<RawServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false});
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false});
 
   /**
    * Returns the port used by this socket.
@@ -326,9 +339,14 @@ abstract class ServerSocket implements Stream<Socket> {
    * isolates are bound to the port, then the incoming connections will be
    * distributed among all the bound `ServerSocket`s. Connections can be
    * distributed over multiple isolates this way.
+   *
+   * The optional argument [reusePort] works as for [RawServerSocket.bind].
    */
   external static Future<ServerSocket> bind(address, int port,
-      {int backlog: 0, bool v6Only: false, bool shared: false});
+      {int backlog: 0,
+      bool v6Only: false,
+      bool shared: false,
+      bool reusePort: false});
 
   /**
    * Returns the port used by this socket.
@@ -620,6 +638,29 @@ abstract class RawSocket implements Stream<RawSocketEvent> {
    */
   List<int> read([int len]);
 
+  /**
+   * Reads up to `end - start` bytes from the socket into [buffer], starting
+   * at [start], and returns the number of bytes read. [end] defaults to the
+   * length of [buffer].
+   *
+   * Like [read], this function is non-blocking and returns 0 when no data
+   * is available. Unlike [read], it does not allocate a new list, so a
+   * buffer can be reused for many reads.
+   */
+  int readInto(Uint8List buffer, [int start = 0, int end]);
+
+  /**
+   * Writes up to [length] bytes of [file], starting at [position], to the
+   * socket and returns the number of bytes written.
+   *
+   * Where the platform allows it, the bytes are passed from the file to the
+   * socket by the operating system, without being read into memory first.
+   * Like [write], this function is non-blocking and does not write more than
+   * the socket can take; wait for a [RawSocketEvent.write] event to write
+   * the rest. The position of [file] is unspecified afterwards.
+   */
+  int sendFile(RandomAccessFile file, int position, int length);
+
   /**
    * Writes up to [count] bytes of the buffer from [offset] buffer offset to
    * the socket. The number of successfully written bytes is returned. This
@@ -765,6 +806,17 @@ abstract class Socket implements Stream<List<int>>, IOSink {
    */
   void destroy();
 
+  /**
+   * Sends the bytes of [file] from [start] to [end] to the socket, like
+   * `addStream(file.openRead(start, end))` does.
+   *
+   * Where the platform allows it, the bytes are passed from the file to the
+   * socket by the operating system, without being read into memory first.
+   * As with [addStream], no other data can be added to the socket until the
+   * returned future completes.
+   */
+  Future sendFile(File file, [int start = 0, int end]);
+
   /**
    * Use [setOption] to customize the [RawSocket]. See [SocketOption] for
    * available options.
@@ -923,6 +975,16 @@ abstract class RawDatagramSocket extends Stream<RawSocketEvent> {
    */
   int send(List<int> buffer, InternetAddress address, int port);
 
+  /**
+   * Send several datagrams, each to its own address and port, with as few
+   * system calls as the platform allows.
+   *
+   * Returns the number of datagrams sent, which can be less than the length
+   * of [datagrams]. The remaining ones can be sent again on the next
+   * [RawSocketEvent.write] event.
+   */
+  int sendMany(List<Datagram> datagrams);
+
   /**
    * Receive a datagram. If there are no datagrams available `null` is
    * returned.
@@ -931,6 +993,16 @@ abstract class RawDatagramSocket extends Stream<RawSocketEvent> {
    */
   Datagram receive();
 
+  /**
+   * Receive up to [maxCount] datagrams at once, with as few system calls as
+   * the platform allows. If there are no datagrams available an empty list
+   * is returned.
+   *
+   * Fewer than [maxCount] datagrams may be returned even if more are
+   * pending, and at most 16 are received per call.
+   */
+  List<Datagram> receiveMany([int maxCount = 16]);
+
   /**
    * Join a multicast group.
    *
@@ -264,6 +264,27 @@ class Stdout extends _StdSink implements IOSink {
   external int _terminalLines(int fd);
   external static bool _supportsAnsiEscapes(int fd);
 
+  static const int _maxBufferSize = 1024 * 1024;
+
+  /**
+   * The number of bytes written to this stream which are collected before
+   * they are passed on to the operating system.
+   *
+   * Collected output is also passed on at the end of each turn of the event
+   * loop, on [flush], before the process exits, and for every line break
+   * when [hasTerminal] is true. Setting the size to zero passes every write
+   * on right away. The size is shared by all isolates, and is at most one
+   * megabyte.
+   *
+   * The standard error stream is not buffered, so that diagnostics are not
+   * lost if the process dies. Its size is always zero.
+   */
+  int get bufferSize => _StdIOUtils._getBufferSize(_fd);
+  void set bufferSize(int size) {
+    RangeError.checkValueInInterval(size, 0, _maxBufferSize, "size");
+    _StdIOUtils._setBufferSize(_fd, size);
+  }
+
   /**
    * Get a non-blocking `IOSink`.
    */
@@ -296,28 +317,78 @@ class StdinException implements IOException {
 }
 
 class _StdConsumer implements StreamConsumer<List<int>> {
+  final int _fd;
   final _file;
+  bool _flushScheduled = false;
+  // An error from writing out buffered output after the write that filled
+  // the buffer had returned. It is reported by the next write or flush.
+  OSError _flushError;
+
+  _StdConsumer(int fd)
+      : _fd = fd,
+        _file = _File._openStdioSync(fd);
+
+  bool get _isBuffered => _fd == 1;
+
+  void _write(List<int> data) {
+    if (!_isBuffered) {
+      _file.writeFromSync(data);
+      return;
+    }
+    _checkFlushError();
+    _StdIOUtils._writeBuffered(_fd, data);
+    if (!_flushScheduled) {
+      // The output written during this turn of the event loop is passed on
+      // in one go.
+      _flushScheduled = true;
+      Timer.run(() {
+        _flushScheduled = false;
+        try {
+          _StdIOUtils._flushBuffered(_fd);
+        } on StdoutException catch (e) {
+          _flushError = e.osError;
+        }
+      });
+    }
+  }
 
-  _StdConsumer(int fd) : _file = _File._openStdioSync(fd);
+  void _flush() {
+    if (!_isBuffered) return;
+    _checkFlushError();
+    _StdIOUtils._flushBuffered(_fd);
+  }
+
+  void _checkFlushError() {
+    if (_flushError != null) {
+      var error = _flushError;
+      _flushError = null;
+      throw new StdoutException("Error writing to standard output", error);
+    }
+  }
 
   Future addStream(Stream<List<int>> stream) {
     var completer = new Completer();
     var sub;
     sub = stream.listen((data) {
       try {
-        _file.writeFromSync(data);
+        _write(data);
       } catch (e, s) {
         sub.cancel();
         completer.completeError(e, s);
       }
-    },
-        onError: completer.completeError,
-        onDone: completer.complete,
-        cancelOnError: true);
+    }, onError: completer.completeError, onDone: () {
+      try {
+        _flush();
+        completer.complete();
+      } catch (e, s) {
+        completer.completeError(e, s);
+      }
+    }, cancelOnError: true);
     return completer.future;
   }
 
   Future close() {
+    _flush();
     _file.closeSync();
     return new Future.value();
   }
@@ -477,4 +548,10 @@ class _StdIOUtils {
   /// Returns the socket type or `null` if [socket] is not a builtin socket.
   external static int _socketType(Socket socket);
   external static _getStdioHandleType(int fd);
+
+  // Only used for the standard output and error streams, fd 1 and 2.
+  external static void _writeBuffered(int fd, List<int> data);
+  external static void _flushBuffered(int fd);
+  external static int _getBufferSize(int fd);
+  external static void _setBufferSize(int fd, int size);
 }
@@ -17,6 +17,7 @@
 library dart.isolate;
 
 import "dart:async";
+import "dart:typed_data" show ByteBuffer, TypedData, Uint8List;
 
 part "capability.dart";
 
@@ -750,3 +751,90 @@ class RemoteError implements Error {
         stackTrace = new StackTrace.fromString(stackDescription);
   String toString() => _description;
 }
+
+/**
+ * An efficiently transferable sequence of byte values.
+ *
+ * A [TransferableTypedData] is created from a number of bytes.
+ * This will take time proportional to the number of bytes.
+ *
+ * The [TransferableTypedData] can be moved between isolates, so
+ * sending it through a send port will only take constant time.
+ *
+ * When sent this way, the local transferable can no longer be materialized,
+ * and the received object is now the only way to materialize the data.
+ */
+abstract class TransferableTypedData {
+  /**
+   * Creates a new [TransferableTypedData] containing the bytes of [list].
+   *
+   * It must be possible to create a single [Uint8List] containing the
+   * bytes, so if there are more bytes than what the platform allows in
+   * a single [Uint8List], then creation fails.
+   */
+  external factory TransferableTypedData.fromList(List<TypedData> list);
+
+  /**
+   * Creates a new [ByteBuffer] containing the bytes stored in this
+   * [TransferableTypedData].
+   *
+   * The [TransferableTypedData] is a cross-isolate single-use resource.
+   * This method must not be called more than once on the same underlying
+   * transferable bytes, even if the calls occur in different isolates.
+   */
+  ByteBuffer materialize();
+}
+
+/**
+ * A single-producer, single-consumer channel of bytes between two isolates.
+ *
+ * The bytes are kept in memory shared by both isolates, so writing and
+ * reading do not send messages. One isolate creates the channel and passes
+ * its [id] to the other isolate, which calls [RingBufferChannel.attach].
+ * The creating isolate must keep its channel reachable until the other one
+ * has attached.
+ *
+ * Only one isolate may write to the channel and only one may read from it.
+ * The reading isolate can use [notifyWhenReadable] to be told about new
+ * bytes instead of polling.
+ */
+abstract class RingBufferChannel {
+  /**
+   * Creates a channel holding at least [capacity] bytes.
+   */
+  external factory RingBufferChannel(int capacity);
+
+  /**
+   * Attaches to the channel with the given [id] created by another isolate.
+   *
+   * Throws an [ArgumentError] if there is no such channel anymore.
+   */
+  external factory RingBufferChannel.attach(int id);
+
+  /** The id other isolates can attach to this channel with. */
+  int get id;
+
+  /** The number of bytes the channel can hold. */
+  int get capacity;
+
+  /**
+   * Copies as many of the bytes of [bytes] from [start] to [end] into the
+   * channel as fit, and returns their number.
+   */
+  int write(Uint8List bytes, [int start = 0, int end]);
+
+  /**
+   * Moves up to `end - start` bytes from the channel into [target] starting
+   * at [start], and returns their number.
+   */
+  int read(Uint8List target, [int start = 0, int end]);
+
+  /**
+   * Arranges for `null` to be sent to [port] once bytes are written to the
+   * channel, and returns `true`.
+   *
+   * Returns `false` without arranging anything if there are bytes to read
+   * already. Only the next write after this call sends a message.
+   */
+  bool notifyWhenReadable(SendPort port);
+}
@@ -1030,6 +1030,43 @@ void testFromToDouble() {
   Expect.equals(BigInt.zero, new BigInt.from(-0.9999999999999999));
 }
 
+// Operands large enough for Karatsuba multiplication, recursive division
+// and recursive decimal conversion.
+testBigintLarge() {
+  var x = new BigInt.from(3).pow(20000);
+  var y = new BigInt.from(7).pow(9000) + BigInt.one;
+  var m = (BigInt.one << 5000) - BigInt.one;
+  Expect.equals(
+      (BigInt.one << 10000) - (BigInt.one << 5001) + BigInt.one, m * m);
+  Expect.equals(x * x, x * (x + BigInt.one) - x);
+  Expect.equals(x * y, y * x);
+  Expect.equals(-(x * y), x * -y);
+  Expect.equals(x * (y + m), x * y + x * m);
+  Expect.equals(m * (x * y), (m * x) * y);
+  // Unbalanced operands.
+  var z = new BigInt.from(5).pow(1000);
+  Expect.equals(x * z * z, x * (z * z));
+
+  var r = y - new BigInt.from(12345);
+  var n = x * y + r;
+  Expect.equals(x, n ~/ y);
+  Expect.equals(r, n.remainder(y));
+  Expect.equals(-x, -n ~/ y);
+  Expect.equals(-r, (-n).remainder(y));
+  Expect.equals(y - r, (-n) % y);
+  Expect.equals(x - BigInt.one, (n - r - BigInt.one) ~/ y);
+  Expect.equals(y - BigInt.one, (n - r - BigInt.one).remainder(y));
+  Expect.equals(m, (m * m + m) ~/ (m + BigInt.one));
+
+  var digits = "1" + "0" * 3000 + "123456789" + "0" * 1000 + "42";
+  Expect.equals(digits, BigInt.parse(digits).toString());
+  Expect.equals("-" + digits, BigInt.parse("-" + digits).toString());
+  Expect.equals("1" + "0" * 5000, BigInt.from(10).pow(5000).toString());
+  Expect.equals("9" * 5000,
+      (BigInt.from(10).pow(5000) - BigInt.one).toString());
+  Expect.equals(x, BigInt.parse(x.toString()));
+}
+
 main() {
   for (int i = 0; i < 8; i++) {
     Expect.equals(BigInt.parse("1234567890123456789"), foo()); /// 01: ok
@@ -1065,6 +1102,7 @@ main() {
     var b = BigInt.parse("10000000000000000001"); /// 27: ok
     Expect.equals(false, a.hashCode == b.hashCode); /// 27: ok
     Expect.equals(true, a.hashCode == (b - BigInt.one).hashCode); /// 27: ok
+    testBigintLarge(); /// 28: ok
 
     // Regression test for http://dartbug.com/36105
     var overbig = -BigInt.from(10).pow(309);
@@ -0,0 +1,41 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=
+// VMOptions=--regexp_tier_up_threshold=0
+
+// Tests regexps whose matches all start with the same literal, which are
+// searched for by skipping to occurrences of it.
+
+import "package:expect/expect.dart";
+
+void check(String pattern, String subject, List<String> expected) {
+  var re = new RegExp(pattern);
+  // Run it often enough to be compiled when tiering up is enabled.
+  for (var i = 0; i < 20; i++) {
+    Expect.listEquals(
+        expected, re.allMatches(subject).map((m) => m[0]).toList());
+  }
+}
+
+main() {
+  check(r"ERROR:\s+(\d+)", "ok\nERROR: 12\nERROR:x\nERROR:  345",
+      ["ERROR: 12", "ERROR:  345"]);
+  check(r"ERROR:\s+(\d+)", "no errors at all", []);
+  check(r"ab", "aababab", ["ab", "ab", "ab"]);
+  check(r"(abc)+d", "abcabd abcabcd", ["abcabcd"]);
+  check(r"\bfoo\d", "xfoo1 foo2 foofoo3", ["foo2"]);
+  check(r"(?<=x)yz", "yz xyz xxyz", ["yz", "yz"]);
+  check(r"(?=ab)abc", "abab abc", ["abc"]);
+  check(r"aāb", "aaāābaāb", ["aāb"]);
+  check(r"aāb", "only one byte characters", []);
+  check(r"āĂ", "xāĂāăāĂ", ["āĂ", "āĂ"]);
+  check(r"end$", "end end", ["end"]);
+
+  var re = new RegExp(r"needle");
+  Expect.equals(8, "haystackneedle".indexOf(re, 5));
+  Expect.equals(null, re.matchAsPrefix("a needle"));
+  Expect.equals(2, re.firstMatch("a needle").start);
+  Expect.equals(null, re.firstMatch("a needl"));
+}
@@ -0,0 +1,37 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=
+// VMOptions=--regexp_tier_up_threshold=0
+// VMOptions=--regexp_tier_up_threshold=1
+// VMOptions=--regexp_tier_up_threshold=5
+
+// Tests that regexps match the same way before and after they are compiled.
+
+import "package:expect/expect.dart";
+
+main() {
+  var re = new RegExp(r"(\w+)@(\w+)\.com");
+  var subjects = [
+    "mail alice@example.com now",
+    "mäil bob@example.com now",
+    "mail \u{1F600} carol@example.com now",
+    "no address here",
+  ];
+  for (var i = 0; i < 20; i++) {
+    for (var subject in subjects) {
+      var match = re.firstMatch(subject);
+      if (subject.startsWith("no")) {
+        Expect.isNull(match);
+        continue;
+      }
+      Expect.equals("example", match.group(2));
+      Expect.isTrue(match.group(1).length >= 3);
+      Expect.equals(subject.indexOf("@") - match.group(1).length, match.start);
+      Expect.isNull(re.matchAsPrefix(subject));
+      Expect.isNotNull(re.matchAsPrefix(subject, match.start));
+    }
+    Expect.equals(2, re.allMatches("a@b.com c@d.com").length);
+  }
+}
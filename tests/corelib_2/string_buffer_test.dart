@@ -169,6 +169,23 @@ void testToString() {
   bf = new StringBuffer("foo");
   bf.write("bar");
   Expect.equals("foobar", bf.toString());
+
+  // Writing more after toString, with enough parts to be compacted.
+  bf = new StringBuffer();
+  var expected = "";
+  for (int i = 0; i < 300; i++) {
+    bf.write(i);
+    bf.writeCharCode(0x2c);
+    expected += "$i,";
+    if (i % 7 == 0) {
+      Expect.equals(expected, bf.toString());
+      Expect.equals(expected.length, bf.length);
+    }
+  }
+  Expect.equals(expected, bf.toString());
+  bf.clear();
+  bf.write("x");
+  Expect.equals("x", bf.toString());
 }
 
 void testChaining() {
@@ -0,0 +1,117 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for element-wise loads and stores through dart:ffi
+// pointers, which the VM compiles to raw memory accesses.
+//
+// VMOptions=
+// VMOptions=--deterministic --optimization-counter-threshold=10
+
+library FfiTest;
+
+import 'dart:ffi' as ffi;
+
+import "package:expect/expect.dart";
+
+const int length = 20;
+
+void main() {
+  for (int i = 0; i < 50; i++) {
+    testInt8Elements();
+    testUint16Elements();
+    testInt64Elements();
+    testIntPtrElements();
+    testFloatElements();
+    testDoubleElements();
+    testNull();
+  }
+}
+
+void testInt8Elements() {
+  ffi.Pointer<ffi.Int8> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(i * 100);
+  }
+  for (int i = 0; i < length; i++) {
+    Expect.equals((i * 100).toSigned(8), p.elementAt(i).load<int>());
+  }
+  ffi.Pointer<ffi.Int8> q = p.elementAt(3);
+  q.store(0x7fffffff01);
+  Expect.equals(1, p.elementAt(3).load<int>());
+  Expect.equals(q.address, p.address + 3);
+  p.free();
+}
+
+void testUint16Elements() {
+  ffi.Pointer<ffi.Uint16> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(-i);
+  }
+  for (int i = 0; i < length; i++) {
+    Expect.equals((-i).toUnsigned(16), p.elementAt(i).load<int>());
+  }
+  p.free();
+}
+
+void testInt64Elements() {
+  ffi.Pointer<ffi.Int64> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(0x100000000 * i - i);
+  }
+  int sum = 0;
+  for (int i = 0; i < length; i++) {
+    sum += p.elementAt(i).load<int>();
+  }
+  Expect.equals(0xffffffff * (length * (length - 1) ~/ 2), sum);
+  p.elementAt(length - 1).store(-0x8000000000000000);
+  Expect.equals(-0x8000000000000000, p.elementAt(length - 1).load<int>());
+  p.free();
+}
+
+void testIntPtrElements() {
+  ffi.Pointer<ffi.IntPtr> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(i - 10);
+  }
+  for (int i = 0; i < length; i++) {
+    Expect.equals(i - 10, p.elementAt(i).load<int>());
+  }
+  Expect.equals(length * ffi.sizeOf<ffi.IntPtr>(),
+      p.elementAt(length).address - p.address);
+  p.free();
+}
+
+void testFloatElements() {
+  ffi.Pointer<ffi.Float> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(i + 0.5);
+  }
+  for (int i = 0; i < length; i++) {
+    Expect.equals(i + 0.5, p.elementAt(i).load<double>());
+  }
+  p.store(1.1);
+  Expect.approxEquals(1.1, p.load<double>());
+  Expect.notEquals(1.1, p.load<double>());
+  p.free();
+}
+
+void testDoubleElements() {
+  ffi.Pointer<ffi.Double> p = ffi.allocate(count: length);
+  for (int i = 0; i < length; i++) {
+    p.elementAt(i).store(i / 3);
+  }
+  for (int i = 0; i < length; i++) {
+    Expect.equals(i / 3, p.elementAt(i).load<double>());
+  }
+  p.free();
+}
+
+void testNull() {
+  ffi.Pointer<ffi.Int32> p = null;
+  Expect.throws(() => p.load<int>());
+  Expect.throws(() => p.store(1));
+  ffi.Pointer<ffi.Int32> q = ffi.allocate();
+  Expect.throws(() => q.elementAt(null).load<int>());
+  q.free();
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for calling Dart functions from C through pointers
+// obtained with fromFunction.
+//
+// SharedObjects=ffi_test_functions
+
+library FfiTest;
+
+import 'dart:ffi' as ffi;
+
+import 'dylib_utils.dart';
+
+import "package:expect/expect.dart";
+
+typedef NativeIntptrBinOp = ffi.IntPtr Function(ffi.IntPtr, ffi.IntPtr);
+
+typedef NativeApplyTo42And74Type = ffi.IntPtr Function(
+    ffi.Pointer<ffi.NativeFunction<NativeIntptrBinOp>>);
+
+typedef ApplyTo42And74Type = int Function(
+    ffi.Pointer<ffi.NativeFunction<NativeIntptrBinOp>>);
+
+typedef NativeMixedOp = ffi.Double Function(
+    ffi.Int8, ffi.Double, ffi.Float, ffi.Int64);
+
+typedef NativeApplyToMixedArgumentsType = ffi.Double Function(
+    ffi.Pointer<ffi.NativeFunction<NativeMixedOp>>);
+
+typedef ApplyToMixedArgumentsType = double Function(
+    ffi.Pointer<ffi.NativeFunction<NativeMixedOp>>);
+
+ffi.DynamicLibrary ffiTestFunctions =
+    dlopenPlatformSpecific("ffi_test_functions");
+
+ApplyTo42And74Type applyTo42And74 = ffiTestFunctions
+    .lookupFunction<NativeApplyTo42And74Type, ApplyTo42And74Type>(
+        "ApplyTo42And74");
+
+ApplyToMixedArgumentsType applyToMixedArguments = ffiTestFunctions
+    .lookupFunction<NativeApplyToMixedArgumentsType,
+        ApplyToMixedArgumentsType>("ApplyToMixedArguments");
+
+int plus(int a, int b) => a + b;
+
+int throwing(int a, int b) => throw "callback failed";
+
+int returnsNull(int a, int b) => null;
+
+double mixed(int a, double b, double c, int d) => a + b * c + d;
+
+void main() {
+  for (int i = 0; i < 10; i++) {
+    testCallback();
+    testExceptionalReturn();
+    testMixedArguments();
+    testSamePointer();
+  }
+}
+
+void testCallback() {
+  Expect.equals(
+      116, applyTo42And74(ffi.fromFunction<NativeIntptrBinOp>(plus, 0)));
+}
+
+void testExceptionalReturn() {
+  Expect.equals(
+      -1, applyTo42And74(ffi.fromFunction<NativeIntptrBinOp>(throwing, -1)));
+  Expect.equals(
+      -2, applyTo42And74(ffi.fromFunction<NativeIntptrBinOp>(returnsNull, -2)));
+  Expect.throws(() => ffi.fromFunction<NativeIntptrBinOp>(plus));
+  Expect.throws(() => ffi.fromFunction<NativeIntptrBinOp>(plus, 1.5));
+}
+
+void testMixedArguments() {
+  Expect.equals(-1 + 1.5 * 2.25 + (1 << 40),
+      applyToMixedArguments(ffi.fromFunction<NativeMixedOp>(mixed, 0.0)));
+}
+
+void testSamePointer() {
+  Expect.equals(ffi.fromFunction<NativeIntptrBinOp>(plus, 0).address,
+      ffi.fromFunction<NativeIntptrBinOp>(plus, 0).address);
+  Expect.notEquals(ffi.fromFunction<NativeIntptrBinOp>(plus, 0).address,
+      ffi.fromFunction<NativeIntptrBinOp>(plus, 1).address);
+}
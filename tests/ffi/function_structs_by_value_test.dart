@@ -0,0 +1,197 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for passing and returning structs by value in calls to C
+// functions.
+//
+// VMOptions=
+// VMOptions=--deterministic --optimization-counter-threshold=10
+// SharedObjects=ffi_test_functions
+
+library FfiTest;
+
+import 'dart:ffi' as ffi;
+import 'dart:io' show Platform;
+
+import 'dylib_utils.dart';
+
+import "package:expect/expect.dart";
+
+@ffi.struct
+class Mixed8 extends ffi.Pointer<ffi.Void> {
+  @ffi.Int32()
+  int a;
+
+  @ffi.Float()
+  double b;
+
+  external static int sizeOf();
+
+  factory Mixed8(int a, double b) =>
+      ffi.allocate<ffi.Uint8>(count: sizeOf()).cast<Mixed8>()
+        ..a = a
+        ..b = b;
+}
+
+@ffi.struct
+class Mixed12 extends ffi.Pointer<ffi.Void> {
+  @ffi.Float()
+  double x;
+
+  @ffi.Int32()
+  int tag;
+
+  @ffi.Float()
+  double y;
+
+  external static int sizeOf();
+
+  factory Mixed12(double x, int tag, double y) =>
+      ffi.allocate<ffi.Uint8>(count: sizeOf()).cast<Mixed12>()
+        ..x = x
+        ..tag = tag
+        ..y = y;
+}
+
+@ffi.struct
+class Point2 extends ffi.Pointer<ffi.Void> {
+  @ffi.Double()
+  double x;
+
+  @ffi.Double()
+  double y;
+
+  external static int sizeOf();
+
+  factory Point2(double x, double y) =>
+      ffi.allocate<ffi.Uint8>(count: sizeOf()).cast<Point2>()
+        ..x = x
+        ..y = y;
+}
+
+@ffi.struct
+class Point3 extends ffi.Pointer<ffi.Void> {
+  @ffi.Double()
+  double x;
+
+  @ffi.Double()
+  double y;
+
+  @ffi.Double()
+  double z;
+
+  external static int sizeOf();
+
+  factory Point3(double x, double y, double z) =>
+      ffi.allocate<ffi.Uint8>(count: sizeOf()).cast<Point3>()
+        ..x = x
+        ..y = y
+        ..z = z;
+}
+
+typedef NativeScaleMixed8 = ffi.ByValue<Mixed8> Function(
+    ffi.ByValue<Mixed8>, ffi.Int32);
+typedef ScaleMixed8 = Mixed8 Function(Mixed8, int);
+
+typedef NativeSwapMixed12 = ffi.ByValue<Mixed12> Function(
+    ffi.ByValue<Mixed12>);
+typedef SwapMixed12 = Mixed12 Function(Mixed12);
+
+typedef NativeSumPoint2s = ffi.ByValue<Point2> Function(
+    ffi.ByValue<Point2>,
+    ffi.ByValue<Point2>,
+    ffi.ByValue<Point2>,
+    ffi.ByValue<Point2>,
+    ffi.ByValue<Point2>);
+typedef SumPoint2s = Point2 Function(Point2, Point2, Point2, Point2, Point2);
+
+typedef NativeScalePoint3 = ffi.ByValue<Point3> Function(
+    ffi.ByValue<Point3>, ffi.Double);
+typedef ScalePoint3 = Point3 Function(Point3, double);
+
+ffi.DynamicLibrary ffiTestFunctions =
+    dlopenPlatformSpecific("ffi_test_functions");
+
+void main() {
+  for (int i = 0; i < 20; i++) {
+    testSmallStruct();
+    testMixedStruct();
+    testStructsOnStack();
+    testLargeStruct();
+    testNull();
+  }
+}
+
+void testSmallStruct() {
+  ScaleMixed8 f = ffiTestFunctions
+      .lookupFunction<NativeScaleMixed8, ScaleMixed8>("ScaleMixed8");
+  Mixed8 m = Mixed8(3, 1.5);
+  Mixed8 result = f(m, 4);
+  Expect.equals(12, result.a);
+  Expect.equals(6.0, result.b);
+  // The argument is passed as a copy.
+  Expect.equals(3, m.a);
+  Expect.notEquals(m.address, result.address);
+  m.free();
+  result.free();
+}
+
+void testMixedStruct() {
+  if (Platform.isWindows) {
+    Expect.throws<UnsupportedError>(() => ffiTestFunctions
+        .lookupFunction<NativeSwapMixed12, SwapMixed12>("SwapMixed12"));
+    return;
+  }
+  SwapMixed12 f = ffiTestFunctions
+      .lookupFunction<NativeSwapMixed12, SwapMixed12>("SwapMixed12");
+  Mixed12 m = Mixed12(1.5, 7, 2.5);
+  Mixed12 result = f(m);
+  Expect.equals(2.5, result.x);
+  Expect.equals(8, result.tag);
+  Expect.equals(1.5, result.y);
+  m.free();
+  result.free();
+}
+
+void testStructsOnStack() {
+  if (Platform.isWindows) {
+    Expect.throws<UnsupportedError>(() => ffiTestFunctions
+        .lookupFunction<NativeSumPoint2s, SumPoint2s>("SumPoint2s"));
+    return;
+  }
+  SumPoint2s f = ffiTestFunctions
+      .lookupFunction<NativeSumPoint2s, SumPoint2s>("SumPoint2s");
+  List<Point2> points = <Point2>[];
+  for (int i = 1; i <= 5; i++) {
+    points.add(Point2(i.toDouble(), -i / 2));
+  }
+  Point2 result = f(points[0], points[1], points[2], points[3], points[4]);
+  Expect.equals(15.0, result.x);
+  Expect.equals(-7.5, result.y);
+  points.forEach((p) => p.free());
+  result.free();
+}
+
+void testLargeStruct() {
+  if (Platform.isWindows) {
+    Expect.throws<UnsupportedError>(() => ffiTestFunctions
+        .lookupFunction<NativeScalePoint3, ScalePoint3>("ScalePoint3"));
+    return;
+  }
+  ScalePoint3 f = ffiTestFunctions
+      .lookupFunction<NativeScalePoint3, ScalePoint3>("ScalePoint3");
+  Point3 p = Point3(1.0, -2.0, 0.5);
+  Point3 result = f(p, 3.0);
+  Expect.equals(3.0, result.x);
+  Expect.equals(-6.0, result.y);
+  Expect.equals(1.5, result.z);
+  p.free();
+  result.free();
+}
+
+void testNull() {
+  ScaleMixed8 f = ffiTestFunctions
+      .lookupFunction<NativeScaleMixed8, ScaleMixed8>("ScaleMixed8");
+  Expect.throws(() => f(null, 1));
+}
@@ -36,6 +36,7 @@ void main() {
     testFloatRounding();
     testVoidReturn();
     testNoArgs();
+    testLeafCalls();
   }
 }
 
@@ -326,6 +327,29 @@ typedef Int64PointerUnOp = ffi.Pointer<ffi.Int64> Function(
 Int64PointerUnOp assign1337Index1 = ffiTestFunctions
     .lookupFunction<Int64PointerUnOp, Int64PointerUnOp>("Assign1337Index1");
 
+BinaryOp sumPlus42Leaf = ffiTestFunctions
+    .lookupFunction<NativeBinaryOp, BinaryOp>("SumPlus42", isLeaf: true);
+
+VigesimalOp sumManyNumbersLeaf = ffiTestFunctions
+    .lookupFunction<NativeVigesimalOp, VigesimalOp>("SumManyNumbers",
+        isLeaf: true);
+
+Int64PointerUnOp assign1337Index1Leaf = ffiTestFunctions
+    .lookupFunction<Int64PointerUnOp, Int64PointerUnOp>("Assign1337Index1",
+        isLeaf: true);
+
+void testLeafCalls() {
+  Expect.equals(49, sumPlus42Leaf(3, 4));
+  Expect.approxEquals(
+      210.0,
+      sumManyNumbersLeaf(1, 2.0, 3, 4.0, 5, 6.0, 7, 8.0, 9, 10.0, 11, 12.0, 13,
+          14.0, 15, 16.0, 17, 18.0, 19, 20.0));
+  ffi.Pointer<ffi.Int64> p = ffi.allocate(count: 2);
+  Expect.equals(p.elementAt(1).address, assign1337Index1Leaf(p).address);
+  Expect.equals(1337, p.elementAt(1).load<int>());
+  p.free();
+}
+
 void testNativeFunctionPointer() {
   ffi.Pointer<ffi.Int64> p2 = ffi.allocate(count: 2);
   p2.store(42);
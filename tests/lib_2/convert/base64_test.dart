@@ -23,6 +23,7 @@ main() {
   }
   testErrors();
   testIssue25577();
+  testLongInputs();
 
   // Decoder is lenient with mixed styles.
   Expect.listEquals([0xfb, 0xff, 0xbf, 0x00], base64.decode("-_+/AA%3D="));
@@ -291,6 +292,37 @@ void testIssue25577() {
       base64.encoder.startChunkedConversion(new TestSink<String>());
 }
 
+void testLongInputs() {
+  // Long enough to be converted natively by the VM.
+  for (var length = 30; length < 100; length++) {
+    var bytes = new Uint8List(length);
+    for (var i = 0; i < length; i++) {
+      bytes[i] = (i * 37 + length) & 0xff;
+    }
+    var encoded = base64.encode(bytes);
+    Expect.equals(base64.encode(bytes.toList()), encoded);
+    Expect.equals(encoded.replaceAll("+", "-").replaceAll("/", "_"),
+        base64Url.encode(bytes));
+    Expect.listEquals(bytes, base64.decode(encoded));
+    Expect.listEquals(bytes, base64.decode(base64Url.encode(bytes)));
+    Expect.listEquals(
+        bytes, base64.decoder.convert("!!$encoded!!", 2, encoded.length + 2));
+    Expect.listEquals(bytes.sublist(3), base64.decode(base64.encode(
+        new Uint8List.view(bytes.buffer, 3))));
+  }
+
+  var long = "QUJD" * 10;
+  Expect.listEquals("ABC".codeUnits * 10, base64.decode(long));
+  Expect.listEquals("ABC".codeUnits * 10 + [0xff, 0xff],
+      base64.decode(long + "//8%3D"));
+  Expect.throwsFormatException(() => base64.decode(long + "QUJ"));
+  Expect.throwsFormatException(() => base64.decode(long + "QR=="));
+  Expect.throwsFormatException(() => base64.decode(long + "QUF="));
+  Expect.throwsFormatException(() => base64.decode(long + "Q==="));
+  Expect.throwsFormatException(() => base64.decode(long + "Q\xffJD"));
+  Expect.throwsFormatException(() => base64.decode("QU==" + long));
+}
+
 // Implementation of Sink<T> to test type constraints.
 class TestSink<T> implements Sink<T> {
   void add(T value) {}
@@ -409,6 +409,43 @@ testWhitespace() {
   }
 }
 
+testDocuments() {
+  // Duplicate keys keep their first position and their last value.
+  var map = json.decode('{"a": 1, "b": 2, "a": 3}');
+  Expect.listEquals(["a", "b"], map.keys.toList());
+  Expect.equals(3, map["a"]);
+
+  // Decoded maps and lists behave like literals.
+  map = json.decode('{"list": [1, {"x": null}], "s": "\\u00e6\\ud83d\\ude00"}');
+  Expect.isTrue(map is Map<String, dynamic>);
+  Expect.isTrue(map["list"] is List<dynamic>);
+  Expect.isTrue(map["list"][1].containsKey("x"));
+  Expect.equals("\u00e6\u{1F600}", map["s"]);
+  map["new"] = 1;
+  map["list"].add(2);
+  Expect.equals(3, map.length);
+  Expect.equals(3, map["list"].length);
+
+  // Many objects with the same short keys, decoded from bytes too.
+  var text = "[" +
+      new List.generate(1000, (i) => '{"id": $i, "name": "n$i"}').join(",") +
+      "]";
+  for (var list in [
+    json.decode(text),
+    utf8.decoder.fuse(json.decoder).convert(utf8.encode(text))
+  ]) {
+    Expect.equals(1000, list.length);
+    Expect.equals(999, list[999]["id"]);
+    Expect.equals("n999", list[999]["name"]);
+  }
+
+  // Nesting deeper than the native parser handles.
+  var deep = "[" * 10000 + "]" * 10000;
+  var value = json.decode(deep);
+  for (int i = 0; i < 9999; i++) value = value[0];
+  Expect.listEquals([], value);
+}
+
 main() {
   testNumbers();
   testStrings();
@@ -416,4 +453,5 @@ main() {
   testObjects();
   testArrays();
   testWhitespace();
+  testDocuments();
 }
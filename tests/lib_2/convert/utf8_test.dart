@@ -19,6 +19,7 @@ void main() {
 
   testDecodeSlice();
   testErrorOffset();
+  testLongInput();
 }
 
 void testDecodeSlice() {
@@ -58,6 +59,37 @@ void testDecodeSlice() {
   testUtf8(new Uint8List.fromList(utf8bytes));
 }
 
+void testLongInput() {
+  // Long typed data inputs take a different path in some implementations.
+  var prefix = "x" * 100;
+  for (var test in UNICODE_TESTS) {
+    List<int> bytes = test[0];
+    String expected = prefix + test[1] + prefix;
+    var input = <int>[]..addAll(utf8.encode(prefix))..addAll(bytes);
+    input.addAll(utf8.encode(prefix));
+    Expect.stringEquals(expected, decode(input));
+    Expect.stringEquals(expected, decode(new Uint8List.fromList(input)));
+    var padded = new Uint8List(input.length + 3)
+      ..setRange(3, 3 + input.length, input);
+    Expect.stringEquals(
+        expected, decode(new Uint8List.view(padded.buffer, 3)));
+    Expect.stringEquals(expected, decode(padded, 3));
+  }
+
+  // A leading byte order mark is dropped.
+  var withBom = new Uint8List.fromList(
+      [0xEF, 0xBB, 0xBF]..addAll(utf8.encode(prefix + "\u1234")));
+  Expect.stringEquals(prefix + "\u1234", decode(withBom));
+
+  // Malformed input is still reported at the first bad byte.
+  var malformed = new Uint8List.fromList(
+      utf8.encode(prefix)..addAll([0xC0, 0x80])..addAll(utf8.encode(prefix)));
+  Expect.throws(() => decode(malformed),
+      (e) => e is FormatException && e.offset == 100);
+  Expect.stringEquals(prefix + "\uFFFD" + prefix,
+      new Utf8Decoder(allowMalformed: true).convert(malformed));
+}
+
 void testErrorOffset() {
   // Test that failed convert calls have an offset in the exception.
   testExn(input, offset) {
@@ -0,0 +1,92 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "dart:async";
+import "dart:isolate";
+import "dart:typed_data";
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const total = 10000;
+
+// Attaches to the channel and writes the bytes 0, 1, ... 255, 0, ... to it.
+void producer(int id) {
+  final channel = new RingBufferChannel.attach(id);
+  final bytes = new Uint8List(100);
+  int written = 0;
+  void writeMore() {
+    while (written < total) {
+      for (int i = 0; i < bytes.length; i++) {
+        bytes[i] = (written + i) & 0xff;
+      }
+      final count = channel.write(
+          bytes, 0, total - written < 100 ? total - written : 100);
+      if (count == 0) {
+        // The ring is full: let the consumer catch up.
+        Timer.run(writeMore);
+        return;
+      }
+      written += count;
+    }
+  }
+
+  writeMore();
+}
+
+void testLocal() {
+  final channel = new RingBufferChannel(10);
+  Expect.equals(16, channel.capacity);
+  Expect.equals(16, channel.write(new Uint8List(20)));
+  Expect.equals(0, channel.write(new Uint8List(1)));
+  final target = new Uint8List(20);
+  Expect.equals(4, channel.read(target, 2, 6));
+  Expect.equals(12, channel.read(target));
+  Expect.equals(0, channel.read(target));
+
+  Expect.throwsRangeError(() => channel.read(target, 10, 30));
+  Expect.throwsRangeError(() => new RingBufferChannel(0));
+  Expect.throwsArgumentError(() => new RingBufferChannel.attach(-1));
+
+  final other = new RingBufferChannel.attach(channel.id);
+  Expect.equals(channel.id, other.id);
+  Expect.equals(3, other.write(new Uint8List.fromList([1, 2, 3])));
+  Expect.equals(3, channel.read(target));
+  Expect.listEquals([1, 2, 3], target.sublist(0, 3));
+}
+
+void testAcrossIsolates() {
+  asyncStart();
+  final channel = new RingBufferChannel(256);
+  final port = new ReceivePort();
+  final buffer = new Uint8List(64);
+  int received = 0;
+
+  void readAll() {
+    int count;
+    while ((count = channel.read(buffer)) > 0) {
+      for (int i = 0; i < count; i++) {
+        Expect.equals((received + i) & 0xff, buffer[i]);
+      }
+      received += count;
+    }
+    if (received == total) {
+      port.close();
+      asyncEnd();
+    } else if (!channel.notifyWhenReadable(port.sendPort)) {
+      // Bytes arrived before the request was registered.
+      Timer.run(readAll);
+    }
+  }
+
+  port.listen((message) {
+    Expect.isNull(message);
+    readAll();
+  });
+  Isolate.spawn(producer, channel.id).then((_) => readAll());
+}
+
+main() {
+  testLocal();
+  testAcrossIsolates();
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--share_program_on_spawn
+
+// Tests that isolates created from a snapshot of the parent's program start
+// with fresh static state and can spawn isolates themselves.
+
+import "dart:async";
+import "dart:isolate";
+import "package:expect/expect.dart";
+
+int counter = 0;
+final List<String> log = <String>["initial"];
+
+class Point {
+  final int x;
+  final int y;
+  const Point(this.x, this.y);
+  int get sum => x + y;
+}
+
+void grandchild(SendPort replyPort) {
+  replyPort.send("grandchild $counter ${log.length}");
+}
+
+Future<void> child(SendPort replyPort) async {
+  // Statics start from their initial values, not the parent's.
+  Expect.equals(0, counter);
+  Expect.listEquals(<String>["initial"], log);
+  counter = 7;
+  replyPort.send(new Point(3, 4).sum + counter);
+
+  final port = new ReceivePort();
+  await Isolate.spawn(grandchild, port.sendPort);
+  replyPort.send(await port.first);
+}
+
+Future<void> main() async {
+  // Warm up and mutate state before spawning.
+  for (int i = 0; i < 1000; i++) {
+    counter += new Point(i, 1).sum;
+  }
+  log.add("parent");
+
+  for (int round = 0; round < 2; round++) {
+    final port = new ReceivePort();
+    await Isolate.spawn(child, port.sendPort);
+    final incoming = new StreamIterator<dynamic>(port);
+    Expect.isTrue(await incoming.moveNext());
+    Expect.equals(14, incoming.current);
+    Expect.isTrue(await incoming.moveNext());
+    Expect.equals("grandchild 0 1", incoming.current);
+    port.close();
+  }
+  Expect.equals(2, log.length);
+}
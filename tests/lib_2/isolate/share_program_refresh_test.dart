@@ -0,0 +1,43 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--share_program_on_spawn --share_program_refresh_threshold=1 --optimization_counter_threshold=100 --no-background-compilation
+
+// Tests that isolates spawned after the spawning isolate optimized more code
+// start from a new snapshot of its program.
+
+import "dart:async";
+import "dart:isolate";
+import "package:expect/expect.dart";
+
+int counter = 0;
+
+int hot(int i) => i * 2 + 1;
+
+void child(SendPort replyPort) {
+  int sum = 0;
+  for (int i = 0; i < 1000; i++) {
+    sum += hot(i);
+  }
+  replyPort.send(sum + counter);
+}
+
+Future<int> spawnChild() async {
+  final port = new ReceivePort();
+  await Isolate.spawn(child, port.sendPort);
+  final result = await port.first;
+  port.close();
+  return result;
+}
+
+Future<void> main() async {
+  Expect.equals(1000000, await spawnChild());
+
+  // Optimize 'hot' so that the next spawn writes a new snapshot.
+  for (int i = 0; i < 10000; i++) {
+    counter += hot(i) & 1;
+  }
+  Expect.equals(1000000, await spawnChild());
+  Expect.equals(1000000, await spawnChild());
+}
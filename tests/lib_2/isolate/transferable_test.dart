@@ -0,0 +1,59 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "dart:async";
+import "dart:isolate";
+import "dart:typed_data";
+import "package:expect/expect.dart";
+
+const large = 2 * 1024 * 1024;
+
+void child(replyPort) {
+  print("Child start");
+
+  final x = new Uint8List(large);
+  for (int i = 0; i < 4; i++) {
+    x[i] = i;
+  }
+  final y = new Uint16List(4);
+  for (int i = 0; i < 4; i++) {
+    y[i] = i;
+  }
+  final transferable = new TransferableTypedData.fromList(
+      <TypedData>[x, new Uint8List.view(x.buffer, 1, 2), y]);
+  replyPort.send(transferable);
+
+  // The bytes moved with the message: they can't be used here any more.
+  Expect.throwsArgumentError(() => transferable.materialize());
+  Expect.throws(() => replyPort.send(transferable));
+
+  print("Child done");
+}
+
+Future<void> main(List<String> args) async {
+  print("Parent start");
+
+  ReceivePort port = new ReceivePort();
+  Isolate.spawn(child, port.sendPort);
+  StreamIterator<dynamic> incoming = new StreamIterator<dynamic>(port);
+
+  Expect.isTrue(await incoming.moveNext());
+  dynamic x = incoming.current;
+  Expect.isTrue(x is TransferableTypedData);
+  final bytes = x.materialize().asUint8List();
+  Expect.equals(large + 2 + 8, bytes.length);
+  for (int i = 0; i < 4; i++) {
+    Expect.equals(i, bytes[i]);
+  }
+  Expect.equals(1, bytes[large]);
+  Expect.equals(2, bytes[large + 1]);
+  final tail = bytes.buffer.asByteData(large + 2);
+  for (int i = 0; i < 4; i++) {
+    Expect.equals(i, tail.getUint16(2 * i, Endian.host));
+  }
+  Expect.throwsArgumentError(() => x.materialize());
+
+  port.close();
+  print("Parent done");
+}
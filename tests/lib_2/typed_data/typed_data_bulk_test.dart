@@ -0,0 +1,137 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests fillRange, indexOf, lastIndexOf and setRange on ranges long enough
+// to be handled in bulk, comparing them with element-wise stores.
+
+import 'dart:typed_data';
+import 'package:expect/expect.dart';
+
+const int length = 100;
+
+List<List<int>> intLists() => [
+      new Int8List(length),
+      new Uint8List(length),
+      new Uint8ClampedList(length),
+      new Int16List(length),
+      new Uint16List(length),
+      new Int32List(length),
+      new Uint32List(length),
+      new Int64List(length),
+      new Uint64List(length),
+      new Int16List.view(new Int16List(length + 8).buffer, 6, length),
+    ];
+
+List<List<double>> doubleLists() => [
+      new Float32List(length),
+      new Float64List(length),
+      new Float64List.view(new Float64List(length + 2).buffer, 8, length),
+    ];
+
+testFillRange() {
+  var values = [0, 1, -1, 127, 128, 255, 256, -129, 0x12345678, -1 << 40];
+  for (var value in values) {
+    var lists = intLists();
+    var expected = intLists();
+    for (var j = 0; j < lists.length; j++) {
+      lists[j].fillRange(10, 90, value);
+      for (var i = 10; i < 90; i++) {
+        expected[j][i] = value;
+      }
+      Expect.listEquals(expected[j], lists[j], "${lists[j].runtimeType}");
+    }
+  }
+  for (var value in [0.0, -0.0, 1.5, 1e40, double.nan, 0.1]) {
+    for (var list in doubleLists()) {
+      list.fillRange(3, 97, value);
+      Expect.equals(0.0, list[2]);
+      Expect.equals(0.0, list[97]);
+      var expected =
+          (list is Float32List) ? (new Float32List(1)..[0] = value)[0] : value;
+      for (var i = 3; i < 97; i++) {
+        if (value.isNaN) {
+          Expect.isTrue(list[i].isNaN);
+        } else {
+          Expect.equals(expected, list[i]);
+          Expect.equals(expected.isNegative, list[i].isNegative);
+        }
+      }
+    }
+  }
+}
+
+testIndexOf() {
+  for (var list in intLists()) {
+    for (var i = 0; i < length; i++) {
+      list[i] = i % 50;
+    }
+    Expect.equals(7, list.indexOf(7));
+    Expect.equals(57, list.indexOf(7, 8));
+    Expect.equals(-1, list.indexOf(7, 58));
+    Expect.equals(57, list.lastIndexOf(7));
+    Expect.equals(7, list.lastIndexOf(7, 56));
+    Expect.equals(-1, list.indexOf(50));
+    Expect.equals(-1, list.indexOf(7 + 0x10000));
+    Expect.equals(-1, list.lastIndexOf(7 - 0x10000));
+    Expect.equals(-1, list.indexOf(null));
+    list[80] = -1;
+    Expect.equals(list[80] == -1 ? 80 : -1, list.indexOf(-1));
+    Expect.equals(list[80] == -1 ? 80 : -1, list.lastIndexOf(-1));
+  }
+  for (var list in doubleLists()) {
+    for (var i = 0; i < length; i++) {
+      list[i] = (i % 50) + 0.5;
+    }
+    list[60] = -0.0;
+    list[70] = double.nan;
+    Expect.equals(7, list.indexOf(7.5));
+    Expect.equals(57, list.lastIndexOf(7.5));
+    Expect.equals(60, list.indexOf(0.0));
+    Expect.equals(-1, list.indexOf(double.nan));
+    Expect.equals(-1, list.indexOf(0.1));
+  }
+}
+
+testConvertingSetRange() {
+  var source = new Int64List(length);
+  for (var i = 0; i < length; i++) {
+    source[i] = (i - 50) * 0x01010101 * 3;
+  }
+  var sources = intLists();
+  for (var from in sources) {
+    for (var i = 0; i < length; i++) {
+      from[i] = source[i];
+    }
+  }
+  for (var from in sources) {
+    var lists = intLists();
+    var expected = intLists();
+    for (var j = 0; j < lists.length; j++) {
+      lists[j].setRange(5, 95, from, 2);
+      for (var i = 5; i < 95; i++) {
+        expected[j][i] = from[i - 3];
+      }
+      Expect.listEquals(expected[j], lists[j],
+          "${from.runtimeType} to ${lists[j].runtimeType}");
+    }
+  }
+
+  var doubles = new Float64List(length);
+  for (var i = 0; i < length; i++) {
+    doubles[i] = i / 3;
+  }
+  var floats = new Float32List(length)..setRange(0, length, doubles);
+  for (var i = 0; i < length; i++) {
+    var expected = new Float32List(1)..[0] = doubles[i];
+    Expect.equals(expected[0], floats[i]);
+  }
+  doubles.setRange(0, length, floats);
+  Expect.listEquals(floats, doubles);
+}
+
+main() {
+  testFillRange();
+  testIndexOf();
+  testConvertingSetRange();
+}
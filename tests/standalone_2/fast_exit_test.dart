@@ -0,0 +1,44 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// With --fast-exit the VM skips tearing down the heap at exit, but the output
+// and exit code of the program are unchanged.
+
+import "dart:io";
+import "dart:isolate";
+
+import "package:expect/expect.dart";
+
+void child(SendPort port) {
+  port.send(new List<int>.generate(1000, (i) => i).reduce((a, b) => a + b));
+}
+
+Future<void> runChild() async {
+  final garbage = <List<int>>[];
+  for (var i = 0; i < 100; i++) {
+    garbage.add(new List<int>.filled(10000, i));
+  }
+  final port = new ReceivePort();
+  await Isolate.spawn(child, port.sendPort);
+  print(await port.first);
+  stdout.write("done");
+  exitCode = 3;
+}
+
+main(List<String> args) async {
+  if (args.contains("child")) {
+    await runChild();
+    return;
+  }
+  if (Platform.executable.endsWith("dart_precompiled_runtime")) {
+    return; // The test runs the script from source.
+  }
+  final result = Process.runSync(Platform.executable, <String>[
+    "--fast-exit",
+    Platform.script.toFilePath(),
+    "child",
+  ]);
+  Expect.equals(3, result.exitCode, result.stderr);
+  Expect.equals("499500\ndone", result.stdout.replaceAll("\r\n", "\n"));
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that listing a directory with more entries than fit in one response
+// from the native lister gives the same entries as a synchronous listing.
+
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+main() async {
+  asyncStart();
+  Directory dir = Directory.systemTemp.createTempSync('dart_list_chunks');
+  try {
+    for (int i = 0; i < 40; i++) {
+      Directory sub = new Directory('${dir.path}/d$i')..createSync();
+      for (int j = 0; j < 60; j++) {
+        // Names of many lengths, including non-ASCII ones.
+        String name = 'f$j${'x' * (j % 17)}${i % 3 == 0 ? 'å' : ''}';
+        new File('${sub.path}/$name').createSync();
+      }
+      new Link('${dir.path}/l$i').createSync(sub.path);
+    }
+
+    Map<String, Type> expected = <String, Type>{};
+    for (FileSystemEntity entity
+        in dir.listSync(recursive: true, followLinks: false)) {
+      expected[entity.path] = entity.runtimeType;
+    }
+    Map<String, Type> actual = <String, Type>{};
+    await for (FileSystemEntity entity
+        in dir.list(recursive: true, followLinks: false)) {
+      Expect.isFalse(actual.containsKey(entity.path));
+      actual[entity.path] = entity.runtimeType;
+    }
+    Expect.equals(40 * 62, actual.length);
+    Expect.mapEquals(expected, actual);
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -11,7 +11,7 @@ import "package:expect/expect.dart";
 void testPauseList() {
   asyncStart();
   // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
@@ -45,7 +45,7 @@ void testPauseList() {
 void testPauseResumeCancelList() {
   asyncStart();
   // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
@@ -75,7 +75,7 @@ void testPauseResumeCancelList() {
 void testListIsEmpty() {
   asyncStart();
   // TOTAL should be bigger the our directory listing buffer.
-  const int TOTAL = 128;
+  const int TOTAL = 1024;
   Directory.systemTemp.createTemp('dart_directory_list_pause').then((d) {
     for (int i = 0; i < TOTAL; i++) {
       new Directory("${d.path}/$i").createSync();
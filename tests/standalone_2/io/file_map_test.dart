@@ -0,0 +1,65 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+const int size = 3 * 4096 + 100;
+
+void testMapRead(File file) {
+  var raf = file.openSync();
+  var all = raf.mapSync(0, size, access: FileMapAccess.sequential);
+  Expect.equals(size, all.length);
+  for (int i = 0; i < size; i++) {
+    Expect.equals(i & 0xff, all[i]);
+  }
+  Expect.throws(() => all[0] = 1, (e) => e is UnsupportedError);
+
+  // The start does not have to be page aligned.
+  var part = raf.mapSync(5000, 10, access: FileMapAccess.random);
+  Expect.listEquals(
+      new List<int>.generate(10, (i) => (5000 + i) & 0xff), part);
+
+  // The mapping outlives the file.
+  raf.closeSync();
+  Expect.equals((size - 1) & 0xff, all[size - 1]);
+}
+
+void testMapOutOfRange(File file) {
+  var raf = file.openSync();
+  Expect.throws(() => raf.mapSync(-1, 10), (e) => e is RangeError);
+  Expect.throws(() => raf.mapSync(0, 0), (e) => e is RangeError);
+  Expect.throws(
+      () => raf.mapSync(size - 10, 11), (e) => e is FileSystemException);
+  raf.closeSync();
+}
+
+void testMapWrite(File file) {
+  // Windows reads the file into memory instead of mapping it.
+  if (Platform.isWindows) return;
+  var raf = file.openSync(mode: FileMode.append);
+  var mapping = raf.mapSync(4096, 4, mode: FileMapMode.write);
+  mapping.setAll(0, [1, 2, 3, 4]);
+  raf.flushSync();
+  raf.closeSync();
+  var bytes = file.readAsBytesSync();
+  Expect.listEquals([1, 2, 3, 4], bytes.sublist(4096, 4100));
+  Expect.equals(4100 & 0xff, bytes[4100]);
+}
+
+void main() {
+  var dir = Directory.systemTemp.createTempSync('dart_file_map');
+  var file = new File("${dir.path}/file");
+  file.writeAsBytesSync(new Uint8List.fromList(
+      new List<int>.generate(size, (i) => i & 0xff)));
+  try {
+    testMapRead(file);
+    testMapOutOfRange(file);
+    testMapWrite(file);
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+}
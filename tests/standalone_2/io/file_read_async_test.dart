@@ -0,0 +1,76 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test asynchronous reads from many files at once, and that errors and
+// pending reads are reported as before.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int fileCount = 20;
+const int fileSize = 100000;
+
+Future testConcurrentReads(Directory temp) async {
+  var contents = <List<int>>[];
+  var files = <RandomAccessFile>[];
+  for (int i = 0; i < fileCount; i++) {
+    var bytes = new Uint8List(fileSize);
+    for (int j = 0; j < fileSize; j++) {
+      bytes[j] = (i + j) & 0xff;
+    }
+    var file = new File("${temp.path}/file$i");
+    file.writeAsBytesSync(bytes);
+    contents.add(bytes);
+    files.add(await file.open());
+  }
+
+  // Read the first half of each file with read() and the rest with
+  // readInto(), all of the files at the same time.
+  var results = await Future.wait(files.map((raf) async {
+    var buffer = new List<int>.filled(fileSize, 0);
+    var first = await raf.read(fileSize ~/ 2);
+    buffer.setRange(0, first.length, first);
+    var read = await raf.readInto(buffer, first.length);
+    Expect.equals(fileSize, first.length + read);
+    Expect.equals(0, await raf.readInto(buffer, 0, 10));
+    Expect.equals(0, (await raf.read(10)).length);
+    return buffer;
+  }));
+  for (int i = 0; i < fileCount; i++) {
+    Expect.listEquals(contents[i], results[i]);
+    await files[i].close();
+  }
+}
+
+Future testPendingAndClosed(Directory temp) async {
+  var file = new File("${temp.path}/small");
+  file.writeAsBytesSync([1, 2, 3]);
+  var raf = await file.open();
+  var read = raf.read(3);
+  Expect.throws(() => raf.readSync(1), (e) => e is FileSystemException);
+  await raf.read(1).then((_) => Expect.fail("read should fail"),
+      onError: (e) => Expect.isTrue(e is FileSystemException));
+  Expect.listEquals([1, 2, 3], await read);
+  await raf.read(-1).then((_) => Expect.fail("read should fail"),
+      onError: (e) => Expect.isTrue(e is ArgumentError));
+  await raf.close();
+  await raf.read(1).then((_) => Expect.fail("read should fail"),
+      onError: (e) => Expect.isTrue(e is FileSystemException));
+}
+
+main() async {
+  asyncStart();
+  var temp = Directory.systemTemp.createTempSync("file_read_async_test");
+  try {
+    await testConcurrentReads(temp);
+    await testPendingAndClosed(temp);
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -113,8 +113,35 @@ Future testStatAsync() {
   });
 }
 
+Future testStatAllAsync() async {
+  Directory directory = await Directory.systemTemp.createTemp('dart_stat_all');
+  File file = new File(join(directory.path, "file"));
+  await file.writeAsString("Dart IO library test of FileStat");
+  String missing = join(directory.path, "missing");
+  List<FileStat> stats =
+      await FileStat.statAll([file.path, missing, directory.path, file.path]);
+  Expect.equals(4, stats.length);
+  Expect.equals(FileSystemEntityType.file, stats[0].type);
+  Expect.equals(32, stats[0].size);
+  Expect.equals(6 << 6, stats[0].mode & (6 << 6)); // Mode includes +urw.
+  Expect.equals(FileSystemEntityType.notFound, stats[1].type);
+  Expect.equals(FileSystemEntityType.directory, stats[2].type);
+  Expect.equals(7 << 6, stats[2].mode & (7 << 6)); // Includes +urwx.
+  FileStat fileStat = await FileStat.stat(file.path);
+  for (FileStat stat in [stats[0], stats[3]]) {
+    Expect.equals(fileStat.type, stat.type);
+    Expect.equals(fileStat.size, stat.size);
+    Expect.equals(fileStat.mode, stat.mode);
+    Expect.equals(fileStat.modified, stat.modified);
+  }
+  Expect.equals(0, (await FileStat.statAll([])).length);
+  await directory.delete(recursive: true);
+}
+
 void main() {
   asyncStart();
   testStat();
-  testStatAsync().then((_) => asyncEnd());
+  testStatAsync()
+      .then((_) => testStatAllAsync())
+      .then((_) => asyncEnd());
 }
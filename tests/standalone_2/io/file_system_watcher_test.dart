@@ -275,6 +275,36 @@ void testWatchNonRecursive() {
   });
 }
 
+void testWatchRecursive() {
+  var dir = Directory.systemTemp.createTempSync('dart_file_system_watcher');
+  new Directory(join(dir.path, 'dir/inner')).createSync(recursive: true);
+  var file = new File(join(dir.path, 'dir/inner/file'));
+  var newDir = new Directory(join(dir.path, 'new'));
+  var newFile = new File(join(dir.path, 'new/file'));
+
+  var watcher = dir.watch(events: FileSystemEvent.create, recursive: true);
+
+  asyncStart();
+  var expected = new Set.from([join('inner', 'file'), join('new', 'file')]);
+  var sub;
+  sub = watcher.listen((event) {
+    expected.removeWhere((suffix) => event.path.endsWith(suffix));
+    if (expected.isEmpty) {
+      sub.cancel();
+      asyncEnd();
+      dir.deleteSync(recursive: true);
+    }
+  }, onError: (e) {
+    dir.deleteSync(recursive: true);
+    throw e;
+  });
+
+  file.createSync();
+  // The file is created before the watch on its directory can be in place.
+  newDir.createSync();
+  newFile.createSync();
+}
+
 void testWatchNonExisting() {
   // MacOS allows listening on non-existing paths.
   if (Platform.isMacOS) return;
@@ -324,6 +354,7 @@ void main() {
   testWatchOnlyModifyFile();
   testMultipleEvents();
   testWatchNonRecursive();
+  testWatchRecursive();
   testWatchNonExisting();
   testWatchMoveSelf();
 }
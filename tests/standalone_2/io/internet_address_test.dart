@@ -2,6 +2,7 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+import 'dart:async';
 import 'dart:io';
 
 import "package:expect/expect.dart";
@@ -112,6 +113,24 @@ void testLookup() {
   });
 }
 
+void testRepeatedLookup() {
+  // Concurrent lookups share one resolution, and later ones are answered
+  // from the cache. Either way the answers are the same.
+  List<String> addresses(List<InternetAddress> result) =>
+      result.map((address) => address.address).toList();
+  Future.wait(new List.generate(
+          4, (_) => InternetAddress.lookup('localhost')))
+      .then((results) {
+    for (var result in results) {
+      Expect.listEquals(addresses(results.first), addresses(result));
+      Expect.equals('localhost', result.first.host);
+    }
+    InternetAddress.lookup('localhost').then((result) {
+      Expect.listEquals(addresses(results.first), addresses(result));
+    });
+  });
+}
+
 void testReverseLookup() {
   InternetAddress.lookup('localhost').then((addrs) {
     addrs.first.reverse().then((addr) {
@@ -136,5 +155,6 @@ void main() {
   testConstructor();
   testEquality();
   testLookup();
+  testRepeatedLookup();
   testReverseLookup();
 }
@@ -0,0 +1,73 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// With --lazy-vm-service the VM service port accepts connections before the
+// service isolate runs, and the first client gets answered once it does.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<int> freePort() async {
+  final socket = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final port = socket.port;
+  await socket.close();
+  return port;
+}
+
+Future<void> test() async {
+  final port = await freePort();
+  final process = await Process.start(Platform.executable, <String>[
+    '--enable-vm-service=$port/127.0.0.1',
+    '--lazy-vm-service',
+    '--disable-service-auth-codes',
+    Platform.script.toFilePath(),
+    'child',
+  ]);
+  final lines =
+      process.stdout.transform(utf8.decoder).transform(const LineSplitter());
+  final ready = new Completer<void>();
+  var serviceStarted = false;
+  lines.listen((line) {
+    if (line.startsWith('Observatory listening')) {
+      serviceStarted = true;
+    } else if (line == 'ready') {
+      ready.complete();
+    }
+  });
+  process.stderr.drain();
+
+  await ready.future;
+  Expect.isFalse(serviceStarted);
+
+  final client = new HttpClient();
+  final request =
+      await client.getUrl(Uri.parse('http://127.0.0.1:$port/getVersion'));
+  final response = await request.close();
+  Expect.equals(HttpStatus.ok, response.statusCode);
+  final body = json.decode(await response.transform(utf8.decoder).join());
+  Expect.equals('Version', body['result']['type']);
+  client.close();
+
+  process.stdin.close();
+  Expect.equals(0, await process.exitCode);
+}
+
+main(List<String> args) async {
+  if (args.contains('child')) {
+    print('ready');
+    await stdin.drain();
+    return;
+  }
+  // The listener is only created ahead of the service on POSIX hosts.
+  if (Platform.isWindows || Platform.isFuchsia) {
+    return;
+  }
+  asyncStart();
+  await test();
+  asyncEnd();
+}
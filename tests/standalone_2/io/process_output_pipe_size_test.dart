@@ -0,0 +1,63 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// With --process_output_pipe_size the output of started processes still
+// arrives complete and in order.
+
+import "dart:convert";
+import "dart:io";
+
+import "package:expect/expect.dart";
+
+const int lineCount = 100000;
+
+void writeLines() {
+  final buffer = new StringBuffer();
+  for (var i = 0; i < lineCount; i++) {
+    buffer.writeln(i);
+    if (buffer.length > 4096) {
+      stdout.write(buffer);
+      buffer.clear();
+    }
+  }
+  stdout.write(buffer);
+}
+
+Future<void> readLines() async {
+  final process = await Process.start(Platform.executable,
+      <String>[Platform.script.toFilePath(), "writer"]);
+  process.stderr.drain();
+  var next = 0;
+  final lines = process.stdout
+      .transform(systemEncoding.decoder)
+      .transform(const LineSplitter());
+  await for (final line in lines) {
+    Expect.equals("$next", line);
+    next++;
+  }
+  Expect.equals(lineCount, next);
+  Expect.equals(0, await process.exitCode);
+  print("ok");
+}
+
+main(List<String> args) async {
+  if (args.contains("writer")) {
+    writeLines();
+    return;
+  }
+  if (args.contains("reader")) {
+    await readLines();
+    return;
+  }
+  if (Platform.executable.endsWith("dart_precompiled_runtime")) {
+    return; // The test runs the script from source.
+  }
+  final result = Process.runSync(Platform.executable, <String>[
+    "--process_output_pipe_size=1048576",
+    Platform.script.toFilePath(),
+    "reader",
+  ]);
+  Expect.equals(0, result.exitCode, result.stderr);
+  Expect.equals("ok", result.stdout.trim());
+}
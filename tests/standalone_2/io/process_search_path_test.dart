@@ -0,0 +1,36 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that the executable is looked up on the PATH of the environment given
+// to the new process, and that files without a recognized format are run by
+// the shell, as execvp does.
+
+import "dart:io";
+
+import "package:expect/expect.dart";
+
+main() {
+  if (Platform.isWindows) return;
+  Directory dir = Directory.systemTemp.createTempSync('dart_search_path');
+  try {
+    File script = new File('${dir.path}/dart_search_path_script');
+    // No "#!" line, so exec fails with ENOEXEC.
+    script.writeAsStringSync('echo found "\$1"\n');
+    Expect.equals(0, Process.runSync('chmod', ['+x', script.path]).exitCode);
+
+    ProcessResult result = Process.runSync('dart_search_path_script', ['it'],
+        environment: {'PATH': '/nonexistent:${dir.path}'},
+        includeParentEnvironment: false);
+    Expect.equals(0, result.exitCode);
+    Expect.equals('found it\n', result.stdout);
+
+    Expect.throws(
+        () => Process.runSync('dart_search_path_script', [],
+            environment: {'PATH': '/nonexistent'},
+            includeParentEnvironment: false),
+        (e) => e is ProcessException);
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+}
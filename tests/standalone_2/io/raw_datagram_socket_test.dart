@@ -387,6 +387,44 @@ testSendReceive(InternetAddress bindAddress, int dataSize) {
   });
 }
 
+testSendReceiveMany(InternetAddress bindAddress) {
+  asyncStart();
+  const int datagramCount = 100;
+  Future.wait(<Future<RawDatagramSocket>>[
+    RawDatagramSocket.bind(bindAddress, 0),
+    RawDatagramSocket.bind(bindAddress, 0)
+  ]).then((sockets) {
+    var sender = sockets[0];
+    var receiver = sockets[1];
+    var datagrams = new List<Datagram>.generate(
+        datagramCount,
+        (i) => new Datagram(
+            new Uint8List.fromList([i, i + 1]), bindAddress, receiver.port));
+    var seen = new Set<int>();
+    receiver.listen((event) {
+      if (event != RawSocketEvent.read) return;
+      for (var datagram in receiver.receiveMany(datagramCount)) {
+        Expect.equals(2, datagram.data.length);
+        Expect.equals(datagram.data[0] + 1, datagram.data[1]);
+        Expect.equals(sender.port, datagram.port);
+        seen.add(datagram.data[0]);
+      }
+      if (seen.length == datagramCount) {
+        sender.close();
+        receiver.close();
+        asyncEnd();
+      }
+    });
+
+    int sent = 0;
+    sender.listen((event) {
+      if (event != RawSocketEvent.write) return;
+      sent += sender.sendMany(datagrams.sublist(sent));
+      if (sent < datagramCount) sender.writeEventsEnabled = true;
+    });
+  });
+}
+
 main() {
   testDatagramBroadcastOptions();
   testDatagramMulticastOptions();
@@ -398,6 +436,8 @@ main() {
   testLoopbackMulticastError();
   testSendReceive(InternetAddress.loopbackIPv4, 1000);
   testSendReceive(InternetAddress.loopbackIPv6, 1000);
+  testSendReceiveMany(InternetAddress.loopbackIPv4);
+  testSendReceiveMany(InternetAddress.loopbackIPv6);
   if (!Platform.isMacOS) {
     testSendReceive(InternetAddress.loopbackIPv4, 32 * 1024);
     testSendReceive(InternetAddress.loopbackIPv6, 32 * 1024);
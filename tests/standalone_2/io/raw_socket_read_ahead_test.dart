@@ -0,0 +1,88 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--socket_read_ahead
+// VMOptions=--socket_read_ahead --short_socket_read
+// VMOptions=--socket_read_ahead --short_socket_write
+
+// Transfers enough data for the read ahead buffer to grow to its largest
+// size and to shrink again, and checks that no byte is lost or reordered.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int bulkSize = 4 * 1024 * 1024;
+const int smallWrites = 100;
+
+int byteAt(int index) => (index * 7 + (index >> 10)) & 0xff;
+
+Future testReadAhead() async {
+  final server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) {
+    // A bulk transfer followed by small writes.
+    final data = new Uint8List(bulkSize + smallWrites);
+    for (int i = 0; i < data.length; i++) {
+      data[i] = byteAt(i);
+    }
+    int offset = 0;
+    int small = 0;
+    client.listen((event) {
+      switch (event) {
+        case RawSocketEvent.write:
+          if (offset < bulkSize) {
+            offset += client.write(data, offset, bulkSize - offset);
+          } else if (small < smallWrites) {
+            new Timer(const Duration(milliseconds: 1), () {
+              small += client.write(data, bulkSize + small, 1);
+              client.writeEventsEnabled = true;
+            });
+            return;
+          } else {
+            client.shutdown(SocketDirection.send);
+            return;
+          }
+          if (offset < bulkSize || small < smallWrites) {
+            client.writeEventsEnabled = true;
+          }
+          break;
+        case RawSocketEvent.readClosed:
+          client.close();
+          server.close();
+          break;
+      }
+    });
+  });
+
+  final socket =
+      await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+  final done = new Completer();
+  int received = 0;
+  socket.listen((event) {
+    switch (event) {
+      case RawSocketEvent.read:
+        Expect.isTrue(socket.available() > 0);
+        final data = socket.read();
+        for (int i = 0; i < data.length; i++) {
+          Expect.equals(byteAt(received + i), data[i]);
+        }
+        received += data.length;
+        break;
+      case RawSocketEvent.readClosed:
+        Expect.equals(bulkSize + smallWrites, received);
+        socket.close();
+        done.complete();
+        break;
+    }
+  });
+  await done.future;
+}
+
+main() {
+  asyncStart();
+  testReadAhead().then((_) => asyncEnd());
+}
@@ -6,9 +6,12 @@
 // VMOptions=--short_socket_read
 // VMOptions=--short_socket_write
 // VMOptions=--short_socket_read --short_socket_write
+// VMOptions=--socket_read_ahead
+// VMOptions=--socket_read_ahead --short_socket_read
 
 import "dart:async";
 import "dart:io";
+import "dart:typed_data";
 
 import "package:async_helper/async_helper.dart";
 import "package:expect/expect.dart";
@@ -474,6 +477,54 @@ void testClosedError() {
   });
 }
 
+void testReadInto() {
+  asyncStart();
+  const int messageSize = 10000;
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((client) {
+      var data = new List<int>.generate(messageSize, (i) => i & 0xff);
+      int written = 0;
+      client.writeEventsEnabled = true;
+      client.listen((event) {
+        if (event == RawSocketEvent.write && written < messageSize) {
+          written += client.write(data, written);
+          if (written < messageSize) {
+            client.writeEventsEnabled = true;
+          } else {
+            client.shutdown(SocketDirection.send);
+          }
+        } else if (event == RawSocketEvent.readClosed) {
+          client.close();
+          server.close();
+        }
+      });
+    });
+
+    RawSocket.connect("127.0.0.1", server.port).then((socket) {
+      // Read through a small window of a larger buffer, reusing it for all
+      // the reads.
+      var buffer = new Uint8List(100);
+      int received = 0;
+      socket.listen((event) {
+        if (event == RawSocketEvent.read) {
+          int count;
+          while ((count = socket.readInto(buffer, 10, 20)) > 0) {
+            for (int i = 0; i < count; i++) {
+              Expect.equals((received + i) & 0xff, buffer[10 + i]);
+            }
+            received += count;
+          }
+          Expect.equals(0, buffer[20]);
+        } else if (event == RawSocketEvent.readClosed) {
+          Expect.equals(messageSize, received);
+          socket.close();
+          asyncEnd();
+        }
+      });
+    });
+  });
+}
+
 main() {
   asyncStart();
   testArguments();
@@ -491,5 +542,6 @@ main() {
   testSocketZone();
   testSocketZoneError();
   testClosedError();
+  testReadInto();
   asyncEnd();
 }
@@ -0,0 +1,76 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+// Client sessions are cached for the whole process. Checks that a cached
+// session never lets a connection skip a certificate check it would fail.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(localFile('certificates/server_key.pem'),
+      password: 'dartdart');
+
+SecurityContext trustingContext() => new SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+Future<SecureServerSocket> startServer() async {
+  SecureServerSocket server =
+      await SecureServerSocket.bind("localhost", 0, serverContext);
+  server.listen((SecureSocket socket) {
+    socket.listen((_) {}, onError: (_) {}, onDone: () => socket.close());
+    socket.add([1, 2, 3]);
+  }, onError: (_) {});
+  return server;
+}
+
+// Connects and waits for the server's data, so that any session tickets
+// sent after the handshake have been received.
+Future<bool> connect(SecureServerSocket server, SecurityContext context,
+    {bool onBadCertificate(X509Certificate certificate)}) async {
+  SecureSocket socket;
+  try {
+    socket = await SecureSocket.connect("localhost", server.port,
+        context: context, onBadCertificate: onBadCertificate);
+  } on HandshakeException {
+    return false;
+  }
+  await socket.first;
+  await socket.close();
+  return true;
+}
+
+Future test() async {
+  SecureServerSocket server = await startServer();
+  SecurityContext trusting = trustingContext();
+  Expect.isTrue(await connect(server, trusting));
+  Expect.isTrue(await connect(server, trusting));
+  Expect.isTrue(await connect(server, trustingContext()));
+
+  // A context which does not trust the server gets no cached session.
+  SecurityContext untrusting = new SecurityContext();
+  Expect.isFalse(await connect(server, untrusting));
+
+  // Nor is a session kept when only the callback accepted the certificate.
+  Expect.isTrue(
+      await connect(server, untrusting, onBadCertificate: (_) => true));
+  Expect.isFalse(await connect(server, untrusting));
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await test();
+  asyncEnd();
+}
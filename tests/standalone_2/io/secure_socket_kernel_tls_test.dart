@@ -0,0 +1,66 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+// Whether the kernel takes over the connection depends on the platform and
+// the negotiated cipher, so this only checks that data keeps flowing in both
+// directions either way.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(localFile('certificates/server_key.pem'),
+      password: 'dartdart');
+
+SecurityContext clientContext = new SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+const int messageSize = 100000;
+
+List<int> message() => new List<int>.generate(messageSize, (i) => i & 0xff);
+
+Future<List<int>> readAll(Stream<List<int>> stream) {
+  return stream.fold(<int>[], (List<int> all, data) => all..addAll(data));
+}
+
+Future test() async {
+  SecureServerSocket server =
+      await SecureServerSocket.bind(HOST, 0, serverContext);
+  server.listen((SecureSocket socket) async {
+    Expect.isTrue(socket.enableKernelTls() is bool);
+    List<int> received = await readAll(socket);
+    Expect.listEquals(message(), received);
+    socket.add(received);
+    await socket.close();
+    await server.close();
+  });
+
+  SecureSocket client = await SecureSocket.connect(HOST, server.port,
+      context: clientContext);
+  Expect.isTrue(client.enableKernelTls() is bool);
+  client.add(message());
+  Future<List<int>> reply = readAll(client);
+  await client.flush();
+  await client.close();
+  Expect.listEquals(message(), await reply);
+}
+
+InternetAddress HOST;
+
+main() async {
+  asyncStart();
+  HOST = (await InternetAddress.lookup("localhost")).first;
+  await test();
+  asyncEnd();
+}
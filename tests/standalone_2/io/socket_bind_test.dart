@@ -43,6 +43,38 @@ Future negTestBindV6OnlyMismatch(String host, bool v6Only) async {
   await socket.close();
 }
 
+Future testBindReusePort(String host) async {
+  final socket = await ServerSocket.bind(host, 0, reusePort: true);
+  Expect.isTrue(socket.port > 0);
+
+  final socket2 = await ServerSocket.bind(host, socket.port, reusePort: true);
+  Expect.equals(socket.port, socket2.port);
+
+  // Every connection is accepted by exactly one of the sockets.
+  int accepted = 0;
+  final connections = 20;
+  final allAccepted = new Completer();
+  void onConnection(Socket client) {
+    client.destroy();
+    if (++accepted == connections) allAccepted.complete();
+  }
+
+  socket.listen(onConnection);
+  socket2.listen(onConnection);
+  for (int i = 0; i < connections; i++) {
+    (await Socket.connect(host, socket.port)).destroy();
+  }
+  await allAccepted.future;
+
+  await throws(() => ServerSocket.bind(host, socket.port),
+      (error) => error is SocketException && '$error'.contains('reusePort'));
+  await throws(() => ServerSocket.bind(host, 0, shared: true, reusePort: true),
+      (error) => error is ArgumentError);
+
+  await socket.close();
+  await socket2.close();
+}
+
 Future testBindDifferentAddresses(InternetAddress addr1, InternetAddress addr2,
     bool addr1V6Only, bool addr2V6Only) async {
   var socket =
@@ -116,5 +148,9 @@ main() async {
     await negTestBindV6OnlyMismatch(host, false);
 
     await testListenCloseListenClose(host);
+
+    if (Platform.isLinux || Platform.isAndroid) {
+      await testBindReusePort(host);
+    }
   }
 }
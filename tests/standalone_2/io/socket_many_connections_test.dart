@@ -2,6 +2,9 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 //
+// VMOptions=
+// VMOptions=--event_handler_threads=4
+//
 // Test creating a large number of socket connections.
 library ServerTest;
 
@@ -0,0 +1,97 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int fileSize = 1024 * 1024 + 17;
+
+Future<List<int>> sendAndReceive(void send(Socket socket)) async {
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = <int>[];
+  var done = new Completer();
+  server.listen((client) {
+    client.listen(received.addAll, onDone: () {
+      client.close();
+      done.complete();
+    });
+  });
+  var socket = await Socket.connect("127.0.0.1", server.port);
+  send(socket);
+  await socket.close();
+  await done.future;
+  await server.close();
+  return received;
+}
+
+Future testSendFile(File file, List<int> data) async {
+  var received = await sendAndReceive((socket) {
+    socket.add([1, 2, 3]);
+    socket.sendFile(file).then((_) => socket.add([4, 5]));
+  });
+  Expect.listEquals([1, 2, 3]..addAll(data)..addAll([4, 5]), received);
+
+  received = await sendAndReceive((socket) {
+    socket.sendFile(file, 1000, 200000);
+  });
+  Expect.listEquals(data.sublist(1000, 200000), received);
+
+  // The end is clamped to the length of the file.
+  received = await sendAndReceive((socket) {
+    socket.sendFile(file, fileSize - 10, fileSize + 10);
+  });
+  Expect.listEquals(data.sublist(fileSize - 10), received);
+}
+
+Future testRawSendFile(File file, List<int> data) async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = <int>[];
+  var done = new Completer();
+  server.listen((client) {
+    client.listen((event) {
+      if (event == RawSocketEvent.read) {
+        received.addAll(client.read());
+      } else if (event == RawSocketEvent.readClosed) {
+        client.close();
+        done.complete();
+      }
+    });
+  });
+  var socket = await RawSocket.connect("127.0.0.1", server.port);
+  var raf = await file.open();
+  int position = 0;
+  socket.listen((event) {
+    if (event == RawSocketEvent.write) {
+      position += socket.sendFile(raf, position, fileSize - position);
+      if (position < fileSize) {
+        socket.writeEventsEnabled = true;
+      } else {
+        raf.closeSync();
+        socket.shutdown(SocketDirection.send);
+      }
+    }
+  });
+  await done.future;
+  socket.close();
+  await server.close();
+  Expect.listEquals(data, received);
+}
+
+main() async {
+  asyncStart();
+  var directory = Directory.systemTemp.createTempSync("socket_send_file");
+  var file = new File("${directory.path}/data");
+  var data = new List<int>.generate(fileSize, (i) => (i * 7) & 0xff);
+  file.writeAsBytesSync(data);
+  await testSendFile(file, data);
+  await testRawSendFile(file, data);
+  directory.deleteSync(recursive: true);
+  asyncEnd();
+}
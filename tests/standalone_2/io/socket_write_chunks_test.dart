@@ -0,0 +1,48 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+//
+// Test that many small chunks added to a socket, some of them shared and
+// some of them empty, arrive in order.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int chunkCount = 10000;
+
+void main() {
+  asyncStart();
+  var separator = [0xff, 0xfe];
+  var expected = <int>[];
+  ServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((client) {
+      var received = <int>[];
+      client.listen(received.addAll, onDone: () {
+        Expect.listEquals(expected, received);
+        client.close();
+        server.close();
+        asyncEnd();
+      });
+    });
+
+    Socket.connect("127.0.0.1", server.port).then((socket) {
+      for (int i = 0; i < chunkCount; i++) {
+        var chunk = (i % 3 == 0)
+            ? new Uint8List.fromList([i & 0xff, (i >> 8) & 0xff])
+            : new List<int>.filled(i % 7, i & 0xff);
+        socket.add(chunk);
+        socket.add(separator);
+        socket.add(const []);
+        expected..addAll(chunk)..addAll(separator);
+      }
+      socket.close();
+    });
+  });
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+import "dart:convert";
+import "dart:io";
+
+const int lines = 10000;
+
+void writeLines(int bufferSize) {
+  stdout.bufferSize = bufferSize;
+  Expect.equals(bufferSize, stdout.bufferSize);
+  for (int i = 0; i < lines; i++) {
+    stdout.writeln("line $i");
+  }
+  stderr.write("error");
+  // Output still in the buffers has to survive an immediate exit.
+  stdout.done.then((_) => exit(0));
+  stdout.close();
+}
+
+void writeAndThrow() {
+  // print is ordered with buffered writes, and an unhandled exception does
+  // not lose the output of the last turn.
+  stdout.write("a");
+  print("b");
+  stdout.write("c");
+  throw "boom";
+}
+
+void testThrow() {
+  var arguments = <String>[]
+    ..addAll(Platform.executableArguments)
+    ..add(Platform.script.toFilePath())
+    ..add("throw");
+  asyncStart();
+  Process.run(Platform.executable, arguments,
+          stdoutEncoding: ascii, stderrEncoding: ascii)
+      .then((result) {
+    Expect.notEquals(0, result.exitCode);
+    Expect.equals("ab\nc", result.stdout.replaceAll("\r\n", "\n"));
+    Expect.isTrue(result.stderr.contains("boom"));
+    asyncEnd();
+  });
+}
+
+void test(int bufferSize) {
+  var arguments = <String>[]
+    ..addAll(Platform.executableArguments)
+    ..add(Platform.script.toFilePath())
+    ..add("$bufferSize");
+  asyncStart();
+  Process.run(Platform.executable, arguments,
+          stdoutEncoding: ascii, stderrEncoding: ascii)
+      .then((result) {
+    Expect.equals(0, result.exitCode);
+    var output = result.stdout.split("\n");
+    Expect.equals(lines + 1, output.length);
+    for (int i = 0; i < lines; i++) {
+      Expect.equals("line $i", output[i]);
+    }
+    Expect.equals("error", result.stderr);
+    asyncEnd();
+  });
+}
+
+void main(List<String> arguments) {
+  if (arguments.contains("throw")) {
+    writeAndThrow();
+    return;
+  }
+  if (arguments.isNotEmpty) {
+    writeLines(int.parse(arguments[0]));
+    return;
+  }
+  Expect.throwsRangeError(() => stdout.bufferSize = -1);
+  Expect.throwsRangeError(() => stdout.bufferSize = 2 * 1024 * 1024);
+  test(0);
+  test(100);
+  test(64 * 1024);
+  testThrow();
+}
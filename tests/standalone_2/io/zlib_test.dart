@@ -244,6 +244,56 @@ void testZlibWithDictionary() {
   });
 }
 
+void testZLibReuseFilters() {
+  // Filters are reused for later streams with the same settings, which must
+  // not carry any state over.
+  var data = new List<int>.generate(10000, (i) => (i * i) & 0xff);
+  var expected = [
+    new ZLibEncoder(level: 6).convert(data),
+    new ZLibEncoder(gzip: true, level: 6).convert(data),
+    new ZLibEncoder(raw: true, level: 1).convert(data),
+  ];
+  for (int i = 0; i < 50; i++) {
+    // Leave a stream unfinished now and then.
+    new RawZLibFilter.deflateFilter(level: 6).process(data, 0, 100);
+    Expect.listEquals(expected[0], new ZLibEncoder(level: 6).convert(data));
+    Expect.listEquals(
+        expected[1], new ZLibEncoder(gzip: true, level: 6).convert(data));
+    Expect.listEquals(
+        expected[2], new ZLibEncoder(raw: true, level: 1).convert(data));
+    Expect.listEquals(data, new ZLibDecoder().convert(expected[i % 2]));
+    Expect.listEquals(data, new ZLibDecoder(raw: true).convert(expected[2]));
+  }
+}
+
+void testZLibInflateExternalInput() {
+  // Data read from a file is external typed data, which is inflated in
+  // place rather than copied.
+  var data = new List<int>.generate(10000, (i) => (i * 7) & 0xff);
+  var temp = Directory.systemTemp.createTempSync('zlib_test');
+  var file = new File('${temp.path}/data');
+  file.writeAsBytesSync(new ZLibEncoder(gzip: true).convert(data));
+  var raf = file.openSync();
+  var filter = new RawZLibFilter.inflateFilter();
+  var inflated = <int>[];
+  while (true) {
+    var chunk = raf.readSync(97);
+    if (chunk.isEmpty) break;
+    filter.process(chunk, 0, chunk.length);
+    var out;
+    while ((out = filter.processed(flush: false)) != null) {
+      inflated.addAll(out);
+    }
+  }
+  var out;
+  while ((out = filter.processed(end: true)) != null) {
+    inflated.addAll(out);
+  }
+  raf.closeSync();
+  temp.deleteSync(recursive: true);
+  Expect.listEquals(data, inflated);
+}
+
 var generateListTypes = [
   (list) => list,
   (list) => new Uint8List.fromList(list),
@@ -286,5 +336,7 @@ void main() {
   testZlibInflateThrowsWithSmallerWindow();
   testZlibInflateWithLargerWindow();
   testZlibWithDictionary();
+  testZLibReuseFilters();
+  testZLibInflateExternalInput();
   asyncEnd();
 }
@@ -0,0 +1,63 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// With --kernel-cache the kernel compiled for a script is reused by later
+// runs, until one of the sources of the script changes.
+
+import "dart:io";
+
+import "package:expect/expect.dart";
+
+String run(String cacheDir, String scriptPath) {
+  final result = Process.runSync(Platform.executable, <String>[
+    "--kernel-cache=$cacheDir",
+    scriptPath,
+  ]);
+  Expect.equals(0, result.exitCode, result.stderr);
+  return result.stdout.trim();
+}
+
+void writeSources(Directory dir, String greeting) {
+  new File("${dir.path}/main.dart").writeAsStringSync("""
+import 'greeting.dart';
+main() => print(greeting);
+""");
+  new File("${dir.path}/greeting.dart")
+      .writeAsStringSync("const greeting = '$greeting';\n");
+}
+
+void main() {
+  if (Platform.executable.endsWith("dart_precompiled_runtime")) {
+    return; // Nothing to compile from source.
+  }
+  if (Platform.isAndroid) {
+    return; // The front end is not available on the test device.
+  }
+
+  final tempDir = Directory.systemTemp.createTempSync("kernel-cache");
+  try {
+    final sourceDir = new Directory("${tempDir.path}/src")..createSync();
+    final cacheDir = "${tempDir.path}/cache";
+    final scriptPath = "${sourceDir.path}/main.dart";
+
+    writeSources(sourceDir, "hello");
+    Expect.equals("hello", run(cacheDir, scriptPath));
+    final cached = new Directory(cacheDir)
+        .listSync()
+        .map((entry) => entry.path)
+        .where((path) => path.endsWith(".dill"))
+        .toList();
+    Expect.equals(1, cached.length);
+
+    // An unchanged program runs from the cache.
+    Expect.equals("hello", run(cacheDir, scriptPath));
+
+    // Changing an imported library invalidates the cached kernel.
+    writeSources(sourceDir, "goodbye");
+    Expect.equals("goodbye", run(cacheDir, scriptPath));
+    Expect.equals("goodbye", run(cacheDir, scriptPath));
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}